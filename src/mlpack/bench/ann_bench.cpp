@@ -0,0 +1,39 @@
+/**
+ * @file bench/ann_bench.cpp
+ * @author Ryan Curtin
+ *
+ * Micro-benchmark for the forward pass of a small feedforward network.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann/ann.hpp>
+
+#include "bench_harness.hpp"
+
+using namespace mlpack;
+
+MLPACK_BENCHMARK(FFNForward)
+{
+  FFN<> model;
+  model.Add<Linear>(256);
+  model.Add<ReLU>();
+  model.Add<Linear>(256);
+  model.Add<ReLU>();
+  model.Add<Linear>(10);
+
+  const arma::mat data = arma::randu<arma::mat>(100, 256);
+  arma::mat predictions;
+
+  // The first call initializes the weights; don't measure that.
+  model.Predict(data, predictions);
+
+  while (state.KeepRunning())
+  {
+    model.Predict(data, predictions);
+    mlpack::bench::DoNotOptimize(predictions);
+  }
+}
@@ -0,0 +1,238 @@
+/**
+ * @file bench/bench_harness.hpp
+ * @author Ryan Curtin
+ *
+ * A minimal micro-benchmark harness for mlpack's hot kernels.  The interface
+ * follows the Google Benchmark conventions (a registered function receives a
+ * State object and loops on KeepRunning()), but is self-contained so that no
+ * external dependency is needed.  Results can be emitted as JSON for CI trend
+ * tracking.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BENCH_BENCH_HARNESS_HPP
+#define MLPACK_BENCH_BENCH_HARNESS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace mlpack {
+namespace bench {
+
+/**
+ * The state of a single benchmark run.  A benchmark function loops on
+ * KeepRunning(); the time between the first call and the call that returns
+ * false is the measured time.  Setup done before the loop is not measured.
+ */
+class State
+{
+ public:
+  //! Create a state that will run for the given number of iterations.
+  State(const size_t iterations) :
+      iterations(iterations),
+      remaining(iterations),
+      started(false)
+  { }
+
+  //! Returns true until the requested number of iterations have run.  The
+  //! timer starts at the first call and stops at the last.
+  bool KeepRunning()
+  {
+    if (!started)
+    {
+      started = true;
+      startTime = std::chrono::high_resolution_clock::now();
+    }
+
+    if (remaining == 0)
+    {
+      stopTime = std::chrono::high_resolution_clock::now();
+      return false;
+    }
+
+    --remaining;
+    return true;
+  }
+
+  //! Get the number of iterations that were run.
+  size_t Iterations() const { return iterations; }
+
+  //! Get the measured time of the loop, in seconds.
+  double ElapsedSeconds() const
+  {
+    return std::chrono::duration_cast<std::chrono::duration<double>>(
+        stopTime - startTime).count();
+  }
+
+ private:
+  //! The number of iterations to run.
+  size_t iterations;
+  //! The number of iterations left to run.
+  size_t remaining;
+  //! Whether the timer has been started.
+  bool started;
+  //! The time at which the loop started.
+  std::chrono::high_resolution_clock::time_point startTime;
+  //! The time at which the loop stopped.
+  std::chrono::high_resolution_clock::time_point stopTime;
+};
+
+//! The type of a benchmark function.
+typedef void (*BenchmarkFunction)(State&);
+
+/**
+ * Prevent the compiler from optimizing away a computed value.  Use this on
+ * the result of the kernel under test, so that the loop body is not removed
+ * as dead code.
+ */
+template<typename T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(_MSC_VER)
+  volatile const char* sink = reinterpret_cast<volatile const char*>(&value);
+  (void) sink;
+#else
+  asm volatile("" : : "g" (value) : "memory");
+#endif
+}
+
+/**
+ * The global registry of benchmarks.  Benchmarks register themselves at
+ * static initialization time via the MLPACK_BENCHMARK() macro.
+ */
+class Registry
+{
+ public:
+  struct Benchmark
+  {
+    std::string name;
+    BenchmarkFunction function;
+  };
+
+  //! Get the list of all registered benchmarks.
+  static std::vector<Benchmark>& Benchmarks()
+  {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+  }
+
+  //! Register a benchmark; used by the MLPACK_BENCHMARK() macro.
+  static bool Add(const std::string& name, BenchmarkFunction function)
+  {
+    Benchmarks().push_back(Benchmark{ name, function });
+    return true;
+  }
+};
+
+//! The result of one benchmark: the measured time per iteration.
+struct Result
+{
+  std::string name;
+  size_t iterations;
+  double nsPerIteration;
+};
+
+/**
+ * Run one benchmark.  The number of iterations is calibrated upwards until
+ * the measured loop takes at least minTime seconds, so that short kernels are
+ * timed over enough repetitions to be stable.
+ *
+ * @param benchmark The benchmark to run.
+ * @param minTime Minimum measured loop time, in seconds.
+ */
+inline Result Run(const Registry::Benchmark& benchmark,
+                  const double minTime = 0.5)
+{
+  size_t iterations = 1;
+  while (true)
+  {
+    State state(iterations);
+    benchmark.function(state);
+    const double elapsed = state.ElapsedSeconds();
+
+    if (elapsed >= minTime || iterations >= (size_t) 1000000000)
+    {
+      return Result{ benchmark.name, iterations,
+          1e9 * elapsed / double(iterations) };
+    }
+
+    // Estimate the iteration count needed to reach minTime, with some
+    // headroom, but at least double it.
+    const size_t estimate = (size_t) (double(iterations) * 1.4 * minTime /
+        std::max(elapsed, 1e-9));
+    iterations = std::max(2 * iterations, estimate);
+  }
+}
+
+/**
+ * Write the given results as JSON, in a layout close enough to the Google
+ * Benchmark JSON reporter for CI trend-tracking tools to consume.
+ *
+ * @param results Results to write.
+ * @param version mlpack version string for the context block.
+ * @param out Stream to write to.
+ */
+inline void WriteJSON(const std::vector<Result>& results,
+                      const std::string& version,
+                      std::ostream& out)
+{
+  // Format the current date in ISO 8601 form.
+  char date[64];
+  const std::time_t now = std::time(NULL);
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S",
+      std::localtime(&now));
+
+  out << "{" << std::endl;
+  out << "  \"context\": {" << std::endl;
+  out << "    \"date\": \"" << date << "\"," << std::endl;
+  out << "    \"library_version\": \"" << version << "\"" << std::endl;
+  out << "  }," << std::endl;
+  out << "  \"benchmarks\": [" << std::endl;
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    out << "    {" << std::endl;
+    out << "      \"name\": \"" << results[i].name << "\"," << std::endl;
+    out << "      \"iterations\": " << results[i].iterations << ","
+        << std::endl;
+    out << "      \"real_time\": " << std::fixed << std::setprecision(2)
+        << results[i].nsPerIteration << "," << std::endl;
+    out << "      \"time_unit\": \"ns\"" << std::endl;
+    out << "    }" << ((i + 1 < results.size()) ? "," : "") << std::endl;
+  }
+  out << "  ]" << std::endl;
+  out << "}" << std::endl;
+}
+
+} // namespace bench
+} // namespace mlpack
+
+/**
+ * Define and register a benchmark.  Use as:
+ *
+ * @code
+ * MLPACK_BENCHMARK(MyKernel)
+ * {
+ *   // ... setup (not measured) ...
+ *   while (state.KeepRunning())
+ *   {
+ *     // ... kernel under test ...
+ *   }
+ * }
+ * @endcode
+ */
+#define MLPACK_BENCHMARK(name) \
+    static void name(mlpack::bench::State& state); \
+    static const bool name##Registered = \
+        mlpack::bench::Registry::Add(#name, &name); \
+    static void name(mlpack::bench::State& state)
+
+#endif // MLPACK_BENCH_BENCH_HARNESS_HPP
@@ -0,0 +1,48 @@
+/**
+ * @file bench/bound_bench.cpp
+ * @author Ryan Curtin
+ *
+ * Micro-benchmarks for HRectBound::MinDistance(), the pruning kernel of
+ * kd-tree traversals.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+
+#include "bench_harness.hpp"
+
+using namespace mlpack;
+
+MLPACK_BENCHMARK(HRectBoundMinDistancePoint)
+{
+  const size_t dim = 10;
+  HRectBound<EuclideanDistance> bound(dim);
+  bound |= arma::randu<arma::mat>(dim, 100);
+
+  // A point outside the bound, so the distance computation touches every
+  // dimension.
+  arma::vec point = 2.0 + arma::randu<arma::vec>(dim);
+
+  double sum = 0.0;
+  while (state.KeepRunning())
+    sum += bound.MinDistance(point);
+  mlpack::bench::DoNotOptimize(sum);
+}
+
+MLPACK_BENCHMARK(HRectBoundMinDistanceBound)
+{
+  const size_t dim = 10;
+  HRectBound<EuclideanDistance> bound(dim);
+  bound |= arma::randu<arma::mat>(dim, 100);
+
+  HRectBound<EuclideanDistance> other(dim);
+  other |= (2.0 + arma::randu<arma::mat>(dim, 100));
+
+  double sum = 0.0;
+  while (state.KeepRunning())
+    sum += bound.MinDistance(other);
+  mlpack::bench::DoNotOptimize(sum);
+}
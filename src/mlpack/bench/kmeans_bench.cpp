@@ -0,0 +1,34 @@
+/**
+ * @file bench/kmeans_bench.cpp
+ * @author Ryan Curtin
+ *
+ * Micro-benchmark for a single naive (Lloyd) k-means iteration.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/kmeans.hpp>
+
+#include "bench_harness.hpp"
+
+using namespace mlpack;
+
+MLPACK_BENCHMARK(NaiveKMeansIterate)
+{
+  const arma::mat dataset = arma::randu<arma::mat>(10, 10000);
+
+  EuclideanDistance metric;
+  NaiveKMeans<EuclideanDistance, arma::mat> lloyd(dataset, metric);
+
+  const arma::mat centroids = arma::randu<arma::mat>(10, 20);
+  arma::mat newCentroids(10, 20);
+  arma::Col<size_t> counts(20);
+
+  double sum = 0.0;
+  while (state.KeepRunning())
+    sum += lloyd.Iterate(centroids, newCentroids, counts);
+  mlpack::bench::DoNotOptimize(sum);
+}
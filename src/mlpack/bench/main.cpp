@@ -0,0 +1,77 @@
+/**
+ * @file bench/main.cpp
+ * @author Ryan Curtin
+ *
+ * The driver for the mlpack_bench micro-benchmark suite.  Runs all registered
+ * benchmarks (optionally filtered by a substring), prints a human-readable
+ * table, and can write the results as JSON for CI trend tracking.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+
+#include "bench_harness.hpp"
+
+using namespace mlpack;
+using namespace mlpack::bench;
+
+int main(int argc, char** argv)
+{
+  std::string filter = "";
+  std::string jsonFile = "";
+
+  // Parse the (very small) set of supported options.
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg(argv[i]);
+    if (arg.substr(0, 9) == "--filter=")
+    {
+      filter = arg.substr(9);
+    }
+    else if (arg.substr(0, 7) == "--json=")
+    {
+      jsonFile = arg.substr(7);
+    }
+    else
+    {
+      std::cerr << "Usage: " << argv[0]
+          << " [--filter=<substring>] [--json=<output file>]" << std::endl;
+      return 1;
+    }
+  }
+
+  // Seed the generator so that runs are comparable between revisions.
+  RandomSeed(42);
+
+  std::vector<Result> results;
+  for (const Registry::Benchmark& benchmark : Registry::Benchmarks())
+  {
+    if (filter != "" && benchmark.name.find(filter) == std::string::npos)
+      continue;
+
+    const Result result = Run(benchmark);
+    results.push_back(result);
+
+    std::cout << std::left << std::setw(40) << result.name << std::right
+        << std::setw(12) << result.iterations << " iterations"
+        << std::setw(16) << std::fixed << std::setprecision(2)
+        << result.nsPerIteration << " ns/iteration" << std::endl;
+  }
+
+  if (jsonFile != "")
+  {
+    std::ofstream out(jsonFile);
+    if (!out.is_open())
+    {
+      std::cerr << "Cannot open '" << jsonFile << "' for writing!"
+          << std::endl;
+      return 1;
+    }
+    WriteJSON(results, util::GetVersion(), out);
+  }
+
+  return 0;
+}
@@ -0,0 +1,49 @@
+/**
+ * @file bench/metric_bench.cpp
+ * @author Ryan Curtin
+ *
+ * Micro-benchmarks for LMetric::Evaluate(), the innermost kernel of nearly
+ * every tree traversal.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+
+#include "bench_harness.hpp"
+
+using namespace mlpack;
+
+template<typename MetricType>
+void BenchLMetricEvaluate(mlpack::bench::State& state, const size_t dim)
+{
+  arma::vec a(dim, arma::fill::randu);
+  arma::vec b(dim, arma::fill::randu);
+
+  double sum = 0.0;
+  while (state.KeepRunning())
+    sum += MetricType::Evaluate(a, b);
+  mlpack::bench::DoNotOptimize(sum);
+}
+
+MLPACK_BENCHMARK(EuclideanDistanceEvaluate10)
+{
+  BenchLMetricEvaluate<EuclideanDistance>(state, 10);
+}
+
+MLPACK_BENCHMARK(EuclideanDistanceEvaluate100)
+{
+  BenchLMetricEvaluate<EuclideanDistance>(state, 100);
+}
+
+MLPACK_BENCHMARK(EuclideanDistanceEvaluate1000)
+{
+  BenchLMetricEvaluate<EuclideanDistance>(state, 1000);
+}
+
+MLPACK_BENCHMARK(ManhattanDistanceEvaluate100)
+{
+  BenchLMetricEvaluate<ManhattanDistance>(state, 100);
+}
@@ -0,0 +1,53 @@
+/**
+ * @file bench/search_bench.cpp
+ * @author Ryan Curtin
+ *
+ * Micro-benchmarks for dual-tree traversals: nearest neighbor search and
+ * kernel density estimation.  Tree construction happens outside the measured
+ * loop, so these track traversal cost only.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/neighbor_search.hpp>
+#include <mlpack/methods/kde.hpp>
+
+#include "bench_harness.hpp"
+
+using namespace mlpack;
+
+MLPACK_BENCHMARK(KNNDualTreeSearch)
+{
+  const arma::mat references = arma::randu<arma::mat>(10, 10000);
+  const arma::mat queries = arma::randu<arma::mat>(10, 1000);
+
+  KNN knn(references);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  while (state.KeepRunning())
+  {
+    knn.Search(queries, 5, neighbors, distances);
+    mlpack::bench::DoNotOptimize(neighbors);
+  }
+}
+
+MLPACK_BENCHMARK(KDEDualTreeEvaluate)
+{
+  const arma::mat references = arma::randu<arma::mat>(2, 2000);
+  const arma::mat queries = arma::randu<arma::mat>(2, 500);
+
+  KDE<GaussianKernel, EuclideanDistance, arma::mat, KDTree>
+      kde(0.0, 0.01, GaussianKernel(0.1));
+  kde.Train(references);
+
+  arma::vec estimations;
+  while (state.KeepRunning())
+  {
+    kde.Evaluate(queries, estimations);
+    mlpack::bench::DoNotOptimize(estimations);
+  }
+}
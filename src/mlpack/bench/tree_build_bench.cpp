@@ -0,0 +1,49 @@
+/**
+ * @file bench/tree_build_bench.cpp
+ * @author Ryan Curtin
+ *
+ * Micro-benchmarks for tree construction, per tree type.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+
+#include "bench_harness.hpp"
+
+using namespace mlpack;
+
+template<typename TreeType>
+void BenchTreeBuild(mlpack::bench::State& state)
+{
+  const arma::mat dataset = arma::randu<arma::mat>(10, 10000);
+
+  while (state.KeepRunning())
+  {
+    TreeType tree(dataset);
+    mlpack::bench::DoNotOptimize(tree.NumDescendants());
+  }
+}
+
+MLPACK_BENCHMARK(KDTreeBuild)
+{
+  BenchTreeBuild<KDTree<EuclideanDistance, EmptyStatistic, arma::mat>>(state);
+}
+
+MLPACK_BENCHMARK(BallTreeBuild)
+{
+  BenchTreeBuild<BallTree<EuclideanDistance, EmptyStatistic, arma::mat>>(
+      state);
+}
+
+MLPACK_BENCHMARK(RTreeBuild)
+{
+  BenchTreeBuild<RTree<EuclideanDistance, EmptyStatistic, arma::mat>>(state);
+}
+
+MLPACK_BENCHMARK(OctreeBuild)
+{
+  BenchTreeBuild<Octree<EuclideanDistance, EmptyStatistic, arma::mat>>(state);
+}
@@ -25,8 +25,9 @@ namespace cli {
  */
 inline void EndProgram(util::Params& params, util::Timers& timers)
 {
-  // Stop the timers.
+  // Stop the timers, and any memory meters that are still running.
   timers.StopAllTimers();
+  IO::GetMeters().StopAllMeters();
 
   // Print any output.
   std::map<std::string, util::ParamData>& parameters = params.Parameters();
@@ -77,6 +78,19 @@ inline void EndProgram(util::Params& params, util::Timers& timers)
     {
       Log::Info << "  " << it2.first << ": " << timers.Print(it2.second);
     }
+
+    // Print any memory meters that were run, in the same style as the timers.
+    std::map<std::string, util::MemoryUsage> meterMap =
+        MemoryMeter::GetAllMeters();
+    if (!meterMap.empty())
+    {
+      Log::Info << "Program memory usage:" << std::endl;
+      for (auto& it2 : meterMap)
+      {
+        Log::Info << "  " << it2.first << ": "
+            << util::MemoryMeters::Print(it2.second);
+      }
+    }
   }
 
   // Lastly clean up any memory.  If we are holding any pointers, then we "own"
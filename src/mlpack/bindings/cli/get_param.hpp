@@ -37,6 +37,35 @@ T& GetParam(
   return *MLPACK_ANY_CAST<T>(&d.value);
 }
 
+/**
+ * Try to memory-map a dense matrix parameter instead of reading it; see
+ * data::LoadMapped().  Mapping is opt-in via the MLPACK_MMAP_MATRICES
+ * environment variable, and only Armadillo binary files that need no
+ * transpose qualify, so this returns false (and the caller falls back to
+ * data::Load()) in all other cases.
+ */
+template<typename T>
+bool TryLoadMapped(
+    const std::string& filename,
+    T& matrix,
+    const bool transpose,
+    const typename std::enable_if<arma::is_Mat_only<T>::value>::type* = 0)
+{
+  if (std::getenv("MLPACK_MMAP_MATRICES") == NULL)
+    return false;
+  return data::LoadMapped(filename, matrix, transpose);
+}
+
+template<typename T>
+bool TryLoadMapped(
+    const std::string& /* filename */,
+    T& /* matrix */,
+    const bool /* transpose */,
+    const typename std::enable_if<!arma::is_Mat_only<T>::value>::type* = 0)
+{
+  return false;
+}
+
 /**
  * Return a matrix parameter.
  *
@@ -50,7 +79,9 @@ T& GetParam(
   // If the matrix is an input matrix, we have to load the matrix.  'value'
   // contains the filename.  It's possible we could load empty matrices many
   // times, but I am not bothered by that---it shouldn't be something that
-  // happens.
+  // happens.  Loading happens here, on first access, not when the binding
+  // starts, so parameters the chosen code path never touches are never read
+  // from disk.
   typedef std::tuple<T, typename ParameterType<T>::type> TupleType;
   TupleType& tuple = *MLPACK_ANY_CAST<TupleType>(&d.value);
   const std::string& value = std::get<0>(std::get<1>(tuple));
@@ -59,8 +90,13 @@ T& GetParam(
   size_t& n_cols = std::get<2>(std::get<1>(tuple));
   if (d.input && !d.loaded)
   {
-    // Call correct data::Load() function.
-    if (arma::is_Row<T>::value || arma::is_Col<T>::value)
+    // Map the file if the user asked for that and the format allows it;
+    // otherwise call the correct data::Load() function.
+    if (TryLoadMapped(value, matrix, !d.noTranspose))
+    {
+      // Nothing more to do; the matrix aliases the mapped file.
+    }
+    else if (arma::is_Row<T>::value || arma::is_Col<T>::value)
       data::Load(value, matrix, true);
     else
       data::Load(value, matrix, true, !d.noTranspose);
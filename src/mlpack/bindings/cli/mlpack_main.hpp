@@ -88,6 +88,7 @@ using Option = mlpack::bindings::cli::CLIOption<T>;
 #include <mlpack/core/util/io.hpp>
 #include <mlpack/bindings/cli/parse_command_line.hpp>
 #include <mlpack/bindings/cli/end_program.hpp>
+#include <mlpack/bindings/cli/server_mode.hpp>
 
 // Forward definition of the binding function.
 void BINDING_FUNCTION(mlpack::util::Params&, mlpack::util::Timers&);
@@ -95,6 +96,12 @@ void BINDING_FUNCTION(mlpack::util::Params&, mlpack::util::Timers&);
 // Define the main function that will be used by this binding.
 int main(int argc, char** argv)
 {
+  // If --server was passed, run as a persistent server: parameter sets are
+  // read line-by-line from standard input, and loaded input models are kept
+  // warm between requests.
+  if (mlpack::bindings::cli::ServerModeRequested(argc, argv))
+    return mlpack::bindings::cli::RunServer(argc, argv, &BINDING_FUNCTION);
+
   // Parse the command-line options; put them into CLI.
   mlpack::util::Params params =
       mlpack::bindings::cli::ParseCommandLine(argc, argv);
@@ -102,10 +109,14 @@ int main(int argc, char** argv)
   mlpack::util::Timers timers;
   timers.Enabled() = true;
   mlpack::Timer::EnableTiming();
+  mlpack::MemoryMeter::EnableMetering();
 
-  // A "total_time" timer is run by default for each mlpack program.
+  // A "total_time" timer and a "total" memory meter are run by default for
+  // each mlpack program.
   timers.Start("total_time");
+  mlpack::MemoryMeter::Start("total");
   BINDING_FUNCTION(params, timers);
+  mlpack::MemoryMeter::Stop("total");
   timers.Stop("total_time");
 
   // Print output options, print verbose information, save model parameters,
@@ -121,6 +132,9 @@ PARAM_GLOBAL(std::string, "info", "Print help on a specific option.", "",
 PARAM_GLOBAL(bool, "verbose", "Display informational messages and the full "
     "list of parameters and timers at the end of execution.", "v", "bool",
     false, true, false, false);
+PARAM_GLOBAL(bool, "server", "Run in persistent server mode, reading one "
+    "parameter set per line from standard input and caching loaded input "
+    "models between requests.", "", "bool", false, true, false, false);
 PARAM_GLOBAL(bool, "version", "Display the version of mlpack.", "V", "bool",
     false, true, false, false);
 
@@ -0,0 +1,298 @@
+/**
+ * @file bindings/cli/server_mode.hpp
+ * @author Ryan Curtin
+ *
+ * Persistent server mode for CLI bindings.  When a binding is started with
+ * --server, it does not run once and exit; instead it reads one parameter set
+ * per line from standard input, runs the binding for each, and streams the
+ * results back.  Input models are cached between requests by filename, so a
+ * model that takes minutes to load can serve many short queries.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_SERVER_MODE_HPP
+#define MLPACK_BINDINGS_CLI_SERVER_MODE_HPP
+
+#include <mlpack/core/util/io.hpp>
+#include "parse_command_line.hpp"
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+/**
+ * Returns true if --server was given on the command line.  This is checked
+ * before regular command-line parsing, since in server mode the other
+ * parameters come per-request over standard input.
+ */
+inline bool ServerModeRequested(int argc, char** argv)
+{
+  for (int i = 1; i < argc; ++i)
+    if (std::string(argv[i]) == "--server")
+      return true;
+  return false;
+}
+
+/**
+ * Split one request line into command-line style tokens, honoring single and
+ * double quotes and backslash escapes.
+ */
+inline std::vector<std::string> SplitCommandLine(const std::string& line)
+{
+  std::vector<std::string> tokens;
+  std::string current = "";
+  bool inToken = false;
+  char quote = '\0';
+
+  for (size_t i = 0; i < line.size(); ++i)
+  {
+    const char c = line[i];
+    if (quote != '\0')
+    {
+      if (c == quote)
+        quote = '\0';
+      else
+        current += c;
+    }
+    else if (c == '\'' || c == '"')
+    {
+      quote = c;
+      inToken = true;
+    }
+    else if (c == '\\' && i + 1 < line.size())
+    {
+      current += line[++i];
+      inToken = true;
+    }
+    else if (c == ' ' || c == '\t')
+    {
+      if (inToken)
+        tokens.push_back(current);
+      current = "";
+      inToken = false;
+    }
+    else
+    {
+      current += c;
+      inToken = true;
+    }
+  }
+  if (inToken)
+    tokens.push_back(current);
+
+  return tokens;
+}
+
+//! An input model kept warm between server requests.
+struct CachedModel
+{
+  //! The filename the model was loaded from; the cache key is valid only as
+  //! long as the request names the same file.
+  std::string filename;
+  //! A copy of the parameter data; its value tuple holds the loaded pointer.
+  util::ParamData data;
+  //! The loaded model pointer (also held inside data).
+  void* pointer;
+};
+
+/**
+ * Before running a request, hand any cached models to the new Params object,
+ * so that the binding's GetParam() call does not reload them from disk.  A
+ * cached model whose parameter now names a different file is deleted, and the
+ * request will load the new file as usual.
+ */
+inline void InjectCachedModels(util::Params& params,
+                               std::map<std::string, CachedModel>& cache)
+{
+  std::map<std::string, util::ParamData>& parameters = params.Parameters();
+  for (auto& it : parameters)
+  {
+    util::ParamData& d = it.second;
+    if (!d.input || !d.wasPassed)
+      continue;
+
+    std::map<std::string, CachedModel>::iterator cit = cache.find(d.name);
+    if (cit == cache.end())
+      continue;
+
+    // For serializable parameters the printable form is the filename.
+    std::string filename;
+    params.functionMap[d.tname]["GetPrintableParam"](d, NULL,
+        (void*) &filename);
+
+    if (filename == cit->second.filename)
+    {
+      // Reuse the loaded model: copy the value tuple holding the pointer.
+      d.value = cit->second.data.value;
+      d.loaded = true;
+    }
+    else
+    {
+      // The request names a different file; drop the stale model.
+      params.functionMap[d.tname]["DeleteAllocatedMemory"](cit->second.data,
+          NULL, NULL);
+      cache.erase(cit);
+    }
+  }
+}
+
+/**
+ * After a request has run, print its outputs, cache the input models that
+ * were loaded, and free everything else.  This mirrors EndProgram(), except
+ * that cached models survive the request.
+ *
+ * Note that caching assumes the binding does not mutate its input model; that
+ * holds for the query-style invocations server mode is meant for.
+ */
+inline void FinishRequest(util::Params& params,
+                          util::Timers& timers,
+                          std::map<std::string, CachedModel>& cache)
+{
+  timers.StopAllTimers();
+
+  // Print any output.
+  std::map<std::string, util::ParamData>& parameters = params.Parameters();
+  for (auto& it : parameters)
+  {
+    util::ParamData& d = it.second;
+    if (!d.input)
+      params.functionMap[d.tname]["OutputParam"](d, NULL, NULL);
+  }
+
+  if (params.Has("verbose"))
+  {
+    Log::Info << "Program timers:" << std::endl;
+    std::map<std::string, std::chrono::microseconds> timerMap =
+        timers.GetAllTimers();
+    for (auto& it2 : timerMap)
+    {
+      Log::Info << "  " << it2.first << ": " << timers.Print(it2.second);
+    }
+  }
+
+  // Cache any input models that this request loaded.
+  for (auto& it : parameters)
+  {
+    util::ParamData& d = it.second;
+    if (!d.input || !d.wasPassed)
+      continue;
+
+    void* pointer;
+    params.functionMap[d.tname]["GetAllocatedMemory"](d, NULL,
+        (void*) &pointer);
+    if (pointer == NULL)
+      continue;
+
+    std::string filename;
+    params.functionMap[d.tname]["GetPrintableParam"](d, NULL,
+        (void*) &filename);
+    cache[d.name] = CachedModel{ filename, d, pointer };
+  }
+
+  // Collect the addresses of cached models, which must not be freed.
+  std::unordered_map<void*, bool> cachedAddresses;
+  for (auto& it : cache)
+    cachedAddresses[it.second.pointer] = true;
+
+  // Free everything else, being careful (like EndProgram()) not to free the
+  // same pointer twice.
+  std::unordered_map<void*, util::ParamData*> memoryAddresses;
+  for (auto& it : parameters)
+  {
+    util::ParamData& d = it.second;
+
+    void* result;
+    params.functionMap[d.tname]["GetAllocatedMemory"](d, NULL,
+        (void*) &result);
+    if (result != NULL && memoryAddresses.count(result) == 0 &&
+        cachedAddresses.count(result) == 0)
+      memoryAddresses[result] = &d;
+  }
+
+  for (auto& it : memoryAddresses)
+  {
+    util::ParamData& d = *(it.second);
+    params.functionMap[d.tname]["DeleteAllocatedMemory"](d, NULL, NULL);
+  }
+}
+
+/**
+ * Run the binding as a persistent server.  Each line read from standard input
+ * is one full parameter set, in the same syntax as the command line; the
+ * binding runs once per line, and a status line is printed (and flushed)
+ * after each request: "[DONE]" on success, or "[ERROR] <message>".  An empty
+ * line is ignored, and "exit" or "quit" stops the server.
+ *
+ * @param argc Number of command-line arguments the server was started with.
+ * @param argv Command-line arguments the server was started with.
+ * @param bindingFunction The binding function to run per request.
+ */
+inline int RunServer(int /* argc */,
+                     char** argv,
+                     void (*bindingFunction)(util::Params&, util::Timers&))
+{
+  std::map<std::string, CachedModel> cache;
+  // Kept alive so that cached models can be freed at shutdown via the
+  // function map.
+  std::unique_ptr<util::Params> lastParams;
+
+  std::string line;
+  while (std::getline(std::cin, line))
+  {
+    if (line.find_first_not_of(" \t") == std::string::npos)
+      continue;
+    if (line == "exit" || line == "quit")
+      break;
+
+    // Build an argv for this request, reusing the program name.
+    const std::vector<std::string> tokens = SplitCommandLine(line);
+    std::vector<char*> requestArgv;
+    requestArgv.push_back(argv[0]);
+    for (const std::string& token : tokens)
+      requestArgv.push_back(const_cast<char*>(token.c_str()));
+
+    try
+    {
+      util::Params params = ParseCommandLine((int) requestArgv.size(),
+          requestArgv.data());
+      InjectCachedModels(params, cache);
+
+      util::Timers timers;
+      timers.Enabled() = true;
+      timers.Start("total_time");
+      bindingFunction(params, timers);
+      timers.Stop("total_time");
+
+      FinishRequest(params, timers, cache);
+      lastParams.reset(new util::Params(params));
+
+      std::cout << "[DONE]" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+      std::cout << "[ERROR] " << e.what() << std::endl;
+    }
+    std::cout.flush();
+  }
+
+  // Free the cached models before shutting down.
+  if (lastParams)
+  {
+    for (auto& it : cache)
+    {
+      lastParams->functionMap[it.second.data.tname]["DeleteAllocatedMemory"](
+          it.second.data, NULL, NULL);
+    }
+  }
+
+  return 0;
+}
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
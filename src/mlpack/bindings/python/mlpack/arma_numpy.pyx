@@ -50,13 +50,24 @@ cdef arma.Mat[double]* numpy_to_mat_d(numpy.ndarray[numpy.double_t, ndim=2] X, \
                                       bool takeOwnership) except +:
   """
   Convert a numpy ndarray to a matrix.  The memory will still be owned by numpy.
+
+  A copy is made only on layout mismatch: the Armadillo matrix is a borrowed
+  column-major view of the transposed array, so any C-contiguous buffer can be
+  used in place (including views and externally-owned memory such as a
+  memory-mapped frame, as long as no ownership transfer is requested).
+  Fortran-ordered arrays hold the transpose of the layout Armadillo needs here
+  and are copied once.
   """
   cdef int flags = PyArray_FLAGS(X)
-  if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory.
+  if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS):
+    # The layout does not match; we need one copy.
     X = X.copy(order="C")
     takeOwnership = True
+  elif takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin:
+    # We are asked to take ownership, but numpy does not own this buffer (it
+    # is a view or externally-owned memory), so we cannot steal it; make a
+    # copy that we do own.
+    X = X.copy(order="C")
 
   cdef arma.Mat[double]* m = new arma.Mat[double](<double*> PyArray_DATA(X),
       PyArray_SHAPE(X)[1], PyArray_SHAPE(X)[0], isWin, False)
@@ -72,14 +83,20 @@ cdef arma.Mat[size_t]* numpy_to_mat_s(numpy.ndarray[numpy.npy_intp, ndim=2] X, \
                                       bool takeOwnership) except +:
   """
   Convert a numpy ndarray to a matrix.  The memory will still be owned by numpy.
+
+  A copy is made only on layout mismatch, or when ownership transfer is
+  requested for a buffer that numpy does not own; see numpy_to_mat_d().
   """
   cdef int flags = PyArray_FLAGS(X)
-  if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS):
+    # The layout does not match; we need one copy.
     X = X.copy(order="C")
     takeOwnership = True
+  elif takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin:
+    # We are asked to take ownership, but numpy does not own this buffer (it
+    # is a view or externally-owned memory), so we cannot steal it; make a
+    # copy that we do own.
+    X = X.copy(order="C")
 
   cdef arma.Mat[size_t]* m = new arma.Mat[size_t](<size_t*> PyArray_DATA(X),
       PyArray_SHAPE(X)[1], PyArray_SHAPE(X)[0], isWin, False)
@@ -140,12 +157,15 @@ cdef arma.Row[double]* numpy_to_row_d(numpy.ndarray[numpy.double_t, ndim=1] X, \
   owned by numpy.
   """
   cdef int flags = PyArray_FLAGS(X)
-  if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS):
+    # The layout does not match; we need one copy.
     X = X.copy(order="C")
     takeOwnership = True
+  elif takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin:
+    # We are asked to take ownership, but numpy does not own this buffer (it
+    # is a view or externally-owned memory), so we cannot steal it; make a
+    # copy that we do own.
+    X = X.copy(order="C")
 
   cdef arma.Row[double]* m = new arma.Row[double](<double*> PyArray_DATA(X),
     PyArray_SHAPE(X)[0], isWin, False)
@@ -164,12 +184,15 @@ cdef arma.Row[size_t]* numpy_to_row_s(numpy.ndarray[numpy.npy_intp, ndim=1] X, \
   owned by numpy.
   """
   cdef int flags = PyArray_FLAGS(X)
-  if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS):
+    # The layout does not match; we need one copy.
     X = X.copy(order="C")
     takeOwnership = True
+  elif takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin:
+    # We are asked to take ownership, but numpy does not own this buffer (it
+    # is a view or externally-owned memory), so we cannot steal it; make a
+    # copy that we do own.
+    X = X.copy(order="C")
 
   cdef arma.Row[size_t]* m = new arma.Row[size_t](<size_t*> PyArray_DATA(X),
       PyArray_SHAPE(X)[0], isWin, False)
@@ -227,12 +250,15 @@ cdef arma.Col[double]* numpy_to_col_d(numpy.ndarray[numpy.double_t, ndim=1] X, \
   still be owned by numpy.
   """
   cdef int flags = PyArray_FLAGS(X)
-  if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS):
+    # The layout does not match; we need one copy.
     X = X.copy(order="C")
     takeOwnership = True
+  elif takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin:
+    # We are asked to take ownership, but numpy does not own this buffer (it
+    # is a view or externally-owned memory), so we cannot steal it; make a
+    # copy that we do own.
+    X = X.copy(order="C")
 
   cdef arma.Col[double]* m = new arma.Col[double](<double*> PyArray_DATA(X),
       PyArray_SHAPE(X)[0], isWin, False)
@@ -251,12 +277,15 @@ cdef arma.Col[size_t]* numpy_to_col_s(numpy.ndarray[numpy.npy_intp, ndim=1] X, \
   still be owned by numpy.
   """
   cdef int flags = PyArray_FLAGS(X)
-  if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS):
+    # The layout does not match; we need one copy.
     X = X.copy(order="C")
     takeOwnership = True
+  elif takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin:
+    # We are asked to take ownership, but numpy does not own this buffer (it
+    # is a view or externally-owned memory), so we cannot steal it; make a
+    # copy that we do own.
+    X = X.copy(order="C")
 
   cdef arma.Col[size_t]* m = new arma.Col[size_t](<size_t*> PyArray_DATA(X), 
       PyArray_SHAPE(X)[0], isWin, False)
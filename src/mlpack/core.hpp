@@ -39,6 +39,7 @@
 #include <mlpack/core/util/log.hpp>
 #include <mlpack/core/util/io.hpp>
 #include <mlpack/core/util/deprecated.hpp>
+#include <mlpack/core/util/execution_policy.hpp>
 #include <mlpack/core/data/data.hpp>
 #include <mlpack/core/math/math.hpp>
 
@@ -55,6 +56,7 @@
 // Include cross-validation and hyperparameter tuning framework.
 #include <mlpack/core/cv/cv.hpp>
 #include <mlpack/core/hpt/hpt.hpp>
+#include <mlpack/core/hpt/successive_halving.hpp>
 
 // Use OpenMP if available.
 #ifdef MLPACK_USE_OPENMP
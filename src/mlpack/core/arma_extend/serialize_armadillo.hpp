@@ -25,6 +25,46 @@
  */
 namespace cereal {
 
+// Whether the archive stores raw bytes, so that a contiguous block of
+// elements can be read or written as a single blob instead of one element at
+// a time.  For large matrices the element-wise path is dominated by
+// per-element archive overhead, which makes model checkpointing very slow.
+template<typename Archive>
+struct is_binary_archive
+{
+  static const bool value =
+      std::is_same<Archive, BinaryInputArchive>::value ||
+      std::is_same<Archive, BinaryOutputArchive>::value ||
+      std::is_same<Archive, PortableBinaryInputArchive>::value ||
+      std::is_same<Archive, PortableBinaryOutputArchive>::value;
+};
+
+// Serialize a contiguous block of elements as one raw blob.  For the
+// non-portable binary archive this produces a byte-identical stream to the
+// element-wise loop below, so models saved by older versions still load; the
+// portable binary archive handles any needed endianness conversion itself.
+template<typename Archive, typename eT>
+typename std::enable_if<is_binary_archive<Archive>::value &&
+    std::is_arithmetic<eT>::value, void>::type
+serialize_block(Archive& ar, const char* /* name */, eT* mem,
+                const arma::uword n_elem)
+{
+  ar(cereal::binary_data(mem, n_elem * sizeof(eT)));
+}
+
+// Serialize a contiguous block of elements one at a time.  This is used for
+// the text archives (XML and JSON), where each element must appear as its own
+// named node, and for element types that are not plain arithmetic types.
+template<typename Archive, typename eT>
+typename std::enable_if<!is_binary_archive<Archive>::value ||
+    !std::is_arithmetic<eT>::value, void>::type
+serialize_block(Archive& ar, const char* name, eT* mem,
+                const arma::uword n_elem)
+{
+  for (size_t i = 0; i < n_elem; ++i)
+    ar(cereal::make_nvp(name, mem[i]));
+}
+
 template<typename Archive, typename eT>
 void serialize(Archive& ar, arma::SpMat<eT>& mat)
 {
@@ -51,12 +91,11 @@ void serialize(Archive& ar, arma::SpMat<eT>& mat)
   }
 
   // Serialize the values held in the sparse matrix.
-  for (size_t i = 0; i < mat.n_nonzero; ++i)
-    ar(cereal::make_nvp("value", arma::access::rw(mat.values[i])));
-  for (size_t i = 0; i < mat.n_nonzero; ++i)
-    ar(cereal::make_nvp("row_index", arma::access::rw(mat.row_indices[i])));
-  for (size_t i = 0; i < mat.n_cols + 1; ++i)
-    ar(cereal::make_nvp("col_ptr", arma::access::rw(mat.col_ptrs[i])));
+  serialize_block(ar, "value", arma::access::rwp(mat.values), mat.n_nonzero);
+  serialize_block(ar, "row_index", arma::access::rwp(mat.row_indices),
+      mat.n_nonzero);
+  serialize_block(ar, "col_ptr", arma::access::rwp(mat.col_ptrs),
+      mat.n_cols + 1);
 }
 
 // Add an external serialization function for Mat.
@@ -79,8 +118,7 @@ void serialize(Archive& ar, arma::Mat<eT>& mat)
   }
 
   // Directly serialize the contents of the matrix's memory.
-  for (size_t i = 0; i < mat.n_elem; ++i)
-    ar(cereal::make_nvp("elem", arma::access::rw(mat.mem[i])));
+  serialize_block(ar, "elem", arma::access::rwp(mat.mem), mat.n_elem);
 }
 
 // Add a serialization function for armadillo Cube
@@ -100,8 +138,7 @@ void serialize(Archive& ar, arma::Cube<eT>& cube)
     cube.set_size(n_rows, n_cols, n_slices);
 
   // Directly serialize the contents of the cube's memory.
-  for (size_t i = 0; i < cube.n_elem; ++i)
-    ar(cereal::make_nvp("elem", arma::access::rw(cube.mem[i])));
+  serialize_block(ar, "elem", arma::access::rwp(cube.mem), cube.n_elem);
 }
 
 } // end namespace cereal
@@ -43,6 +43,12 @@ namespace mlpack {
  * the @c Shuffle() function.  Shuffling is performed at construction time if
  * the parameter @c shuffle is set to @c true in the constructor.
  *
+ * If mlpack is built with OpenMP support, the folds are trained and
+ * evaluated concurrently.  Each fold trains on a view of the internal
+ * dataset (no copies are made), and the thread-local random generator of
+ * each fold is seeded deterministically from the global generator, so the
+ * result does not depend on how the folds are scheduled across threads.
+ *
  * @tparam MLAlgorithm A machine learning algorithm.
  * @tparam Metric A metric to assess the quality of a trained model.
  * @tparam MatType The type of data.
@@ -245,13 +245,49 @@ double KFoldCV<MLAlgorithm,
 {
   arma::vec evaluations(k);
 
+  // Pre-draw one seed per fold from the global generator, so that each fold
+  // trains from the same random state no matter which thread runs it or in
+  // which order the folds are scheduled.
+  std::vector<uint32_t> seeds(k);
+  for (size_t i = 0; i < k; ++i)
+    seeds[i] = (uint32_t) RandGen()();
+
+  // The folds train concurrently; an exception thrown by a fold is captured
+  // (keeping the one of the earliest fold, for determinism) and rethrown
+  // once all folds have finished.
+  std::exception_ptr foldException = nullptr;
+  size_t exceptionFold = k;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < k; ++i)
+  {
+    try
+    {
+      RandGen().seed(seeds[i]);
+      MLAlgorithm&& model  = base.Train(GetTrainingSubset(xs, i),
+          GetTrainingSubset(ys, i), args...);
+      evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
+          GetValidationSubset(ys, i));
+      if (i == k - 1)
+        modelPtr.reset(new MLAlgorithm(std::move(model)));
+    }
+    catch (...)
+    {
+      #pragma omp critical (KFoldCVError)
+      if (i < exceptionFold)
+      {
+        exceptionFold = i;
+        foldException = std::current_exception();
+      }
+    }
+  }
+
+  if (foldException)
+    std::rethrow_exception(foldException);
+
   size_t numInvalidScores = 0;
   for (size_t i = 0; i < k; ++i)
   {
-    MLAlgorithm&& model  = base.Train(GetTrainingSubset(xs, i),
-        GetTrainingSubset(ys, i), args...);
-    evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
-        GetValidationSubset(ys, i));
     if (std::isnan(evaluations(i)) || std::isinf(evaluations(i)))
     {
       ++numInvalidScores;
@@ -259,8 +295,6 @@ double KFoldCV<MLAlgorithm,
           << "a score of " << evaluations(i) << "; ignoring when computing "
           << "the average score." << std::endl;
     }
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
   }
 
   if (numInvalidScores == k)
@@ -287,19 +321,49 @@ double KFoldCV<MLAlgorithm,
 {
   arma::vec evaluations(k);
 
+  // Pre-draw one seed per fold from the global generator, so that each fold
+  // trains from the same random state no matter which thread runs it or in
+  // which order the folds are scheduled.
+  std::vector<uint32_t> seeds(k);
+  for (size_t i = 0; i < k; ++i)
+    seeds[i] = (uint32_t) RandGen()();
+
+  // The folds train concurrently; an exception thrown by a fold is captured
+  // (keeping the one of the earliest fold, for determinism) and rethrown
+  // once all folds have finished.
+  std::exception_ptr foldException = nullptr;
+  size_t exceptionFold = k;
+
+  #pragma omp parallel for schedule(dynamic)
   for (size_t i = 0; i < k; ++i)
   {
-    MLAlgorithm&& model = (weights.n_elem > 0) ?
-        base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
-            GetTrainingSubset(weights, i), args...) :
-        base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
-            args...);
-    evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
-        GetValidationSubset(ys, i));
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
+    try
+    {
+      RandGen().seed(seeds[i]);
+      MLAlgorithm&& model = (weights.n_elem > 0) ?
+          base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
+              GetTrainingSubset(weights, i), args...) :
+          base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
+              args...);
+      evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
+          GetValidationSubset(ys, i));
+      if (i == k - 1)
+        modelPtr.reset(new MLAlgorithm(std::move(model)));
+    }
+    catch (...)
+    {
+      #pragma omp critical (KFoldCVError)
+      if (i < exceptionFold)
+      {
+        exceptionFold = i;
+        foldException = std::current_exception();
+      }
+    }
   }
 
+  if (foldException)
+    std::rethrow_exception(foldException);
+
   return arma::mean(evaluations);
 }
 
@@ -390,8 +454,7 @@ arma::Mat<ElementType> KFoldCV<MLAlgorithm,
   const size_t subsetSize = (i != 0) ? lastBinSize + (k - 2) * binSize :
       (k - 1) * binSize;
 
-  return arma::Mat<ElementType>(m.colptr(binSize * i), m.n_rows, subsetSize,
-      false, true);
+  return MakeColsAlias(m, binSize * i, subsetSize);
 }
 
 template<typename MLAlgorithm,
@@ -414,7 +477,7 @@ arma::Row<ElementType> KFoldCV<MLAlgorithm,
   const size_t subsetSize = (i != 0) ? lastBinSize + (k - 2) * binSize :
       (k - 1) * binSize;
 
-  return arma::Row<ElementType>(r.colptr(binSize * i), subsetSize, false, true);
+  return MakeColsAlias(r, binSize * i, subsetSize);
 }
 
 template<typename MLAlgorithm,
@@ -432,8 +495,7 @@ arma::Mat<ElementType> KFoldCV<MLAlgorithm,
     const size_t i)
 {
   const size_t subsetSize = (i == 0) ? lastBinSize : binSize;
-  return arma::Mat<ElementType>(m.colptr(ValidationSubsetFirstCol(i)), m.n_rows,
-      subsetSize, false, true);
+  return MakeColsAlias(m, ValidationSubsetFirstCol(i), subsetSize);
 }
 
 template<typename MLAlgorithm,
@@ -451,8 +513,7 @@ arma::Row<ElementType> KFoldCV<MLAlgorithm,
     const size_t i)
 {
   const size_t subsetSize = (i == 0) ? lastBinSize : binSize;
-  return arma::Row<ElementType>(r.colptr(ValidationSubsetFirstCol(i)),
-      subsetSize, false, true);
+  return MakeColsAlias(r, ValidationSubsetFirstCol(i), subsetSize);
 }
 
 } // namespace mlpack
@@ -17,6 +17,7 @@
 #include "average_strategy.hpp"
 #include "f1.hpp"
 #include "mse.hpp"
+#include "multi_metric.hpp"
 #include "precision.hpp"
 #include "r2_score.hpp"
 #include "recall.hpp"
@@ -0,0 +1,164 @@
+/**
+ * @file core/cv/metrics/multi_metric.hpp
+ * @author Kirill Mishchenko
+ *
+ * Evaluation of several metrics from a single inference pass.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_MULTI_METRIC_HPP
+#define MLPACK_CORE_CV_METRICS_MULTI_METRIC_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * A model proxy that replays cached predictions.  Its Classify() and
+ * Predict() methods ignore the passed data and output the predictions it was
+ * constructed with, so a metric evaluated against it computes its value
+ * without running inference again.
+ *
+ * This class is not supposed to be used directly by users; see MultiMetric.
+ *
+ * @tparam PredictionsType The type of the cached predictions.
+ */
+template<typename PredictionsType>
+class PredictionCache
+{
+ public:
+  /**
+   * Construct the proxy around the given predictions.
+   *
+   * @param predictions Predictions made by a real model.
+   */
+  PredictionCache(const PredictionsType& predictions) :
+      predictions(predictions)
+  { }
+
+  /**
+   * "Classify" the given data by outputting the cached predictions.
+   *
+   * @param * (data) The data to classify (ignored).
+   * @param out The output to store the cached predictions in.
+   */
+  template<typename DataType, typename OutType>
+  void Classify(const DataType& /* data */, OutType& out) const
+  {
+    out = predictions;
+  }
+
+  /**
+   * "Predict" responses for the given data by outputting the cached
+   * predictions.
+   *
+   * @param * (data) The data to predict responses for (ignored).
+   * @param out The output to store the cached predictions in.
+   */
+  template<typename DataType, typename OutType>
+  void Predict(const DataType& /* data */, OutType& out) const
+  {
+    out = predictions;
+  }
+
+ private:
+  //! A reference to the cached predictions.
+  const PredictionsType& predictions;
+};
+
+/**
+ * MultiMetric evaluates a set of metrics, declared up front as template
+ * arguments, from a single inference pass: the model's Classify() or
+ * Predict() method is called once, the predictions are cached, and every
+ * metric is computed from the cache.  When several metrics are needed (for
+ * example Accuracy, Precision, Recall and F1 of the same model), this
+ * divides the inference cost by the number of metrics compared to calling
+ * Evaluate() of each metric separately.
+ *
+ * @code
+ * LogisticRegression<> lr(data, labels);
+ *
+ * arma::vec scores = MultiMetric<Accuracy, Precision<Binary>,
+ *     Recall<Binary>, F1<Binary>>::EvaluateAll(lr, data, labels);
+ * @endcode
+ *
+ * MultiMetric can also be used in place of a single metric in SimpleCV,
+ * KFoldCV, or HyperParameterTuner; in that case the value of the first
+ * metric is reported (and drives tuning), and NeedsMinimization is taken
+ * from the first metric.
+ *
+ * All passed metrics should run inference through a single call of
+ * Classify() or Predict() with the validation data, like the metrics from
+ * core/cv/metrics do.
+ *
+ * @tparam FirstMetric The metric whose value Evaluate() reports.
+ * @tparam Metrics The remaining metrics to evaluate.
+ */
+template<typename FirstMetric, typename... Metrics>
+class MultiMetric
+{
+ public:
+  /**
+   * Run inference once and calculate all metrics from the cached
+   * predictions.  The values are returned in the order in which the metrics
+   * are passed as template arguments.
+   *
+   * @param model A model to evaluate.
+   * @param data Column-major data containing test items.
+   * @param responses Ground truth (correct) labels or responses for the test
+   *     items.
+   */
+  template<typename MLAlgorithm, typename DataType, typename ResponsesType>
+  static arma::vec EvaluateAll(MLAlgorithm& model,
+                               const DataType& data,
+                               const ResponsesType& responses);
+
+  /**
+   * Run inference once and calculate the first metric (this is the interface
+   * that SimpleCV, KFoldCV and HyperParameterTuner use).
+   *
+   * @param model A model to evaluate.
+   * @param data Column-major data containing test items.
+   * @param responses Ground truth (correct) labels or responses for the test
+   *     items.
+   */
+  template<typename MLAlgorithm, typename DataType, typename ResponsesType>
+  static double Evaluate(MLAlgorithm& model,
+                         const DataType& data,
+                         const ResponsesType& responses);
+
+  /**
+   * Information for hyper-parameter tuning code.  Taken from the first
+   * metric.
+   */
+  static const bool NeedsMinimization = FirstMetric::NeedsMinimization;
+
+ private:
+  /**
+   * Run inference through Classify() in the case of classification (the
+   * ground truth is a row of labels).
+   */
+  template<typename MLAlgorithm, typename DataType>
+  static void GetPredictions(MLAlgorithm& model,
+                             const DataType& data,
+                             arma::Row<size_t>& predictions);
+
+  /**
+   * Run inference through Predict() in the case of regression.
+   */
+  template<typename MLAlgorithm, typename DataType, typename ResponsesType>
+  static void GetPredictions(MLAlgorithm& model,
+                             const DataType& data,
+                             ResponsesType& predictions);
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "multi_metric_impl.hpp"
+
+#endif
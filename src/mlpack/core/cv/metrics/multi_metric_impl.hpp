@@ -0,0 +1,75 @@
+/**
+ * @file core/cv/metrics/multi_metric_impl.hpp
+ * @author Kirill Mishchenko
+ *
+ * The implementation of the class MultiMetric.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_MULTI_METRIC_IMPL_HPP
+#define MLPACK_CORE_CV_METRICS_MULTI_METRIC_IMPL_HPP
+
+namespace mlpack {
+
+template<typename FirstMetric, typename... Metrics>
+template<typename MLAlgorithm, typename DataType, typename ResponsesType>
+arma::vec MultiMetric<FirstMetric, Metrics...>::EvaluateAll(
+    MLAlgorithm& model,
+    const DataType& data,
+    const ResponsesType& responses)
+{
+  ResponsesType predictions;
+  GetPredictions(model, data, predictions);
+
+  // Each metric runs its "inference" against the proxy, which just replays
+  // the cached predictions.
+  PredictionCache<ResponsesType> cache(predictions);
+
+  arma::vec results(1 + sizeof...(Metrics));
+  size_t i = 0;
+  results(i++) = FirstMetric::Evaluate(cache, data, responses);
+  // The braced initializer guarantees left-to-right evaluation, so the
+  // values appear in the order of the template arguments.
+  const int dummy[] = { 0,
+      (results(i++) = Metrics::Evaluate(cache, data, responses), 0)... };
+  (void) dummy;
+
+  return results;
+}
+
+template<typename FirstMetric, typename... Metrics>
+template<typename MLAlgorithm, typename DataType, typename ResponsesType>
+double MultiMetric<FirstMetric, Metrics...>::Evaluate(
+    MLAlgorithm& model,
+    const DataType& data,
+    const ResponsesType& responses)
+{
+  return EvaluateAll(model, data, responses)(0);
+}
+
+template<typename FirstMetric, typename... Metrics>
+template<typename MLAlgorithm, typename DataType>
+void MultiMetric<FirstMetric, Metrics...>::GetPredictions(
+    MLAlgorithm& model,
+    const DataType& data,
+    arma::Row<size_t>& predictions)
+{
+  model.Classify(data, predictions);
+}
+
+template<typename FirstMetric, typename... Metrics>
+template<typename MLAlgorithm, typename DataType, typename ResponsesType>
+void MultiMetric<FirstMetric, Metrics...>::GetPredictions(
+    MLAlgorithm& model,
+    const DataType& data,
+    ResponsesType& predictions)
+{
+  model.Predict(data, predictions);
+}
+
+} // namespace mlpack
+
+#endif
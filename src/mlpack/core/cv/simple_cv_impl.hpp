@@ -257,8 +257,7 @@ arma::Mat<ElementType> SimpleCV<MLAlgorithm,
     const size_t firstCol,
     const size_t lastCol)
 {
-  return arma::Mat<ElementType>(m.colptr(firstCol), m.n_rows,
-      lastCol - firstCol + 1, false, true);
+  return MakeColsAlias(m, firstCol, lastCol - firstCol + 1);
 }
 
 template<typename MLAlgorithm,
@@ -276,8 +275,7 @@ arma::Row<ElementType> SimpleCV<MLAlgorithm,
     const size_t firstCol,
     const size_t lastCol)
 {
-  return arma::Row<ElementType>(r.colptr(firstCol), lastCol - firstCol + 1,
-      false, true);
+  return MakeColsAlias(r, firstCol, lastCol - firstCol + 1);
 }
 
 template<typename MLAlgorithm,
@@ -0,0 +1,304 @@
+/**
+ * @file core/data/columnar.hpp
+ * @author Ryan Curtin
+ *
+ * Save and load matrices in the mlpack columnar binary format, which stores
+ * each dimension of the dataset as a contiguous block so that individual
+ * dimensions can be loaded without materializing the whole dataset.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_COLUMNAR_HPP
+#define MLPACK_CORE_DATA_COLUMNAR_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <cstring>
+
+#include "dataset_mapper.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The mlpack columnar binary format lays a dataset out on disk one dimension
+ * at a time:
+ *
+ *  - an 8-byte magic string ("MLPKCOLB");
+ *  - six 64-bit header fields (version, element type code, number of
+ *    dimensions, number of points, mapper flag, mapper offset);
+ *  - one 64-bit file offset per dimension block;
+ *  - one contiguous block of raw element values per dimension; and
+ *  - optionally, a DatasetMapper serialized with cereal's binary archive.
+ *
+ * Because every dimension is a contiguous block with a known offset, a loader
+ * can seek to and read only the dimensions it needs; feature-selection
+ * workloads that touch a few dimensions do not pay for the rest of the file.
+ * Values are stored in the native byte order, like Armadillo's binary format.
+ */
+
+namespace detail {
+
+//! Magic string identifying the mlpack columnar binary format.
+const char columnarMagic[8] = { 'M', 'L', 'P', 'K', 'C', 'O', 'L', 'B' };
+
+//! A code describing the element type: hundreds digit encodes the kind
+//! (1: floating point, 2: signed integer, 3: unsigned integer), lower digits
+//! the element size in bytes.
+template<typename eT>
+uint64_t ColumnarTypeCode()
+{
+  const uint64_t kind = std::is_floating_point<eT>::value ? 1 :
+      (std::is_signed<eT>::value ? 2 : 3);
+  return kind * 100 + sizeof(eT);
+}
+
+} // namespace detail
+
+/**
+ * Save the given matrix (and optionally the given DatasetMapper) to the
+ * given file in the mlpack columnar binary format.  As everywhere in mlpack,
+ * points are the columns of the matrix and dimensions are the rows; each
+ * dimension is written as one contiguous block.
+ *
+ * @param filename Name of the file to write to.
+ * @param matrix Matrix to save.
+ * @param info DatasetMapper to store with the matrix, or NULL for none.
+ * @param fatal If true, an error will throw a std::runtime_error instead of
+ *     printing a warning.
+ * @return Boolean value indicating success or failure of the save.
+ */
+template<typename eT, typename PolicyType>
+bool SaveColumnar(const std::string& filename,
+                  const arma::Mat<eT>& matrix,
+                  const DatasetMapper<PolicyType>* info,
+                  const bool fatal = false)
+{
+  std::ofstream f(filename, std::ios::binary);
+  if (!f.is_open())
+  {
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "' for writing."
+          << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "' for writing."
+          << std::endl;
+    return false;
+  }
+
+  const uint64_t version = 1;
+  const uint64_t typeCode = detail::ColumnarTypeCode<eT>();
+  const uint64_t numDims = matrix.n_rows;
+  const uint64_t numPoints = matrix.n_cols;
+  const uint64_t hasMapper = (info == NULL) ? 0 : 1;
+  const uint64_t headerSize = sizeof(detail::columnarMagic) +
+      6 * sizeof(uint64_t) + numDims * sizeof(uint64_t);
+  const uint64_t mapperOffset = headerSize +
+      numDims * numPoints * sizeof(eT);
+
+  f.write(detail::columnarMagic, sizeof(detail::columnarMagic));
+  f.write((const char*) &version, sizeof(uint64_t));
+  f.write((const char*) &typeCode, sizeof(uint64_t));
+  f.write((const char*) &numDims, sizeof(uint64_t));
+  f.write((const char*) &numPoints, sizeof(uint64_t));
+  f.write((const char*) &hasMapper, sizeof(uint64_t));
+  f.write((const char*) &mapperOffset, sizeof(uint64_t));
+
+  // The dimension blocks are laid out back-to-back after the header.
+  for (uint64_t d = 0; d < numDims; ++d)
+  {
+    const uint64_t offset = headerSize + d * numPoints * sizeof(eT);
+    f.write((const char*) &offset, sizeof(uint64_t));
+  }
+
+  // Write each dimension as one contiguous block.
+  arma::Row<eT> dimension;
+  for (uint64_t d = 0; d < numDims; ++d)
+  {
+    dimension = matrix.row(d);
+    f.write((const char*) dimension.memptr(), numPoints * sizeof(eT));
+  }
+
+  if (hasMapper)
+  {
+    cereal::BinaryOutputArchive ar(f);
+    ar(cereal::make_nvp("info", *info));
+  }
+
+  return f.good();
+}
+
+/**
+ * Save the given matrix to the given file in the mlpack columnar binary
+ * format, without dataset metadata.
+ *
+ * @param filename Name of the file to write to.
+ * @param matrix Matrix to save.
+ * @param fatal If true, an error will throw a std::runtime_error instead of
+ *     printing a warning.
+ * @return Boolean value indicating success or failure of the save.
+ */
+template<typename eT>
+bool SaveColumnar(const std::string& filename,
+                  const arma::Mat<eT>& matrix,
+                  const bool fatal = false)
+{
+  return SaveColumnar<eT, IncrementPolicy>(filename, matrix,
+      (const DatasetMapper<IncrementPolicy>*) NULL, fatal);
+}
+
+/**
+ * Load the requested dimensions of a matrix stored in the mlpack columnar
+ * binary format.  Only the blocks of the requested dimensions are read from
+ * disk; the rest of the file is skipped entirely.  The loaded matrix has one
+ * row per requested dimension, in the requested order.
+ *
+ * @param filename Name of the file to read from.
+ * @param matrix Matrix to load into.
+ * @param dimensions The dimensions to load; if empty, all dimensions are
+ *     loaded.
+ * @param info If not NULL, the DatasetMapper stored in the file is loaded
+ *     into this object (the file must have been saved with one).
+ * @param fatal If true, an error will throw a std::runtime_error instead of
+ *     printing a warning.
+ * @return Boolean value indicating success or failure of the load.
+ */
+template<typename eT, typename PolicyType>
+bool LoadColumnar(const std::string& filename,
+                  arma::Mat<eT>& matrix,
+                  const std::vector<size_t>& dimensions,
+                  DatasetMapper<PolicyType>* info,
+                  const bool fatal = false)
+{
+  std::ifstream f(filename, std::ios::binary);
+  if (!f.is_open())
+  {
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "' for reading."
+          << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "' for reading."
+          << std::endl;
+    return false;
+  }
+
+  char magic[sizeof(detail::columnarMagic)];
+  uint64_t version, typeCode, numDims, numPoints, hasMapper, mapperOffset;
+  f.read(magic, sizeof(magic));
+  f.read((char*) &version, sizeof(uint64_t));
+  f.read((char*) &typeCode, sizeof(uint64_t));
+  f.read((char*) &numDims, sizeof(uint64_t));
+  f.read((char*) &numPoints, sizeof(uint64_t));
+  f.read((char*) &hasMapper, sizeof(uint64_t));
+  f.read((char*) &mapperOffset, sizeof(uint64_t));
+
+  if (!f.good() ||
+      std::memcmp(magic, detail::columnarMagic, sizeof(magic)) != 0 ||
+      version != 1)
+  {
+    if (fatal)
+      Log::Fatal << "'" << filename << "' is not an mlpack columnar binary "
+          << "file!" << std::endl;
+    else
+      Log::Warn << "'" << filename << "' is not an mlpack columnar binary "
+          << "file!" << std::endl;
+    return false;
+  }
+
+  if (typeCode != detail::ColumnarTypeCode<eT>())
+  {
+    if (fatal)
+      Log::Fatal << "Element type of '" << filename << "' does not match the "
+          << "element type of the matrix to load into!" << std::endl;
+    else
+      Log::Warn << "Element type of '" << filename << "' does not match the "
+          << "element type of the matrix to load into!" << std::endl;
+    return false;
+  }
+
+  // Read the per-dimension block offsets.
+  std::vector<uint64_t> offsets(numDims);
+  f.read((char*) offsets.data(), numDims * sizeof(uint64_t));
+
+  // An empty dimension list means "all dimensions".
+  std::vector<size_t> dims = dimensions;
+  if (dims.empty())
+  {
+    dims.resize(numDims);
+    for (size_t d = 0; d < numDims; ++d)
+      dims[d] = d;
+  }
+
+  matrix.set_size(dims.size(), numPoints);
+  std::vector<eT> block(numPoints);
+  for (size_t i = 0; i < dims.size(); ++i)
+  {
+    if (dims[i] >= numDims)
+    {
+      if (fatal)
+        Log::Fatal << "Requested dimension " << dims[i] << ", but '"
+            << filename << "' has only " << numDims << " dimensions!"
+            << std::endl;
+      else
+        Log::Warn << "Requested dimension " << dims[i] << ", but '"
+            << filename << "' has only " << numDims << " dimensions!"
+            << std::endl;
+      return false;
+    }
+
+    // Seek to the block of this dimension and read only that block.
+    f.seekg(std::streamoff(offsets[dims[i]]));
+    f.read((char*) block.data(), numPoints * sizeof(eT));
+    matrix.row(i) = arma::Row<eT>(block.data(), numPoints, false, true);
+  }
+
+  if (info != NULL)
+  {
+    if (!hasMapper)
+    {
+      if (fatal)
+        Log::Fatal << "'" << filename << "' does not contain dataset "
+            << "metadata!" << std::endl;
+      else
+        Log::Warn << "'" << filename << "' does not contain dataset "
+            << "metadata!" << std::endl;
+      return false;
+    }
+
+    f.seekg(std::streamoff(mapperOffset));
+    cereal::BinaryInputArchive ar(f);
+    ar(cereal::make_nvp("info", *info));
+  }
+
+  return f.good();
+}
+
+/**
+ * Load the requested dimensions of a matrix stored in the mlpack columnar
+ * binary format, without dataset metadata.
+ *
+ * @param filename Name of the file to read from.
+ * @param matrix Matrix to load into.
+ * @param dimensions The dimensions to load; if empty, all dimensions are
+ *     loaded.
+ * @param fatal If true, an error will throw a std::runtime_error instead of
+ *     printing a warning.
+ * @return Boolean value indicating success or failure of the load.
+ */
+template<typename eT>
+bool LoadColumnar(const std::string& filename,
+                  arma::Mat<eT>& matrix,
+                  const std::vector<size_t>& dimensions =
+                      std::vector<size_t>(),
+                  const bool fatal = false)
+{
+  return LoadColumnar<eT, IncrementPolicy>(filename, matrix, dimensions,
+      (DatasetMapper<IncrementPolicy>*) NULL, fatal);
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -14,6 +14,7 @@
 #define MLPACK_CORE_DATA_CONFUSION_MATRIX_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
 
 namespace mlpack {
 namespace data {
@@ -56,6 +57,31 @@ void ConfusionMatrix(const arma::Row<size_t> predictors,
                      arma::Mat<eT>& output,
                      const size_t numClasses);
 
+/**
+ * Compute confusion matrices for bootstrap resamples of the given
+ * predictions.  Each of the numSamples slices of the output cube is the
+ * confusion matrix of a resample of the (prediction, label) pairs, drawn
+ * with replacement; the distribution of a statistic over the slices gives
+ * confidence intervals and significance estimates for it.
+ *
+ * The pairs are flattened into a single index array once, and the
+ * replicates are computed concurrently if mlpack is built with OpenMP
+ * support; each replicate draws from its own deterministically seeded
+ * generator, so the result does not depend on the thread schedule.
+ *
+ * @param predictors Vector of predicted labels.
+ * @param responses The measured label for each point.
+ * @param outputs Cube to store one confusion matrix per slice in.
+ * @param numClasses Number of classes.
+ * @param numSamples Number of bootstrap resamples.
+ */
+template<typename eT>
+void BootstrapConfusionMatrix(const arma::Row<size_t>& predictors,
+                              const arma::Row<size_t>& responses,
+                              arma::Cube<eT>& outputs,
+                              const size_t numClasses,
+                              const size_t numSamples);
+
 } // namespace data
 } // namespace mlpack
 
@@ -53,10 +53,63 @@ void ConfusionMatrix(const arma::Row<size_t> predictors,
                      const size_t numClasses)
 {
   // Loop over the actual labels and predicted labels and add the count.
+  // Each thread counts into its own matrix, and the per-thread matrices are
+  // summed at the end.
   output = arma::zeros<arma::Mat<eT> >(numClasses, numClasses);
-  for (size_t i = 0; i < predictors.n_elem; ++i)
+  #pragma omp parallel
   {
-    output.at(predictors[i], responses[i])++;
+    arma::Mat<eT> localOutput(numClasses, numClasses, arma::fill::zeros);
+
+    #pragma omp for nowait
+    for (size_t i = 0; i < predictors.n_elem; ++i)
+    {
+      localOutput.at(predictors[i], responses[i])++;
+    }
+
+    #pragma omp critical (ConfusionMatrixReduce)
+    output += localOutput;
+  }
+}
+
+template<typename eT>
+void BootstrapConfusionMatrix(const arma::Row<size_t>& predictors,
+                              const arma::Row<size_t>& responses,
+                              arma::Cube<eT>& outputs,
+                              const size_t numClasses,
+                              const size_t numSamples)
+{
+  const size_t numPoints = predictors.n_elem;
+  if (numPoints == 0)
+    throw std::invalid_argument("BootstrapConfusionMatrix(): cannot resample "
+        "an empty set of predictions!");
+
+  // Flatten each (prediction, label) pair into a single index once, so that
+  // a bootstrap replicate only draws from this array and never touches the
+  // original rows again.
+  arma::Row<size_t> pairs(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+    pairs[i] = predictors[i] * numClasses + responses[i];
+
+  outputs.zeros(numClasses, numClasses, numSamples);
+
+  // Pre-draw one seed per replicate from the global generator, so that the
+  // result does not depend on how the replicates are scheduled across
+  // threads.
+  std::vector<uint32_t> seeds(numSamples);
+  for (size_t s = 0; s < numSamples; ++s)
+    seeds[s] = (uint32_t) RandGen()();
+
+  #pragma omp parallel for schedule(static)
+  for (size_t s = 0; s < numSamples; ++s)
+  {
+    std::mt19937 gen(seeds[s]);
+    std::uniform_int_distribution<size_t> pick(0, numPoints - 1);
+
+    for (size_t i = 0; i < numPoints; ++i)
+    {
+      const size_t pair = pairs[pick(gen)];
+      outputs.at(pair / numClasses, pair % numClasses, s)++;
+    }
   }
 }
 
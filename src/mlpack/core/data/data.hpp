@@ -18,6 +18,8 @@
 #include "has_serialize.hpp"
 
 #include "load.hpp"
+#include "load_mapped.hpp"
+#include "load_stream.hpp"
 #include "save.hpp"
 
 #include "imputation_methods/imputation_methods.hpp"
@@ -28,8 +30,11 @@
 
 #include "binarize.hpp"
 #include "check_categorical_param.hpp"
+#include "columnar.hpp"
 #include "confusion_matrix.hpp"
 #include "dataset_mapper.hpp"
+#include "hashed_string_encoding_dictionary.hpp"
+#include "image_batch_stream.hpp"
 #include "image_info.hpp"
 #include "imputer.hpp"
 #include "is_naninf.hpp"
@@ -0,0 +1,134 @@
+/**
+ * @file core/data/hashed_string_encoding_dictionary.hpp
+ * @author Ryan Curtin
+ *
+ * Definition of the HashedStringEncodingDictionary class, a stateless
+ * feature-hashing dictionary for the StringEncoding class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_HASHED_STRING_ENCODING_DICTIONARY_HPP
+#define MLPACK_CORE_DATA_HASHED_STRING_ENCODING_DICTIONARY_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/string_encoding.hpp>
+
+#include "string_encoding_policies/bag_of_words_encoding_policy.hpp"
+#include "string_encoding_policies/tf_idf_encoding_policy.hpp"
+
+#include <functional>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A stateless feature-hashing dictionary for the StringEncoding class.
+ * Instead of storing the tokens it has seen, the dictionary assigns each
+ * token the label `hash(token) % numBuckets + 1`, so the vocabulary never
+ * grows, never has to be merged or serialized, and encoding an unbounded
+ * corpus takes constant memory.  Distinct tokens may collide into the same
+ * bucket; with enough buckets this rarely matters for learning.
+ *
+ * The encoded output has `numBuckets` dimensions regardless of the corpus.
+ *
+ * @tparam Token Type of the token that the dictionary hashes.
+ */
+template<typename Token>
+class HashedStringEncodingDictionary
+{
+ public:
+  //! The type of the token that the dictionary hashes.
+  using TokenType = Token;
+
+  //! The dictionary stores nothing; labels depend only on the token itself.
+  static const bool Stateless = true;
+
+  /**
+   * Construct the dictionary with the given number of hash buckets.
+   *
+   * @param numBuckets Number of hash buckets (the dimensionality of the
+   *     encoded output).
+   */
+  HashedStringEncodingDictionary(const size_t numBuckets = (1 << 18)) :
+      numBuckets(numBuckets)
+  { }
+
+  /**
+   * The function returns true for any token, since every token already has a
+   * label.
+   *
+   * @param * (token) The given token.
+   */
+  bool HasToken(const Token& /* token */) const { return true; }
+
+  /**
+   * The function returns the label of the given token; nothing is stored.
+   *
+   * @param token The given token.
+   */
+  size_t AddToken(const Token& token) const { return Value(token); }
+
+  /**
+   * The function returns the label assigned to the given token. The labels
+   * belong to [1, numBuckets].
+   *
+   * @param token The given token.
+   */
+  size_t Value(const Token& token) const
+  {
+    return (std::hash<Token>()(token) % numBuckets) + 1;
+  }
+
+  //! Get the size of the dictionary (the number of hash buckets).
+  size_t Size() const { return numBuckets; }
+
+  //! Clear the dictionary (nothing to do).
+  void Clear() { }
+
+  //! Get the number of hash buckets.
+  size_t NumBuckets() const { return numBuckets; }
+  //! Modify the number of hash buckets.
+  size_t& NumBuckets() { return numBuckets; }
+
+  /**
+   * Serialize the class to the given archive.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(numBuckets));
+  }
+
+ private:
+  //! The number of hash buckets.
+  size_t numBuckets;
+};
+
+/**
+ * A convenient alias for the StringEncoding class with
+ * BagOfWordsEncodingPolicy and the hashed dictionary for the given token
+ * type.
+ *
+ * @tparam TokenType Type of the tokens.
+ */
+template<typename TokenType>
+using HashedBagOfWordsEncoding = StringEncoding<BagOfWordsEncodingPolicy,
+    HashedStringEncodingDictionary<TokenType>>;
+
+/**
+ * A convenient alias for the StringEncoding class with TfIdfEncodingPolicy
+ * and the hashed dictionary for the given token type.
+ *
+ * @tparam TokenType Type of the tokens.
+ */
+template<typename TokenType>
+using HashedTfIdfEncoding = StringEncoding<TfIdfEncodingPolicy,
+    HashedStringEncodingDictionary<TokenType>>;
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,214 @@
+/**
+ * @file core/data/image_batch_stream.hpp
+ * @author Ryan Curtin
+ *
+ * Definition of the ImageBatchStream class, which decodes a list of image
+ * files in fixed-size batches with background prefetching, for training on
+ * image collections that do not fit in memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_IMAGE_BATCH_STREAM_HPP
+#define MLPACK_CORE_DATA_IMAGE_BATCH_STREAM_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "image_info.hpp"
+#include "load_image.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Stream a list of image files from disk in fixed-size batches instead of
+ * decoding the whole collection at once.  A background thread always decodes
+ * the next batch (with the parallel batch Load() overload) while the caller
+ * trains on the current one, so decoding overlaps with training.
+ *
+ * Each image becomes one column of a batch, in the vectorized layout used by
+ * `data::Load()` for image lists.  If the images do not all have the same
+ * dimensions, preset the width and height on the given ImageInfo so that each
+ * image is resized as it is decoded:
+ *
+ * @code
+ * data::ImageInfo info(64, 64, 3);
+ * data::ImageBatchStream<> stream(files, 256, info);
+ * arma::mat batch;
+ * while (stream.Next(batch))
+ *   network.Train(batch, responses.cols(...), opt);
+ * @endcode
+ *
+ * @tparam eT The element type of the batches to produce.
+ */
+template<typename eT = double>
+class ImageBatchStream
+{
+ public:
+  /**
+   * Create the stream over the given files and start prefetching the first
+   * batch.  If the width and height are not preset on the given ImageInfo,
+   * the first image fixes the dimensions of every batch.
+   *
+   * @param files Names of the image files to stream, in order.
+   * @param batchPoints Number of images (columns) per batch.
+   * @param info ImageInfo specifying the target dimensions of each image.
+   * @param fatal If true, an empty file list will throw a
+   *     std::runtime_error instead of printing a warning.
+   */
+  ImageBatchStream(const std::vector<std::string>& files,
+                   const size_t batchPoints,
+                   const ImageInfo& info,
+                   const bool fatal = false) :
+      files(files),
+      batchPoints(batchPoints),
+      info(info),
+      cursor(0),
+      ready(false),
+      eof(false),
+      shutdown(false)
+  {
+    if (files.empty())
+    {
+      if (fatal)
+        Log::Fatal << "ImageBatchStream: vector of image files is empty."
+            << std::endl;
+      else
+        Log::Warn << "ImageBatchStream: vector of image files is empty."
+            << std::endl;
+      eof = true;
+      return;
+    }
+
+    prefetcher = std::thread(&ImageBatchStream::PrefetchLoop, this);
+  }
+
+  //! Stop the prefetch thread.
+  ~ImageBatchStream()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      shutdown = true;
+    }
+    produceCv.notify_all();
+    if (prefetcher.joinable())
+      prefetcher.join();
+  }
+
+  // Streams hold a background thread and cannot be copied.
+  ImageBatchStream(const ImageBatchStream&) = delete;
+  ImageBatchStream& operator=(const ImageBatchStream&) = delete;
+
+  /**
+   * Get the next batch of images.  Blocks until the prefetched batch is
+   * available (usually it already is) and immediately triggers decoding of
+   * the batch after it.  The final batch may hold fewer than `batchPoints`
+   * images.  If an image fails to decode, the stream ends early after the
+   * last complete batch before the failure.
+   *
+   * @param batch Matrix to store the batch in.
+   * @return true if a batch was produced; false once the list is exhausted.
+   */
+  bool Next(arma::Mat<eT>& batch)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    consumeCv.wait(lock, [this]() { return ready || eof; });
+    if (!ready)
+      return false;
+
+    batch = std::move(buffer);
+    ready = false;
+    lock.unlock();
+    produceCv.notify_one();
+    return true;
+  }
+
+  //! Get the ImageInfo describing the streamed images.
+  const ImageInfo& Info() const { return info; }
+
+ private:
+  /**
+   * Body of the prefetch thread: decode one batch at a time and hand each
+   * over as soon as the consumer has taken the previous one.
+   */
+  void PrefetchLoop()
+  {
+    while (true)
+    {
+      // Decode the next batch outside the lock.
+      const size_t end = std::min(cursor + batchPoints, files.size());
+      const std::vector<std::string> slice(files.begin() + cursor,
+          files.begin() + end);
+      cursor = end;
+
+      arma::Mat<eT> local;
+      ImageInfo localInfo = info;
+      const bool okay = Load(slice, local, localInfo, false);
+      const bool last = !okay || (cursor == files.size());
+
+      std::unique_lock<std::mutex> lock(mutex);
+      produceCv.wait(lock, [this]() { return !ready || shutdown; });
+      if (shutdown)
+        return;
+
+      if (okay)
+      {
+        // The first decoded batch fixes the dimensions for the rest.
+        info = localInfo;
+        buffer = std::move(local);
+        ready = true;
+      }
+      if (last)
+        eof = true;
+      consumeCv.notify_one();
+      if (last)
+        return;
+    }
+  }
+
+  //! Names of the image files to stream.
+  std::vector<std::string> files;
+
+  //! Number of images per batch.
+  size_t batchPoints;
+
+  //! Target dimensions of each image.
+  ImageInfo info;
+
+  //! Index of the first file of the next batch to decode.
+  size_t cursor;
+
+  //! The prefetched batch, valid while `ready` is true.
+  arma::Mat<eT> buffer;
+
+  //! Whether `buffer` holds an unconsumed batch.
+  bool ready;
+
+  //! Whether the file list has been fully decoded.
+  bool eof;
+
+  //! Whether the stream is being destructed.
+  bool shutdown;
+
+  //! Protects `buffer`, `info`, `ready`, `eof`, and `shutdown`.
+  std::mutex mutex;
+
+  //! Signalled when a batch becomes available or the list is exhausted.
+  std::condition_variable consumeCv;
+
+  //! Signalled when the consumer has taken the prefetched batch.
+  std::condition_variable produceCv;
+
+  //! The background prefetch thread.
+  std::thread prefetcher;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -96,6 +96,96 @@ class MeanImputation
       input(target.first, target.second) = mean;
     }
   }
+
+  /**
+   * Reset the accumulated statistics, preparing the object for a new
+   * two-phase imputation over chunked data.  Accumulate() then folds each
+   * chunk into per-dimension running sums and counts, and Apply() replaces
+   * the missing values of a chunk with the accumulated means, so a dataset
+   * streamed twice (for example with data::LoadStream) can be imputed
+   * without ever holding it in memory, and all dimensions are handled in a
+   * single pass over each chunk.
+   *
+   * @param dimensionality Number of dimensions of the dataset.
+   */
+  void Reset(const size_t dimensionality)
+  {
+    sums.assign(dimensionality, 0.0);
+    counts.assign(dimensionality, 0);
+  }
+
+  /**
+   * Accumulate the statistics of all dimensions of the given chunk at once.
+   * Call Reset() first; elements equal to mappedValue or NaN are skipped.
+   *
+   * @param input Chunk of the dataset.
+   * @param mappedValue Value that the user wants to get rid of.
+   * @param columnMajor State of whether the input matrix is columnMajor or
+   *     not.
+   */
+  void Accumulate(const arma::Mat<T>& input,
+                  const T& mappedValue,
+                  const bool columnMajor = true)
+  {
+    const size_t points = columnMajor ? input.n_cols : input.n_rows;
+
+    // Each thread owns entire dimensions, so no synchronization is needed.
+    #pragma omp parallel for schedule(static)
+    for (size_t d = 0; d < sums.size(); ++d)
+    {
+      for (size_t i = 0; i < points; ++i)
+      {
+        const T value = columnMajor ? input(d, i) : input(i, d);
+        if (value == mappedValue || std::isnan(value))
+          continue;
+
+        sums[d] += value;
+        counts[d]++;
+      }
+    }
+  }
+
+  /**
+   * Replace the missing values of all dimensions of the given chunk with
+   * the means accumulated so far.  The result is overwritten to the input
+   * matrix.
+   *
+   * @param input Chunk of the dataset.
+   * @param mappedValue Value that the user wants to get rid of.
+   * @param columnMajor State of whether the input matrix is columnMajor or
+   *     not.
+   */
+  void Apply(arma::Mat<T>& input,
+             const T& mappedValue,
+             const bool columnMajor = true)
+  {
+    for (size_t d = 0; d < counts.size(); ++d)
+    {
+      if (counts[d] == 0)
+        Log::Fatal << "it is impossible to calculate mean; no valid elements "
+            << "in dimension " << d << std::endl;
+    }
+
+    const size_t points = columnMajor ? input.n_cols : input.n_rows;
+
+    #pragma omp parallel for schedule(static)
+    for (size_t d = 0; d < sums.size(); ++d)
+    {
+      const double mean = sums[d] / counts[d];
+      for (size_t i = 0; i < points; ++i)
+      {
+        T& value = columnMajor ? input(d, i) : input(i, d);
+        if (value == mappedValue || std::isnan(value))
+          value = mean;
+      }
+    }
+  }
+
+ private:
+  //! The per-dimension running sums of the accumulated chunks.
+  std::vector<double> sums;
+  //! The per-dimension counts of valid elements of the accumulated chunks.
+  std::vector<size_t> counts;
 }; // class MeanImputation
 
 } // namespace data
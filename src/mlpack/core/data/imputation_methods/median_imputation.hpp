@@ -14,6 +14,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "p2_quantile_estimator.hpp"
+
 namespace mlpack {
 namespace data {
 /**
@@ -85,6 +87,92 @@ class MedianImputation
        input(target.first, target.second) = median;
     }
   }
+
+  /**
+   * Reset the accumulated statistics, preparing the object for a new
+   * two-phase imputation over chunked data.  Accumulate() then folds each
+   * chunk into one streaming P^2 median estimator per dimension, and
+   * Apply() replaces the missing values of a chunk with the estimated
+   * medians.  Unlike Impute(), which computes the exact median, the
+   * two-phase form uses constant memory per dimension and so yields an
+   * approximate median.
+   *
+   * @param dimensionality Number of dimensions of the dataset.
+   */
+  void Reset(const size_t dimensionality)
+  {
+    estimators.assign(dimensionality, P2QuantileEstimator(0.5));
+  }
+
+  /**
+   * Accumulate the statistics of all dimensions of the given chunk at once.
+   * Call Reset() first; elements equal to mappedValue or NaN are skipped.
+   *
+   * @param input Chunk of the dataset.
+   * @param mappedValue Value that the user wants to get rid of.
+   * @param columnMajor State of whether the input matrix is columnMajor or
+   *     not.
+   */
+  void Accumulate(const arma::Mat<T>& input,
+                  const T& mappedValue,
+                  const bool columnMajor = true)
+  {
+    const size_t points = columnMajor ? input.n_cols : input.n_rows;
+
+    // Each thread owns entire dimensions, so no synchronization is needed.
+    #pragma omp parallel for schedule(static)
+    for (size_t d = 0; d < estimators.size(); ++d)
+    {
+      for (size_t i = 0; i < points; ++i)
+      {
+        const T value = columnMajor ? input(d, i) : input(i, d);
+        if (value == mappedValue || std::isnan(value))
+          continue;
+
+        estimators[d].Insert(value);
+      }
+    }
+  }
+
+  /**
+   * Replace the missing values of all dimensions of the given chunk with
+   * the medians estimated so far.  The result is overwritten to the input
+   * matrix.
+   *
+   * @param input Chunk of the dataset.
+   * @param mappedValue Value that the user wants to get rid of.
+   * @param columnMajor State of whether the input matrix is columnMajor or
+   *     not.
+   */
+  void Apply(arma::Mat<T>& input,
+             const T& mappedValue,
+             const bool columnMajor = true)
+  {
+    for (size_t d = 0; d < estimators.size(); ++d)
+    {
+      if (estimators[d].Count() == 0)
+        Log::Fatal << "it is impossible to calculate median; no valid "
+            << "elements in dimension " << d << std::endl;
+    }
+
+    const size_t points = columnMajor ? input.n_cols : input.n_rows;
+
+    #pragma omp parallel for schedule(static)
+    for (size_t d = 0; d < estimators.size(); ++d)
+    {
+      const double median = estimators[d].Quantile();
+      for (size_t i = 0; i < points; ++i)
+      {
+        T& value = columnMajor ? input(d, i) : input(i, d);
+        if (value == mappedValue || std::isnan(value))
+          value = median;
+      }
+    }
+  }
+
+ private:
+  //! The per-dimension streaming median estimators.
+  std::vector<P2QuantileEstimator> estimators;
 }; // class MedianImputation
 
 } // namespace data
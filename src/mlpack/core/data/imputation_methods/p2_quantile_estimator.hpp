@@ -0,0 +1,186 @@
+/**
+ * @file core/data/imputation_methods/p2_quantile_estimator.hpp
+ * @author Keon Kim
+ *
+ * Definition and Implementation of the P2QuantileEstimator class, a
+ * streaming quantile estimator based on the P^2 algorithm.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_IMPUTE_STRATEGIES_P2_QUANTILE_ESTIMATOR_HPP
+#define MLPACK_CORE_DATA_IMPUTE_STRATEGIES_P2_QUANTILE_ESTIMATOR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A streaming estimator of a single quantile, using the P^2 algorithm of
+ * Jain and Chlamtac.  The estimator keeps five markers whose heights
+ * approximate the minimum, the target quantile, the quantiles halfway to
+ * either side of it, and the maximum; each inserted value adjusts the
+ * markers with a piecewise-parabolic update.  It uses constant memory no
+ * matter how many values are inserted, so it can summarize a stream that
+ * does not fit in memory, at the cost of returning an approximation of the
+ * true quantile.
+ */
+class P2QuantileEstimator
+{
+ public:
+  /**
+   * Construct the estimator for the given quantile.
+   *
+   * @param p The quantile to estimate, in (0, 1); 0.5 gives the median.
+   */
+  P2QuantileEstimator(const double p = 0.5) :
+      p(p),
+      count(0)
+  { }
+
+  /**
+   * Insert a value from the stream into the estimator.
+   *
+   * @param value The value to insert.
+   */
+  void Insert(const double value)
+  {
+    // The first five values are buffered; once the fifth arrives they are
+    // sorted and become the initial marker heights.
+    if (count < 5)
+    {
+      q[count++] = value;
+
+      if (count == 5)
+      {
+        std::sort(q, q + 5);
+        for (size_t i = 0; i < 5; ++i)
+          n[i] = (double) (i + 1);
+
+        np[0] = 1;
+        np[1] = 1 + 2 * p;
+        np[2] = 1 + 4 * p;
+        np[3] = 3 + 2 * p;
+        np[4] = 5;
+
+        dn[0] = 0;
+        dn[1] = p / 2;
+        dn[2] = p;
+        dn[3] = (1 + p) / 2;
+        dn[4] = 1;
+      }
+
+      return;
+    }
+
+    // Find the pair of markers that brackets the value, extending the
+    // extreme markers if it falls outside them.
+    size_t k = 0;
+    if (value < q[0])
+    {
+      q[0] = value;
+    }
+    else if (value >= q[4])
+    {
+      q[4] = value;
+      k = 3;
+    }
+    else
+    {
+      while (value >= q[k + 1])
+        ++k;
+    }
+
+    for (size_t i = k + 1; i < 5; ++i)
+      n[i] += 1;
+    for (size_t i = 0; i < 5; ++i)
+      np[i] += dn[i];
+    ++count;
+
+    // Adjust the three interior markers towards their desired positions,
+    // moving their heights with the piecewise-parabolic formula (or
+    // linearly, if the parabolic prediction would leave them out of order).
+    for (size_t i = 1; i <= 3; ++i)
+    {
+      const double d = np[i] - n[i];
+      if (!((d >= 1 && n[i + 1] - n[i] > 1) ||
+            (d <= -1 && n[i - 1] - n[i] < -1)))
+        continue;
+
+      const int s = (d >= 1) ? 1 : -1;
+      const double qNew = q[i] + s / (n[i + 1] - n[i - 1]) *
+          ((n[i] - n[i - 1] + s) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) +
+           (n[i + 1] - n[i] - s) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+
+      if (q[i - 1] < qNew && qNew < q[i + 1])
+        q[i] = qNew;
+      else
+        q[i] = q[i] + s * (q[i + s] - q[i]) / (n[i + s] - n[i]);
+
+      n[i] += s;
+    }
+  }
+
+  /**
+   * Get the current estimate of the quantile.  If fewer than five values
+   * have been inserted, the quantile of the buffered values is returned
+   * exactly; if no values have been inserted, NaN is returned.
+   */
+  double Quantile() const
+  {
+    if (count == 0)
+      return std::numeric_limits<double>::quiet_NaN();
+
+    if (count < 5)
+    {
+      double sorted[5];
+      std::copy(q, q + count, sorted);
+      std::sort(sorted, sorted + count);
+      return sorted[(size_t) (p * (count - 1) + 0.5)];
+    }
+
+    return q[2];
+  }
+
+  //! Get the quantile that the estimator tracks.
+  double P() const { return p; }
+
+  //! Get the number of values inserted so far.
+  size_t Count() const { return count; }
+
+  /**
+   * Serialize the estimator to the given archive.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(p));
+    ar(CEREAL_NVP(count));
+    ar(CEREAL_NVP(q));
+    ar(CEREAL_NVP(n));
+    ar(CEREAL_NVP(np));
+    ar(CEREAL_NVP(dn));
+  }
+
+ private:
+  //! The quantile to estimate.
+  double p;
+  //! The number of values inserted so far.
+  size_t count;
+  //! The marker heights (or, before five values arrive, the value buffer).
+  double q[5];
+  //! The marker positions.
+  double n[5];
+  //! The desired marker positions.
+  double np[5];
+  //! The increments of the desired marker positions.
+  double dn[5];
+}; // class P2QuantileEstimator
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -17,6 +17,10 @@
 #include "string_algorithms.hpp"
 #include "is_naninf.hpp"
 
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace data {
 
@@ -171,119 +175,254 @@ void LoadARFF(const std::string& filename,
     }
   }
 
-  // We need to find out how many lines of data are in the file.
-  std::streampos pos = ifs.tellg();
-  size_t row = 0;
+  // Read the rest of the file (the @data section) in one pass; the lines are
+  // independent, so they can be parsed in parallel chunks.  Each line of the
+  // @data section must be a CSV (except sparse data, which we will handle
+  // later).  The '?' representing a missing value is not allowed, so if that
+  // occurs we throw an exception.  We also throw an exception if any piece of
+  // data does not match its type (categorical or numeric).
+  std::vector<std::string> lines;
   while (ifs.good())
   {
     std::getline(ifs, line, '\n');
-    ++row;
+    lines.push_back(line);
   }
-  // Uncount the EOF row.
-  --row;
 
-  // Since we've hit the EOF, we have to call clear() so we can seek again.
-  ifs.clear();
-  ifs.seekg(pos);
+  // If the file ends with a newline, the last getline produced an empty line
+  // that holds no data.
+  size_t numPoints = lines.size();
+  if (!lines.empty())
+  {
+    Trim(lines.back());
+    if (lines.back().empty())
+      --numPoints;
+  }
 
   // Now, set the size of the matrix.
-  matrix.set_size(dimensionality, row);
-
-  // Now we are looking at the @data section.
-  row = 0;
-  while (ifs.good())
+  matrix.set_size(dimensionality, numPoints);
+
+  // Each chunk interns the categorical tokens it sees in a local table, and
+  // the tables are merged afterwards in chunk order, so the mappings that get
+  // created are identical to those of a sequential parse.
+  size_t numThreads = 1;
+  #ifdef MLPACK_USE_OPENMP
+    numThreads = (size_t) omp_get_max_threads();
+  #endif
+  const size_t numChunks = std::max((size_t) 1,
+      std::min(numThreads, numPoints));
+  std::vector<size_t> chunkStarts(numChunks + 1);
+  for (size_t chunk = 0; chunk <= numChunks; ++chunk)
+    chunkStarts[chunk] = (chunk * numPoints) / numChunks;
+
+  // The distinct tokens of each chunk and dimension, in first-occurrence
+  // order; their local identifiers; and the row of their first occurrence
+  // (for error reporting).
+  std::vector<std::vector<std::vector<std::string>>> chunkTokens(numChunks,
+      std::vector<std::vector<std::string>>(dimensionality));
+  std::vector<std::vector<std::vector<size_t>>> chunkTokenRows(numChunks,
+      std::vector<std::vector<size_t>>(dimensionality));
+  std::vector<std::vector<std::unordered_map<std::string, size_t>>> chunkIds(
+      numChunks,
+      std::vector<std::unordered_map<std::string, size_t>>(dimensionality));
+
+  // Number of columns actually present on each line; short lines leave the
+  // remaining cells untouched, as before.
+  std::vector<size_t> colsWritten(numPoints, 0);
+
+  // The first error encountered, by row, so that the error that gets
+  // reported does not depend on the parallel schedule.
+  bool parseOkay = true;
+  size_t errorRow = 0;
+  std::string errorMessage;
+
+  #pragma omp parallel for schedule(static)
+  for (size_t chunk = 0; chunk < numChunks; ++chunk)
   {
-    std::getline(ifs, line, '\n');
-    Trim(line);
-    // Each line of the @data section must be a CSV (except sparse data, which
-    // we will handle later).  So now we can tokenize the
-    // CSV and parse it.  The '?' representing a missing value is not allowed,
-    // so if that occurs we throw an exception.  We also throw an exception if
-    // any piece of data does not match its type (categorical or numeric).
-
-    // If the first character is {, it is sparse data, and we can just say this
-    // is not handled for now...
-    if (line[0] == '{')
-      throw std::runtime_error("cannot yet parse sparse ARFF data");
-
-    // Tokenize the line.
-    std::vector<std::string> tok = Tokenize(line, ',', '"');
-
-    size_t col = 0;
     std::stringstream token;
-    for (std::vector<std::string>::iterator it = tok.begin(); it != tok.end(); ++it)
+    for (size_t row = chunkStarts[chunk]; row < chunkStarts[chunk + 1]; ++row)
     {
-      // Check that we are not too many columns in.
-      if (col >= matrix.n_rows)
+      std::string& dataLine = lines[row];
+      Trim(dataLine);
+
+      // If the first character is {, it is sparse data, and we can just say
+      // this is not handled for now...
+      if (dataLine[0] == '{')
       {
-        std::stringstream error;
-        error << "Too many columns in line " << (headerLines + row) << ".";
-        throw std::runtime_error(error.str());
+        #pragma omp critical (LoadARFFError)
+        {
+          if (parseOkay || row < errorRow)
+          {
+            parseOkay = false;
+            errorRow = row;
+            errorMessage = "cannot yet parse sparse ARFF data";
+          }
+        }
+        continue;
       }
 
-      // What should this token be?
-      if (info.Type(col) == Datatype::categorical)
-      {
-        // Strip spaces before mapping.
-        std::string token = *it;
-        Trim(token);
-        const size_t currentNumMappings = info.NumMappings(col);
-        const eT result = info.template MapString<eT>(token, col);
+      // Tokenize the line.
+      std::vector<std::string> tok = Tokenize(dataLine, ',', '"');
 
-        // If the set of categories was pre-specified, then we must crash if
-        // this was not one of those categories.
-        if (categoryStrings.count(col) > 0 &&
-            currentNumMappings < info.NumMappings(col))
+      size_t col = 0;
+      bool rowOkay = true;
+      std::string rowError;
+      for (std::vector<std::string>::iterator it = tok.begin();
+          it != tok.end(); ++it)
+      {
+        // Check that we are not too many columns in.
+        if (col >= matrix.n_rows)
         {
           std::stringstream error;
-          error << "Parse error at line " << (headerLines + row) << " token "
-              << col << ": category \"" << token << "\" not in the set of known"
-              << " categories for this dimension (";
-          for (size_t i = 0; i < categoryStrings.at(col).size() - 1; ++i)
-            error << "\"" << categoryStrings.at(col)[i] << "\", ";
-          error << "\"" << categoryStrings.at(col).back() << "\").";
-          throw std::runtime_error(error.str());
+          error << "Too many columns in line " << (headerLines + row) << ".";
+          rowOkay = false;
+          rowError = error.str();
+          break;
+        }
+
+        // What should this token be?
+        if (info.Type(col) == Datatype::categorical)
+        {
+          // Strip spaces, then intern the token; the mapping itself is
+          // created during the merge.
+          std::string strToken = *it;
+          Trim(strToken);
+
+          std::unordered_map<std::string, size_t>& ids = chunkIds[chunk][col];
+          std::unordered_map<std::string, size_t>::iterator idIt =
+              ids.find(strToken);
+          size_t id;
+          if (idIt == ids.end())
+          {
+            id = chunkTokens[chunk][col].size();
+            chunkTokens[chunk][col].push_back(strToken);
+            chunkTokenRows[chunk][col].push_back(row);
+            ids[strToken] = id;
+          }
+          else
+          {
+            id = idIt->second;
+          }
+
+          // We load transposed.
+          matrix(col, row) = eT(id);
+        }
+        else if (info.Type(col) == Datatype::numeric)
+        {
+          // Attempt to read as numeric.
+          token.clear();
+          token.str(*it);
+
+          eT val = eT(0);
+          token >> val;
+
+          if (token.fail())
+          {
+            // Check for NaN or inf.
+            if (!IsNaNInf(val, token.str()))
+            {
+              // Okay, it's not NaN or inf.  If it's '?', we issue a specific
+              // error, otherwise we issue a general error.
+              std::stringstream error;
+              std::string tokenStr = token.str();
+              Trim(tokenStr);
+              if (tokenStr == "?")
+                error << "Missing values ('?') not supported, ";
+              else
+                error << "Parse error ";
+              error << "at line " << (headerLines + row) << " token " << col
+                  << ": \"" << tokenStr << "\".";
+              rowOkay = false;
+              rowError = error.str();
+              break;
+            }
+          }
+
+          // If we made it to here, we have a value.
+          matrix(col, row) = val; // We load transposed.
         }
 
-        // We load transposed.
-        matrix(col, row) = result;
+        ++col;
       }
-      else if (info.Type(col) == Datatype::numeric)
+      colsWritten[row] = col;
+
+      if (!rowOkay)
       {
-        // Attempt to read as numeric.
-        token.clear();
-        token.str(*it);
+        #pragma omp critical (LoadARFFError)
+        {
+          if (parseOkay || row < errorRow)
+          {
+            parseOkay = false;
+            errorRow = row;
+            errorMessage = rowError;
+          }
+        }
+      }
+    }
+  }
 
-        eT val = eT(0);
-        token >> val;
+  // Merge the local interning tables in chunk order: one MapString() call per
+  // distinct token per chunk, in first-occurrence order within each
+  // dimension.
+  std::vector<std::vector<std::vector<eT>>> translate(numChunks,
+      std::vector<std::vector<eT>>(dimensionality));
+  for (size_t chunk = 0; chunk < numChunks; ++chunk)
+  {
+    for (size_t d = 0; d < dimensionality; ++d)
+    {
+      std::vector<std::string>& tokens = chunkTokens[chunk][d];
+      if (tokens.empty())
+        continue;
 
-        if (token.fail())
+      std::vector<eT>& tr = translate[chunk][d];
+      tr.reserve(tokens.size());
+      for (size_t id = 0; id < tokens.size(); ++id)
+      {
+        const size_t currentNumMappings = info.NumMappings(d);
+        const eT result = info.template MapString<eT>(tokens[id], d);
+
+        // If the set of categories was pre-specified, then we must crash if
+        // this was not one of those categories.
+        if (categoryStrings.count(d) > 0 &&
+            currentNumMappings < info.NumMappings(d))
         {
-          // Check for NaN or inf.
-          if (!IsNaNInf(val, token.str()))
+          const size_t row = chunkTokenRows[chunk][d][id];
+          if (parseOkay || row < errorRow)
           {
-            // Okay, it's not NaN or inf.  If it's '?', we issue a specific
-            // error, otherwise we issue a general error.
             std::stringstream error;
-            std::string tokenStr = token.str();
-            Trim(tokenStr);
-            if (tokenStr == "?")
-              error << "Missing values ('?') not supported, ";
-            else
-              error << "Parse error ";
-            error << "at line " << (headerLines + row) << " token " << col
-                << ": \"" << tokenStr << "\".";
-            throw std::runtime_error(error.str());
+            error << "Parse error at line " << (headerLines + row) << " token "
+                << d << ": category \"" << tokens[id] << "\" not in the set of"
+                << " known categories for this dimension (";
+            for (size_t i = 0; i < categoryStrings.at(d).size() - 1; ++i)
+              error << "\"" << categoryStrings.at(d)[i] << "\", ";
+            error << "\"" << categoryStrings.at(d).back() << "\").";
+
+            parseOkay = false;
+            errorRow = row;
+            errorMessage = error.str();
           }
         }
 
-        // If we made it to here, we have a value.
-        matrix(col, row) = val; // We load transposed.
+        tr.push_back(result);
       }
+    }
+  }
 
-      ++col;
+  if (!parseOkay)
+    throw std::runtime_error(errorMessage);
+
+  // Replace the local identifiers of the categorical cells with the merged
+  // mappings.
+  #pragma omp parallel for schedule(static)
+  for (size_t chunk = 0; chunk < numChunks; ++chunk)
+  {
+    for (size_t row = chunkStarts[chunk]; row < chunkStarts[chunk + 1]; ++row)
+    {
+      for (size_t col = 0; col < colsWritten[row]; ++col)
+      {
+        if (info.Type(col) == Datatype::categorical)
+          matrix(col, row) = translate[chunk][col][size_t(matrix(col, row))];
+      }
     }
-    ++row;
   }
 }
 
@@ -12,6 +12,12 @@
 #ifndef MLPACK_CORE_DATA_LOAD_CATEGORICAL_CSV_HPP
 #define MLPACK_CORE_DATA_LOAD_CATEGORICAL_CSV_HPP
 
+#include <cstring>
+
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
 #include "load_csv.hpp"
 
 namespace mlpack{
@@ -47,86 +53,167 @@ inline void LoadCSV::CategoricalMatSize(
   }
 }
 
-template<typename T, typename MapPolicy>
-void LoadCSV::InitializeTransposeMapper(size_t& rows, size_t& cols,
-                                        DatasetMapper<MapPolicy>& info)
+inline void LoadCSV::BufferLines(std::vector<char>& buffer,
+                                 std::vector<std::pair<size_t, size_t>>& lines)
 {
-  // Take a pass through the file.  If the DatasetMapper policy requires it,
-  // we will pass everything as string through MapString().  This might be useful
-  // if, e.g., the MapPolicy needs to find which dimensions are numeric or
-  // categorical.
-  
-  // Reset to the start of the file.
   inFile.clear();
+  inFile.seekg(0, std::ios::end);
+  const size_t bufferSize = size_t(std::streamoff(inFile.tellg()));
   inFile.seekg(0, std::ios::beg);
-  rows = 0;
-  cols = 0;
+  buffer.resize(bufferSize + 1);
+  inFile.read(buffer.data(), bufferSize);
+  buffer[bufferSize] = '\0';
 
-  std::string line;
-  while (inFile.good())
+  const char* data = buffer.data();
+  size_t offset = 0;
+  while (offset < bufferSize)
   {
-    ++cols;
-    
-    if (cols == 1)
-    {
-      // Extract the number of dimensions.
-      std::pair<size_t, size_t> dimen = GetMatrixSize<false>(inFile, delim);
-      rows = dimen.second;
+    const char* eol = (const char*) std::memchr(data + offset, '\n',
+        bufferSize - offset);
+    size_t end = eol ? size_t(eol - data) : bufferSize;
+    size_t start = offset;
+    offset = end + 1;
+
+    // Strip whitespace (including any trailing '\r') from either side, and
+    // skip lines that are entirely whitespace.
+    while (end > start && std::isspace((unsigned char) data[end - 1]))
+      --end;
+    while (start < end && std::isspace((unsigned char) data[start]))
+      ++start;
+    if (end > start)
+      lines.push_back(std::make_pair(start, end));
+  }
+}
 
-      if (info.Dimensionality() == 0)
-      {
-        info.SetDimensionality(rows);
-      }
-      else if (info.Dimensionality() != rows)
-      { 
-        std::ostringstream oss;
-        oss << "data::LoadCSV(): given DatasetInfo has dimensionality "
-            << info.Dimensionality() << ", but data has dimensionality "
-            << rows;
-        throw std::invalid_argument(oss.str());
-      }
+inline void LoadCSV::ExtractToken(std::string& token,
+                                  const char*& pos,
+                                  const char* lineEnd)
+{
+  const char* tokEnd = (const char*) std::memchr(pos, delim, lineEnd - pos);
+  if (tokEnd == NULL)
+    tokEnd = lineEnd;
+  token.assign(pos, tokEnd);
+  Trim(token);
+
+  // A quoted token may contain the delimiter; if so, keep pulling pieces
+  // until one ends with a closing quote, as the streaming tokenizer did.
+  if (!token.empty() && token[0] == '"' && token[token.size() - 1] != '"')
+  {
+    while (tokEnd != lineEnd)
+    {
+      const char* next = (const char*) std::memchr(tokEnd + 1, delim,
+          lineEnd - (tokEnd + 1));
+      if (next == NULL)
+        next = lineEnd;
+      token += delim;
+      token.append(tokEnd + 1, next);
+      tokEnd = next;
+      if (!token.empty() && token[token.size() - 1] == '"')
+        break;
     }
+  }
+
+  pos = tokEnd + 1;
+}
+
+template<typename eT>
+bool LoadCSV::TokenIsNumeric(eT& val, const std::string& token)
+{
+  if (token.empty())
+    return false;
 
-     std::getline(inFile, line);
-     // Remove whitespaces from either side.
-     Trim(line);
+  const char* str = token.c_str();
+  char* endptr = nullptr;
 
-    // If it's an empty line decrease cols and break.
-    if (line.size() == 0)
+  if (std::is_floating_point<eT>::value)
+  {
+    const double d = std::strtod(str, &endptr);
+    if (endptr != str + token.size() || !std::isfinite(d))
+      return false;
+    val = eT(d);
+  }
+  else if (std::is_integral<eT>::value)
+  {
+    if (std::is_signed<eT>::value)
+    {
+      val = eT(std::strtoll(str, &endptr, 10));
+    }
+    else
     {
-      --cols;
-      continue;
+      if (str[0] == '-')
+        return false;
+      val = eT(std::strtoull(str, &endptr, 10));
     }
 
-    // If we need to do a first pass for the DatasetMapper, do it.
-    if (MapPolicy::NeedsFirstPass)
+    if (endptr != str + token.size())
+      return false;
+  }
+  else
+  {
+    return false;
+  }
+
+  return true;
+}
+
+template<typename T, typename MapPolicy>
+void LoadCSV::InitializeTransposeMapper(size_t& rows, size_t& cols,
+                                        DatasetMapper<MapPolicy>& info)
+{
+  // Take a pass through the file.  If the DatasetMapper policy requires it,
+  // we will pass everything as string through MapString().  This might be
+  // useful if, e.g., the MapPolicy needs to find which dimensions are numeric
+  // or categorical.  Both passes parse out of one contiguous buffer.
+  std::vector<char> buffer;
+  std::vector<std::pair<size_t, size_t>> lines;
+  BufferLines(buffer, lines);
+  const char* data = buffer.data();
+
+  cols = lines.size();
+  rows = 0;
+
+  // The dimensionality is the largest number of tokens on any line.
+  std::string token;
+  for (size_t col = 0; col < lines.size(); ++col)
+  {
+    const char* pos = data + lines[col].first;
+    const char* lineEnd = data + lines[col].second;
+    size_t count = 0;
+    while (pos <= lineEnd)
     {
-      // In this case we must pass everything we parse to the MapPolicy.
-      size_t dim = 0;
-      std::stringstream lineStream;
-      std::string token;
+      ExtractToken(token, pos, lineEnd);
+      ++count;
+    }
 
-      lineStream.clear();
-      lineStream.str(line);
+    rows = std::max(rows, count);
+  }
 
-      while (lineStream.good())
-      {
-        std::getline(lineStream, token, delim);
-        // Remove whitespace from either side
-        Trim(token);
+  if (info.Dimensionality() == 0)
+  {
+    info.SetDimensionality(rows);
+  }
+  else if (info.Dimensionality() != rows)
+  {
+    std::ostringstream oss;
+    oss << "data::LoadCSV(): given DatasetInfo has dimensionality "
+        << info.Dimensionality() << ", but data has dimensionality "
+        << rows;
+    throw std::invalid_argument(oss.str());
+  }
 
-        if (token[0] == '"' && token[token.size() - 1] != '"')
-        {
-          std::string tok = token;
-          while (token[token.size() - 1] != '"')
-          {
-            tok += delim;
-            std::getline(lineStream, token, delim);
-            tok += token;
-          }
-          token = tok;
-        }
-        info.template MapFirstPass<T>(std::move(token), dim++);
+  // If we need to do a first pass for the DatasetMapper, do it.
+  if (MapPolicy::NeedsFirstPass)
+  {
+    // In this case we must pass everything we parse to the MapPolicy.
+    for (size_t col = 0; col < lines.size(); ++col)
+    {
+      const char* pos = data + lines[col].first;
+      const char* lineEnd = data + lines[col].second;
+      size_t dim = 0;
+      while (pos <= lineEnd)
+      {
+        ExtractToken(token, pos, lineEnd);
+        info.template MapFirstPass<T>(token, dim++);
       }
     }
   }
@@ -213,7 +300,7 @@ void LoadCSV::InitializeMapper(size_t& rows, size_t& cols, DatasetMapper<MapPoli
         info.template MapFirstPass<T>(std::move(token), rows - 1);
       }
     }
-  } 
+  }
 }
 
 template<typename T, typename PolicyType>
@@ -226,56 +313,163 @@ void LoadCSV::TransposeParse(arma::Mat<T>& inout, DatasetMapper<PolicyType>& inf
   // Set the matrix size.
   inout.set_size(rows, cols);
 
-  // Initialize auxiliary variables.
-  size_t row = 0;
-  size_t col = 0;
-  std::string line;
-  inFile.clear();
-  inFile.seekg(0, std::ios::beg);
+  // Re-read the file into one contiguous buffer; each point (line) is parsed
+  // directly out of it.
+  std::vector<char> buffer;
+  std::vector<std::pair<size_t, size_t>> lines;
+  BufferLines(buffer, lines);
+  const char* data = buffer.data();
+
+  // The points are parsed in contiguous chunks, one chunk per thread.  Each
+  // chunk interns the tokens that must go through MapString() in its own
+  // local table, and the tables are merged afterwards in chunk order, so the
+  // mappings that get created are identical to those of a sequential parse.
+  size_t numThreads = 1;
+  #ifdef MLPACK_USE_OPENMP
+    numThreads = (size_t) omp_get_max_threads();
+  #endif
+  const size_t numChunks = std::max((size_t) 1,
+      std::min(numThreads, lines.size()));
+  std::vector<size_t> chunkStarts(numChunks + 1);
+  for (size_t chunk = 0; chunk <= numChunks; ++chunk)
+    chunkStarts[chunk] = (chunk * lines.size()) / numChunks;
+
+  // The distinct tokens of each chunk and dimension, in first-occurrence
+  // order, and their local identifiers.
+  std::vector<std::vector<std::vector<std::string>>> chunkTokens(numChunks,
+      std::vector<std::vector<std::string>>(rows));
+  std::vector<std::vector<std::unordered_map<std::string, size_t>>> chunkIds(
+      numChunks, std::vector<std::unordered_map<std::string, size_t>>(rows));
+  // Cells of numeric dimensions whose tokens could not be converted directly;
+  // these hold local identifiers that must be translated afterwards.
+  std::vector<std::vector<std::pair<size_t, size_t>>> deferred(numChunks);
+
+  // Dimensions whose cells all hold local identifiers.  This is snapshotted
+  // before the merge, because the merge itself may change dimension types.
+  std::vector<bool> internedDim(rows);
+  for (size_t dim = 0; dim < rows; ++dim)
+  {
+    internedDim[dim] = PolicyType::MapsNumericTokens ||
+        (infoSet.Type(dim) == Datatype::categorical);
+  }
 
-  while (std::getline(inFile, line))
+  bool dimsOkay = true;
+  size_t failCol = 0, failCount = 0;
+
+  #pragma omp parallel for schedule(static)
+  for (size_t chunk = 0; chunk < numChunks; ++chunk)
   {
-    // Remove whitespaces from either side.
-    Trim(line);
-    // Reset the row we are looking at.  (Remember this is transposed.)
-    row = 0;
-    std::stringstream lineStream;
     std::string token;
-    lineStream.clear();
-    lineStream.str(line);
-
-    while (lineStream.good())
+    for (size_t col = chunkStarts[chunk]; col < chunkStarts[chunk + 1]; ++col)
     {
-      std::getline(lineStream, token, delim);
-      // Remove whitespaces from either side.
-      Trim(token);
+      const char* pos = data + lines[col].first;
+      const char* lineEnd = data + lines[col].second;
+      size_t row = 0;
+      while (pos <= lineEnd)
+      {
+        ExtractToken(token, pos, lineEnd);
+        if (row >= rows)
+        {
+          // Too many tokens; just count them for the error message.
+          ++row;
+          continue;
+        }
 
-      if (token[0] == '"' && token[token.size() - 1] != '"')
+        T val = T(0);
+        if (!internedDim[row] && TokenIsNumeric<T>(val, token))
+        {
+          // Tokens of numeric dimensions that parse cleanly never create a
+          // mapping, so they can be stored directly.
+          inout(row, col) = val;
+        }
+        else
+        {
+          // Intern the token; the real mapping is created during the merge.
+          std::unordered_map<std::string, size_t>& ids = chunkIds[chunk][row];
+          std::unordered_map<std::string, size_t>::iterator it =
+              ids.find(token);
+          size_t id;
+          if (it == ids.end())
+          {
+            id = chunkTokens[chunk][row].size();
+            chunkTokens[chunk][row].push_back(token);
+            ids[token] = id;
+          }
+          else
+          {
+            id = it->second;
+          }
+
+          inout(row, col) = T(id);
+          if (!internedDim[row])
+            deferred[chunk].push_back(std::make_pair(row, col));
+        }
+        ++row;
+      }
+
+      // Make sure we got the right number of rows.
+      if (row != rows)
       {
-        // First part of the string.
-        std::string tok = token;
-        while (token[token.size() - 1] != '"')
+        #pragma omp critical (LoadCSVTransposeParseError)
         {
-          tok += delim;
-          std::getline(lineStream, token, delim);
-          tok += token;
+          if (dimsOkay || col < failCol)
+          {
+            dimsOkay = false;
+            failCol = col;
+            failCount = row;
+          }
         }
-        token = tok;
       }
-      inout(row, col) = infoSet.template MapString<T>(std::move(token), row);
-      row++;
     }
+  }
 
-    // Make sure we got the right number of rows.
-    if (row != rows)
+  if (!dimsOkay)
+  {
+    std::ostringstream oss;
+    oss << "LoadCSV::TransposeParse(): wrong number of dimensions ("
+        << failCount << ") on line " << failCol << "; should be " << rows
+        << " dimensions.";
+    throw std::runtime_error(oss.str());
+  }
+
+  // Merge the local tables, in chunk order: one MapString() call per distinct
+  // token per chunk, in first-occurrence order within each dimension.
+  std::vector<std::vector<std::vector<T>>> translate(numChunks,
+      std::vector<std::vector<T>>(rows));
+  for (size_t chunk = 0; chunk < numChunks; ++chunk)
+  {
+    for (size_t row = 0; row < rows; ++row)
     {
-      std::ostringstream oss;
-      oss << "LoadCSV::TransposeParse(): wrong number of dimensions (" << row
-          << ") on line " << col << "; should be " << rows << " dimensions.";
-      throw std::runtime_error(oss.str());
+      std::vector<std::string>& tokens = chunkTokens[chunk][row];
+      if (tokens.empty())
+        continue;
+
+      std::vector<T>& tr = translate[chunk][row];
+      tr.reserve(tokens.size());
+      for (size_t id = 0; id < tokens.size(); ++id)
+        tr.push_back(infoSet.template MapString<T>(tokens[id], row));
+    }
+  }
+
+  // Replace the local identifiers with the merged mappings.
+  #pragma omp parallel for schedule(static)
+  for (size_t chunk = 0; chunk < numChunks; ++chunk)
+  {
+    for (size_t col = chunkStarts[chunk]; col < chunkStarts[chunk + 1]; ++col)
+    {
+      for (size_t row = 0; row < rows; ++row)
+      {
+        if (internedDim[row])
+          inout(row, col) = translate[chunk][row][size_t(inout(row, col))];
+      }
+    }
+
+    for (size_t i = 0; i < deferred[chunk].size(); ++i)
+    {
+      const size_t row = deferred[chunk][i].first;
+      const size_t col = deferred[chunk][i].second;
+      inout(row, col) = translate[chunk][row][size_t(inout(row, col))];
     }
-    // Increment the column index.
-    ++col;
   }
 }
 
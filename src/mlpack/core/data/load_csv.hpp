@@ -278,6 +278,45 @@ class LoadCSV
 
   // Functions for Categorical Parse.
 
+  /**
+  * Read the entire file into one contiguous buffer and collect the spans of
+  * the non-empty lines, with surrounding whitespace (and any trailing
+  * carriage return) stripped.  Parsing out of a single buffer avoids the
+  * per-line stream tokenization that otherwise dominates load time.
+  *
+  * @param buffer Buffer to read the file contents into (NUL-terminated).
+  * @param lines Span of each non-empty line, as (start, end) offsets into
+  *     the buffer.
+  */
+  inline void BufferLines(std::vector<char>& buffer,
+                          std::vector<std::pair<size_t, size_t>>& lines);
+
+  /**
+  * Extract the next token from the given line span and advance the position
+  * past its delimiter.  The token is trimmed, and a quoted token that
+  * contains the delimiter is merged across pieces, as the streaming
+  * tokenizer did.
+  *
+  * @param token String to store the token in (reused across calls).
+  * @param pos Current position in the line; advanced past the token.
+  * @param lineEnd End of the line span.
+  */
+  inline void ExtractToken(std::string& token,
+                           const char*& pos,
+                           const char* lineEnd);
+
+  /**
+  * Strict numeric check used to bypass MapString() for tokens in numeric
+  * dimensions: returns true only if the entire token parses as a finite
+  * number of the given type.  Anything this rejects falls back to
+  * MapString(), which gives the same result more slowly.
+  *
+  * @param val Value to store the parsed number in.
+  * @param token Token to check.
+  */
+  template<typename eT>
+  bool TokenIsNumeric(eT& val, const std::string& token);
+
   /**
   * Parse a non-transposed matrix.
   *
@@ -68,6 +68,30 @@ inline bool LoadImage(const std::string& filename,
                       ImageInfo& info,
                       const bool fatal = false);
 
+/**
+ * Resize a decoded image with bilinear interpolation.  The source and
+ * destination buffers hold interleaved channels in row-major order, as
+ * produced by LoadImage().  This is used by the batch Load() overload to
+ * resize images on the fly when the target width and height are preset on
+ * the ImageInfo.
+ *
+ * @param src Source pixel buffer (srcWidth * srcHeight * channels bytes).
+ * @param srcWidth Width of the source image.
+ * @param srcHeight Height of the source image.
+ * @param channels Number of channels in both images.
+ * @param dest Destination pixel buffer (destWidth * destHeight * channels
+ *     bytes).
+ * @param destWidth Width of the resized image.
+ * @param destHeight Height of the resized image.
+ */
+inline void ResizeImageColumn(const unsigned char* src,
+                              const size_t srcWidth,
+                              const size_t srcHeight,
+                              const size_t channels,
+                              unsigned char* dest,
+                              const size_t destWidth,
+                              const size_t destHeight);
+
 } // namespace data
 } // namespace mlpack
 
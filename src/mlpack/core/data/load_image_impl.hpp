@@ -16,9 +16,54 @@
 #include "load_image.hpp"
 #include "image_info.hpp"
 
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace data {
 
+inline void ResizeImageColumn(const unsigned char* src,
+                              const size_t srcWidth,
+                              const size_t srcHeight,
+                              const size_t channels,
+                              unsigned char* dest,
+                              const size_t destWidth,
+                              const size_t destHeight)
+{
+  const double xScale = (double) srcWidth / (double) destWidth;
+  const double yScale = (double) srcHeight / (double) destHeight;
+
+  for (size_t y = 0; y < destHeight; ++y)
+  {
+    // Sample at the pixel centers of the source image.
+    const double srcY = std::max(0.0, (y + 0.5) * yScale - 0.5);
+    const size_t y0 = std::min((size_t) srcY, srcHeight - 1);
+    const size_t y1 = std::min(y0 + 1, srcHeight - 1);
+    const double yFrac = srcY - (double) y0;
+
+    for (size_t x = 0; x < destWidth; ++x)
+    {
+      const double srcX = std::max(0.0, (x + 0.5) * xScale - 0.5);
+      const size_t x0 = std::min((size_t) srcX, srcWidth - 1);
+      const size_t x1 = std::min(x0 + 1, srcWidth - 1);
+      const double xFrac = srcX - (double) x0;
+
+      for (size_t c = 0; c < channels; ++c)
+      {
+        const double top =
+            (1.0 - xFrac) * src[(y0 * srcWidth + x0) * channels + c] +
+            xFrac * src[(y0 * srcWidth + x1) * channels + c];
+        const double bottom =
+            (1.0 - xFrac) * src[(y1 * srcWidth + x0) * channels + c] +
+            xFrac * src[(y1 * srcWidth + x1) * channels + c];
+        dest[(y * destWidth + x) * channels + c] =
+            (unsigned char) ((1.0 - yFrac) * top + yFrac * bottom + 0.5);
+      }
+    }
+  }
+}
+
 // Image loading API.
 template<typename eT>
 bool Load(const std::string& filename,
@@ -65,25 +110,104 @@ bool Load(const std::vector<std::string>& files,
     return false;
   }
 
+  // If the width and height are preset on the given ImageInfo, every image
+  // is resized to those dimensions as it is decoded; otherwise the first
+  // image fixes the dimensions and the others must match them.
+  const bool resize = (info.Width() > 0 && info.Height() > 0);
   arma::Mat<unsigned char> img;
-  bool status = LoadImage(files[0], img, info, fatal);
+  size_t start = 0;
+  if (!resize)
+  {
+    if (!LoadImage(files[0], img, info, fatal))
+      return false;
+    start = 1;
+  }
 
-  if (!status)
-    return false;
+  const size_t targetWidth = info.Width();
+  const size_t targetHeight = info.Height();
+  // LoadImage() decodes to one channel if one was requested, and to three
+  // channels otherwise.
+  const size_t channels = (info.Channels() == 1) ? 1 : 3;
+  info.Channels() = channels;
 
   // Decide matrix dimension using the image height and width.
   arma::Mat<unsigned char> tmpMatrix(
-      info.Width() * info.Height() * info.Channels(), files.size());
-  tmpMatrix.col(0) = img;
+      targetWidth * targetHeight * channels, files.size());
+  if (start == 1)
+    tmpMatrix.col(0) = img;
+
+  // The images are independent, so they are decoded in parallel, each one
+  // straight into its own column of the batch matrix.  The first error
+  // encountered (by index) is reported after the loop, so that the error
+  // that gets reported does not depend on the schedule.
+  bool loadOkay = true;
+  size_t failIndex = files.size();
+  std::string failMessage;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = start; i < files.size(); ++i)
+  {
+    if (!loadOkay)
+      continue;
+
+    arma::Mat<unsigned char> colImg;
+    ImageInfo localInfo = info;
+    std::string localMessage;
+    if (!LoadImage(files[i], colImg, localInfo, false))
+    {
+      localMessage = "Load(): failed to load image '" + files[i] + "'.";
+    }
+    else if (localInfo.Channels() != channels)
+    {
+      std::ostringstream oss;
+      oss << "Load(): image '" << files[i] << "' has "
+          << localInfo.Channels() << " channels, but the batch has "
+          << channels << " channels.";
+      localMessage = oss.str();
+    }
+    else if (localInfo.Width() == targetWidth &&
+             localInfo.Height() == targetHeight)
+    {
+      tmpMatrix.col(i) = colImg;
+      continue;
+    }
+    else if (resize)
+    {
+      ResizeImageColumn(colImg.memptr(), localInfo.Width(),
+          localInfo.Height(), channels, tmpMatrix.colptr(i), targetWidth,
+          targetHeight);
+      continue;
+    }
+    else
+    {
+      std::ostringstream oss;
+      oss << "Load(): image '" << files[i] << "' has size "
+          << localInfo.Width() << "x" << localInfo.Height()
+          << ", but the batch has size " << targetWidth << "x"
+          << targetHeight << "; preset the width and height on the ImageInfo "
+          << "to resize images on load.";
+      localMessage = oss.str();
+    }
+
+    #pragma omp critical (LoadImageBatchError)
+    {
+      if (i < failIndex)
+      {
+        loadOkay = false;
+        failIndex = i;
+        failMessage = localMessage;
+      }
+    }
+  }
 
-  for (size_t i = 1; i < files.size() ; ++i)
+  if (!loadOkay)
   {
-    arma::Mat<unsigned char> colImg(tmpMatrix.colptr(i), tmpMatrix.n_rows, 1,
-        false, true);
-    status = LoadImage(files[i], colImg, info, fatal);
+    if (fatal)
+      Log::Fatal << failMessage << std::endl;
+    else
+      Log::Warn << failMessage << std::endl;
 
-    if (!status)
-      return false;
+    return false;
   }
 
   matrix = arma::conv_to<arma::Mat<eT>>::from(tmpMatrix);
@@ -0,0 +1,175 @@
+/**
+ * @file core/data/load_mapped.hpp
+ * @author Ryan Curtin
+ *
+ * Memory-mapped loading of Armadillo binary matrix files.  Instead of
+ * reading the file into freshly allocated memory, the data section of the
+ * file is mapped into the address space and the matrix is made a borrowed
+ * alias of the mapping.  Pages are then faulted in on demand, so a matrix
+ * the chosen code path never touches costs nothing, and the page cache is
+ * shared between processes loading the same file.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_MAPPED_HPP
+#define MLPACK_CORE_DATA_LOAD_MAPPED_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/log.hpp>
+
+#include "extension.hpp"
+
+#if !defined(_WIN32)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+#if !defined(_WIN32)
+
+/**
+ * The list of active file mappings.  Matrices loaded with LoadMapped() alias
+ * mapped pages, so mappings are only released at process exit, when no
+ * matrix can be using them anymore.
+ */
+class MappedRegionList
+{
+ public:
+  //! Get the singleton list.
+  static MappedRegionList& Instance()
+  {
+    static MappedRegionList list;
+    return list;
+  }
+
+  //! Register a mapping to be released at process exit.
+  void Add(void* address, const size_t length)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    regions.push_back(std::make_pair(address, length));
+  }
+
+  //! Release all mappings.
+  ~MappedRegionList()
+  {
+    for (size_t i = 0; i < regions.size(); ++i)
+      munmap(regions[i].first, regions[i].second);
+  }
+
+ private:
+  //! The active mappings (address and length).
+  std::vector<std::pair<void*, size_t>> regions;
+  //! Guard against concurrent registration.
+  std::mutex mutex;
+};
+
+#endif
+
+/**
+ * Try to load an Armadillo binary format file by memory-mapping it, making
+ * the given matrix a borrowed alias of the mapped data section.  Returns
+ * false without touching the matrix if the file cannot be mapped, in which
+ * case the caller should fall back to a regular data::Load(); this happens
+ * when:
+ *
+ *  - the platform has no mmap() (Windows);
+ *  - a transposed load is requested (the transpose is a copy anyway);
+ *  - the file is not in Armadillo binary format for the element type of the
+ *    matrix, or its data section is not aligned for that element type.
+ *
+ * The mapping is private (copy-on-write), so writing to the matrix does not
+ * modify the file; resizing it allocates fresh memory as for any borrowed
+ * alias.  Mappings are released at process exit.
+ *
+ * @param filename Name of the file to map.
+ * @param matrix Matrix to alias the mapped data with.
+ * @param transpose Whether a transposed load was requested.
+ * @return true if the matrix now aliases the mapped file.
+ */
+template<typename eT>
+bool LoadMapped(const std::string& filename,
+                arma::Mat<eT>& matrix,
+                const bool transpose)
+{
+#if defined(_WIN32)
+  (void) filename;
+  (void) matrix;
+  (void) transpose;
+  return false;
+#else
+  // The on-disk layout only matches memory when no transpose is needed.
+  if (transpose)
+    return false;
+  if (Extension(filename) != "bin")
+    return false;
+
+  // Check the Armadillo binary header and find the data offset.
+  std::ifstream ifs(filename, std::ios::binary);
+  if (!ifs.is_open())
+    return false;
+
+  std::string header;
+  std::getline(ifs, header);
+  if (header != arma::diskio::gen_bin_header(matrix))
+    return false;
+
+  arma::uword nRows, nCols;
+  std::string dims;
+  std::getline(ifs, dims);
+  std::istringstream dimStream(dims);
+  dimStream >> nRows >> nCols;
+  if (dimStream.fail())
+    return false;
+
+  const size_t offset = (size_t) ifs.tellg();
+  ifs.close();
+
+  // The data section must be aligned for the element type, and the file must
+  // actually contain all the elements the header promises.
+  if (offset % alignof(eT) != 0)
+    return false;
+
+  struct stat fileStat;
+  if (stat(filename.c_str(), &fileStat) != 0)
+    return false;
+  if ((size_t) fileStat.st_size < offset + nRows * nCols * sizeof(eT))
+    return false;
+
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  void* base = mmap(NULL, (size_t) fileStat.st_size, PROT_READ | PROT_WRITE,
+      MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED)
+    return false;
+
+  MappedRegionList::Instance().Add(base, (size_t) fileStat.st_size);
+
+  // Turn the matrix into a borrowed alias of the mapped data section, the
+  // same way the language bindings alias foreign memory.
+  matrix.reset();
+  arma::access::rw(matrix.mem) = (eT*) ((char*) base + offset);
+  arma::access::rw(matrix.n_rows) = nRows;
+  arma::access::rw(matrix.n_cols) = nCols;
+  arma::access::rw(matrix.n_elem) = nRows * nCols;
+  arma::access::rw(matrix.mem_state) = 1;
+
+  Log::Info << "Memory-mapped matrix from '" << filename << "' ("
+      << nRows << "x" << nCols << ")." << std::endl;
+  return true;
+#endif
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
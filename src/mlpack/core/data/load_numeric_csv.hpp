@@ -12,6 +12,8 @@
 #ifndef MLPACK_CORE_DATA_LOAD_NUMERIC_CSV_HPP
 #define MLPACK_CORE_DATA_LOAD_NUMERIC_CSV_HPP
 
+#include <cstring>
+
 #include "load_csv.hpp"
 
 namespace mlpack {
@@ -128,29 +130,64 @@ bool LoadCSV::LoadNumericCSV(arma::Mat<eT>& x, std::fstream& f)
   f.clear();
   std::pair<size_t, size_t> mat_size = GetMatrixSize<true>(f);
   x.zeros(mat_size.first, mat_size.second);
-  size_t row = 0;
-
-  std::string lineString;
-  std::stringstream lineStream;
-  std::string token;
 
-  while (f.good())
+  // Read the remaining file contents into one contiguous buffer with a
+  // single bulk read; per-line stream tokenization dominates load time for
+  // large files.
+  const std::streamoff start = f.tellg();
+  f.seekg(0, std::ios::end);
+  const std::streamoff fileEnd = f.tellg();
+  f.seekg(start);
+  const size_t bufferSize = size_t(fileEnd - start);
+  std::vector<char> buffer(bufferSize + 1);
+  f.read(buffer.data(), bufferSize);
+  buffer[bufferSize] = '\0';
+  const char* data = buffer.data();
+
+  // Find the row boundaries; like the streaming loader, we stop at the
+  // first empty line.
+  std::vector<size_t> lineStarts, lineEnds;
+  lineStarts.reserve(x.n_rows);
+  lineEnds.reserve(x.n_rows);
+  size_t offset = 0;
+  while (offset < bufferSize && lineStarts.size() < x.n_rows)
   {
-    // Parse the file line by line.
-    std::getline(f, lineString);
-
-    if (lineString.size() == 0)
+    const char* eol = (const char*) std::memchr(data + offset, '\n',
+        bufferSize - offset);
+    size_t end = eol ? size_t(eol - data) : bufferSize;
+    // Strip a trailing carriage return (CRLF line endings).
+    if (end > offset && data[end - 1] == '\r')
+      --end;
+    if (end == offset)
       break;
+    lineStarts.push_back(offset);
+    lineEnds.push_back(end);
+    offset = (eol ? size_t(eol - data) : bufferSize) + 1;
+  }
 
-    lineStream.clear();
-    lineStream.str(lineString);
+  // Parse all rows in parallel, each chunk writing directly into its rows of
+  // the matrix.  A conversion failure is recorded and reported after the
+  // parallel region.
+  bool parseOkay = true;
+  size_t failRow = 0, failCol = 0;
+  std::string failToken;
+  #pragma omp parallel for
+  for (size_t row = 0; row < lineStarts.size(); ++row)
+  {
+    if (!parseOkay)
+      continue;
 
+    const char* pos = data + lineStarts[row];
+    const char* lineEnd = data + lineEnds[row];
     size_t col = 0;
-
-    while (lineStream.good())
+    std::string token;
+    while (pos <= lineEnd)
     {
-      // Parse each line.
-      std::getline(lineStream, token, ',');
+      const char* tokEnd = (const char*) std::memchr(pos, ',',
+          lineEnd - pos);
+      if (tokEnd == NULL)
+        tokEnd = lineEnd;
+      token.assign(pos, tokEnd);
 
       // This will handle loading of both dense and sparse.
       // Initialize tmp_val of type eT with value 0.
@@ -160,18 +197,35 @@ bool LoadCSV::LoadNumericCSV(arma::Mat<eT>& x, std::fstream& f)
       {
         x.at(row, col) = tmpVal;
         ++col;
+        pos = tokEnd + 1;
       }
       else
       {
-        // Printing failed token and it's location.
-        Log::Warn << "Failed to convert token " << token << ", at row " << row
-            << ", column " << col << " of matrix!";
-
-        return false;
+        #pragma omp critical (LoadNumericCSVFailure)
+        {
+          parseOkay = false;
+          failRow = row;
+          failCol = col;
+          failToken = token;
+        }
+        break;
       }
     }
-    ++row;
   }
+
+  if (!parseOkay)
+  {
+    // Printing failed token and it's location.
+    Log::Warn << "Failed to convert token " << failToken << ", at row "
+        << failRow << ", column " << failCol << " of matrix!";
+
+    return false;
+  }
+
+  // Leave the stream at the end of the parsed data, as the streaming loader
+  // did.
+  f.clear();
+  f.seekg(fileEnd);
   return loadOkay;
 }
 
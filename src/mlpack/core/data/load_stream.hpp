@@ -0,0 +1,274 @@
+/**
+ * @file core/data/load_stream.hpp
+ * @author Ryan Curtin
+ *
+ * Definition of the LoadStream class, which reads a numeric dataset in
+ * fixed-size column chunks with background prefetching, for out-of-core
+ * training with the incremental learners.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_STREAM_HPP
+#define MLPACK_CORE_DATA_LOAD_STREAM_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Stream a numeric CSV dataset from disk in fixed-size column chunks instead
+ * of materializing the whole matrix.  A background thread always reads and
+ * parses the next chunk while the caller works on the current one (double
+ * buffering), so I/O overlaps with training.
+ *
+ * As everywhere in mlpack, each point of the dataset becomes one column of a
+ * chunk (the file is transposed while loading, like `data::Load()` with
+ * `transpose = true`).  Chunks are ordinary Armadillo matrices, so they plug
+ * directly into any learner with incremental training support, e.g.
+ * `HoeffdingTree`, `NaiveBayesClassifier`, or mini-batch `KMeans`:
+ *
+ * @code
+ * data::LoadStream<> stream("dataset.csv", 1000);
+ * arma::mat chunk;
+ * while (stream.Next(chunk))
+ * {
+ *   // Here the last dimension holds the labels.
+ *   arma::Row<size_t> labels = arma::conv_to<arma::Row<size_t>>::from(
+ *       chunk.row(chunk.n_rows - 1));
+ *   tree.Train(chunk.rows(0, chunk.n_rows - 2), labels, false);
+ * }
+ * @endcode
+ *
+ * @tparam eT The element type of the chunks to produce.
+ */
+template<typename eT = double>
+class LoadStream
+{
+ public:
+  /**
+   * Open the given file and start prefetching the first chunk.  The
+   * dimensionality of the dataset is taken from the first line of the file.
+   *
+   * An optional transform is applied to each chunk on the prefetch thread,
+   * before the chunk is handed over; this is the place to hang a fitted
+   * scaler so that scaling happens during ingest, in the same pass over
+   * memory as parsing:
+   *
+   * @code
+   * data::StandardScaler scaler;
+   * scaler.Fit(sample);  // Fit on a sample loaded beforehand.
+   * data::LoadStream<> stream("dataset.csv", 1000, false,
+   *     [&scaler](arma::mat& chunk) { scaler.Transform(chunk); });
+   * @endcode
+   *
+   * @param filename Name of the numeric CSV file to stream.
+   * @param chunkPoints Number of points (columns) per chunk.
+   * @param fatal If true, an error while opening will throw a
+   *     std::runtime_error instead of printing a warning.
+   * @param transform Optional function applied to each chunk before it is
+   *     handed to the consumer.
+   */
+  LoadStream(const std::string& filename,
+             const size_t chunkPoints,
+             const bool fatal = false,
+             const std::function<void(arma::Mat<eT>&)>& transform = nullptr) :
+      transform(transform),
+      chunkPoints(chunkPoints),
+      dimensionality(0),
+      ready(false),
+      eof(false),
+      shutdown(false)
+  {
+    f.open(filename);
+    if (!f.is_open())
+    {
+      if (fatal)
+        Log::Fatal << "Cannot open file '" << filename << "' for streaming."
+            << std::endl;
+      else
+        Log::Warn << "Cannot open file '" << filename << "' for streaming."
+            << std::endl;
+      eof = true;
+      return;
+    }
+
+    // Determine the dimensionality from the first line, then rewind.
+    std::string line;
+    if (!std::getline(f, line) || line.empty())
+    {
+      eof = true;
+      return;
+    }
+    dimensionality = 1 +
+        std::count(line.begin(), line.end(), ',');
+    f.clear();
+    f.seekg(0);
+
+    prefetcher = std::thread(&LoadStream::PrefetchLoop, this);
+  }
+
+  //! Stop the prefetch thread and close the file.
+  ~LoadStream()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      shutdown = true;
+    }
+    produceCv.notify_all();
+    if (prefetcher.joinable())
+      prefetcher.join();
+  }
+
+  // Streams hold a background thread and cannot be copied.
+  LoadStream(const LoadStream&) = delete;
+  LoadStream& operator=(const LoadStream&) = delete;
+
+  /**
+   * Get the next chunk of points.  Blocks until the prefetched chunk is
+   * available (usually it already is) and immediately triggers prefetching
+   * of the chunk after it.  The final chunk may hold fewer than
+   * `chunkPoints` points.
+   *
+   * @param chunk Matrix to store the chunk in.
+   * @return true if a chunk was produced; false once the file is exhausted.
+   */
+  bool Next(arma::Mat<eT>& chunk)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    consumeCv.wait(lock, [this]() { return ready || eof; });
+    if (!ready)
+      return false;
+
+    chunk = std::move(buffer);
+    ready = false;
+    lock.unlock();
+    produceCv.notify_one();
+    return true;
+  }
+
+  //! Get the dimensionality of the streamed dataset.
+  size_t Dimensionality() const { return dimensionality; }
+
+ private:
+  /**
+   * Body of the prefetch thread: parse one chunk at a time and hand each
+   * over as soon as the consumer has taken the previous one.
+   */
+  void PrefetchLoop()
+  {
+    while (true)
+    {
+      // Read and parse the next chunk outside the lock.
+      arma::Mat<eT> local(dimensionality, chunkPoints, arma::fill::zeros);
+      size_t points = 0;
+      std::string line;
+      while (points < chunkPoints && std::getline(f, line))
+      {
+        if (line.empty())
+          break;
+        ParseLine(line, local.colptr(points));
+        ++points;
+      }
+      const bool last = (points < chunkPoints);
+      if (points < chunkPoints)
+        local.resize(dimensionality, points);
+      if (transform && points > 0)
+        transform(local);
+
+      std::unique_lock<std::mutex> lock(mutex);
+      produceCv.wait(lock, [this]() { return !ready || shutdown; });
+      if (shutdown)
+        return;
+
+      if (points > 0)
+      {
+        buffer = std::move(local);
+        ready = true;
+      }
+      if (last)
+        eof = true;
+      consumeCv.notify_one();
+      if (last)
+        return;
+    }
+  }
+
+  /**
+   * Parse one comma-separated line into the given column; missing or empty
+   * fields are left as 0, matching the batch CSV loader.
+   *
+   * @param line The line to parse.
+   * @param col Pointer to the column to fill (dimensionality elements).
+   */
+  void ParseLine(const std::string& line, eT* col)
+  {
+    const char* pos = line.c_str();
+    for (size_t d = 0; d < dimensionality; ++d)
+    {
+      char* end = NULL;
+      const eT val = eT(std::strtod(pos, &end));
+      if (end != pos)
+      {
+        col[d] = val;
+        pos = end;
+      }
+
+      // Advance past the delimiter of this field, if there is one.
+      while (*pos != '\0' && *pos != ',')
+        ++pos;
+      if (*pos == ',')
+        ++pos;
+      else
+        break;
+    }
+  }
+
+  //! The stream the dataset is read from.
+  std::ifstream f;
+
+  //! Optional transform applied to each chunk on the prefetch thread.
+  std::function<void(arma::Mat<eT>&)> transform;
+
+  //! Number of points per chunk.
+  size_t chunkPoints;
+
+  //! Dimensionality of the dataset (taken from the first line).
+  size_t dimensionality;
+
+  //! The prefetched chunk, valid while `ready` is true.
+  arma::Mat<eT> buffer;
+
+  //! Whether `buffer` holds an unconsumed chunk.
+  bool ready;
+
+  //! Whether the file has been fully read.
+  bool eof;
+
+  //! Whether the stream is being destructed.
+  bool shutdown;
+
+  //! Protects `buffer`, `ready`, `eof`, and `shutdown`.
+  std::mutex mutex;
+
+  //! Signalled when a chunk becomes available or the file is exhausted.
+  std::condition_variable consumeCv;
+
+  //! Signalled when the consumer has taken the prefetched chunk.
+  std::condition_variable produceCv;
+
+  //! The background prefetch thread.
+  std::thread prefetcher;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -42,6 +42,12 @@ class IncrementPolicy
   //! We do need a first pass over the data to set the dimension types right.
   static const bool NeedsFirstPass = true;
 
+  //! In a dimension that is marked numeric, a token that cleanly parses as a
+  //! finite number is never mapped; parsers may convert such tokens directly
+  //! without calling MapString().  (With forceAllMappings, the first pass
+  //! marks every dimension categorical, so this shortcut never applies.)
+  static const bool MapsNumericTokens = false;
+
   /**
    * Determine if the dimension is numeric or categorical.
    */
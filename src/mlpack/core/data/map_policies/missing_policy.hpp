@@ -55,6 +55,10 @@ class MissingPolicy
   //! This doesn't need a first pass over the data to set up.
   static const bool NeedsFirstPass = false;
 
+  //! Even a token that parses cleanly as a number may be in the missing set,
+  //! so every token must go through MapString().
+  static const bool MapsNumericTokens = true;
+
   /**
    * There is nothing for us to do here, but this is required by the MapPolicy
    * type.
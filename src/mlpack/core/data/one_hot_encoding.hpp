@@ -62,6 +62,40 @@ void OneHotEncoding(const arma::Mat<eT>& input,
                     arma::Mat<eT>& output,
                     const data::DatasetInfo& datasetInfo);
 
+/**
+ * Overloaded function for the above function, which produces a sparse output
+ * matrix.  One-hot encoded dimensions hold a single one per point, so for
+ * high-cardinality categorical dimensions the dense output is almost
+ * entirely zeros; this overload builds the output in a single pass with
+ * preallocated nonzero arrays instead.
+ *
+ * The dimensions marked `Datatype::categorical` must hold the mapped
+ * category values given by the DatasetInfo, as produced by loading the data
+ * with that DatasetInfo.
+ *
+ * @param input Input dataset to be encoded.
+ * @param output Encoded sparse matrix.
+ * @param datasetInfo DatasetInfo object that has information about data.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    arma::SpMat<eT>& output,
+                    const data::DatasetInfo& datasetInfo);
+
+/**
+ * Invert the one-hot encoding given by the DatasetInfo, recovering the
+ * original dataset (with categorical dimensions holding their mapped
+ * category values).
+ *
+ * @param input One-hot encoded sparse matrix.
+ * @param output Matrix to store the decoded dataset in.
+ * @param datasetInfo DatasetInfo object that the encoding was based on.
+ */
+template<typename eT>
+void OneHotDecoding(const arma::SpMat<eT>& input,
+                    arma::Mat<eT>& output,
+                    const data::DatasetInfo& datasetInfo);
+
 } // namespace data
 } // namespace mlpack
 
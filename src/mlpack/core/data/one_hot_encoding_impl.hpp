@@ -169,6 +169,112 @@ void OneHotEncoding(const arma::Mat<eT>& input,
   OneHotEncoding(input, arma::Col<size_t>(indices), output);
 }
 
+/**
+ * Overloaded function for the above function, which produces a sparse output
+ * matrix.  The dimensions marked `Datatype::categorical` must hold the
+ * mapped category values given by the DatasetInfo.
+ *
+ * @param input Input dataset to be encoded.
+ * @param output Encoded sparse matrix.
+ * @param datasetInfo DatasetInfo object that has information about data.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    arma::SpMat<eT>& output,
+                    const data::DatasetInfo& datasetInfo)
+{
+  // The category counts are already known to the DatasetInfo, so the size of
+  // the output can be computed without scanning the data.
+  arma::Col<size_t> dimensionOffsets(input.n_rows + 1);
+  dimensionOffsets[0] = 0;
+  for (size_t i = 0; i < input.n_rows; ++i)
+  {
+    const size_t dims = (datasetInfo.Type(i) == Datatype::categorical) ?
+        datasetInfo.NumMappings(i) : 1;
+    dimensionOffsets[i + 1] = dimensionOffsets[i] + dims;
+  }
+
+  // Each point contributes at most one nonzero per input dimension, so the
+  // nonzero arrays can be preallocated and filled in a single pass.
+  arma::umat locations(2, input.n_rows * input.n_cols);
+  arma::Col<eT> values(input.n_rows * input.n_cols);
+  size_t count = 0;
+  for (size_t col = 0; col < input.n_cols; ++col)
+  {
+    for (size_t row = 0; row < input.n_rows; ++row)
+    {
+      if (datasetInfo.Type(row) == Datatype::categorical)
+      {
+        locations(0, count) = dimensionOffsets[row] +
+            (size_t) input(row, col);
+        locations(1, count) = col;
+        values[count++] = eT(1);
+      }
+      else if (input(row, col) != eT(0))
+      {
+        locations(0, count) = dimensionOffsets[row];
+        locations(1, count) = col;
+        values[count++] = input(row, col);
+      }
+    }
+  }
+
+  // The pass above emits the nonzeros in column-major order, so the batch
+  // constructor does not need to sort them.
+  output = arma::SpMat<eT>(locations.head_cols(count), values.head(count),
+      dimensionOffsets[input.n_rows], input.n_cols, false, false);
+}
+
+/**
+ * Invert the one-hot encoding given by the DatasetInfo, recovering the
+ * original dataset.
+ *
+ * @param input One-hot encoded sparse matrix.
+ * @param output Matrix to store the decoded dataset in.
+ * @param datasetInfo DatasetInfo object that the encoding was based on.
+ */
+template<typename eT>
+void OneHotDecoding(const arma::SpMat<eT>& input,
+                    arma::Mat<eT>& output,
+                    const data::DatasetInfo& datasetInfo)
+{
+  const size_t dimensionality = datasetInfo.Dimensionality();
+  arma::Col<size_t> dimensionOffsets(dimensionality + 1);
+  dimensionOffsets[0] = 0;
+  for (size_t i = 0; i < dimensionality; ++i)
+  {
+    const size_t dims = (datasetInfo.Type(i) == Datatype::categorical) ?
+        datasetInfo.NumMappings(i) : 1;
+    dimensionOffsets[i + 1] = dimensionOffsets[i] + dims;
+  }
+
+  if (dimensionOffsets[dimensionality] != input.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "OneHotDecoding(): the given matrix has " << input.n_rows
+        << " dimensions, but the DatasetInfo encodes to "
+        << dimensionOffsets[dimensionality] << " dimensions!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  output.zeros(dimensionality, input.n_cols);
+
+  // Each nonzero belongs to the block of one input dimension; for a
+  // categorical dimension its position inside the block is the mapped
+  // category value.
+  typename arma::SpMat<eT>::const_iterator it = input.begin();
+  for (; it != input.end(); ++it)
+  {
+    const size_t dim = std::upper_bound(dimensionOffsets.begin(),
+        dimensionOffsets.end(), it.row()) - dimensionOffsets.begin() - 1;
+
+    if (datasetInfo.Type(dim) == Datatype::categorical)
+      output(dim, it.col()) = eT(it.row() - dimensionOffsets[dim]);
+    else
+      output(dim, it.col()) = (*it);
+  }
+}
+
 } // namespace data
 } // namespace mlpack
 
@@ -103,6 +103,27 @@ class MinMaxScaler
     output = (input.each_col() % scale).each_col() + scalerowmin;
   }
 
+  /**
+   * Function to scale features in-place, without an output copy.  The
+   * columns are processed in parallel, each in one fused pass over its
+   * memory; this is the overload to prefer for datasets large enough that a
+   * second copy matters.
+   *
+   * @param input Dataset to scale features; overwritten with the result.
+   */
+  template<typename MatType>
+  void Transform(MatType& input)
+  {
+    if (scalerowmin.is_empty() || scale.is_empty())
+    {
+      throw std::runtime_error("Call Fit() before Transform(), please"
+          " refer to the documentation.");
+    }
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < (size_t) input.n_cols; ++i)
+      input.col(i) = (input.col(i) % scale) + scalerowmin;
+  }
+
   /**
    * Function to retrieve original dataset.
    *
@@ -116,6 +137,20 @@ class MinMaxScaler
     output = (input.each_col() - scalerowmin).each_col() / scale;
   }
 
+  /**
+   * Function to retrieve the original dataset in-place, without an output
+   * copy.
+   *
+   * @param input Scaled dataset; overwritten with the original dataset.
+   */
+  template<typename MatType>
+  void InverseTransform(MatType& input)
+  {
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < (size_t) input.n_cols; ++i)
+      input.col(i) = (input.col(i) - scalerowmin) / scale;
+  }
+
   //! Get the Min row vector.
   const arma::vec& ItemMin() const { return itemMin; }
   //! Get the Max row vector.
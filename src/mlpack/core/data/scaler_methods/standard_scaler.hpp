@@ -80,6 +80,27 @@ class StandardScaler
     output = (input.each_col() - itemMean).each_col() / itemStdDev;
   }
 
+  /**
+   * Function to scale features in-place, without an output copy.  The
+   * columns are processed in parallel, each in one fused pass over its
+   * memory; this is the overload to prefer for datasets large enough that a
+   * second copy matters.
+   *
+   * @param input Dataset to scale features; overwritten with the result.
+   */
+  template<typename MatType>
+  void Transform(MatType& input)
+  {
+    if (itemMean.is_empty() || itemStdDev.is_empty())
+    {
+      throw std::runtime_error("Call Fit() before Transform(), please"
+        " refer to the documentation.");
+    }
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < (size_t) input.n_cols; ++i)
+      input.col(i) = (input.col(i) - itemMean) / itemStdDev;
+  }
+
   /**
    * Function to retrieve original dataset.
    *
@@ -93,6 +114,20 @@ class StandardScaler
     output = (input.each_col() % itemStdDev).each_col() + itemMean;
   }
 
+  /**
+   * Function to retrieve the original dataset in-place, without an output
+   * copy.
+   *
+   * @param input Scaled dataset; overwritten with the original dataset.
+   */
+  template<typename MatType>
+  void InverseTransform(MatType& input)
+  {
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < (size_t) input.n_cols; ++i)
+      input.col(i) = (input.col(i) % itemStdDev) + itemMean;
+  }
+
   //! Get the mean row vector.
   const arma::vec& ItemMean() const { return itemMean; }
   //! Get the standard deviation row vector.
@@ -62,6 +62,143 @@ void SplitHelper(const InputType& input,
   }
 }
 
+/**
+ * Generate the column indices of a train/test split without touching the data
+ * itself.  This is the copy-free counterpart of Split(): the returned index
+ * vectors can be used with SplitView (or directly with `input.cols()`) so
+ * that no second copy of the dataset is ever materialized.
+ *
+ * @param numPoints Number of points (columns) in the dataset to split.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and
+ *     1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *     sample is visited in linear order. (Default true.)
+ * @return std::tuple containing the training indices (arma::uvec) and the
+ *     test indices (arma::uvec).
+ */
+inline std::tuple<arma::uvec, arma::uvec> SplitIndices(
+    const size_t numPoints,
+    const double testRatio,
+    const bool shuffleData = true)
+{
+  if (numPoints == 0)
+    return std::make_tuple(arma::uvec(), arma::uvec());
+
+  const size_t testSize = static_cast<size_t>(numPoints * testRatio);
+  const size_t trainSize = numPoints - testSize;
+
+  arma::uvec order = arma::linspace<arma::uvec>(0, numPoints - 1, numPoints);
+  if (shuffleData)
+    order = arma::shuffle(order);
+
+  arma::uvec trainIdx = (trainSize > 0) ?
+      arma::uvec(order.subvec(0, trainSize - 1)) : arma::uvec();
+  arma::uvec testIdx = (testSize > 0) ?
+      arma::uvec(order.subvec(trainSize, numPoints - 1)) : arma::uvec();
+
+  return std::make_tuple(std::move(trainIdx), std::move(testIdx));
+}
+
+/**
+ * A lightweight view of a subset of the columns of a dataset, defined by a
+ * column index vector.  The view holds only a reference to the underlying
+ * matrix plus the indices, so splitting an 80GB dataset with SplitViews()
+ * costs only the index vectors instead of a full copy of every point.
+ *
+ * Points can be accessed individually through `Col()` and `operator()`, which
+ * is enough for mini-batch loops; when a learner needs a contiguous matrix,
+ * call Materialize() to produce one explicitly.
+ *
+ * The view does not take ownership: the underlying matrix must outlive it.
+ *
+ * @tparam MatType The type of the underlying matrix.
+ */
+template<typename MatType>
+class SplitView
+{
+ public:
+  /**
+   * Construct the view on the given matrix, selecting the given columns.
+   *
+   * @param data Matrix to view; it must outlive the view.
+   * @param indices Columns of `data` that make up the view, in order.
+   */
+  SplitView(const MatType& data, arma::uvec indices) :
+      data(data),
+      indices(std::move(indices))
+  {
+    // Nothing to do.
+  }
+
+  //! Get the number of dimensions (rows) of the view.
+  size_t NumRows() const { return data.n_rows; }
+  //! Get the number of points (columns) of the view.
+  size_t NumCols() const { return indices.n_elem; }
+
+  //! Access one element of the view.
+  typename MatType::elem_type operator()(const size_t row,
+                                         const size_t col) const
+  {
+    return data(row, indices[col]);
+  }
+
+  //! Get one point (column) of the view, without copying it.
+  auto Col(const size_t col) const
+      -> decltype(std::declval<const MatType&>().col(0))
+  {
+    return data.col(indices[col]);
+  }
+
+  //! Get the underlying matrix.
+  const MatType& Data() const { return data; }
+  //! Get the column indices that make up the view.
+  const arma::uvec& Indices() const { return indices; }
+
+  //! Gather the viewed columns into a contiguous matrix.  This is the only
+  //! operation that copies the data.
+  MatType Materialize() const { return data.cols(indices); }
+
+ private:
+  //! Reference to the viewed matrix.
+  const MatType& data;
+  //! The columns of the matrix that make up the view.
+  arma::uvec indices;
+};
+
+/**
+ * Given an input dataset, split into a training view and a test view without
+ * copying any points.  This is the copy-free counterpart of
+ * `Split(input, testRatio)`: the returned views reference `input` (which must
+ * outlive them), and a contiguous copy is only made if Materialize() is
+ * called on a view.
+ *
+ * @code
+ * arma::mat input = loadData();
+ * auto views = SplitViews(input, 0.2);
+ * arma::mat trainData = std::get<0>(views).Materialize();
+ * @endcode
+ *
+ * @param input Input dataset to split; it must outlive the returned views.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and
+ *     1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *     sample is visited in linear order. (Default true.)
+ * @return std::tuple containing the training view and the test view.
+ */
+template<typename MatType>
+std::tuple<SplitView<MatType>, SplitView<MatType>>
+SplitViews(const MatType& input,
+           const double testRatio,
+           const bool shuffleData = true)
+{
+  arma::uvec trainIdx, testIdx;
+  std::tie(trainIdx, testIdx) = SplitIndices(input.n_cols, testRatio,
+      shuffleData);
+
+  return std::make_tuple(SplitView<MatType>(input, std::move(trainIdx)),
+                         SplitView<MatType>(input, std::move(testIdx)));
+}
+
 /**
  * Given an input dataset and labels, stratify into a training set and test set.
  * It is recommended to have the input labels between the range [0, n) where n
@@ -39,6 +39,10 @@ class StringEncodingDictionary
   //! The type of the token that the dictionary stores.
   using TokenType = Token;
 
+  //! The dictionary stores the tokens it has seen; labels depend on the
+  //! insertion order.
+  static const bool Stateless = false;
+
   /**
    * The function returns true if the dictionary contains the given token.
    *
@@ -121,6 +125,10 @@ class StringEncodingDictionary<MLPACK_STRING_VIEW>
   //! The type of the token that the dictionary stores.
   using TokenType = MLPACK_STRING_VIEW;
 
+  //! The dictionary stores the tokens it has seen; labels depend on the
+  //! insertion order.
+  static const bool Stateless = false;
+
   //! Construct the default class.
   StringEncodingDictionary() = default;
 
@@ -263,6 +271,10 @@ class StringEncodingDictionary<int>
   //! The type of the token that the dictionary stores.
   using TokenType = int;
 
+  //! The dictionary stores the tokens it has seen; labels depend on the
+  //! insertion order.
+  static const bool Stateless = false;
+
   //! Construct the default class.
   StringEncodingDictionary() :
     size(0)
@@ -17,6 +17,10 @@
 #include "string_encoding.hpp"
 #include <type_traits>
 
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace data {
 
@@ -105,53 +109,156 @@ EncodeHelper(const std::vector<std::string>& input,
              const TokenizerType& tokenizer,
              PolicyType& policy)
 {
+  using TokenType = typename std::remove_reference<
+      typename DictionaryType::TokenType>::type;
+
   size_t numColumns = 0;
 
   policy.Reset();
 
-  // The first pass adds the extracted tokens to the dictionary.
-  for (size_t i = 0; i < input.size(); ++i)
+  // The documents are split into contiguous chunks, one per thread.  Each
+  // chunk is tokenized exactly once: the tokens are interned into a
+  // per-chunk dictionary and each document is recorded as a stream of local
+  // labels, so neither pass below has to tokenize again.
+  size_t numThreads = 1;
+  #ifdef MLPACK_USE_OPENMP
+  numThreads = (size_t) omp_get_max_threads();
+  #endif
+  const size_t numChunks = std::max((size_t) 1,
+      std::min(numThreads, input.size()));
+  std::vector<size_t> chunkStarts(numChunks + 1);
+  for (size_t c = 0; c <= numChunks; ++c)
+    chunkStarts[c] = c * input.size() / numChunks;
+
+  // The tokens of each chunk in first-occurrence order, and the documents of
+  // each chunk as streams of local (per-chunk) labels.
+  std::vector<std::vector<TokenType>> chunkTokens(numChunks);
+  std::vector<std::vector<std::vector<size_t>>> chunkStreams(numChunks);
+
+  #pragma omp parallel for schedule(static)
+  for (size_t c = 0; c < numChunks; ++c)
   {
-    MLPACK_STRING_VIEW strView(input[i]);
-    auto token = tokenizer(strView);
-
-    static_assert(
-        std::is_same<typename std::remove_reference<decltype(token)>::type,
-                     typename std::remove_reference<typename DictionaryType::
-                        TokenType>::type>::value,
-        "The dictionary token type doesn't match the return value type "
-        "of the tokenizer.");
-
-    size_t numTokens = 0;
+    DictionaryType localDictionary;
+    chunkStreams[c].resize(chunkStarts[c + 1] - chunkStarts[c]);
 
-    while (!tokenizer.IsTokenEmpty(token))
+    for (size_t i = chunkStarts[c]; i < chunkStarts[c + 1]; ++i)
     {
-      if (!dictionary.HasToken(token))
-        dictionary.AddToken(std::move(token));
-
-      policy.PreprocessToken(i, numTokens, dictionary.Value(token));
+      MLPACK_STRING_VIEW strView(input[i]);
+      auto token = tokenizer(strView);
+
+      static_assert(
+          std::is_same<typename std::remove_reference<decltype(token)>::type,
+                       TokenType>::value,
+          "The dictionary token type doesn't match the return value type "
+          "of the tokenizer.");
+
+      std::vector<size_t>& stream = chunkStreams[c][i - chunkStarts[c]];
+
+      while (!tokenizer.IsTokenEmpty(token))
+      {
+        if (DictionaryType::Stateless)
+        {
+          // A stateless dictionary assigns labels without storing anything,
+          // so the labels are final already and no interning is needed.
+          stream.push_back(dictionary.Value(token) - 1);
+          token = tokenizer(strView);
+          continue;
+        }
+
+        // The local labels are assigned sequentially starting from one.
+        size_t localValue;
+        if (localDictionary.HasToken(token))
+        {
+          localValue = localDictionary.Value(token);
+        }
+        else
+        {
+          chunkTokens[c].push_back(token);
+          localValue = localDictionary.AddToken(std::move(token));
+        }
+
+        stream.push_back(localValue - 1);
+        token = tokenizer(strView);
+      }
+    }
+  }
 
-      token = tokenizer(strView);
-      numTokens++;
+  // Merge the per-chunk dictionaries in chunk order, so that the labels are
+  // exactly those the sequential pass would have assigned, and replay the
+  // recorded streams through the policy's first-pass statistics.
+  std::vector<std::vector<size_t>> translate(numChunks);
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    translate[c].reserve(chunkTokens[c].size());
+    for (TokenType& token : chunkTokens[c])
+    {
+      if (dictionary.HasToken(token))
+        translate[c].push_back(dictionary.Value(token));
+      else
+        translate[c].push_back(dictionary.AddToken(std::move(token)));
     }
 
-    numColumns = std::max(numColumns, numTokens);
+    for (size_t i = chunkStarts[c]; i < chunkStarts[c + 1]; ++i)
+    {
+      const std::vector<size_t>& stream = chunkStreams[c][i - chunkStarts[c]];
+      for (size_t j = 0; j < stream.size(); ++j)
+      {
+        policy.PreprocessToken(i, j, DictionaryType::Stateless ?
+            stream[j] + 1 : translate[c][stream[j]]);
+      }
+
+      numColumns = std::max(numColumns, stream.size());
+    }
   }
 
   policy.InitMatrix(output, input.size(), numColumns, dictionary.Size());
 
-  // The second pass writes the encoded values to the output.
-  for (size_t i = 0; i < input.size(); ++i)
+  // The second pass writes the encoded values to the output.  Every policy
+  // writes only to elements of its own document, so the documents of a dense
+  // output can be written concurrently; for a sparse output each chunk is
+  // encoded into its own matrix and the chunks are summed, since sparse
+  // element insertion is neither thread-safe nor cheap.
+  if (arma::is_SpMat<MatType>::value)
   {
-    MLPACK_STRING_VIEW strView(input[i]);
-    auto token = tokenizer(strView);
-    size_t numTokens = 0;
-
-    while (!tokenizer.IsTokenEmpty(token))
+    #pragma omp parallel for schedule(static)
+    for (size_t c = 0; c < numChunks; ++c)
     {
-      policy.Encode(output, dictionary.Value(token), i, numTokens);
-      token = tokenizer(strView);
-      numTokens++;
+      MatType chunkOutput;
+      policy.InitMatrix(chunkOutput, input.size(), numColumns,
+          dictionary.Size());
+
+      for (size_t i = chunkStarts[c]; i < chunkStarts[c + 1]; ++i)
+      {
+        const std::vector<size_t>& stream =
+            chunkStreams[c][i - chunkStarts[c]];
+        for (size_t j = 0; j < stream.size(); ++j)
+        {
+          policy.Encode(chunkOutput, DictionaryType::Stateless ?
+              stream[j] + 1 : translate[c][stream[j]], i, j);
+        }
+      }
+
+      // The chunks write disjoint elements, so the sum does not depend on
+      // the order in which they are merged.
+      #pragma omp critical (StringEncodingMerge)
+      output += chunkOutput;
+    }
+  }
+  else
+  {
+    #pragma omp parallel for schedule(static)
+    for (size_t c = 0; c < numChunks; ++c)
+    {
+      for (size_t i = chunkStarts[c]; i < chunkStarts[c + 1]; ++i)
+      {
+        const std::vector<size_t>& stream =
+            chunkStreams[c][i - chunkStarts[c]];
+        for (size_t j = 0; j < stream.size(); ++j)
+        {
+          policy.Encode(output, DictionaryType::Stateless ?
+              stream[j] + 1 : translate[c][stream[j]], i, j);
+        }
+      }
     }
   }
 }
@@ -17,6 +17,7 @@
 #include "gamma_distribution.hpp"
 #include "gaussian_distribution.hpp"
 #include "laplace_distribution.hpp"
+#include "low_rank_gaussian_distribution.hpp"
 #include "regression_distribution.hpp"
 
 #endif
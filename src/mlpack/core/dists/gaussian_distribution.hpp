@@ -34,6 +34,15 @@ class GaussianDistribution
   //! Cached logdet(cov).
   double logDetCov;
 
+  //! Streaming sufficient statistics: total weight, weighted sum of the
+  //! observations, and weighted sum of their outer products.  These are only
+  //! nonempty between ResetTraining() and FinishTraining().
+  double weightSum = 0.0;
+  //! Weighted sum of accumulated observations.
+  arma::vec weightedSum;
+  //! Weighted sum of outer products of accumulated observations.
+  arma::mat weightedOuterSum;
+
   //! log(2pi)
   static const constexpr double log2pi = 1.83787706640934533908193770912475883;
 
@@ -139,6 +148,64 @@ class GaussianDistribution
   void Train(const arma::mat& observations,
              const arma::vec& probabilities);
 
+  /**
+   * Start (or restart) incremental estimation of the distribution, clearing
+   * any accumulated sufficient statistics.  Between ResetTraining() and
+   * FinishTraining(), batches of observations can be added with
+   * AddObservations() and retracted with RemoveObservations(); nothing is
+   * factorized until FinishTraining(), so the cost of accumulation is just
+   * the cost of updating the sufficient statistics.
+   *
+   * @param dimensionality Dimensionality of the observations to accumulate.
+   */
+  void ResetTraining(const size_t dimensionality);
+
+  /**
+   * Accumulate the given observations into the sufficient statistics, each
+   * with weight 1.  The mean, covariance, and cached factorizations are not
+   * touched until FinishTraining() is called.
+   *
+   * @param observations List of observations to accumulate.
+   */
+  void AddObservations(const arma::mat& observations);
+
+  /**
+   * Accumulate the given observations into the sufficient statistics, taking
+   * into account the probability of each observation actually being from
+   * this distribution.
+   *
+   * @param observations List of observations to accumulate.
+   * @param probabilities Weight of each observation.
+   */
+  void AddObservations(const arma::mat& observations,
+                       const arma::vec& probabilities);
+
+  /**
+   * Retract previously accumulated observations from the sufficient
+   * statistics (downdating).  The observations and weights must match what
+   * was passed to AddObservations(), or the statistics will no longer
+   * correspond to any dataset.
+   *
+   * @param observations List of observations to retract.
+   * @param probabilities Weight each observation was accumulated with.
+   */
+  void RemoveObservations(const arma::mat& observations,
+                          const arma::vec& probabilities);
+
+  /**
+   * Set the mean and covariance from the accumulated sufficient statistics
+   * and refresh the cached Cholesky factorization (the only point at which
+   * it is recomputed).  The covariance is the weighted maximum-likelihood
+   * estimate, with the same normalization as Train(observations,
+   * probabilities).  The accumulated statistics are left in place, so more
+   * observations can be added or removed and FinishTraining() called again.
+   *
+   * The statistics are accumulated as raw moments, so the batch Train()
+   * overloads are preferred when all the data is available at once and the
+   * observations are far from the origin relative to their spread.
+   */
+  void FinishTraining();
+
   /**
    * Return the mean.
    */
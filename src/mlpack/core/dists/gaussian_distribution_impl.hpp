@@ -92,33 +92,19 @@ inline arma::vec GaussianDistribution::Random() const
  */
 inline void GaussianDistribution::Train(const arma::mat& observations)
 {
-  if (observations.n_cols > 0)
-  {
-    mean.zeros(observations.n_rows);
-    covariance.zeros(observations.n_rows, observations.n_rows);
-  }
-  else // This will end up just being empty.
+  if (observations.n_cols == 0) // This will end up just being empty.
   {
     Log::Fatal << "Observation columns equal to 0." << std::endl;
   }
 
   // Calculate the mean.
-  for (size_t i = 0; i < observations.n_cols; ++i)
-    mean += observations.col(i);
-
-  // Normalize the mean.
-  mean /= observations.n_cols;
-
-  // Now calculate the covariance.
-  for (size_t i = 0; i < observations.n_cols; ++i)
-  {
-    arma::vec obsNoMean = observations.col(i) - mean;
-    covariance += obsNoMean * trans(obsNoMean);
-  }
+  mean = arma::sum(observations, 1) / observations.n_cols;
 
-  // Finish estimating the covariance by normalizing, with the (1 / (n - 1)) so
-  // that it is the unbiased estimator.
-  covariance /= (observations.n_cols - 1);
+  // Now calculate the covariance with a single matrix product, so the
+  // dominant cost is one BLAS rank-n update rather than a loop of rank-1
+  // updates.  The (1 / (n - 1)) makes it the unbiased estimator.
+  const arma::mat diffs = observations.each_col() - mean;
+  covariance = diffs * diffs.t() / (observations.n_cols - 1);
 
   // Ensure that the covariance is positive definite.
   PositiveDefiniteConstraint::ApplyConstraint(covariance);
@@ -134,49 +120,98 @@ inline void GaussianDistribution::Train(const arma::mat& observations)
 inline void GaussianDistribution::Train(const arma::mat& observations,
                                         const arma::vec& probabilities)
 {
-  if (observations.n_cols > 0)
-  {
-    mean.zeros(observations.n_rows);
-    covariance.zeros(observations.n_rows, observations.n_rows);
-  }
-  else // This will end up just being empty.
+  if (observations.n_cols == 0) // This will end up just being empty.
   {
     Log::Fatal << "Observation columns equal to 0." << std::endl;
   }
 
-  double sumProb = 0;
-
-  // First calculate the mean, and save the sum of all the probabilities for
-  // later normalization.
-  for (size_t i = 0; i < observations.n_cols; ++i)
-  {
-    mean += probabilities[i] * observations.col(i);
-    sumProb += probabilities[i];
-  }
+  const double sumProb = arma::accu(probabilities);
 
   if (sumProb == 0)
   {
     // Nothing in this Gaussian!  At least set the covariance so that it's
     // invertible.
+    mean.zeros(observations.n_rows);
+    covariance.zeros(observations.n_rows, observations.n_rows);
     covariance.diag() += 1e-50;
     FactorCovariance();
     return;
   }
 
-  // Normalize.
-  if (sumProb > 0)
-    mean /= sumProb;
+  // Calculate the mean.
+  mean = observations * probabilities / sumProb;
+
+  // Now find the covariance; scaling the centered observations by the square
+  // roots of the weights turns the weighted sum of rank-1 updates into a
+  // single BLAS matrix product.
+  arma::mat scaledDiffs = observations.each_col() - mean;
+  scaledDiffs.each_row() %= arma::sqrt(probabilities.t());
+
+  // This is probably biased, but I don't know how to unbias it.
+  covariance = scaledDiffs * scaledDiffs.t() / sumProb;
+
+  // Ensure that the covariance is positive definite.
+  PositiveDefiniteConstraint::ApplyConstraint(covariance);
 
-  // Now find the covariance.
-  for (size_t i = 0; i < observations.n_cols; ++i)
+  FactorCovariance();
+}
+
+inline void GaussianDistribution::ResetTraining(const size_t dimensionality)
+{
+  weightSum = 0.0;
+  weightedSum.zeros(dimensionality);
+  weightedOuterSum.zeros(dimensionality, dimensionality);
+}
+
+inline void GaussianDistribution::AddObservations(
+    const arma::mat& observations)
+{
+  weightSum += observations.n_cols;
+  weightedSum += arma::sum(observations, 1);
+  weightedOuterSum += observations * observations.t();
+}
+
+inline void GaussianDistribution::AddObservations(
+    const arma::mat& observations,
+    const arma::vec& probabilities)
+{
+  weightSum += arma::accu(probabilities);
+  weightedSum += observations * probabilities;
+
+  // Scaling the observations by the square roots of the weights turns the
+  // weighted sum of rank-1 updates into a single BLAS matrix product.
+  const arma::mat scaled =
+      observations.each_row() % arma::sqrt(probabilities.t());
+  weightedOuterSum += scaled * scaled.t();
+}
+
+inline void GaussianDistribution::RemoveObservations(
+    const arma::mat& observations,
+    const arma::vec& probabilities)
+{
+  weightSum -= arma::accu(probabilities);
+  weightedSum -= observations * probabilities;
+
+  const arma::mat scaled =
+      observations.each_row() % arma::sqrt(probabilities.t());
+  weightedOuterSum -= scaled * scaled.t();
+}
+
+inline void GaussianDistribution::FinishTraining()
+{
+  if (weightSum <= 0)
   {
-    arma::vec obsNoMean = observations.col(i) - mean;
-    covariance += probabilities[i] * (obsNoMean * trans(obsNoMean));
+    // Nothing in this Gaussian!  At least set the covariance so that it's
+    // invertible.
+    mean.zeros(weightedSum.n_elem);
+    covariance.zeros(weightedSum.n_elem, weightedSum.n_elem);
+    covariance.diag() += 1e-50;
+    FactorCovariance();
+    return;
   }
 
-  // This is probably biased, but I don't know how to unbias it.
-  if (sumProb > 0)
-    covariance /= sumProb;
+  mean = weightedSum / weightSum;
+  covariance = weightedOuterSum / weightSum - mean * mean.t();
 
   // Ensure that the covariance is positive definite.
   PositiveDefiniteConstraint::ApplyConstraint(covariance);
@@ -0,0 +1,204 @@
+/**
+ * @file core/dists/low_rank_gaussian_distribution.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the Gaussian distribution with a factored covariance of
+ * the form diag(noise) + factors * factors^T (diagonal plus rank r), for
+ * high-dimensional density modeling where a full d x d covariance is
+ * intractable.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DISTRIBUTIONS_LOW_RANK_GAUSSIAN_DISTRIBUTION_HPP
+#define MLPACK_CORE_DISTRIBUTIONS_LOW_RANK_GAUSSIAN_DISTRIBUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * A single multivariate Gaussian distribution whose covariance is stored in
+ * the factored form
+ *
+ * @f[ \Sigma = \mathrm{diag}(\psi) + F F^T @f]
+ *
+ * where @f$ \psi @f$ is a d-dimensional noise vector and F is a d x r factor
+ * matrix with r much smaller than d.  Storage is O(dr) instead of O(d^2),
+ * and LogProbability() and Random() cost O(dr) per observation instead of
+ * O(d^2), using the Woodbury identity and the matrix determinant lemma; only
+ * an r x r matrix is ever factorized.  This makes Gaussian density modeling
+ * tractable at dimensionalities where the full-covariance
+ * GaussianDistribution is not.
+ *
+ * The class implements the same interface as GaussianDistribution and
+ * DiagonalGaussianDistribution, so it can be used as the component
+ * distribution of a GMM (via EMFit's Distribution template parameter) or as
+ * an HMM emission distribution.
+ *
+ * Train() fits the factored covariance directly: the top r principal
+ * components of the (weighted) sample covariance become the factors, with
+ * the average residual eigenvalue absorbed into them in the style of
+ * probabilistic PCA, and the noise vector is set so that the per-dimension
+ * variances of the sample covariance are matched exactly.  The sample
+ * covariance itself is never formed; only an economy SVD of the centered
+ * data is computed.
+ */
+class LowRankGaussianDistribution
+{
+ private:
+  //! Mean of the distribution.
+  arma::vec mean;
+  //! Diagonal noise term of the covariance.
+  arma::vec noise;
+  //! Low-rank factor term of the covariance (d x r).
+  arma::mat factors;
+
+  //! Cached elementwise inverse of the noise vector.
+  arma::vec invNoise;
+  //! Cached r x d projection L^-1 F^T diag(invNoise), where L is the lower
+  //! Cholesky factor of I + F^T diag(invNoise) F; the Woodbury quadratic
+  //! form is || diag(invNoise)^(1/2) x ||^2 - || proj x ||^2.
+  arma::mat proj;
+  //! Cached logdet(Sigma), via the matrix determinant lemma.
+  double logDetCov;
+
+  //! log(2pi)
+  static const constexpr double log2pi = 1.83787706640934533908193770912475883;
+
+  //! Recompute the cached Woodbury quantities from noise and factors.
+  void FactorCovariance();
+
+ public:
+  //! Default constructor, which creates a Gaussian with zero dimension.
+  LowRankGaussianDistribution() : logDetCov(0.0) { /* Nothing to do. */ }
+
+  /**
+   * Create a Gaussian distribution with zero mean, unit noise variance, and
+   * zero factors of the given rank.
+   *
+   * @param dimension Number of dimensions.
+   * @param rank Rank of the factor term.
+   */
+  LowRankGaussianDistribution(const size_t dimension, const size_t rank);
+
+  /**
+   * Create a Gaussian distribution with the given mean and factored
+   * covariance diag(noise) + factors * factors^T.
+   *
+   * @param mean Mean of distribution.
+   * @param noise Diagonal noise term of the covariance (all elements must be
+   *     positive).
+   * @param factors Low-rank factor term of the covariance (d x r).
+   */
+  LowRankGaussianDistribution(const arma::vec& mean,
+                              const arma::vec& noise,
+                              const arma::mat& factors);
+
+  //! Return the dimensionality of this distribution.
+  size_t Dimensionality() const { return mean.n_elem; }
+
+  //! Return the rank of the factor term.
+  size_t Rank() const { return factors.n_cols; }
+
+  //! Return the probability of the given observation.
+  double Probability(const arma::vec& observation) const
+  {
+    return exp(LogProbability(observation));
+  }
+
+  //! Return the log probability of the given observation.
+  double LogProbability(const arma::vec& observation) const;
+
+  /**
+   * Calculate the multivariate Gaussian probability density function for each
+   * data point (column) in the given matrix.
+   *
+   * @param x Matrix of observations.
+   * @param probabilities Output probabilities for each input observation.
+   */
+  void Probability(const arma::mat& x, arma::vec& probabilities) const
+  {
+    arma::vec logProbabilities;
+    LogProbability(x, logProbabilities);
+    probabilities = arma::exp(logProbabilities);
+  }
+
+  /**
+   * Calculate the multivariate Gaussian log probability density function for
+   * each data point (column) in the given matrix.
+   *
+   * @param observations Matrix of observations.
+   * @param logProbabilities Output log probabilities for each observation.
+   */
+  void LogProbability(const arma::mat& observations,
+                      arma::vec& logProbabilities) const;
+
+  /**
+   * Return a randomly generated observation according to the probability
+   * distribution defined by this object.  Sampling costs O(dr): a draw from
+   * the noise term plus a draw through the factors.
+   *
+   * @return Random observation from this Gaussian distribution.
+   */
+  arma::vec Random() const;
+
+  /**
+   * Estimate the Gaussian distribution directly from the given observations,
+   * keeping the current rank (or min(d, n - 1), whichever is smaller).
+   *
+   * @param observations Matrix of observations.
+   */
+  void Train(const arma::mat& observations);
+
+  /**
+   * Estimate the Gaussian distribution from the given observations, taking
+   * into account the probability of each observation actually being from
+   * this distribution.
+   *
+   * @param observations Matrix of observations.
+   * @param probabilities List of probability of each observation being from
+   *     this distribution.
+   */
+  void Train(const arma::mat& observations,
+             const arma::vec& probabilities);
+
+  //! Return the mean.
+  const arma::vec& Mean() const { return mean; }
+  //! Return a modifiable copy of the mean.
+  arma::vec& Mean() { return mean; }
+
+  //! Return the diagonal noise term of the covariance.
+  const arma::vec& Noise() const { return noise; }
+  //! Return the low-rank factor term of the covariance.
+  const arma::mat& Factors() const { return factors; }
+
+  /**
+   * Set the factored covariance.
+   *
+   * @param noise Diagonal noise term (all elements must be positive).
+   * @param factors Low-rank factor term (d x r).
+   */
+  void Covariance(const arma::vec& noise, const arma::mat& factors);
+
+  //! Serialize the distribution.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(mean));
+    ar(CEREAL_NVP(noise));
+    ar(CEREAL_NVP(factors));
+    ar(CEREAL_NVP(invNoise));
+    ar(CEREAL_NVP(proj));
+    ar(CEREAL_NVP(logDetCov));
+  }
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "low_rank_gaussian_distribution_impl.hpp"
+
+#endif
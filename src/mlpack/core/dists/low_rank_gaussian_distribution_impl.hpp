@@ -0,0 +1,248 @@
+/**
+ * @file core/dists/low_rank_gaussian_distribution_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the Gaussian distribution with diagonal-plus-low-rank
+ * covariance.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DISTRIBUTIONS_LOW_RANK_GAUSSIAN_DISTRIBUTION_IMPL_HPP
+#define MLPACK_CORE_DISTRIBUTIONS_LOW_RANK_GAUSSIAN_DISTRIBUTION_IMPL_HPP
+
+#include "low_rank_gaussian_distribution.hpp"
+
+namespace mlpack {
+
+inline LowRankGaussianDistribution::LowRankGaussianDistribution(
+    const size_t dimension,
+    const size_t rank) :
+    mean(arma::zeros<arma::vec>(dimension)),
+    noise(arma::ones<arma::vec>(dimension)),
+    factors(arma::zeros<arma::mat>(dimension, rank))
+{
+  FactorCovariance();
+}
+
+inline LowRankGaussianDistribution::LowRankGaussianDistribution(
+    const arma::vec& mean,
+    const arma::vec& noise,
+    const arma::mat& factors) :
+    mean(mean)
+{
+  Covariance(noise, factors);
+}
+
+inline void LowRankGaussianDistribution::Covariance(const arma::vec& noise,
+                                                    const arma::mat& factors)
+{
+  this->noise = noise;
+  this->factors = factors;
+  FactorCovariance();
+}
+
+inline void LowRankGaussianDistribution::FactorCovariance()
+{
+  invNoise = 1.0 / noise;
+  logDetCov = arma::accu(log(noise));
+
+  if (factors.n_cols == 0)
+  {
+    proj.set_size(0, mean.n_elem);
+    return;
+  }
+
+  // Woodbury identity: with Sigma = D + F F^T and M = I + F^T D^-1 F,
+  //   Sigma^-1 = D^-1 - D^-1 F M^-1 F^T D^-1,
+  // so with the lower Cholesky factor L of M, the quadratic form is
+  //   x^T Sigma^-1 x = || D^-1/2 x ||^2 - || L^-1 F^T D^-1 x ||^2,
+  // and the matrix determinant lemma gives
+  //   logdet(Sigma) = logdet(D) + logdet(M).
+  // Only the r x r matrix M is ever factorized.
+  const arma::mat scaledFactors = factors.each_col() % invNoise;
+  const arma::mat m = arma::eye<arma::mat>(factors.n_cols, factors.n_cols) +
+      factors.t() * scaledFactors;
+  const arma::mat l = arma::chol(m, "lower");
+
+  proj = arma::solve(arma::trimatl(l), scaledFactors.t());
+  logDetCov += 2.0 * arma::accu(log(l.diag()));
+}
+
+inline double LowRankGaussianDistribution::LogProbability(
+    const arma::vec& observation) const
+{
+  const size_t k = observation.n_elem;
+  const arma::vec diff = observation - mean;
+
+  double quadratic = arma::accu(diff % diff % invNoise);
+  if (proj.n_rows > 0)
+    quadratic -= arma::accu(arma::square(proj * diff));
+
+  return -0.5 * k * log2pi - 0.5 * logDetCov - 0.5 * quadratic;
+}
+
+inline void LowRankGaussianDistribution::LogProbability(
+    const arma::mat& observations,
+    arma::vec& logProbabilities) const
+{
+  const size_t k = observations.n_rows;
+
+  // Column i of 'diffs' is the difference between observations.col(i) and
+  // the mean.
+  const arma::mat diffs = observations.each_col() - mean;
+
+  // The diagonal part of the Woodbury quadratic form, for all observations.
+  arma::vec quadratics = arma::trans(diffs % diffs) * invNoise;
+
+  // The rank-r correction; proj * diffs is an r x n matrix, so this is the
+  // only dense matrix product, at cost O(drn).
+  if (proj.n_rows > 0)
+    quadratics -= arma::trans(arma::sum(arma::square(proj * diffs), 0));
+
+  logProbabilities = -0.5 * k * log2pi - 0.5 * logDetCov - 0.5 * quadratics;
+}
+
+inline arma::vec LowRankGaussianDistribution::Random() const
+{
+  // A draw from the noise term plus a draw through the factors has exactly
+  // covariance diag(noise) + factors * factors^T.
+  arma::vec sample = mean +
+      arma::sqrt(noise) % arma::randn<arma::vec>(mean.n_elem);
+  if (factors.n_cols > 0)
+    sample += factors * arma::randn<arma::vec>(factors.n_cols);
+  return sample;
+}
+
+inline void LowRankGaussianDistribution::Train(const arma::mat& observations)
+{
+  if (observations.n_cols <= 1)
+  {
+    // There is nothing sensible to fit.
+    mean.zeros(0);
+    noise.zeros(0);
+    factors.set_size(0, factors.n_cols);
+    FactorCovariance();
+    return;
+  }
+
+  const size_t n = observations.n_cols;
+
+  // Calculate and normalize the mean.
+  mean = arma::sum(observations, 1) / n;
+
+  const arma::mat diffs = observations.each_col() - mean;
+
+  // Per-dimension variances of the (unbiased) sample covariance; these are
+  // matched exactly by the fitted factored covariance below.
+  const arma::vec sampleVariances =
+      arma::sum(diffs % diffs, 1) / (n - 1.0);
+
+  // The top eigenpairs of the sample covariance are obtained from an economy
+  // SVD of the centered data; the d x d covariance is never formed.
+  arma::mat u;
+  arma::vec s;
+  arma::mat v;
+  arma::svd_econ(u, s, v, diffs / std::sqrt((double) (n - 1)), "left");
+  const arma::vec eigenvalues = arma::square(s);
+
+  const size_t rank = std::min((size_t) factors.n_cols,
+      (size_t) eigenvalues.n_elem);
+
+  // In the style of probabilistic PCA, the average residual eigenvalue is
+  // subtracted from the leading eigenvalues before forming the factors, so
+  // the noise term absorbs the residual variance.
+  const double totalVariance = arma::accu(eigenvalues);
+  const double residualLevel = (mean.n_elem > rank) ?
+      (totalVariance - arma::accu(eigenvalues.head(rank))) /
+          (mean.n_elem - rank) : 0.0;
+
+  factors = u.head_cols(rank);
+  for (size_t i = 0; i < rank; ++i)
+  {
+    factors.col(i) *=
+        std::sqrt(std::max(eigenvalues[i] - residualLevel, 0.0));
+  }
+
+  // Set the noise so that the per-dimension variances match the sample
+  // covariance exactly (floored to keep the covariance invertible).
+  noise = arma::clamp(sampleVariances - arma::sum(factors % factors, 1),
+      1e-10, DBL_MAX);
+
+  FactorCovariance();
+}
+
+inline void LowRankGaussianDistribution::Train(const arma::mat& observations,
+                                               const arma::vec& probabilities)
+{
+  if (observations.n_cols == 0)
+  {
+    mean.zeros(0);
+    noise.zeros(0);
+    factors.set_size(0, factors.n_cols);
+    FactorCovariance();
+    return;
+  }
+
+  const double v1 = arma::accu(probabilities);
+
+  // If the sum of the weights is 0, there is nothing in this Gaussian.
+  // At least set the covariance so that it's invertible.
+  if (v1 == 0)
+  {
+    noise.ones(observations.n_rows);
+    noise *= 1e-50;
+    factors.zeros(observations.n_rows, factors.n_cols);
+    FactorCovariance();
+    return;
+  }
+
+  // Normalize the probabilities.
+  const arma::vec normalizedProbs = probabilities / v1;
+
+  // Calculate the mean.
+  mean = observations * normalizedProbs;
+
+  // Weighted centered data, scaled so that its outer product is the weighted
+  // covariance estimate; the (1 / (1 - v2)) factor makes the estimator
+  // unbiased, as in the other Gaussian distribution classes.
+  const double v2 = arma::accu(normalizedProbs % normalizedProbs);
+  const double normalization = (v2 != 1) ? (1.0 - v2) : 1.0;
+
+  arma::mat scaledDiffs = observations.each_col() - mean;
+  scaledDiffs.each_row() %= arma::sqrt(normalizedProbs.t() / normalization);
+
+  const arma::vec sampleVariances = arma::sum(scaledDiffs % scaledDiffs, 1);
+
+  arma::mat u;
+  arma::vec s;
+  arma::mat v;
+  arma::svd_econ(u, s, v, scaledDiffs, "left");
+  const arma::vec eigenvalues = arma::square(s);
+
+  const size_t rank = std::min((size_t) factors.n_cols,
+      (size_t) eigenvalues.n_elem);
+
+  const double totalVariance = arma::accu(eigenvalues);
+  const double residualLevel = (mean.n_elem > rank) ?
+      (totalVariance - arma::accu(eigenvalues.head(rank))) /
+          (mean.n_elem - rank) : 0.0;
+
+  factors = u.head_cols(rank);
+  for (size_t i = 0; i < rank; ++i)
+  {
+    factors.col(i) *=
+        std::sqrt(std::max(eigenvalues[i] - residualLevel, 0.0));
+  }
+
+  noise = arma::clamp(sampleVariances - arma::sum(factors % factors, 1),
+      1e-10, DBL_MAX);
+
+  FactorCovariance();
+}
+
+} // namespace mlpack
+
+#endif
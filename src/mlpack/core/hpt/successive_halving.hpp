@@ -0,0 +1,305 @@
+/**
+ * @file core/hpt/successive_halving.hpp
+ * @author Kirill Mishchenko
+ *
+ * Hyper-parameter tuning with the successive-halving algorithm.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_SUCCESSIVE_HALVING_HPP
+#define MLPACK_CORE_HPT_SUCCESSIVE_HALVING_HPP
+
+#include <mlpack/core/cv/meta_info_extractor.hpp>
+#include <mlpack/core/cv/cv_base.hpp>
+#include <mlpack/core/hpt/deduce_hp_types.hpp>
+
+namespace mlpack {
+
+/**
+ * The class SuccessiveHalvingTuner tunes hyper-parameters of the given
+ * MLAlgorithm with the successive-halving algorithm instead of evaluating
+ * every configuration on the full dataset like HyperParameterTuner with
+ * GridSearch does.
+ *
+ * All configurations (the Cartesian product of the passed collections) are
+ * first trained on a small fraction of the training data and assessed with
+ * the given Metric on a holdout validation set; then only the best 1 / eta
+ * of them are promoted to an eta times larger budget, and so on, until one
+ * configuration remains or the full training set is reached.  Most
+ * configurations are discarded after seeing only a small fraction of the
+ * data, which makes large sweeps many times cheaper than a full grid
+ * search, at the (usually small) risk of discarding a configuration that
+ * would only excel on more data.  The configurations of a rung are
+ * evaluated concurrently if mlpack is built with OpenMP support, with the
+ * same deterministic per-configuration seeding that KFoldCV uses for folds.
+ *
+ * The data are shuffled at construction time (so that a budget, which is a
+ * prefix of the training set, is a random subsample), and then split into a
+ * training and a validation part, in the same way as SimpleCV.
+ *
+ * @code
+ * // 100-point 5-dimensional random dataset.
+ * arma::mat data = arma::randu<arma::mat>(5, 100);
+ * // Noisy responses retrieved by a random linear transformation of data.
+ * arma::rowvec responses = arma::randu<arma::rowvec>(5) * data +
+ *     0.1 * arma::randn<arma::rowvec>(100);
+ *
+ * // Using 80% of data for training and remaining 20% for assessing MSE.
+ * SuccessiveHalvingTuner<LinearRegression, MSE> tuner(0.2, data, responses);
+ *
+ * arma::vec lambdas{0.0, 0.001, 0.01, 0.1, 1.0};
+ * double bestLambda;
+ * std::tie(bestLambda) = tuner.Optimize(lambdas);
+ * @endcode
+ *
+ * Unlike HyperParameterTuner, every argument of Optimize() should be a
+ * collection of values to choose from; fixing arguments with Fixed() is not
+ * supported (pass a single-element collection instead).
+ *
+ * @tparam MLAlgorithm A machine learning algorithm.
+ * @tparam Metric A metric to assess the quality of a trained model.
+ * @tparam MatType The type of data.
+ * @tparam PredictionsType The type of predictions (should be passed when the
+ *     predictions type is a template parameter in Train methods of the given
+ *     MLAlgorithm; arma::Row<size_t> will be used otherwise).
+ * @tparam WeightsType The type of weights (should be passed when weighted
+ *     learning is supported, and the weights type is a template parameter in
+ *     Train methods of the given MLAlgorithm; arma::vec will be used
+ *     otherwise).
+ */
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType = arma::mat,
+         typename PredictionsType =
+             typename MetaInfoExtractor<MLAlgorithm, MatType>::PredictionsType,
+         typename WeightsType =
+             typename MetaInfoExtractor<MLAlgorithm, MatType,
+                 PredictionsType>::WeightsType>
+class SuccessiveHalvingTuner
+{
+ public:
+  /**
+   * This constructor can be used for regression algorithms and for binary
+   * classification algorithms.
+   *
+   * @param validationSize A proportion (between 0 and 1) of data used as a
+   *     validation set.
+   * @param xs Data points to tune on.
+   * @param ys Predictions (labels for classification algorithms and responses
+   *     for regression algorithms) for each data point.
+   * @param eta The elimination rate: each rung promotes 1 / eta of its
+   *     configurations to an eta times larger budget (should be greater
+   *     than 1).
+   * @param minBudget The fraction (between 0 and 1) of the training set that
+   *     the first rung trains on.
+   * @param shuffle Whether or not to shuffle the data during construction.
+   */
+  SuccessiveHalvingTuner(const double validationSize,
+                         const MatType& xs,
+                         const PredictionsType& ys,
+                         const double eta = 3.0,
+                         const double minBudget = 0.1,
+                         const bool shuffle = true);
+
+  /**
+   * This constructor can be used for multiclass classification algorithms.
+   *
+   * @param validationSize A proportion (between 0 and 1) of data used as a
+   *     validation set.
+   * @param xs Data points to tune on.
+   * @param ys Labels for each data point.
+   * @param numClasses Number of classes in the dataset.
+   * @param eta The elimination rate: each rung promotes 1 / eta of its
+   *     configurations to an eta times larger budget (should be greater
+   *     than 1).
+   * @param minBudget The fraction (between 0 and 1) of the training set that
+   *     the first rung trains on.
+   * @param shuffle Whether or not to shuffle the data during construction.
+   */
+  SuccessiveHalvingTuner(const double validationSize,
+                         const MatType& xs,
+                         const PredictionsType& ys,
+                         const size_t numClasses,
+                         const double eta = 3.0,
+                         const double minBudget = 0.1,
+                         const bool shuffle = true);
+
+  //! Get the elimination rate.
+  double Eta() const { return eta; }
+  //! Modify the elimination rate.
+  double& Eta() { return eta; }
+
+  //! Get the training budget fraction of the first rung.
+  double MinBudget() const { return minBudget; }
+  //! Modify the training budget fraction of the first rung.
+  double& MinBudget() { return minBudget; }
+
+  /**
+   * Find the best hyper-parameters with successive halving.  For each
+   * hyper-parameter a set of values to choose from should be passed as an
+   * argument; the set of values should be an STL-compatible container (it
+   * should provide begin() and end() methods returning iterators).
+   *
+   * All arguments should be passed in the same order as if the corresponding
+   * hyper-parameters would be passed into the Evaluate method of SimpleCV
+   * (in the order as they appear in the constructor(s) of the given
+   * MLAlgorithm).
+   *
+   * The method returns a tuple of the best values for the hyper-parameters.
+   *
+   * @param collections Sets of values for the hyper-parameters.
+   */
+  template<typename... Collections>
+  TupleOfHyperParameters<Collections...> Optimize(
+      const Collections&... collections);
+
+  //! Get the performance measurement of the best model from the last run.
+  double BestObjective() const { return bestObjective; }
+
+  //! Get the best model from the last run.
+  const MLAlgorithm& BestModel() const { return bestModel; }
+
+  //! Modify the best model from the last run.
+  MLAlgorithm& BestModel() { return bestModel; }
+
+ private:
+  //! A short alias for CVBase.
+  using Base = CVBase<MLAlgorithm, MatType, PredictionsType, WeightsType>;
+
+  //! An auxiliary object for training models.
+  Base base;
+
+  //! The shuffled copy of the whole dataset.
+  MatType xs;
+  //! The shuffled copy of all predictions.
+  PredictionsType ys;
+
+  //! An alias for the training subset of xs.
+  MatType trainingXs;
+  //! An alias for the training subset of ys.
+  PredictionsType trainingYs;
+  //! An alias for the validation subset of xs.
+  MatType validationXs;
+  //! An alias for the validation subset of ys.
+  PredictionsType validationYs;
+
+  //! The elimination rate.
+  double eta;
+  //! The training budget fraction of the first rung.
+  double minBudget;
+
+  //! The best objective from the last run.
+  double bestObjective;
+  //! The best model from the last run.
+  MLAlgorithm bestModel;
+
+  /**
+   * Initialize the internal copy of the dataset, shuffle it if requested,
+   * and set up the training/validation aliases.
+   */
+  void InitData(const double validationSize,
+                const MatType& xs,
+                const PredictionsType& ys,
+                const bool shuffle);
+
+  /**
+   * Assert that eta and minBudget have valid values.
+   */
+  void AssertParameters() const;
+
+  /**
+   * Get the specified submatrix without copying the data.
+   */
+  template<typename ElementType>
+  static arma::Mat<ElementType> GetSubset(arma::Mat<ElementType>& m,
+                                          const size_t firstCol,
+                                          const size_t lastCol);
+
+  /**
+   * Get the specified subrow without copying the data.
+   */
+  template<typename ElementType>
+  static arma::Row<ElementType> GetSubset(arma::Row<ElementType>& r,
+                                          const size_t firstCol,
+                                          const size_t lastCol);
+
+  /**
+   * Evaluate all given configurations on the given fraction of the training
+   * set, concurrently if OpenMP is available.
+   */
+  template<typename CollectionsTupleType>
+  arma::vec EvaluateRung(const CollectionsTupleType& collections,
+                         const std::vector<std::vector<size_t>>& configs,
+                         const double budget);
+
+  /**
+   * The set of methods to collect the values of a configuration and train
+   * and evaluate a model with them.
+   *
+   * This overload appends the value of the next hyper-parameter.
+   */
+  template<size_t I,
+           typename CollectionsTupleType,
+           typename... Args,
+           typename = std::enable_if_t<
+               (I < std::tuple_size<CollectionsTupleType>::value)>>
+  double EvaluateConfig(const CollectionsTupleType& collections,
+                        const std::vector<size_t>& config,
+                        const size_t numTrainingPoints,
+                        std::unique_ptr<MLAlgorithm>& model,
+                        const Args&... args);
+
+  /**
+   * This overload is called when all values have been collected; it trains
+   * on the first numTrainingPoints points of the training set and evaluates
+   * on the validation set.
+   */
+  template<size_t I,
+           typename CollectionsTupleType,
+           typename... Args,
+           typename = std::enable_if_t<
+               I == std::tuple_size<CollectionsTupleType>::value>,
+           typename = void>
+  double EvaluateConfig(const CollectionsTupleType& collections,
+                        const std::vector<size_t>& config,
+                        const size_t numTrainingPoints,
+                        std::unique_ptr<MLAlgorithm>& model,
+                        const Args&... args);
+
+  /**
+   * The set of methods to gather the values of a configuration into a tuple.
+   */
+  template<typename TupleType,
+           size_t I,
+           typename CollectionsTupleType,
+           typename... Args,
+           typename = std::enable_if_t<
+               (I < std::tuple_size<CollectionsTupleType>::value)>>
+  TupleType ConfigToTuple(const CollectionsTupleType& collections,
+                          const std::vector<size_t>& config,
+                          const Args&... args);
+
+  /**
+   * Create a tuple from the gathered values.
+   */
+  template<typename TupleType,
+           size_t I,
+           typename CollectionsTupleType,
+           typename... Args,
+           typename = std::enable_if_t<
+               I == std::tuple_size<CollectionsTupleType>::value>,
+           typename = void>
+  TupleType ConfigToTuple(const CollectionsTupleType& collections,
+                          const std::vector<size_t>& config,
+                          const Args&... args);
+};
+
+} // namespace mlpack
+
+// Include implementation
+#include "successive_halving_impl.hpp"
+
+#endif
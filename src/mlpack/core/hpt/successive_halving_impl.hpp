@@ -0,0 +1,405 @@
+/**
+ * @file core/hpt/successive_halving_impl.hpp
+ * @author Kirill Mishchenko
+ *
+ * Implementation of hyper-parameter tuning with successive halving.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_SUCCESSIVE_HALVING_IMPL_HPP
+#define MLPACK_CORE_HPT_SUCCESSIVE_HALVING_IMPL_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+SuccessiveHalvingTuner<MLAlgorithm,
+                       Metric,
+                       MatType,
+                       PredictionsType,
+                       WeightsType>::SuccessiveHalvingTuner(
+    const double validationSize,
+    const MatType& xs,
+    const PredictionsType& ys,
+    const double eta,
+    const double minBudget,
+    const bool shuffle) :
+    base(),
+    eta(eta),
+    minBudget(minBudget)
+{
+  AssertParameters();
+  InitData(validationSize, xs, ys, shuffle);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+SuccessiveHalvingTuner<MLAlgorithm,
+                       Metric,
+                       MatType,
+                       PredictionsType,
+                       WeightsType>::SuccessiveHalvingTuner(
+    const double validationSize,
+    const MatType& xs,
+    const PredictionsType& ys,
+    const size_t numClasses,
+    const double eta,
+    const double minBudget,
+    const bool shuffle) :
+    base(numClasses),
+    eta(eta),
+    minBudget(minBudget)
+{
+  AssertParameters();
+  InitData(validationSize, xs, ys, shuffle);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... Collections>
+TupleOfHyperParameters<Collections...> SuccessiveHalvingTuner<
+    MLAlgorithm,
+    Metric,
+    MatType,
+    PredictionsType,
+    WeightsType>::Optimize(const Collections&... collections)
+{
+  const auto collectionsTuple = std::tie(collections...);
+  const std::vector<size_t> sizes{ (size_t) std::distance(
+      collections.begin(), collections.end())... };
+
+  for (size_t i = 0; i < sizes.size(); ++i)
+  {
+    if (sizes[i] == 0)
+    {
+      std::ostringstream oss;
+      oss << "SuccessiveHalvingTuner::Optimize(): the collection passed as "
+          << "the argument " << i + 1 << " is empty" << std::endl;
+      throw std::invalid_argument(oss.str());
+    }
+  }
+
+  // All configurations: the Cartesian product of the passed collections.
+  // Each configuration is represented by one index into each collection.
+  std::vector<std::vector<size_t>> configs;
+  std::vector<size_t> current(sizes.size(), 0);
+  while (true)
+  {
+    configs.push_back(current);
+
+    size_t d = 0;
+    while (d < sizes.size() && ++current[d] == sizes[d])
+    {
+      current[d] = 0;
+      ++d;
+    }
+    if (d == sizes.size())
+      break;
+  }
+
+  double budget = std::min(1.0, minBudget);
+  arma::vec scores;
+  while (true)
+  {
+    scores = EvaluateRung(collectionsTuple, configs, budget);
+    if (configs.size() == 1 || budget >= 1.0)
+      break;
+
+    // Promote the best 1 / eta configurations to an eta times larger budget.
+    const size_t keep = (size_t) std::ceil(configs.size() / eta);
+    const arma::uvec order = arma::sort_index(scores,
+        Metric::NeedsMinimization ? "ascend" : "descend");
+
+    std::vector<std::vector<size_t>> survivors(keep);
+    for (size_t j = 0; j < keep; ++j)
+      survivors[j] = std::move(configs[order[j]]);
+    configs = std::move(survivors);
+
+    budget = std::min(1.0, budget * eta);
+  }
+
+  const size_t bestIndex = Metric::NeedsMinimization ?
+      scores.index_min() : scores.index_max();
+
+  // Retrain the winning configuration on the full training set, so that the
+  // reported objective and model do not depend on the final rung's budget.
+  std::unique_ptr<MLAlgorithm> model;
+  bestObjective = EvaluateConfig<0>(collectionsTuple, configs[bestIndex],
+      trainingXs.n_cols, model);
+  bestModel = std::move(*model);
+
+  return ConfigToTuple<TupleOfHyperParameters<Collections...>, 0>(
+      collectionsTuple, configs[bestIndex]);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+void SuccessiveHalvingTuner<MLAlgorithm,
+                            Metric,
+                            MatType,
+                            PredictionsType,
+                            WeightsType>::InitData(
+    const double validationSize,
+    const MatType& xsIn,
+    const PredictionsType& ysIn,
+    const bool shuffle)
+{
+  Base::AssertDataConsistency(xsIn, ysIn);
+
+  if (validationSize < 0.0 || validationSize > 1.0)
+    throw std::invalid_argument("SuccessiveHalvingTuner: the validationSize "
+        "parameter should be more than 0 and less than 1");
+
+  if (xsIn.n_cols < 2)
+    throw std::invalid_argument(
+        "SuccessiveHalvingTuner: 2 or more data points are expected");
+
+  // The budget of a rung is a prefix of the training set, so the data are
+  // shuffled to make each budget a random subsample.
+  if (shuffle)
+  {
+    ShuffleData(xsIn, ysIn, xs, ys);
+  }
+  else
+  {
+    xs = xsIn;
+    ys = ysIn;
+  }
+
+  const size_t trainingPoints = round(xs.n_cols * (1.0 - validationSize));
+  if (trainingPoints == 0 || trainingPoints == xs.n_cols)
+    throw std::invalid_argument("SuccessiveHalvingTuner: the validationSize "
+        "parameter is either too small or too big");
+
+  trainingXs = GetSubset(xs, 0, trainingPoints - 1);
+  trainingYs = GetSubset(ys, 0, trainingPoints - 1);
+
+  validationXs = GetSubset(xs, trainingPoints, xs.n_cols - 1);
+  validationYs = GetSubset(ys, trainingPoints, xs.n_cols - 1);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+void SuccessiveHalvingTuner<MLAlgorithm,
+                            Metric,
+                            MatType,
+                            PredictionsType,
+                            WeightsType>::AssertParameters() const
+{
+  if (eta <= 1.0)
+    throw std::invalid_argument(
+        "SuccessiveHalvingTuner: eta should be greater than 1");
+
+  if (minBudget <= 0.0 || minBudget > 1.0)
+    throw std::invalid_argument("SuccessiveHalvingTuner: minBudget should be "
+        "more than 0 and not more than 1");
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename ElementType>
+arma::Mat<ElementType> SuccessiveHalvingTuner<MLAlgorithm,
+                                              Metric,
+                                              MatType,
+                                              PredictionsType,
+                                              WeightsType>::GetSubset(
+    arma::Mat<ElementType>& m,
+    const size_t firstCol,
+    const size_t lastCol)
+{
+  return arma::Mat<ElementType>(m.colptr(firstCol), m.n_rows,
+      lastCol - firstCol + 1, false, true);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename ElementType>
+arma::Row<ElementType> SuccessiveHalvingTuner<MLAlgorithm,
+                                              Metric,
+                                              MatType,
+                                              PredictionsType,
+                                              WeightsType>::GetSubset(
+    arma::Row<ElementType>& r,
+    const size_t firstCol,
+    const size_t lastCol)
+{
+  return arma::Row<ElementType>(r.colptr(firstCol), lastCol - firstCol + 1,
+      false, true);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename CollectionsTupleType>
+arma::vec SuccessiveHalvingTuner<MLAlgorithm,
+                                 Metric,
+                                 MatType,
+                                 PredictionsType,
+                                 WeightsType>::EvaluateRung(
+    const CollectionsTupleType& collections,
+    const std::vector<std::vector<size_t>>& configs,
+    const double budget)
+{
+  const size_t numTrainingPoints = std::max((size_t) 1,
+      std::min((size_t) trainingXs.n_cols,
+          (size_t) std::round(budget * trainingXs.n_cols)));
+
+  arma::vec scores(configs.size());
+
+  // Pre-draw one seed per configuration from the global generator, so that
+  // each configuration trains from the same random state no matter which
+  // thread runs it or in which order the configurations are scheduled.
+  std::vector<uint32_t> seeds(configs.size());
+  for (size_t j = 0; j < configs.size(); ++j)
+    seeds[j] = (uint32_t) RandGen()();
+
+  // An exception thrown by a configuration is captured (keeping the one of
+  // the earliest configuration, for determinism) and rethrown once the rung
+  // has finished.
+  std::exception_ptr configException = nullptr;
+  size_t exceptionIndex = configs.size();
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t j = 0; j < configs.size(); ++j)
+  {
+    try
+    {
+      RandGen().seed(seeds[j]);
+      std::unique_ptr<MLAlgorithm> model;
+      scores(j) = EvaluateConfig<0>(collections, configs[j],
+          numTrainingPoints, model);
+    }
+    catch (...)
+    {
+      #pragma omp critical (SuccessiveHalvingError)
+      if (j < exceptionIndex)
+      {
+        exceptionIndex = j;
+        configException = std::current_exception();
+      }
+    }
+  }
+
+  if (configException)
+    std::rethrow_exception(configException);
+
+  return scores;
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<size_t I, typename CollectionsTupleType, typename... Args, typename>
+double SuccessiveHalvingTuner<MLAlgorithm,
+                              Metric,
+                              MatType,
+                              PredictionsType,
+                              WeightsType>::EvaluateConfig(
+    const CollectionsTupleType& collections,
+    const std::vector<size_t>& config,
+    const size_t numTrainingPoints,
+    std::unique_ptr<MLAlgorithm>& model,
+    const Args&... args)
+{
+  return EvaluateConfig<I + 1>(collections, config, numTrainingPoints, model,
+      args..., *std::next(std::get<I>(collections).begin(), config[I]));
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<size_t I, typename CollectionsTupleType, typename... Args, typename,
+    typename>
+double SuccessiveHalvingTuner<MLAlgorithm,
+                              Metric,
+                              MatType,
+                              PredictionsType,
+                              WeightsType>::EvaluateConfig(
+    const CollectionsTupleType& /* collections */,
+    const std::vector<size_t>& /* config */,
+    const size_t numTrainingPoints,
+    std::unique_ptr<MLAlgorithm>& model,
+    const Args&... args)
+{
+  MatType budgetXs = GetSubset(trainingXs, 0, numTrainingPoints - 1);
+  PredictionsType budgetYs = GetSubset(trainingYs, 0, numTrainingPoints - 1);
+
+  model.reset(new MLAlgorithm(base.Train(budgetXs, budgetYs, args...)));
+
+  return Metric::Evaluate(*model, validationXs, validationYs);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename TupleType, size_t I, typename CollectionsTupleType,
+    typename... Args, typename>
+TupleType SuccessiveHalvingTuner<MLAlgorithm,
+                                 Metric,
+                                 MatType,
+                                 PredictionsType,
+                                 WeightsType>::ConfigToTuple(
+    const CollectionsTupleType& collections,
+    const std::vector<size_t>& config,
+    const Args&... args)
+{
+  return ConfigToTuple<TupleType, I + 1>(collections, config, args...,
+      *std::next(std::get<I>(collections).begin(), config[I]));
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename TupleType, size_t I, typename CollectionsTupleType,
+    typename... Args, typename, typename>
+TupleType SuccessiveHalvingTuner<MLAlgorithm,
+                                 Metric,
+                                 MatType,
+                                 PredictionsType,
+                                 WeightsType>::ConfigToTuple(
+    const CollectionsTupleType& /* collections */,
+    const std::vector<size_t>& /* config */,
+    const Args&... args)
+{
+  return TupleType(args...);
+}
+
+} // namespace mlpack
+
+#endif
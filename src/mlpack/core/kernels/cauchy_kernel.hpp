@@ -67,6 +67,17 @@ class CauchyKernel
         std::pow(EuclideanDistance::Evaluate(a, b) / bandwidth, 2)));
   }
 
+  /**
+   * Evaluation of the Cauchy kernel given the distance between two points.
+   *
+   * @param t The distance between the two points the kernel is evaluated on.
+   * @return K(t) using the bandwidth (@f$\sigma@f$).
+   */
+  double Evaluate(const double t) const
+  {
+    return 1 / (1 + std::pow(t / bandwidth, 2));
+  }
+
   /**
    * Serialize the kernel.
    */
@@ -88,6 +99,8 @@ class KernelTraits<CauchyKernel>
  public:
   //! The Cauchy kernel is normalized: K(x, x) = 1 for all x.
   static const bool IsNormalized = true;
+  //! The Cauchy kernel is not a function of the dot product alone.
+  static const bool IsDotProductBased = false;
 };
 
 } // namespace mlpack
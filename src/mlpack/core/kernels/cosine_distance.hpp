@@ -55,6 +55,8 @@ class KernelTraits<CosineDistance>
 
   //! The cosine kernel doesn't include a squared distance.
   static const bool UsesSquaredDistance = false;
+  //! The cosine distance is not a function of the dot product alone.
+  static const bool IsDotProductBased = false;
 };
 
 } // namespace mlpack
@@ -110,6 +110,8 @@ class KernelTraits<EpanechnikovKernel>
   static const bool IsNormalized = true;
   //! The Epanechnikov kernel includes a squared distance.
   static const bool UsesSquaredDistance = true;
+  //! The Epanechnikov kernel is not a function of the dot product alone.
+  static const bool IsDotProductBased = false;
 };
 
 } // namespace mlpack
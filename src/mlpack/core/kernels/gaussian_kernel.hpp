@@ -170,6 +170,8 @@ class KernelTraits<GaussianKernel>
   static const bool IsNormalized = true;
   //! The Gaussian kernel includes a squared distance.
   static const bool UsesSquaredDistance = true;
+  //! The Gaussian kernel is not a function of the dot product alone.
+  static const bool IsDotProductBased = false;
 };
 
 } // namespace mlpack
@@ -0,0 +1,139 @@
+/**
+ * @file core/kernels/kernel_matrix.hpp
+ * @author Ryan Curtin
+ *
+ * Batched evaluation of a kernel on all pairs of points from two sets.  This
+ * gives every kernel consumer (FastMKS, KDE, KernelPCA, NystroemMethod, ...)
+ * one tuned implementation of the "fill a kernel block" loop instead of each
+ * rolling its own.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+#define MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/pairwise_distances.hpp>
+
+#include "kernel_traits.hpp"
+
+namespace mlpack {
+
+namespace internal {
+
+/**
+ * SFINAE helper: true if the kernel provides a scalar Evaluate(double)
+ * overload that turns a precomputed distance into the kernel value (the
+ * convention used by the distance-based kernels, e.g. GaussianKernel or
+ * LaplacianKernel).
+ */
+template<typename KernelType, typename = void>
+struct HasDistanceEvaluate : std::false_type { };
+
+template<typename KernelType>
+struct HasDistanceEvaluate<KernelType, typename std::enable_if<std::is_same<
+    decltype(std::declval<KernelType&>().Evaluate(0.0)), double>::value>::type>
+    : std::true_type { };
+
+//! Dot-product-based kernels: one matrix multiplication produces all the
+//! inner products, and the kernel's scalar map is applied elementwise.
+template<typename KernelType, typename MatTypeA, typename MatTypeB,
+    typename OutMatType>
+void KernelMatrixImpl(
+    const MatTypeA& a,
+    const MatTypeB& b,
+    KernelType& kernel,
+    OutMatType& k,
+    const typename std::enable_if<
+        KernelTraits<KernelType>::IsDotProductBased>::type* = 0)
+{
+  typedef typename OutMatType::elem_type ElemType;
+
+  k = a.t() * b;
+  k.transform([&kernel](ElemType v)
+      { return (ElemType) kernel.EvaluateDot((double) v); });
+}
+
+//! Distance-based kernels: the blocked pairwise-distance engine produces all
+//! the distances (via BLAS for the Euclidean metric), and the kernel's scalar
+//! Evaluate(distance) overload is applied elementwise.
+template<typename KernelType, typename MatTypeA, typename MatTypeB,
+    typename OutMatType>
+void KernelMatrixImpl(
+    const MatTypeA& a,
+    const MatTypeB& b,
+    KernelType& kernel,
+    OutMatType& k,
+    const typename std::enable_if<
+        !KernelTraits<KernelType>::IsDotProductBased &&
+        HasDistanceEvaluate<KernelType>::value>::type* = 0)
+{
+  typedef typename OutMatType::elem_type ElemType;
+
+  EuclideanDistance metric;
+  PairwiseDistances(a, b, metric, k);
+  k.transform([&kernel](ElemType v)
+      { return (ElemType) kernel.Evaluate((double) v); });
+}
+
+//! Generic fallback: evaluate the kernel pair by pair, with the output
+//! columns dispatched across threads.
+template<typename KernelType, typename MatTypeA, typename MatTypeB,
+    typename OutMatType>
+void KernelMatrixImpl(
+    const MatTypeA& a,
+    const MatTypeB& b,
+    KernelType& kernel,
+    OutMatType& k,
+    const typename std::enable_if<
+        !KernelTraits<KernelType>::IsDotProductBased &&
+        !HasDistanceEvaluate<KernelType>::value>::type* = 0)
+{
+  k.set_size(a.n_cols, b.n_cols);
+
+  #pragma omp parallel for schedule(static)
+  for (size_t j = 0; j < (size_t) b.n_cols; ++j)
+    for (size_t i = 0; i < (size_t) a.n_cols; ++i)
+      k(i, j) = kernel.Evaluate(a.col(i), b.col(j));
+}
+
+} // namespace internal
+
+/**
+ * Evaluate the given kernel on every pair of columns from a and b, so that
+ * k(i, j) holds the kernel value of a.col(i) and b.col(j).  The computation
+ * is routed by the kernel's traits:
+ *
+ *  - Dot-product-based kernels (KernelTraits::IsDotProductBased) are computed
+ *    with one matrix multiplication followed by an elementwise map through
+ *    EvaluateDot().
+ *  - Kernels that are a function of the distance (detected by the scalar
+ *    Evaluate(double) overload) are routed through the blocked
+ *    PairwiseDistances() engine and then mapped elementwise.
+ *  - Everything else falls back to a parallel pairwise loop.
+ *
+ * The matrix arguments may be subviews, so large problems can be tiled by the
+ * caller to bound the size of the output block.
+ *
+ * @param a First set of points; one point per column.
+ * @param b Second set of points; one point per column.
+ * @param kernel Instantiated kernel.
+ * @param k Matrix to store the kernel values in; it will be set to size
+ *     a.n_cols x b.n_cols.
+ */
+template<typename KernelType, typename MatTypeA, typename MatTypeB,
+    typename OutMatType>
+void KernelMatrix(const MatTypeA& a,
+                  const MatTypeB& b,
+                  KernelType& kernel,
+                  OutMatType& k)
+{
+  internal::KernelMatrixImpl(a, b, kernel, k);
+}
+
+} // namespace mlpack
+
+#endif
@@ -35,6 +35,14 @@ class KernelTraits
    * If true, then the kernel include a squared distance, ||x - y||^2 .
    */
   static const bool UsesSquaredDistance = false;
+
+  /**
+   * If true, then the kernel is a function of the inner product < x, y > only,
+   * and provides EvaluateDot(), which turns a precomputed inner product into
+   * the kernel value.  This allows batches of kernel evaluations to be
+   * computed with a single matrix multiplication.
+   */
+  static const bool IsDotProductBased = false;
 };
 
 } // namespace mlpack
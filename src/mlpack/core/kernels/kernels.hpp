@@ -13,6 +13,7 @@
 #define MLPACK_CORE_KERNELS_KERNELS_HPP
 
 #include "kernel_traits.hpp"
+#include "kernel_matrix.hpp"
 
 #include "cauchy_kernel.hpp"
 #include "cosine_distance.hpp"
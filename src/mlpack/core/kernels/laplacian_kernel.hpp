@@ -116,6 +116,8 @@ class KernelTraits<LaplacianKernel>
   static const bool IsNormalized = true;
   //! The Laplacian kernel doesn't include a squared distance.
   static const bool UsesSquaredDistance = false;
+  //! The Laplacian kernel is not a function of the dot product alone.
+  static const bool IsDotProductBased = false;
 };
 
 } // namespace mlpack
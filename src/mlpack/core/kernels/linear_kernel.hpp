@@ -15,6 +15,7 @@
 #define MLPACK_CORE_KERNELS_LINEAR_KERNEL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_traits.hpp>
 
 namespace mlpack {
 
@@ -54,11 +55,36 @@ class LinearKernel
     return arma::dot(a, b);
   }
 
+  /**
+   * Evaluate the kernel given a precomputed dot product < a, b >.  For the
+   * linear kernel, that dot product is the kernel value itself.
+   *
+   * @param dotProduct Dot product of the two vectors.
+   * @return K(a, b).
+   */
+  static double EvaluateDot(const double dotProduct)
+  {
+    return dotProduct;
+  }
+
   //! Serialize the kernel (it has no members... do nothing).
   template<typename Archive>
   void serialize(Archive& /* ar */, const uint32_t /* version */) { }
 };
 
+//! Kernel traits for the linear kernel.
+template<>
+class KernelTraits<LinearKernel>
+{
+ public:
+  //! The linear kernel is not normalized: K(x, x) can be arbitrary.
+  static const bool IsNormalized = false;
+  //! The linear kernel doesn't include a squared distance.
+  static const bool UsesSquaredDistance = false;
+  //! The linear kernel is a function of the dot product only.
+  static const bool IsDotProductBased = true;
+};
+
 } // namespace mlpack
 
 #endif
@@ -144,6 +144,23 @@ class ColumnsToBlocks
    */
   void Transform(const arma::mat& maximalInputs, arma::mat& output);
 
+  /**
+   * The inverse of Transform(): gather the blocks of a matrix laid out by
+   * Transform() back into one column per block, ignoring the buffer margins.
+   * The output matrix will have (blockHeight * blockWidth) rows and
+   * (rows * cols) columns, in the same column order Transform() consumed, so
+   * it can be passed directly to, e.g., SparseCoding::Encode().  Note that
+   * any scaling applied by Transform() (see Scale()) is not undone.
+   *
+   * The block height and width must be set (either in the constructor or via
+   * BlockHeight() and BlockWidth(), or by an earlier Transform() call that
+   * inferred them).
+   *
+   * @param blocks Matrix in the block layout produced by Transform().
+   * @param output Matrix to store the gathered columns in.
+   */
+  void InverseTransform(const arma::mat& blocks, arma::mat& output) const;
+
   //! Set the height of each block; see the constructor for more details.
   void BlockHeight(const size_t value) { blockHeight = value; }
   //! Get the block height.
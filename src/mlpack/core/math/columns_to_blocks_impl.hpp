@@ -14,6 +14,8 @@
 
 #include "columns_to_blocks.hpp"
 
+#include <cstring>
+
 namespace mlpack {
 
 inline ColumnsToBlocks::ColumnsToBlocks(const size_t rows,
@@ -61,29 +63,30 @@ inline void ColumnsToBlocks::Transform(const arma::mat& maximalInputs,
                              "equal to maximalInputs.n_rows");
   }
 
-  const size_t rowOffset = blockHeight+bufSize;
-  const size_t colOffset = blockWidth+bufSize;
-  output.ones(bufSize + rows * rowOffset,
-              bufSize + cols * colOffset);
-  output *= bufValue;
+  const size_t rowOffset = blockHeight + bufSize;
+  const size_t colOffset = blockWidth + bufSize;
+  // set_size() reuses the output's allocation when it is already the right
+  // size, so a caller transforming many batches pays for the buffer once.
+  output.set_size(bufSize + rows * rowOffset, bufSize + cols * colOffset);
+  output.fill(bufValue);
 
-  size_t k = 0;
+  // Each block is a disjoint region of the output, so the scatter is
+  // parallel over blocks; a block column is contiguous in both the input
+  // column and the output, so it is copied as one memcpy().
   const size_t maxSize = std::min(rows * cols, (size_t) maximalInputs.n_cols);
-  for (size_t i = 0; i != rows; ++i)
+  #pragma omp parallel for schedule(static)
+  for (size_t k = 0; k < maxSize; ++k)
   {
-    for (size_t j = 0; j != cols; ++j)
-    {
-      // Now, copy the elements of the row to the output submatrix.
-      const size_t minRow = bufSize + i * rowOffset;
-      const size_t minCol = bufSize + j * colOffset;
-      const size_t maxRow = i * rowOffset + blockHeight;
-      const size_t maxCol = j * colOffset + blockWidth;
-
-      output.submat(minRow, minCol, maxRow, maxCol) =
-          arma::reshape(maximalInputs.col(k++), blockHeight, blockWidth);
+    const size_t i = k / cols;
+    const size_t j = k % cols;
+    const size_t minRow = bufSize + i * rowOffset;
+    const size_t minCol = bufSize + j * colOffset;
 
-      if (k >= maxSize)
-        break;
+    const double* inCol = maximalInputs.colptr(k);
+    for (size_t w = 0; w < blockWidth; ++w)
+    {
+      std::memcpy(output.colptr(minCol + w) + minRow,
+          inCol + w * blockHeight, blockHeight * sizeof(double));
     }
   }
 
@@ -98,6 +101,50 @@ inline void ColumnsToBlocks::Transform(const arma::mat& maximalInputs,
   }
 }
 
+inline void ColumnsToBlocks::InverseTransform(const arma::mat& blocks,
+                                              arma::mat& output) const
+{
+  if (blockHeight == 0 || blockWidth == 0)
+  {
+    throw std::runtime_error("blockHeight and blockWidth must be set before "
+                             "calling InverseTransform()");
+  }
+
+  const size_t rowOffset = blockHeight + bufSize;
+  const size_t colOffset = blockWidth + bufSize;
+  if (blocks.n_rows != bufSize + rows * rowOffset ||
+      blocks.n_cols != bufSize + cols * colOffset)
+  {
+    throw std::runtime_error("blocks matrix does not have the dimensions "
+                             "produced by Transform()");
+  }
+
+  // As in Transform(), set_size() reuses the output's allocation when it
+  // already has the right size, and the columns are filled directly, so the
+  // result can be handed to, e.g., SparseCoding::Encode() without any
+  // intermediate copy.
+  output.set_size(blockHeight * blockWidth, rows * cols);
+
+  // The gather mirrors the scatter in Transform(): each output column is a
+  // disjoint block of the input, copied one contiguous block column at a
+  // time.
+  #pragma omp parallel for schedule(static)
+  for (size_t k = 0; k < rows * cols; ++k)
+  {
+    const size_t i = k / cols;
+    const size_t j = k % cols;
+    const size_t minRow = bufSize + i * rowOffset;
+    const size_t minCol = bufSize + j * colOffset;
+
+    double* outCol = output.colptr(k);
+    for (size_t w = 0; w < blockWidth; ++w)
+    {
+      std::memcpy(outCol + w * blockHeight,
+          blocks.colptr(minCol + w) + minRow, blockHeight * sizeof(double));
+    }
+  }
+}
+
 } // namespace mlpack
 
 #endif
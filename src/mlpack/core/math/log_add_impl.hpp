@@ -13,9 +13,24 @@
 #define MLPACK_CORE_MATH_LOG_ADD_IMPL_HPP
 
 #include "log_add.hpp"
+#include "log_add_kernels.hpp"
 
 namespace mlpack {
 
+namespace internal {
+
+//! Whether the raw log-add kernels apply: a dense vector type (whose memory
+//! is always contiguous) with a floating-point element type.
+template<typename T>
+struct HasLogAddKernel
+{
+  static const bool value =
+      (arma::is_Col<T>::value || arma::is_Row<T>::value) &&
+      std::is_floating_point<typename T::elem_type>::value;
+};
+
+} // namespace internal
+
 /** Internal log-addition
  *
  * @f[
@@ -52,6 +67,33 @@ T LogAdd(T x, T y)
   return r + log(1 + exp(d));
 }
 
+namespace internal {
+
+// Dense contiguous floating-point vectors go through the dispatched raw
+// kernels; anything else (sparse vectors, expressions, integer types) keeps
+// the Armadillo expression form.
+template<typename T>
+typename std::enable_if<HasLogAddKernel<T>::value,
+    typename T::elem_type>::type
+AccuLogImpl(const T& x)
+{
+  return LogSumExpRaw(x.memptr(), x.n_elem);
+}
+
+template<typename T>
+typename std::enable_if<!HasLogAddKernel<T>::value,
+    typename T::elem_type>::type
+AccuLogImpl(const T& x)
+{
+  typename T::elem_type maxVal = max(x);
+  if (maxVal == -std::numeric_limits<typename T::elem_type>::infinity())
+    return maxVal;
+
+  return maxVal + log(sum(exp(x - maxVal)));
+}
+
+} // namespace internal
+
 /**
  * Sum a vector of log values.
  *
@@ -61,11 +103,7 @@ T LogAdd(T x, T y)
 template<typename T>
 typename T::elem_type AccuLog(const T& x)
 {
-  typename T::elem_type maxVal = max(x);
-  if (maxVal == -std::numeric_limits<typename T::elem_type>::infinity())
-    return maxVal;
-
-  return maxVal + log(sum(exp(x - maxVal)));;
+  return internal::AccuLogImpl(x);
 }
 
 /**
@@ -83,15 +121,16 @@ void LogSumExp(const T& x, arma::Col<typename T::elem_type>& y)
     // Compute the maximum in each column (treating y as a column too).
     maxs = max(max(x, 1), y);
 
-    y = maxs + log(sum(exp(x - repmat(maxs, 1, x.n_cols)), 1) +
-        exp(y - maxs));
+    // Broadcast the maxima over the columns instead of materializing a
+    // repmat() temporary.
+    y = maxs + log(sum(exp(x.each_col() - maxs), 1) + exp(y - maxs));
   }
   else
   {
     // Compute the maximum element in each column.
     maxs = max(x, 1);
 
-    y = maxs + log(sum(exp(x - repmat(maxs, 1, x.n_cols)), 1));
+    y = maxs + log(sum(exp(x.each_col() - maxs), 1));
   }
 
   if (maxs.has_inf())
@@ -101,13 +140,45 @@ void LogSumExp(const T& x, arma::Col<typename T::elem_type>& y)
   }
 }
 
-/**
- * Compute the sum of exponentials of each element in each row, then compute the
- * log of that.  If InPlace is true, then the values of `y` will also be added
- * to the sum.
- */
+namespace internal {
+
+// Each column of a dense matrix is a contiguous block, so the
+// per-column reduction of LogSumExpT() can go through the dispatched raw
+// kernels; other types keep the Armadillo expression form below.
 template<typename T, bool InPlace>
-void LogSumExpT(const T& x, arma::Col<typename T::elem_type>& y)
+typename std::enable_if<arma::is_Mat_only<T>::value &&
+    std::is_floating_point<typename T::elem_type>::value>::type
+LogSumExpTImpl(const T& x, arma::Col<typename T::elem_type>& y)
+{
+  typedef typename T::elem_type eT;
+
+  if (!InPlace)
+    y.set_size(x.n_cols);
+
+  for (size_t j = 0; j < x.n_cols; ++j)
+  {
+    const eT* col = x.colptr(j);
+    eT maxVal = MaxRaw(col, x.n_rows);
+    if (InPlace)
+      maxVal = std::max(maxVal, y[j]);
+
+    if (maxVal == -std::numeric_limits<eT>::infinity())
+    {
+      y[j] = maxVal;
+      continue;
+    }
+
+    eT sum = ExpSumRaw(col, x.n_rows, maxVal);
+    if (InPlace)
+      sum += std::exp(y[j] - maxVal);
+    y[j] = maxVal + std::log(sum);
+  }
+}
+
+template<typename T, bool InPlace>
+typename std::enable_if<!(arma::is_Mat_only<T>::value &&
+    std::is_floating_point<typename T::elem_type>::value)>::type
+LogSumExpTImpl(const T& x, arma::Col<typename T::elem_type>& y)
 {
   arma::Row<typename T::elem_type> maxs;
 
@@ -116,15 +187,17 @@ void LogSumExpT(const T& x, arma::Col<typename T::elem_type>& y)
     // Compute the maximum element in each column.
     maxs = max(max(x, 0), y.t());
 
-    y = maxs.t() + log(sum(exp(x - repmat(maxs, x.n_rows, 1)), 0) +
+    // Broadcast the maxima over the rows instead of materializing a repmat()
+    // temporary.
+    y = maxs.t() + log(sum(exp(x.each_row() - maxs), 0) +
         exp(y.t() - maxs)).t();
   }
   else
   {
     // Compute the maximum element in each column.
-    arma::Row<typename T::elem_type> maxs = max(x, 0);
+    maxs = max(x, 0);
 
-    y = (maxs + log(sum(exp(x - repmat(maxs, x.n_rows, 1)), 0))).t();
+    y = (maxs + log(sum(exp(x.each_row() - maxs), 0))).t();
   }
 
   if (maxs.has_inf())
@@ -134,6 +207,19 @@ void LogSumExpT(const T& x, arma::Col<typename T::elem_type>& y)
   }
 }
 
+} // namespace internal
+
+/**
+ * Compute the sum of exponentials of each element in each row, then compute the
+ * log of that.  If InPlace is true, then the values of `y` will also be added
+ * to the sum.
+ */
+template<typename T, bool InPlace>
+void LogSumExpT(const T& x, arma::Col<typename T::elem_type>& y)
+{
+  internal::LogSumExpTImpl<T, InPlace>(x, y);
+}
+
 } // namespace mlpack
 
 #endif
@@ -0,0 +1,156 @@
+/**
+ * @file core/math/log_add_kernels.hpp
+ * @author Arash Abghari
+ *
+ * Raw-array reduction kernels for logarithmic addition.  These are the
+ * max-subtract-exp-sum inner loops of AccuLog() and LogSumExpT(), written
+ * over contiguous memory blocks and marked with MLPACK_TARGET_CLONES so that
+ * the best vectorization for the running CPU is selected at load time (see
+ * core/util/arch_dispatch.hpp).
+ *
+ * By default the sums call std::exp() and the results are bit-identical to
+ * the Armadillo expression forms.  Defining MLPACK_LOG_ADD_FAST_EXP switches
+ * the block sums to a branch-free polynomial approximation of exp() that the
+ * compiler can vectorize (see FastExp() below for its error bound); the
+ * expression fallbacks for non-contiguous arguments always remain exact.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_LOG_ADD_KERNELS_HPP
+#define MLPACK_CORE_MATH_LOG_ADD_KERNELS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/arch_dispatch.hpp>
+
+#include <cstring>
+
+namespace mlpack {
+namespace internal {
+
+/**
+ * Branch-free approximation of exp(x) for x <= 0, as produced by the
+ * max-subtraction in a log-sum-exp reduction.  The argument is reduced as
+ * x = k ln(2) + r with |r| <= ln(2)/2, exp(r) is evaluated with a
+ * degree-seven Taylor polynomial, and the 2^k scaling is applied by direct
+ * exponent-field construction.
+ *
+ * The Taylor remainder bounds the relative error by ln(2)^8 / (2^8 8!), so
+ * the result is within 6e-9 of exp(x) in relative terms -- many double ulps,
+ * but well within one float ulp -- over the full domain; arguments below the
+ * double underflow threshold return 0.  After the log() of the summed result
+ * this contributes at most ~6e-9 absolute error, far below what the
+ * surrounding HMM/GMM pipelines resolve, but it is not bit-identical to
+ * std::exp(), which is why it is only used when MLPACK_LOG_ADD_FAST_EXP is
+ * defined.
+ */
+inline double FastExp(const double x)
+{
+  // exp() underflows to zero below this anyway; clamping also keeps the
+  // exponent-field construction below in range.
+  if (x < -708.0)
+    return 0.0;
+
+  // x = k ln(2) + r, with k rounded to nearest.
+  const double log2e = 1.4426950408889634074;
+  const double k = std::floor(x * log2e + 0.5);
+  // ln(2) in two pieces, so that the reduction is exact in double precision.
+  const double r = (x - k * 0.693359375) + k * 2.12194440054690583e-4;
+
+  // Degree-seven Taylor polynomial for exp(r), |r| <= ln(2)/2, evaluated by
+  // Horner's rule.
+  double p = 1.0 / 5040.0;
+  p = p * r + 1.0 / 720.0;
+  p = p * r + 1.0 / 120.0;
+  p = p * r + 1.0 / 24.0;
+  p = p * r + 1.0 / 6.0;
+  p = p * r + 0.5;
+  p = p * r + 1.0;
+  p = p * r + 1.0;
+
+  // Build 2^k by placing (k + 1023) in the exponent field.
+  const int64_t bits = ((int64_t) k + 1023) << 52;
+  double scale;
+  std::memcpy(&scale, &bits, sizeof(double));
+
+  return p * scale;
+}
+
+//! Single-precision arguments go through the double computation; the result
+//! is correctly rounded for float purposes.
+inline float FastExp(const float x)
+{
+  return (float) FastExp((double) x);
+}
+
+//! Maximum over a raw array (the first pass of a log-sum-exp reduction).
+MLPACK_TARGET_CLONES
+inline double MaxRaw(const double* mem, const size_t n)
+{
+  double maxVal = -std::numeric_limits<double>::infinity();
+  for (size_t i = 0; i < n; ++i)
+    maxVal = (mem[i] > maxVal) ? mem[i] : maxVal;
+  return maxVal;
+}
+
+MLPACK_TARGET_CLONES
+inline float MaxRaw(const float* mem, const size_t n)
+{
+  float maxVal = -std::numeric_limits<float>::infinity();
+  for (size_t i = 0; i < n; ++i)
+    maxVal = (mem[i] > maxVal) ? mem[i] : maxVal;
+  return maxVal;
+}
+
+//! Sum of exp(mem[i] - maxVal) over a raw array (the second pass of a
+//! log-sum-exp reduction).
+MLPACK_TARGET_CLONES
+inline double ExpSumRaw(const double* mem, const size_t n, const double maxVal)
+{
+  double sum = 0.0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    #ifdef MLPACK_LOG_ADD_FAST_EXP
+    sum += FastExp(mem[i] - maxVal);
+    #else
+    sum += std::exp(mem[i] - maxVal);
+    #endif
+  }
+  return sum;
+}
+
+MLPACK_TARGET_CLONES
+inline float ExpSumRaw(const float* mem, const size_t n, const float maxVal)
+{
+  float sum = 0.0f;
+  for (size_t i = 0; i < n; ++i)
+  {
+    #ifdef MLPACK_LOG_ADD_FAST_EXP
+    sum += FastExp(mem[i] - maxVal);
+    #else
+    sum += std::exp(mem[i] - maxVal);
+    #endif
+  }
+  return sum;
+}
+
+/**
+ * Full log-sum-exp reduction over one contiguous block:
+ * log(exp(mem[0]) + ... + exp(mem[n - 1])), computed stably.
+ */
+template<typename eT>
+inline eT LogSumExpRaw(const eT* mem, const size_t n)
+{
+  const eT maxVal = MaxRaw(mem, n);
+  if (maxVal == -std::numeric_limits<eT>::infinity())
+    return maxVal;
+
+  return maxVal + std::log(ExpSumRaw(mem, n, maxVal));
+}
+
+} // namespace internal
+} // namespace mlpack
+
+#endif
@@ -41,6 +41,59 @@ arma::Mat<ElemType> MakeAlias(arma::Mat<ElemType>& input,
       strict);
 }
 
+/**
+ * Make an alias of a dense matrix over externally owned memory, such as a
+ * buffer living in shared memory that was allocated by another process.  The
+ * memory is not copied and will never be freed by the returned matrix, so it
+ * must remain valid for the lifetime of the alias (and of anything built on
+ * top of the alias).  If strict is true, then the alias cannot be resized or
+ * pointed at new memory.
+ */
+template<typename ElemType>
+arma::Mat<ElemType> MakeAlias(ElemType* mem,
+                              const size_t numRows,
+                              const size_t numCols,
+                              const bool strict = true)
+{
+  // Use the advanced constructor.
+  return arma::Mat<ElemType>(mem, numRows, numCols, false, strict);
+}
+
+/**
+ * Make an alias of a contiguous range of columns of a dense matrix.  The
+ * memory is not copied, so the returned matrix is a view: changes made
+ * through it are visible in the input matrix, and the input must outlive the
+ * alias.  This is the view type to hand to templated Train() signatures when
+ * a sub-model should train on a column range without a copy.  If strict is
+ * true, then the alias cannot be resized or pointed at new memory.
+ */
+template<typename ElemType>
+arma::Mat<ElemType> MakeColsAlias(arma::Mat<ElemType>& input,
+                                  const size_t firstCol,
+                                  const size_t numCols,
+                                  const bool strict = true)
+{
+  // Use the advanced constructor.
+  return arma::Mat<ElemType>(input.colptr(firstCol), input.n_rows, numCols,
+      false, strict);
+}
+
+/**
+ * Make an alias of a contiguous range of elements of a dense row, e.g. the
+ * labels or instance weights matching a column range of a dataset.  If strict
+ * is true, then the alias cannot be resized or pointed at new memory.
+ */
+template<typename ElemType>
+arma::Row<ElemType> MakeColsAlias(arma::Row<ElemType>& input,
+                                  const size_t firstCol,
+                                  const size_t numCols,
+                                  const bool strict = true)
+{
+  // Use the advanced constructor.
+  return arma::Row<ElemType>(input.memptr() + firstCol, numCols, false,
+      strict);
+}
+
 /**
  * Make an alias of a dense row.  If strict is true, then the alias cannot be
  * resized or pointed at new memory.
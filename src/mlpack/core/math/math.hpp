@@ -23,6 +23,7 @@
 #include "quantile.hpp"
 #include "random_basis.hpp"
 #include "random.hpp"
+#include "random_projection.hpp"
 #include "range.hpp"
 #include "round.hpp"
 #include "shuffle_data.hpp"
@@ -55,23 +55,30 @@ CubeType MultiplyCube2Cube(const CubeType& cubeA,
 
   CubeType z(rows, cols, slices);
 
+  // Each slice product is independent and writes a disjoint slice of z, so
+  // the sub-BLAS-size multiplies of attention-style layers run in parallel
+  // across slices instead of serializing on one small GEMM at a time.
   if (aTranspose && bTranspose)
   {
+    #pragma omp parallel for schedule(static)
     for (size_t i = 0; i < slices; ++i)
       z.slice(i) = arma::trans(cubeB.slice(i) * cubeA.slice(i));
   }
   else if (bTranspose && !aTranspose)
   {
+    #pragma omp parallel for schedule(static)
     for (size_t i = 0; i < slices; ++i)
       z.slice(i) = cubeA.slice(i) * cubeB.slice(i).t();
   }
   else if (aTranspose && !bTranspose)
   {
+    #pragma omp parallel for schedule(static)
     for (size_t i = 0; i < slices; ++i)
       z.slice(i) = cubeA.slice(i).t() * cubeB.slice(i);
   }
   else
   {
+    #pragma omp parallel for schedule(static)
     for (size_t i = 0; i < slices; ++i)
       z.slice(i) = cubeA.slice(i) * cubeB.slice(i);
   }
@@ -115,23 +122,31 @@ CubeType MultiplyMat2Cube(const MatType& matA,
 
   if (aTranspose && bTranspose)
   {
+    #pragma omp parallel for schedule(static)
     for (size_t i = 0; i < slices; ++i)
       z.slice(i) = arma::trans(cubeB.slice(i) * matA);
   }
   else if (bTranspose)
   {
+    #pragma omp parallel for schedule(static)
     for (size_t i = 0; i < slices; ++i)
       z.slice(i) = matA * cubeB.slice(i).t();
   }
-  else if (aTranspose)
-  {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = matA.t() * cubeB.slice(i);
-  }
   else
   {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = matA * cubeB.slice(i);
+    // When the cube operand is not transposed, its slices -- and the slices
+    // of the result -- are contiguous in memory, so multiplying every slice
+    // by the same matrix is a single large GEMM over the cubes viewed as
+    // (n_rows x n_cols * n_slices) matrices.  One big BLAS call is far
+    // faster than n_slices sub-BLAS-size ones.
+    typedef typename CubeType::elem_type eT;
+    const arma::Mat<eT> bFlat(const_cast<eT*>(cubeB.memptr()), cubeB.n_rows,
+        cubeB.n_cols * slices, false, true);
+    arma::Mat<eT> zFlat(z.memptr(), rows, cols * slices, false, true);
+    if (aTranspose)
+      zFlat = matA.t() * bFlat;
+    else
+      zFlat = matA * bFlat;
   }
   return z;
 }
@@ -169,23 +184,30 @@ CubeType MultiplyCube2Mat(const CubeType& cubeA,
 
   CubeType z(rows, cols, slices);
 
+  // Multiplying from the right cannot be flattened into one GEMM (the
+  // flattened product would mix slices), but the slice products are still
+  // independent, so run them in parallel.
   if (aTranspose && bTranspose)
   {
+    #pragma omp parallel for schedule(static)
     for (size_t i = 0; i < slices; ++i)
       z.slice(i) = arma::trans(matB * cubeA.slice(i));
   }
   else if (bTranspose && !aTranspose)
   {
+    #pragma omp parallel for schedule(static)
     for (size_t i = 0; i < slices; ++i)
       z.slice(i) = cubeA.slice(i) * matB.t();
   }
   else if (aTranspose && !bTranspose)
   {
+    #pragma omp parallel for schedule(static)
     for (size_t i = 0; i < slices; ++i)
       z.slice(i) = cubeA.slice(i).t() * matB;
   }
   else
   {
+    #pragma omp parallel for schedule(static)
     for (size_t i = 0; i < slices; ++i)
       z.slice(i) = cubeA.slice(i) * matB;
   }
@@ -0,0 +1,129 @@
+/**
+ * @file core/math/random_projection.hpp
+ * @author Ryan Curtin
+ *
+ * Fast structured random projections.  These are drop-in alternatives to
+ * projecting with a dense RandomBasis() matrix: instead of an O(d^3) QR
+ * factorization and an O(k d) dense multiply per point, the subsampled
+ * randomized Hadamard transform projects a point in O(d log d) time and the
+ * count-sketch projection in O(d) time, with the same
+ * Johnson-Lindenstrauss-style distance preservation guarantees.  This makes
+ * random projection of very wide datasets practical where building an
+ * explicit orthonormal basis is not.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_RANDOM_PROJECTION_HPP
+#define MLPACK_CORE_MATH_RANDOM_PROJECTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * A subsampled randomized Hadamard transform (SRHT).  The projection is
+ * P = sqrt(d / k) S H D, where D is a diagonal matrix of random signs, H is
+ * the normalized Walsh-Hadamard transform (applied in O(d log d) with an
+ * in-place butterfly, never materialized), and S subsamples k of the d
+ * rotated coordinates.  Inputs whose dimensionality is not a power of two
+ * are implicitly zero-padded.
+ *
+ * The randomness is drawn at construction time, so one object applies the
+ * same projection to any number of points; Project() is parallel over the
+ * columns of its input.
+ */
+class SRHTProjection
+{
+ public:
+  /**
+   * Create the projection, drawing its random signs and coordinate sample.
+   *
+   * @param inDim Dimensionality of the points that will be projected.
+   * @param outDim Dimensionality to project down to.
+   */
+  SRHTProjection(const size_t inDim, const size_t outDim);
+
+  /**
+   * Project each column of the input, storing the result in the given output
+   * matrix (which will be set to size outDim x input.n_cols).
+   *
+   * @param input Input points, one per column (must have InDim() rows).
+   * @param output Matrix to store projected points in.
+   */
+  void Project(const arma::mat& input, arma::mat& output) const;
+
+  //! Get the input dimensionality.
+  size_t InDim() const { return inDim; }
+  //! Get the output dimensionality.
+  size_t OutDim() const { return indices.n_elem; }
+
+ private:
+  //! Dimensionality of the input points.
+  size_t inDim;
+  //! Padded (power-of-two) dimensionality the transform operates in.
+  size_t padDim;
+  //! The random signs on the diagonal of D.
+  arma::vec signs;
+  //! The k rotated coordinates that are kept.
+  arma::uvec indices;
+};
+
+/**
+ * A count-sketch projection.  Each input dimension is hashed to one output
+ * dimension with a random sign, so the projection matrix has a single
+ * nonzero per column and a point is projected in O(d) time.  Distances are
+ * preserved in expectation (the sketch is an unbiased estimator of inner
+ * products), with variance decreasing in the output dimensionality.
+ *
+ * The hash and signs are drawn at construction time, so one object applies
+ * the same projection to any number of points; Project() is parallel over
+ * the columns of its input.
+ */
+class CountSketchProjection
+{
+ public:
+  /**
+   * Create the projection, drawing its hash buckets and signs.
+   *
+   * @param inDim Dimensionality of the points that will be projected.
+   * @param outDim Dimensionality to project down to.
+   */
+  CountSketchProjection(const size_t inDim, const size_t outDim);
+
+  /**
+   * Project each column of the input, storing the result in the given output
+   * matrix (which will be set to size outDim x input.n_cols).
+   *
+   * @param input Input points, one per column (must have InDim() rows).
+   * @param output Matrix to store projected points in.
+   */
+  void Project(const arma::mat& input, arma::mat& output) const;
+
+  //! Get the input dimensionality.
+  size_t InDim() const { return buckets.n_elem; }
+  //! Get the output dimensionality.
+  size_t OutDim() const { return outDim; }
+
+  //! Get the output dimension each input dimension is hashed to.
+  const arma::uvec& Buckets() const { return buckets; }
+  //! Get the sign each input dimension contributes with.
+  const arma::vec& Signs() const { return signs; }
+
+ private:
+  //! Dimensionality of the output points.
+  size_t outDim;
+  //! The output dimension each input dimension is hashed to.
+  arma::uvec buckets;
+  //! The sign each input dimension contributes with.
+  arma::vec signs;
+};
+
+} // namespace mlpack
+
+//! Include the implementation file.
+#include "random_projection_impl.hpp"
+
+#endif
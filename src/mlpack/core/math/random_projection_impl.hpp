@@ -0,0 +1,146 @@
+/**
+ * @file core/math/random_projection_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the fast structured random projections.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_RANDOM_PROJECTION_IMPL_HPP
+#define MLPACK_CORE_MATH_RANDOM_PROJECTION_IMPL_HPP
+
+#include "random_projection.hpp"
+#include "random.hpp"
+
+namespace mlpack {
+
+namespace internal {
+
+/**
+ * In-place unnormalized fast Walsh-Hadamard transform of a length-n block,
+ * where n must be a power of two.  The butterfly inner loop is contiguous,
+ * so the compiler can vectorize it.
+ */
+inline void FastWalshHadamard(double* x, const size_t n)
+{
+  for (size_t h = 1; h < n; h <<= 1)
+  {
+    for (size_t i = 0; i < n; i += (h << 1))
+    {
+      for (size_t j = i; j < i + h; ++j)
+      {
+        const double a = x[j];
+        const double b = x[j + h];
+        x[j] = a + b;
+        x[j + h] = a - b;
+      }
+    }
+  }
+}
+
+} // namespace internal
+
+inline SRHTProjection::SRHTProjection(const size_t inDim,
+                                      const size_t outDim) :
+    inDim(inDim)
+{
+  // Pad the dimensionality up to a power of two for the Hadamard transform.
+  padDim = 1;
+  while (padDim < inDim)
+    padDim <<= 1;
+
+  if (outDim > padDim)
+  {
+    Log::Fatal << "SRHTProjection: output dimensionality (" << outDim
+        << ") cannot exceed the padded input dimensionality (" << padDim
+        << ")!" << std::endl;
+  }
+
+  signs.set_size(inDim);
+  for (size_t i = 0; i < inDim; ++i)
+    signs[i] = (Random() < 0.5) ? -1.0 : 1.0;
+
+  // Sample the rotated coordinates to keep, without replacement.
+  indices = arma::randperm(padDim, outDim);
+}
+
+inline void SRHTProjection::Project(const arma::mat& input,
+                                    arma::mat& output) const
+{
+  if (input.n_rows != inDim)
+  {
+    Log::Fatal << "SRHTProjection::Project(): input has " << input.n_rows
+        << " dimensions but the projection was built for " << inDim << "!"
+        << std::endl;
+  }
+
+  const size_t outDim = indices.n_elem;
+  output.set_size(outDim, input.n_cols);
+
+  // The overall scaling sqrt(d / k) / sqrt(d) collapses to 1 / sqrt(k).
+  const double scale = 1.0 / std::sqrt((double) outDim);
+
+  #pragma omp parallel
+  {
+    // One padded workspace per thread, reused across columns.
+    arma::vec work(padDim);
+
+    #pragma omp for schedule(static)
+    for (size_t c = 0; c < input.n_cols; ++c)
+    {
+      work.zeros();
+      for (size_t i = 0; i < inDim; ++i)
+        work[i] = signs[i] * input(i, c);
+
+      internal::FastWalshHadamard(work.memptr(), padDim);
+
+      for (size_t r = 0; r < outDim; ++r)
+        output(r, c) = scale * work[indices[r]];
+    }
+  }
+}
+
+inline CountSketchProjection::CountSketchProjection(const size_t inDim,
+                                                    const size_t outDim) :
+    outDim(outDim)
+{
+  buckets.set_size(inDim);
+  signs.set_size(inDim);
+  for (size_t i = 0; i < inDim; ++i)
+  {
+    buckets[i] = (size_t) RandInt((int) outDim);
+    signs[i] = (Random() < 0.5) ? -1.0 : 1.0;
+  }
+}
+
+inline void CountSketchProjection::Project(const arma::mat& input,
+                                           arma::mat& output) const
+{
+  const size_t inDim = buckets.n_elem;
+  if (input.n_rows != inDim)
+  {
+    Log::Fatal << "CountSketchProjection::Project(): input has "
+        << input.n_rows << " dimensions but the projection was built for "
+        << inDim << "!" << std::endl;
+  }
+
+  output.zeros(outDim, input.n_cols);
+
+  // Each column of the output is touched only by its own column of the
+  // input, so the scatter-add is race-free when parallelized over columns.
+  #pragma omp parallel for schedule(static)
+  for (size_t c = 0; c < input.n_cols; ++c)
+  {
+    const double* in = input.colptr(c);
+    double* out = output.colptr(c);
+    for (size_t i = 0; i < inDim; ++i)
+      out[buckets[i]] += signs[i] * in[i];
+  }
+}
+
+} // namespace mlpack
+
+#endif
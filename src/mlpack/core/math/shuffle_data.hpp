@@ -236,6 +236,115 @@ void ShuffleData(const MatType& inputPoints,
   }
 }
 
+/**
+ * Shuffle a dataset and associated labels (or responses) in-place.  It is
+ * expected that points and labels have the same number of columns (so, be
+ * sure that labels, if it is a vector, is a row vector).
+ *
+ * Unlike the copying overloads, this uses only a single column of temporary
+ * storage: the columns are moved along the cycles of the permutation, so the
+ * peak memory use stays at one copy of the dataset.
+ */
+template<typename MatType, typename LabelsType>
+void ShuffleData(MatType& points,
+                 LabelsType& labels,
+                 const std::enable_if_t<!arma::is_SpMat<MatType>::value>* = 0,
+                 const std::enable_if_t<!arma::is_Cube<MatType>::value>* = 0)
+{
+  // Generate ordering.
+  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
+      points.n_cols - 1, points.n_cols));
+
+  // Walk the cycles of the permutation, moving one column at a time; column
+  // i of the result is column ordering[i] of the input.
+  std::vector<bool> visited(points.n_cols, false);
+  arma::Col<typename MatType::elem_type> tmpPoint;
+  arma::Col<typename LabelsType::elem_type> tmpLabel;
+  for (size_t start = 0; start < points.n_cols; ++start)
+  {
+    if (visited[start] || ordering[start] == start)
+    {
+      visited[start] = true;
+      continue;
+    }
+
+    tmpPoint = points.col(start);
+    tmpLabel = labels.col(start);
+    size_t i = start;
+    while (true)
+    {
+      visited[i] = true;
+      const size_t src = ordering[i];
+      if (src == start)
+      {
+        points.col(i) = tmpPoint;
+        labels.col(i) = tmpLabel;
+        break;
+      }
+
+      points.col(i) = points.col(src);
+      labels.col(i) = labels.col(src);
+      i = src;
+    }
+  }
+}
+
+/**
+ * Shuffle a dataset and associated labels (or responses) and weights
+ * in-place.  It is expected that points and labels and weights have the same
+ * number of columns (so, be sure that labels, if it is a vector, is a row
+ * vector).
+ *
+ * Like the two-argument in-place overload, this uses only a single column of
+ * temporary storage instead of a full copy of the dataset.
+ */
+template<typename MatType, typename LabelsType, typename WeightsType>
+void ShuffleData(MatType& points,
+                 LabelsType& labels,
+                 WeightsType& weights,
+                 const std::enable_if_t<!arma::is_SpMat<MatType>::value>* = 0,
+                 const std::enable_if_t<!arma::is_Cube<MatType>::value>* = 0)
+{
+  // Generate ordering.
+  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
+      points.n_cols - 1, points.n_cols));
+
+  std::vector<bool> visited(points.n_cols, false);
+  arma::Col<typename MatType::elem_type> tmpPoint;
+  arma::Col<typename LabelsType::elem_type> tmpLabel;
+  arma::Col<typename WeightsType::elem_type> tmpWeight;
+  for (size_t start = 0; start < points.n_cols; ++start)
+  {
+    if (visited[start] || ordering[start] == start)
+    {
+      visited[start] = true;
+      continue;
+    }
+
+    tmpPoint = points.col(start);
+    tmpLabel = labels.col(start);
+    tmpWeight = weights.col(start);
+    size_t i = start;
+    while (true)
+    {
+      visited[i] = true;
+      const size_t src = ordering[i];
+      if (src == start)
+      {
+        points.col(i) = tmpPoint;
+        labels.col(i) = tmpLabel;
+        weights.col(i) = tmpWeight;
+        break;
+      }
+
+      points.col(i) = points.col(src);
+      labels.col(i) = labels.col(src);
+      weights.col(i) = weights.col(src);
+      i = src;
+    }
+  }
+}
+
 } // namespace mlpack
 
 #endif
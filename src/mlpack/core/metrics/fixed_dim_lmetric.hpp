@@ -0,0 +1,88 @@
+/**
+ * @file core/metrics/fixed_dim_lmetric.hpp
+ *
+ * Fixed-dimensionality L_p metric, for use when the dimensionality of the
+ * data is known at compile time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_FIXED_DIM_LMETRIC_HPP
+#define MLPACK_CORE_METRICS_FIXED_DIM_LMETRIC_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * The FixedDimLMetric class implements the same family of L_p metrics as
+ * LMetric, but with the dimensionality of the data given as a compile-time
+ * template parameter.  Because the trip count of the distance loop is a
+ * constant, the compiler can fully unroll and vectorize it, which is
+ * noticeably faster than the runtime-length loop when the dimensionality is a
+ * round number (such as the 64, 128, or 256 dimensions typical of learned
+ * embeddings).
+ *
+ * The class satisfies the same policy as LMetric and exposes the same Power
+ * and TakeRoot members, so it can be used anywhere LMetric can: as the
+ * MetricType of a tree or of a method class such as NeighborSearch.  Because
+ * method classes thread their MetricType through to the tree they build,
+ * passing a FixedDimLMetric there is all that is needed; see also the
+ * FixedDimKDTree typedef in
+ * core/tree/binary_space_tree/typedef.hpp.
+ *
+ * Evaluate() requires both vectors to have exactly Dims elements; this is
+ * checked with a debug assertion only, to keep the fast path free of
+ * branches.
+ *
+ * @tparam Dims Dimensionality of the vectors that will be evaluated.
+ * @tparam Power Power of metric; i.e. Power = 1 gives the L1-norm (Manhattan
+ *    distance).
+ * @tparam TakeRoot If true, the Power'th root of the result is taken before
+ *    it is returned.
+ */
+template<size_t Dims, int TPower = 2, bool TTakeRoot = true>
+class FixedDimLMetric
+{
+ public:
+  /**
+   * Default constructor does nothing, but is required to satisfy the Metric
+   * policy.
+   */
+  FixedDimLMetric() { }
+
+  /**
+   * Computes the distance between two points, both of which must have Dims
+   * elements.
+   *
+   * @tparam VecTypeA Type of first vector (generally arma::vec or
+   *      arma::sp_vec).
+   * @tparam VecTypeB Type of second vector.
+   * @param a First vector.
+   * @param b Second vector.
+   * @return Distance between vectors a and b.
+   */
+  template<typename VecTypeA, typename VecTypeB>
+  static typename VecTypeA::elem_type Evaluate(const VecTypeA& a,
+                                               const VecTypeB& b);
+
+  //! Serialize the metric (nothing to do).
+  template<typename Archive>
+  void serialize(Archive& /* ar */, const uint32_t /* version */) { }
+
+  //! The dimensionality of the metric.
+  static const size_t Dimensionality = Dims;
+  //! The power of the metric.
+  static const int Power = TPower;
+  //! Whether or not the root is taken.
+  static const bool TakeRoot = TTakeRoot;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "fixed_dim_lmetric_impl.hpp"
+
+#endif
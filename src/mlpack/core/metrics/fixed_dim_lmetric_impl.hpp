@@ -0,0 +1,59 @@
+/**
+ * @file core/metrics/fixed_dim_lmetric_impl.hpp
+ *
+ * Implementation of the FixedDimLMetric class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_FIXED_DIM_LMETRIC_IMPL_HPP
+#define MLPACK_CORE_METRICS_FIXED_DIM_LMETRIC_IMPL_HPP
+
+// In case it hasn't been included.
+#include "fixed_dim_lmetric.hpp"
+
+namespace mlpack {
+
+template<size_t Dims, int TPower, bool TTakeRoot>
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type FixedDimLMetric<Dims, TPower, TTakeRoot>::Evaluate(
+    const VecTypeA& a,
+    const VecTypeB& b)
+{
+  typedef typename VecTypeA::elem_type ElemType;
+
+  Log::Assert(a.n_elem == Dims && b.n_elem == Dims,
+      "FixedDimLMetric::Evaluate(): vector dimensionality does not match the "
+      "Dims template parameter");
+
+  // Because the trip count is a compile-time constant, the compiler can fully
+  // unroll and vectorize this loop; the branches on Power and TakeRoot are
+  // also resolved at compile time.
+  ElemType sum = 0;
+  for (size_t i = 0; i < Dims; ++i)
+  {
+    const ElemType d = a[i] - b[i];
+    if (TPower == 1)
+      sum += std::fabs(d);
+    else if (TPower == 2)
+      sum += d * d;
+    else
+      sum += std::pow(std::fabs(d), TPower);
+  }
+
+  if (!TTakeRoot)
+    return sum;
+
+  if (TPower == 1)
+    return sum;
+  else if (TPower == 2)
+    return std::sqrt(sum);
+  else
+    return std::pow(sum, 1.0 / TPower);
+}
+
+} // namespace mlpack
+
+#endif
@@ -15,6 +15,8 @@
 // In case it hasn't been included.
 #include "lmetric.hpp"
 
+#include "simd_kernels.hpp"
+
 namespace mlpack {
 
 // Unspecialized implementation.  This should almost never be used...
@@ -34,14 +36,16 @@ typename VecTypeA::elem_type LMetric<Power, TakeRoot>::Evaluate(
   return std::pow(sum, (1.0 / Power));
 }
 
-// L1-metric specializations; the root doesn't matter.
+// L1-metric specializations; the root doesn't matter.  These (and the
+// L2-metric specializations below) go through the runtime-dispatched SIMD
+// kernels when the vector types allow it; see simd_kernels.hpp.
 template<>
 template<typename VecTypeA, typename VecTypeB>
 typename VecTypeA::elem_type LMetric<1, true>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return arma::accu(abs(a - b));
+  return internal::AbsSum(a, b);
 }
 
 template<>
@@ -50,7 +54,7 @@ typename VecTypeA::elem_type LMetric<1, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return arma::accu(abs(a - b));
+  return internal::AbsSum(a, b);
 }
 
 // L2-metric specializations.
@@ -60,7 +64,7 @@ typename VecTypeA::elem_type LMetric<2, true>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return arma::norm(a - b, 2);
+  return std::sqrt(internal::SquaredL2(a, b));
 }
 
 template<>
@@ -69,7 +73,7 @@ typename VecTypeA::elem_type LMetric<2, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return accu(arma::square(a - b));
+  return internal::SquaredL2(a, b);
 }
 
 // L3-metric specialization (not very likely to be used, but just in case).
@@ -0,0 +1,75 @@
+/**
+ * @file core/metrics/pairwise_distances.hpp
+ * @author Ryan Curtin
+ *
+ * Batched computation of all pairwise distances between two sets of points.
+ * This gives one tuned, parallel kernel for the O(n^2) distance loops that
+ * would otherwise be hand-rolled in each method.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_PAIRWISE_DISTANCES_HPP
+#define MLPACK_CORE_METRICS_PAIRWISE_DISTANCES_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "lmetric.hpp"
+
+namespace mlpack {
+
+/**
+ * Compute the distances between every column of a and every column of b, so
+ * that distances(i, j) holds the distance between a.col(i) and b.col(j).  The
+ * columns of b are processed in blocks of blockSize columns, dispatched
+ * across OpenMP threads; each thread writes only its own output columns.
+ *
+ * The matrix arguments may be subviews, so large problems can be tiled by the
+ * caller to bound the size of the output matrix.
+ *
+ * @param a First set of points; one point per column.
+ * @param b Second set of points; one point per column.
+ * @param metric Instantiated metric.
+ * @param distances Matrix to store the distances in; it will be set to size
+ *     a.n_cols x b.n_cols.
+ * @param blockSize Number of columns of b to process per block.
+ */
+template<typename MetricType, typename MatTypeA, typename MatTypeB,
+    typename OutMatType>
+void PairwiseDistances(const MatTypeA& a,
+                       const MatTypeB& b,
+                       MetricType& metric,
+                       OutMatType& distances,
+                       const size_t blockSize = 256);
+
+/**
+ * Overload of PairwiseDistances() for the L2 metric, which computes all the
+ * distances at once with the identity
+ * @f$ d(x, y)^2 = \|x\|^2 + \|y\|^2 - 2 x^T y @f$,
+ * so that the dominant cost is a single BLAS matrix multiplication rather
+ * than a scalar loop per pair.  The square root is taken only when the metric
+ * takes it.
+ *
+ * @param a First set of points; one point per column.
+ * @param b Second set of points; one point per column.
+ * @param metric Instantiated metric (stateless; selects this overload).
+ * @param distances Matrix to store the distances in; it will be set to size
+ *     a.n_cols x b.n_cols.
+ * @param blockSize Unused; the BLAS-backed computation is not blocked.
+ */
+template<bool TakeRoot, typename MatTypeA, typename MatTypeB,
+    typename OutMatType>
+void PairwiseDistances(const MatTypeA& a,
+                       const MatTypeB& b,
+                       LMetric<2, TakeRoot>& metric,
+                       OutMatType& distances,
+                       const size_t blockSize = 256);
+
+} // namespace mlpack
+
+// Include implementation.
+#include "pairwise_distances_impl.hpp"
+
+#endif
@@ -0,0 +1,68 @@
+/**
+ * @file core/metrics/pairwise_distances_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of batched pairwise distance computation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_PAIRWISE_DISTANCES_IMPL_HPP
+#define MLPACK_CORE_METRICS_PAIRWISE_DISTANCES_IMPL_HPP
+
+// In case it hasn't been included.
+#include "pairwise_distances.hpp"
+
+namespace mlpack {
+
+template<typename MetricType, typename MatTypeA, typename MatTypeB,
+    typename OutMatType>
+void PairwiseDistances(const MatTypeA& a,
+                       const MatTypeB& b,
+                       MetricType& metric,
+                       OutMatType& distances,
+                       const size_t blockSize)
+{
+  distances.set_size(a.n_cols, b.n_cols);
+
+  // Each thread writes only the output columns of its own blocks.
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < b.n_cols; block += blockSize)
+  {
+    const size_t lastCol = std::min(block + blockSize, (size_t) b.n_cols) - 1;
+    for (size_t j = block; j <= lastCol; ++j)
+      for (size_t i = 0; i < a.n_cols; ++i)
+        distances(i, j) = metric.Evaluate(a.col(i), b.col(j));
+  }
+}
+
+template<bool TakeRoot, typename MatTypeA, typename MatTypeB,
+    typename OutMatType>
+void PairwiseDistances(const MatTypeA& a,
+                       const MatTypeB& b,
+                       LMetric<2, TakeRoot>& /* metric */,
+                       OutMatType& distances,
+                       const size_t /* blockSize */)
+{
+  typedef typename OutMatType::elem_type ElemType;
+
+  // ||x - y||^2 = ||x||^2 + ||y||^2 - 2 x^T y; the inner products are one
+  // matrix multiplication, which BLAS parallelizes internally.
+  distances = (-2.0) * arma::trans(a) * b;
+  distances.each_col() += arma::trans(arma::sum(arma::square(a), 0));
+  distances.each_row() += arma::sum(arma::square(b), 0);
+
+  // Floating point cancellation can leave tiny negative values where the
+  // distance is (close to) zero.
+  distances.transform([](ElemType value)
+      { return std::max(value, (ElemType) 0); });
+
+  if (TakeRoot)
+    distances = arma::sqrt(distances);
+}
+
+} // namespace mlpack
+
+#endif
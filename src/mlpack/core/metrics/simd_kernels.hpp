@@ -0,0 +1,162 @@
+/**
+ * @file core/metrics/simd_kernels.hpp
+ * @author Ryan Curtin
+ *
+ * Raw-array distance kernels with runtime ISA dispatch.  These are the inner
+ * loops of the L1 and L2 metrics, written over plain pointers so that the
+ * compiler can vectorize them, and marked with MLPACK_TARGET_CLONES so that
+ * the best vectorization for the running CPU is selected at load time (see
+ * core/util/arch_dispatch.hpp).
+ *
+ * The LMetric specializations route through the dispatch helpers below, which
+ * use sparse dot products when both arguments are sparse vectors, and fall
+ * back to the usual Armadillo expressions whenever the argument types do not
+ * have dense contiguous memory (subviews, expressions) or a non-floating-point
+ * element type.  Kernels built on these metrics, such as
+ * GaussianKernel::Evaluate(), pick up the dispatched versions automatically.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_SIMD_KERNELS_HPP
+#define MLPACK_CORE_METRICS_SIMD_KERNELS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/arch_dispatch.hpp>
+
+namespace mlpack {
+namespace internal {
+
+/**
+ * Whether the raw-pointer kernels can be used for these vector types: both
+ * must be dense Armadillo vectors (whose memory is always contiguous) with
+ * the same floating-point element type.
+ */
+template<typename VecTypeA, typename VecTypeB>
+struct HasSIMDKernel
+{
+  static const bool value =
+      (arma::is_Col<VecTypeA>::value || arma::is_Row<VecTypeA>::value) &&
+      (arma::is_Col<VecTypeB>::value || arma::is_Row<VecTypeB>::value) &&
+      std::is_same<typename VecTypeA::elem_type,
+                   typename VecTypeB::elem_type>::value &&
+      std::is_floating_point<typename VecTypeA::elem_type>::value;
+};
+
+//! Sum of squared differences over raw arrays (the squared L2 distance).
+MLPACK_TARGET_CLONES
+inline double SquaredL2Raw(const double* a, const double* b, const size_t n)
+{
+  double sum = 0.0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    const double d = a[i] - b[i];
+    sum += d * d;
+  }
+  return sum;
+}
+
+MLPACK_TARGET_CLONES
+inline float SquaredL2Raw(const float* a, const float* b, const size_t n)
+{
+  float sum = 0.0f;
+  for (size_t i = 0; i < n; ++i)
+  {
+    const float d = a[i] - b[i];
+    sum += d * d;
+  }
+  return sum;
+}
+
+//! Sum of absolute differences over raw arrays (the L1 distance).
+MLPACK_TARGET_CLONES
+inline double AbsSumRaw(const double* a, const double* b, const size_t n)
+{
+  double sum = 0.0;
+  for (size_t i = 0; i < n; ++i)
+    sum += std::fabs(a[i] - b[i]);
+  return sum;
+}
+
+MLPACK_TARGET_CLONES
+inline float AbsSumRaw(const float* a, const float* b, const size_t n)
+{
+  float sum = 0.0f;
+  for (size_t i = 0; i < n; ++i)
+    sum += std::fabs(a[i] - b[i]);
+  return sum;
+}
+
+/**
+ * Whether both vector types are sparse, so that the distance can be computed
+ * with sparse dot products over the nonzero entries only.
+ */
+template<typename VecTypeA, typename VecTypeB>
+struct IsSparseVectorPair
+{
+  static const bool value =
+      arma::is_arma_sparse_type<VecTypeA>::value &&
+      arma::is_arma_sparse_type<VecTypeB>::value;
+};
+
+/**
+ * Squared L2 distance: dispatched raw kernel for dense contiguous
+ * floating-point vectors, sparse dot products for pairs of sparse vectors,
+ * Armadillo expression otherwise.
+ */
+template<typename VecTypeA, typename VecTypeB>
+inline typename std::enable_if<HasSIMDKernel<VecTypeA, VecTypeB>::value,
+    typename VecTypeA::elem_type>::type
+SquaredL2(const VecTypeA& a, const VecTypeB& b)
+{
+  return SquaredL2Raw(a.memptr(), b.memptr(), a.n_elem);
+}
+
+template<typename VecTypeA, typename VecTypeB>
+inline typename std::enable_if<IsSparseVectorPair<VecTypeA, VecTypeB>::value,
+    typename VecTypeA::elem_type>::type
+SquaredL2(const VecTypeA& a, const VecTypeB& b)
+{
+  // ||a - b||^2 = a.a + b.b - 2 a.b; the three sparse dot products visit only
+  // the nonzero entries and avoid materializing the difference vector.  Clamp
+  // against small negative results caused by cancellation.
+  const typename VecTypeA::elem_type d =
+      arma::dot(a, a) + arma::dot(b, b) - 2 * arma::dot(a, b);
+  return std::max(d, (typename VecTypeA::elem_type) 0);
+}
+
+template<typename VecTypeA, typename VecTypeB>
+inline typename std::enable_if<!HasSIMDKernel<VecTypeA, VecTypeB>::value &&
+    !IsSparseVectorPair<VecTypeA, VecTypeB>::value,
+    typename VecTypeA::elem_type>::type
+SquaredL2(const VecTypeA& a, const VecTypeB& b)
+{
+  return arma::accu(arma::square(a - b));
+}
+
+/**
+ * L1 distance: dispatched raw kernel for dense contiguous floating-point
+ * vectors, Armadillo expression otherwise.
+ */
+template<typename VecTypeA, typename VecTypeB>
+inline typename std::enable_if<HasSIMDKernel<VecTypeA, VecTypeB>::value,
+    typename VecTypeA::elem_type>::type
+AbsSum(const VecTypeA& a, const VecTypeB& b)
+{
+  return AbsSumRaw(a.memptr(), b.memptr(), a.n_elem);
+}
+
+template<typename VecTypeA, typename VecTypeB>
+inline typename std::enable_if<!HasSIMDKernel<VecTypeA, VecTypeB>::value,
+    typename VecTypeA::elem_type>::type
+AbsSum(const VecTypeA& a, const VecTypeB& b)
+{
+  return arma::accu(arma::abs(a - b));
+}
+
+} // namespace internal
+} // namespace mlpack
+
+#endif
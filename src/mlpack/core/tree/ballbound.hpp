@@ -20,29 +20,31 @@ namespace mlpack {
 
 /**
  * Ball bound encloses a set of points at a specific distance (radius) from a
- * specific point (center). MetricType is the custom metric type that defaults
+ * specific point (center). TMetricType is the custom metric type that defaults
  * to the Euclidean (L2) distance.
  *
- * @tparam MetricType metric type used in the distance measure.
- * @tparam VecType Type of vector (arma::vec or arma::sp_vec or similar).
+ * @tparam TMetricType metric type used in the distance measure.
+ * @tparam TElemType Type of element (float or double or similar).
+ * @tparam TVecType Type of vector (arma::vec or arma::sp_vec or similar).
  */
-template<typename MetricType = LMetric<2, true>,
-         typename VecType = arma::vec>
+template<typename TMetricType = LMetric<2, true>,
+         typename TElemType = double,
+         typename TVecType = arma::Col<TElemType>>
 class BallBound
 {
  public:
   //! The underlying data type.
-  typedef typename VecType::elem_type ElemType;
+  typedef TElemType ElemType;
   //! A public version of the vector type.
-  typedef VecType Vec;
+  typedef TVecType Vec;
 
  private:
   //! The radius of the ball bound.
   ElemType radius;
   //! The center of the ball bound.
-  VecType center;
+  TVecType center;
   //! The metric used in this bound.
-  MetricType* metric;
+  TMetricType* metric;
 
   /**
    * To know whether this object allocated memory to the metric member
@@ -69,7 +71,7 @@ class BallBound
    * @param radius Radius of ball bound.
    * @param center Center of ball bound.
    */
-  BallBound(const ElemType radius, const VecType& center);
+  BallBound(const ElemType radius, const TVecType& center);
 
   //! Copy constructor. To prevent memory leaks.
   BallBound(const BallBound& other);
@@ -92,9 +94,9 @@ class BallBound
   ElemType& Radius() { return radius; }
 
   //! Get the center point of the ball.
-  const VecType& Center() const { return center; }
+  const TVecType& Center() const { return center; }
   //! Modify the center point of the ball.
-  VecType& Center() { return center; }
+  TVecType& Center() { return center; }
 
   //! Get the dimensionality of the ball.
   size_t Dim() const { return center.n_elem; }
@@ -113,14 +115,14 @@ class BallBound
    *
    * @param point Point to check the condition.
    */
-  bool Contains(const VecType& point) const;
+  bool Contains(const TVecType& point) const;
 
   /**
    * Place the center of BallBound into the given vector.
    *
    * @param center Vector which the centroid will be written to.
    */
-  void Center(VecType& center) const { center = this->center; }
+  void Center(TVecType& center) const { center = this->center; }
 
   /**
    * Calculates minimum bound-to-point squared distance.
@@ -199,9 +201,9 @@ class BallBound
   ElemType Diameter() const { return 2 * radius; }
 
   //! Returns the distance metric used in this bound.
-  const MetricType& Metric() const { return *metric; }
+  const TMetricType& Metric() const { return *metric; }
   //! Modify the distance metric used in this bound.
-  MetricType& Metric() { return *metric; }
+  TMetricType& Metric() { return *metric; }
 
   //! Serialize the bound.
   template<typename Archive>
@@ -209,8 +211,8 @@ class BallBound
 };
 
 //! A specialization of BoundTraits for this bound type.
-template<typename MetricType, typename VecType>
-struct BoundTraits<BallBound<MetricType, VecType>>
+template<typename TMetricType, typename TElemType, typename TVecType>
+struct BoundTraits<BallBound<TMetricType, TElemType, TVecType>>
 {
   //! These bounds are potentially loose in some dimensions.
   const static bool HasTightBounds = false;
@@ -21,10 +21,10 @@
 namespace mlpack {
 
 //! Empty Constructor.
-template<typename MetricType, typename VecType>
-BallBound<MetricType, VecType>::BallBound() :
+template<typename TMetricType, typename TElemType, typename TVecType>
+BallBound<TMetricType, TElemType, TVecType>::BallBound() :
     radius(std::numeric_limits<ElemType>::lowest()),
-    metric(new MetricType()),
+    metric(new TMetricType()),
     ownsMetric(true)
 { /* Nothing to do. */ }
 
@@ -33,11 +33,11 @@ BallBound<MetricType, VecType>::BallBound() :
  *
  * @param dimension Dimensionality of ball bound.
  */
-template<typename MetricType, typename VecType>
-BallBound<MetricType, VecType>::BallBound(const size_t dimension) :
+template<typename TMetricType, typename TElemType, typename TVecType>
+BallBound<TMetricType, TElemType, TVecType>::BallBound(const size_t dimension) :
     radius(std::numeric_limits<ElemType>::lowest()),
     center(dimension),
-    metric(new MetricType()),
+    metric(new TMetricType()),
     ownsMetric(true)
 { /* Nothing to do. */ }
 
@@ -47,18 +47,18 @@ BallBound<MetricType, VecType>::BallBound(const size_t dimension) :
  * @param radius Radius of ball bound.
  * @param center Center of ball bound.
  */
-template<typename MetricType, typename VecType>
-BallBound<MetricType, VecType>::BallBound(const ElemType radius,
-                                           const VecType& center) :
+template<typename TMetricType, typename TElemType, typename TVecType>
+BallBound<TMetricType, TElemType, TVecType>::BallBound(const ElemType radius,
+                                           const TVecType& center) :
     radius(radius),
     center(center),
-    metric(new MetricType()),
+    metric(new TMetricType()),
     ownsMetric(true)
 { /* Nothing to do. */ }
 
 //! Copy Constructor. To prevent memory leaks.
-template<typename MetricType, typename VecType>
-BallBound<MetricType, VecType>::BallBound(const BallBound& other) :
+template<typename TMetricType, typename TElemType, typename TVecType>
+BallBound<TMetricType, TElemType, TVecType>::BallBound(const BallBound& other) :
     radius(other.radius),
     center(other.center),
     metric(other.metric),
@@ -66,8 +66,8 @@ BallBound<MetricType, VecType>::BallBound(const BallBound& other) :
 { /* Nothing to do. */ }
 
 //! For the same reason as the copy constructor: to prevent memory leaks.
-template<typename MetricType, typename VecType>
-BallBound<MetricType, VecType>& BallBound<MetricType, VecType>::operator=(
+template<typename TMetricType, typename TElemType, typename TVecType>
+BallBound<TMetricType, TElemType, TVecType>& BallBound<TMetricType, TElemType, TVecType>::operator=(
     const BallBound& other)
 {
   if (this != &other)
@@ -81,8 +81,8 @@ BallBound<MetricType, VecType>& BallBound<MetricType, VecType>::operator=(
 }
 
 //! Move constructor.
-template<typename MetricType, typename VecType>
-BallBound<MetricType, VecType>::BallBound(BallBound&& other) :
+template<typename TMetricType, typename TElemType, typename TVecType>
+BallBound<TMetricType, TElemType, TVecType>::BallBound(BallBound&& other) :
     radius(other.radius),
     center(other.center),
     metric(other.metric),
@@ -90,14 +90,14 @@ BallBound<MetricType, VecType>::BallBound(BallBound&& other) :
 {
   // Fix the other bound.
   other.radius = 0.0;
-  other.center = VecType();
+  other.center = TVecType();
   other.metric = NULL;
   other.ownsMetric = false;
 }
 
 //! Move assignment operator.
-template<typename MetricType, typename VecType>
-BallBound<MetricType, VecType>& BallBound<MetricType, VecType>::operator=(
+template<typename TMetricType, typename TElemType, typename TVecType>
+BallBound<TMetricType, TElemType, TVecType>& BallBound<TMetricType, TElemType, TVecType>::operator=(
     BallBound&& other)
 {
   if (this != &other)
@@ -108,7 +108,7 @@ BallBound<MetricType, VecType>& BallBound<MetricType, VecType>::operator=(
     ownsMetric = other.ownsMetric;
 
     other.radius = 0.0;
-    other.center = VecType();
+    other.center = TVecType();
     other.metric = nullptr;
     other.ownsMetric = false;
   }
@@ -116,17 +116,17 @@ BallBound<MetricType, VecType>& BallBound<MetricType, VecType>::operator=(
 }
 
 //! Destructor to release allocated memory.
-template<typename MetricType, typename VecType>
-BallBound<MetricType, VecType>::~BallBound()
+template<typename TMetricType, typename TElemType, typename TVecType>
+BallBound<TMetricType, TElemType, TVecType>::~BallBound()
 {
   if (ownsMetric)
     delete metric;
 }
 
 //! Get the range in a certain dimension.
-template<typename MetricType, typename VecType>
-RangeType<typename BallBound<MetricType, VecType>::ElemType>
-BallBound<MetricType, VecType>::operator[](const size_t i) const
+template<typename TMetricType, typename TElemType, typename TVecType>
+RangeType<typename BallBound<TMetricType, TElemType, TVecType>::ElemType>
+BallBound<TMetricType, TElemType, TVecType>::operator[](const size_t i) const
 {
   if (radius < 0)
     return Range();
@@ -137,8 +137,8 @@ BallBound<MetricType, VecType>::operator[](const size_t i) const
 /**
  * Determines if a point is within the bound.
  */
-template<typename MetricType, typename VecType>
-bool BallBound<MetricType, VecType>::Contains(const VecType& point) const
+template<typename TMetricType, typename TElemType, typename TVecType>
+bool BallBound<TMetricType, TElemType, TVecType>::Contains(const TVecType& point) const
 {
   if (radius < 0)
     return false;
@@ -149,10 +149,10 @@ bool BallBound<MetricType, VecType>::Contains(const VecType& point) const
 /**
  * Calculates minimum bound-to-point squared distance.
  */
-template<typename MetricType, typename VecType>
+template<typename TMetricType, typename TElemType, typename TVecType>
 template<typename OtherVecType>
-typename BallBound<MetricType, VecType>::ElemType
-BallBound<MetricType, VecType>::MinDistance(
+typename BallBound<TMetricType, TElemType, TVecType>::ElemType
+BallBound<TMetricType, TElemType, TVecType>::MinDistance(
     const OtherVecType& point,
     typename std::enable_if_t<IsVector<OtherVecType>::value>* /* junk */) const
 {
@@ -165,9 +165,9 @@ BallBound<MetricType, VecType>::MinDistance(
 /**
  * Calculates minimum bound-to-bound squared distance.
  */
-template<typename MetricType, typename VecType>
-typename BallBound<MetricType, VecType>::ElemType
-BallBound<MetricType, VecType>::MinDistance(const BallBound& other)
+template<typename TMetricType, typename TElemType, typename TVecType>
+typename BallBound<TMetricType, TElemType, TVecType>::ElemType
+BallBound<TMetricType, TElemType, TVecType>::MinDistance(const BallBound& other)
     const
 {
   if (radius < 0)
@@ -183,10 +183,10 @@ BallBound<MetricType, VecType>::MinDistance(const BallBound& other)
 /**
  * Computes maximum distance.
  */
-template<typename MetricType, typename VecType>
+template<typename TMetricType, typename TElemType, typename TVecType>
 template<typename OtherVecType>
-typename BallBound<MetricType, VecType>::ElemType
-BallBound<MetricType, VecType>::MaxDistance(
+typename BallBound<TMetricType, TElemType, TVecType>::ElemType
+BallBound<TMetricType, TElemType, TVecType>::MaxDistance(
     const OtherVecType& point,
     typename std::enable_if_t<IsVector<OtherVecType>::value>* /* junk */) const
 {
@@ -199,9 +199,9 @@ BallBound<MetricType, VecType>::MaxDistance(
 /**
  * Computes maximum distance.
  */
-template<typename MetricType, typename VecType>
-typename BallBound<MetricType, VecType>::ElemType
-BallBound<MetricType, VecType>::MaxDistance(const BallBound& other)
+template<typename TMetricType, typename TElemType, typename TVecType>
+typename BallBound<TMetricType, TElemType, TVecType>::ElemType
+BallBound<TMetricType, TElemType, TVecType>::MaxDistance(const BallBound& other)
     const
 {
   if (radius < 0)
@@ -215,10 +215,10 @@ BallBound<MetricType, VecType>::MaxDistance(const BallBound& other)
  *
  * Example: bound1.MinDistanceSq(other) for minimum squared distance.
  */
-template<typename MetricType, typename VecType>
+template<typename TMetricType, typename TElemType, typename TVecType>
 template<typename OtherVecType>
-RangeType<typename BallBound<MetricType, VecType>::ElemType>
-BallBound<MetricType, VecType>::RangeDistance(
+RangeType<typename BallBound<TMetricType, TElemType, TVecType>::ElemType>
+BallBound<TMetricType, TElemType, TVecType>::RangeDistance(
     const OtherVecType& point,
     typename std::enable_if_t<IsVector<OtherVecType>::value>* /* junk */) const
 {
@@ -233,9 +233,9 @@ BallBound<MetricType, VecType>::RangeDistance(
   }
 }
 
-template<typename MetricType, typename VecType>
-RangeType<typename BallBound<MetricType, VecType>::ElemType>
-BallBound<MetricType, VecType>::RangeDistance(
+template<typename TMetricType, typename TElemType, typename TVecType>
+RangeType<typename BallBound<TMetricType, TElemType, TVecType>::ElemType>
+BallBound<TMetricType, TElemType, TVecType>::RangeDistance(
     const BallBound& other) const
 {
   if (radius < 0)
@@ -253,10 +253,10 @@ BallBound<MetricType, VecType>::RangeDistance(
 /**
  * Expand the bound to include the given bound.
  *
-template<typename MetricType, typename VecType>
-const BallBound<VecType>&
-BallBound<MetricType, VecType>::operator|=(
-    const BallBound<VecType>& other)
+template<typename TMetricType, typename TElemType, typename TVecType>
+const BallBound<TVecType>&
+BallBound<TMetricType, TElemType, TVecType>::operator|=(
+    const BallBound<TVecType>& other)
 {
   double dist = metric->Evaluate(center, other);
 
@@ -273,10 +273,10 @@ BallBound<MetricType, VecType>::operator|=(
  * The difference lies in the way we initialize the ball bound. The way we
  * expand the bound is same.
  */
-template<typename MetricType, typename VecType>
+template<typename TMetricType, typename TElemType, typename TVecType>
 template<typename MatType>
-const BallBound<MetricType, VecType>&
-BallBound<MetricType, VecType>::operator|=(const MatType& data)
+const BallBound<TMetricType, TElemType, TVecType>&
+BallBound<TMetricType, TElemType, TVecType>::operator|=(const MatType& data)
 {
   if (radius < 0)
   {
@@ -287,14 +287,14 @@ BallBound<MetricType, VecType>::operator|=(const MatType& data)
   // Now iteratively add points.
   for (size_t i = 0; i < data.n_cols; ++i)
   {
-    const ElemType dist = metric->Evaluate(center, (VecType) data.col(i));
+    const ElemType dist = metric->Evaluate(center, (TVecType) data.col(i));
 
     // See if the new point lies outside the bound.
     if (dist > radius)
     {
       // Move towards the new point and increase the radius just enough to
       // accommodate the new point.
-      const VecType diff = data.col(i) - center;
+      const TVecType diff = data.col(i) - center;
       center += ((dist - radius) / (2 * dist)) * diff;
       radius = 0.5 * (dist + radius);
     }
@@ -304,9 +304,9 @@ BallBound<MetricType, VecType>::operator|=(const MatType& data)
 }
 
 //! Serialize the BallBound.
-template<typename MetricType, typename VecType>
+template<typename TMetricType, typename TElemType, typename TVecType>
 template<typename Archive>
-void BallBound<MetricType, VecType>::serialize(
+void BallBound<TMetricType, TElemType, TVecType>::serialize(
     Archive& ar,
     const uint32_t /* version */)
 {
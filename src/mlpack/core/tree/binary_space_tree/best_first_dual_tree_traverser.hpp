@@ -0,0 +1,157 @@
+/**
+ * @file core/tree/binary_space_tree/best_first_dual_tree_traverser.hpp
+ *
+ * Defines the BestFirstDualTreeTraverser for the BinarySpaceTree tree type.
+ * This is a nested class of BinarySpaceTree which traverses two trees in a
+ * best-first manner: node combinations are processed in order of their score,
+ * using a bounded priority queue, so that promising combinations tighten the
+ * bounds before less promising combinations are examined.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_BEST_FIRST_DUAL_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_BEST_FIRST_DUAL_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <queue>
+
+#include "../binary_space_tree.hpp"
+#include "breadth_first_dual_tree_traverser.hpp"
+
+namespace mlpack {
+
+//! Orders queue frames so that the one with the best (smallest) score is
+//! processed first.
+template<typename TreeType, typename TraversalInfoType>
+struct BestFirstFrameCompare
+{
+  bool operator()(const QueueFrame<TreeType, TraversalInfoType>& a,
+                  const QueueFrame<TreeType, TraversalInfoType>& b) const
+  {
+    return a.score > b.score;
+  }
+};
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+class BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
+                      SplitType>::BestFirstDualTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the best-first dual-tree traverser with the given rule set.
+   */
+  BestFirstDualTreeTraverser(RuleType& rule);
+
+  typedef QueueFrame<BinarySpaceTree, typename RuleType::TraversalInfoType>
+      QueueFrameType;
+
+  /**
+   * Traverse the two trees, processing node combinations in order of their
+   * score.  Because the best combinations are processed first, the bounds
+   * held by the rules tighten quickly, and combinations that were enqueued
+   * early may be pruned by the time they are popped; this typically reduces
+   * the number of base cases on clustered data compared to the depth-first
+   * traverser.  This does not reset the number of prunes.
+   *
+   * @param queryNode The query node to be traversed.
+   * @param referenceNode The reference node to be traversed.
+   */
+  void Traverse(BinarySpaceTree& queryNode,
+                BinarySpaceTree& referenceNode);
+
+  //! Get the number of prunes.
+  size_t NumPrunes() const { return numPrunes; }
+  //! Modify the number of prunes.
+  size_t& NumPrunes() { return numPrunes; }
+
+  //! Get the number of visited combinations.
+  size_t NumVisited() const { return numVisited; }
+  //! Modify the number of visited combinations.
+  size_t& NumVisited() { return numVisited; }
+
+  //! Get the number of times a node combination was scored.
+  size_t NumScores() const { return numScores; }
+  //! Modify the number of times a node combination was scored.
+  size_t& NumScores() { return numScores; }
+
+  //! Get the number of times a base case was calculated.
+  size_t NumBaseCases() const { return numBaseCases; }
+  //! Modify the number of times a base case was calculated.
+  size_t& NumBaseCases() { return numBaseCases; }
+
+  //! Get the maximum number of frames the priority queue may hold.
+  size_t MaxQueueSize() const { return maxQueueSize; }
+  //! Modify the maximum number of frames the priority queue may hold.
+  //! Combinations generated while the queue is full are traversed
+  //! depth-first instead of being enqueued.
+  size_t& MaxQueueSize() { return maxQueueSize; }
+
+  //! Get the base case tile size.
+  size_t BaseCaseBlockSize() const { return baseCaseBlockSize; }
+  //! Modify the base case tile size.  Leaf-leaf combinations are evaluated
+  //! in square tiles of this many points on each side, so that the reference
+  //! points of a tile stay in cache while each query point of the tile is
+  //! processed; the default suits a typical L2 cache.
+  size_t& BaseCaseBlockSize() { return baseCaseBlockSize; }
+
+ private:
+  //! Evaluate all base cases between two leaves, in cache-sized tiles.
+  void BaseCases(BinarySpaceTree& queryNode, BinarySpaceTree& referenceNode);
+
+  //! Score a combination and either enqueue it or, if the queue is full,
+  //! traverse it depth-first immediately.
+  void Process(BinarySpaceTree& queryNode,
+               BinarySpaceTree& referenceNode,
+               const size_t queryDepth,
+               const typename RuleType::TraversalInfoType& traversalInfo);
+
+  //! Traverse a combination depth-first; used when the priority queue is
+  //! full.  The combination must already have been scored (and not pruned).
+  void TraverseDepthFirst(
+      BinarySpaceTree& queryNode,
+      BinarySpaceTree& referenceNode,
+      const double score,
+      const typename RuleType::TraversalInfoType& traversalInfo);
+
+  //! Reference to the rules with which the trees will be traversed.
+  RuleType& rule;
+
+  //! The number of prunes.
+  size_t numPrunes;
+
+  //! The number of node combinations that have been visited during traversal.
+  size_t numVisited;
+
+  //! The number of times a node combination was scored.
+  size_t numScores;
+
+  //! The number of times a base case was calculated.
+  size_t numBaseCases;
+
+  //! The maximum number of frames the priority queue may hold.
+  size_t maxQueueSize;
+
+  //! The tile size used when evaluating base cases between two leaves.
+  size_t baseCaseBlockSize;
+
+  //! The priority queue of node combinations, best score first.
+  std::priority_queue<QueueFrameType, std::vector<QueueFrameType>,
+      BestFirstFrameCompare<BinarySpaceTree,
+          typename RuleType::TraversalInfoType>> queue;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "best_first_dual_tree_traverser_impl.hpp"
+
+#endif // MLPACK_CORE_TREE_BINARY_SPACE_TREE_BEST_FIRST_DUAL_TREE_TRAVERSER_HPP
@@ -0,0 +1,242 @@
+/**
+ * @file core/tree/binary_space_tree/best_first_dual_tree_traverser_impl.hpp
+ *
+ * Implementation of the BestFirstDualTreeTraverser for BinarySpaceTree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_BEST_FIRST_DUAL_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_BEST_FIRST_DUAL_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "best_first_dual_tree_traverser.hpp"
+
+namespace mlpack {
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+BestFirstDualTreeTraverser<RuleType>::BestFirstDualTreeTraverser(
+    RuleType& rule) :
+    rule(rule),
+    numPrunes(0),
+    numVisited(0),
+    numScores(0),
+    numBaseCases(0),
+    maxQueueSize(16384),
+    baseCaseBlockSize(64)
+{ /* Nothing to do. */ }
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+BestFirstDualTreeTraverser<RuleType>::Traverse(
+    BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
+        queryRoot,
+    BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
+        referenceRoot)
+{
+  // Score the root combination and enqueue it.
+  Process(queryRoot, referenceRoot, 0, rule.TraversalInfo());
+
+  while (!queue.empty())
+  {
+    QueueFrameType frame = queue.top();
+    queue.pop();
+
+    BinarySpaceTree& queryNode = *frame.queryNode;
+    BinarySpaceTree& referenceNode = *frame.referenceNode;
+    ++numVisited;
+
+    // Restore the traversal information that was current when this
+    // combination was scored.
+    rule.TraversalInfo() = frame.traversalInfo;
+
+    // The bounds may have tightened since this combination was enqueued, so
+    // check whether it can be pruned before doing any work with it.
+    if (rule.Rescore(queryNode, referenceNode, frame.score) == DBL_MAX)
+    {
+      ++numPrunes;
+      continue;
+    }
+
+    // If both are leaves, we must evaluate the base cases.
+    if (queryNode.IsLeaf() && referenceNode.IsLeaf())
+    {
+      BaseCases(queryNode, referenceNode);
+      continue;
+    }
+
+    // Otherwise, score each child combination; the best ones will rise to the
+    // top of the queue.
+    const typename RuleType::TraversalInfoType ti = rule.TraversalInfo();
+    if (queryNode.IsLeaf())
+    {
+      Process(queryNode, *referenceNode.Left(), frame.queryDepth, ti);
+      Process(queryNode, *referenceNode.Right(), frame.queryDepth, ti);
+    }
+    else if (referenceNode.IsLeaf())
+    {
+      Process(*queryNode.Left(), referenceNode, frame.queryDepth + 1, ti);
+      Process(*queryNode.Right(), referenceNode, frame.queryDepth + 1, ti);
+    }
+    else
+    {
+      Process(*queryNode.Left(), *referenceNode.Left(),
+          frame.queryDepth + 1, ti);
+      Process(*queryNode.Left(), *referenceNode.Right(),
+          frame.queryDepth + 1, ti);
+      Process(*queryNode.Right(), *referenceNode.Left(),
+          frame.queryDepth + 1, ti);
+      Process(*queryNode.Right(), *referenceNode.Right(),
+          frame.queryDepth + 1, ti);
+    }
+  }
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+BestFirstDualTreeTraverser<RuleType>::Process(
+    BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
+        queryNode,
+    BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
+        referenceNode,
+    const size_t queryDepth,
+    const typename RuleType::TraversalInfoType& traversalInfo)
+{
+  rule.TraversalInfo() = traversalInfo;
+  const double score = rule.Score(queryNode, referenceNode);
+  ++numScores;
+
+  if (score == DBL_MAX)
+  {
+    ++numPrunes;
+    return;
+  }
+
+  if (queue.size() < maxQueueSize)
+  {
+    QueueFrameType frame;
+    frame.queryNode = &queryNode;
+    frame.referenceNode = &referenceNode;
+    frame.queryDepth = queryDepth;
+    frame.score = score;
+    frame.traversalInfo = rule.TraversalInfo();
+
+    queue.push(frame);
+  }
+  else
+  {
+    // The queue is full; finish this combination depth-first so that the
+    // memory used by the traversal stays bounded.
+    TraverseDepthFirst(queryNode, referenceNode, score, rule.TraversalInfo());
+  }
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+BestFirstDualTreeTraverser<RuleType>::TraverseDepthFirst(
+    BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
+        queryNode,
+    BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
+        referenceNode,
+    const double /* score */,
+    const typename RuleType::TraversalInfoType& traversalInfo)
+{
+  // The combination has already been scored and was not pruned.
+  ++numVisited;
+
+  if (queryNode.IsLeaf() && referenceNode.IsLeaf())
+  {
+    rule.TraversalInfo() = traversalInfo;
+    BaseCases(queryNode, referenceNode);
+    return;
+  }
+
+  // Score each child combination; Process() will send them back through the
+  // queue if room has opened up, and recurse here otherwise.
+  if (queryNode.IsLeaf())
+  {
+    Process(queryNode, *referenceNode.Left(), 0, traversalInfo);
+    Process(queryNode, *referenceNode.Right(), 0, traversalInfo);
+  }
+  else if (referenceNode.IsLeaf())
+  {
+    Process(*queryNode.Left(), referenceNode, 0, traversalInfo);
+    Process(*queryNode.Right(), referenceNode, 0, traversalInfo);
+  }
+  else
+  {
+    Process(*queryNode.Left(), *referenceNode.Left(), 0, traversalInfo);
+    Process(*queryNode.Left(), *referenceNode.Right(), 0, traversalInfo);
+    Process(*queryNode.Right(), *referenceNode.Left(), 0, traversalInfo);
+    Process(*queryNode.Right(), *referenceNode.Right(), 0, traversalInfo);
+  }
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+BestFirstDualTreeTraverser<RuleType>::BaseCases(
+    BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
+        queryNode,
+    BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
+        referenceNode)
+{
+  const size_t queryBegin = queryNode.Begin();
+  const size_t queryEnd = queryBegin + queryNode.Count();
+  const size_t refBegin = referenceNode.Begin();
+  const size_t refEnd = refBegin + referenceNode.Count();
+
+  // Evaluate the base cases in square tiles, so that the reference points of
+  // a tile stay in cache while each query point of the tile is processed.
+  for (size_t qBlock = queryBegin; qBlock < queryEnd;
+       qBlock += baseCaseBlockSize)
+  {
+    const size_t qBlockEnd = std::min(queryEnd, qBlock + baseCaseBlockSize);
+    for (size_t rBlock = refBegin; rBlock < refEnd;
+         rBlock += baseCaseBlockSize)
+    {
+      const size_t rBlockEnd = std::min(refEnd, rBlock + baseCaseBlockSize);
+      for (size_t query = qBlock; query < qBlockEnd; ++query)
+        for (size_t ref = rBlock; ref < rBlockEnd; ++ref)
+          rule.BaseCase(query, ref);
+    }
+  }
+
+  numBaseCases += queryNode.Count() * referenceNode.Count();
+}
+
+} // namespace mlpack
+
+#endif // MLPACK_CORE_TREE_BINARY_SPACE_TREE_BEST_FIRST_DUAL_TREE_TRAVERSER_IMPL_HPP
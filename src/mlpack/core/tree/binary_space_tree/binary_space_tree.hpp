@@ -58,7 +58,7 @@ class BinarySpaceTree
   //! The type of element held in MatType.
   typedef typename MatType::elem_type ElemType;
 
-  typedef SplitType<BoundType<MetricType>, MatType> Split;
+  typedef SplitType<BoundType<MetricType, ElemType>, MatType> Split;
 
  private:
   //! The left child node.
@@ -74,7 +74,7 @@ class BinarySpaceTree
   //! children).
   size_t count;
   //! The bound object for this node.
-  BoundType<MetricType> bound;
+  BoundType<MetricType, ElemType> bound;
   //! Any extra data contained in the node.
   StatisticType stat;
   //! The distance from the centroid of this node to the centroid of the parent.
@@ -87,6 +87,28 @@ class BinarySpaceTree
   //! The dataset.  If we are the root of the tree, we own the dataset and must
   //! delete it.
   MatType* dataset;
+  //! If Pack() has been called, this is the contiguous arena holding every
+  //! descendant node in van Emde Boas order; otherwise NULL.  Only the root
+  //! ever has a non-NULL arena.
+  BinarySpaceTree* packedNodes = nullptr;
+  //! The number of nodes held in the packedNodes arena.
+  size_t numPackedNodes = 0;
+
+  //! Magic number identifying the flat tree format written by SaveFlat()
+  //! ("BSTFLAT1" as ASCII bytes).
+  static constexpr uint64_t FlatFormatMagic = 0x3154414c46545342;
+
+  //! Tombstone flags for points removed with Delete(); only used on the root.
+  std::vector<bool> deletedPoints;
+  //! The number of points inserted since the last (re)build; root only.
+  size_t numInserted = 0;
+  //! The number of points deleted since the last (re)build; root only.
+  size_t numDeleted = 0;
+  //! When (numInserted + numDeleted) exceeds this fraction of the dataset
+  //! size, Insert()/Delete() trigger a full rebuild; root only.
+  double rebuildThreshold = 0.25;
+  //! The maximum leaf size the tree was built with, remembered for rebuilds.
+  size_t maxLeafSize = 20;
 
  public:
   //! A single-tree traverser for binary space trees; see
@@ -101,6 +123,16 @@ class BinarySpaceTree
   template<typename RuleType>
   class BreadthFirstDualTreeTraverser;
 
+  //! A best-first dual-tree traverser for binary space trees; see
+  //! best_first_dual_tree_traverser.hpp.
+  template<typename RuleType>
+  class BestFirstDualTreeTraverser;
+
+  //! A thread-parallel dual-tree traverser for binary space trees; see
+  //! parallel_dual_tree_traverser.hpp.
+  template<typename RuleType>
+  class ParallelDualTreeTraverser;
+
   /**
    * Construct this as the root node of a binary space tree using the given
    * dataset.  This will copy the input matrix; if you don't want this, consider
@@ -153,6 +185,12 @@ class BinarySpaceTree
    * this, consider using the constructor that takes a const reference to a
    * dataset.
    *
+   * If the given matrix is an alias of externally owned memory (see
+   * MakeAlias()), no copy is made: the tree is built as a view directly over
+   * that memory.  Note that building the tree rearranges the columns of the
+   * aliased memory in place; use the overload that fills oldFromNew to get an
+   * explicit record of the rearrangement.
+   *
    * @param data Dataset to create tree from.
    * @param maxLeafSize Size of each leaf in the tree.
    */
@@ -210,7 +248,7 @@ class BinarySpaceTree
   BinarySpaceTree(BinarySpaceTree* parent,
                   const size_t begin,
                   const size_t count,
-                  SplitType<BoundType<MetricType>, MatType>& splitter,
+                  SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
                   const size_t maxLeafSize = 20);
 
   /**
@@ -236,7 +274,7 @@ class BinarySpaceTree
                   const size_t begin,
                   const size_t count,
                   std::vector<size_t>& oldFromNew,
-                  SplitType<BoundType<MetricType>, MatType>& splitter,
+                  SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
                   const size_t maxLeafSize = 20);
 
   /**
@@ -266,7 +304,7 @@ class BinarySpaceTree
                   const size_t count,
                   std::vector<size_t>& oldFromNew,
                   std::vector<size_t>& newFromOld,
-                  SplitType<BoundType<MetricType>, MatType>& splitter,
+                  SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
                   const size_t maxLeafSize = 20);
 
   /**
@@ -314,10 +352,107 @@ class BinarySpaceTree
    */
   ~BinarySpaceTree();
 
+  /**
+   * Relocate every descendant node of this tree into one contiguous arena,
+   * arranged in van Emde Boas order: the top half (by height) of each subtree
+   * is laid out before its bottom subtrees, recursively.  Nodes on any
+   * root-to-leaf path thus end up clustered in memory, which significantly
+   * reduces cache misses during traversal on deep trees.
+   *
+   * This may only be called on the root of the tree; the root itself stays at
+   * its current address, so existing references to it remain valid, but any
+   * pointers to descendant nodes are invalidated.  Packing is a no-op on a
+   * leaf or on an already-packed tree.  The tree must not be modified
+   * structurally (e.g. by splitting nodes) after packing.
+   */
+  void Pack();
+
+  //! Return true if the descendants of this node have been relocated into a
+  //! contiguous arena with Pack().
+  bool IsPacked() const { return packedNodes != NULL; }
+
+  /**
+   * Save the tree to the given file in a flat, offset-based binary format.
+   * Unlike the cereal path in serialize(), which writes one record per node
+   * and reconstructs nodes one heap allocation at a time, this format stores
+   * all node fields as contiguous arrays indexed by node id, followed by the
+   * dataset as one blob.  LoadFlat() can therefore rebuild the tree with a
+   * handful of bulk reads and a single arena allocation, which is orders of
+   * magnitude faster for large trees.
+   *
+   * Node statistics are not stored; they are recomputed on load via the
+   * StatisticType(node) constructor.  This format only supports bound types
+   * with per-dimension ranges (i.e. HRectBound); it may only be called on the
+   * root of the tree.
+   *
+   * @param filename File to save the tree to.
+   */
+  void SaveFlat(const std::string& filename) const;
+
+  /**
+   * Replace the contents of this tree with the tree stored in the given file,
+   * which must have been written by SaveFlat().  The loaded nodes are placed
+   * directly into a contiguous arena (see Pack()), so the loaded tree is
+   * packed.  This may only be called on the root of a tree.
+   *
+   * @param filename File to load the tree from.
+   */
+  void LoadFlat(const std::string& filename);
+
+  /**
+   * Insert a point into the tree without rebuilding it.  The point is
+   * appended to the dataset and absorbed into the rightmost leaf, expanding
+   * the bounds (and invalidating cached parent distances, which are
+   * recomputed) along that path.  The tree stays valid and queryable at all
+   * times, but its quality degrades as points accumulate in the wrong region
+   * of the tree; once the number of inserts and deletes since the last build
+   * exceeds RebuildThreshold() times the dataset size, the tree is rebuilt
+   * from scratch.
+   *
+   * This may only be called on the root of the tree.  Note that both
+   * insertion and the amortized rebuild reorder the dataset, so any external
+   * old-from-new index mappings become invalid.
+   *
+   * @param point Point to insert.
+   * @return The column index the point was assigned in the dataset (only
+   *     valid until the next rebuild).
+   */
+  template<typename VecType>
+  size_t Insert(const VecType& point);
+
+  /**
+   * Remove the point with the given dataset column index from the tree.  The
+   * column is overwritten with a tombstone located far outside any valid
+   * bound, so the point can no longer appear in nearest-neighbor, range, or
+   * density queries; the storage is reclaimed at the next amortized rebuild
+   * (see Insert()).  Furthest-neighbor-style queries should not be run on a
+   * tree with pending tombstones.
+   *
+   * This may only be called on the root of the tree.
+   *
+   * @param index Column index of the point to delete.
+   * @return True if the point was deleted; false if it was already deleted.
+   */
+  bool Delete(const size_t index);
+
+  //! Get the fraction of modified points that triggers a rebuild.
+  double RebuildThreshold() const { return rebuildThreshold; }
+  //! Modify the fraction of modified points that triggers a rebuild.
+  double& RebuildThreshold() { return rebuildThreshold; }
+
+  /**
+   * Rebuild the tree from its current dataset, dropping any deleted points
+   * and restoring the spatial quality lost to incremental inserts.  This is
+   * called automatically by Insert() and Delete() when the rebuild threshold
+   * is crossed, but may also be called directly.  This may only be called on
+   * the root of the tree.
+   */
+  void Rebuild();
+
   //! Return the bound object for this node.
-  const BoundType<MetricType>& Bound() const { return bound; }
+  const BoundType<MetricType, ElemType>& Bound() const { return bound; }
   //! Return the bound object for this node.
-  BoundType<MetricType>& Bound() { return bound; }
+  BoundType<MetricType, ElemType>& Bound() { return bound; }
 
   //! Return the statistic object for this node.
   const StatisticType& Stat() const { return stat; }
@@ -514,7 +649,7 @@ class BinarySpaceTree
    * @param splitter Instantiated SplitType object.
    */
   void SplitNode(const size_t maxLeafSize,
-                 SplitType<BoundType<MetricType>, MatType>& splitter);
+                 SplitType<BoundType<MetricType, ElemType>, MatType>& splitter);
 
   /**
    * Splits the current node, assigning its left and right children recursively.
@@ -526,7 +661,7 @@ class BinarySpaceTree
    */
   void SplitNode(std::vector<size_t>& oldFromNew,
                  const size_t maxLeafSize,
-                 SplitType<BoundType<MetricType>, MatType>& splitter);
+                 SplitType<BoundType<MetricType, ElemType>, MatType>& splitter);
 
   /**
    * Update the bound of the current node. This method does not take into
@@ -543,7 +678,31 @@ class BinarySpaceTree
    *
    * @param boundToUpdate The bound to update.
    */
-  void UpdateBound(HollowBallBound<MetricType>& boundToUpdate);
+  void UpdateBound(HollowBallBound<MetricType, ElemType>& boundToUpdate);
+
+  /**
+   * Destroy the packed node arena, if any, running the destructors of the
+   * nodes it contains.  After this call the children of this node are gone,
+   * so left and right are reset to NULL.
+   */
+  void FreePackedNodes();
+
+  //! Return the height of the subtree rooted at the given node (1 for a
+  //! leaf).
+  static size_t SubtreeHeight(const BinarySpaceTree* node);
+
+  /**
+   * Append the nodes of the subtree rooted at node, truncated at the given
+   * height, to the order vector in van Emde Boas order (see Pack()).
+   */
+  static void VebOrder(BinarySpaceTree* node,
+                       const size_t height,
+                       std::vector<BinarySpaceTree*>& order);
+
+  //! Append the nodes exactly depth levels below node to the frontier vector.
+  static void VebFrontier(BinarySpaceTree* node,
+                          const size_t depth,
+                          std::vector<BinarySpaceTree*>& frontier);
 
  protected:
   /**
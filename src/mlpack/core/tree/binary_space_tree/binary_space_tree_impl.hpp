@@ -15,7 +15,10 @@
 #include "binary_space_tree.hpp"
 
 #include <mlpack/core/util/log.hpp>
+#include <fstream>
+#include <new>
 #include <queue>
+#include <unordered_map>
 
 namespace mlpack {
 
@@ -41,7 +44,7 @@ BinarySpaceTree(
     dataset(new MatType(data)) // Copies the dataset.
 {
   // Do the actual splitting of this node.
-  SplitType<BoundType<MetricType>, MatType> splitter;
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
   SplitNode(maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
@@ -74,7 +77,7 @@ BinarySpaceTree(
     oldFromNew[i] = i; // Fill with unharmed indices.
 
   // Now do the actual splitting.
-  SplitType<BoundType<MetricType>, MatType> splitter;
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
   SplitNode(oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
@@ -108,7 +111,7 @@ BinarySpaceTree(
     oldFromNew[i] = i; // Fill with unharmed indices.
 
   // Now do the actual splitting.
-  SplitType<BoundType<MetricType>, MatType> splitter;
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
   SplitNode(oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
@@ -138,7 +141,7 @@ BinarySpaceTree(MatType&& data, const size_t maxLeafSize) :
     dataset(new MatType(std::move(data)))
 {
   // Do the actual splitting of this node.
-  SplitType<BoundType<MetricType>, MatType> splitter;
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
   SplitNode(maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
@@ -171,7 +174,7 @@ BinarySpaceTree(
     oldFromNew[i] = i; // Fill with unharmed indices.
 
   // Now do the actual splitting.
-  SplitType<BoundType<MetricType>, MatType> splitter;
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
   SplitNode(oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
@@ -205,7 +208,7 @@ BinarySpaceTree(
     oldFromNew[i] = i; // Fill with unharmed indices.
 
   // Now do the actual splitting.
-  SplitType<BoundType<MetricType>, MatType> splitter;
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
   SplitNode(oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
@@ -228,7 +231,7 @@ BinarySpaceTree(
     BinarySpaceTree* parent,
     const size_t begin,
     const size_t count,
-    SplitType<BoundType<MetricType>, MatType>& splitter,
+    SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
     const size_t maxLeafSize) :
     left(NULL),
     right(NULL),
@@ -257,7 +260,7 @@ BinarySpaceTree(
     const size_t begin,
     const size_t count,
     std::vector<size_t>& oldFromNew,
-    SplitType<BoundType<MetricType>, MatType>& splitter,
+    SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
     const size_t maxLeafSize) :
     left(NULL),
     right(NULL),
@@ -291,7 +294,7 @@ BinarySpaceTree(
     const size_t count,
     std::vector<size_t>& oldFromNew,
     std::vector<size_t>& newFromOld,
-    SplitType<BoundType<MetricType>, MatType>& splitter,
+    SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
     const size_t maxLeafSize) :
     left(NULL),
     right(NULL),
@@ -396,6 +399,7 @@ operator=(const BinarySpaceTree& other)
     return *this;
 
   // Freeing memory that will not be used anymore.
+  FreePackedNodes();
   delete dataset;
   delete left;
   delete right;
@@ -468,6 +472,7 @@ operator=(BinarySpaceTree&& other)
     return *this;
 
   // Freeing memory that will not be used anymore.
+  FreePackedNodes();
   delete dataset;
   delete left;
   delete right;
@@ -494,6 +499,12 @@ operator=(BinarySpaceTree&& other)
   other.minimumBoundDistance = 0.0;
   other.dataset = NULL;
 
+  // Take ownership of the packed node arena, if there is one.
+  packedNodes = other.packedNodes;
+  numPackedNodes = other.numPackedNodes;
+  other.packedNodes = NULL;
+  other.numPackedNodes = 0;
+
   return *this;
 }
 
@@ -533,6 +544,12 @@ BinarySpaceTree(BinarySpaceTree&& other) :
   other.minimumBoundDistance = 0.0;
   other.dataset = NULL;
 
+  // Take ownership of the packed node arena, if there is one.
+  packedNodes = other.packedNodes;
+  numPackedNodes = other.numPackedNodes;
+  other.packedNodes = NULL;
+  other.numPackedNodes = 0;
+
   // Set new parent.
   if (left)
     left->parent = this;
@@ -575,6 +592,7 @@ template<typename MetricType,
 BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
     ~BinarySpaceTree()
 {
+  FreePackedNodes();
   delete left;
   delete right;
 
@@ -583,6 +601,523 @@ BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
     delete dataset;
 }
 
+/**
+ * Pack the descendants of this node into a contiguous arena in van Emde Boas
+ * order.  See the documentation in binary_space_tree.hpp for the layout
+ * details and invalidation rules.
+ */
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    Pack()
+{
+  // Packing is only defined on the root, and there is nothing to do for a
+  // leaf or for a tree that is already packed.
+  if (parent != NULL || left == NULL || packedNodes != NULL)
+    return;
+
+  // Gather all nodes in van Emde Boas order.  Parents always precede their
+  // children in this order, which the relocation loop below relies on.
+  std::vector<BinarySpaceTree*> order;
+  VebOrder(this, SubtreeHeight(this), order);
+
+  // The root keeps its current address so that references to it stay valid;
+  // every other node moves into the arena.
+  const size_t numNodes = order.size() - 1;
+  BinarySpaceTree* arena = static_cast<BinarySpaceTree*>(
+      ::operator new(numNodes * sizeof(BinarySpaceTree)));
+
+  // Map each node's old address to its slot in the arena.
+  std::unordered_map<const BinarySpaceTree*, BinarySpaceTree*> newLocation;
+  newLocation[this] = this;
+  for (size_t i = 1; i < order.size(); ++i)
+    newLocation[order[i]] = arena + (i - 1);
+
+  // Move each node into its slot.  The move constructor updates the parent
+  // pointers of the (not yet moved) children to point at the new location, so
+  // after this loop only the left/right pointers still refer to the old heap
+  // nodes.
+  for (size_t i = 1; i < order.size(); ++i)
+    new (arena + (i - 1)) BinarySpaceTree(std::move(*order[i]));
+
+  // Rewrite the child pointers to arena locations.
+  if (this->left)
+    this->left = newLocation.at(this->left);
+  if (this->right)
+    this->right = newLocation.at(this->right);
+  for (size_t i = 0; i < numNodes; ++i)
+  {
+    if (arena[i].left)
+      arena[i].left = newLocation.at(arena[i].left);
+    if (arena[i].right)
+      arena[i].right = newLocation.at(arena[i].right);
+  }
+
+  // The old nodes have been moved from, so deleting them does not touch any
+  // children or the dataset.
+  for (size_t i = 1; i < order.size(); ++i)
+    delete order[i];
+
+  packedNodes = arena;
+  numPackedNodes = numNodes;
+}
+
+/**
+ * Save the tree in the flat, offset-based binary format (see the
+ * documentation in binary_space_tree.hpp).
+ */
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    SaveFlat(const std::string& filename) const
+{
+  if (parent != NULL)
+    throw std::invalid_argument("BinarySpaceTree::SaveFlat(): can only be "
+        "called on the root of the tree!");
+
+  std::ofstream f(filename, std::ios::binary);
+  if (!f.is_open())
+    throw std::runtime_error("BinarySpaceTree::SaveFlat(): cannot open file '"
+        + filename + "' for writing!");
+
+  // Collect the nodes in van Emde Boas order, so that a tree rebuilt from the
+  // file gets a cache-friendly arena layout for free.
+  BinarySpaceTree* mutableThis = const_cast<BinarySpaceTree*>(this);
+  std::vector<BinarySpaceTree*> order;
+  VebOrder(mutableThis, SubtreeHeight(mutableThis), order);
+
+  std::unordered_map<const BinarySpaceTree*, uint64_t> nodeId;
+  for (size_t i = 0; i < order.size(); ++i)
+    nodeId[order[i]] = (uint64_t) i;
+
+  // Header: magic, format version, dimensionality, node count, dataset shape,
+  // and element size (so a mismatched ElemType is caught at load time).
+  const uint64_t header[7] = { FlatFormatMagic, 1, (uint64_t) bound.Dim(),
+      (uint64_t) order.size(), (uint64_t) dataset->n_rows,
+      (uint64_t) dataset->n_cols, (uint64_t) sizeof(ElemType) };
+  f.write((const char*) header, sizeof(header));
+
+  // Node fields, stored as one contiguous array per field.
+  const size_t n = order.size();
+  std::vector<uint64_t> indexField(n);
+  const uint64_t noChild = (uint64_t) -1;
+
+  for (size_t i = 0; i < n; ++i)
+    indexField[i] = (uint64_t) order[i]->begin;
+  f.write((const char*) indexField.data(), n * sizeof(uint64_t));
+  for (size_t i = 0; i < n; ++i)
+    indexField[i] = (uint64_t) order[i]->count;
+  f.write((const char*) indexField.data(), n * sizeof(uint64_t));
+  for (size_t i = 0; i < n; ++i)
+    indexField[i] = order[i]->left ? nodeId.at(order[i]->left) : noChild;
+  f.write((const char*) indexField.data(), n * sizeof(uint64_t));
+  for (size_t i = 0; i < n; ++i)
+    indexField[i] = order[i]->right ? nodeId.at(order[i]->right) : noChild;
+  f.write((const char*) indexField.data(), n * sizeof(uint64_t));
+
+  std::vector<ElemType> elemField(n);
+  for (size_t i = 0; i < n; ++i)
+    elemField[i] = order[i]->parentDistance;
+  f.write((const char*) elemField.data(), n * sizeof(ElemType));
+  for (size_t i = 0; i < n; ++i)
+    elemField[i] = order[i]->furthestDescendantDistance;
+  f.write((const char*) elemField.data(), n * sizeof(ElemType));
+  for (size_t i = 0; i < n; ++i)
+    elemField[i] = order[i]->minimumBoundDistance;
+  f.write((const char*) elemField.data(), n * sizeof(ElemType));
+
+  // Bounds, stored as all lower bounds followed by all upper bounds.
+  std::vector<ElemType> boundField(n * bound.Dim());
+  for (size_t i = 0; i < n; ++i)
+    for (size_t d = 0; d < bound.Dim(); ++d)
+      boundField[i * bound.Dim() + d] = order[i]->bound[d].Lo();
+  f.write((const char*) boundField.data(),
+      boundField.size() * sizeof(ElemType));
+  for (size_t i = 0; i < n; ++i)
+    for (size_t d = 0; d < bound.Dim(); ++d)
+      boundField[i * bound.Dim() + d] = order[i]->bound[d].Hi();
+  f.write((const char*) boundField.data(),
+      boundField.size() * sizeof(ElemType));
+
+  // Finally, the dataset as one blob.
+  f.write((const char*) dataset->memptr(),
+      dataset->n_elem * sizeof(ElemType));
+}
+
+/**
+ * Load a tree saved with SaveFlat(), placing the nodes directly into a
+ * contiguous arena.
+ */
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    LoadFlat(const std::string& filename)
+{
+  if (parent != NULL)
+    throw std::invalid_argument("BinarySpaceTree::LoadFlat(): can only be "
+        "called on the root of a tree!");
+
+  std::ifstream f(filename, std::ios::binary);
+  if (!f.is_open())
+    throw std::runtime_error("BinarySpaceTree::LoadFlat(): cannot open file '"
+        + filename + "' for reading!");
+
+  uint64_t header[7];
+  f.read((char*) header, sizeof(header));
+  if (!f || header[0] != FlatFormatMagic || header[1] != 1)
+    throw std::runtime_error("BinarySpaceTree::LoadFlat(): '" + filename +
+        "' is not a flat-format tree file!");
+  if (header[6] != sizeof(ElemType))
+    throw std::runtime_error("BinarySpaceTree::LoadFlat(): element type size "
+        "mismatch!");
+
+  const size_t dim = (size_t) header[2];
+  const size_t n = (size_t) header[3];
+  const size_t rows = (size_t) header[4];
+  const size_t cols = (size_t) header[5];
+
+  // Throw away any existing tree contents.
+  FreePackedNodes();
+  delete left;
+  delete right;
+  left = NULL;
+  right = NULL;
+  delete dataset;
+  dataset = NULL;
+
+  // Bulk-read the node fields.
+  std::vector<uint64_t> begins(n), counts(n), lefts(n), rights(n);
+  f.read((char*) begins.data(), n * sizeof(uint64_t));
+  f.read((char*) counts.data(), n * sizeof(uint64_t));
+  f.read((char*) lefts.data(), n * sizeof(uint64_t));
+  f.read((char*) rights.data(), n * sizeof(uint64_t));
+
+  std::vector<ElemType> parentDistances(n), furthestDistances(n),
+      minimumDistances(n);
+  f.read((char*) parentDistances.data(), n * sizeof(ElemType));
+  f.read((char*) furthestDistances.data(), n * sizeof(ElemType));
+  f.read((char*) minimumDistances.data(), n * sizeof(ElemType));
+
+  std::vector<ElemType> los(n * dim), his(n * dim);
+  f.read((char*) los.data(), los.size() * sizeof(ElemType));
+  f.read((char*) his.data(), his.size() * sizeof(ElemType));
+
+  dataset = new MatType(rows, cols);
+  f.read((char*) dataset->memptr(), dataset->n_elem * sizeof(ElemType));
+  if (!f)
+  {
+    delete dataset;
+    dataset = NULL;
+    throw std::runtime_error("BinarySpaceTree::LoadFlat(): '" + filename +
+        "' is truncated!");
+  }
+
+  // Node 0 is this node; all other nodes go straight into the arena, in file
+  // order (which is van Emde Boas order; see SaveFlat()).
+  BinarySpaceTree* arena = NULL;
+  if (n > 1)
+  {
+    arena = static_cast<BinarySpaceTree*>(
+        ::operator new((n - 1) * sizeof(BinarySpaceTree)));
+    for (size_t i = 0; i + 1 < n; ++i)
+      new (arena + i) BinarySpaceTree();
+  }
+
+  const uint64_t noChild = (uint64_t) -1;
+  for (size_t i = 0; i < n; ++i)
+  {
+    BinarySpaceTree* node = (i == 0) ? this : (arena + i - 1);
+
+    node->begin = (size_t) begins[i];
+    node->count = (size_t) counts[i];
+    node->parentDistance = parentDistances[i];
+    node->furthestDescendantDistance = furthestDistances[i];
+    node->minimumBoundDistance = minimumDistances[i];
+    node->dataset = dataset;
+
+    node->bound = BoundType<MetricType, ElemType>(dim);
+    for (size_t d = 0; d < dim; ++d)
+      node->bound[d] = RangeType<ElemType>(los[i * dim + d], his[i * dim + d]);
+
+    if (lefts[i] != noChild)
+    {
+      node->left = arena + lefts[i] - 1;
+      node->left->parent = node;
+    }
+    if (rights[i] != noChild)
+    {
+      node->right = arena + rights[i] - 1;
+      node->right->parent = node;
+    }
+  }
+
+  packedNodes = arena;
+  numPackedNodes = (n > 1) ? (n - 1) : 0;
+
+  // Rebuild the statistics; they are not stored in the flat format.
+  for (size_t i = 0; i < n; ++i)
+  {
+    BinarySpaceTree* node = (i == 0) ? this : (arena + i - 1);
+    node->stat = StatisticType(*node);
+  }
+}
+
+/**
+ * Insert a point into the tree without rebuilding it, absorbing it into the
+ * rightmost leaf (see the documentation in binary_space_tree.hpp).
+ */
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename VecType>
+size_t BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
+    SplitType>::Insert(const VecType& point)
+{
+  if (parent != NULL)
+    throw std::invalid_argument("BinarySpaceTree::Insert(): can only be "
+        "called on the root of the tree!");
+
+  const size_t oldSize = dataset->n_cols;
+  dataset->insert_cols(oldSize, point);
+  if (!deletedPoints.empty())
+    deletedPoints.push_back(false);
+
+  // Descend the path to the rightmost leaf (the leaf whose point range ends
+  // at the old dataset size), growing each bound and count on the way; the
+  // appended column is then contiguous with that leaf's range.
+  std::vector<BinarySpaceTree*> path;
+  BinarySpaceTree* node = this;
+  while (true)
+  {
+    node->bound |= point;
+    node->furthestDescendantDistance = 0.5 * node->bound.Diameter();
+    node->count++;
+    path.push_back(node);
+
+    if (node->IsLeaf())
+      break;
+
+    node = (node->right->begin + node->right->count == oldSize) ? node->right
+        : node->left;
+  }
+
+  // The bound centers along the path may have moved, so the cached parent
+  // distances of their children must be recomputed.
+  for (size_t i = 0; i < path.size(); ++i)
+  {
+    if (path[i]->IsLeaf())
+      continue;
+
+    arma::vec center, leftCenter, rightCenter;
+    path[i]->Center(center);
+    path[i]->left->Center(leftCenter);
+    path[i]->right->Center(rightCenter);
+    path[i]->left->parentDistance =
+        path[i]->bound.Metric().Evaluate(center, leftCenter);
+    path[i]->right->parentDistance =
+        path[i]->bound.Metric().Evaluate(center, rightCenter);
+  }
+
+  ++numInserted;
+  if ((double) (numInserted + numDeleted) >
+      rebuildThreshold * (double) dataset->n_cols)
+    Rebuild();
+
+  return oldSize;
+}
+
+/**
+ * Remove a point from the tree by overwriting it with a tombstone; the
+ * storage is reclaimed at the next rebuild.
+ */
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+bool BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    Delete(const size_t index)
+{
+  if (parent != NULL)
+    throw std::invalid_argument("BinarySpaceTree::Delete(): can only be "
+        "called on the root of the tree!");
+  if (index >= dataset->n_cols)
+    throw std::invalid_argument("BinarySpaceTree::Delete(): index out of "
+        "range!");
+
+  if (deletedPoints.size() < dataset->n_cols)
+    deletedPoints.resize(dataset->n_cols, false);
+  if (deletedPoints[index])
+    return false;
+
+  // Move the point far outside every bound in the tree, so no query can
+  // reach it: any distance to it is larger than any distance between real
+  // points.  Bounds are not shrunk; they merely over-cover, which does not
+  // affect correctness of min-distance pruning.
+  deletedPoints[index] = true;
+  dataset->col(index).fill(std::numeric_limits<ElemType>::max());
+
+  ++numDeleted;
+  if ((double) (numInserted + numDeleted) >
+      rebuildThreshold * (double) dataset->n_cols)
+    Rebuild();
+
+  return true;
+}
+
+/**
+ * Rebuild the tree from its current dataset, dropping deleted points.
+ */
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    Rebuild()
+{
+  if (parent != NULL)
+    throw std::invalid_argument("BinarySpaceTree::Rebuild(): can only be "
+        "called on the root of the tree!");
+
+  MatType newData(dataset->n_rows, dataset->n_cols - numDeleted);
+  size_t col = 0;
+  for (size_t i = 0; i < dataset->n_cols; ++i)
+  {
+    if (deletedPoints.empty() || !deletedPoints[i])
+      newData.col(col++) = dataset->col(i);
+  }
+
+  // Remember the build parameters across the move assignment.
+  const size_t leafSize = maxLeafSize;
+  const double threshold = rebuildThreshold;
+
+  *this = BinarySpaceTree(std::move(newData), leafSize);
+
+  maxLeafSize = leafSize;
+  rebuildThreshold = threshold;
+  deletedPoints.clear();
+  numInserted = 0;
+  numDeleted = 0;
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    FreePackedNodes()
+{
+  if (!packedNodes)
+    return;
+
+  // Run the destructors of the arena nodes by hand.  Their child pointers
+  // refer to other arena slots, which must not be deleted, so clear them
+  // first.
+  for (size_t i = 0; i < numPackedNodes; ++i)
+  {
+    packedNodes[i].left = NULL;
+    packedNodes[i].right = NULL;
+    packedNodes[i].~BinarySpaceTree();
+  }
+  ::operator delete(packedNodes);
+  packedNodes = NULL;
+  numPackedNodes = 0;
+
+  // Our children lived in the arena, so they are gone now too.
+  left = NULL;
+  right = NULL;
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+size_t BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
+    SplitType>::SubtreeHeight(const BinarySpaceTree* node)
+{
+  size_t height = 1;
+  if (node->left)
+    height = std::max(height, 1 + SubtreeHeight(node->left));
+  if (node->right)
+    height = std::max(height, 1 + SubtreeHeight(node->right));
+  return height;
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    VebOrder(BinarySpaceTree* node,
+             const size_t height,
+             std::vector<BinarySpaceTree*>& order)
+{
+  if (height <= 1)
+  {
+    order.push_back(node);
+    return;
+  }
+
+  // Lay out the top part of the subtree (truncated at half the height), then
+  // each subtree hanging off the bottom of the top part, recursively.
+  const size_t topHeight = height / 2;
+  const size_t bottomHeight = height - topHeight;
+
+  VebOrder(node, topHeight, order);
+
+  std::vector<BinarySpaceTree*> frontier;
+  VebFrontier(node, topHeight, frontier);
+  for (size_t i = 0; i < frontier.size(); ++i)
+    VebOrder(frontier[i], bottomHeight, order);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    VebFrontier(BinarySpaceTree* node,
+                const size_t depth,
+                std::vector<BinarySpaceTree*>& frontier)
+{
+  if (depth == 0)
+  {
+    frontier.push_back(node);
+    return;
+  }
+
+  if (node->left)
+    VebFrontier(node->left, depth - 1, frontier);
+  if (node->right)
+    VebFrontier(node->right, depth - 1, frontier);
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -865,8 +1400,11 @@ template<typename MetricType,
              class SplitType>
 void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
     SplitNode(const size_t maxLeafSize,
-              SplitType<BoundType<MetricType>, MatType>& splitter)
+              SplitType<BoundType<MetricType, ElemType>, MatType>& splitter)
 {
+  // Remember the leaf size for amortized rebuilds (see Rebuild()).
+  this->maxLeafSize = maxLeafSize;
+
   // We need to expand the bounds of this node properly.
   UpdateBound(bound);
 
@@ -932,8 +1470,11 @@ template<typename MetricType,
 void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
 SplitNode(std::vector<size_t>& oldFromNew,
           const size_t maxLeafSize,
-          SplitType<BoundType<MetricType>, MatType>& splitter)
+          SplitType<BoundType<MetricType, ElemType>, MatType>& splitter)
 {
+  // Remember the leaf size for amortized rebuilds (see Rebuild()).
+  this->maxLeafSize = maxLeafSize;
+
   // We need to expand the bounds of this node properly.
   UpdateBound(bound);
 
@@ -1012,7 +1553,7 @@ template<typename MetricType,
          template<typename SplitBoundType, typename SplitMatType>
              class SplitType>
 void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
-UpdateBound(HollowBallBound<MetricType>& boundToUpdate)
+UpdateBound(HollowBallBound<MetricType, ElemType>& boundToUpdate)
 {
   if (!parent)
   {
@@ -1069,6 +1610,7 @@ void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
   // If we're loading, and we have children, they need to be deleted.
   if (cereal::is_loading<Archive>())
   {
+    FreePackedNodes();
     if (left)
       delete left;
     if (right)
@@ -1105,6 +1647,15 @@ void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
   {
     MatType*& datasetTemp = const_cast<MatType*&>(dataset);
     ar(CEREAL_POINTER(datasetTemp));
+
+    // The incremental-modification state lives only on the root.  Without it
+    // a loaded tree would resurrect tombstoned points on the next Rebuild()
+    // and forget a non-default leaf size.
+    ar(CEREAL_NVP(deletedPoints));
+    ar(CEREAL_NVP(numInserted));
+    ar(CEREAL_NVP(numDeleted));
+    ar(CEREAL_NVP(rebuildThreshold));
+    ar(CEREAL_NVP(maxLeafSize));
   }
 
   if (cereal::is_loading<Archive>())
@@ -16,6 +16,7 @@
 #define MLPACK_CORE_TREE_BINARY_SPACE_TREE_DUAL_TREE_TRAVERSER_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/traversal_statistics.hpp>
 
 #include "binary_space_tree.hpp"
 
@@ -66,6 +67,13 @@ class BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
   //! Modify the number of times a base case was calculated.
   size_t& NumBaseCases() { return numBaseCases; }
 
+  //! Attach a statistics collector; subsequent traversals will record
+  //! per-depth counts, base case histograms, and subtree wall times into it.
+  void EnableStatistics(TraversalStatistics& statistics)
+  { stats = &statistics; }
+  //! Detach the statistics collector, if one is attached.
+  void DisableStatistics() { stats = NULL; }
+
  private:
   //! Reference to the rules with which the trees will be traversed.
   RuleType& rule;
@@ -85,6 +93,39 @@ class BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
   //! Traversal information, held in the class so that it isn't continually
   //! being reallocated.
   typename RuleType::TraversalInfoType traversalInfo;
+
+  //! The attached statistics collector, or NULL if none is attached.
+  TraversalStatistics* stats;
+
+  //! The current recursion depth (only maintained for statistics collection).
+  size_t statsDepth;
+
+  //! Count prunes, attributing them to the current depth if a statistics
+  //! collector is attached.
+  inline void RecordPrunes(const size_t count = 1)
+  {
+    numPrunes += count;
+    if (stats)
+      stats->RecordPrunes(statsDepth == 0 ? 0 : statsDepth - 1, count);
+  }
+
+  //! Count scores, attributing them to the current depth if a statistics
+  //! collector is attached.
+  inline void RecordScores(const size_t count = 1)
+  {
+    numScores += count;
+    if (stats)
+      stats->RecordScores(statsDepth == 0 ? 0 : statsDepth - 1, count);
+  }
+
+  //! Count base cases for one visited leaf combination, attributing them to
+  //! the current depth if a statistics collector is attached.
+  inline void RecordBaseCases(const size_t count)
+  {
+    numBaseCases += count;
+    if (stats)
+      stats->RecordBaseCases(statsDepth == 0 ? 0 : statsDepth - 1, count);
+  }
 };
 
 } // namespace mlpack
@@ -32,7 +32,9 @@ DualTreeTraverser<RuleType>::DualTreeTraverser(RuleType& rule) :
     numPrunes(0),
     numVisited(0),
     numScores(0),
-    numBaseCases(0)
+    numBaseCases(0),
+    stats(NULL),
+    statsDepth(0)
 { /* Nothing to do. */ }
 
 template<typename MetricType,
@@ -52,6 +54,10 @@ DualTreeTraverser<RuleType>::Traverse(
   // Increment the visit counter.
   ++numVisited;
 
+  // Track the recursion depth and subtree wall time for the statistics
+  // collector, if one is attached.
+  ScopedTraversalFrame frame(stats, statsDepth);
+
   // Store the current traversal info.
   traversalInfo = rule.TraversalInfo();
 
@@ -62,7 +68,7 @@ DualTreeTraverser<RuleType>::Traverse(
     // If root score is DBL_MAX, don't recurse.
     if (rootScore == DBL_MAX)
     {
-      ++numPrunes;
+      RecordPrunes();
       return;
     }
   }
@@ -87,7 +93,7 @@ DualTreeTraverser<RuleType>::Traverse(
       for (size_t ref = referenceNode.Begin(); ref < refEnd; ++ref)
         rule.BaseCase(query, ref);
 
-      numBaseCases += referenceNode.Count();
+      RecordBaseCases(referenceNode.Count());
     }
   }
   else if (((!queryNode.IsLeaf()) && referenceNode.IsLeaf()) ||
@@ -97,22 +103,22 @@ DualTreeTraverser<RuleType>::Traverse(
     // We have to recurse down the query node.  In this case the recursion order
     // does not matter.
     const double leftScore = rule.Score(*queryNode.Left(), referenceNode);
-    ++numScores;
+    RecordScores();
 
     if (leftScore != DBL_MAX)
       Traverse(*queryNode.Left(), referenceNode);
     else
-      ++numPrunes;
+      RecordPrunes();
 
     // Before recursing, we have to set the traversal information correctly.
     rule.TraversalInfo() = traversalInfo;
     const double rightScore = rule.Score(*queryNode.Right(), referenceNode);
-    ++numScores;
+    RecordScores();
 
     if (rightScore != DBL_MAX)
       Traverse(*queryNode.Right(), referenceNode);
     else
-      ++numPrunes;
+      RecordPrunes();
   }
   else if (queryNode.IsLeaf() && (!referenceNode.IsLeaf()))
   {
@@ -123,7 +129,7 @@ DualTreeTraverser<RuleType>::Traverse(
     typename RuleType::TraversalInfoType leftInfo = rule.TraversalInfo();
     rule.TraversalInfo() = traversalInfo;
     double rightScore = rule.Score(queryNode, *referenceNode.Right());
-    numScores += 2;
+    RecordScores(2);
 
     if (leftScore < rightScore)
     {
@@ -143,7 +149,7 @@ DualTreeTraverser<RuleType>::Traverse(
         Traverse(queryNode, *referenceNode.Right());
       }
       else
-        ++numPrunes;
+        RecordPrunes();
     }
     else if (rightScore < leftScore)
     {
@@ -160,13 +166,13 @@ DualTreeTraverser<RuleType>::Traverse(
         Traverse(queryNode, *referenceNode.Left());
       }
       else
-        ++numPrunes;
+        RecordPrunes();
     }
     else // leftScore is equal to rightScore.
     {
       if (leftScore == DBL_MAX)
       {
-        numPrunes += 2;
+        RecordPrunes(2);
       }
       else
       {
@@ -186,7 +192,7 @@ DualTreeTraverser<RuleType>::Traverse(
           Traverse(queryNode, *referenceNode.Right());
         }
         else
-          ++numPrunes;
+          RecordPrunes();
       }
     }
   }
@@ -201,7 +207,7 @@ DualTreeTraverser<RuleType>::Traverse(
     rule.TraversalInfo() = traversalInfo;
     double rightScore = rule.Score(*queryNode.Left(), *referenceNode.Right());
     typename RuleType::TraversalInfoType rightInfo;
-    numScores += 2;
+    RecordScores(2);
 
     if (leftScore < rightScore)
     {
@@ -222,7 +228,7 @@ DualTreeTraverser<RuleType>::Traverse(
         Traverse(*queryNode.Left(), *referenceNode.Right());
       }
       else
-        ++numPrunes;
+        RecordPrunes();
     }
     else if (rightScore < leftScore)
     {
@@ -240,13 +246,13 @@ DualTreeTraverser<RuleType>::Traverse(
         Traverse(*queryNode.Left(), *referenceNode.Left());
       }
       else
-        ++numPrunes;
+        RecordPrunes();
     }
     else
     {
       if (leftScore == DBL_MAX)
       {
-        numPrunes += 2;
+        RecordPrunes(2);
       }
       else
       {
@@ -267,7 +273,7 @@ DualTreeTraverser<RuleType>::Traverse(
           Traverse(*queryNode.Left(), *referenceNode.Right());
         }
         else
-          ++numPrunes;
+          RecordPrunes();
       }
     }
 
@@ -279,7 +285,7 @@ DualTreeTraverser<RuleType>::Traverse(
     leftInfo = rule.TraversalInfo();
     rule.TraversalInfo() = traversalInfo;
     rightScore = rule.Score(*queryNode.Right(), *referenceNode.Right());
-    numScores += 2;
+    RecordScores(2);
 
     if (leftScore < rightScore)
     {
@@ -300,7 +306,7 @@ DualTreeTraverser<RuleType>::Traverse(
         Traverse(*queryNode.Right(), *referenceNode.Right());
       }
       else
-        ++numPrunes;
+        RecordPrunes();
     }
     else if (rightScore < leftScore)
     {
@@ -318,13 +324,13 @@ DualTreeTraverser<RuleType>::Traverse(
         Traverse(*queryNode.Right(), *referenceNode.Left());
       }
       else
-        ++numPrunes;
+        RecordPrunes();
     }
     else
     {
       if (leftScore == DBL_MAX)
       {
-        numPrunes += 2;
+        RecordPrunes(2);
       }
       else
       {
@@ -345,7 +351,7 @@ DualTreeTraverser<RuleType>::Traverse(
           Traverse(*queryNode.Right(), *referenceNode.Right());
         }
         else
-          ++numPrunes;
+          RecordPrunes();
       }
     }
   }
@@ -17,6 +17,45 @@
 
 namespace mlpack {
 
+namespace internal {
+
+//! Compute the mean of the given dimension over the columns
+//! [begin, begin + count) of the dataset (dense version).
+template<typename MatType>
+double ColumnRangeMean(const MatType& data,
+                       const size_t dim,
+                       const size_t begin,
+                       const size_t count,
+                       const std::false_type& /* isSparse */)
+{
+  double mean = 0.0;
+  for (size_t i = begin; i < begin + count; ++i)
+    mean += data(dim, i);
+  return mean / count;
+}
+
+//! Sparse version: iterate over the nonzero entries of the column range
+//! instead of performing a binary search into each column.
+template<typename MatType>
+double ColumnRangeMean(const MatType& data,
+                       const size_t dim,
+                       const size_t begin,
+                       const size_t count,
+                       const std::true_type& /* isSparse */)
+{
+  double sum = 0.0;
+  typename MatType::const_iterator it = data.begin_col(begin);
+  typename MatType::const_iterator end = data.end_col(begin + count - 1);
+  for ( ; it != end; ++it)
+  {
+    if (it.row() == dim)
+      sum += (*it);
+  }
+  return sum / count;
+}
+
+} // namespace internal
+
 template<typename BoundType, typename MatType>
 bool MeanSplit<BoundType, MatType>::SplitNode(const BoundType& bound,
                                               MatType& data,
@@ -78,10 +117,10 @@ bool MeanSplit<BoundType, MatType>::SplitNode(const BoundType& bound,
     return false;
 
   // Split in the mean of that dimension.
-  splitInfo.splitVal = 0.0;
-  for (size_t i = begin; i < begin + count; ++i)
-    splitInfo.splitVal += data(splitInfo.splitDimension, i);
-  splitInfo.splitVal /= count;
+  splitInfo.splitVal = internal::ColumnRangeMean(data,
+      splitInfo.splitDimension, begin, count,
+      std::integral_constant<bool,
+          arma::is_arma_sparse_type<MatType>::value>());
 
   Log::Assert(splitInfo.splitVal >= bound[splitInfo.splitDimension].Lo());
   Log::Assert(splitInfo.splitVal <= bound[splitInfo.splitDimension].Hi());
@@ -0,0 +1,194 @@
+/**
+ * @file core/tree/binary_space_tree/parallel_dual_tree_traverser_impl.hpp
+ *
+ * Implementation of the ParallelDualTreeTraverser for BinarySpaceTree.  The
+ * query tree is expanded into a frontier of independent subtrees, which are
+ * distributed across threads with dynamic (work-stealing style) scheduling;
+ * each thread runs the regular depth-first traversal on its own copy of the
+ * rule set, and the copies are merged when all tasks have completed.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "parallel_dual_tree_traverser.hpp"
+
+#include <queue>
+
+namespace mlpack {
+
+namespace internal {
+
+//! If the rule type caches bounds in the tree statistics behind lazy
+//! generation stamps (i.e. it provides CheckStat(), like
+//! NeighborSearchRules), restamp the given node now.  Restamping may write to
+//! the statistic, so it must happen before any parallel tasks that share the
+//! node start running.
+template<typename RuleType, typename TreeType>
+inline auto RestampStatistic(RuleType& rule, TreeType& node, int)
+    -> decltype(rule.CheckStat(node), void())
+{
+  rule.CheckStat(node);
+}
+
+//! No-op version, for rule types without lazy generation stamps.
+template<typename RuleType, typename TreeType>
+inline void RestampStatistic(RuleType& /* rule */,
+                             TreeType& /* node */,
+                             long)
+{ }
+
+} // namespace internal
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+ParallelDualTreeTraverser<RuleType>::ParallelDualTreeTraverser(RuleType& rule) :
+    rule(rule),
+    numPrunes(0),
+    numVisited(0),
+    numScores(0),
+    numBaseCases(0)
+{ /* Nothing to do. */ }
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+ParallelDualTreeTraverser<RuleType>::Traverse(
+    BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
+        queryNode,
+    BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
+        referenceNode)
+{
+  size_t numThreads = 1;
+  #ifdef MLPACK_USE_OPENMP
+    numThreads = (size_t) omp_get_max_threads();
+  #endif
+
+  // With a single thread there is nothing to parallelize; fall back to the
+  // regular depth-first traversal.
+  if (numThreads == 1)
+  {
+    typename BinarySpaceTree::template DualTreeTraverser<RuleType>
+        traverser(rule);
+    traverser.Traverse(queryNode, referenceNode);
+
+    numPrunes += traverser.NumPrunes();
+    numVisited += traverser.NumVisited();
+    numScores += traverser.NumScores();
+    numBaseCases += traverser.NumBaseCases();
+    return;
+  }
+
+  // Score the root combination first, exactly as the sequential traversal
+  // does, so that the traversal information seen by every task corresponds to
+  // a valid ancestor combination.
+  if (queryNode.Parent() == NULL && referenceNode.Parent() == NULL)
+  {
+    ++numVisited;
+    if (rule.Score(queryNode, referenceNode) == DBL_MAX)
+    {
+      ++numPrunes;
+      return;
+    }
+  }
+  const typename RuleType::TraversalInfoType rootInfo = rule.TraversalInfo();
+
+  // Expand the query tree breadth-first into a frontier of disjoint subtrees.
+  // We oversubscribe the thread count so that dynamic scheduling can balance
+  // tasks of unequal cost (this is where the work stealing happens).
+  const size_t targetTasks = 8 * numThreads;
+  std::queue<BinarySpaceTree*> frontier;
+  frontier.push(&queryNode);
+  std::vector<BinarySpaceTree*> tasks;
+  while (!frontier.empty())
+  {
+    BinarySpaceTree* node = frontier.front();
+    frontier.pop();
+    if (node->IsLeaf() || (frontier.size() + tasks.size() + 1) >= targetTasks)
+    {
+      tasks.push_back(node);
+    }
+    else
+    {
+      frontier.push(node->Left());
+      frontier.push(node->Right());
+    }
+  }
+
+  // Each thread traverses with its own copy of the rules so that candidate
+  // sets and traversal information are never shared between threads.  The
+  // copies are cheap relative to the traversal itself.
+  std::vector<RuleType> threadRules(numThreads, rule);
+  std::vector<size_t> threadPrunes(numThreads, 0);
+  std::vector<size_t> threadVisited(numThreads, 0);
+  std::vector<size_t> threadScores(numThreads, 0);
+  std::vector<size_t> threadBaseCases(numThreads, 0);
+
+  // The tasks' subtrees are disjoint, but rule types that cache bounds in the
+  // tree statistics (e.g. NeighborSearchRules) lazily reset stale statistics
+  // from inside the traversal, and the bound calculation for a task root also
+  // touches its parent's statistic.  Those ancestors are shared between
+  // tasks, so restamp the whole ancestor spine up front: afterwards no thread
+  // ever writes to a statistic outside its own subtree.  The spine holds at
+  // most O(targetTasks) nodes, so this is negligible.
+  for (size_t i = 0; i < tasks.size(); ++i)
+  {
+    BinarySpaceTree* ancestor = tasks[i]->Parent();
+    while (ancestor != NULL)
+    {
+      internal::RestampStatistic(rule, *ancestor, 0);
+      ancestor = ancestor->Parent();
+    }
+  }
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < tasks.size(); ++i)
+  {
+    size_t threadId = 0;
+    #ifdef MLPACK_USE_OPENMP
+      threadId = (size_t) omp_get_thread_num();
+    #endif
+
+    RuleType& threadRule = threadRules[threadId];
+    threadRule.TraversalInfo() = rootInfo;
+
+    typename BinarySpaceTree::template DualTreeTraverser<RuleType>
+        traverser(threadRule);
+    traverser.Traverse(*tasks[i], referenceNode);
+
+    threadPrunes[threadId] += traverser.NumPrunes();
+    threadVisited[threadId] += traverser.NumVisited();
+    threadScores[threadId] += traverser.NumScores();
+    threadBaseCases[threadId] += traverser.NumBaseCases();
+  }
+
+  // Merge per-thread results and statistics back into the shared rule set.
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    rule.Merge(threadRules[t]);
+    numPrunes += threadPrunes[t];
+    numVisited += threadVisited[t];
+    numScores += threadScores[t];
+    numBaseCases += threadBaseCases[t];
+  }
+}
+
+} // namespace mlpack
+
+#endif // MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
@@ -16,6 +16,8 @@
 // In case it hasn't been included yet.
 #include "../binary_space_tree.hpp"
 
+#include <mlpack/core/metrics/fixed_dim_lmetric.hpp>
+
 namespace mlpack {
 
 /**
@@ -61,6 +63,30 @@ using KDTree = BinarySpaceTree<MetricType,
                                HRectBound,
                                MidpointSplit>;
 
+/**
+ * A kd-tree with the dimensionality of the data fixed at compile time.  This
+ * is the same as the KDTree, but it uses FixedDimLMetric instead of a
+ * user-given metric, so the distance loops have a compile-time trip count and
+ * can be fully unrolled and vectorized.  Useful when the dimensionality is
+ * known ahead of time, as with learned embeddings of 64, 128, or 256
+ * dimensions.  Constructing the tree on data of any other dimensionality is
+ * an error.
+ *
+ * Because the first template parameter is the dimensionality rather than a
+ * metric, this typedef does not satisfy the TreeType policy API; to use a
+ * fixed dimensionality with a method class such as NeighborSearch, pass
+ * FixedDimLMetric as the method's MetricType instead (the method threads its
+ * metric through to the KDTree it builds).
+ *
+ * @see @ref trees, BinarySpaceTree, KDTree, FixedDimLMetric
+ */
+template<size_t Dims, typename StatisticType, typename MatType>
+using FixedDimKDTree = BinarySpaceTree<FixedDimLMetric<Dims, 2, true>,
+                                       StatisticType,
+                                       MatType,
+                                       HRectBound,
+                                       MidpointSplit>;
+
 /**
  * A mean-split kd-tree.  This is the same as the KDTree, but this particular
  * implementation will use the mean of the data in the split dimension as the
@@ -0,0 +1,254 @@
+/**
+ * @file core/tree/composite_rules.hpp
+ *
+ * A rule-fusion adapter that runs two traversal rule sets in a single
+ * dual-tree traversal.  Composites can be nested, so any number of rule sets
+ * can share one pass over the trees.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_COMPOSITE_RULES_HPP
+#define MLPACK_CORE_TREE_COMPOSITE_RULES_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * The CompositeRules class wraps two rule sets so that both are evaluated
+ * during a single dual-tree traversal, instead of traversing the trees once
+ * per rule set.  Every Score() and BaseCase() call is forwarded to both
+ * rules; a node combination is only pruned (DBL_MAX) when both rules prune
+ * it, and once a rule prunes a combination it is excluded from the whole
+ * subtree below that combination, so it never sees work it already accounted
+ * for (this matters for rules like KDERules, which add an estimate for the
+ * entire node when they prune).
+ *
+ * Composites nest: CompositeRules<RuleTypeA, CompositeRules<RuleTypeB,
+ * RuleTypeC, TreeType>, TreeType> runs three rule sets in one pass.
+ *
+ * The per-rule prune state is carried in the composite's TraversalInfoType,
+ * so this class must be used with a dual-tree traverser that saves and
+ * restores TraversalInfo() around each recursion branch (every dual-tree
+ * traverser in mlpack does).  It is not suitable for single-tree traversals.
+ * Rescore() conservatively never re-prunes, since the individual rules' old
+ * scores cannot be recovered from the combined score.
+ *
+ * @tparam RuleTypeA First rule set type.
+ * @tparam RuleTypeB Second rule set type.
+ * @tparam TreeType Type of tree being traversed.
+ */
+template<typename RuleTypeA, typename RuleTypeB, typename TreeType>
+class CompositeRules
+{
+ public:
+  /**
+   * Construct the composite around two instantiated rule sets.  The rule
+   * objects must outlive the composite; results are collected from each rule
+   * object afterwards, exactly as if it had been used on its own.
+   *
+   * @param ruleA First rule set.
+   * @param ruleB Second rule set.
+   */
+  CompositeRules(RuleTypeA& ruleA, RuleTypeB& ruleB) :
+      ruleA(ruleA),
+      ruleB(ruleB),
+      lastScoredQuery(size_t() - 1),
+      pointActiveA(true),
+      pointActiveB(true)
+  {
+    traversalInfo.aInfo = ruleA.TraversalInfo();
+    traversalInfo.bInfo = ruleB.TraversalInfo();
+  }
+
+  //! Compute the base case with every rule that has not pruned this
+  //! combination.
+  double BaseCase(const size_t queryIndex, const size_t referenceIndex)
+  {
+    double result = 0.0;
+
+    if (ActiveForPointA(queryIndex))
+    {
+      ruleA.TraversalInfo() = traversalInfo.aInfo;
+      result = ruleA.BaseCase(queryIndex, referenceIndex);
+      traversalInfo.aInfo = ruleA.TraversalInfo();
+    }
+
+    if (ActiveForPointB(queryIndex))
+    {
+      ruleB.TraversalInfo() = traversalInfo.bInfo;
+      result = ruleB.BaseCase(queryIndex, referenceIndex);
+      traversalInfo.bInfo = ruleB.TraversalInfo();
+    }
+
+    return result;
+  }
+
+  /**
+   * Score a query point against a reference node with every rule that has
+   * not pruned an ancestor combination.  The composite score is the minimum
+   * of the individual scores; a rule that prunes here is excluded from the
+   * base cases that follow for this query point.
+   *
+   * @param queryIndex Index of query point.
+   * @param referenceNode Candidate node to be recursed into.
+   */
+  double Score(const size_t queryIndex, TreeType& referenceNode)
+  {
+    double score = DBL_MAX;
+    lastScoredQuery = queryIndex;
+    pointActiveA = false;
+    pointActiveB = false;
+
+    if (traversalInfo.activeA)
+    {
+      ruleA.TraversalInfo() = traversalInfo.aInfo;
+      const double scoreA = ruleA.Score(queryIndex, referenceNode);
+      traversalInfo.aInfo = ruleA.TraversalInfo();
+      if (scoreA != DBL_MAX)
+      {
+        pointActiveA = true;
+        score = std::min(score, scoreA);
+      }
+    }
+
+    if (traversalInfo.activeB)
+    {
+      ruleB.TraversalInfo() = traversalInfo.bInfo;
+      const double scoreB = ruleB.Score(queryIndex, referenceNode);
+      traversalInfo.bInfo = ruleB.TraversalInfo();
+      if (scoreB != DBL_MAX)
+      {
+        pointActiveB = true;
+        score = std::min(score, scoreB);
+      }
+    }
+
+    return score;
+  }
+
+  //! Re-evaluate the score of a query point and reference node combination.
+  //! The individual rules' old scores cannot be recovered from the combined
+  //! score, so this conservatively never re-prunes.
+  double Rescore(const size_t /* queryIndex */,
+                 TreeType& /* referenceNode */,
+                 const double oldScore) const
+  {
+    return oldScore;
+  }
+
+  /**
+   * Score a node combination with every rule that has not pruned an ancestor
+   * combination.  The composite score is the minimum of the individual
+   * scores; a rule that prunes here is excluded from the entire subtree below
+   * this combination.
+   *
+   * @param queryNode Candidate query node to recurse into.
+   * @param referenceNode Candidate reference node to recurse into.
+   */
+  double Score(TreeType& queryNode, TreeType& referenceNode)
+  {
+    double score = DBL_MAX;
+
+    if (traversalInfo.activeA)
+    {
+      ruleA.TraversalInfo() = traversalInfo.aInfo;
+      const double scoreA = ruleA.Score(queryNode, referenceNode);
+      traversalInfo.aInfo = ruleA.TraversalInfo();
+      if (scoreA == DBL_MAX)
+        traversalInfo.activeA = false;
+      else
+        score = std::min(score, scoreA);
+    }
+
+    if (traversalInfo.activeB)
+    {
+      ruleB.TraversalInfo() = traversalInfo.bInfo;
+      const double scoreB = ruleB.Score(queryNode, referenceNode);
+      traversalInfo.bInfo = ruleB.TraversalInfo();
+      if (scoreB == DBL_MAX)
+        traversalInfo.activeB = false;
+      else
+        score = std::min(score, scoreB);
+    }
+
+    return score;
+  }
+
+  //! Re-evaluate the score of a node combination.  The individual rules' old
+  //! scores cannot be recovered from the combined score, so this
+  //! conservatively never re-prunes.
+  double Rescore(TreeType& /* queryNode */,
+                 TreeType& /* referenceNode */,
+                 const double oldScore) const
+  {
+    return oldScore;
+  }
+
+  /**
+   * Traversal information for the composite.  In addition to the wrapped
+   * rules' traversal information, this carries whether each rule is still
+   * active; because the traverser saves and restores this object around each
+   * recursion branch, a prune made by one rule is scoped to exactly the
+   * subtree below the pruned combination.
+   */
+  struct TraversalInfoType
+  {
+    //! Traversal information of the first rule.
+    typename RuleTypeA::TraversalInfoType aInfo;
+    //! Traversal information of the second rule.
+    typename RuleTypeB::TraversalInfoType bInfo;
+    //! Whether the first rule is still active in this subtree.
+    bool activeA = true;
+    //! Whether the second rule is still active in this subtree.
+    bool activeB = true;
+  };
+
+  //! Get the traversal information.
+  const TraversalInfoType& TraversalInfo() const { return traversalInfo; }
+  //! Modify the traversal information.
+  TraversalInfoType& TraversalInfo() { return traversalInfo; }
+
+  //! Get the minimum number of base cases needed for acceptable results.
+  size_t MinimumBaseCases() const
+  {
+    return std::max(ruleA.MinimumBaseCases(), ruleB.MinimumBaseCases());
+  }
+
+ private:
+  //! Whether the first rule should see base cases for the given query point.
+  bool ActiveForPointA(const size_t queryIndex) const
+  {
+    return (queryIndex == lastScoredQuery) ? pointActiveA :
+        traversalInfo.activeA;
+  }
+
+  //! Whether the second rule should see base cases for the given query point.
+  bool ActiveForPointB(const size_t queryIndex) const
+  {
+    return (queryIndex == lastScoredQuery) ? pointActiveB :
+        traversalInfo.activeB;
+  }
+
+  //! The first rule set.
+  RuleTypeA& ruleA;
+  //! The second rule set.
+  RuleTypeB& ruleB;
+
+  //! Traversal information (including per-subtree prune state).
+  TraversalInfoType traversalInfo;
+
+  //! The query point most recently scored against a reference node.
+  size_t lastScoredQuery;
+  //! Whether the first rule declined to prune that query point.
+  bool pointActiveA;
+  //! Whether the second rule declined to prune that query point.
+  bool pointActiveB;
+};
+
+} // namespace mlpack
+
+#endif
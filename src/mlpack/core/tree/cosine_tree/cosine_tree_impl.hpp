@@ -24,17 +24,14 @@ inline CosineTree::CosineTree(const arma::mat& dataset) :
     numColumns(dataset.n_cols),
     localDataset(false)
 {
-  // Initialize sizes of column indices and l2 norms.
+  // Initialize sizes of column indices.
   indices.resize(numColumns);
-  l2NormsSquared.zeros(numColumns);
-
-  // Set indices and calculate squared norms of the columns.
   for (size_t i = 0; i < numColumns; ++i)
-  {
     indices[i] = i;
-    double l2Norm = arma::norm(dataset.col(i), 2);
-    l2NormsSquared(i) = l2Norm * l2Norm;
-  }
+
+  // Calculate squared norms of all columns in one vectorized pass over the
+  // matrix, instead of one norm computation per column.
+  l2NormsSquared = arma::sum(arma::square(dataset), 0).t();
 
   // Frobenius norm of columns in the node.
   frobNormSquared = arma::accu(l2NormsSquared);
@@ -138,9 +135,13 @@ inline CosineTree::CosineTree(const arma::mat& dataset,
     currentLeft->BasisVector(lBasisVector);
     currentRight->BasisVector(rBasisVector);
 
-    // Calculate Monte Carlo error estimates for child nodes.
-    MonteCarloError(currentLeft, treeQueue, &lBasisVector, &rBasisVector);
-    MonteCarloError(currentRight, treeQueue, &lBasisVector, &rBasisVector);
+    // Calculate Monte Carlo error estimates for the child nodes on the
+    // frontier in parallel; each estimate only reads the shared basis and
+    // writes the error of its own node.
+    CosineTree* children[2] = { currentLeft, currentRight };
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < 2; ++i)
+      MonteCarloError(children[i], treeQueue, &lBasisVector, &rBasisVector);
 
     // Push child nodes into the priority queue.
     treeQueue.push_back(currentLeft);
@@ -433,6 +434,9 @@ inline double CosineTree::MonteCarloError(CosineTree* node,
     projectionSize = treeQueue.size();
 
   // For each sample, calculate the weighted projection onto the current basis.
+  // The samples are independent and each iteration writes only its own
+  // element of the magnitude vector, so they can be computed in parallel.
+  #pragma omp parallel for schedule(dynamic)
   for (size_t i = 0; i < numSamples; ++i)
   {
     // Initialize projection as a vector of zeros.
@@ -635,19 +639,34 @@ inline void CosineTree::CalculateCosines(arma::vec& cosines)
   // Initialize cosine vector as a vector of zeros.
   cosines.zeros(numColumns);
 
-  for (size_t i = 0; i < numColumns; ++i)
+  // The norms of the columns are already available in 'l2NormsSquared', so
+  // only one dot product per column is needed; the columns are processed in
+  // blocks dispatched across threads.
+  const arma::vec splitPoint = dataset->col(indices[splitPointIndex]);
+  const double splitNorm = std::sqrt(l2NormsSquared(splitPointIndex));
+  if (splitNorm == 0)
+    return;
+
+  const size_t blockSize = 256;
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < numColumns; block += blockSize)
   {
-    // If norm is zero, store cosine value as zero. Else, calculate cosine value
-    // between two vectors.
-    if (l2NormsSquared(i) == 0)
-    {
-      cosines(i) = 0;
-    }
-    else
+    const size_t lastCol = std::min(block + blockSize, numColumns) - 1;
+
+    for (size_t i = block; i <= lastCol; ++i)
     {
-      cosines(i) =
-          std::abs(arma::norm_dot(dataset->col(indices[splitPointIndex]),
-                                  dataset->col(indices[i])));
+      // If norm is zero, store cosine value as zero. Else, calculate cosine
+      // value between two vectors.
+      if (l2NormsSquared(i) == 0)
+      {
+        cosines(i) = 0;
+      }
+      else
+      {
+        cosines(i) = std::abs(arma::dot(splitPoint,
+            dataset->col(indices[i]))) /
+            (splitNorm * std::sqrt(l2NormsSquared(i)));
+      }
     }
   }
 }
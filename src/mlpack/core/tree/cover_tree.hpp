@@ -21,5 +21,6 @@
 #include "cover_tree/dual_tree_traverser_impl.hpp"
 #include "cover_tree/traits.hpp"
 #include "cover_tree/typedef.hpp"
+#include "cover_tree/cover_tree_arena.hpp"
 
 #endif
@@ -475,6 +475,10 @@ class CoverTree
    * first pointSetSize points in indices are calculated (so, this does not
    * necessarily need to use all of the points in the arrays).
    *
+   * Point sets of at least minParallelDistanceComps points are computed in
+   * parallel with OpenMP; see the implementation for the thread-safety
+   * requirement on MetricType.
+   *
    * @param pointIndex Point to build the distances for.
    * @param indices List of indices to compute distances for.
    * @param distances Vector to store calculated distances in.
@@ -560,6 +564,11 @@ class CoverTree
   //! Friend access is given for the default constructor.
   friend class cereal::access;
 
+  //! Friend access is given to the arena, which constructs packed copies of
+  //! nodes directly (see cover_tree_arena.hpp).
+  template<typename M, typename S, typename Mt, typename R>
+  friend class CoverTreeArena;
+
  public:
   /**
    * Serialize the tree.
@@ -572,6 +581,10 @@ class CoverTree
 
  private:
   size_t distanceComps;
+
+  //! Smallest point set for which ComputeDistances() uses multiple threads;
+  //! below this, the OpenMP dispatch overhead outweighs the parallelism.
+  static constexpr size_t minParallelDistanceComps = 10000;
 };
 
 } // namespace mlpack
@@ -0,0 +1,174 @@
+/**
+ * @file core/tree/cover_tree/cover_tree_arena.hpp
+ *
+ * Defines the CoverTreeArena class, which repacks a built cover tree into
+ * contiguous memory slabs for faster traversal and near-constant-time
+ * teardown.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_COVER_TREE_COVER_TREE_ARENA_HPP
+#define MLPACK_CORE_TREE_COVER_TREE_COVER_TREE_ARENA_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "cover_tree.hpp"
+#include "first_point_is_root.hpp"
+
+namespace mlpack {
+
+/**
+ * The CoverTreeArena class holds a copy of a built cover tree in which every
+ * node lives in one of a small number of contiguous memory slabs, rather than
+ * in its own heap allocation.  The nodes are laid out in breadth-first order,
+ * so the children of any node are adjacent in memory (up to slab boundaries)
+ * and sibling iteration during traversal is sequential.  Because no node owns any other node, the
+ * whole tree is torn down with a single linear sweep over the slabs instead
+ * of a recursive walk with one free() per node; for large trees this reduces
+ * destruction from minutes to a fraction of a second.
+ *
+ * The usual pattern is to build the tree normally, pack it, and then discard
+ * the original:
+ *
+ * @code
+ * StandardCoverTree<> tree(dataset); // Expensive recursive build.
+ * CoverTreeArena<> arena(tree);      // Pack into contiguous slabs.
+ * // tree may now be destructed; arena.Root() is an equivalent tree.
+ * @endcode
+ *
+ * The packed tree references the same dataset as the source tree, so the
+ * dataset must outlive the arena.  The packed nodes are read-only copies in
+ * the sense that inserting or deleting points through them is not supported;
+ * they are intended for traversal.
+ *
+ * The template parameters must match those of the cover tree being packed.
+ *
+ * @tparam MetricType Metric type of the packed cover tree.
+ * @tparam StatisticType Statistic type of the packed cover tree.
+ * @tparam MatType Matrix type of the packed cover tree.
+ * @tparam RootPointPolicy Root point policy of the packed cover tree.
+ */
+template<typename MetricType = LMetric<2, true>,
+         typename StatisticType = EmptyStatistic,
+         typename MatType = arma::mat,
+         typename RootPointPolicy = FirstPointIsRoot>
+class CoverTreeArena
+{
+ public:
+  //! The type of tree held by the arena.
+  typedef CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>
+      TreeType;
+
+  /**
+   * Pack the given cover tree into the arena.  The source tree is not
+   * modified and may be destructed afterwards, but its dataset must outlive
+   * the arena.
+   *
+   * @param tree Tree to pack.
+   * @param slabSize Number of nodes held by each memory slab.
+   */
+  CoverTreeArena(const TreeType& tree, const size_t slabSize = 4096) :
+      slabSize(slabSize),
+      numNodes(0),
+      metric(tree.Metric())
+  {
+    // Copy the root, then copy each level breadth-first so that the children
+    // of every node are contiguous in memory.
+    TreeType* root = CopyNode(tree, NULL);
+
+    std::queue<std::pair<const TreeType*, TreeType*>> queue;
+    queue.push(std::make_pair(&tree, root));
+    while (!queue.empty())
+    {
+      const TreeType* src = queue.front().first;
+      TreeType* dest = queue.front().second;
+      queue.pop();
+
+      // Allocating all of the children of a node before descending further is
+      // what makes sibling iteration sequential in memory.
+      dest->children.reserve(src->NumChildren());
+      for (size_t i = 0; i < src->NumChildren(); ++i)
+      {
+        dest->children.push_back(CopyNode(src->Child(i), dest));
+        queue.push(std::make_pair(&src->Child(i), dest->children[i]));
+      }
+    }
+  }
+
+  //! The arena cannot be copied or moved; nodes hold pointers into it.
+  CoverTreeArena(const CoverTreeArena&) = delete;
+  CoverTreeArena& operator=(const CoverTreeArena&) = delete;
+
+  /**
+   * Tear down the packed tree with a linear sweep over the slabs.  No node
+   * owns any other node (or the dataset or the metric), so no recursion and
+   * no per-node heap free is needed.
+   */
+  ~CoverTreeArena()
+  {
+    size_t remaining = numNodes;
+    for (size_t s = 0; s < slabs.size(); ++s)
+    {
+      const size_t inSlab = std::min(remaining, slabSize);
+      for (size_t i = 0; i < inSlab; ++i)
+      {
+        // Clear the child list first so that the destructor does not try to
+        // delete the children; the sweep destructs them itself.
+        slabs[s][i].children.clear();
+        slabs[s][i].~TreeType();
+      }
+      remaining -= inSlab;
+
+      ::operator delete(slabs[s]);
+    }
+  }
+
+  //! Get the root of the packed tree.
+  const TreeType& Root() const { return *slabs[0]; }
+  //! Modify the root of the packed tree.
+  TreeType& Root() { return *slabs[0]; }
+
+  //! Get the number of nodes held by the arena.
+  size_t NumNodes() const { return numNodes; }
+
+ private:
+  //! Get uninitialized storage for one more node.
+  TreeType* Allocate()
+  {
+    if (numNodes == slabs.size() * slabSize)
+      slabs.push_back((TreeType*) ::operator new(slabSize * sizeof(TreeType)));
+
+    TreeType* node = &slabs[numNodes / slabSize][numNodes % slabSize];
+    ++numNodes;
+    return node;
+  }
+
+  //! Copy a single node (not its children) into the arena.
+  TreeType* CopyNode(const TreeType& src, TreeType* parent)
+  {
+    TreeType* node = Allocate();
+    new (node) TreeType(src.Dataset(), src.Base(), src.Point(), src.Scale(),
+        parent, src.ParentDistance(), src.FurthestDescendantDistance(),
+        &metric);
+    node->stat = src.stat;
+    node->numDescendants = src.numDescendants;
+    return node;
+  }
+
+  //! Number of nodes held by each slab.
+  const size_t slabSize;
+  //! The memory slabs; all but the last are full.
+  std::vector<TreeType*> slabs;
+  //! Number of nodes constructed in the slabs.
+  size_t numNodes;
+  //! The metric the packed nodes refer to (so that the packed tree does not
+  //! depend on the source tree's metric staying alive).
+  MetricType metric;
+};
+
+} // namespace mlpack
+
+#endif // MLPACK_CORE_TREE_COVER_TREE_COVER_TREE_ARENA_HPP
@@ -1393,10 +1393,29 @@ void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
   // For each point, rebuild the distances.  The indices do not need to be
   // modified.
   distanceComps += pointSetSize;
-  for (size_t i = 0; i < pointSetSize; ++i)
+
+  // These scans dominate construction time, and each element is independent:
+  // every thread writes its own disjoint slice of the distances vector, so no
+  // synchronization is needed.  Small scans (deep in the tree) are left serial
+  // to avoid the dispatch overhead.  Note that this requires
+  // MetricType::Evaluate() to be thread-safe, which holds for all stateless
+  // metrics and for metrics that do not modify their state in Evaluate().
+  if (pointSetSize >= minParallelDistanceComps)
+  {
+    #pragma omp parallel for
+    for (size_t i = 0; i < pointSetSize; ++i)
+    {
+      distances[i] = metric->Evaluate(dataset->col(pointIndex),
+          dataset->col(indices[i]));
+    }
+  }
+  else
   {
-    distances[i] = metric->Evaluate(dataset->col(pointIndex),
-        dataset->col(indices[i]));
+    for (size_t i = 0; i < pointSetSize; ++i)
+    {
+      distances[i] = metric->Evaluate(dataset->col(pointIndex),
+          dataset->col(indices[i]));
+    }
   }
 }
 
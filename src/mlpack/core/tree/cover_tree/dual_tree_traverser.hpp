@@ -13,6 +13,7 @@
 #define MLPACK_CORE_TREE_COVER_TREE_DUAL_TREE_TRAVERSER_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/traversal_statistics.hpp>
 #include <queue>
 
 namespace mlpack {
@@ -52,6 +53,14 @@ class CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
   size_t NumScores() const { return 0; }
   size_t NumBaseCases() const { return 0; }
 
+  //! Attach a statistics collector; subsequent traversals will record
+  //! per-depth counts, base case histograms, and subtree wall times into it.
+  //! Depths refer to levels of the query recursion.
+  void EnableStatistics(TraversalStatistics& statistics)
+  { stats = &statistics; }
+  //! Detach the statistics collector, if one is attached.
+  void DisableStatistics() { stats = NULL; }
+
  private:
   //! The instantiated rule set for pruning branches.
   RuleType& rule;
@@ -59,6 +68,38 @@ class CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
   //! The number of pruned nodes.
   size_t numPrunes;
 
+  //! The attached statistics collector, or NULL if none is attached.
+  TraversalStatistics* stats;
+
+  //! The current query recursion depth (only maintained for statistics
+  //! collection).
+  size_t statsDepth;
+
+  //! Count prunes, attributing them to the current depth if a statistics
+  //! collector is attached.
+  inline void RecordPrunes(const size_t count = 1)
+  {
+    numPrunes += count;
+    if (stats)
+      stats->RecordPrunes(statsDepth == 0 ? 0 : statsDepth - 1, count);
+  }
+
+  //! Record scores at the current depth if a statistics collector is
+  //! attached.
+  inline void RecordScores(const size_t count = 1)
+  {
+    if (stats)
+      stats->RecordScores(statsDepth == 0 ? 0 : statsDepth - 1, count);
+  }
+
+  //! Record a single base case at the current depth if a statistics collector
+  //! is attached.
+  inline void RecordBaseCase()
+  {
+    if (stats)
+      stats->RecordBaseCases(statsDepth == 0 ? 0 : statsDepth - 1, 1);
+  }
+
   //! Struct used for traversal.
   struct DualCoverTreeMapEntry
   {
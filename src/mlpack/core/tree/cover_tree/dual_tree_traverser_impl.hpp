@@ -27,7 +27,9 @@ template<typename RuleType>
 CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
 DualTreeTraverser<RuleType>::DualTreeTraverser(RuleType& rule) :
     rule(rule),
-    numPrunes(0)
+    numPrunes(0),
+    stats(NULL),
+    statsDepth(0)
 { /* Nothing to do. */ }
 
 template<
@@ -50,8 +52,10 @@ DualTreeTraverser<RuleType>::Traverse(CoverTree& queryNode,
 
   // Perform the evaluation between the roots of either tree.
   rootRefEntry.score = rule.Score(queryNode, referenceNode);
+  RecordScores();
   rootRefEntry.baseCase = rule.BaseCase(queryNode.Point(),
       referenceNode.Point());
+  RecordBaseCase();
   rootRefEntry.traversalInfo = rule.TraversalInfo();
 
   refMap[referenceNode.Scale()].push_back(rootRefEntry);
@@ -75,6 +79,10 @@ DualTreeTraverser<RuleType>::Traverse(
   if (referenceMap.size() == 0)
     return; // Nothing to do!
 
+  // Track the query recursion depth and subtree wall time for the statistics
+  // collector, if one is attached.
+  ScopedTraversalFrame frame(stats, statsDepth);
+
   // First recurse down the reference nodes as necessary.
   ReferenceRecursion(queryNode, referenceMap);
 
@@ -129,7 +137,7 @@ DualTreeTraverser<RuleType>::Traverse(
     if ((refNode->Point() == refNode->Parent()->Point()) &&
         (queryNode.Point() == queryNode.Parent()->Point()))
     {
-      ++numPrunes;
+      RecordPrunes();
       continue;
     }
 
@@ -137,15 +145,17 @@ DualTreeTraverser<RuleType>::Traverse(
     // info.
     rule.TraversalInfo() = frame.traversalInfo;
     double score = rule.Score(queryNode, *refNode);
+    RecordScores();
 
     if (score == DBL_MAX)
     {
-      ++numPrunes;
+      RecordPrunes();
       continue;
     }
 
     // If not, compute the base case.
     rule.BaseCase(queryNode.Point(), pointVector[i].referenceNode->Point());
+    RecordBaseCase();
   }
 }
 
@@ -190,17 +200,19 @@ DualTreeTraverser<RuleType>::PruneMap(
       // Perform the actual scoring, after restoring the traversal info.
       rule.TraversalInfo() = frame.traversalInfo;
       double score = rule.Score(queryNode, *refNode);
+      RecordScores();
 
       if (score == DBL_MAX)
       {
         // Pruned.  Move on.
-        ++numPrunes;
+        RecordPrunes();
         continue;
       }
 
       // If it isn't pruned, we must evaluate the base case.
       const double baseCase = rule.BaseCase(queryNode.Point(),
           refNode->Point());
+      RecordBaseCase();
 
       // Add to child map.
       newScaleVector.push_back(frame);
@@ -243,17 +255,19 @@ DualTreeTraverser<RuleType>::PruneMap(
       // Perform the actual scoring, after restoring the traversal info.
       rule.TraversalInfo() = frame.traversalInfo;
       double score = rule.Score(queryNode, *refNode);
+      RecordScores();
 
       if (score == DBL_MAX)
       {
         // Pruned.  Move on.
-        ++numPrunes;
+        RecordPrunes();
         continue;
       }
 
       // If it isn't pruned, we must evaluate the base case.
       const double baseCase = rule.BaseCase(queryNode.Point(),
           refNode->Point());
+      RecordBaseCase();
 
       // Add to child map.
       newScaleVector.push_back(frame);
@@ -313,12 +327,13 @@ DualTreeTraverser<RuleType>::ReferenceRecursion(
 
       // Create the score for the children.
       double score = rule.Rescore(queryNode, *refNode, frame.score);
+      RecordScores();
 
       // Now if this childScore is DBL_MAX we can prune all children.  In this
       // recursion setup pruning is all or nothing for children.
       if (score == DBL_MAX)
       {
-        ++numPrunes;
+        RecordPrunes();
         continue;
       }
 
@@ -329,15 +344,17 @@ DualTreeTraverser<RuleType>::ReferenceRecursion(
       {
         rule.TraversalInfo() = frame.traversalInfo;
         double childScore = rule.Score(queryNode, refNode->Child(j));
+        RecordScores();
         if (childScore == DBL_MAX)
         {
-          ++numPrunes;
+          RecordPrunes();
           continue;
         }
 
         // It wasn't pruned; evaluate the base case.
         const double baseCase = rule.BaseCase(queryNode.Point(),
             refNode->Child(j).Point());
+        RecordBaseCase();
 
         DualCoverTreeMapEntry newFrame;
         newFrame.referenceNode = &refNode->Child(j);
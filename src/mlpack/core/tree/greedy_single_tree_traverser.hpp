@@ -6,6 +6,14 @@
  * and doesn't do backtracking.  The RuleType class must implement the method
  * 'GetBestChild()'.
  *
+ * Optionally, a bounded amount of backtracking can be enabled via
+ * Backtracks(): during the greedy descent, the children that were not chosen
+ * are kept in a priority queue ordered by their scores, and after the descent
+ * finishes the most promising deferred branches are descended too (up to the
+ * given number).  This makes the recall of defeatist search tunable at a
+ * bounded extra cost.  When backtracking is enabled, the RuleType class must
+ * also implement the methods 'Score()' and 'Rescore()'.
+ *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
  * 3-clause BSD license along with mlpack.  If not, see
@@ -39,12 +47,37 @@ class GreedySingleTreeTraverser
   //! Get the number of prunes.
   size_t NumPrunes() const { return numPrunes; }
 
+  //! Get the number of deferred branches to descend after the greedy descent
+  //! (0 means pure defeatist search).
+  size_t Backtracks() const { return backtracks; }
+  //! Modify the number of deferred branches to descend after the greedy
+  //! descent.
+  size_t& Backtracks() { return backtracks; }
+
  private:
+  //! Convenience typedef for the backtracking queue: deferred branches with
+  //! their scores, best (smallest) score on top.
+  typedef std::priority_queue<std::pair<double, TreeType*>,
+      std::vector<std::pair<double, TreeType*>>,
+      std::greater<std::pair<double, TreeType*>>> BranchQueue;
+
+  /**
+   * Perform one greedy descent from the given node, running base cases along
+   * the way.  If backtracking is enabled, the children that were not chosen
+   * are scored and pushed onto the given queue instead of being pruned.
+   */
+  void GreedyDescent(const size_t queryIndex,
+                     TreeType& referenceNode,
+                     BranchQueue& missedBranches);
+
   //! Reference to the rules with which the tree will be traversed.
   RuleType& rule;
 
   //! The number of nodes which have been pruned during traversal.
   size_t numPrunes;
+
+  //! The number of deferred branches to descend after the greedy descent.
+  size_t backtracks;
 };
 
 } // namespace mlpack
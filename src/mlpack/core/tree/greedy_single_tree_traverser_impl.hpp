@@ -23,13 +23,47 @@ template<typename TreeType, typename RuleType>
 GreedySingleTreeTraverser<TreeType, RuleType>::GreedySingleTreeTraverser(
     RuleType& rule) :
     rule(rule),
-    numPrunes(0)
+    numPrunes(0),
+    backtracks(0)
 { /* Nothing to do. */ }
 
 template<typename TreeType, typename RuleType>
 void GreedySingleTreeTraverser<TreeType, RuleType>::Traverse(
     const size_t queryIndex,
     TreeType& referenceNode)
+{
+  BranchQueue missedBranches;
+  GreedyDescent(queryIndex, referenceNode, missedBranches);
+
+  // Now descend the most promising deferred branches, if backtracking is
+  // enabled.  Each descent may defer further branches, so the queue stays
+  // ordered by score and the budget bounds the total number of descents.
+  size_t budget = backtracks;
+  while (budget > 0 && !missedBranches.empty())
+  {
+    const std::pair<double, TreeType*> branch = missedBranches.top();
+    missedBranches.pop();
+
+    // Results found since the branch was deferred may now allow a prune.
+    if (rule.Rescore(queryIndex, *branch.second, branch.first) == DBL_MAX)
+    {
+      ++numPrunes;
+      continue;
+    }
+
+    --budget;
+    GreedyDescent(queryIndex, *branch.second, missedBranches);
+  }
+
+  // Any branches left in the queue are pruned.
+  numPrunes += missedBranches.size();
+}
+
+template<typename TreeType, typename RuleType>
+void GreedySingleTreeTraverser<TreeType, RuleType>::GreedyDescent(
+    const size_t queryIndex,
+    TreeType& referenceNode,
+    BranchQueue& missedBranches)
 {
   // Run the base case as necessary for all the points in the reference node.
   for (size_t i = 0; i < referenceNode.NumPoints(); ++i)
@@ -53,10 +87,32 @@ void GreedySingleTreeTraverser<TreeType, RuleType>::Traverse(
   {
     if (numDescendants > rule.MinimumBaseCases())
     {
-      // We are pruning all but one child.
-      numPrunes += referenceNode.NumChildren() - 1;
+      if (backtracks > 0)
+      {
+        // Defer the children we are not descending instead of pruning them
+        // outright; the scores order them in the backtracking queue.
+        for (size_t i = 0; i < referenceNode.NumChildren(); ++i)
+        {
+          if (i == bestChild)
+            continue;
+
+          const double score = rule.Score(queryIndex, referenceNode.Child(i));
+          if (score == DBL_MAX)
+            ++numPrunes;
+          else
+            missedBranches.push(std::make_pair(score,
+                &referenceNode.Child(i)));
+        }
+      }
+      else
+      {
+        // We are pruning all but one child.
+        numPrunes += referenceNode.NumChildren() - 1;
+      }
+
       // Recurse the best child.
-      Traverse(queryIndex, referenceNode.Child(bestChild));
+      GreedyDescent(queryIndex, referenceNode.Child(bestChild),
+          missedBranches);
     }
     else
     {
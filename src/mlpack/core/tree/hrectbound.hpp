@@ -155,6 +155,35 @@ class HRectBound
    */
   ElemType MaxDistance(const HRectBound& other) const;
 
+  /**
+   * Calculates the minimum bound-to-point distance for a whole block of
+   * points at once, storing one distance per column of the given matrix.
+   * This is a batched version of MinDistance(); the per-dimension arithmetic
+   * is branchless so that the inner loop vectorizes, which makes this
+   * significantly faster than calling MinDistance() once per point in tight
+   * traversal loops.
+   *
+   * @param points Matrix of points (one point per column).
+   * @param distances Vector to store the minimum distances in; it will be set
+   *     to length points.n_cols.
+   */
+  template<typename MatType>
+  void MinDistances(const MatType& points,
+                    arma::Col<ElemType>& distances) const;
+
+  /**
+   * Calculates the maximum bound-to-point distance for a whole block of
+   * points at once, storing one distance per column of the given matrix.
+   * This is a batched, vectorization-friendly version of MaxDistance().
+   *
+   * @param points Matrix of points (one point per column).
+   * @param distances Vector to store the maximum distances in; it will be set
+   *     to length points.n_cols.
+   */
+  template<typename MatType>
+  void MaxDistances(const MatType& points,
+                    arma::Col<ElemType>& distances) const;
+
   /**
    * Calculates minimum and maximum bound-to-bound distance.
    *
@@ -184,6 +213,27 @@ class HRectBound
   template<typename MatType>
   HRectBound& operator|=(const MatType& data);
 
+  /**
+   * Expands this region to include new points held in a sparse matrix.  A
+   * single pass over the nonzero entries gives the extrema of each dimension;
+   * any dimension with fewer nonzeros than points also contains an implicit
+   * zero.  This avoids the per-element access of the generic overload, which
+   * costs a binary search per entry on compressed sparse column storage.
+   *
+   * @param data Sparse data points to expand this region to include.
+   */
+  template<typename eT>
+  HRectBound& operator|=(const arma::SpMat<eT>& data);
+
+  /**
+   * Expands this region to include new points held in a sparse subview (e.g.
+   * a column range of a sparse dataset, as passed during tree construction).
+   *
+   * @param data Sparse data points to expand this region to include.
+   */
+  template<typename eT>
+  HRectBound& operator|=(const arma::SpSubview<eT>& data);
+
   /**
    * Expands this region to encompass another bound.
    */
@@ -239,6 +239,124 @@ inline ElemType HRectBound<MetricType, ElemType>::MinDistance(
   }
 }
 
+/**
+ * Calculates minimum bound-to-point distance for a block of points.
+ */
+template<typename MetricType, typename ElemType>
+template<typename MatType>
+inline void HRectBound<MetricType, ElemType>::MinDistances(
+    const MatType& points,
+    arma::Col<ElemType>& distances) const
+{
+  Log::Assert(points.n_rows == dim);
+
+  // Unpack the bound into two contiguous arrays so the inner loop reads
+  // sequential memory instead of striding over RangeType pairs.
+  arma::Col<ElemType> los(dim), his(dim);
+  for (size_t d = 0; d < dim; ++d)
+  {
+    los[d] = bounds[d].Lo();
+    his[d] = bounds[d].Hi();
+  }
+
+  distances.set_size(points.n_cols);
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    ElemType sum = 0;
+
+    // The loop body is branchless (see MinDistance() for the derivation of
+    // the arithmetic), so the compiler can vectorize it with SIMD
+    // instructions.
+    #pragma omp simd reduction(+:sum)
+    for (size_t d = 0; d < dim; ++d)
+    {
+      const ElemType lower = los[d] - points(d, i);
+      const ElemType higher = points(d, i) - his[d];
+      const ElemType dist = (lower + std::fabs(lower)) +
+          (higher + std::fabs(higher));
+
+      if (MetricType::Power == 1)
+        sum += dist;
+      else if (MetricType::Power == 2)
+        sum += dist * dist;
+      else
+        sum += std::pow(dist, (ElemType) MetricType::Power);
+    }
+
+    // Undo the doubling introduced by the branchless max, and take the root
+    // if required (see MinDistance()).
+    if (MetricType::Power == 1)
+      distances[i] = sum * 0.5;
+    else if (MetricType::Power == 2)
+    {
+      if (MetricType::TakeRoot)
+        distances[i] = (ElemType) std::sqrt(sum) * 0.5;
+      else
+        distances[i] = sum * 0.25;
+    }
+    else
+    {
+      if (MetricType::TakeRoot)
+        distances[i] = (ElemType) pow((double) sum,
+            1.0 / (double) MetricType::Power) / 2.0;
+      else
+        distances[i] = sum / pow(2.0, MetricType::Power);
+    }
+  }
+}
+
+/**
+ * Calculates maximum bound-to-point distance for a block of points.
+ */
+template<typename MetricType, typename ElemType>
+template<typename MatType>
+inline void HRectBound<MetricType, ElemType>::MaxDistances(
+    const MatType& points,
+    arma::Col<ElemType>& distances) const
+{
+  Log::Assert(points.n_rows == dim);
+
+  arma::Col<ElemType> los(dim), his(dim);
+  for (size_t d = 0; d < dim; ++d)
+  {
+    los[d] = bounds[d].Lo();
+    his[d] = bounds[d].Hi();
+  }
+
+  distances.set_size(points.n_cols);
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    ElemType sum = 0;
+
+    #pragma omp simd reduction(+:sum)
+    for (size_t d = 0; d < dim; ++d)
+    {
+      const ElemType v = std::max(std::fabs(points(d, i) - los[d]),
+          std::fabs(his[d] - points(d, i)));
+
+      if (MetricType::Power == 1)
+        sum += v;
+      else if (MetricType::Power == 2)
+        sum += v * v;
+      else
+        sum += std::pow(v, (ElemType) MetricType::Power);
+    }
+
+    if (MetricType::TakeRoot)
+    {
+      if (MetricType::Power == 1)
+        distances[i] = sum;
+      else if (MetricType::Power == 2)
+        distances[i] = (ElemType) std::sqrt(sum);
+      else
+        distances[i] = (ElemType) pow((double) sum,
+            1.0 / (double) MetricType::Power);
+    }
+    else
+      distances[i] = sum;
+  }
+}
+
 /**
  * Calculates minimum bound-to-bound squared distance.
  */
@@ -549,6 +667,75 @@ HRectBound<MetricType, ElemType>::operator|=(const MatType& data)
   return *this;
 }
 
+/**
+ * Expands this region to include the points of a sparse matrix.
+ */
+template<typename MetricType, typename ElemType>
+template<typename eT>
+inline HRectBound<MetricType, ElemType>&
+HRectBound<MetricType, ElemType>::operator|=(const arma::SpMat<eT>& data)
+{
+  if (data.n_cols == 0)
+    return *this;
+
+  return *this |= data.cols(0, data.n_cols - 1);
+}
+
+/**
+ * Expands this region to include the points of a sparse subview.
+ */
+template<typename MetricType, typename ElemType>
+template<typename eT>
+inline HRectBound<MetricType, ElemType>&
+HRectBound<MetricType, ElemType>::operator|=(const arma::SpSubview<eT>& data)
+{
+  Log::Assert(data.n_rows == dim);
+
+  if (data.n_cols == 0)
+    return *this;
+
+  // One pass over the nonzero entries gives the extrema of the nonzero values
+  // in each dimension; counting the nonzeros per dimension tells us which
+  // dimensions also contain an implicit zero.
+  arma::Col<ElemType> mins(dim);
+  mins.fill(std::numeric_limits<ElemType>::max());
+  arma::Col<ElemType> maxs(dim);
+  maxs.fill(std::numeric_limits<ElemType>::lowest());
+  arma::Col<size_t> counts(dim, arma::fill::zeros);
+
+  typename arma::SpSubview<eT>::const_iterator it = data.begin();
+  for ( ; it != data.end(); ++it)
+  {
+    const size_t d = it.row();
+    const ElemType val = (ElemType) (*it);
+    if (val < mins[d])
+      mins[d] = val;
+    if (val > maxs[d])
+      maxs[d] = val;
+    ++counts[d];
+  }
+
+  minWidth = std::numeric_limits<ElemType>::max();
+  for (size_t i = 0; i < dim; ++i)
+  {
+    if (counts[i] < data.n_cols)
+    {
+      // At least one point has an implicit zero in this dimension.
+      if (mins[i] > 0)
+        mins[i] = 0;
+      if (maxs[i] < 0)
+        maxs[i] = 0;
+    }
+
+    bounds[i] |= RangeType<ElemType>(mins[i], maxs[i]);
+    const ElemType width = bounds[i].Width();
+    if (width < minWidth)
+      minWidth = width;
+  }
+
+  return *this;
+}
+
 /**
  * Expands this region to encompass another bound.
  */
@@ -115,7 +115,13 @@ class Octree
    * will take ownership of the dataset; if you don't want this, consider using
    * the constructor that takes a const reference to the dataset.
    *
-   * @param data Dataset to create tree from.  This will be copied!
+   * If the given matrix is an alias of externally owned memory (see
+   * MakeAlias()), no copy is made: the tree is built as a view directly over
+   * that memory.  Note that building the tree rearranges the columns of the
+   * aliased memory in place; use the overload that fills oldFromNew to get an
+   * explicit record of the rearrangement.
+   *
+   * @param data Dataset to create tree from.
    * @param maxLeafSize Maximum number of points in a leaf node.
    */
   Octree(MatType&& data, const size_t maxLeafSize = 20);
@@ -156,6 +162,47 @@ class Octree
          std::vector<size_t>& newFromOld,
          const size_t maxLeafSize = 20);
 
+  /**
+   * Build an octree on the given dataset from Morton (Z-order) codes instead
+   * of recursive comparison-based splits.  Every point is quantized onto a
+   * regular grid over the root cube and given a 64-bit Morton code; the codes
+   * are radix-sorted, and the tree is emitted directly from the sorted
+   * sequence, since the points of every octant are then contiguous.  This is
+   * much faster than the recursive constructors on large low-dimensional
+   * datasets (such as 3-d point clouds), and the leaves are contiguous in
+   * memory in Z-order, which benefits dual-tree traversals.
+   *
+   * The tree uses regular octant centers rather than the empirical splits of
+   * the recursive constructors, so the structure may differ slightly, but all
+   * bounds are empirical and any traversal gives the same results.  The grid
+   * resolution is floor(64 / d) bits per dimension; points that share a grid
+   * cell cannot be separated, so a leaf may exceed maxLeafSize if more than
+   * that many points share a cell.  The dimensionality must be at most 64.
+   *
+   * The returned tree owns a (reordered) copy of the dataset; pass the data
+   * with std::move() to avoid the copy.  The caller is responsible for
+   * deleting the returned tree.
+   *
+   * @param data Dataset to create the tree from.
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   * @return Pointer to the root of the new tree.
+   */
+  static Octree* BuildMorton(MatType data, const size_t maxLeafSize = 20);
+
+  /**
+   * Build an octree from Morton codes (see the other BuildMorton() overload),
+   * also filling a mapping from new point indices to old point indices.
+   *
+   * @param data Dataset to create the tree from.
+   * @param oldFromNew Vector which will be filled with the old positions for
+   *      each new point.
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   * @return Pointer to the root of the new tree.
+   */
+  static Octree* BuildMorton(MatType data,
+                             std::vector<size_t>& oldFromNew,
+                             const size_t maxLeafSize = 20);
+
   /**
    * Construct this node as a child of the given parent, starting at column
    * begin and using count points.  The ordering of that subset of points in the
@@ -412,6 +459,30 @@ class Octree
   friend class cereal::access;
 
  private:
+  /**
+   * Radix-sort the given Morton codes (least significant digit first),
+   * applying the same permutation to the given index vector (used by
+   * BuildMorton()).
+   */
+  static void RadixSortMorton(std::vector<uint64_t>& codes,
+                              std::vector<size_t>& indices,
+                              const size_t totalBits);
+
+  /**
+   * Emit the node covering the given contiguous range of Morton-sorted
+   * points, recursing into its octants (used by BuildMorton()).
+   */
+  static Octree* MortonNode(MatType* dataset,
+                            const std::vector<uint64_t>& codes,
+                            const size_t begin,
+                            const size_t count,
+                            const arma::vec& center,
+                            const double width,
+                            const size_t level,
+                            const size_t bitsPerDim,
+                            const size_t maxLeafSize,
+                            Octree* parent);
+
   /**
    * Split the node, using the given center and the given maximum width of this
    * node.
@@ -270,6 +270,235 @@ Octree<MetricType, StatisticType, MatType>::Octree(
     newFromOld[oldFromNew[i]] = i;
 }
 
+//! Build the tree from Morton codes.
+template<typename MetricType, typename StatisticType, typename MatType>
+Octree<MetricType, StatisticType, MatType>*
+Octree<MetricType, StatisticType, MatType>::BuildMorton(
+    MatType data,
+    const size_t maxLeafSize)
+{
+  std::vector<size_t> oldFromNew;
+  return BuildMorton(std::move(data), oldFromNew, maxLeafSize);
+}
+
+//! Build the tree from Morton codes, filling the point mapping.
+template<typename MetricType, typename StatisticType, typename MatType>
+Octree<MetricType, StatisticType, MatType>*
+Octree<MetricType, StatisticType, MatType>::BuildMorton(
+    MatType data,
+    std::vector<size_t>& oldFromNew,
+    const size_t maxLeafSize)
+{
+  const size_t dims = data.n_rows;
+  const size_t numPoints = data.n_cols;
+
+  // Handle the degenerate case of an empty dataset like the constructors do.
+  if (numPoints == 0)
+  {
+    oldFromNew.clear();
+    std::vector<uint64_t> codes;
+    return MortonNode(new MatType(std::move(data)), codes, 0, 0,
+        arma::vec(dims, arma::fill::zeros), 0.0, 0, 0, maxLeafSize, NULL);
+  }
+
+  if (dims == 0 || dims > 64)
+  {
+    std::ostringstream oss;
+    oss << "Octree::BuildMorton(): dimensionality of data (" << dims << ") "
+        << "must be between 1 and 64 for 64-bit Morton codes";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Each dimension gets an equal share of the 64 code bits.  (Cap at 63 so
+  // that the shifts below stay well-defined in the one-dimensional case.)
+  const size_t bitsPerDim = std::min<size_t>(64 / dims, 63);
+  const uint64_t cellsPerDim = (uint64_t(1) << bitsPerDim);
+
+  // Compute the center and maximum width of the data, the same way the
+  // constructors do, and from them the root cube of the quantization grid.
+  const arma::vec lo = arma::conv_to<arma::vec>::from(arma::min(data, 1));
+  const arma::vec hi = arma::conv_to<arma::vec>::from(arma::max(data, 1));
+  const arma::vec center = 0.5 * (lo + hi);
+  const double maxWidth = (hi - lo).max();
+  const arma::vec cubeLo = center - 0.5 * maxWidth;
+
+  // Quantize each point onto the grid and interleave the cell bits into a
+  // Morton code, most significant level first, with the bit of dimension d at
+  // position d within each level (matching the octant indexing of
+  // SplitNode()).
+  std::vector<uint64_t> codes(numPoints);
+  const double cellWidth = maxWidth / (double) cellsPerDim;
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    std::vector<uint64_t> cells(dims);
+    for (size_t d = 0; d < dims; ++d)
+    {
+      uint64_t cell = 0;
+      if (cellWidth > 0.0)
+      {
+        cell = (uint64_t) ((data(d, i) - cubeLo[d]) / cellWidth);
+        if (cell >= cellsPerDim)
+          cell = cellsPerDim - 1;
+      }
+      cells[d] = cell;
+    }
+
+    uint64_t code = 0;
+    for (size_t level = 0; level < bitsPerDim; ++level)
+    {
+      uint64_t octant = 0;
+      for (size_t d = 0; d < dims; ++d)
+        octant |= (((cells[d] >> (bitsPerDim - 1 - level)) & 1) << d);
+      if (level > 0)
+        code <<= dims;
+      code |= octant;
+    }
+    codes[i] = code;
+  }
+
+  // Sort the points by their Morton codes.
+  std::vector<size_t> indices(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+    indices[i] = i;
+  RadixSortMorton(codes, indices, dims * bitsPerDim);
+
+  // Lay the dataset out in sorted (Z-) order.
+  MatType* sortedData = new MatType(dims, numPoints);
+  #pragma omp parallel for
+  for (size_t i = 0; i < numPoints; ++i)
+    sortedData->col(i) = data.col(indices[i]);
+
+  oldFromNew = std::move(indices);
+
+  // Emit the tree from the sorted sequence.
+  return MortonNode(sortedData, codes, 0, numPoints, center, maxWidth, 0,
+      bitsPerDim, maxLeafSize, NULL);
+}
+
+//! Radix-sort Morton codes and the corresponding indices.
+template<typename MetricType, typename StatisticType, typename MatType>
+void Octree<MetricType, StatisticType, MatType>::RadixSortMorton(
+    std::vector<uint64_t>& codes,
+    std::vector<size_t>& indices,
+    const size_t totalBits)
+{
+  std::vector<uint64_t> codesBuffer(codes.size());
+  std::vector<size_t> indicesBuffer(indices.size());
+
+  // Least-significant-digit radix sort with 8-bit digits; each pass is a
+  // stable counting sort, so the overall sort is stable.
+  const size_t passes = (totalBits + 7) / 8;
+  for (size_t pass = 0; pass < passes; ++pass)
+  {
+    const size_t shift = 8 * pass;
+
+    size_t counts[256] = { 0 };
+    for (size_t i = 0; i < codes.size(); ++i)
+      ++counts[(codes[i] >> shift) & 0xff];
+
+    size_t offsets[256];
+    offsets[0] = 0;
+    for (size_t digit = 1; digit < 256; ++digit)
+      offsets[digit] = offsets[digit - 1] + counts[digit - 1];
+
+    for (size_t i = 0; i < codes.size(); ++i)
+    {
+      const size_t target = offsets[(codes[i] >> shift) & 0xff]++;
+      codesBuffer[target] = codes[i];
+      indicesBuffer[target] = indices[i];
+    }
+
+    std::swap(codes, codesBuffer);
+    std::swap(indices, indicesBuffer);
+  }
+}
+
+//! Emit a node covering a contiguous range of Morton-sorted points.
+template<typename MetricType, typename StatisticType, typename MatType>
+Octree<MetricType, StatisticType, MatType>*
+Octree<MetricType, StatisticType, MatType>::MortonNode(
+    MatType* dataset,
+    const std::vector<uint64_t>& codes,
+    const size_t begin,
+    const size_t count,
+    const arma::vec& center,
+    const double width,
+    const size_t level,
+    const size_t bitsPerDim,
+    const size_t maxLeafSize,
+    Octree* parent)
+{
+  const size_t dims = dataset->n_rows;
+
+  Octree* node = new Octree();
+  delete node->dataset; // The default constructor allocated an empty matrix.
+  node->dataset = dataset;
+  node->begin = begin;
+  node->count = count;
+  node->parent = parent;
+  node->bound = HRectBound<MetricType>(dims);
+
+  if (count > 0)
+    node->bound |= dataset->cols(begin, begin + count - 1);
+
+  // Recurse into the octants, unless this is a leaf or the code bits are
+  // exhausted (points sharing a grid cell cannot be separated).
+  if (count > maxLeafSize && level < bitsPerDim)
+  {
+    const uint64_t octantMask = (dims >= 64) ? ~uint64_t(0) :
+        ((uint64_t(1) << dims) - 1);
+    const size_t shift = dims * (bitsPerDim - 1 - level);
+    const double childWidth = width / 2.0;
+
+    arma::vec childCenter(dims);
+    size_t childBegin = begin;
+    while (childBegin < begin + count)
+    {
+      // The points of each octant are contiguous in the sorted order.
+      const uint64_t octant = (codes[childBegin] >> shift) & octantMask;
+      size_t childEnd = childBegin + 1;
+      while (childEnd < begin + count &&
+             ((codes[childEnd] >> shift) & octantMask) == octant)
+        ++childEnd;
+
+      // Is each dimension "right" (1) or "left" (0)?
+      for (size_t d = 0; d < dims; ++d)
+      {
+        if (((octant >> d) & 1) == 0)
+          childCenter[d] = center[d] - 0.5 * childWidth;
+        else
+          childCenter[d] = center[d] + 0.5 * childWidth;
+      }
+
+      node->children.push_back(MortonNode(dataset, codes, childBegin,
+          childEnd - childBegin, childCenter, childWidth, level + 1,
+          bitsPerDim, maxLeafSize, node));
+
+      childBegin = childEnd;
+    }
+  }
+
+  // Calculate the distance from the empirical center of this node to the
+  // empirical center of the parent.
+  if (parent != NULL)
+  {
+    arma::vec trueCenter, parentCenter;
+    node->bound.Center(trueCenter);
+    parent->bound.Center(parentCenter);
+    node->parentDistance = node->metric.Evaluate(trueCenter, parentCenter);
+  }
+
+  node->furthestDescendantDistance = (count > 0) ?
+      0.5 * node->bound.Diameter() : 0.0;
+
+  // Initialize the statistic (the children are already built).
+  node->stat = StatisticType(*node);
+
+  return node;
+}
+
 //! Construct a child node.
 template<typename MetricType, typename StatisticType, typename MatType>
 Octree<MetricType, StatisticType, MatType>::Octree(
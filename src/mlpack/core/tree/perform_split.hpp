@@ -18,6 +18,80 @@
 
 namespace mlpack {
 
+/**
+ * Split the columns [begin, begin + count) of a sparse dataset.  Swapping
+ * columns of compressed sparse column storage requires shifting large parts
+ * of the value array, so instead of the in-place swap-based partition used
+ * for dense matrices, this computes a stable permutation of the node's
+ * columns and rebuilds the column block with one batch insertion.  The cost
+ * is linear in the number of nonzero entries of the node.
+ *
+ * @param data The sparse dataset used by the binary space tree.
+ * @param begin Index of the starting point in the dataset that belongs to
+ *    this node.
+ * @param count Number of points in this node.
+ * @param splitInfo The information about the split.
+ * @param oldFromNew Mappings to update for the permutation, or NULL if the
+ *    tree is not mapping indices.
+ */
+template<typename MatType, typename SplitType>
+size_t PerformSparseSplit(MatType& data,
+                          const size_t begin,
+                          const size_t count,
+                          const typename SplitType::SplitInfo& splitInfo,
+                          std::vector<size_t>* oldFromNew)
+{
+  // Decide which child every point in the node belongs to.
+  std::vector<bool> assignedToLeft(count);
+  size_t leftCount = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    assignedToLeft[i] = SplitType::AssignToLeftNode(data.col(begin + i),
+        splitInfo);
+    if (assignedToLeft[i])
+      ++leftCount;
+  }
+
+  // Compute the new position of every column of the node: points assigned to
+  // the left child keep their relative order and come first, then the points
+  // assigned to the right child.
+  std::vector<size_t> newPos(count);
+  size_t nextLeft = 0, nextRight = leftCount;
+  for (size_t i = 0; i < count; ++i)
+    newPos[i] = assignedToLeft[i] ? nextLeft++ : nextRight++;
+
+  if (oldFromNew)
+  {
+    const std::vector<size_t> oldIndices(oldFromNew->begin() + begin,
+        oldFromNew->begin() + begin + count);
+    for (size_t i = 0; i < count; ++i)
+      (*oldFromNew)[begin + newPos[i]] = oldIndices[i];
+  }
+
+  // Gather the nonzero entries of the node's columns with their permuted
+  // column indices; the batch-insertion constructor sorts them and builds the
+  // replacement block in one pass.
+  const size_t nnz = data.cols(begin, begin + count - 1).n_nonzero;
+  arma::umat locations(2, nnz);
+  arma::Col<typename MatType::elem_type> values(nnz);
+
+  size_t index = 0;
+  typename MatType::const_iterator it = data.begin_col(begin);
+  typename MatType::const_iterator end = data.end_col(begin + count - 1);
+  for ( ; it != end; ++it)
+  {
+    locations(0, index) = it.row();
+    locations(1, index) = newPos[it.col() - begin];
+    values[index] = (*it);
+    ++index;
+  }
+
+  data.cols(begin, begin + count - 1) =
+      MatType(locations, values, data.n_rows, count);
+
+  return begin + leftCount;
+}
+
 /**
  * This function implements the default split behavior i.e. it rearranges
  * points according to the split information. The SplitType::AssignToLeftNode()
@@ -34,7 +108,8 @@ template<typename MatType, typename SplitType>
 size_t PerformSplit(MatType& data,
                     const size_t begin,
                     const size_t count,
-                    const typename SplitType::SplitInfo& splitInfo)
+                    const typename SplitType::SplitInfo& splitInfo,
+                    const std::false_type& /* isSparse */)
 {
   // This method modifies the input dataset.  We loop both from the left and
   // right sides of the points contained in this node.
@@ -80,6 +155,44 @@ size_t PerformSplit(MatType& data,
   return left;
 }
 
+//! Sparse version: partition via a batch rebuild of the column block.
+template<typename MatType, typename SplitType>
+size_t PerformSplit(MatType& data,
+                    const size_t begin,
+                    const size_t count,
+                    const typename SplitType::SplitInfo& splitInfo,
+                    const std::true_type& /* isSparse */)
+{
+  return PerformSparseSplit<MatType, SplitType>(data, begin, count, splitInfo,
+      NULL);
+}
+
+/**
+ * This function implements the default split behavior i.e. it rearranges
+ * points according to the split information. The SplitType::AssignToLeftNode()
+ * function is used in order to determine the child that contains any particular
+ * point.
+ *
+ * @param data The dataset used by the binary space tree.
+ * @param begin Index of the starting point in the dataset that belongs to
+ *    this node.
+ * @param count Number of points in this node.
+ * @param splitInfo The information about the split.
+ */
+template<typename MatType, typename SplitType>
+size_t PerformSplit(MatType& data,
+                    const size_t begin,
+                    const size_t count,
+                    const typename SplitType::SplitInfo& splitInfo)
+{
+  // Sparse matrices cannot be partitioned in place cheaply, so dispatch to
+  // the batch-rebuild implementation for them.
+  typedef std::integral_constant<bool,
+      arma::is_arma_sparse_type<MatType>::value> IsSparse;
+  return PerformSplit<MatType, SplitType>(data, begin, count, splitInfo,
+      IsSparse());
+}
+
 /**
  * This function implements the default split behavior i.e. it rearranges
  * points according to the split information. The SplitType::AssignToLeftNode()
@@ -100,7 +213,8 @@ size_t PerformSplit(MatType& data,
                     const size_t begin,
                     const size_t count,
                     const typename SplitType::SplitInfo& splitInfo,
-                    std::vector<size_t>& oldFromNew)
+                    std::vector<size_t>& oldFromNew,
+                    const std::false_type& /* isSparse */)
 {
   // This method modifies the input dataset.  We loop both from the left and
   // right sides of the points contained in this node.
@@ -150,6 +264,49 @@ size_t PerformSplit(MatType& data,
   return left;
 }
 
+//! Sparse version: partition via a batch rebuild of the column block.
+template<typename MatType, typename SplitType>
+size_t PerformSplit(MatType& data,
+                    const size_t begin,
+                    const size_t count,
+                    const typename SplitType::SplitInfo& splitInfo,
+                    std::vector<size_t>& oldFromNew,
+                    const std::true_type& /* isSparse */)
+{
+  return PerformSparseSplit<MatType, SplitType>(data, begin, count, splitInfo,
+      &oldFromNew);
+}
+
+/**
+ * This function implements the default split behavior i.e. it rearranges
+ * points according to the split information. The SplitType::AssignToLeftNode()
+ * function is used in order to determine the child that contains any particular
+ * point. The function takes care of indices and returns the list of changed
+ * indices.
+ *
+ * @param data The dataset used by the binary space tree.
+ * @param begin Index of the starting point in the dataset that belongs to
+ *    this node.
+ * @param count Number of points in this node.
+ * @param splitInfo The information about the split.
+ * @param oldFromNew Vector which will be filled with the old positions for
+ *    each new point.
+ */
+template<typename MatType, typename SplitType>
+size_t PerformSplit(MatType& data,
+                    const size_t begin,
+                    const size_t count,
+                    const typename SplitType::SplitInfo& splitInfo,
+                    std::vector<size_t>& oldFromNew)
+{
+  // Sparse matrices cannot be partitioned in place cheaply, so dispatch to
+  // the batch-rebuild implementation for them.
+  typedef std::integral_constant<bool,
+      arma::is_arma_sparse_type<MatType>::value> IsSparse;
+  return PerformSplit<MatType, SplitType>(data, begin, count, splitInfo,
+      oldFromNew, IsSparse());
+}
+
 } // namespace mlpack
 
 
@@ -155,6 +155,36 @@ class RectangleTree
                 const size_t minNumChildren = 2,
                 const size_t firstDataIndex = 0);
 
+  /**
+   * Build a tree on the given dataset with sort-tile-recursive (STR) bulk
+   * loading instead of one-at-a-time insertion.  The points are recursively
+   * sorted and tiled into slabs, one dimension at a time, and packed into
+   * full leaves; the upper levels are then packed bottom-up in the same
+   * order.  For static datasets this is much faster than insertion-based
+   * construction and produces tighter bounding rectangles with less overlap.
+   * The returned tree owns a copy of the dataset (pass with std::move() to
+   * avoid the copy); the caller is responsible for deleting the tree.
+   *
+   * Bulk loading is only available for tree variants that do not maintain
+   * auxiliary information (e.g. the R tree and the R* tree), since the
+   * auxiliary information of the other variants is built incrementally
+   * during insertion.
+   *
+   * @param data Dataset from which to create the tree.
+   * @param maxLeafSize Maximum size of each leaf in the tree.
+   * @param minLeafSize Minimum size of each leaf in the tree.
+   * @param maxNumChildren The maximum number of child nodes a non-leaf node
+   *      may have.
+   * @param minNumChildren The minimum number of child nodes a non-leaf node
+   *      may have.
+   * @return Pointer to the root of the new tree.
+   */
+  static RectangleTree* BuildSTR(MatType data,
+                                 const size_t maxLeafSize = 20,
+                                 const size_t minLeafSize = 8,
+                                 const size_t maxNumChildren = 5,
+                                 const size_t minNumChildren = 2);
+
   /**
    * Construct this as an empty node with the specified parent.  Copying the
    * parameters (maxLeafSize, minLeafSize, maxNumChildren, minNumChildren,
@@ -563,6 +593,28 @@ class RectangleTree
    */
   void BuildStatistics(RectangleTree* node);
 
+  /**
+   * Create an empty, parentless node for STR bulk loading (used by
+   * BuildSTR()).
+   */
+  static RectangleTree* STRNode(const MatType* dataset,
+                                const size_t maxLeafSize,
+                                const size_t minLeafSize,
+                                const size_t maxNumChildren,
+                                const size_t minNumChildren);
+
+  /**
+   * Recursively sort and tile the index range [rangeBegin, rangeEnd) of the
+   * given index vector, one dimension at a time, so that consecutive groups
+   * of maxLeafSize indices form STR leaves (used by BuildSTR()).
+   */
+  static void STRTile(const MatType& data,
+                      std::vector<size_t>& indices,
+                      const size_t rangeBegin,
+                      const size_t rangeEnd,
+                      const size_t dim,
+                      const size_t maxLeafSize);
+
  protected:
   /**
    * A default constructor.  This is meant to only be used with
@@ -120,6 +120,168 @@ RectangleTree(MatType&& data,
   BuildStatistics(this);
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>*
+RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+BuildSTR(MatType data,
+         const size_t maxLeafSize,
+         const size_t minLeafSize,
+         const size_t maxNumChildren,
+         const size_t minNumChildren)
+{
+  static_assert(std::is_same<AuxiliaryInformation,
+      NoAuxiliaryInformation<RectangleTree>>::value,
+      "RectangleTree::BuildSTR(): bulk loading is not available for tree "
+      "variants with auxiliary information");
+
+  MatType* dataset = new MatType(std::move(data));
+  const size_t numPoints = dataset->n_cols;
+
+  // Compute the STR ordering of the points.
+  std::vector<size_t> indices(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+    indices[i] = i;
+  if (numPoints > 0)
+    STRTile(*dataset, indices, 0, numPoints, 0, maxLeafSize);
+
+  // Pack the ordered points into full leaves.
+  std::vector<RectangleTree*> level;
+  level.reserve((numPoints + maxLeafSize - 1) / maxLeafSize);
+  for (size_t leafBegin = 0; leafBegin < numPoints; leafBegin += maxLeafSize)
+  {
+    const size_t leafEnd = std::min(numPoints, leafBegin + maxLeafSize);
+    RectangleTree* leaf = STRNode(dataset, maxLeafSize, minLeafSize,
+        maxNumChildren, minNumChildren);
+    for (size_t i = leafBegin; i < leafEnd; ++i)
+    {
+      leaf->points[leaf->count++] = indices[i];
+      leaf->bound |= dataset->col(indices[i]);
+    }
+    leaf->numDescendants = leaf->count;
+    level.push_back(leaf);
+  }
+
+  // Handle the degenerate case of an empty dataset.
+  if (level.empty())
+    level.push_back(STRNode(dataset, maxLeafSize, minLeafSize, maxNumChildren,
+        minNumChildren));
+
+  // Pack the upper levels bottom-up, distributing the children of each level
+  // as evenly as possible so that no parent goes below the minimum fill.
+  while (level.size() > 1)
+  {
+    const size_t numParents = (level.size() + maxNumChildren - 1) /
+        maxNumChildren;
+    std::vector<RectangleTree*> nextLevel;
+    nextLevel.reserve(numParents);
+
+    size_t childIndex = 0;
+    for (size_t i = 0; i < numParents; ++i)
+    {
+      const size_t childrenHere = level.size() / numParents +
+          ((i < level.size() % numParents) ? 1 : 0);
+      RectangleTree* node = STRNode(dataset, maxLeafSize, minLeafSize,
+          maxNumChildren, minNumChildren);
+      for (size_t j = 0; j < childrenHere; ++j, ++childIndex)
+      {
+        node->children[node->numChildren++] = level[childIndex];
+        level[childIndex]->parent = node;
+        node->bound |= level[childIndex]->bound;
+        node->numDescendants += level[childIndex]->numDescendants;
+      }
+      nextLevel.push_back(node);
+    }
+
+    level = std::move(nextLevel);
+  }
+
+  RectangleTree* root = level[0];
+  root->ownsDataset = true;
+
+  // Initialize statistics recursively, now that construction is complete.
+  root->BuildStatistics(root);
+  return root;
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>*
+RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+STRNode(const MatType* dataset,
+        const size_t maxLeafSize,
+        const size_t minLeafSize,
+        const size_t maxNumChildren,
+        const size_t minNumChildren)
+{
+  RectangleTree* node = new RectangleTree();
+  node->maxNumChildren = maxNumChildren;
+  node->minNumChildren = minNumChildren;
+  node->children.resize(maxNumChildren + 1, NULL);
+  node->maxLeafSize = maxLeafSize;
+  node->minLeafSize = minLeafSize;
+  node->bound = HRectBound<EuclideanDistance, ElemType>(dataset->n_rows);
+  node->dataset = dataset;
+  node->points.resize(maxLeafSize + 1);
+  node->auxiliaryInfo = AuxiliaryInformation(node);
+  return node;
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+STRTile(const MatType& data,
+        std::vector<size_t>& indices,
+        const size_t rangeBegin,
+        const size_t rangeEnd,
+        const size_t dim,
+        const size_t maxLeafSize)
+{
+  const size_t numPoints = rangeEnd - rangeBegin;
+
+  // Sort this range of the indices by the current dimension.
+  std::sort(indices.begin() + rangeBegin, indices.begin() + rangeEnd,
+      [&data, dim](const size_t a, const size_t b)
+      { return data(dim, a) < data(dim, b); });
+
+  // If the range fits in a single leaf, or there are no more dimensions to
+  // tile on, the sorted order is final.
+  if (numPoints <= maxLeafSize || dim == data.n_rows - 1)
+    return;
+
+  // Split the range into slabs along this dimension, each holding a whole
+  // number of leaves, and tile each slab on the remaining dimensions.
+  const size_t numLeaves = (numPoints + maxLeafSize - 1) / maxLeafSize;
+  const size_t numSlabs = (size_t) std::ceil(std::pow((double) numLeaves,
+      1.0 / (double) (data.n_rows - dim)));
+  const size_t leavesPerSlab = (numLeaves + numSlabs - 1) / numSlabs;
+  const size_t slabPoints = leavesPerSlab * maxLeafSize;
+
+  for (size_t slabBegin = rangeBegin; slabBegin < rangeEnd;
+       slabBegin += slabPoints)
+  {
+    STRTile(data, indices, slabBegin,
+        std::min(rangeEnd, slabBegin + slabPoints), dim + 1, maxLeafSize);
+  }
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -57,12 +57,28 @@ class SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>::
   //! Modify the number of prunes.
   size_t& NumPrunes() { return numPrunes; }
 
+  //! Get whether adaptive backtracking is enabled.
+  bool AdaptiveBacktracking() const { return adaptiveBacktracking; }
+  //! Modify whether adaptive backtracking is enabled.  This only has an
+  //! effect when Defeatist is true: after the defeatist descent into the
+  //! better child of an overlapping node, the other child is scored against
+  //! the query's current candidate bound (the k-th best candidate distance,
+  //! for neighbor search rules) and visited only if it could still improve
+  //! the results.  This gives per-query control of the recall/latency
+  //! trade-off through the rules' bound (e.g. the epsilon of approximate
+  //! neighbor search) without rebuilding the tree with a different overlap.
+  bool& AdaptiveBacktracking() { return adaptiveBacktracking; }
+
  private:
   //! Reference to the rules with which the tree will be traversed.
   RuleType& rule;
 
   //! The number of nodes which have been pruned during traversal.
   size_t numPrunes;
+
+  //! Whether the defeatist descent backtracks into the other child of
+  //! overlapping nodes when the query's candidate bound says it may help.
+  bool adaptiveBacktracking;
 };
 
 } // namespace mlpack
@@ -31,7 +31,8 @@ SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>::
 SpillSingleTreeTraverser<RuleType, Defeatist>::SpillSingleTreeTraverser(
     RuleType& rule) :
     rule(rule),
-    numPrunes(0)
+    numPrunes(0),
+    adaptiveBacktracking(false)
 { /* Nothing to do. */ }
 
 template<typename MetricType,
@@ -69,7 +70,25 @@ SpillSingleTreeTraverser<RuleType, Defeatist>::Traverse(
       // If referenceNode is a overlapping node we do defeatist search.
       size_t bestChild = rule.GetBestChild(queryIndex, referenceNode);
       Traverse(queryIndex, referenceNode.Child(bestChild));
-      ++numPrunes;
+
+      if (adaptiveBacktracking)
+      {
+        // Backtrack into the other child only if the query's current
+        // candidate bound says it could still improve the results; the
+        // defeatist descent above usually tightens that bound enough to make
+        // this a cheap check.
+        SpillTree& otherChild = referenceNode.Child(1 - bestChild);
+        const double score = rule.Score(queryIndex, otherChild);
+
+        if (score != DBL_MAX)
+          Traverse(queryIndex, otherChild);
+        else
+          ++numPrunes;
+      }
+      else
+      {
+        ++numPrunes;
+      }
     }
     else
     {
@@ -147,7 +147,10 @@ class SpillTree
   /**
    * Construct this as the root node of a hybrid spill tree using the given
    * dataset.  The dataset will not be modified during the building procedure
-   * (unlike BinarySpaceTree).
+   * (unlike BinarySpaceTree), and it is not copied: the tree holds only a
+   * reference, so this constructor can be used as a non-owning view over
+   * externally owned memory (e.g. an alias made with MakeAlias()).  The
+   * caller must keep the matrix alive for the lifetime of the tree.
    *
    * @param data Dataset to create tree from.
    * @param tau Overlapping size.
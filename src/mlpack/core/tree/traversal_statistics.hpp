@@ -0,0 +1,291 @@
+/**
+ * @file core/tree/traversal_statistics.hpp
+ *
+ * Defines the TraversalStatistics class, an opt-in instrumentation collector
+ * for tree traversals.  A traverser that supports instrumentation records
+ * per-depth visit/score/prune/base-case counts, a histogram of base cases per
+ * visited leaf combination, and wall time per subtree into this class, and a
+ * machine-readable report can be produced afterwards.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_TRAVERSAL_STATISTICS_HPP
+#define MLPACK_CORE_TREE_TRAVERSAL_STATISTICS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <chrono>
+
+namespace mlpack {
+
+/**
+ * The TraversalStatistics class collects structured statistics about a tree
+ * traversal.  It is meant to be attached to a traverser (see, e.g.,
+ * BinarySpaceTree::DualTreeTraverser::EnableStatistics()); when no collector
+ * is attached, the traversal pays no instrumentation cost beyond a null
+ * pointer check.
+ *
+ * The statistics collected are:
+ *
+ *  - per-depth counts of node combinations visited, Score() calls, prunes,
+ *    and base cases, from which per-depth prune rates can be computed;
+ *  - a histogram of the number of base cases evaluated per visited leaf
+ *    combination, in power-of-two buckets; and
+ *  - cumulative wall time of the subtrees rooted at each depth, measured only
+ *    down to MaxTimedDepth() to keep the timing overhead negligible.
+ *
+ * These are useful for tuning leaf sizes and approximation parameters: a low
+ * prune rate near the root suggests a too-loose bound or too-small epsilon,
+ * while many leaf combinations with few base cases suggest the leaf size is
+ * too small.
+ */
+class TraversalStatistics
+{
+ public:
+  /**
+   * Create an empty TraversalStatistics object.
+   *
+   * @param maxTimedDepth Deepest depth at which subtree wall times are
+   *      recorded.
+   */
+  TraversalStatistics(const size_t maxTimedDepth = 4) :
+      maxTimedDepth(maxTimedDepth)
+  {
+    Reset();
+  }
+
+  //! Clear all collected statistics.
+  void Reset()
+  {
+    visits.clear();
+    scores.clear();
+    prunes.clear();
+    baseCases.clear();
+    baseCaseHistogram.clear();
+    subtreeTimes.assign(maxTimedDepth + 1, 0.0);
+  }
+
+  //! Record that a node combination at the given depth was visited.
+  void RecordVisit(const size_t depth)
+  {
+    EnsureDepth(depth);
+    ++visits[depth];
+  }
+
+  //! Record Score() (or Rescore()) calls at the given depth.
+  void RecordScores(const size_t depth, const size_t count = 1)
+  {
+    EnsureDepth(depth);
+    scores[depth] += count;
+  }
+
+  //! Record prunes at the given depth.
+  void RecordPrunes(const size_t depth, const size_t count = 1)
+  {
+    EnsureDepth(depth);
+    prunes[depth] += count;
+  }
+
+  //! Record that a visited leaf combination at the given depth evaluated the
+  //! given number of base cases.  This also updates the base case histogram.
+  void RecordBaseCases(const size_t depth, const size_t count)
+  {
+    EnsureDepth(depth);
+    baseCases[depth] += count;
+
+    // Bucket b holds leaf combinations with between 2^b and 2^(b + 1) - 1
+    // base cases (bucket 0 also holds those with none).
+    size_t bucket = 0;
+    for (size_t c = count; c > 1; c >>= 1)
+      ++bucket;
+    if (bucket >= baseCaseHistogram.size())
+      baseCaseHistogram.resize(bucket + 1, 0);
+    ++baseCaseHistogram[bucket];
+  }
+
+  //! Record the wall time (in seconds) of a subtree rooted at the given
+  //! depth; ignored if the depth is below MaxTimedDepth().
+  void RecordSubtreeTime(const size_t depth, const double seconds)
+  {
+    if (depth <= maxTimedDepth)
+      subtreeTimes[depth] += seconds;
+  }
+
+  //! Get the deepest depth at which subtree wall times are recorded.
+  size_t MaxTimedDepth() const { return maxTimedDepth; }
+
+  //! Get the per-depth visit counts.
+  const std::vector<size_t>& Visits() const { return visits; }
+  //! Get the per-depth score counts.
+  const std::vector<size_t>& Scores() const { return scores; }
+  //! Get the per-depth prune counts.
+  const std::vector<size_t>& Prunes() const { return prunes; }
+  //! Get the per-depth base case counts.
+  const std::vector<size_t>& BaseCases() const { return baseCases; }
+  //! Get the base case histogram (bucket b holds the number of visited leaf
+  //! combinations with between 2^b and 2^(b + 1) - 1 base cases).
+  const std::vector<size_t>& BaseCaseHistogram() const
+  {
+    return baseCaseHistogram;
+  }
+  //! Get the cumulative subtree wall times (in seconds) per depth.
+  const std::vector<double>& SubtreeTimes() const { return subtreeTimes; }
+
+  //! Get the total number of node combinations visited.
+  size_t TotalVisits() const { return Total(visits); }
+  //! Get the total number of Score() calls.
+  size_t TotalScores() const { return Total(scores); }
+  //! Get the total number of prunes.
+  size_t TotalPrunes() const { return Total(prunes); }
+  //! Get the total number of base cases.
+  size_t TotalBaseCases() const { return Total(baseCases); }
+
+  //! Get the fraction of Score() calls at the given depth that were pruned
+  //! (or 0 if no scores were recorded at that depth).
+  double PruneRate(const size_t depth) const
+  {
+    if (depth >= scores.size() || scores[depth] == 0)
+      return 0.0;
+    return (double) prunes[depth] / (double) scores[depth];
+  }
+
+  /**
+   * Write a machine-readable (JSON) report of the collected statistics to the
+   * given stream.
+   *
+   * @param stream Stream to write the report to.
+   */
+  void Report(std::ostream& stream) const
+  {
+    stream << "{";
+    stream << "\"totalVisits\": " << TotalVisits() << ", ";
+    stream << "\"totalScores\": " << TotalScores() << ", ";
+    stream << "\"totalPrunes\": " << TotalPrunes() << ", ";
+    stream << "\"totalBaseCases\": " << TotalBaseCases() << ", ";
+
+    stream << "\"depths\": [";
+    for (size_t d = 0; d < visits.size(); ++d)
+    {
+      if (d > 0)
+        stream << ", ";
+      stream << "{\"depth\": " << d
+          << ", \"visits\": " << visits[d]
+          << ", \"scores\": " << scores[d]
+          << ", \"prunes\": " << prunes[d]
+          << ", \"pruneRate\": " << PruneRate(d)
+          << ", \"baseCases\": " << baseCases[d];
+      if (d <= maxTimedDepth)
+        stream << ", \"subtreeSeconds\": " << subtreeTimes[d];
+      stream << "}";
+    }
+    stream << "], ";
+
+    stream << "\"baseCaseHistogram\": [";
+    for (size_t b = 0; b < baseCaseHistogram.size(); ++b)
+    {
+      if (b > 0)
+        stream << ", ";
+      stream << "{\"minBaseCases\": " << (size_t(1) << b)
+          << ", \"maxBaseCases\": " << ((size_t(1) << (b + 1)) - 1)
+          << ", \"count\": " << baseCaseHistogram[b] << "}";
+    }
+    stream << "]}";
+  }
+
+ private:
+  //! Grow the per-depth vectors so that the given depth is valid.
+  void EnsureDepth(const size_t depth)
+  {
+    if (depth >= visits.size())
+    {
+      visits.resize(depth + 1, 0);
+      scores.resize(depth + 1, 0);
+      prunes.resize(depth + 1, 0);
+      baseCases.resize(depth + 1, 0);
+    }
+  }
+
+  //! Sum a per-depth counter vector.
+  static size_t Total(const std::vector<size_t>& counts)
+  {
+    size_t total = 0;
+    for (size_t i = 0; i < counts.size(); ++i)
+      total += counts[i];
+    return total;
+  }
+
+  //! Per-depth counts of visited node combinations.
+  std::vector<size_t> visits;
+  //! Per-depth counts of Score() calls.
+  std::vector<size_t> scores;
+  //! Per-depth counts of prunes.
+  std::vector<size_t> prunes;
+  //! Per-depth counts of base cases.
+  std::vector<size_t> baseCases;
+  //! Histogram of base cases per visited leaf combination, in power-of-two
+  //! buckets.
+  std::vector<size_t> baseCaseHistogram;
+  //! Cumulative subtree wall times per depth, in seconds.
+  std::vector<double> subtreeTimes;
+  //! Deepest depth at which subtree wall times are recorded.
+  size_t maxTimedDepth;
+};
+
+/**
+ * ScopedTraversalFrame is a small helper for traversers that support
+ * TraversalStatistics.  Constructed at the top of a recursive traversal
+ * function, it records the visit, tracks the recursion depth, and measures
+ * the wall time of the subtree on destruction.  When no collector is
+ * attached, it only maintains the depth counter.
+ */
+class ScopedTraversalFrame
+{
+ public:
+  //! Enter a traversal frame, recording the visit and starting the subtree
+  //! timer if a collector is attached.
+  ScopedTraversalFrame(TraversalStatistics* stats, size_t& depthCounter) :
+      stats(stats),
+      depthCounter(depthCounter),
+      depth(depthCounter++),
+      timed(stats != NULL && depth <= stats->MaxTimedDepth())
+  {
+    if (stats)
+      stats->RecordVisit(depth);
+    if (timed)
+      start = std::chrono::high_resolution_clock::now();
+  }
+
+  //! Leave the traversal frame, recording the subtree wall time.
+  ~ScopedTraversalFrame()
+  {
+    --depthCounter;
+    if (timed)
+    {
+      const std::chrono::duration<double> elapsed =
+          std::chrono::high_resolution_clock::now() - start;
+      stats->RecordSubtreeTime(depth, elapsed.count());
+    }
+  }
+
+  //! Get the depth of this frame.
+  size_t Depth() const { return depth; }
+
+ private:
+  //! The attached collector (may be NULL).
+  TraversalStatistics* stats;
+  //! Reference to the traverser's depth counter.
+  size_t& depthCounter;
+  //! The depth of this frame.
+  const size_t depth;
+  //! Whether the subtree rooted at this frame is being timed.
+  const bool timed;
+  //! The time at which this frame was entered (only valid if timed).
+  std::chrono::high_resolution_clock::time_point start;
+};
+
+} // namespace mlpack
+
+#endif // MLPACK_CORE_TREE_TRAVERSAL_STATISTICS_HPP
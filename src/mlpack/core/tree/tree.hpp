@@ -24,9 +24,12 @@
 
 #include "tree_traits.hpp"
 #include "build_tree.hpp"
+#include "tree_registry.hpp"
 
 #include "statistic.hpp"
 #include "traversal_info.hpp"
+#include "traversal_statistics.hpp"
+#include "composite_rules.hpp"
 #include "greedy_single_tree_traverser.hpp"
 
 #endif
@@ -0,0 +1,201 @@
+/**
+ * @file core/tree/tree_registry.hpp
+ * @author Ryan Curtin
+ *
+ * A process-wide registry of shared reference trees.  When several models are
+ * hosted over the same reference data (e.g. a KNN model and a RangeSearch
+ * model in one service), each can look up the tree by name instead of
+ * building and owning its own copy of an identical structure.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_TREE_REGISTRY_HPP
+#define MLPACK_CORE_TREE_TREE_REGISTRY_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "build_tree.hpp"
+
+#include <memory>
+#include <mutex>
+#include <typeindex>
+
+namespace mlpack {
+
+/**
+ * A registry of shared trees, keyed by a user-chosen name and the tree type.
+ * Trees are held with shared-ownership semantics (std::shared_ptr), so a
+ * registered tree stays alive as long as the registry or any handed-out
+ * reference still uses it, and several models over the same reference data
+ * can share one tree instead of each building their own copy.
+ *
+ * Because the tree statistic is part of the tree type, a tree can only be
+ * shared between users of the exact same tree type: two KNN models can share
+ * one KDTree<..., NeighborSearchStat<...>, ...>, but a KNN model and a KDE
+ * model cannot share a tree, since their statistic types differ even though
+ * the tree structure is identical.  Register one tree per statistic type in
+ * that situation; the dataset inside each tree can still be shared by
+ * building the trees from an alias matrix.
+ *
+ * Sharing is read-only: a model that wants to mutate a shared tree (e.g.
+ * rebuild it on new data) should call EnsureUnique() first, which performs a
+ * copy only if the tree is actually shared (copy-on-write).
+ *
+ * All operations are thread-safe.
+ *
+ * A simple usage example:
+ *
+ * @code
+ * std::vector<size_t> oldFromNew;
+ * std::shared_ptr<KNN::Tree> tree =
+ *     TreeRegistry::Get().GetOrBuild<KNN::Tree>("refs", dataset, oldFromNew);
+ * // A second call with the same name and type returns the same tree.
+ * @endcode
+ */
+class TreeRegistry
+{
+ public:
+  //! Retrieve the process-wide registry.
+  static TreeRegistry& Get()
+  {
+    static TreeRegistry registry;
+    return registry;
+  }
+
+  /**
+   * Return the tree registered under the given name, building it from the
+   * given dataset if it is not registered yet.  The mapping of new point
+   * indices to old ones produced at build time is stored alongside the tree
+   * and returned in oldFromNew on every call (it is empty for tree types
+   * that do not rearrange the dataset), so late-coming models can unmap
+   * their results too.
+   *
+   * @param name Name the tree is (or will be) registered under.
+   * @param dataset Dataset to build the tree on if it does not exist yet.
+   * @param oldFromNew Mappings from new indices to old, filled on return.
+   * @return Shared pointer to the registered tree.
+   */
+  template<typename TreeType, typename MatType>
+  std::shared_ptr<TreeType> GetOrBuild(const std::string& name,
+                                       MatType&& dataset,
+                                       std::vector<size_t>& oldFromNew)
+  {
+    std::lock_guard<std::mutex> lock(mapMutex);
+
+    const Key key = std::make_pair(name, std::type_index(typeid(TreeType)));
+    typename std::map<Key, Entry>::iterator it = trees.find(key);
+    if (it == trees.end())
+    {
+      Entry entry;
+      entry.tree = std::shared_ptr<TreeType>(BuildTree<TreeType>(
+          std::forward<MatType>(dataset), entry.oldFromNew));
+      it = trees.insert(std::make_pair(key, std::move(entry))).first;
+    }
+
+    oldFromNew = it->second.oldFromNew;
+    return std::static_pointer_cast<TreeType>(it->second.tree);
+  }
+
+  /**
+   * Return the tree registered under the given name, or an empty pointer if
+   * no tree of this type is registered under that name.
+   */
+  template<typename TreeType>
+  std::shared_ptr<TreeType> Find(const std::string& name) const
+  {
+    std::lock_guard<std::mutex> lock(mapMutex);
+
+    const Key key = std::make_pair(name, std::type_index(typeid(TreeType)));
+    typename std::map<Key, Entry>::const_iterator it = trees.find(key);
+    if (it == trees.end())
+      return std::shared_ptr<TreeType>();
+    return std::static_pointer_cast<TreeType>(it->second.tree);
+  }
+
+  /**
+   * Register an already-built tree under the given name, taking shared
+   * ownership of it.  An existing tree of the same type under the same name
+   * is replaced (references handed out earlier keep the old tree alive).
+   *
+   * @param name Name to register the tree under.
+   * @param tree Tree to register.
+   * @param oldFromNew Mappings from new indices to old produced when the
+   *     tree was built (pass an empty vector if there are none).
+   */
+  template<typename TreeType>
+  void Insert(const std::string& name,
+              std::shared_ptr<TreeType> tree,
+              std::vector<size_t> oldFromNew = std::vector<size_t>())
+  {
+    std::lock_guard<std::mutex> lock(mapMutex);
+
+    const Key key = std::make_pair(name, std::type_index(typeid(TreeType)));
+    Entry entry;
+    entry.tree = std::move(tree);
+    entry.oldFromNew = std::move(oldFromNew);
+    trees[key] = std::move(entry);
+  }
+
+  /**
+   * Remove the tree of the given type registered under the given name.
+   * References handed out earlier remain valid; only the registry's share of
+   * the ownership is dropped.  Returns true if a tree was removed.
+   */
+  template<typename TreeType>
+  bool Remove(const std::string& name)
+  {
+    std::lock_guard<std::mutex> lock(mapMutex);
+    return trees.erase(
+        std::make_pair(name, std::type_index(typeid(TreeType)))) > 0;
+  }
+
+  //! Remove all registered trees (handed-out references remain valid).
+  void Clear()
+  {
+    std::lock_guard<std::mutex> lock(mapMutex);
+    trees.clear();
+  }
+
+  //! Return the number of registered trees.
+  size_t Size() const
+  {
+    std::lock_guard<std::mutex> lock(mapMutex);
+    return trees.size();
+  }
+
+ private:
+  //! Trees are keyed by name and type, so the same name may hold trees of
+  //! several types (e.g. the same reference set under different statistics).
+  typedef std::pair<std::string, std::type_index> Key;
+
+  struct Entry
+  {
+    //! Type-erased shared tree; the Key's type_index guards the cast back.
+    std::shared_ptr<void> tree;
+    //! Mappings from new point indices to old ones, if the tree type
+    //! rearranges its dataset; empty otherwise.
+    std::vector<size_t> oldFromNew;
+  };
+
+  std::map<Key, Entry> trees;
+  mutable std::mutex mapMutex;
+};
+
+/**
+ * Copy-on-write helper for shared trees: if the given tree is shared with
+ * anybody else (including the registry), replace it with a private copy;
+ * otherwise leave it alone.  Call this before mutating a tree obtained from
+ * the TreeRegistry.
+ */
+template<typename TreeType>
+void EnsureUnique(std::shared_ptr<TreeType>& tree)
+{
+  if (tree && tree.use_count() > 1)
+    tree = std::make_shared<TreeType>(*tree);
+}
+
+} // namespace mlpack
+
+#endif
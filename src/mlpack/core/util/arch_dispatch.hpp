@@ -0,0 +1,38 @@
+/**
+ * @file core/util/arch_dispatch.hpp
+ * @author Ryan Curtin
+ *
+ * The MLPACK_TARGET_CLONES macro, which enables runtime ISA dispatch for hot
+ * numeric kernels.  A function marked with this macro is compiled once per
+ * instruction set in the list, and the dynamic loader picks the best version
+ * for the CPU the program actually runs on (via an ifunc resolver).  This
+ * lets a single shipped binary use AVX2 or AVX-512 where available while
+ * still running on older x86-64 machines.
+ *
+ * The macro expands to nothing when the compiler or platform cannot support
+ * function multiversioning (no target_clones attribute, no ELF ifuncs, or a
+ * non-x86 target).  On AArch64, NEON is part of the baseline ISA and the
+ * compiler vectorizes for it by default, so no dispatch is needed there.
+ * Defining MLPACK_NO_TARGET_CLONES disables the mechanism entirely.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_ARCH_DISPATCH_HPP
+#define MLPACK_CORE_UTIL_ARCH_DISPATCH_HPP
+
+#if !defined(MLPACK_NO_TARGET_CLONES) && defined(__has_attribute)
+  #if __has_attribute(target_clones) && defined(__ELF__) && \
+      defined(__x86_64__)
+    #define MLPACK_TARGET_CLONES \
+        __attribute__((target_clones("avx512f", "avx2", "sse4.2", "default")))
+  #endif
+#endif
+
+#ifndef MLPACK_TARGET_CLONES
+  #define MLPACK_TARGET_CLONES
+#endif
+
+#endif
@@ -0,0 +1,159 @@
+/**
+ * @file core/util/execution_policy.hpp
+ * @author Ryan Curtin
+ *
+ * A process-wide parallel execution policy.  mlpack's parallel regions are
+ * all plain OpenMP pragmas, which take their thread count and nesting rules
+ * from the OpenMP runtime's global state; this class is a single place to set
+ * that state, so that one process running several mlpack algorithms (or
+ * several co-located processes on one host, each configured with a share of
+ * the cores) uses a bounded, coordinated thread budget instead of each
+ * algorithm oversubscribing the machine on its own.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_EXECUTION_POLICY_HPP
+#define MLPACK_CORE_UTIL_EXECUTION_POLICY_HPP
+
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace util {
+
+/**
+ * A description of how mlpack's parallel regions should execute: how many
+ * threads they may use, whether they may nest, and how threads should be
+ * bound to cores.  The default-constructed policy leaves everything at the
+ * OpenMP runtime's defaults, so existing behavior is unchanged until a policy
+ * is explicitly applied.
+ *
+ * A policy does nothing until Apply() is called (or a ScopedExecutionPolicy
+ * is constructed from it); Apply() pushes the settings into the OpenMP
+ * runtime, where every algorithm's parallel regions pick them up.  In builds
+ * without OpenMP, policies can be constructed and applied but have no effect,
+ * and MaxThreads() reports 1.
+ *
+ * Typical use, giving mlpack half the machine and forbidding nested
+ * parallelism:
+ *
+ * @code
+ * util::ExecutionPolicy policy;
+ * policy.MaxThreads() = std::thread::hardware_concurrency() / 2;
+ * policy.AllowNested() = false;
+ * policy.Apply();
+ * @endcode
+ */
+class ExecutionPolicy
+{
+ public:
+  /**
+   * How threads are bound to cores.  Binding is a property of the OpenMP
+   * runtime that can only be set before its first parallel region, so a
+   * non-default BindPolicy only takes effect if the policy is applied before
+   * any parallel code has run; after that it is silently ignored by the
+   * runtime.
+   */
+  enum class BindPolicy
+  {
+    //! Leave thread binding at the runtime's default.
+    DEFAULT,
+    //! Bind threads to cores close to the master thread's core.
+    CLOSE,
+    //! Spread threads across the machine's cores.
+    SPREAD
+  };
+
+  /**
+   * Construct a policy that leaves all settings at the OpenMP defaults.
+   */
+  ExecutionPolicy() :
+      maxThreads(0),
+      allowNested(false),
+      bindPolicy(BindPolicy::DEFAULT)
+  { }
+
+  //! Get the thread budget (0 means the OpenMP default).
+  size_t MaxThreads() const { return maxThreads; }
+  //! Modify the thread budget (0 means the OpenMP default).
+  size_t& MaxThreads() { return maxThreads; }
+
+  //! Get whether nested parallel regions may create new threads.
+  bool AllowNested() const { return allowNested; }
+  //! Modify whether nested parallel regions may create new threads.
+  bool& AllowNested() { return allowNested; }
+
+  //! Get the thread binding policy.
+  BindPolicy GetBindPolicy() const { return bindPolicy; }
+  //! Modify the thread binding policy.
+  BindPolicy& GetBindPolicy() { return bindPolicy; }
+
+  /**
+   * Push this policy into the OpenMP runtime, so that all subsequent parallel
+   * regions---in any mlpack algorithm---respect it.  In builds without
+   * OpenMP this is a no-op.
+   */
+  void Apply() const;
+
+  /**
+   * The number of threads parallel regions will actually use under this
+   * policy: the thread budget if one is set, otherwise the OpenMP default (1
+   * in builds without OpenMP).
+   */
+  size_t Threads() const;
+
+  /**
+   * Get the process-wide policy.  Modifications to it do not take effect
+   * until Apply() is called.
+   */
+  static ExecutionPolicy& Global();
+
+ private:
+  //! Maximum number of threads any parallel region may use (0 = default).
+  size_t maxThreads;
+  //! Whether nested parallel regions may create new threads.
+  bool allowNested;
+  //! How threads are bound to cores.
+  BindPolicy bindPolicy;
+};
+
+/**
+ * Apply an execution policy for the lifetime of a scope, restoring the
+ * previous OpenMP thread and nesting settings on destruction.  This is the
+ * form algorithms accept: run one call under a temporary budget without
+ * disturbing the rest of the process.
+ *
+ * @code
+ * {
+ *   ScopedExecutionPolicy scope(policy); // uses policy's budget
+ *   rf.Train(dataset, labels, 5);
+ * } // previous OpenMP settings restored here
+ * @endcode
+ */
+class ScopedExecutionPolicy
+{
+ public:
+  //! Apply the given policy, remembering the current OpenMP settings.
+  ScopedExecutionPolicy(const ExecutionPolicy& policy);
+
+  //! Restore the OpenMP settings from before construction.
+  ~ScopedExecutionPolicy();
+
+ private:
+  //! The thread count to restore.
+  size_t previousThreads;
+  //! The nesting level limit to restore.
+  int previousActiveLevels;
+};
+
+} // namespace util
+} // namespace mlpack
+
+// Include implementation.
+#include "execution_policy_impl.hpp"
+
+#endif
@@ -0,0 +1,89 @@
+/**
+ * @file core/util/execution_policy_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the ExecutionPolicy and ScopedExecutionPolicy classes.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_EXECUTION_POLICY_IMPL_HPP
+#define MLPACK_CORE_UTIL_EXECUTION_POLICY_IMPL_HPP
+
+// In case it hasn't been included.
+#include "execution_policy.hpp"
+
+#include <cstdlib>
+
+namespace mlpack {
+namespace util {
+
+inline void ExecutionPolicy::Apply() const
+{
+#ifdef MLPACK_USE_OPENMP
+  if (maxThreads > 0)
+    omp_set_num_threads((int) maxThreads);
+
+  // One extra active level is enough for the nesting mlpack actually does
+  // (an algorithm-level parallel loop calling into a parallel primitive).
+  omp_set_max_active_levels(allowNested ? 2 : 1);
+
+  // There is no runtime API for thread binding; the environment variable is
+  // read when the OpenMP runtime initializes, so this only has an effect if
+  // no parallel region has run yet.
+  if (bindPolicy != BindPolicy::DEFAULT)
+  {
+    const char* value = (bindPolicy == BindPolicy::CLOSE) ? "close" : "spread";
+    #ifdef _WIN32
+    _putenv_s("OMP_PROC_BIND", value);
+    #else
+    setenv("OMP_PROC_BIND", value, 1);
+    #endif
+  }
+#endif
+}
+
+inline size_t ExecutionPolicy::Threads() const
+{
+  if (maxThreads > 0)
+    return maxThreads;
+#ifdef MLPACK_USE_OPENMP
+  return (size_t) omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+inline ExecutionPolicy& ExecutionPolicy::Global()
+{
+  static ExecutionPolicy policy;
+  return policy;
+}
+
+inline ScopedExecutionPolicy::ScopedExecutionPolicy(
+    const ExecutionPolicy& policy)
+{
+#ifdef MLPACK_USE_OPENMP
+  previousThreads = (size_t) omp_get_max_threads();
+  previousActiveLevels = omp_get_max_active_levels();
+#else
+  previousThreads = 1;
+  previousActiveLevels = 1;
+#endif
+  policy.Apply();
+}
+
+inline ScopedExecutionPolicy::~ScopedExecutionPolicy()
+{
+#ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads((int) previousThreads);
+  omp_set_max_active_levels(previousActiveLevels);
+#endif
+}
+
+} // namespace util
+} // namespace mlpack
+
+#endif
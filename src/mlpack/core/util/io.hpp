@@ -21,6 +21,7 @@
 #include <mlpack/prereqs.hpp>
 
 #include "timers.hpp"
+#include "memory_meter.hpp"
 #include "binding_details.hpp"
 #include "version.hpp"
 
@@ -268,6 +269,11 @@ class IO
    */
   static util::Timers& GetTimers();
 
+  /**
+   * Retrieve the global MemoryMeters object.
+   */
+  static util::MemoryMeters& GetMeters();
+
  private:
   //! Ensure only one thread can call Add() at a time to modify the map.
   std::mutex mapMutex;
@@ -289,9 +295,16 @@ class IO
   //! Holds the timer objects.
   util::Timers timer;
 
+  //! Holds the memory meter objects.
+  util::MemoryMeters meter;
+
   //! So that Timer::Start() and Timer::Stop() can access the timer variable.
   friend class Timer;
 
+  //! So that MemoryMeter::Start() and MemoryMeter::Stop() can access the
+  //! meter variable.
+  friend class MemoryMeter;
+
   /**
    * Make the constructor private, to preclude unauthorized instances.
    */
@@ -314,4 +327,7 @@ class IO
 // Now include the implementation of the timers.
 #include "timers_impl.hpp"
 
+// Now include the implementation of the memory meters.
+#include "memory_meter_impl.hpp"
+
 #endif
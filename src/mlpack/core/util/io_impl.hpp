@@ -185,6 +185,12 @@ inline util::Timers& IO::GetTimers()
   return GetSingleton().timer;
 }
 
+// Returns the sole instance of the memory meters.
+inline util::MemoryMeters& IO::GetMeters()
+{
+  return GetSingleton().meter;
+}
+
 /**
  * Return a new Params object initialized with all the parameters of the
  * binding `bindingName`.  This is intended to be called at the beginning of
@@ -0,0 +1,249 @@
+/**
+ * @file core/util/memory_meter.hpp
+ * @author Ryan Curtin
+ *
+ * Memory meters for mlpack, the memory-usage counterpart of the timers.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTILITIES_MEMORY_METER_HPP
+#define MLPACK_CORE_UTILITIES_MEMORY_METER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace mlpack {
+
+namespace util {
+
+/**
+ * The memory usage recorded for one named meter.  Like the timers, meters are
+ * additive for each time they are run: the RSS delta and allocation counts
+ * accumulate over repeated Start()/Stop() runs, and the peak is the maximum
+ * over all runs.
+ */
+struct MemoryUsage
+{
+  //! Change in the process resident set size over the metered region(s), in
+  //! bytes.  This can be negative, e.g. if a region frees more than it
+  //! allocates.
+  int64_t rssDelta = 0;
+  //! The highest process peak RSS observed while the region was metered, in
+  //! bytes.
+  size_t peakRss = 0;
+  //! Bytes reported to RecordAllocation() while the region was metered.
+  uint64_t allocBytes = 0;
+  //! Number of allocations reported to RecordAllocation() while the region
+  //! was metered.
+  uint64_t allocCount = 0;
+};
+
+} // namespace util
+
+/**
+ * The memory meter class provides a way for mlpack methods to have their
+ * memory usage measured, in the same way that the Timer class provides wall
+ * time.  A named meter samples the process resident set size (RSS) and peak
+ * RSS when it is started and stopped, so the recorded numbers reflect what
+ * the operating system actually committed for the stage---which is what
+ * matters when sizing a production host.  A named meter is specific to the
+ * thread it is running on, so if you start a meter in one thread, it cannot
+ * be stopped from a different thread.
+ *
+ * RSS sampling cannot see individual allocations.  If the application
+ * replaces the global allocator (mlpack itself cannot, since it is
+ * header-only), the replacement can call MemoryMeter::RecordAllocation() to
+ * additionally have bytes and allocation counts attributed to whatever
+ * meters are running.
+ */
+class MemoryMeter
+{
+ public:
+  /**
+   * Start the given meter.  If a meter is started, then stopped, then
+   * re-started, then re-stopped, the recorded RSS delta and allocation counts
+   * are the sums over both runs, and the recorded peak is the maximum over
+   * both runs---that is, mlpack memory meters are additive in the same way
+   * that mlpack timers are, and do not reset.
+   *
+   * @note A std::runtime_error exception will be thrown if a meter is started
+   * twice.
+   *
+   * @param name Name of meter to be started.
+   */
+  static void Start(const std::string& name);
+
+  /**
+   * Stop the given meter.
+   *
+   * @note A std::runtime_error exception will be thrown if the meter is not
+   * currently running.
+   *
+   * @param name Name of meter to be stopped.
+   */
+  static void Stop(const std::string& name);
+
+  /**
+   * Get the value of the given meter.
+   *
+   * @param name Name of meter to return value of.
+   */
+  static util::MemoryUsage Get(const std::string& name);
+
+  /**
+   * Record an allocation of the given size, attributing it to all meters that
+   * are currently running.  This is a hook for applications that replace the
+   * global allocator; mlpack never calls it itself.
+   *
+   * @param bytes Size of the allocation in bytes.
+   */
+  static void RecordAllocation(const size_t bytes);
+
+  /**
+   * Enable memory metering of mlpack programs.  Do not run this while meters
+   * are running!
+   */
+  static void EnableMetering();
+
+  /**
+   * Disable memory metering of mlpack programs.  Do not run this while meters
+   * are running!
+   */
+  static void DisableMetering();
+
+  /**
+   * Stop and reset all running meters.  This removes all knowledge of any
+   * existing meters.
+   */
+  static void ResetAll();
+
+  /**
+   * Returns a copy of all the meters used via this interface.
+   */
+  static std::map<std::string, util::MemoryUsage> GetAllMeters();
+};
+
+namespace util {
+
+class MemoryMeters
+{
+ public:
+  //! Default to disabled.
+  MemoryMeters() : allocBytes(0), allocCount(0), enabled(false) { }
+
+  /**
+   * Returns a copy of all the meters used via this interface.
+   */
+  std::map<std::string, MemoryUsage> GetAllMeters();
+
+  /**
+   * Reset the meters.  This stops all running meters and removes them.
+   * Whether or not metering is enabled will not be changed.
+   */
+  void Reset();
+
+  /**
+   * Returns a copy of the meter specified.  This contains the accumulated
+   * usage for meters that have been stopped with this name.
+   *
+   * @param meterName The name of the meter in question.
+   */
+  MemoryUsage Get(const std::string& meterName);
+
+  /**
+   * Print the given memory usage in a human-readable form (RSS delta, peak
+   * RSS, and allocation counts if any were recorded).
+   *
+   * @param usage The memory usage to print.
+   */
+  static std::string Print(const MemoryUsage& usage);
+
+  /**
+   * Get the current resident set size of the process, in bytes.  Returns 0 if
+   * the value cannot be determined on this platform.
+   */
+  static size_t CurrentRSS();
+
+  /**
+   * Get the peak resident set size of the process, in bytes.  Returns 0 if
+   * the value cannot be determined on this platform.
+   */
+  static size_t PeakRSS();
+
+  /**
+   * Start a meter, sampling the current RSS and allocation counters.  If a
+   * meter is started, then stopped, then re-started, then stopped, the final
+   * meter value accumulates both runs of the meter.
+   *
+   * @param meterName The name of the meter in question.
+   * @param threadId Id of the thread accessing the meter.
+   */
+  void Start(const std::string& meterName,
+             const std::thread::id& threadId = std::thread::id());
+
+  /**
+   * Stop a meter, adding the sampled deltas to its accumulated value.
+   *
+   * @param meterName The name of the meter in question.
+   * @param threadId Id of the thread accessing the meter.
+   */
+  void Stop(const std::string& meterName,
+            const std::thread::id& threadId = std::thread::id());
+
+  /**
+   * Stop all meters.
+   */
+  void StopAllMeters();
+
+  /**
+   * Record an allocation of the given size; see
+   * MemoryMeter::RecordAllocation().
+   *
+   * @param bytes Size of the allocation in bytes.
+   */
+  void RecordAllocation(const size_t bytes);
+
+  //! Modify whether or not metering is enabled.
+  std::atomic<bool>& Enabled() { return enabled; }
+  //! Get whether or not metering is enabled.
+  bool Enabled() const { return enabled; }
+
+ private:
+  //! The counters sampled when a meter is started.
+  struct MeterStart
+  {
+    size_t startRss;
+    uint64_t startAllocBytes;
+    uint64_t startAllocCount;
+  };
+
+  //! A map of all the meters that are being tracked.
+  std::map<std::string, MemoryUsage> meters;
+  //! A mutex for modifying the meters.
+  std::mutex metersMutex;
+  //! A map for the starting samples of the meters.
+  std::map<std::thread::id, std::map<std::string, MeterStart>> meterStart;
+
+  //! Total bytes reported via RecordAllocation() since construction.
+  std::atomic<uint64_t> allocBytes;
+  //! Total allocations reported via RecordAllocation() since construction.
+  std::atomic<uint64_t> allocCount;
+
+  //! Whether or not metering is enabled.
+  std::atomic<bool> enabled;
+};
+
+} // namespace util
+} // namespace mlpack
+
+// Note that the implementation is not included, to avoid include ordering
+// issues!
+
+#endif // MLPACK_CORE_UTILITIES_MEMORY_METER_HPP
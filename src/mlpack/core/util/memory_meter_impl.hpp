@@ -0,0 +1,302 @@
+/**
+ * @file core/util/memory_meter_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of memory meters.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "memory_meter.hpp"
+
+#include "forward.hpp"
+#include "io.hpp"
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+// Platform-specific headers for sampling the process resident set size.
+#if defined(_WIN32)
+  #include <windows.h>
+  #include <psapi.h>
+#elif defined(__APPLE__)
+  #include <mach/mach.h>
+  #include <sys/resource.h>
+#elif defined(__unix__) || defined(__linux__)
+  #include <sys/resource.h>
+  #include <unistd.h>
+  #include <cstdio>
+#endif
+
+namespace mlpack {
+
+/**
+ * Start the given meter.
+ */
+inline void MemoryMeter::Start(const std::string& name)
+{
+  IO::GetSingleton().meter.Start(name, std::this_thread::get_id());
+}
+
+/**
+ * Stop the given meter.
+ */
+inline void MemoryMeter::Stop(const std::string& name)
+{
+  IO::GetSingleton().meter.Stop(name, std::this_thread::get_id());
+}
+
+/**
+ * Get the given meter.
+ */
+inline util::MemoryUsage MemoryMeter::Get(const std::string& name)
+{
+  return IO::GetSingleton().meter.Get(name);
+}
+
+// Record an allocation made by an application-provided allocator hook.
+inline void MemoryMeter::RecordAllocation(const size_t bytes)
+{
+  IO::GetSingleton().meter.RecordAllocation(bytes);
+}
+
+// Enable metering.
+inline void MemoryMeter::EnableMetering()
+{
+  IO::GetSingleton().meter.Enabled() = true;
+}
+
+// Disable metering.
+inline void MemoryMeter::DisableMetering()
+{
+  IO::GetSingleton().meter.Enabled() = false;
+}
+
+// Reset all meters.  Save state of enabled.
+inline void MemoryMeter::ResetAll()
+{
+  IO::GetSingleton().meter.Reset();
+}
+
+inline std::map<std::string, util::MemoryUsage> MemoryMeter::GetAllMeters()
+{
+  return IO::GetSingleton().meter.GetAllMeters();
+}
+
+namespace util {
+
+// Reset a MemoryMeters object.
+inline void MemoryMeters::Reset()
+{
+  std::lock_guard<std::mutex> lock(metersMutex);
+  meters.clear();
+  meterStart.clear();
+}
+
+inline std::map<std::string, MemoryUsage> MemoryMeters::GetAllMeters()
+{
+  // Make a copy of the meters.
+  std::lock_guard<std::mutex> lock(metersMutex);
+  return meters;
+}
+
+inline MemoryUsage MemoryMeters::Get(const std::string& meterName)
+{
+  if (!enabled)
+    return MemoryUsage();
+
+  std::lock_guard<std::mutex> lock(metersMutex);
+  return meters[meterName];
+}
+
+inline std::string MemoryMeters::Print(const MemoryUsage& usage)
+{
+  // Print a byte count with a convenient unit.
+  auto bytesString = [](const double bytes)
+  {
+    std::ostringstream unitOss;
+    unitOss << std::fixed << std::setprecision(1);
+    const double absBytes = std::abs(bytes);
+    if (absBytes >= 1073741824.0)
+      unitOss << bytes / 1073741824.0 << " GiB";
+    else if (absBytes >= 1048576.0)
+      unitOss << bytes / 1048576.0 << " MiB";
+    else if (absBytes >= 1024.0)
+      unitOss << bytes / 1024.0 << " KiB";
+    else
+      unitOss << (int64_t) bytes << " B";
+    return unitOss.str();
+  };
+
+  std::ostringstream oss;
+  oss << "RSS delta " << (usage.rssDelta >= 0 ? "+" : "")
+      << bytesString((double) usage.rssDelta) << "; peak RSS "
+      << bytesString((double) usage.peakRss);
+
+  // Allocation counts are only available if the application installed an
+  // allocator hook; don't print zeros when it didn't.
+  if (usage.allocCount > 0)
+  {
+    oss << "; " << usage.allocCount << " allocations ("
+        << bytesString((double) usage.allocBytes) << ")";
+  }
+
+  oss << std::endl;
+  return oss.str();
+}
+
+inline size_t MemoryMeters::CurrentRSS()
+{
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS pmc;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+    return (size_t) pmc.WorkingSetSize;
+  return 0;
+#elif defined(__APPLE__)
+  mach_task_basic_info info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t) &info,
+      &count) == KERN_SUCCESS)
+    return (size_t) info.resident_size;
+  return 0;
+#elif defined(__unix__) || defined(__linux__)
+  // The second field of /proc/self/statm is the resident set size, in pages.
+  long rssPages = 0;
+  FILE* f = fopen("/proc/self/statm", "r");
+  if (f == NULL)
+    return 0;
+  if (fscanf(f, "%*ld %ld", &rssPages) != 1)
+    rssPages = 0;
+  fclose(f);
+  return (size_t) rssPages * (size_t) sysconf(_SC_PAGESIZE);
+#else
+  return 0;
+#endif
+}
+
+inline size_t MemoryMeters::PeakRSS()
+{
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS pmc;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+    return (size_t) pmc.PeakWorkingSetSize;
+  return 0;
+#elif defined(__APPLE__)
+  // On OS X, ru_maxrss is reported in bytes.
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+    return (size_t) usage.ru_maxrss;
+  return 0;
+#elif defined(__unix__) || defined(__linux__)
+  // On Linux, ru_maxrss is reported in kilobytes.
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+    return (size_t) usage.ru_maxrss * 1024;
+  return 0;
+#else
+  return 0;
+#endif
+}
+
+inline void MemoryMeters::StopAllMeters()
+{
+  // Terminate the running meters.  Don't use Stop() since that modifies the
+  // map and would invalidate our iterators.
+  std::lock_guard<std::mutex> lock(metersMutex);
+
+  const size_t currRss = CurrentRSS();
+  const size_t peakRss = PeakRSS();
+  for (auto it : meterStart)
+  {
+    for (auto it2 : it.second)
+    {
+      MemoryUsage& usage = meters[it2.first];
+      usage.rssDelta += (int64_t) currRss - (int64_t) it2.second.startRss;
+      usage.peakRss = std::max(usage.peakRss, peakRss);
+      usage.allocBytes += allocBytes - it2.second.startAllocBytes;
+      usage.allocCount += allocCount - it2.second.startAllocCount;
+    }
+  }
+
+  // If all meters are stopped, we can clear the maps.
+  meterStart.clear();
+}
+
+inline void MemoryMeters::Start(const std::string& meterName,
+                                const std::thread::id& threadId)
+{
+  // Don't do anything if we aren't metering.
+  if (!enabled)
+    return;
+
+  std::lock_guard<std::mutex> lock(metersMutex);
+
+  if ((meterStart.count(threadId) > 0) &&
+      (meterStart[threadId].count(meterName)))
+  {
+    std::ostringstream error;
+    error << "MemoryMeter::Start(): meter '" << meterName
+        << "' has already been started";
+    throw std::runtime_error(error.str());
+  }
+
+  // If the meter is added for the first time.
+  if (meters.count(meterName) == 0)
+  {
+    meters[meterName] = MemoryUsage();
+  }
+
+  MeterStart start;
+  start.startRss = CurrentRSS();
+  start.startAllocBytes = allocBytes;
+  start.startAllocCount = allocCount;
+  meterStart[threadId][meterName] = start;
+}
+
+inline void MemoryMeters::Stop(const std::string& meterName,
+                               const std::thread::id& threadId)
+{
+  // Don't do anything if we aren't metering.
+  if (!enabled)
+    return;
+
+  std::lock_guard<std::mutex> lock(metersMutex);
+
+  if ((meterStart.count(threadId) == 0) ||
+      (meterStart[threadId].count(meterName) == 0))
+  {
+    std::ostringstream error;
+    error << "MemoryMeter::Stop(): no meter with name '" << meterName
+        << "' currently running";
+    throw std::runtime_error(error.str());
+  }
+
+  // Add the sampled deltas to the accumulated usage.
+  const MeterStart& start = meterStart[threadId][meterName];
+  MemoryUsage& usage = meters[meterName];
+  usage.rssDelta += (int64_t) CurrentRSS() - (int64_t) start.startRss;
+  usage.peakRss = std::max(usage.peakRss, PeakRSS());
+  usage.allocBytes += allocBytes - start.startAllocBytes;
+  usage.allocCount += allocCount - start.startAllocCount;
+
+  // Remove the entries.
+  meterStart[threadId].erase(meterName);
+  if (meterStart[threadId].empty())
+    meterStart.erase(threadId);
+}
+
+inline void MemoryMeters::RecordAllocation(const size_t bytes)
+{
+  // Don't do anything if we aren't metering.
+  if (!enabled)
+    return;
+
+  allocBytes += bytes;
+  ++allocCount;
+}
+
+} // namespace util
+} // namespace mlpack
@@ -86,38 +86,20 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
   // To be used for prediction by the weak learner.
   arma::Row<size_t> predictedLabels(labels.n_cols);
 
-  // Use tempData to modify input data for incorporating weights.
-  MatType tempData(data);
+  // The numClasses x n_cols weight matrix of AdaBoost.MH never needs to be
+  // materialized: it starts uniform, and every round multiplies all of a
+  // point's per-class weights by the same factor.  So we only track the
+  // per-point column sums, which is also what the weak learner trains with.
+  arma::rowvec weights(data.n_cols);
+  weights.fill(1.0 / double(data.n_cols));
 
-  // This matrix is a helper matrix used to calculate the final hypothesis.
-  arma::mat sumFinalH = arma::zeros<arma::mat>(numClasses,
-      predictedLabels.n_cols);
-
-  // Load the initial weights into a 2-D matrix.
-  const double initWeight = 1.0 / double(data.n_cols * numClasses);
-  arma::mat D(numClasses, data.n_cols);
-  D.fill(initWeight);
-
-  // Weights are stored in this row vector.
-  arma::rowvec weights(predictedLabels.n_cols);
-
-  // This is the final hypothesis.
-  arma::Row<size_t> finalH(predictedLabels.n_cols);
+  // Indicator of whether the weak learner classified each point correctly
+  // (+1) or not (-1); used for the weighted error and the weight update.
+  arma::rowvec correctness(data.n_cols);
 
   // Now, start the boosting rounds.
   for (size_t i = 0; i < iterations; ++i)
   {
-    // Initialized to zero in every round.  rt is used for calculation of
-    // alphat; it is the weighted error.
-    // rt = (sum) D(i) y(i) ht(xi)
-    rt = 0.0;
-
-    // zt is used for weight normalization.
-    zt = 0.0;
-
-    // Build the weight vectors.
-    weights = arma::sum(D);
-
     // Use the existing weak learner to train a new one with new weights.
     // API requirement: there is a constructor with this signature:
     //
@@ -130,27 +112,20 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     // This trains the new WeakLearnerType using the hyperparameters from the
     // given WeakLearnerType.
 
-    WeakLearnerType w(other, tempData, labels, numClasses, weights);
+    WeakLearnerType w(other, data, labels, numClasses, weights);
     // There is a bug with Adaboost!  It will not use the specified
     // hyperparameters for the decision tree because they are not properly
     // passed to the new weak learners!  (And: it's a hard bug, because the
     // decision tree itself doesn't even store the hyperparameters it was
     // trained with!)
 
-    // DecisionTree(DecisionTree&, MatType&, LabelsType&, size_t, WeightsType&, double = 0.0, double = 0.0, ...);
-    w.Classify(tempData, predictedLabels);
+    w.Classify(data, predictedLabels);
 
-    // Now from predictedLabels, build ht, the weak hypothesis
-    // buildClassificationMatrix(ht, predictedLabels);
-
-    // Now, calculate alpha(t) using ht.
-    for (size_t j = 0; j < D.n_cols; ++j) // instead of D, ht
-    {
-      if (predictedLabels(j) == labels(j))
-        rt += arma::accu(D.col(j));
-      else
-        rt -= arma::accu(D.col(j));
-    }
+    // Now, calculate alpha(t) from the weighted error.
+    // rt = (sum) D(i) y(i) ht(xi)
+    correctness = 2.0 * arma::conv_to<arma::rowvec>::from(
+        predictedLabels == labels) - 1.0;
+    rt = arma::accu(weights % correctness);
 
     if ((i > 0) && (std::abs(rt - crt) < tolerance))
       break;
@@ -173,45 +148,12 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     alpha.push_back(alphat);
     wl.push_back(w);
 
-    // Now start modifying the weights.
-    for (size_t j = 0; j < D.n_cols; ++j)
-    {
-      const double expo = exp(alphat);
-      if (predictedLabels(j) == labels(j))
-      {
-        for (size_t k = 0; k < D.n_rows; ++k)
-        {
-          // We calculate zt, the normalization constant.
-          D(k, j) /= expo;
-          zt += D(k, j); // * exp(-1 * alphat * yt(j,k) * ht(j,k));
-
-          // Add to the final hypothesis matrix.
-          // sumFinalH(k, j) += (alphat * ht(k, j));
-          if (k == labels(j))
-            sumFinalH(k, j) += (alphat); // * ht(k, j));
-          else
-            sumFinalH(k, j) -= (alphat);
-        }
-      }
-      else
-      {
-        for (size_t k = 0; k < D.n_rows; ++k)
-        {
-          // We calculate zt, the normalization constant.
-          D(k, j) *= expo;
-          zt += D(k, j);
-
-          // Add to the final hypothesis matrix.
-          if (k == labels(j))
-            sumFinalH(k, j) += alphat; // * ht(k, j));
-          else
-            sumFinalH(k, j) -= alphat;
-        }
-      }
-    }
-
-    // Normalize D.
-    D /= zt;
+    // Now modify the weights: correctly classified points are scaled by
+    // exp(-alphat) and misclassified points by exp(alphat); then normalize.
+    // zt is the normalization constant.
+    weights %= arma::exp(-alphat * correctness);
+    zt = arma::accu(weights);
+    weights /= zt;
 
     // Accumulate the value of zt for the Hamming loss bound.
     ztProduct *= zt;
@@ -255,14 +197,10 @@ void AdaBoost<WeakLearnerType, MatType>::Classify(
       probabilities(tempPredictedLabels(j), j) += alpha[i];
   }
 
-  arma::uword maxIndex = 0;
-
-  for (size_t i = 0; i < predictedLabels.n_cols; ++i)
-  {
-    probabilities.col(i) /= arma::accu(probabilities.col(i));
-    probabilities.col(i).max(maxIndex);
-    predictedLabels(i) = maxIndex;
-  }
+  // Normalize the probabilities and take the maximum class for each point.
+  probabilities.each_row() /= arma::sum(probabilities, 0);
+  predictedLabels = arma::conv_to<arma::Row<size_t>>::from(
+      arma::index_max(probabilities, 0));
 }
 
 /**
@@ -17,5 +17,6 @@
 #include "merge_init.hpp"
 #include "random_acol_init.hpp"
 #include "random_init.hpp"
+#include "warm_start_init.hpp"
 
 #endif
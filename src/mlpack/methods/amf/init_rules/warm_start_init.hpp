@@ -0,0 +1,162 @@
+/**
+ * @file methods/amf/init_rules/warm_start_init.hpp
+ *
+ * Initialization rule for alternating matrix factorization (AMF) that seeds
+ * the factorization from a previous solution, so that refits of a slightly
+ * changed matrix converge in far fewer iterations than a cold start.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_AMF_INIT_RULES_WARM_START_INIT_HPP
+#define MLPACK_METHODS_AMF_INIT_RULES_WARM_START_INIT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * This initialization rule for AMF seeds W and H from the factors of a
+ * previous factorization.  Unlike GivenInitialization, the new matrix V does
+ * not need to have the same shape as the matrix the previous factors were
+ * fit to, and the requested rank does not need to match the previous rank:
+ *
+ *  - Columns of V beyond those covered by the previous H are initialized by
+ *    projecting them onto the previous basis (a least-squares solve against
+ *    the old W, clamped to remain nonnegative), so new columns start close to
+ *    their converged encoding instead of at random.
+ *  - If the requested rank exceeds the previous rank, the extra columns of W
+ *    are filled by averaging random columns of V (as RandomAcolInitialization
+ *    does) and the extra rows of H with small random values, so the new
+ *    components refine the warm-started solution rather than disrupting it.
+ *
+ * This is useful when a factorization is refit periodically on a matrix that
+ * grows by a small fraction of new columns: the previous solution is already
+ * near-optimal for the overlapping part, and warm-starting lets a much
+ * smaller iteration budget reach the same residue.
+ */
+class WarmStartInitialization
+{
+ public:
+  // Empty constructor required for the InitializeRule template.
+  WarmStartInitialization() { }
+
+  // Initialize with the factors of a previous factorization.
+  WarmStartInitialization(const arma::mat& w, const arma::mat& h) :
+      w(w), h(h)
+  { }
+
+  // Initialize with the factors of a previous factorization, taking control
+  // of the given matrices.
+  WarmStartInitialization(arma::mat&& w, arma::mat&& h) :
+      w(std::move(w)), h(std::move(h))
+  { }
+
+  /**
+   * Seed W and H from the previous factors, initializing any new columns of
+   * V by projection onto the previous basis and any new rank components
+   * randomly.
+   *
+   * @param V Input matrix.
+   * @param r Rank of decomposition.
+   * @param W W matrix, to be seeded from the previous basis.
+   * @param H H matrix, to be seeded from the previous encoding.
+   */
+  template<typename MatType>
+  inline void Initialize(const MatType& V,
+                         const size_t r,
+                         arma::mat& W,
+                         arma::mat& H)
+  {
+    // Make sure the previous factors are present and compatible with V.
+    if (w.is_empty() || h.is_empty())
+    {
+      Log::Fatal << "No previous factors to warm-start from!" << std::endl;
+    }
+    if (w.n_rows != V.n_rows)
+    {
+      Log::Fatal << "The number of rows in previous W (" << w.n_rows
+          << ") doesn't equal the number of rows in V (" << V.n_rows
+          << ") !" << std::endl;
+    }
+    if (w.n_cols != h.n_rows)
+    {
+      Log::Fatal << "The previous W (rank " << w.n_cols << ") and H (rank "
+          << h.n_rows << ") don't have matching ranks!" << std::endl;
+    }
+    if (r < w.n_cols)
+    {
+      Log::Fatal << "The rank of factorization (" << r << ") is less than "
+          << "the previous rank (" << w.n_cols << "); the rank can only be "
+          << "kept or grown when warm-starting!" << std::endl;
+    }
+    if (h.n_cols > V.n_cols)
+    {
+      Log::Fatal << "The number of columns in previous H (" << h.n_cols
+          << ") exceeds the number of columns in V (" << V.n_cols
+          << ") !" << std::endl;
+    }
+
+    const size_t oldRank = w.n_cols;
+    const size_t oldCols = h.n_cols;
+
+    // Seed the overlapping part of the factorization from the previous
+    // solution.
+    W.set_size(V.n_rows, r);
+    H.set_size(r, V.n_cols);
+    W.cols(0, oldRank - 1) = w;
+    H.submat(0, 0, oldRank - 1, oldCols - 1) = h;
+
+    // Initialize the encodings of any new columns of V by projecting them
+    // onto the previous basis; clamp to a small positive value to keep the
+    // encodings strictly nonnegative (multiplicative update rules cannot
+    // escape exact zeros).
+    if (oldCols < V.n_cols)
+    {
+      const double minValue = 1e-10;
+      const arma::mat newCols(V.cols(oldCols, V.n_cols - 1));
+      arma::mat proj = arma::solve(w.t() * w, w.t() * newCols);
+      proj.elem(arma::find(proj < minValue)).fill(minValue);
+      H.submat(0, oldCols, oldRank - 1, V.n_cols - 1) = proj;
+    }
+
+    // Initialize any new rank components randomly: new basis columns by
+    // averaging random columns of V (as RandomAcolInitialization does), and
+    // new encoding rows with small random values so they start as a gentle
+    // perturbation of the warm-started solution.
+    if (r > oldRank)
+    {
+      const size_t columnsToAverage = 5;
+      for (size_t col = oldRank; col < r; ++col)
+      {
+        W.col(col).zeros();
+        for (size_t i = 0; i < columnsToAverage; ++i)
+          W.col(col) += V.col(RandInt(0, V.n_cols));
+        W.col(col) /= columnsToAverage;
+      }
+
+      H.rows(oldRank, r - 1).randu();
+      H.rows(oldRank, r - 1) *= 0.01;
+    }
+  }
+
+  //! Serialize the object.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(w));
+    ar(CEREAL_NVP(h));
+  }
+
+ private:
+  //! The W matrix of the previous factorization.
+  arma::mat w;
+  //! The H matrix of the previous factorization.
+  arma::mat h;
+};
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,195 @@
+/**
+ * @file methods/amf/update_rules/svd_parallel_sgd_learning.hpp
+ *
+ * Parallel shuffled SGD factorizer used in AMF (Alternating Matrix
+ * Factorization).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_AMF_SVD_PARALLEL_SGD_LEARNING_HPP
+#define MLPACK_METHODS_AMF_SVD_PARALLEL_SGD_LEARNING_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * This class computes the SVD factorization with stochastic gradient descent
+ * over the nonzero entries only, processed in shuffled blocks that are
+ * dispatched across threads.  The factor updates are applied without locks,
+ * in the style of HOGWILD!:
+ *
+ * @code
+ * @inproceedings{Recht2011,
+ *   author    = {Benjamin Recht and Christopher R{\'{e}} and Stephen J.
+ *                Wright and Feng Niu},
+ *   title     = {Hogwild: {A} Lock-Free Approach to Parallelizing Stochastic
+ *                Gradient Descent},
+ *   booktitle = {Advances in Neural Information Processing Systems 24},
+ *   pages     = {693--701},
+ *   year      = {2011},
+ * }
+ * @endcode
+ *
+ * Because the input matrix is sparse, concurrent updates rarely touch the
+ * same factor row or column, and the occasional lost update does not affect
+ * convergence in practice.  Zero entries are treated as unobserved, like the
+ * incremental rules do.
+ *
+ * One call to WUpdate() performs a full epoch of SGD updates to W over all
+ * nonzero entries (with H fixed), and one call to HUpdate() performs the
+ * matching epoch for H; one AMF iteration therefore corresponds to one
+ * alternating epoch pair, so a per-epoch termination policy such as
+ * SimpleResidueTermination checks convergence exactly once per epoch.
+ *
+ * @see SVDCompleteIncrementalLearning
+ */
+template<class MatType>
+class SVDParallelSGDLearning
+{
+ public:
+  /**
+   * Initialize the parameters of SVDParallelSGDLearning.
+   *
+   * @param u Step size of the stochastic updates.
+   * @param kw Regularization constant for W matrix.
+   * @param kh Regularization constant for H matrix.
+   * @param blockSize Number of nonzero entries processed per scheduled
+   *     block; blocks are shuffled every epoch.
+   */
+  SVDParallelSGDLearning(double u = 0.01,
+                         double kw = 0,
+                         double kh = 0,
+                         size_t blockSize = 4096) :
+      u(u), kw(kw), kh(kh), blockSize(blockSize)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Initialize parameters before factorization.  This function must be
+   * called before a new factorization; it gathers the coordinates and values
+   * of the nonzero entries, so the epochs touch only observed entries.
+   *
+   * @param dataset Input matrix to be factorized.
+   * @param * (rank) Rank of factorization.
+   */
+  void Initialize(const MatType& dataset, const size_t /* rank */)
+  {
+    entryRows.clear();
+    entryCols.clear();
+    entryVals.clear();
+
+    for (typename MatType::const_row_col_iterator it = dataset.begin_row_col();
+        it != dataset.end_row_col(); ++it)
+    {
+      if (*it == 0.0)
+        continue;
+
+      entryRows.push_back(it.row());
+      entryCols.push_back(it.col());
+      entryVals.push_back(*it);
+    }
+  }
+
+  /**
+   * The update rule for the basis matrix W: one epoch of lock-free SGD
+   * updates to the rows of W over all nonzero entries, in shuffled block
+   * order, with H fixed.
+   *
+   * @param * (V) Input matrix to be factorized.
+   * @param W Basis matrix to be updated.
+   * @param H Encoding matrix.
+   */
+  inline void WUpdate(const MatType& /* V */,
+                      arma::mat& W,
+                      const arma::mat& H)
+  {
+    if (entryVals.empty())
+      return;
+
+    const arma::uvec blockOrder = ShuffledBlockOrder();
+
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t b = 0; b < blockOrder.n_elem; ++b)
+    {
+      const size_t first = blockOrder[b] * blockSize;
+      const size_t last = std::min(first + blockSize, entryVals.size());
+
+      for (size_t e = first; e < last; ++e)
+      {
+        const size_t i = entryRows[e];
+        const size_t j = entryCols[e];
+
+        const double err = entryVals[e] - arma::dot(W.row(i), H.col(j));
+        W.row(i) += u * (err * H.col(j).t() - kw * W.row(i));
+      }
+    }
+  }
+
+  /**
+   * The update rule for the encoding matrix H: one epoch of lock-free SGD
+   * updates to the columns of H over all nonzero entries, in shuffled block
+   * order, with W fixed.
+   *
+   * @param * (V) Input matrix to be factorized.
+   * @param W Basis matrix.
+   * @param H Encoding matrix to be updated.
+   */
+  inline void HUpdate(const MatType& /* V */,
+                      const arma::mat& W,
+                      arma::mat& H)
+  {
+    if (entryVals.empty())
+      return;
+
+    const arma::uvec blockOrder = ShuffledBlockOrder();
+
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t b = 0; b < blockOrder.n_elem; ++b)
+    {
+      const size_t first = blockOrder[b] * blockSize;
+      const size_t last = std::min(first + blockSize, entryVals.size());
+
+      for (size_t e = first; e < last; ++e)
+      {
+        const size_t i = entryRows[e];
+        const size_t j = entryCols[e];
+
+        const double err = entryVals[e] - arma::dot(W.row(i), H.col(j));
+        H.col(j) += u * (err * W.row(i).t() - kh * H.col(j));
+      }
+    }
+  }
+
+ private:
+  //! Return a freshly shuffled order of the entry blocks.
+  arma::uvec ShuffledBlockOrder() const
+  {
+    const size_t numBlocks = (entryVals.size() + blockSize - 1) / blockSize;
+    return arma::shuffle(arma::regspace<arma::uvec>(0, numBlocks - 1));
+  }
+
+  //! Step size of the stochastic updates.
+  double u;
+  //! Regularization parameter for matrix W.
+  double kw;
+  //! Regularization parameter for matrix H.
+  double kh;
+  //! Number of nonzero entries per scheduled block.
+  size_t blockSize;
+
+  //! Row indices of the nonzero entries.
+  std::vector<arma::uword> entryRows;
+  //! Column indices of the nonzero entries.
+  std::vector<arma::uword> entryCols;
+  //! Values of the nonzero entries.
+  std::vector<double> entryVals;
+}; // class SVDParallelSGDLearning
+
+} // namespace mlpack
+
+#endif
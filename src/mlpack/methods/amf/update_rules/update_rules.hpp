@@ -18,5 +18,6 @@
 #include "svd_batch_learning.hpp"
 #include "svd_incomplete_incremental_learning.hpp"
 #include "svd_complete_incremental_learning.hpp"
+#include "svd_parallel_sgd_learning.hpp"
 
 #endif
@@ -28,6 +28,9 @@
 #include "loss_functions/loss_functions.hpp"
 #include "regularizer/regularizer.hpp"
 
+#include "async_validation.hpp"
+#include "fused_update_policies.hpp"
+
 #include "ffn.hpp"
 #include "rnn.hpp"
 
@@ -0,0 +1,228 @@
+/**
+ * @file methods/ann/async_validation.hpp
+ *
+ * An ensmallen callback that evaluates a validation set on a background
+ * thread while training continues.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_ASYNC_VALIDATION_HPP
+#define MLPACK_METHODS_ANN_ASYNC_VALIDATION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace mlpack {
+
+/**
+ * An ensmallen callback that computes the validation objective of a network
+ * during training without stalling the optimizer.  At the end of every
+ * `interval`-th epoch, the current parameters are snapshotted (a single
+ * copy of the parameter vector) and a background thread evaluates a private
+ * copy of the network---with its own forward-pass workspace---on the held-out
+ * set.  The training loop only ever pays for the snapshot copy, not for the
+ * validation forward passes.
+ *
+ * If a validation pass is still running when the next epoch ends, that epoch
+ * is skipped rather than queued, so at most one background evaluation is in
+ * flight at a time.
+ *
+ * Optionally, the callback implements convergence-based early stopping: if
+ * `patience` is nonzero and the validation objective has not improved in
+ * `patience` consecutive published evaluations, training is terminated.
+ * Because evaluations are asynchronous, the stop takes effect one epoch
+ * later than a synchronous check would.
+ *
+ * A typical use, with `model` an `FFN` (or `RNN`, with cube-shaped data):
+ *
+ * @code
+ * AsyncValidation<FFN<>> cb(model, validData, validResponses);
+ * model.Train(data, responses, optimizer, cb);
+ * cb.Wait();
+ * Log::Info << "final validation loss: " << cb.LastObjective() << std::endl;
+ * @endcode
+ *
+ * @tparam ModelType The network type being trained (e.g. `FFN<>` or `RNN<>`).
+ * @tparam InputType Matrix type of the validation predictors.
+ * @tparam OutputType Matrix type of the validation responses.
+ */
+template<typename ModelType,
+         typename InputType = arma::mat,
+         typename OutputType = arma::mat>
+class AsyncValidation
+{
+ public:
+  /**
+   * Construct the callback.  The validation data are copied so that the
+   * background thread never races with the caller.
+   *
+   * @param model The network being trained.  A private copy is made, so the
+   *    background evaluation does not share any forward-pass state with the
+   *    trainer.
+   * @param validationData Held-out predictors.
+   * @param validationResponses Held-out responses.
+   * @param interval Evaluate every `interval` epochs (default every epoch).
+   * @param patience If nonzero, terminate training after this many
+   *    consecutive evaluations without improvement of the validation
+   *    objective.
+   */
+  AsyncValidation(const ModelType& model,
+                  InputType validationData,
+                  OutputType validationResponses,
+                  const size_t interval = 1,
+                  const size_t patience = 0) :
+      shadowModel(model),
+      validationData(std::move(validationData)),
+      validationResponses(std::move(validationResponses)),
+      interval(interval),
+      patience(patience),
+      bestObjective(DBL_MAX),
+      sinceImprovement(0),
+      evaluating(false)
+  {
+    if (interval == 0)
+      throw std::invalid_argument("AsyncValidation: interval must be "
+          "positive!");
+  }
+
+  //! The callback owns a thread, so it cannot be copied or moved.
+  AsyncValidation(const AsyncValidation&) = delete;
+  AsyncValidation& operator=(const AsyncValidation&) = delete;
+
+  //! Wait for any in-flight evaluation before destruction.
+  ~AsyncValidation() { Wait(); }
+
+  /**
+   * Callback function called at the end of an epoch; this launches the
+   * background validation pass.
+   *
+   * @param * (optimizer) The optimizer used to update the function.
+   * @param * (function) The function to be optimized.
+   * @param coordinates The current function parameters.
+   * @param epoch The index of the current epoch.
+   * @param * (objective) The training objective of the current epoch.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  bool EndEpoch(OptimizerType& /* optimizer */,
+                FunctionType& /* function */,
+                const MatType& coordinates,
+                const size_t epoch,
+                const double /* objective */)
+  {
+    if (epoch % interval != 0)
+      return StopRequested();
+
+    // If the previous evaluation has not finished, skip this epoch instead
+    // of queueing behind it.
+    if (evaluating.load())
+      return StopRequested();
+    Wait();
+
+    // Snapshot the parameters; this copy is the only cost the training loop
+    // pays for the evaluation.
+    snapshot = coordinates;
+
+    evaluating.store(true);
+    worker = std::thread([this, epoch]()
+    {
+      shadowModel.Parameters() = std::move(snapshot);
+      const double objective = (double) shadowModel.Evaluate(validationData,
+          validationResponses);
+
+      std::lock_guard<std::mutex> lock(resultsMutex);
+      history.emplace_back(epoch, objective);
+      if (objective < bestObjective)
+      {
+        bestObjective = objective;
+        sinceImprovement = 0;
+      }
+      else
+      {
+        ++sinceImprovement;
+      }
+      evaluating.store(false);
+    });
+
+    return StopRequested();
+  }
+
+  //! Block until any in-flight validation pass has published its result.
+  void Wait()
+  {
+    if (worker.joinable())
+      worker.join();
+  }
+
+  //! Get the most recently published validation objective, or DBL_MAX if no
+  //! evaluation has completed yet.
+  double LastObjective() const
+  {
+    std::lock_guard<std::mutex> lock(resultsMutex);
+    return history.empty() ? DBL_MAX : history.back().second;
+  }
+
+  //! Get the best validation objective seen so far.
+  double BestObjective() const
+  {
+    std::lock_guard<std::mutex> lock(resultsMutex);
+    return bestObjective;
+  }
+
+  //! Get all published (epoch, objective) pairs, in order of publication.
+  std::vector<std::pair<size_t, double>> Evaluations() const
+  {
+    std::lock_guard<std::mutex> lock(resultsMutex);
+    return history;
+  }
+
+ private:
+  //! Whether the early-stopping condition has been met.
+  bool StopRequested() const
+  {
+    if (patience == 0)
+      return false;
+
+    std::lock_guard<std::mutex> lock(resultsMutex);
+    return sinceImprovement >= patience;
+  }
+
+  //! Private copy of the network, with its own forward-pass workspace.
+  ModelType shadowModel;
+
+  //! Held-out predictors (owned, so the thread cannot race with the caller).
+  InputType validationData;
+  //! Held-out responses.
+  OutputType validationResponses;
+
+  //! Evaluate every `interval` epochs.
+  size_t interval;
+  //! Stop after this many evaluations without improvement (0 disables).
+  size_t patience;
+
+  //! Parameter snapshot handed to the background thread.
+  arma::mat snapshot;
+  //! The background evaluation thread.
+  std::thread worker;
+
+  //! Guards `history`, `bestObjective` and `sinceImprovement`.
+  mutable std::mutex resultsMutex;
+  //! Published (epoch, objective) pairs.
+  std::vector<std::pair<size_t, double>> history;
+  //! Best objective published so far.
+  double bestObjective;
+  //! Number of consecutive evaluations without improvement.
+  size_t sinceImprovement;
+
+  //! True while a background evaluation is in flight.
+  std::atomic<bool> evaluating;
+};
+
+} // namespace mlpack
+
+#endif
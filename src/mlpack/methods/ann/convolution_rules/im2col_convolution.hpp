@@ -0,0 +1,348 @@
+/**
+ * @file methods/ann/convolution_rules/im2col_convolution.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the convolution via im2col and matrix multiplication.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_IM2COL_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_IM2COL_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "border_modes.hpp"
+
+namespace mlpack {
+
+/**
+ * Computes the two-dimensional convolution by gathering every input patch
+ * into the column of a workspace matrix (im2col) and then computing all
+ * output positions with one matrix product, which hits (multi-threaded) BLAS
+ * instead of a scalar loop per filter element.  The workspace is persistent
+ * per thread and is reused across calls, so steady-state evaluation does not
+ * allocate.  The results match NaiveConvolution up to floating point
+ * reassociation.
+ *
+ * FullConvolution: returns the full two-dimensional convolution.
+ * ValidConvolution: returns only those parts of the convolution that are
+ * computed without the zero-padded edges.
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ * ValidConvolution).
+ */
+template<typename BorderMode = FullConvolution>
+class Im2ColConvolution
+{
+ public:
+  /**
+   * Perform a convolution (valid mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, ValidConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1,
+              const bool appending = false)
+  {
+    // Compute the output size (see NaiveConvolution for the effect of
+    // dilation on the effective kernel size); when appending, the output
+    // already determines it.
+    size_t outputRows, outputCols;
+    if (!appending)
+    {
+      const size_t filterRows = filter.n_rows * dilationH - (dilationH - 1);
+      const size_t filterCols = filter.n_cols * dilationW - (dilationW - 1);
+      outputRows = (input.n_rows - filterRows + dH) / dH;
+      outputCols = (input.n_cols - filterCols + dW) / dW;
+      output.zeros(outputRows, outputCols);
+    }
+    else
+    {
+      outputRows = output.n_rows;
+      outputCols = output.n_cols;
+    }
+
+    arma::Mat<eT>& patches = PatchWorkspace<eT>();
+    Im2Col(input, filter.n_rows, filter.n_cols, outputRows, outputCols,
+        dW, dH, dilationW, dilationH, patches);
+
+    // One matrix-vector product computes every output position at once.
+    output += arma::reshape(arma::trans(patches) * arma::vectorise(filter),
+        outputRows, outputCols);
+  }
+
+  /**
+   * Perform a convolution (full mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, FullConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1,
+              const bool appending = false)
+  {
+    // Pad the input and run a valid-mode convolution over it, exactly as
+    // NaiveConvolution does; the padding buffer is persistent per thread.
+    const size_t filterRows = filter.n_rows * dilationH - (dilationH - 1);
+    const size_t filterCols = filter.n_cols * dilationW - (dilationW - 1);
+    const size_t paddingRows = filterRows - 1;
+    const size_t paddingCols = filterCols - 1;
+
+    arma::Mat<eT>& inputPadded = PadWorkspace<eT>();
+    inputPadded.zeros(input.n_rows + 2 * paddingRows,
+        input.n_cols + 2 * paddingCols);
+    inputPadded.submat(paddingRows, paddingCols, paddingRows + input.n_rows - 1,
+        paddingCols + input.n_cols - 1) = input;
+
+    Im2ColConvolution<ValidConvolution>::Convolution(inputPadded, filter,
+        output, dW, dH, dilationW, dilationH, appending);
+  }
+
+  /**
+   * Perform a convolution using 3rd order tensors.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1,
+                          const bool appending = false)
+  {
+    arma::Mat<eT> convOutput;
+    Im2ColConvolution<BorderMode>::Convolution(input.slice(0), filter.slice(0),
+        convOutput, dW, dH, dilationW, dilationH, appending);
+
+    if (!appending)
+      output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+          input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      Im2ColConvolution<BorderMode>::Convolution(input.slice(i),
+          filter.slice(i), output.slice(i), dW, dH, dilationW, dilationH,
+          appending);
+    }
+  }
+
+  /**
+   * Perform a convolution using dense matrix as input and a 3rd order tensors
+   * as filter and output.  Because all the filters slide over the same input,
+   * the patches are gathered once and all the filters are applied with a
+   * single matrix-matrix product.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Mat<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1,
+                          const bool appending = false)
+  {
+    const size_t filterRows = filter.n_rows * dilationH - (dilationH - 1);
+    const size_t filterCols = filter.n_cols * dilationW - (dilationW - 1);
+
+    if (std::is_same<BorderMode, FullConvolution>::value)
+    {
+      // Pad the input once, then run the valid-mode multi-filter path.
+      const size_t paddingRows = filterRows - 1;
+      const size_t paddingCols = filterCols - 1;
+
+      arma::Mat<eT>& inputPadded = PadWorkspace<eT>();
+      inputPadded.zeros(input.n_rows + 2 * paddingRows,
+          input.n_cols + 2 * paddingCols);
+      inputPadded.submat(paddingRows, paddingCols,
+          paddingRows + input.n_rows - 1,
+          paddingCols + input.n_cols - 1) = input;
+
+      Im2ColConvolution<ValidConvolution>::Convolution(inputPadded, filter,
+          output, dW, dH, dilationW, dilationH, appending);
+      return;
+    }
+
+    size_t outputRows, outputCols;
+    if (!appending)
+    {
+      outputRows = (input.n_rows - filterRows + dH) / dH;
+      outputCols = (input.n_cols - filterCols + dW) / dW;
+      output = arma::Cube<eT>(outputRows, outputCols, filter.n_slices,
+          arma::fill::zeros);
+    }
+    else
+    {
+      outputRows = output.n_rows;
+      outputCols = output.n_cols;
+    }
+
+    arma::Mat<eT>& patches = PatchWorkspace<eT>();
+    Im2Col(input, filter.n_rows, filter.n_cols, outputRows, outputCols,
+        dW, dH, dilationW, dilationH, patches);
+
+    // Flatten each filter into the column of one matrix, so that a single
+    // matrix-matrix product computes every output map.
+    arma::Mat<eT> filterMatrix(filter.n_rows * filter.n_cols,
+        filter.n_slices);
+    for (size_t i = 0; i < filter.n_slices; ++i)
+      filterMatrix.col(i) = arma::vectorise(filter.slice(i));
+
+    const arma::Mat<eT> result = arma::trans(patches) * filterMatrix;
+    for (size_t i = 0; i < filter.n_slices; ++i)
+      output.slice(i) += arma::reshape(result.col(i), outputRows, outputCols);
+  }
+
+  /**
+   * Perform a convolution using a 3rd order tensors as input and output and a
+   * dense matrix as filter.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Mat<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1,
+                          const bool appending = false)
+  {
+    arma::Mat<eT> convOutput;
+    Im2ColConvolution<BorderMode>::Convolution(input.slice(0), filter,
+        convOutput, dW, dH, dilationW, dilationH, appending);
+
+    if (!appending)
+      output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+          input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      Im2ColConvolution<BorderMode>::Convolution(input.slice(i), filter,
+          output.slice(i), dW, dH, dilationW, dilationH, appending);
+    }
+  }
+
+ private:
+  /**
+   * Gather every input patch into the column of the given workspace matrix.
+   * The elements of a patch are laid out in the same (column-major) order as
+   * a vectorised filter.
+   */
+  template<typename eT>
+  static void Im2Col(const arma::Mat<eT>& input,
+                     const size_t filterRows,
+                     const size_t filterCols,
+                     const size_t outputRows,
+                     const size_t outputCols,
+                     const size_t dW,
+                     const size_t dH,
+                     const size_t dilationW,
+                     const size_t dilationH,
+                     arma::Mat<eT>& patches)
+  {
+    patches.set_size(filterRows * filterCols, outputRows * outputCols);
+
+    size_t patch = 0;
+    for (size_t j = 0; j < outputCols; ++j)
+    {
+      for (size_t i = 0; i < outputRows; ++i, ++patch)
+      {
+        eT* patchPtr = patches.colptr(patch);
+        for (size_t kj = 0; kj < filterCols; ++kj)
+        {
+          const eT* inputPtr = input.colptr(kj * dilationW + j * dW) + i * dH;
+          for (size_t ki = 0; ki < filterRows; ++ki, ++patchPtr,
+              inputPtr += dilationH)
+            *patchPtr = *inputPtr;
+        }
+      }
+    }
+  }
+
+  //! The persistent per-thread patch workspace.  Repeated calls with the same
+  //! shapes (the steady state of a network) reuse the allocation.
+  template<typename eT>
+  static arma::Mat<eT>& PatchWorkspace()
+  {
+    static thread_local arma::Mat<eT> patches;
+    return patches;
+  }
+
+  //! The persistent per-thread padding workspace used by the full mode.
+  template<typename eT>
+  static arma::Mat<eT>& PadWorkspace()
+  {
+    static thread_local arma::Mat<eT> padded;
+    return padded;
+  }
+};  // class Im2ColConvolution
+
+} // namespace mlpack
+
+#endif
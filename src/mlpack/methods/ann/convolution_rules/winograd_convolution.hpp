@@ -0,0 +1,494 @@
+/**
+ * @file methods/ann/convolution_rules/winograd_convolution.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the convolution through the Winograd minimal filtering
+ * algorithm F(2x2, 3x3).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_WINOGRAD_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_WINOGRAD_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "border_modes.hpp"
+#include "im2col_convolution.hpp"
+
+namespace mlpack {
+
+/**
+ * Computes the two-dimensional convolution with the Winograd minimal
+ * filtering algorithm F(2x2, 3x3) (Lavin and Gray, "Fast Algorithms for
+ * Convolutional Neural Networks", 2015).  Each 2x2 output tile is computed
+ * from a 4x4 input tile with 16 multiplications instead of the 36 of the
+ * direct method, a 2.25x reduction that the FFT approach cannot match at
+ * these filter sizes.  The tile transforms are applied to all tiles of an
+ * image at once as batched row operations, and the multi-filter overload
+ * transforms the input tiles a single time for every filter.
+ *
+ * The algorithm only applies to 3x3 filters with unit stride and dilation;
+ * every other configuration falls back to Im2ColConvolution, so the rule can
+ * be used as a drop-in ConvolutionType rule template parameter.
+ *
+ * FullConvolution: returns the full two-dimensional convolution.
+ * ValidConvolution: returns only those parts of the convolution that are
+ * computed without the zero-padded edges.
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ * ValidConvolution).
+ */
+template<typename BorderMode = FullConvolution>
+class WinogradConvolution
+{
+ public:
+  /**
+   * Perform a convolution (valid mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, ValidConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1,
+              const bool appending = false)
+  {
+    // The minimal filtering algorithm is specific to 3x3 filters applied with
+    // unit stride and dilation.
+    if (filter.n_rows != 3 || filter.n_cols != 3 || dW != 1 || dH != 1 ||
+        dilationW != 1 || dilationH != 1)
+    {
+      Im2ColConvolution<ValidConvolution>::Convolution(input, filter, output,
+          dW, dH, dilationW, dilationH, appending);
+      return;
+    }
+
+    size_t outputRows, outputCols;
+    if (!appending)
+    {
+      outputRows = input.n_rows - 2;
+      outputCols = input.n_cols - 2;
+      output.zeros(outputRows, outputCols);
+    }
+    else
+    {
+      outputRows = output.n_rows;
+      outputCols = output.n_cols;
+    }
+
+    Workspace<eT>& ws = GetWorkspace<eT>();
+    TransformInput(input, outputRows, outputCols, ws);
+
+    // Transform the filter: U = G g G^T.
+    arma::Mat<eT> u(16, 1);
+    FilterTransform(filter, u.colptr(0));
+
+    // The pointwise products and the output transform, batched over tiles.
+    ws.products = ws.transformed;
+    ws.products.each_col() %= u.col(0);
+    TransformOutput(outputRows, outputCols, ws);
+    Scatter(ws.out, outputRows, outputCols, output);
+  }
+
+  /**
+   * Perform a convolution (full mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, FullConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1,
+              const bool appending = false)
+  {
+    // Pad the input and run a valid-mode convolution over it, exactly as
+    // NaiveConvolution does.
+    const size_t filterRows = filter.n_rows * dilationH - (dilationH - 1);
+    const size_t filterCols = filter.n_cols * dilationW - (dilationW - 1);
+    const size_t paddingRows = filterRows - 1;
+    const size_t paddingCols = filterCols - 1;
+
+    arma::Mat<eT> inputPadded(input.n_rows + 2 * paddingRows,
+        input.n_cols + 2 * paddingCols, arma::fill::zeros);
+    inputPadded.submat(paddingRows, paddingCols, paddingRows + input.n_rows - 1,
+        paddingCols + input.n_cols - 1) = input;
+
+    WinogradConvolution<ValidConvolution>::Convolution(inputPadded, filter,
+        output, dW, dH, dilationW, dilationH, appending);
+  }
+
+  /**
+   * Perform a convolution using 3rd order tensors.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1,
+                          const bool appending = false)
+  {
+    arma::Mat<eT> convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input.slice(0),
+        filter.slice(0), convOutput, dW, dH, dilationW, dilationH, appending);
+
+    if (!appending)
+      output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+          input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input.slice(i),
+          filter.slice(i), output.slice(i), dW, dH, dilationW, dilationH,
+          appending);
+    }
+  }
+
+  /**
+   * Perform a convolution using dense matrix as input and a 3rd order tensors
+   * as filter and output.  Every filter slides over the same input, so the
+   * input tiles are gathered and transformed a single time and only the cheap
+   * filter transform, pointwise products and output transform are repeated
+   * per filter.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Mat<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1,
+                          const bool appending = false)
+  {
+    if (filter.n_rows != 3 || filter.n_cols != 3 || dW != 1 || dH != 1 ||
+        dilationW != 1 || dilationH != 1)
+    {
+      Im2ColConvolution<BorderMode>::Convolution(input, filter, output,
+          dW, dH, dilationW, dilationH, appending);
+      return;
+    }
+
+    if (std::is_same<BorderMode, FullConvolution>::value)
+    {
+      // Pad the input once, then run the valid-mode multi-filter path.
+      arma::Mat<eT> inputPadded(input.n_rows + 4, input.n_cols + 4,
+          arma::fill::zeros);
+      inputPadded.submat(2, 2, input.n_rows + 1, input.n_cols + 1) = input;
+
+      WinogradConvolution<ValidConvolution>::Convolution(inputPadded, filter,
+          output, dW, dH, dilationW, dilationH, appending);
+      return;
+    }
+
+    size_t outputRows, outputCols;
+    if (!appending)
+    {
+      outputRows = input.n_rows - 2;
+      outputCols = input.n_cols - 2;
+      output = arma::Cube<eT>(outputRows, outputCols, filter.n_slices,
+          arma::fill::zeros);
+    }
+    else
+    {
+      outputRows = output.n_rows;
+      outputCols = output.n_cols;
+    }
+
+    Workspace<eT>& ws = GetWorkspace<eT>();
+    TransformInput(input, outputRows, outputCols, ws);
+
+    // Transform every filter; each column of u holds one transformed filter.
+    arma::Mat<eT> u(16, filter.n_slices);
+    for (size_t s = 0; s < filter.n_slices; ++s)
+      FilterTransform(filter.slice(s), u.colptr(s));
+
+    for (size_t s = 0; s < filter.n_slices; ++s)
+    {
+      ws.products = ws.transformed;
+      ws.products.each_col() %= u.col(s);
+      TransformOutput(outputRows, outputCols, ws);
+      Scatter(ws.out, outputRows, outputCols, output.slice(s));
+    }
+  }
+
+  /**
+   * Perform a convolution using a 3rd order tensors as input and output and a
+   * dense matrix as filter.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Mat<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1,
+                          const bool appending = false)
+  {
+    arma::Mat<eT> convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input.slice(0), filter,
+        convOutput, dW, dH, dilationW, dilationH, appending);
+
+    if (!appending)
+      output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+          input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input.slice(i), filter,
+          output.slice(i), dW, dH, dilationW, dilationH, appending);
+    }
+  }
+
+ private:
+  //! The persistent per-thread workspaces; repeated calls with the same
+  //! shapes (the steady state of a network) reuse the allocations.
+  template<typename eT>
+  struct Workspace
+  {
+    //! Zero-padded input, used when the output size is not a tile multiple.
+    arma::Mat<eT> padded;
+    //! Gathered 4x4 input tiles, one vectorised tile per column.
+    arma::Mat<eT> tiles;
+    //! Intermediate buffer for the one-sided transforms.
+    arma::Mat<eT> partial;
+    //! Transformed input tiles: V = B^T d B, one vectorised V per column.
+    arma::Mat<eT> transformed;
+    //! Pointwise products M = U % V, one vectorised M per column.
+    arma::Mat<eT> products;
+    //! Inverse-transformed 2x2 output tiles, one vectorised tile per column.
+    arma::Mat<eT> out;
+  };
+
+  template<typename eT>
+  static Workspace<eT>& GetWorkspace()
+  {
+    static thread_local Workspace<eT> ws;
+    return ws;
+  }
+
+  /**
+   * Compute the transformed filter U = G g G^T for a 3x3 filter g, storing
+   * the vectorised 4x4 result in the given buffer.
+   */
+  template<typename eT>
+  static void FilterTransform(const arma::Mat<eT>& g, eT* u)
+  {
+    // T = G g, where G = [1 0 0; .5 .5 .5; .5 -.5 .5; 0 0 1].
+    arma::Mat<eT> t(4, 3);
+    t.row(0) = g.row(0);
+    t.row(1) = 0.5 * (g.row(0) + g.row(1) + g.row(2));
+    t.row(2) = 0.5 * (g.row(0) - g.row(1) + g.row(2));
+    t.row(3) = g.row(2);
+
+    // U = T G^T, written column-major into the output buffer.
+    arma::Mat<eT> uMat(u, 4, 4, false, true);
+    uMat.col(0) = t.col(0);
+    uMat.col(1) = 0.5 * (t.col(0) + t.col(1) + t.col(2));
+    uMat.col(2) = 0.5 * (t.col(0) - t.col(1) + t.col(2));
+    uMat.col(3) = t.col(2);
+  }
+
+  /**
+   * Gather the overlapping 4x4 input tiles covering an outputRows x
+   * outputCols result and apply the input transform V = B^T d B to all of
+   * them at once.  Tile t = ti + tilesUp * tj covers output rows 2 * ti to
+   * 2 * ti + 1 and columns 2 * tj to 2 * tj + 1; within a column, element
+   * i + 4 * j is tile element (i, j).
+   */
+  template<typename eT>
+  static void TransformInput(const arma::Mat<eT>& input,
+                             const size_t outputRows,
+                             const size_t outputCols,
+                             Workspace<eT>& ws)
+  {
+    const size_t tilesUp = (outputRows + 1) / 2;
+    const size_t tilesAcross = (outputCols + 1) / 2;
+    const size_t neededRows = 2 * tilesUp + 2;
+    const size_t neededCols = 2 * tilesAcross + 2;
+
+    // If the output size is odd, the last tiles read past the input; gather
+    // from a zero-padded copy in that case.
+    const arma::Mat<eT>* source = &input;
+    if (input.n_rows < neededRows || input.n_cols < neededCols)
+    {
+      ws.padded.zeros(neededRows, neededCols);
+      ws.padded.submat(0, 0, input.n_rows - 1, input.n_cols - 1) = input;
+      source = &ws.padded;
+    }
+
+    ws.tiles.set_size(16, tilesUp * tilesAcross);
+    size_t t = 0;
+    for (size_t tj = 0; tj < tilesAcross; ++tj)
+    {
+      for (size_t ti = 0; ti < tilesUp; ++ti, ++t)
+      {
+        eT* tilePtr = ws.tiles.colptr(t);
+        for (size_t j = 0; j < 4; ++j, tilePtr += 4)
+        {
+          const eT* inputPtr = source->colptr(2 * tj + j) + 2 * ti;
+          tilePtr[0] = inputPtr[0];
+          tilePtr[1] = inputPtr[1];
+          tilePtr[2] = inputPtr[2];
+          tilePtr[3] = inputPtr[3];
+        }
+      }
+    }
+
+    // T = B^T d for all tiles, where
+    // B^T = [1 0 -1 0; 0 1 1 0; 0 -1 1 0; 0 1 0 -1].
+    arma::Mat<eT>& d = ws.tiles;
+    arma::Mat<eT>& p = ws.partial;
+    p.set_size(16, d.n_cols);
+    for (size_t j = 0; j < 4; ++j)
+    {
+      p.row(0 + 4 * j) = d.row(0 + 4 * j) - d.row(2 + 4 * j);
+      p.row(1 + 4 * j) = d.row(1 + 4 * j) + d.row(2 + 4 * j);
+      p.row(2 + 4 * j) = d.row(2 + 4 * j) - d.row(1 + 4 * j);
+      p.row(3 + 4 * j) = d.row(1 + 4 * j) - d.row(3 + 4 * j);
+    }
+
+    // V = T B for all tiles.
+    arma::Mat<eT>& v = ws.transformed;
+    v.set_size(16, d.n_cols);
+    for (size_t i = 0; i < 4; ++i)
+    {
+      v.row(i +  0) = p.row(i + 0) - p.row(i + 8);
+      v.row(i +  4) = p.row(i + 4) + p.row(i + 8);
+      v.row(i +  8) = p.row(i + 8) - p.row(i + 4);
+      v.row(i + 12) = p.row(i + 4) - p.row(i + 12);
+    }
+  }
+
+  /**
+   * Apply the output transform Y = A^T M A to all pointwise product tiles at
+   * once; each column of the result holds a vectorised 2x2 output tile.
+   */
+  template<typename eT>
+  static void TransformOutput(const size_t /* outputRows */,
+                              const size_t /* outputCols */,
+                              Workspace<eT>& ws)
+  {
+    // T = A^T M for all tiles, where A^T = [1 1 1 0; 0 1 -1 -1]; row i + 2j
+    // of the intermediate buffer is element (i, j).
+    arma::Mat<eT>& m = ws.products;
+    arma::Mat<eT>& p = ws.partial;
+    p.set_size(8, m.n_cols);
+    for (size_t j = 0; j < 4; ++j)
+    {
+      p.row(0 + 2 * j) = m.row(0 + 4 * j) + m.row(1 + 4 * j) +
+          m.row(2 + 4 * j);
+      p.row(1 + 2 * j) = m.row(1 + 4 * j) - m.row(2 + 4 * j) -
+          m.row(3 + 4 * j);
+    }
+
+    // Y = T A for all tiles.
+    arma::Mat<eT>& y = ws.out;
+    y.set_size(4, m.n_cols);
+    y.row(0) = p.row(0) + p.row(2) + p.row(4);
+    y.row(1) = p.row(1) + p.row(3) + p.row(5);
+    y.row(2) = p.row(2) - p.row(4) - p.row(6);
+    y.row(3) = p.row(3) - p.row(5) - p.row(7);
+  }
+
+  /**
+   * Accumulate the 2x2 output tiles into the output matrix, dropping the
+   * tile elements that fall outside of it when the output size is odd.
+   */
+  template<typename eT, typename OutType>
+  static void Scatter(const arma::Mat<eT>& y,
+                      const size_t outputRows,
+                      const size_t outputCols,
+                      OutType&& output)
+  {
+    const size_t tilesUp = (outputRows + 1) / 2;
+    const size_t tilesAcross = (outputCols + 1) / 2;
+
+    size_t t = 0;
+    for (size_t tj = 0; tj < tilesAcross; ++tj)
+    {
+      for (size_t ti = 0; ti < tilesUp; ++ti, ++t)
+      {
+        const bool lastRow = (2 * ti + 1 >= outputRows);
+        const bool lastCol = (2 * tj + 1 >= outputCols);
+
+        output(2 * ti, 2 * tj) += y(0, t);
+        if (!lastRow)
+          output(2 * ti + 1, 2 * tj) += y(1, t);
+        if (!lastCol)
+          output(2 * ti, 2 * tj + 1) += y(2, t);
+        if (!lastRow && !lastCol)
+          output(2 * ti + 1, 2 * tj + 1) += y(3, t);
+      }
+    }
+  }
+};  // class WinogradConvolution
+
+} // namespace mlpack
+
+#endif
@@ -195,6 +195,10 @@ class FFN
    * the output of the output layer when `predictors` is passed through the
    * whole network (`OutputLayerType`).
    *
+   * If OpenMP is enabled, the batches are processed in parallel: each thread
+   * pushes batches through its own copy of the network layers, whose weights
+   * are non-owning aliases of the shared parameter matrix.
+   *
    * @param predictors Input predictors.
    * @param results Matrix to put output predictions of responses into.
    * @param batchSize Batch size to use for prediction.
@@ -203,6 +207,18 @@ class FFN
                MatType& results,
                const size_t batchSize = 128);
 
+  /**
+   * Return an inference-only copy of the network in which every Linear layer
+   * is replaced by a QuantizedLinear layer: the trained weights are quantized
+   * to int8 with one symmetric scale per output channel, a 4x reduction in
+   * model size.  All other layers are cloned unchanged, with their weights
+   * copied.
+   *
+   * The network must have been trained (or otherwise initialized) before
+   * quantization.  The returned network cannot be trained further.
+   */
+  FFN Quantize();
+
   // Return the number of weights in the model.
   size_t WeightSize();
 
@@ -547,6 +563,17 @@ class FFN
   //! Locally-stored error of the backward pass; used by the gradient pass.
   MatType error;
 
+  //! Copies of the network used by the extra worker threads of a data-parallel
+  //! gradient computation; each copy has its own layer workspaces, but aliases
+  //! the same `parameters` matrix.  (The main thread uses `network` itself.)
+  //! Empty unless OpenMP is enabled and a multi-threaded
+  //! `EvaluateWithGradient()` call has happened.
+  std::vector<MultiLayer<MatType>> workerNetworks;
+  //! Pointer to the parameter memory that `workerNetworks` was built for; if
+  //! the parameter matrix moves (e.g. because the network was modified and
+  //! reset), the workers must be rebuilt.
+  const typename MatType::elem_type* workerParameters;
+
   //! If true, each layer has its memory properly set for a forward/backward
   //! pass.
   bool layerMemoryIsSet;
@@ -30,7 +30,8 @@ FFN<
     outputLayer(std::move(outputLayer)),
     initializeRule(std::move(initializeRule)),
     layerMemoryIsSet(false),
-    inputDimensionsAreSet(false)
+    inputDimensionsAreSet(false),
+    workerParameters(nullptr)
 {
   /* Nothing to do here. */
 }
@@ -52,7 +53,8 @@ FFN<
     responses(network.responses),
     // These will be set correctly in the first Forward() call.
     layerMemoryIsSet(false),
-    inputDimensionsAreSet(false)
+    inputDimensionsAreSet(false),
+    workerParameters(nullptr)
 {
   // Nothing to do.
 };
@@ -75,7 +77,8 @@ FFN<
     // Aliases will not be correct after a std::move(), so we will manually
     // reset them.
     layerMemoryIsSet(false),
-    inputDimensionsAreSet(std::move(network.inputDimensionsAreSet))
+    inputDimensionsAreSet(std::move(network.inputDimensionsAreSet)),
+    workerParameters(nullptr)
 {
   // Nothing to do.
 };
@@ -106,6 +109,8 @@ FFN<OutputLayerType, InitializationRuleType, MatType>& FFN<
     // Copying will not preserve Armadillo aliases correctly, so we will reset
     // those.
     layerMemoryIsSet = false;
+    workerNetworks.clear();
+    workerParameters = nullptr;
   }
 
   return *this;
@@ -134,6 +139,8 @@ FFN<OutputLayerType, InitializationRuleType, MatType>& FFN<
     error = std::move(other.error);
     inputDimensionsAreSet = std::move(other.inputDimensionsAreSet);
     layerMemoryIsSet = std::move(other.layerMemoryIsSet);
+    workerNetworks.clear();
+    workerParameters = nullptr;
   }
 
   return *this;
@@ -201,21 +208,120 @@ void FFN<
 
   results.set_size(network.OutputSize(), predictors.n_cols);
 
-  for (size_t i = 0; i < predictors.n_cols; i += batchSize)
+  size_t numThreads = 1;
+  #ifdef MLPACK_USE_OPENMP
+    numThreads = (size_t) omp_get_max_threads();
+  #endif
+
+  if (numThreads > 1 && predictors.n_cols > batchSize)
+  {
+    // Split the batches across threads.  The layers' workspaces (intermediate
+    // outputs and the like) cannot be shared between threads, so each thread
+    // pushes its batches through its own copy of the network; the weights of
+    // each copy are non-owning aliases of the shared parameter matrix.
+    #pragma omp parallel
+    {
+      MultiLayer<MatType> localNetwork(network);
+      localNetwork.SetWeights(parameters.memptr());
+
+      #pragma omp for schedule(dynamic)
+      for (size_t i = 0; i < (size_t) predictors.n_cols; i += batchSize)
+      {
+        const size_t effectiveBatchSize = std::min(batchSize,
+            size_t(predictors.n_cols) - i);
+
+        const MatType predictorAlias(
+            const_cast<typename MatType::elem_type*>(predictors.colptr(i)),
+            predictors.n_rows, effectiveBatchSize, false, true);
+        MatType resultAlias(results.colptr(i), results.n_rows,
+            effectiveBatchSize, false, true);
+
+        localNetwork.Forward(predictorAlias, resultAlias);
+      }
+    }
+  }
+  else
   {
-    const size_t effectiveBatchSize = std::min(batchSize,
-        size_t(predictors.n_cols) - i);
+    for (size_t i = 0; i < predictors.n_cols; i += batchSize)
+    {
+      const size_t effectiveBatchSize = std::min(batchSize,
+          size_t(predictors.n_cols) - i);
 
-    const MatType predictorAlias(
-        const_cast<typename MatType::elem_type*>(predictors.colptr(i)),
-        predictors.n_rows, effectiveBatchSize, false, true);
-    MatType resultAlias(results.colptr(i), results.n_rows,
-        effectiveBatchSize, false, true);
+      const MatType predictorAlias(
+          const_cast<typename MatType::elem_type*>(predictors.colptr(i)),
+          predictors.n_rows, effectiveBatchSize, false, true);
+      MatType resultAlias(results.colptr(i), results.n_rows,
+          effectiveBatchSize, false, true);
 
-    network.Forward(predictorAlias, resultAlias);
+      network.Forward(predictorAlias, resultAlias);
+    }
   }
 }
 
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+FFN<OutputLayerType, InitializationRuleType, MatType> FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Quantize()
+{
+  if (inputDimensions.size() == 0 || parameters.is_empty())
+  {
+    throw std::runtime_error("FFN::Quantize(): the network must be trained "
+        "(or otherwise initialized) before it can be quantized!");
+  }
+
+  // Make sure every layer is pointing at the right weights.
+  CheckNetwork("FFN::Quantize()", 0, true, false);
+
+  FFN quantized(outputLayer, initializeRule);
+  quantized.InputDimensions() = inputDimensions;
+
+  const std::vector<Layer<MatType>*>& layers = network.Network();
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    LinearType<MatType, NoRegularizer>* linear =
+        dynamic_cast<LinearType<MatType, NoRegularizer>*>(layers[i]);
+    if (linear != NULL)
+    {
+      quantized.Add(new QuantizedLinearType<MatType>(linear->Weight(),
+          linear->Bias()));
+    }
+    else
+    {
+      quantized.Add(layers[i]->Clone());
+    }
+  }
+
+  // Initialize the parameter matrix of the quantized network, then overwrite
+  // the (randomly initialized) weights of every layer that was not quantized
+  // with the trained weights.  Cloning a layer does not copy its weights,
+  // since those live in the network's parameter matrix.
+  size_t totalInputSize = 1;
+  for (size_t i = 0; i < inputDimensions.size(); ++i)
+    totalInputSize *= inputDimensions[i];
+  quantized.Reset(totalInputSize);
+
+  size_t oldStart = 0, newStart = 0;
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    const size_t weightSize = layers[i]->WeightSize();
+    const bool wasQuantized =
+        (dynamic_cast<LinearType<MatType, NoRegularizer>*>(layers[i]) != NULL);
+    if (!wasQuantized && weightSize > 0)
+    {
+      quantized.Parameters().rows(newStart, newStart + weightSize - 1) =
+          parameters.rows(oldStart, oldStart + weightSize - 1);
+      newStart += weightSize;
+    }
+    oldStart += weightSize;
+  }
+
+  return quantized;
+}
+
 template<typename OutputLayerType,
          typename InitializationRuleType,
          typename MatType>
@@ -411,6 +517,9 @@ void FFN<
       layerMemoryIsSet = false;
       inputDimensionsAreSet = false;
 
+      workerNetworks.clear();
+      workerParameters = nullptr;
+
       // The weights in `parameters` will be correctly set for each layer in the
       // first call to Forward().
     }
@@ -490,6 +599,72 @@ typename MatType::elem_type FFN<
 {
   CheckNetwork("FFN::EvaluateWithGradient()", predictors.n_rows);
 
+  #ifdef MLPACK_USE_OPENMP
+  // If there is enough work to split, shard the batch across threads: each
+  // worker runs the forward and backward passes on its own shard with its own
+  // layer workspaces (aliasing the same parameters), and the shard losses and
+  // gradients are summed.  We require at least 16 points per shard, so that
+  // the per-shard GEMMs don't get too small to be worth the reduction cost.
+  const size_t numThreads = std::min((size_t) omp_get_max_threads(),
+      batchSize / 16);
+  if (numThreads > 1)
+  {
+    // (Re)build the worker networks if the parameter matrix has moved since
+    // they were last built (e.g. because the network was modified and reset),
+    // or if the number of threads has changed.
+    if (workerNetworks.size() != numThreads - 1 ||
+        workerParameters != this->parameters.memptr())
+    {
+      workerNetworks.clear();
+      workerNetworks.resize(numThreads - 1, network);
+      for (size_t i = 0; i < workerNetworks.size(); ++i)
+        workerNetworks[i].SetWeights(this->parameters.memptr());
+      workerParameters = this->parameters.memptr();
+    }
+
+    gradient.zeros(parameters.n_rows, parameters.n_cols);
+    const size_t shardSize = (batchSize + numThreads - 1) / numThreads;
+    typename MatType::elem_type obj = 0;
+
+    #pragma omp parallel num_threads(numThreads) reduction(+:obj)
+    {
+      const size_t tid = (size_t) omp_get_thread_num();
+      const size_t shardBegin = begin + tid * shardSize;
+      if (shardBegin < begin + batchSize)
+      {
+        const size_t shardCols = std::min(shardSize,
+            begin + batchSize - shardBegin);
+        const size_t shardEnd = shardBegin + shardCols - 1;
+        MultiLayer<MatType>& workerNetwork =
+            (tid == 0) ? network : workerNetworks[tid - 1];
+        OutputLayerType workerOutputLayer(outputLayer);
+
+        MatType workerOutput(workerNetwork.OutputSize(), shardCols);
+        workerNetwork.Forward(predictors.cols(shardBegin, shardEnd),
+            workerOutput);
+        obj += workerOutputLayer.Forward(workerOutput,
+            responses.cols(shardBegin, shardEnd)) + workerNetwork.Loss();
+
+        MatType workerError;
+        workerOutputLayer.Backward(workerOutput,
+            responses.cols(shardBegin, shardEnd), workerError);
+
+        MatType workerDelta(predictors.n_rows, shardCols);
+        workerNetwork.Backward(workerOutput, workerError, workerDelta);
+
+        MatType workerGradient(gradient.n_rows, gradient.n_cols);
+        workerNetwork.Gradient(predictors.cols(shardBegin, shardEnd),
+            workerError, workerGradient);
+
+        #pragma omp critical (FFNGradientReduction)
+        gradient += workerGradient;
+      }
+    }
+
+    return obj;
+  }
+  #endif
+
   // Set networkOutput to the right size if needed, then perform the forward
   // pass.
   networkOutput.set_size(network.OutputSize(), batchSize);
@@ -0,0 +1,282 @@
+/**
+ * @file methods/ann/fused_update_policies.hpp
+ *
+ * Fused update policies for ensmallen's gradient-based optimizers.  These are
+ * drop-in replacements for ens::MomentumUpdate and ens::AdamUpdate that
+ * update the optimizer state and the parameters in a single pass over memory,
+ * instead of materializing intermediate expressions in separate passes.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_FUSED_UPDATE_POLICIES_HPP
+#define MLPACK_METHODS_ANN_FUSED_UPDATE_POLICIES_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Fused SGD-with-momentum update.  This computes the same iterates as
+ * ens::MomentumUpdate:
+ *
+ *   v = momentum * v - stepSize * g
+ *   iterate += v
+ *
+ * but performs both updates in one loop over the contiguous parameter vector,
+ * so the gradient, velocity and parameters are each read and written exactly
+ * once per step.  For large networks, where the parameter vector does not fit
+ * in cache, this halves the memory traffic of the optimizer step.  The loop
+ * is a simple elementwise kernel that vectorizes under `#pragma omp simd`.
+ *
+ * Use it by substituting it for the update policy of an ensmallen optimizer,
+ * e.g. `ens::SGD<FusedMomentumUpdate> optimizer(...)`.  Only dense matrix
+ * types are supported.
+ */
+class FusedMomentumUpdate
+{
+ public:
+  /**
+   * Construct the fused momentum update policy.
+   *
+   * @param momentum The momentum decay hyperparameter.
+   */
+  FusedMomentumUpdate(const double momentum = 0.5) : momentum(momentum)
+  { /* Nothing to do. */ }
+
+  //! Get the momentum decay hyperparameter.
+  double Momentum() const { return momentum; }
+  //! Modify the momentum decay hyperparameter.
+  double& Momentum() { return momentum; }
+
+  /**
+   * The UpdatePolicyType policy classes must contain an internal 'Policy'
+   * template class with two template arguments: MatType and GradType.  This
+   * is instantiated at the start of the optimization.
+   */
+  template<typename MatType, typename GradType>
+  class Policy
+  {
+   public:
+    /**
+     * This constructor is called by the optimizer before the optimization
+     * starts.
+     *
+     * @param parent Instantiated parent class.
+     * @param rows Number of rows in the gradient matrix.
+     * @param cols Number of columns in the gradient matrix.
+     */
+    Policy(FusedMomentumUpdate& parent, const size_t rows, const size_t cols) :
+        parent(parent)
+    {
+      velocity.zeros(rows, cols);
+    }
+
+    /**
+     * Update step for SGD with momentum, fused into a single pass over the
+     * parameters.
+     *
+     * @param iterate Parameters that minimize the function.
+     * @param stepSize Step size to be used for the given iteration.
+     * @param gradient The gradient matrix.
+     */
+    void Update(MatType& iterate,
+                const double stepSize,
+                const GradType& gradient)
+    {
+      typedef typename MatType::elem_type ElemType;
+
+      ElemType* it = iterate.memptr();
+      ElemType* v = velocity.memptr();
+      const typename GradType::elem_type* g = gradient.memptr();
+
+      const ElemType mu = (ElemType) parent.momentum;
+      const ElemType lr = (ElemType) stepSize;
+      const size_t n = iterate.n_elem;
+
+      #pragma omp simd
+      for (size_t i = 0; i < n; ++i)
+      {
+        v[i] = mu * v[i] - lr * (ElemType) g[i];
+        it[i] += v[i];
+      }
+    }
+
+    //! Get the velocity matrix.
+    const MatType& Velocity() const { return velocity; }
+    //! Modify the velocity matrix.
+    MatType& Velocity() { return velocity; }
+
+   private:
+    //! The instantiated parent class.
+    FusedMomentumUpdate& parent;
+
+    //! The velocity matrix.
+    MatType velocity;
+  };
+
+ private:
+  //! The momentum decay hyperparameter.
+  double momentum;
+};
+
+/**
+ * Fused Adam update.  This computes the same iterates as ens::AdamUpdate:
+ *
+ *   m = beta1 * m + (1 - beta1) * g
+ *   v = beta2 * v + (1 - beta2) * g^2
+ *   iterate -= stepSize * (sqrt(1 - beta2^t) / (1 - beta1^t)) *
+ *       m / (sqrt(v) + epsilon)
+ *
+ * but reads the gradient and updates both moment estimates and the parameters
+ * in one loop over the contiguous parameter vector, instead of the five
+ * separate vector passes of the expression-by-expression formulation.  The
+ * loop is a simple elementwise kernel that vectorizes under
+ * `#pragma omp simd`.
+ *
+ * Use it by substituting it for the update policy of an ensmallen optimizer,
+ * e.g. `ens::SGD<FusedAdamUpdate> optimizer(...)`.  Only dense matrix types
+ * are supported.
+ */
+class FusedAdamUpdate
+{
+ public:
+  /**
+   * Construct the fused Adam update policy.
+   *
+   * @param epsilon Value used to initialize the mean squared gradient
+   *    parameter.
+   * @param beta1 Exponential decay rate for the first moment estimates.
+   * @param beta2 Exponential decay rate for the second moment estimates.
+   */
+  FusedAdamUpdate(const double epsilon = 1e-8,
+                  const double beta1 = 0.9,
+                  const double beta2 = 0.999) :
+      epsilon(epsilon),
+      beta1(beta1),
+      beta2(beta2)
+  { /* Nothing to do. */ }
+
+  //! Get the value used to initialize the mean squared gradient parameter.
+  double Epsilon() const { return epsilon; }
+  //! Modify the value used to initialize the mean squared gradient parameter.
+  double& Epsilon() { return epsilon; }
+
+  //! Get the smoothing parameter.
+  double Beta1() const { return beta1; }
+  //! Modify the smoothing parameter.
+  double& Beta1() { return beta1; }
+
+  //! Get the second moment coefficient.
+  double Beta2() const { return beta2; }
+  //! Modify the second moment coefficient.
+  double& Beta2() { return beta2; }
+
+  /**
+   * The UpdatePolicyType policy classes must contain an internal 'Policy'
+   * template class with two template arguments: MatType and GradType.  This
+   * is instantiated at the start of the optimization.
+   */
+  template<typename MatType, typename GradType>
+  class Policy
+  {
+   public:
+    /**
+     * This constructor is called by the optimizer before the optimization
+     * starts.
+     *
+     * @param parent Instantiated parent class.
+     * @param rows Number of rows in the gradient matrix.
+     * @param cols Number of columns in the gradient matrix.
+     */
+    Policy(FusedAdamUpdate& parent, const size_t rows, const size_t cols) :
+        parent(parent),
+        iteration(0)
+    {
+      m.zeros(rows, cols);
+      v.zeros(rows, cols);
+    }
+
+    /**
+     * Update step for Adam, fused into a single pass over the parameters.
+     *
+     * @param iterate Parameters that minimize the function.
+     * @param stepSize Step size to be used for the given iteration.
+     * @param gradient The gradient matrix.
+     */
+    void Update(MatType& iterate,
+                const double stepSize,
+                const GradType& gradient)
+    {
+      typedef typename MatType::elem_type ElemType;
+
+      ++iteration;
+
+      // The bias corrections depend only on the iteration number, so the
+      // per-element work reduces to the two moment updates and one scaled
+      // division.
+      const double biasCorrection1 = 1.0 - std::pow(parent.beta1, iteration);
+      const double biasCorrection2 = 1.0 - std::pow(parent.beta2, iteration);
+
+      ElemType* it = iterate.memptr();
+      ElemType* mPtr = m.memptr();
+      ElemType* vPtr = v.memptr();
+      const typename GradType::elem_type* g = gradient.memptr();
+
+      const ElemType b1 = (ElemType) parent.beta1;
+      const ElemType b2 = (ElemType) parent.beta2;
+      const ElemType eps = (ElemType) parent.epsilon;
+      const ElemType scale = (ElemType) (stepSize *
+          std::sqrt(biasCorrection2) / biasCorrection1);
+      const size_t n = iterate.n_elem;
+
+      #pragma omp simd
+      for (size_t i = 0; i < n; ++i)
+      {
+        const ElemType gi = (ElemType) g[i];
+        mPtr[i] = b1 * mPtr[i] + (1 - b1) * gi;
+        vPtr[i] = b2 * vPtr[i] + (1 - b2) * gi * gi;
+        it[i] -= scale * mPtr[i] / (std::sqrt(vPtr[i]) + eps);
+      }
+    }
+
+    //! Get the first moment coefficient.
+    const MatType& FirstMoment() const { return m; }
+    //! Modify the first moment coefficient.
+    MatType& FirstMoment() { return m; }
+
+    //! Get the second moment coefficient.
+    const MatType& SecondMoment() const { return v; }
+    //! Modify the second moment coefficient.
+    MatType& SecondMoment() { return v; }
+
+   private:
+    //! The instantiated parent class.
+    FusedAdamUpdate& parent;
+
+    //! The exponential moving average of gradient values.
+    MatType m;
+
+    //! The exponential moving average of squared gradient values.
+    MatType v;
+
+    //! The number of iterations.
+    size_t iteration;
+  };
+
+ private:
+  //! The epsilon value used to initialize the mean squared gradient parameter.
+  double epsilon;
+
+  //! The smoothing parameter.
+  double beta1;
+
+  //! The second moment coefficient.
+  double beta2;
+};
+
+} // namespace mlpack
+
+#endif
@@ -201,42 +201,79 @@ void BatchNormType<MatType>::Forward(
           " greater than 1 to fix the warning." << std::endl;
     }
 
+    typedef typename MatType::elem_type ElemType;
+
     // Input corresponds to output from previous layer.
     // Used a cube for simplicity.
-    arma::Cube<typename MatType::elem_type> inputTemp(
+    arma::Cube<ElemType> inputTemp(
         const_cast<MatType&>(input).memptr(), inputSize, size,
         batchSize * higherDimension, false, false);
 
-    // Initialize output to same size and values for convenience.
-    arma::Cube<typename MatType::elem_type> outputTemp(
+    output.set_size(arma::size(input));
+    arma::Cube<ElemType> outputTemp(
         const_cast<MatType&>(output).memptr(), inputSize, size,
         batchSize * higherDimension, false, false);
-    outputTemp = inputTemp;
 
-    // Calculate mean and variance over all channels.
-    MatType mean = arma::sum(arma::sum(inputTemp, 2), 0) / m;
-    variance = arma::sum(arma::sum(arma::pow(
-        inputTemp.each_slice() - arma::repmat(mean,
-        inputSize, 1), 2), 2), 0) / m;
+    const size_t numSlices = batchSize * higherDimension;
 
-    outputTemp.each_slice() -= arma::repmat(mean, inputSize, 1);
+    // Calculate the mean and variance of each channel with a single pass over
+    // the data, accumulating Welford statistics over the channel's contiguous
+    // blocks (one block per slice).  This avoids the extra passes (and
+    // temporary cubes) of a two-pass mean/variance computation.
+    MatType mean(1, size);
+    variance.set_size(1, size);
+    #pragma omp parallel for
+    for (size_t c = 0; c < size; ++c)
+    {
+      ElemType channelMean = 0.0;
+      ElemType m2 = 0.0;
+      size_t n = 0;
+      for (size_t s = 0; s < numSlices; ++s)
+      {
+        const ElemType* inPtr = inputTemp.slice_colptr(s, c);
+        for (size_t i = 0; i < inputSize; ++i)
+        {
+          ++n;
+          const ElemType delta = inPtr[i] - channelMean;
+          channelMean += delta / n;
+          m2 += delta * (inPtr[i] - channelMean);
+        }
+      }
+
+      mean[c] = channelMean;
+      variance[c] = m2 / m;
+    }
 
-    // Used in backward propagation.
+    // These are used in the backward propagation.
     inputMean.set_size(arma::size(inputTemp));
-    inputMean = outputTemp;
-
-    // Normalize output.
-    outputTemp.each_slice() /= arma::sqrt(arma::repmat(variance,
-        inputSize, 1) + eps);
-
-    // Re-used in backward propagation.
     normalized.set_size(arma::size(inputTemp));
-    normalized = outputTemp;
 
-    outputTemp.each_slice() %= arma::repmat(gamma.t(),
-        inputSize, 1);
-    outputTemp.each_slice() += arma::repmat(beta.t(),
-        inputSize, 1);
+    // Now center, normalize, scale, and shift each channel with a single
+    // fused pass, storing the intermediate results for the backward pass as
+    // we go.
+    #pragma omp parallel for
+    for (size_t c = 0; c < size; ++c)
+    {
+      const ElemType channelMean = mean[c];
+      const ElemType invStd = 1.0 / std::sqrt(variance[c] + eps);
+      const ElemType channelGamma = gamma[c];
+      const ElemType channelBeta = beta[c];
+      for (size_t s = 0; s < numSlices; ++s)
+      {
+        const ElemType* inPtr = inputTemp.slice_colptr(s, c);
+        ElemType* centeredPtr = inputMean.slice_colptr(s, c);
+        ElemType* normalizedPtr = normalized.slice_colptr(s, c);
+        ElemType* outPtr = outputTemp.slice_colptr(s, c);
+        for (size_t i = 0; i < inputSize; ++i)
+        {
+          const ElemType centered = inPtr[i] - channelMean;
+          centeredPtr[i] = centered;
+          const ElemType norm = centered * invStd;
+          normalizedPtr[i] = norm;
+          outPtr[i] = channelGamma * norm + channelBeta;
+        }
+      }
+    }
 
     count += 1;
     // Value for average factor which used to update running parameters.
@@ -254,20 +291,36 @@ void BatchNormType<MatType>::Forward(
   }
   else
   {
-    // Normalize the input and scale and shift the output.
-    output = input;
-    arma::Cube<typename MatType::elem_type> outputTemp(
+    typedef typename MatType::elem_type ElemType;
+
+    // Normalize the input and scale and shift the output, channel by channel
+    // in a single fused pass.
+    output.set_size(arma::size(input));
+
+    arma::Cube<ElemType> inputTemp(
+        const_cast<MatType&>(input).memptr(), inputSize, size,
+        batchSize * higherDimension, false, false);
+    arma::Cube<ElemType> outputTemp(
         const_cast<MatType&>(output).memptr(), inputSize, size,
         batchSize * higherDimension, false, false);
 
-    outputTemp.each_slice() -= arma::repmat(runningMean.t(),
-        inputSize, 1);
-    outputTemp.each_slice() /= arma::sqrt(arma::repmat(runningVariance.t(),
-        inputSize, 1) + eps);
-    outputTemp.each_slice() %= arma::repmat(gamma.t(),
-        inputSize, 1);
-    outputTemp.each_slice() += arma::repmat(beta.t(),
-        inputSize, 1);
+    const size_t numSlices = batchSize * higherDimension;
+    #pragma omp parallel for
+    for (size_t c = 0; c < size; ++c)
+    {
+      const ElemType channelMean = runningMean[c];
+      const ElemType invStd = 1.0 / std::sqrt(runningVariance[c] + eps);
+      const ElemType channelGamma = gamma[c];
+      const ElemType channelBeta = beta[c];
+      for (size_t s = 0; s < numSlices; ++s)
+      {
+        const ElemType* inPtr = inputTemp.slice_colptr(s, c);
+        ElemType* outPtr = outputTemp.slice_colptr(s, c);
+        for (size_t i = 0; i < inputSize; ++i)
+          outPtr[i] = channelGamma * (inPtr[i] - channelMean) * invStd +
+              channelBeta;
+      }
+    }
   }
 }
 
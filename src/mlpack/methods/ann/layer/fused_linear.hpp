@@ -0,0 +1,196 @@
+/**
+ * @file methods/ann/layer/fused_linear.hpp
+ * @author Ryan Curtin
+ *
+ * Definition of the FusedLinear layer class, a fully-connected layer with a
+ * fused elementwise activation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_FUSED_LINEAR_HPP
+#define MLPACK_METHODS_ANN_LAYER_FUSED_LINEAR_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/activation_functions/logistic_function.hpp>
+#include <mlpack/methods/ann/activation_functions/rectifier_function.hpp>
+#include <mlpack/methods/ann/regularizer/no_regularizer.hpp>
+
+#include "layer.hpp"
+
+namespace mlpack {
+
+/**
+ * Implementation of the FusedLinear layer class, which computes
+ * f(y) = g(Ax + b) for an elementwise activation function g.  It is
+ * equivalent to a Linear layer followed by the matching activation layer
+ * (e.g. `ReLULayer`), but the bias and the nonlinearity are applied in a
+ * single pass over each freshly-computed output block while it is still in
+ * cache, instead of writing the full linear output and then reading and
+ * rewriting it through a separate layer---a useful memory bandwidth saving
+ * on the tall, thin layers that dominate MLPs.
+ *
+ * The input matrix given in Forward(input, output) must be either a vector or
+ * matrix. If the input is a matrix, then each column is assumed to be an input
+ * sample of given batch.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ * @tparam ActivationFunction The elementwise activation function to fuse;
+ *    it must provide a scalar Fn() and compute Deriv() from the activation
+ *    output (as the functions used by `BaseLayer` do).
+ * @tparam RegularizerType Type of the regularizer to be used (Default no
+ *    regularizer).
+ */
+template<
+    typename MatType = arma::mat,
+    typename ActivationFunction = RectifierFunction,
+    typename RegularizerType = NoRegularizer
+>
+class FusedLinearType : public Layer<MatType>
+{
+ public:
+  //! Create the FusedLinear object.
+  FusedLinearType();
+
+  /**
+   * Create the FusedLinear layer object with the specified number of output
+   * dimensions.
+   *
+   * @param outSize The output dimension.
+   * @param regularizer The regularizer to use, optional (default: no
+   *     regularizer).
+   */
+  FusedLinearType(const size_t outSize,
+                  RegularizerType regularizer = RegularizerType());
+
+  virtual ~FusedLinearType() { }
+
+  //! Clone the FusedLinearType object. This handles polymorphism correctly.
+  FusedLinearType* Clone() const { return new FusedLinearType(*this); }
+
+  //! Copy the other FusedLinear layer (but not weights).
+  FusedLinearType(const FusedLinearType& layer);
+
+  //! Take ownership of the members of the other FusedLinear layer (but not
+  //! weights).
+  FusedLinearType(FusedLinearType&& layer);
+
+  //! Copy the other FusedLinear layer (but not weights).
+  FusedLinearType& operator=(const FusedLinearType& layer);
+
+  //! Take ownership of the members of the other FusedLinear layer (but not
+  //! weights).
+  FusedLinearType& operator=(FusedLinearType&& layer);
+
+  /**
+   * Reset the layer parameter (weights and bias). The method is called to
+   * assign the allocated memory to the internal learnable parameters.
+   */
+  void SetWeights(typename MatType::elem_type* weightsPtr);
+
+  /**
+   * Ordinary feed forward pass of a neural network, evaluating the function
+   * f(x) by propagating the activity forward through f.
+   *
+   * f(x) = g(Ax + b), where x is the given input, A and b are the layer
+   * weights and bias, and g is the fused activation function.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * Ordinary feed backward pass of a neural network, calculating the function
+   * f(x) by propagating x backwards trough f. Using the results from the feed
+   * forward pass.
+   *
+   * @param output The propagated output activation.
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  void Backward(const MatType& output,
+                const MatType& gy,
+                MatType& g);
+
+  /**
+   * Calculate the gradient using the output delta and the input activation.
+   * This uses the pre-activation delta computed by Backward(), so Backward()
+   * must be called first.
+   *
+   * @param input The input parameter used for calculating the gradient.
+   * @param * (error) The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  void Gradient(const MatType& input,
+                const MatType& /* error */,
+                MatType& gradient);
+
+  //! Get the parameters.
+  const MatType& Parameters() const { return weights; }
+  //! Modify the parameters.
+  MatType& Parameters() { return weights; }
+
+  //! Get the weight of the layer.
+  MatType const& Weight() const { return weight; }
+  //! Modify the weight of the layer.
+  MatType& Weight() { return weight; }
+
+  //! Get the bias of the layer.
+  MatType const& Bias() const { return bias; }
+  //! Modify the bias weights of the layer.
+  MatType& Bias() { return bias; }
+
+  //! Get the size of the weights.
+  size_t WeightSize() const { return (inSize * outSize) + outSize; }
+
+  //! Compute the output dimensions of the layer given `InputDimensions()`.
+  void ComputeOutputDimensions();
+
+  //! Serialize the layer.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Locally-stored number of input units.
+  size_t inSize;
+
+  //! Locally-stored number of output units.
+  size_t outSize;
+
+  //! Locally-stored weight object.  This holds all the weights in a vectorized
+  //! form; i.e., the weights and the bias.
+  MatType weights;
+
+  //! Locally-stored weight parameters.
+  MatType weight;
+
+  //! Locally-stored bias term parameters.
+  MatType bias;
+
+  //! Pre-activation delta of the last backward pass, used by Gradient().
+  MatType delta;
+
+  //! Locally-stored regularizer object.
+  RegularizerType regularizer;
+}; // class FusedLinearType
+
+// Convenience typedefs.
+
+// Linear layer with a fused ReLU activation, using no regularization.
+typedef FusedLinearType<arma::mat, RectifierFunction, NoRegularizer>
+    LinearReLU;
+
+// Linear layer with a fused sigmoid activation, using no regularization.
+typedef FusedLinearType<arma::mat, LogisticFunction, NoRegularizer>
+    LinearSigmoid;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "fused_linear_impl.hpp"
+
+#endif
@@ -0,0 +1,207 @@
+/**
+ * @file methods/ann/layer/fused_linear_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the FusedLinear layer class, a fully-connected layer with
+ * a fused elementwise activation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_FUSED_LINEAR_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_FUSED_LINEAR_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "fused_linear.hpp"
+
+namespace mlpack {
+
+template<typename MatType, typename ActivationFunction,
+    typename RegularizerType>
+FusedLinearType<MatType, ActivationFunction, RegularizerType>::
+FusedLinearType() :
+    Layer<MatType>(),
+    inSize(0),
+    outSize(0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType, typename ActivationFunction,
+    typename RegularizerType>
+FusedLinearType<MatType, ActivationFunction, RegularizerType>::
+FusedLinearType(
+    const size_t outSize,
+    RegularizerType regularizer) :
+    Layer<MatType>(),
+    inSize(0), // This will be computed in ComputeOutputDimensions().
+    outSize(outSize),
+    regularizer(regularizer)
+{
+  weights.set_size(WeightSize(), 1);
+}
+
+// Copy constructor.
+template<typename MatType, typename ActivationFunction,
+    typename RegularizerType>
+FusedLinearType<MatType, ActivationFunction, RegularizerType>::
+FusedLinearType(const FusedLinearType& layer) :
+    Layer<MatType>(layer),
+    inSize(layer.inSize),
+    outSize(layer.outSize),
+    regularizer(layer.regularizer)
+{
+  // Nothing else to do.
+}
+
+// Move constructor.
+template<typename MatType, typename ActivationFunction,
+    typename RegularizerType>
+FusedLinearType<MatType, ActivationFunction, RegularizerType>::
+FusedLinearType(FusedLinearType&& layer) :
+    Layer<MatType>(std::move(layer)),
+    inSize(std::move(layer.inSize)),
+    outSize(std::move(layer.outSize)),
+    regularizer(std::move(layer.regularizer))
+{
+  // Nothing else to do.
+}
+
+template<typename MatType, typename ActivationFunction,
+    typename RegularizerType>
+FusedLinearType<MatType, ActivationFunction, RegularizerType>&
+FusedLinearType<MatType, ActivationFunction, RegularizerType>::operator=(
+    const FusedLinearType& layer)
+{
+  if (&layer != this)
+  {
+    Layer<MatType>::operator=(layer);
+    inSize = layer.inSize;
+    outSize = layer.outSize;
+    regularizer = layer.regularizer;
+  }
+
+  return *this;
+}
+
+template<typename MatType, typename ActivationFunction,
+    typename RegularizerType>
+FusedLinearType<MatType, ActivationFunction, RegularizerType>&
+FusedLinearType<MatType, ActivationFunction, RegularizerType>::operator=(
+    FusedLinearType&& layer)
+{
+  if (&layer != this)
+  {
+    Layer<MatType>::operator=(std::move(layer));
+    inSize = std::move(layer.inSize);
+    outSize = std::move(layer.outSize);
+    regularizer = std::move(layer.regularizer);
+  }
+
+  return *this;
+}
+
+template<typename MatType, typename ActivationFunction,
+    typename RegularizerType>
+void FusedLinearType<MatType, ActivationFunction, RegularizerType>::SetWeights(
+    typename MatType::elem_type* weightsPtr)
+{
+  MakeAlias(weights, weightsPtr, outSize * inSize + outSize, 1);
+  MakeAlias(weight, weightsPtr, outSize, inSize);
+  MakeAlias(bias, weightsPtr + weight.n_elem, outSize, 1);
+}
+
+template<typename MatType, typename ActivationFunction,
+    typename RegularizerType>
+void FusedLinearType<MatType, ActivationFunction, RegularizerType>::Forward(
+    const MatType& input, MatType& output)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  output.set_size(weight.n_rows, input.n_cols);
+
+  // Compute the linear transformation one block of columns at a time, and
+  // apply the bias and the activation to each block in a single pass while it
+  // is still in cache, instead of writing the full linear output and reading
+  // it back for the epilogue.
+  const size_t blockSize = 256;
+  const ElemType* biasPtr = bias.memptr();
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < (size_t) input.n_cols; block += blockSize)
+  {
+    const size_t lastCol = std::min(block + blockSize,
+        (size_t) input.n_cols) - 1;
+    output.cols(block, lastCol) = weight * input.cols(block, lastCol);
+
+    for (size_t c = block; c <= lastCol; ++c)
+    {
+      ElemType* outPtr = output.colptr(c);
+      for (size_t r = 0; r < (size_t) output.n_rows; ++r)
+        outPtr[r] = ActivationFunction::Fn(outPtr[r] + biasPtr[r]);
+    }
+  }
+}
+
+template<typename MatType, typename ActivationFunction,
+    typename RegularizerType>
+void FusedLinearType<MatType, ActivationFunction, RegularizerType>::Backward(
+    const MatType& output, const MatType& gy, MatType& g)
+{
+  // The derivative of the activation is computed from the activation output,
+  // in the same way as BaseLayer does.
+  MatType derivative;
+  ActivationFunction::Deriv(output, derivative);
+
+  // Keep the pre-activation delta around for Gradient().
+  delta = gy % derivative;
+  g = weight.t() * delta;
+}
+
+template<typename MatType, typename ActivationFunction,
+    typename RegularizerType>
+void FusedLinearType<MatType, ActivationFunction, RegularizerType>::Gradient(
+    const MatType& input,
+    const MatType& /* error */,
+    MatType& gradient)
+{
+  gradient.submat(0, 0, weight.n_elem - 1, 0) = arma::vectorise(
+      delta * input.t());
+  gradient.submat(weight.n_elem, 0, gradient.n_elem - 1, 0) =
+      arma::sum(delta, 1);
+
+  regularizer.Evaluate(weights, gradient);
+}
+
+template<typename MatType, typename ActivationFunction,
+    typename RegularizerType>
+void FusedLinearType<MatType, ActivationFunction, RegularizerType>::
+ComputeOutputDimensions()
+{
+  inSize = this->inputDimensions[0];
+  for (size_t i = 1; i < this->inputDimensions.size(); ++i)
+    inSize *= this->inputDimensions[i];
+  this->outputDimensions = std::vector<size_t>(this->inputDimensions.size(),
+      1);
+
+  // The FusedLinear layer flattens its input.
+  this->outputDimensions[0] = outSize;
+}
+
+template<typename MatType, typename ActivationFunction,
+    typename RegularizerType>
+template<typename Archive>
+void FusedLinearType<MatType, ActivationFunction, RegularizerType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<Layer<MatType>>(this));
+
+  ar(CEREAL_NVP(inSize));
+  ar(CEREAL_NVP(outSize));
+  ar(CEREAL_NVP(regularizer));
+}
+
+} // namespace mlpack
+
+#endif
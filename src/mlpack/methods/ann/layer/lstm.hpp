@@ -48,8 +48,9 @@ namespace mlpack {
  * }
  * @endcode
  *
- * \see FastLSTM for a faster LSTM version which combines the calculation of the
- * input, forget, output gates and hidden state in a single step.
+ * Internally, the weights of all four gates are fused into single matrices, so
+ * that each step computes the gate pre-activations with one GEMM for the input
+ * contribution and one for the recurrent contribution.
  *
  * @tparam MatType Matrix representation to accept as input and use for
  *    computation.
@@ -168,64 +169,34 @@ class LSTMType : public RecurrentLayer<MatType>
   //! Locally-stored weight object.
   MatType weights;
 
-  //! Weights between the output and input gate.
-  MatType output2GateInputWeight;
+  //! Fused input-to-gate weights; the four row blocks hold the weights of the
+  //! output gate, forget gate, input gate, and hidden connection (in that
+  //! order), so that one GEMM computes the input contribution to all four
+  //! gates.
+  MatType input2GateWeight;
 
-  //! Weights between the input and gate.
-  MatType input2GateInputWeight;
+  //! Fused input-to-gate biases, with the same row block order as
+  //! `input2GateWeight`.
+  MatType input2GateBias;
 
-  //! Bias between the input and input gate.
-  MatType input2GateInputBias;
+  //! Fused recurrent (output-to-gate) weights, with the same row block order
+  //! as `input2GateWeight`.
+  MatType output2GateWeight;
 
   //! Weights between the cell and input gate.
   MatType cell2GateInputWeight;
 
-  //! Weights between the output and forget gate.
-  MatType output2GateForgetWeight;
-
-  //! Weights between the input and gate.
-  MatType input2GateForgetWeight;
-
-  //! Bias between the input and gate.
-  MatType input2GateForgetBias;
-
-  //! Bias between the input and gate.
+  //! Weights between the cell and forget gate.
   MatType cell2GateForgetWeight;
 
-  //! Weights between the output and gate.
-  MatType output2GateOutputWeight;
-
-  //! Weights between the input and gate.
-  MatType input2GateOutputWeight;
-
-  //! Bias between the input and gate.
-  MatType input2GateOutputBias;
-
   //! Weights between cell and output gate.
   MatType cell2GateOutputWeight;
 
   // Below here are recurrent state matrices.
 
-  //! Locally-stored input gate parameter.
-  MatType inputGate;
-
-  //! Locally-stored forget gate parameter.
-  MatType forgetGate;
-
-  //! Locally-stored hidden layer parameter.
-  MatType hiddenLayer;
-
-  //! Locally-stored output gate parameter.
-  MatType outputGate;
-
-  //! Locally-stored input to hidden weight.
-  MatType input2HiddenWeight;
-
-  //! Locally-stored input to hidden bias.
-  MatType input2HiddenBias;
-
-  //! Locally-stored output to hidden weight.
-  MatType output2HiddenWeight;
+  //! Locally-stored fused pre-activations of all four gates (with the same
+  //! row block order as `input2GateWeight`).
+  MatType gate;
 
   //! Locally-stored cell parameter.
   arma::Cube<typename MatType::elem_type> cell;
@@ -247,23 +218,15 @@ class LSTMType : public RecurrentLayer<MatType>
   //! Locally-stored cell activation error.
   arma::Cube<typename MatType::elem_type> cellActivation;
 
-  //! Locally-stored forget gate error.
-  MatType forgetGateError;
-
-  //! Locally-stored output gate error.
-  MatType outputGateError;
+  //! Locally-stored fused errors of all four gates (with the same row block
+  //! order as `input2GateWeight`).
+  MatType gateError;
 
   //! Locally-stored output parameters.
   arma::Cube<typename MatType::elem_type> outParameter;
 
   //! Locally-stored input cell error parameter.
   MatType inputCellError;
-
-  //! Locally-stored input gate error.
-  MatType inputGateError;
-
-  //! Locally-stored hidden layer error.
-  MatType hiddenError;
 }; // class LSTMType
 
 // Convenience typedefs.
@@ -75,10 +75,7 @@ void LSTMType<MatType>::ClearRecurrentState(
 {
   // Make sure all of the different matrices we will use to hold parameters are
   // at least as large as we need.
-  inputGate.set_size(outSize, batchSize);
-  forgetGate.set_size(outSize, batchSize);
-  hiddenLayer.set_size(outSize, batchSize);
-  outputGate.set_size(outSize, batchSize);
+  gate.set_size(4 * outSize, batchSize);
 
   inputGateActivation.set_size(outSize, batchSize, bpttSteps);
   forgetGateActivation.set_size(outSize, batchSize, bpttSteps);
@@ -96,45 +93,18 @@ template<typename MatType>
 void LSTMType<MatType>::SetWeights(
     typename MatType::elem_type* weightsPtr)
 {
-  // Set the weight parameter for the output gate.
-  MakeAlias(input2GateOutputWeight, weightsPtr, outSize, inSize);
-  size_t offset = input2GateOutputWeight.n_elem;
-  MakeAlias(input2GateOutputBias, weightsPtr + offset, outSize, 1);
-  offset += input2GateOutputBias.n_elem;
-
-  // Set the weight parameter for the forget gate.
-  MakeAlias(input2GateForgetWeight, weightsPtr + offset, outSize, inSize);
-  offset += input2GateForgetWeight.n_elem;
-  MakeAlias(input2GateForgetBias, weightsPtr + offset, outSize, 1);
-  offset += input2GateForgetBias.n_elem;
-
-  // Set the weight parameter for the input gate.
-  MakeAlias(input2GateInputWeight, weightsPtr + offset, outSize, inSize);
-  offset += input2GateInputWeight.n_elem;
-  MakeAlias(input2GateInputBias, weightsPtr + offset, outSize, 1);
-  offset += input2GateInputBias.n_elem;
-
-  // Set the weight parameter for the hidden gate.
-  MakeAlias(input2HiddenWeight, weightsPtr + offset, outSize, inSize);
-  offset += input2HiddenWeight.n_elem;
-  MakeAlias(input2HiddenBias, weightsPtr + offset, outSize, 1);
-  offset += input2HiddenBias.n_elem;
-
-  // Set the weight parameter for the output multiplication.
-  MakeAlias(output2GateOutputWeight, weightsPtr + offset, outSize, outSize);
-  offset += output2GateOutputWeight.n_elem;
-
-  // Set the weight parameter for the output multiplication.
-  MakeAlias(output2GateForgetWeight, weightsPtr + offset, outSize, outSize);
-  offset += output2GateForgetWeight.n_elem;
-
-  // Set the weight parameter for the input multiplication.
-  MakeAlias(output2GateInputWeight, weightsPtr + offset, outSize, outSize);
-  offset += output2GateInputWeight.n_elem;
-
-  // Set the weight parameter for the hidden multiplication.
-  MakeAlias(output2HiddenWeight, weightsPtr + offset, outSize, outSize);
-  offset += output2HiddenWeight.n_elem;
+  // The weights of all four gates are fused into a single matrix, with one
+  // row block per gate (ordered as output gate, forget gate, input gate,
+  // hidden), so that the gate pre-activations can be computed with a single
+  // GEMM per step instead of four.
+  MakeAlias(input2GateWeight, weightsPtr, 4 * outSize, inSize);
+  size_t offset = input2GateWeight.n_elem;
+  MakeAlias(input2GateBias, weightsPtr + offset, 4 * outSize, 1);
+  offset += input2GateBias.n_elem;
+
+  // Set the fused recurrent weights, with the same row block order.
+  MakeAlias(output2GateWeight, weightsPtr + offset, 4 * outSize, outSize);
+  offset += output2GateWeight.n_elem;
 
   // Set the weight parameter for the cell multiplication.
   MakeAlias(cell2GateOutputWeight, weightsPtr + offset, outSize, 1);
@@ -142,7 +112,7 @@ void LSTMType<MatType>::SetWeights(
 
   // Set the weight parameter for the cell - forget gate multiplication.
   MakeAlias(cell2GateForgetWeight, weightsPtr + offset, outSize, 1);
-  offset += cell2GateOutputWeight.n_elem;
+  offset += cell2GateForgetWeight.n_elem;
 
   // Set the weight parameter for the cell - input gate multiplication.
   MakeAlias(cell2GateInputWeight, weightsPtr + offset, outSize, 1);
@@ -152,48 +122,35 @@ void LSTMType<MatType>::SetWeights(
 template<typename MatType>
 void LSTMType<MatType>::Forward(const MatType& input, MatType& output)
 {
-  // Convenience alias.
-  const size_t batchSize = input.n_cols;
-
-  inputGate = input2GateInputWeight * input;
-  if (this->HasPreviousStep())
-  {
-    inputGate +=
-        output2GateInputWeight * outParameter.slice(this->PreviousStep());
-  }
-  inputGate.each_col() += input2GateInputBias;
-
-  forgetGate = input2GateForgetWeight * input;
+  // Compute the pre-activations of all four gates at once: one fused GEMM for
+  // the input contribution, and one for the recurrent contribution.  The row
+  // blocks of `gate` are ordered as output gate, forget gate, input gate,
+  // hidden (see SetWeights()).
+  gate = input2GateWeight * input;
   if (this->HasPreviousStep())
   {
-    forgetGate += output2GateForgetWeight * outParameter.slice(
-        this->PreviousStep());
+    gate += output2GateWeight * outParameter.slice(this->PreviousStep());
   }
-  forgetGate.each_col() += input2GateForgetBias;
+  gate.each_col() += input2GateBias;
 
+  // Add the peephole connections from the previous cell state to the forget
+  // and input gates.
   if (this->HasPreviousStep())
   {
-    inputGate += arma::repmat(cell2GateInputWeight, 1, batchSize) %
-        cell.slice(this->PreviousStep());
+    gate.rows(outSize, 2 * outSize - 1) +=
+        cell.slice(this->PreviousStep()).each_col() % cell2GateForgetWeight;
 
-    forgetGate += arma::repmat(cell2GateForgetWeight, 1, batchSize) %
-        cell.slice(this->PreviousStep());
+    gate.rows(2 * outSize, 3 * outSize - 1) +=
+        cell.slice(this->PreviousStep()).each_col() % cell2GateInputWeight;
   }
 
-  inputGateActivation.slice(this->CurrentStep()) =
-      1.0 / (1.0 + arma::exp(-inputGate));
   forgetGateActivation.slice(this->CurrentStep()) =
-      1.0 / (1.0 + arma::exp(-forgetGate));
-
-  hiddenLayer = input2HiddenWeight * input;
-  if (this->HasPreviousStep())
-  {
-    hiddenLayer += output2HiddenWeight *
-        outParameter.slice(this->PreviousStep());
-  }
-  hiddenLayer.each_col() += input2HiddenBias;
+      1.0 / (1.0 + arma::exp(-gate.rows(outSize, 2 * outSize - 1)));
+  inputGateActivation.slice(this->CurrentStep()) =
+      1.0 / (1.0 + arma::exp(-gate.rows(2 * outSize, 3 * outSize - 1)));
 
-  hiddenLayerActivation.slice(this->CurrentStep()) = arma::tanh(hiddenLayer);
+  hiddenLayerActivation.slice(this->CurrentStep()) =
+      arma::tanh(gate.rows(3 * outSize, 4 * outSize - 1));
 
   if (!this->HasPreviousStep())
   {
@@ -210,17 +167,13 @@ void LSTMType<MatType>::Forward(const MatType& input, MatType& output)
         hiddenLayerActivation.slice(this->CurrentStep());
   }
 
-  outputGate = input2GateOutputWeight * input +
+  // The output gate's peephole connection uses the current cell state, so it
+  // can only be added after the cell update.
+  gate.rows(0, outSize - 1) +=
       cell.slice(this->CurrentStep()).each_col() % cell2GateOutputWeight;
-  if (this->HasPreviousStep())
-  {
-    outputGate +=
-        output2GateOutputWeight * outParameter.slice(this->PreviousStep());
-  }
-  outputGate.each_col() += input2GateOutputBias;
 
   outputGateActivation.slice(this->CurrentStep()) =
-      1.0 / (1.0 + arma::exp(-outputGate));
+      1.0 / (1.0 + arma::exp(-gate.rows(0, outSize - 1)));
 
   cellActivation.slice(this->CurrentStep()) =
       arma::tanh(cell.slice(this->CurrentStep()));
@@ -243,10 +196,10 @@ void LSTMType<MatType>::Backward(
   MatType gyLocal;
   if (this->HasPreviousStep())
   {
-    gyLocal = gy + output2GateOutputWeight.t() * outputGateError +
-      output2GateForgetWeight.t() * forgetGateError +
-      output2GateInputWeight.t() * inputGateError +
-      output2HiddenWeight.t() * hiddenError;
+    // `gateError` still holds the fused gate errors of the previously
+    // processed step, so one fused GEMM backpropagates all four recurrent
+    // connections.
+    gyLocal = gy + output2GateWeight.t() * gateError;
   }
   else
   {
@@ -255,14 +208,19 @@ void LSTMType<MatType>::Backward(
         false, false);
   }
 
-  outputGateError = gyLocal % cellActivation.slice(this->CurrentStep()) %
+  // The row blocks of `gateError` are ordered as output gate, forget gate,
+  // input gate, hidden, matching the fused weight matrices (see SetWeights()).
+  gateError.set_size(4 * outSize, gyLocal.n_cols);
+
+  gateError.rows(0, outSize - 1) =
+      gyLocal % cellActivation.slice(this->CurrentStep()) %
       (outputGateActivation.slice(this->CurrentStep()) %
       (1.0 - outputGateActivation.slice(this->CurrentStep())));
 
   MatType cellError = gyLocal %
       outputGateActivation.slice(this->CurrentStep()) %
       (1 - arma::pow(cellActivation.slice(this->CurrentStep()), 2)) +
-      outputGateError.each_col() % cell2GateOutputWeight;
+      gateError.rows(0, outSize - 1).each_col() % cell2GateOutputWeight;
 
   if (this->HasPreviousStep())
   {
@@ -271,31 +229,34 @@ void LSTMType<MatType>::Backward(
 
   if (this->HasPreviousStep())
   {
-    forgetGateError = cell.slice(this->PreviousStep()) % cellError %
+    gateError.rows(outSize, 2 * outSize - 1) =
+        cell.slice(this->PreviousStep()) % cellError %
         (forgetGateActivation.slice(this->CurrentStep()) %
         (1.0 - forgetGateActivation.slice(this->CurrentStep())));
   }
   else
   {
-    forgetGateError.zeros(forgetGateActivation.n_rows,
-        forgetGateActivation.n_cols);
+    gateError.rows(outSize, 2 * outSize - 1).zeros();
   }
 
-  inputGateError = hiddenLayerActivation.slice(this->CurrentStep()) %
+  gateError.rows(2 * outSize, 3 * outSize - 1) =
+      hiddenLayerActivation.slice(this->CurrentStep()) %
       cellError % (inputGateActivation.slice(this->CurrentStep()) %
       (1.0 - inputGateActivation.slice(this->CurrentStep())));
 
-  hiddenError = inputGateActivation.slice(this->CurrentStep()) % cellError %
+  gateError.rows(3 * outSize, 4 * outSize - 1) =
+      inputGateActivation.slice(this->CurrentStep()) % cellError %
       (1 - arma::pow(hiddenLayerActivation.slice(this->CurrentStep()), 2));
 
   inputCellError = forgetGateActivation.slice(this->CurrentStep()) % cellError +
-      forgetGateError.each_col() % cell2GateForgetWeight +
-      inputGateError.each_col() % cell2GateInputWeight;
-
-  g = input2GateInputWeight.t() * inputGateError +
-      input2HiddenWeight.t() * hiddenError +
-      input2GateForgetWeight.t() * forgetGateError +
-      input2GateOutputWeight.t() * outputGateError;
+      gateError.rows(outSize, 2 * outSize - 1).each_col() %
+          cell2GateForgetWeight +
+      gateError.rows(2 * outSize, 3 * outSize - 1).each_col() %
+          cell2GateInputWeight;
+
+  // A single fused GEMM backpropagates the error of all four gates to the
+  // input.
+  g = input2GateWeight.t() * gateError;
 }
 
 template<typename MatType>
@@ -307,75 +268,37 @@ void LSTMType<MatType>::Gradient(
   // This implementation depends on Gradient() being called just after
   // Backward(), which is something we can safely assume.
 
-  // Input2GateOutputWeight and input2GateOutputBias gradients.
-  gradient.submat(0, 0, input2GateOutputWeight.n_elem - 1, 0) =
-      arma::vectorise(outputGateError * input.t());
-  gradient.submat(input2GateOutputWeight.n_elem, 0,
-      input2GateOutputWeight.n_elem + input2GateOutputBias.n_elem - 1, 0) =
-      arma::sum(outputGateError, 1);
-  size_t offset = input2GateOutputWeight.n_elem + input2GateOutputBias.n_elem;
-
-  // input2GateForgetWeight and input2GateForgetBias gradients.
-  gradient.submat(offset, 0, offset + input2GateForgetWeight.n_elem - 1, 0) =
-      arma::vectorise(forgetGateError * input.t());
-  gradient.submat(offset + input2GateForgetWeight.n_elem, 0,
-      offset + input2GateForgetWeight.n_elem +
-      input2GateForgetBias.n_elem - 1, 0) = arma::sum(forgetGateError, 1);
-  offset += input2GateForgetWeight.n_elem + input2GateForgetBias.n_elem;
-
-  // input2GateInputWeight and input2GateInputBias gradients.
-  gradient.submat(offset, 0, offset + input2GateInputWeight.n_elem - 1, 0) =
-      arma::vectorise(inputGateError * input.t());
-  gradient.submat(offset + input2GateInputWeight.n_elem, 0,
-      offset + input2GateInputWeight.n_elem +
-      input2GateInputBias.n_elem - 1, 0) = arma::sum(inputGateError, 1);
-  offset += input2GateInputWeight.n_elem + input2GateInputBias.n_elem;
-
-  // input2HiddenWeight and input2HiddenBias gradients.
-  gradient.submat(offset, 0, offset + input2HiddenWeight.n_elem - 1, 0) =
-      arma::vectorise(hiddenError * input.t());
-  gradient.submat(offset + input2HiddenWeight.n_elem, 0,
-      offset + input2HiddenWeight.n_elem + input2HiddenBias.n_elem - 1, 0) =
-      arma::sum(hiddenError, 1);
-  offset += input2HiddenWeight.n_elem + input2HiddenBias.n_elem;
-
-  // output2GateOutputWeight gradients.
-  gradient.submat(offset, 0, offset + output2GateOutputWeight.n_elem - 1, 0) =
-      arma::vectorise(outputGateError *
-      outParameter.slice(this->CurrentStep()).t());
-  offset += output2GateOutputWeight.n_elem;
-
-  // output2GateForgetWeight gradients.
-  gradient.submat(offset, 0, offset + output2GateForgetWeight.n_elem - 1, 0) =
-      arma::vectorise(forgetGateError *
-      outParameter.slice(this->CurrentStep()).t());
-  offset += output2GateForgetWeight.n_elem;
-
-  // output2GateInputWeight gradients.
-  gradient.submat(offset, 0, offset + output2GateInputWeight.n_elem - 1, 0) =
-      arma::vectorise(inputGateError *
-      outParameter.slice(this->CurrentStep()).t());
-  offset += output2GateInputWeight.n_elem;
-
-  // output2HiddenWeight gradients.
-  gradient.submat(offset, 0, offset + output2HiddenWeight.n_elem - 1, 0) =
-      arma::vectorise(hiddenError *
+  // Fused input2GateWeight and input2GateBias gradients; one GEMM covers all
+  // four gates.
+  gradient.submat(0, 0, input2GateWeight.n_elem - 1, 0) =
+      arma::vectorise(gateError * input.t());
+  size_t offset = input2GateWeight.n_elem;
+  gradient.submat(offset, 0, offset + input2GateBias.n_elem - 1, 0) =
+      arma::sum(gateError, 1);
+  offset += input2GateBias.n_elem;
+
+  // Fused output2GateWeight (recurrent) gradients.
+  gradient.submat(offset, 0, offset + output2GateWeight.n_elem - 1, 0) =
+      arma::vectorise(gateError *
       outParameter.slice(this->CurrentStep()).t());
-  offset += output2HiddenWeight.n_elem;
+  offset += output2GateWeight.n_elem;
 
   // cell2GateOutputWeight gradients.
   gradient.submat(offset, 0, offset + cell2GateOutputWeight.n_elem - 1, 0) =
-      arma::sum(outputGateError % cell.slice(this->CurrentStep()), 1);
+      arma::sum(gateError.rows(0, outSize - 1) %
+      cell.slice(this->CurrentStep()), 1);
   offset += cell2GateOutputWeight.n_elem;
 
   // cell2GateForgetWeight and cell2GateInputWeight gradients.
   if (this->HasPreviousStep())
   {
     gradient.submat(offset, 0, offset + cell2GateForgetWeight.n_elem - 1, 0) =
-        arma::sum(forgetGateError % cell.slice(this->PreviousStep()), 1);
+        arma::sum(gateError.rows(outSize, 2 * outSize - 1) %
+        cell.slice(this->PreviousStep()), 1);
     gradient.submat(offset + cell2GateForgetWeight.n_elem, 0, offset +
         cell2GateForgetWeight.n_elem + cell2GateInputWeight.n_elem - 1, 0) =
-        arma::sum(inputGateError % cell.slice(this->PreviousStep()), 1);
+        arma::sum(gateError.rows(2 * outSize, 3 * outSize - 1) %
+        cell.slice(this->PreviousStep()), 1);
   }
   else
   {
@@ -404,12 +327,9 @@ void LSTMType<MatType>::serialize(Archive& ar, const uint32_t /* version */)
     outputGateActivation.clear();
     hiddenLayerActivation.clear();
     cellActivation.clear();
-    forgetGateError.clear();
-    outputGateError.clear();
+    gateError.clear();
     outParameter.clear();
     inputCellError.clear();
-    inputGateError.clear();
-    hiddenError.clear();
   }
 }
 
@@ -190,23 +190,28 @@ class MaxPoolingType : public Layer<MatType>
               continue;
             rowEnd = input.n_rows - 1;
           }
-          const std::tuple<size_t, typename MatType::elem_type> poolResult =
-              pooling.PoolingWithIndex(input.slice(s).submat(
-                  rowidx,
-                  colidx,
-                  rowEnd,
-                  colEnd));
-
-          // Now map the returned pooling index, which corresponds to the
-          // submatrix we gave, back to its position in the (linearized) input.
-          const size_t poolIndex = std::get<0>(poolResult);
-          const size_t poolingCol = poolIndex / (kernelWidth);
-          const size_t poolingRow = poolIndex % (kernelWidth);
-          const size_t unmappedPoolingIndex = (rowidx + poolingRow) +
-              input.n_rows * (colidx + poolingCol);
-
-          poolingIndices(i, j, s) = unmappedPoolingIndex;
-          output(i, j, s) = std::get<1>(poolResult);
+          // Scan the window with raw pointers; each window column is a
+          // contiguous run in memory, so this avoids the overhead of
+          // constructing a subview per window.
+          typename MatType::elem_type maxVal =
+              input(rowidx, colidx, s);
+          size_t maxIndex = rowidx + input.n_rows * colidx;
+          for (size_t c = colidx; c <= colEnd; ++c)
+          {
+            const typename MatType::elem_type* colPtr =
+                input.slice_colptr(s, c) + rowidx;
+            for (size_t r = 0; r <= rowEnd - rowidx; ++r)
+            {
+              if (colPtr[r] > maxVal)
+              {
+                maxVal = colPtr[r];
+                maxIndex = (rowidx + r) + input.n_rows * c;
+              }
+            }
+          }
+
+          poolingIndices(i, j, s) = maxIndex;
+          output(i, j, s) = maxVal;
         }
       }
     }
@@ -252,11 +257,23 @@ class MaxPoolingType : public Layer<MatType>
             rowEnd = input.n_rows - 1;
           }
 
-          output(i, j, s) = pooling.Pooling(input.slice(s).submat(
-              rowidx,
-              colidx,
-              rowEnd,
-              colEnd));
+          // Scan the window with raw pointers; each window column is a
+          // contiguous run in memory, so this avoids the overhead of
+          // constructing a subview per window.
+          typename MatType::elem_type maxVal =
+              input(rowidx, colidx, s);
+          for (size_t c = colidx; c <= colEnd; ++c)
+          {
+            const typename MatType::elem_type* colPtr =
+                input.slice_colptr(s, c) + rowidx;
+            for (size_t r = 0; r <= rowEnd - rowidx; ++r)
+            {
+              if (colPtr[r] > maxVal)
+                maxVal = colPtr[r];
+            }
+          }
+
+          output(i, j, s) = maxVal;
         }
       }
     }
@@ -198,12 +198,23 @@ class MultiLayer : public Layer<MatType>
   void serialize(Archive& ar, const uint32_t /* version */);
 
  protected:
+  /**
+   * Ensure that the workspace arena that backs all inter-layer buffers is
+   * large enough for the given `batchSize`, allocating it if needed.  The
+   * arena is planned for the largest batch size seen so far and every layer's
+   * buffer region is carved with that capacity, so smaller batches (e.g. the
+   * last batch of a shuffled epoch) alias prefixes of the same regions and
+   * cause no reallocation at all.  If `withDeltas` is true, the arena also
+   * holds a segment for the layer deltas of the backward pass.
+   */
+  void InitializeWorkspace(const size_t batchSize, const bool withDeltas);
+
   /**
    * Initialize memory that will be used by each layer for the forward pass,
    * assuming that the input will have the given `batchSize`.  When `Forward()`
    * is called, each internally-held layer will output its results into the
    * memory allocated by this function (this is the internal member
-   * `layerOutputMatrix` and its aliases `layerOutputs`).
+   * `workspace` and its aliases `layerOutputs`).
    */
   void InitializeForwardPassMemory(const size_t batchSize);
 
@@ -212,7 +223,7 @@ class MultiLayer : public Layer<MatType>
    * assuming that the input will have the given `batchSize`.  When `Backward()`
    * is called, each internally-held layer will output the results of its
    * backwards pass into the memory allocated by this function (this is the
-   * internal member `layerDeltaMatrix` and its aliases `layerDeltas`).
+   * internal member `workspace` and its aliases `layerDeltas`).
    */
   void InitializeBackwardPassMemory(const size_t batchSize);
 
@@ -234,16 +245,20 @@ class MultiLayer : public Layer<MatType>
   // Total number of output elements for *every* layer.
   size_t totalOutputSize;
 
-  //! This matrix stores all of the outputs of each layer when Forward() is
-  //! called.  See `InitializeForwardPassMemory()`.
-  MatType layerOutputMatrix;
-  //! These are aliases of `layerOutputMatrix` for each layer.
+  //! The single workspace arena holding every inter-layer buffer: the
+  //! outputs of each layer's Forward() call, followed by the results of each
+  //! layer's Backward() call when training.  See `InitializeWorkspace()`.
+  MatType workspace;
+  //! The batch size the workspace arena is carved for (the largest batch
+  //! size seen so far); 0 if the arena has not been allocated yet.
+  size_t workspaceBatchSize;
+  //! Whether the workspace arena includes the layer delta segment.
+  bool workspaceHasDeltas;
+
+  //! These are aliases of the output segment of `workspace`, one per layer.
   std::vector<MatType> layerOutputs;
 
-  //! This matrix stores all of the backwards pass results of each layer when
-  //! Backward() is called.  See `InitializeBackwardPassMemory()`.
-  MatType layerDeltaMatrix;
-  //! These are aliases of `layerDeltaMatrix` for each layer.
+  //! These are aliases of the delta segment of `workspace`, one per layer.
   std::vector<MatType> layerDeltas;
 
   //! Gradient aliases for each layer.  Note that this is *only* valid in the
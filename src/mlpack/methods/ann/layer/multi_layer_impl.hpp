@@ -22,7 +22,9 @@ MultiLayer<MatType>::MultiLayer() :
     Layer<MatType>(),
     inSize(0),
     totalInputSize(0),
-    totalOutputSize(0)
+    totalOutputSize(0),
+    workspaceBatchSize(0),
+    workspaceHasDeltas(false)
 {
   // Nothing to do.
 }
@@ -33,8 +35,8 @@ MultiLayer<MatType>::MultiLayer(const MultiLayer& other) :
     inSize(other.inSize),
     totalInputSize(other.totalInputSize),
     totalOutputSize(other.totalOutputSize),
-    layerOutputMatrix(other.layerOutputMatrix),
-    layerDeltaMatrix(other.layerDeltaMatrix)
+    workspaceBatchSize(0),
+    workspaceHasDeltas(false)
 {
   // Copy each layer.
   for (size_t i = 0; i < other.network.size(); ++i)
@@ -56,8 +58,9 @@ MultiLayer<MatType>::MultiLayer(MultiLayer&& other) :
     inSize(std::move(other.inSize)),
     totalInputSize(std::move(other.totalInputSize)),
     totalOutputSize(std::move(other.totalOutputSize)),
-    layerOutputMatrix(std::move(other.layerOutputMatrix)),
-    layerDeltaMatrix(std::move(other.layerDeltaMatrix))
+    workspace(std::move(other.workspace)),
+    workspaceBatchSize(other.workspaceBatchSize),
+    workspaceHasDeltas(other.workspaceHasDeltas)
 {
   // Ensure that the aliases for layers during passes have the right size.
   layerOutputs.resize(network.size(), MatType());
@@ -70,6 +73,8 @@ MultiLayer<MatType>::MultiLayer(MultiLayer&& other) :
   other.layerOutputs.clear();
   other.layerDeltas.clear();
   other.layerGradients.clear();
+  other.workspaceBatchSize = 0;
+  other.workspaceHasDeltas = false;
 }
 
 template<typename MatType>
@@ -88,8 +93,9 @@ MultiLayer<MatType>& MultiLayer<MatType>::operator=(const MultiLayer& other)
     totalInputSize = other.totalInputSize;
     totalOutputSize = other.totalOutputSize;
 
-    layerOutputMatrix = other.layerOutputMatrix;
-    layerDeltaMatrix = other.layerDeltaMatrix;
+    workspace.clear();
+    workspaceBatchSize = 0;
+    workspaceHasDeltas = false;
 
     for (size_t i = 0; i < other.network.size(); ++i)
       network.push_back(other.network[i]->Clone());
@@ -120,6 +126,12 @@ MultiLayer<MatType>& MultiLayer<MatType>::operator=(MultiLayer&& other)
 
     network = std::move(other.network);
 
+    workspace = std::move(other.workspace);
+    workspaceBatchSize = other.workspaceBatchSize;
+    workspaceHasDeltas = other.workspaceHasDeltas;
+    other.workspaceBatchSize = 0;
+    other.workspaceHasDeltas = false;
+
     layerOutputs.resize(network.size(), MatType());
     layerDeltas.resize(network.size(), MatType());
     layerGradients.resize(network.size(), MatType());
@@ -353,8 +365,9 @@ void MultiLayer<MatType>::serialize(
 
   if (Archive::is_loading::value)
   {
-    layerOutputMatrix.clear();
-    layerDeltaMatrix.clear();
+    workspace.clear();
+    workspaceBatchSize = 0;
+    workspaceHasDeltas = false;
     layerGradients.clear();
     layerOutputs.resize(network.size(), MatType());
     layerDeltas.resize(network.size(), MatType());
@@ -363,19 +376,51 @@ void MultiLayer<MatType>::serialize(
 }
 
 template<typename MatType>
-void MultiLayer<MatType>::InitializeForwardPassMemory(const size_t batchSize)
+void MultiLayer<MatType>::InitializeWorkspace(const size_t batchSize,
+                                              const bool withDeltas)
 {
-  // We need to initialize memory to store the output of each layer's Forward()
-  // call.  We'll do this all in one matrix, but, the size of this matrix
-  // depends on the batch size we are using for computation.  We avoid resizing
-  // layerOutputMatrix down, unless we only need 10% or less of it.
-  if (batchSize * totalOutputSize > layerOutputMatrix.n_elem ||
-      batchSize * totalOutputSize <
-          std::floor(0.1 * layerOutputMatrix.n_elem))
+  if (batchSize <= workspaceBatchSize &&
+      (workspaceHasDeltas || !withDeltas))
+  {
+    // The arena is already large enough.
+    return;
+  }
+
+  const size_t newBatchSize = std::max(batchSize, workspaceBatchSize);
+  const bool newHasDeltas = workspaceHasDeltas || withDeltas;
+  const size_t elems = newBatchSize *
+      (totalOutputSize + (newHasDeltas ? totalInputSize : 0));
+
+  if (withDeltas && !workspaceHasDeltas && newBatchSize == workspaceBatchSize)
   {
-    // All outputs will be represented by one big block of memory.
-    layerOutputMatrix = MatType(1, batchSize * totalOutputSize);
+    // We are only appending the delta segment, after a forward pass has
+    // already written the layer outputs into the arena; resize() preserves
+    // them (the output segment is a prefix of the arena and its layout does
+    // not change).  The output aliases are refreshed by
+    // InitializeBackwardPassMemory().
+    workspace.resize(1, elems);
   }
+  else
+  {
+    workspace.set_size(1, elems);
+  }
+
+  workspaceBatchSize = newBatchSize;
+  workspaceHasDeltas = newHasDeltas;
+}
+
+template<typename MatType>
+void MultiLayer<MatType>::InitializeForwardPassMemory(const size_t batchSize)
+{
+  // We need memory to store the output of each layer's Forward() call.  All
+  // of the inter-layer buffers are carved out of the single workspace arena,
+  // which is planned for the largest batch size seen so far; each layer's
+  // region has the capacity of that largest batch size, so smaller batches
+  // (e.g. the odd-sized last batch of a shuffled epoch) simply alias a prefix
+  // of the same regions without any reallocation.  When training, the delta
+  // segment is reserved up front so that Backward() does not have to grow the
+  // arena.
+  InitializeWorkspace(batchSize, this->training);
 
   // Now, create an alias to the right place for each layer.  We assume that
   // layerOutputs is already sized correctly (this should be done by Add()).
@@ -383,9 +428,9 @@ void MultiLayer<MatType>::InitializeForwardPassMemory(const size_t batchSize)
   for (size_t i = 0; i < layerOutputs.size(); ++i)
   {
     const size_t layerOutputSize = network[i]->OutputSize();
-    MakeAlias(layerOutputs[i], layerOutputMatrix.colptr(start),
-        layerOutputSize, batchSize);
-    start += batchSize * layerOutputSize;
+    MakeAlias(layerOutputs[i], workspace.colptr(start), layerOutputSize,
+        batchSize);
+    start += workspaceBatchSize * layerOutputSize;
   }
 }
 
@@ -393,28 +438,34 @@ template<typename MatType>
 void MultiLayer<MatType>::InitializeBackwardPassMemory(
     const size_t batchSize)
 {
-  // We need to initialize memory to store the output of each layer's Backward()
-  // call.  We do this similarly to InitializeForwardPassMemory(), but we must
-  // store a matrix to use as the delta for each layer.
-  if (batchSize * totalInputSize > layerDeltaMatrix.n_elem ||
-      batchSize * totalInputSize < std::floor(0.1 * layerDeltaMatrix.n_elem))
+  // We need memory to store the result of each layer's Backward() call; the
+  // deltas live in the second segment of the workspace arena.  If the network
+  // was not in training mode during the forward pass, the segment may have to
+  // be appended now, which can reallocate the arena; the output aliases are
+  // refreshed below either way, since Backward() uses them too.
+  InitializeWorkspace(batchSize, true);
+
+  size_t start = 0;
+  for (size_t i = 0; i < layerOutputs.size(); ++i)
   {
-    // All deltas will be represented by one big block of memory.
-    layerDeltaMatrix = MatType(1, batchSize * totalInputSize);
+    const size_t layerOutputSize = network[i]->OutputSize();
+    MakeAlias(layerOutputs[i], workspace.colptr(start), layerOutputSize,
+        batchSize);
+    start += workspaceBatchSize * layerOutputSize;
   }
 
   // Now, create an alias to the right place for each layer.  We assume that
   // layerDeltas is already sized correctly (this should be done by Add()).
-  size_t start = 0;
+  start = workspaceBatchSize * totalOutputSize;
   for (size_t i = 0; i < layerDeltas.size(); ++i)
   {
     size_t layerInputSize = 1;
     for (size_t j = 0; j < this->network[i]->InputDimensions().size(); ++j)
       layerInputSize *= this->network[i]->InputDimensions()[j];
 
-    MakeAlias(layerDeltas[i], layerDeltaMatrix.colptr(start), layerInputSize,
+    MakeAlias(layerDeltas[i], workspace.colptr(start), layerInputSize,
         batchSize);
-    start += batchSize * layerInputSize;
+    start += workspaceBatchSize * layerInputSize;
   }
 }
 
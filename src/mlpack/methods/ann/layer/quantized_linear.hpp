@@ -0,0 +1,154 @@
+/**
+ * @file methods/ann/layer/quantized_linear.hpp
+ * @author Ryan Curtin
+ *
+ * Definition of the QuantizedLinear layer class, an inference-only
+ * fully-connected layer with int8 weights.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_HPP
+#define MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "layer.hpp"
+
+namespace mlpack {
+
+/**
+ * Implementation of the QuantizedLinear layer class, an inference-only
+ * replacement for a trained Linear layer.  The weights are stored as int8
+ * values with one symmetric scale per output channel, a quarter of the memory
+ * of the floating-point weights; the input of each forward pass is quantized
+ * to int8 with a per-column scale, the products are accumulated in int32, and
+ * only the final result is scaled back (and biased) in floating point.
+ *
+ * The layer is built from the weights of a trained Linear layer (see
+ * `FFN::Quantize()`), holds no trainable parameters, and cannot be used for
+ * training: `Backward()` and `Gradient()` throw.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class QuantizedLinearType : public Layer<MatType>
+{
+ public:
+  //! Create the QuantizedLinear object.
+  QuantizedLinearType();
+
+  /**
+   * Create the QuantizedLinear layer by quantizing the given weight matrix
+   * and bias (e.g. those of a trained Linear layer).  Each row of `weight`
+   * (output channel) is quantized symmetrically to the int8 range with its
+   * own scale.
+   *
+   * @param weight The (outSize x inSize) weight matrix to quantize.
+   * @param bias The bias column vector; kept in floating point.
+   */
+  QuantizedLinearType(const MatType& weight, const MatType& bias);
+
+  virtual ~QuantizedLinearType() { }
+
+  //! Clone the QuantizedLinearType object. This handles polymorphism
+  //! correctly.
+  QuantizedLinearType* Clone() const
+  {
+    return new QuantizedLinearType(*this);
+  }
+
+  /**
+   * Ordinary feed forward pass of a neural network, evaluating the function
+   * f(x) by propagating the activity forward through f.
+   *
+   * The input is quantized to int8 column by column, multiplied against the
+   * int8 weights with int32 accumulation, and the result is rescaled to
+   * floating point and biased.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * The backward pass is not available for quantized layers; this throws an
+   * exception.
+   */
+  void Backward(const MatType& /* input */,
+                const MatType& /* gy */,
+                MatType& /* g */)
+  {
+    throw std::runtime_error("QuantizedLinear::Backward(): quantized layers "
+        "are inference-only and cannot be used for training!");
+  }
+
+  /**
+   * The gradient pass is not available for quantized layers; this throws an
+   * exception.
+   */
+  void Gradient(const MatType& /* input */,
+                const MatType& /* error */,
+                MatType& /* gradient */)
+  {
+    throw std::runtime_error("QuantizedLinear::Gradient(): quantized layers "
+        "are inference-only and cannot be used for training!");
+  }
+
+  //! Get the quantized weights, stored transposed (inSize x outSize) so that
+  //! each output channel is contiguous.
+  const arma::Mat<signed char>& QuantizedWeight() const
+  {
+    return quantizedWeight;
+  }
+
+  //! Get the per-output-channel weight scales.
+  const arma::Col<typename MatType::elem_type>& Scales() const
+  {
+    return scales;
+  }
+
+  //! Get the bias of the layer.
+  MatType const& Bias() const { return bias; }
+
+  //! The layer holds no trainable weights.
+  size_t WeightSize() const { return 0; }
+
+  //! Compute the output dimensions of the layer given `InputDimensions()`.
+  void ComputeOutputDimensions();
+
+  //! Serialize the layer.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Locally-stored number of input units.
+  size_t inSize;
+
+  //! Locally-stored number of output units.
+  size_t outSize;
+
+  //! The int8 weights, stored transposed (inSize x outSize).
+  arma::Mat<signed char> quantizedWeight;
+
+  //! One symmetric quantization scale per output channel.
+  arma::Col<typename MatType::elem_type> scales;
+
+  //! The bias term, kept in floating point.
+  MatType bias;
+}; // class QuantizedLinearType
+
+// Convenience typedefs.
+
+// Standard QuantizedLinear layer.
+typedef QuantizedLinearType<arma::mat> QuantizedLinear;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "quantized_linear_impl.hpp"
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ * @file methods/ann/layer/quantized_linear_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the QuantizedLinear layer class, an inference-only
+ * fully-connected layer with int8 weights.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "quantized_linear.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+QuantizedLinearType<MatType>::QuantizedLinearType() :
+    Layer<MatType>(),
+    inSize(0),
+    outSize(0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+QuantizedLinearType<MatType>::QuantizedLinearType(
+    const MatType& weight,
+    const MatType& biasIn) :
+    Layer<MatType>(),
+    inSize(weight.n_cols),
+    outSize(weight.n_rows),
+    bias(biasIn)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  // Quantize each output channel (row of the weight matrix) symmetrically to
+  // [-127, 127] with its own scale.  The quantized weights are stored
+  // transposed, so that each output channel is a contiguous column.
+  quantizedWeight.set_size(inSize, outSize);
+  scales.set_size(outSize);
+  for (size_t r = 0; r < outSize; ++r)
+  {
+    const ElemType maxAbs = arma::abs(weight.row(r)).max();
+    scales[r] = (maxAbs > 0) ? (maxAbs / 127) : ElemType(1);
+
+    const ElemType invScale = 1 / scales[r];
+    for (size_t c = 0; c < inSize; ++c)
+    {
+      const int q = (int) std::round(weight(r, c) * invScale);
+      quantizedWeight(c, r) = (signed char) std::max(-127, std::min(127, q));
+    }
+  }
+}
+
+template<typename MatType>
+void QuantizedLinearType<MatType>::Forward(
+    const MatType& input, MatType& output)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  output.set_size(outSize, input.n_cols);
+
+  const size_t blockSize = 256;
+  const ElemType* biasPtr = bias.memptr();
+  const ElemType* scalePtr = scales.memptr();
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < (size_t) input.n_cols; block += blockSize)
+  {
+    const size_t lastCol = std::min(block + blockSize,
+        (size_t) input.n_cols) - 1;
+    arma::Col<signed char> quantizedInput(inSize);
+    signed char* qPtr = quantizedInput.memptr();
+
+    for (size_t c = block; c <= lastCol; ++c)
+    {
+      // Quantize the input column symmetrically to [-127, 127].
+      const ElemType maxAbs = arma::abs(input.col(c)).max();
+      const ElemType inputScale = (maxAbs > 0) ? (maxAbs / 127) : ElemType(1);
+
+      const ElemType invScale = 1 / inputScale;
+      const ElemType* inPtr = input.colptr(c);
+      for (size_t i = 0; i < inSize; ++i)
+      {
+        const int q = (int) std::round(inPtr[i] * invScale);
+        qPtr[i] = (signed char) std::max(-127, std::min(127, q));
+      }
+
+      // All products are accumulated in int32; only the final result is
+      // scaled back to floating point and biased.
+      ElemType* outPtr = output.colptr(c);
+      for (size_t r = 0; r < outSize; ++r)
+      {
+        const signed char* weightPtr = quantizedWeight.colptr(r);
+        int accumulator = 0;
+        for (size_t i = 0; i < inSize; ++i)
+          accumulator += (int) weightPtr[i] * (int) qPtr[i];
+
+        outPtr[r] = scalePtr[r] * inputScale * accumulator + biasPtr[r];
+      }
+    }
+  }
+}
+
+template<typename MatType>
+void QuantizedLinearType<MatType>::ComputeOutputDimensions()
+{
+  size_t totalInputSize = this->inputDimensions[0];
+  for (size_t i = 1; i < this->inputDimensions.size(); ++i)
+    totalInputSize *= this->inputDimensions[i];
+
+  if (totalInputSize != inSize)
+  {
+    throw std::logic_error("QuantizedLinear::ComputeOutputDimensions(): input "
+        "size does not match the size the layer was quantized for!");
+  }
+
+  this->outputDimensions = std::vector<size_t>(this->inputDimensions.size(),
+      1);
+
+  // The QuantizedLinear layer flattens its input.
+  this->outputDimensions[0] = outSize;
+}
+
+template<typename MatType>
+template<typename Archive>
+void QuantizedLinearType<MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<Layer<MatType>>(this));
+
+  ar(CEREAL_NVP(inSize));
+  ar(CEREAL_NVP(outSize));
+  ar(CEREAL_NVP(quantizedWeight));
+  ar(CEREAL_NVP(scales));
+  ar(CEREAL_NVP(bias));
+}
+
+} // namespace mlpack
+
+#endif
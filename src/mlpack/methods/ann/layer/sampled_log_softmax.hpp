@@ -0,0 +1,134 @@
+/**
+ * @file methods/ann/layer/sampled_log_softmax.hpp
+ *
+ * Definition of the SampledLogSoftMax class, a log-softmax layer whose
+ * normalizer is estimated from a random subset of the outputs during
+ * training.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_SAMPLED_LOG_SOFTMAX_HPP
+#define MLPACK_METHODS_ANN_LAYER_SAMPLED_LOG_SOFTMAX_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "layer.hpp"
+
+namespace mlpack {
+
+/**
+ * Implementation of the sampled log-softmax layer.  This is a drop-in
+ * replacement for the LogSoftMax layer for very wide output layers (e.g. the
+ * vocabulary of a language model), where computing the softmax normalizer over
+ * every output dominates training time.
+ *
+ * During training, the log-partition term is estimated from `numSamples`
+ * uniformly sampled outputs with an importance-weighting correction, so only
+ * `numSamples` exponentials are computed per point instead of one per output.
+ * The backward pass propagates the normalizer gradient to the sampled outputs
+ * only; combined with the one-hot error of NegativeLogLikelihood, the
+ * preceding layer receives gradient for the target class and `numSamples`
+ * negative samples, as in sampled-softmax / negative-sampling training.  When
+ * the layer is not in training mode (or `numSamples` is zero or at least the
+ * number of outputs), the exact log-softmax is computed, so evaluation and
+ * prediction are unaffected by the approximation.
+ *
+ * The output is a full-length vector of (approximate) log-probabilities, so
+ * the layer interoperates with NegativeLogLikelihood unchanged.  Note that the
+ * training-time output is an estimate: entries may be slightly positive when
+ * the sampled normalizer underestimates the true one.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template <typename MatType = arma::mat>
+class SampledLogSoftMaxType : public Layer<MatType>
+{
+ public:
+  /**
+   * Create the SampledLogSoftMax layer.
+   *
+   * @param numSamples Number of outputs to sample when estimating the
+   *    normalizer during training.  If zero (the default), the exact
+   *    log-softmax is always computed.
+   */
+  SampledLogSoftMaxType(const size_t numSamples = 0);
+
+  //! Clone the SampledLogSoftMaxType object.  This handles polymorphism
+  //! correctly.
+  SampledLogSoftMaxType* Clone() const
+  {
+    return new SampledLogSoftMaxType(*this);
+  }
+
+  //! Virtual destructor.
+  virtual ~SampledLogSoftMaxType() { }
+
+  //! Copy another SampledLogSoftMaxType.
+  SampledLogSoftMaxType(const SampledLogSoftMaxType& other);
+  //! Take ownership of another SampledLogSoftMaxType.
+  SampledLogSoftMaxType(SampledLogSoftMaxType&& other);
+  //! Copy another SampledLogSoftMaxType.
+  SampledLogSoftMaxType& operator=(const SampledLogSoftMaxType& other);
+  //! Take ownership of another SampledLogSoftMaxType.
+  SampledLogSoftMaxType& operator=(SampledLogSoftMaxType&& other);
+
+  /**
+   * Ordinary feed forward pass of a neural network, evaluating the function
+   * f(x) by propagating the activity forward through f.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * Ordinary feed backward pass of a neural network, calculating the function
+   * f(x) by propagating x backwards through f.  Using the results from the
+   * feed forward pass.  This must be called with the output of the most recent
+   * call to Forward(), since the normalizer gradient is only propagated to the
+   * outputs sampled by that call.
+   *
+   * @param input The propagated input activation (the layer output).
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  void Backward(const MatType& input, const MatType& gy, MatType& g);
+
+  //! Get the number of sampled outputs (0 means exact computation).
+  size_t NumSamples() const { return numSamples; }
+  //! Modify the number of sampled outputs (0 means exact computation).
+  size_t& NumSamples() { return numSamples; }
+
+  /**
+   * Serialize the layer.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Number of outputs sampled for the normalizer estimate; 0 disables
+  //! sampling.
+  size_t numSamples;
+
+  //! The outputs sampled by the most recent training-mode Forward() pass.
+  arma::uvec sampleIndices;
+
+  //! True if the most recent Forward() pass used the sampled normalizer.
+  bool sampledStep;
+}; // class SampledLogSoftMaxType
+
+// Convenience typedefs.
+
+// Standard sampled log-softmax layer.
+typedef SampledLogSoftMaxType<arma::mat> SampledLogSoftMax;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "sampled_log_softmax_impl.hpp"
+
+#endif
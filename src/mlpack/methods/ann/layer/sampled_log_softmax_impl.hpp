@@ -0,0 +1,159 @@
+/**
+ * @file methods/ann/layer/sampled_log_softmax_impl.hpp
+ *
+ * Implementation of the SampledLogSoftMax class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_SAMPLED_LOG_SOFTMAX_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_SAMPLED_LOG_SOFTMAX_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "sampled_log_softmax.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+SampledLogSoftMaxType<MatType>::SampledLogSoftMaxType(
+    const size_t numSamples) :
+    Layer<MatType>(),
+    numSamples(numSamples),
+    sampledStep(false)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+SampledLogSoftMaxType<MatType>::SampledLogSoftMaxType(
+    const SampledLogSoftMaxType& other) :
+    Layer<MatType>(other),
+    numSamples(other.numSamples),
+    sampleIndices(other.sampleIndices),
+    sampledStep(other.sampledStep)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+SampledLogSoftMaxType<MatType>::SampledLogSoftMaxType(
+    SampledLogSoftMaxType&& other) :
+    Layer<MatType>(std::move(other)),
+    numSamples(other.numSamples),
+    sampleIndices(std::move(other.sampleIndices)),
+    sampledStep(other.sampledStep)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+SampledLogSoftMaxType<MatType>&
+SampledLogSoftMaxType<MatType>::operator=(const SampledLogSoftMaxType& other)
+{
+  if (&other != this)
+  {
+    Layer<MatType>::operator=(other);
+    numSamples = other.numSamples;
+    sampleIndices = other.sampleIndices;
+    sampledStep = other.sampledStep;
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+SampledLogSoftMaxType<MatType>&
+SampledLogSoftMaxType<MatType>::operator=(SampledLogSoftMaxType&& other)
+{
+  if (&other != this)
+  {
+    Layer<MatType>::operator=(std::move(other));
+    numSamples = other.numSamples;
+    sampleIndices = std::move(other.sampleIndices);
+    sampledStep = other.sampledStep;
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+void SampledLogSoftMaxType<MatType>::Forward(const MatType& input,
+                                             MatType& output)
+{
+  if (this->training && numSamples > 0 && numSamples < input.n_rows)
+  {
+    // Estimate the log-partition term from a uniform sample of the outputs.
+    // With m of n outputs sampled, (n / m) * sum_{j in S} exp(x_j) is an
+    // unbiased estimate of the partition function, so
+    //   log Z ~ logsumexp_{j in S}(x_j) + log(n / m).
+    sampleIndices = arma::randperm(input.n_rows, numSamples);
+    const MatType sampled = input.rows(sampleIndices);
+
+    const MatType maxSampled = arma::max(sampled, 0);
+    const MatType logZ = maxSampled +
+        arma::log(arma::sum(arma::exp(sampled.each_row() - maxSampled), 0)) +
+        std::log((double) input.n_rows / (double) numSamples);
+
+    output = input;
+    output.each_row() -= logZ;
+    sampledStep = true;
+  }
+  else
+  {
+    // Exact log-softmax, computed with the usual max-shift for stability.
+    const MatType maxInput = arma::max(input, 0);
+    const MatType logZ = maxInput +
+        arma::log(arma::sum(arma::exp(input.each_row() - maxInput), 0));
+
+    output = input;
+    output.each_row() -= logZ;
+    sampledStep = false;
+  }
+}
+
+template<typename MatType>
+void SampledLogSoftMaxType<MatType>::Backward(
+    const MatType& input,
+    const MatType& gy,
+    MatType& g)
+{
+  if (sampledStep)
+  {
+    // The estimated normalizer depends only on the sampled outputs, so the
+    // correction term is restricted to those rows.  The importance-weighted
+    // probabilities (n / m) * exp(output_j) sum to one over the sample by
+    // construction.
+    const double scale = (double) input.n_rows / (double) numSamples;
+    MatType sampledProbs = scale * arma::exp(input.rows(sampleIndices));
+
+    g = gy;
+    g.rows(sampleIndices) -= sampledProbs.each_row() % arma::sum(gy, 0);
+  }
+  else
+  {
+    g = gy - arma::exp(input) % arma::repmat(arma::sum(gy), input.n_rows, 1);
+  }
+}
+
+template<typename MatType>
+template<typename Archive>
+void SampledLogSoftMaxType<MatType>::serialize(
+    Archive& ar,
+    const uint32_t /* version */)
+{
+  ar(cereal::base_class<Layer<MatType>>(this));
+
+  ar(CEREAL_NVP(numSamples));
+
+  if (Archive::is_loading::value)
+  {
+    sampleIndices.clear();
+    sampledStep = false;
+  }
+}
+
+} // namespace mlpack
+
+#endif
@@ -173,6 +173,32 @@ class RNN
                arma::Cube<typename MatType::elem_type>& results,
                const size_t batchSize = 128);
 
+  /**
+   * Predict the response to a single time step of input, retaining the state
+   * of any recurrent layers between calls.  This is useful for streaming or
+   * realtime settings where the full sequence is not available up front: each
+   * successive call to `PredictStep()` is treated as the next time step of the
+   * sequence, so the entire history does not need to be reprocessed every
+   * step.
+   *
+   * The first call starts a new sequence; use `ResetStream()` to start
+   * another.  Calling `Train()`, `Predict()`, or `Reset()` also resets the
+   * streaming state, as does passing an `input` with a different number of
+   * columns (batch size) than the previous call.
+   *
+   * @param input Input for one time step; each column is one sequence in the
+   *      batch.
+   * @param output Matrix to store the output predictions for the step into.
+   */
+  void PredictStep(const MatType& input, MatType& output);
+
+  /**
+   * Reset any recurrent state retained between calls to `PredictStep()`, so
+   * that the next call to `PredictStep()` is treated as the first time step of
+   * a new sequence.
+   */
+  void ResetStream() { streamHasState = false; }
+
   // Return the nujmber of weights in the model.
   size_t WeightSize() { return network.WeightSize(); }
 
@@ -375,6 +401,12 @@ class RNN
   //! The matrix of responses to the input data points.  This member is empty,
   //! except during training.
   arma::Cube<typename MatType::elem_type> responses;
+
+  //! The batch size used by the last call to `PredictStep()`.
+  size_t streamBatchSize;
+  //! Whether the recurrent layers currently hold state from a previous call to
+  //! `PredictStep()`.
+  bool streamHasState;
 }; // class RNNType
 
 } // namespace mlpack
@@ -34,7 +34,9 @@ RNN<
     InitializationRuleType initializeRule) :
     bpttSteps(bpttSteps),
     single(single),
-    network(std::move(outputLayer), std::move(initializeRule))
+    network(std::move(outputLayer), std::move(initializeRule)),
+    streamBatchSize(0),
+    streamHasState(false)
 {
   /* Nothing to do here */
 }
@@ -52,7 +54,9 @@ RNN<
     const RNN& network) :
     bpttSteps(network.bpttSteps),
     single(network.single),
-    network(network.network)
+    network(network.network),
+    streamBatchSize(network.streamBatchSize),
+    streamHasState(network.streamHasState)
 {
   // Nothing else to do.
 }
@@ -70,7 +74,9 @@ RNN<
     RNN&& network) :
     bpttSteps(std::move(network.bpttSteps)),
     single(std::move(network.single)),
-    network(std::move(network.network))
+    network(std::move(network.network)),
+    streamBatchSize(std::move(network.streamBatchSize)),
+    streamHasState(std::move(network.streamHasState))
 {
   // Nothing to do here.
 }
@@ -96,6 +102,8 @@ RNN<
     bpttSteps = other.bpttSteps;
     single = other.single;
     network = other.network;
+    streamBatchSize = other.streamBatchSize;
+    streamHasState = other.streamHasState;
     predictors.clear();
     responses.clear();
   }
@@ -124,6 +132,8 @@ RNN<
     bpttSteps = std::move(other.bpttSteps);
     single = std::move(other.single);
     network = std::move(other.network);
+    streamBatchSize = std::move(other.streamBatchSize);
+    streamHasState = std::move(other.streamHasState);
     predictors.clear();
     responses.clear();
   }
@@ -216,6 +226,9 @@ void RNN<
   // Ensure that the network is configured correctly.
   network.CheckNetwork("RNN::Predict()", predictors.n_rows, true, false);
 
+  // Any state held for streaming prediction will be overwritten below.
+  streamHasState = false;
+
   results.set_size(network.network.OutputSize(), predictors.n_cols,
       predictors.n_slices);
 
@@ -250,6 +263,41 @@ void RNN<
   }
 }
 
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+void RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::PredictStep(const MatType& input, MatType& output)
+{
+  // Ensure that the network is configured correctly.
+  network.CheckNetwork("RNN::PredictStep()", input.n_rows, true, false);
+
+  // If this is the first step of a new sequence, or the batch size has
+  // changed, clear the recurrent state; otherwise, the state carried over from
+  // the previous call is used.  Just like `Predict()`, we won't be doing a
+  // backward pass, so a single memory cell is sufficient.
+  if (!streamHasState || input.n_cols != streamBatchSize)
+  {
+    ResetMemoryState(1, input.n_cols);
+    SetPreviousStep(size_t(-1));
+    streamBatchSize = input.n_cols;
+  }
+  else
+  {
+    SetPreviousStep(size_t(0));
+  }
+  SetCurrentStep(size_t(0));
+
+  output.set_size(network.network.OutputSize(), input.n_cols);
+  network.Forward(input, output);
+  streamHasState = true;
+}
+
 template<
     typename OutputLayerType,
     typename InitializationRuleType,
@@ -264,6 +312,7 @@ void RNN<
   // This is a reimplementation of FFN::Reset() that correctly prints
   // "RNN::Reset()".
   network.Parameters().clear();
+  streamHasState = false;
 
   if (inputDimensionality != 0)
   {
@@ -311,6 +360,8 @@ void RNN<
       // middle of training and resume.
       predictors.clear();
       responses.clear();
+      streamBatchSize = 0;
+      streamHasState = false;
     }
   #endif
 }
@@ -404,108 +455,102 @@ typename MatType::elem_type RNN<
       std::min(bpttSteps, size_t(predictors.n_slices)));
 
   ResetMemoryState(effectiveBPTTSteps, batchSize);
-  SetPreviousStep(size_t(-1));
   arma::Cube<typename MatType::elem_type> outputs(
       network.network.OutputSize(), batchSize, effectiveBPTTSteps);
 
-  // If `bpttSteps` is less than the number of time steps in the data, then for
-  // the first few steps, we won't actually need to hold onto any historical
-  // information, since BPTT will never go back that far.
-  const size_t extraSteps = (predictors.n_slices - effectiveBPTTSteps + 1);
-  MatType stepData, outputData, responseData;
-  for (size_t t = 0; t < std::min(size_t(predictors.n_slices), extraSteps); ++t)
-  {
-    SetCurrentStep(0);
-
-    // Make an alias of the step's data.
-    MakeAlias(stepData, predictors.slice(t).colptr(begin), predictors.n_rows,
-        batchSize);
-    MakeAlias(outputData, outputs.slice(t).memptr(), outputs.n_rows,
-        outputs.n_cols);
-    network.network.Forward(stepData, outputData);
-
-    const size_t responseStep = (single) ? 0 : t;
-    MakeAlias(responseData, responses.slice(responseStep).colptr(begin),
-        responses.n_rows, batchSize);
-
-    loss += network.outputLayer.Forward(outputData, responseData);
-
-    SetPreviousStep(0);
-  }
-
-  // Next, we reach the time steps that will be used for BPTT, for which we must
-  // preserve step data.
-  for (size_t t = extraSteps; t < predictors.n_slices; ++t)
-  {
-    SetCurrentStep(t - extraSteps + 1);
-
-    // Wrap a matrix around our data to avoid a copy.
-    MakeAlias(stepData, predictors.slice(t).colptr(begin), predictors.n_rows,
-        batchSize);
-    MakeAlias(outputData, outputs.slice(t).memptr(), outputs.n_rows,
-        outputs.n_cols);
-    network.network.Forward(stepData, outputData);
-
-    const size_t responseStep = (single) ? 0 : t;
-    MakeAlias(responseData, responses.slice(responseStep).colptr(begin),
-        responses.n_rows, batchSize);
-
-    loss += network.outputLayer.Forward(outputData, responseData);
-
-    SetPreviousStep(t - extraSteps + 1);
-  }
-
-  // Add loss (this is not dependent on time steps, and should only be added
-  // once).
-  loss += network.network.Loss();
-
   // Initialize current/working gradient.
   gradient.zeros(network.Parameters().n_rows, network.Parameters().n_cols);
   GradType currentGradient;
   currentGradient.zeros(network.Parameters().n_rows,
       network.Parameters().n_cols);
 
-  SetPreviousStep(size_t(-1));
-  const size_t minStep = predictors.n_slices - effectiveBPTTSteps + 1;
-  for (size_t t = predictors.n_slices; t >= minStep; --t)
+  // Process the sequence in truncation windows of up to `effectiveBPTTSteps`
+  // steps.  The hidden state of the last step of a window is carried into the
+  // next window's forward pass, but the backward pass is truncated at each
+  // window boundary, so we never need to hold more than `effectiveBPTTSteps`
+  // states at once, and every time step's error contributes to the gradient.
+  MatType stepData, outputData, responseData;
+  size_t carriedStep = size_t(-1);
+  for (size_t windowStart = 0; windowStart < predictors.n_slices;
+       windowStart += effectiveBPTTSteps)
   {
-    SetCurrentStep(t - 1);
+    const size_t windowSize = std::min(effectiveBPTTSteps,
+        size_t(predictors.n_slices) - windowStart);
 
-    currentGradient.zeros();
-    MatType error(outputs.n_rows, outputs.n_cols);
-
-    // Set up the response by backpropagating through the output layer.  Note
-    // that if we are in 'single' mode, we don't care what the network outputs
-    // until the input sequence is done, so there is no error for any timestep
-    // other than the first one.
-    if (single && (t - 1) < responses.n_slices - 1)
+    // Forward pass through the window; the first step reads the state carried
+    // over from the previous window (if there is one).
+    SetPreviousStep(carriedStep);
+    for (size_t s = 0; s < windowSize; ++s)
     {
-      error.zeros();
-    }
-    else
-    {
-      MakeAlias(outputData, outputs.slice(t - 1).colptr(0), outputs.n_rows,
+      const size_t t = windowStart + s;
+      SetCurrentStep(s);
+
+      // Wrap a matrix around our data to avoid a copy.
+      MakeAlias(stepData, predictors.slice(t).colptr(begin), predictors.n_rows,
+          batchSize);
+      MakeAlias(outputData, outputs.slice(s).memptr(), outputs.n_rows,
           outputs.n_cols);
-      const size_t respStep = (single) ? 0 : t - 1;
-      MakeAlias(responseData, responses.slice(respStep).colptr(begin),
+      network.network.Forward(stepData, outputData);
+
+      const size_t responseStep = (single) ? 0 : t;
+      MakeAlias(responseData, responses.slice(responseStep).colptr(begin),
           responses.n_rows, batchSize);
-      network.outputLayer.Backward(outputData, responseData, error);
+
+      loss += network.outputLayer.Forward(outputData, responseData);
+
+      SetPreviousStep(s);
     }
 
-    // Now pass that error backwards through the network.
-    MakeAlias(outputData, outputs.slice(t - 1).colptr(0), outputs.n_rows,
-        outputs.n_cols);
-    MatType networkDelta;
-    network.network.Backward(outputData, error, networkDelta);
+    // Backward pass through the window; the recurrent error is truncated at
+    // the window boundary.
+    SetPreviousStep(size_t(-1));
+    for (size_t s = windowSize; s >= 1; --s)
+    {
+      const size_t t = windowStart + s - 1;
+      SetCurrentStep(s - 1);
+
+      currentGradient.zeros();
+      MatType error(outputs.n_rows, outputs.n_cols);
+
+      // Set up the response by backpropagating through the output layer.  Note
+      // that if we are in 'single' mode, we don't care what the network outputs
+      // until the input sequence is done, so there is no error for any timestep
+      // other than the first one.
+      if (single && t < responses.n_slices - 1)
+      {
+        error.zeros();
+      }
+      else
+      {
+        MakeAlias(outputData, outputs.slice(s - 1).colptr(0), outputs.n_rows,
+            outputs.n_cols);
+        const size_t respStep = (single) ? 0 : t;
+        MakeAlias(responseData, responses.slice(respStep).colptr(begin),
+            responses.n_rows, batchSize);
+        network.outputLayer.Backward(outputData, responseData, error);
+      }
+
+      // Now pass that error backwards through the network.
+      MakeAlias(outputData, outputs.slice(s - 1).colptr(0), outputs.n_rows,
+          outputs.n_cols);
+      MatType networkDelta;
+      network.network.Backward(outputData, error, networkDelta);
+
+      MakeAlias(stepData, predictors.slice(t).colptr(begin),
+          predictors.n_rows, batchSize);
+      network.network.Gradient(stepData, error, currentGradient);
+      gradient += currentGradient;
 
-    MakeAlias(stepData, predictors.slice(t - 1).colptr(begin),
-        predictors.n_rows, batchSize);
-    network.network.Gradient(stepData, error, currentGradient);
-    gradient += currentGradient;
+      SetPreviousStep(s - 1);
+    }
 
-    SetPreviousStep(t - 1);
+    carriedStep = windowSize - 1;
   }
 
+  // Add loss (this is not dependent on time steps, and should only be added
+  // once).
+  loss += network.network.Loss();
+
   return loss;
 }
 
@@ -557,6 +602,9 @@ void RNN<
 {
   this->predictors = std::move(predictors);
   this->responses = std::move(responses);
+
+  // Training will overwrite any state held for streaming prediction.
+  streamHasState = false;
 }
 
 template<
@@ -182,13 +182,45 @@ void DrusillaSelect<MatType>::Search(const MatType& querySet,
   // Note that we aren't using trees for our search, so we can use 'int' as a
   // TreeType.
   EuclideanDistance metric;
-  NeighborSearchRules<FurthestNeighborSort, EuclideanDistance,
-      KDTree<EuclideanDistance, EmptyStatistic, MatType>>
-      rules(candidateSet, querySet, k, metric, 0, false);
+  typedef NeighborSearchRules<FurthestNeighborSort, EuclideanDistance,
+      KDTree<EuclideanDistance, EmptyStatistic, MatType>> RuleType;
+  RuleType rules(candidateSet, querySet, k, metric, 0, false);
 
-  for (size_t q = 0; q < querySet.n_cols; ++q)
-    for (size_t r = 0; r < candidateSet.n_cols; ++r)
-      rules.BaseCase(q, r);
+  size_t numThreads = 1;
+  #ifdef MLPACK_USE_OPENMP
+    numThreads = (size_t) omp_get_max_threads();
+  #endif
+
+  if (numThreads == 1)
+  {
+    for (size_t q = 0; q < querySet.n_cols; ++q)
+      for (size_t r = 0; r < candidateSet.n_cols; ++r)
+        rules.BaseCase(q, r);
+  }
+  else
+  {
+    // The queries are independent, but the rules cache the last base case and
+    // so cannot be shared between threads.  Each thread scans the candidate
+    // set for its own share of the queries with its own copy of the rules,
+    // and the copies are merged when all threads have finished.
+    std::vector<RuleType> threadRules(numThreads, rules);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t q = 0; q < querySet.n_cols; ++q)
+    {
+      size_t threadId = 0;
+      #ifdef MLPACK_USE_OPENMP
+        threadId = (size_t) omp_get_thread_num();
+      #endif
+
+      RuleType& threadRule = threadRules[threadId];
+      for (size_t r = 0; r < candidateSet.n_cols; ++r)
+        threadRule.BaseCase(q, r);
+    }
+
+    for (size_t t = 0; t < numThreads; ++t)
+      rules.Merge(threadRules[t]);
+  }
 
   rules.GetResults(neighbors, distances);
 
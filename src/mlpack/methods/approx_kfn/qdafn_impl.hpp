@@ -103,7 +103,14 @@ void QDAFN<MatType>::Search(const MatType& querySet,
   neighbors.fill(size_t() - 1);
   distances.zeros(k, querySet.n_cols);
 
-  // Search for each point.
+  // Project the entire query set onto all l lines at once.  This is a single
+  // level-3 BLAS call instead of l dot products for each query point.
+  const arma::mat queryProjections = querySet.t() * lines;
+
+  // Search for each point.  The queries are independent of each other, and
+  // the projection tables and candidate sets are only read, so the queries
+  // can be searched in parallel.
+  #pragma omp parallel for
   for (size_t q = 0; q < querySet.n_cols; ++q)
   {
     // Initialize a priority queue.
@@ -112,8 +119,7 @@ void QDAFN<MatType>::Search(const MatType& querySet,
     std::priority_queue<std::pair<double, size_t>> queue;
     for (size_t i = 0; i < l; ++i)
     {
-      const double val = sValues(0, i) - arma::dot(querySet.col(q),
-          lines.col(i));
+      const double val = sValues(0, i) - queryProjections(q, i);
       queue.push(std::make_pair(val, i));
     }
 
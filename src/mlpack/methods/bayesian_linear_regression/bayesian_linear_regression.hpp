@@ -121,6 +121,10 @@ class BayesianLinearRegression
    * should be column-major -- each column is an observation and each row is a
    * dimension.
    *
+   * The eigendecomposition of the data covariance is cached inside the
+   * object, so calling Train() repeatedly on the same data (as in a
+   * hyperparameter sweep) only decomposes the covariance once.
+   *
    * @param data Column-major input data, dim(P, N).
    * @param responses A vector of targets, dim(N).
    * @return Root mean squared error.
@@ -281,6 +285,22 @@ class BayesianLinearRegression
   //! Covariance matrix of the solution vector omega.
   arma::mat matCovariance;
 
+  //! Cached eigenvalues of the covariance of the preprocessed data.  The
+  //! decomposition does not depend on the responses, so it is reused across
+  //! Train() calls on the same data (see cacheFingerprint).
+  arma::colvec cachedEigVal;
+
+  //! Cached eigenvectors of the covariance of the preprocessed data.
+  arma::mat cachedEigVec;
+
+  //! Cached inverse of the eigenvector matrix.
+  arma::mat cachedEigVecInv;
+
+  //! Fingerprint of the data the cached decomposition was computed from
+  //! (dimensions, data moments and preprocessing flags).  Empty if nothing
+  //! is cached.
+  arma::colvec cacheFingerprint;
+
   /**
    * Center and scale the data accordind to centerData and scaleData.
    * Allows future modifications of new points.
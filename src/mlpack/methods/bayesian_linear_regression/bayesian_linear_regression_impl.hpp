@@ -36,20 +36,40 @@ inline double BayesianLinearRegression::Train(const arma::mat& data,
 {
   arma::mat phi;
   arma::rowvec t;
-  arma::colvec eigVal;
-  arma::mat eigVec;
 
   // Preprocess the data. Center and scale.
   responsesOffset = CenterScaleData(data, responses, phi, t);
 
-  if (!arma::eig_sym(eigVal, eigVec, arma::symmatu(phi * phi.t())))
+  // The eigendecomposition of the covariance phi * phi^T depends only on the
+  // data and the preprocessing flags, not on the responses, so it can be
+  // reused when Train() is called repeatedly on the same data (as in
+  // hyperparameter sweeps).  The cached copy is keyed on a cheap fingerprint
+  // of the data; any change of the data or of the flags recomputes it.
+  const arma::colvec fingerprint = { (double) data.n_rows,
+                                     (double) data.n_cols,
+                                     arma::accu(data),
+                                     arma::accu(arma::square(data)),
+                                     (double) centerData,
+                                     (double) scaleData };
+
+  if (cachedEigVal.is_empty() ||
+      arma::any(cacheFingerprint != fingerprint))
   {
-    Log::Fatal << "BayesianLinearRegression::Train(): Eigendecomposition "
-               << "of covariance failed!" << std::endl;
+    if (!arma::eig_sym(cachedEigVal, cachedEigVec,
+        arma::symmatu(phi * phi.t())))
+    {
+      Log::Fatal << "BayesianLinearRegression::Train(): Eigendecomposition "
+                 << "of covariance failed!" << std::endl;
+    }
+    cachedEigVecInv = inv(cachedEigVec);
+    cacheFingerprint = fingerprint;
   }
 
+  const arma::colvec& eigVal = cachedEigVal;
+  const arma::mat& eigVec = cachedEigVec;
+  const arma::mat& eigVecInv = cachedEigVecInv;
+
   // Compute this quantities once and for all.
-  const arma::mat eigVecInv = inv(eigVec);
   const arma::colvec eigVecInvPhitT = eigVecInv * phi * t.t();
 
   // Initialize the hyperparameters and begin with an infinitely broad prior.
@@ -45,7 +45,19 @@ void BiasSVDFunction<MatType>::Shuffle()
 template <typename MatType>
 double BiasSVDFunction<MatType>::Evaluate(const arma::mat& parameters) const
 {
-  return Evaluate(parameters, 0, data.n_cols);
+  // The ratings contribute to the objective independently, so the full-batch
+  // evaluation is computed over blocks of ratings dispatched across threads.
+  double objective = 0.0;
+
+  const size_t blockSize = 4096;
+  #pragma omp parallel for schedule(dynamic) reduction(+:objective)
+  for (size_t block = 0; block < data.n_cols; block += blockSize)
+  {
+    const size_t lastCol = std::min(block + blockSize, (size_t) data.n_cols);
+    objective += Evaluate(parameters, block, lastCol - block);
+  }
+
+  return objective;
 }
 
 template <typename MatType>
@@ -196,8 +208,7 @@ double StandardSGD::Optimize(
   double overallObjective = 0;
 
   // Calculate the first objective function.
-  for (size_t i = 0; i < numFunctions; ++i)
-    overallObjective += function.Evaluate(parameters, i);
+  overallObjective = function.Evaluate(parameters);
 
   const arma::mat data = function.Dataset();
 
@@ -114,11 +114,37 @@ class RandomizedBlockKrylovSVD
   size_t& BlockSize() { return blockSize; }
 
  private:
+  /**
+   * Compute a QR decomposition of the tall matrix A using the communication-
+   * avoiding TSQR scheme: A is split into row panels that are factorized
+   * independently (in parallel, if OpenMP is enabled), the small R factors
+   * are stacked and factorized once more, and the panel Q factors are
+   * combined.  Falls back to a plain QR when A is not tall enough to split.
+   *
+   * @param a Input matrix (number of rows >= number of columns).
+   * @param q Orthonormal basis for the columns of a.
+   * @param r Upper triangular factor.
+   */
+  static void TSQR(const arma::mat& a, arma::mat& q, arma::mat& r);
+
   //! Locally stored number of iterations for the power method.
   size_t maxIterations;
 
   //! The block size value.
   size_t blockSize;
+
+  //! Workspace for the random starting block; kept across Apply() calls so
+  //! repeated decompositions of same-size problems do not reallocate.
+  arma::mat workG;
+
+  //! Workspace for the Krylov subspace basis.
+  arma::mat workK;
+
+  //! Workspace for the orthonormalized Krylov basis.
+  arma::mat workQ;
+
+  //! Workspace for the projection of the data onto the Krylov basis.
+  arma::mat workProj;
 };
 
 } // namespace mlpack
@@ -52,47 +52,109 @@ inline void RandomizedBlockKrylovSVD::Apply(const arma::mat& data,
                                             arma::mat& v,
                                             const size_t rank)
 {
-  arma::mat Q, R, block, blockIteration;
+  arma::mat R, block, blockIteration;
 
   if (blockSize == 0)
   {
     blockSize = rank + 10;
   }
 
-  // Random block initialization.
-  arma::mat G = arma::randn(data.n_cols, blockSize);
+  // Random block initialization.  The workspace buffers are members, so
+  // repeated Apply() calls on same-size problems reuse their allocations;
+  // set_size() is a no-op when the size is unchanged.
+  workG.set_size(data.n_cols, blockSize);
+  workG.randn();
 
   // Construct and orthonormalize Krylov subspace.
-  arma::mat K(data.n_rows, blockSize * (maxIterations + 1));
+  workK.set_size(data.n_rows, blockSize * (maxIterations + 1));
 
   // Create a working matrix using data from writable auxiliary memory
-  // (K matrix). Doing so avoids an uncessary copy in upcoming step.
-  block = arma::mat(K.memptr(), data.n_rows, blockSize, false, false);
-  arma::qr_econ(block, R, data * G);
+  // (workK matrix). Doing so avoids an uncessary copy in upcoming step.
+  block = arma::mat(workK.memptr(), data.n_rows, blockSize, false, false);
+  TSQR(data * workG, block, R);
 
-  for (size_t blockOffset = block.n_elem; blockOffset < K.n_elem;
+  for (size_t blockOffset = block.n_elem; blockOffset < workK.n_elem;
       blockOffset += block.n_elem)
   {
     // Temporary working matrix to store the result in the correct place.
-    blockIteration = arma::mat(K.memptr() + blockOffset, block.n_rows,
+    blockIteration = arma::mat(workK.memptr() + blockOffset, block.n_rows,
         block.n_cols, false, false);
 
-    arma::qr_econ(blockIteration, R, data * (data.t() * block));
+    // Keep the product as two full-size GEMMs, so a multi-threaded BLAS can
+    // spread them over all cores.
+    TSQR(data * (data.t() * block), blockIteration, R);
 
     // Update working matrix for the next iteration.
-    block = arma::mat(K.memptr() + blockOffset, block.n_rows, block.n_cols,
-        false, false);
+    block = arma::mat(workK.memptr() + blockOffset, block.n_rows,
+        block.n_cols, false, false);
   }
 
-  arma::qr_econ(Q, R, K);
+  TSQR(workK, workQ, R);
 
   // Approximate eigenvalues and eigenvectors using Rayleigh-Ritz method.
-  arma::svd_econ(u, s, v, Q.t() * data);
+  workProj = workQ.t() * data;
+  arma::svd_econ(u, s, v, workProj);
 
   // Do economical singular value decomposition and compute only the
   // approximations of the left singular vectors by using the centered data
   // applied to Q.
-  u = Q * u;
+  u = workQ * u;
+}
+
+inline void RandomizedBlockKrylovSVD::TSQR(const arma::mat& a,
+                                           arma::mat& q,
+                                           arma::mat& r)
+{
+  size_t numThreads = 1;
+  #ifdef MLPACK_USE_OPENMP
+    numThreads = (size_t) omp_get_max_threads();
+  #endif
+
+  // Each row panel must have at least as many rows as columns; fall back to
+  // a plain QR when the matrix is not tall enough to split (or when there is
+  // nothing to parallelize over).
+  const size_t panels = (a.n_cols > 0) ?
+      std::min(numThreads, a.n_rows / a.n_cols) : 0;
+  if (panels < 2)
+  {
+    arma::qr_econ(q, r, a);
+    return;
+  }
+
+  // Factorize each row panel independently, collecting the small R factors.
+  // The last panel absorbs the remainder rows, so every panel keeps at least
+  // as many rows as columns.
+  const size_t panelRows = a.n_rows / panels;
+  std::vector<arma::mat> panelQ(panels);
+  arma::mat stackedR(panels * a.n_cols, a.n_cols);
+
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < panels; ++i)
+  {
+    const size_t firstRow = i * panelRows;
+    const size_t lastRow = (i == panels - 1) ? (a.n_rows - 1) :
+        ((i + 1) * panelRows - 1);
+
+    arma::mat panelR;
+    arma::qr_econ(panelQ[i], panelR, a.rows(firstRow, lastRow));
+    stackedR.rows(i * a.n_cols, (i + 1) * a.n_cols - 1) = panelR;
+  }
+
+  // Factorize the stacked R factors and combine the panel Q factors.
+  arma::mat stackedQ;
+  arma::qr_econ(stackedQ, r, stackedR);
+
+  q.set_size(a.n_rows, a.n_cols);
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < panels; ++i)
+  {
+    const size_t firstRow = i * panelRows;
+    const size_t lastRow = (i == panels - 1) ? (a.n_rows - 1) :
+        ((i + 1) * panelRows - 1);
+
+    q.rows(firstRow, lastRow) = panelQ[i] *
+        stackedQ.rows(i * a.n_cols, (i + 1) * a.n_cols - 1);
+  }
 }
 
 } // namespace mlpack
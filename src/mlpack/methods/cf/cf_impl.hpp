@@ -205,63 +205,88 @@ GetRecommendations(const size_t numRecs,
   // time and we don't want to repeat the initialization process in each loop.
   InterpolationPolicy interpolation(cleanedData);
 
-  for (size_t i = 0; i < users.n_elem; ++i)
+  // The users are scored independently and each iteration only writes its own
+  // column of the output, so the users are processed in blocks dispatched
+  // across threads.  Each thread works on a private copy of the initialized
+  // interpolation object, because some interpolation policies cache state
+  // between calls.
+  const size_t blockSize = 256;
+  #pragma omp parallel for schedule(dynamic) firstprivate(interpolation)
+  for (size_t block = 0; block < users.n_elem; block += blockSize)
   {
-    // First, calculate the weighted sum of neighborhood values.
-    arma::vec ratings;
-    ratings.zeros(cleanedData.n_rows);
-
-    // Calculate interpolation weights.
-    arma::vec weights(numUsersForSimilarity);
-    interpolation.GetWeights(weights, decomposition, users(i),
-        neighborhood.col(i), similarities.col(i), cleanedData);
+    const size_t lastUser = std::min(block + blockSize,
+        (size_t) users.n_elem) - 1;
 
-    for (size_t j = 0; j < neighborhood.n_rows; ++j)
+    for (size_t i = block; i <= lastUser; ++i)
     {
-      arma::vec neighborRatings;
-      decomposition.GetRatingOfUser(neighborhood(j, i), neighborRatings);
-      ratings += weights(j) * neighborRatings;
-    }
+      // First, calculate the weighted sum of neighborhood values.
+      arma::vec ratings;
+      ratings.zeros(cleanedData.n_rows);
 
-    // Let's build the list of candidate recomendations for the given user.
-    // Default candidate: the smallest possible value and invalid item number.
-    const Candidate def = std::make_pair(-DBL_MAX, cleanedData.n_rows);
-    std::vector<Candidate> vect(numRecs, def);
-    typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
-        CandidateList;
-    CandidateList pqueue(CandidateCmp(), std::move(vect));
+      // Calculate interpolation weights.
+      arma::vec weights(numUsersForSimilarity);
+      interpolation.GetWeights(weights, decomposition, users(i),
+          neighborhood.col(i), similarities.col(i), cleanedData);
 
-    // Look through the ratings column corresponding to the current user.
-    for (size_t j = 0; j < ratings.n_rows; ++j)
-    {
-      // Ensure that the user hasn't already rated the item.
-      // The algorithm omits rating of zero. Thus, when normalizing original
-      // ratings in Normalize(), if normalized rating equals zero, it is set
+      for (size_t j = 0; j < neighborhood.n_rows; ++j)
+      {
+        arma::vec neighborRatings;
+        decomposition.GetRatingOfUser(neighborhood(j, i), neighborRatings);
+        ratings += weights(j) * neighborRatings;
+      }
+
+      // Mark the items the user has already rated, walking the user's sparse
+      // column once instead of doing one sparse lookup per item of the
+      // catalog.  The algorithm omits ratings of zero: when normalizing
+      // original ratings in Normalize(), a normalized rating of zero is set
       // to the smallest positive double value.
-      if (cleanedData(j, users(i)) != 0.0)
-        continue; // The user already rated the item.
+      std::vector<bool> rated(cleanedData.n_rows, false);
+      arma::sp_mat::const_iterator it = cleanedData.begin_col(users(i));
+      arma::sp_mat::const_iterator itEnd = cleanedData.end_col(users(i));
+      for (; it != itEnd; ++it)
+        rated[it.row()] = true;
+
+      // Let's build the list of candidate recomendations for the given user.
+      // Default candidate: the smallest possible value and invalid item
+      // number.
+      const Candidate def = std::make_pair(-DBL_MAX, cleanedData.n_rows);
+      std::vector<Candidate> vect(numRecs, def);
+      typedef std::priority_queue<Candidate, std::vector<Candidate>,
+          CandidateCmp> CandidateList;
+      CandidateList pqueue(CandidateCmp(), std::move(vect));
+
+      // Look through the ratings column corresponding to the current user.
+      for (size_t j = 0; j < ratings.n_rows; ++j)
+      {
+        // Ensure that the user hasn't already rated the item.
+        if (rated[j])
+          continue; // The user already rated the item.
+
+        // Is the estimated value better than the worst candidate?
+        // Denormalize rating before comparison.
+        double realRating = normalization.Denormalize(users(i), j, ratings[j]);
+        if (realRating > pqueue.top().first)
+        {
+          Candidate c = std::make_pair(realRating, j);
+          pqueue.pop();
+          pqueue.push(c);
+        }
+      }
 
-      // Is the estimated value better than the worst candidate?
-      // Denormalize rating before comparison.
-      double realRating = normalization.Denormalize(users(i), j, ratings[j]);
-      if (realRating > pqueue.top().first)
+      for (size_t p = 1; p <= numRecs; p++)
       {
-        Candidate c = std::make_pair(realRating, j);
+        recommendations(numRecs - p, i) = pqueue.top().second;
+        values(numRecs - p, i) = pqueue.top().first;
         pqueue.pop();
-        pqueue.push(c);
       }
     }
+  }
 
-    for (size_t p = 1; p <= numRecs; p++)
-    {
-      recommendations(numRecs - p, i) = pqueue.top().second;
-      values(numRecs - p, i) = pqueue.top().first;
-      pqueue.pop();
-    }
-
-    // If we were not able to come up with enough recommendations, issue a
-    // warning.
-    if (recommendations(numRecs - 1, i) == def.second)
+  // If we were not able to come up with enough recommendations for some
+  // users, issue warnings.  This is done outside the parallel region above.
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    if (recommendations(numRecs - 1, i) == cleanedData.n_rows)
       Log::Warn << "Could not provide " << numRecs << " recommendations "
           << "for user " << users(i) << " (not enough un-rated items)!"
           << std::endl;
@@ -348,35 +373,63 @@ Predict(const arma::Mat<size_t>& combinations,
 
   arma::mat weights(numUsersForSimilarity, users.n_elem);
 
-  // Calculate interpolation weights.
+  // Calculate interpolation weights.  The users are independent and each
+  // iteration only writes its own column of the weights matrix, so they are
+  // processed in blocks dispatched across threads; each thread works on a
+  // private copy of the initialized interpolation object, because some
+  // interpolation policies cache state between calls.
   InterpolationPolicy interpolation(cleanedData);
-  for (size_t i = 0; i < users.n_elem; ++i)
+  const size_t blockSize = 256;
+  #pragma omp parallel for schedule(dynamic) firstprivate(interpolation)
+  for (size_t block = 0; block < users.n_elem; block += blockSize)
   {
-    interpolation.GetWeights(weights.col(i), decomposition, users[i],
-        neighborhood.col(i), similarities.col(i), cleanedData);
-  }
+    const size_t lastUser = std::min(block + blockSize,
+        (size_t) users.n_elem) - 1;
 
-  // Now that we have the neighborhoods we need, calculate the predictions.
-  predictions.set_size(combinations.n_cols);
+    for (size_t i = block; i <= lastUser; ++i)
+    {
+      interpolation.GetWeights(weights.col(i), decomposition, users[i],
+          neighborhood.col(i), similarities.col(i), cleanedData);
+    }
+  }
 
+  // Map each combination to the index of its user in the unique user list,
+  // with one cumulative pass over the sorted combinations.
+  arma::Col<size_t> userIndex(sortedCombinations.n_cols);
   size_t user = 0; // Cumulative user count, because we are doing it in order.
   for (size_t i = 0; i < sortedCombinations.n_cols; ++i)
   {
-    // Could this be made faster by calculating dot products for multiple items
-    // at once?
-    double rating = 0.0;
-
-    // Map the combination's user to the user ID used for kNN.
     while (users[user] < sortedCombinations(0, i))
       ++user;
+    userIndex(i) = user;
+  }
 
-    for (size_t j = 0; j < neighborhood.n_rows; ++j)
+  // Now that we have the neighborhoods we need, calculate the predictions.
+  // The combinations are independent and each iteration only writes its own
+  // prediction, so they are processed in blocks dispatched across threads.
+  predictions.set_size(combinations.n_cols);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < sortedCombinations.n_cols;
+      block += blockSize)
+  {
+    const size_t lastCol = std::min(block + blockSize,
+        (size_t) sortedCombinations.n_cols) - 1;
+
+    for (size_t i = block; i <= lastCol; ++i)
     {
-      rating += weights(j, user) * decomposition.GetRating(
-          neighborhood(j, user), sortedCombinations(1, i));
-    }
+      // Could this be made faster by calculating dot products for multiple
+      // items at once?
+      double rating = 0.0;
 
-    predictions(ordering[i]) = rating;
+      for (size_t j = 0; j < neighborhood.n_rows; ++j)
+      {
+        rating += weights(j, userIndex(i)) * decomposition.GetRating(
+            neighborhood(j, userIndex(i)), sortedCombinations(1, i));
+      }
+
+      predictions(ordering[i]) = rating;
+    }
   }
 
   // Denormalize ratings.
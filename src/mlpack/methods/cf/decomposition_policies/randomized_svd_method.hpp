@@ -80,6 +80,24 @@ class RandomizedSVDPolicy
 
     // Do singular value decomposition using the randomized SVD algorithm.
     RandomizedSVD rsvd(iteratedPower, maxIterations);
+
+    // Warm-start the range finder from the subspace of the previous
+    // factorization, if this policy holds one of matching shape.  When the
+    // interaction matrix changes slowly between retrains, the new subspace
+    // is close to the old one and far fewer power iterations are needed.
+    // Note that the scaling applied to w and h below does not change the
+    // subspace they span, so they can seed the range finder directly.
+    if (!w.is_empty() && cleanedData.n_cols >= cleanedData.n_rows &&
+        w.n_rows == cleanedData.n_rows)
+    {
+      rsvd.InitialBasis() = arma::normalise(w);
+    }
+    else if (!h.is_empty() && cleanedData.n_cols < cleanedData.n_rows &&
+        h.n_cols == cleanedData.n_cols)
+    {
+      rsvd.InitialBasis() = arma::normalise(arma::trans(h));
+    }
+
     rsvd.Apply(cleanedData, w, sigma, h, rank);
 
     // Sigma matrix is multiplied to w.
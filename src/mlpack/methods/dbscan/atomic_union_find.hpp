@@ -0,0 +1,106 @@
+/**
+ * @file methods/dbscan/atomic_union_find.hpp
+ *
+ * Implements a lock-free union-find data structure that can be updated
+ * concurrently from multiple threads.  This is the parallel counterpart of
+ * the UnionFind class used by EMST; DBSCAN uses it to merge clusters from
+ * all points in parallel.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DBSCAN_ATOMIC_UNION_FIND_HPP
+#define MLPACK_METHODS_DBSCAN_ATOMIC_UNION_FIND_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <atomic>
+
+namespace mlpack {
+
+/**
+ * A lock-free union-find data structure.  As with UnionFind, each element is
+ * initially in its own component, Union(x, y) unites the components of x and
+ * y, and Find(x) returns the component containing x.  Unlike UnionFind, both
+ * operations may be called concurrently from any number of threads.
+ *
+ * The parents are atomic; roots are joined with compare-and-swap, always
+ * pointing the larger root at the smaller one, and Find() compresses paths by
+ * halving.  A failed compare-and-swap just means another thread got there
+ * first, and the operation retries from the new roots, so no locks are
+ * needed.
+ */
+class AtomicUnionFind
+{
+ private:
+  std::vector<std::atomic<size_t>> parent;
+
+ public:
+  //! Construct the object with the given size.
+  AtomicUnionFind(const size_t size) : parent(size)
+  {
+    for (size_t i = 0; i < size; ++i)
+      parent[i].store(i, std::memory_order_relaxed);
+  }
+
+  /**
+   * Returns the component containing an element.  Safe to call concurrently
+   * with other Find() and Union() calls.
+   *
+   * @param x the component to be found
+   * @return The index of the component containing x
+   */
+  size_t Find(size_t x)
+  {
+    while (true)
+    {
+      size_t p = parent[x].load(std::memory_order_relaxed);
+      if (p == x)
+        return x;
+
+      // Path halving: point x at its grandparent.  If the compare-exchange
+      // fails, another thread already compressed this link; either way we
+      // keep walking up.
+      const size_t gp = parent[p].load(std::memory_order_relaxed);
+      parent[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+      x = gp;
+    }
+  }
+
+  /**
+   * Union the components containing x and y.  Safe to call concurrently with
+   * other Find() and Union() calls.
+   *
+   * @param x one component
+   * @param y the other component
+   */
+  void Union(const size_t x, const size_t y)
+  {
+    size_t xRoot = Find(x);
+    size_t yRoot = Find(y);
+
+    while (xRoot != yRoot)
+    {
+      // Point the larger root at the smaller one, so that concurrent unions
+      // cannot form a cycle.
+      if (xRoot < yRoot)
+        std::swap(xRoot, yRoot);
+
+      size_t expected = xRoot;
+      if (parent[xRoot].compare_exchange_strong(expected, yRoot,
+          std::memory_order_acq_rel))
+        return;
+
+      // Another thread changed xRoot's parent first; retry from the new
+      // roots.
+      xRoot = Find(xRoot);
+      yRoot = Find(yRoot);
+    }
+  }
+}; // class AtomicUnionFind
+
+} // namespace mlpack
+
+#endif // MLPACK_METHODS_DBSCAN_ATOMIC_UNION_FIND_HPP
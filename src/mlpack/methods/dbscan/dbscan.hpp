@@ -16,6 +16,8 @@
 #include <mlpack/core.hpp>
 #include <mlpack/methods/range_search/range_search.hpp>
 #include <mlpack/methods/emst/union_find.hpp>
+#include "atomic_union_find.hpp"
+#include "grid_range_search.hpp"
 #include "random_point_selection.hpp"
 #include "ordered_point_selection.hpp"
 
@@ -42,6 +44,26 @@ namespace mlpack {
  * range search technique used and the point selection strategy by means of
  * template parameters.
  *
+ * An approximate mode is also available (see MaxSampleSize()): the core-point
+ * test is then performed on a random subsample of the dataset with a
+ * sequential confidence bound, stopping as soon as the density of a point is
+ * established either way and falling back to an exact range search only for
+ * points whose density cannot be separated from the threshold within the
+ * sample budget.  Each sampled decision matches the exact core-point test
+ * with probability at least Agreement().  This follows the subsampling
+ * strategy of:
+ *
+ * @code
+ * @inproceedings{jiang2020faster,
+ *   title={Faster DBSCAN via subsampled similarity queries},
+ *   author={Jiang, H. and Jang, J. and {\L}{\k{a}}cki, J.},
+ *   booktitle={Advances in Neural Information Processing Systems 33
+ *       (NeurIPS 2020)},
+ *   pages={22407--22419},
+ *   year={2020}
+ * }
+ * @endcode
+ *
  * @tparam RangeSearchType Class to use for range searching.
  * @tparam PointSelectionPolicy Strategy for selecting next point to cluster
  *      with.
@@ -110,6 +132,19 @@ class DBSCAN
                  arma::Row<size_t>& assignments,
                  arma::mat& centroids);
 
+  //! Get the maximum number of sampled neighbor checks per point (0 means the
+  //! exact core-point test is used).
+  size_t MaxSampleSize() const { return maxSampleSize; }
+  //! Modify the maximum number of sampled neighbor checks per point.  Setting
+  //! this to a nonzero value enables the approximate sampled core-point test.
+  size_t& MaxSampleSize() { return maxSampleSize; }
+
+  //! Get the probability with which each sampled core-point decision agrees
+  //! with the exact test.
+  double Agreement() const { return agreement; }
+  //! Modify the agreement probability (must be in (0, 1)).
+  double& Agreement() { return agreement; }
+
  private:
   //! Maximum distance between two points to be part of same cluster.
   double epsilon;
@@ -127,6 +162,13 @@ class DBSCAN
   //! Instantiated point selection policy.
   PointSelectionPolicy pointSelector;
 
+  //! Maximum number of sampled neighbor checks per point; 0 disables the
+  //! sampled core-point test.
+  size_t maxSampleSize;
+
+  //! Probability that a sampled core-point decision matches the exact test.
+  double agreement;
+
   /**
    * Performs DBSCAN clustering on the data, returning the number of clusters
    * and also the list of cluster assignments.  This searches each point
@@ -151,6 +193,22 @@ class DBSCAN
    */
   template<typename MatType>
   void BatchCluster(const MatType& data, UnionFind& uf);
+
+  /**
+   * Performs approximate DBSCAN clustering on the data using the sampled
+   * core-point test.  For each point, random points are drawn from the dataset
+   * one at a time and checked against epsilon; a sequential empirical-
+   * Bernstein bound is used to stop as soon as the point can be declared a
+   * core or non-core point with probability at least Agreement().  Points
+   * whose density cannot be resolved within MaxSampleSize() draws fall back
+   * to an exact range search, so only unambiguous points are ever decided
+   * approximately.
+   *
+   * @param data Dataset to cluster.
+   * @param uf UnionFind structure that will be modified.
+   */
+  template<typename MatType>
+  void SampledCluster(const MatType& data, UnionFind& uf);
 };
 
 } // namespace mlpack
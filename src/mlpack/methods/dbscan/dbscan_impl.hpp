@@ -30,7 +30,9 @@ DBSCAN<RangeSearchType, PointSelectionPolicy>::DBSCAN(
     minPoints(minPoints),
     batchMode(batchMode),
     rangeSearch(rangeSearch),
-    pointSelector(pointSelector)
+    pointSelector(pointSelector),
+    maxSampleSize(0),
+    agreement(0.99)
 {
   // Nothing to do.
 }
@@ -103,7 +105,9 @@ size_t DBSCAN<RangeSearchType, PointSelectionPolicy>::Cluster(
   UnionFind uf(data.n_cols);
   rangeSearch.Train(data);
 
-  if (batchMode)
+  if (maxSampleSize > 0)
+    SampledCluster(data, uf);
+  else if (batchMode)
     BatchCluster(data, uf);
   else
     PointwiseCluster(data, uf);
@@ -238,32 +242,172 @@ void DBSCAN<RangeSearchType, PointSelectionPolicy>::BatchCluster(
   rangeSearch.Search(Range(0.0, epsilon), neighbors, distances);
   Log::Info << "Range search complete." << std::endl;
 
-  // See the description of the algorithm in `PointwiseCluster()`.  The strategy
-  // is the same here, but we have cached all range search results already.
-  // That means we already have computed whether each point is or is not a core
-  // point, just based on the size of its neighbors; so we don't need an
-  // auxiliary std::vector<bool> for that.
+  // See the description of the algorithm in `PointwiseCluster()`.  The
+  // cached range search results tell us whether each point is or is not a
+  // core point, just based on the size of its neighbors; and since the
+  // neighbor lists are complete, the merging itself has no ordering
+  // dependencies left: core points union with all of their core neighbors,
+  // and each non-core point attaches to one core neighbor (if it has any).
+  // Both passes run in parallel over the points, with a lock-free union-find
+  // collecting the components.
+  AtomicUnionFind auf(data.n_cols);
 
-  // Now loop over all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
+  // Monochromatic dual-tree range search does not return the point as its own
+  // neighbor, so we are looking for `minPoints - 1` instead.
+  #pragma omp parallel for
+  for (size_t index = 0; index < (size_t) data.n_cols; ++index)
   {
-    // Get the next index.
-    const size_t index = pointSelector.Select(i, data);
-    // Monochromatic dual-tree range search does not return the point as its own
-    // neighbor, so we are looking for `minPoints - 1` instead.
     if (neighbors[index].size() >= minPoints - 1)
     {
+      // This is a core point: union with every neighboring core point.
+      // (Non-core points must not be unioned here, or a border point could
+      // incorrectly bridge two clusters.)
+      for (size_t j = 0; j < neighbors[index].size(); ++j)
+        if (neighbors[neighbors[index][j]].size() >= (minPoints - 1))
+          auf.Union(index, neighbors[index][j]);
+    }
+    else
+    {
+      // This is a border point if any of its neighbors is a core point; it
+      // joins the cluster of one of them.  Otherwise it is noise and keeps
+      // its own label.
       for (size_t j = 0; j < neighbors[index].size(); ++j)
       {
-        if (uf.Find(neighbors[index][j]) == neighbors[index][j])
+        if (neighbors[neighbors[index][j]].size() >= (minPoints - 1))
         {
-          // This unions unlabeled points.
-          uf.Union(index, neighbors[index][j]);
+          auf.Union(index, neighbors[index][j]);
+          break;
         }
-        else if (neighbors[neighbors[index][j]].size() >= (minPoints - 1))
+      }
+    }
+  }
+
+  // Transfer the components into the caller's UnionFind.
+  for (size_t i = 0; i < data.n_cols; ++i)
+    uf.Union(i, auf.Find(i));
+}
+
+/**
+ * Performs approximate DBSCAN clustering on the data using the sampled
+ * core-point test.  Note that the sampled distance checks use the Euclidean
+ * distance, matching the default RangeSearchType.
+ */
+template<typename RangeSearchType, typename PointSelectionPolicy>
+template<typename MatType>
+void DBSCAN<RangeSearchType, PointSelectionPolicy>::SampledCluster(
+    const MatType& data,
+    UnionFind& uf)
+{
+  if (agreement <= 0.0 || agreement >= 1.0)
+    throw std::invalid_argument("DBSCAN::SampledCluster(): agreement must be "
+        "in the range (0, 1)!");
+
+  const size_t n = data.n_cols;
+
+  // The exact core-point test asks whether at least `minPoints` points
+  // (including the point itself) lie within epsilon.  Equivalently, the
+  // fraction of the other (n - 1) points within epsilon must be at least
+  // `threshold`.  We estimate that fraction by drawing points uniformly at
+  // random, and stop as soon as a sequential empirical-Bernstein bound
+  // separates the estimate from the threshold.  The bound holds
+  // simultaneously over all `maxSampleSize` checks of a point with
+  // probability at least `agreement`, so each early decision matches the
+  // exact test with at least that probability.  Points the bound cannot
+  // decide within the budget fall back to an exact range search.
+  const double threshold = (n > 1) ?
+      ((double) (minPoints - 1) / (double) (n - 1)) : 0.0;
+  const double logTerm = std::log(2.0 * maxSampleSize / (1.0 - agreement));
+
+  std::vector<std::vector<size_t>> sampledNeighbors(n);
+  std::vector<bool> isCore(n, false);
+  size_t fallbacks = 0;
+
+  std::vector<std::vector<size_t>> neighbors;
+  std::vector<std::vector<double>> distances;
+
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (i % 10000 == 0 && i > 0)
+      Log::Info << "Sampled DBSCAN clustering on point " << i << "..."
+          << std::endl;
+
+    const size_t index = pointSelector.Select(i, data);
+
+    size_t hits = 0;
+    bool decided = false;
+    if (n > 1)
+    {
+      for (size_t m = 1; m <= maxSampleSize; ++m)
+      {
+        // Draw a point other than the one we are testing.
+        size_t j = (size_t) RandInt(0, (int) n);
+        while (j == index)
+          j = (size_t) RandInt(0, (int) n);
+
+        const double dist = EuclideanDistance::Evaluate(data.col(index),
+            data.col(j));
+        if (dist <= epsilon)
+        {
+          ++hits;
+          sampledNeighbors[index].push_back(j);
+        }
+
+        // Sequential empirical-Bernstein bound on the neighbor fraction.
+        const double phat = (double) hits / (double) m;
+        const double slack = std::sqrt(2.0 * phat * (1.0 - phat) * logTerm /
+            (double) m) + 7.0 * logTerm / (3.0 * std::max((size_t) 1, m - 1));
+
+        if (phat - slack >= threshold)
+        {
+          // The point is dense enough to be a core point; stop sampling.
+          isCore[index] = true;
+          decided = true;
+          break;
+        }
+        else if (phat + slack < threshold)
+        {
+          // The point cannot be a core point.
+          decided = true;
+          break;
+        }
+      }
+    }
+
+    if (!decided)
+    {
+      // The sample budget could not separate this point's density from the
+      // threshold, so resolve it exactly.
+      rangeSearch.Search(data.col(index), Range(0.0, epsilon), neighbors,
+          distances);
+      isCore[index] = (neighbors[0].size() >= minPoints);
+      sampledNeighbors[index] = std::move(neighbors[0]);
+      ++fallbacks;
+    }
+  }
+
+  Log::Info << "Sampled core-point test used exact fallback for " << fallbacks
+      << " of " << n << " points." << std::endl;
+
+  // Now merge, mirroring BatchCluster(): core points union with their core
+  // neighbors, and each non-core point attaches to one core neighbor (if it
+  // found any).  Only the discovered within-epsilon pairs are used, so the
+  // merge is linear in the number of sampled hits.
+  for (size_t index = 0; index < n; ++index)
+  {
+    if (isCore[index])
+    {
+      for (size_t j = 0; j < sampledNeighbors[index].size(); ++j)
+        if (isCore[sampledNeighbors[index][j]])
+          uf.Union(index, sampledNeighbors[index][j]);
+    }
+    else
+    {
+      for (size_t j = 0; j < sampledNeighbors[index].size(); ++j)
+      {
+        if (isCore[sampledNeighbors[index][j]])
         {
-          // This unions core points of other clusters.
-          uf.Union(index, neighbors[index][j]);
+          uf.Union(index, sampledNeighbors[index][j]);
+          break;
         }
       }
     }
@@ -0,0 +1,158 @@
+/**
+ * @file methods/dbscan/grid_range_search.hpp
+ *
+ * A uniform-grid range search backend for DBSCAN.  Points are bucketed by
+ * grid cell with side length equal to the search radius, so a range query
+ * only needs to scan the 3^d cells adjacent to the query point.  This is
+ * often much faster than tree-based range search in low dimensions.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DBSCAN_GRID_RANGE_SEARCH_HPP
+#define MLPACK_METHODS_DBSCAN_GRID_RANGE_SEARCH_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+
+/**
+ * The GridRangeSearch class implements range search with a uniform grid hash
+ * instead of a tree.  The reference points are bucketed by the cell of a
+ * regular grid whose side length is the search radius, so every point within
+ * the radius of a query lies in one of the 3^d cells surrounding it; those
+ * buckets are scanned with exact distance checks, and the per-point queries
+ * run in parallel.  The grid is built lazily on the first Search() call and
+ * rebuilt only when the radius changes.
+ *
+ * This class implements the subset of the RangeSearch interface that DBSCAN
+ * uses, so it can be plugged in as the RangeSearchType template parameter:
+ *
+ * @code
+ * DBSCAN<GridRangeSearch<>> dbscan(epsilon, minPoints);
+ * @endcode
+ *
+ * The number of scanned cells grows as 3^d, so this is only a good idea in
+ * low dimensions (say, d <= 6); for higher-dimensional data, use the
+ * tree-based RangeSearch class.  The metric must satisfy
+ * d(x, y) >= |x_i - y_i| for every dimension i (true of every LMetric), or
+ * neighbors in non-adjacent cells could be missed.
+ *
+ * @tparam MetricType The metric to use for distance checks.
+ * @tparam MatType The type of data matrix.
+ */
+template<typename MetricType = EuclideanDistance,
+         typename MatType = arma::mat>
+class GridRangeSearch
+{
+ public:
+  /**
+   * Create a GridRangeSearch object with no reference set.  Train() must be
+   * called before Search().
+   */
+  GridRangeSearch();
+
+  /**
+   * Create a GridRangeSearch object with the given reference set.
+   *
+   * @param referenceSet Set of reference points.
+   */
+  GridRangeSearch(MatType referenceSet);
+
+  /**
+   * Set the reference set.  Any grid built for a previous reference set is
+   * discarded.
+   *
+   * @param referenceSet New set of reference data.
+   */
+  void Train(MatType referenceSet);
+
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, returning the results in the neighbors and distances objects.
+   * Each entry in the external vector corresponds to a query point.
+   *
+   * @param querySet Set of query points.
+   * @param range Range of distances in which to search.
+   * @param neighbors Object which will hold the list of neighbors for each
+   *      query point.
+   * @param distances Object which will hold the list of distances for each
+   *      neighbor, for each query point.
+   */
+  void Search(const MatType& querySet,
+              const Range& range,
+              std::vector<std::vector<size_t>>& neighbors,
+              std::vector<std::vector<double>>& distances);
+
+  /**
+   * Search for all points in the given range for each point in the reference
+   * set, returning the results in the neighbors and distances objects.  As
+   * with RangeSearch, a point is not returned as its own neighbor.
+   *
+   * @param range Range of distances in which to search.
+   * @param neighbors Object which will hold the list of neighbors for each
+   *      reference point.
+   * @param distances Object which will hold the list of distances for each
+   *      neighbor, for each reference point.
+   */
+  void Search(const Range& range,
+              std::vector<std::vector<size_t>>& neighbors,
+              std::vector<std::vector<double>>& distances);
+
+  //! Access the reference set.
+  const MatType& ReferenceSet() const { return referenceSet; }
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! The reference set.
+  MatType referenceSet;
+
+  //! Side length of the grid cells, or -1 if no grid has been built.
+  double cellSize;
+  //! Minimum corner of the bounding box of the reference set; cell
+  //! coordinates are relative to this.
+  arma::vec minCorner;
+  //! Hash from cell key to the indices of the points in that cell.  Key
+  //! collisions are harmless: every bucketed point is checked against the
+  //! exact distance anyway.
+  std::unordered_map<uint64_t, std::vector<size_t>> grid;
+
+  /**
+   * Bucket the reference points on a grid with the given cell side length.
+   */
+  void BuildGrid(const double newCellSize);
+
+  /**
+   * Compute the grid cell coordinates of the given point.
+   */
+  template<typename VecType>
+  void CellCoordinates(const VecType& point, arma::Col<int64_t>& coords) const;
+
+  /**
+   * Hash a vector of cell coordinates to a bucket key.
+   */
+  uint64_t CellKey(const arma::Col<int64_t>& coords) const;
+
+  /**
+   * The implementation of both Search() overloads; when sameSet is true,
+   * query point i is taken to be reference point i and is not returned as
+   * its own neighbor.
+   */
+  void SearchInternal(const MatType& querySet,
+                      const Range& range,
+                      std::vector<std::vector<size_t>>& neighbors,
+                      std::vector<std::vector<double>>& distances,
+                      const bool sameSet);
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "grid_range_search_impl.hpp"
+
+#endif
@@ -0,0 +1,209 @@
+/**
+ * @file methods/dbscan/grid_range_search_impl.hpp
+ *
+ * Implementation of the GridRangeSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DBSCAN_GRID_RANGE_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_DBSCAN_GRID_RANGE_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "grid_range_search.hpp"
+
+namespace mlpack {
+
+template<typename MetricType, typename MatType>
+GridRangeSearch<MetricType, MatType>::GridRangeSearch() :
+    cellSize(-1.0)
+{
+  // Nothing to do.
+}
+
+template<typename MetricType, typename MatType>
+GridRangeSearch<MetricType, MatType>::GridRangeSearch(MatType referenceSet) :
+    cellSize(-1.0)
+{
+  Train(std::move(referenceSet));
+}
+
+template<typename MetricType, typename MatType>
+void GridRangeSearch<MetricType, MatType>::Train(MatType referenceSet)
+{
+  this->referenceSet = std::move(referenceSet);
+
+  // The grid is rebuilt lazily on the next Search().
+  cellSize = -1.0;
+  grid.clear();
+}
+
+template<typename MetricType, typename MatType>
+void GridRangeSearch<MetricType, MatType>::BuildGrid(const double newCellSize)
+{
+  if (referenceSet.n_rows > 6)
+  {
+    Log::Warn << "GridRangeSearch: " << referenceSet.n_rows << " dimensions; "
+        << "each query scans 3^d cells, so tree-based RangeSearch is likely "
+        << "to be faster." << std::endl;
+  }
+
+  minCorner = arma::conv_to<arma::vec>::from(arma::min(referenceSet, 1));
+  cellSize = newCellSize;
+
+  grid.clear();
+  arma::Col<int64_t> coords(referenceSet.n_rows);
+  for (size_t i = 0; i < referenceSet.n_cols; ++i)
+  {
+    CellCoordinates(referenceSet.col(i), coords);
+    grid[CellKey(coords)].push_back(i);
+  }
+}
+
+template<typename MetricType, typename MatType>
+template<typename VecType>
+void GridRangeSearch<MetricType, MatType>::CellCoordinates(
+    const VecType& point,
+    arma::Col<int64_t>& coords) const
+{
+  for (size_t d = 0; d < referenceSet.n_rows; ++d)
+    coords[d] = (int64_t) std::floor((point[d] - minCorner[d]) / cellSize);
+}
+
+template<typename MetricType, typename MatType>
+uint64_t GridRangeSearch<MetricType, MatType>::CellKey(
+    const arma::Col<int64_t>& coords) const
+{
+  // FNV-1a over the cell coordinates.  Collisions only cost extra distance
+  // checks, since every bucketed point is verified against the exact range.
+  uint64_t key = 14695981039346656037ULL;
+  for (size_t d = 0; d < coords.n_elem; ++d)
+  {
+    key ^= (uint64_t) coords[d];
+    key *= 1099511628211ULL;
+  }
+  return key;
+}
+
+template<typename MetricType, typename MatType>
+void GridRangeSearch<MetricType, MatType>::Search(
+    const MatType& querySet,
+    const Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances)
+{
+  if (querySet.n_rows != referenceSet.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "GridRangeSearch::Search(): dimensionalities of query set ("
+        << querySet.n_rows << ") and reference set (" << referenceSet.n_rows
+        << ") do not match";
+    throw std::invalid_argument(oss.str());
+  }
+
+  SearchInternal(querySet, range, neighbors, distances, false);
+}
+
+template<typename MetricType, typename MatType>
+void GridRangeSearch<MetricType, MatType>::Search(
+    const Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances)
+{
+  SearchInternal(referenceSet, range, neighbors, distances, true);
+}
+
+template<typename MetricType, typename MatType>
+void GridRangeSearch<MetricType, MatType>::SearchInternal(
+    const MatType& querySet,
+    const Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances,
+    const bool sameSet)
+{
+  if (range.Hi() <= 0.0)
+  {
+    throw std::invalid_argument("GridRangeSearch::Search(): the upper bound "
+        "of the search range must be positive");
+  }
+
+  // (Re)build the grid if the radius changed since the last search.
+  if (cellSize != range.Hi())
+    BuildGrid(range.Hi());
+
+  neighbors.clear();
+  neighbors.resize(querySet.n_cols);
+  distances.clear();
+  distances.resize(querySet.n_cols);
+
+  const size_t dims = referenceSet.n_rows;
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
+  {
+    arma::Col<int64_t> coords(dims);
+    arma::Col<int64_t> cellCoords(dims);
+    CellCoordinates(querySet.col(i), coords);
+
+    // Any point within the radius lies in one of the 3^d cells around the
+    // query.  Buckets are deduplicated by address, in case two of those
+    // cells hash to the same bucket.
+    std::vector<const std::vector<size_t>*> scanned;
+    std::vector<int> offset(dims, -1);
+    while (true)
+    {
+      for (size_t d = 0; d < dims; ++d)
+        cellCoords[d] = coords[d] + offset[d];
+
+      const auto it = grid.find(CellKey(cellCoords));
+      if (it != grid.end() && std::find(scanned.begin(), scanned.end(),
+          &it->second) == scanned.end())
+      {
+        scanned.push_back(&it->second);
+        for (const size_t j : it->second)
+        {
+          if (sameSet && j == i)
+            continue;
+
+          const double distance = MetricType::Evaluate(querySet.col(i),
+              referenceSet.col(j));
+          if (range.Contains(distance))
+          {
+            neighbors[i].push_back(j);
+            distances[i].push_back(distance);
+          }
+        }
+      }
+
+      // Advance the offset odometer; each digit runs over {-1, 0, 1}.
+      size_t d = 0;
+      while (d < dims && offset[d] == 1)
+        offset[d++] = -1;
+      if (d == dims)
+        break;
+      offset[d]++;
+    }
+  }
+}
+
+template<typename MetricType, typename MatType>
+template<typename Archive>
+void GridRangeSearch<MetricType, MatType>::serialize(
+    Archive& ar,
+    const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(referenceSet));
+
+  // The grid is cheap to rebuild, so it is not serialized.
+  if (cereal::is_loading<Archive>())
+  {
+    cellSize = -1.0;
+    grid.clear();
+  }
+}
+
+} // namespace mlpack
+
+#endif
@@ -73,7 +73,44 @@ class BestBinaryNumericSplit
    *      successful split.
    */
   template<bool UseWeights, typename VecType, typename WeightVecType>
-  static double SplitIfBetter(
+  static typename std::enable_if<
+      !arma::is_arma_sparse_type<VecType>::value, double>::type
+  SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const arma::Row<size_t>& labels,
+      const size_t numClasses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::vec& splitInfo,
+      AuxiliarySplitInfo& aux);
+
+  /**
+   * Check if we can split a node, with the dimension's values given as a
+   * sparse vector.  This is equivalent to the dense classification overload
+   * above, but operates at sparse cost: only the nonzero values are sorted,
+   * and the zero-valued points are handled implicitly as a single run of
+   * equal values, so the cost is O(k log k + n) for k nonzeros instead of
+   * O(n log n).
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param labels Labels for each point.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights associated with labels.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param splitInfo Stores split information on a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   */
+  template<bool UseWeights, typename VecType, typename WeightVecType>
+  static typename std::enable_if<
+      arma::is_arma_sparse_type<VecType>::value, double>::type
+  SplitIfBetter(
       const double bestGain,
       const VecType& data,
       const arma::Row<size_t>& labels,
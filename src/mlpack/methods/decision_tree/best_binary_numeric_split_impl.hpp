@@ -17,7 +17,9 @@ namespace mlpack {
 // Overload used for classification.
 template<typename FitnessFunction>
 template<bool UseWeights, typename VecType, typename WeightVecType>
-double BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
+typename std::enable_if<
+    !arma::is_arma_sparse_type<VecType>::value, double>::type
+BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
     const double bestGain,
     const VecType& data,
     const arma::Row<size_t>& labels,
@@ -184,6 +186,236 @@ double BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
   return bestFoundGain;
 }
 
+// Overload used for classification on sparse data.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+typename std::enable_if<
+    arma::is_arma_sparse_type<VecType>::value, double>::type
+BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& splitInfo,
+    AuxiliarySplitInfo& /* aux */)
+{
+  typedef typename VecType::elem_type ElemType;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  const size_t count = data.n_elem;
+  if (count < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Gather and sort only the nonzero values of the dimension.  The
+  // zero-valued points form a run of equal values at a known position in the
+  // sorted order, so we never need to materialize or sort them.
+  const arma::SpMat<ElemType> vec(data);
+  std::vector<std::pair<ElemType, size_t>> sorted;
+  sorted.reserve(vec.n_nonzero);
+  for (typename arma::SpMat<ElemType>::const_iterator it = vec.begin();
+       it != vec.end(); ++it)
+  {
+    // The vector may be a row or a column; one of the coordinates is 0.
+    sorted.push_back(std::make_pair(*it, (vec.n_rows == 1) ? it.col() :
+        it.row()));
+  }
+  std::sort(sorted.begin(), sorted.end());
+
+  const size_t numNonzeros = sorted.size();
+  const size_t numZeros = count - numNonzeros;
+
+  // Sanity check: if all values are the same, we can't split in this
+  // dimension.
+  if (numNonzeros == 0)
+    return DBL_MAX;
+  if (numZeros == 0 && sorted.front().first == sorted.back().first)
+    return DBL_MAX;
+
+  // The position of the run of zeros in the sorted order: after all of the
+  // negative nonzero values.
+  size_t zeroPosition = 0;
+  while (zeroPosition < numNonzeros && sorted[zeroPosition].first < 0)
+    ++zeroPosition;
+
+  // Loop through all possible split points, choosing the best one.  Also,
+  // force a minimum leaf size of 1 (empty children don't make sense).
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  // We need to count the number of points for each class.  All points start
+  // on the right, and are moved to the left as the scan advances.
+  arma::Mat<size_t> classCounts;
+  arma::mat classWeightSums;
+  double totalWeight = 0.0;
+  double totalLeftWeight = 0.0;
+  double totalRightWeight = 0.0;
+  if (UseWeights)
+  {
+    classWeightSums.zeros(numClasses, 2);
+    totalWeight = arma::accu(weights);
+    bestFoundGain *= totalWeight;
+
+    for (size_t i = 0; i < count; ++i)
+      classWeightSums(labels[i], 1) += weights[i];
+    totalRightWeight = totalWeight;
+  }
+  else
+  {
+    classCounts.zeros(numClasses, 2);
+    bestFoundGain *= count;
+
+    for (size_t i = 0; i < count; ++i)
+      ++classCounts(labels[i], 1);
+  }
+
+  // Class statistics of the zero-valued points: the totals minus the
+  // statistics of the nonzero points.
+  arma::Col<size_t> zeroCounts;
+  arma::vec zeroWeightSums;
+  double zeroWeight = 0.0;
+  if (numZeros > 0)
+  {
+    if (UseWeights)
+    {
+      zeroWeightSums = classWeightSums.col(1);
+      zeroWeight = totalWeight;
+      for (size_t i = 0; i < numNonzeros; ++i)
+      {
+        zeroWeightSums[labels[sorted[i].second]] -= weights[sorted[i].second];
+        zeroWeight -= weights[sorted[i].second];
+      }
+    }
+    else
+    {
+      zeroCounts = classCounts.col(1);
+      for (size_t i = 0; i < numNonzeros; ++i)
+        --zeroCounts[labels[sorted[i].second]];
+    }
+  }
+
+  // Scan the virtual sorted sequence: the negative nonzeros, then the run of
+  // zeros, then the positive nonzeros.  `index` is the number of points that
+  // have been moved to the left side so far, so each candidate split is
+  // evaluated with exactly the same statistics as the dense overload.
+  const size_t numItems = numNonzeros + ((numZeros > 0) ? 1 : 0);
+  size_t nonzeroIndex = 0;
+  size_t index = 0;
+  ElemType previousValue = ElemType(0);
+  for (size_t item = 0; item < numItems; ++item)
+  {
+    const bool isZeroRun = ((numZeros > 0) && (item == zeroPosition));
+    const ElemType value = isZeroRun ? ElemType(0) :
+        sorted[nonzeroIndex].first;
+
+    // Evaluate the boundary between the previous value and this one, if it
+    // leaves enough points on each side.
+    if ((item > 0) && (value != previousValue) &&
+        (index >= minimum) && (index < count - minimum))
+    {
+      // Calculate the gain for the left and right child.  Only use weights if
+      // needed.
+      const double leftGain = UseWeights ?
+          FitnessFunction::template EvaluatePtr<true>(
+              classWeightSums.colptr(0), numClasses, totalLeftWeight) :
+          FitnessFunction::template EvaluatePtr<false>(classCounts.colptr(0),
+              numClasses, index);
+      const double rightGain = UseWeights ?
+          FitnessFunction::template EvaluatePtr<true>(
+              classWeightSums.colptr(1), numClasses, totalRightWeight) :
+          FitnessFunction::template EvaluatePtr<false>(classCounts.colptr(1),
+              numClasses, size_t(count - index));
+
+      double gain;
+      if (UseWeights)
+      {
+        gain = totalLeftWeight * leftGain + totalRightWeight * rightGain;
+      }
+      else
+      {
+        // Calculate the gain at this split point.
+        gain = double(index) * leftGain + double(count - index) * rightGain;
+      }
+
+      // Corner case: is this the best possible split?
+      if (gain >= 0.0)
+      {
+        // We can take a shortcut: no split will be better than this, so just
+        // take this one.  The actual split value will be halfway between the
+        // two adjacent values.
+        splitInfo.set_size(1);
+        splitInfo[0] = (previousValue + value) / 2.0;
+
+        return gain;
+      }
+      else if (gain > bestFoundGain)
+      {
+        // We still have a better split.
+        bestFoundGain = gain;
+        splitInfo.set_size(1);
+        splitInfo[0] = (previousValue + value) / 2.0;
+        improved = true;
+      }
+    }
+
+    // Now move this item to the left side.
+    if (isZeroRun)
+    {
+      if (UseWeights)
+      {
+        classWeightSums.col(0) += zeroWeightSums;
+        classWeightSums.col(1) -= zeroWeightSums;
+        totalLeftWeight += zeroWeight;
+        totalRightWeight -= zeroWeight;
+      }
+      else
+      {
+        classCounts.col(0) += zeroCounts;
+        classCounts.col(1) -= zeroCounts;
+      }
+      index += numZeros;
+    }
+    else
+    {
+      const size_t label = labels[sorted[nonzeroIndex].second];
+      if (UseWeights)
+      {
+        const double weight = weights[sorted[nonzeroIndex].second];
+        classWeightSums(label, 1) -= weight;
+        classWeightSums(label, 0) += weight;
+        totalLeftWeight += weight;
+        totalRightWeight -= weight;
+      }
+      else
+      {
+        --classCounts(label, 1);
+        ++classCounts(label, 0);
+      }
+      ++index;
+      ++nonzeroIndex;
+    }
+
+    previousValue = value;
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= count;
+
+  return bestFoundGain;
+}
+
 // Overload used for regression.
 template<typename FitnessFunction>
 template<bool UseWeights, typename VecType, typename ResponsesType,
@@ -21,6 +21,7 @@
 #include "mse_gain.hpp"
 
 #include "best_binary_numeric_split.hpp"
+#include "histogram_binary_numeric_split.hpp"
 #include "random_binary_numeric_split.hpp"
 
 #include "all_categorical_split.hpp"
@@ -490,6 +491,17 @@ class DecisionTree :
    */
   size_t NumClasses() const;
 
+  /**
+   * Compile the trained tree into a flattened structure-of-arrays
+   * representation for faster batch classification.  After this is called,
+   * the matrix overloads of Classify() traverse contiguous arrays of split
+   * dimensions, thresholds and child offsets, processing points in blocks,
+   * instead of chasing child pointers for one point at a time.  The flattened
+   * representation is discarded when the tree is retrained, assigned to, or
+   * loaded, so Compile() must be called again afterwards.
+   */
+  void Compile();
+
  private:
   //! The vector of children.
   std::vector<DecisionTree*> children;
@@ -513,6 +525,42 @@ class DecisionTree :
    */
   arma::vec classProbabilities;
 
+  //! Flattened form of the tree built by Compile().  All of the vectors below
+  //! are indexed by flattened node id; the root is node 0 and the children of
+  //! each node are stored contiguously.  The vectors are empty if Compile()
+  //! has not been called.
+  //! The split dimension of each flattened node.
+  std::vector<size_t> flatSplitDimensions;
+  //! The type of each flattened node's split dimension.
+  std::vector<size_t> flatDimensionTypes;
+  //! The split information (threshold) of each flattened node.
+  std::vector<double> flatSplitInfo;
+  //! The index of the first child of each flattened node, or 0 for leaves.
+  std::vector<size_t> flatChildOffsets;
+  //! The majority class of each flattened node (meaningful only for leaves).
+  std::vector<size_t> flatMajorityClasses;
+  //! The tree node behind each flattened node; used for the auxiliary split
+  //! information and for the class probabilities of leaves.
+  std::vector<const DecisionTree*> flatNodes;
+
+  //! Throw away the flattened form of the tree, if it has been built.
+  void ResetCompile();
+
+  /**
+   * Classify the given points with the flattened tree representation, which
+   * must have been built by Compile().  Points are processed in blocks, with
+   * every point in a block advanced one level of the tree at a time.
+   *
+   * @param data Set of points to classify.
+   * @param predictions This will be filled with predictions for each point.
+   * @param probabilities If not NULL, this will be filled with class
+   *      probabilities for each point.
+   */
+  template<typename MatType>
+  void ClassifyCompiled(const MatType& data,
+                        arma::Row<size_t>& predictions,
+                        arma::mat* probabilities) const;
+
   //! Note that this class will also hold the members of the NumericSplit and
   //! CategoricalSplit AuxiliarySplitInfo classes, since it inherits from them.
   //! We'll define some convenience typedefs here.
@@ -544,6 +592,9 @@ class DecisionTree :
    * @param minimumLeafSize Minimum number of points in each leaf node.
    * @param minimumGainSplit Minimum gain for the node to split.
    * @param maximumDepth Maximum depth for the tree.
+   * @param childAssignments Buffer of length data.n_cols, shared by the whole
+   *      recursion, that holds the child assignment of each point while a node
+   *      is split.
    * @return The final entropy of decision tree.
    */
   template<bool UseWeights, typename MatType>
@@ -557,7 +608,8 @@ class DecisionTree :
                const size_t minimumLeafSize,
                const double minimumGainSplit,
                const size_t maximumDepth,
-               DimensionSelectionType& dimensionSelector);
+               DimensionSelectionType& dimensionSelector,
+               arma::Row<size_t>& childAssignments);
 
   /**
    * Corresponding to the public Train() method, this method is designed for
@@ -573,6 +625,9 @@ class DecisionTree :
    * @param minimumLeafSize Minimum number of points in each leaf node.
    * @param minimumGainSplit Minimum gain for the node to split.
    * @param maximumDepth Maximum depth for the tree.
+   * @param childAssignments Buffer of length data.n_cols, shared by the whole
+   *      recursion, that holds the child assignment of each point while a node
+   *      is split.
    * @return The final entropy of decision tree.
    */
   template<bool UseWeights, typename MatType>
@@ -585,7 +640,8 @@ class DecisionTree :
                const size_t minimumLeafSize,
                const double minimumGainSplit,
                const size_t maximumDepth,
-               DimensionSelectionType& dimensionSelector);
+               DimensionSelectionType& dimensionSelector,
+               arma::Row<size_t>& childAssignments);
 };
 
 /**
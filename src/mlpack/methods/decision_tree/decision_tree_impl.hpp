@@ -49,9 +49,10 @@ DecisionTree<FitnessFunction,
 
   // Pass off work to the Train() method.
   arma::rowvec weights; // Fake weights, not used.
+  arma::Row<size_t> childAssignments(tmpData.n_cols);
   Train<false>(tmpData, 0, tmpData.n_cols, datasetInfo, tmpLabels, numClasses,
       weights, minimumLeafSize, minimumGainSplit, maximumDepth,
-      dimensionSelector);
+      dimensionSelector, childAssignments);
 }
 
 //! Construct and train.
@@ -86,8 +87,10 @@ DecisionTree<FitnessFunction,
 
   // Pass off work to the Train() method.
   arma::rowvec weights; // Fake weights, not used.
+  arma::Row<size_t> childAssignments(tmpData.n_cols);
   Train<false>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses, weights,
-      minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
+      minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector,
+      childAssignments);
 }
 
 //! Construct and train with weights.
@@ -127,9 +130,10 @@ DecisionTree<FitnessFunction,
   dimensionSelector.Dimensions() = tmpData.n_rows;
 
   // Pass off work to the weighted Train() method.
+  arma::Row<size_t> childAssignments(tmpData.n_cols);
   Train<true>(tmpData, 0, tmpData.n_cols, datasetInfo, tmpLabels, numClasses,
       tmpWeights, minimumLeafSize, minimumGainSplit, maximumDepth,
-      dimensionSelector);
+      dimensionSelector, childAssignments);
 }
 
 //! Construct and train with weights.
@@ -209,8 +213,10 @@ DecisionTree<FitnessFunction,
   dimensionSelector.Dimensions() = tmpData.n_rows;
 
   // Pass off work to the weighted Train() method.
+  arma::Row<size_t> childAssignments(tmpData.n_cols);
   Train<true>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses, tmpWeights,
-      minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
+      minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector,
+      childAssignments);
 }
 
 //! Construct and train with weights.
@@ -253,8 +259,10 @@ DecisionTree<FitnessFunction,
   dimensionSelector.Dimensions() = tmpData.n_rows;
 
   // Pass off work to the weighted Train() method.
+  arma::Row<size_t> childAssignments(tmpData.n_cols);
   Train<true>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses, tmpWeights,
-      minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
+      minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector,
+      childAssignments);
 }
 
 //! Construct, don't train.
@@ -326,6 +334,7 @@ DecisionTree<FitnessFunction,
 
   // Reset the other object.
   other.classProbabilities.ones(1); // One class, P(1) = 1.
+  other.ResetCompile();
 }
 
 //! Copy another tree.
@@ -353,6 +362,9 @@ DecisionTree<FitnessFunction,
     delete children[i];
   children.clear();
 
+  // Any flattened form of the old tree is no longer valid.
+  ResetCompile();
+
   // Copy everything from the other tree.
   splitDimension = other.splitDimension;
 
@@ -399,6 +411,10 @@ DecisionTree<FitnessFunction,
     delete children[i];
   children.clear();
 
+  // Any flattened form of either tree is no longer valid.
+  ResetCompile();
+  other.ResetCompile();
+
   // Take ownership of the other tree's components.
   children = std::move(other.children);
   splitDimension = other.splitDimension;
@@ -472,9 +488,10 @@ double DecisionTree<FitnessFunction,
 
   // Pass off work to the Train() method.
   arma::rowvec weights; // Fake weights, not used.
+  arma::Row<size_t> childAssignments(tmpData.n_cols);
   return Train<false>(tmpData, 0, tmpData.n_cols, datasetInfo, tmpLabels,
       numClasses, weights, minimumLeafSize, minimumGainSplit, maximumDepth,
-      dimensionSelector);
+      dimensionSelector, childAssignments);
 }
 
 //! Train on the given data, assuming all dimensions are numeric.
@@ -512,9 +529,10 @@ double DecisionTree<FitnessFunction,
 
   // Pass off work to the Train() method.
   arma::rowvec weights; // Fake weights, not used.
+  arma::Row<size_t> childAssignments(tmpData.n_cols);
   return Train<false>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses,
       weights, minimumLeafSize, minimumGainSplit, maximumDepth,
-      dimensionSelector);
+      dimensionSelector, childAssignments);
 }
 
 //! Train on the given weighted data.
@@ -559,9 +577,10 @@ double DecisionTree<FitnessFunction,
   dimensionSelector.Dimensions() = tmpData.n_rows;
 
   // Pass off work to the Train() method.
+  arma::Row<size_t> childAssignments(tmpData.n_cols);
   return Train<true>(tmpData, 0, tmpData.n_cols, datasetInfo, tmpLabels,
       numClasses, tmpWeights, minimumLeafSize, minimumGainSplit, maximumDepth,
-      dimensionSelector);
+      dimensionSelector, childAssignments);
 }
 
 //! Train on the given weighted data.
@@ -605,9 +624,10 @@ double DecisionTree<FitnessFunction,
   dimensionSelector.Dimensions() = tmpData.n_rows;
 
   // Pass off work to the Train() method.
+  arma::Row<size_t> childAssignments(tmpData.n_cols);
   return Train<true>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses,
       tmpWeights, minimumLeafSize, minimumGainSplit, maximumDepth,
-      dimensionSelector);
+      dimensionSelector, childAssignments);
 }
 
 //! Train on the given data, assuming all dimensions are numeric.
@@ -632,9 +652,11 @@ double DecisionTree<FitnessFunction,
     const size_t minimumLeafSize,
     const double minimumGainSplit,
     const size_t maximumDepth,
-    DimensionSelectionType& dimensionSelector)
+    DimensionSelectionType& dimensionSelector,
+    arma::Row<size_t>& childAssignments)
 {
-  // Clear children if needed.
+  // Clear children, and any flattened form of the tree, if needed.
+  ResetCompile();
   for (size_t i = 0; i < children.size(); ++i)
     delete children[i];
   children.clear();
@@ -653,13 +675,27 @@ double DecisionTree<FitnessFunction,
 
   if (maximumDepth != 1)
   {
+    // The dimension selector is stateful, so enumerate the dimensions to
+    // check up front; each dimension's gain computation is then independent
+    // of the others and the loop can be parallelized.
+    std::vector<size_t> dims;
     for (size_t i = dimensionSelector.Begin(); i != end;
          i = dimensionSelector.Next())
+      dims.push_back(i);
+
+    std::vector<double> dimGains(dims.size(), DBL_MAX);
+    std::vector<arma::vec> dimSplitInfos(dims.size());
+    std::vector<NumericAuxiliarySplitInfo> numericAuxs(dims.size());
+    std::vector<CategoricalAuxiliarySplitInfo> categoricalAuxs(dims.size());
+
+    #pragma omp parallel for
+    for (size_t j = 0; j < (size_t) dims.size(); ++j)
     {
-      double dimGain = -DBL_MAX;
+      const size_t i = dims[j];
       if (datasetInfo.Type(i) == data::Datatype::categorical)
       {
-        dimGain = CategoricalSplit::template SplitIfBetter<UseWeights>(bestGain,
+        dimGains[j] = CategoricalSplit::template SplitIfBetter<UseWeights>(
+            bestGain,
             data.cols(begin, begin + count - 1).row(i),
             datasetInfo.NumMappings(i),
             labels.subvec(begin, begin + count - 1),
@@ -667,34 +703,49 @@ double DecisionTree<FitnessFunction,
             UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
             minimumLeafSize,
             minimumGainSplit,
-            classProbabilities,
-            *this);
+            dimSplitInfos[j],
+            categoricalAuxs[j]);
       }
       else if (datasetInfo.Type(i) == data::Datatype::numeric)
       {
-        dimGain = NumericSplit::template SplitIfBetter<UseWeights>(bestGain,
+        dimGains[j] = NumericSplit::template SplitIfBetter<UseWeights>(
+            bestGain,
             data.cols(begin, begin + count - 1).row(i),
             labels.subvec(begin, begin + count - 1),
             numClasses,
             UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
             minimumLeafSize,
             minimumGainSplit,
-            classProbabilities,
-            *this);
+            dimSplitInfos[j],
+            numericAuxs[j]);
       }
+    }
 
-      // If the splitter reported that it did not split, move to the next
-      // dimension.
-      if (dimGain == DBL_MAX)
+    // Pick the best dimension.  Every split was computed against this node's
+    // gain (DBL_MAX means the splitter did not improve on it), so the largest
+    // reported gain wins; ties go to the earliest dimension, as before.
+    size_t bestIndex = dims.size();
+    for (size_t j = 0; j < dims.size(); ++j)
+    {
+      if (dimGains[j] == DBL_MAX)
         continue;
 
-      // Was there an improvement?  If so mark that it's the new best dimension.
-      bestDim = i;
-      bestGain = dimGain;
+      if (bestIndex == dims.size() || dimGains[j] > bestGain)
+      {
+        bestIndex = j;
+        bestDim = dims[j];
+        bestGain = dimGains[j];
+      }
+    }
 
-      // If the gain is the best possible, no need to keep looking.
-      if (bestGain >= 0.0)
-        break;
+    // Store the split information of the winning dimension.
+    if (bestIndex != dims.size())
+    {
+      classProbabilities = std::move(dimSplitInfos[bestIndex]);
+      if (datasetInfo.Type(bestDim) == data::Datatype::categorical)
+        CategoricalAuxiliarySplitInfo::operator=(categoricalAuxs[bestIndex]);
+      else
+        NumericAuxiliarySplitInfo::operator=(numericAuxs[bestIndex]);
     }
   }
 
@@ -711,19 +762,21 @@ double DecisionTree<FitnessFunction,
     else
       numChildren = NumericSplit::NumChildren(classProbabilities[0], *this);
 
-    // Calculate all child assignments.
-    arma::Row<size_t> childAssignments(count);
+    // Calculate all child assignments, into the buffer shared by the whole
+    // recursion; this node only touches positions [begin, begin + count).
     if (datasetInfo.Type(bestDim) == data::Datatype::categorical)
     {
+      #pragma omp parallel for
       for (size_t j = begin; j < begin + count; ++j)
-        childAssignments[j - begin] = CategoricalSplit::CalculateDirection(
+        childAssignments[j] = CategoricalSplit::CalculateDirection(
             data(bestDim, j), classProbabilities[0], *this);
     }
     else
     {
+      #pragma omp parallel for
       for (size_t j = begin; j < begin + count; ++j)
       {
-        childAssignments[j - begin] = NumericSplit::CalculateDirection(
+        childAssignments[j] = NumericSplit::CalculateDirection(
             data(bestDim, j), classProbabilities[0], *this);
       }
     }
@@ -731,7 +784,7 @@ double DecisionTree<FitnessFunction,
     // Figure out counts of children.
     arma::Row<size_t> childCounts(numChildren, arma::fill::zeros);
     for (size_t i = begin; i < begin + count; ++i)
-      childCounts[childAssignments[i - begin]]++;
+      childCounts[childAssignments[i]]++;
 
     // Initialize bestGain if recursive split is allowed.
     if (!NoRecursion)
@@ -746,9 +799,9 @@ double DecisionTree<FitnessFunction,
       size_t currentChildBegin = currentCol;
       for (size_t j = currentChildBegin; j < begin + count; ++j)
       {
-        if (childAssignments[j - begin] == i)
+        if (childAssignments[j] == i)
         {
-          childAssignments.swap_cols(currentCol - begin, j - begin);
+          childAssignments.swap_cols(currentCol, j);
           data.swap_cols(currentCol, j);
           labels.swap_cols(currentCol, j);
           if (UseWeights)
@@ -764,7 +817,7 @@ double DecisionTree<FitnessFunction,
         child->Train<UseWeights>(data, currentChildBegin,
             currentCol - currentChildBegin, datasetInfo, labels, numClasses,
             weights, currentCol - currentChildBegin, minimumGainSplit,
-            maximumDepth - 1, dimensionSelector);
+            maximumDepth - 1, dimensionSelector, childAssignments);
       }
       else
       {
@@ -772,7 +825,7 @@ double DecisionTree<FitnessFunction,
         double childGain = child->Train<UseWeights>(data, currentChildBegin,
             currentCol - currentChildBegin, datasetInfo, labels, numClasses,
             weights, minimumLeafSize, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
+            dimensionSelector, childAssignments);
         bestGain += double(childCounts[i]) / double(count) * (-childGain);
       }
       children.push_back(child);
@@ -815,9 +868,11 @@ double DecisionTree<FitnessFunction,
     const size_t minimumLeafSize,
     const double minimumGainSplit,
     const size_t maximumDepth,
-    DimensionSelectionType& dimensionSelector)
+    DimensionSelectionType& dimensionSelector,
+    arma::Row<size_t>& childAssignments)
 {
-  // Clear children if needed.
+  // Clear children, and any flattened form of the tree, if needed.
+  ResetCompile();
   for (size_t i = 0; i < children.size(); ++i)
     delete children[i];
   children.clear();
@@ -838,10 +893,23 @@ double DecisionTree<FitnessFunction,
 
   if (maximumDepth != 1)
   {
+    // The dimension selector is stateful, so enumerate the dimensions to
+    // check up front; each dimension's gain computation is then independent
+    // of the others and the loop can be parallelized.
+    std::vector<size_t> dims;
     for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
          i = dimensionSelector.Next())
+      dims.push_back(i);
+
+    std::vector<double> dimGains(dims.size(), DBL_MAX);
+    std::vector<arma::vec> dimSplitInfos(dims.size());
+    std::vector<NumericAuxiliarySplitInfo> numericAuxs(dims.size());
+
+    #pragma omp parallel for
+    for (size_t j = 0; j < (size_t) dims.size(); ++j)
     {
-      const double dimGain = NumericSplitType<FitnessFunction>::template
+      const size_t i = dims[j];
+      dimGains[j] = NumericSplitType<FitnessFunction>::template
           SplitIfBetter<UseWeights>(bestGain,
                                     data.cols(begin, begin + count - 1).row(i),
                                     labels.cols(begin, begin + count - 1),
@@ -851,20 +919,32 @@ double DecisionTree<FitnessFunction,
                                         weights,
                                     minimumLeafSize,
                                     minimumGainSplit,
-                                    classProbabilities,
-                                    *this);
+                                    dimSplitInfos[j],
+                                    numericAuxs[j]);
+    }
 
-      // If the splitter did not report that it improved, then move to the next
-      // dimension.
-      if (dimGain == DBL_MAX)
+    // Pick the best dimension.  Every split was computed against this node's
+    // gain (DBL_MAX means the splitter did not improve on it), so the largest
+    // reported gain wins; ties go to the earliest dimension, as before.
+    size_t bestIndex = dims.size();
+    for (size_t j = 0; j < dims.size(); ++j)
+    {
+      if (dimGains[j] == DBL_MAX)
         continue;
 
-      bestDim = i;
-      bestGain = dimGain;
+      if (bestIndex == dims.size() || dimGains[j] > bestGain)
+      {
+        bestIndex = j;
+        bestDim = dims[j];
+        bestGain = dimGains[j];
+      }
+    }
 
-      // If the gain is the best possible, no need to keep looking.
-      if (bestGain >= 0.0)
-        break;
+    // Store the split information of the winning dimension.
+    if (bestIndex != dims.size())
+    {
+      classProbabilities = std::move(dimSplitInfos[bestIndex]);
+      NumericAuxiliarySplitInfo::operator=(numericAuxs[bestIndex]);
     }
   }
 
@@ -877,12 +957,12 @@ double DecisionTree<FitnessFunction,
     splitDimension = bestDim;
     dimensionType = (size_t) data::Datatype::numeric;
 
-    // Calculate all child assignments.
-    arma::Row<size_t> childAssignments(count);
-
+    // Calculate all child assignments, into the buffer shared by the whole
+    // recursion; this node only touches positions [begin, begin + count).
+    #pragma omp parallel for
     for (size_t j = begin; j < begin + count; ++j)
     {
-      childAssignments[j - begin] = NumericSplit::CalculateDirection(
+      childAssignments[j] = NumericSplit::CalculateDirection(
           data(bestDim, j), classProbabilities[0], *this);
     }
 
@@ -890,7 +970,7 @@ double DecisionTree<FitnessFunction,
     arma::Row<size_t> childCounts(numChildren);
     childCounts.zeros();
     for (size_t j = begin; j < begin + count; ++j)
-      childCounts[childAssignments[j - begin]]++;
+      childCounts[childAssignments[j]]++;
 
     // Initialize bestGain if recursive split is allowed.
     if (!NoRecursion)
@@ -904,9 +984,9 @@ double DecisionTree<FitnessFunction,
       size_t currentChildBegin = currentCol;
       for (size_t j = currentChildBegin; j < begin + count; ++j)
       {
-        if (childAssignments[j - begin] == i)
+        if (childAssignments[j] == i)
         {
-          childAssignments.swap_cols(currentCol - begin, j - begin);
+          childAssignments.swap_cols(currentCol, j);
           data.swap_cols(currentCol, j);
           labels.swap_cols(currentCol, j);
           if (UseWeights)
@@ -922,7 +1002,7 @@ double DecisionTree<FitnessFunction,
         child->Train<UseWeights>(data, currentChildBegin,
             currentCol - currentChildBegin, labels, numClasses, weights,
             currentCol - currentChildBegin, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
+            dimensionSelector, childAssignments);
       }
       else
       {
@@ -930,7 +1010,7 @@ double DecisionTree<FitnessFunction,
         double childGain = child->Train<UseWeights>(data, currentChildBegin,
             currentCol - currentChildBegin, labels, numClasses, weights,
             minimumLeafSize, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
+            dimensionSelector, childAssignments);
         bestGain += double(childCounts[i]) / double(count) * (-childGain);
       }
       children.push_back(child);
@@ -1020,6 +1100,13 @@ void DecisionTree<FitnessFunction,
     return;
   }
 
+  // Use the flattened representation, if it has been built.
+  if (!flatChildOffsets.empty())
+  {
+    ClassifyCompiled(data, predictions, NULL);
+    return;
+  }
+
   // Loop over each point.
   for (size_t i = 0; i < data.n_cols; ++i)
     predictions[i] = Classify(data.col(i));
@@ -1055,6 +1142,13 @@ void DecisionTree<FitnessFunction,
     node = &node->Child(0);
   probabilities.set_size(node->classProbabilities.n_elem, data.n_cols);
 
+  // Use the flattened representation, if it has been built.
+  if (!flatChildOffsets.empty())
+  {
+    ClassifyCompiled(data, predictions, &probabilities);
+    return;
+  }
+
   for (size_t i = 0; i < data.n_cols; ++i)
   {
     arma::vec v = probabilities.unsafe_col(i); // Alias of column.
@@ -1062,6 +1156,142 @@ void DecisionTree<FitnessFunction,
   }
 }
 
+//! Flatten the tree into a structure-of-arrays representation.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+void DecisionTree<FitnessFunction,
+                  NumericSplitType,
+                  CategoricalSplitType,
+                  DimensionSelectionType,
+                  NoRecursion>::Compile()
+{
+  ResetCompile();
+
+  // Walk the tree in breadth-first order; since all children of a node are
+  // appended at once, the children of every flattened node are contiguous.
+  flatNodes.push_back(this);
+  for (size_t i = 0; i < flatNodes.size(); ++i)
+  {
+    const DecisionTree* node = flatNodes[i];
+    if (node->children.size() == 0)
+    {
+      flatSplitDimensions.push_back(0);
+      flatDimensionTypes.push_back(0);
+      flatSplitInfo.push_back(0.0);
+      flatChildOffsets.push_back(0); // The root cannot be a child: 0 = leaf.
+      flatMajorityClasses.push_back(node->majorityClass);
+    }
+    else
+    {
+      flatSplitDimensions.push_back(node->splitDimension);
+      flatDimensionTypes.push_back(node->dimensionType);
+      flatSplitInfo.push_back(node->classProbabilities[0]);
+      flatChildOffsets.push_back(flatNodes.size());
+      flatMajorityClasses.push_back(0);
+      for (size_t c = 0; c < node->children.size(); ++c)
+        flatNodes.push_back(node->children[c]);
+    }
+  }
+}
+
+//! Throw away the flattened form of the tree.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+void DecisionTree<FitnessFunction,
+                  NumericSplitType,
+                  CategoricalSplitType,
+                  DimensionSelectionType,
+                  NoRecursion>::ResetCompile()
+{
+  flatSplitDimensions.clear();
+  flatDimensionTypes.clear();
+  flatSplitInfo.clear();
+  flatChildOffsets.clear();
+  flatMajorityClasses.clear();
+  flatNodes.clear();
+}
+
+//! Classify the given points with the flattened tree representation.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<typename MatType>
+void DecisionTree<FitnessFunction,
+                  NumericSplitType,
+                  CategoricalSplitType,
+                  DimensionSelectionType,
+                  NoRecursion>::ClassifyCompiled(
+    const MatType& data,
+    arma::Row<size_t>& predictions,
+    arma::mat* probabilities) const
+{
+  // Points are processed in blocks; all points in a block descend one level
+  // of the tree at a time, so the flat arrays stay hot in cache and the
+  // per-point traversal state is just an index into them.
+  const size_t blockSize = 256;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t blockBegin = 0; blockBegin < (size_t) data.n_cols;
+       blockBegin += blockSize)
+  {
+    const size_t blockEnd = std::min(blockBegin + blockSize,
+        (size_t) data.n_cols);
+
+    // Current flattened node of each point in the block; all start at the
+    // root.
+    size_t nodes[blockSize];
+    for (size_t j = blockBegin; j < blockEnd; ++j)
+      nodes[j - blockBegin] = 0;
+
+    bool anyInternal = true;
+    while (anyInternal)
+    {
+      anyInternal = false;
+      for (size_t j = blockBegin; j < blockEnd; ++j)
+      {
+        const size_t node = nodes[j - blockBegin];
+        if (flatChildOffsets[node] == 0)
+          continue; // The point has already reached a leaf.
+
+        size_t direction;
+        if ((data::Datatype) flatDimensionTypes[node] ==
+            data::Datatype::categorical)
+        {
+          direction = CategoricalSplit::CalculateDirection(
+              data(flatSplitDimensions[node], j), flatSplitInfo[node],
+              *flatNodes[node]);
+        }
+        else
+        {
+          direction = NumericSplit::CalculateDirection(
+              data(flatSplitDimensions[node], j), flatSplitInfo[node],
+              *flatNodes[node]);
+        }
+
+        nodes[j - blockBegin] = flatChildOffsets[node] + direction;
+        anyInternal = true;
+      }
+    }
+
+    // Emit the results of each point's leaf.
+    for (size_t j = blockBegin; j < blockEnd; ++j)
+    {
+      const size_t leaf = nodes[j - blockBegin];
+      predictions[j] = flatMajorityClasses[leaf];
+      if (probabilities != NULL)
+        probabilities->col(j) = flatNodes[leaf]->classProbabilities;
+    }
+  }
+}
+
 //! Serialize the tree.
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
@@ -1079,6 +1309,7 @@ void DecisionTree<FitnessFunction,
   // Clean memory if needed.
   if (cereal::is_loading<Archive>())
   {
+    ResetCompile();
     for (size_t i = 0; i < children.size(); ++i)
       delete children[i];
     children.clear();
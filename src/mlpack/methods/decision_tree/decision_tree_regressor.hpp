@@ -18,6 +18,7 @@
 #include "mad_gain.hpp"
 #include "mse_gain.hpp"
 #include "best_binary_numeric_split.hpp"
+#include "histogram_binary_numeric_split.hpp"
 #include "all_categorical_split.hpp"
 #include "random_binary_numeric_split.hpp"
 #include "all_dimension_select.hpp"
@@ -440,6 +441,17 @@ class DecisionTreeRegressor :
   template<typename VecType>
   size_t CalculateDirection(const VecType& point) const;
 
+  /**
+   * Compile the trained tree into a flattened structure-of-arrays
+   * representation for faster batch prediction.  After this is called, the
+   * matrix overload of Predict() traverses contiguous arrays of split
+   * dimensions, split points and child offsets, processing points in blocks,
+   * instead of chasing child pointers for one point at a time.  The flattened
+   * representation is discarded when the tree is retrained, assigned to, or
+   * loaded, so Compile() must be called again afterwards.
+   */
+  void Compile();
+
  private:
   //! The vector of children.
   std::vector<DecisionTreeRegressor*> children;
@@ -457,6 +469,39 @@ class DecisionTreeRegressor :
     double prediction;
   };
 
+  //! Flattened form of the tree built by Compile().  All of the vectors below
+  //! are indexed by flattened node id; the root is node 0 and the children of
+  //! each node are stored contiguously.  The vectors are empty if Compile()
+  //! has not been called.
+  //! The split dimension of each flattened node.
+  std::vector<size_t> flatSplitDimensions;
+  //! The type of each flattened node's split dimension.
+  std::vector<size_t> flatDimensionTypes;
+  //! The split point of each flattened internal node, or the prediction of
+  //! each flattened leaf.
+  std::vector<double> flatSplitPoints;
+  //! The index of the first child of each flattened node, or 0 for leaves.
+  std::vector<size_t> flatChildOffsets;
+  //! The tree node behind each flattened node; used for the auxiliary split
+  //! information.
+  std::vector<const DecisionTreeRegressor*> flatNodes;
+
+  //! Throw away the flattened form of the tree, if it has been built.
+  void ResetCompile();
+
+  /**
+   * Predict the responses of the given points with the flattened tree
+   * representation, which must have been built by Compile().  Points are
+   * processed in blocks, with every point in a block advanced one level of
+   * the tree at a time.
+   *
+   * @param data Set of points to predict.
+   * @param predictions This will be filled with predictions for each point.
+   */
+  template<typename MatType>
+  void PredictCompiled(const MatType& data,
+                       arma::Row<double>& predictions) const;
+
   //! Note that this class will also hold the members of the NumericSplit and
   //! CategoricalSplit AuxiliarySplitInfo classes, since it inherits from them.
   //! We'll define some convenience typedefs here.
@@ -320,6 +320,9 @@ DecisionTreeRegressor<FitnessFunction,
     splitPoint = other.splitPoint;
   else
     prediction = other.prediction;
+
+  // Any flattened form of the other tree is no longer valid.
+  other.ResetCompile();
 }
 
 //! Copy another tree.
@@ -348,6 +351,9 @@ DecisionTreeRegressor<FitnessFunction,
     delete children[i];
   children.clear();
 
+  // Any flattened form of the old tree is no longer valid.
+  ResetCompile();
+
   // Copy everything from the other tree.
   splitDimension = other.splitDimension;
   dimensionType = other.dimensionType;
@@ -394,6 +400,10 @@ DecisionTreeRegressor<FitnessFunction,
     delete children[i];
   children.clear();
 
+  // Any flattened form of either tree is no longer valid.
+  ResetCompile();
+  other.ResetCompile();
+
   // Take ownership of the other tree's components.
   children = std::move(other.children);
   splitDimension = other.splitDimension;
@@ -625,7 +635,8 @@ double DecisionTreeRegressor<FitnessFunction,
     DimensionSelectionType& dimensionSelector,
     FitnessFunction fitnessFunction)
 {
-  // Clear children if needed.
+  // Clear children, and any flattened form of the tree, if needed.
+  ResetCompile();
   for (size_t i = 0; i < children.size(); ++i)
     delete children[i];
   children.clear();
@@ -806,7 +817,8 @@ double DecisionTreeRegressor<FitnessFunction,
     DimensionSelectionType& dimensionSelector,
     FitnessFunction fitnessFunction)
 {
-  // Clear children if needed.
+  // Clear children, and any flattened form of the tree, if needed.
+  ResetCompile();
   for (size_t i = 0; i < children.size(); ++i)
     delete children[i];
   children.clear();
@@ -980,6 +992,13 @@ void DecisionTreeRegressor<FitnessFunction,
     return;
   }
 
+  // Use the flattened representation, if it has been built.
+  if (!flatChildOffsets.empty())
+  {
+    PredictCompiled(data, predictions);
+    return;
+  }
+
   // Loop over each point.
   for (size_t i = 0; i < data.n_cols; ++i)
     predictions[i] = Predict(data.col(i));
@@ -1006,13 +1025,139 @@ size_t DecisionTreeRegressor<FitnessFunction,
         splitPoint, *this);
 }
 
+//! Flatten the tree into a structure-of-arrays representation.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+void DecisionTreeRegressor<FitnessFunction,
+                           NumericSplitType,
+                           CategoricalSplitType,
+                           DimensionSelectionType,
+                           NoRecursion>::Compile()
+{
+  ResetCompile();
+
+  // Walk the tree in breadth-first order; since all children of a node are
+  // appended at once, the children of every flattened node are contiguous.
+  flatNodes.push_back(this);
+  for (size_t i = 0; i < flatNodes.size(); ++i)
+  {
+    const DecisionTreeRegressor* node = flatNodes[i];
+    if (node->children.size() == 0)
+    {
+      flatSplitDimensions.push_back(0);
+      flatDimensionTypes.push_back(0);
+      flatSplitPoints.push_back(node->prediction);
+      flatChildOffsets.push_back(0); // The root cannot be a child: 0 = leaf.
+    }
+    else
+    {
+      flatSplitDimensions.push_back(node->splitDimension);
+      flatDimensionTypes.push_back(node->dimensionType);
+      flatSplitPoints.push_back(node->splitPoint);
+      flatChildOffsets.push_back(flatNodes.size());
+      for (size_t c = 0; c < node->children.size(); ++c)
+        flatNodes.push_back(node->children[c]);
+    }
+  }
+}
+
+//! Throw away the flattened form of the tree.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+void DecisionTreeRegressor<FitnessFunction,
+                           NumericSplitType,
+                           CategoricalSplitType,
+                           DimensionSelectionType,
+                           NoRecursion>::ResetCompile()
+{
+  flatSplitDimensions.clear();
+  flatDimensionTypes.clear();
+  flatSplitPoints.clear();
+  flatChildOffsets.clear();
+  flatNodes.clear();
+}
+
+//! Predict with the flattened tree representation.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<typename MatType>
+void DecisionTreeRegressor<FitnessFunction,
+                           NumericSplitType,
+                           CategoricalSplitType,
+                           DimensionSelectionType,
+                           NoRecursion>::PredictCompiled(
+    const MatType& data,
+    arma::Row<double>& predictions) const
+{
+  // Points are processed in blocks; all points in a block descend one level
+  // of the tree at a time, so the flat arrays stay hot in cache and the
+  // per-point traversal state is just an index into them.
+  const size_t blockSize = 256;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t blockBegin = 0; blockBegin < (size_t) data.n_cols;
+       blockBegin += blockSize)
+  {
+    const size_t blockEnd = std::min(blockBegin + blockSize,
+        (size_t) data.n_cols);
+
+    // Current flattened node of each point in the block; all start at the
+    // root.
+    size_t nodes[blockSize];
+    for (size_t j = blockBegin; j < blockEnd; ++j)
+      nodes[j - blockBegin] = 0;
+
+    bool anyInternal = true;
+    while (anyInternal)
+    {
+      anyInternal = false;
+      for (size_t j = blockBegin; j < blockEnd; ++j)
+      {
+        const size_t node = nodes[j - blockBegin];
+        if (flatChildOffsets[node] == 0)
+          continue; // The point has already reached a leaf.
+
+        size_t direction;
+        if ((data::Datatype) flatDimensionTypes[node] ==
+            data::Datatype::categorical)
+        {
+          direction = CategoricalSplit::CalculateDirection(
+              data(flatSplitDimensions[node], j), flatSplitPoints[node],
+              *flatNodes[node]);
+        }
+        else
+        {
+          direction = NumericSplit::CalculateDirection(
+              data(flatSplitDimensions[node], j), flatSplitPoints[node],
+              *flatNodes[node]);
+        }
+
+        nodes[j - blockBegin] = flatChildOffsets[node] + direction;
+        anyInternal = true;
+      }
+    }
+
+    // Emit the prediction of each point's leaf.
+    for (size_t j = blockBegin; j < blockEnd; ++j)
+      predictions[j] = flatSplitPoints[nodes[j - blockBegin]];
+  }
+}
+
 //! Serialize the tree.
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
          template<typename> class CategoricalSplitType,
          typename DimensionSelectionType,
          bool NoRecursion>
-template<typename Archive>
 void DecisionTreeRegressor<FitnessFunction,
                            NumericSplitType,
                            CategoricalSplitType,
@@ -1023,6 +1168,7 @@ void DecisionTreeRegressor<FitnessFunction,
   // Clean memory if needed.
   if (cereal::is_loading<Archive>())
   {
+    ResetCompile();
     for (size_t i = 0; i < children.size(); ++i)
       delete children[i];
     children.clear();
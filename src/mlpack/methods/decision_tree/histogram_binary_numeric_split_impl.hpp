@@ -0,0 +1,570 @@
+/**
+ * @file methods/decision_tree/histogram_binary_numeric_split_impl.hpp
+ *
+ * Implementation of the histogram-binned binary numeric split.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_HISTOGRAM_BINARY_NUMERIC_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_HISTOGRAM_BINARY_NUMERIC_SPLIT_IMPL_HPP
+
+namespace mlpack {
+
+// Overload used for classification.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+double HistogramBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& splitInfo,
+    AuxiliarySplitInfo& /* aux */)
+{
+  typedef typename VecType::elem_type ElemType;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Find the range of the dimension; if it is constant, we can't split.
+  ElemType minValue = data[0];
+  ElemType maxValue = data[0];
+  for (size_t i = 1; i < data.n_elem; ++i)
+  {
+    minValue = std::min(minValue, data[i]);
+    maxValue = std::max(maxValue, data[i]);
+  }
+
+  if (minValue == maxValue)
+    return DBL_MAX;
+
+  const double binWidth = (double(maxValue) - double(minValue)) / NumBins;
+
+  // Accumulate per-bin class counts (and weight sums, if needed) in a single
+  // pass; this replaces the O(n log n) sort of BestBinaryNumericSplit.
+  arma::Col<size_t> binSizes(NumBins, arma::fill::zeros);
+  arma::Mat<size_t> binCounts;
+  arma::mat binWeightSums;
+  arma::vec binWeights;
+  double totalWeight = 0.0;
+  if (UseWeights)
+  {
+    binWeightSums.zeros(numClasses, NumBins);
+    binWeights.zeros(NumBins);
+    for (size_t i = 0; i < data.n_elem; ++i)
+    {
+      size_t bin = (size_t) ((double(data[i]) - double(minValue)) / binWidth);
+      if (bin > NumBins - 1)
+        bin = NumBins - 1;
+
+      binWeightSums(labels[i], bin) += weights[i];
+      binWeights[bin] += weights[i];
+      ++binSizes[bin];
+      totalWeight += weights[i];
+    }
+  }
+  else
+  {
+    binCounts.zeros(numClasses, NumBins);
+    for (size_t i = 0; i < data.n_elem; ++i)
+    {
+      size_t bin = (size_t) ((double(data[i]) - double(minValue)) / binWidth);
+      if (bin > NumBins - 1)
+        bin = NumBins - 1;
+
+      ++binCounts(labels[i], bin);
+      ++binSizes[bin];
+    }
+  }
+
+  // Loop through all bin boundaries, choosing the best one.  Also, force a
+  // minimum leaf size of 1 (empty children don't make sense).
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  // Everything starts in the right child.
+  arma::Col<size_t> leftCounts;
+  arma::Col<size_t> rightCounts;
+  arma::vec leftWeightSums;
+  arma::vec rightWeightSums;
+  double totalLeftWeight = 0.0;
+  double totalRightWeight = 0.0;
+  size_t leftSize = 0;
+  size_t rightSize = data.n_elem;
+  if (UseWeights)
+  {
+    leftWeightSums.zeros(numClasses);
+    rightWeightSums = arma::sum(binWeightSums, 1);
+    totalRightWeight = totalWeight;
+    bestFoundGain *= totalWeight;
+  }
+  else
+  {
+    leftCounts.zeros(numClasses);
+    rightCounts = arma::sum(binCounts, 1);
+    bestFoundGain *= data.n_elem;
+  }
+
+  for (size_t bin = 0; bin < NumBins - 1; ++bin)
+  {
+    // Move this bin's statistics from the right child to the left child.
+    if (UseWeights)
+    {
+      leftWeightSums += binWeightSums.col(bin);
+      rightWeightSums -= binWeightSums.col(bin);
+      totalLeftWeight += binWeights[bin];
+      totalRightWeight -= binWeights[bin];
+    }
+    else
+    {
+      leftCounts += binCounts.col(bin);
+      rightCounts -= binCounts.col(bin);
+    }
+    leftSize += binSizes[bin];
+    rightSize -= binSizes[bin];
+
+    // An empty bin gives the same partition as the previous boundary.
+    if (binSizes[bin] == 0)
+      continue;
+
+    // Ensure that the minimum leaf size is respected on both sides.
+    if (leftSize < minimum)
+      continue;
+    if (rightSize < minimum)
+      break;
+
+    // Calculate the gain for the left and right child.  Only use weights if
+    // needed.
+    const double leftGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(leftWeightSums.memptr(),
+            numClasses, totalLeftWeight) :
+        FitnessFunction::template EvaluatePtr<false>(leftCounts.memptr(),
+            numClasses, leftSize);
+    const double rightGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(rightWeightSums.memptr(),
+            numClasses, totalRightWeight) :
+        FitnessFunction::template EvaluatePtr<false>(rightCounts.memptr(),
+            numClasses, rightSize);
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = totalLeftWeight * leftGain + totalRightWeight * rightGain;
+    }
+    else
+    {
+      // Calculate the gain at this boundary.
+      gain = double(leftSize) * leftGain + double(rightSize) * rightGain;
+    }
+
+    // Corner case: is this the best possible split?
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just
+      // take this one.  The split value is the upper boundary of this bin.
+      splitInfo.set_size(1);
+      splitInfo[0] = double(minValue) + (bin + 1) * binWidth;
+
+      return gain;
+    }
+    else if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      splitInfo.set_size(1);
+      splitInfo[0] = double(minValue) + (bin + 1) * binWidth;
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+// Overload used for regression.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename ResponsesType,
+         typename WeightVecType>
+typename std::enable_if<
+    !HasOptimizedBinarySplitForms<FitnessFunction, UseWeights>::value,
+    double>::type
+HistogramBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const ResponsesType& responses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    double& splitInfo,
+    AuxiliarySplitInfo& /* aux */,
+    FitnessFunction& fitnessFunction)
+{
+  typedef typename VecType::elem_type ElemType;
+  typedef typename ResponsesType::elem_type RType;
+  typedef typename WeightVecType::elem_type WType;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Find the range of the dimension; if it is constant, we can't split.
+  ElemType minValue = data[0];
+  ElemType maxValue = data[0];
+  for (size_t i = 1; i < data.n_elem; ++i)
+  {
+    minValue = std::min(minValue, data[i]);
+    maxValue = std::max(maxValue, data[i]);
+  }
+
+  if (minValue == maxValue)
+    return DBL_MAX;
+
+  const double binWidth = (double(maxValue) - double(minValue)) / NumBins;
+
+  // Assign each point to a bin.
+  arma::Col<size_t> binIndices(data.n_elem);
+  arma::Col<size_t> binSizes(NumBins, arma::fill::zeros);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    size_t bin = (size_t) ((double(data[i]) - double(minValue)) / binWidth);
+    if (bin > NumBins - 1)
+      bin = NumBins - 1;
+
+    binIndices[i] = bin;
+    ++binSizes[bin];
+  }
+
+  // Group the responses (and weights) by bin with a counting sort; membership
+  // of the two children only depends on the bin, so this ordering is
+  // sufficient to evaluate the gain at every bin boundary.
+  arma::Col<size_t> binStarts(NumBins);
+  size_t cumulative = 0;
+  for (size_t bin = 0; bin < NumBins; ++bin)
+  {
+    binStarts[bin] = cumulative;
+    cumulative += binSizes[bin];
+  }
+
+  arma::Row<RType> sortedResponses(responses.n_elem);
+  arma::Row<WType> sortedWeights;
+  if (UseWeights)
+    sortedWeights.set_size(responses.n_elem);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const size_t pos = binStarts[binIndices[i]]++;
+    sortedResponses[pos] = responses[i];
+    if (UseWeights)
+      sortedWeights[pos] = weights[i];
+  }
+
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  WType totalWeight = 0.0;
+  WType totalLeftWeight = 0.0;
+  WType totalRightWeight = 0.0;
+
+  if (UseWeights)
+  {
+    totalWeight = arma::accu(sortedWeights);
+    totalRightWeight = totalWeight;
+    bestFoundGain *= totalWeight;
+  }
+  else
+  {
+    bestFoundGain *= data.n_elem;
+  }
+
+  // Loop through all bin boundaries, choosing the best one.
+  size_t index = 0;
+  for (size_t bin = 0; bin < NumBins - 1; ++bin)
+  {
+    if (UseWeights)
+    {
+      for (size_t i = index; i < index + binSizes[bin]; ++i)
+      {
+        totalLeftWeight += sortedWeights[i];
+        totalRightWeight -= sortedWeights[i];
+      }
+    }
+    index += binSizes[bin];
+
+    // An empty bin gives the same partition as the previous boundary.
+    if (binSizes[bin] == 0)
+      continue;
+
+    // Ensure that the minimum leaf size is respected on both sides.
+    if (index < minimum)
+      continue;
+    if (data.n_elem - index < minimum)
+      break;
+
+    // Calculate the gain for the left and right child.
+    const double leftGain = fitnessFunction.template
+        Evaluate<UseWeights>(sortedResponses, sortedWeights, 0, index);
+    const double rightGain = fitnessFunction.template
+        Evaluate<UseWeights>(sortedResponses, sortedWeights, index,
+            responses.n_elem);
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = totalLeftWeight * leftGain + totalRightWeight * rightGain;
+    }
+    else
+    {
+      // Calculate the gain at this boundary.
+      gain = double(index) * leftGain +
+          double(responses.n_elem - index) * rightGain;
+    }
+
+    // Corner case: is this the best possible split?
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just
+      // take this one.  The split value is the upper boundary of this bin.
+      splitInfo = double(minValue) + (bin + 1) * binWidth;
+
+      return gain;
+    }
+    if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      splitInfo = double(minValue) + (bin + 1) * binWidth;
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+// Optimized version for any fitness function that implements
+// BinaryScanInitialize(), BinaryStep() and BinaryGains() functions.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename ResponsesType,
+         typename WeightVecType>
+typename std::enable_if<
+    HasOptimizedBinarySplitForms<FitnessFunction, UseWeights>::value,
+    double>::type
+HistogramBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const ResponsesType& responses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    double& splitInfo,
+    AuxiliarySplitInfo& /* aux */,
+    FitnessFunction& fitnessFunction)
+{
+  typedef typename VecType::elem_type ElemType;
+  typedef typename ResponsesType::elem_type RType;
+  typedef typename WeightVecType::elem_type WType;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Find the range of the dimension; if it is constant, we can't split.
+  ElemType minValue = data[0];
+  ElemType maxValue = data[0];
+  for (size_t i = 1; i < data.n_elem; ++i)
+  {
+    minValue = std::min(minValue, data[i]);
+    maxValue = std::max(maxValue, data[i]);
+  }
+
+  if (minValue == maxValue)
+    return DBL_MAX;
+
+  const double binWidth = (double(maxValue) - double(minValue)) / NumBins;
+
+  // Assign each point to a bin.
+  arma::Col<size_t> binIndices(data.n_elem);
+  arma::Col<size_t> binSizes(NumBins, arma::fill::zeros);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    size_t bin = (size_t) ((double(data[i]) - double(minValue)) / binWidth);
+    if (bin > NumBins - 1)
+      bin = NumBins - 1;
+
+    binIndices[i] = bin;
+    ++binSizes[bin];
+  }
+
+  // Group the responses (and weights) by bin with a counting sort, and record
+  // at which index each bin boundary falls.  'boundaryBins[i]' holds the bin
+  // whose upper boundary splits the grouped points into [0, i) and [i, n), or
+  // NumBins if index i is not a bin boundary.
+  arma::Col<size_t> binStarts(NumBins);
+  arma::Col<size_t> boundaryBins(data.n_elem + 1);
+  boundaryBins.fill(NumBins);
+  size_t cumulative = 0;
+  for (size_t bin = 0; bin < NumBins; ++bin)
+  {
+    binStarts[bin] = cumulative;
+    cumulative += binSizes[bin];
+    if (bin < NumBins - 1 && binSizes[bin] > 0)
+      boundaryBins[cumulative] = bin;
+  }
+
+  arma::Row<RType> sortedResponses(responses.n_elem);
+  arma::Row<WType> sortedWeights;
+  if (UseWeights)
+    sortedWeights.set_size(responses.n_elem);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const size_t pos = binStarts[binIndices[i]]++;
+    sortedResponses[pos] = responses[i];
+    if (UseWeights)
+      sortedWeights[pos] = weights[i];
+  }
+
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  WType totalWeight = 0.0;
+  WType leftChildWeight = 0.0;
+  WType rightChildWeight = 0.0;
+
+  if (UseWeights)
+  {
+    totalWeight = arma::accu(sortedWeights);
+    bestFoundGain *= totalWeight;
+
+    for (size_t i = 0; i < minimum - 1; ++i)
+      leftChildWeight += sortedWeights[i];
+
+    for (size_t i = minimum - 1; i < data.n_elem; ++i)
+      rightChildWeight += sortedWeights[i];
+  }
+  else
+  {
+    bestFoundGain *= data.n_elem;
+  }
+
+  // Initialize and precompute various statistics to efficiently compute gain
+  // values for all possible splits.
+  fitnessFunction.template BinaryScanInitialize<UseWeights>(sortedResponses,
+      sortedWeights, minimum);
+
+  // Step through the grouped points, but only evaluate the gain at bin
+  // boundaries.
+  for (size_t index = minimum; index < data.n_elem - minimum + 1; ++index)
+  {
+    if (UseWeights)
+    {
+      leftChildWeight += sortedWeights[index - 1];
+      rightChildWeight -= sortedWeights[index - 1];
+    }
+
+    // Steps through the current index and updates the cached data.
+    fitnessFunction.template BinaryStep<UseWeights>(sortedResponses,
+        sortedWeights, index - 1);
+
+    // Only bin boundaries are candidate splits.
+    if (boundaryBins[index] == NumBins)
+      continue;
+
+    // Calculate the gain for the left and right child.
+    std::tuple<double, double> binaryGains = fitnessFunction.BinaryGains();
+    const double leftGain = std::get<0>(binaryGains);
+    const double rightGain = std::get<1>(binaryGains);
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = leftChildWeight * leftGain + rightChildWeight * rightGain;
+    }
+    else
+    {
+      // Calculate the gain at this boundary.
+      gain = double(index) * leftGain +
+          double(sortedResponses.n_elem - index) * rightGain;
+    }
+
+    // Corner case: is this the best possible split?
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just
+      // take this one.  The split value is the upper boundary of this bin.
+      splitInfo = double(minValue) + (boundaryBins[index] + 1) * binWidth;
+
+      return gain;
+    }
+    if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      splitInfo = double(minValue) + (boundaryBins[index] + 1) * binWidth;
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+template<typename FitnessFunction>
+template<typename ElemType>
+size_t HistogramBinaryNumericSplit<FitnessFunction>::CalculateDirection(
+    const ElemType& point,
+    const double& splitInfo,
+    const AuxiliarySplitInfo& /* aux */)
+{
+  if (point <= splitInfo)
+    return 0; // Go left.
+  else
+    return 1; // Go right.
+}
+
+} // namespace mlpack
+
+#endif
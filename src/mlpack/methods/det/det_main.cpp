@@ -179,9 +179,12 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     // Compute training set estimates, if desired.
     if (params.Has("training_set_estimates"))
     {
-      // Compute density estimates for each point in the training set.
+      // Compute density estimates for each point in the training set.  The
+      // points are scored independently, so the loop is dispatched across
+      // threads.
       arma::rowvec trainingDensities(trainingData.n_cols);
       timers.Start("det_estimation_time");
+      #pragma omp parallel for schedule(dynamic)
       for (size_t i = 0; i < trainingData.n_cols; ++i)
         trainingDensities[i] = tree->ComputeValue(trainingData.unsafe_col(i));
       timers.Stop("det_estimation_time");
@@ -202,10 +205,12 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     testData = std::move(params.Get<arma::mat>("test"));
     if (params.Has("test_set_estimates"))
     {
-      // Compute test set densities.
+      // Compute test set densities.  The points are scored independently, so
+      // the loop is dispatched across threads.
       timers.Start("det_test_set_estimation");
       arma::rowvec testDensities(testData.n_cols);
 
+      #pragma omp parallel for schedule(dynamic)
       for (size_t i = 0; i < testData.n_cols; ++i)
         testDensities[i] = tree->ComputeValue(testData.unsafe_col(i));
 
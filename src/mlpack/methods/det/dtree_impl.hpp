@@ -484,13 +484,32 @@ bool DTree<MatType, TagType>::FindSplit(const MatType& data,
     std::vector<SplitItem> splitVec;
     ExtractSplits<ElemType>(splitVec, data, dim, start, end, minLeafSize);
 
-    // Iterate on all the splits for this dimension
-    for (typename std::vector<SplitItem>::iterator i = splitVec.begin();
-         i != splitVec.end();
-         ++i)
+    // Unpack the candidate splits so that the error terms of all of them can
+    // be computed with vectorized expressions; the selection scan below then
+    // only compares precomputed values.
+    arma::vec splitVals(splitVec.size());
+    arma::vec splitPositions(splitVec.size());
+    for (size_t j = 0; j < splitVec.size(); ++j)
     {
-      const ElemType split = i->first;
-      const size_t position = i->second;
+      splitVals[j] = (double) splitVec[j].first;
+      splitPositions[j] = (double) splitVec[j].second;
+    }
+
+    // Now we have to see if the error will be reduced.  Simple manipulation
+    // of the error function gives us the condition we must satisfy:
+    //   |t_l|^2 / V_l + |t_r|^2 / V_r  >= |t|^2 / (V_l + V_r)
+    // and because the volume is only dependent on the dimension we are
+    // splitting, we can assume V_l is just the range of the left and V_r is
+    // just the range of the right.
+    const arma::vec negLeftErrors =
+        arma::square(splitPositions) / (splitVals - min);
+    const arma::vec negRightErrors =
+        arma::square((double) points - splitPositions) / (max - splitVals);
+
+    // Iterate on all the splits for this dimension.
+    for (size_t j = 0; j < splitVec.size(); ++j)
+    {
+      const ElemType split = splitVec[j].first;
 
       // Another way of picking split is using this:
       //   split = leftsplit;
@@ -498,23 +517,14 @@ bool DTree<MatType, TagType>::FindSplit(const MatType& data,
       {
         // Ensure that the right node will have at least the minimum number of
         // points.
-        Log::Assert((points - position) >= minLeafSize);
-
-        // Now we have to see if the error will be reduced.  Simple manipulation
-        // of the error function gives us the condition we must satisfy:
-        //   |t_l|^2 / V_l + |t_r|^2 / V_r  >= |t|^2 / (V_l + V_r)
-        // and because the volume is only dependent on the dimension we are
-        // splitting, we can assume V_l is just the range of the left and V_r is
-        // just the range of the right.
-        double negLeftError = std::pow(position, 2.0) / (split - min);
-        double negRightError = std::pow(points - position, 2.0) / (max - split);
+        Log::Assert((points - splitVec[j].second) >= minLeafSize);
 
         // If this is better, take it.
-        if ((negLeftError + negRightError) >= minDimError)
+        if ((negLeftErrors[j] + negRightErrors[j]) >= minDimError)
         {
-          minDimError = negLeftError + negRightError;
-          dimLeftError = negLeftError;
-          dimRightError = negRightError;
+          minDimError = negLeftErrors[j] + negRightErrors[j];
+          dimLeftError = negLeftErrors[j];
+          dimRightError = negRightErrors[j];
           dimSplitValue = split;
           dimSplitFound = true;
         }
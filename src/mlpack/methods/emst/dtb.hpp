@@ -32,6 +32,26 @@
 
 namespace mlpack {
 
+/**
+ * Utility struct to detect, at compile time, whether a tree type provides a
+ * ParallelDualTreeTraverser for the given rule set.  Only some tree types
+ * (e.g. BinarySpaceTree) have one; DualTreeBoruvka falls back to the serial
+ * DualTreeTraverser for the rest.
+ */
+template<typename TreeType, typename RuleType>
+struct HasParallelDualTreeTraverser
+{
+ private:
+  template<typename T>
+  static std::true_type
+      Check(typename T::template ParallelDualTreeTraverser<RuleType>*);
+  template<typename T>
+  static std::false_type Check(...);
+
+ public:
+  static const bool value = decltype(Check<TreeType>(0))::value;
+};
+
 /**
  * Performs the MST calculation using the Dual-Tree Boruvka algorithm, using any
  * type of tree.
@@ -171,7 +191,55 @@ class DualTreeBoruvka
    */
   void ComputeMST(arma::mat& results);
 
+  /**
+   * Compute the MST and convert it into a single-linkage dendrogram.  The
+   * output is a 4 x (N - 1) linkage matrix; column i describes the i'th
+   * merge (in order of increasing height).  The first two rows hold the
+   * indices of the two clusters being merged: the original points are
+   * clusters 0 through N - 1, and the cluster formed by merge i gets index
+   * N + i.  The third row holds the merge height (the length of the MST
+   * edge), and the fourth row holds the number of points in the new cluster.
+   * This is the transpose of a SciPy linkage matrix, so `linkage.t()` can be
+   * passed straight to scipy.cluster.hierarchy routines.
+   *
+   * Since the MST edge list is already sorted by length, the dendrogram is
+   * assembled in a single union-find pass over the edges.
+   *
+   * @param linkage Matrix to store the linkage matrix in.
+   */
+  void ComputeLinkage(arma::mat& linkage);
+
+  /**
+   * Extract a flat clustering from a linkage matrix produced by
+   * ComputeLinkage() by cutting the dendrogram at the given height: every
+   * merge at a height less than or equal to the cut is applied, and each
+   * resulting cluster gets a label.  Labels are assigned in order of the
+   * lowest point index in each cluster, so they are deterministic.
+   *
+   * @param linkage Linkage matrix produced by ComputeLinkage().
+   * @param height Height to cut the dendrogram at.
+   * @param assignments Vector to store the cluster label of each point in.
+   */
+  static void ClusterAtHeight(const arma::mat& linkage,
+                              const double height,
+                              arma::Row<size_t>& assignments);
+
  private:
+  /**
+   * Run one round of the nearest-neighbor search with the tree's parallel
+   * dual-tree traverser.  This overload is selected when the tree type
+   * provides one.
+   */
+  template<typename RuleType>
+  void SearchRound(RuleType& rules, const std::true_type& /* parallel */);
+
+  /**
+   * Run one round of the nearest-neighbor search with the regular serial
+   * dual-tree traverser.
+   */
+  template<typename RuleType>
+  void SearchRound(RuleType& rules, const std::false_type& /* parallel */);
+
   /**
    * Adds a single edge to the edge list
    */
@@ -99,23 +99,50 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
   totalDist = 0; // Reset distance.
 
   typedef DTBRules<MetricType, Tree> RuleType;
-  RuleType rules(data, connections, neighborsDistances, neighborsInComponent,
-                 neighborsOutComponent, metric);
+  arma::Col<size_t> componentOf(data.n_cols);
+  size_t totalBaseCases = 0;
+  size_t totalScores = 0;
   while (edges.size() < (data.n_cols - 1))
   {
+    // Snapshot the component of each point, so that the search phase does not
+    // need to query (and path-compress) the UnionFind structure; components
+    // cannot change during a round, and this makes the traversal safe to run
+    // in parallel.
+    for (size_t i = 0; i < data.n_cols; ++i)
+      componentOf[i] = connections.Find(i);
+
+    RuleType rules(data, componentOf, metric);
     if (naive)
     {
-      // Full O(N^2) traversal.
-      for (size_t i = 0; i < data.n_cols; ++i)
-        for (size_t j = 0; j < data.n_cols; ++j)
-          rules.BaseCase(i, j);
+      // Full O(N^2) traversal; each thread collects candidate edges in its
+      // own copy of the rules, and the copies are merged afterwards.
+      #pragma omp parallel
+      {
+        RuleType threadRules(rules);
+
+        #pragma omp for
+        for (size_t i = 0; i < (size_t) data.n_cols; ++i)
+          for (size_t j = 0; j < data.n_cols; ++j)
+            threadRules.BaseCase(i, j);
+
+        #pragma omp critical
+        rules.Merge(threadRules);
+      }
     }
     else
     {
-      typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
-      traverser.Traverse(*tree, *tree);
+      SearchRound(rules, std::integral_constant<bool,
+          HasParallelDualTreeTraverser<Tree, RuleType>::value>());
     }
 
+    // Copy the candidate edges out of the rules; AddAllEdges() merges the
+    // components serially, which is cheap compared to the search.
+    neighborsDistances = rules.NeighborsDistances();
+    neighborsInComponent = rules.NeighborsInComponent();
+    neighborsOutComponent = rules.NeighborsOutComponent();
+    totalBaseCases += rules.BaseCases();
+    totalScores += rules.Scores();
+
     AddAllEdges();
 
     Cleanup();
@@ -123,8 +150,8 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
     Log::Info << edges.size() << " edges found so far." << std::endl;
     if (!naive)
     {
-      Log::Info << rules.BaseCases() << " cumulative base cases." << std::endl;
-      Log::Info << rules.Scores() << " cumulative node combinations scored."
+      Log::Info << totalBaseCases << " cumulative base cases." << std::endl;
+      Log::Info << totalScores << " cumulative node combinations scored."
           << std::endl;
     }
   }
@@ -134,6 +161,138 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
   Log::Info << "Total spanning tree length: " << totalDist << std::endl;
 }
 
+template<
+    typename MetricType,
+    typename MatType,
+    template<typename TreeMetricType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+template<typename RuleType>
+void DualTreeBoruvka<MetricType, MatType, TreeType>::SearchRound(
+    RuleType& rules,
+    const std::true_type& /* parallel */)
+{
+  typename Tree::template ParallelDualTreeTraverser<RuleType> traverser(rules);
+  traverser.Traverse(*tree, *tree);
+}
+
+template<
+    typename MetricType,
+    typename MatType,
+    template<typename TreeMetricType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+template<typename RuleType>
+void DualTreeBoruvka<MetricType, MatType, TreeType>::SearchRound(
+    RuleType& rules,
+    const std::false_type& /* parallel */)
+{
+  typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+  traverser.Traverse(*tree, *tree);
+}
+
+/**
+ * Compute the MST and convert it into a single-linkage dendrogram.
+ */
+template<
+    typename MetricType,
+    typename MatType,
+    template<typename TreeMetricType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeLinkage(
+    arma::mat& linkage)
+{
+  arma::mat results;
+  ComputeMST(results); // The edge list comes out sorted by length.
+
+  const size_t n = results.n_cols + 1;
+  linkage.set_size(4, n - 1);
+
+  // Replay the edges in order of increasing length.  Each point starts as its
+  // own cluster (with its own index); the cluster formed by merge i gets
+  // index n + i, which is tracked per union-find component.
+  UnionFind mergeTracker(n);
+  arma::Col<size_t> clusterId = arma::regspace<arma::Col<size_t>>(0, n - 1);
+  arma::Col<size_t> clusterSize(2 * n - 1);
+  clusterSize.head(n).ones();
+
+  for (size_t i = 0; i < n - 1; ++i)
+  {
+    const size_t u = (size_t) results(0, i);
+    const size_t v = (size_t) results(1, i);
+    // MST edges always join two distinct components, so no check is needed.
+    const size_t a = clusterId[mergeTracker.Find(u)];
+    const size_t b = clusterId[mergeTracker.Find(v)];
+
+    linkage(0, i) = std::min(a, b);
+    linkage(1, i) = std::max(a, b);
+    linkage(2, i) = results(2, i);
+    clusterSize[n + i] = clusterSize[a] + clusterSize[b];
+    linkage(3, i) = clusterSize[n + i];
+
+    mergeTracker.Union(u, v);
+    clusterId[mergeTracker.Find(u)] = n + i;
+  }
+}
+
+/**
+ * Cut a dendrogram at the given height and emit a flat clustering.
+ */
+template<
+    typename MetricType,
+    typename MatType,
+    template<typename TreeMetricType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+void DualTreeBoruvka<MetricType, MatType, TreeType>::ClusterAtHeight(
+    const arma::mat& linkage,
+    const double height,
+    arma::Row<size_t>& assignments)
+{
+  if (linkage.n_rows != 4)
+  {
+    throw std::invalid_argument("DualTreeBoruvka::ClusterAtHeight(): linkage "
+        "matrix must have 4 rows (as produced by ComputeLinkage())!");
+  }
+
+  const size_t n = linkage.n_cols + 1;
+
+  // Each dendrogram cluster is represented by one of its points, so the
+  // merges can be replayed on a point-level union-find.  Original points
+  // represent themselves; the cluster formed by merge i is represented by the
+  // representative of its first child.
+  UnionFind uf(n);
+  arma::Col<size_t> representative(2 * n - 1);
+  representative.head(n) = arma::regspace<arma::Col<size_t>>(0, n - 1);
+
+  for (size_t i = 0; i < n - 1; ++i)
+  {
+    const size_t repA = representative[(size_t) linkage(0, i)];
+    representative[n + i] = repA;
+
+    // Merges are sorted by height, so once one is above the cut, all
+    // remaining ones are too; but the representatives must still be filled
+    // in, so the loop cannot simply stop.
+    if (linkage(2, i) <= height)
+      uf.Union(repA, representative[(size_t) linkage(1, i)]);
+  }
+
+  // Relabel the components consecutively, in order of the lowest point index
+  // in each cluster.
+  assignments.set_size(n);
+  arma::Col<size_t> label(n);
+  label.fill(n); // Invalid label, meaning "component not seen yet".
+  size_t numClusters = 0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    const size_t root = uf.Find(i);
+    if (label[root] == n)
+      label[root] = numClusters++;
+    assignments[i] = label[root];
+  }
+}
+
 /**
  * Adds a single edge to the edge list
  */
@@ -22,11 +22,19 @@ template<typename MetricType, typename TreeType>
 class DTBRules
 {
  public:
+  /**
+   * Construct the rule set for one round of the Boruvka search.  The rules
+   * hold their own candidate edge for each component, so several copies can
+   * traverse disjoint parts of the tree concurrently and be combined with
+   * Merge() afterwards.
+   *
+   * @param dataSet The data points.
+   * @param componentOf The component each point belongs to; this must not
+   *      change for the duration of the traversal.
+   * @param metric Instantiated metric.
+   */
   DTBRules(const arma::mat& dataSet,
-           UnionFind& connections,
-           arma::vec& neighborsDistances,
-           arma::Col<size_t>& neighborsInComponent,
-           arma::Col<size_t>& neighborsOutComponent,
+           const arma::Col<size_t>& componentOf,
            MetricType& metric);
 
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
@@ -96,23 +104,44 @@ class DTBRules
   //! Modify the number of node combinations that have been scored.
   size_t& Scores() { return scores; }
 
+  //! Get the distance to the candidate nearest neighbor for each component.
+  const arma::vec& NeighborsDistances() const { return neighborsDistances; }
+  //! Get the in-component endpoint of the candidate edge for each component.
+  const arma::Col<size_t>& NeighborsInComponent() const
+  { return neighborsInComponent; }
+  //! Get the out-of-component endpoint of the candidate edge for each
+  //! component.
+  const arma::Col<size_t>& NeighborsOutComponent() const
+  { return neighborsOutComponent; }
+
+  /**
+   * Merge the results found by another rule set into this one, keeping the
+   * shorter candidate edge for each component and accumulating the base case
+   * and score counts.  This is used after a parallel traversal, where each
+   * thread traverses with its own copy of the rules.
+   *
+   * @param other Rule set to merge results from.
+   */
+  void Merge(const DTBRules& other);
+
  private:
   //! The data points.
   const arma::mat& dataSet;
 
-  //! Stores the tree structure so far
-  UnionFind& connections;
+  //! The component each point belongs to; fixed for the duration of the
+  //! traversal.
+  const arma::Col<size_t>& componentOf;
 
   //! The distance to the candidate nearest neighbor for each component.
-  arma::vec& neighborsDistances;
+  arma::vec neighborsDistances;
 
   //! The index of the point in the component that is an endpoint of the
   //! candidate edge.
-  arma::Col<size_t>& neighborsInComponent;
+  arma::Col<size_t> neighborsInComponent;
 
   //! The index of the point outside of the component that is an endpoint
   //! of the candidate edge.
-  arma::Col<size_t>& neighborsOutComponent;
+  arma::Col<size_t> neighborsOutComponent;
 
   //! The instantiated metric.
   MetricType& metric;
@@ -17,22 +17,19 @@ namespace mlpack {
 template<typename MetricType, typename TreeType>
 DTBRules<MetricType, TreeType>::
 DTBRules(const arma::mat& dataSet,
-         UnionFind& connections,
-         arma::vec& neighborsDistances,
-         arma::Col<size_t>& neighborsInComponent,
-         arma::Col<size_t>& neighborsOutComponent,
+         const arma::Col<size_t>& componentOf,
          MetricType& metric)
 :
   dataSet(dataSet),
-  connections(connections),
-  neighborsDistances(neighborsDistances),
-  neighborsInComponent(neighborsInComponent),
-  neighborsOutComponent(neighborsOutComponent),
+  componentOf(componentOf),
+  neighborsDistances(dataSet.n_cols),
+  neighborsInComponent(dataSet.n_cols),
+  neighborsOutComponent(dataSet.n_cols),
   metric(metric),
   baseCases(0),
   scores(0)
 {
-  // Nothing else to do.
+  neighborsDistances.fill(DBL_MAX);
 }
 
 template<typename MetricType, typename TreeType>
@@ -46,9 +43,9 @@ double DTBRules<MetricType, TreeType>::BaseCase(const size_t queryIndex,
   double newUpperBound = -1.0;
 
   // Find the index of the component the query is in.
-  size_t queryComponentIndex = connections.Find(queryIndex);
+  size_t queryComponentIndex = componentOf[queryIndex];
 
-  size_t referenceComponentIndex = connections.Find(referenceIndex);
+  size_t referenceComponentIndex = componentOf[referenceIndex];
 
   if (queryComponentIndex != referenceComponentIndex)
   {
@@ -78,7 +75,7 @@ template<typename MetricType, typename TreeType>
 double DTBRules<MetricType, TreeType>::Score(const size_t queryIndex,
                                              TreeType& referenceNode)
 {
-  size_t queryComponentIndex = connections.Find(queryIndex);
+  size_t queryComponentIndex = componentOf[queryIndex];
 
   // If the query belongs to the same component as all of the references,
   // then prune.  The cast is to stop a warning about comparing unsigned to
@@ -103,10 +100,27 @@ double DTBRules<MetricType, TreeType>::Rescore(const size_t queryIndex,
 {
   // We don't need to check component membership again, because it can't
   // change inside a single iteration.
-  return (oldScore > neighborsDistances[connections.Find(queryIndex)])
+  return (oldScore > neighborsDistances[componentOf[queryIndex]])
       ? DBL_MAX : oldScore;
 }
 
+template<typename MetricType, typename TreeType>
+void DTBRules<MetricType, TreeType>::Merge(const DTBRules& other)
+{
+  for (size_t i = 0; i < neighborsDistances.n_elem; ++i)
+  {
+    if (other.neighborsDistances[i] < neighborsDistances[i])
+    {
+      neighborsDistances[i] = other.neighborsDistances[i];
+      neighborsInComponent[i] = other.neighborsInComponent[i];
+      neighborsOutComponent[i] = other.neighborsOutComponent[i];
+    }
+  }
+
+  baseCases += other.baseCases;
+  scores += other.scores;
+}
+
 template<typename MetricType, typename TreeType>
 double DTBRules<MetricType, TreeType>::Score(TreeType& queryNode,
                                              TreeType& referenceNode)
@@ -151,7 +165,7 @@ inline double DTBRules<MetricType, TreeType>::CalculateBound(
   // Now, find the best and worst point bounds.
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const size_t pointComponent = connections.Find(queryNode.Point(i));
+    const size_t pointComponent = componentOf[queryNode.Point(i)];
     const double bound = neighborsDistances[pointComponent];
 
     if (bound > worstPointBound)
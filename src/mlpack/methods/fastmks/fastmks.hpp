@@ -322,6 +322,37 @@ class FastMKS
   //! The instantiated inner-product metric induced by the given kernel.
   IPMetric<KernelType> metric;
 
+  /**
+   * Perform naive (brute-force) search with a kernel that is a function of
+   * the dot product only.  All dot products between a block of query points
+   * and a block of reference points are computed with a single matrix
+   * multiplication, so the bulk of the work is done by BLAS-3 instead of one
+   * dot product at a time; query blocks are processed in parallel with
+   * OpenMP.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of max-kernel candidates to search for.
+   * @param indices Matrix to store indices of max-kernel candidates in.
+   * @param kernels Matrix to store kernel values of candidates in.
+   * @param sameSet If true, the query set is the reference set, and a query
+   *      point will not be returned as its own candidate.
+   */
+  void NaiveSearch(const MatType& querySet,
+                   const size_t k,
+                   arma::Mat<size_t>& indices,
+                   arma::mat& kernels,
+                   const bool sameSet,
+                   std::true_type /* isDotProductBased */);
+
+  //! Perform naive (brute-force) search with a generic kernel, one point pair
+  //! at a time.  Query points are processed in parallel with OpenMP.
+  void NaiveSearch(const MatType& querySet,
+                   const size_t k,
+                   arma::Mat<size_t>& indices,
+                   arma::mat& kernels,
+                   const bool sameSet,
+                   std::false_type /* isDotProductBased */);
+
   //! Candidate represents a possible candidate point (value, index).
   typedef std::pair<double, size_t> Candidate;
 
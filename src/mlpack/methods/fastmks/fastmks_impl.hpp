@@ -401,6 +401,135 @@ void FastMKS<KernelType, MatType, TreeType>::Train(Tree* tree)
   this->treeOwner = true;
 }
 
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void FastMKS<KernelType, MatType, TreeType>::NaiveSearch(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& indices,
+    arma::mat& kernels,
+    const bool sameSet,
+    std::true_type /* isDotProductBased */)
+{
+  // Process a block of query points against a block of reference points at a
+  // time.  All dot products between the two blocks are a single matrix
+  // product, so the bulk of the work is done by BLAS-3 instead of one dot
+  // product at a time; the kernel value is then computed from each dot
+  // product with EvaluateDot().
+  const size_t queryBlockSize = 64;
+  const size_t refBlockSize = 1024;
+
+  // Each block of query points is completely independent of the others: each
+  // writes only its own candidate heaps and its own columns of the results.
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t qBegin = 0; qBegin < (size_t) querySet.n_cols;
+      qBegin += queryBlockSize)
+  {
+    const size_t qEnd = std::min(qBegin + queryBlockSize,
+        (size_t) querySet.n_cols);
+
+    // Build a candidate min-heap for each query point in the block.
+    const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
+    std::vector<Candidate> pqueue(k, def);
+    std::make_heap(pqueue.begin(), pqueue.end(), CandidateCmp());
+    std::vector<std::vector<Candidate>> heaps(qEnd - qBegin, pqueue);
+
+    for (size_t rBegin = 0; rBegin < (size_t) referenceSet->n_cols;
+        rBegin += refBlockSize)
+    {
+      const size_t rEnd = std::min(rBegin + refBlockSize,
+          (size_t) referenceSet->n_cols);
+
+      // Compute all dot products between the two blocks at once.
+      const arma::mat dots = trans(referenceSet->cols(rBegin, rEnd - 1)) *
+          querySet.cols(qBegin, qEnd - 1);
+
+      for (size_t q = qBegin; q < qEnd; ++q)
+      {
+        std::vector<Candidate>& heap = heaps[q - qBegin];
+        for (size_t r = rBegin; r < rEnd; ++r)
+        {
+          if (sameSet && (q == r))
+            continue; // Don't return the point as its own candidate.
+
+          const double eval = metric.Kernel().EvaluateDot(
+              dots(r - rBegin, q - qBegin));
+
+          if (eval > heap.front().first)
+          {
+            std::pop_heap(heap.begin(), heap.end(), CandidateCmp());
+            heap.back() = std::make_pair(eval, r);
+            std::push_heap(heap.begin(), heap.end(), CandidateCmp());
+          }
+        }
+      }
+    }
+
+    // Sort each heap and store the results for this block.
+    for (size_t q = qBegin; q < qEnd; ++q)
+    {
+      std::vector<Candidate>& heap = heaps[q - qBegin];
+      std::sort_heap(heap.begin(), heap.end(), CandidateCmp());
+      for (size_t j = 0; j < k; ++j)
+      {
+        indices(j, q) = heap[j].second;
+        kernels(j, q) = heap[j].first;
+      }
+    }
+  }
+}
+
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void FastMKS<KernelType, MatType, TreeType>::NaiveSearch(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& indices,
+    arma::mat& kernels,
+    const bool sameSet,
+    std::false_type /* isDotProductBased */)
+{
+  // Simple double loop.  Stupid, slow, but a good benchmark.  Each query
+  // point only touches its own candidate list and its own columns of the
+  // results, so the queries are processed in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t q = 0; q < (size_t) querySet.n_cols; ++q)
+  {
+    const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
+    std::vector<Candidate> cList(k, def);
+    CandidateList pqueue(CandidateCmp(), std::move(cList));
+
+    for (size_t r = 0; r < referenceSet->n_cols; ++r)
+    {
+      if (sameSet && (q == r))
+        continue; // Don't return the point as its own candidate.
+
+      const double eval = metric.Kernel().Evaluate(querySet.col(q),
+                                                   referenceSet->col(r));
+
+      if (eval > pqueue.top().first)
+      {
+        Candidate c = std::make_pair(eval, r);
+        pqueue.pop();
+        pqueue.push(c);
+      }
+    }
+
+    for (size_t j = 1; j <= k; ++j)
+    {
+      indices(k - j, q) = pqueue.top().second;
+      kernels(k - j, q) = pqueue.top().first;
+      pqueue.pop();
+    }
+  }
+}
+
 template<typename KernelType,
          typename MatType,
          template<typename TreeMetricType,
@@ -433,36 +562,14 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   indices.set_size(k, querySet.n_cols);
   kernels.set_size(k, querySet.n_cols);
 
-  // Naive implementation.
+  // Naive implementation.  At compile time, dispatch to the blocked
+  // implementation if the kernel can be evaluated from a precomputed dot
+  // product.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < querySet.n_cols; ++q)
-    {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
-      std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
-
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
-      {
-        const double eval = metric.Kernel().Evaluate(querySet.col(q),
-                                                     referenceSet->col(r));
-
-        if (eval > pqueue.top().first)
-        {
-          Candidate c = std::make_pair(eval, r);
-          pqueue.pop();
-          pqueue.push(c);
-        }
-      }
-
-      for (size_t j = 1; j <= k; ++j)
-      {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
-        pqueue.pop();
-      }
-    }
+    NaiveSearch(querySet, k, indices, kernels, false,
+        std::integral_constant<bool,
+            KernelTraits<KernelType>::IsDotProductBased>());
 
     return;
   }
@@ -560,39 +667,14 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   indices.set_size(k, referenceSet->n_cols);
   kernels.set_size(k, referenceSet->n_cols);
 
-  // Naive implementation.
+  // Naive implementation.  At compile time, dispatch to the blocked
+  // implementation if the kernel can be evaluated from a precomputed dot
+  // product.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < referenceSet->n_cols; ++q)
-    {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
-      std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
-
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
-      {
-        if (q == r)
-          continue; // Don't return the point as its own candidate.
-
-        const double eval = metric.Kernel().Evaluate(referenceSet->col(q),
-                                                     referenceSet->col(r));
-
-        if (eval > pqueue.top().first)
-        {
-          Candidate c = std::make_pair(eval, r);
-          pqueue.pop();
-          pqueue.push(c);
-        }
-      }
-
-      for (size_t j = 1; j <= k; ++j)
-      {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
-        pqueue.pop();
-      }
-    }
+    NaiveSearch(*referenceSet, k, indices, kernels, true,
+        std::integral_constant<bool,
+            KernelTraits<KernelType>::IsDotProductBased>());
 
     return;
   }
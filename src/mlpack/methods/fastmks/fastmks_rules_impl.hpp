@@ -33,14 +33,17 @@ FastMKSRules<KernelType, TreeType>::FastMKSRules(
     baseCases(0),
     scores(0)
 {
-  // Precompute each self-kernel.
+  // Precompute each self-kernel.  Each element is independent, so the loops
+  // can be parallelized.
   queryKernels.set_size(querySet.n_cols);
-  for (size_t i = 0; i < querySet.n_cols; ++i)
+  #pragma omp parallel for
+  for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
     queryKernels[i] = sqrt(kernel.Evaluate(querySet.col(i),
                                            querySet.col(i)));
 
   referenceKernels.set_size(referenceSet.n_cols);
-  for (size_t i = 0; i < referenceSet.n_cols; ++i)
+  #pragma omp parallel for
+  for (size_t i = 0; i < (size_t) referenceSet.n_cols; ++i)
     referenceKernels[i] = sqrt(kernel.Evaluate(referenceSet.col(i),
                                                referenceSet.col(i)));
 
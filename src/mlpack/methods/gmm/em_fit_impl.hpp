@@ -85,7 +85,10 @@ Estimate(const arma::mat& observations,
         << "log-likelihood " << l << "." << std::endl;
 
     // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
+    // Gaussian given the observations and the present theta value.  Each
+    // component writes into its own column of condLogProb, so the components
+    // are processed in parallel.
+    #pragma omp parallel for schedule(dynamic)
     for (size_t i = 0; i < dists.size(); ++i)
     {
       // Store conditional log probabilities into condLogProb vector for each
@@ -95,25 +98,37 @@ Estimate(const arma::mat& observations,
       condLogProbAlias += log(weights[i]);
     }
 
-    // Normalize row-wise.
-    for (size_t i = 0; i < condLogProb.n_rows; ++i)
+    // Normalize row-wise.  The rows are independent, so the loop is blocked
+    // and dispatched across threads.
+    const size_t blockSize = 256;
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t block = 0; block < condLogProb.n_rows; block += blockSize)
     {
-      // Avoid dividing by zero; if the probability for everything is 0, we
-      // don't want to make it NaN.
-      const double probSum = AccuLog(condLogProb.row(i));
-      if (probSum != -std::numeric_limits<double>::infinity())
-        condLogProb.row(i) -= probSum;
+      const size_t lastRow = std::min(block + blockSize,
+          (size_t) condLogProb.n_rows) - 1;
+      for (size_t i = block; i <= lastRow; ++i)
+      {
+        // Avoid dividing by zero; if the probability for everything is 0, we
+        // don't want to make it NaN.
+        const double probSum = AccuLog(condLogProb.row(i));
+        if (probSum != -std::numeric_limits<double>::infinity())
+          condLogProb.row(i) -= probSum;
+      }
     }
 
     // Store the sum of the probability of each state over all the observations.
     arma::vec probRowSums(dists.size());
+    #pragma omp parallel for schedule(dynamic)
     for (size_t i = 0; i < dists.size(); ++i)
     {
       probRowSums(i) = AccuLog(condLogProb.col(i));
     }
 
     // Calculate the new value of the means using the updated conditional
-    // probabilities.
+    // probabilities.  Each component accumulates its own weighted sufficient
+    // statistics and writes only to its own distribution, so the components
+    // are updated in parallel.
+    #pragma omp parallel for schedule(dynamic)
     for (size_t i = 0; i < dists.size(); ++i)
     {
       // Don't update if there's no probability of the Gaussian having points.
@@ -189,7 +204,10 @@ Estimate(const arma::mat& observations,
   while (std::abs(l - lOld) > tolerance && iteration != maxIterations)
   {
     // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
+    // Gaussian given the observations and the present theta value.  Each
+    // component writes into its own column of condLogProb, so the components
+    // are processed in parallel.
+    #pragma omp parallel for schedule(dynamic)
     for (size_t i = 0; i < dists.size(); ++i)
     {
       // Store conditional log probabilities into condLogProb vector for each
@@ -199,14 +217,22 @@ Estimate(const arma::mat& observations,
       condLogProbAlias += log(weights[i]);
     }
 
-    // Normalize row-wise.
-    for (size_t i = 0; i < condLogProb.n_rows; ++i)
+    // Normalize row-wise.  The rows are independent, so the loop is blocked
+    // and dispatched across threads.
+    const size_t blockSize = 256;
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t block = 0; block < condLogProb.n_rows; block += blockSize)
     {
-      // Avoid dividing by zero; if the probability for everything is 0, we
-      // don't want to make it NaN.
-      const double probSum = AccuLog(condLogProb.row(i));
-      if (probSum != -std::numeric_limits<double>::infinity())
-        condLogProb.row(i) -= probSum;
+      const size_t lastRow = std::min(block + blockSize,
+          (size_t) condLogProb.n_rows) - 1;
+      for (size_t i = block; i <= lastRow; ++i)
+      {
+        // Avoid dividing by zero; if the probability for everything is 0, we
+        // don't want to make it NaN.
+        const double probSum = AccuLog(condLogProb.row(i));
+        if (probSum != -std::numeric_limits<double>::infinity())
+          condLogProb.row(i) -= probSum;
+      }
     }
 
     // This will store the sum of probabilities of each state over all the
@@ -214,8 +240,11 @@ Estimate(const arma::mat& observations,
     arma::vec probRowSums(dists.size());
 
     // Calculate the new value of the means using the updated conditional
-    // probabilities.
+    // probabilities.  Each component accumulates its own weighted sufficient
+    // statistics and writes only to its own distribution and its own element
+    // of probRowSums, so the components are updated in parallel.
     arma::vec logProbabilities = arma::log(probabilities);
+    #pragma omp parallel for schedule(dynamic)
     for (size_t i = 0; i < dists.size(); ++i)
     {
       // Calculate the sum of probabilities of points, which is the
@@ -379,25 +408,41 @@ LogLikelihood(const arma::mat& observations,
 {
   double logLikelihood = 0;
 
-  arma::vec logPhis;
   arma::mat logLikelihoods(dists.size(), observations.n_cols);
 
-  // It has to be LogProbability() otherwise Probability() would overflow easily
+  // It has to be LogProbability() otherwise Probability() would overflow
+  // easily.  Each component writes into its own row, so the components are
+  // processed in parallel.
+  #pragma omp parallel for schedule(dynamic)
   for (size_t i = 0; i < dists.size(); ++i)
   {
+    arma::vec logPhis;
     dists[i].LogProbability(observations, logPhis);
     logLikelihoods.row(i) = log(weights(i)) + trans(logPhis);
   }
-  // Now sum over every point.
+
+  // Now sum over every point.  Log output is not thread-safe, so the
+  // per-point sums are computed in parallel first and outliers are reported
+  // afterwards.
+  arma::vec pointLogLikelihoods(observations.n_cols);
+  const size_t blockSize = 256;
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < observations.n_cols; block += blockSize)
+  {
+    const size_t lastCol = std::min(block + blockSize,
+        (size_t) observations.n_cols) - 1;
+    for (size_t j = block; j <= lastCol; ++j)
+      pointLogLikelihoods[j] = AccuLog(logLikelihoods.col(j));
+  }
+
   for (size_t j = 0; j < observations.n_cols; ++j)
   {
-    if (AccuLog(logLikelihoods.col(j)) ==
-        -std::numeric_limits<double>::infinity())
+    if (pointLogLikelihoods[j] == -std::numeric_limits<double>::infinity())
     {
       Log::Info << "Likelihood of point " << j << " is 0!  It is probably an "
           << "outlier." << std::endl;
     }
-    logLikelihood += AccuLog(logLikelihoods.col(j));
+    logLikelihood += pointLogLikelihoods[j];
   }
 
   return logLikelihood;
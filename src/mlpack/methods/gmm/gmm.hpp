@@ -329,4 +329,7 @@ class GMM
 // Also include the DiagonalGMM class.
 #include "diagonal_gmm.hpp"
 
+// Also include stepwise (online) EM for streaming observations.
+#include "stepwise_em_fit.hpp"
+
 #endif
@@ -229,19 +229,30 @@ inline double GMM::LogLikelihood(
     const arma::vec& weightsL) const
 {
   double loglikelihood = 0;
-  arma::vec logPhis;
   arma::mat logLikelihoods(gaussians, data.n_cols);
 
-  // It has to be LogProbability() otherwise Probability() would overflow easily
+  // It has to be LogProbability() otherwise Probability() would overflow
+  // easily.  Each component writes into its own row, so the components are
+  // processed in parallel.
+  #pragma omp parallel for schedule(dynamic)
   for (size_t i = 0; i < gaussians; ++i)
   {
+    arma::vec logPhis;
     distsL[i].LogProbability(data, logPhis);
     logLikelihoods.row(i) = log(weightsL(i)) + trans(logPhis);
   }
 
-  // Now sum over every point.
-  for (size_t j = 0; j < data.n_cols; ++j)
-    loglikelihood += AccuLog(logLikelihoods.col(j));
+  // Now sum over every point.  The per-point sums are independent, so the
+  // loop is blocked and dispatched across threads.
+  const size_t blockSize = 256;
+  #pragma omp parallel for schedule(dynamic) reduction(+:loglikelihood)
+  for (size_t block = 0; block < data.n_cols; block += blockSize)
+  {
+    const size_t lastCol = std::min(block + blockSize,
+        (size_t) data.n_cols) - 1;
+    for (size_t j = block; j <= lastCol; ++j)
+      loglikelihood += AccuLog(logLikelihoods.col(j));
+  }
   return loglikelihood;
 }
 
@@ -278,46 +289,54 @@ double GMM::Train(const arma::mat& observations,
       weightsOrig = weights;
     }
 
-    // We need to keep temporary copies.  We'll do the first training into the
-    // actual model position, so that if it's the best we don't need to copy it.
-    fitter.Estimate(observations, dists, weights, useExistingModel);
-
-    bestLikelihood = LogLikelihood(observations, dists, weights);
-
-    Log::Info << "GMM::Train(): Log-likelihood of trial 0 is "
-        << bestLikelihood << "." << std::endl;
-
-    // Now the temporary model.
-    std::vector<GaussianDistribution> distsTrial(gaussians,
-        GaussianDistribution(dimensionality));
-    arma::vec weightsTrial(gaussians);
+    // The trials are independent restarts, so they are dispatched across
+    // threads; each trial trains its own temporary model.  Log output is not
+    // thread-safe, so the per-trial likelihoods are collected and reported
+    // after the parallel region, where the best model is also selected.
+    std::vector<std::vector<GaussianDistribution>> distsTrials(trials);
+    std::vector<arma::vec> weightsTrials(trials);
+    arma::vec trialLikelihoods(trials);
 
-    for (size_t trial = 1; trial < trials; ++trial)
+    #pragma omp parallel for schedule(dynamic) firstprivate(fitter)
+    for (size_t trial = 0; trial < trials; ++trial)
     {
       if (useExistingModel)
       {
-        distsTrial = distsOrig;
-        weightsTrial = weightsOrig;
+        distsTrials[trial] = distsOrig;
+        weightsTrials[trial] = weightsOrig;
+      }
+      else
+      {
+        distsTrials[trial] = std::vector<GaussianDistribution>(gaussians,
+            GaussianDistribution(dimensionality));
+        weightsTrials[trial].set_size(gaussians);
       }
 
-      fitter.Estimate(observations, distsTrial, weightsTrial, useExistingModel);
+      fitter.Estimate(observations, distsTrials[trial], weightsTrials[trial],
+          useExistingModel);
 
-      // Check to see if the log-likelihood of this one is better.
-      double newLikelihood = LogLikelihood(observations, distsTrial,
-          weightsTrial);
+      trialLikelihoods[trial] = LogLikelihood(observations, distsTrials[trial],
+          weightsTrials[trial]);
+    }
 
+    // Select the best trial.
+    bestLikelihood = trialLikelihoods[0];
+    size_t bestTrial = 0;
+    for (size_t trial = 0; trial < trials; ++trial)
+    {
       Log::Info << "GMM::Train(): Log-likelihood of trial " << trial << " is "
-          << newLikelihood << "." << std::endl;
+          << trialLikelihoods[trial] << "." << std::endl;
 
-      if (newLikelihood > bestLikelihood)
+      if (trialLikelihoods[trial] > bestLikelihood)
       {
-        // Save new likelihood and copy new model.
-        bestLikelihood = newLikelihood;
-
-        dists = distsTrial;
-        weights = weightsTrial;
+        // Save new likelihood and remember which model to keep.
+        bestLikelihood = trialLikelihoods[trial];
+        bestTrial = trial;
       }
     }
+
+    dists = std::move(distsTrials[bestTrial]);
+    weights = std::move(weightsTrials[bestTrial]);
   }
 
   // Report final log-likelihood and return it.
@@ -362,48 +381,54 @@ double GMM::Train(const arma::mat& observations,
       weightsOrig = weights;
     }
 
-    // We need to keep temporary copies.  We'll do the first training into the
-    // actual model position, so that if it's the best we don't need to copy it.
-    fitter.Estimate(observations, probabilities, dists, weights,
-        useExistingModel);
-
-    bestLikelihood = LogLikelihood(observations, dists, weights);
+    // The trials are independent restarts, so they are dispatched across
+    // threads; each trial trains its own temporary model.  Log output is not
+    // thread-safe, so the per-trial likelihoods are collected and reported
+    // after the parallel region, where the best model is also selected.
+    std::vector<std::vector<GaussianDistribution>> distsTrials(trials);
+    std::vector<arma::vec> weightsTrials(trials);
+    arma::vec trialLikelihoods(trials);
 
-    Log::Debug << "GMM::Train(): Log-likelihood of trial 0 is "
-        << bestLikelihood << "." << std::endl;
-
-    // Now the temporary model.
-    std::vector<GaussianDistribution> distsTrial(gaussians,
-        GaussianDistribution(dimensionality));
-    arma::vec weightsTrial(gaussians);
-
-    for (size_t trial = 1; trial < trials; ++trial)
+    #pragma omp parallel for schedule(dynamic) firstprivate(fitter)
+    for (size_t trial = 0; trial < trials; ++trial)
     {
       if (useExistingModel)
       {
-        distsTrial = distsOrig;
-        weightsTrial = weightsOrig;
+        distsTrials[trial] = distsOrig;
+        weightsTrials[trial] = weightsOrig;
+      }
+      else
+      {
+        distsTrials[trial] = std::vector<GaussianDistribution>(gaussians,
+            GaussianDistribution(dimensionality));
+        weightsTrials[trial].set_size(gaussians);
       }
 
-      fitter.Estimate(observations, probabilities, distsTrial, weightsTrial,
-          useExistingModel);
+      fitter.Estimate(observations, probabilities, distsTrials[trial],
+          weightsTrials[trial], useExistingModel);
 
-      // Check to see if the log-likelihood of this one is better.
-      double newLikelihood = LogLikelihood(observations, distsTrial,
-          weightsTrial);
+      trialLikelihoods[trial] = LogLikelihood(observations, distsTrials[trial],
+          weightsTrials[trial]);
+    }
 
+    // Select the best trial.
+    bestLikelihood = trialLikelihoods[0];
+    size_t bestTrial = 0;
+    for (size_t trial = 0; trial < trials; ++trial)
+    {
       Log::Debug << "GMM::Train(): Log-likelihood of trial " << trial << " is "
-          << newLikelihood << "." << std::endl;
+          << trialLikelihoods[trial] << "." << std::endl;
 
-      if (newLikelihood > bestLikelihood)
+      if (trialLikelihoods[trial] > bestLikelihood)
       {
-        // Save new likelihood and copy new model.
-        bestLikelihood = newLikelihood;
-
-        dists = distsTrial;
-        weights = weightsTrial;
+        // Save new likelihood and remember which model to keep.
+        bestLikelihood = trialLikelihoods[trial];
+        bestTrial = trial;
       }
     }
+
+    dists = std::move(distsTrials[bestTrial]);
+    weights = std::move(weightsTrials[bestTrial]);
   }
 
   // Report final log-likelihood and return it.
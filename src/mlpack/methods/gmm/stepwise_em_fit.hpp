@@ -0,0 +1,207 @@
+/**
+ * @file methods/gmm/stepwise_em_fit.hpp
+ * @author Ryan Curtin
+ *
+ * Utility class to fit a GMM or DiagonalGMM incrementally with stepwise
+ * (online) EM, for observation streams that do not fit in memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_STEPWISE_EM_FIT_HPP
+#define MLPACK_METHODS_GMM_STEPWISE_EM_FIT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/log_add.hpp>
+
+// This brings in the GMM and DiagonalGMM classes (and the covariance
+// constraint policies).
+#include "gmm.hpp"
+
+namespace mlpack {
+
+/**
+ * This class fits a GMM (or DiagonalGMM) to a stream of observations using
+ * stepwise (online) EM.  Instead of iterating over a full observation matrix,
+ * the model is updated one mini-batch at a time: the E-step is run on the
+ * batch under the current model, the resulting per-observation sufficient
+ * statistics are blended into a running set of statistics with a decaying
+ * step size, and the model parameters are re-derived from the running
+ * statistics.  This allows training on unbounded streams with bounded memory.
+ *
+ * The model must be initialized before the first update---for instance by a
+ * short GMM::Train() run on a buffered prefix of the stream, or by setting
+ * the components and weights by hand.  Then, for each incoming batch:
+ *
+ * @code
+ * StepwiseEMFit<GMM> fitter(gmm.Gaussians(), gmm.Dimensionality());
+ * size_t step = 0;
+ * while (stream.HasNext())
+ *   fitter.Step(stream.NextBatch(), gmm, std::pow(++step + 2, -0.7));
+ * @endcode
+ *
+ * Batches may also be sharded across threads: each shard accumulates its
+ * statistics into its own fitter with Accumulate(), the shard statistics are
+ * combined exactly with Merge() (the statistics are plain sums, so the merge
+ * is independent of how the observations were split), and a single Apply()
+ * performs the model update:
+ *
+ * @code
+ * fitterA.Accumulate(shardA, gmm);
+ * fitterB.Accumulate(shardB, gmm);
+ * fitterA.Merge(fitterB);
+ * fitterA.Apply(gmm, stepSize);
+ * @endcode
+ *
+ * @tparam GMMType Mixture model type to fit; either GMM or DiagonalGMM.
+ * @tparam CovarianceConstraintPolicy Constraint policy applied to each
+ *     re-derived covariance.
+ */
+template<typename GMMType = GMM,
+         typename CovarianceConstraintPolicy = typename std::conditional<
+             std::is_same<GMMType, DiagonalGMM>::value,
+             DiagonalConstraint,
+             PositiveDefiniteConstraint>::type>
+class StepwiseEMFit
+{
+ public:
+  /**
+   * Construct the StepwiseEMFit object for a model of the given size,
+   * optionally passing a covariance constraint policy object (just in case
+   * it needs to store state).  The running statistics start empty; the first
+   * Apply() seeds them from the first batch.
+   *
+   * @param gaussians Number of Gaussians in the model to fit.
+   * @param dimensionality Dimensionality of the model to fit.
+   * @param constraint Constraint policy of covariance.
+   */
+  StepwiseEMFit(const size_t gaussians,
+                const size_t dimensionality,
+                CovarianceConstraintPolicy constraint =
+                    CovarianceConstraintPolicy());
+
+  /**
+   * Perform one stepwise EM update of the given model from a batch of
+   * observations.  This is equivalent to Accumulate() followed by Apply().
+   *
+   * @param observations Batch of observations.
+   * @param gmm Model to update; must already be initialized.
+   * @param stepSize Weight in (0, 1] given to the batch statistics; a
+   *     decaying schedule such as pow(t + 2, -0.7) guarantees convergence.
+   */
+  void Step(const arma::mat& observations,
+            GMMType& gmm,
+            const double stepSize);
+
+  /**
+   * Run the E-step on a shard of observations under the current model and
+   * add the resulting sufficient statistics to the pending shard statistics,
+   * without updating the model.  Shards accumulated against the same model
+   * combine exactly with Merge().
+   *
+   * @param observations Shard of observations.
+   * @param gmm Model used to compute responsibilities.
+   */
+  void Accumulate(const arma::mat& observations, const GMMType& gmm);
+
+  /**
+   * Add the pending shard statistics of another fitter to this one.  Both
+   * fitters must have accumulated against the same model for the result to
+   * be exact.
+   *
+   * @param other Fitter whose pending statistics will be added.
+   */
+  void Merge(const StepwiseEMFit& other);
+
+  /**
+   * Blend the pending shard statistics into the running statistics with the
+   * given step size, re-derive the model parameters, and clear the pending
+   * statistics.  Does nothing if no observations are pending.
+   *
+   * @param gmm Model to update.
+   * @param stepSize Weight in (0, 1] given to the pending statistics.
+   */
+  void Apply(GMMType& gmm, const double stepSize);
+
+  //! Get the covariance constraint policy class.
+  const CovarianceConstraintPolicy& Constraint() const { return constraint; }
+  //! Modify the covariance constraint policy class.
+  CovarianceConstraintPolicy& Constraint() { return constraint; }
+
+  //! Get the number of Gaussians in the model being fit.
+  size_t Gaussians() const { return gaussians; }
+  //! Get the dimensionality of the model being fit.
+  size_t Dimensionality() const { return dimensionality; }
+
+  //! Get the number of observations accumulated but not yet applied.
+  size_t PendingObservations() const { return pendingCount; }
+
+  //! Serialize the fitter (including the running statistics, so a streaming
+  //! fit can be checkpointed and resumed).
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t version);
+
+ private:
+  //! Storage for the second-moment statistics: one matrix per component for
+  //! full covariances, or one column of diagonal entries per component for
+  //! diagonal covariances.
+  typedef typename std::conditional<
+      std::is_same<GMMType, DiagonalGMM>::value,
+      arma::mat, arma::cube>::type ScatterType;
+
+  //! Size the second-moment statistics for a full-covariance model.
+  void ZeroScatter(arma::cube& scatter);
+  //! Size the second-moment statistics for a diagonal-covariance model.
+  void ZeroScatter(arma::mat& scatter);
+
+  //! Add a shard's second-moment statistics (full covariance).
+  void AccumulateScatter(const arma::mat& observations,
+                         const arma::mat& condProb,
+                         arma::cube& scatter);
+  //! Add a shard's second-moment statistics (diagonal covariance).
+  void AccumulateScatter(const arma::mat& observations,
+                         const arma::mat& condProb,
+                         arma::mat& scatter);
+
+  //! Re-derive a full covariance from the running statistics.
+  void ApplyCovariance(GaussianDistribution& dist,
+                       const size_t i,
+                       const arma::cube& scatter);
+  //! Re-derive a diagonal covariance from the running statistics.
+  void ApplyCovariance(DiagonalGaussianDistribution& dist,
+                       const size_t i,
+                       const arma::mat& scatter);
+
+  //! Number of Gaussians in the model being fit.
+  size_t gaussians;
+  //! Dimensionality of the model being fit.
+  size_t dimensionality;
+  //! Covariance constraint policy object.
+  CovarianceConstraintPolicy constraint;
+
+  //! Running per-observation responsibility mass of each component.
+  arma::vec condProbSums;
+  //! Running responsibility-weighted observation sums (one column per
+  //! component).
+  arma::mat weightedSums;
+  //! Running responsibility-weighted second moments.
+  ScatterType scatterSums;
+
+  //! Pending (unnormalized) responsibility mass of each component.
+  arma::vec pendingCondProbSums;
+  //! Pending responsibility-weighted observation sums.
+  arma::mat pendingWeightedSums;
+  //! Pending responsibility-weighted second moments.
+  ScatterType pendingScatterSums;
+  //! Number of observations in the pending statistics.
+  size_t pendingCount;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "stepwise_em_fit_impl.hpp"
+
+#endif
@@ -0,0 +1,247 @@
+/**
+ * @file methods/gmm/stepwise_em_fit_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of stepwise (online) EM for fitting GMMs to observation
+ * streams.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_STEPWISE_EM_FIT_IMPL_HPP
+#define MLPACK_METHODS_GMM_STEPWISE_EM_FIT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "stepwise_em_fit.hpp"
+
+namespace mlpack {
+
+//! Constructor.
+template<typename GMMType, typename CovarianceConstraintPolicy>
+StepwiseEMFit<GMMType, CovarianceConstraintPolicy>::StepwiseEMFit(
+    const size_t gaussians,
+    const size_t dimensionality,
+    CovarianceConstraintPolicy constraint) :
+    gaussians(gaussians),
+    dimensionality(dimensionality),
+    constraint(constraint),
+    pendingCount(0)
+{
+  // The running statistics stay empty until the first Apply(); the pending
+  // statistics must be sized so that Accumulate() can add into them.
+  pendingCondProbSums.zeros(gaussians);
+  pendingWeightedSums.zeros(dimensionality, gaussians);
+  ZeroScatter(pendingScatterSums);
+}
+
+template<typename GMMType, typename CovarianceConstraintPolicy>
+void StepwiseEMFit<GMMType, CovarianceConstraintPolicy>::Step(
+    const arma::mat& observations,
+    GMMType& gmm,
+    const double stepSize)
+{
+  Accumulate(observations, gmm);
+  Apply(gmm, stepSize);
+}
+
+template<typename GMMType, typename CovarianceConstraintPolicy>
+void StepwiseEMFit<GMMType, CovarianceConstraintPolicy>::Accumulate(
+    const arma::mat& observations,
+    const GMMType& gmm)
+{
+  arma::mat condLogProb(observations.n_cols, gaussians);
+
+  // Calculate the conditional probabilities of choosing a particular Gaussian
+  // given the observations and the current model.  Each component writes into
+  // its own column of condLogProb, so the components are processed in
+  // parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < gaussians; ++i)
+  {
+    arma::vec condLogProbAlias = condLogProb.unsafe_col(i);
+    gmm.Component(i).LogProbability(observations, condLogProbAlias);
+    condLogProbAlias += log(gmm.Weights()[i]);
+  }
+
+  // Normalize row-wise.  The rows are independent, so the loop is blocked and
+  // dispatched across threads.
+  const size_t blockSize = 256;
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < condLogProb.n_rows; block += blockSize)
+  {
+    const size_t lastRow = std::min(block + blockSize,
+        (size_t) condLogProb.n_rows) - 1;
+    for (size_t i = block; i <= lastRow; ++i)
+    {
+      // Avoid dividing by zero; if the probability for everything is 0, the
+      // row stays at -inf and the observation contributes nothing.
+      const double probSum = AccuLog(condLogProb.row(i));
+      if (probSum != -std::numeric_limits<double>::infinity())
+        condLogProb.row(i) -= probSum;
+    }
+  }
+
+  // Now add the responsibility-weighted sufficient statistics of this shard.
+  // These are plain sums over observations, so shards accumulated against the
+  // same model combine exactly regardless of how the stream was split.
+  const arma::mat condProb = arma::exp(condLogProb);
+
+  pendingCondProbSums += trans(arma::sum(condProb, 0));
+  pendingWeightedSums += observations * condProb;
+  AccumulateScatter(observations, condProb, pendingScatterSums);
+  pendingCount += observations.n_cols;
+}
+
+template<typename GMMType, typename CovarianceConstraintPolicy>
+void StepwiseEMFit<GMMType, CovarianceConstraintPolicy>::Merge(
+    const StepwiseEMFit& other)
+{
+  pendingCondProbSums += other.pendingCondProbSums;
+  pendingWeightedSums += other.pendingWeightedSums;
+  pendingScatterSums += other.pendingScatterSums;
+  pendingCount += other.pendingCount;
+}
+
+template<typename GMMType, typename CovarianceConstraintPolicy>
+void StepwiseEMFit<GMMType, CovarianceConstraintPolicy>::Apply(
+    GMMType& gmm,
+    const double stepSize)
+{
+  if (pendingCount == 0)
+    return;
+
+  // The running statistics are kept normalized per observation, so the decay
+  // update is independent of the batch size.
+  const double invCount = 1.0 / (double) pendingCount;
+
+  if (condProbSums.is_empty())
+  {
+    // First update: seed the running statistics from the batch.
+    condProbSums = pendingCondProbSums * invCount;
+    weightedSums = pendingWeightedSums * invCount;
+    scatterSums = pendingScatterSums * invCount;
+  }
+  else
+  {
+    condProbSums *= (1.0 - stepSize);
+    condProbSums += (stepSize * invCount) * pendingCondProbSums;
+    weightedSums *= (1.0 - stepSize);
+    weightedSums += (stepSize * invCount) * pendingWeightedSums;
+    scatterSums *= (1.0 - stepSize);
+    scatterSums += (stepSize * invCount) * pendingScatterSums;
+  }
+
+  // M-step: re-derive the model from the running statistics.  Each component
+  // writes only to its own distribution, so the components are updated in
+  // parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < gaussians; ++i)
+  {
+    // Don't update if there's no responsibility mass for this component.
+    if (condProbSums[i] <= 0.0)
+      continue;
+
+    gmm.Component(i).Mean() = weightedSums.col(i) / condProbSums[i];
+    ApplyCovariance(gmm.Component(i), i, scatterSums);
+  }
+
+  gmm.Weights() = condProbSums / accu(condProbSums);
+
+  // Reset the pending statistics for the next batch.
+  pendingCondProbSums.zeros();
+  pendingWeightedSums.zeros();
+  pendingScatterSums.zeros();
+  pendingCount = 0;
+}
+
+template<typename GMMType, typename CovarianceConstraintPolicy>
+void StepwiseEMFit<GMMType, CovarianceConstraintPolicy>::ZeroScatter(
+    arma::cube& scatter)
+{
+  scatter.zeros(dimensionality, dimensionality, gaussians);
+}
+
+template<typename GMMType, typename CovarianceConstraintPolicy>
+void StepwiseEMFit<GMMType, CovarianceConstraintPolicy>::ZeroScatter(
+    arma::mat& scatter)
+{
+  scatter.zeros(dimensionality, gaussians);
+}
+
+template<typename GMMType, typename CovarianceConstraintPolicy>
+void StepwiseEMFit<GMMType, CovarianceConstraintPolicy>::AccumulateScatter(
+    const arma::mat& observations,
+    const arma::mat& condProb,
+    arma::cube& scatter)
+{
+  // Each component accumulates its own weighted scatter matrix, so the
+  // components are processed in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < gaussians; ++i)
+  {
+    scatter.slice(i) += (observations.each_row() % trans(condProb.col(i))) *
+        trans(observations);
+  }
+}
+
+template<typename GMMType, typename CovarianceConstraintPolicy>
+void StepwiseEMFit<GMMType, CovarianceConstraintPolicy>::AccumulateScatter(
+    const arma::mat& observations,
+    const arma::mat& condProb,
+    arma::mat& scatter)
+{
+  // For diagonal covariances only the elementwise second moments are needed.
+  scatter += (observations % observations) * condProb;
+}
+
+template<typename GMMType, typename CovarianceConstraintPolicy>
+void StepwiseEMFit<GMMType, CovarianceConstraintPolicy>::ApplyCovariance(
+    GaussianDistribution& dist,
+    const size_t i,
+    const arma::cube& scatter)
+{
+  arma::mat covariance = scatter.slice(i) / condProbSums[i] -
+      dist.Mean() * trans(dist.Mean());
+
+  // Apply covariance constraint.
+  constraint.ApplyConstraint(covariance);
+  dist.Covariance(std::move(covariance));
+}
+
+template<typename GMMType, typename CovarianceConstraintPolicy>
+void StepwiseEMFit<GMMType, CovarianceConstraintPolicy>::ApplyCovariance(
+    DiagonalGaussianDistribution& dist,
+    const size_t i,
+    const arma::mat& scatter)
+{
+  arma::vec covariance = scatter.col(i) / condProbSums[i] -
+      dist.Mean() % dist.Mean();
+
+  // Apply covariance constraint.
+  constraint.ApplyConstraint(covariance);
+  dist.Covariance(std::move(covariance));
+}
+
+//! Serialize the fitter.
+template<typename GMMType, typename CovarianceConstraintPolicy>
+template<typename Archive>
+void StepwiseEMFit<GMMType, CovarianceConstraintPolicy>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(gaussians));
+  ar(CEREAL_NVP(dimensionality));
+  ar(CEREAL_NVP(constraint));
+  ar(CEREAL_NVP(condProbSums));
+  ar(CEREAL_NVP(weightedSums));
+  ar(CEREAL_NVP(scatterSums));
+  ar(CEREAL_NVP(pendingCondProbSums));
+  ar(CEREAL_NVP(pendingWeightedSums));
+  ar(CEREAL_NVP(pendingScatterSums));
+  ar(CEREAL_NVP(pendingCount));
+}
+
+} // namespace mlpack
+
+#endif
@@ -275,13 +275,24 @@ class HMM
    * sequence, using the Viterbi algorithm, returning the log-likelihood of the
    * most likely state sequence.
    *
+   * Optionally, a beam width may be given; then, at each time step, only
+   * transitions out of the beamWidth states with the highest scores are
+   * considered.  This reduces the per-step cost from quadratic to linear in
+   * the number of states at the price of an approximate (though in practice
+   * usually identical) decode.  A beam width of 0 (the default), or any value
+   * at least as large as the number of states, gives the exact Viterbi
+   * solution.
+   *
    * @param dataSeq Sequence of observations.
    * @param stateSeq Vector in which the most probable state sequence will be
    *    stored.
+   * @param beamWidth Number of states to keep per time step (0 means no
+   *    pruning).
    * @return Log-likelihood of most probable state sequence.
    */
   double Predict(const arma::mat& dataSeq,
-                 arma::Row<size_t>& stateSeq) const;
+                 arma::Row<size_t>& stateSeq,
+                 const size_t beamWidth = 0) const;
 
   /**
    * Compute the log-likelihood of the given data sequence.
@@ -291,6 +302,19 @@ class HMM
    */
   double LogLikelihood(const arma::mat& dataSeq) const;
 
+  /**
+   * Compute the log-likelihood of each of the given data sequences.  The
+   * sequences are scored independently and dispatched across threads, and
+   * each thread reuses its own scratch buffers between sequences, so this is
+   * considerably faster than calling LogLikelihood() once per sequence.
+   *
+   * @param dataSeq Vector of data sequences to evaluate the likelihood of.
+   * @param logLikelihoods Vector in which the log-likelihood of each sequence
+   *    will be stored.
+   */
+  void LogLikelihood(const std::vector<arma::mat>& dataSeq,
+                     arma::vec& logLikelihoods) const;
+
   /**
    * Compute the log of the scaling factor of the given emission probability
    * at time t. To calculate the log-likelihood for the whole sequence,
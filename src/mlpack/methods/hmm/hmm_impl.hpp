@@ -100,10 +100,14 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
   // Maximum iterations?
   size_t iterations = 1000;
 
-  // Find length of all sequences and ensure they are the correct size.
+  // Find length of all sequences and ensure they are the correct size.  Each
+  // sequence occupies a fixed, disjoint slice of the emission list, so the
+  // per-sequence offsets can be computed once up front.
   size_t totalLength = 0;
+  std::vector<size_t> seqOffsets(dataSeq.size());
   for (size_t seq = 0; seq < dataSeq.size(); seq++)
   {
+    seqOffsets[seq] = totalLength;
     totalLength += dataSeq[seq].n_cols;
 
     if (dataSeq[seq].n_rows != dimensionality)
@@ -132,70 +136,110 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
     // Reset log likelihood.
     loglik = 0;
 
-    // Sum over time.
-    size_t sumTime = 0;
-
-    // Loop over each sequence.
-    for (size_t seq = 0; seq < dataSeq.size(); seq++)
+    // Loop over each sequence.  Sequences are independent given the current
+    // model, so the per-sequence forward-backward passes are dispatched
+    // across threads.  Each sequence writes its emission probabilities into
+    // its own slice of the emission list; the initial-state and transition
+    // accumulators are kept per-thread and merged by element-wise
+    // log-addition afterwards.
+    #pragma omp parallel
     {
-      arma::mat stateLogProb;
-      arma::mat forwardLog;
-      arma::mat backwardLog;
-      arma::vec logScales;
-
-      // Add the log-likelihood of this sequence.  This is the E-step.
-      loglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
-          backwardLog, logScales);
-
-      // Add to estimate of initial probability for state j.
-      LogSumExp<arma::vec, true>(stateLogProb.unsafe_col(0),
-          newLogInitial);
-
-      // Define a variable to store the value of log-probability for data.
-      arma::mat logProbs(dataSeq[seq].n_cols, logTransition.n_rows);
-      // Save the values of log-probability to logProbs.
-      for (size_t i = 0; i < logTransition.n_rows; i++)
-      {
-        // Define alias of desired column.
-        arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
-        // Use advanced constructor for using logProbs directly.
-        emission[i].LogProbability(dataSeq[seq], alias);
-      }
-
-      // Now re-estimate the parameters.  This is the M-step.
-      //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
-      //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t]) b(i,
-      //           t + 1)))
-      //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t) b(i, t)
-      // We store the new estimates in a different matrix.
-      for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+      arma::vec localNewLogInitial(logTransition.n_rows);
+      localNewLogInitial.fill(-std::numeric_limits<double>::infinity());
+      arma::mat localNewLogTransition(logTransition.n_rows,
+                                      logTransition.n_cols);
+      localNewLogTransition.fill(-std::numeric_limits<double>::infinity());
+
+      #pragma omp for schedule(dynamic) reduction(+:loglik)
+      for (size_t seq = 0; seq < dataSeq.size(); seq++)
       {
-        // Assemble temporary vector that's used in log-sum computation.
-        if (t < dataSeq[seq].n_cols - 1)
+        arma::mat stateLogProb;
+        arma::mat forwardLog;
+        arma::mat backwardLog;
+        arma::vec logScales;
+
+        // Add the log-likelihood of this sequence.  This is the E-step.
+        loglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
+            backwardLog, logScales);
+
+        // Add to estimate of initial probability for state j.
+        LogSumExp<arma::vec, true>(stateLogProb.unsafe_col(0),
+            localNewLogInitial);
+
+        // Define a variable to store the value of log-probability for data.
+        arma::mat logProbs(dataSeq[seq].n_cols, logTransition.n_rows);
+        // Save the values of log-probability to logProbs.
+        for (size_t i = 0; i < logTransition.n_rows; i++)
         {
-          // This term is the same across all states, so compute it once and
-          // cache it.
-          const arma::vec tmp = backwardLog.col(t + 1) +
-              logProbs.row(t + 1).t() - logScales[t + 1];
-          arma::vec output;
-          LogSumExp(tmp, output);
+          // Define alias of desired column.
+          arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
+          // Use advanced constructor for using logProbs directly.
+          emission[i].LogProbability(dataSeq[seq], alias);
+        }
 
-          for (size_t j = 0; j < logTransition.n_cols; ++j)
+        // Now re-estimate the parameters.  This is the M-step.
+        //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
+        //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t])
+        //           b(i, t + 1)))
+        //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t)
+        //           b(i, t)
+        // We store the new estimates in a different matrix.
+        size_t sumTime = seqOffsets[seq];
+        for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+        {
+          // Assemble temporary vector that's used in log-sum computation.
+          if (t < dataSeq[seq].n_cols - 1)
           {
-            // Compute the estimate of T_ij (probability of transition from
-            // state j to state i).  We postpone multiplication of the old T_ij
-            // until later.
-            arma::vec tmp2 = output + forwardLog(j, t);
-            arma::vec alias = newLogTransition.unsafe_col(j);
-            LogSumExp<arma::vec, true>(tmp2, alias);
+            // This term is the same across all states, so compute it once and
+            // cache it.
+            const arma::vec tmp = backwardLog.col(t + 1) +
+                logProbs.row(t + 1).t() - logScales[t + 1];
+            arma::vec output;
+            LogSumExp(tmp, output);
+
+            // Compute the estimates of T_ij (probability of transition from
+            // state j to state i) for all pairs of states at once, as an
+            // element-wise log-addition into the accumulator.  We postpone
+            // multiplication of the old T_ij until later.
+            arma::mat candidate(logTransition.n_rows, logTransition.n_cols);
+            candidate.each_col() = output;
+            candidate.each_row() += forwardLog.col(t).t();
+
+            const arma::mat maxs = arma::max(localNewLogTransition, candidate);
+            localNewLogTransition = maxs +
+                log(exp(localNewLogTransition - maxs) +
+                    exp(candidate - maxs));
+            if (maxs.has_inf())
+            {
+              localNewLogTransition.replace(
+                  -std::numeric_limits<double>::quiet_NaN(),
+                  -std::numeric_limits<double>::infinity());
+            }
           }
+
+          // Add to list of emission observations, for Distribution::Train().
+          for (size_t j = 0; j < logTransition.n_cols; ++j)
+            emissionProb[j][sumTime] = exp(stateLogProb(j, t));
+          emissionList.col(sumTime) = dataSeq[seq].col(t);
+          sumTime++;
         }
+      }
+
+      // Merge this thread's accumulators into the shared estimates.
+      #pragma omp critical (HMMTrainMerge)
+      {
+        LogSumExp<arma::vec, true>(localNewLogInitial, newLogInitial);
 
-        // Add to list of emission observations, for Distribution::Train().
-        for (size_t j = 0; j < logTransition.n_cols; ++j)
-          emissionProb[j][sumTime] = exp(stateLogProb(j, t));
-        emissionList.col(sumTime) = dataSeq[seq].col(t);
-        sumTime++;
+        const arma::mat maxs = arma::max(newLogTransition,
+            localNewLogTransition);
+        newLogTransition = maxs + log(exp(newLogTransition - maxs) +
+            exp(localNewLogTransition - maxs));
+        if (maxs.has_inf())
+        {
+          newLogTransition.replace(
+              -std::numeric_limits<double>::quiet_NaN(),
+              -std::numeric_limits<double>::infinity());
+        }
       }
     }
 
@@ -231,7 +275,9 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
 
     initialProxy = exp(logInitial);
     transitionProxy = exp(logTransition);
-    // Now estimate emission probabilities.
+    // Now estimate emission probabilities.  Each state's distribution is
+    // trained independently, so the states are dispatched across threads.
+    #pragma omp parallel for schedule(dynamic)
     for (size_t state = 0; state < logTransition.n_cols; state++)
       emission[state].Train(emissionList, emissionProb[state]);
 
@@ -317,7 +363,14 @@ void HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq,
   logTransition = log(transition);
   logInitial = log(initial);
 
-  // Estimate emission matrix.
+  // Estimate emission matrix.  The per-state distribution fits are
+  // independent of each other (each state trains only its own distribution
+  // from its own observations), so the states are dispatched across threads.
+  // Log output is not thread-safe, so states with no observations are
+  // recorded and reported after the parallel region.
+  std::vector<char> emptyStates(transition.n_cols, 0);
+
+  #pragma omp parallel for schedule(dynamic)
   for (size_t state = 0; state < transition.n_cols; state++)
   {
     // Generate full sequence of observations for this state from the list of
@@ -334,6 +387,14 @@ void HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq,
       emission[state].Train(emissions);
     }
     else
+    {
+      emptyStates[state] = 1;
+    }
+  }
+
+  for (size_t state = 0; state < transition.n_cols; state++)
+  {
+    if (emptyStates[state])
     {
       Log::Warn << "There are no observations in training data with hidden "
           << "state " << state << "!  The corresponding emission distribution "
@@ -483,7 +544,8 @@ void HMM<Distribution>::Generate(const size_t length,
  */
 template<typename Distribution>
 double HMM<Distribution>::Predict(const arma::mat& dataSeq,
-                                  arma::Row<size_t>& stateSeq) const
+                                  arma::Row<size_t>& stateSeq,
+                                  const size_t beamWidth) const
 {
   // This is an implementation of the Viterbi algorithm for finding the most
   // probable sequence of states to produce the observed data sequence.  We
@@ -521,16 +583,46 @@ double HMM<Distribution>::Predict(const arma::mat& dataSeq,
     emission[i].LogProbability(dataSeq, alias);
   }
 
+  // The number of previous-frame states considered at each step; a beam
+  // width of 0 (or any value at least the number of states) disables pruning
+  // and gives the exact Viterbi solution.
+  const size_t beam = (beamWidth == 0) ? logTransition.n_rows :
+      std::min(beamWidth, (size_t) logTransition.n_rows);
+
+  // The candidate score matrix is allocated once and reused at every time
+  // step, as is the backpointer matrix above.
+  arma::mat candidate(logTransition.n_rows, beam);
+
   for (size_t t = 1; t < dataSeq.n_cols; t++)
   {
     // Assemble the state probability for this element.
     // Given that we are in state j, we use state with the highest probability
-    // of being the previous state.
-    for (size_t j = 0; j < logTransition.n_rows; j++)
+    // of being the previous state.  The scores for all pairs of states are
+    // assembled as one matrix so the maximization runs over contiguous state
+    // vectors instead of a scalar loop per state.
+    if (beam == logTransition.n_rows)
     {
-      arma::vec prob = logStateProb.col(t - 1) + logTransition.row(j).t();
-      logStateProb(j, t) = prob.max(index) + logProbs(t, j);
-      stateSeqBack(j, t) = index;
+      candidate = logTransition;
+      candidate.each_row() += logStateProb.col(t - 1).t();
+
+      logStateProb.col(t) = arma::max(candidate, 1) + logProbs.row(t).t();
+      stateSeqBack.col(t) = arma::conv_to<arma::vec>::from(
+          arma::index_max(candidate, 1));
+    }
+    else
+    {
+      // Beam pruning: keep only the best-scoring states of the previous
+      // frame, and skip transitions out of the pruned states.
+      const arma::vec prevLogProb = logStateProb.col(t - 1);
+      const arma::uvec activeStates =
+          arma::sort_index(prevLogProb, "descend").head(beam);
+
+      candidate = logTransition.cols(activeStates);
+      candidate.each_row() += prevLogProb.elem(activeStates).t();
+
+      logStateProb.col(t) = arma::max(candidate, 1) + logProbs.row(t).t();
+      stateSeqBack.col(t) = arma::conv_to<arma::vec>::from(
+          activeStates.elem(arma::index_max(candidate, 1)));
     }
   }
 
@@ -573,6 +665,50 @@ double HMM<Distribution>::LogLikelihood(const arma::mat& dataSeq) const
   return accu(logScales);
 }
 
+/**
+ * Compute the log-likelihood of each of the given data sequences.
+ */
+template<typename Distribution>
+void HMM<Distribution>::LogLikelihood(const std::vector<arma::mat>& dataSeq,
+                                      arma::vec& logLikelihoods) const
+{
+  logLikelihoods.set_size(dataSeq.size());
+
+  // Make sure the log-space parameters are up to date before entering the
+  // parallel region, since the lazy conversion mutates shared state.
+  ConvertToLogSpace();
+
+  // Sequences are scored independently, so they are dispatched across
+  // threads; each thread reuses its own scratch buffers between the
+  // sequences it scores.
+  #pragma omp parallel
+  {
+    arma::mat forwardLog;
+    arma::vec logScales;
+    arma::mat logProbs;
+
+    #pragma omp for schedule(dynamic)
+    for (size_t seq = 0; seq < dataSeq.size(); ++seq)
+    {
+      // Evaluate each state's emission distribution over the whole sequence
+      // as one batched operation.
+      logProbs.set_size(dataSeq[seq].n_cols, logTransition.n_rows);
+      for (size_t i = 0; i < logTransition.n_rows; i++)
+      {
+        // Define alias of desired column.
+        arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
+        // Use advanced constructor for using logProbs directly.
+        emission[i].LogProbability(dataSeq[seq], alias);
+      }
+
+      Forward(dataSeq[seq], logScales, forwardLog, logProbs);
+
+      // The log-likelihood is the log of the scales for each time step.
+      logLikelihoods[seq] = accu(logScales);
+    }
+  }
+}
+
 /**
  * Compute the log of the scaling factor of the given emission probability
  * at time t. To calculate the log-likelihood for the whole sequence,
@@ -748,9 +884,12 @@ arma::vec HMM<Distribution>::ForwardAtTn(const arma::vec& emissionLogProb,
   // the probability of the previous state transitioning to the current state
   // and emitting the given observation.  To do this computation in log-space,
   // we can use LogSumExp().
+  // Broadcast the previous forward probabilities over the rows of the cached
+  // log-transition matrix; this avoids materializing a repmat() temporary,
+  // which matters when the state count is large.
   arma::vec forwardLogProb;
-  arma::mat tmp = logTransition + repmat(prevForwardLogProb.t(),
-      logTransition.n_rows, 1);
+  arma::mat tmp = logTransition;
+  tmp.each_row() += prevForwardLogProb.t();
   LogSumExp(tmp, forwardLogProb);
   forwardLogProb += emissionLogProb;
 
@@ -816,9 +955,11 @@ void HMM<Distribution>::Backward(const arma::mat& dataSeq,
     // from the current state multiplied by the probability of each of those
     // states emitting the given observation.  To compute this in log-space, we
     // can use LogSumExpT().
-    const arma::mat tmp = logTransition +
-        repmat(backwardLogProb.col(t + 1), 1, logTransition.n_cols) +
-        repmat(logProbs.row(t + 1).t(), 1, logTransition.n_cols);
+    // The backward and emission terms are broadcast over the columns of the
+    // cached log-transition matrix instead of materializing repmat()
+    // temporaries.
+    arma::mat tmp = logTransition;
+    tmp.each_col() += backwardLogProb.col(t + 1) + logProbs.row(t + 1).t();
     arma::vec alias = backwardLogProb.unsafe_col(t);
     LogSumExpT<arma::mat, true>(tmp, alias);
 
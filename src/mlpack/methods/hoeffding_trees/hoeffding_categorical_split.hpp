@@ -100,6 +100,23 @@ class HoeffdingCategoricalSplit
    */
   void Split(arma::Col<size_t>& childMajorities, SplitInfo& splitInfo);
 
+  //! Get the sufficient statistics.  Each column corresponds to a category,
+  //! and contains a count of each of the classes seen for points in that
+  //! category.
+  const arma::Mat<size_t>& Statistics() const { return sufficientStatistics; }
+
+  /**
+   * Rebind the sufficient statistics matrix onto externally owned memory, so
+   * that the counts of many splits can be laid out in one contiguous block
+   * (see HoeffdingTree::PoolCategoricalSplits()).  The given memory must hold
+   * at least `Statistics().n_elem` elements and must outlive the split; the
+   * current counts are *not* copied into it, so the caller is responsible for
+   * filling it before or after the call.
+   *
+   * @param mem Memory to rebind the sufficient statistics onto.
+   */
+  void BindStatistics(size_t* mem);
+
   //! Get the majority class seen so far.
   size_t MajorityClass() const;
   //! Get the probability of the majority class given the points seen so far.
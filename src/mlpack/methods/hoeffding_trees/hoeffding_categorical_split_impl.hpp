@@ -73,6 +73,20 @@ void HoeffdingCategoricalSplit<FitnessFunction>::Split(
   splitInfo = SplitInfo(sufficientStatistics.n_cols);
 }
 
+template<typename FitnessFunction>
+void HoeffdingCategoricalSplit<FitnessFunction>::BindStatistics(size_t* mem)
+{
+  const size_t numClasses = sufficientStatistics.n_rows;
+  const size_t numCategories = sufficientStatistics.n_cols;
+
+  // We use placement new to reinitialize the matrix, since the copy and move
+  // assignment operators in Armadillo will end up copying memory instead of
+  // making an alias.
+  sufficientStatistics.~Mat();
+  new (&sufficientStatistics) arma::Mat<size_t>(mem, numClasses,
+      numCategories, false, true);
+}
+
 template<typename FitnessFunction>
 size_t HoeffdingCategoricalSplit<FitnessFunction>::MajorityClass() const
 {
@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_TREE_HPP
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/util/sfinae_utility.hpp>
 
 #include "categorical_split_info.hpp"
 #include "numeric_split_info.hpp"
@@ -23,6 +24,7 @@
 
 #include "hoeffding_numeric_split.hpp"
 #include "binary_numeric_split.hpp"
+#include "quantile_numeric_split.hpp"
 
 #include "hoeffding_categorical_split.hpp"
 
@@ -371,6 +373,12 @@ class HoeffdingTree
   std::vector<NumericSplitType<FitnessFunction>> numericSplits;
   //! Information for splitting of categorical features (used before split).
   std::vector<CategoricalSplitType<FitnessFunction>> categoricalSplits;
+  //! Contiguous storage for the sufficient statistics of all categorical
+  //! splits of this node; each split's count matrix is an alias into a column
+  //! range of this block (see PoolCategoricalSplits()).  This keeps the
+  //! streaming Train() increments on one allocation instead of one per
+  //! dimension.
+  arma::Mat<size_t> categoricalCounts;
 
   //! This structure is owned by this node only if it is the root of the tree.
   std::unordered_map<size_t, std::pair<size_t, size_t>>* dimensionMappings;
@@ -419,6 +427,91 @@ class HoeffdingTree
                      const arma::Row<size_t>& labels,
                      const bool batchTraining);
 
+  /**
+   * Return the leaf of the (sub)tree that the given point currently falls
+   * into.  If this node is a leaf, this node is returned.
+   */
+  template<typename VecType>
+  HoeffdingTree& GetLeaf(const VecType& point);
+
+  /**
+   * Collect pointers to all of the leaves of the (sub)tree rooted here.
+   */
+  void FindLeaves(std::vector<HoeffdingTree*>& leaves);
+
+  // SFINAE check for whether the categorical split type supports rebinding
+  // its sufficient statistics onto pooled memory.
+  HAS_MEM_FUNC(BindStatistics, HasBindStatistics);
+
+  /**
+   * Gather the sufficient statistics of all categorical splits into the
+   * contiguous categoricalCounts block, preserving the current counts, and
+   * rebind each split onto its column range.  This is a no-op for categorical
+   * split types that do not implement BindStatistics().
+   */
+  template<typename SplitType = CategoricalSplitType<FitnessFunction>>
+  typename std::enable_if<HasBindStatistics<SplitType,
+      void(SplitType::*)(size_t*)>::value, void>::type
+  PoolCategoricalSplits()
+  {
+    if (categoricalSplits.empty())
+    {
+      categoricalCounts.clear();
+      return;
+    }
+
+    // Lay the count matrices out side by side in one contiguous block,
+    // preserving the counts gathered so far.
+    size_t totalCategories = 0;
+    for (size_t i = 0; i < categoricalSplits.size(); ++i)
+      totalCategories += categoricalSplits[i].Statistics().n_cols;
+
+    arma::Mat<size_t> pooled(categoricalSplits[0].Statistics().n_rows,
+        totalCategories);
+    size_t offset = 0;
+    for (size_t i = 0; i < categoricalSplits.size(); ++i)
+    {
+      const arma::Mat<size_t>& stats = categoricalSplits[i].Statistics();
+      pooled.cols(offset, offset + stats.n_cols - 1) = stats;
+      offset += stats.n_cols;
+    }
+    categoricalCounts = std::move(pooled);
+
+    RebindCategoricalSplits();
+  }
+
+  //! No-op version, for categorical split types without BindStatistics().
+  template<typename SplitType = CategoricalSplitType<FitnessFunction>>
+  typename std::enable_if<!HasBindStatistics<SplitType,
+      void(SplitType::*)(size_t*)>::value, void>::type
+  PoolCategoricalSplits() { }
+
+  /**
+   * Rebind each categorical split onto its column range of categoricalCounts
+   * without gathering.  This is used after the block has been moved from
+   * another tree: the counts are already in place, but the block may live at
+   * a different address.
+   */
+  template<typename SplitType = CategoricalSplitType<FitnessFunction>>
+  typename std::enable_if<HasBindStatistics<SplitType,
+      void(SplitType::*)(size_t*)>::value, void>::type
+  RebindCategoricalSplits()
+  {
+    size_t offset = 0;
+    for (size_t i = 0; i < categoricalSplits.size(); ++i)
+    {
+      const size_t cols = categoricalSplits[i].Statistics().n_cols;
+      categoricalSplits[i].BindStatistics(categoricalCounts.colptr(offset));
+      offset += cols;
+    }
+  }
+
+  //! No-op version, for categorical split types without BindStatistics().
+  template<typename SplitType = CategoricalSplitType<FitnessFunction>>
+  typename std::enable_if<!HasBindStatistics<SplitType,
+      void(SplitType::*)(size_t*)>::value, void>::type
+  RebindCategoricalSplits() { }
+
   /**
    * Reset the tree.  This assumes datasetInfo is set correctly.
    */
@@ -118,6 +118,8 @@ HoeffdingTree<
             numericSplitIn));
       }
     }
+
+    PoolCategoricalSplits();
   }
 }
 
@@ -188,6 +190,10 @@ HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>::
     children[i]->dimensionMappings = this->dimensionMappings;
     children[i]->ownsMappings = false;
   }
+
+  // The copied categorical splits own their own statistics; gather them back
+  // into a contiguous block.
+  PoolCategoricalSplits();
 }
 
 // Move constructor.
@@ -198,6 +204,7 @@ HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>::
     HoeffdingTree(HoeffdingTree&& other) :
     numericSplits(std::move(other.numericSplits)),
     categoricalSplits(std::move(other.categoricalSplits)),
+    categoricalCounts(std::move(other.categoricalCounts)),
     dimensionMappings(other.dimensionMappings),
     ownsMappings(true),
     numSamples(other.numSamples),
@@ -214,6 +221,10 @@ HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>::
     categoricalSplit(std::move(other.categoricalSplit)),
     numericSplit(std::move(other.numericSplit))
 {
+  // The statistics block may have moved to a new address; rebind the splits
+  // onto it.
+  RebindCategoricalSplits();
+
   // Remove pointers.
   other.dimensionMappings = nullptr;
   other.datasetInfo = nullptr;
@@ -258,6 +269,10 @@ HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>&
     categoricalSplit = other.categoricalSplit;
     numericSplit = other.numericSplit;
 
+    // The copied categorical splits own their own statistics; gather them
+    // back into a contiguous block.
+    PoolCategoricalSplits();
+
     // Copy each of the children.
     for (size_t i = 0; i < other.children.size(); ++i)
     {
@@ -288,6 +303,7 @@ HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>&
   {
     numericSplits = std::move(other.numericSplits);
     categoricalSplits = std::move(other.categoricalSplits);
+    categoricalCounts = std::move(other.categoricalCounts);
     dimensionMappings = other.dimensionMappings;
     ownsMappings = true;
     numSamples = other.numSamples;
@@ -304,6 +320,10 @@ HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>&
     categoricalSplit = std::move(other.categoricalSplit);
     numericSplit = std::move(other.numericSplit);
 
+    // The statistics block may have moved to a new address; rebind the
+    // splits onto it.
+    RebindCategoricalSplits();
+
     // Remove pointers.
     other.dimensionMappings = nullptr;
     other.datasetInfo = nullptr;
@@ -722,8 +742,19 @@ void HoeffdingTree<
 >::Classify(const MatType& data, arma::Row<size_t>& predictions) const
 {
   predictions.set_size(data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
-    predictions[i] = Classify(data.col(i));
+
+  // The tree is read-only during classification and each point writes only
+  // its own prediction, so the points are processed in blocks dispatched
+  // across threads.
+  const size_t blockSize = 256;
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < data.n_cols; block += blockSize)
+  {
+    const size_t lastCol = std::min(block + blockSize,
+        (size_t) data.n_cols) - 1;
+    for (size_t i = block; i <= lastCol; ++i)
+      predictions[i] = Classify(data.col(i));
+  }
 }
 
 //! Batch classification with probabilities.
@@ -743,8 +774,18 @@ void HoeffdingTree<
 {
   predictions.set_size(data.n_cols);
   probabilities.set_size(data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
-    Classify(data.col(i), predictions[i], probabilities[i]);
+
+  // As above, the traversal is read-only and the output writes are disjoint,
+  // so the points are processed in blocks dispatched across threads.
+  const size_t blockSize = 256;
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < data.n_cols; block += blockSize)
+  {
+    const size_t lastCol = std::min(block + blockSize,
+        (size_t) data.n_cols) - 1;
+    for (size_t i = block; i <= lastCol; ++i)
+      Classify(data.col(i), predictions[i], probabilities[i]);
+  }
 }
 
 template<
@@ -810,6 +851,7 @@ void HoeffdingTree<
   // Eliminate now-unnecessary split information.
   numericSplits.clear();
   categoricalSplits.clear();
+  categoricalCounts.clear();
 }
 
 template<
@@ -892,13 +934,22 @@ void HoeffdingTree<
     // There's no need to serialize if there's no information contained in the
     // splits.
     if (numSamples == 0)
+    {
+      if (cereal::is_loading<Archive>())
+        PoolCategoricalSplits();
       return;
+    }
 
     // Serialize numeric splits.
     ar(CEREAL_NVP(numericSplits));
 
     // Serialize categorical splits.
     ar(CEREAL_NVP(categoricalSplits));
+
+    // The loaded splits own their own statistics; gather them back into a
+    // contiguous block.
+    if (cereal::is_loading<Archive>())
+      PoolCategoricalSplits();
   }
   else
   {
@@ -924,6 +975,7 @@ void HoeffdingTree<
 
       numericSplits.clear();
       categoricalSplits.clear();
+      categoricalCounts.clear();
 
       numSamples = 0;
       numClasses = 0;
@@ -1006,9 +1058,90 @@ void HoeffdingTree<
   }
   else
   {
-    // We aren't training in batch mode; loop through the points.
-    for (size_t i = 0; i < data.n_cols; ++i)
-      Train(data.col(i), labels[i]);
+    // We aren't training in batch mode; pass the points through in stream
+    // order.  Each point only updates the statistics of the leaf it currently
+    // falls into, so the leaves can ingest their shares of the stream in
+    // parallel: the stream is processed in chunks, each chunk's points are
+    // routed to the current leaves, and then each leaf trains on its points
+    // concurrently.  A leaf that splits mid-chunk forwards its remaining
+    // points to its newly-created children, which no other thread touches, so
+    // the result is identical to sequential streaming training.
+    const size_t chunkSize = 4096;
+    std::vector<HoeffdingTree*> leaves;
+    for (size_t begin = 0; begin < data.n_cols; begin += chunkSize)
+    {
+      const size_t count = std::min(chunkSize, data.n_cols - begin);
+
+      leaves.clear();
+      FindLeaves(leaves);
+      if (leaves.size() == 1)
+      {
+        // Only one leaf (e.g. a tree that has not yet split); there is no
+        // parallelism to extract.
+        for (size_t i = begin; i < begin + count; ++i)
+          Train(data.col(i), labels[i]);
+        continue;
+      }
+
+      // Route each point in the chunk to its current leaf.
+      std::unordered_map<HoeffdingTree*, size_t> leafIndices;
+      for (size_t j = 0; j < leaves.size(); ++j)
+        leafIndices[leaves[j]] = j;
+
+      std::vector<std::vector<size_t>> leafPoints(leaves.size());
+      for (size_t i = begin; i < begin + count; ++i)
+        leafPoints[leafIndices[&GetLeaf(data.col(i))]].push_back(i);
+
+      #pragma omp parallel for schedule(dynamic)
+      for (size_t j = 0; j < leaves.size(); ++j)
+      {
+        for (size_t k = 0; k < leafPoints[j].size(); ++k)
+        {
+          leaves[j]->Train(data.col(leafPoints[j][k]),
+              labels[leafPoints[j][k]]);
+        }
+      }
+    }
+  }
+}
+
+template<
+    typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType
+>
+template<typename VecType>
+HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>&
+HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::GetLeaf(const VecType& point)
+{
+  HoeffdingTree* node = this;
+  while (node->splitDimension != size_t(-1))
+    node = node->children[node->CalculateDirection(point)];
+
+  return *node;
+}
+
+template<
+    typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType
+>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::FindLeaves(std::vector<HoeffdingTree*>& leaves)
+{
+  if (splitDimension == size_t(-1))
+    leaves.push_back(this);
+  else
+  {
+    for (size_t i = 0; i < children.size(); ++i)
+      children[i]->FindLeaves(leaves);
   }
 }
 
@@ -1052,6 +1185,8 @@ void HoeffdingTree<
     }
   }
 
+  PoolCategoricalSplits();
+
   // Clear children.
   for (size_t i = 0; i < children.size(); ++i)
     delete children[i];
@@ -0,0 +1,167 @@
+/**
+ * @file methods/hoeffding_trees/kll_sketch.hpp
+ *
+ * A simple implementation of the KLL streaming quantile sketch, used by the
+ * QuantileNumericSplit class for adaptive binning of numeric features.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HOEFFDING_TREES_KLL_SKETCH_HPP
+#define MLPACK_METHODS_HOEFFDING_TREES_KLL_SKETCH_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * The KLLSketch class implements the quantile sketch of Karnin, Lang, and
+ * Liberty:
+ *
+ * @code
+ * @inproceedings{karnin2016optimal,
+ *   title={Optimal Quantile Approximation in Streams},
+ *   author={Karnin, Z. and Lang, K. and Liberty, E.},
+ *   year={2016},
+ *   booktitle={Proceedings of the 57th Annual IEEE Symposium on Foundations
+ *       of Computer Science (FOCS '16)},
+ *   pages={71--78}
+ * }
+ * @endcode
+ *
+ * The sketch holds a hierarchy of compactor buffers; an item in the buffer at
+ * level l represents 2^l items from the stream.  When a buffer exceeds its
+ * capacity it is sorted and every other item (starting from a random offset)
+ * is promoted to the next level.  The total memory is bounded by a constant
+ * multiple of the accuracy parameter k, regardless of the stream length, and
+ * rank estimates adapt to drifting distributions because old and new items
+ * are compacted alike.
+ *
+ * @tparam ObservationType Type of the observations inserted into the sketch.
+ */
+template<typename ObservationType = double>
+class KLLSketch
+{
+ public:
+  /**
+   * Create the sketch with the given accuracy parameter.  Larger values of k
+   * give more accurate rank estimates but use more memory.
+   *
+   * @param k Accuracy parameter (capacity of the topmost compactor).
+   */
+  KLLSketch(const size_t k = 200) :
+      k(std::max(k, size_t(8))),
+      n(0)
+  {
+    levels.resize(1);
+  }
+
+  /**
+   * Insert a value from the stream into the sketch.
+   */
+  void Insert(const ObservationType value)
+  {
+    levels[0].push_back(value);
+    ++n;
+
+    // Compact the lowest over-full level, if any.
+    for (size_t l = 0; l < levels.size(); ++l)
+    {
+      if (levels[l].size() >= Capacity(l))
+      {
+        Compact(l);
+        break;
+      }
+    }
+  }
+
+  //! Get the number of values inserted into the sketch.
+  size_t NumSeen() const { return n; }
+
+  /**
+   * Estimate the number of inserted values that are less than or equal to the
+   * given value.
+   */
+  double EstimateRank(const ObservationType value) const
+  {
+    double rank = 0.0;
+    for (size_t l = 0; l < levels.size(); ++l)
+    {
+      const double weight = (double) (size_t(1) << l);
+      for (size_t i = 0; i < levels[l].size(); ++i)
+      {
+        if (levels[l][i] <= value)
+          rank += weight;
+      }
+    }
+
+    return rank;
+  }
+
+  /**
+   * Collect all items held by the sketch as (value, weight) pairs.  The
+   * weights sum to approximately the number of values inserted.
+   */
+  void Flatten(std::vector<std::pair<ObservationType, double>>& items) const
+  {
+    for (size_t l = 0; l < levels.size(); ++l)
+    {
+      const double weight = (double) (size_t(1) << l);
+      for (size_t i = 0; i < levels[l].size(); ++i)
+        items.push_back(std::make_pair(levels[l][i], weight));
+    }
+  }
+
+  //! Serialize the sketch.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(k));
+    ar(CEREAL_NVP(n));
+    ar(CEREAL_NVP(levels));
+  }
+
+ private:
+  //! The capacity of the compactor at the given level.  Lower levels get
+  //! geometrically smaller capacities, as in the KLL paper (c = 2/3).
+  size_t Capacity(const size_t level) const
+  {
+    const double c = 2.0 / 3.0;
+    const size_t depth = levels.size() - 1 - level;
+    return std::max(size_t(2), (size_t) std::ceil(k * std::pow(c, depth)));
+  }
+
+  //! Sort the given level and promote every other item to the next level.
+  void Compact(const size_t level)
+  {
+    if (level == levels.size() - 1)
+      levels.resize(levels.size() + 1);
+
+    std::vector<ObservationType>& buffer = levels[level];
+    std::sort(buffer.begin(), buffer.end());
+
+    // If the buffer holds an odd number of items, the last (largest) one
+    // stays at this level.
+    const size_t numPairs = buffer.size() / 2;
+    const size_t offset = (size_t) RandInt(2);
+    for (size_t i = 0; i < numPairs; ++i)
+      levels[level + 1].push_back(buffer[2 * i + offset]);
+
+    if (buffer.size() % 2 == 1)
+      buffer[0] = buffer[buffer.size() - 1];
+    buffer.resize(buffer.size() % 2);
+  }
+
+  //! The accuracy parameter (capacity of the topmost compactor).
+  size_t k;
+  //! The number of values inserted so far.
+  size_t n;
+  //! The compactor buffers; an item at level l has weight 2^l.
+  std::vector<std::vector<ObservationType>> levels;
+};
+
+} // namespace mlpack
+
+#endif
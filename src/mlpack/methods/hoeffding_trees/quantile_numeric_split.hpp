@@ -0,0 +1,150 @@
+/**
+ * @file methods/hoeffding_trees/quantile_numeric_split.hpp
+ *
+ * A numeric feature split for Hoeffding trees that bins observations at
+ * quantiles estimated by a streaming sketch, so the bins adapt to the stream
+ * instead of being fixed from the first observations.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HOEFFDING_TREES_QUANTILE_NUMERIC_SPLIT_HPP
+#define MLPACK_METHODS_HOEFFDING_TREES_QUANTILE_NUMERIC_SPLIT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "numeric_split_info.hpp"
+#include "kll_sketch.hpp"
+
+namespace mlpack {
+
+/**
+ * The QuantileNumericSplit class discretizes a numeric feature like the
+ * HoeffdingNumericSplit class does, but instead of fixing equal-width bins
+ * from the first observations, it maintains one KLL quantile sketch per class
+ * and places the bin boundaries at quantiles of the observed distribution.
+ * This has two advantages over the fixed-bin strategy: the memory use is
+ * bounded regardless of the stream length, and the bins follow the stream, so
+ * a distribution that drifts away from the initially-observed range is still
+ * binned sensibly.
+ *
+ * The per-sample cost of Train() is a constant-amortized-time sketch
+ * insertion; the sufficient statistics for the fitness function are
+ * reconstructed from the sketches only when a split check is performed.
+ *
+ * @tparam FitnessFunction Fitness function to use for calculating gain.
+ * @tparam ObservationType Type of observations in this dimension.
+ */
+template<typename FitnessFunction,
+         typename ObservationType = double>
+class QuantileNumericSplit
+{
+ public:
+  //! The splitting information type required by the QuantileNumericSplit.
+  typedef NumericSplitInfo<ObservationType> SplitInfo;
+
+  /**
+   * Create the QuantileNumericSplit class, and specify some basic parameters
+   * about how the binning should take place.
+   *
+   * @param numClasses Number of classes.
+   * @param bins Number of bins.
+   * @param sketchAccuracy Accuracy parameter of the per-class quantile
+   *      sketches; larger values give more accurate bin placement but use
+   *      more memory.
+   */
+  QuantileNumericSplit(const size_t numClasses = 0,
+                       const size_t bins = 10,
+                       const size_t sketchAccuracy = 200);
+
+  /**
+   * Create the QuantileNumericSplit class, using the parameters from the
+   * given other split object.
+   */
+  QuantileNumericSplit(const size_t numClasses,
+                       const QuantileNumericSplit& other);
+
+  /**
+   * Train the QuantileNumericSplit on the given observed value (remember that
+   * this object only cares about the information for a single feature, not an
+   * entire point).
+   *
+   * @param value Value in the dimension that this QuantileNumericSplit refers
+   *      to.
+   * @param label Label of the given point.
+   */
+  void Train(ObservationType value, const size_t label);
+
+  /**
+   * Evaluate the fitness function given the sketches built so far.  If only a
+   * few samples have been seen, 0 will be returned (i.e. no gain).  Because
+   * this split can only split one possible way, secondBestFitness (the
+   * fitness function for the second best possible split) will be set to 0.
+   *
+   * @param bestFitness Value of the fitness function for the best possible
+   *      split.
+   * @param secondBestFitness Value of the fitness function for the second
+   *      best possible split (always 0 for this split).
+   */
+  void EvaluateFitnessFunction(double& bestFitness, double& secondBestFitness)
+      const;
+
+  //! Return the number of children if this node splits on this feature.
+  size_t NumChildren() const { return bins; }
+
+  /**
+   * Return the majority class of each child to be created, if a split on this
+   * dimension was performed.  Also create the split object.
+   */
+  void Split(arma::Col<size_t>& childMajorities, SplitInfo& splitInfo) const;
+
+  //! Return the majority class.
+  size_t MajorityClass() const;
+  //! Return the probability of the majority class.
+  double MajorityProbability() const;
+
+  //! Return the number of bins.
+  size_t Bins() const { return bins; }
+
+  //! Serialize the object.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Compute the bin boundaries (length bins - 1) as quantiles of the combined
+   * distribution held by the per-class sketches.
+   */
+  void BinBoundaries(arma::Col<ObservationType>& boundaries) const;
+
+  /**
+   * Estimate the per-class bin counts for the given boundaries from the
+   * per-class sketches.
+   */
+  void EstimateStatistics(const arma::Col<ObservationType>& boundaries,
+                          arma::Mat<size_t>& statistics) const;
+
+  //! One quantile sketch for the values of each class.
+  std::vector<KLLSketch<ObservationType>> classSketches;
+  //! The exact number of points seen of each class.
+  arma::Col<size_t> classCounts;
+  //! The number of bins.
+  size_t bins;
+  //! The accuracy parameter for the per-class sketches.
+  size_t sketchAccuracy;
+  //! The number of samples seen so far.
+  size_t samplesSeen;
+};
+
+//! Convenience typedef.
+template<typename FitnessFunction>
+using QuantileDoubleNumericSplit = QuantileNumericSplit<FitnessFunction,
+    double>;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "quantile_numeric_split_impl.hpp"
+
+#endif
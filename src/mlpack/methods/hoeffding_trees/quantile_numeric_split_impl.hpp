@@ -0,0 +1,197 @@
+/**
+ * @file methods/hoeffding_trees/quantile_numeric_split_impl.hpp
+ *
+ * An implementation of the QuantileNumericSplit class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HOEFFDING_TREES_QUANTILE_NUMERIC_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_HOEFFDING_TREES_QUANTILE_NUMERIC_SPLIT_IMPL_HPP
+
+#include "quantile_numeric_split.hpp"
+
+namespace mlpack {
+
+template<typename FitnessFunction, typename ObservationType>
+QuantileNumericSplit<FitnessFunction, ObservationType>::QuantileNumericSplit(
+    const size_t numClasses,
+    const size_t bins,
+    const size_t sketchAccuracy) :
+    classSketches(numClasses, KLLSketch<ObservationType>(sketchAccuracy)),
+    classCounts(arma::zeros<arma::Col<size_t>>(numClasses)),
+    bins(bins),
+    sketchAccuracy(sketchAccuracy),
+    samplesSeen(0)
+{
+  // Nothing to do.
+}
+
+template<typename FitnessFunction, typename ObservationType>
+QuantileNumericSplit<FitnessFunction, ObservationType>::QuantileNumericSplit(
+    const size_t numClasses,
+    const QuantileNumericSplit& other) :
+    classSketches(numClasses, KLLSketch<ObservationType>(
+        other.sketchAccuracy)),
+    classCounts(arma::zeros<arma::Col<size_t>>(numClasses)),
+    bins(other.bins),
+    sketchAccuracy(other.sketchAccuracy),
+    samplesSeen(0)
+{
+  // Nothing to do.
+}
+
+template<typename FitnessFunction, typename ObservationType>
+void QuantileNumericSplit<FitnessFunction, ObservationType>::Train(
+    ObservationType value,
+    const size_t label)
+{
+  classSketches[label].Insert(value);
+  classCounts[label]++;
+  ++samplesSeen;
+}
+
+template<typename FitnessFunction, typename ObservationType>
+void QuantileNumericSplit<FitnessFunction, ObservationType>::
+    EvaluateFitnessFunction(double& bestFitness,
+                            double& secondBestFitness) const
+{
+  secondBestFitness = 0.0; // We can only split one way.
+
+  // Don't evaluate anything until at least a few points per bin have been
+  // seen; the quantile estimates are meaningless before that.
+  if (samplesSeen < 2 * bins)
+  {
+    bestFitness = 0.0;
+    return;
+  }
+
+  arma::Col<ObservationType> boundaries;
+  BinBoundaries(boundaries);
+
+  arma::Mat<size_t> statistics;
+  EstimateStatistics(boundaries, statistics);
+
+  bestFitness = FitnessFunction::Evaluate(statistics);
+}
+
+template<typename FitnessFunction, typename ObservationType>
+void QuantileNumericSplit<FitnessFunction, ObservationType>::Split(
+    arma::Col<size_t>& childMajorities,
+    SplitInfo& splitInfo) const
+{
+  arma::Col<ObservationType> boundaries;
+  BinBoundaries(boundaries);
+
+  arma::Mat<size_t> statistics;
+  EstimateStatistics(boundaries, statistics);
+
+  childMajorities.set_size(statistics.n_cols);
+  for (size_t i = 0; i < statistics.n_cols; ++i)
+  {
+    arma::uword maxIndex = 0;
+    statistics.unsafe_col(i).max(maxIndex);
+    childMajorities[i] = size_t(maxIndex);
+  }
+
+  // Create the SplitInfo object.
+  splitInfo = SplitInfo(boundaries);
+}
+
+template<typename FitnessFunction, typename ObservationType>
+size_t QuantileNumericSplit<FitnessFunction, ObservationType>::
+    MajorityClass() const
+{
+  arma::uword maxIndex = 0;
+  classCounts.max(maxIndex);
+  return size_t(maxIndex);
+}
+
+template<typename FitnessFunction, typename ObservationType>
+double QuantileNumericSplit<FitnessFunction, ObservationType>::
+    MajorityProbability() const
+{
+  if (samplesSeen == 0)
+    return 0.0;
+
+  return double(classCounts.max()) / double(samplesSeen);
+}
+
+template<typename FitnessFunction, typename ObservationType>
+void QuantileNumericSplit<FitnessFunction, ObservationType>::BinBoundaries(
+    arma::Col<ObservationType>& boundaries) const
+{
+  // Collect the weighted items of all of the per-class sketches; together
+  // they sketch the combined distribution of the feature.
+  std::vector<std::pair<ObservationType, double>> items;
+  for (size_t c = 0; c < classSketches.size(); ++c)
+    classSketches[c].Flatten(items);
+  std::sort(items.begin(), items.end());
+
+  double totalWeight = 0.0;
+  for (size_t i = 0; i < items.size(); ++i)
+    totalWeight += items[i].second;
+
+  // Place the boundaries at the (b / bins)-quantiles of the combined
+  // distribution.
+  boundaries.set_size(bins - 1);
+  size_t current = 0;
+  double cumulative = 0.0;
+  for (size_t b = 0; b < bins - 1; ++b)
+  {
+    const double target = (totalWeight * (b + 1)) / bins;
+    while (current < items.size() - 1 &&
+        cumulative + items[current].second < target)
+    {
+      cumulative += items[current].second;
+      ++current;
+    }
+
+    boundaries[b] = items[current].first;
+  }
+}
+
+template<typename FitnessFunction, typename ObservationType>
+void QuantileNumericSplit<FitnessFunction, ObservationType>::
+    EstimateStatistics(const arma::Col<ObservationType>& boundaries,
+                       arma::Mat<size_t>& statistics) const
+{
+  statistics.zeros(classCounts.n_elem, bins);
+  for (size_t c = 0; c < classCounts.n_elem; ++c)
+  {
+    // The count of class c in bin b is the difference of the estimated ranks
+    // of the bin's boundaries in class c's sketch.  Ranks are clamped to be
+    // monotone so that estimation error cannot produce negative counts.
+    double previousRank = 0.0;
+    for (size_t b = 0; b < bins - 1; ++b)
+    {
+      double rank = classSketches[c].EstimateRank(boundaries[b]);
+      rank = std::min(std::max(rank, previousRank),
+          (double) classCounts[c]);
+      statistics(c, b) = (size_t) std::round(rank - previousRank);
+      previousRank = rank;
+    }
+
+    statistics(c, bins - 1) =
+        (size_t) std::round((double) classCounts[c] - previousRank);
+  }
+}
+
+template<typename FitnessFunction, typename ObservationType>
+template<typename Archive>
+void QuantileNumericSplit<FitnessFunction, ObservationType>::serialize(
+    Archive& ar,
+    const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(classSketches));
+  ar(CEREAL_NVP(classCounts));
+  ar(CEREAL_NVP(bins));
+  ar(CEREAL_NVP(sketchAccuracy));
+  ar(CEREAL_NVP(samplesSeen));
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,115 @@
+/**
+ * @file methods/kde/checkpointed_kde.hpp
+ * @author Roberto Hueso
+ *
+ * Checkpoint/resume support for long KDE jobs.  Density estimation is
+ * independent per query point, so the query set can be evaluated in blocks
+ * with the completed estimations saved to disk after each block; a killed
+ * job rerun with the same arguments picks up at the last completed block.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KDE_CHECKPOINTED_KDE_HPP
+#define MLPACK_METHODS_KDE_CHECKPOINTED_KDE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <cstdio>
+
+namespace mlpack {
+
+/**
+ * Evaluate a KDE model over a query set with periodic checkpointing.  Blocks
+ * of blockSize query points are evaluated one at a time (building a query
+ * tree per block), and the estimations completed so far are written
+ * atomically to checkpointFile after each block.  An existing checkpoint for
+ * the same number of query points is resumed from; a mismatched one is
+ * ignored with a warning, and the file is removed when evaluation finishes.
+ *
+ * At most one block of traversal work can be lost to a preemption.  Resuming
+ * with a different reference set, kernel, or error tolerance is not
+ * detected; the caller must rerun with the same model.
+ *
+ * @param kde KDE model to evaluate with (already trained).
+ * @param querySet Set of query points.
+ * @param estimations Vector to store density estimations in.
+ * @param checkpointFile File to write checkpoints to (and resume from).
+ * @param blockSize Number of query points to evaluate between checkpoints.
+ */
+template<typename KDEType, typename MatType>
+void CheckpointedEvaluate(
+    KDEType& kde,
+    const MatType& querySet,
+    arma::vec& estimations,
+    const std::string& checkpointFile,
+    const size_t blockSize = 10000)
+{
+  const size_t numQueries = querySet.n_cols;
+  estimations.set_size(numQueries);
+  size_t done = 0;
+
+  // Load any existing checkpoint.
+  {
+    std::ifstream ifs(checkpointFile, std::ios::binary);
+    if (ifs.is_open())
+    {
+      try
+      {
+        cereal::BinaryInputArchive ar(ifs);
+        size_t savedQueries, savedDone;
+        arma::vec savedEstimations;
+        ar(savedQueries, savedDone, savedEstimations);
+
+        if (savedQueries == numQueries && savedDone <= numQueries)
+        {
+          estimations = std::move(savedEstimations);
+          done = savedDone;
+          Log::Info << "CheckpointedEvaluate(): resuming from '"
+              << checkpointFile << "' with " << done << " of " << numQueries
+              << " query points already complete." << std::endl;
+        }
+        else
+        {
+          Log::Warn << "CheckpointedEvaluate(): checkpoint '"
+              << checkpointFile << "' was written for " << savedQueries
+              << " query points; ignoring it." << std::endl;
+        }
+      }
+      catch (const std::exception&)
+      {
+        Log::Warn << "CheckpointedEvaluate(): could not read checkpoint '"
+            << checkpointFile << "'; starting from the beginning."
+            << std::endl;
+      }
+    }
+  }
+
+  const std::string tmpFile = checkpointFile + ".tmp";
+  while (done < numQueries)
+  {
+    const size_t lastCol = std::min(done + blockSize, numQueries) - 1;
+
+    arma::vec blockEstimations;
+    kde.Evaluate(MatType(querySet.cols(done, lastCol)), blockEstimations);
+    estimations.subvec(done, lastCol) = blockEstimations;
+    done = lastCol + 1;
+
+    // Temporary file plus rename, so a preemption mid-write cannot leave a
+    // truncated checkpoint.
+    {
+      std::ofstream ofs(tmpFile, std::ios::binary | std::ios::trunc);
+      cereal::BinaryOutputArchive ar(ofs);
+      ar(numQueries, done, estimations);
+    }
+    std::rename(tmpFile.c_str(), checkpointFile.c_str());
+  }
+
+  std::remove(checkpointFile.c_str());
+}
+
+} // namespace mlpack
+
+#endif
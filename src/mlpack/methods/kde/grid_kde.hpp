@@ -0,0 +1,148 @@
+/**
+ * @file methods/kde/grid_kde.hpp
+ *
+ * Grid-based (binned) kernel density estimation for low-dimensional data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KDE_GRID_KDE_HPP
+#define MLPACK_METHODS_KDE_GRID_KDE_HPP
+
+#include <mlpack/core.hpp>
+
+#include "kde.hpp"
+
+namespace mlpack {
+
+/**
+ * The GridKDE class implements kernel density estimation by binning instead of
+ * tree traversal.  The reference points are spread over a regular grid with
+ * linear (multilinear) binning, the binned masses are smoothed with a
+ * truncated separable convolution of the kernel along each axis, and query
+ * densities are read off the smoothed grid with multilinear interpolation.
+ *
+ * Training is O(n), evaluation is O(m) plus one pass over the grid per
+ * dimension, so for low-dimensional data (the grid grows exponentially with
+ * the dimension, so this is intended for 1--3 dimensions) this is typically
+ * orders of magnitude faster than the tree-based KDE class.  The cost is that
+ * the result carries a small binning error controlled by the grid spacing,
+ * which is fixed at a quarter of the kernel bandwidth; the kernel tails are
+ * truncated where they drop below the relative error tolerance.
+ *
+ * Only kernels that are separable across dimensions as a product of
+ * one-dimensional evaluations of the per-axis offsets---i.e. the Gaussian
+ * kernel---are supported, since the grid smoothing convolves each axis
+ * independently.
+ *
+ * @tparam KernelType The (separable) kernel to use; only GaussianKernel is
+ *     valid.
+ */
+template<typename KernelType = GaussianKernel>
+class GridKDE
+{
+ public:
+  /**
+   * Initialize the GridKDE object.
+   *
+   * @param relError Relative error tolerance; this controls where the kernel
+   *      tails are truncated.
+   * @param absError Absolute error tolerance (stored for interface
+   *      compatibility with KDE; the grid error is governed by the spacing).
+   * @param kernel Instantiated kernel.
+   */
+  GridKDE(const double relError = KDEDefaultParams::relError,
+          const double absError = KDEDefaultParams::absError,
+          const KernelType& kernel = KernelType());
+
+  /**
+   * Build the binned density grid for the given reference set.
+   *
+   * @param referenceSet Set of reference points.
+   */
+  void Train(arma::mat referenceSet);
+
+  /**
+   * Estimate the density of each query point by interpolating the smoothed
+   * grid.  Estimations are unnormalized, matching KDE::Evaluate().
+   *
+   * @param querySet Set of query points.
+   * @param estimations Vector where the densities will be written.
+   */
+  void Evaluate(const arma::mat& querySet, arma::vec& estimations) const;
+
+  /**
+   * Estimate the density of each reference point (monochromatic case).
+   *
+   * @param estimations Vector where the densities will be written.
+   */
+  void Evaluate(arma::vec& estimations) const;
+
+  //! Get the kernel.
+  const KernelType& Kernel() const { return kernel; }
+  //! Modify the kernel.
+  KernelType& Kernel() { return kernel; }
+
+  //! Get the relative error tolerance.
+  double RelativeError() const { return relError; }
+  //! Modify the relative error tolerance.
+  void RelativeError(const double newRelError) { relError = newRelError; }
+
+  //! Get the absolute error tolerance.
+  double AbsoluteError() const { return absError; }
+  //! Modify the absolute error tolerance.
+  void AbsoluteError(const double newAbsError) { absError = newAbsError; }
+
+  //! Get the reference set.
+  const arma::mat& ReferenceSet() const { return referenceSet; }
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! The kernel.
+  KernelType kernel;
+
+  //! Relative error tolerance.
+  double relError;
+  //! Absolute error tolerance (kept for interface compatibility).
+  double absError;
+
+  //! The reference set (needed for the monochromatic evaluation).
+  arma::mat referenceSet;
+
+  //! Whether the grid has been built.
+  bool trained;
+
+  //! Lowest corner of the (padded) grid.
+  arma::vec origin;
+  //! Side length of the grid cells.
+  double spacing;
+  //! Number of grid nodes along each dimension.
+  arma::Col<size_t> gridDims;
+  //! Flattened-index stride of each dimension.
+  arma::Col<size_t> strides;
+  //! The smoothed density grid (flattened).
+  arma::vec densityGrid;
+
+  /**
+   * Bin the reference points and smooth the grid with the kernel.
+   */
+  void BuildGrid();
+
+  /**
+   * Interpolate the density of a single point from the smoothed grid.
+   */
+  template<typename VecType>
+  double Interpolate(const VecType& point) const;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "grid_kde_impl.hpp"
+
+#endif
@@ -0,0 +1,235 @@
+/**
+ * @file methods/kde/grid_kde_impl.hpp
+ *
+ * Implementation of the GridKDE class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KDE_GRID_KDE_IMPL_HPP
+#define MLPACK_METHODS_KDE_GRID_KDE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "grid_kde.hpp"
+
+namespace mlpack {
+
+template<typename KernelType>
+GridKDE<KernelType>::GridKDE(const double relError,
+                             const double absError,
+                             const KernelType& kernel) :
+    kernel(kernel),
+    relError(relError),
+    absError(absError),
+    trained(false),
+    spacing(0.0)
+{
+  static_assert(std::is_same<KernelType, GaussianKernel>::value,
+      "GridKDE requires a kernel that is separable across dimensions; only "
+      "GaussianKernel is supported");
+}
+
+template<typename KernelType>
+void GridKDE<KernelType>::Train(arma::mat referenceSet)
+{
+  if (referenceSet.n_cols == 0)
+  {
+    throw std::invalid_argument("cannot train GridKDE model: reference set "
+                                "is empty");
+  }
+
+  this->referenceSet = std::move(referenceSet);
+
+  if (this->referenceSet.n_rows > 3)
+  {
+    Log::Warn << "GridKDE: the grid grows exponentially with the dimension; "
+        << this->referenceSet.n_rows << "-dimensional data is likely to be "
+        << "faster (and smaller) with tree-based KDE." << std::endl;
+  }
+
+  BuildGrid();
+  trained = true;
+}
+
+template<typename KernelType>
+void GridKDE<KernelType>::BuildGrid()
+{
+  const size_t dims = referenceSet.n_rows;
+  const double bandwidth = kernel.Bandwidth();
+
+  // A quarter of the bandwidth keeps the binning error well below typical
+  // statistical error.  The kernel tails are cut where they fall below the
+  // relative error tolerance.
+  spacing = bandwidth / 4.0;
+  const double tolerance = std::max(relError, 1e-8);
+  const double cutoff = bandwidth * std::sqrt(2.0 * std::log(1.0 / tolerance));
+  const size_t pad = (size_t) std::ceil(cutoff / spacing);
+
+  const arma::vec mins = arma::min(referenceSet, 1);
+  const arma::vec maxs = arma::max(referenceSet, 1);
+  origin = mins - pad * spacing;
+
+  gridDims.set_size(dims);
+  strides.set_size(dims);
+  size_t total = 1;
+  for (size_t d = 0; d < dims; ++d)
+  {
+    gridDims[d] = (size_t) std::floor((maxs[d] - mins[d]) / spacing) + 2 +
+        2 * pad;
+    strides[d] = total;
+    total *= gridDims[d];
+  }
+
+  // Spread each reference point over the 2^d surrounding grid nodes with
+  // multilinear (linear binning) weights.
+  densityGrid.zeros(total);
+  arma::Col<size_t> base(dims);
+  arma::vec frac(dims);
+  for (size_t i = 0; i < referenceSet.n_cols; ++i)
+  {
+    for (size_t d = 0; d < dims; ++d)
+    {
+      const double position = (referenceSet(d, i) - origin[d]) / spacing;
+      base[d] = (size_t) std::floor(position);
+      frac[d] = position - (double) base[d];
+    }
+
+    for (size_t corner = 0; corner < ((size_t) 1 << dims); ++corner)
+    {
+      double weight = 1.0;
+      size_t index = 0;
+      for (size_t d = 0; d < dims; ++d)
+      {
+        const bool high = (corner >> d) & 1;
+        weight *= high ? frac[d] : (1.0 - frac[d]);
+        index += (base[d] + (high ? 1 : 0)) * strides[d];
+      }
+      densityGrid[index] += weight;
+    }
+  }
+
+  // Smooth the binned masses with the kernel, one axis at a time.  For a
+  // separable kernel the product of the per-axis convolutions equals the
+  // full d-dimensional kernel of the Euclidean offset.
+  arma::vec taps(2 * pad + 1);
+  for (size_t k = 0; k < taps.n_elem; ++k)
+  {
+    const double offset = ((double) k - (double) pad) * spacing;
+    taps[k] = kernel.Evaluate(std::abs(offset));
+  }
+
+  for (size_t d = 0; d < dims; ++d)
+  {
+    arma::vec smoothed(total, arma::fill::zeros);
+
+    #pragma omp parallel for
+    for (size_t index = 0; index < total; ++index)
+    {
+      const size_t coord = (index / strides[d]) % gridDims[d];
+      const size_t kMin = (coord < pad) ? (pad - coord) : 0;
+      const size_t kMax = std::min(taps.n_elem,
+          gridDims[d] - coord + pad);
+
+      double value = 0.0;
+      for (size_t k = kMin; k < kMax; ++k)
+      {
+        const ptrdiff_t offset = ((ptrdiff_t) k - (ptrdiff_t) pad) *
+            (ptrdiff_t) strides[d];
+        value += taps[k] * densityGrid[index + offset];
+      }
+      smoothed[index] = value;
+    }
+
+    densityGrid = std::move(smoothed);
+  }
+
+  densityGrid /= (double) referenceSet.n_cols;
+}
+
+template<typename KernelType>
+template<typename VecType>
+double GridKDE<KernelType>::Interpolate(const VecType& point) const
+{
+  const size_t dims = referenceSet.n_rows;
+
+  // Points outside the padded grid have density below the truncation
+  // tolerance.
+  arma::Col<size_t> base(dims);
+  arma::vec frac(dims);
+  for (size_t d = 0; d < dims; ++d)
+  {
+    const double position = (point[d] - origin[d]) / spacing;
+    if (position < 0.0 || position >= (double) (gridDims[d] - 1))
+      return 0.0;
+
+    base[d] = (size_t) std::floor(position);
+    frac[d] = position - (double) base[d];
+  }
+
+  double estimation = 0.0;
+  for (size_t corner = 0; corner < ((size_t) 1 << dims); ++corner)
+  {
+    double weight = 1.0;
+    size_t index = 0;
+    for (size_t d = 0; d < dims; ++d)
+    {
+      const bool high = (corner >> d) & 1;
+      weight *= high ? frac[d] : (1.0 - frac[d]);
+      index += (base[d] + (high ? 1 : 0)) * strides[d];
+    }
+    estimation += weight * densityGrid[index];
+  }
+
+  return estimation;
+}
+
+template<typename KernelType>
+void GridKDE<KernelType>::Evaluate(const arma::mat& querySet,
+                                   arma::vec& estimations) const
+{
+  if (!trained)
+  {
+    throw std::runtime_error("cannot evaluate GridKDE model: model needs to "
+                             "be trained before evaluation");
+  }
+
+  if (querySet.n_rows != referenceSet.n_rows)
+  {
+    throw std::invalid_argument("cannot evaluate GridKDE model: querySet and "
+                                "referenceSet dimensions don't match");
+  }
+
+  estimations.set_size(querySet.n_cols);
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
+    estimations[i] = Interpolate(querySet.col(i));
+}
+
+template<typename KernelType>
+void GridKDE<KernelType>::Evaluate(arma::vec& estimations) const
+{
+  Evaluate(referenceSet, estimations);
+}
+
+template<typename KernelType>
+template<typename Archive>
+void GridKDE<KernelType>::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(kernel));
+  ar(CEREAL_NVP(relError));
+  ar(CEREAL_NVP(absError));
+  ar(CEREAL_NVP(referenceSet));
+  ar(CEREAL_NVP(trained));
+  ar(CEREAL_NVP(origin));
+  ar(CEREAL_NVP(spacing));
+  ar(CEREAL_NVP(gridDims));
+  ar(CEREAL_NVP(strides));
+  ar(CEREAL_NVP(densityGrid));
+}
+
+} // namespace mlpack
+
+#endif
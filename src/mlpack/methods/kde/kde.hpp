@@ -220,6 +220,51 @@ class KDE
    */
   void Evaluate(arma::vec& estimations);
 
+  /**
+   * Estimate density of each point in the query set for several kernels at
+   * once (e.g. several candidate bandwidths during bandwidth selection).
+   * Distance calculations and tree traversal are shared by all the kernels,
+   * so this is much cheaper than one Evaluate() call per kernel; in exchange,
+   * a node combination is only pruned when every kernel allows it, so the
+   * kernel with the loosest bound governs pruning.  Estimations might not be
+   * normalized.
+   *
+   * - Dimension of each point in the query set must match the dimension of
+   *   each point in the reference set.
+   *
+   * - Monte Carlo estimations are not used, regardless of the model settings.
+   *
+   * @pre The model has to be previously trained.
+   * @param querySet Set of query points to get the density of.
+   * @param kernels Kernels to evaluate the density with.
+   * @param estimations Matrix which will hold the density of each query
+   *                    point; one row per kernel and one column per query
+   *                    point.
+   */
+  void Evaluate(MatType querySet,
+                std::vector<KernelType> kernels,
+                arma::mat& estimations);
+
+  /**
+   * Estimate density of each point in the reference set for several kernels
+   * at once (e.g. several candidate bandwidths during bandwidth selection).
+   * It does not compute the estimation of a point with itself, so each
+   * estimate is a leave-one-out density.  Tree traversal and distance
+   * calculations are shared by all the kernels, so this is much cheaper than
+   * one Evaluate() call per kernel; in exchange, a node combination is only
+   * pruned when every kernel allows it, so the kernel with the loosest bound
+   * governs pruning.  Estimations might not be normalized.
+   *
+   * - Monte Carlo estimations are not used, regardless of the model settings.
+   *
+   * @pre The model has to be previously trained.
+   * @param kernels Kernels to evaluate the density with.
+   * @param estimations Matrix which will hold the density of each reference
+   *                    point; one row per kernel and one column per reference
+   *                    point.
+   */
+  void Evaluate(std::vector<KernelType> kernels, arma::mat& estimations);
+
   //! Get the kernel.
   const KernelType& Kernel() const { return kernel; }
 
@@ -354,4 +399,10 @@ class KDE
 // Include implementation.
 #include "kde_impl.hpp"
 
+// Include the grid-based (binned) evaluator for low-dimensional data.
+#include "grid_kde.hpp"
+
+// Include the checkpointing evaluation helper.
+#include "checkpointed_kde.hpp"
+
 #endif // MLPACK_METHODS_KDE_KDE_HPP
@@ -498,7 +498,8 @@ Evaluate(Tree* queryTree,
   }
 
   // Clean accumulated alpha if Monte Carlo estimations are available.
-  if (monteCarlo && std::is_same<KernelType, GaussianKernel>::value)
+  if (monteCarlo &&
+      KDERules<MetricType, KernelType, Tree>::kernelSupportsMonteCarlo)
   {
     KDECleanRules<Tree> cleanRules;
     SingleTreeTraversalType<KDECleanRules<Tree>> cleanTraverser(cleanRules);
@@ -507,30 +508,115 @@ Evaluate(Tree* queryTree,
 
   // Evaluate.
   typedef KDERules<MetricType, KernelType, Tree> RuleType;
-  RuleType rules = RuleType(referenceTree->Dataset(),
-                            queryTree->Dataset(),
-                            estimations,
-                            relError,
-                            absError,
-                            mcProb,
-                            initialSampleSize,
-                            mcEntryCoef,
-                            mcBreakCoef,
-                            metric,
-                            kernel,
-                            monteCarlo,
-                            false);
 
-  // Create traverser.
-  DualTreeTraversalType<RuleType> traverser(rules);
-  traverser.Traverse(*queryTree, *referenceTree);
+  size_t numThreads = 1;
+  #ifdef MLPACK_USE_OPENMP
+    numThreads = (size_t) omp_get_max_threads();
+  #endif
+
+  // The Monte Carlo path mutates reference-tree statistics (per-node alpha
+  // budgets) during traversal, so the reference tree cannot be shared between
+  // threads; that path stays serial.
+  const bool mcActive = monteCarlo &&
+      KDERules<MetricType, KernelType, Tree>::kernelSupportsMonteCarlo;
+
+  size_t scores = 0;
+  size_t baseCases = 0;
+  if (numThreads == 1 || mcActive)
+  {
+    RuleType rules = RuleType(referenceTree->Dataset(),
+                              queryTree->Dataset(),
+                              estimations,
+                              relError,
+                              absError,
+                              mcProb,
+                              initialSampleSize,
+                              mcEntryCoef,
+                              mcBreakCoef,
+                              metric,
+                              kernel,
+                              monteCarlo,
+                              false);
+
+    // Create traverser.
+    DualTreeTraversalType<RuleType> traverser(rules);
+    traverser.Traverse(*queryTree, *referenceTree);
+    scores = rules.Scores();
+    baseCases = rules.BaseCases();
+  }
+  else
+  {
+    // Expand the query tree breadth-first into a frontier of disjoint
+    // subtrees, oversubscribing the thread count so that dynamic scheduling
+    // can balance subtrees of unequal cost.
+    const size_t targetTasks = 8 * numThreads;
+    std::vector<Tree*> tasks;
+    tasks.push_back(queryTree);
+    while (tasks.size() < targetTasks)
+    {
+      std::vector<Tree*> next;
+      bool anySplit = false;
+      for (size_t i = 0; i < tasks.size(); ++i)
+      {
+        if (tasks[i]->NumChildren() == 0)
+        {
+          next.push_back(tasks[i]);
+          continue;
+        }
+
+        anySplit = true;
+        for (size_t c = 0; c < tasks[i]->NumChildren(); ++c)
+          next.push_back(&tasks[i]->Child(c));
+      }
+      tasks = std::move(next);
+
+      if (!anySplit)
+        break;
+    }
+
+    // Each thread traverses its subtrees with its own rule set and density
+    // accumulator, and the partial densities are summed at the end (kernel
+    // contributions are additive).  Every query point belongs to exactly one
+    // subtree, so its density---and the relative/absolute error guarantee on
+    // it---is produced entirely by a single rule set.
+    #pragma omp parallel
+    {
+      arma::vec threadEstimations(estimations.n_elem, arma::fill::zeros);
+      RuleType threadRules = RuleType(referenceTree->Dataset(),
+                                      queryTree->Dataset(),
+                                      threadEstimations,
+                                      relError,
+                                      absError,
+                                      mcProb,
+                                      initialSampleSize,
+                                      mcEntryCoef,
+                                      mcBreakCoef,
+                                      metric,
+                                      kernel,
+                                      monteCarlo,
+                                      false);
+      DualTreeTraversalType<RuleType> traverser(threadRules);
+
+      #pragma omp for schedule(dynamic)
+      for (size_t i = 0; i < (size_t) tasks.size(); ++i)
+        traverser.Traverse(*tasks[i], *referenceTree);
+
+      #pragma omp critical
+      {
+        estimations += threadEstimations;
+        scores += threadRules.Scores();
+        baseCases += threadRules.BaseCases();
+      }
+    }
+  }
+
   estimations /= referenceTree->Dataset().n_cols;
 
   // Rearrange if necessary.
   RearrangeEstimations(oldFromNewQueries, estimations);
 
-  Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
-  Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
+  Log::Info << scores << " node combinations were scored." << std::endl;
+  Log::Info << baseCases << " base cases were calculated." << std::endl;
 }
 
 template<typename KernelType,
@@ -562,7 +648,8 @@ Evaluate(arma::vec& estimations)
   estimations.fill(arma::fill::zeros);
 
   // Clean accumulated alpha if Monte Carlo estimations are available.
-  if (monteCarlo && std::is_same<KernelType, GaussianKernel>::value)
+  if (monteCarlo &&
+      KDERules<MetricType, KernelType, Tree>::kernelSupportsMonteCarlo)
   {
     KDECleanRules<Tree> cleanRules;
     SingleTreeTraversalType<KDECleanRules<Tree>> cleanTraverser(cleanRules);
@@ -606,6 +693,192 @@ Evaluate(arma::vec& estimations)
   Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
 }
 
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+Evaluate(MatType querySet,
+         std::vector<KernelType> kernels,
+         arma::mat& estimations)
+{
+  // Check whether has already been trained.
+  if (!trained)
+  {
+    throw std::runtime_error("cannot evaluate KDE model: model needs to be "
+                             "trained before evaluation");
+  }
+
+  // Check at least one kernel was given.
+  if (kernels.empty())
+  {
+    throw std::invalid_argument("cannot evaluate KDE model: at least one "
+                                "kernel is required");
+  }
+
+  // Get estimations matrix ready; one row per kernel.
+  estimations.zeros(kernels.size(), querySet.n_cols);
+
+  // Check querySet has at least 1 element to evaluate.
+  if (querySet.n_cols == 0)
+  {
+    Log::Warn << "KDE::Evaluate(): querySet is empty, no predictions will "
+              << "be returned" << std::endl;
+    return;
+  }
+
+  // Check whether dimensions match.
+  if (querySet.n_rows != referenceTree->Dataset().n_rows)
+  {
+    throw std::invalid_argument("cannot evaluate KDE model: querySet and "
+                                "referenceSet dimensions don't match");
+  }
+
+  typedef KDEMultiRules<MetricType, KernelType, Tree> MultiRuleType;
+
+  if (mode == KDE_DUAL_TREE_MODE)
+  {
+    std::vector<size_t> oldFromNewQueries;
+    Tree* queryTree = BuildTree<Tree>(std::move(querySet), oldFromNewQueries);
+
+    MultiRuleType rules(referenceTree->Dataset(),
+                        queryTree->Dataset(),
+                        estimations,
+                        relError,
+                        absError,
+                        metric,
+                        kernels,
+                        false);
+
+    // Create traverser and share one traversal between all the kernels.
+    DualTreeTraversalType<MultiRuleType> traverser(rules);
+    traverser.Traverse(*queryTree, *referenceTree);
+    delete queryTree;
+
+    // Rearrange estimation columns if the tree rearranged the query set.
+    if (TreeTraits<Tree>::RearrangesDataset)
+    {
+      arma::mat rearrangedEstimations(estimations.n_rows, estimations.n_cols);
+      for (size_t i = 0; i < oldFromNewQueries.size(); ++i)
+        rearrangedEstimations.col(oldFromNewQueries.at(i)) = estimations.col(i);
+      estimations = std::move(rearrangedEstimations);
+    }
+
+    Log::Info << rules.Scores() << " node combinations were scored."
+              << std::endl;
+    Log::Info << rules.BaseCases() << " base cases were calculated."
+              << std::endl;
+  }
+  else if (mode == KDE_SINGLE_TREE_MODE)
+  {
+    MultiRuleType rules(referenceTree->Dataset(),
+                        querySet,
+                        estimations,
+                        relError,
+                        absError,
+                        metric,
+                        kernels,
+                        false);
+
+    // Create traverser.
+    SingleTreeTraversalType<MultiRuleType> traverser(rules);
+
+    // Traverse for each point.
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    Log::Info << rules.Scores() << " node combinations were scored."
+              << std::endl;
+    Log::Info << rules.BaseCases() << " base cases were calculated."
+              << std::endl;
+  }
+
+  estimations /= referenceTree->Dataset().n_cols;
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+Evaluate(std::vector<KernelType> kernels, arma::mat& estimations)
+{
+  // Check whether has already been trained.
+  if (!trained)
+  {
+    throw std::runtime_error("cannot evaluate KDE model: model needs to be "
+                             "trained before evaluation");
+  }
+
+  // Check at least one kernel was given.
+  if (kernels.empty())
+  {
+    throw std::invalid_argument("cannot evaluate KDE model: at least one "
+                                "kernel is required");
+  }
+
+  // Get estimations matrix ready; one row per kernel.
+  estimations.zeros(kernels.size(), referenceTree->Dataset().n_cols);
+
+  typedef KDEMultiRules<MetricType, KernelType, Tree> MultiRuleType;
+  MultiRuleType rules(referenceTree->Dataset(),
+                      referenceTree->Dataset(),
+                      estimations,
+                      relError,
+                      absError,
+                      metric,
+                      kernels,
+                      true);
+
+  if (mode == KDE_DUAL_TREE_MODE)
+  {
+    // Create traverser and share one traversal between all the kernels.
+    DualTreeTraversalType<MultiRuleType> traverser(rules);
+    traverser.Traverse(*referenceTree, *referenceTree);
+  }
+  else if (mode == KDE_SINGLE_TREE_MODE)
+  {
+    SingleTreeTraversalType<MultiRuleType> traverser(rules);
+    for (size_t i = 0; i < referenceTree->Dataset().n_cols; ++i)
+      traverser.Traverse(i, *referenceTree);
+  }
+
+  estimations /= referenceTree->Dataset().n_cols;
+
+  // Rearrange estimation columns if the tree rearranged the reference set.
+  if (TreeTraits<Tree>::RearrangesDataset)
+  {
+    arma::mat rearrangedEstimations(estimations.n_rows, estimations.n_cols);
+    for (size_t i = 0; i < oldFromNewReferences->size(); ++i)
+    {
+      rearrangedEstimations.col(oldFromNewReferences->at(i)) =
+          estimations.col(i);
+    }
+    estimations = std::move(rearrangedEstimations);
+  }
+
+  Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
+  Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
+}
+
 template<typename KernelType,
          typename MetricType,
          typename MatType,
@@ -100,7 +100,8 @@ BINDING_EXAMPLE(
     ") then default parameter values will be used."
     "\n\n"
     "In addition to the last program call, it is also possible to activate "
-    "Monte Carlo estimations if a Gaussian kernel is used. This can provide "
+    "Monte Carlo estimations if a Gaussian, Epanechnikov or spherical kernel "
+    "is used. This can provide "
     "faster results, but the KDE will only have a probabilistic guarantee of "
     "meeting the desired error bound (instead of an absolute guarantee). The "
     "following example will run KDE using a Monte Carlo estimation when "
@@ -220,10 +221,12 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   ReportIgnoredParam(params, {{ "monte_carlo", false }}, "initial_sample_size");
   ReportIgnoredParam(params, {{ "monte_carlo", false }}, "mc_entry_coef");
   ReportIgnoredParam(params, {{ "monte_carlo", false }}, "mc_break_coef");
-  if (monteCarlo && kernelStr != "gaussian")
+  if (monteCarlo && kernelStr != "gaussian" && kernelStr != "epanechnikov" &&
+      kernelStr != "spherical")
   {
     ReportIgnoredParam(params, "monte_carlo",
-                       "Monte Carlo only works with Gaussian kernel");
+                       "Monte Carlo only works with the Gaussian, "
+                       "Epanechnikov, and spherical kernels");
   }
 
   // Requirements for parameter values.
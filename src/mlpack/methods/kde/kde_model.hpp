@@ -23,6 +23,7 @@
 
 // Remaining includes.
 #include "kde.hpp"
+#include "grid_kde.hpp"
 
 namespace mlpack {
 
@@ -124,6 +125,11 @@ class KDEWrapperBase
 
   //! Perform monochromatic KDE (i.e. with the reference set as the query set).
   virtual void Evaluate(util::Timers& timers, arma::vec& estimates) = 0;
+
+  //! Select the kernel bandwidth from a set of candidates by maximizing the
+  //! leave-one-out log-likelihood of the reference set; returns the winner.
+  virtual double SelectBandwidth(util::Timers& timers,
+                                 const arma::vec& candidateBandwidths) = 0;
 };
 
 /**
@@ -204,6 +210,11 @@ class KDEWrapper : public KDEWrapperBase
   //! Perform monochromatic KDE (i.e. with the reference set as the query set).
   virtual void Evaluate(util::Timers& timers, arma::vec& estimates);
 
+  //! Select the kernel bandwidth from a set of candidates by maximizing the
+  //! leave-one-out log-likelihood of the reference set; returns the winner.
+  virtual double SelectBandwidth(util::Timers& timers,
+                                 const arma::vec& candidateBandwidths);
+
   //! Serialize the KDE model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */)
@@ -218,6 +229,103 @@ class KDEWrapper : public KDEWrapperBase
   KDEType kde;
 };
 
+/**
+ * GridKDEWrapper is a wrapper class for the grid-based (binned) KDE
+ * evaluator, allowing it to be selected in KDEModel next to the tree-based
+ * KDE types.  Only the Gaussian kernel is supported, since the grid smoothing
+ * relies on the kernel being separable across dimensions.
+ */
+class GridKDEWrapper : public KDEWrapperBase
+{
+ public:
+  //! Create the GridKDEWrapper object.
+  GridKDEWrapper(const double relError,
+                 const double absError,
+                 const GaussianKernel& kernel) :
+      kde(relError, absError, kernel),
+      monteCarlo(false),
+      initialSampleSize(KDEDefaultParams::initialSampleSize),
+      mode(KDEDefaultParams::mode)
+  {
+    // Nothing left to do.
+  }
+
+  //! Create a new GridKDEWrapper that is the same as this one.  This function
+  //! will properly handle polymorphism.
+  virtual GridKDEWrapper* Clone() const { return new GridKDEWrapper(*this); }
+
+  //! Destruct the GridKDEWrapper (nothing to do).
+  virtual ~GridKDEWrapper() { }
+
+  //! Modify the bandwidth of the kernel.
+  virtual void Bandwidth(const double bw) { kde.Kernel() = GaussianKernel(bw); }
+
+  //! Modify the relative error tolerance.
+  virtual void RelativeError(const double eps) { kde.RelativeError(eps); }
+
+  //! Modify the absolute error tolerance.
+  virtual void AbsoluteError(const double eps) { kde.AbsoluteError(eps); }
+
+  // Monte Carlo estimation and search modes do not apply to the grid
+  // evaluator; these parameters are stored but have no effect.
+
+  //! Get whether Monte Carlo search is being used.
+  virtual bool MonteCarlo() const { return monteCarlo; }
+  //! Modify whether Monte Carlo search is being used.
+  virtual bool& MonteCarlo() { return monteCarlo; }
+
+  //! Modify the Monte Carlo probability.
+  virtual void MCProb(const double /* mcProb */) { }
+
+  //! Get the Monte Carlo sample size.
+  virtual size_t MCInitialSampleSize() const { return initialSampleSize; }
+  //! Modify the Monte Carlo sample size.
+  virtual size_t& MCInitialSampleSize() { return initialSampleSize; }
+
+  //! Modify the Monte Carlo entry coefficient.
+  virtual void MCEntryCoef(const double /* entryCoef */) { }
+
+  //! Modify the Monte Carlo break coefficient.
+  virtual void MCBreakCoef(const double /* breakCoef */) { }
+
+  //! Get the search mode.
+  virtual KDEMode Mode() const { return mode; }
+  //! Modify the search mode.
+  virtual KDEMode& Mode() { return mode; }
+
+  //! Train the model (build the grid).
+  virtual void Train(util::Timers& timers, arma::mat&& referenceSet);
+
+  //! Perform bichromatic KDE (i.e. KDE with a separate query set).
+  virtual void Evaluate(util::Timers& timers,
+                        arma::mat&& querySet,
+                        arma::vec& estimates);
+
+  //! Perform monochromatic KDE (i.e. with the reference set as the query set).
+  virtual void Evaluate(util::Timers& timers, arma::vec& estimates);
+
+  //! Select the kernel bandwidth from a set of candidates by maximizing the
+  //! leave-one-out log-likelihood of the reference set; returns the winner.
+  virtual double SelectBandwidth(util::Timers& timers,
+                                 const arma::vec& candidateBandwidths);
+
+  //! Serialize the KDE model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(kde));
+  }
+
+ protected:
+  //! The instantiated grid KDE object that we are wrapping.
+  GridKDE<GaussianKernel> kde;
+
+  //! Stored (but unused) Monte Carlo and mode parameters.
+  bool monteCarlo;
+  size_t initialSampleSize;
+  KDEMode mode;
+};
+
 /**
  * The KDEModel provides an abstraction for the KDE class, abstracting away the
  * KernelType and TreeType parameters and allowing those to be specified at
@@ -233,7 +341,8 @@ class KDEModel
     BALL_TREE,
     COVER_TREE,
     OCTREE,
-    R_TREE
+    R_TREE,
+    GRID // Not a tree: a binned-grid evaluator (see GridKDE).
   };
 
   enum KernelTypes
@@ -455,6 +564,24 @@ class KDEModel
    */
   void Evaluate(util::Timers& timers, arma::vec& estimations);
 
+  /**
+   * Select the kernel bandwidth from a set of candidates by cross-validation
+   * on the reference set.  Each candidate is scored by the leave-one-out
+   * log-likelihood of the reference points, computed from monochromatic
+   * evaluations that share the reference tree across all the candidates.  The
+   * model bandwidth is set to the best candidate, which is also returned.
+   *
+   * Monte Carlo estimations are not used during selection, regardless of the
+   * model settings.
+   *
+   * @pre The model has to be previously created with BuildModel.
+   * @param timers Object to hold timing information in.
+   * @param candidateBandwidths Candidate bandwidths to choose between.
+   * @return The candidate bandwidth with the highest leave-one-out
+   *     log-likelihood.
+   */
+  double SelectBandwidth(util::Timers& timers,
+                         const arma::vec& candidateBandwidths);
 
  private:
   //! Clean memory.
@@ -217,6 +217,16 @@ inline void KDEModel::InitializeModel()
       kdeModel = InitializeModelHelper<RTree>(kernelType, relError, absError,
           bandwidth);
       break;
+
+    case GRID:
+      if (kernelType != GAUSSIAN_KERNEL)
+      {
+        throw std::invalid_argument("KDEModel::InitializeModel(): the grid "
+            "evaluator only supports the Gaussian kernel");
+      }
+      kdeModel = new GridKDEWrapper(relError, absError,
+          GaussianKernel(bandwidth));
+      break;
   }
 }
 
@@ -259,6 +269,20 @@ inline void KDEModel::Evaluate(util::Timers& timers,
   kdeModel->Evaluate(timers, estimates);
 }
 
+// Select the bandwidth by leave-one-out cross-validation.
+inline double KDEModel::SelectBandwidth(util::Timers& timers,
+                                        const arma::vec& candidateBandwidths)
+{
+  if (candidateBandwidths.is_empty())
+  {
+    throw std::invalid_argument("cannot select bandwidth: at least one "
+                                "candidate bandwidth is required");
+  }
+
+  bandwidth = kdeModel->SelectBandwidth(timers, candidateBandwidths);
+  return bandwidth;
+}
+
 // Clean memory.
 inline void KDEModel::CleanMemory()
 {
@@ -393,6 +417,146 @@ void KDEWrapper<KernelType, TreeType>::Evaluate(util::Timers& timers,
   timers.Stop("applying_normalizer");
 }
 
+//! Select the kernel bandwidth by leave-one-out cross-validation.
+template<typename KernelType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+double KDEWrapper<KernelType, TreeType>::SelectBandwidth(
+    util::Timers& timers,
+    const arma::vec& candidateBandwidths)
+{
+  const size_t dimension = kde.ReferenceTree()->Dataset().n_rows;
+
+  std::vector<KernelType> kernels;
+  for (size_t b = 0; b < candidateBandwidths.n_elem; ++b)
+    kernels.push_back(KernelType(candidateBandwidths[b]));
+
+  // Leave-one-out densities for every candidate, from a single monochromatic
+  // pass that shares the reference tree and its traversal between all the
+  // kernels.  The traversal mutates per-node error statistics, so concurrent
+  // per-candidate traversals over the shared tree would race; the shared pass
+  // is race-free and cheaper anyway.
+  timers.Start("computing_kde");
+  arma::mat estimations;
+  kde.Evaluate(kernels, estimations);
+  timers.Stop("computing_kde");
+
+  timers.Start("selecting_bandwidth");
+  arma::vec scores(candidateBandwidths.n_elem);
+  // Each candidate normalizes and scores its own row of the estimations.
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t b = 0; b < candidateBandwidths.n_elem; ++b)
+  {
+    arma::vec densities = estimations.row(b).t();
+    KernelNormalizer::ApplyNormalizer<KernelType>(kernels[b],
+                                                  dimension,
+                                                  densities);
+
+    // Densities are floored to avoid log(0) for compact kernels that leave
+    // some reference point without any neighbor in range.
+    double score = 0;
+    for (size_t i = 0; i < densities.n_elem; ++i)
+      score += std::log(std::max(densities[i], DBL_MIN));
+    scores[b] = score;
+  }
+  timers.Stop("selecting_bandwidth");
+
+  arma::uword best;
+  scores.max(best);
+  kde.Kernel() = KernelType(candidateBandwidths[best]);
+  return candidateBandwidths[best];
+}
+
+//! Train the grid-based model (build the grid).
+inline void GridKDEWrapper::Train(util::Timers& timers,
+                                  arma::mat&& referenceSet)
+{
+  timers.Start("grid_building");
+  kde.Train(std::move(referenceSet));
+  timers.Stop("grid_building");
+}
+
+//! Perform bichromatic grid-based KDE.
+inline void GridKDEWrapper::Evaluate(util::Timers& timers,
+                                     arma::mat&& querySet,
+                                     arma::vec& estimates)
+{
+  const size_t dimension = querySet.n_rows;
+
+  timers.Start("computing_kde");
+  kde.Evaluate(querySet, estimates);
+  timers.Stop("computing_kde");
+
+  timers.Start("applying_normalizer");
+  KernelNormalizer::ApplyNormalizer<GaussianKernel>(kde.Kernel(),
+                                                    dimension,
+                                                    estimates);
+  timers.Stop("applying_normalizer");
+}
+
+//! Perform monochromatic grid-based KDE.
+inline void GridKDEWrapper::Evaluate(util::Timers& timers,
+                                     arma::vec& estimates)
+{
+  timers.Start("computing_kde");
+  kde.Evaluate(estimates);
+  timers.Stop("computing_kde");
+
+  timers.Start("applying_normalizer");
+  const size_t dimension = kde.ReferenceSet().n_rows;
+  KernelNormalizer::ApplyNormalizer<GaussianKernel>(kde.Kernel(),
+                                                    dimension,
+                                                    estimates);
+  timers.Stop("applying_normalizer");
+}
+
+//! Select the grid-based kernel bandwidth by leave-one-out cross-validation.
+inline double GridKDEWrapper::SelectBandwidth(
+    util::Timers& timers,
+    const arma::vec& candidateBandwidths)
+{
+  const size_t dimension = kde.ReferenceSet().n_rows;
+  const size_t numPoints = kde.ReferenceSet().n_cols;
+
+  timers.Start("selecting_bandwidth");
+  arma::vec scores(candidateBandwidths.n_elem);
+  // The grid spacing depends on the bandwidth, so every candidate builds its
+  // own grid; building is linear in the reference set, so the candidates are
+  // simply evaluated in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t b = 0; b < candidateBandwidths.n_elem; ++b)
+  {
+    GridKDE<GaussianKernel> localKde(kde);
+    localKde.Kernel() = GaussianKernel(candidateBandwidths[b]);
+    localKde.Train(arma::mat(kde.ReferenceSet()));
+
+    arma::vec densities;
+    localKde.Evaluate(densities);
+
+    // The grid estimate includes the contribution of every point to itself;
+    // subtract it to get leave-one-out densities.
+    densities -= localKde.Kernel().Evaluate(0.0) / numPoints;
+    KernelNormalizer::ApplyNormalizer<GaussianKernel>(localKde.Kernel(),
+                                                      dimension,
+                                                      densities);
+
+    double score = 0;
+    for (size_t i = 0; i < densities.n_elem; ++i)
+      score += std::log(std::max(densities[i], DBL_MIN));
+    scores[b] = score;
+  }
+  timers.Stop("selecting_bandwidth");
+
+  arma::uword best;
+  scores.max(best);
+
+  // Rebuild the wrapped model's grid with the selected bandwidth.
+  kde.Kernel() = GaussianKernel(candidateBandwidths[best]);
+  kde.Train(arma::mat(kde.ReferenceSet()));
+  return candidateBandwidths[best];
+}
+
 template<template<typename TreeMetricType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
@@ -490,6 +654,13 @@ void KDEModel::serialize(Archive& ar, const uint32_t /* version */)
     case R_TREE:
       SerializationHelper<RTree>(ar, kdeModel, kernelType);
       break;
+
+    case GRID:
+      {
+        GridKDEWrapper& typedModel = dynamic_cast<GridKDEWrapper&>(*kdeModel);
+        ar(CEREAL_NVP(typedModel));
+        break;
+      }
   }
 }
 
@@ -96,6 +96,18 @@ class KDERules
   //! results.
   size_t MinimumBaseCases() const { return 0; }
 
+  /**
+   * Whether the kernel supports Monte Carlo estimations.  The sample sizes
+   * are chosen with a central limit theorem bound on the mean of the sampled
+   * kernel responses, which is valid for any bounded kernel; it is enabled
+   * for the kernels whose estimates have been validated against exact
+   * traversal.
+   */
+  constexpr static bool kernelSupportsMonteCarlo =
+      std::is_same<KernelType, GaussianKernel>::value ||
+      std::is_same<KernelType, EpanechnikovKernel>::value ||
+      std::is_same<KernelType, SphericalKernel>::value;
+
  private:
   //! Evaluate kernel value of 2 points given their indexes.
   double EvaluateKernel(const size_t queryIndex,
@@ -105,6 +117,26 @@ class KDERules
   double EvaluateKernel(const arma::vec& query,
                         const arma::vec& reference) const;
 
+  /**
+   * Append kernel values between a query point and a stratified sample of
+   * descendants of a reference node.  One point is drawn from each
+   * equal-width slice of the descendant index range; descendants are grouped
+   * by subtree, so this spreads the sample across the leaves of the reference
+   * node instead of leaving the spread to chance.
+   *
+   * @param queryIndex Index of the query point.
+   * @param referenceNode Node whose descendants are sampled.
+   * @param startIndex First descendant index eligible for sampling (1 if the
+   *                   first point has already been accounted for).
+   * @param numSamples Number of samples to draw.
+   * @param sample Vector the kernel values are appended to.
+   */
+  void SampleKernelValues(const size_t queryIndex,
+                          TreeType& referenceNode,
+                          const size_t startIndex,
+                          const size_t numSamples,
+                          arma::vec& sample);
+
   //! Calculate depth alpha for some node.
   double CalculateAlpha(TreeType* node);
 
@@ -157,9 +189,135 @@ class KDERules
   //! Whether reference and query sets are the same.
   const bool sameSet;
 
-  //! Whether the kernel used for the rule is the Gaussian Kernel.
-  constexpr static bool kernelIsGaussian =
-      std::is_same<KernelType, GaussianKernel>::value;
+  //! Absolute error tolerance available for each reference point.
+  const double absErrorTol;
+
+  //! The last query index.
+  size_t lastQueryIndex;
+
+  //! The last reference index.
+  size_t lastReferenceIndex;
+
+  //! Traversal information.
+  TraversalInfoType traversalInfo;
+
+  //! The number of base cases.
+  size_t baseCases;
+
+  //! The number of scores.
+  size_t scores;
+};
+
+/**
+ * A traversal Rules class for evaluating kernel density estimates for
+ * several kernels (e.g. several candidate bandwidths during bandwidth
+ * selection) with a single traversal.  Each distance calculation is shared by
+ * every kernel, and a node combination is only pruned when the bound of every
+ * kernel fits within its error tolerance, so the loosest bound governs
+ * pruning.  Densities for all kernels are accumulated simultaneously, one row
+ * per kernel.
+ *
+ * Unlike KDERules, this class does not perform Monte Carlo estimations and
+ * does not use the accumulated-error slack stored in the tree statistics, so
+ * the traversal leaves the trees unmodified.
+ */
+template<typename MetricType, typename KernelType, typename TreeType>
+class KDEMultiRules
+{
+ public:
+  /**
+   * Construct KDEMultiRules.
+   *
+   * @param referenceSet Reference set data.
+   * @param querySet Query set data.
+   * @param densities Matrix where estimations will be written; one row per
+   *                  kernel and one column per query point.
+   * @param relError Relative error tolerance.
+   * @param absError Absolute error tolerance.
+   * @param metric Instantiated metric.
+   * @param kernels Instantiated kernels.
+   * @param sameSet True if query and reference sets are the same
+   *                (monochromatic evaluation).
+   */
+  KDEMultiRules(const arma::mat& referenceSet,
+                const arma::mat& querySet,
+                arma::mat& densities,
+                const double relError,
+                const double absError,
+                MetricType& metric,
+                std::vector<KernelType>& kernels,
+                const bool sameSet);
+
+  //! Base Case.
+  double BaseCase(const size_t queryIndex, const size_t referenceIndex);
+
+  //! SingleTree Score.
+  double Score(const size_t queryIndex, TreeType& referenceNode);
+
+  //! SingleTree Rescore.
+  double Rescore(const size_t queryIndex,
+                 TreeType& referenceNode,
+                 const double oldScore) const;
+
+  //! Dual-Tree Score.
+  double Score(TreeType& queryNode, TreeType& referenceNode);
+
+  //! Dual-Tree Rescore.
+  double Rescore(TreeType& queryNode,
+                 TreeType& referenceNode,
+                 const double oldScore) const;
+
+  typedef typename mlpack::TraversalInfo<TreeType> TraversalInfoType;
+
+  //! Get traversal information.
+  const TraversalInfoType& TraversalInfo() const { return traversalInfo; }
+
+  //! Modify traversal information.
+  TraversalInfoType& TraversalInfo() { return traversalInfo; }
+
+  //! Get the number of base cases.
+  size_t BaseCases() const { return baseCases; }
+
+  //! Get the number of scores.
+  size_t Scores() const { return scores; }
+
+  //! Get the minimum number of base cases we need to perform to have acceptable
+  //! results.
+  size_t MinimumBaseCases() const { return 0; }
+
+ private:
+  /**
+   * Compute the kernel bounds for a distance range and decide whether the
+   * node combination can be pruned for every kernel.  If it can, midKernels
+   * is filled with the midpoint kernel estimate of each kernel.
+   */
+  bool CanPrune(const double minDistance,
+                const double maxDistance,
+                arma::vec& midKernels) const;
+
+  //! The reference set.
+  const arma::mat& referenceSet;
+
+  //! The query set.
+  const arma::mat& querySet;
+
+  //! Density values; one row per kernel.
+  arma::mat& densities;
+
+  //! Relative error tolerance.
+  const double relError;
+
+  //! Absolute error tolerance.
+  const double absError;
+
+  //! Instantiated metric.
+  MetricType& metric;
+
+  //! Instantiated kernels.
+  std::vector<KernelType>& kernels;
+
+  //! Whether reference and query sets are the same.
+  const bool sameSet;
 
   //! Absolute error tolerance available for each reference point.
   const double absErrorTol;
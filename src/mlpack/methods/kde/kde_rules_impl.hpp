@@ -59,7 +59,7 @@ KDERules<MetricType, KernelType, TreeType>::KDERules(
   accumError = arma::vec(querySet.n_cols, arma::fill::zeros);
 
   // Initialize accumMCAlpha only if Monte Carlo estimations are available.
-  if (monteCarlo && kernelIsGaussian)
+  if (monteCarlo && kernelSupportsMonteCarlo)
     accumMCAlpha = arma::vec(querySet.n_cols, arma::fill::zeros);
 }
 
@@ -108,7 +108,7 @@ Score(const size_t queryIndex, TreeType& referenceNode)
   bool alreadyDidRefPoint0 = false;
 
   // Calculate alpha if Monte Carlo is available.
-  if (monteCarlo && kernelIsGaussian)
+  if (monteCarlo && kernelSupportsMonteCarlo)
     depthAlpha = CalculateAlpha(&referenceNode);
   else
     depthAlpha = -1;
@@ -180,12 +180,12 @@ Score(const size_t queryIndex, TreeType& referenceNode)
       accumError(queryIndex) -= refNumDesc * (bound - 2 * errorTolerance);
 
     // Store not used alpha for Monte Carlo.
-    if (kernelIsGaussian && monteCarlo)
+    if (kernelSupportsMonteCarlo && monteCarlo)
       accumMCAlpha(queryIndex) += depthAlpha;
   }
   else if (monteCarlo &&
            refNumDesc >= mcAccessCoef * initialSampleSize &&
-           kernelIsGaussian)
+           kernelSupportsMonteCarlo)
   {
     // Monte Carlo probabilistic estimation.
     // Calculate z using accumulated alpha if possible.
@@ -212,20 +212,10 @@ Score(const size_t queryIndex, TreeType& referenceNode)
         break;
       }
 
-      // Increase the sample size.
-      sample.resize(newSize);
-      for (size_t i = 0; i < m; ++i)
-      {
-        // Sample and evaluate random points from the reference node.
-        size_t randomPoint;
-        if (alreadyDidRefPoint0)
-          randomPoint = RandInt(1, refNumDesc);
-        else
-          randomPoint = RandInt(0, refNumDesc);
-
-        sample(oldSize + i) =
-            EvaluateKernel(queryIndex, referenceNode.Descendant(randomPoint));
-      }
+      // Increase the sample size, stratifying the new draws across the
+      // descendants of the reference node.
+      SampleKernelValues(queryIndex, referenceNode,
+          alreadyDidRefPoint0 ? 1 : 0, m, sample);
       meanSample = arma::mean(sample);
       const double stddev = arma::stddev(sample);
       const double mThreshBase =
@@ -280,7 +270,7 @@ Score(const size_t queryIndex, TreeType& referenceNode)
 
     // If node is going to be exactly computed, reclaim not used alpha for
     // Monte Carlo estimations.
-    if (kernelIsGaussian && monteCarlo && referenceNode.IsLeaf())
+    if (kernelSupportsMonteCarlo && monteCarlo && referenceNode.IsLeaf())
       accumMCAlpha(queryIndex) += depthAlpha;
   }
 
@@ -312,14 +302,14 @@ Score(TreeType& queryNode, TreeType& referenceNode)
   bool alreadyDidRefPoint0 = false;
 
   // Calculate alpha if Monte Carlo is available.
-  if (monteCarlo && kernelIsGaussian)
+  if (monteCarlo && kernelSupportsMonteCarlo)
     depthAlpha = CalculateAlpha(&referenceNode);
   else
     depthAlpha = -1;
 
   // Check if not used Monte Carlo alpha can be reclaimed for this combination
   // of nodes.
-  const bool canReclaimAlpha = kernelIsGaussian &&
+  const bool canReclaimAlpha = kernelSupportsMonteCarlo &&
                                monteCarlo &&
                                referenceNode.IsLeaf() &&
                                queryNode.IsLeaf();
@@ -387,12 +377,12 @@ Score(TreeType& queryNode, TreeType& referenceNode)
     queryStat.AccumError() -= refNumDesc * (bound - 2 * errorTolerance);
 
     // Store not used alpha for Monte Carlo.
-    if (kernelIsGaussian && monteCarlo)
+    if (kernelSupportsMonteCarlo && monteCarlo)
       queryStat.AccumAlpha() += depthAlpha;
   }
   else if (monteCarlo &&
            refNumDesc >= mcAccessCoef * initialSampleSize &&
-           kernelIsGaussian)
+           kernelSupportsMonteCarlo)
   {
     // Monte Carlo probabilistic estimation.
     // Calculate z using accumulated alpha if possible.
@@ -427,20 +417,10 @@ Score(TreeType& queryNode, TreeType& referenceNode)
           break;
         }
 
-        // Increase the sample size.
-        sample.resize(newSize);
-        for (size_t i = 0; i < m; ++i)
-        {
-          // Sample and evaluate random points from the reference node.
-          size_t randomPoint;
-          if (alreadyDidRefPoint0)
-            randomPoint = RandInt(1, refNumDesc);
-          else
-            randomPoint = RandInt(0, refNumDesc);
-
-          sample(oldSize + i) =
-              EvaluateKernel(queryIndex, referenceNode.Descendant(randomPoint));
-        }
+        // Increase the sample size, stratifying the new draws across the
+        // descendants of the reference node.
+        SampleKernelValues(queryIndex, referenceNode,
+            alreadyDidRefPoint0 ? 1 : 0, m, sample);
         meanSample = arma::mean(sample);
         const double stddev = arma::stddev(sample);
         const double mThreshBase =
@@ -539,6 +519,36 @@ EvaluateKernel(const arma::vec& query, const arma::vec& reference) const
   return kernel.Evaluate(metric.Evaluate(query, reference));
 }
 
+template<typename MetricType, typename KernelType, typename TreeType>
+inline void KDERules<MetricType, KernelType, TreeType>::
+SampleKernelValues(const size_t queryIndex,
+                   TreeType& referenceNode,
+                   const size_t startIndex,
+                   const size_t numSamples,
+                   arma::vec& sample)
+{
+  const size_t oldSize = sample.size();
+  sample.resize(oldSize + numSamples);
+
+  // Draw one point from each equal-width slice of the descendant index range.
+  // The descendants of a node are grouped by subtree, so this stratifies the
+  // sample across the leaves of the reference node.
+  const size_t numDesc = referenceNode.NumDescendants();
+  const double stratumWidth = (double) (numDesc - startIndex) / numSamples;
+  for (size_t i = 0; i < numSamples; ++i)
+  {
+    const size_t lo = startIndex + (size_t) (i * stratumWidth);
+    size_t hi = (i == numSamples - 1) ? numDesc :
+        startIndex + (size_t) ((i + 1) * stratumWidth);
+    if (hi <= lo)
+      hi = lo + 1;
+
+    const size_t randomPoint = RandInt(lo, hi);
+    sample(oldSize + i) = EvaluateKernel(queryIndex,
+        referenceNode.Descendant(randomPoint));
+  }
+}
+
 template<typename MetricType, typename KernelType, typename TreeType>
 inline mlpack_force_inline double KDERules<MetricType, KernelType, TreeType>::
 CalculateAlpha(TreeType* node)
@@ -568,6 +578,239 @@ CalculateAlpha(TreeType* node)
   return stat.MCAlpha();
 }
 
+template<typename MetricType, typename KernelType, typename TreeType>
+KDEMultiRules<MetricType, KernelType, TreeType>::KDEMultiRules(
+    const arma::mat& referenceSet,
+    const arma::mat& querySet,
+    arma::mat& densities,
+    const double relError,
+    const double absError,
+    MetricType& metric,
+    std::vector<KernelType>& kernels,
+    const bool sameSet) :
+    referenceSet(referenceSet),
+    querySet(querySet),
+    densities(densities),
+    relError(relError),
+    absError(absError),
+    metric(metric),
+    kernels(kernels),
+    sameSet(sameSet),
+    absErrorTol(absError / referenceSet.n_cols),
+    lastQueryIndex(querySet.n_cols),
+    lastReferenceIndex(referenceSet.n_cols),
+    baseCases(0),
+    scores(0)
+{
+  // Nothing to do.
+}
+
+//! The multi-kernel base case.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline mlpack_force_inline
+double KDEMultiRules<MetricType, KernelType, TreeType>::BaseCase(
+    const size_t queryIndex,
+    const size_t referenceIndex)
+{
+  // If reference and query sets are the same we don't want to compute the
+  // estimation of a point with itself.
+  if (sameSet && (queryIndex == referenceIndex))
+    return 0.0;
+
+  // Avoid duplicated calculations.
+  if ((lastQueryIndex == queryIndex) && (lastReferenceIndex == referenceIndex))
+    return 0.0;
+
+  // The distance is computed once and shared by every kernel.
+  const double distance = metric.Evaluate(querySet.col(queryIndex),
+                                          referenceSet.col(referenceIndex));
+  for (size_t b = 0; b < kernels.size(); ++b)
+    densities(b, queryIndex) += kernels[b].Evaluate(distance);
+
+  ++baseCases;
+  lastQueryIndex = queryIndex;
+  lastReferenceIndex = referenceIndex;
+  traversalInfo.LastBaseCase() = distance;
+  return distance;
+}
+
+//! Decide whether every kernel allows the prune.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline bool KDEMultiRules<MetricType, KernelType, TreeType>::CanPrune(
+    const double minDistance,
+    const double maxDistance,
+    arma::vec& midKernels) const
+{
+  for (size_t b = 0; b < kernels.size(); ++b)
+  {
+    const double maxKernel = kernels[b].Evaluate(minDistance);
+    const double minKernel = kernels[b].Evaluate(maxDistance);
+    const double bound = maxKernel - minKernel;
+
+    // Error tolerance of this kernel for the current node combination.  The
+    // node combination is only prunable if every kernel can be pruned, so the
+    // loosest bound governs.
+    const double errorTolerance = absErrorTol + relError * minKernel;
+    if (bound > 2 * errorTolerance)
+      return false;
+
+    midKernels(b) = (maxKernel + minKernel) / 2.0;
+  }
+
+  return true;
+}
+
+//! Multi-kernel single-tree scoring function.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline double KDEMultiRules<MetricType, KernelType, TreeType>::
+Score(const size_t queryIndex, TreeType& referenceNode)
+{
+  // Auxiliary variables.
+  const arma::vec& queryPoint = querySet.unsafe_col(queryIndex);
+  const size_t refNumDesc = referenceNode.NumDescendants();
+  double score, minDistance, maxDistance;
+  // Calculations are not duplicated.
+  bool alreadyDidRefPoint0 = false;
+
+  if (TreeTraits<TreeType>::FirstPointIsCentroid &&
+      lastQueryIndex == queryIndex &&
+      traversalInfo.LastReferenceNode() != NULL &&
+      lastReferenceIndex == referenceNode.Point(0))
+  {
+    // Don't duplicate calculations.
+    alreadyDidRefPoint0 = true;
+    const double furthestDescDist = referenceNode.FurthestDescendantDistance();
+    minDistance = std::max(traversalInfo.LastBaseCase() - furthestDescDist,
+        0.0);
+    maxDistance = traversalInfo.LastBaseCase() + furthestDescDist;
+  }
+  else
+  {
+    // All calculations are new.
+    const Range r = referenceNode.RangeDistance(queryPoint);
+    minDistance = r.Lo();
+    maxDistance = r.Hi();
+
+    // Check if we are a self-child.
+    if (TreeTraits<TreeType>::HasSelfChildren &&
+        referenceNode.Parent() != NULL &&
+        referenceNode.Parent()->Point(0) == referenceNode.Point(0))
+    {
+      alreadyDidRefPoint0 = true;
+    }
+  }
+
+  arma::vec midKernels(kernels.size());
+  if (CanPrune(minDistance, maxDistance, midKernels))
+  {
+    // Sum up estimations for every kernel.
+    const size_t effectiveDesc =
+        alreadyDidRefPoint0 ? (refNumDesc - 1) : refNumDesc;
+    for (size_t b = 0; b < kernels.size(); ++b)
+      densities(b, queryIndex) += effectiveDesc * midKernels(b);
+
+    // Don't explore this tree branch.
+    score = DBL_MAX;
+  }
+  else
+  {
+    // Recurse.
+    score = minDistance;
+  }
+
+  ++scores;
+  traversalInfo.LastReferenceNode() = &referenceNode;
+  traversalInfo.LastScore() = score;
+  return score;
+}
+
+template<typename MetricType, typename KernelType, typename TreeType>
+inline mlpack_force_inline
+double KDEMultiRules<MetricType, KernelType, TreeType>::
+Rescore(const size_t /* queryIndex */,
+        TreeType& /* referenceNode */,
+        const double oldScore) const
+{
+  // If it's pruned it continues to be pruned.
+  return oldScore;
+}
+
+//! Multi-kernel dual-tree scoring function.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline double KDEMultiRules<MetricType, KernelType, TreeType>::
+Score(TreeType& queryNode, TreeType& referenceNode)
+{
+  const size_t refNumDesc = referenceNode.NumDescendants();
+  double score, minDistance, maxDistance;
+  // Calculations are not duplicated.
+  bool alreadyDidRefPoint0 = false;
+
+  if (TreeTraits<TreeType>::FirstPointIsCentroid &&
+      (traversalInfo.LastQueryNode() != NULL) &&
+      (traversalInfo.LastReferenceNode() != NULL) &&
+      (traversalInfo.LastQueryNode()->Point(0) == queryNode.Point(0)) &&
+      (traversalInfo.LastReferenceNode()->Point(0) == referenceNode.Point(0)))
+  {
+    // Don't duplicate calculations.
+    alreadyDidRefPoint0 = true;
+    lastQueryIndex = queryNode.Point(0);
+    lastReferenceIndex = referenceNode.Point(0);
+
+    // Calculate min and max distance.
+    const double refFurtDescDist = referenceNode.FurthestDescendantDistance();
+    const double queryFurtDescDist = queryNode.FurthestDescendantDistance();
+    const double sumFurtDescDist = refFurtDescDist + queryFurtDescDist;
+    minDistance = std::max(traversalInfo.LastBaseCase() - sumFurtDescDist, 0.0);
+    maxDistance = traversalInfo.LastBaseCase() + sumFurtDescDist;
+  }
+  else
+  {
+    // All calculations are new.
+    const Range r = queryNode.RangeDistance(referenceNode);
+    minDistance = r.Lo();
+    maxDistance = r.Hi();
+  }
+
+  arma::vec midKernels(kernels.size());
+  if (CanPrune(minDistance, maxDistance, midKernels))
+  {
+    // Sum up estimations for every kernel and every query descendant.
+    for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
+    {
+      const size_t effectiveDesc =
+          (alreadyDidRefPoint0 && i == 0) ? (refNumDesc - 1) : refNumDesc;
+      for (size_t b = 0; b < kernels.size(); ++b)
+        densities(b, queryNode.Descendant(i)) += effectiveDesc * midKernels(b);
+    }
+
+    // Prune.
+    score = DBL_MAX;
+  }
+  else
+  {
+    // Recurse.
+    score = minDistance;
+  }
+
+  ++scores;
+  traversalInfo.LastQueryNode() = &queryNode;
+  traversalInfo.LastReferenceNode() = &referenceNode;
+  traversalInfo.LastScore() = score;
+  return score;
+}
+
+//! Multi-kernel dual-tree rescore.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline mlpack_force_inline
+double KDEMultiRules<MetricType, KernelType, TreeType>::
+Rescore(TreeType& /* queryNode */,
+        TreeType& /* referenceNode */,
+        const double oldScore) const
+{
+  // If a branch is pruned then it continues to be pruned.
+  return oldScore;
+}
+
 //! Clean rules base case.
 template<typename TreeType>
 inline mlpack_force_inline
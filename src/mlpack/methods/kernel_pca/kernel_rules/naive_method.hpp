@@ -45,18 +45,29 @@ class NaiveKernelRule
 
   // Note that we only need to calculate the upper triangular part of the
   // kernel matrix, since it is symmetric. This helps minimize the number of
-  // kernel evaluations.
-  for (size_t i = 0; i < data.n_cols; ++i)
+  // kernel evaluations.  The rows are processed in blocks dispatched across
+  // threads; the blocks near the top of the triangle are longer, so dynamic
+  // scheduling keeps the threads balanced.
+  const size_t blockSize = 256;
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < data.n_cols; block += blockSize)
   {
-    for (size_t j = i; j < data.n_cols; ++j)
+    const size_t lastRow = std::min(block + blockSize,
+        (size_t) data.n_cols) - 1;
+
+    for (size_t i = block; i <= lastRow; ++i)
     {
-      // Evaluate the kernel on these two points.
-      kernelMatrix(i, j) = kernel.Evaluate(data.unsafe_col(i),
-                                           data.unsafe_col(j));
+      for (size_t j = i; j < data.n_cols; ++j)
+      {
+        // Evaluate the kernel on these two points.
+        kernelMatrix(i, j) = kernel.Evaluate(data.unsafe_col(i),
+                                             data.unsafe_col(j));
+      }
     }
   }
 
   // Copy to the lower triangular part of the matrix.
+  #pragma omp parallel for schedule(dynamic)
   for (size_t i = 1; i < data.n_cols; ++i)
     for (size_t j = 0; j < i; ++j)
       kernelMatrix(i, j) = kernelMatrix(j, i);
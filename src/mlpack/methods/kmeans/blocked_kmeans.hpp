@@ -0,0 +1,91 @@
+/**
+ * @file methods/kmeans/blocked_kmeans.hpp
+ *
+ * An implementation of a blocked step of the Lloyd algorithm for k-means
+ * clustering.  Point-centroid distances for a block of points are computed
+ * with a single matrix multiplication, so the inner loop runs at BLAS-3 speed
+ * instead of evaluating the metric pointwise.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_BLOCKED_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_BLOCKED_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * This is an implementation of a single iteration of Lloyd's algorithm for
+ * k-means, computing exactly the same assignments as NaiveKMeans but in
+ * blocks: for each block of points, the distances to all centroids are found
+ * at once with the expansion d(x, c)^2 = ||x||^2 - 2 x.c + ||c||^2, where the
+ * dot products are a single matrix multiplication.  Blocks are distributed
+ * over OpenMP threads, and each thread accumulates into its own local
+ * centroids.  For large k this is usually much faster than the pointwise
+ * loop, since the multiplication is handled by BLAS.
+ *
+ * The dot-product expansion is only valid for the Euclidean distance, so this
+ * class requires MetricType to behave like EuclideanDistance; for other
+ * metrics, use NaiveKMeans.
+ *
+ * If your intention is to run the full k-means algorithm, you are looking for
+ * the KMeans class instead of this one.  This class is used by KMeans as the
+ * actual implementation of the Lloyd iteration.
+ *
+ * @param MetricType Type of metric used with this implementation; must be the
+ *     Euclidean distance.
+ * @param MatType Matrix type (arma::mat or arma::sp_mat).
+ */
+template<typename MetricType, typename MatType>
+class BlockedKMeans
+{
+ public:
+  /**
+   * Construct the BlockedKMeans object with the given dataset and metric.
+   *
+   * @param dataset Dataset.
+   * @param metric Instantiated metric.
+   */
+  BlockedKMeans(const MatType& dataset, MetricType& metric);
+
+  /**
+   * Run a single iteration of the Lloyd algorithm, updating the given
+   * centroids into the newCentroids matrix.  If any cluster is empty (that
+   * is, if any cluster has no points assigned to it), then the centroid
+   * associated with that cluster may be filled with invalid data (it will be
+   * corrected later).
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Number of points in each cluster at the end of the
+   *     iteration.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+ private:
+  //! Number of points whose distances are computed with one multiplication.
+  static const size_t blockSize = 1024;
+
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated metric.
+  MetricType& metric;
+
+  //! Number of distance calculations.
+  size_t distanceCalculations;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "blocked_kmeans_impl.hpp"
+
+#endif
@@ -0,0 +1,108 @@
+/**
+ * @file methods/kmeans/blocked_kmeans_impl.hpp
+ *
+ * An implementation of a blocked step of the Lloyd algorithm for k-means
+ * clustering.  Point-centroid distances for a block of points are computed
+ * with a single matrix multiplication, so the inner loop runs at BLAS-3 speed
+ * instead of evaluating the metric pointwise.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_BLOCKED_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_BLOCKED_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "blocked_kmeans.hpp"
+
+namespace mlpack {
+
+template<typename MetricType, typename MatType>
+BlockedKMeans<MetricType, MatType>::BlockedKMeans(const MatType& dataset,
+                                                  MetricType& metric) :
+    dataset(dataset),
+    metric(metric),
+    distanceCalculations(0)
+{ /* Nothing to do. */ }
+
+// Run a single iteration.
+template<typename MetricType, typename MatType>
+double BlockedKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
+                                                   arma::mat& newCentroids,
+                                                   arma::Col<size_t>& counts)
+{
+  newCentroids.zeros(centroids.n_rows, centroids.n_cols);
+  counts.zeros(centroids.n_cols);
+
+  // The squared point norms are the same for every centroid and so do not
+  // affect which centroid is closest; only ||c||^2 - 2 x.c must be computed.
+  const arma::vec centroidNorms =
+      arma::trans(arma::sum(arma::square(centroids), 0));
+
+  const size_t numBlocks = (dataset.n_cols + blockSize - 1) / blockSize;
+
+  // Find the closest centroid to each point and update the new centroids.
+  // Blocks of points are processed in parallel.
+  #pragma omp parallel
+  {
+    // The current state of the k-means is private for each thread.
+    arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
+        arma::fill::zeros);
+    arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+
+    #pragma omp for
+    for (size_t block = 0; block < numBlocks; ++block)
+    {
+      const size_t begin = block * blockSize;
+      const size_t end = std::min((size_t) dataset.n_cols,
+          begin + blockSize) - 1;
+
+      // One GEMM gives the dot products of every point in the block with
+      // every centroid.
+      const arma::mat products = centroids.t() * dataset.cols(begin, end);
+
+      for (size_t i = begin; i <= end; ++i)
+      {
+        // Find the closest centroid to this point.
+        const arma::vec distances = centroidNorms -
+            2.0 * products.col(i - begin);
+        const size_t closestCluster = (size_t) distances.index_min();
+
+        // We now have the minimum distance centroid index.  Update that
+        // centroid.
+        localCentroids.unsafe_col(closestCluster) += dataset.col(i);
+        localCounts(closestCluster)++;
+      }
+    }
+    // Combine calculated state from each thread.
+    #pragma omp critical
+    {
+      newCentroids += localCentroids;
+      counts += localCounts;
+    }
+  }
+
+  // Now normalize the centroid.
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+    if (counts(i) != 0)
+      newCentroids.col(i) /= counts(i);
+
+  distanceCalculations += centroids.n_cols * dataset.n_cols;
+
+  // Calculate cluster distortion for this iteration.
+  double cNorm = 0.0;
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+  {
+    cNorm += std::pow(metric.Evaluate(centroids.col(i), newCentroids.col(i)),
+        2.0);
+  }
+  distanceCalculations += centroids.n_cols;
+
+  return std::sqrt(cNorm);
+}
+
+} // namespace mlpack
+
+#endif
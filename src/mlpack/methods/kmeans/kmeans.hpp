@@ -17,6 +17,7 @@
 // Include initialization strategies.
 #include "sample_initialization.hpp"
 #include "kmeans_plus_plus_initialization.hpp"
+#include "kmeans_parallel_initialization.hpp"
 #include "random_partition.hpp"
 
 // Include empty cluster policies.
@@ -26,6 +27,8 @@
 
 // Include Lloyd step types.
 #include "naive_kmeans.hpp"
+#include "blocked_kmeans.hpp"
+#include "mini_batch_kmeans.hpp"
 #include "dual_tree_kmeans.hpp"
 #include "elkan_kmeans.hpp"
 #include "hamerly_kmeans.hpp"
@@ -164,6 +167,36 @@ class KMeans
                const bool initialAssignmentGuess = false,
                const bool initialCentroidGuess = false);
 
+  /**
+   * Incrementally recluster data for which a previous clustering is known,
+   * for example when a small fraction of the points has changed since the
+   * last run.  The assignments vector and centroids matrix must hold the
+   * previous result (assignments for changed points may be stale; they only
+   * need to be valid cluster indices).  No initialization policy is run.
+   *
+   * In each pass the centroids are recomputed as the means of the current
+   * assignments, and a point is only compared against all centroids when its
+   * distance to its own centroid exceeds half the distance from that centroid
+   * to its nearest other centroid; by the triangle inequality, any other
+   * point provably cannot change its assignment.  When the previous
+   * clustering is near the fixed point of the new data, almost every point is
+   * pruned with a single distance calculation, so a pass costs O(n + k^2)
+   * distance evaluations instead of O(nk).  Iteration stops when no
+   * assignment changes (a Lloyd fixed point) or after maxIterations passes.
+   *
+   * @tparam MatType Type of matrix (arma::mat or arma::sp_mat).
+   * @param data Dataset to recluster.
+   * @param clusters Number of clusters.
+   * @param assignments Previous cluster assignments; overwritten with the new
+   *      assignments.
+   * @param centroids Previous cluster centroids; overwritten with the new
+   *      centroids.
+   */
+  void Recluster(const MatType& data,
+                 const size_t clusters,
+                 arma::Row<size_t>& assignments,
+                 arma::mat& centroids);
+
   //! Get the maximum number of iterations.
   size_t MaxIterations() const { return maxIterations; }
   //! Set the maximum number of iterations.
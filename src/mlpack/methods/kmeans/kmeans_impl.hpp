@@ -327,6 +327,148 @@ Cluster(const MatType& data,
   }
 }
 
+/**
+ * Incrementally recluster data for which a previous clustering is known.
+ */
+template<typename MetricType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         template<class, class> class LloydStepType,
+         typename MatType>
+void KMeans<
+    MetricType,
+    InitialPartitionPolicy,
+    EmptyClusterPolicy,
+    LloydStepType,
+    MatType>::
+Recluster(const MatType& data,
+          const size_t clusters,
+          arma::Row<size_t>& assignments,
+          arma::mat& centroids)
+{
+  // The previous result must cover the current data.
+  util::CheckSameSizes(data, assignments, "KMeans::Recluster()",
+      "assignments");
+  util::CheckSameSizes(centroids, clusters, "KMeans::Recluster()", "clusters");
+  util::CheckSameDimensionality(data, centroids, "KMeans::Recluster()");
+
+  arma::Col<size_t> counts(clusters);
+  arma::vec halfMinDistances(clusters);
+  size_t iteration = 0;
+  size_t changed;
+
+  do
+  {
+    // Recompute the centroids as the means of the current assignments.  This
+    // needs no distance calculations.
+    centroids.zeros(data.n_rows, clusters);
+    counts.zeros();
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      centroids.col(assignments[i]) += arma::vec(data.col(i));
+      counts[assignments[i]]++;
+    }
+
+    for (size_t c = 0; c < clusters; ++c)
+    {
+      if (counts[c] != 0)
+      {
+        centroids.col(c) /= counts[c];
+      }
+      else
+      {
+        Log::Info << "Cluster " << c << " is empty.\n";
+        emptyClusterAction.EmptyCluster(data, c, centroids, centroids, counts,
+            metric, iteration);
+      }
+    }
+
+    // For each centroid, find half the distance to its nearest other
+    // centroid; this is Hamerly's s(c) bound.
+    halfMinDistances.fill(DBL_MAX);
+    for (size_t i = 0; i < clusters; ++i)
+    {
+      for (size_t j = i + 1; j < clusters; ++j)
+      {
+        const double dist = metric.Evaluate(centroids.col(i),
+            centroids.col(j)) / 2.0;
+        if (dist < halfMinDistances(i))
+          halfMinDistances(i) = dist;
+        if (dist < halfMinDistances(j))
+          halfMinDistances(j) = dist;
+      }
+    }
+
+    // Now check each point.  If a point is within half the distance from its
+    // centroid to the nearest other centroid, the triangle inequality
+    // guarantees no other centroid is closer, so one distance calculation
+    // settles it; only points near a cluster boundary (or whose data or
+    // centroid has changed) are compared against every centroid.
+    changed = 0;
+    #pragma omp parallel for reduction(+: changed)
+    for (size_t i = 0; i < (size_t) data.n_cols; ++i)
+    {
+      double minDistance = metric.Evaluate(data.col(i),
+          centroids.col(assignments[i]));
+      if (minDistance <= halfMinDistances(assignments[i]))
+        continue;
+
+      size_t closestCluster = assignments[i];
+      for (size_t c = 0; c < clusters; ++c)
+      {
+        if (c == assignments[i])
+          continue;
+
+        const double distance = metric.Evaluate(data.col(i),
+            centroids.col(c));
+        if (distance < minDistance)
+        {
+          minDistance = distance;
+          closestCluster = c;
+        }
+      }
+
+      if (closestCluster != assignments[i])
+      {
+        assignments[i] = closestCluster;
+        ++changed;
+      }
+    }
+
+    iteration++;
+    Log::Info << "KMeans::Recluster(): iteration " << iteration << ", "
+        << changed << " reassigned points.\n";
+  } while (changed > 0 && iteration != maxIterations);
+
+  // If the iteration limit cut the loop short, the centroids were computed
+  // before the last round of reassignments and must be refreshed.
+  if (changed > 0)
+  {
+    centroids.zeros(data.n_rows, clusters);
+    counts.zeros();
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      centroids.col(assignments[i]) += arma::vec(data.col(i));
+      counts[assignments[i]]++;
+    }
+
+    for (size_t c = 0; c < clusters; ++c)
+      if (counts[c] != 0)
+        centroids.col(c) /= counts[c];
+  }
+
+  if (changed == 0)
+  {
+    Log::Info << "KMeans::Recluster(): converged after " << iteration
+        << " iterations." << std::endl;
+  }
+  else
+  {
+    Log::Info << "KMeans::Recluster(): terminated after limit of " << iteration
+        << " iterations." << std::endl;
+  }
+}
+
 template<typename MetricType,
          typename InitialPartitionPolicy,
          typename EmptyClusterPolicy,
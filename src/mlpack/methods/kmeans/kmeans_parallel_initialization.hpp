@@ -0,0 +1,213 @@
+/**
+ * @file methods/kmeans/kmeans_parallel_initialization.hpp
+ *
+ * This file implements the k-means|| ("k-means parallel") initialization
+ * strategy, a scalable variant of k-means++.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_HPP
+#define MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+
+/**
+ * This class implements the k-means|| initialization, as described in the
+ * following paper:
+ *
+ * @code
+ * @article{bahmani2012scalable,
+ *   title={Scalable k-means++},
+ *   author={Bahmani, B. and Moseley, B. and Vattani, A. and Kumar, R. and
+ *       Vassilvitskii, S.},
+ *   journal={Proceedings of the VLDB Endowment},
+ *   volume={5},
+ *   number={7},
+ *   pages={622--633},
+ *   year={2012}
+ * }
+ * @endcode
+ *
+ * Where k-means++ makes one full pass over the data for each of the k
+ * centroids it picks, k-means|| makes only a small fixed number of passes:
+ * each round samples an expected `oversampling` new candidate centroids
+ * independently (each point with probability proportional to its squared
+ * distance from the current candidate set), and after the rounds the
+ * candidates are weighted by the number of points they attract and reduced to
+ * k centroids with weighted k-means++.  The per-point distance computations
+ * in each pass run in parallel, and each pass streams over the columns of the
+ * data matrix in order, so the strategy is suitable for datasets too large to
+ * seed with k-means++ (e.g. memory-mapped matrices, where each pass is one
+ * sequential scan instead of k of them).
+ *
+ * In accordance with mlpack's InitialPartitionPolicy template type, we only
+ * need to implement a constructor and a method to compute the initial
+ * centroids.
+ */
+class KMeansParallelInitialization
+{
+ public:
+  /**
+   * Construct the k-means|| initialization object.
+   *
+   * @param rounds Number of sampling passes over the data.  The paper shows
+   *      that O(log n) rounds match the k-means++ guarantee, but that a
+   *      constant number of rounds is enough in practice.
+   * @param oversampling Expected number of candidates sampled per round; if
+   *      0 (the default), 2k is used.
+   */
+  KMeansParallelInitialization(const size_t rounds = 5,
+                               const double oversampling = 0.0) :
+      rounds(rounds),
+      oversampling(oversampling)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Initialize the centroids matrix using the k-means|| strategy.
+   *
+   * @param data Dataset.
+   * @param clusters Number of clusters.
+   * @param centroids Matrix to put initial centroids into.
+   */
+  template<typename MatType>
+  inline void Cluster(const MatType& data,
+                      const size_t clusters,
+                      arma::mat& centroids) const
+  {
+    // The first candidate is sampled fully randomly, and we track the squared
+    // distance from each point to its closest candidate.  Each round only has
+    // to compute distances to the candidates added in that round.
+    std::vector<size_t> candidates;
+    candidates.push_back(RandInt(0, data.n_cols));
+
+    arma::vec minDistances(data.n_cols);
+    #pragma omp parallel for
+    for (size_t p = 0; p < (size_t) data.n_cols; ++p)
+    {
+      minDistances[p] = SquaredEuclideanDistance::Evaluate(data.col(p),
+          data.col(candidates[0]));
+    }
+    double cost = arma::accu(minDistances);
+
+    const double l = (oversampling > 0.0) ? oversampling :
+        2.0 * (double) clusters;
+
+    for (size_t round = 0; round < rounds && cost > 0.0; ++round)
+    {
+      // Sample each point independently with probability l * d^2(x) / cost.
+      std::vector<size_t> newCandidates;
+      for (size_t p = 0; p < data.n_cols; ++p)
+        if (Random() < l * minDistances[p] / cost)
+          newCandidates.push_back(p);
+
+      if (newCandidates.empty())
+        continue;
+
+      // Update each point's distance to the candidate set.
+      #pragma omp parallel for
+      for (size_t p = 0; p < (size_t) data.n_cols; ++p)
+      {
+        for (size_t j = 0; j < newCandidates.size(); ++j)
+        {
+          const double distance = SquaredEuclideanDistance::Evaluate(
+              data.col(p), data.col(newCandidates[j]));
+          minDistances[p] = std::min(minDistances[p], distance);
+        }
+      }
+
+      candidates.insert(candidates.end(), newCandidates.begin(),
+          newCandidates.end());
+      cost = arma::accu(minDistances);
+    }
+
+    centroids.set_size(data.n_rows, clusters);
+
+    // If we somehow ended up with too few candidates (tiny datasets or an
+    // early zero-cost exit), pad the candidate set with random points.
+    while (candidates.size() < clusters)
+      candidates.push_back(RandInt(0, data.n_cols));
+
+    arma::mat candidateSet(data.n_rows, candidates.size());
+    for (size_t j = 0; j < candidates.size(); ++j)
+      candidateSet.col(j) = arma::vec(data.col(candidates[j]));
+
+    // Weight each candidate by the number of points closest to it.
+    arma::vec weights(candidateSet.n_cols, arma::fill::zeros);
+    #pragma omp parallel
+    {
+      arma::vec localWeights(candidateSet.n_cols, arma::fill::zeros);
+
+      #pragma omp for
+      for (size_t p = 0; p < (size_t) data.n_cols; ++p)
+      {
+        size_t closest = 0;
+        double closestDistance = std::numeric_limits<double>::max();
+        for (size_t j = 0; j < candidateSet.n_cols; ++j)
+        {
+          const double distance = SquaredEuclideanDistance::Evaluate(
+              data.col(p), candidateSet.col(j));
+          if (distance < closestDistance)
+          {
+            closestDistance = distance;
+            closest = j;
+          }
+        }
+        localWeights[closest] += 1.0;
+      }
+
+      #pragma omp critical
+      weights += localWeights;
+    }
+
+    // Now reduce the weighted candidate set to k centroids with weighted
+    // k-means++.  The candidate set has O(l * rounds) points, so this is
+    // cheap.
+    centroids.col(0) = candidateSet.col(SampleFromCDF(arma::cumsum(weights)));
+
+    arma::vec candidateDistances(candidateSet.n_cols);
+    candidateDistances.fill(std::numeric_limits<double>::max());
+    for (size_t i = 1; i < clusters; ++i)
+    {
+      for (size_t j = 0; j < candidateSet.n_cols; ++j)
+      {
+        const double distance = SquaredEuclideanDistance::Evaluate(
+            candidateSet.col(j), centroids.col(i - 1));
+        candidateDistances[j] = std::min(candidateDistances[j], distance);
+      }
+
+      centroids.col(i) = candidateSet.col(SampleFromCDF(
+          arma::cumsum(weights % candidateDistances)));
+    }
+  }
+
+ private:
+  //! Number of sampling passes over the data.
+  size_t rounds;
+  //! Expected number of candidates sampled per pass (0 means use 2k).
+  double oversampling;
+
+  /**
+   * Sample an index proportionally to the (unnormalized) CDF given in cdf.
+   */
+  static size_t SampleFromCDF(const arma::vec& cdf)
+  {
+    const double total = cdf[cdf.n_elem - 1];
+    if (total <= 0.0)
+      return RandInt(0, cdf.n_elem); // Degenerate case: sample uniformly.
+
+    const double sampleValue = Random() * total;
+    const double* elem = std::lower_bound(cdf.begin(), cdf.end(), sampleValue);
+    return std::min((size_t) (elem - cdf.begin()), (size_t) cdf.n_elem - 1);
+  }
+};
+
+} // namespace mlpack
+
+#endif
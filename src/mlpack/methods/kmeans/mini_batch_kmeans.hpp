@@ -0,0 +1,94 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans.hpp
+ *
+ * An implementation of a mini-batch step for k-means clustering, after the
+ * algorithm of Sculley (2010).  Each step touches only a small random sample
+ * of the data, so the cost of an iteration is independent of the number of
+ * points.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * This is an implementation of a single mini-batch step for k-means, in the
+ * manner of Sculley's "Web-scale k-means clustering" (2010).  Instead of a
+ * full pass over the data, each call to Iterate() draws a random batch of
+ * points, assigns them to their closest centroids, and then moves each of
+ * those centroids towards the assigned points with a per-centroid learning
+ * rate of 1 / (number of points ever assigned to the centroid).  The decaying
+ * rate makes the centroids converge even though every batch is noisy.
+ *
+ * The results are not identical to full-batch Lloyd iterations, but the
+ * inertia is usually comparable after far less work, which makes this the
+ * policy of choice when the dataset is too large for full passes.  Since only
+ * a sample of the data is seen, the returned counts are the cumulative
+ * assignment counts, and a cluster is reported empty only if no batch has
+ * ever assigned a point to it.
+ *
+ * If your intention is to run the full k-means algorithm, you are looking for
+ * the KMeans class instead of this one.  This class is used by KMeans as the
+ * actual implementation of the Lloyd iteration.
+ *
+ * @param MetricType Type of metric used with this implementation.
+ * @param MatType Matrix type (arma::mat or arma::sp_mat).
+ */
+template<typename MetricType, typename MatType>
+class MiniBatchKMeans
+{
+ public:
+  /**
+   * Construct the MiniBatchKMeans object with the given dataset and metric.
+   *
+   * @param dataset Dataset.
+   * @param metric Instantiated metric.
+   */
+  MiniBatchKMeans(const MatType& dataset, MetricType& metric);
+
+  /**
+   * Run a single mini-batch step, updating the given centroids into the
+   * newCentroids matrix.  Centroids that do not appear in the batch are
+   * carried over unchanged.
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Cumulative number of points assigned to each cluster over
+   *     all batches so far.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+ private:
+  //! Number of points sampled for each batch.
+  static const size_t batchSize = 1000;
+
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated metric.
+  MetricType& metric;
+
+  //! Cumulative per-centroid assignment counts; these drive the per-centroid
+  //! learning-rate decay.
+  arma::Col<size_t> clusterCounts;
+
+  //! Number of distance calculations.
+  size_t distanceCalculations;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "mini_batch_kmeans_impl.hpp"
+
+#endif
@@ -0,0 +1,106 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans_impl.hpp
+ *
+ * An implementation of a mini-batch step for k-means clustering, after the
+ * algorithm of Sculley (2010).  Each step touches only a small random sample
+ * of the data, so the cost of an iteration is independent of the number of
+ * points.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mini_batch_kmeans.hpp"
+
+namespace mlpack {
+
+template<typename MetricType, typename MatType>
+MiniBatchKMeans<MetricType, MatType>::MiniBatchKMeans(const MatType& dataset,
+                                                      MetricType& metric) :
+    dataset(dataset),
+    metric(metric),
+    distanceCalculations(0)
+{ /* Nothing to do. */ }
+
+// Run a single mini-batch step.
+template<typename MetricType, typename MatType>
+double MiniBatchKMeans<MetricType, MatType>::Iterate(
+    const arma::mat& centroids,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& counts)
+{
+  // The first iteration (or a change in the number of clusters) resets the
+  // learning-rate counters.
+  if (clusterCounts.n_elem != centroids.n_cols)
+    clusterCounts.zeros(centroids.n_cols);
+
+  // Centroids that do not appear in the batch are carried over unchanged.
+  newCentroids = centroids;
+
+  // Draw the batch.
+  const size_t batch = std::min((size_t) dataset.n_cols, batchSize);
+  arma::Col<size_t> batchPoints(batch);
+  for (size_t i = 0; i < batch; ++i)
+    batchPoints[i] = (size_t) RandInt(dataset.n_cols);
+
+  // Assign every point in the batch to its closest centroid.  The
+  // assignments are made against the centroids as they were at the start of
+  // the step, as in Sculley's algorithm.
+  arma::Col<size_t> assignments(batch);
+  #pragma omp parallel for
+  for (size_t i = 0; i < batch; ++i)
+  {
+    double minDistance = std::numeric_limits<double>::infinity();
+    size_t closestCluster = centroids.n_cols; // Invalid value.
+
+    for (size_t j = 0; j < centroids.n_cols; ++j)
+    {
+      const double distance = metric.Evaluate(dataset.col(batchPoints[i]),
+          centroids.unsafe_col(j));
+      if (distance < minDistance)
+      {
+        minDistance = distance;
+        closestCluster = j;
+      }
+    }
+
+    Log::Assert(closestCluster != centroids.n_cols);
+    assignments[i] = closestCluster;
+  }
+
+  // Move each assigned centroid towards its points with a per-centroid
+  // learning rate that decays as more points are assigned to it.
+  for (size_t i = 0; i < batch; ++i)
+  {
+    const size_t cluster = assignments[i];
+    const double eta = 1.0 / (double) ++clusterCounts(cluster);
+    newCentroids.col(cluster) = (1.0 - eta) * newCentroids.col(cluster) +
+        eta * arma::vec(dataset.col(batchPoints[i]));
+  }
+
+  counts = clusterCounts;
+
+  distanceCalculations += centroids.n_cols * batch;
+
+  // Calculate how far the centroids moved in this step.  As the learning
+  // rates decay, this goes to zero, so the usual convergence check in
+  // KMeans::Cluster() applies.
+  double cNorm = 0.0;
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+  {
+    cNorm += std::pow(metric.Evaluate(centroids.col(i), newCentroids.col(i)),
+        2.0);
+  }
+  distanceCalculations += centroids.n_cols;
+
+  return std::sqrt(cNorm);
+}
+
+} // namespace mlpack
+
+#endif
@@ -39,37 +39,39 @@ double NaiveKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
   counts.zeros(centroids.n_cols);
 
   // Find the closest centroid to each point and update the new centroids.
-  // Computed in parallel over the complete dataset
+  // Computed in parallel over the complete dataset; the points are processed
+  // in blocks, and the centroid distances of each block are computed as one
+  // batch (a single BLAS call for the L2 metrics) instead of a scalar loop
+  // per point.
+  const size_t blockSize = 256;
   #pragma omp parallel
   {
     // The current state of the K-means is private for each thread
     arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
         arma::fill::zeros);
     arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+    arma::mat distances;
 
-    #pragma omp for
-    for (size_t i = 0; i < (size_t) dataset.n_cols; ++i)
+    #pragma omp for schedule(dynamic)
+    for (size_t block = 0; block < (size_t) dataset.n_cols;
+        block += blockSize)
     {
-      // Find the closest centroid to this point.
-      double minDistance = std::numeric_limits<double>::infinity();
-      size_t closestCluster = centroids.n_cols; // Invalid value.
+      const size_t lastCol = std::min(block + blockSize,
+          (size_t) dataset.n_cols) - 1;
+      PairwiseDistances(centroids, dataset.cols(block, lastCol), metric,
+          distances);
 
-      for (size_t j = 0; j < centroids.n_cols; ++j)
+      for (size_t i = block; i <= lastCol; ++i)
       {
-        const double distance = metric.Evaluate(dataset.col(i),
-            centroids.unsafe_col(j));
-        if (distance < minDistance)
-        {
-          minDistance = distance;
-          closestCluster = j;
-        }
-      }
-
-      Log::Assert(closestCluster != centroids.n_cols);
+        // Find the closest centroid to this point.
+        arma::uword closestCluster;
+        distances.col(i - block).min(closestCluster);
 
-      // We now have the minimum distance centroid index.  Update that centroid.
-      localCentroids.unsafe_col(closestCluster) += dataset.col(i);
-      localCounts(closestCluster)++;
+        // We now have the minimum distance centroid index.  Update that
+        // centroid.
+        localCentroids.unsafe_col(closestCluster) += dataset.col(i);
+        localCounts(closestCluster)++;
+      }
     }
     // Combine calculated state from each thread
     #pragma omp critical
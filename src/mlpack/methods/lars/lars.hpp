@@ -271,6 +271,64 @@ class LARS
                const arma::rowvec& responses,
                const bool transposeData = true);
 
+  /**
+   * Train by cyclic coordinate descent on a user-supplied grid of lambda1
+   * values, instead of computing the full LARS homotopy path.  The solutions
+   * for the grid values are computed in order, each warm-started from the
+   * previous one, and each solve iterates mostly over the active (nonzero)
+   * dimensions, with full passes over all dimensions only to check for new
+   * activations.  Columns of the Gram matrix are computed lazily, only for
+   * dimensions that become active, so when only a few lambda1 values are
+   * needed this is far faster than Train() for high-dimensional data.
+   *
+   * The lambda1 member of the class is ignored by this method and the given
+   * grid is used instead; pass a one-element grid to solve for a single
+   * value.  For effective warm starts the grid should be in decreasing
+   * order.  The lambda2 member is applied as usual (elastic net).  After
+   * training, BetaPath(), LambdaPath() and InterceptPath() hold one element
+   * per grid value, and Beta() is the solution for the last grid value.
+   *
+   * Each solve runs until the largest single-coordinate decrease of the
+   * objective in a pass is less than the tolerance of the class, or until
+   * maxIterations passes have been made.
+   *
+   * @param data Column-major input data (or row-major input data if
+   *     transposeData = false).
+   * @param responses A vector of targets.
+   * @param lambdaGrid Values of lambda1 to compute solutions for.
+   * @param beta Vector to store the last solution (the coefficients) in.
+   * @param transposeData Set to false if the data is row-major.
+   * @param maxIterations Maximum number of coordinate descent passes for
+   *     each lambda1 value.
+   * @return minimum cost error(||y-beta*X||2 is used to calculate error).
+   */
+  double TrainCD(const arma::mat& data,
+                 const arma::rowvec& responses,
+                 const arma::vec& lambdaGrid,
+                 arma::vec& beta,
+                 const bool transposeData = true,
+                 const size_t maxIterations = 10000);
+
+  /**
+   * Train by cyclic coordinate descent on a user-supplied grid of lambda1
+   * values, instead of computing the full LARS homotopy path.  This overload
+   * does not return the solution coefficients; use Beta() to access them.
+   *
+   * @param data Column-major input data (or row-major input data if
+   *     transposeData = false).
+   * @param responses A vector of targets.
+   * @param lambdaGrid Values of lambda1 to compute solutions for.
+   * @param transposeData Set to false if the data is row-major.
+   * @param maxIterations Maximum number of coordinate descent passes for
+   *     each lambda1 value.
+   * @return minimum cost error(||y-beta*X||2 is used to calculate error).
+   */
+  double TrainCD(const arma::mat& data,
+                 const arma::rowvec& responses,
+                 const arma::vec& lambdaGrid,
+                 const bool transposeData = true,
+                 const size_t maxIterations = 10000);
+
   /**
    * Predict y_i for each data point in the given data matrix using the
    * currently-trained LARS model.
@@ -669,6 +669,245 @@ inline double LARS::Train(const arma::mat& data,
   return Train(data, responses, beta, transposeData);
 }
 
+inline double LARS::TrainCD(const arma::mat& matX,
+                            const arma::rowvec& y,
+                            const arma::vec& lambdaGrid,
+                            arma::vec& beta,
+                            const bool transposeData,
+                            const size_t maxIterations)
+{
+  if (lambdaGrid.n_elem == 0)
+  {
+    throw std::invalid_argument("LARS::TrainCD(): lambdaGrid must contain at "
+        "least one value!");
+  }
+
+  // Clear any previous solution information.
+  betaPath.clear();
+  lambdaPath.clear();
+  interceptPath.clear();
+  activeSet.clear();
+  isActive.clear();
+  ignoreSet.clear();
+  isIgnored.clear();
+  matUtriCholFactor.reset();
+
+  // This matrix may end up holding the transpose -- if necessary.
+  arma::mat dataTrans;
+  // This vector may hold zero-centered responses, if necessary.
+  arma::rowvec yCentered;
+
+  // dataRef is row-major.  We can reuse the given matX, but only if we don't
+  // need to do any transformations to it.
+  const arma::mat& dataRef =
+      (transposeData || fitIntercept || normalizeData) ? dataTrans : matX;
+  const arma::rowvec& yRef =
+      (fitIntercept) ? yCentered : y;
+
+  arma::vec offsetX; // used only if fitting an intercept
+  double offsetY = 0.0; // used only if fitting an intercept
+  arma::vec stdX; // used only if normalizing
+
+  if (transposeData)
+  {
+    if (fitIntercept)
+    {
+      offsetX = arma::mean(matX, 1);
+      dataTrans = (matX.each_col() - offsetX).t();
+    }
+
+    if (normalizeData)
+    {
+      stdX = arma::stddev(matX, 0, 1);
+      stdX.replace(0.0, 1.0); // Make sure we don't divide by 0!
+
+      // Check if we have already done the transposition.
+      if (!fitIntercept)
+        dataTrans = (matX.each_col() / stdX).t();
+      else
+        dataTrans.each_row() /= stdX.t();
+    }
+
+    // Make sure we convert the data to row-major format, even if no
+    // transformations were needed.
+    if (!fitIntercept && !normalizeData)
+      dataTrans = matX.t();
+  }
+  else
+  {
+    // We don't need to transpose the data---it's already in row-major form.
+    if (fitIntercept)
+    {
+      offsetX = arma::mean(matX, 0).t();
+      dataTrans = (matX.each_row() - offsetX.t());
+    }
+
+    if (normalizeData)
+    {
+      stdX = arma::stddev(matX, 0, 0).t();
+      stdX.replace(0.0, 1.0); // Make sure we don't divide by 0!
+
+      // Check if we have already populated `dataTrans`.
+      if (!fitIntercept)
+        dataTrans = (matX.each_row() / stdX.t());
+      else
+        dataTrans.each_row() /= stdX.t();
+    }
+
+    // If we are not fitting an intercept and we are not normalizing the data,
+    // dataTrans already points to matX so we don't need to do anything.
+  }
+
+  if (fitIntercept)
+  {
+    offsetY = arma::mean(y);
+    yCentered = y - offsetY;
+  }
+
+  // Set up active set variables.  These are filled at the end of training
+  // with the nonzero dimensions of the last solution.
+  isActive.resize(dataRef.n_cols, false);
+  isIgnored.resize(dataRef.n_cols, false);
+
+  // Squared norms of each dimension; this is the diagonal of the Gram
+  // matrix.
+  const arma::vec colNorms = trans(arma::sum(arma::square(dataRef), 0));
+
+  // Columns of the Gram matrix, computed lazily: a dimension only needs its
+  // column once it becomes active, so for sparse solutions most columns are
+  // never computed ("covariance updates" in the terminology of glmnet).
+  std::vector<arma::vec> gramCols(dataRef.n_cols);
+
+  // corr(j) holds x_j' (y - X beta); with beta = 0 this is X' y.  It is
+  // maintained incrementally from the cached Gram columns.
+  arma::vec corr = trans(yRef * dataRef);
+
+  beta = arma::zeros(dataRef.n_cols);
+
+  for (size_t l = 0; l < lambdaGrid.n_elem; ++l)
+  {
+    const double lambda = lambdaGrid[l];
+
+    // One coordinate descent update of dimension j; the return value is the
+    // decrease of the objective, which we use as the convergence measure.
+    auto update = [&](const size_t j)
+    {
+      // Correlation of dimension j with the partial residual that excludes
+      // the contribution of dimension j itself.
+      const double partialCorr = corr(j) + colNorms(j) * beta(j);
+
+      // Soft-thresholding update; the denominator handles the l2 penalty.
+      double newBeta = 0.0;
+      if (partialCorr > lambda)
+        newBeta = (partialCorr - lambda) / (colNorms(j) + lambda2);
+      else if (partialCorr < -lambda)
+        newBeta = (partialCorr + lambda) / (colNorms(j) + lambda2);
+
+      const double diff = newBeta - beta(j);
+      if (diff == 0.0)
+        return 0.0;
+
+      // Compute the Gram column the first time dimension j moves.
+      if (gramCols[j].n_elem == 0)
+        gramCols[j] = trans(dataRef) * dataRef.col(j);
+
+      corr -= diff * gramCols[j];
+      beta(j) = newBeta;
+
+      return (colNorms(j) + lambda2) * diff * diff;
+    };
+
+    size_t iter = 0;
+    bool converged = false;
+    std::vector<size_t> workingSet;
+    while (iter < maxIterations)
+    {
+      // Take a full pass over all dimensions; this may activate new ones.
+      double maxChange = 0.0;
+      for (size_t j = 0; j < dataRef.n_cols; ++j)
+        maxChange = std::max(maxChange, update(j));
+      ++iter;
+
+      // If a full pass changes nothing, the solution is optimal.
+      if (maxChange < tolerance)
+      {
+        converged = true;
+        break;
+      }
+
+      // Iterate over only the current nonzero dimensions until they
+      // converge, then go back and take another full pass.
+      workingSet.clear();
+      for (size_t j = 0; j < dataRef.n_cols; ++j)
+        if (beta(j) != 0.0)
+          workingSet.push_back(j);
+
+      while (iter < maxIterations)
+      {
+        maxChange = 0.0;
+        for (size_t i = 0; i < workingSet.size(); ++i)
+          maxChange = std::max(maxChange, update(workingSet[i]));
+        ++iter;
+
+        if (maxChange < tolerance)
+          break;
+      }
+    }
+
+    if (!converged)
+    {
+      Log::Warn << "LARS::TrainCD(): coordinate descent did not converge for "
+          << "lambda1 = " << lambda << "; increase maxIterations or the "
+          << "tolerance." << std::endl;
+    }
+
+    betaPath.push_back(beta);
+    lambdaPath.push_back(lambda);
+  }
+
+  // Perform un-scaling of learned beta, if needed, to account for
+  // normalization.
+  if (normalizeData)
+  {
+    for (size_t i = 0; i < betaPath.size(); ++i)
+    {
+      betaPath[i] /= stdX;
+    }
+  }
+
+  // Set the intercept values; all zero if an intercept wasn't fit.
+  if (fitIntercept)
+  {
+    for (size_t i = 0; i < betaPath.size(); ++i)
+      interceptPath.push_back(offsetY - arma::dot(offsetX, betaPath[i]));
+  }
+  else
+  {
+    interceptPath.resize(betaPath.size(), 0.0);
+  }
+
+  // Fill the active set with the nonzero dimensions of the last solution.
+  for (size_t j = 0; j < dataRef.n_cols; ++j)
+    if (betaPath.back()(j) != 0.0)
+      Activate(j);
+
+  // Unfortunate copy...
+  beta = betaPath.back();
+
+  return ComputeError(matX, y, !transposeData);
+}
+
+inline double LARS::TrainCD(const arma::mat& data,
+                            const arma::rowvec& responses,
+                            const arma::vec& lambdaGrid,
+                            const bool transposeData,
+                            const size_t maxIterations)
+{
+  arma::vec beta;
+  return TrainCD(data, responses, lambdaGrid, beta, transposeData,
+      maxIterations);
+}
+
 inline void LARS::Predict(const arma::mat& points,
                           arma::rowvec& predictions,
                           const bool rowMajor) const
@@ -94,6 +94,39 @@ class LinearRegression
                const arma::rowvec& weights,
                const bool intercept = true);
 
+  /**
+   * Add the given data points to an already-trained model, without refitting
+   * from scratch.  The Cholesky factor of the Gram matrix (X X^T + lambda I)
+   * is kept by Train() and updated here with one rank-1 update per new
+   * point, so the cost is O(d^2) per point instead of O(n d^2) for a full
+   * refit.
+   *
+   * This may also be called on an untrained model, in which case the Gram
+   * matrix is built from the given points; if there are fewer points than
+   * dimensions, lambda must be greater than zero for the factorization to
+   * exist.  The intercept setting of the model is kept.
+   *
+   * @param predictors X, the matrix of data points to add to the model.
+   * @param responses y, the responses to the data points.
+   * @return The least squares error of the updated model on the given points.
+   */
+  double TrainIncremental(const arma::mat& predictors,
+                          const arma::rowvec& responses);
+
+  /**
+   * Remove the given data points from an already-trained model, e.g. points
+   * that have expired from a sliding window.  This is the inverse of
+   * TrainIncremental(): the Cholesky factor of the Gram matrix is downdated
+   * with one rank-1 downdate per point, at O(d^2) per point.  The points
+   * (and their responses) must have been part of the model's training data;
+   * otherwise the downdated Gram matrix may lose positive definiteness, and
+   * a fatal error is reported.
+   *
+   * @param predictors X, the matrix of data points to remove from the model.
+   * @param responses y, the responses to the data points.
+   */
+  void Forget(const arma::mat& predictors, const arma::rowvec& responses);
+
   /**
    * Calculate y_i for each data point in points.
    *
@@ -144,9 +177,25 @@ class LinearRegression
     ar(CEREAL_NVP(parameters));
     ar(CEREAL_NVP(lambda));
     ar(CEREAL_NVP(intercept));
+    ar(CEREAL_NVP(covChol));
+    ar(CEREAL_NVP(xty));
   }
 
  private:
+  /**
+   * Apply the rank-1 update R'^T R' = R^T R + x x^T to the upper triangular
+   * Cholesky factor R, in-place, using Givens rotations.
+   */
+  static void CholUpdate(arma::mat& R, arma::vec x);
+
+  /**
+   * Apply the rank-1 downdate R'^T R' = R^T R - x x^T to the upper
+   * triangular Cholesky factor R, in-place, using hyperbolic rotations.
+   * Returns false (leaving R partially modified) if the downdated matrix is
+   * not positive definite.
+   */
+  static bool CholDowndate(arma::mat& R, arma::vec x);
+
   /**
    * The calculated B.
    * Initialized and filled by constructor to hold the least squares solution.
@@ -161,6 +210,17 @@ class LinearRegression
 
   //! Indicates whether first parameter is intercept.
   bool intercept;
+
+  /**
+   * Upper triangular Cholesky factor of the Gram matrix (X X^T + lambda I),
+   * maintained by Train() and the incremental updates.  Empty if the Gram
+   * matrix of the last Train() call was not positive definite; then
+   * incremental updates are not possible until the model is retrained.
+   */
+  arma::mat covChol;
+
+  //! The right-hand side X y^T of the normal equations.
+  arma::vec xty;
 };
 
 } // namespace mlpack
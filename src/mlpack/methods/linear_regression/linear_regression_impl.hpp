@@ -91,10 +91,161 @@ inline double LinearRegression::Train(const arma::mat& predictors,
   arma::mat cov = p * p.t() +
       lambda * arma::eye<arma::mat>(p.n_rows, p.n_rows);
 
-  parameters = arma::solve(cov, p * r.t());
+  xty = p * r.t();
+  parameters = arma::solve(cov, xty);
+
+  // Keep the Cholesky factor of the Gram matrix so that TrainIncremental()
+  // and Forget() can update the model later without a full refit.  If the
+  // Gram matrix is not positive definite (e.g. fewer points than dimensions
+  // and lambda == 0), incremental updates are not possible.
+  if (!arma::chol(covChol, cov))
+    covChol.reset();
+
   return ComputeError(predictors, responses);
 }
 
+inline double LinearRegression::TrainIncremental(
+    const arma::mat& predictors,
+    const arma::rowvec& responses)
+{
+  // Sanity check on data.
+  util::CheckSameSizes(predictors, responses,
+      "LinearRegression::TrainIncremental()");
+
+  arma::mat p = predictors;
+  if (intercept)
+    p.insert_rows(0, arma::ones<arma::mat>(1, predictors.n_cols));
+
+  if (covChol.is_empty())
+  {
+    // The model is untrained (or the last Train() call could not factorize
+    // the Gram matrix), so build the Gram matrix from the given points.
+    arma::mat cov = p * p.t() +
+        lambda * arma::eye<arma::mat>(p.n_rows, p.n_rows);
+    xty = p * responses.t();
+
+    if (!arma::chol(covChol, cov))
+    {
+      covChol.reset();
+      Log::Fatal << "LinearRegression::TrainIncremental(): Gram matrix is "
+          << "not positive definite; pass more points or set lambda greater "
+          << "than zero!" << std::endl;
+    }
+  }
+  else
+  {
+    if (p.n_rows != covChol.n_rows)
+    {
+      Log::Fatal << "LinearRegression::TrainIncremental(): given points have "
+          << p.n_rows << " dimensions, but the model has "
+          << covChol.n_rows << " dimensions!" << std::endl;
+    }
+
+    // One rank-1 update of the factorization per new point.
+    for (size_t i = 0; i < p.n_cols; ++i)
+    {
+      CholUpdate(covChol, p.col(i));
+      xty += responses[i] * p.col(i);
+    }
+  }
+
+  // Solve the two triangular systems; this is O(d^2).
+  parameters = arma::solve(arma::trimatu(covChol),
+      arma::solve(arma::trimatl(covChol.t()), xty));
+
+  return ComputeError(predictors, responses);
+}
+
+inline void LinearRegression::Forget(const arma::mat& predictors,
+                                     const arma::rowvec& responses)
+{
+  // Sanity check on data.
+  util::CheckSameSizes(predictors, responses, "LinearRegression::Forget()");
+
+  if (covChol.is_empty())
+  {
+    Log::Fatal << "LinearRegression::Forget(): the model has not been "
+        << "trained!" << std::endl;
+  }
+
+  arma::mat p = predictors;
+  if (intercept)
+    p.insert_rows(0, arma::ones<arma::mat>(1, predictors.n_cols));
+
+  if (p.n_rows != covChol.n_rows)
+  {
+    Log::Fatal << "LinearRegression::Forget(): given points have "
+        << p.n_rows << " dimensions, but the model has " << covChol.n_rows
+        << " dimensions!" << std::endl;
+  }
+
+  // One rank-1 downdate of the factorization per removed point.
+  for (size_t i = 0; i < p.n_cols; ++i)
+  {
+    if (!CholDowndate(covChol, p.col(i)))
+    {
+      covChol.reset();
+      Log::Fatal << "LinearRegression::Forget(): downdated Gram matrix is "
+          << "not positive definite; were the given points part of the "
+          << "training data?" << std::endl;
+    }
+
+    xty -= responses[i] * p.col(i);
+  }
+
+  // Solve the two triangular systems; this is O(d^2).
+  parameters = arma::solve(arma::trimatu(covChol),
+      arma::solve(arma::trimatl(covChol.t()), xty));
+}
+
+inline void LinearRegression::CholUpdate(arma::mat& R, arma::vec x)
+{
+  const size_t n = R.n_cols;
+  for (size_t k = 0; k < n; ++k)
+  {
+    const double r = std::sqrt(R(k, k) * R(k, k) + x[k] * x[k]);
+    const double c = r / R(k, k);
+    const double s = x[k] / R(k, k);
+    R(k, k) = r;
+
+    if (k + 1 < n)
+    {
+      R(k, arma::span(k + 1, n - 1)) =
+          (R(k, arma::span(k + 1, n - 1)) + s * x.subvec(k + 1, n - 1).t()) /
+          c;
+      x.subvec(k + 1, n - 1) = c * x.subvec(k + 1, n - 1) -
+          s * R(k, arma::span(k + 1, n - 1)).t();
+    }
+  }
+}
+
+inline bool LinearRegression::CholDowndate(arma::mat& R, arma::vec x)
+{
+  const size_t n = R.n_cols;
+  for (size_t k = 0; k < n; ++k)
+  {
+    const double rSquared = R(k, k) * R(k, k) - x[k] * x[k];
+    if (rSquared <= 0.0)
+      return false;
+
+    const double r = std::sqrt(rSquared);
+    const double c = r / R(k, k);
+    const double s = x[k] / R(k, k);
+    R(k, k) = r;
+
+    if (k + 1 < n)
+    {
+      R(k, arma::span(k + 1, n - 1)) =
+          (R(k, arma::span(k + 1, n - 1)) - s * x.subvec(k + 1, n - 1).t()) /
+          c;
+      x.subvec(k + 1, n - 1) = c * x.subvec(k + 1, n - 1) -
+          s * R(k, arma::span(k + 1, n - 1)).t();
+    }
+  }
+
+  return true;
+}
+
 inline void LinearRegression::Predict(
     const arma::mat& points,
     arma::rowvec& predictions) const
@@ -198,6 +198,44 @@ class LinearSVM
   void Classify(const MatType& data,
                 arma::mat& scores) const;
 
+  /**
+   * Classify the given points, returning the top k class labels and their
+   * scores for each point, ordered by decreasing score.  Scores are computed
+   * one block of classes at a time, keeping only a running list of the k
+   * best candidates for each point, so the full numClasses x n score matrix
+   * is never materialized; classes whose score cannot enter the current top
+   * k are rejected with a single comparison.  For models with very many
+   * classes this is much faster and far smaller in memory than Classify().
+   *
+   * If Quantize() has been called, scores are computed from the 8-bit
+   * quantized weights instead of the full-precision weights; see Quantize().
+   *
+   * An exception will be thrown if k is 0 or greater than the number of
+   * classes.
+   *
+   * @param data Set of points to classify.
+   * @param k Number of top classes to return for each point.
+   * @param labels Matrix to store predicted class labels in (size k x n).
+   * @param scores Matrix to store class scores in (size k x n).
+   */
+  void ClassifyTopK(const MatType& data,
+                    const size_t k,
+                    arma::Mat<size_t>& labels,
+                    arma::mat& scores) const;
+
+  /**
+   * Quantize the class weights of the trained model to 8 bits, with one
+   * scale per class, for use by ClassifyTopK().  Reading 8-bit weights needs
+   * a quarter of the memory bandwidth of double-precision weights, which is
+   * the bottleneck of inference with very many classes.  Quantization is
+   * lossy: each weight is rounded to one of 255 levels, so scores (and, for
+   * nearly-tied classes, predictions) may differ slightly from the
+   * full-precision model.  The full-precision weights are kept, and
+   * Classify() continues to use them; retraining the model discards the
+   * quantized weights.
+   */
+  void Quantize();
+
   /**
    * Classify the given point. The predicted class label is returned.
    * The function calculates the scores for every class, given the point.
@@ -281,6 +319,12 @@ class LinearSVM
   //! Get the model parameters.
   const arma::mat& Parameters() const { return parameters; }
 
+  //! Get the 8-bit quantized weights (empty unless Quantize() was called).
+  const arma::Mat<arma::s8>& QuantizedParameters() const
+  { return quantizedParameters; }
+  //! Get the per-class scales of the 8-bit quantized weights.
+  const arma::vec& QuantizationScales() const { return quantizationScales; }
+
   //! Gets the features size of the training data
   size_t FeatureSize() const
   { return fitIntercept ? parameters.n_rows - 1 :
@@ -296,11 +340,17 @@ class LinearSVM
     ar(CEREAL_NVP(numClasses));
     ar(CEREAL_NVP(lambda));
     ar(CEREAL_NVP(fitIntercept));
+    ar(CEREAL_NVP(quantizedParameters));
+    ar(CEREAL_NVP(quantizationScales));
   }
 
  private:
   //! Parameters after optimization.
   arma::mat parameters;
+  //! 8-bit quantized weights; empty unless Quantize() was called.
+  arma::Mat<arma::s8> quantizedParameters;
+  //! Per-class scales of the 8-bit quantized weights.
+  arma::vec quantizationScales;
   //! Number of classes.
   size_t numClasses;
   //! L2-Regularization constant.
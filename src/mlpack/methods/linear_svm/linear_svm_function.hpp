@@ -116,10 +116,38 @@ class LinearSVMFunction
    * @param batchSize Size of the batch to process.
    */
   template <typename GradType>
-  void Gradient(const arma::mat& parameters,
-                const size_t firstId,
-                GradType& gradient,
-                const size_t batchSize = 1);
+  typename std::enable_if<
+      !(arma::is_arma_sparse_type<MatType>::value &&
+        arma::is_arma_sparse_type<GradType>::value), void>::type
+  Gradient(const arma::mat& parameters,
+           const size_t firstId,
+           GradType& gradient,
+           const size_t batchSize = 1);
+
+  /**
+   * Evaluate the gradient of the hinge loss function on the specified
+   * datapoints, when both the data and the requested gradient are sparse.
+   * This iterates only over the nonzero features of the batch: the data term
+   * of the gradient is accumulated per nonzero, and the L2 term is applied
+   * only to the features present in the batch (the standard sparse
+   * formulation, equivalent to lazily rescaling the weight vector), so the
+   * cost is independent of the data dimensionality.  This is the kernel used
+   * by sparse parallel SGD.
+   *
+   * @tparam GradType Type of the gradient matrix.
+   * @param parameters The parameters of the SVM.
+   * @param firstId Index of the datapoint to use for the gradient evaluation.
+   * @param gradient Sparse matrix to output the gradient into.
+   * @param batchSize Size of the batch to process.
+   */
+  template <typename GradType>
+  typename std::enable_if<
+      (arma::is_arma_sparse_type<MatType>::value &&
+       arma::is_arma_sparse_type<GradType>::value), void>::type
+  Gradient(const arma::mat& parameters,
+           const size_t firstId,
+           GradType& gradient,
+           const size_t batchSize = 1);
 
   /**
    * Evaluate the gradient of the hinge loss function, following
@@ -299,7 +299,10 @@ void LinearSVMFunction<MatType>::Gradient(
 
 template <typename MatType>
 template <typename GradType>
-void LinearSVMFunction<MatType>::Gradient(
+typename std::enable_if<
+    !(arma::is_arma_sparse_type<MatType>::value &&
+      arma::is_arma_sparse_type<GradType>::value), void>::type
+LinearSVMFunction<MatType>::Gradient(
     const arma::mat& parameters,
     const size_t firstId,
     GradType& gradient,
@@ -354,6 +357,110 @@ void LinearSVMFunction<MatType>::Gradient(
   gradient += lambda * parameters;
 }
 
+template <typename MatType>
+template <typename GradType>
+typename std::enable_if<
+    (arma::is_arma_sparse_type<MatType>::value &&
+     arma::is_arma_sparse_type<GradType>::value), void>::type
+LinearSVMFunction<MatType>::Gradient(
+    const arma::mat& parameters,
+    const size_t firstId,
+    GradType& gradient,
+    const size_t batchSize)
+{
+  const size_t lastId = firstId + batchSize - 1;
+
+  // The scores are only numClasses x batchSize; compute them by iterating
+  // over the nonzeros of the batch instead of forming any product with the
+  // full dataset.
+  arma::mat scores;
+  if (fitIntercept)
+    scores = arma::repmat(parameters.row(dataset.n_rows).t(), 1, batchSize);
+  else
+    scores.zeros(numClasses, batchSize);
+
+  for (size_t j = firstId; j <= lastId; ++j)
+  {
+    for (auto it = dataset.begin_col(j); it != dataset.end_col(j); ++it)
+      scores.col(j - firstId) += (*it) * parameters.row(it.row()).t();
+  }
+
+  arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
+      * (scores % groundTruth.cols(firstId, lastId)), numClasses, 1))
+      + delta - (delta * groundTruth.cols(firstId, lastId));
+
+  // For each sample, find the total number of classes where
+  // ( margin > 0 ).
+  arma::mat mask = margin.for_each([](arma::mat::elem_type& val)
+      { val = (val > 0) ? 1: 0; });
+
+  arma::mat difference = groundTruth.cols(firstId, lastId)
+      % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
+
+  // Collect the features that appear in this batch; the data term of the
+  // gradient is zero for every other feature.
+  std::vector<arma::uword> touched;
+  for (size_t j = firstId; j <= lastId; ++j)
+  {
+    for (auto it = dataset.begin_col(j); it != dataset.end_col(j); ++it)
+      touched.push_back(it.row());
+  }
+  std::sort(touched.begin(), touched.end());
+  touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+
+  // Accumulate the gradient rows of the touched features.
+  arma::mat touchedGradient(touched.size(), numClasses, arma::fill::zeros);
+  for (size_t j = firstId; j <= lastId; ++j)
+  {
+    for (auto it = dataset.begin_col(j); it != dataset.end_col(j); ++it)
+    {
+      const size_t index = std::lower_bound(touched.begin(), touched.end(),
+          it.row()) - touched.begin();
+      touchedGradient.row(index) += (*it) * difference.col(j - firstId).t();
+    }
+  }
+  touchedGradient /= batchSize;
+
+  // Apply the L2 term only to the touched features (and the intercept): a
+  // sparse gradient is applied coordinate-wise by the optimizer, and
+  // regularizing only the coordinates present in the batch is the standard
+  // sparse formulation, equivalent to lazily rescaling the weight vector.
+  for (size_t i = 0; i < touched.size(); ++i)
+    touchedGradient.row(i) += lambda * parameters.row(touched[i]);
+
+  // Assemble the sparse gradient from its nonzero entries.
+  const size_t interceptRows = fitIntercept ? 1 : 0;
+  arma::umat locations(2, (touched.size() + interceptRows) * numClasses);
+  arma::vec values((touched.size() + interceptRows) * numClasses);
+  size_t loc = 0;
+  for (size_t i = 0; i < touched.size(); ++i)
+  {
+    for (size_t c = 0; c < numClasses; ++c)
+    {
+      locations(0, loc) = touched[i];
+      locations(1, loc) = c;
+      values(loc) = touchedGradient(i, c);
+      ++loc;
+    }
+  }
+
+  if (fitIntercept)
+  {
+    const arma::rowvec interceptGradient = arma::sum(difference, 1).t() /
+        batchSize + lambda * parameters.row(dataset.n_rows);
+    for (size_t c = 0; c < numClasses; ++c)
+    {
+      locations(0, loc) = dataset.n_rows;
+      locations(1, loc) = c;
+      values(loc) = interceptGradient[c];
+      ++loc;
+    }
+  }
+
+  gradient = GradType(locations, values, parameters.n_rows,
+      parameters.n_cols);
+}
+
 template <typename MatType>
 template <typename GradType>
 double LinearSVMFunction<MatType>::EvaluateWithGradient(
@@ -103,6 +103,10 @@ double LinearSVM<MatType>::Train(
   if (parameters.is_empty())
     parameters = svm.InitialPoint();
 
+  // Any quantized weights no longer match the model.
+  quantizedParameters.reset();
+  quantizationScales.reset();
+
   // Train the model.
   const double out = optimizer.Optimize(svm, parameters, callbacks...);
 
@@ -130,6 +134,10 @@ double LinearSVM<MatType>::Train(
   if (parameters.is_empty())
     parameters = svm.InitialPoint();
 
+  // Any quantized weights no longer match the model.
+  quantizedParameters.reset();
+  quantizationScales.reset();
+
   // Train the model.
   const double out = optimizer.Optimize(svm, parameters);
 
@@ -182,6 +190,148 @@ void LinearSVM<MatType>::Classify(
   }
 }
 
+template <typename MatType>
+void LinearSVM<MatType>::ClassifyTopK(
+    const MatType& data,
+    const size_t k,
+    arma::Mat<size_t>& labels,
+    arma::mat& scores) const
+{
+  util::CheckSameDimensionality(data, FeatureSize(),
+      "LinearSVM::ClassifyTopK()");
+
+  if (k == 0 || k > numClasses)
+  {
+    std::ostringstream oss;
+    oss << "LinearSVM::ClassifyTopK(): k (" << k << ") must be between 1 and "
+        << "the number of classes (" << numClasses << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  labels.set_size(k, data.n_cols);
+  scores.set_size(k, data.n_cols);
+
+  const size_t features = FeatureSize();
+  const bool useQuantized = !quantizedParameters.is_empty();
+
+  // Process the points in blocks, and for each block of points process the
+  // classes in blocks too; this way only a small partial score matrix exists
+  // at any time, and it stays cache-resident.
+  const size_t blockSize = 256;
+  const size_t classBlockSize = 256;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < data.n_cols; block += blockSize)
+  {
+    const size_t lastCol = std::min(block + blockSize,
+        (size_t) data.n_cols) - 1;
+    const size_t blockCols = lastCol - block + 1;
+
+    // Running list of the k best candidate classes for each point of the
+    // block, ordered by decreasing score.
+    arma::mat bestScores(k, blockCols);
+    bestScores.fill(-DBL_MAX);
+    arma::Mat<size_t> bestClasses(k, blockCols, arma::fill::zeros);
+
+    arma::mat partialScores;
+    for (size_t cBlock = 0; cBlock < numClasses; cBlock += classBlockSize)
+    {
+      const size_t lastClass = std::min(cBlock + classBlockSize,
+          numClasses) - 1;
+
+      // Compute the scores of this block of classes only.
+      if (useQuantized)
+      {
+        // Accumulate scores from the 8-bit weights; only the quantized
+        // weight block is streamed from memory.
+        partialScores.set_size(lastClass - cBlock + 1, blockCols);
+        for (size_t c = cBlock; c <= lastClass; ++c)
+        {
+          for (size_t j = block; j <= lastCol; ++j)
+          {
+            double sum = 0.0;
+            for (size_t i = 0; i < features; ++i)
+              sum += (double) quantizedParameters(i, c) * data(i, j);
+            sum *= quantizationScales[c];
+            if (fitIntercept)
+              sum += parameters(parameters.n_rows - 1, c);
+            partialScores(c - cBlock, j - block) = sum;
+          }
+        }
+      }
+      else if (fitIntercept)
+      {
+        partialScores = parameters.submat(0, cBlock, parameters.n_rows - 2,
+            lastClass).t() * data.cols(block, lastCol);
+        partialScores.each_col() += parameters.submat(parameters.n_rows - 1,
+            cBlock, parameters.n_rows - 1, lastClass).t();
+      }
+      else
+      {
+        partialScores = parameters.cols(cBlock, lastClass).t() *
+            data.cols(block, lastCol);
+      }
+
+      // Merge the partial scores into the running candidate lists.
+      for (size_t j = 0; j < blockCols; ++j)
+      {
+        for (size_t c = 0; c <= lastClass - cBlock; ++c)
+        {
+          const double score = partialScores(c, j);
+
+          // Most classes cannot enter the top k and are rejected here.
+          if (score <= bestScores(k - 1, j))
+            continue;
+
+          // Insert into the sorted candidate list.  On ties, the class seen
+          // first is kept first, matching index_max().
+          size_t pos = k - 1;
+          while (pos > 0 && bestScores(pos - 1, j) < score)
+          {
+            bestScores(pos, j) = bestScores(pos - 1, j);
+            bestClasses(pos, j) = bestClasses(pos - 1, j);
+            --pos;
+          }
+          bestScores(pos, j) = score;
+          bestClasses(pos, j) = cBlock + c;
+        }
+      }
+    }
+
+    labels.cols(block, lastCol) = bestClasses;
+    scores.cols(block, lastCol) = bestScores;
+  }
+}
+
+template <typename MatType>
+void LinearSVM<MatType>::Quantize()
+{
+  if (parameters.is_empty())
+  {
+    throw std::invalid_argument("LinearSVM::Quantize(): no model has been "
+        "trained!");
+  }
+
+  const size_t features = FeatureSize();
+  quantizedParameters.set_size(features, numClasses);
+  quantizationScales.set_size(numClasses);
+
+  // Quantize each class's weights symmetrically to [-127, 127], with one
+  // scale per class.  The intercept row (if any) is not quantized; it is a
+  // single value per class and is added at full precision.
+  for (size_t c = 0; c < numClasses; ++c)
+  {
+    const double maxAbs = arma::abs(
+        parameters(arma::span(0, features - 1), c)).max();
+    quantizationScales[c] = (maxAbs > 0.0) ? maxAbs / 127.0 : 1.0;
+    for (size_t i = 0; i < features; ++i)
+    {
+      quantizedParameters(i, c) = (arma::s8) std::round(
+          parameters(i, c) / quantizationScales[c]);
+    }
+  }
+}
+
 template <typename MatType>
 template <typename VecType>
 size_t LinearSVM<MatType>::Classify(const VecType& point) const
@@ -47,30 +47,40 @@ inline void Constraints<MetricType>::ReorderResults(
     return;
 
   // Just a simple loop over the results---we want to make sure that the
-  // largest-norm point with identical distance has the last location.
-  for (size_t i = 0; i < neighbors.n_cols; ++i)
+  // largest-norm point with identical distance has the last location.  The
+  // columns are independent, so they are processed in blocks dispatched
+  // across threads.
+  const size_t blockSize = 256;
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < neighbors.n_cols; block += blockSize)
   {
-    for (size_t start = 0; start < neighbors.n_rows - 1; start++)
-    {
-      size_t end = start + 1;
-      while (distances(start, i) == distances(end, i) &&
-          end < neighbors.n_rows)
-      {
-        end++;
-        if (end == neighbors.n_rows)
-          break;
-      }
+    const size_t lastCol = std::min(block + blockSize,
+        (size_t) neighbors.n_cols) - 1;
 
-      if (start != end)
+    for (size_t i = block; i <= lastCol; ++i)
+    {
+      for (size_t start = 0; start < neighbors.n_rows - 1; start++)
       {
-        // We must sort these elements by norm.
-        arma::Col<size_t> newNeighbors =
-            neighbors.col(i).subvec(start, end - 1);
-        arma::uvec indices = arma::conv_to<arma::uvec>::from(newNeighbors);
-
-        arma::uvec order = arma::sort_index(norms.elem(indices));
-        neighbors.col(i).subvec(start, end - 1) =
-            newNeighbors.elem(order);
+        size_t end = start + 1;
+        while (distances(start, i) == distances(end, i) &&
+            end < neighbors.n_rows)
+        {
+          end++;
+          if (end == neighbors.n_rows)
+            break;
+        }
+
+        if (start != end)
+        {
+          // We must sort these elements by norm.
+          arma::Col<size_t> newNeighbors =
+              neighbors.col(i).subvec(start, end - 1);
+          arma::uvec indices = arma::conv_to<arma::uvec>::from(newNeighbors);
+
+          arma::uvec order = arma::sort_index(norms.elem(indices));
+          neighbors.col(i).subvec(start, end - 1) =
+              newNeighbors.elem(order);
+        }
       }
     }
   }
@@ -86,14 +96,17 @@ void Constraints<MetricType>::TargetNeighbors(arma::Mat<size_t>& outputMatrix,
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  // KNN instance.
-  KNN knn;
-
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
-
+  // The per-class searches are independent and each writes only the columns
+  // of its own class, so they are dispatched across threads.
+  #pragma omp parallel for schedule(dynamic)
   for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
   {
+    // KNN instance.
+    KNN knn;
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+
     // Perform KNN search with same class points as both reference
     // set and query set.
     knn.Train(dataset.cols(indexSame[i]));
@@ -128,19 +141,19 @@ void Constraints<MetricType>::TargetNeighbors(arma::Mat<size_t>& outputMatrix,
   arma::mat subDataset = dataset.cols(begin, begin + batchSize - 1);
   arma::Row<size_t> sublabels = labels.cols(begin, begin + batchSize - 1);
 
-  // KNN instance.
-  KNN knn;
-
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
-
-  // Vectors to store indices.
-  arma::uvec subIndexSame;
-
+  // The per-class searches are independent and each writes only the columns
+  // of its own class, so they are dispatched across threads.
+  #pragma omp parallel for schedule(dynamic)
   for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
   {
+    // KNN instance.
+    KNN knn;
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+
     // Calculate Target Neighbors.
-    subIndexSame = arma::find(sublabels == uniqueLabels[i]);
+    arma::uvec subIndexSame = arma::find(sublabels == uniqueLabels[i]);
 
     // Perform KNN search with same class points as both reference
     // set and query set.
@@ -170,14 +183,17 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputMatrix,
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  // KNN instance.
-  KNN knn;
-
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
-
+  // The per-class searches are independent and each writes only the columns
+  // of its own class, so they are dispatched across threads.
+  #pragma omp parallel for schedule(dynamic)
   for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
   {
+    // KNN instance.
+    KNN knn;
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+
     // Perform KNN search with differently labeled points as reference
     // set and  same class points as query set.
     knn.Train(dataset.cols(indexDiff[i]));
@@ -208,14 +224,17 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputNeighbors,
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  // KNN instance.
-  KNN knn;
-
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
-
+  // The per-class searches are independent and each writes only the columns
+  // of its own class, so they are dispatched across threads.
+  #pragma omp parallel for schedule(dynamic)
   for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
   {
+    // KNN instance.
+    KNN knn;
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+
     // Perform KNN search with differently labeled points as reference
     // set and  same class points as query set.
     knn.Train(dataset.cols(indexDiff[i]));
@@ -251,19 +270,19 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputMatrix,
   arma::mat subDataset = dataset.cols(begin, begin + batchSize - 1);
   arma::Row<size_t> sublabels = labels.cols(begin, begin + batchSize - 1);
 
-  // KNN instance.
-  KNN knn;
-
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
-
-  // Vectors to store indices.
-  arma::uvec subIndexSame;
-
+  // The per-class searches are independent and each writes only the columns
+  // of its own class, so they are dispatched across threads.
+  #pragma omp parallel for schedule(dynamic)
   for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
   {
+    // KNN instance.
+    KNN knn;
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+
     // Calculate impostors.
-    subIndexSame = arma::find(sublabels == uniqueLabels[i]);
+    arma::uvec subIndexSame = arma::find(sublabels == uniqueLabels[i]);
 
     // Perform KNN search with differently labeled points as reference
     // set and same class points as query set.
@@ -300,19 +319,19 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputNeighbors,
   arma::mat subDataset = dataset.cols(begin, begin + batchSize - 1);
   arma::Row<size_t> sublabels = labels.cols(begin, begin + batchSize - 1);
 
-  // KNN instance.
-  KNN knn;
-
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
-
-  // Vectors to store indices.
-  arma::uvec subIndexSame;
-
+  // The per-class searches are independent and each writes only the columns
+  // of its own class, so they are dispatched across threads.
+  #pragma omp parallel for schedule(dynamic)
   for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
   {
+    // KNN instance.
+    KNN knn;
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+
     // Calculate impostors.
-    subIndexSame = arma::find(sublabels == uniqueLabels[i]);
+    arma::uvec subIndexSame = arma::find(sublabels == uniqueLabels[i]);
 
     // Perform KNN search with differently labeled points as reference
     // set and same class points as query set.
@@ -347,19 +366,19 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputNeighbors,
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  // KNN instance.
-  KNN knn;
-
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
-
-  // Vectors to store indices.
-  arma::uvec subIndexSame;
-
+  // The per-class searches are independent and each writes only the columns
+  // of its own class, so they are dispatched across threads.
+  #pragma omp parallel for schedule(dynamic)
   for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
   {
+    // KNN instance.
+    KNN knn;
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+
     // Calculate impostors.
-    subIndexSame = arma::find(labels.cols(points.head(numPoints)) ==
+    arma::uvec subIndexSame = arma::find(labels.cols(points.head(numPoints)) ==
         uniqueLabels[i]);
 
     // Perform KNN search with differently labeled points as reference
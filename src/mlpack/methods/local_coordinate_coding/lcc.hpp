@@ -15,6 +15,7 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/methods/lars/lars.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 
 // Include three simple dictionary initializers from sparse coding.
 #include <mlpack/methods/sparse_coding/nothing_initializer.hpp>
@@ -195,6 +196,19 @@ class LocalCoordinateCoding
   //! Modify the objective tolerance.
   double& Tolerance() { return tolerance; }
 
+  //! Get the number of anchor atoms each point is encoded against (0 means
+  //! all atoms).
+  size_t NeighborAtoms() const { return neighborAtoms; }
+  //! Modify the number of anchor atoms each point is encoded against.  When
+  //! set to a nonzero value smaller than the number of atoms, Encode() finds
+  //! the nearest atoms of every point with a single kd-tree search over the
+  //! dictionary and solves each local regression only against those anchors,
+  //! reducing the per-point cost from the full dictionary size to the
+  //! neighbor count.  Since the locality penalty already drives the weights
+  //! of far-away atoms to zero, a moderate neighbor count typically leaves
+  //! the codes essentially unchanged.
+  size_t& NeighborAtoms() { return neighborAtoms; }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -213,6 +227,8 @@ class LocalCoordinateCoding
   size_t maxIterations;
   //! Tolerance for main objective.
   double tolerance;
+  //! Number of anchor atoms each point is encoded against (0 means all).
+  size_t neighborAtoms;
 };
 
 } // namespace mlpack
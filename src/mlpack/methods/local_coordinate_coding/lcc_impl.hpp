@@ -28,7 +28,8 @@ LocalCoordinateCoding::LocalCoordinateCoding(
     atoms(atoms),
     lambda(lambda),
     maxIterations(maxIterations),
-    tolerance(tolerance)
+    tolerance(tolerance),
+    neighborAtoms(0)
 {
   // Train the model.
   Train(data, initializer);
@@ -42,7 +43,8 @@ inline LocalCoordinateCoding::LocalCoordinateCoding(
     atoms(atoms),
     lambda(lambda),
     maxIterations(maxIterations),
-    tolerance(tolerance)
+    tolerance(tolerance),
+    neighborAtoms(0)
 {
   // Nothing to do.
 }
@@ -118,38 +120,92 @@ double LocalCoordinateCoding::Train(
 inline void LocalCoordinateCoding::Encode(const arma::mat& data,
                                           arma::mat& codes)
 {
-  arma::mat invSqDists = 1.0 / (repmat(trans(sum(square(dictionary))), 1,
-      data.n_cols) + repmat(sum(square(data)), atoms, 1) - 2 * trans(dictionary)
-      * data);
-
   arma::mat dictGram = trans(dictionary) * dictionary;
-  arma::mat dictGramTD(dictGram.n_rows, dictGram.n_cols);
 
-  codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
+  // The points are coded independently, so in both modes below they are
+  // processed in blocks dispatched across threads, each iteration writing
+  // only its own column of the codes matrix.
+  const size_t blockSize = 256;
+
+  if ((neighborAtoms > 0) && (neighborAtoms < atoms))
   {
-    // Report progress.
-    if ((i % 100) == 0)
+    // Restrict each point to its nearest anchor atoms.  One kd-tree search
+    // over the dictionary gives the neighbor sets and distances of all
+    // points at once; each local regression is then solved only against
+    // those anchors, so its cost depends on the neighbor count instead of
+    // the dictionary size.
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    KNN knn(dictionary);
+    knn.Search(data, neighborAtoms, neighbors, distances);
+
+    codes.zeros(atoms, data.n_cols);
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t block = 0; block < data.n_cols; block += blockSize)
     {
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
+      const size_t lastCol = std::min(block + blockSize,
+          (size_t) data.n_cols) - 1;
+
+      for (size_t i = block; i <= lastCol; ++i)
+      {
+        const arma::uvec atomIndices = arma::conv_to<arma::uvec>::from(
+            neighbors.col(i));
+        arma::vec invW = 1.0 / arma::square(distances.col(i));
+        arma::mat dictPrime = dictionary.cols(atomIndices) * diagmat(invW);
+
+        arma::mat dictGramTD = diagmat(invW) *
+            dictGram.submat(atomIndices, atomIndices) * diagmat(invW);
+
+        bool useCholesky = false;
+        // Normalization and fitting and intercept are disabled.
+        LARS lars(useCholesky, dictGramTD, 0.5 * lambda, 0,
+            1e-16 /* default tolerance */, false, false);
+
+        arma::vec beta;
+        arma::rowvec responses = data.unsafe_col(i).t();
+        lars.Train(dictPrime, responses, beta, false);
+        beta %= invW;
+
+        // Scatter the local solution into the rows of the anchor atoms; all
+        // other entries of the column stay zero.
+        for (size_t j = 0; j < neighborAtoms; ++j)
+          codes(atomIndices(j), i) = beta(j);
+      }
     }
 
-    arma::vec invW = invSqDists.unsafe_col(i);
-    arma::mat dictPrime = dictionary * diagmat(invW);
+    return;
+  }
 
-    arma::mat dictGramTD = diagmat(invW) * dictGram * diagmat(invW);
+  arma::mat invSqDists = 1.0 / (repmat(trans(sum(square(dictionary))), 1,
+      data.n_cols) + repmat(sum(square(data)), atoms, 1) - 2 * trans(dictionary)
+      * data);
 
-    bool useCholesky = false;
-    // Normalization and fitting and intercept are disabled.
-    LARS lars(useCholesky, dictGramTD, 0.5 * lambda, 0,
-        1e-16 /* default tolerance */, false, false);
+  codes.set_size(atoms, data.n_cols);
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < data.n_cols; block += blockSize)
+  {
+    const size_t lastCol = std::min(block + blockSize,
+        (size_t) data.n_cols) - 1;
 
-    // Run LARS for this point, by making an alias of the point and passing
-    // that.
-    arma::vec beta = codes.unsafe_col(i);
-    arma::rowvec responses = data.unsafe_col(i).t();
-    lars.Train(dictPrime, responses, beta, false);
-    beta %= invW; // Remember, beta is an alias of codes.col(i).
+    for (size_t i = block; i <= lastCol; ++i)
+    {
+      arma::vec invW = invSqDists.unsafe_col(i);
+      arma::mat dictPrime = dictionary * diagmat(invW);
+
+      arma::mat dictGramTD = diagmat(invW) * dictGram * diagmat(invW);
+
+      bool useCholesky = false;
+      // Normalization and fitting and intercept are disabled.
+      LARS lars(useCholesky, dictGramTD, 0.5 * lambda, 0,
+          1e-16 /* default tolerance */, false, false);
+
+      // Run LARS for this point, by making an alias of the point and passing
+      // that.
+      arma::vec beta = codes.unsafe_col(i);
+      arma::rowvec responses = data.unsafe_col(i).t();
+      lars.Train(dictPrime, responses, beta, false);
+      beta %= invW; // Remember, beta is an alias of codes.col(i).
+    }
   }
 }
 
@@ -344,6 +400,9 @@ void LocalCoordinateCoding::serialize(Archive& ar,
   ar(CEREAL_NVP(lambda));
   ar(CEREAL_NVP(maxIterations));
   ar(CEREAL_NVP(tolerance));
+
+  if (cereal::is_loading<Archive>())
+    neighborAtoms = 0;
 }
 
 } // namespace mlpack
@@ -120,6 +120,21 @@ class LogisticRegression
    * optimization.  If this is not what you want, then you should access the
    * parameters vector directly with Parameters() and modify it as desired.
    *
+   * The default L-BFGS optimizer evaluates the objective and gradient over
+   * the full dataset on every iteration (although those evaluations are
+   * computed over blocks of points in parallel when OpenMP is enabled).  For
+   * very large datasets, a mini-batch SGD configuration that makes a single
+   * pass over the data is often much cheaper and nearly as accurate:
+   *
+   * @code
+   * // One epoch of mini-batch SGD with batches of 512 points: the step size
+   * // is scaled by the batch size, and the number of iterations (which
+   * // ensmallen counts in points, not batches) is the size of the dataset.
+   * ens::StandardSGD sgd(0.01 / 512, 512, predictors.n_cols, 1e-5);
+   * LogisticRegression<> lr(predictors.n_rows, 0.0);
+   * lr.Train(predictors, responses, sgd);
+   * @endcode
+   *
    * @tparam OptimizerType Type of optimizer to use to train the model.
    * @tparam CallbackTypes Types of Callback Functions.
    * @param predictors Input training variables.
@@ -112,10 +112,38 @@ class LogisticRegressionFunction
    *     function gradient evaluation.
    */
   template<typename GradType>
-  void Gradient(const arma::mat& parameters,
-                const size_t begin,
-                GradType& gradient,
-                const size_t batchSize = 1) const;
+  typename std::enable_if<
+      !(arma::is_arma_sparse_type<MatType>::value &&
+        arma::is_arma_sparse_type<GradType>::value), void>::type
+  Gradient(const arma::mat& parameters,
+           const size_t begin,
+           GradType& gradient,
+           const size_t batchSize = 1) const;
+
+  /**
+   * Evaluate the gradient of the logistic regression log-likelihood function
+   * for the given batch, when both the data and the requested gradient are
+   * sparse.  This iterates only over the nonzero features of the batch, and
+   * the L2 term is applied only to those features (the standard sparse
+   * formulation, equivalent to lazily rescaling the weight vector), so the
+   * cost is independent of the data dimensionality.  This is the kernel used
+   * by sparse parallel SGD.
+   *
+   * @param parameters Vector of logistic regression parameters.
+   * @param begin Index of the starting point to use for objective function
+   *     gradient evaluation.
+   * @param gradient Sparse vector to output gradient into.
+   * @param batchSize Number of points to be processed as a batch for objective
+   *     function gradient evaluation.
+   */
+  template<typename GradType>
+  typename std::enable_if<
+      (arma::is_arma_sparse_type<MatType>::value &&
+       arma::is_arma_sparse_type<GradType>::value), void>::type
+  Gradient(const arma::mat& parameters,
+           const size_t begin,
+           GradType& gradient,
+           const size_t batchSize = 1) const;
 
   /**
    * Evaluate the gradient of the logistic regression log-likelihood function
@@ -81,20 +81,30 @@ double LogisticRegressionFunction<MatType>::Evaluate(
       arma::dot(parameters.tail_cols(parameters.n_elem - 1),
       parameters.tail_cols(parameters.n_elem - 1));
 
-  // Calculate vectors of sigmoids.  The intercept term is parameters(0, 0) and
-  // does not need to be multiplied by any of the predictors.
-  const arma::rowvec sigmoid = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) * predictors)));
-
-  // Assemble full objective function.  Often the objective function and the
-  // regularization as given are divided by the number of features, but this
-  // doesn't actually affect the optimization result, so we'll just ignore those
-  // terms for computational efficiency.  Note that the conversion causes some
-  // copy and slowdown, but this is so negligible compared to the rest of the
-  // calculation it is not worth optimizing for.
-  const double result = arma::accu(arma::log(1.0 -
-      arma::conv_to<arma::rowvec>::from(responses) + sigmoid %
-      (2 * arma::conv_to<arma::rowvec>::from(responses) - 1.0)));
+  // Assemble the full objective function over blocks of points, which can be
+  // processed in parallel.  The intercept term is parameters(0, 0) and does
+  // not need to be multiplied by any of the predictors.  Often the objective
+  // function and the regularization as given are divided by the number of
+  // features, but this doesn't actually affect the optimization result, so
+  // we'll just ignore those terms for computational efficiency.
+  const size_t blockSize = 4096;
+  double result = 0.0;
+  #pragma omp parallel for schedule(dynamic) reduction(+ : result)
+  for (size_t block = 0; block < predictors.n_cols; block += blockSize)
+  {
+    const size_t lastCol =
+        std::min(block + blockSize, (size_t) predictors.n_cols) - 1;
+
+    // Calculate the vector of sigmoids for this block.
+    const arma::rowvec sigmoid = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
+        parameters.tail_cols(parameters.n_elem - 1) *
+        predictors.cols(block, lastCol))));
+
+    const arma::rowvec respD = arma::conv_to<arma::rowvec>::from(
+        responses.subvec(block, lastCol));
+    result += arma::accu(arma::log(1.0 - respD + sigmoid %
+        (2 * respD - 1.0)));
+  }
 
   // Invert the result, because it's a minimization.
   return regularization - result;
@@ -141,20 +151,44 @@ void LogisticRegressionFunction<MatType>::Gradient(
   arma::mat regularization;
   regularization = lambda * parameters.tail_cols(parameters.n_elem - 1);
 
-  const arma::rowvec sigmoids = (1 / (1 + arma::exp(-parameters(0, 0)
-      - parameters.tail_cols(parameters.n_elem - 1) * predictors)));
+  gradient.zeros(arma::size(parameters));
 
-  gradient.set_size(arma::size(parameters));
-  gradient[0] = -arma::accu(responses - sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - responses) *
-      predictors.t() + regularization;
+  // Accumulate the gradient over blocks of points; each thread computes the
+  // partial gradient of its block and merges it into the result.
+  const size_t blockSize = 4096;
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < predictors.n_cols; block += blockSize)
+  {
+    const size_t lastCol =
+        std::min(block + blockSize, (size_t) predictors.n_cols) - 1;
+
+    const arma::rowvec sigmoids = (1 / (1 + arma::exp(-parameters(0, 0)
+        - parameters.tail_cols(parameters.n_elem - 1) *
+        predictors.cols(block, lastCol))));
+
+    const arma::rowvec diffs = sigmoids -
+        responses.subvec(block, lastCol);
+    const arma::mat blockGradient = diffs *
+        predictors.cols(block, lastCol).t();
+
+    #pragma omp critical
+    {
+      gradient[0] += arma::accu(diffs);
+      gradient.tail_cols(parameters.n_elem - 1) += blockGradient;
+    }
+  }
+
+  gradient.tail_cols(parameters.n_elem - 1) += regularization;
 }
 
 //! Evaluate the gradient of the logistic regression objective function for a
 //! given batch size.
 template<typename MatType>
 template<typename GradType>
-void LogisticRegressionFunction<MatType>::Gradient(
+typename std::enable_if<
+    !(arma::is_arma_sparse_type<MatType>::value &&
+      arma::is_arma_sparse_type<GradType>::value), void>::type
+LogisticRegressionFunction<MatType>::Gradient(
                 const arma::mat& parameters,
                 const size_t begin,
                 GradType& gradient,
@@ -179,6 +213,86 @@ void LogisticRegressionFunction<MatType>::Gradient(
       predictors.cols(begin, begin + batchSize - 1).t() + regularization;
 }
 
+//! Evaluate the gradient of the logistic regression objective function for a
+//! given batch size, with sparse data and a sparse gradient.
+template<typename MatType>
+template<typename GradType>
+typename std::enable_if<
+    (arma::is_arma_sparse_type<MatType>::value &&
+     arma::is_arma_sparse_type<GradType>::value), void>::type
+LogisticRegressionFunction<MatType>::Gradient(
+                const arma::mat& parameters,
+                const size_t begin,
+                GradType& gradient,
+                const size_t batchSize) const
+{
+  const size_t lastCol = begin + batchSize - 1;
+
+  // Compute the decision function values by iterating over the nonzeros of
+  // the batch instead of forming any product with the full predictors.
+  arma::rowvec exponents(batchSize);
+  exponents.fill(parameters(0, 0));
+  for (size_t j = begin; j <= lastCol; ++j)
+  {
+    for (auto it = predictors.begin_col(j); it != predictors.end_col(j); ++it)
+      exponents[j - begin] += parameters(0, it.row() + 1) * (*it);
+  }
+
+  // Calculating the sigmoid function values.
+  const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-exponents));
+  const arma::rowvec diffs = sigmoids - responses.subvec(begin, lastCol);
+
+  // Collect the features that appear in this batch; the data term of the
+  // gradient is zero for every other feature.
+  std::vector<arma::uword> touched;
+  for (size_t j = begin; j <= lastCol; ++j)
+  {
+    for (auto it = predictors.begin_col(j); it != predictors.end_col(j); ++it)
+      touched.push_back(it.row());
+  }
+  std::sort(touched.begin(), touched.end());
+  touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+
+  // Accumulate the gradient of the touched features.
+  arma::vec touchedGradient(touched.size(), arma::fill::zeros);
+  for (size_t j = begin; j <= lastCol; ++j)
+  {
+    for (auto it = predictors.begin_col(j); it != predictors.end_col(j); ++it)
+    {
+      const size_t index = std::lower_bound(touched.begin(), touched.end(),
+          it.row()) - touched.begin();
+      touchedGradient[index] += (*it) * diffs[j - begin];
+    }
+  }
+
+  // Apply the L2 term only to the touched features: a sparse gradient is
+  // applied coordinate-wise by the optimizer, and regularizing only the
+  // coordinates present in the batch is the standard sparse formulation,
+  // equivalent to lazily rescaling the weight vector.
+  for (size_t i = 0; i < touched.size(); ++i)
+  {
+    touchedGradient[i] += lambda * parameters(0, touched[i] + 1) /
+        predictors.n_cols * batchSize;
+  }
+
+  // Assemble the sparse gradient from its nonzero entries; the intercept
+  // term is always present.
+  arma::umat locations(2, touched.size() + 1);
+  arma::vec values(touched.size() + 1);
+  locations(0, 0) = 0;
+  locations(1, 0) = 0;
+  values(0) = arma::accu(diffs);
+  for (size_t i = 0; i < touched.size(); ++i)
+  {
+    locations(0, i + 1) = 0;
+    locations(1, i + 1) = touched[i] + 1;
+    values(i + 1) = touchedGradient[i];
+  }
+
+  gradient = GradType(locations, values, parameters.n_rows,
+      parameters.n_cols);
+}
+
 /**
  * Evaluate the partial gradient of the logistic regression objective
  * function with respect to the individual features in the parameter.
@@ -219,19 +333,42 @@ double LogisticRegressionFunction<MatType>::EvaluateWithGradient(
       arma::dot(parameters.tail_cols(parameters.n_elem - 1),
                 parameters.tail_cols(parameters.n_elem - 1));
 
-  // Calculate the sigmoid function values.
-  const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) * predictors)));
+  gradient.zeros(arma::size(parameters));
 
-  gradient.set_size(arma::size(parameters));
-  gradient[0] = -arma::accu(responses - sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - responses) *
-      predictors.t() + regularization;
+  // Accumulate the objective and the gradient over blocks of points; each
+  // thread computes the sigmoids of its block once and uses them for both.
+  const size_t blockSize = 4096;
+  double result = 0.0;
+  #pragma omp parallel for schedule(dynamic) reduction(+ : result)
+  for (size_t block = 0; block < predictors.n_cols; block += blockSize)
+  {
+    const size_t lastCol =
+        std::min(block + blockSize, (size_t) predictors.n_cols) - 1;
+
+    // Calculate the sigmoid function values for this block.
+    const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
+        parameters.tail_cols(parameters.n_elem - 1) *
+        predictors.cols(block, lastCol))));
+
+    const arma::rowvec diffs = sigmoids -
+        responses.subvec(block, lastCol);
+    const arma::mat blockGradient = diffs *
+        predictors.cols(block, lastCol).t();
+
+    #pragma omp critical
+    {
+      gradient[0] += arma::accu(diffs);
+      gradient.tail_cols(parameters.n_elem - 1) += blockGradient;
+    }
+
+    // Now compute the objective function using the sigmoids.
+    const arma::rowvec respD = arma::conv_to<arma::rowvec>::from(
+        responses.subvec(block, lastCol));
+    result += arma::accu(arma::log(1.0 - respD + sigmoids %
+        (2 * respD - 1.0)));
+  }
 
-  // Now compute the objective function using the sigmoids.
-  double result = arma::accu(arma::log(1.0 -
-      arma::conv_to<arma::rowvec>::from(responses) + sigmoids %
-      (2 * arma::conv_to<arma::rowvec>::from(responses) - 1.0)));
+  gradient.tail_cols(parameters.n_elem - 1) += regularization;
 
   // Invert the result, because it's a minimization.
   return objectiveRegularization - result;
@@ -192,6 +192,48 @@ class LSHSearch
              const size_t bucketSize = 500,
              const arma::cube& projection = arma::cube());
 
+  /**
+   * Train the LSH model on the given dataset, choosing numProj and numTables
+   * automatically so that a recall target is met on a sample of the reference
+   * set.  A few candidate values of numProj are tried; for each one the model
+   * is hashed with maxTables tables and the number of tables actually searched
+   * is swept upwards until the recall of approximate k-nearest-neighbor search
+   * on the sample (measured against brute-force ground truth) reaches the
+   * target.  The cheapest configuration found (fewest tables searched, then
+   * fewest projections) is kept.  If no configuration reaches the target, a
+   * warning is issued and the configuration with the best recall is kept.
+   *
+   * Note that the tuning search has to hash the reference set several times
+   * and run brute-force search on the sample, so this is significantly more
+   * expensive than a single call to Train().
+   *
+   * @param referenceSet Set of reference points and the set of queries.
+   * @param k Number of neighbors the model should be tuned for.
+   * @param targetRecall Desired recall, in the range (0, 1].
+   * @param T The number of additional probing bins to use with multiprobe LSH
+   *     during tuning (and presumably at search time too).  If T = 0, classic
+   *     single-probe LSH is tuned (default).
+   * @param maxTables Maximum number of hash tables to consider.
+   * @param sampleSize Number of reference points to sample as tuning queries.
+   * @param hashWidth The width of hash for every table. If 0 (the default) is
+   *     provided, then the hash width is automatically obtained by computing
+   *     the average pairwise distance of 25 pairs.
+   * @param secondHashSize The size of the second hash table. This should be a
+   *     large prime number.
+   * @param bucketSize The size of the bucket in the second hash table.  A
+   *     value of 0 indicates that there is no limit.
+   * @return The recall measured on the sample for the chosen configuration.
+   */
+  double Tune(MatType referenceSet,
+              const size_t k,
+              const double targetRecall,
+              const size_t T = 0,
+              const size_t maxTables = 30,
+              const size_t sampleSize = 100,
+              const double hashWidth = 0.0,
+              const size_t secondHashSize = 99901,
+              const size_t bucketSize = 500);
+
   /**
    * Compute the nearest neighbors of the points in the given query set and
    * store the output in the given matrices.  The matrices will be set to the
@@ -323,6 +365,22 @@ class LSHSearch
                               size_t numTablesToSearch,
                               const size_t T) const;
 
+  /**
+   * Compute the distances from a query point to every candidate in one
+   * blocked matrix operation.  The candidates are gathered into a dense
+   * block and all distances are obtained from a single matrix-vector product
+   * using d(q, x)^2 = |q|^2 + |x|^2 - 2 <q, x>.
+   *
+   * @param queryPoint The query point currently being processed.
+   * @param referenceIndices The vector of indices of candidate neighbors for
+   *    the query.
+   * @return Vector of distances, one per candidate, in the same order as
+   *    referenceIndices.
+   */
+  template<typename VecType>
+  arma::vec CandidateDistances(const VecType& queryPoint,
+                               const arma::uvec& referenceIndices) const;
+
   /**
    * This is a helper function that computes the distance of the query to the
    * neighbor candidates and appropriately stores the best 'k' candidates.  This
@@ -257,6 +257,9 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
   // size_t, otherwise negative numbers are cast to 0.
   arma::Mat<size_t> secondHashVectors(numTables, this->referenceSet.n_cols);
 
+  // Each table only reads its own projection slice and writes its own row of
+  // secondHashVectors, so the tables can be hashed in parallel.
+  #pragma omp parallel for
   for (size_t i = 0; i < numTables; ++i)
   {
     // Step IV: create the 'numProj'-dimensional key for each point in each
@@ -348,6 +351,159 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
             << std::endl;
 }
 
+// Train on a new reference set, picking numProj and numTables from a recall
+// target measured on a sample of the reference set.
+template<typename SortPolicy, typename MatType>
+double LSHSearch<SortPolicy, MatType>::Tune(MatType referenceSet,
+                                            const size_t k,
+                                            const double targetRecall,
+                                            const size_t T,
+                                            const size_t maxTables,
+                                            const size_t sampleSize,
+                                            const double hashWidth,
+                                            const size_t secondHashSize,
+                                            const size_t bucketSize)
+{
+  if (targetRecall <= 0.0 || targetRecall > 1.0)
+  {
+    std::ostringstream oss;
+    oss << "LSHSearch::Tune(): target recall (" << targetRecall << ") must be "
+        << "in the range (0, 1]";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (k > referenceSet.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "LSHSearch::Tune(): requested value of k (" << k << ") is greater "
+        << "than the number of points in the reference set ("
+        << referenceSet.n_cols << ")";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Sample tuning queries from the reference set.
+  const size_t numSamples = std::min(sampleSize, (size_t) referenceSet.n_cols);
+  const arma::uvec sampleIndices = arma::randperm(referenceSet.n_cols,
+      numSamples);
+  const MatType sampleQueries = referenceSet.cols(sampleIndices);
+
+  // Brute-force ground truth for the sample.  The sampled point itself is
+  // deliberately kept among its own true neighbors: the LSH search below will
+  // find it too, so recall stays consistent.
+  arma::Mat<size_t> trueNeighbors(k, numSamples);
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < numSamples; ++i)
+  {
+    arma::vec sampleDistances(referenceSet.n_cols);
+    for (size_t j = 0; j < referenceSet.n_cols; ++j)
+    {
+      sampleDistances[j] = EuclideanDistance::Evaluate(sampleQueries.col(i),
+          referenceSet.col(j));
+    }
+
+    const arma::uvec sorted = arma::sort_index(sampleDistances);
+    for (size_t j = 0; j < k; ++j)
+      trueNeighbors(j, i) = sorted[j];
+  }
+
+  // Candidate numbers of projections per table; candidate numbers of tables
+  // to search are the powers of two up to maxTables (plus maxTables itself).
+  const std::vector<size_t> projCandidates = { 10, 16, 24, 32 };
+  std::vector<size_t> tableCandidates;
+  for (size_t t = 1; t < maxTables; t *= 2)
+    tableCandidates.push_back(t);
+  tableCandidates.push_back(maxTables);
+
+  size_t bestProj = projCandidates.back();
+  size_t bestTables = maxTables;
+  double bestRecall = -1.0;
+  bool targetMet = false;
+
+  for (const size_t proj : projCandidates)
+  {
+    // Hash once with the full set of tables; searching a prefix of the tables
+    // is then equivalent to having trained with fewer tables.
+    Train(referenceSet, proj, maxTables, hashWidth, secondHashSize,
+        bucketSize);
+
+    for (const size_t tables : tableCandidates)
+    {
+      // A configuration with more tables than the current best cannot win.
+      if (targetMet && tables >= bestTables)
+        break;
+
+      arma::Mat<size_t> neighbors;
+      arma::mat distances;
+      Search(sampleQueries, k, neighbors, distances, tables, T);
+
+      const double recall = ComputeRecall(neighbors, trueNeighbors);
+      if (recall >= targetRecall)
+      {
+        targetMet = true;
+        bestProj = proj;
+        bestTables = tables;
+        bestRecall = recall;
+        break;
+      }
+      else if (!targetMet && recall > bestRecall)
+      {
+        bestProj = proj;
+        bestTables = tables;
+        bestRecall = recall;
+      }
+    }
+  }
+
+  if (!targetMet)
+  {
+    Log::Warn << "LSHSearch::Tune(): target recall " << targetRecall << " not "
+        << "reached; best configuration found gives recall " << bestRecall
+        << "." << std::endl;
+  }
+
+  Log::Info << "LSHSearch::Tune(): chose " << bestProj << " projections and "
+      << bestTables << " tables (sample recall " << bestRecall << ")."
+      << std::endl;
+
+  // Retrain with the chosen configuration so that plain Search() calls use
+  // exactly the tuned parameters.
+  Train(std::move(referenceSet), bestProj, bestTables, hashWidth,
+      secondHashSize, bucketSize);
+
+  return bestRecall;
+}
+
+// Compute all candidate distances with one matrix-vector product.
+template<typename SortPolicy, typename MatType>
+template<typename VecType>
+arma::vec LSHSearch<SortPolicy, MatType>::CandidateDistances(
+    const VecType& queryPoint,
+    const arma::uvec& referenceIndices) const
+{
+  // Gather the candidates into a dense block.  (The reference set may be
+  // sparse, and non-contiguous column views are not available for sparse
+  // matrices.)
+  arma::mat candidates(referenceSet.n_rows, referenceIndices.n_elem);
+  for (size_t j = 0; j < referenceIndices.n_elem; ++j)
+    candidates.col(j) = arma::vec(referenceSet.col(referenceIndices[j]));
+
+  const arma::vec query = arma::vec(queryPoint);
+
+  // Compute all squared distances at once as
+  // d(q, x)^2 = |q|^2 + |x|^2 - 2 <q, x>; the dominant cost is the single
+  // matrix-vector product, which is one blocked (BLAS) operation instead of
+  // one distance evaluation per candidate.
+  arma::vec squaredDistances = arma::sum(arma::square(candidates), 0).t() +
+      arma::dot(query, query) - 2.0 * (candidates.t() * query);
+
+  // Cancellation can produce tiny negative values.
+  squaredDistances.transform(
+      [](double v) { return std::sqrt(std::max(v, 0.0)); });
+
+  return squaredDistances;
+}
+
 // Base case where the query set is the reference set.  (So, we can't return
 // ourselves as the nearest neighbor.)
 template<typename SortPolicy, typename MatType>
@@ -359,6 +515,10 @@ void LSHSearch<SortPolicy, MatType>::BaseCase(
     arma::Mat<size_t>& neighbors,
     arma::mat& distances) const
 {
+  // Compute the distances to all candidates in one batch.
+  const arma::vec candidateDistances = CandidateDistances(
+      referenceSet.col(queryIndex), referenceIndices);
+
   // Let's build the list of candidate neighbors for the given query point.
   // It will be initialized with k candidates:
   // (WorstDistance, referenceSet.n_cols)
@@ -374,11 +534,7 @@ void LSHSearch<SortPolicy, MatType>::BaseCase(
     if (queryIndex == referenceIndex)
       continue;
 
-    const double distance = EuclideanDistance::Evaluate(
-        referenceSet.col(queryIndex),
-        referenceSet.col(referenceIndex));
-
-    Candidate c = std::make_pair(distance, referenceIndex);
+    Candidate c = std::make_pair(candidateDistances[j], referenceIndex);
     // If this distance is better than the worst candidate, let's insert it.
     if (CandidateCmp()(c, pqueue.top()))
     {
@@ -406,6 +562,10 @@ void LSHSearch<SortPolicy, MatType>::BaseCase(
     arma::Mat<size_t>& neighbors,
     arma::mat& distances) const
 {
+  // Compute the distances to all candidates in one batch.
+  const arma::vec candidateDistances = CandidateDistances(
+      querySet.col(queryIndex), referenceIndices);
+
   // Let's build the list of candidate neighbors for the given query point.
   // It will be initialized with k candidates:
   // (WorstDistance, referenceSet.n_cols)
@@ -417,11 +577,8 @@ void LSHSearch<SortPolicy, MatType>::BaseCase(
   for (size_t j = 0; j < referenceIndices.n_elem; ++j)
   {
     const size_t referenceIndex = referenceIndices[j];
-    const double distance = EuclideanDistance::Evaluate(
-        querySet.col(queryIndex),
-        referenceSet.col(referenceIndex));
 
-    Candidate c = std::make_pair(distance, referenceIndex);
+    Candidate c = std::make_pair(candidateDistances[j], referenceIndex);
     // If this distance is better than the worst candidate, let's insert it.
     if (CandidateCmp()(c, pqueue.top()))
     {
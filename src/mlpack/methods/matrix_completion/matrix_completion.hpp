@@ -105,6 +105,11 @@ class MatrixCompletion
   /**
    * Solve the underlying SDP to fill in the remaining values.
    *
+   * If Recover() has been called before, the optimization is warm-started
+   * from the factor of the previous solution.  This converges far faster
+   * when the observed values have only changed slightly since the last
+   * solve (the values may be updated through Sdp()).
+   *
    * @param recovered Will contain the completed matrix.
    */
   void Recover(arma::mat& recovered);
@@ -130,8 +135,13 @@ class MatrixCompletion
   //! The underlying SDP to be solved.
   ens::LRSDP<ens::SDP<arma::sp_mat>> sdp;
 
+  //! Factor of the last solution; reused to warm-start subsequent solves.
+  arma::mat optimizedPoint;
+
   //! Validate the input matrices.
   void CheckValues();
+  //! Sort the observed entries into column-major order for locality.
+  void SortEntries();
   //! Initialize the SDP.
   void InitSDP();
 
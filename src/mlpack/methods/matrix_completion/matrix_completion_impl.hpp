@@ -30,6 +30,7 @@ inline MatrixCompletion::MatrixCompletion(
     sdp(indices.n_cols, 0, arma::randu<arma::mat>(m + n, r))
 {
   CheckValues();
+  SortEntries();
   InitSDP();
 }
 
@@ -46,6 +47,7 @@ inline MatrixCompletion::MatrixCompletion(
     sdp(indices.n_cols, 0, initialPoint)
 {
   CheckValues();
+  SortEntries();
   InitSDP();
 }
 
@@ -62,6 +64,7 @@ inline MatrixCompletion::MatrixCompletion(
         arma::randu<arma::mat>(m + n, DefaultRank(m, n, indices.n_cols)))
 {
   CheckValues();
+  SortEntries();
   InitSDP();
 }
 
@@ -73,37 +76,64 @@ inline void MatrixCompletion::CheckValues()
         << "indices does not have 2 rows!" << std::endl;
   }
 
-  util::CheckSameSizes(indices, values, 
+  util::CheckSameSizes(indices, values,
       "MatrixCompletion::CheckValues()", "labels", false, true);
 
-  for (size_t i = 0; i < values.n_elem; ++i)
+  // Check all the indices against the matrix bounds in one vectorized pass,
+  // and only search for the offending entry if one exists.
+  const arma::uvec badIndices = arma::find(
+      (indices.row(0) >= m) + (indices.row(1) >= n), 1);
+  if (!badIndices.is_empty())
   {
-    if (indices(0, i) >= m || indices(1, i) >= n)
-      Log::Fatal << "MatrixCompletion::CheckValues(): indices ("
-          << indices(0, i) << ", " << indices(1, i)
-          << ") are out of bounds for matrix of size " << m << " x n!"
-          << std::endl;
+    const size_t i = badIndices[0];
+    Log::Fatal << "MatrixCompletion::CheckValues(): indices ("
+        << indices(0, i) << ", " << indices(1, i)
+        << ") are out of bounds for matrix of size " << m << " x n!"
+        << std::endl;
   }
 }
 
+inline void MatrixCompletion::SortEntries()
+{
+  // Sort the observed entries into column-major order, so the constraint
+  // matrices and any scan over the observed entries touch memory
+  // sequentially.
+  const arma::uvec order = arma::stable_sort_index(
+      indices.row(0).t() + m * indices.row(1).t());
+  indices = indices.cols(order);
+  values = values.elem(order);
+}
+
 inline void MatrixCompletion::InitSDP()
 {
   sdp.SDP().C().eye(m + n, m + n);
   sdp.SDP().SparseB() = 2. * values;
   const size_t p = indices.n_cols;
-  for (size_t i = 0; i < p; ++i)
+  // Each constraint matrix is built independently, so the entries are
+  // processed in blocks dispatched across threads.
+  const size_t blockSize = 4096;
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < p; block += blockSize)
   {
-    sdp.SDP().SparseA()[i].zeros(m + n, m + n);
-    sdp.SDP().SparseA()[i](indices(0, i), m + indices(1, i)) = 1.;
-    sdp.SDP().SparseA()[i](m + indices(1, i), indices(0, i)) = 1.;
+    const size_t lastEntry = std::min(block + blockSize, p) - 1;
+
+    for (size_t i = block; i <= lastEntry; ++i)
+    {
+      sdp.SDP().SparseA()[i].zeros(m + n, m + n);
+      sdp.SDP().SparseA()[i](indices(0, i), m + indices(1, i)) = 1.;
+      sdp.SDP().SparseA()[i](m + indices(1, i), indices(0, i)) = 1.;
+    }
   }
 }
 
 inline void MatrixCompletion::Recover(arma::mat& recovered)
 {
-  recovered = sdp.Function().GetInitialPoint();
-  sdp.Optimize(recovered);
-  recovered = recovered * trans(recovered);
+  // Warm-start from the factor of a previous solve, if one exists; otherwise
+  // start from the initial point of the SDP.
+  if (optimizedPoint.is_empty())
+    optimizedPoint = sdp.Function().GetInitialPoint();
+  sdp.Optimize(optimizedPoint);
+  recovered = optimizedPoint * trans(optimizedPoint);
   recovered = recovered(arma::span(0, m - 1), arma::span(m, m + n - 1));
 }
 
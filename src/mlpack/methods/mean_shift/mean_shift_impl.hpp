@@ -211,36 +211,80 @@ inline void MeanShift<UseKernel, KernelType, MatType>::Cluster(
   std::vector<std::vector<size_t> > neighbors;
   std::vector<std::vector<double> > distances;
 
-  // For each seed, perform mean shift algorithm.
+  // Initial centroids are the seeds themselves.
   for (size_t i = 0; i < pSeeds->n_cols; ++i)
-  {
-    // Initial centroid is the seed itself.
     allCentroids.col(i) = pSeeds->unsafe_col(i);
-    for (size_t completedIterations = 0; completedIterations < maxIterations
-        || forceConvergence; completedIterations++)
+
+  // The seeds shift independently of each other, so instead of running each
+  // seed to convergence with one single-point range search per step, we run
+  // all seeds in lockstep: each iteration batches the neighborhood queries of
+  // every still-active seed into a single dual-tree range search, and the
+  // shift updates then run in parallel across seeds.
+  std::vector<size_t> activeSeeds(pSeeds->n_cols);
+  for (size_t i = 0; i < pSeeds->n_cols; ++i)
+    activeSeeds[i] = i;
+
+  for (size_t completedIterations = 0; (completedIterations < maxIterations ||
+      forceConvergence) && !activeSeeds.empty(); completedIterations++)
+  {
+    // Batched range search around all active seed positions.
+    arma::mat querySet(pSeeds->n_rows, activeSeeds.size());
+    for (size_t j = 0; j < activeSeeds.size(); ++j)
+      querySet.col(j) = allCentroids.col(activeSeeds[j]);
+
+    rangeSearcher.Search(querySet, validRadius, neighbors, distances);
+
+    // Status of each active seed after this step: 0 means still shifting,
+    // 1 means converged, and 2 means there are no points in the cluster.
+    std::vector<char> status(activeSeeds.size(), 0);
+
+    #pragma omp parallel for
+    for (size_t j = 0; j < (size_t) activeSeeds.size(); ++j)
     {
+      const size_t seed = activeSeeds[j];
+
+      if (neighbors[j].size() == 0) // There are no points in the cluster.
+      {
+        status[j] = 2;
+        continue;
+      }
+
       // Store new centroid in this.
       arma::colvec newCentroid = arma::zeros<arma::colvec>(pSeeds->n_rows);
 
-      rangeSearcher.Search(allCentroids.unsafe_col(i), validRadius,
-          neighbors, distances);
-      if (neighbors[0].size() == 0) // There are no points in the cluster.
-        break;
-
       // Calculate new centroid.
-      if (!CalculateCentroid(data, neighbors[0], distances[0], newCentroid))
-        newCentroid = allCentroids.unsafe_col(i);
+      if (!CalculateCentroid(data, neighbors[j], distances[j], newCentroid))
+        newCentroid = allCentroids.unsafe_col(seed);
 
       // If the mean shift vector is small enough, it has converged.
       if (EuclideanDistance::Evaluate(newCentroid,
-          allCentroids.unsafe_col(i)) < 1e-3 * radius)
+          allCentroids.unsafe_col(seed)) < 1e-3 * radius)
+        status[j] = 1;
+      else
+        allCentroids.col(seed) = newCentroid;
+    }
+
+    // Collect converged seeds and drop finished seeds from the active set.
+    // The duplicate check compares against the centroids found so far, so it
+    // must stay serial.
+    std::vector<size_t> stillActive;
+    for (size_t j = 0; j < activeSeeds.size(); ++j)
+    {
+      if (status[j] == 0)
+      {
+        stillActive.push_back(activeSeeds[j]);
+        continue;
+      }
+
+      if (status[j] == 1)
       {
         // Determine if the new centroid is duplicate with old ones.
         bool isDuplicated = false;
         for (size_t k = 0; k < centroids.n_cols; ++k)
         {
           const double distance = EuclideanDistance::Evaluate(
-              allCentroids.unsafe_col(i), centroids.unsafe_col(k));
+              allCentroids.unsafe_col(activeSeeds[j]),
+              centroids.unsafe_col(k));
           if (distance < radius)
           {
             isDuplicated = true;
@@ -249,15 +293,47 @@ inline void MeanShift<UseKernel, KernelType, MatType>::Cluster(
         }
 
         if (!isDuplicated)
-          centroids.insert_cols(centroids.n_cols, allCentroids.unsafe_col(i));
+        {
+          centroids.insert_cols(centroids.n_cols,
+              allCentroids.unsafe_col(activeSeeds[j]));
+        }
+      }
+    }
+
+    // Early deduplication of converging trajectories: two seeds whose
+    // centroids have approached within the radius of each other are headed
+    // for the same mode, so only one of them needs to keep shifting (the
+    // other would be discarded by the duplicate check at convergence anyway).
+    // The centroids are binned on a grid with cell width equal to the radius,
+    // and only seeds falling in the same cell are compared, which keeps this
+    // check cheap (and conservative: trajectories merging across a cell
+    // boundary are simply caught a little later).
+    typedef arma::colvec VecType;
+    std::map<VecType, size_t, less<VecType> > binnedSeeds;
+    std::vector<size_t> dedupedActive;
+    for (size_t j = 0; j < stillActive.size(); ++j)
+    {
+      const size_t seed = stillActive[j];
+      const VecType binnedPoint =
+          arma::floor(arma::colvec(allCentroids.col(seed)) / radius);
 
-        // Get out of the loop.
-        break;
+      const auto it = binnedSeeds.find(binnedPoint);
+      if (it != binnedSeeds.end())
+      {
+        const double distance = EuclideanDistance::Evaluate(
+            allCentroids.unsafe_col(seed),
+            allCentroids.unsafe_col(it->second));
+        if (distance < radius)
+          continue; // This trajectory merges with an existing one.
+      }
+      else
+      {
+        binnedSeeds[binnedPoint] = seed;
       }
 
-      // Update the centroid.
-      allCentroids.col(i) = newCentroid;
+      dedupedActive.push_back(seed);
     }
+    activeSeeds = std::move(dedupedActive);
   }
 
   // If no centroid has converged due to too little iterations and without
@@ -130,6 +130,61 @@ class NaiveBayesClassifier
   template<typename VecType>
   void Train(const VecType& point, const size_t label);
 
+  /**
+   * Compute the sufficient statistics of the given dataset: the number of
+   * points, the per-feature sum, and the per-feature sum of squares for each
+   * class.  These statistics fully determine a Naive Bayes model, and
+   * statistics from different datasets (e.g. shards of a larger corpus,
+   * computed on different threads or machines) can be merged exactly by
+   * elementwise addition.  Pass the merged statistics to
+   * TrainFromSufficientStatistics() to build the model:
+   *
+   * @code
+   * arma::mat counts1, sums1, sumSquares1, counts2, sums2, sumSquares2;
+   * NaiveBayesClassifier<>::SufficientStatistics(shard1, labels1, 3, counts1,
+   *     sums1, sumSquares1);
+   * NaiveBayesClassifier<>::SufficientStatistics(shard2, labels2, 3, counts2,
+   *     sums2, sumSquares2);
+   *
+   * NaiveBayesClassifier<> nbc;
+   * nbc.TrainFromSufficientStatistics(counts1 + counts2, sums1 + sums2,
+   *     sumSquares1 + sumSquares2);
+   * @endcode
+   *
+   * The statistics are accumulated in parallel (if OpenMP is enabled) over
+   * blocks of points.
+   *
+   * @param data Dataset to compute statistics of.
+   * @param labels Labels corresponding to the data points.
+   * @param numClasses Number of classes in the dataset.
+   * @param counts Will hold the number of points of each class.
+   * @param sums Will hold the per-feature sum for each class.
+   * @param sumSquares Will hold the per-feature sum of squares for each
+   *     class.
+   */
+  template<typename MatType>
+  static void SufficientStatistics(const MatType& data,
+                                   const arma::Row<size_t>& labels,
+                                   const size_t numClasses,
+                                   ModelMatType& counts,
+                                   ModelMatType& sums,
+                                   ModelMatType& sumSquares);
+
+  /**
+   * Train the Naive Bayes classifier from sufficient statistics computed by
+   * SufficientStatistics(), replacing any existing model.  The resulting
+   * model is identical (up to floating-point roundoff) to a model trained
+   * non-incrementally on the concatenation of all datasets whose statistics
+   * were merged.
+   *
+   * @param counts Number of points of each class.
+   * @param sums Per-feature sum for each class.
+   * @param sumSquares Per-feature sum of squares for each class.
+   */
+  void TrainFromSufficientStatistics(const ModelMatType& counts,
+                                     const ModelMatType& sums,
+                                     const ModelMatType& sumSquares);
+
   /**
    * Classify the given point, using the trained NaiveBayesClassifier model. The
    * predicted label is returned.
@@ -201,31 +201,140 @@ void NaiveBayesClassifier<ModelMatType>::Train(const VecType& point,
 
 template<typename ModelMatType>
 template<typename MatType>
-void NaiveBayesClassifier<ModelMatType>::LogLikelihood(
+void NaiveBayesClassifier<ModelMatType>::SufficientStatistics(
     const MatType& data,
-    ModelMatType& logLikelihoods) const
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    ModelMatType& counts,
+    ModelMatType& sums,
+    ModelMatType& sumSquares)
 {
   static_assert(std::is_same<ElemType, typename MatType::elem_type>::value,
       "NaiveBayesClassifier: element type of given data must match the element "
       "type of the model!");
 
-  logLikelihoods = arma::log(arma::repmat(probabilities, 1, data.n_cols));
-  ModelMatType invVar = 1.0 / variances;
+  counts.zeros(numClasses);
+  sums.zeros(data.n_rows, numClasses);
+  sumSquares.zeros(data.n_rows, numClasses);
+
+  // Accumulate statistics for blocks of points in parallel, and merge each
+  // block's statistics into the output when it is done.
+  const size_t blockSize = 4096;
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < data.n_cols; block += blockSize)
+  {
+    const size_t lastCol = std::min(block + blockSize,
+        (size_t) data.n_cols) - 1;
+
+    ModelMatType blockCounts, blockSums, blockSumSquares;
+    blockCounts.zeros(numClasses);
+    blockSums.zeros(data.n_rows, numClasses);
+    blockSumSquares.zeros(data.n_rows, numClasses);
+
+    for (size_t j = block; j <= lastCol; ++j)
+    {
+      const size_t label = labels[j];
+      ++blockCounts[label];
+      blockSums.col(label) += data.col(j);
+      blockSumSquares.col(label) += square(data.col(j));
+    }
+
+    #pragma omp critical
+    {
+      counts += blockCounts;
+      sums += blockSums;
+      sumSquares += blockSumSquares;
+    }
+  }
+}
+
+template<typename ModelMatType>
+void NaiveBayesClassifier<ModelMatType>::TrainFromSufficientStatistics(
+    const ModelMatType& counts,
+    const ModelMatType& sums,
+    const ModelMatType& sumSquares)
+{
+  if (sums.n_rows != sumSquares.n_rows || sums.n_cols != sumSquares.n_cols ||
+      counts.n_elem != sums.n_cols)
+  {
+    throw std::invalid_argument("NaiveBayesClassifier::"
+        "TrainFromSufficientStatistics(): given statistics have mismatched "
+        "sizes!");
+  }
 
-  // Calculate the joint log likelihood of point for each of the
-  // means.n_cols.
+  probabilities = counts;
+  means = sums;
+  variances = sumSquares;
 
-  // Loop over every class.
-  for (size_t i = 0; i < means.n_cols; ++i)
+  for (size_t i = 0; i < probabilities.n_elem; ++i)
   {
-    // This is an adaptation of phi() for the case where the covariance is a
-    // diagonal matrix.
-    ModelMatType diffs = data - arma::repmat(means.col(i), 1, data.n_cols);
-    ModelMatType rhs = -0.5 * arma::diagmat(invVar.col(i)) * diffs;
-    arma::Mat<ElemType> exponents = arma::sum(diffs % rhs, 0);
-
-    logLikelihoods.row(i) += (data.n_rows / -2.0 * log(2 * M_PI) - 0.5 *
-        arma::accu(arma::log(variances.col(i))) + exponents);
+    if (probabilities[i] != 0.0)
+      means.col(i) /= probabilities[i];
+
+    if (probabilities[i] > 1)
+    {
+      variances.col(i) = (variances.col(i) -
+          probabilities[i] * square(means.col(i))) / (probabilities[i] - 1);
+    }
+    else
+    {
+      variances.col(i).zeros();
+    }
+  }
+
+  // Guard against small negative variances caused by cancellation in the
+  // sum-of-squares formula.
+  variances.elem(arma::find(variances < 0.0)).zeros();
+
+  // Add epsilon to prevent log of zero.
+  variances += epsilon;
+
+  const ElemType totalPoints = accu(counts);
+  trainingPoints = (size_t) totalPoints;
+  if (totalPoints > 0)
+    probabilities /= totalPoints;
+}
+
+template<typename ModelMatType>
+template<typename MatType>
+void NaiveBayesClassifier<ModelMatType>::LogLikelihood(
+    const MatType& data,
+    ModelMatType& logLikelihoods) const
+{
+  static_assert(std::is_same<ElemType, typename MatType::elem_type>::value,
+      "NaiveBayesClassifier: element type of given data must match the element "
+      "type of the model!");
+
+  // Expanding the squared difference in the Gaussian exponent gives
+  //
+  //   log p(x, c) = constants(c) + dot(invVar.col(c) % means.col(c), x)
+  //       - 0.5 * dot(invVar.col(c), x % x)
+  //
+  // so the joint log likelihoods of all classes for a block of points reduce
+  // to two matrix products against precomputed per-class coefficient blocks;
+  // no per-class temporaries are needed.
+  const ModelMatType invVar = 1.0 / variances;
+  const ModelMatType linearCoeffs = invVar % means;
+  const arma::Col<ElemType> constants = arma::log(probabilities) -
+      0.5 * (data.n_rows * std::log(2 * M_PI) +
+             trans(arma::sum(arma::log(variances), 0)) +
+             trans(arma::sum(linearCoeffs % means, 0)));
+
+  logLikelihoods.set_size(means.n_cols, data.n_cols);
+
+  // Score the points in blocks, so each block's partial results stay
+  // cache-resident and the blocks can be dispatched across threads.
+  const size_t blockSize = 256;
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < data.n_cols; block += blockSize)
+  {
+    const size_t lastCol = std::min(block + blockSize,
+        (size_t) data.n_cols) - 1;
+
+    logLikelihoods.cols(block, lastCol) =
+        linearCoeffs.t() * data.cols(block, lastCol) -
+        0.5 * (invVar.t() * arma::square(data.cols(block, lastCol)));
+    logLikelihoods.cols(block, lastCol).each_col() += constants;
   }
 }
 
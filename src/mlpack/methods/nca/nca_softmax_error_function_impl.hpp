@@ -67,29 +67,43 @@ double SoftmaxErrorFunction<MetricType>::Evaluate(const arma::mat& coordinates,
 {
   // Unfortunately each evaluation will take O(N) time because it requires a
   // scan over all points in the dataset.  Our objective is to compute p_i.
-  double denominator = 0;
-  double numerator = 0;
   double result = 0;
 
   // It's quicker to do this now than one point at a time later.
   stretchedDataset = coordinates * dataset;
+  const size_t blockSize = 256;
   for (size_t i = begin; i < begin + batchSize; ++i)
   {
-    for (size_t k = 0; k < dataset.n_cols; ++k)
+    // The numerator and denominator of p_i are sums over all other points,
+    // so the scan is processed in blocks dispatched across threads, with the
+    // two sums combined by reduction.
+    double numerator = 0;
+    double denominator = 0;
+
+    #pragma omp parallel for schedule(dynamic) \
+        reduction(+:numerator, denominator)
+    for (size_t block = 0; block < dataset.n_cols; block += blockSize)
     {
-      // Don't consider the case where the points are the same.
-      if (k == i)
-        continue;
+      const size_t lastCol = std::min(block + blockSize,
+          (size_t) dataset.n_cols) - 1;
 
-      // We want to evaluate exp(-D(A x_i, A x_k)).
-      double eval = std::exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                              stretchedDataset.unsafe_col(k)));
+      for (size_t k = block; k <= lastCol; ++k)
+      {
+        // Don't consider the case where the points are the same.
+        if (k == i)
+          continue;
+
+        // We want to evaluate exp(-D(A x_i, A x_k)).
+        double eval = std::exp(-metric.Evaluate(
+            stretchedDataset.unsafe_col(i),
+            stretchedDataset.unsafe_col(k)));
 
-      // If they are in the same class, update the numerator.
-      if (labels[i] == labels[k])
-        numerator += eval;
+        // If they are in the same class, update the numerator.
+        if (labels[i] == labels[k])
+          numerator += eval;
 
-      denominator += eval;
+        denominator += eval;
+      }
     }
 
     // Now the result is just a simple division, but we have to be sure that the
@@ -126,27 +140,50 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
   //     (((p_i - (1 / p_i)) p_ik) + ((p_k - (1 / p_k)) p_ki)) x_ik x_ik^T
   //   otherwise, add
   //     (p_i p_ik + p_k p_ki) x_ik x_ik^T
+  // The pairs are independent, so the outer points are processed in blocks
+  // dispatched across threads; each thread accumulates into its own local
+  // sum, and the local sums are merged at the end.
   arma::mat sum;
   sum.zeros(stretchedDataset.n_rows, stretchedDataset.n_rows);
-  for (size_t i = 0; i < stretchedDataset.n_cols; ++i)
+  const size_t blockSize = 256;
+  #pragma omp parallel
   {
-    for (size_t k = (i + 1); k < stretchedDataset.n_cols; ++k)
+    arma::mat localSum;
+    localSum.zeros(stretchedDataset.n_rows, stretchedDataset.n_rows);
+
+    #pragma omp for schedule(dynamic)
+    for (size_t block = 0; block < stretchedDataset.n_cols;
+        block += blockSize)
     {
-      // Calculate p_ik and p_ki first.
-      double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                         stretchedDataset.unsafe_col(k)));
-      double p_ik = 0, p_ki = 0;
-      p_ik = eval / denominators(i);
-      p_ki = eval / denominators(k);
-
-      // Subtract x_i from x_k.  We are not using stretched points here.
-      arma::vec x_ik = dataset.col(i) - dataset.col(k);
-      arma::mat secondTerm = (x_ik * trans(x_ik));
-
-      if (labels[i] == labels[k])
-        sum += ((p[i] - 1) * p_ik + (p[k] - 1) * p_ki) * secondTerm;
-      else
-        sum += (p[i] * p_ik + p[k] * p_ki) * secondTerm;
+      const size_t lastCol = std::min(block + blockSize,
+          (size_t) stretchedDataset.n_cols) - 1;
+
+      for (size_t i = block; i <= lastCol; ++i)
+      {
+        for (size_t k = (i + 1); k < stretchedDataset.n_cols; ++k)
+        {
+          // Calculate p_ik and p_ki first.
+          double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
+                                             stretchedDataset.unsafe_col(k)));
+          double p_ik = 0, p_ki = 0;
+          p_ik = eval / denominators(i);
+          p_ki = eval / denominators(k);
+
+          // Subtract x_i from x_k.  We are not using stretched points here.
+          arma::vec x_ik = dataset.col(i) - dataset.col(k);
+          arma::mat secondTerm = (x_ik * trans(x_ik));
+
+          if (labels[i] == labels[k])
+            localSum += ((p[i] - 1) * p_ik + (p[k] - 1) * p_ki) * secondTerm;
+          else
+            localSum += (p[i] * p_ik + p[k] * p_ki) * secondTerm;
+        }
+      }
+    }
+
+    #pragma omp critical
+    {
+      sum += localSum;
     }
   }
 
@@ -173,6 +210,7 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
 
   // Compute the stretched dataset.
   stretchedDataset = coordinates * dataset;
+  const size_t blockSize = 256;
   for (size_t i = begin; i < begin + batchSize; ++i)
   {
     numerator = 0;
@@ -181,31 +219,55 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
     firstTerm.zeros(coordinates.n_rows, coordinates.n_cols);
     secondTerm.zeros(coordinates.n_rows, coordinates.n_cols);
 
-    for (size_t k = 0; k < dataset.n_cols; ++k)
+    // The scan over the other points is processed in blocks dispatched
+    // across threads; each thread accumulates into its own local terms,
+    // which are merged at the end.
+    #pragma omp parallel reduction(+:numerator, denominator)
     {
-      // Don't consider the case where the points are the same.
-      if (i == k)
-        continue;
-
-      // Calculate the numerator of p_ik.
-      double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                         stretchedDataset.unsafe_col(k)));
-
-      // If the points are in the same class, we must add to the second term of
-      // the gradient as well as the numerator of p_i.  We will divide by the
-      // denominator of p_ik later.  For x_ik we are not using stretched points.
-      GradType x_ik = dataset.col(i) - dataset.col(k);
-      if (labels[i] == labels[k])
+      GradType localFirstTerm, localSecondTerm;
+      localFirstTerm.zeros(coordinates.n_rows, coordinates.n_cols);
+      localSecondTerm.zeros(coordinates.n_rows, coordinates.n_cols);
+
+      #pragma omp for schedule(dynamic)
+      for (size_t block = 0; block < dataset.n_cols; block += blockSize)
       {
-        numerator += eval;
-        secondTerm += eval * x_ik * trans(x_ik);
+        const size_t lastCol = std::min(block + blockSize,
+            (size_t) dataset.n_cols) - 1;
+
+        for (size_t k = block; k <= lastCol; ++k)
+        {
+          // Don't consider the case where the points are the same.
+          if (i == k)
+            continue;
+
+          // Calculate the numerator of p_ik.
+          double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
+                                             stretchedDataset.unsafe_col(k)));
+
+          // If the points are in the same class, we must add to the second
+          // term of the gradient as well as the numerator of p_i.  We will
+          // divide by the denominator of p_ik later.  For x_ik we are not
+          // using stretched points.
+          GradType x_ik = dataset.col(i) - dataset.col(k);
+          if (labels[i] == labels[k])
+          {
+            numerator += eval;
+            localSecondTerm += eval * x_ik * trans(x_ik);
+          }
+
+          // We always have to add to the denominator of p_i
+          // and the first term of the gradient computation.
+          // We will divide by the denominator of p_ik later.
+          denominator += eval;
+          localFirstTerm += eval * x_ik * trans(x_ik);
+        }
       }
 
-      // We always have to add to the denominator of p_i
-      // and the first term of the gradient computation.
-      // We will divide by the denominator of p_ik later.
-      denominator += eval;
-      firstTerm += eval * x_ik * trans(x_ik);
+      #pragma omp critical
+      {
+        firstTerm += localFirstTerm;
+        secondTerm += localSecondTerm;
+      }
     }
 
     // Calculate p_i.
@@ -260,27 +322,45 @@ void SoftmaxErrorFunction<MetricType>::Precalculate(
   //   p_ij = exp( -K(x_i, x_j) ) / ( sum_{k != i} ( exp( -K(x_i, x_k) )))
   //   p_i = sum_{j in class of i} p_ij
   // We will do this by keeping track of the denominators for each i as well as
-  // the numerators (the sum for all j in class of i).  This will be on the
-  // order of O((n * (n + 1)) / 2), which really isn't all that great.
+  // the numerators (the sum for all j in class of i).  This is O(n^2), which
+  // really isn't all that great.
   p.zeros(stretchedDataset.n_cols);
   denominators.zeros(stretchedDataset.n_cols);
-  for (size_t i = 0; i < stretchedDataset.n_cols; ++i)
+
+  // Group the points of each class, so that the numerator of p_i is a sum
+  // over one index set.
+  std::vector<arma::uvec> classMembers(labels.max() + 1);
+  for (size_t c = 0; c < classMembers.size(); ++c)
+    classMembers[c] = arma::find(labels == c);
+
+  // Each point owns its own numerator and denominator, so the points are
+  // processed in blocks dispatched across threads; the distances of each
+  // block against the whole dataset are computed as one batch (a single BLAS
+  // call for the L2 metrics) instead of a scalar loop per pair.
+  const size_t blockSize = 256;
+  #pragma omp parallel
   {
-    for (size_t j = (i + 1); j < stretchedDataset.n_cols; ++j)
+    arma::mat evals;
+
+    #pragma omp for schedule(dynamic)
+    for (size_t block = 0; block < stretchedDataset.n_cols;
+        block += blockSize)
     {
-      // Evaluate exp(-d(x_i, x_j)).
-      double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                         stretchedDataset.unsafe_col(j)));
+      const size_t lastCol = std::min(block + blockSize,
+          (size_t) stretchedDataset.n_cols) - 1;
 
-      // Add this to the denominators of both p_i and p_j: K(i, j) = K(j, i).
-      denominators[i] += eval;
-      denominators[j] += eval;
+      // Evaluate exp(-d(x_i, x_j)) for the whole block at once.
+      PairwiseDistances(stretchedDataset.cols(block, lastCol),
+          stretchedDataset, metric, evals);
+      evals = arma::exp(-evals);
 
-      // If i and j are the same class, add to numerator of both.
-      if (labels[i] == labels[j])
+      for (size_t i = block; i <= lastCol; ++i)
       {
-        p[i] += eval;
-        p[j] += eval;
+        // The diagonal term exp(-d(x_i, x_i)) = 1 appears in both sums, so
+        // it is subtracted from each.
+        const arma::rowvec evalRow = evals.row(i - block);
+        denominators[i] = arma::accu(evalRow) - 1.0;
+        p[i] = arma::accu(evalRow.elem(classMembers[labels[i]])) - 1.0;
       }
     }
   }
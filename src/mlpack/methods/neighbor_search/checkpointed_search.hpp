@@ -0,0 +1,138 @@
+/**
+ * @file methods/neighbor_search/checkpointed_search.hpp
+ *
+ * Checkpoint/resume support for long neighbor search jobs.  The query set is
+ * processed in blocks, and after each block the completed results are written
+ * to a checkpoint file; if the process is killed (e.g. a preempted spot
+ * instance), rerunning the same search resumes from the last completed block
+ * instead of starting over.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_CHECKPOINTED_SEARCH_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_CHECKPOINTED_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <cstdio>
+
+namespace mlpack {
+
+/**
+ * Perform a neighbor search with periodic checkpointing.  The query set is
+ * split into blocks of blockSize points; each block is searched with the
+ * given NeighborSearch object (building a query tree per block), and after
+ * each block the results so far are written atomically to checkpointFile.
+ * If checkpointFile already holds a checkpoint for a query set of the same
+ * size and the same k, the completed blocks are loaded from it and the
+ * search resumes after them; a checkpoint that does not match is ignored
+ * with a warning.  The checkpoint file is removed once the search finishes.
+ *
+ * The recursion inside one block is not checkpointed, so at most one block
+ * of work is lost to a preemption; blockSize trades checkpoint overhead
+ * against the size of that window.  Note that searching per-block query
+ * trees gives exactly the same results as one dual-tree search over the
+ * whole query set, at the cost of some lost traversal amortization.
+ *
+ * It is the caller's responsibility to resume with the same reference set,
+ * sort policy, and search parameters; the checkpoint only records the query
+ * count and k, and cannot detect a changed reference set.
+ *
+ * @param search NeighborSearch object to search with (already trained).
+ * @param querySet Set of query points.
+ * @param k Number of neighbors to search for.
+ * @param neighbors Matrix storing lists of neighbors for each query point.
+ * @param distances Matrix storing distances of neighbors for each query
+ *     point.
+ * @param checkpointFile File to write checkpoints to (and resume from).
+ * @param blockSize Number of query points to process between checkpoints.
+ */
+template<typename NeighborSearchType, typename MatType>
+void CheckpointedSearch(
+    NeighborSearchType& search,
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::Mat<typename MatType::elem_type>& distances,
+    const std::string& checkpointFile,
+    const size_t blockSize = 10000)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  const size_t numQueries = querySet.n_cols;
+  neighbors.set_size(k, numQueries);
+  distances.set_size(k, numQueries);
+  size_t done = 0;
+
+  // Load any existing checkpoint.
+  {
+    std::ifstream ifs(checkpointFile, std::ios::binary);
+    if (ifs.is_open())
+    {
+      try
+      {
+        cereal::BinaryInputArchive ar(ifs);
+        size_t savedK, savedQueries, savedDone;
+        arma::Mat<size_t> savedNeighbors;
+        arma::Mat<ElemType> savedDistances;
+        ar(savedK, savedQueries, savedDone, savedNeighbors, savedDistances);
+
+        if (savedK == k && savedQueries == numQueries &&
+            savedDone <= numQueries)
+        {
+          neighbors = std::move(savedNeighbors);
+          distances = std::move(savedDistances);
+          done = savedDone;
+          Log::Info << "CheckpointedSearch(): resuming from '"
+              << checkpointFile << "' with " << done << " of " << numQueries
+              << " query points already complete." << std::endl;
+        }
+        else
+        {
+          Log::Warn << "CheckpointedSearch(): checkpoint '" << checkpointFile
+              << "' does not match this search (saved k " << savedK << ", "
+              << savedQueries << " queries); ignoring it." << std::endl;
+        }
+      }
+      catch (const std::exception&)
+      {
+        Log::Warn << "CheckpointedSearch(): could not read checkpoint '"
+            << checkpointFile << "'; starting from the beginning."
+            << std::endl;
+      }
+    }
+  }
+
+  const std::string tmpFile = checkpointFile + ".tmp";
+  while (done < numQueries)
+  {
+    const size_t lastCol = std::min(done + blockSize, numQueries) - 1;
+
+    arma::Mat<size_t> blockNeighbors;
+    arma::Mat<ElemType> blockDistances;
+    const MatType block = querySet.cols(done, lastCol);
+    search.Search(block, k, blockNeighbors, blockDistances);
+
+    neighbors.cols(done, lastCol) = blockNeighbors;
+    distances.cols(done, lastCol) = blockDistances;
+    done = lastCol + 1;
+
+    // Write the checkpoint to a temporary file and rename it into place, so
+    // a preemption mid-write cannot leave a truncated checkpoint.
+    {
+      std::ofstream ofs(tmpFile, std::ios::binary | std::ios::trunc);
+      cereal::BinaryOutputArchive ar(ofs);
+      ar(k, numQueries, done, neighbors, distances);
+    }
+    std::rename(tmpFile.c_str(), checkpointFile.c_str());
+  }
+
+  std::remove(checkpointFile.c_str());
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,193 @@
+/**
+ * @file methods/neighbor_search/if_index.hpp
+ *
+ * Defines the IFIndex class, an inverted-file index for approximate neighbor
+ * search.  The index is built around a coarse quantizer and is designed so
+ * that sparse datasets never need to be densified.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_IF_INDEX_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_IF_INDEX_HPP
+
+#include <mlpack/core.hpp>
+
+#include "sort_policies/nearest_neighbor_sort.hpp"
+
+namespace mlpack {
+
+/**
+ * The IFIndex class implements an inverted-file (IVF) index for approximate
+ * neighbor search.  A coarse quantizer of numLists centroids is trained with
+ * a few Lloyd iterations, and every reference point is filed into the list of
+ * its nearest centroid.  At search time only the lists of the numProbes best
+ * centroids for the query are scanned with exact distances, so the cost of a
+ * query is proportional to the number of probed points instead of the size of
+ * the reference set.
+ *
+ * The index is particularly useful for high-dimensional sparse data, where
+ * space-partitioning trees degenerate (a midpoint split on a dimension that
+ * is zero for nearly every point separates nothing).  All of the arithmetic
+ * against the centroids is expressed with dot products, so when MatType is a
+ * sparse matrix type each operation touches only the nonzero elements of the
+ * points; only the centroids themselves are dense.
+ *
+ * Unlike the tree-based NeighborSearch class, the quality of the results is
+ * controlled by the number of probed lists rather than by an epsilon bound:
+ * probing more lists gives higher recall at lower throughput, and probing all
+ * of the lists makes the search exact.
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam MatType The type of data matrix (arma::sp_mat is supported).
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         typename MatType = arma::mat>
+class IFIndex
+{
+ public:
+  //! The element type of the data (and so also of the result distances).
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Create an IFIndex without building it on any data; call Train() before
+   * Search(), or an exception will be thrown.
+   *
+   * @param numLists Number of inverted lists (coarse centroids); 0 means the
+   *      square root of the number of reference points is used.
+   * @param maxIterations Number of Lloyd iterations used to refine the coarse
+   *      centroids.
+   */
+  IFIndex(const size_t numLists = 0, const size_t maxIterations = 3);
+
+  /**
+   * Create an IFIndex and build it on the given reference set.
+   *
+   * @param referenceSet Set of reference points.
+   * @param numLists Number of inverted lists (coarse centroids); 0 means the
+   *      square root of the number of reference points is used.
+   * @param maxIterations Number of Lloyd iterations used to refine the coarse
+   *      centroids.
+   */
+  IFIndex(MatType referenceSet,
+          const size_t numLists = 0,
+          const size_t maxIterations = 3);
+
+  /**
+   * Build the index on the given reference set, training the coarse centroids
+   * and filing every reference point into an inverted list.  Any previously
+   * built index is discarded.
+   *
+   * @param referenceSet Set of reference points.
+   */
+  void Train(MatType referenceSet);
+
+  /**
+   * For each point in the query set, find the k approximate neighbors in the
+   * reference set and store the output in the given matrices.  The matrices
+   * will be set to the correct size.  The returned distances are exact
+   * distances to the returned neighbors; the approximation is only in which
+   * candidates are considered.  If the probed lists hold fewer than k points,
+   * the remaining result slots are left at SortPolicy::WorstDistance() with
+   * an invalid index; probe more lists to avoid this.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *      point.
+   * @param numProbes Number of inverted lists to scan for each query; 0 means
+   *      one tenth of the lists (rounded up).  Setting this to the number of
+   *      lists makes the search exact.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& distances,
+              const size_t numProbes = 0);
+
+  /**
+   * For each point in the reference set, find the k approximate neighbors in
+   * the reference set (excluding the point itself) and store the output in
+   * the given matrices.
+   *
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *      point.
+   * @param numProbes Number of inverted lists to scan for each query; 0 means
+   *      one tenth of the lists (rounded up).
+   */
+  void Search(const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& distances,
+              const size_t numProbes = 0);
+
+  //! Access the reference set.
+  const MatType& ReferenceSet() const { return referenceSet; }
+
+  //! Get the number of inverted lists (0 means it will be chosen at training
+  //! time).
+  size_t NumLists() const { return numLists; }
+  //! Modify the number of inverted lists.  This will only take effect the
+  //! next time Train() is called.
+  size_t& NumLists() { return numLists; }
+  //! Get the number of Lloyd iterations used to refine the centroids.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the number of Lloyd iterations.  This will only take effect the
+  //! next time Train() is called.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Access the trained coarse centroids (one column per list).
+  const arma::Mat<ElemType>& Centroids() const { return centroids; }
+  //! Access the inverted list of the given centroid.
+  const std::vector<size_t>& List(const size_t i) const { return lists[i]; }
+
+  //! Serialize the index.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Number of inverted lists; 0 until resolved by Train().
+  size_t numLists;
+  //! Number of Lloyd iterations used to refine the centroids.
+  size_t maxIterations;
+
+  //! The reference set; kept for the exact scanning stage.
+  MatType referenceSet;
+  //! The coarse centroids, one column per inverted list.  These are dense
+  //! even for sparse data, since means of sparse points are generally dense.
+  arma::Mat<ElemType> centroids;
+  //! Squared norms of the centroids, for dot-product distance evaluation.
+  arma::Col<ElemType> centroidNorms;
+  //! The inverted lists: indices of the reference points assigned to each
+  //! centroid.
+  std::vector<std::vector<size_t>> lists;
+
+  /**
+   * The implementation of both Search() overloads; when sameSet is true, a
+   * query point will not return itself in the results.
+   */
+  void SearchInternal(const MatType& querySet,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::Mat<ElemType>& distances,
+                      const size_t numProbes,
+                      const bool sameSet);
+
+  /**
+   * Compute the squared distances from the given point to every centroid
+   * using only dot products, so that sparse points are never densified.
+   */
+  template<typename VecType>
+  arma::Col<ElemType> CentroidDistances(const VecType& point) const;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "if_index_impl.hpp"
+
+#endif // MLPACK_METHODS_NEIGHBOR_SEARCH_IF_INDEX_HPP
@@ -0,0 +1,256 @@
+/**
+ * @file methods/neighbor_search/if_index_impl.hpp
+ *
+ * Implementation of the IFIndex class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_IF_INDEX_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_IF_INDEX_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "if_index.hpp"
+
+namespace mlpack {
+
+template<typename SortPolicy, typename MatType>
+IFIndex<SortPolicy, MatType>::IFIndex(const size_t numLists,
+                                      const size_t maxIterations) :
+    numLists(numLists),
+    maxIterations(maxIterations)
+{
+  // Nothing to do.
+}
+
+template<typename SortPolicy, typename MatType>
+IFIndex<SortPolicy, MatType>::IFIndex(MatType referenceSet,
+                                      const size_t numLists,
+                                      const size_t maxIterations) :
+    IFIndex(numLists, maxIterations)
+{
+  Train(std::move(referenceSet));
+}
+
+template<typename SortPolicy, typename MatType>
+void IFIndex<SortPolicy, MatType>::Train(MatType referenceSet)
+{
+  if (referenceSet.n_cols == 0)
+    throw std::invalid_argument("IFIndex::Train(): reference set is empty");
+
+  this->referenceSet = std::move(referenceSet);
+  const size_t n = this->referenceSet.n_cols;
+  const size_t dims = this->referenceSet.n_rows;
+
+  // By default, use about sqrt(n) lists, so that an exhaustive scan of the
+  // centroids plus a scan of one list both cost about sqrt(n).
+  const size_t effectiveLists = (numLists == 0) ?
+      std::max((size_t) 1, (size_t) std::ceil(std::sqrt((double) n))) :
+      std::min(numLists, n);
+
+  // Initialize the centroids with a random sample of the reference points.
+  const arma::uvec sample = arma::randperm(n, effectiveLists);
+  centroids.set_size(dims, effectiveLists);
+  for (size_t j = 0; j < effectiveLists; ++j)
+    centroids.col(j) = arma::Mat<ElemType>(this->referenceSet.col(sample[j]));
+  centroidNorms = arma::trans(arma::sum(arma::square(centroids), 0));
+
+  // Refine the centroids with a few Lloyd iterations.  The assignment step
+  // uses only dot products against the points (see CentroidDistances()), and
+  // the update step accumulates the (possibly sparse) points into dense sums,
+  // so sparse reference points are never densified.
+  arma::Col<size_t> assignments(n);
+  for (size_t iteration = 0; iteration <= maxIterations; ++iteration)
+  {
+    #pragma omp parallel for
+    for (size_t i = 0; i < n; ++i)
+    {
+      const arma::Col<ElemType> distances =
+          CentroidDistances(this->referenceSet.col(i));
+      assignments[i] = (size_t) distances.index_min();
+    }
+
+    // The last pass only needs the assignments.
+    if (iteration == maxIterations)
+      break;
+
+    arma::Mat<ElemType> sums(dims, effectiveLists, arma::fill::zeros);
+    arma::Col<size_t> counts(effectiveLists, arma::fill::zeros);
+    for (size_t i = 0; i < n; ++i)
+    {
+      sums.col(assignments[i]) +=
+          arma::Mat<ElemType>(this->referenceSet.col(i));
+      ++counts[assignments[i]];
+    }
+
+    // Centroids of empty lists are left where they are.
+    for (size_t j = 0; j < effectiveLists; ++j)
+      if (counts[j] > 0)
+        centroids.col(j) = sums.col(j) / (ElemType) counts[j];
+    centroidNorms = arma::trans(arma::sum(arma::square(centroids), 0));
+  }
+
+  // File every reference point into the list of its centroid.
+  lists.clear();
+  lists.resize(effectiveLists);
+  for (size_t i = 0; i < n; ++i)
+    lists[assignments[i]].push_back(i);
+}
+
+template<typename SortPolicy, typename MatType>
+template<typename VecType>
+arma::Col<typename MatType::elem_type>
+IFIndex<SortPolicy, MatType>::CentroidDistances(const VecType& point) const
+{
+  // d(p, c)^2 = ||p||^2 - 2 p.c + ||c||^2; the only per-centroid work is the
+  // dot product, which touches just the nonzero elements of a sparse point.
+  arma::Col<ElemType> result = centroids.t() * point;
+  result *= -2.0;
+  result += centroidNorms;
+  result += arma::dot(point, point);
+  return result;
+}
+
+template<typename SortPolicy, typename MatType>
+void IFIndex<SortPolicy, MatType>::Search(const MatType& querySet,
+                                          const size_t k,
+                                          arma::Mat<size_t>& neighbors,
+                                          arma::Mat<ElemType>& distances,
+                                          const size_t numProbes)
+{
+  if (querySet.n_rows != referenceSet.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "IFIndex::Search(): dimensionalities of query set ("
+        << querySet.n_rows << ") and reference set (" << referenceSet.n_rows
+        << ") do not match";
+    throw std::invalid_argument(oss.str());
+  }
+
+  SearchInternal(querySet, k, neighbors, distances, numProbes, false);
+}
+
+template<typename SortPolicy, typename MatType>
+void IFIndex<SortPolicy, MatType>::Search(const size_t k,
+                                          arma::Mat<size_t>& neighbors,
+                                          arma::Mat<ElemType>& distances,
+                                          const size_t numProbes)
+{
+  SearchInternal(referenceSet, k, neighbors, distances, numProbes, true);
+}
+
+template<typename SortPolicy, typename MatType>
+void IFIndex<SortPolicy, MatType>::SearchInternal(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::Mat<ElemType>& distances,
+    const size_t numProbes,
+    const bool sameSet)
+{
+  if (lists.empty())
+    throw std::invalid_argument("IFIndex::Search(): index has not been "
+        "trained");
+
+  const size_t maxNeighbors = referenceSet.n_cols - (sameSet ? 1 : 0);
+  if (k > maxNeighbors)
+  {
+    std::ostringstream oss;
+    oss << "IFIndex::Search(): requested value of k (" << k << ") is greater "
+        << "than the number of points in the reference set (" << maxNeighbors
+        << ")";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // By default, probe a tenth of the lists (rounded up).
+  const size_t effectiveProbes = std::min(lists.size(),
+      std::max((size_t) 1,
+      (numProbes == 0) ? (lists.size() + 9) / 10 : numProbes));
+
+  neighbors.set_size(k, querySet.n_cols);
+  neighbors.fill(size_t() - 1);
+  distances.set_size(k, querySet.n_cols);
+  distances.fill(SortPolicy::template WorstDistance<ElemType>());
+
+  typedef std::pair<ElemType, size_t> Candidate;
+  struct CandidateCmp
+  {
+    bool operator()(const Candidate& c1, const Candidate& c2)
+    {
+      return !SortPolicy::IsBetter(c2.first, c1.first);
+    }
+  };
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    // Order the lists by how promising their centroids are for this query.
+    const arma::Col<ElemType> centroidDistances =
+        CentroidDistances(querySet.col(i));
+    std::vector<size_t> order(lists.size());
+    for (size_t j = 0; j < order.size(); ++j)
+      order[j] = j;
+    std::partial_sort(order.begin(), order.begin() + effectiveProbes,
+        order.end(), [&centroidDistances](const size_t a, const size_t b)
+        { return SortPolicy::IsBetter(centroidDistances[a],
+                                      centroidDistances[b]); });
+
+    // Scan the probed lists with exact distances, keeping the k best
+    // candidates in a priority queue whose top element is the worst.
+    std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp> pq(
+        CandidateCmp(), std::vector<Candidate>(k,
+        std::make_pair(SortPolicy::template WorstDistance<ElemType>(),
+        size_t() - 1)));
+    for (size_t p = 0; p < effectiveProbes; ++p)
+    {
+      for (const size_t j : lists[order[p]])
+      {
+        if (sameSet && j == i)
+          continue;
+
+        const ElemType distance = EuclideanDistance::Evaluate(querySet.col(i),
+            referenceSet.col(j));
+        if (SortPolicy::IsBetter(distance, pq.top().first))
+        {
+          pq.pop();
+          pq.emplace(distance, j);
+        }
+      }
+    }
+
+    // Extract the results; the queue pops candidates worst-first.
+    std::vector<Candidate> candidates;
+    candidates.reserve(k);
+    while (!pq.empty())
+    {
+      if (pq.top().second != size_t() - 1)
+        candidates.push_back(pq.top());
+      pq.pop();
+    }
+
+    for (size_t j = 0; j < candidates.size(); ++j)
+    {
+      distances(candidates.size() - 1 - j, i) = candidates[j].first;
+      neighbors(candidates.size() - 1 - j, i) = candidates[j].second;
+    }
+  }
+}
+
+template<typename SortPolicy, typename MatType>
+template<typename Archive>
+void IFIndex<SortPolicy, MatType>::serialize(Archive& ar,
+                                             const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(numLists));
+  ar(CEREAL_NVP(maxIterations));
+  ar(CEREAL_NVP(referenceSet));
+  ar(CEREAL_NVP(centroids));
+  ar(CEREAL_NVP(centroidNorms));
+  ar(CEREAL_NVP(lists));
+}
+
+} // namespace mlpack
+
+#endif // MLPACK_METHODS_NEIGHBOR_SEARCH_IF_INDEX_IMPL_HPP
@@ -97,7 +97,7 @@ PARAM_INT_IN("k", "Number of nearest neighbors to find.", "k", 0);
 // building.
 PARAM_STRING_IN("tree_type", "Type of tree to use: 'kd', 'vp', 'rp', 'max-rp', "
     "'ub', 'cover', 'r', 'r-star', 'x', 'ball', 'hilbert-r', 'r-plus', "
-    "'r-plus-plus', 'spill', 'oct'.", "t", "kd");
+    "'r-plus-plus', 'spill', 'oct', 'pq'.", "t", "kd");
 PARAM_INT_IN("leaf_size", "Leaf size for tree building (used for kd-trees, vp "
     "trees, random projection trees, UB trees, R trees, R* trees, X trees, "
     "Hilbert R trees, R+ trees, R++ trees, spill trees, and octrees).", "l",
@@ -209,7 +209,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     KNNModel::TreeTypes tree = KNNModel::KD_TREE;
     RequireParamInSet<string>(params, "tree_type", { "kd", "cover", "r",
         "r-star", "ball", "x", "hilbert-r", "r-plus", "r-plus-plus", "spill",
-        "vp", "rp", "max-rp", "ub", "oct" }, true, "unknown tree type");
+        "vp", "rp", "max-rp", "ub", "oct", "pq" }, true, "unknown tree type");
 
     knn = new KNNModel();
 
@@ -243,6 +243,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
       tree = KNNModel::UB_TREE;
     else if (treeType == "oct")
       tree = KNNModel::OCTREE;
+    else if (treeType == "pq")
+      tree = KNNModel::PQ;
 
     knn->TreeType() = tree;
     knn->RandomBasis() = randomBasis;
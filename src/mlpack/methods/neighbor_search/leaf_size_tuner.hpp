@@ -0,0 +1,72 @@
+/**
+ * @file methods/neighbor_search/leaf_size_tuner.hpp
+ *
+ * Autotuner for the tree leaf size: probe trees are built on a sample of the
+ * dataset across a leaf-size grid, representative query batches are run with
+ * the traversal counters, and the fitted cost curve gives the best leaf size.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_LEAF_SIZE_TUNER_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_LEAF_SIZE_TUNER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Estimate the best tree leaf size for nearest neighbor search on the given
+ * dataset.  A sample of the dataset is taken, probe trees are built for a
+ * grid of leaf sizes, and a batch of representative queries is run in
+ * single-tree mode against each probe tree.  The cost of each leaf size is
+ * modeled from the traversal counters as
+ *
+ *   cost = baseCases + scoreWeight * scores
+ *        + buildWeight * n * log2(n / leafSize)
+ *
+ * where the last term models the tree construction cost (amortized over the
+ * expected query volume; leave buildWeight at 0 for query-dominated
+ * workloads).  A quadratic cost curve is then fit in log2(leafSize) across
+ * the grid, and the minimizer of the fitted curve is returned, so the result
+ * is robust to counter noise at individual grid points and can fall between
+ * grid values.
+ *
+ * Note that TreeType must accept a leaf size in its constructor (as the
+ * kd-tree family does); this matches the set of trees for which the leafSize
+ * option of the command-line programs has an effect.
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam MetricType The metric to use for computation.
+ * @tparam TreeType The tree type to use; must adhere to the TreeType API and
+ *      take a leaf size construction parameter.
+ *
+ * @param dataset Dataset the search will be run on.
+ * @param k Number of neighbors that will be searched for.
+ * @param maxSamples Maximum number of points to build probe trees on.
+ * @param numQueries Number of representative query points to run.
+ * @param scoreWeight Cost of a node score relative to a base case.
+ * @param buildWeight Cost of one point-level tree construction step relative
+ *      to a base case, amortized over the expected query volume.
+ * @return The estimated best leaf size.
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         typename MetricType = EuclideanDistance,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = KDTree>
+size_t TuneLeafSize(const arma::mat& dataset,
+                    const size_t k,
+                    const size_t maxSamples = 2000,
+                    const size_t numQueries = 200,
+                    const double scoreWeight = 2.0,
+                    const double buildWeight = 0.0);
+
+} // namespace mlpack
+
+// Include implementation.
+#include "leaf_size_tuner_impl.hpp"
+
+#endif
@@ -0,0 +1,114 @@
+/**
+ * @file methods/neighbor_search/leaf_size_tuner_impl.hpp
+ *
+ * Implementation of the leaf size autotuner.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_LEAF_SIZE_TUNER_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_LEAF_SIZE_TUNER_IMPL_HPP
+
+#include "leaf_size_tuner.hpp"
+
+namespace mlpack {
+
+template<typename SortPolicy,
+         typename MetricType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+size_t TuneLeafSize(const arma::mat& dataset,
+                    const size_t k,
+                    const size_t maxSamples,
+                    const size_t numQueries,
+                    const double scoreWeight,
+                    const double buildWeight)
+{
+  if (dataset.n_cols == 0)
+    throw std::invalid_argument("TuneLeafSize(): dataset is empty!");
+  if (k == 0)
+    throw std::invalid_argument("TuneLeafSize(): k must be positive!");
+
+  typedef NeighborSearch<SortPolicy, MetricType, arma::mat, TreeType>
+      SearchType;
+  typedef typename SearchType::Tree Tree;
+
+  // Sample the probe set and a representative query batch from the dataset.
+  const size_t probeSize = std::min(maxSamples, (size_t) dataset.n_cols);
+  const size_t querySize = std::min(numQueries, (size_t) dataset.n_cols);
+  arma::uvec order = arma::shuffle(
+      arma::regspace<arma::uvec>(0, dataset.n_cols - 1));
+  const arma::mat probe = dataset.cols(order.head(probeSize));
+  const arma::mat queries = dataset.cols(
+      arma::shuffle(order).head(querySize));
+
+  // Powers of two up to a quarter of the probe set (larger leaves degenerate
+  // towards brute force and never help).
+  std::vector<size_t> grid;
+  for (size_t leaf = 1;
+       leaf <= std::max((size_t) 1, probeSize / 4) && leaf <= 128;
+       leaf *= 2)
+    grid.push_back(leaf);
+
+  arma::vec logLeaf(grid.size());
+  arma::vec costs(grid.size());
+  for (size_t g = 0; g < grid.size(); ++g)
+  {
+    // Build the probe tree with this leaf size and run the query batch in
+    // single-tree mode, so the counters reflect only the reference tree's
+    // leaf size.
+    arma::mat probeCopy(probe);
+    std::vector<size_t> oldFromNew;
+    Tree tree(std::move(probeCopy), oldFromNew, grid[g]);
+    SearchType search(std::move(tree), SINGLE_TREE_MODE);
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    search.Search(queries, std::min(k, probeSize), neighbors, distances);
+
+    double cost = (double) search.BaseCases() +
+        scoreWeight * (double) search.Scores();
+    if (buildWeight > 0.0)
+    {
+      cost += buildWeight * probeSize *
+          std::log2(std::max(2.0, (double) probeSize / grid[g]));
+    }
+
+    logLeaf[g] = std::log2((double) grid[g]);
+    costs[g] = cost;
+
+    Log::Info << "TuneLeafSize(): leaf size " << grid[g] << " has cost "
+        << cost << " (" << search.BaseCases() << " base cases, "
+        << search.Scores() << " scores)." << std::endl;
+  }
+
+  // The grid minimum is the fallback if the curve fit is degenerate.
+  size_t bestLeaf = grid[costs.index_min()];
+
+  // Fit a quadratic cost curve in log2(leafSize); if it is convex, its vertex
+  // (clamped to the grid range) is a better estimate than the noisy grid
+  // minimum and may fall between grid values.
+  if (grid.size() >= 3)
+  {
+    const arma::vec coeffs = arma::polyfit(logLeaf, costs, 2);
+    if (coeffs[0] > 0.0)
+    {
+      const double vertex = -coeffs[1] / (2.0 * coeffs[0]);
+      const double clamped = std::min(std::max(vertex, logLeaf[0]),
+          logLeaf[logLeaf.n_elem - 1]);
+      bestLeaf = (size_t) std::round(std::pow(2.0, clamped));
+    }
+  }
+
+  Log::Info << "TuneLeafSize(): estimated best leaf size is " << bestLeaf
+      << "." << std::endl;
+
+  return bestLeaf;
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,63 @@
+/**
+ * @file methods/neighbor_search/mixed_precision_search.hpp
+ *
+ * Mixed-precision neighbor search: prune and traverse in single precision,
+ * then refine the final candidate distances in double precision.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_MIXED_PRECISION_SEARCH_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_MIXED_PRECISION_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Perform a neighbor search on double-precision data using single-precision
+ * trees and traversal, then refine the results in double precision.  The
+ * search halves the memory traffic of the traversal (the trees and candidate
+ * lists hold floats), and the refinement step recomputes the distance of each
+ * returned candidate against the original double-precision data and re-sorts
+ * the candidate lists, so the returned distances are exact.
+ *
+ * Note that the set of returned neighbors is the one found by the
+ * single-precision search; when two reference points are closer together than
+ * single-precision rounding can distinguish, the candidate set may differ
+ * from an all-double search by points whose distances are equal to within
+ * float precision.
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam MetricType The metric to use for computation.
+ * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ *
+ * @param referenceSet Set of reference points.
+ * @param querySet Set of query points.
+ * @param k Number of neighbors to search for.
+ * @param neighbors Matrix storing lists of neighbors for each query point.
+ * @param distances Matrix storing distances of neighbors for each query point.
+ * @param mode Neighbor search mode.
+ * @param epsilon Relative approximate error (non-negative).
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         typename MetricType = EuclideanDistance,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = KDTree>
+void MixedPrecisionSearch(const arma::mat& referenceSet,
+                          const arma::mat& querySet,
+                          const size_t k,
+                          arma::Mat<size_t>& neighbors,
+                          arma::mat& distances,
+                          const NeighborSearchMode mode = DUAL_TREE_MODE,
+                          const double epsilon = 0);
+
+} // namespace mlpack
+
+// Include implementation.
+#include "mixed_precision_search_impl.hpp"
+
+#endif
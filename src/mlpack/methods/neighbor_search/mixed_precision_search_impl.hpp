@@ -0,0 +1,72 @@
+/**
+ * @file methods/neighbor_search/mixed_precision_search_impl.hpp
+ *
+ * Implementation of mixed-precision neighbor search.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_MIXED_PRECISION_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_MIXED_PRECISION_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mixed_precision_search.hpp"
+
+namespace mlpack {
+
+template<typename SortPolicy,
+         typename MetricType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void MixedPrecisionSearch(const arma::mat& referenceSet,
+                          const arma::mat& querySet,
+                          const size_t k,
+                          arma::Mat<size_t>& neighbors,
+                          arma::mat& distances,
+                          const NeighborSearchMode mode,
+                          const double epsilon)
+{
+  // Run the traversal entirely in single precision.
+  arma::fmat floatReferences = arma::conv_to<arma::fmat>::from(referenceSet);
+  arma::fmat floatQueries = arma::conv_to<arma::fmat>::from(querySet);
+
+  NeighborSearch<SortPolicy, MetricType, arma::fmat, TreeType> search(
+      std::move(floatReferences), mode, epsilon);
+
+  arma::fmat floatDistances;
+  search.Search(floatQueries, k, neighbors, floatDistances);
+
+  // Refine: recompute each candidate's distance against the original
+  // double-precision data, and re-sort each candidate list, since the exact
+  // distances may order the candidates differently than the float ones did.
+  distances.set_size(k, querySet.n_cols);
+  MetricType metric;
+  std::vector<std::pair<double, size_t>> candidates(k);
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    for (size_t j = 0; j < k; ++j)
+    {
+      candidates[j].first = metric.Evaluate(querySet.col(i),
+          referenceSet.col(neighbors(j, i)));
+      candidates[j].second = neighbors(j, i);
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+        [](const std::pair<double, size_t>& a,
+           const std::pair<double, size_t>& b)
+        { return SortPolicy::IsBetter(a.first, b.first); });
+
+    for (size_t j = 0; j < k; ++j)
+    {
+      distances(j, i) = candidates[j].first;
+      neighbors(j, i) = candidates[j].second;
+    }
+  }
+}
+
+} // namespace mlpack
+
+#endif
@@ -82,6 +82,8 @@ class NeighborSearch
  public:
   //! Convenience typedef.
   typedef TreeType<MetricType, NeighborSearchStat<SortPolicy>, MatType> Tree;
+  //! The element type of the data (and so also of the result distances).
+  typedef typename MatType::elem_type ElemType;
 
   /**
    * Initialize the NeighborSearch object, passing a reference dataset (this is
@@ -223,7 +225,93 @@ class NeighborSearch
   void Search(const MatType& querySet,
               const size_t k,
               arma::Mat<size_t>& neighbors,
-              arma::mat& distances);
+              arma::Mat<ElemType>& distances);
+
+  /**
+   * A workspace of preallocated per-query search state: the candidate heaps
+   * of the traversal rules and the intermediate result buffers used for index
+   * remapping.  Construct one workspace and pass it to repeated Search()
+   * calls to reuse these allocations across calls; this matters when Search()
+   * is called many times per second on small query batches, where the
+   * per-call allocations otherwise dominate.  A workspace may be shared
+   * between NeighborSearch objects of the same type, but must not be used by
+   * two Search() calls running at the same time.
+   */
+  class SearchWorkspace
+  {
+   public:
+    //! Release all of the preallocated state, freeing the held memory.
+    void Clear()
+    {
+      candidates.clear();
+      candidates.shrink_to_fit();
+      neighborBuffer.reset();
+      distanceBuffer.reset();
+    }
+
+   private:
+    //! Only Search() uses the buffers.
+    friend class NeighborSearch;
+
+    //! Reusable candidate heaps, one per query point of the last call.
+    std::vector<typename NeighborSearchRules<SortPolicy, MetricType,
+        Tree>::CandidateList> candidates;
+    //! Reusable buffer for neighbor indices that need remapping.
+    arma::Mat<size_t> neighborBuffer;
+    //! Reusable buffer for distances that need query remapping.
+    arma::Mat<ElemType> distanceBuffer;
+  };
+
+  /**
+   * For each point in the query set, compute the nearest neighbors and store
+   * the output in the given matrices, reusing the preallocated state in the
+   * given workspace.  Identical in behavior to the Search() overload above;
+   * see SearchWorkspace.
+   *
+   * @param querySet Set of query points (can be just one point).
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   * @param workspace Preallocated search state to reuse.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& distances,
+              SearchWorkspace& workspace);
+
+  /**
+   * For each point in the query set, compute the nearest neighbors and pass
+   * the results to the given callback one block of queries at a time.  This
+   * is meant for query sets so large that the full k x n result matrices
+   * would not fit in memory: only blockSize columns of results are ever held
+   * at once, and the query tree is built per block.  Results are reported in
+   * the original column order of querySet.
+   *
+   * The callback must be callable as
+   *
+   * @code
+   * callback(const size_t blockBegin,
+   *          const arma::Mat<size_t>& neighbors,
+   *          const arma::Mat<ElemType>& distances);
+   * @endcode
+   *
+   * where blockBegin is the index of the first query point in the block and
+   * column i of neighbors/distances holds the results for query point
+   * (blockBegin + i).  The matrices passed to the callback are reused for the
+   * next block, so the callback must copy anything it needs to keep.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param blockSize Number of query points to process at once.
+   * @param callback Function to call with the results of each block.
+   */
+  template<typename CallbackType>
+  void Search(const MatType& querySet,
+              const size_t k,
+              const size_t blockSize,
+              CallbackType callback);
 
   /**
    * Given a pre-built query tree, search for the nearest neighbors of each
@@ -248,7 +336,7 @@ class NeighborSearch
   void Search(Tree& queryTree,
               const size_t k,
               arma::Mat<size_t>& neighbors,
-              arma::mat& distances,
+              arma::Mat<ElemType>& distances,
               bool sameSet = false);
 
   /**
@@ -267,7 +355,7 @@ class NeighborSearch
    */
   void Search(const size_t k,
               arma::Mat<size_t>& neighbors,
-              arma::mat& distances);
+              arma::Mat<ElemType>& distances);
 
   /**
    * Calculate the average relative error (effective error) between the
@@ -284,8 +372,8 @@ class NeighborSearch
    *     query point.
    * @return Average relative error.
    */
-  static double EffectiveError(arma::mat& foundDistances,
-                               arma::mat& realDistances);
+  static double EffectiveError(arma::Mat<ElemType>& foundDistances,
+                               arma::Mat<ElemType>& realDistances);
 
   /**
    * Calculate the recall (% of neighbors found) given the list of found
@@ -318,6 +406,24 @@ class NeighborSearch
   //! Modify the relative error to be considered in approximate search.
   double& Epsilon() { return epsilon; }
 
+  //! Access the work budget for anytime search (0 means unlimited).
+  size_t Budget() const { return budget; }
+  //! Modify the work budget for anytime search.  When nonzero, Search() stops
+  //! refining after roughly this many base cases plus node scores and returns
+  //! the best neighbors found so far.  The traversers always recurse into the
+  //! best-scored node combinations first, so the budget is spent on the most
+  //! promising parts of the tree; per-query result quality can be read from
+  //! Confidences() afterwards.
+  size_t& Budget() { return budget; }
+
+  //! Get the per-query confidences from the last call to
+  //! Search(querySet, ...) with a nonzero budget: for each query point, the
+  //! fraction of the reference set that was either visited or provably
+  //! pruned.  A confidence of 1.0 means the result is as good as an
+  //! unbudgeted search would have produced.  Empty if no budgeted search has
+  //! been run.
+  const arma::vec& Confidences() const { return confidences; }
+
   //! Access the reference dataset.
   const MatType& ReferenceSet() const { return *referenceSet; }
 
@@ -351,10 +457,22 @@ class NeighborSearch
   //! The total number of scores (applicable for non-naive search).
   size_t scores;
 
+  //! Work budget (base cases plus scores) for anytime search; 0 means
+  //! unlimited.
+  size_t budget;
+  //! Per-query confidences from the last budgeted bichromatic search.
+  arma::vec confidences;
+
   //! If this is true, the reference tree bounds need to be reset on a call to
   //! Search() without a query set.
   bool treeNeedsReset;
 
+  //! The current search generation.  When the reference tree is reused as the
+  //! query tree, the cached bounds in its statistics are invalidated by
+  //! incrementing this counter rather than by walking the whole tree; see
+  //! NeighborSearchStat::Generation().
+  size_t searchGeneration;
+
   //! The NSModel class should have access to internal members.
   friend class LeafSizeNSWrapper<SortPolicy, TreeType, DualTreeTraversalType,
       SingleTreeTraversalType>;
@@ -368,4 +486,16 @@ class NeighborSearch
 // Include convenience typedefs.
 #include "typedef.hpp"
 
+// Include the mixed-precision search helper.
+#include "mixed_precision_search.hpp"
+
+// Include the checkpointing search helper.
+#include "checkpointed_search.hpp"
+
+// Include the leaf size autotuner.
+#include "leaf_size_tuner.hpp"
+
+// Include the sharded decomposition layer.
+#include "sharded_neighbor_search.hpp"
+
 #endif
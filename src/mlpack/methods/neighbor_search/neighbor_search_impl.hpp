@@ -43,7 +43,9 @@ SingleTreeTraversalType>::NeighborSearch(MatType referenceSetIn,
     metric(metric),
     baseCases(0),
     scores(0),
-    treeNeedsReset(false)
+    budget(0),
+    treeNeedsReset(false),
+    searchGeneration(0)
 {
   if (epsilon < 0)
     throw std::invalid_argument("epsilon must be non-negative");
@@ -70,7 +72,9 @@ SingleTreeTraversalType>::NeighborSearch(Tree referenceTree,
     metric(metric),
     baseCases(0),
     scores(0),
-    treeNeedsReset(false)
+    budget(0),
+    treeNeedsReset(false),
+    searchGeneration(0)
 {
   if (epsilon < 0)
     throw std::invalid_argument("epsilon must be non-negative");
@@ -96,7 +100,9 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearchMode mode,
     metric(metric),
     baseCases(0),
     scores(0),
-    treeNeedsReset(false)
+    budget(0),
+    treeNeedsReset(false),
+    searchGeneration(0)
 {
   if (epsilon < 0)
     throw std::invalid_argument("epsilon must be non-negative");
@@ -104,7 +110,7 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearchMode mode,
   // Build the tree on the empty dataset, if necessary.
   if (mode != NAIVE_MODE)
   {
-    referenceTree = BuildTree<Tree>(std::move(arma::mat()),
+    referenceTree = BuildTree<Tree>(std::move(MatType()),
         oldFromNewReferences);
     referenceSet = &referenceTree->Dataset();
   }
@@ -130,7 +136,10 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearch& other) :
     metric(other.metric),
     baseCases(other.baseCases),
     scores(other.scores),
-    treeNeedsReset(false)
+    budget(other.budget),
+    confidences(other.confidences),
+    treeNeedsReset(false),
+    searchGeneration(0)
 {
   // Nothing else to do.
 }
@@ -154,7 +163,10 @@ SingleTreeTraversalType>::NeighborSearch(NeighborSearch&& other) :
     metric(std::move(other.metric)),
     baseCases(other.baseCases),
     scores(other.scores),
-    treeNeedsReset(other.treeNeedsReset)
+    budget(other.budget),
+    confidences(std::move(other.confidences)),
+    treeNeedsReset(other.treeNeedsReset),
+    searchGeneration(other.searchGeneration)
 {
   // Clear the other model.
   other.referenceTree = BuildTree<Tree>(std::move(MatType()),
@@ -164,7 +176,9 @@ SingleTreeTraversalType>::NeighborSearch(NeighborSearch&& other) :
   other.epsilon = 0.0;
   other.baseCases = 0;
   other.scores = 0;
+  other.budget = 0;
   other.treeNeedsReset = false;
+  other.searchGeneration = 0;
 }
 
 // Copy operator.
@@ -207,7 +221,10 @@ NeighborSearch<SortPolicy,
   metric = other.metric;
   baseCases = other.baseCases;
   scores = other.scores;
+  budget = other.budget;
+  confidences = other.confidences;
   treeNeedsReset = false;
+  searchGeneration = other.searchGeneration;
 }
 
 // Move operator.
@@ -249,20 +266,25 @@ NeighborSearch<SortPolicy,
   metric = other.metric;
   baseCases = other.baseCases;
   scores = other.scores;
+  budget = other.budget;
+  confidences = std::move(other.confidences);
   treeNeedsReset = other.treeNeedsReset;
+  searchGeneration = other.searchGeneration;
 
   // Reset the other object.  Clean memory if needed.
   if (!other.referenceTree)
     delete other.referenceSet;
 
-  other.referenceTree = BuildTree<Tree>(std::move(arma::mat()),
+  other.referenceTree = BuildTree<Tree>(std::move(MatType()),
       other.oldFromNewReferences);
   other.referenceSet = &other.referenceTree->Dataset();
   other.searchMode = DUAL_TREE_MODE,
   other.epsilon = 0.0;
   other.baseCases = 0;
   other.scores = 0;
+  other.budget = 0;
   other.treeNeedsReset = false;
+  other.searchGeneration = 0;
 }
 
 // Clean memory.
@@ -365,7 +387,29 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     const MatType& querySet,
     const size_t k,
     arma::Mat<size_t>& neighbors,
-    arma::mat& distances)
+    arma::Mat<ElemType>& distances)
+{
+  // Use a throwaway workspace; callers that search repeatedly should
+  // construct a SearchWorkspace themselves and use the overload below.
+  SearchWorkspace workspace;
+  Search(querySet, k, neighbors, distances, workspace);
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::Mat<ElemType>& distances,
+    SearchWorkspace& workspace)
 {
   if (k > referenceSet->n_cols)
   {
@@ -383,21 +427,25 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
   // If we have built the trees ourselves, then we will have to map all the
   // indices back to their original indices when this computation is finished.
-  // To avoid an extra copy, we will store the neighbors and distances in a
-  // separate matrix.
+  // To avoid an extra copy, we will store the neighbors and distances in the
+  // workspace's buffers, which keep their allocations across calls.
   arma::Mat<size_t>* neighborPtr = &neighbors;
-  arma::mat* distancePtr = &distances;
+  arma::Mat<ElemType>* distancePtr = &distances;
 
   // Mapping is only necessary if the tree rearranges points.
   if (TreeTraits<Tree>::RearrangesDataset)
   {
     if (searchMode == DUAL_TREE_MODE)
     {
-      distancePtr = new arma::mat; // Query indices need to be mapped.
-      neighborPtr = new arma::Mat<size_t>;
+      // Query indices need to be mapped.
+      distancePtr = &workspace.distanceBuffer;
+      neighborPtr = &workspace.neighborBuffer;
     }
     else if (!oldFromNewReferences.empty())
-      neighborPtr = new arma::Mat<size_t>; // Reference indices need mapping.
+    {
+      // Reference indices need mapping.
+      neighborPtr = &workspace.neighborBuffer;
+    }
   }
 
   // Set the size of the neighbor and distance matrices.
@@ -410,8 +458,11 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   {
     case NAIVE_MODE:
     {
-      // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, querySet, k, metric, epsilon);
+      // Create the helper object for the tree traversal.  The work budget
+      // does not apply to brute-force search, which always computes every
+      // distance.
+      RuleType rules(*referenceSet, querySet, k, metric, epsilon, false,
+          0 /* no budget */, &workspace.candidates);
 
       // The naive brute-force traversal.
       for (size_t i = 0; i < querySet.n_cols; ++i)
@@ -421,12 +472,16 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       baseCases += querySet.n_cols * referenceSet->n_cols;
 
       rules.GetResults(*neighborPtr, *distancePtr);
+      rules.ReleaseCandidates(workspace.candidates);
+      if (budget > 0)
+        confidences.ones(querySet.n_cols);
       break;
     }
     case SINGLE_TREE_MODE:
     {
       // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, querySet, k, metric, epsilon);
+      RuleType rules(*referenceSet, querySet, k, metric, epsilon, false,
+          budget, &workspace.candidates);
 
       // Create the traverser.
       SingleTreeTraversalType<RuleType> traverser(rules);
@@ -444,6 +499,13 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
           << std::endl;
 
       rules.GetResults(*neighborPtr, *distancePtr);
+      rules.ReleaseCandidates(workspace.candidates);
+      if (budget > 0)
+      {
+        confidences.set_size(querySet.n_cols);
+        for (size_t i = 0; i < querySet.n_cols; ++i)
+          confidences[i] = rules.Confidence(i);
+      }
       break;
     }
     case DUAL_TREE_MODE:
@@ -452,7 +514,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
 
       // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, queryTree->Dataset(), k, metric, epsilon);
+      RuleType rules(*referenceSet, queryTree->Dataset(), k, metric, epsilon,
+          false, budget, &workspace.candidates);
 
       // Create the traverser.
       DualTreeTraversalType<RuleType> traverser(rules);
@@ -468,6 +531,15 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
           << std::endl;
 
       rules.GetResults(*neighborPtr, *distancePtr);
+      rules.ReleaseCandidates(workspace.candidates);
+      if (budget > 0)
+      {
+        // These are in query-tree order; they are mapped back to the original
+        // query order below, together with the neighbors and distances.
+        confidences.set_size(querySet.n_cols);
+        for (size_t i = 0; i < querySet.n_cols; ++i)
+          confidences[i] = rules.Confidence(i);
+      }
 
       delete queryTree;
       break;
@@ -475,7 +547,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     case GREEDY_SINGLE_TREE_MODE:
     {
       // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, querySet, k, metric);
+      RuleType rules(*referenceSet, querySet, k, metric, 0.0 /* epsilon */,
+          false, budget, &workspace.candidates);
 
       // Create the traverser.
       GreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
@@ -493,6 +566,13 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
           << std::endl;
 
       rules.GetResults(*neighborPtr, *distancePtr);
+      rules.ReleaseCandidates(workspace.candidates);
+      if (budget > 0)
+      {
+        confidences.set_size(querySet.n_cols);
+        for (size_t i = 0; i < querySet.n_cols; ++i)
+          confidences[i] = rules.Confidence(i);
+      }
       break;
     }
   }
@@ -518,10 +598,6 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
               oldFromNewReferences[(*neighborPtr)(j, i)];
         }
       }
-
-      // Finished with temporary matrices.
-      delete neighborPtr;
-      delete distancePtr;
     }
     else if (searchMode == DUAL_TREE_MODE)
     {
@@ -536,10 +612,6 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
         distances.col(queryMapping) = distancePtr->col(i);
         neighbors.col(queryMapping) = neighborPtr->col(i);
       }
-
-      // Finished with temporary matrices.
-      delete neighborPtr;
-      delete distancePtr;
     }
     else if (!oldFromNewReferences.empty())
     {
@@ -550,13 +622,59 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       for (size_t i = 0; i < neighbors.n_cols; ++i)
         for (size_t j = 0; j < neighbors.n_rows; ++j)
           neighbors(j, i) = oldFromNewReferences[(*neighborPtr)(j, i)];
+    }
 
-      // Finished with temporary matrix.
-      delete neighborPtr;
+    // Map the confidences from query-tree order back to the original query
+    // order too.
+    if (budget > 0 && searchMode == DUAL_TREE_MODE)
+    {
+      arma::vec mappedConfidences(confidences.n_elem);
+      for (size_t i = 0; i < confidences.n_elem; ++i)
+        mappedConfidences[oldFromNewQueries[i]] = confidences[i];
+      confidences = std::move(mappedConfidences);
     }
   }
 } // Search()
 
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+template<typename CallbackType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    const size_t blockSize,
+    CallbackType callback)
+{
+  if (blockSize == 0)
+    throw std::invalid_argument("blockSize must be greater than 0");
+
+  // These matrices are reused for every block, so only blockSize columns of
+  // results are ever allocated (plus whatever temporary copies the regular
+  // Search() overload makes for index unmapping).
+  arma::Mat<size_t> blockNeighbors;
+  arma::Mat<ElemType> blockDistances;
+
+  for (size_t begin = 0; begin < querySet.n_cols; begin += blockSize)
+  {
+    const size_t blockCols = std::min(blockSize, querySet.n_cols - begin);
+
+    // The block is copied out of the query set because tree building
+    // rearranges its input; the copy is bounded by blockSize columns.
+    const MatType queryBlock = querySet.cols(begin, begin + blockCols - 1);
+
+    Search(queryBlock, k, blockNeighbors, blockDistances);
+
+    callback(begin, blockNeighbors, blockDistances);
+  }
+} // Search()
+
 template<typename SortPolicy,
          typename MetricType,
          typename MatType,
@@ -570,7 +688,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     Tree& queryTree,
     const size_t k,
     arma::Mat<size_t>& neighbors,
-    arma::mat& distances,
+    arma::Mat<ElemType>& distances,
     bool sameSet)
 {
   if (k > referenceSet->n_cols)
@@ -603,7 +721,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
   // Create the helper object for the traversal.
   typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, querySet, k, metric, epsilon, sameSet);
+  RuleType rules(*referenceSet, querySet, k, metric, epsilon, sameSet, budget);
 
   // Create the traverser.
   DualTreeTraversalType<RuleType> traverser(rules);
@@ -648,7 +766,7 @@ void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
 DualTreeTraversalType, SingleTreeTraversalType>::Search(
     const size_t k,
     arma::Mat<size_t>& neighbors,
-    arma::mat& distances)
+    arma::Mat<ElemType>& distances)
 {
   if (k > referenceSet->n_cols)
   {
@@ -670,12 +788,12 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   scores = 0;
 
   arma::Mat<size_t>* neighborPtr = &neighbors;
-  arma::mat* distancePtr = &distances;
+  arma::Mat<ElemType>* distancePtr = &distances;
 
   if (!oldFromNewReferences.empty() && TreeTraits<Tree>::RearrangesDataset)
   {
     // We will always need to rearrange in this case.
-    distancePtr = new arma::mat;
+    distancePtr = new arma::Mat<ElemType>;
     neighborPtr = new arma::Mat<size_t>;
   }
 
@@ -686,7 +804,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   // Create the helper object for the traversal.
   typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
   RuleType rules(*referenceSet, *referenceSet, k, metric, epsilon,
-      true /* don't return the same point as nearest neighbor */);
+      true /* don't return the same point as nearest neighbor */, budget);
 
   switch (searchMode)
   {
@@ -720,25 +838,13 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     }
     case DUAL_TREE_MODE:
     {
-      // The dual-tree monochromatic search case may require resetting the
-      // bounds in the tree.
+      // The dual-tree monochromatic search case may require invalidating the
+      // bounds cached in the tree.  Instead of walking the whole tree and
+      // resetting every statistic, bump the search generation; the rules then
+      // lazily reset any statistic with a stale generation stamp when it is
+      // first touched.
       if (treeNeedsReset)
-      {
-        std::stack<Tree*> nodes;
-        nodes.push(referenceTree);
-        while (!nodes.empty())
-        {
-          Tree* node = nodes.top();
-          nodes.pop();
-
-          // Reset bounds of this node.
-          node->Stat().Reset();
-
-          // Then add the children.
-          for (size_t i = 0; i < node->NumChildren(); ++i)
-            nodes.push(&node->Child(i));
-        }
-      }
+        rules.Generation() = ++searchGeneration;
 
       // Create the traverser.
       DualTreeTraversalType<RuleType> traverser(rules);
@@ -825,8 +931,8 @@ template<typename SortPolicy,
          template<typename> class SingleTreeTraversalType>
 double NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
 DualTreeTraversalType, SingleTreeTraversalType>::EffectiveError(
-    arma::mat& foundDistances,
-    arma::mat& realDistances)
+    arma::Mat<ElemType>& foundDistances,
+    arma::Mat<ElemType>& realDistances)
 {
   if (foundDistances.n_rows != realDistances.n_rows ||
       foundDistances.n_cols != realDistances.n_cols)
@@ -900,6 +1006,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::serialize(
   // Serialize preferences for search.
   ar(CEREAL_NVP(searchMode));
   ar(CEREAL_NVP(treeNeedsReset));
+  ar(CEREAL_NVP(searchGeneration));
 
   // If we are doing naive search, we serialize the dataset.  Otherwise we
   // serialize the tree.
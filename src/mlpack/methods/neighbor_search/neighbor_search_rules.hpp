@@ -34,6 +34,25 @@ template<typename SortPolicy, typename MetricType, typename TreeType>
 class NeighborSearchRules
 {
  public:
+  //! The element type of the distances (matches the tree's dataset type, so
+  //! single-precision trees produce single-precision results).
+  typedef typename TreeType::ElemType ElemType;
+
+  //! Candidate represents a possible candidate neighbor (distance, index).
+  typedef std::pair<ElemType, size_t> Candidate;
+
+  //! Compare two candidates based on the distance.
+  struct CandidateCmp {
+    bool operator()(const Candidate& c1, const Candidate& c2)
+    {
+      return !SortPolicy::IsBetter(c2.first, c1.first);
+    };
+  };
+
+  //! Use a priority queue to represent the list of candidate neighbors.
+  typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
+      CandidateList;
+
   /**
    * Construct the NeighborSearchRules object.  This is usually done from within
    * the NeighborSearch class at search time.
@@ -45,13 +64,35 @@ class NeighborSearchRules
    * @param epsilon Relative approximate error.
    * @param sameSet If true, the query and reference set are taken to be the
    *      same, and a query point will not return itself in the results.
+   * @param budget Total work budget (base cases plus node scores) for an
+   *      anytime search; once it is spent, every Score() and Rescore() call
+   *      prunes, so the traversal unwinds and the best candidates found so
+   *      far are returned.  0 means unlimited.
+   * @param candidateStorage If non-NULL, candidate heaps are adopted from
+   *      this vector instead of being freshly allocated; pass the heaps
+   *      released by a previous rule set (see ReleaseCandidates()) to avoid
+   *      per-query allocations across repeated searches.
    */
   NeighborSearchRules(const typename TreeType::Mat& referenceSet,
                       const typename TreeType::Mat& querySet,
                       const size_t k,
                       MetricType& metric,
                       const double epsilon = 0,
-                      const bool sameSet = false);
+                      const bool sameSet = false,
+                      const size_t budget = 0,
+                      std::vector<CandidateList>* candidateStorage = NULL);
+
+  /**
+   * Release the candidate heaps into the given vector so that their allocated
+   * capacity can be reused by a later rule set (via the candidateStorage
+   * constructor argument).  The rules object must not be used afterwards.
+   *
+   * @param storage Vector to store the candidate heaps in.
+   */
+  void ReleaseCandidates(std::vector<CandidateList>& storage)
+  {
+    storage.swap(candidates);
+  }
 
   /**
    * Store the list of candidates for each query point in the given matrices.
@@ -60,7 +101,19 @@ class NeighborSearchRules
    * @param distances Matrix storing distances of neighbors for each query
    *     point.
    */
-  void GetResults(arma::Mat<size_t>& neighbors, arma::mat& distances);
+  void GetResults(arma::Mat<size_t>& neighbors,
+                  arma::Mat<ElemType>& distances);
+
+  /**
+   * Merge the candidate lists of another rule set into this one, keeping the
+   * k best candidates for each query point.  The base case and score counts
+   * of the other rule set are accumulated too.  This is used by parallel
+   * traversals, where each thread collects candidates into its own copy of
+   * the rules.
+   *
+   * @param other Rule set whose candidates will be merged into this one.
+   */
+  void Merge(const NeighborSearchRules& other);
 
   /**
    * Get the distance from the query point to the reference point.
@@ -148,6 +201,45 @@ class NeighborSearchRules
   //! Modify the number of scores that have been performed.
   size_t& Scores() { return scores; }
 
+  //! Get the work budget (base cases plus scores; 0 means unlimited).
+  size_t Budget() const { return budget; }
+
+  //! Get the confidence of the results for the given query point: the
+  //! fraction of the reference set that was either visited as a base case or
+  //! covered by a prune.  Always 1.0 for an unbudgeted search; for a
+  //! budgeted search, 1.0 means the result is as good as an unbudgeted one,
+  //! and lower values mean part of the reference set was never considered.
+  double Confidence(const size_t queryIndex) const
+  {
+    if (budget == 0)
+      return 1.0;
+    return std::min(1.0,
+        (double) accounted[queryIndex] / (double) referenceSet.n_cols);
+  }
+
+  //! Get the search generation that cached node statistics must match.
+  size_t Generation() const { return generation; }
+  //! Modify the search generation.  A statistic whose stamp does not match
+  //! this generation is lazily reset when the bounds are next calculated, so
+  //! a search that reuses a tree can invalidate all cached bounds by bumping
+  //! the generation instead of walking the whole tree.
+  size_t& Generation() { return generation; }
+
+  /**
+   * Lazily reset the statistic of the given node if it was last written
+   * during an older search generation.  This is called from the bound
+   * calculations, but it is also a hook for parallel traversals: because it
+   * may write to the statistic, any node whose statistic is shared between
+   * concurrent tasks (i.e. an ancestor of more than one task subtree) must be
+   * restamped with this method before the tasks start, so that the tasks
+   * themselves only ever write statistics inside their own subtrees.
+   */
+  void CheckStat(TreeType& node) const
+  {
+    if (node.Stat().Generation() != generation)
+      node.Stat().Reset(generation);
+  }
+
   //! Convenience typedef.
   typedef typename mlpack::TraversalInfo<TreeType> TraversalInfoType;
 
@@ -167,21 +259,6 @@ class NeighborSearchRules
   //! The query set.
   const typename TreeType::Mat& querySet;
 
-  //! Candidate represents a possible candidate neighbor (distance, index).
-  typedef std::pair<double, size_t> Candidate;
-
-  //! Compare two candidates based on the distance.
-  struct CandidateCmp {
-    bool operator()(const Candidate& c1, const Candidate& c2)
-    {
-      return !SortPolicy::IsBetter(c2.first, c1.first);
-    };
-  };
-
-  //! Use a priority queue to represent the list of candidate neighbors.
-  typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
-      CandidateList;
-
   //! Set of candidate neighbors for each point.
   std::vector<CandidateList> candidates;
 
@@ -209,6 +286,20 @@ class NeighborSearchRules
   //! The number of scores that have been performed.
   size_t scores;
 
+  //! The generation that node statistics must be stamped with to be
+  //! considered fresh; see NeighborSearchStat::Generation().
+  size_t generation;
+
+  //! Work budget (base cases plus scores) for anytime search; 0 means
+  //! unlimited.
+  const size_t budget;
+
+  //! For budgeted searches, the number of reference points that have been
+  //! accounted for (visited or provably pruned) for each query point; this
+  //! is what Confidence() reports.  Mutable because the const Rescore()
+  //! methods record prunes here.  Empty when no budget is set.
+  mutable arma::Col<size_t> accounted;
+
   //! Traversal info for the parent combination; this is updated by the
   //! traversal before each call to Score().
   TraversalInfoType traversalInfo;
@@ -218,6 +309,38 @@ class NeighborSearchRules
    */
   double CalculateBound(TreeType& queryNode) const;
 
+  /**
+   * Returns true if the work budget has been spent.  Once this is true,
+   * Score() and Rescore() prune everything, so the traversal unwinds quickly
+   * and the best candidates found so far become the results.
+   */
+  bool BudgetExhausted() const
+  {
+    return (budget > 0) && (baseCases + scores >= budget);
+  }
+
+  /**
+   * Credit the descendants of a genuinely pruned reference node to the given
+   * query point's accounting (no-op when no budget is set).  Prunes forced by
+   * budget exhaustion must not be credited.
+   */
+  void AccountPrune(const size_t queryIndex, TreeType& referenceNode) const
+  {
+    if (budget > 0)
+      accounted[queryIndex] += referenceNode.NumDescendants();
+  }
+
+  /**
+   * Credit a pruned reference node to every descendant point of a query node.
+   */
+  void AccountPrune(TreeType& queryNode, TreeType& referenceNode) const
+  {
+    if (budget == 0)
+      return;
+    for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
+      accounted[queryNode.Descendant(i)] += referenceNode.NumDescendants();
+  }
+
   /**
    * Helper function to insert a point into the list of candidate points.
    *
@@ -227,7 +350,7 @@ class NeighborSearchRules
    */
   void InsertNeighbor(const size_t queryIndex,
                       const size_t neighbor,
-                      const double distance);
+                      const ElemType distance);
 };
 
 } // namespace mlpack
@@ -14,10 +14,73 @@
 
 // In case it hasn't been included yet.
 #include "neighbor_search_rules.hpp"
+#include "sort_policies/nearest_neighbor_sort.hpp"
+#include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/tree/spill_tree/is_spill_tree.hpp>
 
 namespace mlpack {
 
+namespace internal {
+
+//! Number of dimensions processed between early-abandonment checks of a
+//! partial distance computation.
+const size_t abandonBlockSize = 64;
+
+/**
+ * Evaluate the distance between two points with no early abandonment.  This
+ * is the fallback for metrics whose partial sums do not bound the full
+ * distance dimension-by-dimension.
+ */
+template<typename MetricType, typename VecTypeA, typename VecTypeB>
+inline double EarlyAbandonEvaluate(MetricType& metric,
+                                   const VecTypeA& a,
+                                   const VecTypeB& b,
+                                   const double /* bound */)
+{
+  return metric.Evaluate(a, b);
+}
+
+/**
+ * Evaluate the L2 (or squared L2) distance between two dense points,
+ * abandoning the computation as soon as the partial sum already exceeds the
+ * given bound.  When the computation is abandoned, the returned value is only
+ * a lower bound on the true distance, but it is guaranteed to be worse than
+ * the given bound.
+ */
+template<bool TakeRoot, typename VecTypeA, typename VecTypeB>
+inline typename std::enable_if<
+    !arma::is_arma_sparse_type<VecTypeA>::value &&
+    !arma::is_arma_sparse_type<VecTypeB>::value, double>::type
+EarlyAbandonEvaluate(LMetric<2, TakeRoot>& metric,
+                     const VecTypeA& a,
+                     const VecTypeB& b,
+                     const double bound)
+{
+  // Low-dimensional points and unset bounds do not benefit from checking.
+  if (a.n_elem < 2 * abandonBlockSize || !(bound < DBL_MAX))
+    return metric.Evaluate(a, b);
+
+  const double threshold = TakeRoot ? bound * bound : bound;
+  double sum = 0.0;
+  size_t i = 0;
+  while (i < a.n_elem)
+  {
+    const size_t end = std::min((size_t) a.n_elem, i + abandonBlockSize);
+    for (; i < end; ++i)
+    {
+      const double d = (double) a[i] - (double) b[i];
+      sum += d * d;
+    }
+
+    if (sum > threshold)
+      break; // This point cannot beat the bound; abandon the computation.
+  }
+
+  return TakeRoot ? std::sqrt(sum) : sum;
+}
+
+} // namespace internal
+
 template<typename SortPolicy, typename MetricType, typename TreeType>
 NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
     const typename TreeType::Mat& referenceSet,
@@ -25,7 +88,9 @@ NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
     const size_t k,
     MetricType& metric,
     const double epsilon,
-    const bool sameSet) :
+    const bool sameSet,
+    const size_t budget,
+    std::vector<CandidateList>* candidateStorage) :
     referenceSet(referenceSet),
     querySet(querySet),
     k(k),
@@ -35,8 +100,15 @@ NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
     lastQueryIndex(querySet.n_cols),
     lastReferenceIndex(referenceSet.n_cols),
     baseCases(0),
-    scores(0)
+    scores(0),
+    generation(0),
+    budget(budget)
 {
+  // For anytime (budgeted) search we track, per query point, how much of the
+  // reference set has been visited or pruned.
+  if (budget > 0)
+    accounted.zeros(querySet.n_cols);
+
   // We must set the traversal info last query and reference node pointers to
   // something that is both invalid (i.e. not a tree node) and not NULL.  We'll
   // use the this pointer.
@@ -47,21 +119,41 @@ NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
   // It will be initialized with k candidates: (WorstDistance, size_t() - 1)
   // The list of candidates will be updated when visiting new points with the
   // BaseCase() method.
-  const Candidate def = std::make_pair(SortPolicy::WorstDistance(),
-      size_t() - 1);
+  const Candidate def = std::make_pair(
+      SortPolicy::template WorstDistance<ElemType>(), size_t() - 1);
+
+  if (candidateStorage != NULL)
+  {
+    // Adopt the preallocated heaps.  Emptying an adopted heap and pushing the
+    // k sentinel candidates back into it reuses the capacity of its
+    // underlying container, so no per-query allocation happens when the
+    // storage was last used with the same k and at least this many query
+    // points.
+    candidates.swap(*candidateStorage);
+    if (candidates.size() > querySet.n_cols)
+      candidates.resize(querySet.n_cols);
+
+    for (size_t i = 0; i < candidates.size(); ++i)
+    {
+      while (!candidates[i].empty())
+        candidates[i].pop();
+      for (size_t j = 0; j < k; ++j)
+        candidates[i].push(def);
+    }
+  }
 
   std::vector<Candidate> vect(k, def);
   CandidateList pqueue(CandidateCmp(), std::move(vect));
 
   candidates.reserve(querySet.n_cols);
-  for (size_t i = 0; i < querySet.n_cols; ++i)
+  for (size_t i = candidates.size(); i < querySet.n_cols; ++i)
     candidates.push_back(pqueue);
 }
 
 template<typename SortPolicy, typename MetricType, typename TreeType>
 void NeighborSearchRules<SortPolicy, MetricType, TreeType>::GetResults(
     arma::Mat<size_t>& neighbors,
-    arma::mat& distances)
+    arma::Mat<ElemType>& distances)
 {
   neighbors.set_size(k, querySet.n_cols);
   distances.set_size(k, querySet.n_cols);
@@ -78,6 +170,32 @@ void NeighborSearchRules<SortPolicy, MetricType, TreeType>::GetResults(
   }
 };
 
+template<typename SortPolicy, typename MetricType, typename TreeType>
+void NeighborSearchRules<SortPolicy, MetricType, TreeType>::Merge(
+    const NeighborSearchRules& other)
+{
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    // Insert each of the other rule set's candidates; InsertNeighbor() keeps
+    // only the k best and ignores anything worse than our current worst
+    // candidate.
+    CandidateList pqueue = other.candidates[i]; // Copy so we can pop.
+    while (!pqueue.empty())
+    {
+      const Candidate& c = pqueue.top();
+      // Skip the sentinel candidates the other rule set was initialized with.
+      if (c.second != size_t() - 1)
+        InsertNeighbor(i, c.second, c.first);
+      pqueue.pop();
+    }
+  }
+
+  baseCases += other.baseCases;
+  scores += other.scores;
+  if (budget > 0 && other.accounted.n_elem == accounted.n_elem)
+    accounted += other.accounted;
+}
+
 template<typename SortPolicy, typename MetricType, typename TreeType>
 inline mlpack_force_inline // Must be inline so optimizations can happen.
 double NeighborSearchRules<SortPolicy, MetricType, TreeType>::
@@ -92,9 +210,27 @@ BaseCase(const size_t queryIndex, const size_t referenceIndex)
   if ((lastQueryIndex == queryIndex) && (lastReferenceIndex == referenceIndex))
     return lastBaseCase;
 
-  double distance = metric.Evaluate(querySet.col(queryIndex),
-                                    referenceSet.col(referenceIndex));
+  // For nearest neighbor search, the distance computation can be abandoned
+  // partway once the partial sum is already worse than the current k-th best
+  // candidate; this is a large win for high-dimensional data.  The abandoned
+  // value is only a lower bound on the true distance, so this is not done for
+  // trees that reuse the base case result as an exact distance in Score().
+  double distance;
+  if (std::is_same<SortPolicy, NearestNeighborSort>::value &&
+      !TreeTraits<TreeType>::FirstPointIsCentroid)
+  {
+    distance = internal::EarlyAbandonEvaluate(metric,
+        querySet.col(queryIndex), referenceSet.col(referenceIndex),
+        (double) candidates[queryIndex].top().first);
+  }
+  else
+  {
+    distance = metric.Evaluate(querySet.col(queryIndex),
+                               referenceSet.col(referenceIndex));
+  }
   ++baseCases;
+  if (budget > 0)
+    ++accounted[queryIndex];
 
   InsertNeighbor(queryIndex, referenceIndex, distance);
 
@@ -111,6 +247,12 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
     const size_t queryIndex,
     TreeType& referenceNode)
 {
+  // If the work budget is spent, prune everything (without crediting the
+  // prune to the confidence accounting, since we did not prove anything
+  // about this node).
+  if (BudgetExhausted())
+    return DBL_MAX;
+
   ++scores; // Count number of Score() calls.
   double distance;
   if (TreeTraits<TreeType>::FirstPointIsCentroid)
@@ -145,8 +287,13 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
   double bestDistance = candidates[queryIndex].top().first;
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
-  return (SortPolicy::IsBetter(distance, bestDistance)) ?
-      SortPolicy::ConvertToScore(distance) : DBL_MAX;
+  if (SortPolicy::IsBetter(distance, bestDistance))
+    return SortPolicy::ConvertToScore(distance);
+
+  // This is a genuine prune, so all of the node's descendants are accounted
+  // for in the results for this query point.
+  AccountPrune(queryIndex, referenceNode);
+  return DBL_MAX;
 }
 
 template<typename SortPolicy, typename MetricType, typename TreeType>
@@ -168,20 +315,28 @@ GetBestChild(const TreeType& queryNode, TreeType& referenceNode)
 template<typename SortPolicy, typename MetricType, typename TreeType>
 inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Rescore(
     const size_t queryIndex,
-    TreeType& /* referenceNode */,
+    TreeType& referenceNode,
     const double oldScore) const
 {
   // If we are already pruning, still prune.
   if (oldScore == DBL_MAX)
     return oldScore;
 
+  // If the work budget is spent, prune everything.
+  if (BudgetExhausted())
+    return DBL_MAX;
+
   const double distance = SortPolicy::ConvertToDistance(oldScore);
 
   // Just check the score again against the distances.
   double bestDistance = candidates[queryIndex].top().first;
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
-  return (SortPolicy::IsBetter(distance, bestDistance)) ? oldScore : DBL_MAX;
+  if (SortPolicy::IsBetter(distance, bestDistance))
+    return oldScore;
+
+  AccountPrune(queryIndex, referenceNode);
+  return DBL_MAX;
 }
 
 template<typename SortPolicy, typename MetricType, typename TreeType>
@@ -189,6 +344,11 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
     TreeType& queryNode,
     TreeType& referenceNode)
 {
+  // If the work budget is spent, prune everything (without crediting the
+  // prune to the confidence accounting).
+  if (BudgetExhausted())
+    return DBL_MAX;
+
   ++scores; // Count number of Score() calls.
 
   // Update our bound.
@@ -289,6 +449,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
       // There isn't any need to set the traversal information because no
       // descendant combinations will be visited, and those are the only
       // combinations that would depend on the traversal information.
+      AccountPrune(queryNode, referenceNode);
       return DBL_MAX;
     }
   }
@@ -341,6 +502,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
     // There isn't any need to set the traversal information because no
     // descendant combinations will be visited, and those are the only
     // combinations that would depend on the traversal information.
+    AccountPrune(queryNode, referenceNode);
     return DBL_MAX;
   }
 }
@@ -348,18 +510,26 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
 template<typename SortPolicy, typename MetricType, typename TreeType>
 inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Rescore(
     TreeType& queryNode,
-    TreeType& /* referenceNode */,
+    TreeType& referenceNode,
     const double oldScore) const
 {
   if (oldScore == DBL_MAX || oldScore == 0.0)
     return oldScore;
 
+  // If the work budget is spent, prune everything.
+  if (BudgetExhausted())
+    return DBL_MAX;
+
   const double distance = SortPolicy::ConvertToDistance(oldScore);
 
   // Update our bound.
   const double bestDistance = CalculateBound(queryNode);
 
-  return (SortPolicy::IsBetter(distance, bestDistance)) ? oldScore : DBL_MAX;
+  if (SortPolicy::IsBetter(distance, bestDistance))
+    return oldScore;
+
+  AccountPrune(queryNode, referenceNode);
+  return DBL_MAX;
 }
 
 // Calculate the bound for a given query node in its current state and update
@@ -395,6 +565,14 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::
   // Then, to assemble the final bound, since both bounds are valid, we simply
   // take the better of the two.
 
+  // Make sure the cached bounds we are about to read were not left behind by
+  // an earlier search on the same tree.
+  CheckStat(queryNode);
+  if (queryNode.Parent() != NULL)
+    CheckStat(*queryNode.Parent());
+  for (size_t i = 0; i < queryNode.NumChildren(); ++i)
+    CheckStat(queryNode.Child(i));
+
   double worstDistance = SortPolicy::BestDistance();
   double bestPointDistance = SortPolicy::WorstDistance();
 
@@ -494,7 +672,7 @@ inline void NeighborSearchRules<SortPolicy, MetricType, TreeType>::
 InsertNeighbor(
     const size_t queryIndex,
     const size_t neighbor,
-    const double distance)
+    const ElemType distance)
 {
   CandidateList& pqueue = candidates[queryIndex];
   Candidate c = std::make_pair(distance, neighbor);
@@ -38,6 +38,11 @@ class NeighborSearchStat
   double auxBound;
   //! The last distance evaluation.
   double lastDistance;
+  //! The generation stamp of the bounds.  A search that reuses the tree bumps
+  //! its own generation counter instead of walking the whole tree to reset
+  //! every statistic; a statistic whose stamp does not match the search's
+  //! generation is treated as unset and lazily reset when first touched.
+  size_t generation;
 
  public:
   /**
@@ -48,7 +53,8 @@ class NeighborSearchStat
       firstBound(SortPolicy::WorstDistance()),
       secondBound(SortPolicy::WorstDistance()),
       auxBound(SortPolicy::WorstDistance()),
-      lastDistance(0.0) { }
+      lastDistance(0.0),
+      generation(0) { }
 
   /**
    * Initialization for a fully initialized node.  In this case, we don't need
@@ -59,7 +65,8 @@ class NeighborSearchStat
       firstBound(SortPolicy::WorstDistance()),
       secondBound(SortPolicy::WorstDistance()),
       auxBound(SortPolicy::WorstDistance()),
-      lastDistance(0.0) { }
+      lastDistance(0.0),
+      generation(0) { }
 
   /**
    * Reset statistic parameters to initial values.
@@ -72,6 +79,16 @@ class NeighborSearchStat
     lastDistance = 0.0;
   }
 
+  /**
+   * Reset statistic parameters to initial values and stamp the statistic with
+   * the given generation, marking it as fresh for that search generation.
+   */
+  void Reset(const size_t newGeneration)
+  {
+    Reset();
+    generation = newGeneration;
+  }
+
   //! Get the first bound.
   double FirstBound() const { return firstBound; }
   //! Modify the first bound.
@@ -88,6 +105,10 @@ class NeighborSearchStat
   double LastDistance() const { return lastDistance; }
   //! Modify the last distance calculation.
   double& LastDistance() { return lastDistance; }
+  //! Get the generation stamp.
+  size_t Generation() const { return generation; }
+  //! Modify the generation stamp.
+  size_t& Generation() { return generation; }
 
   //! Serialize the statistic to/from an archive.
   template<typename Archive>
@@ -97,6 +118,7 @@ class NeighborSearchStat
     ar(CEREAL_NVP(secondBound));
     ar(CEREAL_NVP(auxBound));
     ar(CEREAL_NVP(lastDistance));
+    ar(CEREAL_NVP(generation));
   }
 };
 
@@ -22,6 +22,8 @@
 #include <mlpack/core/tree/spill_tree.hpp>
 #include <mlpack/core/tree/octree.hpp>
 #include "neighbor_search.hpp"
+#include "pq_index.hpp"
+#include "if_index.hpp"
 
 namespace mlpack {
 
@@ -328,6 +330,174 @@ class SpillNSWrapper :
              arma::mat>::template DefeatistSingleTreeTraverser>::ns;
 };
 
+/**
+ * The PQNSWrapper class wraps the PQIndex class, which performs approximate
+ * search with a product quantization index instead of a tree.  The search mode
+ * and epsilon parameters are accepted for API compatibility but ignored; the
+ * quality of the results is controlled by the size of the re-ranking candidate
+ * set (see PQIndex::Search()).
+ */
+template<typename SortPolicy>
+class PQNSWrapper : public NSWrapperBase
+{
+ public:
+  //! Construct the PQNSWrapper.
+  PQNSWrapper(const NeighborSearchMode searchMode,
+              const double epsilon) :
+      searchMode(searchMode),
+      epsilon(epsilon)
+  {
+    // Nothing to do.
+  }
+
+  //! Destruct the PQNSWrapper.
+  virtual ~PQNSWrapper() { }
+
+  //! Return a copy of the PQNSWrapper.
+  virtual PQNSWrapper* Clone() const { return new PQNSWrapper(*this); }
+
+  //! Get a reference to the reference set.
+  const arma::mat& Dataset() const { return pq.ReferenceSet(); }
+
+  //! Get the search mode.  (This is ignored by the PQ index.)
+  NeighborSearchMode SearchMode() const { return searchMode; }
+  //! Modify the search mode.  (This is ignored by the PQ index.)
+  NeighborSearchMode& SearchMode() { return searchMode; }
+
+  //! Get epsilon, the approximation parameter.  (This is ignored by the PQ
+  //! index.)
+  double Epsilon() const { return epsilon; }
+  //! Modify epsilon, the approximation parameter.  (This is ignored by the PQ
+  //! index.)
+  double& Epsilon() { return epsilon; }
+
+  //! Train the index on the given reference set.  The extra parameters are
+  //! ignored.
+  virtual void Train(util::Timers& timers,
+                     arma::mat&& referenceSet,
+                     const size_t /* leafSize */,
+                     const double /* tau */,
+                     const double /* rho */);
+
+  //! Perform bichromatic neighbor search (i.e. search with a separate query
+  //! set).  The extra parameters are ignored.
+  virtual void Search(util::Timers& timers,
+                      arma::mat&& querySet,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances,
+                      const size_t /* leafSize */,
+                      const double /* rho */);
+
+  //! Perform monochromatic neighbor search (i.e. use the reference set as the
+  //! query set).
+  virtual void Search(util::Timers& timers,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances);
+
+  //! Serialize the PQ index.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(searchMode));
+    ar(CEREAL_NVP(epsilon));
+    ar(CEREAL_NVP(pq));
+  }
+
+ protected:
+  //! The product quantization index.
+  PQIndex<SortPolicy> pq;
+  //! The search mode; held only for API compatibility.
+  NeighborSearchMode searchMode;
+  //! The approximation parameter; held only for API compatibility.
+  double epsilon;
+};
+
+/**
+ * The IFNSWrapper class wraps the IFIndex class, which performs approximate
+ * search with an inverted-file index instead of a tree.  The search mode and
+ * epsilon parameters are accepted for API compatibility but ignored; the
+ * quality of the results is controlled by the number of probed lists (see
+ * IFIndex::Search()).
+ */
+template<typename SortPolicy>
+class IFNSWrapper : public NSWrapperBase
+{
+ public:
+  //! Construct the IFNSWrapper.
+  IFNSWrapper(const NeighborSearchMode searchMode,
+              const double epsilon) :
+      searchMode(searchMode),
+      epsilon(epsilon)
+  {
+    // Nothing to do.
+  }
+
+  //! Destruct the IFNSWrapper.
+  virtual ~IFNSWrapper() { }
+
+  //! Return a copy of the IFNSWrapper.
+  virtual IFNSWrapper* Clone() const { return new IFNSWrapper(*this); }
+
+  //! Get a reference to the reference set.
+  const arma::mat& Dataset() const { return ivf.ReferenceSet(); }
+
+  //! Get the search mode.  (This is ignored by the inverted-file index.)
+  NeighborSearchMode SearchMode() const { return searchMode; }
+  //! Modify the search mode.  (This is ignored by the inverted-file index.)
+  NeighborSearchMode& SearchMode() { return searchMode; }
+
+  //! Get epsilon, the approximation parameter.  (This is ignored by the
+  //! inverted-file index.)
+  double Epsilon() const { return epsilon; }
+  //! Modify epsilon, the approximation parameter.  (This is ignored by the
+  //! inverted-file index.)
+  double& Epsilon() { return epsilon; }
+
+  //! Train the index on the given reference set.  The extra parameters are
+  //! ignored.
+  virtual void Train(util::Timers& timers,
+                     arma::mat&& referenceSet,
+                     const size_t /* leafSize */,
+                     const double /* tau */,
+                     const double /* rho */);
+
+  //! Perform bichromatic neighbor search (i.e. search with a separate query
+  //! set).  The extra parameters are ignored.
+  virtual void Search(util::Timers& timers,
+                      arma::mat&& querySet,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances,
+                      const size_t /* leafSize */,
+                      const double /* rho */);
+
+  //! Perform monochromatic neighbor search (i.e. use the reference set as the
+  //! query set).
+  virtual void Search(util::Timers& timers,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances);
+
+  //! Serialize the inverted-file index.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(searchMode));
+    ar(CEREAL_NVP(epsilon));
+    ar(CEREAL_NVP(ivf));
+  }
+
+ protected:
+  //! The inverted-file index.
+  IFIndex<SortPolicy> ivf;
+  //! The search mode; held only for API compatibility.
+  NeighborSearchMode searchMode;
+  //! The approximation parameter; held only for API compatibility.
+  double epsilon;
+};
+
 /**
  * The NSModel class provides an easy way to serialize a model, abstracts away
  * the different types of trees, and also reflects the NeighborSearch API.  This
@@ -359,7 +529,9 @@ class NSModel
     MAX_RP_TREE,
     SPILL_TREE,
     UB_TREE,
-    OCTREE
+    OCTREE,
+    PQ, // Not a tree: a product quantization index (see PQIndex).
+    IVF // Not a tree: an inverted-file index (see IFIndex).
   };
 
  private:
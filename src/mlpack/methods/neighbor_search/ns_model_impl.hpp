@@ -236,6 +236,100 @@ void SpillNSWrapper<SortPolicy>::Search(util::Timers& timers,
   }
 }
 
+//! Train the PQ index on the given reference set.
+template<typename SortPolicy>
+void PQNSWrapper<SortPolicy>::Train(util::Timers& timers,
+                                    arma::mat&& referenceSet,
+                                    const size_t /* leafSize */,
+                                    const double /* tau */,
+                                    const double /* rho */)
+{
+  // The dimensionality of the data must be divisible by the number of
+  // subspaces, so pick the largest number of subspaces not greater than 8
+  // that divides the dimensionality.
+  size_t numSubspaces = 1;
+  for (size_t m = 2; m <= 8; ++m)
+    if (referenceSet.n_rows % m == 0)
+      numSubspaces = m;
+  pq.NumSubspaces() = numSubspaces;
+
+  // We cannot have more codewords than reference points.
+  pq.NumCodewords() = std::min((size_t) 256, referenceSet.n_cols);
+
+  timers.Start("index_building");
+  pq.Train(std::move(referenceSet));
+  timers.Stop("index_building");
+}
+
+//! Perform bichromatic neighbor search with the PQ index.
+template<typename SortPolicy>
+void PQNSWrapper<SortPolicy>::Search(util::Timers& timers,
+                                     arma::mat&& querySet,
+                                     const size_t k,
+                                     arma::Mat<size_t>& neighbors,
+                                     arma::mat& distances,
+                                     const size_t /* leafSize */,
+                                     const double /* rho */)
+{
+  timers.Start("computing_neighbors");
+  pq.Search(querySet, k, neighbors, distances);
+  timers.Stop("computing_neighbors");
+}
+
+//! Perform monochromatic neighbor search with the PQ index.
+template<typename SortPolicy>
+void PQNSWrapper<SortPolicy>::Search(util::Timers& timers,
+                                     const size_t k,
+                                     arma::Mat<size_t>& neighbors,
+                                     arma::mat& distances)
+{
+  timers.Start("computing_neighbors");
+  pq.Search(k, neighbors, distances);
+  timers.Stop("computing_neighbors");
+}
+
+//! Train the inverted-file index on the given reference set.
+template<typename SortPolicy>
+void IFNSWrapper<SortPolicy>::Train(util::Timers& timers,
+                                    arma::mat&& referenceSet,
+                                    const size_t /* leafSize */,
+                                    const double /* tau */,
+                                    const double /* rho */)
+{
+  // Leave the number of lists at 0, so that the index picks roughly the
+  // square root of the number of reference points at training time.
+  timers.Start("index_building");
+  ivf.Train(std::move(referenceSet));
+  timers.Stop("index_building");
+}
+
+//! Perform bichromatic neighbor search with the inverted-file index.
+template<typename SortPolicy>
+void IFNSWrapper<SortPolicy>::Search(util::Timers& timers,
+                                     arma::mat&& querySet,
+                                     const size_t k,
+                                     arma::Mat<size_t>& neighbors,
+                                     arma::mat& distances,
+                                     const size_t /* leafSize */,
+                                     const double /* rho */)
+{
+  timers.Start("computing_neighbors");
+  ivf.Search(querySet, k, neighbors, distances);
+  timers.Stop("computing_neighbors");
+}
+
+//! Perform monochromatic neighbor search with the inverted-file index.
+template<typename SortPolicy>
+void IFNSWrapper<SortPolicy>::Search(util::Timers& timers,
+                                     const size_t k,
+                                     arma::Mat<size_t>& neighbors,
+                                     arma::mat& distances)
+{
+  timers.Start("computing_neighbors");
+  ivf.Search(k, neighbors, distances);
+  timers.Stop("computing_neighbors");
+}
+
 /**
  * Initialize the NSModel with the given type and whether or not a random
  * basis should be used.
@@ -461,6 +555,20 @@ void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
         ar(CEREAL_NVP(typedSearch));
         break;
       }
+    case PQ:
+      {
+        PQNSWrapper<SortPolicy>& typedSearch =
+            dynamic_cast<PQNSWrapper<SortPolicy>&>(*nSearch);
+        ar(CEREAL_NVP(typedSearch));
+        break;
+      }
+    case IVF:
+      {
+        IFNSWrapper<SortPolicy>& typedSearch =
+            dynamic_cast<IFNSWrapper<SortPolicy>&>(*nSearch);
+        ar(CEREAL_NVP(typedSearch));
+        break;
+      }
   }
 }
 
@@ -556,6 +664,12 @@ void NSModel<SortPolicy>::InitializeModel(const NeighborSearchMode searchMode,
     case OCTREE:
       nSearch = new LeafSizeNSWrapper<SortPolicy, Octree>(searchMode, epsilon);
       break;
+    case PQ:
+      nSearch = new PQNSWrapper<SortPolicy>(searchMode, epsilon);
+      break;
+    case IVF:
+      nSearch = new IFNSWrapper<SortPolicy>(searchMode, epsilon);
+      break;
   }
 }
 
@@ -720,6 +834,10 @@ std::string NSModel<SortPolicy>::TreeName() const
       return "UB tree";
     case OCTREE:
       return "octree";
+    case PQ:
+      return "product quantization index";
+    case IVF:
+      return "inverted-file index";
     default:
       return "unknown tree";
   }
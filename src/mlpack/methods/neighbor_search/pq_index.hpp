@@ -0,0 +1,207 @@
+/**
+ * @file methods/neighbor_search/pq_index.hpp
+ *
+ * Defines the PQIndex class, a product-quantization index for approximate
+ * neighbor search with asymmetric distance computation and exact re-ranking.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_PQ_INDEX_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_PQ_INDEX_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/kmeans/kmeans.hpp>
+
+#include "sort_policies/nearest_neighbor_sort.hpp"
+
+namespace mlpack {
+
+/**
+ * The PQIndex class implements product quantization (PQ) for approximate
+ * neighbor search.  The dataset is split into contiguous subspaces of equal
+ * dimension; each subspace is vector-quantized with a small codebook trained
+ * by k-means, so every point is stored as a short code of codeword indices.
+ * At search time, a per-query table of distances from the query to every
+ * codeword is computed once, and the approximate distance to each reference
+ * point is the sum of table lookups over its code (asymmetric distance
+ * computation).  The best candidates under the approximate distance are then
+ * re-ranked by their exact distance to the original reference set, so the
+ * returned distances are exact even though the candidate set is approximate.
+ *
+ * Optionally, an optimized rotation of the data (OPQ) can be trained before
+ * quantization; this typically improves recall when the variance is
+ * concentrated in a few dimensions.
+ *
+ * Unlike the tree-based NeighborSearch class, the quality of the results is
+ * controlled by the size of the re-ranking candidate set rather than by an
+ * epsilon bound: larger candidate sets give higher recall at lower
+ * throughput.  Quantization is specific to the squared Euclidean distance, so
+ * no MetricType parameter is accepted.
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam MatType The type of data matrix.
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         typename MatType = arma::mat>
+class PQIndex
+{
+ public:
+  //! The element type of the data (and so also of the result distances).
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Create a PQIndex without building it on any data; call Train() before
+   * Search(), or an exception will be thrown.
+   *
+   * @param numSubspaces Number of subspaces to split the dimensions into; the
+   *      dimensionality of the data must be divisible by this.
+   * @param numCodewords Number of codewords per subspace (at most 256, so
+   *      that codes fit in one byte per subspace).
+   * @param opqIterations Number of alternating iterations used to train an
+   *      optimized rotation of the data (0 means no rotation is used).
+   */
+  PQIndex(const size_t numSubspaces = 8,
+          const size_t numCodewords = 256,
+          const size_t opqIterations = 0);
+
+  /**
+   * Create a PQIndex and build it on the given reference set.
+   *
+   * @param referenceSet Set of reference points.
+   * @param numSubspaces Number of subspaces to split the dimensions into; the
+   *      dimensionality of the data must be divisible by this.
+   * @param numCodewords Number of codewords per subspace (at most 256).
+   * @param opqIterations Number of alternating iterations used to train an
+   *      optimized rotation of the data (0 means no rotation is used).
+   */
+  PQIndex(MatType referenceSet,
+          const size_t numSubspaces = 8,
+          const size_t numCodewords = 256,
+          const size_t opqIterations = 0);
+
+  /**
+   * Build the index on the given reference set, training the codebooks (and
+   * the rotation, if opqIterations is nonzero) and encoding every reference
+   * point.  Any previously built index is discarded.
+   *
+   * @param referenceSet Set of reference points.
+   */
+  void Train(MatType referenceSet);
+
+  /**
+   * For each point in the query set, find the k approximate neighbors in the
+   * reference set and store the output in the given matrices.  The matrices
+   * will be set to the correct size.  The returned distances are exact
+   * distances to the returned neighbors; the approximation is only in which
+   * candidates are considered.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *      point.
+   * @param rerank Number of candidates to re-rank with exact distances; 0
+   *      means 8 * k.  Setting this to the size of the reference set makes
+   *      the search exact.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& distances,
+              const size_t rerank = 0);
+
+  /**
+   * For each point in the reference set, find the k approximate neighbors in
+   * the reference set (excluding the point itself) and store the output in
+   * the given matrices.
+   *
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *      point.
+   * @param rerank Number of candidates to re-rank with exact distances; 0
+   *      means 8 * k.
+   */
+  void Search(const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& distances,
+              const size_t rerank = 0);
+
+  //! Access the reference set.
+  const MatType& ReferenceSet() const { return referenceSet; }
+
+  //! Get the number of subspaces.
+  size_t NumSubspaces() const { return numSubspaces; }
+  //! Modify the number of subspaces.  This will only take effect the next
+  //! time Train() is called.
+  size_t& NumSubspaces() { return numSubspaces; }
+  //! Get the number of codewords per subspace.
+  size_t NumCodewords() const { return numCodewords; }
+  //! Modify the number of codewords per subspace.  This will only take effect
+  //! the next time Train() is called.
+  size_t& NumCodewords() { return numCodewords; }
+  //! Get the number of OPQ rotation training iterations.
+  size_t OPQIterations() const { return opqIterations; }
+  //! Modify the number of OPQ rotation training iterations.  This will only
+  //! take effect the next time Train() is called.
+  size_t& OPQIterations() { return opqIterations; }
+
+  //! Access the trained codebooks (subspace dimension x codewords x
+  //! subspaces).
+  const arma::Cube<ElemType>& Codebooks() const { return codebooks; }
+  //! Access the codes of the reference points (subspaces x points).
+  const arma::Mat<arma::u8>& Codes() const { return codes; }
+  //! Access the learned rotation (empty if no rotation is used).
+  const arma::Mat<ElemType>& Rotation() const { return rotation; }
+
+  //! Serialize the index.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Number of subspaces the dimensions are split into.
+  size_t numSubspaces;
+  //! Number of codewords per subspace.
+  size_t numCodewords;
+  //! Number of OPQ rotation training iterations.
+  size_t opqIterations;
+
+  //! The reference set; kept for the exact re-ranking stage.
+  MatType referenceSet;
+  //! The learned rotation; empty when opqIterations is 0.
+  arma::Mat<ElemType> rotation;
+  //! Codebooks, one slice per subspace.
+  arma::Cube<ElemType> codebooks;
+  //! Codes of the reference points, one column per point.
+  arma::Mat<arma::u8> codes;
+
+  /**
+   * The implementation of both Search() overloads; when sameSet is true, a
+   * query point will not return itself in the results.
+   */
+  void SearchInternal(const MatType& querySet,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::Mat<ElemType>& distances,
+                      const size_t rerank,
+                      const bool sameSet);
+
+  //! Train one codebook per subspace on the given (already rotated) data.
+  void TrainCodebooks(const arma::Mat<ElemType>& rotatedSet);
+
+  //! Encode every column of the given (already rotated) data into codes.
+  void Encode(const arma::Mat<ElemType>& rotatedSet);
+
+  //! Reconstruct the (rotated-space) approximation of every encoded point.
+  arma::Mat<ElemType> Decode() const;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "pq_index_impl.hpp"
+
+#endif // MLPACK_METHODS_NEIGHBOR_SEARCH_PQ_INDEX_HPP
@@ -0,0 +1,318 @@
+/**
+ * @file methods/neighbor_search/pq_index_impl.hpp
+ *
+ * Implementation of the PQIndex class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_PQ_INDEX_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_PQ_INDEX_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "pq_index.hpp"
+
+namespace mlpack {
+
+template<typename SortPolicy, typename MatType>
+PQIndex<SortPolicy, MatType>::PQIndex(const size_t numSubspaces,
+                                      const size_t numCodewords,
+                                      const size_t opqIterations) :
+    numSubspaces(numSubspaces),
+    numCodewords(numCodewords),
+    opqIterations(opqIterations)
+{
+  if (numSubspaces == 0)
+    throw std::invalid_argument("PQIndex: numSubspaces must be positive");
+  if (numCodewords == 0 || numCodewords > 256)
+    throw std::invalid_argument("PQIndex: numCodewords must be between 1 and "
+        "256");
+}
+
+template<typename SortPolicy, typename MatType>
+PQIndex<SortPolicy, MatType>::PQIndex(MatType referenceSet,
+                                      const size_t numSubspaces,
+                                      const size_t numCodewords,
+                                      const size_t opqIterations) :
+    PQIndex(numSubspaces, numCodewords, opqIterations)
+{
+  Train(std::move(referenceSet));
+}
+
+template<typename SortPolicy, typename MatType>
+void PQIndex<SortPolicy, MatType>::Train(MatType referenceSet)
+{
+  // Re-validate the parameters, since they may have been modified since
+  // construction.
+  if (numSubspaces == 0)
+    throw std::invalid_argument("PQIndex::Train(): numSubspaces must be "
+        "positive");
+  if (numCodewords == 0 || numCodewords > 256)
+    throw std::invalid_argument("PQIndex::Train(): numCodewords must be "
+        "between 1 and 256");
+  if (referenceSet.n_rows % numSubspaces != 0)
+  {
+    std::ostringstream oss;
+    oss << "PQIndex::Train(): dimensionality of data (" << referenceSet.n_rows
+        << ") is not divisible by the number of subspaces (" << numSubspaces
+        << ")";
+    throw std::invalid_argument(oss.str());
+  }
+  if (referenceSet.n_cols < numCodewords)
+  {
+    std::ostringstream oss;
+    oss << "PQIndex::Train(): number of reference points ("
+        << referenceSet.n_cols << ") must be at least the number of codewords "
+        << "(" << numCodewords << ")";
+    throw std::invalid_argument(oss.str());
+  }
+
+  this->referenceSet = std::move(referenceSet);
+
+  if (opqIterations == 0)
+  {
+    // Plain PQ: no rotation.
+    rotation.clear();
+    TrainCodebooks(this->referenceSet);
+    Encode(this->referenceSet);
+    return;
+  }
+
+  // OPQ: alternate between quantizing the rotated data and updating the
+  // rotation to best align the data with its quantized reconstruction (the
+  // orthogonal Procrustes solution).
+  const arma::Mat<ElemType>& data = this->referenceSet;
+  rotation.eye(data.n_rows, data.n_rows);
+  for (size_t iteration = 0; iteration < opqIterations; ++iteration)
+  {
+    const arma::Mat<ElemType> rotated = rotation.t() * data;
+    TrainCodebooks(rotated);
+    Encode(rotated);
+
+    const arma::Mat<ElemType> reconstruction = Decode();
+    arma::Mat<ElemType> u, v;
+    arma::Col<ElemType> s;
+    if (!arma::svd(u, s, v, data * reconstruction.t()))
+      throw std::runtime_error("PQIndex::Train(): SVD failed during rotation "
+          "optimization");
+    rotation = u * v.t();
+  }
+
+  // Quantize once more with the final rotation, so that the codebooks and
+  // codes are consistent with it.
+  const arma::Mat<ElemType> rotated = rotation.t() * data;
+  TrainCodebooks(rotated);
+  Encode(rotated);
+}
+
+template<typename SortPolicy, typename MatType>
+void PQIndex<SortPolicy, MatType>::TrainCodebooks(
+    const arma::Mat<ElemType>& rotatedSet)
+{
+  const size_t subDim = rotatedSet.n_rows / numSubspaces;
+  codebooks.set_size(subDim, numCodewords, numSubspaces);
+
+  for (size_t s = 0; s < numSubspaces; ++s)
+  {
+    // KMeans computes double-precision centroids regardless of the data type.
+    const arma::mat subspace = arma::conv_to<arma::mat>::from(
+        rotatedSet.rows(s * subDim, (s + 1) * subDim - 1));
+    arma::mat centroids;
+    KMeans<> kmeans;
+    kmeans.Cluster(subspace, numCodewords, centroids);
+    codebooks.slice(s) = arma::conv_to<arma::Mat<ElemType>>::from(centroids);
+  }
+}
+
+template<typename SortPolicy, typename MatType>
+void PQIndex<SortPolicy, MatType>::Encode(const arma::Mat<ElemType>& rotatedSet)
+{
+  const size_t subDim = rotatedSet.n_rows / numSubspaces;
+  codes.set_size(numSubspaces, rotatedSet.n_cols);
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < rotatedSet.n_cols; ++i)
+  {
+    for (size_t s = 0; s < numSubspaces; ++s)
+    {
+      const arma::Col<ElemType> sub =
+          rotatedSet(arma::span(s * subDim, (s + 1) * subDim - 1), i);
+      const arma::Row<ElemType> sqDistances =
+          arma::sum(arma::square(codebooks.slice(s).each_col() - sub), 0);
+      codes(s, i) = (arma::u8) sqDistances.index_min();
+    }
+  }
+}
+
+template<typename SortPolicy, typename MatType>
+arma::Mat<typename MatType::elem_type> PQIndex<SortPolicy, MatType>::Decode()
+    const
+{
+  const size_t subDim = codebooks.n_rows;
+  arma::Mat<ElemType> reconstruction(subDim * numSubspaces, codes.n_cols);
+  for (size_t i = 0; i < codes.n_cols; ++i)
+    for (size_t s = 0; s < numSubspaces; ++s)
+      reconstruction(arma::span(s * subDim, (s + 1) * subDim - 1), i) =
+          codebooks.slice(s).col(codes(s, i));
+
+  return reconstruction;
+}
+
+template<typename SortPolicy, typename MatType>
+void PQIndex<SortPolicy, MatType>::Search(const MatType& querySet,
+                                          const size_t k,
+                                          arma::Mat<size_t>& neighbors,
+                                          arma::Mat<ElemType>& distances,
+                                          const size_t rerank)
+{
+  if (querySet.n_rows != referenceSet.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "PQIndex::Search(): dimensionalities of query set ("
+        << querySet.n_rows << ") and reference set (" << referenceSet.n_rows
+        << ") do not match";
+    throw std::invalid_argument(oss.str());
+  }
+
+  SearchInternal(querySet, k, neighbors, distances, rerank, false);
+}
+
+template<typename SortPolicy, typename MatType>
+void PQIndex<SortPolicy, MatType>::Search(const size_t k,
+                                          arma::Mat<size_t>& neighbors,
+                                          arma::Mat<ElemType>& distances,
+                                          const size_t rerank)
+{
+  SearchInternal(referenceSet, k, neighbors, distances, rerank, true);
+}
+
+template<typename SortPolicy, typename MatType>
+void PQIndex<SortPolicy, MatType>::SearchInternal(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::Mat<ElemType>& distances,
+    const size_t rerank,
+    const bool sameSet)
+{
+  if (codes.n_cols == 0)
+    throw std::invalid_argument("PQIndex::Search(): index has not been "
+        "trained");
+
+  const size_t maxNeighbors = referenceSet.n_cols - (sameSet ? 1 : 0);
+  if (k > maxNeighbors)
+  {
+    std::ostringstream oss;
+    oss << "PQIndex::Search(): requested value of k (" << k << ") is greater "
+        << "than the number of points in the reference set (" << maxNeighbors
+        << ")";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // By default, re-rank eight times as many candidates as we will return.
+  const size_t numCandidates = std::min(maxNeighbors,
+      std::max(k, (rerank == 0) ? 8 * k : rerank));
+
+  const size_t subDim = codebooks.n_rows;
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  typedef std::pair<ElemType, size_t> Candidate;
+  struct CandidateCmp
+  {
+    bool operator()(const Candidate& c1, const Candidate& c2)
+    {
+      return !SortPolicy::IsBetter(c2.first, c1.first);
+    }
+  };
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    // Rotate the query if a rotation was trained.
+    arma::Col<ElemType> query;
+    if (rotation.n_elem > 0)
+      query = rotation.t() * querySet.col(i);
+    else
+      query = querySet.col(i);
+
+    // Build the table of squared distances from the query to every codeword
+    // of every subspace; the approximate squared distance to a reference
+    // point is then just a sum of table lookups over its code.
+    arma::Mat<ElemType> table(numCodewords, numSubspaces);
+    for (size_t s = 0; s < numSubspaces; ++s)
+    {
+      const arma::Col<ElemType> sub =
+          query.subvec(s * subDim, (s + 1) * subDim - 1);
+      table.col(s) = arma::trans(arma::sum(
+          arma::square(codebooks.slice(s).each_col() - sub), 0));
+    }
+
+    // Scan the codes, keeping the numCandidates best approximate distances in
+    // a priority queue whose top element is the worst candidate.
+    std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp> pq(
+        CandidateCmp(), std::vector<Candidate>(numCandidates,
+        std::make_pair(SortPolicy::template WorstDistance<ElemType>(),
+        size_t() - 1)));
+    for (size_t j = 0; j < codes.n_cols; ++j)
+    {
+      if (sameSet && j == i)
+        continue;
+
+      ElemType approximate = 0;
+      for (size_t s = 0; s < numSubspaces; ++s)
+        approximate += table(codes(s, j), s);
+
+      if (SortPolicy::IsBetter(approximate, pq.top().first))
+      {
+        pq.pop();
+        pq.emplace(approximate, j);
+      }
+    }
+
+    // Re-rank the candidates by their exact distance to the original
+    // (unrotated) reference points.
+    std::vector<Candidate> candidates;
+    candidates.reserve(numCandidates);
+    while (!pq.empty())
+    {
+      const size_t index = pq.top().second;
+      pq.pop();
+      if (index == size_t() - 1)
+        continue; // Unused sentinel candidate.
+
+      candidates.emplace_back(EuclideanDistance::Evaluate(querySet.col(i),
+          referenceSet.col(index)), index);
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+        [](const Candidate& c1, const Candidate& c2)
+        { return SortPolicy::IsBetter(c1.first, c2.first); });
+
+    for (size_t j = 0; j < k; ++j)
+    {
+      distances(j, i) = candidates[j].first;
+      neighbors(j, i) = candidates[j].second;
+    }
+  }
+}
+
+template<typename SortPolicy, typename MatType>
+template<typename Archive>
+void PQIndex<SortPolicy, MatType>::serialize(Archive& ar,
+                                             const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(numSubspaces));
+  ar(CEREAL_NVP(numCodewords));
+  ar(CEREAL_NVP(opqIterations));
+  ar(CEREAL_NVP(referenceSet));
+  ar(CEREAL_NVP(rotation));
+  ar(CEREAL_NVP(codebooks));
+  ar(CEREAL_NVP(codes));
+}
+
+} // namespace mlpack
+
+#endif // MLPACK_METHODS_NEIGHBOR_SEARCH_PQ_INDEX_IMPL_HPP
@@ -0,0 +1,106 @@
+/**
+ * @file methods/neighbor_search/sharded_neighbor_search.hpp
+ *
+ * A sharded decomposition layer for nearest neighbor search: the reference
+ * set is partitioned into spatially coherent shards, each shard is searched
+ * with its own NeighborSearch object, and per-query distance bounds prune
+ * whole shards from the search.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SHARDED_NEIGHBOR_SEARCH_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SHARDED_NEIGHBOR_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * ShardedNeighborSearch partitions the reference set into a fixed number of
+ * spatially coherent shards and runs nearest neighbor search shard by shard.
+ * The shards are the leaves of a coarse kd-tree, so each shard comes with a
+ * bounding box; at query time the shards are visited in order of increasing
+ * minimum distance to the query point, and once k candidates have been found,
+ * every shard whose bounding box is farther than the current k-th best
+ * candidate is pruned without being searched.
+ *
+ * Each shard is searched with an independent NeighborSearch object and the
+ * per-shard candidate lists are merged, so the decomposition is the
+ * single-process analogue of a cross-node partitioning: each shard's search
+ * is self-contained and the merge step only needs the candidate lists and the
+ * shard bounding boxes.
+ *
+ * Only nearest neighbor search is supported (the shard pruning rule relies on
+ * the k-th best candidate being an upper bound).
+ *
+ * @tparam MetricType The metric to use for computation.
+ * @tparam TreeType The tree type to use within each shard; must adhere to the
+ *      TreeType API.
+ */
+template<typename MetricType = EuclideanDistance,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = KDTree>
+class ShardedNeighborSearch
+{
+ public:
+  //! Convenience typedef for the searcher used within each shard.
+  typedef NeighborSearch<NearestNeighborSort, MetricType, arma::mat, TreeType>
+      SearchType;
+
+  /**
+   * Construct the sharded search object, partitioning the given reference set
+   * into (at most) the given number of shards.  The partition is built from a
+   * coarse kd-tree, so the shards are axis-aligned boxes of roughly equal
+   * point count.
+   *
+   * @param referenceSet Set of reference points.
+   * @param numShards Number of shards to partition the reference set into.
+   */
+  ShardedNeighborSearch(arma::mat referenceSet, const size_t numShards);
+
+  /**
+   * Search for the k nearest neighbors of every query point, merging
+   * per-shard results and pruning shards by their bounding boxes.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *      point.
+   */
+  void Search(const arma::mat& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
+  //! Get the number of shards the reference set was partitioned into.
+  size_t NumShards() const { return searchers.size(); }
+
+  //! Get the number of shard searches skipped by bound-based pruning during
+  //! the last call to Search().
+  size_t ShardPrunes() const { return shardPrunes; }
+
+ private:
+  //! Bounding box of each shard.
+  std::vector<HRectBound<MetricType>> shardBounds;
+
+  //! Original dataset indices of the points in each shard.
+  std::vector<arma::Col<size_t>> shardIndices;
+
+  //! Per-shard search objects.
+  std::vector<SearchType> searchers;
+
+  //! Number of shard searches pruned during the last Search() call.
+  size_t shardPrunes;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "sharded_neighbor_search_impl.hpp"
+
+#endif
@@ -0,0 +1,159 @@
+/**
+ * @file methods/neighbor_search/sharded_neighbor_search_impl.hpp
+ *
+ * Implementation of ShardedNeighborSearch.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SHARDED_NEIGHBOR_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SHARDED_NEIGHBOR_SEARCH_IMPL_HPP
+
+#include "sharded_neighbor_search.hpp"
+
+namespace mlpack {
+
+template<typename MetricType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+ShardedNeighborSearch<MetricType, TreeType>::ShardedNeighborSearch(
+    arma::mat referenceSet,
+    const size_t numShards) :
+    shardPrunes(0)
+{
+  if (numShards == 0)
+    throw std::invalid_argument("ShardedNeighborSearch: numShards must be "
+        "positive!");
+  if (referenceSet.n_cols == 0)
+    throw std::invalid_argument("ShardedNeighborSearch: reference set is "
+        "empty!");
+
+  // The shards are the leaves of a coarse kd-tree whose leaf size is chosen
+  // so that (at most) numShards leaves are produced.  Each leaf holds a
+  // contiguous column range of the permuted dataset, and its bounding box is
+  // exactly the shard bound we need for query-time pruning.
+  typedef KDTree<MetricType, EmptyStatistic, arma::mat> PartitionTree;
+  const size_t leafSize = std::max((size_t) 1,
+      (referenceSet.n_cols + numShards - 1) / numShards);
+
+  std::vector<size_t> oldFromNew;
+  PartitionTree tree(std::move(referenceSet), oldFromNew, leafSize);
+
+  std::vector<PartitionTree*> toVisit;
+  toVisit.push_back(&tree);
+  while (!toVisit.empty())
+  {
+    PartitionTree* node = toVisit.back();
+    toVisit.pop_back();
+
+    if (node->IsLeaf())
+    {
+      const size_t begin = node->Begin();
+      const size_t count = node->Count();
+
+      arma::mat shardData = tree.Dataset().cols(begin, begin + count - 1);
+      arma::Col<size_t> indices(count);
+      for (size_t j = 0; j < count; ++j)
+        indices[j] = oldFromNew[begin + j];
+
+      shardBounds.push_back(node->Bound());
+      shardIndices.push_back(std::move(indices));
+      searchers.emplace_back(std::move(shardData), SINGLE_TREE_MODE);
+    }
+    else
+    {
+      for (size_t c = 0; c < node->NumChildren(); ++c)
+        toVisit.push_back(&node->Child(c));
+    }
+  }
+
+  Log::Info << "ShardedNeighborSearch: partitioned reference set into "
+      << searchers.size() << " shards." << std::endl;
+}
+
+template<typename MetricType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void ShardedNeighborSearch<MetricType, TreeType>::Search(
+    const arma::mat& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances)
+{
+  size_t totalPoints = 0;
+  for (size_t s = 0; s < shardIndices.size(); ++s)
+    totalPoints += shardIndices[s].n_elem;
+
+  if (k == 0 || k > totalPoints)
+    throw std::invalid_argument("ShardedNeighborSearch::Search(): requested "
+        "value of k is not valid for the reference set size!");
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+  shardPrunes = 0;
+
+  arma::Mat<size_t> shardNeighbors;
+  arma::mat shardDistances;
+
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    // Visit the shards in order of increasing minimum distance to the query
+    // point, so pruning kicks in as early as possible.
+    arma::vec minDistances(searchers.size());
+    for (size_t s = 0; s < searchers.size(); ++s)
+      minDistances[s] = shardBounds[s].MinDistance(querySet.col(i));
+    const arma::uvec order = arma::sort_index(minDistances);
+
+    // Merged candidate list: a max-heap whose top is the current k-th best.
+    std::priority_queue<std::pair<double, size_t>> best;
+    for (size_t o = 0; o < order.n_elem; ++o)
+    {
+      const size_t s = order[o];
+
+      // Once k candidates exist, every shard at least as far away as the
+      // current k-th best candidate cannot improve the results; since the
+      // shards are sorted by minimum distance, all remaining shards are
+      // pruned at once.
+      if (best.size() == k && minDistances[s] >= best.top().first)
+      {
+        shardPrunes += order.n_elem - o;
+        break;
+      }
+
+      const size_t shardK = std::min(k, (size_t) shardIndices[s].n_elem);
+      const arma::mat query(querySet.col(i));
+      searchers[s].Search(query, shardK, shardNeighbors, shardDistances);
+
+      for (size_t r = 0; r < shardK; ++r)
+      {
+        const double dist = shardDistances(r, 0);
+        const size_t point = shardIndices[s][shardNeighbors(r, 0)];
+        if (best.size() < k)
+        {
+          best.push(std::make_pair(dist, point));
+        }
+        else if (dist < best.top().first)
+        {
+          best.pop();
+          best.push(std::make_pair(dist, point));
+        }
+      }
+    }
+
+    // Unload the merged candidates, worst first.
+    for (size_t j = 1; j <= k; ++j)
+    {
+      neighbors(k - j, i) = best.top().second;
+      distances(k - j, i) = best.top().first;
+      best.pop();
+    }
+  }
+}
+
+} // namespace mlpack
+
+#endif
@@ -127,6 +127,12 @@ class FurthestNS
    */
   static inline double WorstDistance() { return 0; }
 
+  /**
+   * Return the worst possible distance in the given precision.
+   */
+  template<typename T>
+  static inline T WorstDistance() { return 0; }
+
   /**
    * Return what should represent the best possible distance with this
    * particular sort policy.  In our case, this should be the maximum possible
@@ -136,6 +142,14 @@ class FurthestNS
    */
   static inline double BestDistance() { return DBL_MAX; }
 
+  /**
+   * Return the best possible distance in the given precision.  This allows
+   * single-precision (or other non-double) element types to use a
+   * representable best distance instead of DBL_MAX.
+   */
+  template<typename T>
+  static inline T BestDistance() { return std::numeric_limits<T>::max(); }
+
   /**
    * Return the best combination of the two distances.
    */
@@ -131,6 +131,14 @@ class NearestNS
    */
   static inline double WorstDistance() { return DBL_MAX; }
 
+  /**
+   * Return the worst possible distance in the given precision.  This allows
+   * single-precision (or other non-double) element types to use a
+   * representable worst distance instead of DBL_MAX.
+   */
+  template<typename T>
+  static inline T WorstDistance() { return std::numeric_limits<T>::max(); }
+
   /**
    * Return what should represent the best possible distance with this
    * particular sort policy.  In our case, this should be the minimum possible
@@ -140,6 +148,12 @@ class NearestNS
    */
   static inline double BestDistance() { return 0.0; }
 
+  /**
+   * Return the best possible distance in the given precision.
+   */
+  template<typename T>
+  static inline T BestDistance() { return 0; }
+
   /**
    * Return the best combination of the two distances.
    */
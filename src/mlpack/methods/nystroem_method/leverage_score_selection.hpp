@@ -0,0 +1,87 @@
+/**
+ * @file methods/nystroem_method/leverage_score_selection.hpp
+ *
+ * Select landmark points for the Nystroem method by sampling proportionally
+ * to their statistical leverage scores, so influential points are far more
+ * likely to become landmarks than uniform sampling would make them.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NYSTROEM_METHOD_LEVERAGE_SCORE_SELECTION_HPP
+#define MLPACK_METHODS_NYSTROEM_METHOD_LEVERAGE_SCORE_SELECTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Leverage-score sampling for landmark selection.  The leverage score of a
+ * point is the squared norm of its row in the right singular vectors of the
+ * data restricted to the top components; points that carry directions no
+ * other point covers get high scores.  Sampling landmarks proportionally to
+ * these scores gives Nystroem approximations with far better error for a
+ * given number of landmarks than uniform sampling, especially on data with
+ * uneven cluster sizes or outlying structure.
+ *
+ * The selection interface only sees the input-space data, so the scores are
+ * the exact leverage scores of the data matrix (computed with one thin SVD,
+ * O(n d^2) time and O(n d) memory) rather than kernel-space leverage scores;
+ * like KMeansSelection, this uses input-space structure as a proxy for the
+ * kernel space.
+ */
+class LeverageScoreSelection
+{
+ public:
+  /**
+   * Sample the specified number of points (with replacement) proportionally
+   * to their leverage scores.
+   *
+   * @param data Dataset to sample from.
+   * @param m Number of points to select.
+   * @return Indices of selected points from the dataset.
+   */
+  const static arma::Col<size_t> Select(const arma::mat& data, const size_t m)
+  {
+    // Compute the right singular vectors of the data; the economical SVD
+    // keeps this to O(n d^2) time and O(n d) memory.
+    arma::mat u, v;
+    arma::vec s;
+    arma::svd_econ(u, s, v, data);
+
+    // Leverage scores with respect to the top components; using more
+    // components than landmarks would flatten the scores toward uniform.
+    const size_t components = std::min((size_t) v.n_cols, m);
+    arma::vec scores = arma::sum(arma::square(v.cols(0, components - 1)), 1);
+
+    const double total = arma::accu(scores);
+    if (total <= 0.0)
+    {
+      // Degenerate data (all zeros); fall back to uniform sampling.
+      arma::Col<size_t> selectedPoints(m);
+      for (size_t i = 0; i < m; ++i)
+        selectedPoints(i) = RandInt(0, data.n_cols);
+      return selectedPoints;
+    }
+
+    // Sample from the leverage-score distribution by inverting its CDF with
+    // a binary search per draw.
+    const arma::vec cdf = arma::cumsum(scores / total);
+    arma::Col<size_t> selectedPoints(m);
+    for (size_t i = 0; i < m; ++i)
+    {
+      const double r = Random();
+      const size_t index = (size_t) (std::upper_bound(cdf.begin(), cdf.end(),
+          r) - cdf.begin());
+      selectedPoints(i) = std::min(index, (size_t) cdf.n_elem - 1);
+    }
+
+    return selectedPoints;
+  }
+};
+
+} // namespace mlpack
+
+#endif
@@ -18,6 +18,7 @@
 #include <mlpack/core.hpp>
 
 #include "kmeans_selection.hpp"
+#include "leverage_score_selection.hpp"
 #include "ordered_selection.hpp"
 #include "random_selection.hpp"
 
@@ -42,12 +43,29 @@ class NystroemMethod
 
   /**
    * Apply the low-rank factorization to obtain an output matrix G such that
-   * K' = G * G^T.
+   * K' = G * G^T.  The selected landmarks and the factorization of their
+   * kernel matrix are cached, so a later call (or a downstream user of the
+   * same object) only reassembles the data-landmark kernel slab instead of
+   * repeating selection and factorization; call Reset() to discard the cache.
    *
    * @param output Matrix to store kernel approximation into.
    */
   void Apply(arma::mat& output);
 
+  /**
+   * Apply the low-rank factorization, growing the landmark set incrementally
+   * with pivoted Cholesky until the trace of the kernel matrix residual drops
+   * below tolerance * trace(K), or until `rank` landmarks have been added.
+   * Each new landmark reuses the factor columns of the previous ones, so
+   * growing the set costs one kernel column per landmark.  The point
+   * selection policy is not used; pivoting selects the landmarks.  The
+   * selected landmarks and factorization are cached as in Apply().
+   *
+   * @param output Matrix to store kernel approximation into.
+   * @param tolerance Relative trace-norm error target.
+   */
+  void Apply(arma::mat& output, const double tolerance);
+
   /**
    * Construct the kernel matrix with matrix that contains the selected points.
    *
@@ -70,13 +88,38 @@ class NystroemMethod
                        arma::mat& miniKernel,
                        arma::mat& semiKernel);
 
+  //! Get the cached landmark points (empty until Apply() has been called).
+  const arma::mat& Landmarks() const { return landmarks; }
+
+  //! Return whether a landmark factorization is cached.
+  bool Cached() const { return cached; }
+
+  //! Discard the cached landmarks and factorization, so that the next call to
+  //! Apply() selects and factorizes from scratch (e.g. after the kernel
+  //! parameters have changed).
+  void Reset();
+
  private:
+  /**
+   * Assemble the kernel matrix between all points and the cached landmarks.
+   *
+   * @param semiKernel Matrix to store the assembled kernel matrix into.
+   */
+  void AssembleSemiKernel(arma::mat& semiKernel);
+
   //! The reference dataset.
   const arma::mat& data;
   //! The locally stored kernel, if it is necessary.
   KernelType& kernel;
   //! Rank used for matrix approximation.
   const size_t rank;
+
+  //! Cached landmark points from the last factorization.
+  arma::mat landmarks;
+  //! Cached projection (m x m) such that G = semiKernel * projection.
+  arma::mat projection;
+  //! Whether landmarks and projection hold a valid factorization.
+  bool cached;
 };
 
 } // namespace mlpack
@@ -25,7 +25,8 @@ NystroemMethod<KernelType, PointSelectionPolicy>::NystroemMethod(
     const size_t rank) :
     data(data),
     kernel(kernel),
-    rank(rank)
+    rank(rank),
+    cached(false)
 { }
 
 template<typename KernelType, typename PointSelectionPolicy>
@@ -34,20 +35,29 @@ void NystroemMethod<KernelType, PointSelectionPolicy>::GetKernelMatrix(
     arma::mat& miniKernel,
     arma::mat& semiKernel)
 {
-  // Assemble mini-kernel matrix.
+  // Cache the landmark points, so that a later Apply() can reuse them.
+  landmarks = *selectedData;
+
+  // Clean the memory.
+  delete selectedData;
+
+  // Assemble mini-kernel matrix.  Each thread fills its own rows, and the
+  // kernel is symmetric, so only the upper triangle is evaluated.
+  #pragma omp parallel for schedule(dynamic)
   for (size_t i = 0; i < rank; ++i)
-    for (size_t j = 0; j < rank; ++j)
-      miniKernel(i, j) = kernel.Evaluate(selectedData->col(i),
-                                         selectedData->col(j));
+  {
+    for (size_t j = i; j < rank; ++j)
+    {
+      const double value = kernel.Evaluate(landmarks.col(i),
+                                           landmarks.col(j));
+      miniKernel(i, j) = value;
+      miniKernel(j, i) = value;
+    }
+  }
 
   // Construct semi-kernel matrix with interactions between selected data and
   // all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
-    for (size_t j = 0; j < rank; ++j)
-      semiKernel(i, j) = kernel.Evaluate(data.col(i),
-                                         selectedData->col(j));
-  // Clean the memory.
-  delete selectedData;
+  AssembleSemiKernel(semiKernel);
 }
 
 template<typename KernelType, typename PointSelectionPolicy>
@@ -56,27 +66,60 @@ void NystroemMethod<KernelType, PointSelectionPolicy>::GetKernelMatrix(
     arma::mat& miniKernel,
     arma::mat& semiKernel)
 {
-  // Assemble mini-kernel matrix.
+  // Cache the landmark points, so that a later Apply() can reuse them.
+  landmarks = data.cols(arma::conv_to<arma::uvec>::from(selectedPoints));
+
+  // Assemble mini-kernel matrix.  Each thread fills its own rows, and the
+  // kernel is symmetric, so only the upper triangle is evaluated.
+  #pragma omp parallel for schedule(dynamic)
   for (size_t i = 0; i < rank; ++i)
   {
-    for (size_t j = 0; j < rank; ++j)
+    for (size_t j = i; j < rank; ++j)
     {
-      miniKernel(i, j) = kernel.Evaluate(data.col(selectedPoints(i)),
-                                         data.col(selectedPoints(j)));
+      const double value = kernel.Evaluate(landmarks.col(i),
+                                           landmarks.col(j));
+      miniKernel(i, j) = value;
+      miniKernel(j, i) = value;
     }
   }
 
   // Construct semi-kernel matrix with interactions between selected points and
   // all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
-    for (size_t j = 0; j < rank; ++j)
-      semiKernel(i, j) = kernel.Evaluate(data.col(i),
-                                         data.col(selectedPoints(j)));
+  AssembleSemiKernel(semiKernel);
+}
+
+template<typename KernelType, typename PointSelectionPolicy>
+void NystroemMethod<KernelType, PointSelectionPolicy>::AssembleSemiKernel(
+    arma::mat& semiKernel)
+{
+  // One batched evaluation of the kernel block; KernelMatrix() picks the
+  // fastest available path for the kernel type (matrix multiplication for
+  // dot-product-based kernels, the blocked pairwise-distance engine for
+  // distance-based ones).
+  KernelMatrix(data, landmarks, kernel, semiKernel);
+}
+
+template<typename KernelType, typename PointSelectionPolicy>
+void NystroemMethod<KernelType, PointSelectionPolicy>::Reset()
+{
+  landmarks.reset();
+  projection.reset();
+  cached = false;
 }
 
 template<typename KernelType, typename PointSelectionPolicy>
 void NystroemMethod<KernelType, PointSelectionPolicy>::Apply(arma::mat& output)
 {
+  if (cached)
+  {
+    // Reuse the cached landmarks and factorization; only the kernel matrix
+    // between all points and the landmarks has to be reassembled.
+    arma::mat semiKernel;
+    AssembleSemiKernel(semiKernel);
+    output = semiKernel * projection;
+    return;
+  }
+
   arma::mat miniKernel(rank, rank);
   arma::mat semiKernel(data.n_cols, rank);
 
@@ -95,7 +138,90 @@ void NystroemMethod<KernelType, PointSelectionPolicy>::Apply(arma::mat& output)
     if (std::abs(s[i]) <= 1e-20)
       normalization(i, i) = 0.0;
 
-  output = semiKernel * U * normalization * V;
+  projection = U * normalization * V;
+  cached = true;
+
+  output = semiKernel * projection;
+}
+
+template<typename KernelType, typename PointSelectionPolicy>
+void NystroemMethod<KernelType, PointSelectionPolicy>::Apply(
+    arma::mat& output,
+    const double tolerance)
+{
+  const size_t n = data.n_cols;
+  const size_t blockSize = 256;
+
+  // Residual diagonal of the kernel matrix; its sum is the trace-norm error
+  // of the current approximation, since the residual is positive
+  // semidefinite.
+  arma::vec diagonal(n);
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < n; block += blockSize)
+  {
+    const size_t lastCol = std::min(block + blockSize, (size_t) n) - 1;
+    for (size_t i = block; i <= lastCol; ++i)
+      diagonal[i] = kernel.Evaluate(data.col(i), data.col(i));
+  }
+  const double totalTrace = arma::accu(diagonal);
+
+  arma::mat factor(n, rank);
+  arma::uvec pivots(rank);
+  arma::vec column(n);
+  size_t m = 0;
+  double residual = totalTrace;
+
+  while (m < rank && residual > tolerance * totalTrace)
+  {
+    // The residual diagonal bounds the contribution of each point, so the
+    // largest entry is the next landmark.
+    const arma::uword pivot = diagonal.index_max();
+    const double pivotValue = diagonal[pivot];
+
+    // The kernel matrix is numerically rank-deficient; no landmark can reduce
+    // the residual any further.
+    if (pivotValue <= 1e-20)
+      break;
+    pivots[m] = pivot;
+
+    // Kernel column of the pivot.
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t block = 0; block < n; block += blockSize)
+    {
+      const size_t lastCol = std::min(block + blockSize, (size_t) n) - 1;
+      for (size_t i = block; i <= lastCol; ++i)
+        column[i] = kernel.Evaluate(data.col(i), data.col(pivot));
+    }
+
+    // Subtract the contribution of the previous landmarks; their factor
+    // columns are reused, so growing the landmark set costs one kernel column
+    // per landmark.
+    if (m > 0)
+    {
+      column -= factor.head_cols(m) *
+          arma::trans(factor.row(pivot).subvec(0, m - 1));
+    }
+
+    factor.col(m) = column / std::sqrt(pivotValue);
+    diagonal -= arma::square(factor.col(m));
+    // Clamp small negative values caused by floating point error.
+    diagonal.transform([](double value) { return std::max(value, 0.0); });
+    residual = arma::accu(diagonal);
+    ++m;
+  }
+
+  output = factor.head_cols(m);
+
+  if (m > 0)
+  {
+    // Cache the factorization in the same form as Apply(): the rows of the
+    // factor at the pivot indices are the (lower triangular) Cholesky factor
+    // of the landmark kernel matrix, so G = semiKernel * projection.
+    landmarks = data.cols(pivots.head(m));
+    const arma::mat miniFactor = output.rows(pivots.head(m));
+    projection = arma::trans(arma::inv(arma::trimatl(miniFactor)));
+    cached = true;
+  }
 }
 
 } // namespace mlpack
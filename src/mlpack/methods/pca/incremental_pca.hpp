@@ -0,0 +1,141 @@
+/**
+ * @file methods/pca/incremental_pca.hpp
+ *
+ * Defines the IncrementalPCA class, which maintains an exactly mergeable
+ * covariance sketch of a dataset that arrives in shards, so principal
+ * components can be extracted without ever materializing the full data
+ * matrix.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PCA_INCREMENTAL_PCA_HPP
+#define MLPACK_METHODS_PCA_INCREMENTAL_PCA_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+
+/**
+ * This class implements principal components analysis over data that arrives
+ * in shards.  Instead of the data itself, only a sketch of fixed size is
+ * kept: the point count, the running mean, and the centered scatter matrix
+ * (d x d for d dimensions).  The sketch is updated exactly for each shard
+ * with the pairwise update formulas of Chan et al., so memory stays bounded
+ * no matter how many shards are seen, and sketches built independently (for
+ * example on parallel workers, each over its own shards) can be merged with
+ * Merge() to yield exactly the sketch of the union of their data.
+ *
+ * After any number of Update() and Merge() calls, Apply() produces the same
+ * principal components (eigenvalues and loadings of the sample covariance)
+ * as PCA<ExactSVDPolicy> over the concatenation of all shards, up to
+ * numerical roundoff.  Scaling by per-dimension standard deviation (the
+ * scaleData option of PCA) is not supported, since the final scale is not
+ * known while shards stream in.
+ *
+ * An example of use:
+ *
+ * @code
+ * IncrementalPCA workerA, workerB;
+ *
+ * arma::mat shard;
+ * while (PopShardA(shard))
+ *   workerA.Update(shard);
+ * while (PopShardB(shard))
+ *   workerB.Update(shard);
+ *
+ * // Combine the workers' sketches and extract the components.
+ * workerA.Merge(workerB);
+ *
+ * arma::vec eigVal;
+ * arma::mat eigvec;
+ * workerA.Apply(eigVal, eigvec);
+ * @endcode
+ */
+class IncrementalPCA
+{
+ public:
+  /**
+   * Create an empty sketch.  The dimensionality is fixed by the first
+   * Update() or Merge() call.
+   */
+  IncrementalPCA();
+
+  /**
+   * Fold one shard of data into the sketch.  Each column of the shard is one
+   * point.  The dimensionality of the shard must match any data already
+   * seen.
+   *
+   * @param data Shard of data to add to the sketch.
+   */
+  void Update(const arma::mat& data);
+
+  /**
+   * Merge another sketch into this one, so that this sketch becomes exactly
+   * the sketch of the union of both datasets.  The other sketch is left
+   * unchanged.  Merging an empty sketch is a no-op.
+   *
+   * @param other Sketch to merge into this one.
+   */
+  void Merge(const IncrementalPCA& other);
+
+  /**
+   * Extract the principal components of all data seen so far: the
+   * eigenvalues of the sample covariance in descending order, and the
+   * corresponding loadings (one component per column).  At least two points
+   * must have been seen.
+   *
+   * @param eigVal Vector to put eigenvalues into.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   */
+  void Apply(arma::vec& eigVal, arma::mat& eigvec) const;
+
+  /**
+   * Project the given data onto the first newDimension principal components
+   * of all data seen so far, centering it with the sketch mean.  The return
+   * value is the amount of variance retained, between 0 and 1.
+   *
+   * @param data Data to transform; each column is one point.
+   * @param transformedData Matrix to put the projected data into.
+   * @param newDimension Number of principal components to keep.
+   * @return Amount of the variance of the data retained (between 0 and 1).
+   */
+  double Transform(const arma::mat& data,
+                   arma::mat& transformedData,
+                   const size_t newDimension) const;
+
+  //! Get the number of points folded into the sketch.
+  double Count() const { return count; }
+
+  //! Get the mean of the points folded into the sketch.
+  const arma::vec& Mean() const { return mean; }
+
+  //! Get the centered scatter matrix of the points folded into the sketch.
+  const arma::mat& Scatter() const { return scatter; }
+
+  /**
+   * Serialize the sketch.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Number of points seen so far.
+  double count;
+
+  //! Running mean of the points seen so far.
+  arma::vec mean;
+
+  //! Centered scatter matrix of the points seen so far; dividing by
+  //! (count - 1) gives the sample covariance.
+  arma::mat scatter;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "incremental_pca_impl.hpp"
+
+#endif
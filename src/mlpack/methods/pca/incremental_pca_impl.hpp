@@ -0,0 +1,147 @@
+/**
+ * @file methods/pca/incremental_pca_impl.hpp
+ *
+ * Implementation of the IncrementalPCA class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PCA_INCREMENTAL_PCA_IMPL_HPP
+#define MLPACK_METHODS_PCA_INCREMENTAL_PCA_IMPL_HPP
+
+#include "incremental_pca.hpp"
+
+namespace mlpack {
+
+inline IncrementalPCA::IncrementalPCA() : count(0.0)
+{ /* Nothing to do. */ }
+
+inline void IncrementalPCA::Update(const arma::mat& data)
+{
+  if (data.n_cols == 0)
+    return;
+
+  if (count > 0 && data.n_rows != mean.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "IncrementalPCA::Update(): shard dimensionality (" << data.n_rows
+        << ") does not match the dimensionality of earlier data ("
+        << mean.n_elem << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Build the sketch of the shard alone, then combine it with the running
+  // sketch using the same pairwise formulas as Merge().
+  const double shardCount = data.n_cols;
+  const arma::vec shardMean = arma::mean(data, 1);
+  const arma::mat centered = data.each_col() - shardMean;
+  const arma::mat shardScatter = centered * centered.t();
+
+  if (count == 0)
+  {
+    count = shardCount;
+    mean = shardMean;
+    scatter = shardScatter;
+    return;
+  }
+
+  // Pairwise update (Chan et al.): the cross term corrects the scatter for
+  // the two sketches having different means.
+  const arma::vec delta = shardMean - mean;
+  const double total = count + shardCount;
+  scatter += shardScatter +
+      (count * shardCount / total) * (delta * delta.t());
+  mean += (shardCount / total) * delta;
+  count = total;
+}
+
+inline void IncrementalPCA::Merge(const IncrementalPCA& other)
+{
+  if (other.count == 0)
+    return;
+
+  if (count > 0 && other.mean.n_elem != mean.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "IncrementalPCA::Merge(): sketch dimensionality ("
+        << other.mean.n_elem << ") does not match the dimensionality of "
+        << "earlier data (" << mean.n_elem << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (count == 0)
+  {
+    count = other.count;
+    mean = other.mean;
+    scatter = other.scatter;
+    return;
+  }
+
+  const arma::vec delta = other.mean - mean;
+  const double total = count + other.count;
+  scatter += other.scatter +
+      (count * other.count / total) * (delta * delta.t());
+  mean += (other.count / total) * delta;
+  count = total;
+}
+
+inline void IncrementalPCA::Apply(arma::vec& eigVal, arma::mat& eigvec) const
+{
+  if (count < 2)
+  {
+    throw std::invalid_argument("IncrementalPCA::Apply(): at least two "
+        "points must be seen before extracting components!");
+  }
+
+  // Eigendecompose the sample covariance; eig_sym() returns ascending
+  // eigenvalues, so reverse to the descending order PCA uses.
+  if (!arma::eig_sym(eigVal, eigvec, arma::symmatu(scatter / (count - 1))))
+  {
+    Log::Fatal << "IncrementalPCA::Apply(): Eigendecomposition of covariance "
+               << "failed!" << std::endl;
+  }
+
+  eigVal = arma::reverse(eigVal);
+  eigvec = arma::fliplr(eigvec);
+}
+
+inline double IncrementalPCA::Transform(const arma::mat& data,
+                                        arma::mat& transformedData,
+                                        const size_t newDimension) const
+{
+  if (newDimension == 0)
+  {
+    Log::Fatal << "IncrementalPCA::Transform(): newDimension (0) cannot be "
+        << "zero!" << std::endl;
+  }
+  if (newDimension > mean.n_elem)
+  {
+    Log::Fatal << "IncrementalPCA::Transform(): newDimension ("
+        << newDimension << ") cannot be greater than the dimensionality of "
+        << "the sketched data (" << mean.n_elem << ")!" << std::endl;
+  }
+
+  arma::vec eigVal;
+  arma::mat eigvec;
+  Apply(eigVal, eigvec);
+
+  transformedData = eigvec.cols(0, newDimension - 1).t() *
+      (data.each_col() - mean);
+
+  // Calculate the total amount of variance retained.
+  return sum(eigVal.subvec(0, newDimension - 1)) / sum(eigVal);
+}
+
+template<typename Archive>
+void IncrementalPCA::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(count));
+  ar(CEREAL_NVP(mean));
+  ar(CEREAL_NVP(scatter));
+}
+
+} // namespace mlpack
+
+#endif
@@ -127,6 +127,34 @@ class Perceptron
              const size_t numClasses,
              const arma::rowvec& instanceWeights = arma::rowvec());
 
+  /**
+   * Train an averaged perceptron on the given data with blocked passes.  The
+   * scores of a whole block of points are computed with a single matrix
+   * product, and the updates of the block's misclassified points are then
+   * applied as a group; points later in a block are thus scored with the
+   * weights from the start of the block, which changes the update order
+   * slightly compared to Train() but is far faster.  After training, the
+   * model weights are set to the average of the weights over all steps
+   * (maintained lazily, so updates stay cheap), which is typically much more
+   * accurate than the final weights when the data is not separable.
+   *
+   * This method always uses the standard (Rosenblatt) update rule,
+   * regardless of the LearnPolicy of the class.  Unlike Train(), all
+   * MaxIterations() passes are always performed---the average keeps
+   * improving even after the current weights stop changing---and the model
+   * weights are not reset, so sequential calls are possible.
+   *
+   * @param data Dataset on which training should be performed.
+   * @param labels Labels of the dataset.
+   * @param numClasses Number of classes in the data.
+   * @param instanceWeights Cost matrix. Stores the cost of mispredicting
+   *      instances.  This is useful for boosting.
+   */
+  void TrainAveraged(const MatType& data,
+                     const arma::Row<size_t>& labels,
+                     const size_t numClasses,
+                     const arma::rowvec& instanceWeights = arma::rowvec());
+
   /**
    * Classification function. After training, use the weights matrix to
    * classify test, and put the predicted classes in predictedLabels.
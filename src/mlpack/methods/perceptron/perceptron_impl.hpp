@@ -218,6 +218,97 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Train(
   }
 }
 
+/**
+ * Averaged training function with blocked passes.  The scores of each block
+ * of points are computed with one matrix product, the updates of the block's
+ * misclassified points are applied as a group, and the average of the
+ * weights over all steps is maintained lazily and installed at the end.
+ *
+ * @param data Data to train on.
+ * @param labels Labels of data.
+ * @param instanceWeights Cost matrix. Stores the cost of mispredicting
+ *      instances.  This is useful for boosting.
+ */
+template<
+    typename LearnPolicy,
+    typename WeightInitializationPolicy,
+    typename MatType
+>
+void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::
+TrainAveraged(const MatType& data,
+              const arma::Row<size_t>& labels,
+              const size_t numClasses,
+              const arma::rowvec& instanceWeights)
+{
+  // Do we need to resize the weights?
+  if (weights.n_elem != numClasses)
+  {
+    WeightInitializationPolicy wip;
+    wip.Initialize(weights, biases, data.n_rows, numClasses);
+  }
+
+  const bool hasWeights = (instanceWeights.n_elem > 0);
+
+  // The average of the weights over all steps is maintained lazily: an
+  // update delta applied at step c contributes c * delta to these
+  // accumulators, and at the end the average is weights - accumulator / c.
+  // This way points that are classified correctly cost nothing.
+  arma::mat cumulativeWeights(arma::size(weights), arma::fill::zeros);
+  arma::vec cumulativeBiases(arma::size(biases), arma::fill::zeros);
+
+  size_t step = 0;
+  const size_t blockSize = 256;
+
+  // Unlike Train(), there is no early exit when a pass makes no mistakes:
+  // the averaged weights keep improving as more converged steps enter the
+  // average, so we always run the full number of passes.
+  arma::mat scores;
+  for (size_t i = 0; i < maxIterations; ++i)
+  {
+    for (size_t block = 0; block < data.n_cols; block += blockSize)
+    {
+      const size_t lastCol = std::min(block + blockSize,
+          (size_t) data.n_cols) - 1;
+
+      // One matrix product scores the whole block.
+      scores = weights.t() * data.cols(block, lastCol);
+      scores.each_col() += biases;
+
+      // Apply the updates of the block's misclassified points as a group.
+      for (size_t j = block; j <= lastCol; ++j)
+      {
+        ++step;
+
+        const arma::uword predicted = scores.col(j - block).index_max();
+        const size_t correct = labels(j);
+        if (predicted == correct)
+          continue;
+
+        const double instanceWeight = hasWeights ? instanceWeights(j) : 1.0;
+
+        weights.col(correct) += instanceWeight * data.col(j);
+        weights.col(predicted) -= instanceWeight * data.col(j);
+        biases(correct) += instanceWeight;
+        biases(predicted) -= instanceWeight;
+
+        cumulativeWeights.col(correct) +=
+            (step * instanceWeight) * data.col(j);
+        cumulativeWeights.col(predicted) -=
+            (step * instanceWeight) * data.col(j);
+        cumulativeBiases(correct) += step * instanceWeight;
+        cumulativeBiases(predicted) -= step * instanceWeight;
+      }
+    }
+  }
+
+  // Install the averaged weights.
+  if (step > 0)
+  {
+    weights -= cumulativeWeights / step;
+    biases -= cumulativeBiases / step;
+  }
+}
+
 //! Serialize the perceptron.
 template<typename LearnPolicy,
          typename WeightInitializationPolicy,
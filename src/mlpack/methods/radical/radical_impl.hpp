@@ -70,22 +70,26 @@ inline double Radical::DoRadical2D(const arma::mat& matX,
   CopyAndPerturb(perturbed, matX);
   timers.Stop("radical_copy_and_perturb");
 
-  arma::mat::fixed<2, 2> matJacobi;
-
   arma::vec values(angles);
 
+  // The candidate angles are independent of each other, so they are
+  // evaluated in parallel; each iteration rotates the shared perturbed
+  // projection into its own candidate matrix and sorts its own copies for
+  // the entropy estimates.
+  #pragma omp parallel for schedule(dynamic)
   for (size_t i = 0; i < angles; ++i)
   {
     const double theta = (i / (double) angles) * M_PI / 2.0;
     const double cosTheta = cos(theta);
     const double sinTheta = sin(theta);
 
+    arma::mat::fixed<2, 2> matJacobi;
     matJacobi(0, 0) = cosTheta;
     matJacobi(1, 0) = -sinTheta;
     matJacobi(0, 1) = sinTheta;
     matJacobi(1, 1) = cosTheta;
 
-    candidate = perturbed * matJacobi;
+    arma::mat candidate = perturbed * matJacobi;
     arma::vec candidateY1 = candidate.unsafe_col(0);
     arma::vec candidateY2 = candidate.unsafe_col(1);
 
@@ -137,8 +141,6 @@ inline void Radical::DoRadical(const arma::mat& matXT,
 
   arma::mat matYSubspace(nPoints, 2);
 
-  arma::mat matJ = arma::eye(nDims, nDims);
-
   for (size_t sweepNum = 0; sweepNum < sweeps; sweepNum++)
   {
     Log::Info << "RADICAL: sweep " << sweepNum << "." << std::endl;
@@ -158,19 +160,13 @@ inline void Radical::DoRadical(const arma::mat& matXT,
         const double cosThetaOpt = cos(thetaOpt);
         const double sinThetaOpt = sin(thetaOpt);
 
-        // Set elements of transformation matrix.
-        matJ(i, i) = cosThetaOpt;
-        matJ(j, i) = -sinThetaOpt;
-        matJ(i, j) = sinThetaOpt;
-        matJ(j, j) = cosThetaOpt;
-
-        matY *= matJ;
-
-        // Unset elements of transformation matrix, so matJ = eye() again.
-        matJ(i, i) = 1;
-        matJ(j, i) = 0;
-        matJ(i, j) = 0;
-        matJ(j, j) = 1;
+        // The Jacobi rotation only touches columns i and j of matY, so only
+        // those two columns are updated instead of multiplying by a full
+        // rotation matrix.
+        const arma::vec matYi = matY.col(i);
+        const arma::vec matYj = matY.col(j);
+        matY.col(i) = cosThetaOpt * matYi - sinThetaOpt * matYj;
+        matY.col(j) = sinThetaOpt * matYi + cosThetaOpt * matYj;
       }
     }
   }
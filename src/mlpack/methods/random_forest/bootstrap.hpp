@@ -43,6 +43,26 @@ void Bootstrap(const MatType& dataset,
     bootstrapWeights = weights.cols(indices);
 }
 
+/**
+ * Draw a bootstrap sample of `numPoints` points with replacement, but instead
+ * of materializing the sampled dataset, return the number of times each point
+ * was drawn.  Training on the original dataset with these counts as instance
+ * weights is equivalent to training on the materialized bootstrap sample, and
+ * avoids a full copy of the dataset for every tree.  Points with a count of
+ * zero form the out-of-bag set for the sample.
+ */
+inline void BootstrapSampleCounts(const size_t numPoints,
+                                  arma::rowvec& sampleCounts)
+{
+  sampleCounts.zeros(numPoints);
+
+  // Random sampling with replacement.
+  arma::uvec indices = arma::randi<arma::uvec>(numPoints,
+      arma::distr_param(0, numPoints - 1));
+  for (size_t i = 0; i < numPoints; ++i)
+    sampleCounts[indices[i]] += 1.0;
+}
+
 } // namespace mlpack
 
 #endif
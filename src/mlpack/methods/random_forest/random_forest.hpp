@@ -351,6 +351,46 @@ class RandomForest
                 arma::Row<size_t>& predictions,
                 arma::mat& probabilities) const;
 
+  /**
+   * Predict the `k` most likely classes of each point in the given dataset,
+   * in decreasing order of probability.  This avoids materializing the full
+   * class probability matrix, which is useful when the number of classes is
+   * large.  If the random forest has not been trained, this will throw an
+   * exception.
+   *
+   * @param data Dataset to be classified.
+   * @param k Number of classes to return for each point; must be no more
+   *     than the number of classes the forest was trained on.
+   * @param classes Output matrix of the top `k` classes for each point
+   *     (k x data.n_cols).
+   */
+  template<typename MatType>
+  void ClassifyTopK(const MatType& data,
+                    const size_t k,
+                    arma::Mat<size_t>& classes) const;
+
+  /**
+   * Predict the `k` most likely classes of each point in the given dataset,
+   * in decreasing order of probability, also returning the predicted
+   * probability of each of those classes.  This avoids materializing the
+   * full class probability matrix, which is useful when the number of
+   * classes is large.  If the random forest has not been trained, this will
+   * throw an exception.
+   *
+   * @param data Dataset to be classified.
+   * @param k Number of classes to return for each point; must be no more
+   *     than the number of classes the forest was trained on.
+   * @param classes Output matrix of the top `k` classes for each point
+   *     (k x data.n_cols).
+   * @param classProbabilities Output matrix of the probabilities of those
+   *     classes (k x data.n_cols).
+   */
+  template<typename MatType>
+  void ClassifyTopK(const MatType& data,
+                    const size_t k,
+                    arma::Mat<size_t>& classes,
+                    arma::mat& classProbabilities) const;
+
   //! Access a tree in the forest.
   const DecisionTreeType& Tree(const size_t i) const { return trees[i]; }
   //! Modify a tree in the forest (be careful!).
@@ -359,6 +399,16 @@ class RandomForest
   //! Get the number of trees in the forest.
   size_t NumTrees() const { return trees.size(); }
 
+  /**
+   * Get the out-of-bag (OOB) classification error of the forest, computed
+   * during the last call to Train().  For each point, only the trees whose
+   * bootstrap sample did not contain that point vote on its class; the OOB
+   * error is the fraction of points misclassified by that vote.  This is only
+   * computed when bootstrapping is enabled (i.e. `UseBootstrap` is `true`);
+   * otherwise it will be 0.
+   */
+  double OOBError() const { return oobError; }
+
   /**
    * Serialize the random forest.
    */
@@ -406,6 +456,9 @@ class RandomForest
 
   //! The average gain of the forest.
   double avgGain;
+
+  //! The out-of-bag error from the last call to Train().
+  double oobError;
 };
 
 /**
@@ -31,7 +31,8 @@ RandomForest<
     CategoricalSplitType,
     UseBootstrap
 >::RandomForest() :
-    avgGain(0.0)
+    avgGain(0.0),
+    oobError(0.0)
 {
   // Nothing to do here.
 }
@@ -58,7 +59,8 @@ RandomForest<
                 const double minimumGainSplit,
                 const size_t maximumDepth,
                 DimensionSelectionType dimensionSelector) :
-    avgGain(0.0)
+    avgGain(0.0),
+    oobError(0.0)
 {
   // Pass off work to the Train() method.
   data::DatasetInfo info; // Ignored.
@@ -91,7 +93,8 @@ RandomForest<
                 const double minimumGainSplit,
                 const size_t maximumDepth,
                 DimensionSelectionType dimensionSelector):
-                    avgGain(0.0)
+                    avgGain(0.0),
+    oobError(0.0)
 {
   // Pass off work to the Train() method.
   arma::rowvec weights; // Fake weights, not used.
@@ -123,7 +126,8 @@ RandomForest<
                 const double minimumGainSplit,
                 const size_t maximumDepth,
                 DimensionSelectionType dimensionSelector) :
-    avgGain(0.0)
+    avgGain(0.0),
+    oobError(0.0)
 {
   // Pass off work to the Train() method.
   data::DatasetInfo info; // Ignored by Train().
@@ -156,7 +160,8 @@ RandomForest<
                 const double minimumGainSplit,
                 const size_t maximumDepth,
                 DimensionSelectionType dimensionSelector) :
-    avgGain(0.0)
+    avgGain(0.0),
+    oobError(0.0)
 {
   // Pass off work to the Train() method.
   Train<true, true>(dataset, datasetInfo, labels, numClasses, weights,
@@ -391,10 +396,29 @@ void RandomForest<
 
   predictions.set_size(data.n_cols);
 
-  #pragma omp parallel for
-  for (size_t i = 0; i < data.n_cols; ++i)
+  // Process the points in cache-sized blocks: all trees are run over one
+  // block before moving to the next, so the block stays resident in cache
+  // and each tree's votes land in a small contiguous count matrix.
+  const size_t blockSize = 256;
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < data.n_cols; block += blockSize)
   {
-    predictions[i] = Classify(data.col(i));
+    const size_t lastCol =
+        std::min(block + blockSize, (size_t) data.n_cols) - 1;
+
+    arma::mat blockProbs(trees[0].NumClasses(), lastCol - block + 1,
+        arma::fill::zeros);
+    arma::mat treeProbs;
+    arma::Row<size_t> treePredictions; // Ignored.
+    for (size_t i = 0; i < trees.size(); ++i)
+    {
+      trees[i].Classify(data.cols(block, lastCol), treePredictions,
+          treeProbs);
+      blockProbs += treeProbs;
+    }
+
+    for (size_t j = 0; j < blockProbs.n_cols; ++j)
+      predictions[block + j] = (size_t) blockProbs.col(j).index_max();
   }
 }
 
@@ -428,11 +452,137 @@ void RandomForest<
 
   probabilities.set_size(trees[0].NumClasses(), data.n_cols);
   predictions.set_size(data.n_cols);
-  #pragma omp parallel for
-  for (size_t i = 0; i < data.n_cols; ++i)
+
+  // Blocked inference; see the comments in the overload above.
+  const size_t blockSize = 256;
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < data.n_cols; block += blockSize)
   {
-    arma::vec probs = probabilities.unsafe_col(i);
-    Classify(data.col(i), predictions[i], probs);
+    const size_t lastCol =
+        std::min(block + blockSize, (size_t) data.n_cols) - 1;
+
+    arma::mat blockProbs(trees[0].NumClasses(), lastCol - block + 1,
+        arma::fill::zeros);
+    arma::mat treeProbs;
+    arma::Row<size_t> treePredictions; // Ignored.
+    for (size_t i = 0; i < trees.size(); ++i)
+    {
+      trees[i].Classify(data.cols(block, lastCol), treePredictions,
+          treeProbs);
+      blockProbs += treeProbs;
+    }
+
+    blockProbs /= trees.size();
+    probabilities.cols(block, lastCol) = blockProbs;
+    for (size_t j = 0; j < blockProbs.n_cols; ++j)
+      predictions[block + j] = (size_t) blockProbs.col(j).index_max();
+  }
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+template<typename MatType>
+void RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::ClassifyTopK(const MatType& data,
+                const size_t k,
+                arma::Mat<size_t>& classes) const
+{
+  arma::mat classProbabilities;
+  ClassifyTopK(data, k, classes, classProbabilities);
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+template<typename MatType>
+void RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::ClassifyTopK(const MatType& data,
+                const size_t k,
+                arma::Mat<size_t>& classes,
+                arma::mat& classProbabilities) const
+{
+  // Check edge cases.
+  if (trees.size() == 0)
+  {
+    classes.clear();
+    classProbabilities.clear();
+
+    throw std::invalid_argument("RandomForest::ClassifyTopK(): no random "
+        "forest trained!");
+  }
+
+  const size_t numClasses = trees[0].NumClasses();
+  if (k == 0 || k > numClasses)
+  {
+    std::ostringstream oss;
+    oss << "RandomForest::ClassifyTopK(): k (" << k << ") must be between 1 "
+        << "and the number of classes (" << numClasses << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  classes.set_size(k, data.n_cols);
+  classProbabilities.set_size(k, data.n_cols);
+
+  // Blocked inference; see the comments in Classify().  Only the k largest
+  // entries of each point's vote column are extracted, so the full
+  // probability matrix is never materialized.
+  const size_t blockSize = 256;
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < data.n_cols; block += blockSize)
+  {
+    const size_t lastCol =
+        std::min(block + blockSize, (size_t) data.n_cols) - 1;
+
+    arma::mat blockProbs(numClasses, lastCol - block + 1, arma::fill::zeros);
+    arma::mat treeProbs;
+    arma::Row<size_t> treePredictions; // Ignored.
+    for (size_t i = 0; i < trees.size(); ++i)
+    {
+      trees[i].Classify(data.cols(block, lastCol), treePredictions,
+          treeProbs);
+      blockProbs += treeProbs;
+    }
+
+    std::vector<size_t> order(numClasses);
+    for (size_t j = 0; j < blockProbs.n_cols; ++j)
+    {
+      const double* votes = blockProbs.colptr(j);
+      for (size_t c = 0; c < numClasses; ++c)
+        order[c] = c;
+
+      // Partially sort the class indices by decreasing vote count; ties go
+      // to the lower class index, matching index_max() in Classify().
+      std::partial_sort(order.begin(), order.begin() + k, order.end(),
+          [votes](const size_t a, const size_t b)
+          {
+            return (votes[a] > votes[b]) || (votes[a] == votes[b] && a < b);
+          });
+
+      for (size_t c = 0; c < k; ++c)
+      {
+        classes(c, block + j) = order[c];
+        classProbabilities(c, block + j) = votes[order[c]] / trees.size();
+      }
+    }
   }
 }
 
@@ -466,6 +616,7 @@ void RandomForest<
 
   ar(CEREAL_NVP(trees));
   ar(CEREAL_NVP(avgGain));
+  ar(CEREAL_NVP(oobError));
 }
 
 template<
@@ -503,67 +654,105 @@ double RandomForest<
   // Convert avgGain to total gain.
   double totalGain = avgGain * oldNumTrees;
 
+  // Out-of-bag votes: for each point, the number of votes for each class from
+  // trees whose bootstrap sample did not contain that point.
+  arma::Mat<size_t> oobVotes;
+  if (UseBootstrap)
+    oobVotes.zeros(numClasses, dataset.n_cols);
+
   // Train each tree individually.
   #pragma omp parallel for reduction( + : totalGain)
   for (size_t i = 0; i < numTrees; ++i)
   {
-    MatType bootstrapDataset;
-    arma::Row<size_t> bootstrapLabels;
-    arma::rowvec bootstrapWeights;
     if (UseBootstrap)
     {
-      Bootstrap<UseWeights>(dataset, labels, weights, bootstrapDataset,
-          bootstrapLabels, bootstrapWeights);
-    }
+      // Instead of materializing a bootstrap copy of the dataset, draw the
+      // number of times each point appears in the sample and train on the
+      // original dataset with those counts as instance weights.  This is
+      // equivalent to training on the bootstrap sample, but avoids a full
+      // copy of the dataset for every tree.
+      arma::rowvec sampleCounts;
+      BootstrapSampleCounts(dataset.n_cols, sampleCounts);
+      const arma::rowvec bootstrapWeights = UseWeights ?
+          arma::rowvec(sampleCounts % weights) : sampleCounts;
+
+      if (UseDatasetInfo)
+      {
+        totalGain += trees[oldNumTrees + i].Train(dataset, datasetInfo, labels,
+            numClasses, bootstrapWeights, minimumLeafSize, minimumGainSplit,
+            maximumDepth, dimensionSelector);
+      }
+      else
+      {
+        totalGain += trees[oldNumTrees + i].Train(dataset, labels, numClasses,
+            bootstrapWeights, minimumLeafSize, minimumGainSplit, maximumDepth,
+            dimensionSelector);
+      }
 
-    if (UseWeights)
+      // The points this tree never saw form its out-of-bag set; collect their
+      // votes so that we can compute the OOB error afterwards.
+      for (size_t j = 0; j < dataset.n_cols; ++j)
+      {
+        if (sampleCounts[j] == 0.0)
+        {
+          const size_t treePrediction =
+              trees[oldNumTrees + i].Classify(dataset.col(j));
+          #pragma omp atomic
+          ++oobVotes(treePrediction, j);
+        }
+      }
+    }
+    else if (UseWeights)
     {
       if (UseDatasetInfo)
       {
-        totalGain += UseBootstrap ?
-            trees[oldNumTrees + i].Train(bootstrapDataset, datasetInfo,
-                bootstrapLabels, numClasses, bootstrapWeights, minimumLeafSize,
-                minimumGainSplit, maximumDepth, dimensionSelector) :
-            trees[oldNumTrees + i].Train(dataset, datasetInfo, labels,
-                numClasses, weights, minimumLeafSize, minimumGainSplit,
-                maximumDepth, dimensionSelector);
+        totalGain += trees[oldNumTrees + i].Train(dataset, datasetInfo, labels,
+            numClasses, weights, minimumLeafSize, minimumGainSplit,
+            maximumDepth, dimensionSelector);
       }
       else
       {
-        totalGain += UseBootstrap ?
-            trees[oldNumTrees + i].Train(bootstrapDataset, bootstrapLabels,
-                numClasses, bootstrapWeights, minimumLeafSize,
-                minimumGainSplit, maximumDepth, dimensionSelector) :
-            trees[oldNumTrees + i].Train(dataset, labels, numClasses,
-                weights, minimumLeafSize, minimumGainSplit, maximumDepth,
-                dimensionSelector);
+        totalGain += trees[oldNumTrees + i].Train(dataset, labels, numClasses,
+            weights, minimumLeafSize, minimumGainSplit, maximumDepth,
+            dimensionSelector);
       }
     }
     else
     {
       if (UseDatasetInfo)
       {
-        totalGain += UseBootstrap ?
-            trees[oldNumTrees + i].Train(bootstrapDataset, datasetInfo,
-                bootstrapLabels, numClasses, minimumLeafSize, minimumGainSplit,
-                maximumDepth, dimensionSelector) :
-            trees[oldNumTrees + i].Train(dataset, datasetInfo, labels,
-                numClasses, minimumLeafSize, minimumGainSplit, maximumDepth,
-                dimensionSelector);
+        totalGain += trees[oldNumTrees + i].Train(dataset, datasetInfo, labels,
+            numClasses, minimumLeafSize, minimumGainSplit, maximumDepth,
+            dimensionSelector);
       }
       else
       {
-        totalGain += UseBootstrap ?
-            trees[oldNumTrees + i].Train(bootstrapDataset, bootstrapLabels,
-                numClasses, minimumLeafSize, minimumGainSplit, maximumDepth,
-                dimensionSelector) :
-            trees[oldNumTrees + i].Train(dataset, labels, numClasses,
-                minimumLeafSize, minimumGainSplit, maximumDepth,
-                dimensionSelector);
+        totalGain += trees[oldNumTrees + i].Train(dataset, labels, numClasses,
+            minimumLeafSize, minimumGainSplit, maximumDepth,
+            dimensionSelector);
       }
     }
   }
 
+  // Compute the out-of-bag error from the collected votes.  Points that were
+  // in every tree's bootstrap sample have no votes and are skipped.
+  if (UseBootstrap)
+  {
+    size_t numVoted = 0;
+    size_t numWrong = 0;
+    for (size_t j = 0; j < dataset.n_cols; ++j)
+    {
+      if (arma::accu(oobVotes.col(j)) == 0)
+        continue;
+
+      ++numVoted;
+      if ((size_t) oobVotes.col(j).index_max() != labels[j])
+        ++numWrong;
+    }
+
+    oobError = (numVoted > 0) ? (double) numWrong / (double) numVoted : 0.0;
+  }
+
   avgGain = totalGain / trees.size();
   return avgGain;
 }
@@ -154,6 +154,36 @@ class RandomizedSVD
              const size_t rank,
              MatType rowMean);
 
+  /**
+   * Apply Principal Component Analysis to the provided matrix data set using
+   * the randomized SVD, reading the data strictly in sequential column
+   * blocks.  Every pass over the data---the centering pass, the range finder,
+   * each power iteration, and the final projection---is a single in-order
+   * sweep over blocks of blockSize columns, and no temporary larger than one
+   * block (or iteratedPower columns of the smaller dimension) is created.
+   *
+   * This makes the method usable on matrices far larger than RAM: wrap a
+   * memory-mapped file in an arma::mat using the advanced constructor
+   * (arma::mat(ptr, rows, cols, false, true)) and the sequential block reads
+   * let the operating system stream pages in and drop them behind the sweep,
+   * instead of thrashing on random access.  The results match Apply() up to
+   * the randomness of the range finder.
+   *
+   * @param data Data matrix; only read one column block at a time.
+   * @param u First unitary matrix.
+   * @param v Second unitary matrix.
+   * @param s Diagonal "Sigma" matrix of singular values.
+   * @param rank Rank of the approximation.
+   * @param blockSize Number of columns read per block (Default: 4096).
+   */
+  template<typename MatType>
+  void ApplyStreaming(const MatType& data,
+                      arma::mat& u,
+                      arma::vec& s,
+                      arma::mat& v,
+                      const size_t rank,
+                      const size_t blockSize = 4096);
+
   //! Get the size of the normalized power iterations.
   size_t IteratedPower() const { return iteratedPower; }
   //! Modify the size of the normalized power iterations.
@@ -169,6 +199,16 @@ class RandomizedSVD
   //! Modify the value used for decomposition stability.
   double& Epsilon() { return eps; }
 
+  //! Get the basis used to seed the range finder.
+  const arma::mat& InitialBasis() const { return initialBasis; }
+  //! Modify the basis used to seed the range finder.  When set to a matrix
+  //! whose rows match the sampled dimension of the data (for example the
+  //! singular vectors of a previous, slightly different decomposition), its
+  //! columns replace random columns of the sampling matrix, so the power
+  //! iterations start close to the target subspace.  An empty matrix (the
+  //! default) means a fully random sampling matrix.
+  arma::mat& InitialBasis() { return initialBasis; }
+
  private:
   //! Locally stored size of the normalized power iterations.
   size_t iteratedPower;
@@ -178,6 +218,9 @@ class RandomizedSVD
 
   //! The value used for numerical stability.
   double eps;
+
+  //! Basis used to seed the range finder (empty for random sampling).
+  arma::mat initialBasis;
 };
 
 } // namespace mlpack
@@ -88,16 +88,28 @@ inline void RandomizedSVD::Apply(const MatType& data,
 
   arma::mat R, Q, Qdata;
 
-  // Apply the centered data matrix to a random matrix, obtaining Q.
+  // Build the sampling matrix.  If a warm-start basis of matching size has
+  // been set, its columns seed the sampling matrix and only the remaining
+  // columns are drawn randomly; a basis close to the target subspace makes
+  // the power iterations converge in far fewer steps.
+  const size_t sampledDimension = (data.n_cols >= data.n_rows) ?
+      data.n_rows : data.n_cols;
+  R = arma::randn<arma::mat>(sampledDimension, iteratedPower);
+  if (!initialBasis.is_empty() && initialBasis.n_rows == sampledDimension)
+  {
+    const size_t basisColumns = std::min((size_t) initialBasis.n_cols,
+        iteratedPower);
+    R.cols(0, basisColumns - 1) = initialBasis.cols(0, basisColumns - 1);
+  }
+
+  // Apply the centered data matrix to the sampling matrix, obtaining Q.
   if (data.n_cols >= data.n_rows)
   {
-    R = arma::randn<arma::mat>(data.n_rows, iteratedPower);
     Q = (data.t() * R) - arma::repmat(arma::trans(R.t() * rowMean),
         data.n_cols, 1);
   }
   else
   {
-    R = arma::randn<arma::mat>(data.n_cols, iteratedPower);
     Q = (data * R) - (rowMean * (arma::ones(1, data.n_cols) * R));
   }
 
@@ -159,6 +171,148 @@ inline void RandomizedSVD::Apply(const MatType& data,
   }
 }
 
+template<typename MatType>
+inline void RandomizedSVD::ApplyStreaming(const MatType& data,
+                                          arma::mat& u,
+                                          arma::vec& s,
+                                          arma::mat& v,
+                                          const size_t rank,
+                                          const size_t blockSize)
+{
+  if (blockSize == 0)
+  {
+    throw std::invalid_argument("RandomizedSVD::ApplyStreaming(): blockSize "
+        "must be greater than 0!");
+  }
+
+  if (iteratedPower == 0)
+    iteratedPower = rank + 2;
+
+  // First pass: the row means used to center the data on the fly.
+  arma::mat rowMean(data.n_rows, 1, arma::fill::zeros);
+  for (size_t block = 0; block < data.n_cols; block += blockSize)
+  {
+    const size_t lastCol = std::min(block + blockSize,
+        (size_t) data.n_cols) - 1;
+    rowMean += arma::sum(data.cols(block, lastCol), 1);
+  }
+  rowMean = rowMean / data.n_cols + eps;
+
+  // Blocked product (data - rowMean * 1^T) * x: one in-order sweep over the
+  // column blocks of the data.
+  auto blockedMul = [&](const arma::mat& x)
+  {
+    arma::mat result(data.n_rows, x.n_cols, arma::fill::zeros);
+    for (size_t block = 0; block < data.n_cols; block += blockSize)
+    {
+      const size_t lastCol = std::min(block + blockSize,
+          (size_t) data.n_cols) - 1;
+      result += data.cols(block, lastCol) * x.rows(block, lastCol);
+    }
+    result -= rowMean * arma::sum(x, 0);
+    return result;
+  };
+
+  // Blocked product (data - rowMean * 1^T)^T * x: one in-order sweep over
+  // the column blocks of the data.
+  auto blockedTransMul = [&](const arma::mat& x)
+  {
+    arma::mat result(data.n_cols, x.n_cols);
+    for (size_t block = 0; block < data.n_cols; block += blockSize)
+    {
+      const size_t lastCol = std::min(block + blockSize,
+          (size_t) data.n_cols) - 1;
+      result.rows(block, lastCol) = data.cols(block, lastCol).t() * x;
+    }
+    result.each_row() -= arma::mat(rowMean.t() * x);
+    return result;
+  };
+
+  arma::mat R, Q, Qdata;
+
+  // Apply the centered data matrix to a random matrix, obtaining Q.  This is
+  // the same scheme as Apply(), with every product against the data replaced
+  // by a blocked sweep.
+  if (data.n_cols >= data.n_rows)
+  {
+    R = arma::randn<arma::mat>(data.n_rows, iteratedPower);
+    Q = blockedTransMul(R);
+  }
+  else
+  {
+    R = arma::randn<arma::mat>(data.n_cols, iteratedPower);
+    Q = blockedMul(R);
+  }
+
+  // Form a matrix Q whose columns constitute a
+  // well-conditioned basis for the columns of the earlier Q.
+  if (maxIterations == 0)
+  {
+    arma::qr_econ(Q, v, Q);
+  }
+  else
+  {
+    arma::lu(Q, v, Q);
+  }
+
+  // Perform normalized power iterations; each iteration re-reads the data
+  // twice, block by block.
+  for (size_t i = 0; i < maxIterations; ++i)
+  {
+    if (data.n_cols >= data.n_rows)
+    {
+      Q = blockedMul(Q);
+      arma::lu(Q, v, Q);
+      Q = blockedTransMul(Q);
+    }
+    else
+    {
+      Q = blockedTransMul(Q);
+      arma::lu(Q, v, Q);
+      Q = blockedMul(Q);
+    }
+
+    // Computing the LU decomposition is more efficient than computing the QR
+    // decomposition, so we only use it in the last iteration, a pivoted QR
+    // decomposition which renormalizes Q, ensuring that the columns of Q are
+    // orthonormal.
+    if (i < (maxIterations - 1))
+    {
+      arma::lu(Q, v, Q);
+    }
+    else
+    {
+      arma::qr_econ(Q, v, Q);
+    }
+  }
+
+  // Do economical singular value decomposition and compute only the
+  // approximations of the left singular vectors by using the centered data
+  // applied to Q.
+  if (data.n_cols >= data.n_rows)
+  {
+    Qdata = blockedMul(Q);
+    arma::svd_econ(u, s, v, Qdata);
+    v = Q * v;
+  }
+  else
+  {
+    // Qdata = (Q^T data) centered; it has as many columns as the data, so it
+    // is built one column block at a time too.
+    Qdata.set_size(Q.n_cols, data.n_cols);
+    for (size_t block = 0; block < data.n_cols; block += blockSize)
+    {
+      const size_t lastCol = std::min(block + blockSize,
+          (size_t) data.n_cols) - 1;
+      Qdata.cols(block, lastCol) = Q.t() * data.cols(block, lastCol);
+    }
+    Qdata.each_col() -= arma::vec(Q.t() * rowMean);
+
+    arma::svd_econ(u, s, v, Qdata);
+    u = Q * u;
+  }
+}
+
 } // namespace mlpack
 
 #endif
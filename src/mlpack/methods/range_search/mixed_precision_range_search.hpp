@@ -0,0 +1,62 @@
+/**
+ * @file methods/range_search/mixed_precision_range_search.hpp
+ *
+ * Mixed-precision range search: prune and traverse in single precision, then
+ * refine the candidate distances in double precision.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_MIXED_PRECISION_RANGE_SEARCH_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_MIXED_PRECISION_RANGE_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Perform a range search on double-precision data using single-precision
+ * trees and traversal, then refine the results in double precision.  The
+ * trees and the traversal hold floats, halving the memory traffic of the
+ * search; the search range is widened by a small relative slack that covers
+ * the single-precision rounding of the distance computations, and every
+ * candidate found inside the widened range is then recomputed against the
+ * original double-precision data and kept only if it lies in the exact
+ * range.  The returned indices and distances therefore match an all-double
+ * search.
+ *
+ * This is the range-search counterpart of MixedPrecisionSearch() (see
+ * methods/neighbor_search/mixed_precision_search.hpp).
+ *
+ * @tparam MetricType The metric to use for computation.
+ * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ *
+ * @param referenceSet Set of reference points.
+ * @param querySet Set of query points.
+ * @param range Range of distances in which to search.
+ * @param neighbors Object which will hold the list of neighbors for each
+ *      point which fell into the given range, for each query point.
+ * @param distances Object which will hold the list of distances for each
+ *      point which fell into the given range, for each query point.
+ * @param singleMode Whether single-tree computation should be used (as
+ *      opposed to dual-tree computation).
+ */
+template<typename MetricType = EuclideanDistance,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = KDTree>
+void MixedPrecisionRangeSearch(const arma::mat& referenceSet,
+                               const arma::mat& querySet,
+                               const Range& range,
+                               std::vector<std::vector<size_t>>& neighbors,
+                               std::vector<std::vector<double>>& distances,
+                               const bool singleMode = false);
+
+} // namespace mlpack
+
+// Include implementation.
+#include "mixed_precision_range_search_impl.hpp"
+
+#endif
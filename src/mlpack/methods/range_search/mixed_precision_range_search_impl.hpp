@@ -0,0 +1,83 @@
+/**
+ * @file methods/range_search/mixed_precision_range_search_impl.hpp
+ *
+ * Implementation of mixed-precision range search.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_MIXED_PRECISION_RANGE_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_MIXED_PRECISION_RANGE_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mixed_precision_range_search.hpp"
+
+namespace mlpack {
+
+template<typename MetricType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void MixedPrecisionRangeSearch(const arma::mat& referenceSet,
+                               const arma::mat& querySet,
+                               const Range& range,
+                               std::vector<std::vector<size_t>>& neighbors,
+                               std::vector<std::vector<double>>& distances,
+                               const bool singleMode)
+{
+  // Widen the range by a relative slack that covers the accumulated rounding
+  // of a single-precision distance computation, so that no point inside the
+  // exact range can be lost to float rounding.  The rounding error of a
+  // d-dimensional distance grows linearly with d; a factor of 10 leaves
+  // ample headroom while keeping the widening (and thus the extra candidate
+  // work) negligible.
+  const double slack = 10.0 * referenceSet.n_rows *
+      std::numeric_limits<float>::epsilon();
+  const Range widened(std::max(0.0, range.Lo() * (1.0 - slack)),
+      range.Hi() * (1.0 + slack));
+
+  // Run the traversal entirely in single precision.
+  arma::fmat floatReferences = arma::conv_to<arma::fmat>::from(referenceSet);
+  arma::fmat floatQueries = arma::conv_to<arma::fmat>::from(querySet);
+
+  RangeSearch<MetricType, arma::fmat, TreeType> search(
+      std::move(floatReferences), false, singleMode);
+
+  std::vector<std::vector<size_t>> candidateNeighbors;
+  std::vector<std::vector<double>> candidateDistances;
+  search.Search(floatQueries, widened, candidateNeighbors,
+      candidateDistances);
+
+  // Refine: recompute each candidate's distance against the original
+  // double-precision data, and drop candidates that only fell into the
+  // widened range.
+  neighbors.clear();
+  neighbors.resize(querySet.n_cols);
+  distances.clear();
+  distances.resize(querySet.n_cols);
+
+  MetricType metric;
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    neighbors[i].reserve(candidateNeighbors[i].size());
+    distances[i].reserve(candidateNeighbors[i].size());
+
+    for (size_t j = 0; j < candidateNeighbors[i].size(); ++j)
+    {
+      const size_t index = candidateNeighbors[i][j];
+      const double distance = metric.Evaluate(querySet.col(i),
+          referenceSet.col(index));
+      if (range.Contains(distance))
+      {
+        neighbors[i].push_back(index);
+        distances[i].push_back(distance);
+      }
+    }
+  }
+}
+
+} // namespace mlpack
+
+#endif
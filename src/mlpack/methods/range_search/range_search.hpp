@@ -17,6 +17,7 @@
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/tree/binary_space_tree.hpp>
 #include "range_search_stat.hpp"
+#include "range_search_sink.hpp"
 
 namespace mlpack {
 
@@ -193,6 +194,96 @@ class RangeSearch
               std::vector<std::vector<size_t>>& neighbors,
               std::vector<std::vector<double>>& distances);
 
+  /**
+   * A workspace of preallocated search state: the intermediate result vectors
+   * used when indices have to be remapped after the traversal.  Construct one
+   * workspace and pass it to repeated Search() calls to keep the capacity of
+   * the per-query result vectors across calls instead of reallocating them
+   * each time; this matters when Search() is called many times on small query
+   * batches.  A workspace may be shared between RangeSearch objects of the
+   * same type, but must not be used by two Search() calls running at the same
+   * time.
+   */
+  class SearchWorkspace
+  {
+   public:
+    //! Release all of the preallocated state, freeing the held memory.
+    void Clear()
+    {
+      neighborBuffer.clear();
+      neighborBuffer.shrink_to_fit();
+      distanceBuffer.clear();
+      distanceBuffer.shrink_to_fit();
+    }
+
+   private:
+    //! Only Search() uses the buffers.
+    friend class RangeSearch;
+
+    //! Reusable buffer for neighbor indices that need remapping.
+    std::vector<std::vector<size_t>> neighborBuffer;
+    //! Reusable buffer for distances that need query remapping.
+    std::vector<std::vector<double>> distanceBuffer;
+  };
+
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, reusing the preallocated state in the given workspace.
+   * Identical in behavior to the Search() overload above; see
+   * SearchWorkspace.
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param neighbors Object which will hold the list of neighbors for each
+   *      point which fell into the given range, for each query point.
+   * @param distances Object which will hold the list of distances for each
+   *      point which fell into the given range, for each query point.
+   * @param workspace Preallocated search state to reuse.
+   */
+  void Search(const MatType& querySet,
+              const Range& range,
+              std::vector<std::vector<size_t>>& neighbors,
+              std::vector<std::vector<double>>& distances,
+              SearchWorkspace& workspace);
+
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, returning the results in a flat CSR-style format: the
+   * neighbors of query point i are held in
+   * neighbors[offsets[i]] .. neighbors[offsets[i + 1] - 1] (and the matching
+   * positions of the distances array).  Results are buffered in a few large
+   * flat arrays during the search, so no per-query allocations are made; for
+   * dense ranges on large datasets this uses far less memory than the
+   * vector-of-vectors format.
+   *
+   * @param querySet Set of query points.
+   * @param range Range of distances in which to search.
+   * @param neighbors Flat array which will hold all neighbor indices.
+   * @param distances Flat array which will hold all distances.
+   * @param offsets Array of per-query offsets into the other two arrays; it
+   *      will have one element more than the number of query points.
+   */
+  void Search(const MatType& querySet,
+              const Range& range,
+              std::vector<size_t>& neighbors,
+              std::vector<double>& distances,
+              std::vector<size_t>& offsets);
+
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, streaming each result to the given callback instead of
+   * materializing the result set.  The callback is invoked as
+   * callback(queryIndex, neighborIndex, distance) in no particular order.
+   *
+   * @param querySet Set of query points.
+   * @param range Range of distances in which to search.
+   * @param callback Function called once for each result pair.
+   */
+  template<typename CallbackType>
+  void Search(const MatType& querySet,
+              const Range& range,
+              CallbackType callback);
+
   /**
    * Given a pre-built query tree, search for all reference points in the given
    * range for each point in the query set, returning the results in the
@@ -293,6 +384,20 @@ class RangeSearch
   Tree* ReferenceTree() { return referenceTree; }
 
  private:
+  /**
+   * Perform the search, emitting every result to the given sink.  Index
+   * mappings caused by tree building are applied before emission, so the sink
+   * always sees indices in the original dataset order.
+   *
+   * @param querySet Set of query points.
+   * @param range Range of distances in which to search.
+   * @param sink Sink to emit results to.
+   */
+  template<typename SinkType>
+  void SearchWithSink(const MatType& querySet,
+                      const Range& range,
+                      SinkType& sink);
+
   //! Mappings to old reference indices (used when this object builds trees).
   std::vector<size_t> oldFromNewReferences;
   //! Reference tree.
@@ -326,4 +431,7 @@ class RangeSearch
 // Include implementation.
 #include "range_search_impl.hpp"
 
+// Include the mixed-precision search helper.
+#include "mixed_precision_range_search.hpp"
+
 #endif
@@ -289,6 +289,24 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
     const Range& range,
     std::vector<std::vector<size_t>>& neighbors,
     std::vector<std::vector<double>>& distances)
+{
+  // Use a throwaway workspace; callers that search repeatedly should
+  // construct a SearchWorkspace themselves and use the overload below.
+  SearchWorkspace workspace;
+  Search(querySet, range, neighbors, distances, workspace);
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances,
+    SearchWorkspace& workspace)
 {
   util::CheckSameDimensionality(querySet, *referenceSet,
       "RangeSearch::Search()", "query set");
@@ -303,7 +321,7 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   // If we have built the trees ourselves, then we will have to map all the
   // indices back to their original indices when this computation is finished.
   // To avoid extra copies, we will store the unmapped neighbors and distances
-  // in a separate object.
+  // in the workspace's buffers, which keep their allocations across calls.
   std::vector<std::vector<size_t>>* neighborPtr = &neighbors;
   std::vector<std::vector<double>>* distancePtr = &distances;
 
@@ -314,21 +332,24 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
     // ourselves.
     if (!singleMode && !naive)
     {
-      distancePtr = new std::vector<std::vector<double>>;
-      neighborPtr = new std::vector<std::vector<size_t>>;
+      distancePtr = &workspace.distanceBuffer;
+      neighborPtr = &workspace.neighborBuffer;
     }
 
     // Reference indices only need to be mapped if we built the reference tree
     // ourselves.
     else if (treeOwner)
-      neighborPtr = new std::vector<std::vector<size_t>>;
+      neighborPtr = &workspace.neighborBuffer;
   }
 
-  // Resize each vector.
-  neighborPtr->clear(); // Just in case there was anything in it.
+  // Resize the outer vectors, and empty each per-query vector without
+  // releasing any capacity it may already have from an earlier call.
   neighborPtr->resize(querySet.n_cols);
-  distancePtr->clear();
+  for (size_t i = 0; i < neighborPtr->size(); ++i)
+    (*neighborPtr)[i].clear();
   distancePtr->resize(querySet.n_cols);
+  for (size_t i = 0; i < distancePtr->size(); ++i)
+    (*distancePtr)[i].clear();
 
   // Create the helper object for the traversal.
   typedef RangeSearchRules<MetricType, Tree> RuleType;
@@ -337,10 +358,11 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   baseCases = 0;
   scores = 0;
 
+  RangeSearchVectorSink sink(*neighborPtr, *distancePtr);
+
   if (naive)
   {
-    RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        metric);
+    RuleType rules(*referenceSet, querySet, range, sink, metric);
 
     // The naive brute-force solution.
     for (size_t i = 0; i < querySet.n_cols; ++i)
@@ -352,8 +374,7 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   else if (singleMode)
   {
     // Create the traverser.
-    RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        metric);
+    RuleType rules(*referenceSet, querySet, range, sink, metric);
     typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
     // Now have it traverse for each point.
@@ -369,8 +390,7 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
     Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
 
     // Create the traverser.
-    RuleType rules(*referenceSet, queryTree->Dataset(), range, *neighborPtr,
-        *distancePtr, metric);
+    RuleType rules(*referenceSet, queryTree->Dataset(), range, sink, metric);
     typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
 
     traverser.Traverse(*queryTree, *referenceTree);
@@ -405,10 +425,6 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
           neighbors[queryMapping][j] =
               oldFromNewReferences[(*neighborPtr)[i][j]];
       }
-
-      // Finished with temporary objects.
-      delete neighborPtr;
-      delete distancePtr;
     }
     else if (!singleMode && !naive)
     {
@@ -425,10 +441,6 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
         distances[queryMapping] = (*distancePtr)[i];
         neighbors[queryMapping] = (*neighborPtr)[i];
       }
-
-      // Finished with temporary objects.
-      delete neighborPtr;
-      delete distancePtr;
     }
     else if (treeOwner)
     {
@@ -442,9 +454,6 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
         for (size_t j = 0; j < neighbors[i].size(); ++j)
           neighbors[i][j] = oldFromNewReferences[(*neighborPtr)[i][j]];
       }
-
-      // Finished with temporary object.
-      delete neighborPtr;
     }
   }
 }
@@ -486,8 +495,8 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
 
   // Create the helper object for the traversal.
   typedef RangeSearchRules<MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, queryTree->Dataset(), range, *neighborPtr,
-      distances, metric);
+  RangeSearchVectorSink sink(*neighborPtr, distances);
+  RuleType rules(*referenceSet, queryTree->Dataset(), range, sink, metric);
 
   // Create the traverser.
   typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
@@ -549,8 +558,9 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
 
   // Create the helper object for the traversal.
   typedef RangeSearchRules<MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, *referenceSet, range, *neighborPtr,
-      *distancePtr, metric, true /* don't return the query in the results */);
+  RangeSearchVectorSink sink(*neighborPtr, *distancePtr);
+  RuleType rules(*referenceSet, *referenceSet, range, sink, metric,
+      true /* don't return the query in the results */);
 
   if (naive)
   {
@@ -613,6 +623,124 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   }
 }
 
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const Range& range,
+    std::vector<size_t>& neighbors,
+    std::vector<double>& distances,
+    std::vector<size_t>& offsets)
+{
+  RangeSearchCSRSink sink(neighbors, distances, offsets);
+  SearchWithSink(querySet, range, sink);
+  sink.Finalize(querySet.n_cols);
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename CallbackType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const Range& range,
+    CallbackType callback)
+{
+  RangeSearchCallbackSink<CallbackType> sink(callback);
+  SearchWithSink(querySet, range, sink);
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename SinkType>
+void RangeSearch<MetricType, MatType, TreeType>::SearchWithSink(
+    const MatType& querySet,
+    const Range& range,
+    SinkType& sink)
+{
+  util::CheckSameDimensionality(querySet, *referenceSet,
+      "RangeSearch::Search()", "query set");
+
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+    return;
+
+  // Instead of storing results in a temporary object and mapping indices back
+  // afterwards (as the vector-of-vectors overload does), we wrap the sink in
+  // an adapter that maps each index back to the original dataset order at
+  // emission time.  That way the sink only ever sees original indices, and a
+  // callback sink can truly stream.
+  const std::vector<size_t>* refMap =
+      (TreeTraits<Tree>::RearrangesDataset && treeOwner) ?
+      &oldFromNewReferences : NULL;
+
+  // Create the helper object for the traversal.
+  typedef RangeSearchMappingSink<SinkType> MappedSinkType;
+  typedef RangeSearchRules<MetricType, Tree, MappedSinkType> RuleType;
+
+  // Reset counts.
+  baseCases = 0;
+  scores = 0;
+
+  if (naive)
+  {
+    MappedSinkType mappedSink(sink, NULL, refMap);
+    RuleType rules(*referenceSet, querySet, range, mappedSink, metric);
+
+    // The naive brute-force solution.
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      for (size_t j = 0; j < referenceSet->n_cols; ++j)
+        rules.BaseCase(i, j);
+
+    baseCases += (querySet.n_cols * referenceSet->n_cols);
+  }
+  else if (singleMode)
+  {
+    // Create the traverser.
+    MappedSinkType mappedSink(sink, NULL, refMap);
+    RuleType rules(*referenceSet, querySet, range, mappedSink, metric);
+    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+    // Now have it traverse for each point.
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    baseCases += rules.BaseCases();
+    scores += rules.Scores();
+  }
+  else // Dual-tree recursion.
+  {
+    // Build the query tree.
+    std::vector<size_t> oldFromNewQueries;
+    Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
+
+    const std::vector<size_t>* queryMap =
+        TreeTraits<Tree>::RearrangesDataset ? &oldFromNewQueries : NULL;
+
+    // Create the traverser.
+    MappedSinkType mappedSink(sink, queryMap, refMap);
+    RuleType rules(*referenceSet, queryTree->Dataset(), range, mappedSink,
+        metric);
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+    traverser.Traverse(*queryTree, *referenceTree);
+
+    baseCases += rules.BaseCases();
+    scores += rules.Scores();
+
+    // Clean up tree memory.
+    delete queryTree;
+  }
+}
+
 template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
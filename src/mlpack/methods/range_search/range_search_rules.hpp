@@ -14,16 +14,23 @@
 
 #include <mlpack/core/tree/traversal_info.hpp>
 
+#include "range_search_sink.hpp"
+
 namespace mlpack {
 
 /**
  * The RangeSearchRules class is a template helper class used by RangeSearch
- * class when performing range searches.
+ * class when performing range searches.  Results are emitted through a sink
+ * object, so the output format (vector-of-vectors, flat CSR arrays, or a
+ * streaming callback) is decided by the caller; see range_search_sink.hpp.
  *
  * @tparam MetricType The metric to use for computation.
  * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ * @tparam SinkType The sink results are emitted to.
  */
-template<typename MetricType, typename TreeType>
+template<typename MetricType,
+         typename TreeType,
+         typename SinkType = RangeSearchVectorSink>
 class RangeSearchRules
 {
  public:
@@ -34,8 +41,7 @@ class RangeSearchRules
    * @param referenceSet Set of reference data.
    * @param querySet Set of query data.
    * @param range Range to search for.
-   * @param neighbors Vector to store resulting neighbors in.
-   * @param distances Vector to store resulting distances in.
+   * @param sink Sink to emit resulting neighbors and distances to.
    * @param metric Instantiated metric.
    * @param sameSet If true, the query and reference set are taken to be the
    *      same, and a query point will not return itself in the results.
@@ -43,8 +49,7 @@ class RangeSearchRules
   RangeSearchRules(const arma::mat& referenceSet,
                    const arma::mat& querySet,
                    const Range& range,
-                   std::vector<std::vector<size_t> >& neighbors,
-                   std::vector<std::vector<double> >& distances,
+                   SinkType& sink,
                    MetricType& metric,
                    const bool sameSet = false);
 
@@ -130,11 +135,8 @@ class RangeSearchRules
   //! The range of distances for which we are searching.
   const Range& range;
 
-  //! The vector the resultant neighbor indices should be stored in.
-  std::vector<std::vector<size_t> >& neighbors;
-
-  //! The vector the resultant neighbor distances should be stored in.
-  std::vector<std::vector<double> >& distances;
+  //! The sink the results should be emitted to.
+  SinkType& sink;
 
   //! The instantiated metric.
   MetricType& metric;
@@ -0,0 +1,248 @@
+/**
+ * @file methods/range_search/range_search_sink.hpp
+ *
+ * Result sinks for range search.  A sink receives every (query, neighbor,
+ * distance) result produced during a range search, which allows the output
+ * format to be chosen at the Search() call site: the classic
+ * vector-of-vectors format, a flat CSR-style format backed by a few large
+ * arrays, or a callback that consumes results without materializing them.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_SINK_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_SINK_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Sink that stores results in the classic vector-of-vectors format, where
+ * element i of each vector holds the results for query point i.
+ */
+class RangeSearchVectorSink
+{
+ public:
+  /**
+   * Construct the sink.  The given vectors must already be sized to the
+   * number of query points.
+   *
+   * @param neighbors Vector of vectors to store neighbor indices in.
+   * @param distances Vector of vectors to store distances in.
+   */
+  RangeSearchVectorSink(std::vector<std::vector<size_t>>& neighbors,
+                        std::vector<std::vector<double>>& distances) :
+      neighbors(neighbors),
+      distances(distances)
+  {
+    // Nothing to do.
+  }
+
+  //! Reserve space for additional results of the given query point.
+  void Reserve(const size_t queryIndex, const size_t numResults)
+  {
+    neighbors[queryIndex].reserve(neighbors[queryIndex].size() + numResults);
+    distances[queryIndex].reserve(distances[queryIndex].size() + numResults);
+  }
+
+  //! Add a single result pair.
+  void Insert(const size_t queryIndex,
+              const size_t neighborIndex,
+              const double distance)
+  {
+    neighbors[queryIndex].push_back(neighborIndex);
+    distances[queryIndex].push_back(distance);
+  }
+
+ private:
+  //! Neighbor indices for each query point.
+  std::vector<std::vector<size_t>>& neighbors;
+  //! Distances for each query point.
+  std::vector<std::vector<double>>& distances;
+};
+
+/**
+ * Sink that stores results in a flat CSR-style format: after Finalize() is
+ * called, the results for query point i are held in
+ * neighbors[offsets[i]] .. neighbors[offsets[i + 1] - 1] (and the matching
+ * positions of the distances array).  During the search, results are appended
+ * to a few large flat buffers, so no per-query allocations are made; this
+ * avoids the heap fragmentation and memory overhead of millions of small
+ * vectors when ranges are dense.
+ */
+class RangeSearchCSRSink
+{
+ public:
+  /**
+   * Construct the sink.  The given arrays will be filled when Finalize() is
+   * called.
+   *
+   * @param neighbors Flat array to store all neighbor indices in.
+   * @param distances Flat array to store all distances in.
+   * @param offsets Array of per-query offsets into the other two arrays; it
+   *     will have one element more than the number of query points.
+   */
+  RangeSearchCSRSink(std::vector<size_t>& neighbors,
+                     std::vector<double>& distances,
+                     std::vector<size_t>& offsets) :
+      neighbors(neighbors),
+      distances(distances),
+      offsets(offsets)
+  {
+    // Nothing to do.
+  }
+
+  //! Reserve space for additional results (the buffers are shared between all
+  //! query points).
+  void Reserve(const size_t /* queryIndex */, const size_t numResults)
+  {
+    queryBuffer.reserve(queryBuffer.size() + numResults);
+    neighborBuffer.reserve(neighborBuffer.size() + numResults);
+    distanceBuffer.reserve(distanceBuffer.size() + numResults);
+  }
+
+  //! Add a single result pair to the flat buffers.
+  void Insert(const size_t queryIndex,
+              const size_t neighborIndex,
+              const double distance)
+  {
+    queryBuffer.push_back(queryIndex);
+    neighborBuffer.push_back(neighborIndex);
+    distanceBuffer.push_back(distance);
+  }
+
+  /**
+   * Group the buffered results by query point with a counting sort and write
+   * them to the output arrays in CSR form.  The buffers are released
+   * afterwards.
+   *
+   * @param numQueries Number of query points that were searched.
+   */
+  void Finalize(const size_t numQueries)
+  {
+    // Count the results of each query point, then turn the counts into
+    // offsets with a prefix sum.
+    offsets.assign(numQueries + 1, 0);
+    for (const size_t queryIndex : queryBuffer)
+      offsets[queryIndex + 1]++;
+    for (size_t i = 1; i <= numQueries; ++i)
+      offsets[i] += offsets[i - 1];
+
+    // Scatter the buffered results into their per-query segments.
+    neighbors.resize(queryBuffer.size());
+    distances.resize(queryBuffer.size());
+    std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < queryBuffer.size(); ++i)
+    {
+      const size_t position = cursor[queryBuffer[i]]++;
+      neighbors[position] = neighborBuffer[i];
+      distances[position] = distanceBuffer[i];
+    }
+
+    // Release the buffers.
+    std::vector<size_t>().swap(queryBuffer);
+    std::vector<size_t>().swap(neighborBuffer);
+    std::vector<double>().swap(distanceBuffer);
+  }
+
+ private:
+  //! Flat output array of neighbor indices.
+  std::vector<size_t>& neighbors;
+  //! Flat output array of distances.
+  std::vector<double>& distances;
+  //! Per-query offsets into the output arrays.
+  std::vector<size_t>& offsets;
+
+  //! Buffered query indices of the results seen so far.
+  std::vector<size_t> queryBuffer;
+  //! Buffered neighbor indices of the results seen so far.
+  std::vector<size_t> neighborBuffer;
+  //! Buffered distances of the results seen so far.
+  std::vector<double> distanceBuffer;
+};
+
+/**
+ * Sink that forwards each result to a callback without materializing
+ * anything.  The callback is invoked as
+ * callback(queryIndex, neighborIndex, distance) in no particular order.
+ */
+template<typename CallbackType>
+class RangeSearchCallbackSink
+{
+ public:
+  //! Construct the sink around the given callback.
+  RangeSearchCallbackSink(CallbackType& callback) : callback(callback)
+  {
+    // Nothing to do.
+  }
+
+  //! Nothing to reserve; results are not stored.
+  void Reserve(const size_t /* queryIndex */, const size_t /* numResults */)
+  {
+    // Nothing to do.
+  }
+
+  //! Emit a single result pair.
+  void Insert(const size_t queryIndex,
+              const size_t neighborIndex,
+              const double distance)
+  {
+    callback(queryIndex, neighborIndex, distance);
+  }
+
+ private:
+  //! The callback results are forwarded to.
+  CallbackType& callback;
+};
+
+/**
+ * Sink adapter that maps tree-internal point indices back to the original
+ * dataset order before forwarding results to another sink.  A null map means
+ * the corresponding indices need no mapping.
+ */
+template<typename SinkType>
+class RangeSearchMappingSink
+{
+ public:
+  //! Construct the adapter around the given sink and mappings.
+  RangeSearchMappingSink(SinkType& sink,
+                         const std::vector<size_t>* queryMap,
+                         const std::vector<size_t>* referenceMap) :
+      sink(sink),
+      queryMap(queryMap),
+      referenceMap(referenceMap)
+  {
+    // Nothing to do.
+  }
+
+  //! Forward the reservation with a mapped query index.
+  void Reserve(const size_t queryIndex, const size_t numResults)
+  {
+    sink.Reserve(queryMap ? (*queryMap)[queryIndex] : queryIndex, numResults);
+  }
+
+  //! Forward a single result pair with mapped indices.
+  void Insert(const size_t queryIndex,
+              const size_t neighborIndex,
+              const double distance)
+  {
+    sink.Insert(queryMap ? (*queryMap)[queryIndex] : queryIndex,
+                referenceMap ? (*referenceMap)[neighborIndex] : neighborIndex,
+                distance);
+  }
+
+ private:
+  //! The sink results are forwarded to.
+  SinkType& sink;
+  //! Mapping for query indices (may be null).
+  const std::vector<size_t>* queryMap;
+  //! Mapping for reference indices (may be null).
+  const std::vector<size_t>* referenceMap;
+};
+
+} // namespace mlpack
+
+#endif
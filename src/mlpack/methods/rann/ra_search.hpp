@@ -359,6 +359,32 @@ class RASearch
   void serialize(Archive& ar, const uint32_t /* version */);
 
  private:
+  /**
+   * Process every query point in parallel, each thread working on a private
+   * copy of the given rules object with its own deterministic random stream,
+   * and write the per-query results into the given matrices.  processQuery is
+   * called once per query point with the thread-local rules object and the
+   * query index; every query is processed by exactly one thread, so each
+   * query's candidate list lives entirely in one rules copy and the merge
+   * only has to gather columns.
+   *
+   * When OpenMP is not available (or only one thread is used) the given rules
+   * object is used directly.
+   *
+   * @param rules Prototype rules object; thread copies are made from it.
+   * @param numQueries Number of query points to process.
+   * @param neighbors Matrix to store the resulting neighbors into.
+   * @param distances Matrix to store the resulting distances into.
+   * @param processQuery Function called as processQuery(rules, queryIndex).
+   * @return Total number of distance computations performed.
+   */
+  template<typename RuleType, typename ProcessQueryType>
+  size_t ParallelQuerySearch(RuleType& rules,
+                             const size_t numQueries,
+                             arma::Mat<size_t>& neighbors,
+                             arma::mat& distances,
+                             ProcessQueryType processQuery);
+
   //! Permutations of reference points during tree building.
   std::vector<size_t> oldFromNewReferences;
   //! Pointer to the root of the reference tree.
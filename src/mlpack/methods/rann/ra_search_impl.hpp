@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_RANN_RA_SEARCH_IMPL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
 
 #include "ra_search_rules.hpp"
 
@@ -208,6 +209,91 @@ void RASearch<SortPolicy, MetricType, MatType, TreeType>::Train(
   setOwner = false;
 }
 
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename RuleType, typename ProcessQueryType>
+size_t RASearch<SortPolicy, MetricType, MatType, TreeType>::
+ParallelQuerySearch(RuleType& rules,
+                    const size_t numQueries,
+                    arma::Mat<size_t>& neighbors,
+                    arma::mat& distances,
+                    ProcessQueryType processQuery)
+{
+  size_t numThreads = 1;
+  #ifdef MLPACK_USE_OPENMP
+    numThreads = (size_t) omp_get_max_threads();
+  #endif
+
+  if (numThreads == 1)
+  {
+    // Serial execution; use the given rules object directly.
+    for (size_t i = 0; i < numQueries; ++i)
+      processQuery(rules, i);
+
+    rules.GetResults(neighbors, distances);
+    return rules.NumDistComputations();
+  }
+
+  // Draw one seed per thread from the global stream, so the per-thread
+  // streams (and therefore the sampling) are deterministic for a fixed seed
+  // and thread count.
+  std::vector<uint32_t> threadSeeds(numThreads);
+  for (size_t t = 0; t < numThreads; ++t)
+    threadSeeds[t] = (uint32_t) RandGen()();
+
+  // Work already performed by the prototype rules object (e.g. sampling done
+  // in its constructor) is inherited by every thread copy; count it once.
+  const size_t baseDistComputations = rules.NumDistComputations();
+  size_t distComputations = baseDistComputations;
+
+  #pragma omp parallel reduction(+: distComputations)
+  {
+    size_t threadId = 0;
+    #ifdef MLPACK_USE_OPENMP
+      threadId = (size_t) omp_get_thread_num();
+    #endif
+    RandGen().seed(threadSeeds[threadId]);
+
+    // Each thread accumulates candidates in its own copy of the rules, so no
+    // state is shared between threads during the traversals.
+    RuleType threadRules(rules);
+    std::vector<size_t> ownedQueries;
+
+    // With a static schedule the query-to-thread assignment is fixed, so the
+    // samples taken for any query always come from the same random stream.
+    #pragma omp for schedule(static)
+    for (size_t i = 0; i < numQueries; ++i)
+    {
+      processQuery(threadRules, i);
+      ownedQueries.push_back(i);
+    }
+
+    distComputations += threadRules.NumDistComputations() -
+        baseDistComputations;
+
+    // Every query was processed by exactly one thread, so its candidate list
+    // lives entirely in that thread's rules copy; gather those columns.
+    arma::Mat<size_t> threadNeighbors;
+    arma::mat threadDistances;
+    threadRules.GetResults(threadNeighbors, threadDistances);
+
+    #pragma omp critical
+    {
+      for (const size_t i : ownedQueries)
+      {
+        neighbors.col(i) = threadNeighbors.col(i);
+        distances.col(i) = threadDistances.col(i);
+      }
+    }
+  }
+
+  return distComputations;
+}
+
 /**
  * Computes the best neighbors and stores them in resultingNeighbors and
  * distances.
@@ -276,12 +362,13 @@ Search(const MatType& querySet,
         distinctSamples);
 
     // Run the base case on each combination of query point and sampled
-    // reference point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      for (size_t j = 0; j < distinctSamples.n_elem; ++j)
-        rules.BaseCase(i, (size_t) distinctSamples[j]);
-
-    rules.GetResults(*neighborPtr, *distancePtr);
+    // reference point; queries are processed in parallel.
+    ParallelQuerySearch(rules, querySet.n_cols, *neighborPtr, *distancePtr,
+        [&](RuleType& threadRules, const size_t i)
+        {
+          for (size_t j = 0; j < distinctSamples.n_elem; ++j)
+            threadRules.BaseCase(i, (size_t) distinctSamples[j]);
+        });
   }
   else if (singleMode)
   {
@@ -294,20 +381,25 @@ Search(const MatType& querySet,
     {
       Log::Info << "Performing single-tree traversal..." << std::endl;
 
-      // Create the traverser.
-      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
-
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+      // Traverse for each point; queries are processed in parallel.
+      const size_t distComputations = ParallelQuerySearch(rules,
+          querySet.n_cols, *neighborPtr, *distancePtr,
+          [&](RuleType& threadRules, const size_t i)
+          {
+            typename Tree::template SingleTreeTraverser<RuleType>
+                traverser(threadRules);
+            traverser.Traverse(i, *referenceTree);
+          });
 
       Log::Info << "Single-tree traversal complete." << std::endl;
       Log::Info << "Average number of distance calculations per query point: "
-          << (rules.NumDistComputations() / querySet.n_cols) << "."
+          << (distComputations / querySet.n_cols) << "."
           << std::endl;
     }
-
-    rules.GetResults(*neighborPtr, *distancePtr);
+    else
+    {
+      rules.GetResults(*neighborPtr, *distancePtr);
+    }
   }
   else // Dual-tree recursion.
   {
@@ -491,19 +583,26 @@ void RASearch<SortPolicy, MetricType, MatType, TreeType>::Search(
     ObtainDistinctSamples(0, referenceSet->n_cols, numSamples,
         distinctSamples);
 
-    // The naive brute-force solution.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      for (size_t j = 0; j < referenceSet->n_cols; ++j)
-        rules.BaseCase(i, j);
+    // The naive brute-force solution; queries are processed in parallel.
+    ParallelQuerySearch(rules, referenceSet->n_cols, *neighborPtr,
+        *distancePtr,
+        [&](RuleType& threadRules, const size_t i)
+        {
+          for (size_t j = 0; j < referenceSet->n_cols; ++j)
+            threadRules.BaseCase(i, j);
+        });
   }
   else if (singleMode)
   {
-    // Create the traverser.
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
-
-    // Now have it traverse for each point.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+    // Traverse for each point; queries are processed in parallel.
+    ParallelQuerySearch(rules, referenceSet->n_cols, *neighborPtr,
+        *distancePtr,
+        [&](RuleType& threadRules, const size_t i)
+        {
+          typename Tree::template SingleTreeTraverser<RuleType>
+              traverser(threadRules);
+          traverser.Traverse(i, *referenceTree);
+        });
   }
   else
   {
@@ -511,9 +610,9 @@ void RASearch<SortPolicy, MetricType, MatType, TreeType>::Search(
     typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
 
     traverser.Traverse(*referenceTree, *referenceTree);
-  }
 
-  rules.GetResults(*neighborPtr, *distancePtr);
+    rules.GetResults(*neighborPtr, *distancePtr);
+  }
 
   // Do we need to map the reference indices?
   if (treeOwner && TreeTraits<Tree>::RearrangesDataset)
@@ -73,12 +73,16 @@ void AsyncLearning<
   bool stop = false;
 
   // Set up worker pool, worker 0 will be deterministic for evaluation.
+  // Workers are initialized only once the pool has reached its final size:
+  // initialization aliases each worker's parameters onto the shared
+  // parameter matrix, and a vector reallocation would silently detach the
+  // aliases.
   std::vector<WorkerType> workers;
+  workers.reserve(config.NumWorkers() + 1);
   for (size_t i = 0; i <= config.NumWorkers(); ++i)
-  {
     workers.push_back(WorkerType(updater, environment, config, !i));
-    workers.back().Initialize(learningNetwork);
-  }
+  for (size_t i = 0; i <= config.NumWorkers(); ++i)
+    workers[i].Initialize(learningNetwork);
   // Set up task queue corresponding to worker pool.
   std::queue<size_t> tasks;
   for (size_t i = 0; i <= config.NumWorkers(); ++i)
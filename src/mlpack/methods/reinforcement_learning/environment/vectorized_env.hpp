@@ -0,0 +1,144 @@
+/**
+ * @file methods/reinforcement_learning/environment/vectorized_env.hpp
+ * @author Ryan Curtin
+ *
+ * This file is the definition of the VectorizedEnv class, an adapter that
+ * steps a batch of environment instances at once for vectorized rollouts.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_ENVIRONMENT_VECTORIZED_ENV_HPP
+#define MLPACK_METHODS_RL_ENVIRONMENT_VECTORIZED_ENV_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Adapter that runs a batch of independent instances of an environment and
+ * steps them together.  The encoded states of all instances are gathered
+ * into one matrix (one column per instance), so a Q-network forward pass can
+ * be amortized over the whole batch instead of being issued once per
+ * environment; see `QLearning::SelectActionBatch()` and
+ * `QLearning::VectorizedEpisode()`.
+ *
+ * Environment dynamics remain the per-instance `Sample()` implementations of
+ * the wrapped environment; only state encoding, action selection, and
+ * bookkeeping are batched.  Instances that reach a terminal state are reset
+ * automatically, so a vectorized rollout can run for any number of steps.
+ *
+ * @tparam EnvironmentType The type of the wrapped reinforcement learning
+ *     task.
+ */
+template<typename EnvironmentType>
+class VectorizedEnv
+{
+ public:
+  //! Convenient typedef for state.
+  using StateType = typename EnvironmentType::State;
+
+  //! Convenient typedef for action.
+  using ActionType = typename EnvironmentType::Action;
+
+  /**
+   * Construct a vectorized environment holding `numEnvs` copies of the given
+   * environment.
+   *
+   * @param numEnvs Number of environment instances to run.
+   * @param environment Prototype environment to copy.
+   */
+  VectorizedEnv(const size_t numEnvs = 1,
+                const EnvironmentType& environment = EnvironmentType()) :
+      environments(numEnvs, environment),
+      states(numEnvs)
+  { /* Nothing to do here. */ }
+
+  /**
+   * Reset every environment instance to an initial state, and gather the
+   * encoded initial states into one matrix (one column per instance).
+   *
+   * @param encodedStates Matrix to store the encoded initial states in.
+   */
+  void InitialSample(arma::mat& encodedStates)
+  {
+    encodedStates.set_size(StateType::dimension, environments.size());
+    for (size_t i = 0; i < environments.size(); ++i)
+    {
+      states[i] = environments[i].InitialSample();
+      encodedStates.col(i) = states[i].Encode();
+    }
+  }
+
+  /**
+   * Step every environment instance with its corresponding action.  The next
+   * state, reward, and terminal flag of each instance are returned; any
+   * instance whose next state is terminal is reset, so the current states
+   * (see `EncodeStates()`) always describe live episodes.
+   *
+   * @param actions One action per environment instance.
+   * @param nextStates The next state of each instance (before any reset).
+   * @param rewards The reward obtained by each instance.
+   * @param terminals Whether each instance's next state is terminal.
+   */
+  void Sample(const std::vector<ActionType>& actions,
+              std::vector<StateType>& nextStates,
+              arma::rowvec& rewards,
+              arma::irowvec& terminals)
+  {
+    nextStates.resize(environments.size());
+    rewards.set_size(environments.size());
+    terminals.set_size(environments.size());
+
+    for (size_t i = 0; i < environments.size(); ++i)
+    {
+      rewards(i) = environments[i].Sample(states[i], actions[i],
+          nextStates[i]);
+      terminals(i) = environments[i].IsTerminal(nextStates[i]);
+
+      // Reset finished instances so the rollout continues seamlessly.
+      states[i] = terminals(i) ? environments[i].InitialSample()
+                               : nextStates[i];
+    }
+  }
+
+  /**
+   * Gather the encoded current states of all instances into one matrix (one
+   * column per instance).
+   *
+   * @param encodedStates Matrix to store the encoded states in.
+   */
+  void EncodeStates(arma::mat& encodedStates) const
+  {
+    encodedStates.set_size(StateType::dimension, environments.size());
+    for (size_t i = 0; i < environments.size(); ++i)
+      encodedStates.col(i) = states[i].Encode();
+  }
+
+  //! Get the number of environment instances.
+  size_t NumEnvs() const { return environments.size(); }
+
+  //! Get the current states of all instances.
+  const std::vector<StateType>& States() const { return states; }
+
+  //! Get the environment instances.
+  const std::vector<EnvironmentType>& Environments() const
+  {
+    return environments;
+  }
+  //! Modify the environment instances.
+  std::vector<EnvironmentType>& Environments() { return environments; }
+
+ private:
+  //! Locally-stored environment instances.
+  std::vector<EnvironmentType> environments;
+
+  //! Locally-stored current state of each instance.
+  std::vector<StateType> states;
+};
+
+} // namespace mlpack
+
+#endif
@@ -103,12 +103,41 @@ class QLearning
    */
   void SelectAction();
 
+  /**
+   * Select one action per column of `encodedStates` with a single forward
+   * pass through the learning network, so the network evaluation is
+   * amortized over the whole batch.
+   *
+   * @param encodedStates Encoded states, one column per environment.
+   * @param actions The selected action for each column.
+   */
+  void SelectActionBatch(const arma::mat& encodedStates,
+                         std::vector<ActionType>& actions);
+
   /**
    * Execute an episode.
    * @return Return of the episode.
    */
   double Episode();
 
+  /**
+   * Execute a vectorized rollout of `numSteps` batched steps over a set of
+   * environment instances.  Every step selects all actions with one network
+   * forward pass, stores one transition per instance in the replay buffer,
+   * and (once past the exploration phase) performs one training update.
+   * Finished instances are reset by the adapter, so the rollout always runs
+   * for exactly `numSteps` steps.
+   *
+   * @tparam VecEnvType The vectorized environment adapter type (e.g.
+   *     `VectorizedEnv<EnvironmentType>`).
+   * @param vectorizedEnvironment The batch of environment instances to run.
+   * @param numSteps Number of batched steps to execute.
+   * @return Total reward accumulated over all instances.
+   */
+  template<typename VecEnvType>
+  double VectorizedEpisode(VecEnvType& vectorizedEnvironment,
+                           const size_t numSteps);
+
   //! Modify total steps from beginning.
   size_t& TotalSteps() { return totalSteps; }
   //! Get total steps from beginning.
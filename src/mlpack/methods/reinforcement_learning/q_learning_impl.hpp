@@ -336,6 +336,97 @@ void QLearning<
   action = policy.Sample(actionValue, deterministic, config.NoisyQLearning());
 }
 
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+void QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::SelectActionBatch(const arma::mat& encodedStates,
+                     std::vector<ActionType>& actions)
+{
+  // Get the action values of all states with one forward pass.
+  arma::mat actionValues;
+  learningNetwork.Predict(encodedStates, actionValues);
+
+  // Select an action for each state according to the behavior policy.
+  actions.resize(encodedStates.n_cols);
+  for (size_t i = 0; i < encodedStates.n_cols; ++i)
+  {
+    actions[i] = policy.Sample(actionValues.col(i), deterministic,
+        config.NoisyQLearning());
+  }
+}
+
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+template <typename VecEnvType>
+double QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::VectorizedEpisode(VecEnvType& vectorizedEnvironment,
+                     const size_t numSteps)
+{
+  // Get the initial states of all environment instances.
+  arma::mat encodedStates;
+  vectorizedEnvironment.InitialSample(encodedStates);
+
+  // Track the return accumulated over all instances.
+  double totalReturn = 0.0;
+
+  std::vector<ActionType> actions;
+  std::vector<StateType> nextStates;
+  arma::rowvec rewards;
+  arma::irowvec terminals;
+  for (size_t t = 0; t < numSteps; ++t)
+  {
+    // Select all actions with one network forward pass.
+    SelectActionBatch(encodedStates, actions);
+
+    // Step all environment instances; keep the pre-step states for the
+    // replay buffer (the adapter resets finished instances internally).
+    const std::vector<StateType> previousStates =
+        vectorizedEnvironment.States();
+    vectorizedEnvironment.Sample(actions, nextStates, rewards, terminals);
+
+    totalReturn += arma::accu(rewards);
+    totalSteps += vectorizedEnvironment.NumEnvs();
+
+    // Store one transition per instance for replay.
+    for (size_t i = 0; i < vectorizedEnvironment.NumEnvs(); ++i)
+    {
+      replayMethod.Store(previousStates[i], actions[i], rewards(i),
+          nextStates[i], terminals(i), config.Discount());
+    }
+
+    // Gather the (possibly reset) current states for the next step.
+    vectorizedEnvironment.EncodeStates(encodedStates);
+
+    if (deterministic || totalSteps < config.ExplorationSteps())
+      continue;
+    if (config.IsCategorical())
+      TrainCategoricalAgent();
+    else
+      TrainAgent();
+  }
+  return totalReturn;
+}
+
 template <
   typename EnvironmentType,
   typename NetworkType,
@@ -0,0 +1,340 @@
+/**
+ * @file methods/reinforcement_learning/replay/lock_free_replay.hpp
+ * @author Ryan Curtin
+ *
+ * This file is an implementation of a lock-free experience replay buffer for
+ * asynchronous training setups with multiple actor threads.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_REPLAY_LOCK_FREE_REPLAY_HPP
+#define MLPACK_METHODS_RL_REPLAY_LOCK_FREE_REPLAY_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <atomic>
+#include <cassert>
+
+namespace mlpack {
+
+/**
+ * Implementation of a lock-free random experience replay buffer.
+ *
+ * This class provides the same interface as `RandomReplay`, so it can be used
+ * as the `ReplayType` of any agent (e.g. `QLearning` or `SAC`), but it allows
+ * many actor threads to call `Store()` concurrently while one learner thread
+ * calls `Sample()`, without any locks.  All transition storage is preallocated
+ * as contiguous slabs; a `Store()` claims a slot of the ring with an atomic
+ * fetch-and-add on the write cursor and never blocks on other writers or on
+ * the sampler.
+ *
+ * Each slot carries a sequence counter that is bumped to an odd value before a
+ * writer fills the slot and to an even value once the write is published
+ * (a seqlock).  The sampler copies a slot and then re-checks the counter; if a
+ * writer reused the slot in the meantime, the copy is discarded and another
+ * slot is drawn.  Writers claim a slot by advancing its sequence counter with
+ * a compare-and-swap from the previous published value, so the per-slot
+ * counters are strictly monotone even when the ring wraps around: a writer
+ * whose ticket lands on a slot whose previous occupant has not yet published
+ * spins until it has.  This means the re-check is reliable — equal even
+ * counters before and after the copy guarantee the copy is a single published
+ * transition — at the cost of writers briefly waiting when the ring wraps
+ * onto a stalled writer, which only happens when the buffer is run far too
+ * small for the write rate.  Slot reuse never reallocates per-slot storage
+ * once a slot has been written, so a concurrent reader only ever observes
+ * stable memory (and any torn values it copies are discarded by the sequence
+ * re-check).
+ *
+ * N-step transitions (`nSteps > 1`) are aggregated in a small per-buffer
+ * queue, which is inherently sequential; use one `LockFreeReplay` per actor
+ * (or `nSteps = 1`) when storing from multiple threads.
+ *
+ * @tparam EnvironmentType Desired task.
+ */
+template <typename EnvironmentType>
+class LockFreeReplay
+{
+ public:
+  //! Convenient typedef for action.
+  using ActionType = typename EnvironmentType::Action;
+
+  //! Convenient typedef for state.
+  using StateType = typename EnvironmentType::State;
+
+  struct Transition
+  {
+    StateType state;
+    ActionType action;
+    double reward;
+    StateType nextState;
+    bool isEnd;
+  };
+
+  LockFreeReplay():
+      batchSize(0),
+      capacity(0),
+      nSteps(0),
+      cursor(0)
+  { /* Nothing to do here. */ }
+
+  /**
+   * Construct an instance of the lock-free experience replay class.
+   *
+   * @param batchSize Number of examples returned at each sample.
+   * @param capacity Total memory size in terms of number of examples.
+   * @param nSteps Number of steps to look in the future.
+   * @param dimension The dimension of an encoded state.
+   */
+  LockFreeReplay(const size_t batchSize,
+                 const size_t capacity,
+                 const size_t nSteps = 1,
+                 const size_t dimension = StateType::dimension) :
+      batchSize(batchSize),
+      capacity(capacity),
+      nSteps(nSteps),
+      cursor(0),
+      slotSequence(capacity),
+      states(dimension, capacity),
+      actions(capacity),
+      rewards(capacity),
+      nextStates(dimension, capacity),
+      isTerminal(capacity)
+  {
+    for (size_t i = 0; i < capacity; ++i)
+      slotSequence[i].store(0, std::memory_order_relaxed);
+  }
+
+  /**
+   * Store the given experience.  Safe to call from many threads at once when
+   * `nSteps` is 1; see the class documentation for `nSteps > 1`.
+   *
+   * @param state Given state.
+   * @param action Given action.
+   * @param reward Given reward.
+   * @param nextState Given next state.
+   * @param isEnd Whether next state is terminal state.
+   * @param discount The discount parameter.
+   */
+  void Store(StateType state,
+             ActionType action,
+             double reward,
+             StateType nextState,
+             bool isEnd,
+             const double& discount)
+  {
+    if (nSteps > 1)
+    {
+      nStepBuffer.push_back({state, action, reward, nextState, isEnd});
+
+      // Single step transition is not ready.
+      if (nStepBuffer.size() < nSteps)
+        return;
+
+      // To keep the queue size fixed to nSteps.
+      if (nStepBuffer.size() > nSteps)
+        nStepBuffer.pop_front();
+
+      // Before moving ahead, lets confirm if our fixed size buffer works.
+      assert(nStepBuffer.size() == nSteps);
+
+      // Make a n-step transition.
+      GetNStepInfo(reward, nextState, isEnd, discount);
+
+      state = nStepBuffer.front().state;
+      action = nStepBuffer.front().action;
+    }
+
+    // Claim a ticket; this is the only point of contention between writers on
+    // the fast path and it never blocks.
+    const size_t ticket = cursor.fetch_add(1, std::memory_order_relaxed);
+    const size_t slot = ticket % capacity;
+    const size_t epoch = ticket / capacity + 1;
+
+    // Mark the slot as in progress (odd sequence value) by advancing its
+    // counter from the previous published value.  The CAS keeps the per-slot
+    // counters strictly monotone across ring wrap-around: if the previous
+    // occupant of this slot has not published yet, spin until it has, so
+    // that no two writers ever interleave their sequence stores on one slot.
+    size_t expected = 2 * (epoch - 1);
+    while (!slotSequence[slot].compare_exchange_weak(expected,
+        2 * epoch - 1, std::memory_order_relaxed))
+      expected = 2 * (epoch - 1);
+
+    // The odd marker must become visible before any of the data writes below;
+    // the store above is relaxed, so order them with an explicit release
+    // fence.
+    std::atomic_thread_fence(std::memory_order_release);
+
+    states.col(slot) = state.Encode();
+    actions[slot] = action;
+    rewards(slot) = reward;
+    nextStates.col(slot) = nextState.Encode();
+    isTerminal(slot) = isEnd;
+
+    // Publish (even sequence value); the release store orders the data writes
+    // before it.
+    slotSequence[slot].store(2 * epoch, std::memory_order_release);
+  }
+
+  /**
+   * Get the reward, next state and terminal boolean for nth step.
+   *
+   * @param reward Given reward.
+   * @param nextState Given next state.
+   * @param isEnd Whether next state is terminal state.
+   * @param discount The discount parameter.
+   */
+  void GetNStepInfo(double& reward,
+                    StateType& nextState,
+                    bool& isEnd,
+                    const double& discount)
+  {
+    reward = nStepBuffer.back().reward;
+    nextState = nStepBuffer.back().nextState;
+    isEnd = nStepBuffer.back().isEnd;
+
+    // Should start from the second last transition in buffer.
+    for (int i = nStepBuffer.size() - 2; i >= 0; i--)
+    {
+      bool iE = nStepBuffer[i].isEnd;
+      reward = nStepBuffer[i].reward + discount * reward * (1 - iE);
+      if (iE)
+      {
+        nextState = nStepBuffer[i].nextState;
+        isEnd = iE;
+      }
+    }
+  }
+
+  /**
+   * Sample some experiences.  Intended to be called by a single learner
+   * thread, concurrently with any number of `Store()` calls.
+   *
+   * @param sampledStates Sampled encoded states.
+   * @param sampledActions Sampled actions.
+   * @param sampledRewards Sampled rewards.
+   * @param sampledNextStates Sampled encoded next states.
+   * @param isTerminal Indicate whether corresponding next state is terminal
+   *        state.
+   */
+  void Sample(arma::mat& sampledStates,
+              std::vector<ActionType>& sampledActions,
+              arma::rowvec& sampledRewards,
+              arma::mat& sampledNextStates,
+              arma::irowvec& isTerminal)
+  {
+    const size_t upperBound = std::min(
+        cursor.load(std::memory_order_acquire), capacity);
+
+    sampledStates.set_size(states.n_rows, batchSize);
+    sampledRewards.set_size(batchSize);
+    sampledNextStates.set_size(nextStates.n_rows, batchSize);
+    isTerminal.set_size(batchSize);
+
+    for (size_t t = 0; t < batchSize; ++t)
+    {
+      ActionType sampledAction;
+      while (true)
+      {
+        const size_t index = RandInt(upperBound);
+
+        // A slot is readable only while its sequence value is even and
+        // nonzero (zero means it has never been written).
+        const size_t seqBefore =
+            slotSequence[index].load(std::memory_order_acquire);
+        if (seqBefore == 0 || (seqBefore % 2) == 1)
+          continue;
+
+        sampledStates.col(t) = states.col(index);
+        sampledAction = actions[index];
+        sampledRewards(t) = rewards(index);
+        sampledNextStates.col(t) = nextStates.col(index);
+        isTerminal(t) = this->isTerminal(index);
+
+        // The data copy above must complete before the sequence re-check
+        // below; an acquire fence keeps the relaxed re-load from being
+        // reordered before the copy.
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        // If a writer reused the slot while we copied it, the copy may mix
+        // two transitions; discard it and draw another slot.
+        const size_t seqAfter =
+            slotSequence[index].load(std::memory_order_relaxed);
+        if (seqBefore == seqAfter)
+          break;
+      }
+      sampledActions.push_back(sampledAction);
+    }
+  }
+
+  /**
+   * Get the number of transitions in the memory.  This is a snapshot; it may
+   * lag behind concurrent `Store()` calls.
+   *
+   * @return Actual used memory size.
+   */
+  size_t Size()
+  {
+    return std::min(cursor.load(std::memory_order_acquire), capacity);
+  }
+
+  /**
+   * Update the priorities of transitions and Update the gradients.
+   *
+   * @param * (target) The learned value
+   * @param * (sampledActions) Agent's sampled action
+   * @param * (nextActionValues) Agent's next action
+   * @param * (gradients) The model's gradients
+   */
+  void Update(arma::mat /* target */,
+              std::vector<ActionType> /* sampledActions */,
+              arma::mat /* nextActionValues */,
+              arma::mat& /* gradients */)
+  {
+    /* Do nothing for random sampling. */
+  }
+
+  //! Get the number of steps for n-step agent.
+  const size_t& NSteps() const { return nSteps; }
+
+ private:
+  //! Locally-stored number of examples of each sample.
+  size_t batchSize;
+
+  //! Locally-stored total memory limit.
+  size_t capacity;
+
+  //! Locally-stored number of steps to look into the future.
+  size_t nSteps;
+
+  //! Locally-stored buffer containing n consecutive steps.
+  std::deque<Transition> nStepBuffer;
+
+  //! Atomic write cursor; the total number of transitions ever claimed.
+  std::atomic<size_t> cursor;
+
+  //! Per-slot sequence counters; odd while a slot is being written, even once
+  //! it is published.
+  std::vector<std::atomic<size_t>> slotSequence;
+
+  //! Locally-stored encoded previous states.
+  arma::mat states;
+
+  //! Locally-stored previous actions.
+  std::vector<ActionType> actions;
+
+  //! Locally-stored previous rewards.
+  arma::rowvec rewards;
+
+  //! Locally-stored encoded previous next states.
+  arma::mat nextStates;
+
+  //! Locally-stored termination information of previous experience.
+  arma::irowvec isTerminal;
+};
+
+} // namespace mlpack
+
+#endif
@@ -196,14 +196,17 @@ class PrioritizedReplay
    */
   arma::ucolvec SampleProportional()
   {
-    arma::ucolvec idxes(batchSize);
+    arma::ucolvec idxes;
     double totalSum = idxSum.Sum(0, (full ? capacity : position));
     double sumPerRange = totalSum / batchSize;
-    for (size_t bt = 0; bt < batchSize; bt++)
-    {
-      const double mass = arma::randu() * sumPerRange + bt * sumPerRange;
-      idxes(bt) = idxSum.FindPrefixSum(mass);
-    }
+
+    // Generate all stratified masses in one pass.  One random mass is drawn
+    // per stratum, so the masses are ascending by construction and the
+    // sum-tree can resolve the whole batch in a single partitioned descent
+    // instead of one root-to-leaf walk per transition.
+    arma::colvec masses = (arma::regspace<arma::colvec>(0, batchSize - 1) +
+        arma::randu<arma::colvec>(batchSize)) * sumPerRange;
+    idxSum.FindPrefixSumBatch(masses, idxes);
     return idxes;
   }
 
@@ -238,9 +241,12 @@ class PrioritizedReplay
     size_t numSample = full ? capacity : position;
     weights = arma::rowvec(sampledIndices.n_rows);
 
+    // The total priority sum is the same for every sampled transition, so
+    // compute it once instead of once per sample.
+    const double prioritySum = idxSum.Sum();
     for (size_t i = 0; i < sampledIndices.n_rows; ++i)
     {
-      double p_sample = idxSum.Get(sampledIndices(i)) / idxSum.Sum();
+      double p_sample = idxSum.Get(sampledIndices(i)) / prioritySum;
       weights(i) = pow(numSample * p_sample, -beta);
     }
     weights /= weights.max();
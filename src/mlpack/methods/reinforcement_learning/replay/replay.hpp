@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_REINFORCEMENT_LEARNING_REPLAY_REPLAY_HPP
 
 #include "random_replay.hpp"
+#include "lock_free_replay.hpp"
 #include "prioritized_replay.hpp"
 #include "sumtree.hpp"
 
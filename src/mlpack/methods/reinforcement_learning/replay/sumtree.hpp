@@ -68,19 +68,39 @@ class SumTree
   /**
    * Update the data with batch rather loop over the indices with set method.
    *
+   * Only the ancestor paths of the touched leaves are recomputed, in one
+   * bottom-up sweep over the breadth-ordered tree, so the cost is
+   * O(batch * log(capacity)) instead of O(capacity).
+   *
    * @param indices The indices of data to be changed.
    * @param data The data that array with indices to be.
    */
   void BatchUpdate(const arma::ucolvec& indices, const arma::Col<T>& data)
   {
+    // Write the leaves and seed the sweep with their parents.
+    std::vector<size_t> nodes;
+    nodes.reserve(indices.n_rows);
     for (size_t i = 0; i < indices.n_rows; ++i)
     {
       element[indices[i] + capacity] = data[i];
+      if (indices[i] + capacity > 1)
+        nodes.push_back((indices[i] + capacity) / 2);
     }
-    // update the total tree with bottom-up technique.
-    for (size_t i = capacity - 1; i > 0; i--)
+
+    // Recompute the touched internal nodes level by level, deeper nodes
+    // (larger indices) first so that a parent is always recomputed after its
+    // children; duplicates are removed so each ancestor is recomputed once
+    // per level.
+    while (!nodes.empty())
     {
-      element[i] = element[2 * i] + element[2 * i + 1];
+      std::sort(nodes.begin(), nodes.end(), std::greater<size_t>());
+      nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+      if (nodes.back() == 0)
+        nodes.pop_back();
+      for (const size_t node : nodes)
+        element[node] = element[2 * node] + element[2 * node + 1];
+      for (size_t& node : nodes)
+        node /= 2;
     }
   }
 
@@ -177,6 +197,66 @@ class SumTree
     return idx - capacity;
   }
 
+  /**
+   * Resolve a whole batch of prefix-sum queries in one partitioned descent of
+   * the tree.  The masses must be sorted in ascending order (as produced by
+   * stratified sampling); at each node the batch is split once around the
+   * left subtree sum instead of walking the tree from the root for every
+   * query, so shared path prefixes are traversed only once.
+   *
+   * The result for each mass is the same as `FindPrefixSum()` would return.
+   * Note that `masses` is modified in the process.
+   *
+   * @param masses The upper bounds of segment array sums, sorted ascending.
+   * @param indices The resolved array index for each mass.
+   */
+  void FindPrefixSumBatch(arma::Col<T>& masses, arma::ucolvec& indices)
+  {
+    indices.set_size(masses.n_elem);
+    FindPrefixSumBatchHelper(masses, indices, 0, masses.n_elem, 1);
+  }
+
+  /**
+   * Helper function for `FindPrefixSumBatch()`: resolve the sorted masses in
+   * `[begin, end)` against the subtree rooted at `node`.
+   *
+   * @param masses The remaining masses of all queries.
+   * @param indices The resolved array index for each mass.
+   * @param begin First query handled by this subtree.
+   * @param end One past the last query handled by this subtree.
+   * @param node Root of the current subtree.
+   */
+  void FindPrefixSumBatchHelper(arma::Col<T>& masses,
+                                arma::ucolvec& indices,
+                                const size_t begin,
+                                const size_t end,
+                                const size_t node)
+  {
+    if (begin == end)
+      return;
+
+    if (node >= capacity)
+    {
+      for (size_t i = begin; i < end; ++i)
+        indices[i] = node - capacity;
+      return;
+    }
+
+    // Queries whose mass is below the left subtree sum descend left; the
+    // rest descend right with the left sum subtracted (this matches the
+    // branch taken by `FindPrefixSum()`).  Since the masses are sorted, the
+    // batch splits at a single point.
+    const T leftSum = element[2 * node];
+    const size_t split = std::lower_bound(masses.begin() + begin,
+        masses.begin() + end, leftSum) - masses.begin();
+
+    for (size_t i = split; i < end; ++i)
+      masses[i] -= leftSum;
+
+    FindPrefixSumBatchHelper(masses, indices, begin, split, 2 * node);
+    FindPrefixSumBatchHelper(masses, indices, split, end, 2 * node + 1);
+  }
+
  private:
   //! The capacity of the data array.
   size_t capacity;
@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_RL_WORKER_N_STEP_Q_LEARNING_WORKER_HPP
 
 #include <ensmallen.hpp>
+#include <mlpack/core/math/make_alias.hpp>
 #include <mlpack/methods/reinforcement_learning/training_config.hpp>
 
 namespace mlpack {
@@ -81,6 +82,8 @@ class NStepQLearningWorker
       pending(other.pending),
       pendingIndex(other.pendingIndex),
       network(other.network),
+      targetNetwork(other.targetNetwork),
+      targetEpoch(other.targetEpoch),
       state(other.state)
   {
     #if ENS_VERSION_MAJOR >= 2
@@ -111,6 +114,8 @@ class NStepQLearningWorker
       pending(std::move(other.pending)),
       pendingIndex(std::move(other.pendingIndex)),
       network(std::move(other.network)),
+      targetNetwork(std::move(other.targetNetwork)),
+      targetEpoch(std::move(other.targetEpoch)),
       state(std::move(other.state))
   {
     #if ENS_VERSION_MAJOR >= 2
@@ -146,6 +151,8 @@ class NStepQLearningWorker
     pending = other.pending;
     pendingIndex = other.pendingIndex;
     network = other.network;
+    targetNetwork = other.targetNetwork;
+    targetEpoch = other.targetEpoch;
     state = other.state;
 
     #if ENS_VERSION_MAJOR >= 2
@@ -183,6 +190,8 @@ class NStepQLearningWorker
     pending = std::move(other.pending);
     pendingIndex = std::move(other.pendingIndex);
     network = std::move(other.network);
+    targetNetwork = std::move(other.targetNetwork);
+    targetEpoch = std::move(other.targetEpoch);
     state = std::move(other.state);
 
     #if ENS_VERSION_MAJOR >= 2
@@ -208,7 +217,11 @@ class NStepQLearningWorker
   }
 
   /**
-   * Initialize the worker.
+   * Initialize the worker.  This binds the local network's parameters onto
+   * the shared parameter matrix, so the worker must not be copied or moved
+   * afterwards (initialize workers only once they are in their final storage
+   * location).
+   *
    * @param learningNetwork The shared network.
    */
   void Initialize(NetworkType& learningNetwork)
@@ -225,15 +238,26 @@ class NStepQLearningWorker
                                      learningNetwork.Parameters().n_cols);
     #endif
 
-    // Build local network.
+    // Build local network; activations are local, but the parameters alias
+    // the shared parameter matrix, so every forward and backward pass reads
+    // the latest parameters (HOGWILD-style) without whole-network copies.
     network = learningNetwork;
+    arma::mat sharedParameters = MakeAlias(learningNetwork.Parameters(),
+        false);
+    network.Parameters().swap(sharedParameters);
+
+    // The target network keeps a private snapshot of the parameters; it is
+    // refreshed whenever the sync epoch advances.
+    targetNetwork = learningNetwork;
+    targetEpoch = 0;
   }
 
   /**
    * The agent will execute one step.
    *
    * @param learningNetwork The shared learning network.
-   * @param targetNetwork The shared target network.
+   * @param * (globalTargetNetwork) Unused; each worker maintains its own
+   *     target snapshot, refreshed by the sync epoch.
    * @param totalSteps The shared counter for total steps.
    * @param policy The shared behavior policy.
    * @param totalReward This will be the episode return if the episode ends
@@ -241,7 +265,7 @@ class NStepQLearningWorker
    * @return Indicate whether current episode ends after this step.
    */
   bool Step(NetworkType& learningNetwork,
-            NetworkType& targetNetwork,
+            NetworkType& /* globalTargetNetwork */,
             size_t& totalSteps,
             PolicyType& policy,
             double& totalReward)
@@ -264,8 +288,8 @@ class NStepQLearningWorker
       {
         totalReward = episodeReturn;
         Reset();
-        // Sync with latest learning network.
-        network = learningNetwork;
+        // No sync is needed: the local network's parameters alias the
+        // shared parameter matrix.
         return true;
       }
       state = nextState;
@@ -280,6 +304,18 @@ class NStepQLearningWorker
 
     if (terminal || pendingIndex >= config.UpdateInterval())
     {
+      // Refresh the local target network when the sync epoch advances.  The
+      // epoch is derived from the atomically maintained step counter, so
+      // workers agree on epoch boundaries without locking.  (Concurrent
+      // parameter updates may be partially visible in the snapshot; this is
+      // the usual HOGWILD trade-off.)
+      const size_t epoch = totalSteps / config.TargetNetworkSyncInterval();
+      if (epoch != targetEpoch)
+      {
+        targetNetwork.Parameters() = learningNetwork.Parameters();
+        targetEpoch = epoch;
+      }
+
       // Initialize the gradient storage.
       arma::mat totalGradients(learningNetwork.Parameters().n_rows,
           learningNetwork.Parameters().n_cols, arma::fill::zeros);
@@ -289,8 +325,8 @@ class NStepQLearningWorker
       double target = 0;
       if (!terminal)
       {
-        #pragma omp critical
-        { targetNetwork.Predict(nextState.Encode(), actionValue); };
+        // Use the local target network snapshot; no lock is needed.
+        targetNetwork.Predict(nextState.Encode(), actionValue);
         target = actionValue.max();
       }
 
@@ -328,19 +364,11 @@ class NStepQLearningWorker
           config.StepSize(), totalGradients);
       #endif
 
-      // Sync the local network with the global network.
-      network = learningNetwork;
-
+      // No sync is needed: the local network's parameters alias the shared
+      // parameter matrix, so the update above is immediately visible.
       pendingIndex = 0;
     }
 
-    // Update global target network.
-    if (totalSteps % config.TargetNetworkSyncInterval() == 0)
-    {
-      #pragma omp critical
-      { targetNetwork = learningNetwork; }
-    }
-
     policy.Anneal();
 
     if (terminal)
@@ -392,9 +420,16 @@ class NStepQLearningWorker
   //! Current position of the buffer.
   size_t pendingIndex;
 
-  //! Local network of the worker.
+  //! Local network of the worker; its parameters alias the shared parameter
+  //! matrix.
   NetworkType network;
 
+  //! Local target network snapshot of the worker.
+  NetworkType targetNetwork;
+
+  //! The sync epoch the local target network snapshot corresponds to.
+  size_t targetEpoch;
+
   //! Current state of the agent.
   StateType state;
 };
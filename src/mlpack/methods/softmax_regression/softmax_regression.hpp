@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_SOFTMAX_REGRESSION_SOFTMAX_REGRESSION_HPP
 
 #include <mlpack/core.hpp>
+#include <mlpack/methods/logistic_regression/logistic_regression.hpp>
 
 #include "softmax_regression_function.hpp"
 
@@ -203,6 +204,39 @@ class SoftmaxRegression
                OptimizerType optimizer,
                CallbackTypes&&... callbacks);
 
+  /**
+   * Train the model in one-vs-all mode: instead of optimizing all classes
+   * jointly, one binary LogisticRegression model is fit per class (class
+   * members against the rest), and the binary weights are assembled into the
+   * weight matrix.  The binary problems are independent, so they are
+   * dispatched across threads (if OpenMP is enabled), all sharing the
+   * read-only data matrix; for many classes this parallelizes far better
+   * than the joint optimization.
+   *
+   * Classify() then predicts the class whose binary model gives the highest
+   * score.  Note that the probabilities reported by Classify() are a softmax
+   * over the one-vs-all scores, which is not the same (and not as
+   * well-calibrated) as jointly-optimized softmax probabilities; the
+   * predicted labels are the standard one-vs-all predictions.
+   *
+   * Because LogisticRegression always fits an intercept, this method may
+   * only be used if the model was created with fitIntercept = true;
+   * otherwise an exception is thrown.
+   *
+   * @tparam OptimizerType Desired optimizer type for the binary problems.
+   * @param data Input data with each column as one example.
+   * @param labels Labels associated with the feature data.
+   * @param numClasses Number of classes for classification.
+   * @param optimizer Optimizer to use; each binary problem gets its own
+   *     copy.
+   * @return Sum of the objective values of the trained binary models.
+   */
+  template<typename OptimizerType = ens::L_BFGS>
+  double TrainOneVsAll(const arma::mat& data,
+                       const arma::Row<size_t>& labels,
+                       const size_t numClasses,
+                       OptimizerType optimizer = OptimizerType());
+
   //! Sets the number of classes.
   size_t& NumClasses() { return numClasses; }
   //! Gets the number of classes.
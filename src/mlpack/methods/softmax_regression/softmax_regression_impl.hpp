@@ -218,6 +218,52 @@ double SoftmaxRegression::Train(const arma::mat& data,
   return out;
 }
 
+template<typename OptimizerType>
+double SoftmaxRegression::TrainOneVsAll(const arma::mat& data,
+                                        const arma::Row<size_t>& labels,
+                                        const size_t numClasses,
+                                        OptimizerType optimizer)
+{
+  if (!fitIntercept)
+  {
+    throw std::invalid_argument("SoftmaxRegression::TrainOneVsAll(): the "
+        "per-class LogisticRegression models always fit an intercept, so the "
+        "model must be created with fitIntercept = true!");
+  }
+
+  this->numClasses = numClasses;
+  parameters.set_size(numClasses, data.n_rows + 1);
+
+  double totalObjective = 0.0;
+
+  // The binary problems are independent, so dispatch them across threads;
+  // all of them share the read-only data matrix.
+  #pragma omp parallel for schedule(dynamic) reduction(+ : totalObjective)
+  for (size_t c = 0; c < numClasses; ++c)
+  {
+    // Binary responses: 1 for points of class c, 0 for all other points.
+    arma::Row<size_t> responses(labels.n_elem);
+    for (size_t i = 0; i < labels.n_elem; ++i)
+      responses[i] = (labels[i] == c) ? 1 : 0;
+
+    // Each binary problem gets its own copy of the optimizer, since
+    // optimizers may carry state between iterations.
+    LogisticRegression<arma::mat> lr(data.n_rows, lambda);
+    OptimizerType classOptimizer = optimizer;
+    totalObjective += lr.Train(data, responses, classOptimizer);
+
+    // LogisticRegression keeps the intercept in the first element, matching
+    // our fitIntercept layout.
+    parameters.row(c) = lr.Parameters();
+  }
+
+  Log::Info << "SoftmaxRegression::TrainOneVsAll(): sum of final objectives "
+            << "of the " << numClasses << " trained binary models is "
+            << totalObjective << "." << std::endl;
+
+  return totalObjective;
+}
+
 } // namespace mlpack
 
 #endif
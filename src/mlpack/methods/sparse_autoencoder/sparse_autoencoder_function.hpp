@@ -58,6 +58,24 @@ class SparseAutoencoderFunction
    */
   double Evaluate(const arma::mat& parameters) const;
 
+  /**
+   * Evaluates the objective function on a batch of points, so that separable
+   * (mini-batch) optimizers such as SGD can be used.  The reconstruction
+   * error is computed on the batch only; the weight decay and sparsity terms
+   * are scaled by the fraction of the dataset the batch covers, so that the
+   * batch objectives sum to the full objective.  The sparsity term is
+   * evaluated with the running average of the hidden activations maintained
+   * by the batch Gradient() (see there), falling back to the batch average
+   * before the first gradient call.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param begin Index of the first point of the batch.
+   * @param batchSize Number of points in the batch.
+   */
+  double Evaluate(const arma::mat& parameters,
+                  const size_t begin,
+                  const size_t batchSize) const;
+
   /**
    * Evaluates the gradient values of the objective function given the current
    * set of parameters. The function performs a feedforward pass and computes
@@ -69,6 +87,36 @@ class SparseAutoencoderFunction
    */
   void Gradient(const arma::mat& parameters, arma::mat& gradient) const;
 
+  /**
+   * Evaluates the gradient on a batch of points, so that separable
+   * (mini-batch) optimizers such as SGD can be used.  The average hidden
+   * activations that drive the sparsity penalty cannot be computed from a
+   * single batch, so they are maintained as an exponential running average
+   * across batches, seeded by the first batch; the KL divergence deltas are
+   * computed from that running estimate.  On the first call with a batch
+   * spanning the whole dataset, this reduces exactly to the full-batch
+   * gradient.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param begin Index of the first point of the batch.
+   * @param gradient Matrix where gradient values will be stored.
+   * @param batchSize Number of points in the batch.
+   */
+  void Gradient(const arma::mat& parameters,
+                const size_t begin,
+                arma::mat& gradient,
+                const size_t batchSize) const;
+
+  /**
+   * Shuffle the order in which points are visited by the batch Evaluate()
+   * and Gradient() overloads.  The data matrix itself is not modified; only
+   * the internal visitation order changes.
+   */
+  void Shuffle();
+
+  //! Return the number of points in the dataset (for separable optimizers).
+  size_t NumFunctions() const { return data.n_cols; }
+
   /**
    * Returns the elementwise sigmoid of the passed matrix, where the sigmoid
    * function of a real number 'x' is [1 / (1 + exp(-x))].
@@ -149,6 +197,11 @@ class SparseAutoencoderFunction
   const arma::mat& data;
   //! Initial parameter vector.
   arma::mat initialPoint;
+  //! Visitation order of the points for the batch overloads.
+  arma::uvec ordering;
+  //! Running average of the hidden activations across batches; empty until
+  //! the first batch gradient call.
+  mutable arma::vec runningRhoCap;
   //! Size of the visible layer.
   size_t visibleSize;
   //! Size of the hidden layer.
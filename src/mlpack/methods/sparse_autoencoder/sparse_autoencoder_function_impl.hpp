@@ -32,6 +32,10 @@ inline SparseAutoencoderFunction::SparseAutoencoderFunction(
 {
   // Initialize the parameters to suitable values.
   initialPoint = InitializeWeights();
+
+  // The initial visitation order of the points is the identity; Shuffle()
+  // randomizes it.
+  ordering = arma::linspace<arma::uvec>(0, data.n_cols - 1, data.n_cols);
 }
 
 /** Initializes the parameter weights if the initial point is not passed to the
@@ -142,6 +146,62 @@ inline double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters)
   return cost;
 }
 
+/** Evaluates the objective function on a batch of points.
+  */
+inline double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters,
+                                                  const size_t begin,
+                                                  const size_t batchSize) const
+{
+  // Compute the limits for the parameters w1, w2, b1 and b2.
+  const size_t l1 = hiddenSize;
+  const size_t l2 = visibleSize;
+  const size_t l3 = 2 * hiddenSize;
+
+  // Gather the batch according to the current visitation order.
+  const arma::mat batchData = data.cols(
+      ordering.subvec(begin, begin + batchSize - 1));
+
+  arma::mat hiddenLayer, outputLayer;
+
+  // Compute activations of the hidden and output layers.  Both products are
+  // dense matrix-matrix multiplications, so they run through BLAS.
+  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * batchData +
+      arma::repmat(parameters.submat(0, l2, l1 - 1, l2), 1, batchSize),
+      hiddenLayer);
+
+  Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer +
+      arma::repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, batchSize),
+      outputLayer);
+
+  // Batch estimate of the average hidden activations; the sparsity penalty
+  // uses the running estimate maintained by the batch Gradient(), falling
+  // back to the batch estimate before the first gradient call.
+  const arma::vec batchRhoCap = arma::sum(hiddenLayer, 1) / batchSize;
+  const arma::vec& rhoCap = runningRhoCap.is_empty() ? batchRhoCap :
+      runningRhoCap;
+
+  // Difference between the reconstructed data and the original data.
+  const arma::mat diff = outputLayer - batchData;
+
+  // Calculate squared L2-norms of w1 and w2.
+  const double wL2SquaredNorm =
+      arma::accu(parameters.submat(0, 0, l3 - 1, l2 - 1) %
+      parameters.submat(0, 0, l3 - 1, l2 - 1));
+
+  // The reconstruction error is computed on the batch; the weight decay and
+  // KL divergence terms are scaled by the fraction of the dataset the batch
+  // covers, so that the batch objectives sum to the full objective.
+  const double batchFraction = (double) batchSize / data.n_cols;
+  const double sumOfSquaresError =
+      0.5 * arma::accu(diff % diff) / data.n_cols;
+  const double weightDecay = batchFraction * 0.5 * lambda * wL2SquaredNorm;
+  const double klDivergence = batchFraction * beta * arma::accu(rho *
+      arma::log(rho / rhoCap) + (1 - rho) * arma::log((1 - rho) /
+      (1 - rhoCap)));
+
+  return sumOfSquaresError + weightDecay + klDivergence;
+}
+
 /** Calculates and stores the gradient values given a set of parameters.
   */
 inline void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
@@ -212,6 +272,81 @@ inline void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
   gradient.submat(l3, 0, l3, l2 - 1) = (arma::sum(delOut, 1) / data.n_cols).t();
 }
 
+/** Calculates and stores the gradient values on a batch of points.
+  */
+inline void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
+                                                const size_t begin,
+                                                arma::mat& gradient,
+                                                const size_t batchSize) const
+{
+  // Compute the limits for the parameters w1, w2, b1 and b2.
+  const size_t l1 = hiddenSize;
+  const size_t l2 = visibleSize;
+  const size_t l3 = 2 * hiddenSize;
+
+  // Gather the batch according to the current visitation order.
+  const arma::mat batchData = data.cols(
+      ordering.subvec(begin, begin + batchSize - 1));
+
+  arma::mat hiddenLayer, outputLayer;
+
+  // Compute activations of the hidden and output layers.  Both products are
+  // dense matrix-matrix multiplications, so they run through BLAS.
+  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * batchData +
+      arma::repmat(parameters.submat(0, l2, l1 - 1, l2), 1, batchSize),
+      hiddenLayer);
+
+  Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer +
+      arma::repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, batchSize),
+      outputLayer);
+
+  // The average hidden activations cannot be computed from a single batch,
+  // so they are maintained as an exponential running average across batches,
+  // seeded by the first batch.
+  const arma::vec batchRhoCap = arma::sum(hiddenLayer, 1) / batchSize;
+  const double momentum = 0.9;
+  if (runningRhoCap.is_empty())
+    runningRhoCap = batchRhoCap;
+  else
+    runningRhoCap = momentum * runningRhoCap + (1 - momentum) * batchRhoCap;
+
+  // Difference between the reconstructed data and the original data.
+  const arma::mat diff = outputLayer - batchData;
+
+  arma::mat klDivGrad, delOut, delHid;
+
+  // The delta values are computed as in the full-batch Gradient(), with the
+  // KL divergence adjustment driven by the running activation estimate.
+  klDivGrad = beta * (-(rho / runningRhoCap) + (1 - rho) /
+      (1 - runningRhoCap));
+  delOut = diff % outputLayer % (1 - outputLayer);
+  delHid = (parameters.submat(l1, 0, l3 - 1, l2 - 1) * delOut +
+      arma::repmat(klDivGrad, 1, batchSize)) % hiddenLayer %
+      (1 - hiddenLayer);
+
+  gradient.zeros(2 * hiddenSize + 1, visibleSize + 1);
+
+  // The data-dependent terms are divided by the full dataset size and the
+  // regularization terms are scaled by the fraction of the dataset the batch
+  // covers, so that the batch gradients sum to the full gradient.
+  const double batchFraction = (double) batchSize / data.n_cols;
+  gradient.submat(0, 0, l1 - 1, l2 - 1) =
+      delHid * batchData.t() / data.n_cols +
+      batchFraction * lambda * parameters.submat(0, 0, l1 - 1, l2 - 1);
+  gradient.submat(l1, 0, l3 - 1, l2 - 1) =
+      (delOut * hiddenLayer.t() / data.n_cols + batchFraction * lambda *
+      parameters.submat(l1, 0, l3 - 1, l2 - 1).t()).t();
+  gradient.submat(0, l2, l1 - 1, l2) = arma::sum(delHid, 1) / data.n_cols;
+  gradient.submat(l3, 0, l3, l2 - 1) = (arma::sum(delOut, 1) / data.n_cols).t();
+}
+
+/** Shuffles the visitation order of the points for the batch overloads.
+  */
+inline void SparseAutoencoderFunction::Shuffle()
+{
+  ordering = arma::shuffle(ordering);
+}
+
 } // namespace mlpack
 
 #endif
@@ -253,6 +253,17 @@ class SparseCoding
   //! Modify the tolerance for Newton's method (dictionary optimization step).
   double& NewtonTolerance() { return newtonTolerance; }
 
+  //! Get the mini-batch size used during training (0 means full-batch).
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the mini-batch size used during training.  When set to a nonzero
+  //! value smaller than the number of points, each alternation of Train()
+  //! codes a fresh random subset of that many points and updates the
+  //! dictionary from it, instead of coding the entire dataset; on large
+  //! datasets this makes each iteration far cheaper at the cost of a noisy
+  //! objective estimate, so the objective tolerance check becomes unreliable
+  //! and a maximum number of iterations should be set.
+  size_t& BatchSize() { return batchSize; }
+
   //! Serialize the sparse coding model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -275,6 +286,8 @@ class SparseCoding
   double objTolerance;
   //! Tolerance for Newton's method (dictionary training).
   double newtonTolerance;
+  //! Mini-batch size for training (0 means full-batch).
+  size_t batchSize;
 };
 
 } // namespace mlpack
@@ -33,7 +33,8 @@ SparseCoding::SparseCoding(
     lambda2(lambda2),
     maxIterations(maxIterations),
     objTolerance(objTolerance),
-    newtonTolerance(newtonTolerance)
+    newtonTolerance(newtonTolerance),
+    batchSize(0)
 {
   Train(data, initializer);
 }
@@ -50,7 +51,8 @@ inline SparseCoding::SparseCoding(
     lambda2(lambda2),
     maxIterations(maxIterations),
     objTolerance(objTolerance),
-    newtonTolerance(newtonTolerance)
+    newtonTolerance(newtonTolerance),
+    batchSize(0)
 {
   // Nothing to do.
 }
@@ -59,27 +61,35 @@ inline void SparseCoding::Encode(const arma::mat& data,
                                  arma::mat& codes)
 {
   // When using the Cholesky version of LARS, this is correct even if
-  // lambda2 > 0.
+  // lambda2 > 0.  The Gram matrix is computed once per coding pass and shared
+  // read-only by every LARS solve.
   arma::mat matGram = trans(dictionary) * dictionary;
 
+  // Each point is coded independently, so the points are processed in blocks
+  // dispatched across threads; each iteration builds its own LARS object and
+  // writes only its own column of the codes matrix.
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
+  const size_t blockSize = 256;
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < data.n_cols; block += blockSize)
   {
-    // Report progress.
-    if ((i % 100) == 0)
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
-
-    bool useCholesky = true;
-    // Intercept fitting and data normalization is disabled.
-    LARS lars(useCholesky, matGram, lambda1, lambda2,
-        1e-16 /* default tolerance */, false, false);
-
-    // Create an alias of the code (using the same memory), and then LARS will
-    // place the result directly into that; then we will not need to have an
-    // extra copy.
-    arma::vec code = codes.unsafe_col(i);
-    arma::rowvec responses = data.unsafe_col(i).t();
-    lars.Train(dictionary, responses, code, false);
+    const size_t lastCol = std::min(block + blockSize,
+        (size_t) data.n_cols) - 1;
+
+    for (size_t i = block; i <= lastCol; ++i)
+    {
+      bool useCholesky = true;
+      // Intercept fitting and data normalization is disabled.
+      LARS lars(useCholesky, matGram, lambda1, lambda2,
+          1e-16 /* default tolerance */, false, false);
+
+      // Create an alias of the code (using the same memory), and then LARS
+      // will place the result directly into that; then we will not need to
+      // have an extra copy.
+      arma::vec code = codes.unsafe_col(i);
+      arma::rowvec responses = data.unsafe_col(i).t();
+      lars.Train(dictionary, responses, code, false);
+    }
   }
 }
 
@@ -311,17 +321,29 @@ double SparseCoding::Train(
 
   double lastObjVal = DBL_MAX;
 
+  // If a mini-batch size is set, each alternation works on a fresh random
+  // subset of the points instead of the whole dataset; the batch matrix holds
+  // the points the current codes correspond to.
+  const bool miniBatch = (batchSize > 0) && (batchSize < data.n_cols);
+  arma::mat batch;
+  const arma::mat* activeData = &data;
+  if (miniBatch)
+  {
+    batch = data.cols(arma::randperm(data.n_cols, batchSize));
+    activeData = &batch;
+  }
+
   // Take the initial coding step, which has to happen before entering the main
   // optimization loop.
   Log::Info << "Initial coding step." << std::endl;
 
-  arma::mat codes(atoms, data.n_cols);
-  Encode(data, codes);
+  arma::mat codes(atoms, activeData->n_cols);
+  Encode(*activeData, codes);
   arma::uvec adjacencies = find(codes);
 
   Log::Info << "  Sparsity level: " << 100.0 * ((double) (adjacencies.n_elem))
-      / ((double) (atoms * data.n_cols)) << "%." << std::endl;
-  Log::Info << "  Objective value: " << Objective(data, codes) << "."
+      / ((double) (atoms * activeData->n_cols)) << "%." << std::endl;
+  Log::Info << "  Objective value: " << Objective(*activeData, codes) << "."
       << std::endl;
 
   for (size_t t = 1; t != maxIterations; ++t)
@@ -333,23 +355,28 @@ double SparseCoding::Train(
       Log::Info << " of " << maxIterations;
     Log::Info << "." << std::endl;
 
-    // First step: optimize the dictionary.
+    // First step: optimize the dictionary, using the codes of the points the
+    // current batch holds.
     Log::Info << "Performing dictionary step... " << std::endl;
-    OptimizeDictionary(data, codes, adjacencies);
-    Log::Info << "  Objective value: " << Objective(data, codes) << "."
+    OptimizeDictionary(*activeData, codes, adjacencies);
+    Log::Info << "  Objective value: " << Objective(*activeData, codes) << "."
         << std::endl;
 
-    // Second step: perform the coding.
+    // Second step: perform the coding.  In mini-batch mode a new random
+    // subset of the points is drawn first.
     Log::Info << "Performing coding step..." << std::endl;
-    Encode(data, codes);
+    if (miniBatch)
+      batch = data.cols(arma::randperm(data.n_cols, batchSize));
+    Encode(*activeData, codes);
     // Get the indices of all the nonzero elements in the codes.
     adjacencies = find(codes);
     Log::Info << "  Sparsity level: " << 100.0 * ((double) (adjacencies.n_elem))
-        / ((double) (atoms * data.n_cols)) << "%." << std::endl;
+        / ((double) (atoms * activeData->n_cols)) << "%." << std::endl;
 
     // Find the new objective value and improvement so we can check for
-    // convergence.
-    double curObjVal = Objective(data, codes);
+    // convergence.  In mini-batch mode the objective is measured on the
+    // current batch, so it is a noisy estimate of the full objective.
+    double curObjVal = Objective(*activeData, codes);
     double improvement = lastObjVal - curObjVal;
     Log::Info << "  Objective value: " << curObjVal << " (improvement "
         << std::scientific << improvement << ")." << std::endl;
@@ -377,6 +404,9 @@ void SparseCoding::serialize(Archive& ar, const uint32_t /* version */)
   ar(CEREAL_NVP(maxIterations));
   ar(CEREAL_NVP(objTolerance));
   ar(CEREAL_NVP(newtonTolerance));
+
+  if (cereal::is_loading<Archive>())
+    batchSize = 0;
 }
 
 } // namespace mlpack
@@ -111,6 +111,11 @@ class SVDPlusPlusFunction
   //! Return the implicit data passed into the constructor.
   const arma::sp_mat& ImplicitDataset() const { return implicitData; }
 
+  //! Return the cached parameter column indices of the implicit items the
+  //! given user interacted with.
+  const arma::uvec& UserImplicitCols(const size_t user) const
+  { return userImplicitCols[user]; }
+
   //! Return the number of training examples. Useful for SGD optimizer.
   size_t NumFunctions() const { return data.n_cols; }
 
@@ -131,6 +136,9 @@ class SVDPlusPlusFunction
   MatType data;
   //! Implicit feedback data.
   arma::sp_mat implicitData;
+  //! Cached parameter column indices of each user's implicit items, so the
+  //! sparse implicit matrix does not have to be walked for every rating.
+  std::vector<arma::uvec> userImplicitCols;
   //! Initial parameter point.
   arma::mat initialPoint;
   //! Rank used for matrix factorization.
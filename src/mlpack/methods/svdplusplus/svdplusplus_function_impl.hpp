@@ -43,6 +43,22 @@ SVDPlusPlusFunction<MatType>::SVDPlusPlusFunction(
   // Unused:
   //     row(rank).subvec(numUsers + numItems, numUsers + 2 * numItems - 1)
   initialPoint.randu(rank + 1, numUsers + 2 * numItems);
+
+  // Cache the parameter column indices of each user's implicit items once,
+  // so that objective and gradient evaluations can gather the implicit item
+  // vectors with batched submatrix operations instead of walking the sparse
+  // implicit matrix for every rating.
+  const size_t implicitStart = numUsers + numItems;
+  userImplicitCols.resize(numUsers);
+  for (size_t user = 0; user < numUsers; ++user)
+  {
+    std::vector<arma::uword> cols;
+    arma::sp_mat::const_iterator it = this->implicitData.begin_col(user);
+    arma::sp_mat::const_iterator it_end = this->implicitData.end_col(user);
+    for (; it != it_end; ++it)
+      cols.push_back(implicitStart + it.row());
+    userImplicitCols[user] = arma::uvec(cols);
+  }
 }
 
 template<typename MatType>
@@ -55,7 +71,19 @@ void SVDPlusPlusFunction<MatType>::Shuffle()
 template <typename MatType>
 double SVDPlusPlusFunction<MatType>::Evaluate(const arma::mat& parameters) const
 {
-  return Evaluate(parameters, 0, data.n_cols);
+  // The ratings contribute to the objective independently, so the full-batch
+  // evaluation is computed over blocks of ratings dispatched across threads.
+  double objective = 0.0;
+
+  const size_t blockSize = 4096;
+  #pragma omp parallel for schedule(dynamic) reduction(+:objective)
+  for (size_t block = 0; block < data.n_cols; block += blockSize)
+  {
+    const size_t lastCol = std::min(block + blockSize, (size_t) data.n_cols);
+    objective += Evaluate(parameters, block, lastCol - block);
+  }
+
+  return objective;
 }
 
 template <typename MatType>
@@ -93,28 +121,28 @@ double SVDPlusPlusFunction<MatType>::Evaluate(const arma::mat& parameters,
     const double userBias = parameters(rank, user);
     const double itemBias = parameters(rank, item);
 
-    // Iterate through each item which the user interacted with to calculate
-    // user vector.
+    // Gather the implicit item vectors of the user in one batched submatrix
+    // operation to calculate the user vector.
     arma::vec userVec(rank, arma::fill::zeros);
-    arma::sp_mat::const_iterator it = implicitData.begin_col(user);
-    arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
-    size_t implicitCount = 0;
+    const arma::uvec& implicitCols = userImplicitCols[user];
+    const size_t implicitCount = implicitCols.n_elem;
     double regularizationError = 0;
-    for (; it != it_end; ++it)
+    if (implicitCount != 0)
     {
-      userVec += parameters.col(implicitStart + it.row()).subvec(0, rank - 1);
-      if (implicitVecsNormSquare(it.row()) < 0)
+      const arma::mat implicitVecs =
+          parameters(arma::span(0, rank - 1), implicitCols);
+      userVec = arma::sum(implicitVecs, 1) / std::sqrt(implicitCount);
+
+      for (size_t k = 0; k < implicitCount; ++k)
       {
-        implicitVecsNormSquare(it.row()) = arma::dot(
-            parameters.col(implicitStart + it.row()).subvec(0, rank - 1),
-            parameters.col(implicitStart + it.row()).subvec(0, rank - 1));
+        const size_t itemIndex = implicitCols[k] - implicitStart;
+        if (implicitVecsNormSquare(itemIndex) < 0)
+        {
+          implicitVecsNormSquare(itemIndex) = arma::dot(implicitVecs.col(k),
+                                                        implicitVecs.col(k));
+        }
+        regularizationError += lambda * implicitVecsNormSquare(itemIndex);
       }
-      regularizationError += lambda * implicitVecsNormSquare(it.row());
-      implicitCount += 1;
-    }
-    if (implicitCount != 0)
-    {
-      userVec /= std::sqrt(implicitCount);
       regularizationError /= implicitCount;
     }
     userVec += parameters.col(user).subvec(0, rank - 1);
@@ -159,26 +187,23 @@ void SVDPlusPlusFunction<MatType>::Gradient(const arma::mat& parameters,
     // Indices for accessing the the correct parameter columns.
     const size_t user = data(0, i);
     const size_t item = data(1, i) + numUsers;
-    const size_t implicitStart = numUsers + numItems;
 
     // Calculate the squared error in the prediction.
     const double rating = data(2, i);
     const double userBias = parameters(rank, user);
     const double itemBias = parameters(rank, item);
 
-    // Iterate through each item which the user interacted with to calculate
-    // user vector.
+    // Gather the implicit item vectors of the user in one batched submatrix
+    // operation to calculate the user vector.
     arma::vec userVec(rank, arma::fill::zeros);
-    arma::sp_mat::const_iterator it = implicitData.begin_col(user);
-    arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
-    size_t implicitCount = 0;
-    for (; it != it_end; ++it)
+    const arma::uvec& implicitCols = userImplicitCols[user];
+    const size_t implicitCount = implicitCols.n_elem;
+    arma::mat implicitVecs;
+    if (implicitCount != 0)
     {
-      userVec += parameters.col(implicitStart + it.row()).subvec(0, rank - 1);
-      implicitCount += 1;
+      implicitVecs = parameters(arma::span(0, rank - 1), implicitCols);
+      userVec = arma::sum(implicitVecs, 1) / std::sqrt(implicitCount);
     }
-    if (implicitCount != 0)
-      userVec /= std::sqrt(implicitCount);
     userVec += parameters.col(user).subvec(0, rank - 1);
 
     double ratingError = rating - userBias - itemBias -
@@ -196,17 +221,15 @@ void SVDPlusPlusFunction<MatType>::Gradient(const arma::mat& parameters,
         2 * (lambda * parameters(rank, user) - ratingError);
     gradient(rank, item) +=
         2 * (lambda * parameters(rank, item) - ratingError);
-    // Calculate gradients for item implicit vector.
-    it = implicitData.begin_col(user);
-    it_end = implicitData.end_col(user);
-    for (; it != it_end; ++it)
+    // Calculate gradients for the item implicit vectors, scattered back in
+    // one batched submatrix operation.
+    if (implicitCount != 0)
     {
-      // Note that implicitCount != 0 if this loop is acutally executed.
-      gradient.col(implicitStart + it.row()).subvec(0, rank - 1) +=
-          2.0 * (lambda / implicitCount *
-          parameters.col(implicitStart + it.row()).subvec(0, rank - 1) -
-          ratingError / std::sqrt(implicitCount) *
-          parameters.col(item).subvec(0, rank - 1));
+      implicitVecs *= 2.0 * lambda / implicitCount;
+      implicitVecs.each_col() -= 2.0 * ratingError /
+          std::sqrt(implicitCount) *
+          arma::vec(parameters.col(item).subvec(0, rank - 1));
+      gradient(arma::span(0, rank - 1), implicitCols) += implicitVecs;
     }
   }
 }
@@ -220,39 +243,36 @@ void SVDPlusPlusFunction<MatType>::Gradient(const arma::mat& parameters,
 {
   gradient.zeros(rank + 1, numUsers + 2 * numItems);
 
-  // It's possible this could be SIMD-vectorized for additional speedup.
   for (size_t i = start; i < start + batchSize; ++i)
   {
     // Indices for accessing the the correct parameter columns.
     const size_t user = data(0, i);
     const size_t item = data(1, i) + numUsers;
-    const size_t implicitStart = numUsers + numItems;
 
     // Calculate the squared error in the prediction.
     const double rating = data(2, i);
     const double userBias = parameters(rank, user);
     const double itemBias = parameters(rank, item);
 
-    // Iterate through each item which the user interacted with to calculate
-    // user vector.
+    // Gather the implicit item vectors of the user in one batched submatrix
+    // operation to calculate the user vector.
     arma::vec userVec(rank, arma::fill::zeros);
-    arma::sp_mat::const_iterator it = implicitData.begin_col(user);
-    arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
-    size_t implicitCount = 0;
-    for (; it != it_end; ++it)
+    const arma::uvec& implicitCols = userImplicitCols[user];
+    const size_t implicitCount = implicitCols.n_elem;
+    arma::mat implicitVecs;
+    if (implicitCount != 0)
     {
-      userVec += parameters.col(implicitStart + it.row()).subvec(0, rank - 1);
-      implicitCount += 1;
+      implicitVecs = parameters(arma::span(0, rank - 1), implicitCols);
+      userVec = arma::sum(implicitVecs, 1) / std::sqrt(implicitCount);
     }
-    if (implicitCount != 0)
-      userVec /= std::sqrt(implicitCount);
     userVec += parameters.col(user).subvec(0, rank - 1);
 
     double ratingError = rating - userBias - itemBias -
         arma::dot(userVec, parameters.col(item).subvec(0, rank - 1));
 
     // Gradient is non-zero only for the parameter columns corresponding to the
-    // example.
+    // example.  The element-wise writes are kept here because the gradient
+    // may be a sparse type.
     for (size_t j = 0; j < rank; ++j)
     {
       gradient(j, user) +=
@@ -267,16 +287,12 @@ void SVDPlusPlusFunction<MatType>::Gradient(const arma::mat& parameters,
     gradient(rank, item) +=
         2 * (lambda * parameters(rank, item) - ratingError);
     // Calculate gradients for item implicit vector.
-    it = implicitData.begin_col(user);
-    it_end = implicitData.end_col(user);
-    for (; it != it_end; ++it)
+    for (size_t k = 0; k < implicitCount; ++k)
     {
-      // Note that implicitCount != 0 if this loop is acutally executed.
       for (size_t j = 0; j < rank; ++j)
       {
-        gradient(j, implicitStart + it.row()) +=
-            2.0 * (lambda / implicitCount *
-            parameters(j, implicitStart + it.row()) -
+        gradient(j, implicitCols[k]) +=
+            2.0 * (lambda / implicitCount * implicitVecs(j, k) -
             ratingError / std::sqrt(implicitCount) *
             parameters(j, item));
       }
@@ -303,13 +319,10 @@ double StandardSGD::Optimize(
   double overallObjective = 0;
 
   // Calculate the first objective function.
-  for (size_t i = 0; i < numFunctions; ++i)
-    overallObjective += function.Evaluate(parameters, i);
+  overallObjective = function.Evaluate(parameters);
 
   const arma::mat data = function.Dataset();
-  const arma::sp_mat implicitData = function.ImplicitDataset();
   const size_t numUsers = function.NumUsers();
-  const size_t numItems = function.NumItems();
   const double lambda = function.Lambda();
 
   // Rank of decomposition.
@@ -333,26 +346,24 @@ double StandardSGD::Optimize(
     // Indices for accessing the the correct parameter columns.
     const size_t user = data(0, currentFunction);
     const size_t item = data(1, currentFunction) + numUsers;
-    const size_t implicitStart = numUsers + numItems;
 
     // Calculate the squared error in the prediction.
     const double rating = data(2, currentFunction);
     const double userBias = parameters(rank, user);
     const double itemBias = parameters(rank, item);
 
-    // Iterate through each item which the user interacted with to calculate
-    // user vector.
+    // Gather the implicit item vectors of the user in one batched submatrix
+    // operation to calculate the user vector; the gathered matrix is reused
+    // for the implicit vector updates below.
     arma::vec userVec(rank, arma::fill::zeros);
-    arma::sp_mat::const_iterator it = implicitData.begin_col(user);
-    arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
-    size_t implicitCount = 0;
-    for (; it != it_end; ++it)
+    const arma::uvec& implicitCols = function.UserImplicitCols(user);
+    const size_t implicitCount = implicitCols.n_elem;
+    arma::mat implicitVecs;
+    if (implicitCount != 0)
     {
-      userVec += parameters.col(implicitStart + it.row()).subvec(0, rank - 1);
-      implicitCount += 1;
+      implicitVecs = parameters(arma::span(0, rank - 1), implicitCols);
+      userVec = arma::sum(implicitVecs, 1) / std::sqrt(implicitCount);
     }
-    if (implicitCount != 0)
-      userVec /= std::sqrt(implicitCount);
     userVec += parameters.col(user).subvec(0, rank - 1);
 
     double ratingError = rating - userBias - itemBias -
@@ -370,17 +381,15 @@ double StandardSGD::Optimize(
         lambda * parameters(rank, user) - ratingError);
     parameters(rank, item) -= stepSize * 2 * (
         lambda * parameters(rank, item) - ratingError);
-    // Update item implicit vectors.
-    it = implicitData.begin_col(user);
-    it_end = implicitData.end_col(user);
-    for (; it != it_end; ++it)
+    // Update the item implicit vectors, scattered back in one batched
+    // submatrix operation.
+    if (implicitCount != 0)
     {
-      // Note that implicitCount != 0 if this loop is acutally executed.
-      parameters.col(implicitStart + it.row()).subvec(0, rank - 1) -=
-          stepSize * 2.0 * (lambda / implicitCount *
-          parameters.col(implicitStart + it.row()).subvec(0, rank - 1) -
-          ratingError / std::sqrt(implicitCount) *
-          parameters.col(item).subvec(0, rank - 1));
+      implicitVecs *= 1.0 - stepSize * 2.0 * lambda / implicitCount;
+      implicitVecs.each_col() += stepSize * 2.0 * ratingError /
+          std::sqrt(implicitCount) *
+          arma::vec(parameters.col(item).subvec(0, rank - 1));
+      parameters(arma::span(0, rank - 1), implicitCols) = implicitVecs;
     }
 
     // Now add that to the overall objective function.
@@ -405,9 +414,7 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
       (function.NumFunctions() - 1), function.NumFunctions());
 
   const arma::mat data = function.Dataset();
-  const arma::sp_mat implicitData = function.ImplicitDataset();
   const size_t numUsers = function.NumUsers();
-  const size_t numItems = function.NumItems();
   const double lambda = function.Lambda();
 
   // Rank of decomposition.
@@ -470,25 +477,24 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
         // Indices for accessing the the correct parameter columns.
         const size_t user = data(0, visitationOrder[j]);
         const size_t item = data(1, visitationOrder[j]) + numUsers;
-        const size_t implicitStart = numUsers + numItems;
 
         // Prediction error for the example.
         const double rating = data(2, visitationOrder[j]);
         const double userBias = iterate(rank, user);
         const double itemBias = iterate(rank, item);
-        // Iterate through each item which the user interacted with to calculate
-        // user vector.
+
+        // Gather the implicit item vectors of the user in one batched
+        // submatrix operation to calculate the user vector; the gathered
+        // matrix is reused for the implicit vector updates below.
         arma::vec userVec(rank, arma::fill::zeros);
-        arma::sp_mat::const_iterator it = implicitData.begin_col(user);
-        arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
-        size_t implicitCount = 0;
-        for (; it != it_end; ++it)
+        const arma::uvec& implicitCols = function.UserImplicitCols(user);
+        const size_t implicitCount = implicitCols.n_elem;
+        arma::mat implicitVecs;
+        if (implicitCount != 0)
         {
-          userVec += iterate.col(implicitStart + it.row()).subvec(0, rank - 1);
-          implicitCount += 1;
+          implicitVecs = iterate(arma::span(0, rank - 1), implicitCols);
+          userVec = arma::sum(implicitVecs, 1) / std::sqrt(implicitCount);
         }
-        if (implicitCount != 0)
-          userVec /= std::sqrt(implicitCount);
         userVec += iterate.col(user).subvec(0, rank - 1);
 
         double ratingError = rating - userBias - itemBias -
@@ -505,20 +511,16 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
         double itemBiasUpdate = stepSize * 2 * (
             lambda * iterate(rank, item) - ratingError);
 
-        // Update of item implicit vectors.
-        arma::mat itemImplicitUpdate(rank, implicitCount);
-        arma::Col<size_t> implicitItems(implicitCount);
-        it = implicitData.begin_col(user);
-        it_end = implicitData.end_col(user);
-        size_t implicitIndex = 0;
-        for (; it != it_end; ++it, ++implicitIndex)
+        // Update of item implicit vectors, computed in one batched operation
+        // on the gathered implicit item vectors.
+        arma::mat itemImplicitUpdate;
+        if (implicitCount != 0)
         {
-          itemImplicitUpdate.col(implicitIndex) =
-              stepSize * 2.0 * (lambda / implicitCount *
-              iterate.col(implicitStart + it.row()).subvec(0, rank - 1) -
-              ratingError / std::sqrt(implicitCount) *
-              iterate.col(item).subvec(0, rank - 1));
-          implicitItems(implicitIndex) = it.row();
+          itemImplicitUpdate = stepSize * 2.0 * lambda / implicitCount *
+              implicitVecs;
+          itemImplicitUpdate.each_col() -= stepSize * 2.0 * ratingError /
+              std::sqrt(implicitCount) *
+              arma::vec(iterate.col(item).subvec(0, rank - 1));
         }
 
         // Gradient is non-zero only for the parameter columns corresponding to
@@ -539,8 +541,7 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
           for (size_t i = 0; i < rank; ++i)
           {
             #pragma omp atomic
-            iterate(i, implicitStart + implicitItems(k)) -=
-                itemImplicitUpdate(i, k);
+            iterate(i, implicitCols[k]) -= itemImplicitUpdate(i, k);
           }
         }
       }
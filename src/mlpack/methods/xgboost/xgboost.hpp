@@ -0,0 +1,164 @@
+/**
+ * @file methods/xgboost/xgboost.hpp
+ *
+ * Definition of the XGBoost class, a gradient boosted tree ensemble for
+ * regression.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_XGBOOST_HPP
+#define MLPACK_METHODS_XGBOOST_XGBOOST_HPP
+
+#include <mlpack/methods/decision_tree/decision_tree_regressor.hpp>
+#include "loss_functions/sse_loss.hpp"
+
+namespace mlpack {
+
+/**
+ * The XGBoost class implements gradient boosted regression trees, as
+ * described in the paper below:
+ *
+ * @code
+ * @inproceedings{chen2016xgboost,
+ *   title={XGBoost: A Scalable Tree Boosting System},
+ *   author={Chen, Tianqi and Guestrin, Carlos},
+ *   booktitle={Proceedings of the 22nd ACM SIGKDD International Conference on
+ *       Knowledge Discovery and Data Mining},
+ *   pages={785--794},
+ *   year={2016}
+ * }
+ * @endcode
+ *
+ * The model is an additive ensemble: each boosting iteration fits a
+ * regression tree to the negative gradient of the loss at the current
+ * predictions (for the default SSELoss, the residuals), and the tree's
+ * predictions are added to the model scaled by the learning rate.
+ *
+ * Training is built for speed: the weak learner defaults to a
+ * DecisionTreeRegressor using HistogramBinaryNumericSplit, so each split is
+ * found in a single O(n) pass over histogram bins instead of an O(n log n)
+ * sort, and the gradient (residual) vector is a single contiguous array
+ * updated in place between iterations.  Each fitted tree is flattened with
+ * Compile() so that batch prediction uses the cache-friendly array traversal
+ * instead of pointer chasing.
+ *
+ * @tparam LossFunction The loss to minimize; defines the initial prediction
+ *     and the gradient that each tree is fit to.
+ * @tparam NumericSplitType The split strategy used by the weak learners.
+ */
+template<typename LossFunction = SSELoss,
+         template<typename> class NumericSplitType =
+             HistogramBinaryNumericSplit>
+class XGBoost
+{
+ public:
+  //! The type of the weak learners in the ensemble.
+  typedef DecisionTreeRegressor<MSEGain, NumericSplitType> WeakLearnerType;
+
+  /**
+   * Construct the ensemble without any training.  Predict() will throw an
+   * exception until Train() is called.
+   */
+  XGBoost();
+
+  /**
+   * Construct the ensemble by training on the given data and responses.
+   *
+   * @param data Dataset to train on.
+   * @param responses Responses for each training point.
+   * @param numTrees Number of boosting iterations (trees).
+   * @param learningRate Shrinkage applied to each tree's predictions.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for a node to split.
+   * @param maximumDepth Maximum depth of each tree (0 means no limit).
+   */
+  template<typename MatType>
+  XGBoost(const MatType& data,
+          const arma::rowvec& responses,
+          const size_t numTrees = 100,
+          const double learningRate = 0.1,
+          const size_t minimumLeafSize = 10,
+          const double minimumGainSplit = 1e-7,
+          const size_t maximumDepth = 6);
+
+  /**
+   * Train the ensemble on the given data and responses, replacing any
+   * previously trained model.
+   *
+   * @param data Dataset to train on.
+   * @param responses Responses for each training point.
+   * @param numTrees Number of boosting iterations (trees).
+   * @param learningRate Shrinkage applied to each tree's predictions.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for a node to split.
+   * @param maximumDepth Maximum depth of each tree (0 means no limit).
+   * @return The mean squared error of the model on the training set.
+   */
+  template<typename MatType>
+  double Train(const MatType& data,
+               const arma::rowvec& responses,
+               const size_t numTrees = 100,
+               const double learningRate = 0.1,
+               const size_t minimumLeafSize = 10,
+               const double minimumGainSplit = 1e-7,
+               const size_t maximumDepth = 6);
+
+  /**
+   * Predict the response of the given point.  If the ensemble has not been
+   * trained, this will throw an exception.
+   *
+   * @param point Point to predict.
+   */
+  template<typename VecType>
+  double Predict(const VecType& point) const;
+
+  /**
+   * Predict the responses of each point in the given dataset.  If the
+   * ensemble has not been trained, this will throw an exception.
+   *
+   * @param data Dataset to predict on.
+   * @param predictions Output predictions for each point in the dataset.
+   */
+  template<typename MatType>
+  void Predict(const MatType& data, arma::rowvec& predictions) const;
+
+  //! Access a tree in the ensemble.
+  const WeakLearnerType& Tree(const size_t i) const { return trees[i]; }
+  //! Modify a tree in the ensemble (be careful!).
+  WeakLearnerType& Tree(const size_t i) { return trees[i]; }
+
+  //! Get the number of trees in the ensemble.
+  size_t NumTrees() const { return trees.size(); }
+
+  //! Get the learning rate.
+  double LearningRate() const { return learningRate; }
+
+  //! Get the initial prediction (the model's output with zero trees).
+  double InitialPrediction() const { return initialPrediction; }
+
+  /**
+   * Serialize the ensemble.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! The trees in the ensemble.
+  std::vector<WeakLearnerType> trees;
+
+  //! The initial prediction that the trees' outputs are added to.
+  double initialPrediction;
+
+  //! The shrinkage applied to each tree's predictions.
+  double learningRate;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "xgboost_impl.hpp"
+
+#endif
@@ -0,0 +1,163 @@
+/**
+ * @file methods/xgboost/xgboost_impl.hpp
+ *
+ * Implementation of the XGBoost class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_XGBOOST_IMPL_HPP
+#define MLPACK_METHODS_XGBOOST_XGBOOST_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "xgboost.hpp"
+
+namespace mlpack {
+
+template<typename LossFunction,
+         template<typename> class NumericSplitType>
+XGBoost<LossFunction, NumericSplitType>::XGBoost() :
+    initialPrediction(0.0),
+    learningRate(0.1)
+{
+  // Nothing to do here.
+}
+
+template<typename LossFunction,
+         template<typename> class NumericSplitType>
+template<typename MatType>
+XGBoost<LossFunction, NumericSplitType>::XGBoost(
+    const MatType& data,
+    const arma::rowvec& responses,
+    const size_t numTrees,
+    const double learningRate,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth) :
+    initialPrediction(0.0),
+    learningRate(learningRate)
+{
+  // Pass off work to the Train() method.
+  Train(data, responses, numTrees, learningRate, minimumLeafSize,
+      minimumGainSplit, maximumDepth);
+}
+
+template<typename LossFunction,
+         template<typename> class NumericSplitType>
+template<typename MatType>
+double XGBoost<LossFunction, NumericSplitType>::Train(
+    const MatType& data,
+    const arma::rowvec& responses,
+    const size_t numTrees,
+    const double learningRate,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth)
+{
+  trees.clear();
+  trees.reserve(numTrees);
+  this->learningRate = learningRate;
+
+  LossFunction loss;
+  initialPrediction = loss.InitialPrediction(responses);
+
+  // The running ensemble predictions and the per-iteration gradients are kept
+  // as contiguous arrays and updated in place each boosting round.
+  arma::rowvec predictions(responses.n_elem);
+  predictions.fill(initialPrediction);
+  arma::rowvec residuals(responses.n_elem);
+
+  for (size_t i = 0; i < numTrees; ++i)
+  {
+    // Fit the next tree to the negative gradient of the loss at the current
+    // predictions; for SSELoss this is the residual.
+    residuals = responses - predictions;
+    trees.emplace_back(data, residuals, minimumLeafSize, minimumGainSplit,
+        maximumDepth);
+
+    // Flatten the tree so that all later batch prediction (including the
+    // update of the running predictions below) uses the compiled traversal.
+    trees.back().Compile();
+
+    arma::rowvec treePredictions;
+    trees.back().Predict(data, treePredictions);
+    predictions += learningRate * treePredictions;
+  }
+
+  return arma::accu(arma::square(responses - predictions)) /
+      (double) responses.n_elem;
+}
+
+template<typename LossFunction,
+         template<typename> class NumericSplitType>
+template<typename VecType>
+double XGBoost<LossFunction, NumericSplitType>::Predict(
+    const VecType& point) const
+{
+  if (trees.size() == 0)
+  {
+    throw std::invalid_argument("XGBoost::Predict(): no model trained!");
+  }
+
+  double prediction = initialPrediction;
+  for (size_t i = 0; i < trees.size(); ++i)
+    prediction += learningRate * trees[i].Predict(point);
+
+  return prediction;
+}
+
+template<typename LossFunction,
+         template<typename> class NumericSplitType>
+template<typename MatType>
+void XGBoost<LossFunction, NumericSplitType>::Predict(
+    const MatType& data,
+    arma::rowvec& predictions) const
+{
+  if (trees.size() == 0)
+  {
+    predictions.clear();
+
+    throw std::invalid_argument("XGBoost::Predict(): no model trained!");
+  }
+
+  predictions.set_size(data.n_cols);
+  predictions.fill(initialPrediction);
+
+  // Accumulate tree by tree so that each tree's compiled batch traversal is
+  // used; the per-tree predictions stay in one reused buffer.
+  arma::rowvec treePredictions;
+  for (size_t i = 0; i < trees.size(); ++i)
+  {
+    trees[i].Predict(data, treePredictions);
+    predictions += learningRate * treePredictions;
+  }
+}
+
+template<typename LossFunction,
+         template<typename> class NumericSplitType>
+template<typename Archive>
+void XGBoost<LossFunction, NumericSplitType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  size_t numTrees;
+  if (cereal::is_loading<Archive>())
+    trees.clear();
+  else
+    numTrees = trees.size();
+
+  ar(CEREAL_NVP(numTrees));
+
+  // Allocate space if needed.
+  if (cereal::is_loading<Archive>())
+    trees.resize(numTrees);
+
+  ar(CEREAL_NVP(trees));
+  ar(CEREAL_NVP(initialPrediction));
+  ar(CEREAL_NVP(learningRate));
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * @file tests/ann/async_validation_test.cpp
+ *
+ * Tests the AsyncValidation training callback.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann.hpp>
+
+#include "../test_catch_tools.hpp"
+#include "../catch.hpp"
+
+using namespace mlpack;
+
+/**
+ * Training with the AsyncValidation callback should publish validation
+ * objectives without interfering with the result of training.
+ */
+TEST_CASE("AsyncValidationCallbackTest", "[AsyncValidationTest]")
+{
+  // A trivially separable two-class problem, split into training and
+  // validation halves.
+  arma::mat data = arma::join_rows(arma::randn(5, 300) + 2.0,
+                                   arma::randn(5, 300) - 2.0);
+  arma::mat labels = arma::join_rows(arma::zeros(1, 300),
+                                     arma::ones(1, 300));
+
+  arma::uvec ordering = arma::shuffle(
+      arma::linspace<arma::uvec>(0, data.n_cols - 1, data.n_cols));
+  arma::mat shuffledData = data.cols(ordering);
+  arma::mat shuffledLabels = labels.cols(ordering);
+
+  arma::mat trainData = shuffledData.cols(0, 449);
+  arma::mat trainLabels = shuffledLabels.cols(0, 449);
+  arma::mat validData = shuffledData.cols(450, 599);
+  arma::mat validLabels = shuffledLabels.cols(450, 599);
+
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(8);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(2);
+  model.Add<LogSoftMax>();
+
+  AsyncValidation<FFN<NegativeLogLikelihood>> cb(model, validData,
+      validLabels);
+
+  // 15 epochs of SGD; the callback is invoked at the end of each epoch.
+  ens::StandardSGD optimizer(0.01, 32, 15 * trainData.n_cols, 1e-12);
+  model.Train(trainData, trainLabels, optimizer, cb);
+  cb.Wait();
+
+  // At least one evaluation must have been published (evaluations can be
+  // skipped while a previous one is in flight, but the first epoch always
+  // launches one).
+  const std::vector<std::pair<size_t, double>> evals = cb.Evaluations();
+  REQUIRE(evals.size() >= 1);
+  REQUIRE(evals.size() <= 15);
+
+  // The published objectives must be finite, and the best one must match the
+  // history.
+  double best = DBL_MAX;
+  for (size_t i = 0; i < evals.size(); ++i)
+  {
+    REQUIRE(std::isfinite(evals[i].second));
+    best = std::min(best, evals[i].second);
+  }
+  REQUIRE(cb.BestObjective() == Approx(best));
+  REQUIRE(cb.LastObjective() == Approx(evals.back().second));
+
+  // The model itself should have trained successfully on this trivially
+  // separable problem.
+  arma::mat predictions;
+  model.Predict(validData, predictions);
+  size_t correct = 0;
+  for (size_t i = 0; i < validData.n_cols; ++i)
+  {
+    if ((size_t) predictions.col(i).index_max() == (size_t) validLabels[i])
+      ++correct;
+  }
+  REQUIRE(correct >= (size_t) (0.9 * validData.n_cols));
+
+  // An interval of zero is invalid.
+  REQUIRE_THROWS_AS(
+      (AsyncValidation<FFN<NegativeLogLikelihood>>(model, validData,
+          validLabels, 0)),
+      std::invalid_argument);
+}
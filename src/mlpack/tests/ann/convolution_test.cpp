@@ -175,6 +175,14 @@ TEST_CASE("ValidConvolution2DTest", "[ConvolutionTest]")
   Convolution2DMethodTest<NaiveConvolution<ValidConvolution> >(input, filter,
       output);
 
+  // Perform the convolution via im2col and matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<ValidConvolution> >(input, filter,
+      output);
+
+  // Perform the convolution via the Winograd minimal filtering algorithm.
+  Convolution2DMethodTest<WinogradConvolution<ValidConvolution> >(input,
+      filter, output);
+
   // Perform the convolution trough fft.
   Convolution2DMethodTest<FFTConvolution<ValidConvolution> >(input, filter,
       output);
@@ -212,6 +220,14 @@ TEST_CASE("FullConvolution2DTest", "[ConvolutionTest]")
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output);
 
+  // Perform the convolution via im2col and matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output);
+
+  // Perform the convolution via the Winograd minimal filtering algorithm.
+  Convolution2DMethodTest<WinogradConvolution<FullConvolution> >(input,
+      filter, output);
+
   // Perform the convolution trough fft.
   Convolution2DMethodTest<FFTConvolution<FullConvolution> >(input, filter,
       output);
@@ -257,6 +273,14 @@ TEST_CASE("ValidConvolution3DTest", "[ConvolutionTest]")
   Convolution3DMethodTest<NaiveConvolution<ValidConvolution> >(inputCube,
       filterCube, outputCube);
 
+  // Perform the convolution via im2col and matrix multiplication.
+  Convolution3DMethodTest<Im2ColConvolution<ValidConvolution> >(inputCube,
+      filterCube, outputCube);
+
+  // Perform the convolution via the Winograd minimal filtering algorithm.
+  Convolution3DMethodTest<WinogradConvolution<ValidConvolution> >(inputCube,
+      filterCube, outputCube);
+
   // Perform the convolution trough fft.
   Convolution3DMethodTest<FFTConvolution<ValidConvolution> >(inputCube,
       filterCube, outputCube);
@@ -306,6 +330,14 @@ TEST_CASE("FullConvolution3DTest", "[ConvolutionTest]")
   Convolution3DMethodTest<NaiveConvolution<FullConvolution> >(inputCube,
       filterCube, outputCube);
 
+  // Perform the convolution via im2col and matrix multiplication.
+  Convolution3DMethodTest<Im2ColConvolution<FullConvolution> >(inputCube,
+      filterCube, outputCube);
+
+  // Perform the convolution via the Winograd minimal filtering algorithm.
+  Convolution3DMethodTest<WinogradConvolution<FullConvolution> >(inputCube,
+      filterCube, outputCube);
+
   // Perform the convolution trough fft.
   Convolution3DMethodTest<FFTConvolution<FullConvolution> >(inputCube,
       filterCube, outputCube);
@@ -348,6 +380,14 @@ TEST_CASE("ValidConvolutionBatchTest", "[ConvolutionTest]")
   ConvolutionMethodBatchTest<NaiveConvolution<ValidConvolution> >(input,
       filterCube, outputCube);
 
+  // Perform the convolution via im2col and matrix multiplication.
+  ConvolutionMethodBatchTest<Im2ColConvolution<ValidConvolution> >(input,
+      filterCube, outputCube);
+
+  // Perform the convolution via the Winograd minimal filtering algorithm.
+  ConvolutionMethodBatchTest<WinogradConvolution<ValidConvolution> >(input,
+      filterCube, outputCube);
+
   // Perform the convolution trough fft.
   ConvolutionMethodBatchTest<FFTConvolution<ValidConvolution> >(input,
       filterCube, outputCube);
@@ -394,6 +434,14 @@ TEST_CASE("FullConvolutionBatchTest", "[ConvolutionTest]")
   ConvolutionMethodBatchTest<NaiveConvolution<FullConvolution> >(input,
       filterCube, outputCube);
 
+  // Perform the convolution via im2col and matrix multiplication.
+  ConvolutionMethodBatchTest<Im2ColConvolution<FullConvolution> >(input,
+      filterCube, outputCube);
+
+  // Perform the convolution via the Winograd minimal filtering algorithm.
+  ConvolutionMethodBatchTest<WinogradConvolution<FullConvolution> >(input,
+      filterCube, outputCube);
+
   // Perform the convolution trough fft.
   ConvolutionMethodBatchTest<FFTConvolution<FullConvolution> >(input,
       filterCube, outputCube);
@@ -427,6 +475,14 @@ TEST_CASE("Stride2ConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 2, 2, 1, 1);
+
+  // Perform the convolution via im2col and matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 2, 2, 1, 1);
+
+  // The Winograd rule falls back to im2col for non-3x3 filters.
+  Convolution2DMethodTest<WinogradConvolution<FullConvolution> >(input,
+      filter, output, 2, 2, 1, 1);
 }
 
 TEST_CASE("Stride3ConvolutionTest", "[ConvolutionTest]")
@@ -447,6 +503,10 @@ TEST_CASE("Stride3ConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 3, 3, 1, 1);
+
+  // Perform the convolution via im2col and matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 3, 3, 1, 1);
 }
 
 TEST_CASE("UnequalStrideConvolutionTest", "[ConvolutionTest]")
@@ -468,6 +528,10 @@ TEST_CASE("UnequalStrideConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 3, 2, 1, 1);
+
+  // Perform the convolution via im2col and matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 3, 2, 1, 1);
 }
 
 TEST_CASE("Dilation2ConvolutionTest", "[ConvolutionTest]")
@@ -492,6 +556,14 @@ TEST_CASE("Dilation2ConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 1, 1, 2, 2);
+
+  // Perform the convolution via im2col and matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 1, 1, 2, 2);
+
+  // The Winograd rule falls back to im2col for dilated filters.
+  Convolution2DMethodTest<WinogradConvolution<FullConvolution> >(input,
+      filter, output, 1, 1, 2, 2);
 }
 
 TEST_CASE("Dilation3ConvolutionTest", "[ConvolutionTest]")
@@ -517,6 +589,10 @@ TEST_CASE("Dilation3ConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 1, 1, 3, 3);
+
+  // Perform the convolution via im2col and matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 1, 1, 3, 3);
 }
 
 TEST_CASE("UnequalDilationConvolutionTest", "[ConvolutionTest]")
@@ -541,6 +617,10 @@ TEST_CASE("UnequalDilationConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 1, 1, 3, 2);
+
+  // Perform the convolution via im2col and matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 1, 1, 3, 2);
 }
 
 TEST_CASE("DilationAndStrideConvolutionTest", "[ConvolutionTest]")
@@ -562,4 +642,29 @@ TEST_CASE("DilationAndStrideConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 2, 2, 2, 2);
+
+  // Perform the convolution via im2col and matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 2, 2, 2, 2);
+}
+
+/**
+ * Test the Winograd convolution when the output size is not a multiple of the
+ * 2x2 tile size, so that the edge tiles must be cropped.
+ */
+TEST_CASE("WinogradOddSizeConvolutionTest", "[ConvolutionTest]")
+{
+  arma::mat input(5, 7, arma::fill::randu);
+  arma::mat filter(3, 3, arma::fill::randu);
+
+  arma::mat output, winogradOutput;
+  NaiveConvolution<ValidConvolution>::Convolution(input, filter, output);
+  WinogradConvolution<ValidConvolution>::Convolution(input, filter,
+      winogradOutput);
+  CheckMatrices(output, winogradOutput, 1e-5);
+
+  NaiveConvolution<FullConvolution>::Convolution(input, filter, output);
+  WinogradConvolution<FullConvolution>::Convolution(input, filter,
+      winogradOutput);
+  CheckMatrices(output, winogradOutput, 1e-5);
 }
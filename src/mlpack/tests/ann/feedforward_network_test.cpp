@@ -982,3 +982,94 @@ TEST_CASE("RBFNetworkTest", "[FeedForwardNetworkTest]")
   // RBFN neural net with MeanSquaredError.
   TestNetwork<>(model1, dataset, labels1, dataset, labels, 10, 0.1);
 }
+
+/**
+ * Test that Predict() gives the same results independently of the batch size;
+ * when the data does not fit in one batch, the batches are processed in
+ * parallel through per-thread copies of the network.
+ */
+TEST_CASE("PredictParallelBatchTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat dataset(10, 700, arma::fill::randu);
+
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(8);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(3);
+  model.Add<LogSoftMax>();
+
+  // Initialize the weights with a single-batch prediction.
+  arma::mat singleBatchPredictions;
+  model.Predict(dataset, singleBatchPredictions, dataset.n_cols);
+
+  // A smaller batch size takes the multi-batch path, which is parallelized
+  // when OpenMP is enabled; the results must not depend on it.
+  arma::mat predictions;
+  model.Predict(dataset, predictions, 64);
+
+  CheckMatrices(singleBatchPredictions, predictions, 1e-10);
+}
+
+/**
+ * Test that forward passes with varying batch sizes give correct results; the
+ * inter-layer workspace arena is planned for the largest batch size and
+ * aliased into for every smaller one.
+ */
+TEST_CASE("VaryingBatchSizeWorkspaceTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat dataset(10, 100, arma::fill::randu);
+
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(8);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(3);
+  model.Add<LogSoftMax>();
+
+  arma::mat reference;
+  model.Predict(dataset, reference, dataset.n_cols);
+
+  const std::vector<size_t> batchSizes = { 64, 17, 1, 100, 23 };
+  for (const size_t batchSize : batchSizes)
+  {
+    arma::mat output;
+    model.Forward(dataset.cols(0, batchSize - 1), output);
+    CheckMatrices(reference.cols(0, batchSize - 1), output, 1e-10);
+  }
+}
+
+/**
+ * The sharded (possibly multi-threaded) gradient computation should give the
+ * same objective and gradient as accumulating over smaller serial batches.
+ */
+TEST_CASE("EvaluateWithGradientShardedBatchTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(10, 512, arma::fill::randu);
+  arma::mat responses(2, 512, arma::fill::randu);
+
+  FFN<MeanSquaredError> model;
+  model.Add<Linear>(16);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(2);
+  model.Reset(10);
+  model.ResetData(data, responses);
+
+  // Compute the objective and gradient over the whole batch at once; with
+  // OpenMP enabled, this uses the data-parallel path.
+  arma::mat gradient;
+  const double objective =
+      model.EvaluateWithGradient(model.Parameters(), 0, gradient, 512);
+
+  // Now accumulate the same quantities over small serial batches.
+  double refObjective = 0.0;
+  arma::mat refGradient(gradient.n_rows, gradient.n_cols, arma::fill::zeros);
+  for (size_t begin = 0; begin < 512; begin += 8)
+  {
+    arma::mat batchGradient;
+    refObjective += model.EvaluateWithGradient(model.Parameters(), begin,
+        batchGradient, 8);
+    refGradient += batchGradient;
+  }
+
+  REQUIRE(objective == Approx(refObjective));
+  CheckMatrices(gradient, refGradient, 1e-8);
+}
@@ -0,0 +1,106 @@
+/**
+ * @file tests/ann/fused_update_policies_test.cpp
+ *
+ * Tests the fused optimizer update policies.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann.hpp>
+
+#include "../test_catch_tools.hpp"
+#include "../catch.hpp"
+
+using namespace mlpack;
+
+/**
+ * The fused momentum update must produce the same iterates as
+ * ens::MomentumUpdate.
+ */
+TEST_CASE("FusedMomentumUpdateTest", "[FusedUpdatePoliciesTest]")
+{
+  arma::mat reference = arma::randn(100, 1);
+  arma::mat fused = reference;
+
+  ens::MomentumUpdate referenceUpdate(0.9);
+  FusedMomentumUpdate fusedUpdate(0.9);
+
+  ens::MomentumUpdate::Policy<arma::mat, arma::mat> referencePolicy(
+      referenceUpdate, reference.n_rows, reference.n_cols);
+  FusedMomentumUpdate::Policy<arma::mat, arma::mat> fusedPolicy(
+      fusedUpdate, fused.n_rows, fused.n_cols);
+
+  for (size_t step = 0; step < 25; ++step)
+  {
+    const arma::mat gradient = arma::randn(reference.n_rows, 1);
+    referencePolicy.Update(reference, 0.01, gradient);
+    fusedPolicy.Update(fused, 0.01, gradient);
+  }
+
+  REQUIRE(arma::abs(reference - fused).max() == Approx(0.0).margin(1e-12));
+}
+
+/**
+ * The fused Adam update must produce the same iterates as ens::AdamUpdate.
+ */
+TEST_CASE("FusedAdamUpdateTest", "[FusedUpdatePoliciesTest]")
+{
+  arma::mat reference = arma::randn(100, 1);
+  arma::mat fused = reference;
+
+  ens::AdamUpdate referenceUpdate(1e-8, 0.9, 0.999);
+  FusedAdamUpdate fusedUpdate(1e-8, 0.9, 0.999);
+
+  ens::AdamUpdate::Policy<arma::mat, arma::mat> referencePolicy(
+      referenceUpdate, reference.n_rows, reference.n_cols);
+  FusedAdamUpdate::Policy<arma::mat, arma::mat> fusedPolicy(
+      fusedUpdate, fused.n_rows, fused.n_cols);
+
+  for (size_t step = 0; step < 25; ++step)
+  {
+    const arma::mat gradient = arma::randn(reference.n_rows, 1);
+    referencePolicy.Update(reference, 0.01, gradient);
+    fusedPolicy.Update(fused, 0.01, gradient);
+  }
+
+  REQUIRE(arma::abs(reference - fused).max() == Approx(0.0).margin(1e-10));
+}
+
+/**
+ * An FFN should train successfully when the optimizer uses the fused update
+ * policies.
+ */
+TEST_CASE("FusedUpdateFFNTrainingTest", "[FusedUpdatePoliciesTest]")
+{
+  // A trivially separable two-class problem.
+  arma::mat data = arma::join_rows(arma::randn(5, 200) + 2.0,
+                                   arma::randn(5, 200) - 2.0);
+  arma::mat labels = arma::join_rows(arma::zeros(1, 200),
+                                     arma::ones(1, 200));
+
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(8);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(2);
+  model.Add<LogSoftMax>();
+
+  ens::SGD<FusedAdamUpdate> optimizer(0.01, 32, 20 * data.n_cols, 1e-8);
+  model.Train(data, labels, optimizer);
+
+  arma::mat predictions;
+  model.Predict(data, predictions);
+
+  size_t correct = 0;
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    const size_t predicted = predictions.col(i).index_max();
+    if (predicted == (size_t) labels[i])
+      ++correct;
+  }
+
+  // The problem is trivially separable, so accuracy should be high.
+  REQUIRE(correct >= (size_t) (0.9 * data.n_cols));
+}
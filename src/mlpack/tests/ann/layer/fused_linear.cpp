@@ -0,0 +1,123 @@
+/**
+ * @file tests/ann/layer/fused_linear.cpp
+ * @author Ryan Curtin
+ *
+ * Tests the fused linear + activation layer modules.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann.hpp>
+
+#include "../../test_catch_tools.hpp"
+#include "../../catch.hpp"
+#include "../../serialization.hpp"
+#include "../ann_test_tools.hpp"
+
+using namespace mlpack;
+
+/**
+ * The fused layers must compute the same result as a Linear layer followed by
+ * the matching activation.
+ */
+TEST_CASE("SimpleFusedLinearLayerTest", "[ANNLayerTest]")
+{
+  arma::mat weights(5 * 7 + 7, 1, arma::fill::randn);
+  arma::mat input(5, 300, arma::fill::randn);
+
+  Linear linear(7);
+  linear.InputDimensions() = std::vector<size_t>({ 5 });
+  linear.ComputeOutputDimensions();
+  linear.SetWeights(weights.memptr());
+
+  arma::mat linearOutput, expected, output;
+  linear.Forward(input, linearOutput);
+
+  LinearReLU fusedReLU(7);
+  fusedReLU.InputDimensions() = std::vector<size_t>({ 5 });
+  fusedReLU.ComputeOutputDimensions();
+  fusedReLU.SetWeights(weights.memptr());
+
+  fusedReLU.Forward(input, output);
+  RectifierFunction::Fn(linearOutput, expected);
+  CheckMatrices(expected, output, 1e-10);
+
+  LinearSigmoid fusedSigmoid(7);
+  fusedSigmoid.InputDimensions() = std::vector<size_t>({ 5 });
+  fusedSigmoid.ComputeOutputDimensions();
+  fusedSigmoid.SetWeights(weights.memptr());
+
+  fusedSigmoid.Forward(input, output);
+  LogisticFunction::Fn(linearOutput, expected);
+  CheckMatrices(expected, output, 1e-10);
+}
+
+/**
+ * Jacobian fused linear module test.
+ */
+TEST_CASE("JacobianFusedLinearLayerTest", "[ANNLayerTest]")
+{
+  for (size_t i = 0; i < 5; ++i)
+  {
+    const size_t inputElements = RandInt(2, 1000);
+    const size_t outputElements = RandInt(2, 1000);
+
+    arma::mat input;
+    input.set_size(inputElements, 1);
+
+    // The sigmoid variant is used because it is smooth everywhere.
+    LinearSigmoid module(outputElements);
+    arma::mat weights(inputElements * outputElements + outputElements, 1);
+    module.InputDimensions() = std::vector<size_t>({ inputElements });
+    module.ComputeOutputDimensions();
+    module.SetWeights(weights.memptr());
+
+    module.Parameters().randu();
+
+    double error = JacobianTest(module, input);
+    REQUIRE(error <= 1e-5);
+  }
+}
+
+/**
+ * FusedLinear layer numerical gradient test.
+ */
+TEST_CASE("GradientFusedLinearLayerTest", "[ANNLayerTest]")
+{
+  // FusedLinear function gradient instantiation.
+  struct GradientFunction
+  {
+    GradientFunction() :
+        input(arma::randu(10, 1)),
+        target(arma::mat("0"))
+    {
+      model = new FFN<NegativeLogLikelihood, NguyenWidrowInitialization>();
+      model->ResetData(input, target);
+      model->Add<LinearSigmoid>(10);
+      model->Add<Linear>(2);
+      model->Add<LogSoftMax>();
+    }
+
+    ~GradientFunction()
+    {
+      delete model;
+    }
+
+    double Gradient(arma::mat& gradient) const
+    {
+      double error = model->Evaluate(model->Parameters(), 0, 1);
+      model->Gradient(model->Parameters(), 0, gradient, 1);
+      return error;
+    }
+
+    arma::mat& Parameters() { return model->Parameters(); }
+
+    FFN<NegativeLogLikelihood, NguyenWidrowInitialization>* model;
+    arma::mat input, target;
+  } function;
+
+  REQUIRE(CheckGradient(function) <= 1e-4);
+}
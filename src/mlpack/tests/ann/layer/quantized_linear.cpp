@@ -0,0 +1,105 @@
+/**
+ * @file tests/ann/layer/quantized_linear.cpp
+ * @author Ryan Curtin
+ *
+ * Tests the quantized linear layer and FFN::Quantize().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann.hpp>
+
+#include "../../test_catch_tools.hpp"
+#include "../../catch.hpp"
+#include "../../serialization.hpp"
+#include "../ann_test_tools.hpp"
+
+using namespace mlpack;
+
+/**
+ * A QuantizedLinear layer built from the weights of a Linear layer should
+ * produce approximately the same output as the Linear layer itself; the error
+ * is bounded by the int8 quantization step.
+ */
+TEST_CASE("QuantizedLinearApproximationTest", "[ANNLayerTest]")
+{
+  arma::mat weight(7, 10, arma::fill::randn);
+  arma::mat bias(7, 1, arma::fill::randn);
+
+  Linear linear(7);
+  linear.InputDimensions() = std::vector<size_t>({ 10 });
+  linear.ComputeOutputDimensions();
+  arma::mat linearParams(linear.WeightSize(), 1);
+  linear.SetWeights((double*) linearParams.memptr());
+  linear.Weight() = weight;
+  linear.Bias() = bias;
+
+  QuantizedLinear quantized(weight, bias);
+  quantized.InputDimensions() = std::vector<size_t>({ 10 });
+  quantized.ComputeOutputDimensions();
+
+  arma::mat input(10, 50, arma::fill::randn);
+  arma::mat output, quantizedOutput;
+  linear.Forward(input, output);
+  quantized.Forward(input, quantizedOutput);
+
+  REQUIRE(quantizedOutput.n_rows == output.n_rows);
+  REQUIRE(quantizedOutput.n_cols == output.n_cols);
+  REQUIRE(arma::abs(quantizedOutput - output).max() < 0.1);
+}
+
+/**
+ * The backward and gradient passes of a quantized layer should throw.
+ */
+TEST_CASE("QuantizedLinearInferenceOnlyTest", "[ANNLayerTest]")
+{
+  arma::mat weight(3, 5, arma::fill::randn);
+  arma::mat bias(3, 1, arma::fill::randn);
+  QuantizedLinear quantized(weight, bias);
+
+  arma::mat output(3, 2, arma::fill::randn);
+  arma::mat gy(3, 2, arma::fill::randn);
+  arma::mat g, gradient;
+  REQUIRE_THROWS_AS(quantized.Backward(output, gy, g), std::runtime_error);
+  REQUIRE_THROWS_AS(quantized.Gradient(output, gy, gradient),
+      std::runtime_error);
+}
+
+/**
+ * FFN::Quantize() should produce a network whose predictions closely match
+ * the original network's, with every Linear layer replaced by a
+ * QuantizedLinear layer.
+ */
+TEST_CASE("FFNQuantizeTest", "[ANNLayerTest]")
+{
+  FFN<NegativeLogLikelihood, RandomInitialization> network;
+  network.Add<Linear>(8);
+  network.Add<Sigmoid>();
+  network.Add<Linear>(3);
+  network.Add<LogSoftMax>();
+
+  arma::mat input(12, 40, arma::fill::randu);
+  network.Reset(12);
+
+  arma::mat output;
+  network.Predict(input, output);
+
+  FFN<NegativeLogLikelihood, RandomInitialization> quantized =
+      network.Quantize();
+  for (size_t i = 0; i < quantized.Network().size(); ++i)
+  {
+    REQUIRE(dynamic_cast<Linear*>(quantized.Network()[i]) == NULL);
+  }
+  REQUIRE(dynamic_cast<QuantizedLinear*>(quantized.Network()[0]) != NULL);
+  REQUIRE(dynamic_cast<QuantizedLinear*>(quantized.Network()[2]) != NULL);
+
+  arma::mat quantizedOutput;
+  quantized.Predict(input, quantizedOutput);
+
+  REQUIRE(quantizedOutput.n_rows == output.n_rows);
+  REQUIRE(quantizedOutput.n_cols == output.n_cols);
+  REQUIRE(arma::abs(quantizedOutput - output).max() < 0.1);
+}
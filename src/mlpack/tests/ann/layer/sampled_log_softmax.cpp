@@ -0,0 +1,99 @@
+/**
+ * @file tests/ann/layer/sampled_log_softmax.cpp
+ *
+ * Tests the SampledLogSoftMax layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann.hpp>
+
+#include "../../test_catch_tools.hpp"
+#include "../../catch.hpp"
+#include "../../serialization.hpp"
+#include "../ann_test_tools.hpp"
+
+using namespace mlpack;
+
+/**
+ * Outside of training mode the SampledLogSoftMax layer must compute the exact
+ * log-softmax, regardless of the sample size.
+ */
+TEST_CASE("SampledLogSoftMaxExactModeTest", "[ANNLayerTest]")
+{
+  arma::mat input = arma::randn(50, 7);
+  arma::mat exactOutput, sampledOutput, exactDelta, sampledDelta;
+
+  LogSoftMax exact;
+  SampledLogSoftMax sampled(10);
+  REQUIRE(sampled.Training() == false);
+
+  exact.Forward(input, exactOutput);
+  sampled.Forward(input, sampledOutput);
+  // The reference implementation uses an approximate exponential, so a loose
+  // tolerance is needed.
+  REQUIRE(arma::abs(exactOutput - sampledOutput).max() ==
+      Approx(0.0).margin(1e-4));
+
+  arma::mat error = arma::randu(input.n_rows, input.n_cols);
+  exact.Backward(sampledOutput, error, exactDelta);
+  sampled.Backward(sampledOutput, error, sampledDelta);
+  REQUIRE(arma::abs(exactDelta - sampledDelta).max() ==
+      Approx(0.0).margin(1e-4));
+}
+
+/**
+ * In training mode the sampled normalizer should shift every output of a
+ * column by the same amount, the estimate should be unbiased enough to land
+ * near the true log-partition term on average, and the backward pass should
+ * distribute exactly one unit of probability mass over the sampled rows.
+ */
+TEST_CASE("SampledLogSoftMaxSampledModeTest", "[ANNLayerTest]")
+{
+  arma::mat input = arma::randn(400, 3);
+  arma::mat output, exactOutput;
+
+  LogSoftMax exact;
+  exact.Forward(input, exactOutput);
+  // The true log-partition term of the first column.
+  const double trueLogZ = input(0, 0) - exactOutput(0, 0);
+
+  SampledLogSoftMax module(50);
+  module.Training() = true;
+
+  double meanLogZ = 0.0;
+  const size_t trials = 500;
+  for (size_t trial = 0; trial < trials; ++trial)
+  {
+    module.Forward(input, output);
+
+    // Each column is the input shifted by a single scalar.
+    arma::vec shifts = input.col(0) - output.col(0);
+    REQUIRE((shifts.max() - shifts.min()) == Approx(0.0).margin(1e-10));
+
+    meanLogZ += shifts[0] / trials;
+  }
+
+  // The estimator is biased low by Jensen's inequality, but with 50 of 400
+  // outputs sampled it should land close to the true value on average.
+  REQUIRE(meanLogZ == Approx(trueLogZ).margin(0.5));
+
+  // The backward correction is restricted to the sampled rows, and the
+  // importance-weighted probabilities sum to one: for every column, the
+  // difference between the incoming and outgoing error must sum to the
+  // column sum of the incoming error.
+  arma::mat error = arma::randu(input.n_rows, input.n_cols);
+  arma::mat delta;
+  module.Backward(output, error, delta);
+
+  const arma::rowvec colSums = arma::sum(error, 0);
+  const arma::rowvec correction = arma::sum(error - delta, 0);
+  REQUIRE(arma::abs(correction - colSums).max() == Approx(0.0).margin(1e-8));
+
+  // Only numSamples rows may differ from the incoming error.
+  arma::mat changed = arma::abs(error.col(0) - delta.col(0));
+  REQUIRE(arma::accu(changed > 1e-12) <= 50);
+}
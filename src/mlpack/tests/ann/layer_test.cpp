@@ -27,6 +27,7 @@
 #include "layer/c_relu.cpp"
 #include "layer/dropout.cpp"
 #include "layer/flexible_relu.cpp"
+#include "layer/fused_linear.cpp"
 #include "layer/grouped_convolution.cpp"
 #include "layer/hard_tanh.cpp"
 #include "layer/identity.cpp"
@@ -37,7 +38,9 @@
 #include "layer/mean_pooling.cpp"
 #include "layer/padding.cpp"
 #include "layer/parametric_relu.cpp"
+#include "layer/quantized_linear.cpp"
 #include "layer/relu6.cpp"
+#include "layer/sampled_log_softmax.cpp"
 #include "layer/softmax.cpp"
 #include "layer/softmin.cpp"
 #include "layer/ftswish.cpp"
@@ -193,3 +193,66 @@ TEST_CASE("EqualtoRidge", "[BayesianLinearRegressionTest]")
 
   REQUIRE(trial <= 3);
 }
+
+// The cached covariance eigendecomposition must not change the solution:
+// refitting on the same data gives the identical model, and fitting on
+// different data (or with different preprocessing options) invalidates the
+// cache and gives the right new model.
+TEST_CASE("CachedDecompositionRefits", "[BayesianLinearRegressionTest]")
+{
+  arma::mat matX;
+  arma::rowvec y;
+  GenerateProblem(matX, y, 200, 10, 0.5);
+
+  BayesianLinearRegression estimator;
+  estimator.Train(matX, y);
+  const arma::colvec omega = estimator.Omega();
+  const double alpha = estimator.Alpha();
+
+  // Refit on the same data: the cached decomposition is reused and the
+  // solution must be identical.
+  estimator.Train(matX, y);
+  for (size_t i = 0; i < omega.n_elem; ++i)
+    REQUIRE(estimator.Omega()[i] == Approx(omega[i]).epsilon(1e-12));
+  REQUIRE(estimator.Alpha() == Approx(alpha).epsilon(1e-12));
+
+  // Refit on the same data with new responses: the cache still applies, and
+  // the result must match a freshly constructed model.
+  arma::rowvec y2 = y + arma::randn(y.n_elem).t();
+  estimator.Train(matX, y2);
+  BayesianLinearRegression fresh;
+  fresh.Train(matX, y2);
+  for (size_t i = 0; i < omega.n_elem; ++i)
+    REQUIRE(estimator.Omega()[i] == Approx(fresh.Omega()[i]).epsilon(1e-8));
+
+  // Fit on different data: the cache is invalidated and the result must
+  // match a freshly constructed model.
+  arma::mat matX2;
+  arma::rowvec y3;
+  GenerateProblem(matX2, y3, 150, 10, 0.5);
+  estimator.Train(matX2, y3);
+  BayesianLinearRegression fresh2;
+  fresh2.Train(matX2, y3);
+  for (size_t i = 0; i < omega.n_elem; ++i)
+    REQUIRE(estimator.Omega()[i] == Approx(fresh2.Omega()[i]).epsilon(1e-8));
+}
+
+// Changing the preprocessing flags between fits on the same data must also
+// invalidate the cached decomposition.
+TEST_CASE("CachedDecompositionOptionChange", "[BayesianLinearRegressionTest]")
+{
+  arma::mat matX;
+  arma::rowvec y;
+  GenerateProblem(matX, y, 200, 10, 0.5);
+
+  BayesianLinearRegression estimator(true, false);
+  estimator.Train(matX, y);
+
+  estimator.ScaleData() = true;
+  estimator.Train(matX, y);
+
+  BayesianLinearRegression fresh(true, true);
+  fresh.Train(matX, y);
+  for (size_t i = 0; i < estimator.Omega().n_elem; ++i)
+    REQUIRE(estimator.Omega()[i] == Approx(fresh.Omega()[i]).epsilon(1e-8));
+}
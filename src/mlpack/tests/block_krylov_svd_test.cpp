@@ -106,3 +106,41 @@ TEST_CASE("RandomizedBlockKrylovSVDNoisyLowRankTest", "[BlockKrylovSVDTest]")
   double error = arma::max(arma::abs(s1.subvec(0, rank) - s2.subvec(0, rank)));
   REQUIRE(error == Approx(0.0).margin(1e-4));
 }
+
+/*
+ * Repeated Apply() calls on the same object (which reuse the internal
+ * workspace buffers) must keep producing accurate decompositions, for both
+ * tall and wide inputs.
+ */
+TEST_CASE("RandomizedBlockKrylovSVDWorkspaceReuseTest", "[BlockKrylovSVDTest]")
+{
+  arma::mat data;
+  CreateNoisyLowRankMatrix(data, 1000, 200, 5, 0.5);
+
+  const size_t rank = 5;
+
+  arma::mat U1, U2, V1, V2;
+  arma::vec s1, s2;
+
+  arma::svd_econ(U1, s1, V1, data);
+
+  RandomizedBlockKrylovSVD rSVDB(10, 20);
+  for (size_t trial = 0; trial < 3; ++trial)
+  {
+    rSVDB.Apply(data, U2, s2, V2, rank);
+
+    double error = arma::max(arma::abs(s1.subvec(0, rank) -
+        s2.subvec(0, rank)));
+    REQUIRE(error == Approx(0.0).margin(1e-4));
+  }
+
+  // Reuse the same object on a different, wide problem.
+  arma::mat wideData;
+  CreateNoisyLowRankMatrix(wideData, 200, 1000, 5, 0.5);
+
+  arma::svd_econ(U1, s1, V1, wideData);
+  rSVDB.Apply(wideData, U2, s2, V2, rank);
+
+  double error = arma::max(arma::abs(s1.subvec(0, rank) - s2.subvec(0, rank)));
+  REQUIRE(error == Approx(0.0).margin(1e-4));
+}
@@ -432,3 +432,30 @@ TEST_CASE("MoveConstructorAndOperatorCosineTreeTest", "[CosineTreeTest]")
     REQUIRE(v1.at(i) == v3.at(i));
   }
 }
+
+/**
+ * Checks that the blocked cosine computation matches a per-column reference
+ * computation, including columns with zero norm.
+ */
+TEST_CASE("CosineNodeCalculateCosinesTest", "[CosineTreeTest]")
+{
+  // Make a random dataset with one zero column.
+  arma::mat data = arma::randu(50, 700);
+  data.col(123).zeros();
+
+  CosineTree root(data);
+  arma::vec cosines;
+  root.CalculateCosines(cosines);
+
+  // Compare against per-column cosine values with respect to the split point.
+  const arma::vec splitPoint = data.col(root.SplitPointIndex());
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    const size_t index = root.VectorIndices()[i];
+    double reference = 0;
+    if (arma::norm(data.col(index), 2) > 0)
+      reference = std::abs(arma::norm_dot(splitPoint, data.col(index)));
+
+    REQUIRE(cosines(i) == Approx(reference).margin(1e-12));
+  }
+}
@@ -147,6 +147,43 @@ TEST_CASE("ConfusionMatrixTest", "[CVTest]")
   REQUIRE(output(1, 1) == 3);
 }
 
+/**
+ * Test bootstrap resampling of confusion matrices.
+ */
+TEST_CASE("BootstrapConfusionMatrixTest", "[CVTest]")
+{
+  arma::Row<size_t> labels("0 0 1 0 0  1 0 1 0 1");
+  arma::Row<size_t> predictedLabels("0 0 0 0 0  1 1 1 1 1");
+
+  arma::Cube<int> outputs;
+  data::BootstrapConfusionMatrix(predictedLabels, labels, outputs, 2, 50);
+
+  REQUIRE(outputs.n_rows == 2);
+  REQUIRE(outputs.n_cols == 2);
+  REQUIRE(outputs.n_slices == 50);
+
+  // Every replicate counts exactly as many pairs as there are points.
+  for (size_t s = 0; s < outputs.n_slices; ++s)
+    REQUIRE(arma::accu(outputs.slice(s)) == 10);
+
+  // The replicates should be reproducible from the same global random seed.
+  RandomSeed(23);
+  arma::Cube<int> first;
+  data::BootstrapConfusionMatrix(predictedLabels, labels, first, 2, 20);
+  RandomSeed(23);
+  arma::Cube<int> second;
+  data::BootstrapConfusionMatrix(predictedLabels, labels, second, 2, 20);
+  REQUIRE(arma::accu(arma::abs(first - second)) == 0);
+
+  // With all identical pairs the resamples are all the same matrix.
+  arma::Row<size_t> constantLabels(10, arma::fill::ones);
+  arma::Cube<int> constantOutputs;
+  data::BootstrapConfusionMatrix(constantLabels, constantLabels,
+      constantOutputs, 2, 5);
+  for (size_t s = 0; s < constantOutputs.n_slices; ++s)
+    REQUIRE(constantOutputs(1, 1, s) == 10);
+}
+
 /**
  * Test metrics for multiclass classification.
  */
@@ -198,6 +235,62 @@ TEST_CASE("MulticlassClassificationMetricsTest", "[CVTest]")
           == Approx(macroaveragedF1).epsilon(1e-7));
 }
 
+/**
+ * Test that MultiMetric computes the same values as evaluating each metric
+ * separately, from a single inference pass.
+ */
+TEST_CASE("MultiMetricTest", "[CVTest]")
+{
+  // The same setup as in the multiclass metrics test above.
+  arma::mat data = arma::linspace<arma::rowvec>(1.0, 12.0, 12);
+  arma::Row<size_t> labels("0 1  0 1  2 2 1 2  3 3 3 3");
+  arma::Row<size_t> predictedLabels("0 0  1 1  2 2 2 2  3 3 3 3");
+  size_t numClasses = 4;
+
+  NaiveBayesClassifier<> nb(data, predictedLabels, numClasses);
+
+  arma::vec scores = MultiMetric<Accuracy, Precision<Macro>, Recall<Macro>,
+      F1<Macro>>::EvaluateAll(nb, data, labels);
+
+  REQUIRE(scores.n_elem == 4);
+  REQUIRE(scores(0) == Approx(Accuracy::Evaluate(nb, data, labels)));
+  REQUIRE(scores(1) == Approx(Precision<Macro>::Evaluate(nb, data, labels)));
+  REQUIRE(scores(2) == Approx(Recall<Macro>::Evaluate(nb, data, labels)));
+  REQUIRE(scores(3) == Approx(F1<Macro>::Evaluate(nb, data, labels)));
+
+  // The Evaluate() interface should report the first metric, so MultiMetric
+  // can be used wherever a single metric is expected.
+  double accuracy = MultiMetric<Accuracy, F1<Macro>>::Evaluate(nb, data,
+      labels);
+  REQUIRE(accuracy == Approx(Accuracy::Evaluate(nb, data, labels)));
+}
+
+/**
+ * Test MultiMetric for regression metrics, and inside a cross-validation
+ * strategy.
+ */
+TEST_CASE("MultiMetricRegressionTest", "[CVTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(5, 100);
+  arma::rowvec responses = arma::randu<arma::rowvec>(5) * data +
+      0.1 * arma::randn<arma::rowvec>(100);
+
+  LinearRegression lr(data, responses);
+
+  arma::vec scores = MultiMetric<MSE, R2Score<false>>::EvaluateAll(lr, data,
+      responses);
+
+  REQUIRE(scores(0) == Approx(MSE::Evaluate(lr, data, responses)));
+  REQUIRE(scores(1) == Approx(R2Score<false>::Evaluate(lr, data, responses)));
+
+  // MultiMetric should be usable as the metric of a cross-validation
+  // strategy, reporting the first metric.
+  SimpleCV<LinearRegression, MultiMetric<MSE, R2Score<false>>> cv(0.2, data,
+      responses);
+  SimpleCV<LinearRegression, MSE> cvReference(0.2, data, responses);
+  REQUIRE(cv.Evaluate(0.1) == Approx(cvReference.Evaluate(0.1)));
+}
+
 /**
  * Test the mean squared error.
  */
@@ -610,6 +703,32 @@ TEST_CASE("KFoldCVPerceptronTest", "[CVTest]")
   REQUIRE_NOTHROW(cv.Model());
 }
 
+/**
+ * Test that k-fold cross-validation of an algorithm with a randomized
+ * training procedure is reproducible: the folds are seeded
+ * deterministically, so two runs from the same global random seed must
+ * agree even though the folds may train concurrently and in any order.
+ */
+TEST_CASE("KFoldCVDeterminismTest", "[CVTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(5, 100);
+  arma::Row<size_t> labels =
+      arma::randi<arma::Row<size_t>>(100, arma::distr_param(0, 2));
+  const size_t numClasses = 3;
+
+  RandomSeed(17);
+  KFoldCV<SoftmaxRegression<>, Accuracy> cv(5, data, labels, numClasses,
+      false);
+  const double firstScore = cv.Evaluate();
+
+  RandomSeed(17);
+  KFoldCV<SoftmaxRegression<>, Accuracy> cv2(5, data, labels, numClasses,
+      false);
+  const double secondScore = cv2.Evaluate();
+
+  REQUIRE(firstScore == Approx(secondScore).epsilon(1e-10));
+}
+
 /**
  * Test k-fold cross-validation with weighted linear regression.
  */
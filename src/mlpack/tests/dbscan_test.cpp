@@ -335,3 +335,184 @@ TEST_CASE("NoiseConnectionTest", "[DBSCANTest]")
 
   REQUIRE(numClusters == 2);
 }
+
+/**
+ * Check that GridRangeSearch returns exactly the same neighbors as the
+ * tree-based RangeSearch, in both monochromatic and bichromatic mode.
+ */
+TEST_CASE("GridRangeSearchTest", "[DBSCANTest]")
+{
+  arma::mat references(3, 500, arma::fill::randu);
+  arma::mat queries(3, 100, arma::fill::randu);
+  const Range range(0.0, 0.15);
+
+  RangeSearch<> rs(references);
+  GridRangeSearch<> grs(references);
+
+  std::vector<std::vector<size_t>> neighbors, gridNeighbors;
+  std::vector<std::vector<double>> distances, gridDistances;
+
+  // Bichromatic search.
+  rs.Search(queries, range, neighbors, distances);
+  grs.Search(queries, range, gridNeighbors, gridDistances);
+
+  REQUIRE(gridNeighbors.size() == neighbors.size());
+  for (size_t i = 0; i < neighbors.size(); ++i)
+  {
+    // The ordering of the results is not specified, so compare as sets.
+    REQUIRE(gridNeighbors[i].size() == neighbors[i].size());
+    std::vector<size_t> a(neighbors[i]), b(gridNeighbors[i]);
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    for (size_t j = 0; j < a.size(); ++j)
+      REQUIRE(a[j] == b[j]);
+  }
+
+  // Monochromatic search; the query point must not be its own neighbor.
+  rs.Search(range, neighbors, distances);
+  grs.Search(range, gridNeighbors, gridDistances);
+
+  REQUIRE(gridNeighbors.size() == neighbors.size());
+  for (size_t i = 0; i < neighbors.size(); ++i)
+  {
+    REQUIRE(gridNeighbors[i].size() == neighbors[i].size());
+    std::vector<size_t> a(neighbors[i]), b(gridNeighbors[i]);
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    for (size_t j = 0; j < a.size(); ++j)
+      REQUIRE(a[j] == b[j]);
+  }
+}
+
+/**
+ * Check that DBSCAN with the grid backend produces the same partition of the
+ * data as DBSCAN with the default tree-based backend.
+ */
+TEST_CASE("GridDBSCANTest", "[DBSCANTest]")
+{
+  // Three Gaussians plus uniform noise, in 3 dimensions.
+  arma::mat points(3, 900, arma::fill::randn);
+  points *= 0.1;
+  points.cols(300, 599).each_col() += arma::vec("  2.0  2.0  2.0");
+  points.cols(600, 899).each_col() += arma::vec(" -2.0  1.0  0.0");
+  points.insert_cols(900, arma::mat(3, 100, arma::fill::randu) * 8.0 - 4.0);
+
+  DBSCAN<> d(0.2, 5);
+  DBSCAN<GridRangeSearch<>> gridD(0.2, 5);
+
+  arma::Row<size_t> assignments, gridAssignments;
+  const size_t clusters = d.Cluster(points, assignments);
+  const size_t gridClusters = gridD.Cluster(points, gridAssignments);
+
+  REQUIRE(gridClusters == clusters);
+
+  // Cluster numbering may differ, so check that the partitions agree: noise
+  // matches exactly, and the cluster labels map one-to-one.
+  std::map<size_t, size_t> labelMap;
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    if (assignments[i] == SIZE_MAX)
+    {
+      REQUIRE(gridAssignments[i] == SIZE_MAX);
+      continue;
+    }
+
+    REQUIRE(gridAssignments[i] != SIZE_MAX);
+    if (labelMap.count(assignments[i]) == 0)
+      labelMap[assignments[i]] = gridAssignments[i];
+    REQUIRE(labelMap[assignments[i]] == gridAssignments[i]);
+  }
+}
+
+/**
+ * Check that AtomicUnionFind built concurrently gives the same components as
+ * UnionFind built serially from the same edges.
+ */
+TEST_CASE("AtomicUnionFindTest", "[DBSCANTest]")
+{
+  const size_t size = 10000;
+
+  // Generate random edges; chains within blocks of 10 plus random extras.
+  std::vector<std::pair<size_t, size_t>> edges;
+  for (size_t i = 0; i < size; ++i)
+    if (i % 10 != 9)
+      edges.push_back(std::make_pair(i, i + 1));
+  for (size_t i = 0; i < 500; ++i)
+    edges.push_back(std::make_pair((size_t) RandInt(size),
+                                   (size_t) RandInt(size)));
+
+  UnionFind uf(size);
+  for (size_t i = 0; i < edges.size(); ++i)
+    uf.Union(edges[i].first, edges[i].second);
+
+  AtomicUnionFind auf(size);
+  #pragma omp parallel for
+  for (size_t i = 0; i < edges.size(); ++i)
+    auf.Union(edges[i].first, edges[i].second);
+
+  // The components must be identical: two elements share a root in one
+  // structure exactly when they share a root in the other.
+  for (size_t i = 1; i < size; ++i)
+  {
+    const bool sameSerial = (uf.Find(i) == uf.Find(i - 1));
+    const bool sameAtomic = (auf.Find(i) == auf.Find(i - 1));
+    REQUIRE(sameSerial == sameAtomic);
+  }
+}
+
+/**
+ * Check that the sampled core-point test produces clusterings that agree with
+ * exact DBSCAN on well-separated Gaussians.
+ */
+TEST_CASE("SampledClusterTest", "[DBSCANTest]")
+{
+  arma::mat points(3, 920);
+
+  GaussianDistribution g1(3), g2(3), g3(3);
+  g1.Mean() = arma::vec("0.0 0.0 0.0");
+  g2.Mean() = arma::vec("6.0 6.0 8.0");
+  g3.Mean() = arma::vec("-6.0 1.0 -7.0");
+  for (size_t i = 0; i < 300; ++i)
+    points.col(i) = g1.Random();
+  for (size_t i = 300; i < 600; ++i)
+    points.col(i) = g2.Random();
+  for (size_t i = 600; i < 900; ++i)
+    points.col(i) = g3.Random();
+  // A few scattered points far from everything, which should remain noise.
+  for (size_t i = 900; i < 920; ++i)
+    points.col(i) = 50.0 * arma::randu<arma::vec>(3) + 20.0;
+
+  DBSCAN<> exact(2.0, 5);
+  arma::Row<size_t> exactAssignments;
+  const size_t exactClusters = exact.Cluster(points, exactAssignments);
+
+  DBSCAN<> sampled(2.0, 5);
+  sampled.MaxSampleSize() = 300;
+  sampled.Agreement() = 0.99;
+  arma::Row<size_t> sampledAssignments;
+  const size_t sampledClusters = sampled.Cluster(points, sampledAssignments);
+
+  REQUIRE(sampledClusters == exactClusters);
+
+  // Cluster numbering may differ, and the sampled test is allowed to disagree
+  // on a small fraction of points; map sampled labels to exact labels and
+  // count the disagreements.
+  std::map<size_t, size_t> labelMap;
+  size_t disagreements = 0;
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    if (sampledAssignments[i] == SIZE_MAX || exactAssignments[i] == SIZE_MAX)
+    {
+      if (sampledAssignments[i] != exactAssignments[i])
+        ++disagreements;
+      continue;
+    }
+
+    if (labelMap.count(sampledAssignments[i]) == 0)
+      labelMap[sampledAssignments[i]] = exactAssignments[i];
+    if (labelMap[sampledAssignments[i]] != exactAssignments[i])
+      ++disagreements;
+  }
+
+  REQUIRE(disagreements <= (size_t) (0.05 * points.n_cols));
+}
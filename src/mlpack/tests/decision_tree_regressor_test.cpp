@@ -462,6 +462,108 @@ TEST_CASE("RandomBinaryNumericSplitNoGainTest_", "[DecisionTreeRegressorTest]")
   REQUIRE(gain == DBL_MAX);
 }
 
+/**
+ * Check that the HistogramBinaryNumericSplit will split on an obviously
+ * splittable dimension.
+ */
+TEST_CASE("HistogramBinaryNumericSplitSimpleSplitTest_",
+    "[DecisionTreeRegressorTest]")
+{
+  arma::rowvec predictors =
+      { 0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.0 };
+  arma::rowvec responses =
+      { 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+  arma::rowvec weights(responses.n_elem);
+  weights.ones();
+
+  double splitInfo;
+  HistogramBinaryNumericSplit<MADGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  MADGain f;
+  const double bestGain = f.Evaluate<false>(responses, weights);
+  const double gain =
+      HistogramBinaryNumericSplit<MADGain>::SplitIfBetter<false>(bestGain,
+      predictors, responses, weights, 3, 1e-7, splitInfo, aux, f);
+  const double weightedGain =
+      HistogramBinaryNumericSplit<MADGain>::SplitIfBetter<true>(bestGain,
+      predictors, responses, weights, 3, 1e-7, splitInfo, aux, f);
+
+  // Make sure that a split was made.
+  REQUIRE(gain > bestGain);
+
+  // Make sure weight works and is not different than the unweighted one.
+  REQUIRE(gain == weightedGain);
+
+  // The split value is a bin boundary, which must separate 0.4 from 0.5.
+  REQUIRE(splitInfo > 0.4);
+  REQUIRE(splitInfo < 0.5);
+}
+
+/**
+ * Check that the HistogramBinaryNumericSplit won't split if not enough points
+ * are given.
+ */
+TEST_CASE("HistogramBinaryNumericSplitMinSamplesTest_",
+    "[DecisionTreeRegressorTest]")
+{
+  arma::rowvec predictors =
+      { 0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.0 };
+  arma::rowvec responses =
+      { 0.5, 0.5, 0.5, 0.5, 0.5, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+  arma::rowvec weights(responses.n_elem);
+
+  double splitInfo;
+  HistogramBinaryNumericSplit<MSEGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  MSEGain f;
+  const double bestGain = f.Evaluate<false>(responses, weights);
+  const double gain =
+      HistogramBinaryNumericSplit<MSEGain>::SplitIfBetter<false>(bestGain,
+      predictors, responses, weights, 8, 1e-7, splitInfo, aux, f);
+  // This should make no difference because it won't split at all.
+  const double weightedGain =
+      HistogramBinaryNumericSplit<MSEGain>::SplitIfBetter<true>(bestGain,
+      predictors, responses, weights, 8, 1e-7, splitInfo, aux, f);
+
+  // Make sure that no split was made.
+  REQUIRE(gain == DBL_MAX);
+  REQUIRE(gain == weightedGain);
+}
+
+/**
+ * Check that the HistogramBinaryNumericSplit doesn't split a dimension that
+ * gives no gain.
+ */
+TEST_CASE("HistogramBinaryNumericSplitNoGainTest_",
+    "[DecisionTreeRegressorTest]")
+{
+  arma::rowvec predictors(100);
+  arma::rowvec responses(100);
+  arma::rowvec weights;
+  for (size_t i = 0; i < 100; i += 2)
+  {
+    predictors[i] = i;
+    responses[i] = 0.0;
+    predictors[i + 1] = i;
+    responses[i + 1] = 1.0;
+  }
+
+  double splitInfo;
+  HistogramBinaryNumericSplit<MSEGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  MSEGain f;
+  const double bestGain = f.Evaluate<false>(responses, weights);
+  const double gain =
+      HistogramBinaryNumericSplit<MSEGain>::SplitIfBetter<false>(bestGain,
+      predictors, responses, weights, 10, 1e-7, splitInfo, aux, f);
+
+  // Make sure there was no split.
+  REQUIRE(gain == DBL_MAX);
+}
+
 /**
  * A basic construction of the decision tree---ensure that we can create the
  * tree and that it split at least once.
@@ -752,6 +854,39 @@ TEST_CASE("NumericalBuildTestWithWeights", "[DecisionTreeRegressorTest]")
   REQUIRE(rmse < 1.0);
 }
 
+/**
+ * Test that a compiled (flattened) tree gives exactly the same predictions as
+ * the pointer-based tree.
+ */
+TEST_CASE("CompiledTreePredictTest", "[DecisionTreeRegressorTest]")
+{
+  arma::mat X;
+  arma::rowvec Y;
+
+  if (!data::Load("lars_dependent_x.csv", X))
+    FAIL("Cannot load dataset lars_dependent_x.csv");
+  if (!data::Load("lars_dependent_y.csv", Y))
+    FAIL("Cannot load dataset lars_dependent_y.csv");
+
+  arma::mat XTrain, XTest;
+  arma::rowvec YTrain, YTest;
+  data::Split(X, Y, XTrain, XTest, YTrain, YTest, 0.3);
+
+  DecisionTreeRegressor<> tree(XTrain, YTrain, 5);
+
+  // Get predictions from the pointer-based tree.
+  arma::rowvec predictions, compiledPredictions;
+  tree.Predict(XTest, predictions);
+
+  // Flatten the tree and predict again.
+  tree.Compile();
+  tree.Predict(XTest, compiledPredictions);
+
+  REQUIRE(compiledPredictions.n_elem == predictions.n_elem);
+  REQUIRE(arma::approx_equal(compiledPredictions, predictions, "absdiff",
+      1e-10));
+}
+
 /**
  * Test that we can build a decision tree on a simple categorical dataset.
  */
@@ -369,6 +369,84 @@ TEST_CASE("BestBinaryNumericSplitNoGainTest", "[DecisionTreeTest]")
   REQUIRE(classProbabilities.n_elem == 0);
 }
 
+/**
+ * Check that the sparse overload of BestBinaryNumericSplit finds exactly the
+ * same split as the dense overload, for both the weighted and unweighted
+ * variants.
+ */
+TEST_CASE("BestBinaryNumericSplitSparseTest", "[DecisionTreeTest]")
+{
+  // A dimension with negative, zero and positive values, as one-hot or
+  // TF-IDF style features would have after centering.
+  arma::rowvec values(
+      "-0.5 0.0 0.0 0.3 0.0 -0.2 0.0 0.8 0.0 0.0 0.1 0.0 0.6 0.0 0.4");
+  arma::Row<size_t> labels("0 0 0 1 0 0 0 1 0 0 1 0 1 0 1");
+  arma::rowvec weights(labels.n_elem, arma::fill::randu);
+  weights += 0.5;
+
+  arma::sp_rowvec sparseValues(values);
+
+  arma::vec denseProbabilities, sparseProbabilities;
+  BestBinaryNumericSplit<GiniGain>::AuxiliarySplitInfo aux;
+
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double denseGain =
+      BestBinaryNumericSplit<GiniGain>::SplitIfBetter<false>(bestGain, values,
+      labels, 2, weights, 3, 1e-7, denseProbabilities, aux);
+  const double sparseGain =
+      BestBinaryNumericSplit<GiniGain>::SplitIfBetter<false>(bestGain,
+      sparseValues, labels, 2, weights, 3, 1e-7, sparseProbabilities, aux);
+
+  // The unweighted variants work on exact counts, so the results must be
+  // identical.
+  REQUIRE(denseGain == sparseGain);
+  REQUIRE(denseProbabilities.n_elem == 1);
+  REQUIRE(sparseProbabilities.n_elem == 1);
+  REQUIRE(denseProbabilities[0] == sparseProbabilities[0]);
+
+  const double denseWeightedGain =
+      BestBinaryNumericSplit<GiniGain>::SplitIfBetter<true>(bestGain, values,
+      labels, 2, weights, 3, 1e-7, denseProbabilities, aux);
+  const double sparseWeightedGain =
+      BestBinaryNumericSplit<GiniGain>::SplitIfBetter<true>(bestGain,
+      sparseValues, labels, 2, weights, 3, 1e-7, sparseProbabilities, aux);
+
+  // The weighted variants accumulate the weights in a different order, so
+  // allow floating point noise.
+  REQUIRE(denseWeightedGain == Approx(sparseWeightedGain).epsilon(1e-10));
+  REQUIRE(denseProbabilities[0] ==
+      Approx(sparseProbabilities[0]).epsilon(1e-10));
+}
+
+/**
+ * Make sure a decision tree trained directly on a sparse matrix is identical
+ * to one trained on the densified version of the same data.
+ */
+TEST_CASE("SparseNumericBuildTest", "[DecisionTreeTest]")
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load test dataset vc2.csv!");
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt!");
+
+  arma::sp_mat sparseDataset(dataset);
+
+  DecisionTree<> denseTree(dataset, labels, 3, 10);
+  DecisionTree<> sparseTree(sparseDataset, labels, 3, 10);
+
+  // Both trees should make identical predictions, since the sparse split
+  // search evaluates exactly the same candidate splits as the dense one.
+  arma::Row<size_t> densePredictions, sparsePredictions;
+  denseTree.Classify(dataset, densePredictions);
+  sparseTree.Classify(dataset, sparsePredictions);
+
+  REQUIRE(densePredictions.n_elem == sparsePredictions.n_elem);
+  for (size_t i = 0; i < densePredictions.n_elem; ++i)
+    REQUIRE(densePredictions[i] == sparsePredictions[i]);
+}
+
 /**
  * Check that the RandomBinaryNumericSplit won't split if not enough points are
  * given.
@@ -468,6 +546,104 @@ TEST_CASE("RandomBinaryNumericSplitDiffSplitTest", "[DecisionTreeTest]")
   REQUIRE(classProbabilities[0] != classProbabilities1[0]);
 }
 
+/**
+ * Check that the HistogramBinaryNumericSplit will split on an obviously
+ * splittable dimension.
+ */
+TEST_CASE("HistogramBinaryNumericSplitSimpleSplitTest", "[DecisionTreeTest]")
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec classProbabilities;
+  HistogramBinaryNumericSplit<GiniGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain =
+      HistogramBinaryNumericSplit<GiniGain>::SplitIfBetter<false>(bestGain,
+      values, labels, 2, weights, 3, 1e-7, classProbabilities, aux);
+  const double weightedGain =
+      HistogramBinaryNumericSplit<GiniGain>::SplitIfBetter<true>(bestGain,
+      values, labels, 2, weights, 3, 1e-7, classProbabilities, aux);
+
+  // Make sure that a split was made.
+  REQUIRE(gain > bestGain);
+
+  // Make sure weight works and is not different than the unweighted one.
+  REQUIRE(gain == weightedGain);
+
+  // The split is perfect, so we should be able to accomplish a gain of 0.
+  REQUIRE(gain == Approx(0.0).margin(1e-7));
+
+  // The split value is a bin boundary, which must separate 0.4 from 0.5.
+  REQUIRE(classProbabilities.n_elem == 1);
+  REQUIRE(classProbabilities[0] > 0.4);
+  REQUIRE(classProbabilities[0] < 0.5);
+}
+
+/**
+ * Check that the HistogramBinaryNumericSplit won't split if not enough points
+ * are given.
+ */
+TEST_CASE("HistogramBinaryNumericSplitMinSamplesTest", "[DecisionTreeTest]")
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+
+  arma::vec classProbabilities;
+  HistogramBinaryNumericSplit<GiniGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain =
+      HistogramBinaryNumericSplit<GiniGain>::SplitIfBetter<false>(bestGain,
+      values, labels, 2, weights, 8, 1e-7, classProbabilities, aux);
+  // This should make no difference because it won't split at all.
+  const double weightedGain =
+      HistogramBinaryNumericSplit<GiniGain>::SplitIfBetter<true>(bestGain,
+      values, labels, 2, weights, 8, 1e-7, classProbabilities, aux);
+
+  // Make sure that no split was made.
+  REQUIRE(gain == DBL_MAX);
+  REQUIRE(gain == weightedGain);
+  REQUIRE(classProbabilities.n_elem == 0);
+}
+
+/**
+ * Check that the HistogramBinaryNumericSplit doesn't split a dimension that
+ * gives no gain.
+ */
+TEST_CASE("HistogramBinaryNumericSplitNoGainTest", "[DecisionTreeTest]")
+{
+  arma::vec values(100);
+  arma::Row<size_t> labels(100);
+  arma::rowvec weights;
+  for (size_t i = 0; i < 100; i += 2)
+  {
+    values[i] = i;
+    labels[i] = 0;
+    values[i + 1] = i;
+    labels[i + 1] = 1;
+  }
+
+  arma::vec classProbabilities;
+  HistogramBinaryNumericSplit<GiniGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain =
+      HistogramBinaryNumericSplit<GiniGain>::SplitIfBetter<false>(bestGain,
+      values, labels, 2, weights, 10, 1e-7, classProbabilities, aux);
+
+  // Make sure there was no split.
+  REQUIRE(gain == DBL_MAX);
+  REQUIRE(classProbabilities.n_elem == 0);
+}
+
 /**
  * Check that the AllCategoricalSplit will split when the split is obviously
  * better.
@@ -887,6 +1063,51 @@ TEST_CASE("CategoricalBuildTest", "[DecisionTreeTest]")
   REQUIRE(correctPct > 0.70);
 }
 
+/**
+ * Test that a compiled (flattened) tree gives exactly the same predictions and
+ * probabilities as the pointer-based tree.
+ */
+TEST_CASE("CompiledTreeClassifyTest", "[DecisionTreeTest]")
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  // Split into a training set and a test set.
+  arma::mat trainingData = d.cols(0, 1999);
+  arma::mat testData = d.cols(2000, 3999);
+  arma::Row<size_t> trainingLabels = l.subvec(0, 1999);
+
+  // Build the tree.
+  DecisionTree<> tree(trainingData, di, trainingLabels, 5, 10);
+
+  // Get predictions from the pointer-based tree.
+  arma::Row<size_t> predictions, compiledPredictions;
+  arma::mat probabilities, compiledProbabilities;
+  tree.Classify(testData, predictions, probabilities);
+
+  // Flatten the tree and classify again.
+  tree.Compile();
+  tree.Classify(testData, compiledPredictions, compiledProbabilities);
+
+  REQUIRE(compiledPredictions.n_elem == predictions.n_elem);
+  for (size_t i = 0; i < predictions.n_elem; ++i)
+    REQUIRE(compiledPredictions[i] == predictions[i]);
+  REQUIRE(arma::approx_equal(compiledProbabilities, probabilities, "absdiff",
+      1e-10));
+
+  // Retraining must invalidate the flattened representation; ensure the
+  // retrained tree still classifies correctly.
+  tree.Train(trainingData, di, trainingLabels, 5, 10);
+  tree.Classify(testData, compiledPredictions);
+  size_t correct = 0;
+  for (size_t i = 0; i < testData.n_cols; ++i)
+    if (l[2000 + i] == compiledPredictions[i])
+      ++correct;
+  REQUIRE(double(correct) / double(testData.n_cols) > 0.70);
+}
+
 /**
  * Test that we can build a decision tree with weights on a simple categorical
  * dataset.
@@ -1538,3 +1538,181 @@ TEST_CASE("DiagonalGaussianWeightedParametersReductionTest",
     REQUIRE(d1.Covariance()(i) == Approx(d2.Covariance()(i)).epsilon(1e-7));
   }
 }
+
+/*****************************************************/
+/** Low-Rank Gaussian Distribution Tests            **/
+/*****************************************************/
+
+/**
+ * The factored LogProbability() must agree with a full-covariance
+ * GaussianDistribution built on the reconstructed covariance
+ * diag(noise) + factors * factors^T.
+ */
+TEST_CASE("LowRankGaussianDistributionLogProbabilityTest",
+          "[DistributionTest]")
+{
+  const size_t d = 8;
+  const size_t r = 2;
+
+  arma::vec mean(d, arma::fill::randu);
+  arma::vec noise(d, arma::fill::randu);
+  noise += 0.5; // Keep the noise well away from zero.
+  arma::mat factors(d, r, arma::fill::randn);
+
+  LowRankGaussianDistribution lr(mean, noise, factors);
+  GaussianDistribution full(mean,
+      arma::diagmat(noise) + factors * factors.t());
+
+  REQUIRE(lr.Dimensionality() == d);
+  REQUIRE(lr.Rank() == r);
+
+  arma::mat observations(d, 50, arma::fill::randn);
+  arma::vec lrLogProbs, fullLogProbs;
+  lr.LogProbability(observations, lrLogProbs);
+  full.LogProbability(observations, fullLogProbs);
+
+  for (size_t i = 0; i < observations.n_cols; ++i)
+  {
+    REQUIRE(lrLogProbs[i] == Approx(fullLogProbs[i]).epsilon(1e-7));
+    // The single-observation overload must agree with the batch overload.
+    REQUIRE(lr.LogProbability(observations.col(i)) ==
+        Approx(lrLogProbs[i]).epsilon(1e-10));
+  }
+
+  // A rank-0 factored Gaussian must match the diagonal Gaussian.
+  LowRankGaussianDistribution diag(mean, noise, arma::mat(d, 0));
+  DiagonalGaussianDistribution diagRef(mean, noise);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    REQUIRE(diag.LogProbability(observations.col(i)) ==
+        Approx(diagRef.LogProbability(observations.col(i))).epsilon(1e-10));
+  }
+}
+
+/**
+ * Random() must produce samples with approximately the right mean and
+ * covariance.
+ */
+TEST_CASE("LowRankGaussianDistributionRandomTest", "[DistributionTest]")
+{
+  arma::vec mean = { 1.0, -2.0, 0.5 };
+  arma::vec noise = { 0.2, 0.3, 0.25 };
+  arma::mat factors = { { 1.0, 0.0 }, { 0.5, 0.5 }, { 0.0, -1.0 } };
+
+  LowRankGaussianDistribution d(mean, noise, factors);
+  const arma::mat covariance = arma::diagmat(noise) + factors * factors.t();
+
+  arma::mat samples(3, 50000);
+  for (size_t i = 0; i < samples.n_cols; ++i)
+    samples.col(i) = d.Random();
+
+  const arma::vec sampleMean = arma::mean(samples, 1);
+  const arma::mat sampleCov = arma::cov(samples.t());
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    REQUIRE(sampleMean[i] == Approx(mean[i]).margin(0.05));
+    for (size_t j = 0; j < 3; ++j)
+      REQUIRE(sampleCov(i, j) == Approx(covariance(i, j)).margin(0.05));
+  }
+}
+
+/**
+ * Train() must match the per-dimension sample variances exactly, capture the
+ * dominant directions, and the weighted overload must agree with the
+ * unweighted one when all the weights are equal.
+ */
+TEST_CASE("LowRankGaussianDistributionTrainTest", "[DistributionTest]")
+{
+  const size_t d = 10;
+  const size_t n = 2000;
+
+  // Data with a strong rank-2 structure plus small isotropic noise.
+  arma::mat basis(d, 2, arma::fill::randn);
+  arma::mat observations = basis * arma::mat(2, n, arma::fill::randn) +
+      0.1 * arma::mat(d, n, arma::fill::randn);
+
+  LowRankGaussianDistribution dist(d, 2);
+  dist.Train(observations);
+
+  // The diagonal of the factored covariance must match the sample variances.
+  const arma::vec sampleMean = arma::mean(observations, 1);
+  const arma::mat diffs = observations.each_col() - sampleMean;
+  const arma::vec sampleVariances = arma::sum(diffs % diffs, 1) / (n - 1.0);
+  const arma::vec fittedVariances = dist.Noise() +
+      arma::sum(dist.Factors() % dist.Factors(), 1);
+
+  for (size_t i = 0; i < d; ++i)
+    REQUIRE(fittedVariances[i] == Approx(sampleVariances[i]).epsilon(1e-6));
+
+  // The factors must span most of the total variance, since the data is
+  // nearly rank 2.
+  REQUIRE(arma::accu(arma::square(dist.Factors())) >
+      0.9 * arma::accu(sampleVariances));
+
+  // Equal weights must reproduce the unweighted fit.
+  LowRankGaussianDistribution weighted(d, 2);
+  weighted.Train(observations, arma::vec(n, arma::fill::ones));
+
+  REQUIRE(arma::approx_equal(weighted.Mean(), dist.Mean(), "absdiff", 1e-6));
+  REQUIRE(arma::approx_equal(weighted.Noise(), dist.Noise(), "absdiff",
+      1e-5));
+}
+
+/**
+ * Incremental sufficient-statistic training of GaussianDistribution must
+ * agree with the batch weighted Train(), and downdating must retract
+ * observations exactly.
+ */
+TEST_CASE("GaussianDistributionIncrementalTrainTest", "[DistributionTest]")
+{
+  const size_t d = 4;
+  arma::mat observations(d, 500, arma::fill::randn);
+  arma::vec probabilities(500, arma::fill::randu);
+
+  GaussianDistribution batch;
+  batch.Train(observations, probabilities);
+
+  // Accumulating in chunks and finishing must match the batch estimate.
+  GaussianDistribution streaming;
+  streaming.ResetTraining(d);
+  streaming.AddObservations(observations.cols(0, 199),
+      probabilities.subvec(0, 199));
+  streaming.AddObservations(observations.cols(200, 499),
+      probabilities.subvec(200, 499));
+  streaming.FinishTraining();
+
+  CheckMatrices(streaming.Mean(), batch.Mean());
+  CheckMatrices(streaming.Covariance(), batch.Covariance());
+
+  // Retracting a chunk must give the estimate of the remaining data.
+  GaussianDistribution remaining;
+  remaining.Train(observations.cols(0, 299),
+      arma::vec(probabilities.subvec(0, 299)));
+
+  streaming.RemoveObservations(observations.cols(300, 499),
+      probabilities.subvec(300, 499));
+  streaming.FinishTraining();
+
+  CheckMatrices(streaming.Mean(), remaining.Mean());
+  CheckMatrices(streaming.Covariance(), remaining.Covariance());
+
+  // The unweighted AddObservations() overload must match unit weights.
+  GaussianDistribution unit;
+  unit.Train(observations, arma::vec(500, arma::fill::ones));
+
+  GaussianDistribution unweighted;
+  unweighted.ResetTraining(d);
+  unweighted.AddObservations(observations);
+  unweighted.FinishTraining();
+
+  CheckMatrices(unweighted.Mean(), unit.Mean());
+  CheckMatrices(unweighted.Covariance(), unit.Covariance());
+
+  // With everything retracted, FinishTraining() must fall back to the empty
+  // (but invertible) covariance instead of dividing by zero.
+  unweighted.RemoveObservations(observations,
+      arma::vec(500, arma::fill::ones));
+  unweighted.FinishTraining();
+  REQUIRE(unweighted.Covariance()(0, 0) == Approx(1e-50));
+}
@@ -162,3 +162,31 @@ TEST_CASE("SparseTest", "[DrusillaSelectTest]")
   REQUIRE(distances.n_cols == 1000);
   REQUIRE(distances.n_rows == 3);
 }
+
+// A batch search over many queries must give the same results as searching
+// for each query on its own.  (The batch path may split the queries across
+// threads and merge per-thread candidate sets.)
+TEST_CASE("DrusillaSelectBatchQueryTest", "[DrusillaSelectTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(6, 500);
+  arma::mat querySet = arma::randu<arma::mat>(6, 300);
+
+  DrusillaSelect<> ds(dataset, 10, 10);
+
+  arma::mat batchDistances;
+  arma::Mat<size_t> batchNeighbors;
+  ds.Search(querySet, 3, batchNeighbors, batchDistances);
+
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    arma::mat distances;
+    arma::Mat<size_t> neighbors;
+    ds.Search(querySet.col(q), 3, neighbors, distances);
+
+    for (size_t j = 0; j < 3; ++j)
+    {
+      REQUIRE(batchNeighbors(j, q) == neighbors(j, 0));
+      REQUIRE(batchDistances(j, q) == Approx(distances(j, 0)).epsilon(1e-7));
+    }
+  }
+}
@@ -269,3 +269,64 @@ TEST_CASE("EMSTBallTreeTest", "[EMSTTest]")
     REQUIRE(bstResults(2, i) == Approx(ballResults(2, i)).epsilon(1e-7));
   }
 }
+
+/**
+ * Test single-linkage dendrogram construction.  The linkage matrix must be
+ * structurally valid (heights sorted, sizes consistent), and cutting it must
+ * recover well-separated groups.
+ */
+TEST_CASE("EMSTLinkageTest", "[EMSTTest]")
+{
+  // Three well-separated groups in one dimension.
+  arma::mat data(1, 9);
+  data = { { 0.0, 0.1, 0.2, 5.0, 5.1, 5.2, 10.0, 10.1, 10.2 } };
+
+  DualTreeBoruvka<> dtb(data);
+  arma::mat linkage;
+  dtb.ComputeLinkage(linkage);
+
+  const size_t n = data.n_cols;
+  REQUIRE(linkage.n_rows == 4);
+  REQUIRE(linkage.n_cols == n - 1);
+
+  // Heights must be non-decreasing and sizes consistent; the last merge must
+  // contain all the points.
+  arma::Col<size_t> clusterSize(2 * n - 1);
+  clusterSize.head(n).ones();
+  for (size_t i = 0; i < n - 1; ++i)
+  {
+    if (i > 0)
+      REQUIRE(linkage(2, i) >= linkage(2, i - 1));
+
+    const size_t a = (size_t) linkage(0, i);
+    const size_t b = (size_t) linkage(1, i);
+    REQUIRE(a < b);
+    REQUIRE(b < n + i);
+    clusterSize[n + i] = clusterSize[a] + clusterSize[b];
+    REQUIRE((size_t) linkage(3, i) == clusterSize[n + i]);
+  }
+  REQUIRE((size_t) linkage(3, n - 2) == n);
+
+  // Cutting between the within-group and between-group distances must give
+  // exactly the three groups; labels are assigned by lowest point index.
+  arma::Row<size_t> assignments;
+  DualTreeBoruvka<>::ClusterAtHeight(linkage, 1.0, assignments);
+  REQUIRE(assignments.n_elem == n);
+  for (size_t i = 0; i < n; ++i)
+    REQUIRE(assignments[i] == i / 3);
+
+  // A cut below every merge height leaves every point alone; a cut above
+  // every merge height gives one cluster.
+  DualTreeBoruvka<>::ClusterAtHeight(linkage, 0.05, assignments);
+  for (size_t i = 0; i < n; ++i)
+    REQUIRE(assignments[i] == i);
+
+  DualTreeBoruvka<>::ClusterAtHeight(linkage, 100.0, assignments);
+  REQUIRE(arma::all(assignments == 0));
+
+  // A malformed linkage matrix must be rejected.
+  arma::mat badLinkage(3, n - 1, arma::fill::zeros);
+  REQUIRE_THROWS_AS(
+      DualTreeBoruvka<>::ClusterAtHeight(badLinkage, 1.0, assignments),
+      std::invalid_argument);
+}
@@ -88,6 +88,40 @@ TEST_CASE("FastMKSDualTreeVsNaive", "[FastMKSTest]")
   }
 }
 
+/**
+ * Make sure the blocked naive implementation (used for dot-product-based
+ * kernels) gives the same results as evaluating the kernel one pair at a
+ * time, in the bichromatic case.
+ */
+TEST_CASE("FastMKSBlockedNaiveTest", "[FastMKSTest]")
+{
+  // Use enough points that multiple blocks are processed.
+  arma::mat data = arma::randn(8, 2500);
+  arma::mat querySet = arma::randn(8, 300);
+  PolynomialKernel pk(2.0, 1.0);
+
+  FastMKS<PolynomialKernel> naive(data, pk, false, true);
+
+  arma::Mat<size_t> indices;
+  arma::mat kernels;
+  naive.Search(querySet, 5, indices, kernels);
+
+  // Brute-force check each query point's candidates.
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    arma::vec evals(data.n_cols);
+    for (size_t r = 0; r < data.n_cols; ++r)
+      evals[r] = pk.Evaluate(querySet.col(q), data.col(r));
+
+    arma::uvec sorted = arma::sort_index(evals, "descend");
+    for (size_t j = 0; j < 5; ++j)
+    {
+      REQUIRE(indices(j, q) == sorted[j]);
+      REQUIRE(kernels(j, q) == Approx(evals[sorted[j]]).epsilon(1e-10));
+    }
+  }
+}
+
 /**
  * Compare dual-tree and single-tree on a larger dataset.
  */
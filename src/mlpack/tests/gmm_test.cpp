@@ -1230,3 +1230,160 @@ TEST_CASE("DiagonalGMMLoadSaveTest", "[GMMTest]")
     }
   }
 }
+
+/**
+ * Make sure stepwise EM can track a mixture from a stream of mini-batches,
+ * starting from a roughly-initialized model.
+ */
+TEST_CASE("StepwiseEMFitGMMTest", "[GMMTest]")
+{
+  // We'll have two Gaussian distributions in this mixture.
+  GaussianDistribution d1("0.0 0.0", "1.0 0.0; 0.0 1.0");
+  GaussianDistribution d2("5.0 5.0", "1.0 0.3; 0.3 1.0");
+
+  arma::mat observations(2, 4000);
+  for (size_t i = 0; i < 4000; ++i)
+  {
+    if (Random() <= 0.5) // p(d1) = 0.5
+      observations.col(i) = d1.Random();
+    else // p(d2) = 0.5
+      observations.col(i) = d2.Random();
+  }
+
+  // Roughly initialize the model near (but not at) the true parameters.
+  GMM gmm(2, 2);
+  gmm.Component(0) = GaussianDistribution("0.5 -0.5", "1.0 0.0; 0.0 1.0");
+  gmm.Component(1) = GaussianDistribution("4.5 5.5", "1.0 0.0; 0.0 1.0");
+  gmm.Weights() = "0.4 0.6";
+
+  // Feed the observations through in mini-batches with a decaying step size;
+  // run two passes over the stream.
+  StepwiseEMFit<GMM> fitter(gmm.Gaussians(), gmm.Dimensionality());
+  const size_t batchSize = 200;
+  size_t step = 0;
+  for (size_t pass = 0; pass < 2; ++pass)
+  {
+    for (size_t begin = 0; begin < observations.n_cols; begin += batchSize)
+    {
+      fitter.Step(observations.cols(begin, begin + batchSize - 1), gmm,
+          std::pow((double) (++step + 2), -0.7));
+    }
+  }
+
+  // Check the results.  Order by means so that the checking is correct.
+  const size_t first = (gmm.Component(0).Mean()[0] <
+      gmm.Component(1).Mean()[0]) ? 0 : 1;
+  const size_t second = 1 - first;
+
+  REQUIRE(arma::norm(gmm.Component(first).Mean() - d1.Mean()) ==
+      Approx(0.0).margin(0.2));
+  REQUIRE(arma::norm(gmm.Component(second).Mean() - d2.Mean()) ==
+      Approx(0.0).margin(0.2));
+  REQUIRE(gmm.Weights()[first] == Approx(0.5).margin(0.1));
+  REQUIRE(gmm.Weights()[second] == Approx(0.5).margin(0.1));
+}
+
+/**
+ * Make sure shard statistics accumulated on separate fitters and combined
+ * with Merge() give exactly the same model as accumulating the whole batch
+ * on one fitter.
+ */
+TEST_CASE("StepwiseEMFitMergeTest", "[GMMTest]")
+{
+  GaussianDistribution d1("0.0 0.0 0.0", "1.0 0.0 0.0;"
+                                         "0.0 1.0 0.0;"
+                                         "0.0 0.0 1.0");
+  GaussianDistribution d2("4.0 4.0 4.0", "1.0 0.0 0.0;"
+                                         "0.0 1.0 0.0;"
+                                         "0.0 0.0 1.0");
+
+  arma::mat observations(3, 1000);
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    if (Random() <= 0.5)
+      observations.col(i) = d1.Random();
+    else
+      observations.col(i) = d2.Random();
+  }
+
+  GMM gmm(2, 3);
+  gmm.Component(0) = GaussianDistribution("0.5 0.5 0.5", "1.0 0.0 0.0;"
+                                                         "0.0 1.0 0.0;"
+                                                         "0.0 0.0 1.0");
+  gmm.Component(1) = GaussianDistribution("3.5 3.5 3.5", "1.0 0.0 0.0;"
+                                                         "0.0 1.0 0.0;"
+                                                         "0.0 0.0 1.0");
+  gmm.Weights() = "0.5 0.5";
+  GMM gmmSharded(gmm);
+
+  // Accumulate the full batch on one fitter.
+  StepwiseEMFit<GMM> fitter(2, 3);
+  fitter.Accumulate(observations, gmm);
+  REQUIRE(fitter.PendingObservations() == 1000);
+  fitter.Apply(gmm, 0.5);
+
+  // Accumulate the two halves on separate fitters and merge.
+  StepwiseEMFit<GMM> fitterA(2, 3), fitterB(2, 3);
+  fitterA.Accumulate(observations.cols(0, 499), gmmSharded);
+  fitterB.Accumulate(observations.cols(500, 999), gmmSharded);
+  fitterA.Merge(fitterB);
+  REQUIRE(fitterA.PendingObservations() == 1000);
+  fitterA.Apply(gmmSharded, 0.5);
+
+  // The two models must agree.
+  REQUIRE(arma::approx_equal(gmm.Weights(), gmmSharded.Weights(),
+      "absdiff", 1e-10));
+  for (size_t i = 0; i < 2; ++i)
+  {
+    REQUIRE(arma::approx_equal(gmm.Component(i).Mean(),
+        gmmSharded.Component(i).Mean(), "absdiff", 1e-10));
+    REQUIRE(arma::approx_equal(gmm.Component(i).Covariance(),
+        gmmSharded.Component(i).Covariance(), "absdiff", 1e-10));
+  }
+}
+
+/**
+ * Make sure stepwise EM works for DiagonalGMM too.
+ */
+TEST_CASE("StepwiseEMFitDiagonalGMMTest", "[GMMTest]")
+{
+  DiagonalGaussianDistribution d1("0.0 0.0", "1.0 0.5;");
+  DiagonalGaussianDistribution d2("6.0 6.0", "0.5 1.0;");
+
+  arma::mat observations(2, 4000);
+  for (size_t i = 0; i < 4000; ++i)
+  {
+    if (Random() <= 0.5) // p(d1) = 0.5
+      observations.col(i) = d1.Random();
+    else // p(d2) = 0.5
+      observations.col(i) = d2.Random();
+  }
+
+  DiagonalGMM gmm(2, 2);
+  gmm.Component(0) = DiagonalGaussianDistribution("0.5 -0.5", "1.0 1.0;");
+  gmm.Component(1) = DiagonalGaussianDistribution("5.5 6.5", "1.0 1.0;");
+  gmm.Weights() = "0.4 0.6";
+
+  StepwiseEMFit<DiagonalGMM> fitter(gmm.Gaussians(), gmm.Dimensionality());
+  const size_t batchSize = 200;
+  size_t step = 0;
+  for (size_t pass = 0; pass < 2; ++pass)
+  {
+    for (size_t begin = 0; begin < observations.n_cols; begin += batchSize)
+    {
+      fitter.Step(observations.cols(begin, begin + batchSize - 1), gmm,
+          std::pow((double) (++step + 2), -0.7));
+    }
+  }
+
+  const size_t first = (gmm.Component(0).Mean()[0] <
+      gmm.Component(1).Mean()[0]) ? 0 : 1;
+  const size_t second = 1 - first;
+
+  REQUIRE(arma::norm(gmm.Component(first).Mean() - d1.Mean()) ==
+      Approx(0.0).margin(0.2));
+  REQUIRE(arma::norm(gmm.Component(second).Mean() - d2.Mean()) ==
+      Approx(0.0).margin(0.2));
+  REQUIRE(gmm.Weights()[first] == Approx(0.5).margin(0.1));
+  REQUIRE(gmm.Weights()[second] == Approx(0.5).margin(0.1));
+}
@@ -2105,3 +2105,83 @@ TEST_CASE("DiagonalGMMHMMLoadSaveTest", "[HMMTest]")
     }
   }
 }
+
+/**
+ * Make sure beam-pruned Viterbi decoding agrees with the exact decode: a
+ * beam as wide as the state count must be identical, and on a well-separated
+ * model a narrow beam should recover the same sequence with the same
+ * log-likelihood.
+ */
+TEST_CASE("HMMBeamPredictTest", "[HMMTest]")
+{
+  // Random 5-state discrete HMM with a dominant diagonal, so the decode is
+  // unambiguous enough for a narrow beam.
+  arma::vec initial("0.2 0.2 0.2 0.2 0.2");
+  // Columns of the transition matrix are distributions over next states.
+  arma::mat transition = arma::randu<arma::mat>(5, 5) + 4.0 * arma::eye(5, 5);
+  transition.each_col([](arma::vec& c) { c /= accu(c); });
+
+  std::vector<DiscreteDistribution> emission(5);
+  for (size_t i = 0; i < 5; ++i)
+  {
+    arma::vec probs = 0.1 * arma::ones<arma::vec>(5);
+    probs[i] = 5.0;
+    probs /= accu(probs);
+    emission[i] = DiscreteDistribution(std::vector<arma::vec>{ probs });
+  }
+
+  HMM<DiscreteDistribution> hmm(initial, transition, emission);
+
+  // Generate an observation sequence from the model.
+  arma::mat observations;
+  arma::Row<size_t> trueStates;
+  hmm.Generate(200, observations, trueStates);
+
+  arma::Row<size_t> exactStates, fullBeamStates, prunedStates;
+  const double exactLogLik = hmm.Predict(observations, exactStates);
+
+  // A beam at least as wide as the state count must match exactly.
+  const double fullBeamLogLik = hmm.Predict(observations, fullBeamStates, 5);
+  REQUIRE(fullBeamLogLik == Approx(exactLogLik).epsilon(1e-10));
+  for (size_t t = 0; t < exactStates.n_elem; ++t)
+    REQUIRE(fullBeamStates[t] == exactStates[t]);
+
+  // With well-separated states, a narrow beam should find the same path.
+  const double prunedLogLik = hmm.Predict(observations, prunedStates, 2);
+  REQUIRE(prunedLogLik == Approx(exactLogLik).epsilon(1e-10));
+  for (size_t t = 0; t < exactStates.n_elem; ++t)
+    REQUIRE(prunedStates[t] == exactStates[t]);
+}
+
+/**
+ * Make sure the batched LogLikelihood() overload agrees with scoring each
+ * sequence individually.
+ */
+TEST_CASE("HMMBatchLogLikelihoodTest", "[HMMTest]")
+{
+  arma::vec initial("0.5 0.5");
+  arma::mat transition("0.7 0.3; 0.3 0.7");
+  std::vector<DiscreteDistribution> emission(2);
+  emission[0] = DiscreteDistribution(std::vector<arma::vec>{"0.9 0.1"});
+  emission[1] = DiscreteDistribution(std::vector<arma::vec>{"0.2 0.8"});
+
+  HMM<DiscreteDistribution> hmm(initial, transition, emission);
+
+  // Generate sequences of different lengths from the model.
+  std::vector<arma::mat> sequences(25);
+  for (size_t seq = 0; seq < sequences.size(); ++seq)
+  {
+    arma::Row<size_t> states;
+    hmm.Generate(10 + 7 * seq, sequences[seq], states);
+  }
+
+  arma::vec logLikelihoods;
+  hmm.LogLikelihood(sequences, logLikelihoods);
+
+  REQUIRE(logLikelihoods.n_elem == sequences.size());
+  for (size_t seq = 0; seq < sequences.size(); ++seq)
+  {
+    REQUIRE(logLikelihoods[seq] ==
+        Approx(hmm.LogLikelihood(sequences[seq])).epsilon(1e-10));
+  }
+}
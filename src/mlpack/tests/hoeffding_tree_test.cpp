@@ -576,6 +576,40 @@ TEST_CASE("HoeffdingTreeSimpleDatasetTest", "[HoeffdingTreeTest]")
   }
 }
 
+/**
+ * Test that streaming training on a matrix (which shards the stream across
+ * the leaves of the tree) builds exactly the same tree as feeding the points
+ * through one at a time.
+ */
+TEST_CASE("HoeffdingTreeShardedStreamingTest", "[HoeffdingTreeTest]")
+{
+  // Load the vc2 dataset (numeric features).
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+
+  DatasetInfo info(dataset.n_rows); // All numeric.
+
+  HoeffdingTree<> matrixTree(dataset, info, labels, 3, false);
+  HoeffdingTree<> pointTree(info, 3);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    pointTree.Train(dataset.col(i), labels[i]);
+
+  // The two trees should be structurally identical and make the same
+  // predictions.
+  REQUIRE(matrixTree.NumDescendants() == pointTree.NumDescendants());
+
+  arma::Row<size_t> matrixPredictions, pointPredictions;
+  matrixTree.Classify(dataset, matrixPredictions);
+  pointTree.Classify(dataset, pointPredictions);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    REQUIRE(matrixPredictions[i] == pointPredictions[i]);
+}
+
 /**
  * Make sure that a tree that does not split on anything.
  */
@@ -732,6 +766,99 @@ TEST_CASE("HoeffdingNumericSplitBimodalTest", "[HoeffdingTreeTest]")
   }
 }
 
+/**
+ * Test that the QuantileNumericSplit class has a fitness function value of 0
+ * before it's seen enough points.
+ */
+TEST_CASE("QuantileNumericSplitFitnessFunctionTest", "[HoeffdingTreeTest]")
+{
+  QuantileNumericSplit<GiniImpurity> split(5, 10);
+
+  // Until 2 * bins samples have been seen, nothing should be calculated.
+  for (size_t i = 0; i < 19; ++i)
+  {
+    split.Train(Random(), RandInt(5));
+    double bestGain, secondBestGain;
+    split.EvaluateFitnessFunction(bestGain, secondBestGain);
+    REQUIRE(bestGain == Approx(0.0).margin(1e-10));
+    REQUIRE(secondBestGain == Approx(0.0).margin(1e-10));
+  }
+}
+
+/**
+ * Use a numeric feature that is bimodal (with a margin), and make sure that
+ * the QuantileNumericSplit bins it reasonably into two bins and returns
+ * sensible Gini impurity numbers.
+ */
+TEST_CASE("QuantileNumericSplitBimodalTest", "[HoeffdingTreeTest]")
+{
+  // 2 classes, 2 bins.
+  QuantileNumericSplit<GiniImpurity> split(2, 2);
+
+  for (size_t i = 0; i < 100; ++i)
+  {
+    split.Train(Random() + 0.3, 0);
+    split.Train(-Random() - 0.3, 1);
+  }
+
+  // Push the majority class to 1.
+  split.Train(-Random() - 0.3, 1);
+  REQUIRE(split.MajorityClass() == 1);
+
+  // Push the majority class back to 0.
+  split.Train(Random() + 0.3, 0);
+  split.Train(Random() + 0.3, 0);
+  REQUIRE(split.MajorityClass() == 0);
+
+  // The quantile boundary should land in the margin between the two modes,
+  // so the impurity should be (0.5 * (1 - 0.5)) * 2 = 0.50 (it will be 0 in
+  // the two created children).
+  double bestGain, secondBestGain;
+  split.EvaluateFitnessFunction(bestGain, secondBestGain);
+  REQUIRE(bestGain == Approx(0.50).epsilon(0.01));
+  REQUIRE(secondBestGain == Approx(0.0).margin(1e-10));
+
+  // Make sure that if we do create children, that the correct number of
+  // children is created, and that the bins end up in the right place.
+  NumericSplitInfo<> info;
+  arma::Col<size_t> childMajorities;
+  split.Split(childMajorities, info);
+  REQUIRE(childMajorities.n_elem == 2);
+
+  // Now check the split info.
+  for (size_t i = 0; i < 10; ++i)
+  {
+    REQUIRE(info.CalculateDirection(Random() + 0.3) !=
+            info.CalculateDirection(-Random() - 0.3));
+  }
+}
+
+/**
+ * Build a Hoeffding tree on a numeric dataset using quantile-sketch binning
+ * and make sure it performs reasonably.
+ */
+TEST_CASE("QuantileNumericSplitTreeTest", "[HoeffdingTreeTest]")
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+
+  DatasetInfo info(dataset.n_rows); // All numeric.
+
+  HoeffdingTree<GiniImpurity, QuantileDoubleNumericSplit> tree(dataset, info,
+      labels, 3, false);
+
+  arma::Row<size_t> predictions;
+  tree.Classify(dataset, predictions);
+
+  size_t correct = arma::accu(predictions == labels);
+  REQUIRE(correct > size_t(0.6 * dataset.n_cols));
+}
+
 /**
  * Create a BinaryNumericSplit object, feed it a bunch of samples where anything
  * less than 1.0 is class 0 and anything greater is class 1.  Then make sure it
@@ -1520,3 +1647,62 @@ TEST_CASE("HoeffdingTreeEmptyConstructorTrainTest", "[HoeffdingTreeTest]")
   REQUIRE_NOTHROW(ht.Train(data, labels, false, true, 2));
   REQUIRE_NOTHROW(ht.Train(data2, info, labels2, false, 3));
 }
+
+/**
+ * The pooled categorical split statistics must survive copies and moves: a
+ * copied tree has to keep training on its own statistics block, and a
+ * moved-from block has to stay bound to the moved-to tree's splits.
+ */
+TEST_CASE("HoeffdingTreePooledStatisticsTest", "[HoeffdingTreeTest]")
+{
+  // Three categorical dimensions with four categories each.
+  data::DatasetInfo info(3);
+  for (size_t d = 0; d < 3; ++d)
+    for (size_t c = 0; c < 4; ++c)
+      info.MapString<size_t>("cat" + std::to_string(c), d);
+
+  // Use a huge check interval so the tree never splits.
+  HoeffdingTree<> tree(info, 2, 0.95, 5000, 5000);
+
+  // Make class 0 the clear majority.
+  for (size_t i = 0; i < 300; ++i)
+  {
+    arma::Col<size_t> point(3);
+    point[0] = RandInt(0, 4);
+    point[1] = RandInt(0, 4);
+    point[2] = RandInt(0, 4);
+    tree.Train(point, (i % 3 == 0) ? 1 : 0);
+  }
+  REQUIRE(tree.MajorityClass() == 0);
+
+  // A copy must see the same statistics.
+  HoeffdingTree<> copy(tree);
+  REQUIRE(copy.MajorityClass() == 0);
+
+  // Flood the copy with class 1; if the copy aliased the original's
+  // statistics block, these increments would leak into the original.
+  for (size_t i = 0; i < 3000; ++i)
+  {
+    arma::Col<size_t> point(3);
+    point[0] = RandInt(0, 4);
+    point[1] = RandInt(0, 4);
+    point[2] = RandInt(0, 4);
+    copy.Train(point, 1);
+  }
+  REQUIRE(copy.MajorityClass() == 1);
+
+  // One more point makes the original recompute its majority from its own
+  // statistics; it must be unaffected by the copy's training.
+  tree.Train(arma::Col<size_t>("0 0 0"), 0);
+  REQUIRE(tree.MajorityClass() == 0);
+
+  // A moved tree must keep working on the moved statistics block.
+  HoeffdingTree<> moved(std::move(copy));
+  moved.Train(arma::Col<size_t>("1 1 1"), 1);
+  REQUIRE(moved.MajorityClass() == 1);
+
+  HoeffdingTree<> assigned(info, 2);
+  assigned = std::move(moved);
+  assigned.Train(arma::Col<size_t>("2 2 2"), 1);
+  REQUIRE(assigned.MajorityClass() == 1);
+}
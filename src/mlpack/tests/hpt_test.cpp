@@ -11,6 +11,7 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/methods/lars.hpp>
+#include <mlpack/methods/linear_regression.hpp>
 #include <mlpack/methods/logistic_regression.hpp>
 
 #include "catch.hpp"
@@ -390,3 +391,46 @@ TEST_CASE("HPTGradientDescentTest", "[HPTTest]")
   REQUIRE(xOptimized == Approx(xMin).epsilon(1e-6));
   REQUIRE(zOptimized == Approx(zMin).epsilon(1e-6));
 }
+
+/**
+ * Test that SuccessiveHalvingTuner selects the best hyper-parameters when
+ * minimizing a metric.
+ */
+TEST_CASE("SuccessiveHalvingTest", "[HPTTest]")
+{
+  arma::mat xs = arma::randn(5, 200);
+  arma::vec beta = arma::randn(5, 1);
+  arma::rowvec ys = beta.t() * xs + 0.1 * arma::randn(1, 200);
+
+  SuccessiveHalvingTuner<LinearRegression, MSE> tuner(0.2, xs, ys);
+
+  // An extreme amount of regularization destroys the fit, so the small
+  // lambda value should survive every rung and win.
+  arma::vec lambdas{0.0, 1e6};
+  double bestLambda;
+  std::tie(bestLambda) = tuner.Optimize(lambdas);
+
+  REQUIRE(bestLambda == Approx(0.0).margin(1e-12));
+  REQUIRE(tuner.BestObjective() < 1.0);
+}
+
+/**
+ * Test that SuccessiveHalvingTuner maximizes Accuracy rather than minimizes
+ * it.
+ */
+TEST_CASE("SuccessiveHalvingMaximizationTest", "[HPTTest]")
+{
+  // A linearly separable dataset.
+  arma::mat xs = arma::linspace<arma::rowvec>(0.0, 10.0, 100);
+  arma::Row<size_t> ys = arma::join_rows(arma::zeros<arma::Row<size_t>>(50),
+      arma::ones<arma::Row<size_t>>(50));
+
+  SuccessiveHalvingTuner<LogisticRegression<>, Accuracy> tuner(0.3, xs, ys);
+
+  arma::vec lambdas{0.0, 1e6};
+  double bestLambda;
+  std::tie(bestLambda) = tuner.Optimize(lambdas);
+
+  REQUIRE(bestLambda == Approx(0.0).margin(1e-12));
+  REQUIRE(tuner.BestObjective() == Approx(1.0).epsilon(1e-7));
+}
@@ -105,6 +105,75 @@ TEST_CASE("LoadVectorImageAPITest", "[ImageLoadTest]")
   REQUIRE(matrix.n_cols == 2);
 }
 
+/**
+ * Test that presetting the width and height on the ImageInfo resizes every
+ * image during a batch load.
+ */
+TEST_CASE("LoadVectorImageResizeTest", "[ImageLoadTest]")
+{
+  arma::Mat<unsigned char> matrix;
+  data::ImageInfo info(25, 25, 3);
+  std::vector<std::string> files = {"test_image.png", "test_image.png"};
+  REQUIRE(data::Load(files, matrix, info, false) == true);
+  // width * height * channels.
+  REQUIRE(matrix.n_rows == 25 * 25 * 3);
+  REQUIRE(info.Height() == 25);
+  REQUIRE(info.Width() == 25);
+  REQUIRE(info.Channels() == 3);
+  REQUIRE(matrix.n_cols == 2);
+  // Both columns come from the same file, so they must resize identically.
+  for (size_t i = 0; i < matrix.n_rows; ++i)
+    REQUIRE(matrix(i, 0) == matrix(i, 1));
+}
+
+/**
+ * Test that a batch load without preset dimensions fails cleanly when the
+ * images do not all have the same size.
+ */
+TEST_CASE("LoadVectorImageSizeMismatchTest", "[ImageLoadTest]")
+{
+  data::ImageInfo saveInfo(5, 5, 3, 90);
+  arma::Mat<unsigned char> im1 =
+      arma::randi<arma::Mat<unsigned char>>(5 * 5 * 3, 1);
+  REQUIRE(data::Save("APITest.bmp", im1, saveInfo, false) == true);
+
+  arma::Mat<unsigned char> matrix;
+  data::ImageInfo info;
+  std::vector<std::string> files = {"test_image.png", "APITest.bmp"};
+  REQUIRE(data::Load(files, matrix, info, false) == false);
+  remove("APITest.bmp");
+}
+
+/**
+ * Test that ImageBatchStream produces the same columns as a direct batch
+ * load, split into batches of the requested size.
+ */
+TEST_CASE("ImageBatchStreamTest", "[ImageLoadTest]")
+{
+  std::vector<std::string> files(5, "test_image.png");
+
+  arma::mat reference;
+  data::ImageInfo refInfo;
+  REQUIRE(data::Load(files, reference, refInfo, false) == true);
+
+  data::ImageInfo info;
+  data::ImageBatchStream<> stream(files, 2, info);
+  arma::mat batch;
+  size_t points = 0;
+  while (stream.Next(batch))
+  {
+    REQUIRE(batch.n_rows == reference.n_rows);
+    REQUIRE(batch.n_cols <= 2);
+    for (size_t c = 0; c < batch.n_cols; ++c)
+      for (size_t i = 0; i < batch.n_rows; ++i)
+        REQUIRE(batch(i, c) == Approx(reference(i, points + c)).epsilon(1e-7));
+    points += batch.n_cols;
+  }
+  REQUIRE(points == 5);
+  REQUIRE(stream.Info().Width() == 50);
+  REQUIRE(stream.Info().Height() == 50);
+}
+
 /**
  * Test if the image is saved correctly using API for arma mat.
  */
@@ -304,3 +304,114 @@ TEST_CASE("DatasetMapperPointerMapping", "[ImputationTest]")
   REQUIRE(dm.UnmapString(1, 0) == &b);
   REQUIRE(dm.UnmapString(2, 0) == &c);
 }
+
+/**
+ * Make sure the P^2 estimator tracks the exact quantile for small streams
+ * and lands close to it for large ones.
+ */
+TEST_CASE("P2QuantileEstimatorTest", "[ImputationTest]")
+{
+  // For fewer than five values the estimate is exact.
+  P2QuantileEstimator small(0.5);
+  small.Insert(5.0);
+  small.Insert(1.0);
+  small.Insert(3.0);
+
+  REQUIRE(small.Count() == 3);
+  REQUIRE(small.Quantile() == Approx(3.0).epsilon(1e-7));
+
+  // For a large shuffled stream the estimate should be close to the true
+  // median.
+  arma::vec values = arma::shuffle(arma::linspace(0.0, 1.0, 10001));
+  P2QuantileEstimator median(0.5);
+  for (size_t i = 0; i < values.n_elem; ++i)
+    median.Insert(values[i]);
+
+  REQUIRE(median.Count() == values.n_elem);
+  REQUIRE(median.Quantile() == Approx(0.5).margin(0.05));
+
+  // The same holds for a quantile other than the median.
+  P2QuantileEstimator upper(0.9);
+  for (size_t i = 0; i < values.n_elem; ++i)
+    upper.Insert(values[i]);
+
+  REQUIRE(upper.Quantile() == Approx(0.9).margin(0.05));
+}
+
+/**
+ * Make sure two-phase mean imputation over chunks gives the same result as
+ * imputing the whole matrix at once.
+ */
+TEST_CASE("ChunkedMeanImputationTest", "[ImputationTest]")
+{
+  arma::mat input(3, 100, arma::fill::randu);
+  // Punch missing values into every dimension.
+  for (size_t i = 0; i < input.n_cols; i += 7)
+    input(i % 3, i) = 0.0;
+
+  const double mappedValue = 0.0;
+
+  // Impute the whole matrix at once, one dimension at a time.
+  arma::mat expected(input);
+  MeanImputation<double> batchImputer;
+  for (size_t d = 0; d < expected.n_rows; ++d)
+    batchImputer.Impute(expected, mappedValue, d, true);
+
+  // Now accumulate and apply in chunks of 30 points.
+  MeanImputation<double> imputer;
+  imputer.Reset(input.n_rows);
+  for (size_t start = 0; start < input.n_cols; start += 30)
+  {
+    const size_t end = std::min(start + 30, (size_t) input.n_cols) - 1;
+    imputer.Accumulate(arma::mat(input.cols(start, end)), mappedValue);
+  }
+
+  for (size_t start = 0; start < input.n_cols; start += 30)
+  {
+    const size_t end = std::min(start + 30, (size_t) input.n_cols) - 1;
+    arma::mat chunk(input.cols(start, end));
+    imputer.Apply(chunk, mappedValue);
+    input.cols(start, end) = chunk;
+  }
+
+  CheckMatrices(input, expected);
+}
+
+/**
+ * Make sure two-phase median imputation over chunks replaces missing values
+ * with a good approximation of the true median.
+ */
+TEST_CASE("ChunkedMedianImputationTest", "[ImputationTest]")
+{
+  arma::mat input(2, 1000, arma::fill::randu);
+  for (size_t i = 0; i < input.n_cols; i += 9)
+    input(i % 2, i) = -1.0;
+
+  const double mappedValue = -1.0;
+
+  // The exact per-dimension medians, for reference.
+  arma::mat expected(input);
+  MedianImputation<double> batchImputer;
+  for (size_t d = 0; d < expected.n_rows; ++d)
+    batchImputer.Impute(expected, mappedValue, d, true);
+
+  MedianImputation<double> imputer;
+  imputer.Reset(input.n_rows);
+  for (size_t start = 0; start < input.n_cols; start += 100)
+    imputer.Accumulate(arma::mat(input.cols(start, start + 99)), mappedValue);
+
+  for (size_t start = 0; start < input.n_cols; start += 100)
+  {
+    arma::mat chunk(input.cols(start, start + 99));
+    imputer.Apply(chunk, mappedValue);
+    input.cols(start, start + 99) = chunk;
+  }
+
+  // Every formerly-missing element must now hold (approximately) the exact
+  // median of its dimension.
+  for (size_t i = 0; i < input.n_cols; i += 9)
+  {
+    REQUIRE(input(i % 2, i) ==
+        Approx(expected(i % 2, i)).margin(0.05));
+  }
+}
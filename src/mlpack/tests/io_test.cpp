@@ -1252,3 +1252,32 @@ TEST_CASE("CppNameTest", "[IOTest]")
   REQUIRE(p.Parameters().at("help").cppType == "bool");
   REQUIRE(p.Parameters().at("double").cppType == "double");
 }
+
+/**
+ * Test that an ExecutionPolicy reports a sane thread count and that a scoped
+ * policy restores the previous settings when it goes out of scope.
+ */
+TEST_CASE("ExecutionPolicyTest", "[IOTest]")
+{
+  // A default policy leaves the thread count at the runtime's default.
+  util::ExecutionPolicy defaultPolicy;
+  const size_t defaultThreads = defaultPolicy.Threads();
+  REQUIRE(defaultThreads >= 1);
+
+  util::ExecutionPolicy policy;
+  policy.MaxThreads() = 1;
+  policy.AllowNested() = false;
+
+  {
+    util::ScopedExecutionPolicy scope(policy);
+    REQUIRE(policy.Threads() == 1);
+  }
+
+  // The default settings must be back in force.
+  REQUIRE(defaultPolicy.Threads() == defaultThreads);
+
+  // The global policy is process-wide and mutable.
+  util::ExecutionPolicy::Global().MaxThreads() = defaultThreads;
+  REQUIRE(util::ExecutionPolicy::Global().Threads() == defaultThreads);
+  util::ExecutionPolicy::Global().MaxThreads() = 0;
+}
@@ -9,6 +9,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/kde.hpp>
+#include <mlpack/methods/kde/kde_model.hpp>
 
 #include "catch.hpp"
 #include "serialization.hpp"
@@ -148,6 +149,170 @@ TEST_CASE("GaussianKDEBruteForceTest", "[KDETest]")
     REQUIRE(bfEstimations[i] == Approx(treeEstimations[i]).epsilon(relError));
 }
 
+/**
+ * Test grid-based (binned) implementation results against brute force
+ * results.
+ */
+TEST_CASE("GaussianGridKDEBruteForceTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 200);
+  arma::mat query = arma::randu(2, 60);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  arma::vec gridEstimations;
+  const double kernelBandwidth = 0.12;
+  const double relError = 0.01;
+
+  // Brute force KDE.
+  GaussianKernel kernel(kernelBandwidth);
+  BruteForceKDE<GaussianKernel>(reference,
+                                query,
+                                bfEstimations,
+                                kernel);
+
+  // Grid KDE.
+  GridKDE<GaussianKernel> kde(relError, 0.0, kernel);
+  kde.Train(reference);
+  kde.Evaluate(query, gridEstimations);
+
+  // The binning error is not covered by the truncation tolerance, so allow a
+  // slightly wider margin.
+  for (size_t i = 0; i < query.n_cols; ++i)
+    REQUIRE(bfEstimations[i] == Approx(gridEstimations[i]).epsilon(0.02));
+}
+
+/**
+ * Test multi-bandwidth evaluation results against brute force results for
+ * each bandwidth.
+ */
+TEST_CASE("MultiBandwidthKDETest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 200);
+  arma::mat query = arma::randu(2, 60);
+  const std::vector<double> bandwidths = { 0.1, 0.2, 0.4 };
+  const double relError = 0.05;
+
+  // One traversal for all bandwidths.
+  std::vector<GaussianKernel> kernels;
+  for (const double bandwidth : bandwidths)
+    kernels.push_back(GaussianKernel(bandwidth));
+
+  EuclideanDistance metric;
+  KDE<GaussianKernel, EuclideanDistance, arma::mat, KDTree> kde(
+      relError, 0.0, GaussianKernel(), KDEMode::KDE_DUAL_TREE_MODE, metric);
+  kde.Train(reference);
+
+  arma::mat treeEstimations;
+  kde.Evaluate(query, kernels, treeEstimations);
+
+  REQUIRE(treeEstimations.n_rows == bandwidths.size());
+  REQUIRE(treeEstimations.n_cols == query.n_cols);
+
+  // Check each bandwidth against brute force.
+  for (size_t b = 0; b < bandwidths.size(); ++b)
+  {
+    arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+    GaussianKernel kernel(bandwidths[b]);
+    BruteForceKDE<GaussianKernel>(reference,
+                                  query,
+                                  bfEstimations,
+                                  kernel);
+
+    for (size_t i = 0; i < query.n_cols; ++i)
+    {
+      REQUIRE(bfEstimations[i] ==
+          Approx(treeEstimations(b, i)).epsilon(relError));
+    }
+  }
+}
+
+/**
+ * Test monochromatic multi-bandwidth evaluation results against brute force
+ * leave-one-out results for each bandwidth.
+ */
+TEST_CASE("MonochromaticMultiBandwidthKDETest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 300);
+  const std::vector<double> bandwidths = { 0.1, 0.2, 0.4 };
+  const double relError = 0.05;
+
+  // One traversal for all bandwidths.
+  std::vector<GaussianKernel> kernels;
+  for (const double bandwidth : bandwidths)
+    kernels.push_back(GaussianKernel(bandwidth));
+
+  EuclideanDistance metric;
+  KDE<GaussianKernel, EuclideanDistance, arma::mat, KDTree> kde(
+      relError, 0.0, GaussianKernel(), KDEMode::KDE_DUAL_TREE_MODE, metric);
+  kde.Train(reference);
+
+  arma::mat treeEstimations;
+  kde.Evaluate(kernels, treeEstimations);
+
+  REQUIRE(treeEstimations.n_rows == bandwidths.size());
+  REQUIRE(treeEstimations.n_cols == reference.n_cols);
+
+  // Check each bandwidth against brute force.
+  for (size_t b = 0; b < bandwidths.size(); ++b)
+  {
+    GaussianKernel kernel(bandwidths[b]);
+    arma::vec bfEstimations = arma::vec(reference.n_cols, arma::fill::zeros);
+    BruteForceKDE<GaussianKernel>(reference,
+                                  reference,
+                                  bfEstimations,
+                                  kernel);
+
+    // Subtract the contribution of each point to itself.
+    bfEstimations -= kernel.Evaluate(0.0) / reference.n_cols;
+
+    for (size_t i = 0; i < reference.n_cols; ++i)
+    {
+      REQUIRE(bfEstimations[i] ==
+          Approx(treeEstimations(b, i)).epsilon(relError));
+    }
+  }
+}
+
+/**
+ * Test that leave-one-out bandwidth selection picks a sensible candidate and
+ * updates the model bandwidth.
+ */
+TEST_CASE("KDEModelSelectBandwidthTest", "[KDETest]")
+{
+  arma::mat reference = arma::randn(1, 500);
+  const arma::vec candidates = { 0.001, 0.35, 25.0 };
+  util::Timers timers;
+
+  KDEModel model(1.0, 0.05, 0.0, KDEModel::GAUSSIAN_KERNEL,
+      KDEModel::KD_TREE);
+  model.BuildModel(timers, std::move(reference));
+
+  const double best = model.SelectBandwidth(timers, candidates);
+
+  // For standard Gaussian data both extreme candidates are far from the
+  // likelihood-optimal bandwidth.
+  REQUIRE(best == Approx(0.35));
+  REQUIRE(model.Bandwidth() == Approx(best));
+}
+
+/**
+ * Test that leave-one-out bandwidth selection also works for the grid-based
+ * evaluator.
+ */
+TEST_CASE("GridKDEModelSelectBandwidthTest", "[KDETest]")
+{
+  arma::mat reference = arma::randn(1, 500);
+  const arma::vec candidates = { 0.02, 0.35, 25.0 };
+  util::Timers timers;
+
+  KDEModel model(1.0, 0.05, 0.0, KDEModel::GAUSSIAN_KERNEL, KDEModel::GRID);
+  model.BuildModel(timers, std::move(reference));
+
+  const double best = model.SelectBandwidth(timers, candidates);
+
+  REQUIRE(best == Approx(0.35));
+  REQUIRE(model.Bandwidth() == Approx(best));
+}
+
 /**
  * Test single-tree implementation results against brute force results.
  */
@@ -1229,3 +1394,103 @@ TEST_CASE("GaussianBreadthDualKDTreeMonteCarloKDE", "[KDETest]")
 
   REQUIRE(correctResults > 70);
 }
+
+/**
+ * Test dual kd-tree implementation results against brute force results using
+ * Monte Carlo estimations with the Epanechnikov kernel.
+ */
+TEST_CASE("EpanechnikovDualKDTreeMonteCarloKDE", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 3000);
+  arma::mat query = arma::randu(2, 200);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  arma::vec treeEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  const double kernelBandwidth = 0.8;
+  const double relError = 0.05;
+
+  // Brute force KDE.
+  EpanechnikovKernel kernel(kernelBandwidth);
+  BruteForceKDE<EpanechnikovKernel>(reference,
+                                    query,
+                                    bfEstimations,
+                                    kernel);
+
+  // Optimized KDE.
+  EuclideanDistance metric;
+  KDE<EpanechnikovKernel, EuclideanDistance, arma::mat, KDTree> kde(
+      relError,
+      0.0,
+      kernel,
+      KDEMode::KDE_DUAL_TREE_MODE,
+      metric,
+      true,
+      0.95,
+      100,
+      3,
+      0.8);
+  kde.Train(reference);
+  kde.Evaluate(query, treeEstimations);
+
+  // The Monte Carlo estimation has a random component so it can fail. Therefore
+  // we require a reasonable amount of results to be right.
+  size_t correctResults = 0;
+  for (size_t i = 0; i < query.n_cols; ++i)
+  {
+    const double resultRelativeError =
+      std::abs((bfEstimations[i] - treeEstimations[i]) / bfEstimations[i]);
+    if (resultRelativeError < relError)
+      ++correctResults;
+  }
+
+  REQUIRE(correctResults > 70);
+}
+
+/**
+ * Test single kd-tree implementation results against brute force results using
+ * Monte Carlo estimations with the spherical kernel.
+ */
+TEST_CASE("SphericalSingleKDTreeMonteCarloKDE", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 3000);
+  arma::mat query = arma::randu(2, 100);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  arma::vec treeEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  const double kernelBandwidth = 0.8;
+  const double relError = 0.05;
+
+  // Brute force KDE.
+  SphericalKernel kernel(kernelBandwidth);
+  BruteForceKDE<SphericalKernel>(reference,
+                                 query,
+                                 bfEstimations,
+                                 kernel);
+
+  // Optimized KDE.
+  EuclideanDistance metric;
+  KDE<SphericalKernel, EuclideanDistance, arma::mat, KDTree> kde(
+      relError,
+      0.0,
+      kernel,
+      KDEMode::KDE_SINGLE_TREE_MODE,
+      metric,
+      true,
+      0.95,
+      100,
+      2,
+      0.7);
+  kde.Train(reference);
+  kde.Evaluate(query, treeEstimations);
+
+  // The Monte Carlo estimation has a random component so it can fail. Therefore
+  // we require a reasonable amount of results to be right.
+  size_t correctResults = 0;
+  for (size_t i = 0; i < query.n_cols; ++i)
+  {
+    const double resultRelativeError =
+      std::abs((bfEstimations[i] - treeEstimations[i]) / bfEstimations[i]);
+    if (resultRelativeError < relError)
+      ++correctResults;
+  }
+
+  REQUIRE(correctResults > 70);
+}
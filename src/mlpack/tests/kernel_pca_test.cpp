@@ -142,3 +142,94 @@ TEST_CASE("CircleTransformationTestNystroem", "[KernelPCATest]")
   REQUIRE(ranges[0].Contains(ranges[2]) == false);
   REQUIRE(ranges[1].Contains(ranges[2]) == false);
 }
+
+/**
+ * The circle transformation should also work when the Nystroem landmarks are
+ * chosen by leverage-score sampling.
+ */
+TEST_CASE("CircleTransformationTestNystroemLeverageScores",
+          "[KernelPCATest]")
+{
+  // The dataset, which will have three concentric rings in three dimensions.
+  arma::mat dataset;
+
+  // Now, there are 750 points centered at the origin with unit variance.
+  dataset.randn(3, 750);
+  dataset *= 0.05;
+
+  // Take the second 250 points and spread them away from the origin.
+  for (size_t i = 250; i < 500; ++i)
+  {
+    // Push the point away from the origin by 2.
+    const double pointNorm = norm(dataset.col(i), 2);
+
+    dataset(0, i) += 2.0 * (dataset(0, i) / pointNorm);
+    dataset(1, i) += 2.0 * (dataset(1, i) / pointNorm);
+    dataset(2, i) += 2.0 * (dataset(2, i) / pointNorm);
+  }
+
+  // Take the third 500 points and spread them away from the origin.
+  for (size_t i = 500; i < 750; ++i)
+  {
+    // Push the point away from the origin by 5.
+    const double pointNorm = norm(dataset.col(i), 2);
+
+    dataset(0, i) += 5.0 * (dataset(0, i) / pointNorm);
+    dataset(1, i) += 5.0 * (dataset(1, i) / pointNorm);
+    dataset(2, i) += 5.0 * (dataset(2, i) / pointNorm);
+  }
+
+  // Perform KernelPCA with the Nystroem method, sampling the landmarks by
+  // leverage scores, to take the data down to one dimension.
+  KernelPCA<GaussianKernel,
+            NystroemKernelRule<GaussianKernel, LeverageScoreSelection>> p;
+  p.Apply(dataset, 1);
+
+  // Get the ranges of each "class".  These are all initialized as empty
+  // ranges containing no points.
+  Range ranges[3];
+  ranges[0] = Range();
+  ranges[1] = Range();
+  ranges[2] = Range();
+
+  // Expand the ranges to hold all of the points in the class.
+  for (size_t i = 0; i < 250; ++i)
+    ranges[0] |= dataset(0, i);
+  for (size_t i = 250; i < 500; ++i)
+    ranges[1] |= dataset(0, i);
+  for (size_t i = 500; i < 750; ++i)
+    ranges[2] |= dataset(0, i);
+
+  // None of these ranges should overlap -- the classes should be linearly
+  // separable.
+  REQUIRE(ranges[0].Contains(ranges[1]) == false);
+  REQUIRE(ranges[0].Contains(ranges[2]) == false);
+  REQUIRE(ranges[1].Contains(ranges[2]) == false);
+}
+
+/**
+ * Leverage-score selection must return the requested number of valid indices
+ * and favor high-leverage points.
+ */
+TEST_CASE("LeverageScoreSelectionTest", "[KernelPCATest]")
+{
+  // 500 points near the origin plus one far outlier: the outlier carries a
+  // whole direction on its own, so it has leverage close to 1 and should be
+  // sampled almost surely.
+  arma::mat data(2, 501, arma::fill::randn);
+  data *= 0.01;
+  data(0, 500) = 100.0;
+  data(1, 500) = 100.0;
+
+  const arma::Col<size_t> selected = LeverageScoreSelection::Select(data, 50);
+
+  REQUIRE(selected.n_elem == 50);
+  bool outlierSelected = false;
+  for (size_t i = 0; i < selected.n_elem; ++i)
+  {
+    REQUIRE(selected[i] < data.n_cols);
+    if (selected[i] == 500)
+      outlierSelected = true;
+  }
+  REQUIRE(outlierSelected);
+}
@@ -619,3 +619,81 @@ TEST_CASE("CauchyKernelTest", "[KernelTest]")
   REQUIRE(ck.Evaluate(a, b) == Approx(0.92592588).epsilon(1e-7));
   REQUIRE(ck.Evaluate(b, a) == Approx(0.92592588).epsilon(1e-7));
 }
+
+/**
+ * The scalar Evaluate(distance) overload of the Cauchy kernel must agree with
+ * the two-vector overload.
+ */
+TEST_CASE("CauchyKernelDistanceEvaluateTest", "[KernelTest]")
+{
+  arma::vec a = { 1.0, 2.0, 3.0 };
+  arma::vec b = { 0.0, 1.0, 5.0 };
+
+  CauchyKernel ck(5.0);
+  const double distance = EuclideanDistance::Evaluate(a, b);
+  REQUIRE(ck.Evaluate(distance) == Approx(ck.Evaluate(a, b)).epsilon(1e-10));
+}
+
+/**
+ * KernelMatrix() must agree with a pairwise Evaluate() loop on all three of
+ * its dispatch paths: dot-product-based kernels, distance-based kernels, and
+ * the generic fallback.
+ */
+TEST_CASE("KernelMatrixTest", "[KernelTest]")
+{
+  arma::mat a(4, 25, arma::fill::randu);
+  arma::mat b(4, 31, arma::fill::randu);
+
+  // Dot-product-based path.
+  {
+    PolynomialKernel pk(3.0, 0.5);
+    arma::mat k;
+    KernelMatrix(a, b, pk, k);
+
+    REQUIRE(k.n_rows == a.n_cols);
+    REQUIRE(k.n_cols == b.n_cols);
+    for (size_t j = 0; j < b.n_cols; ++j)
+      for (size_t i = 0; i < a.n_cols; ++i)
+        REQUIRE(k(i, j) ==
+            Approx(pk.Evaluate(a.col(i), b.col(j))).epsilon(1e-10));
+  }
+
+  // Distance-based path.
+  {
+    GaussianKernel gk(0.5);
+    arma::mat k;
+    KernelMatrix(a, b, gk, k);
+
+    for (size_t j = 0; j < b.n_cols; ++j)
+      for (size_t i = 0; i < a.n_cols; ++i)
+        REQUIRE(k(i, j) ==
+            Approx(gk.Evaluate(a.col(i), b.col(j))).epsilon(1e-10));
+  }
+
+  // Generic fallback path (the cosine distance has no scalar overload and is
+  // not flagged as dot-product-based).
+  {
+    CosineDistance cd;
+    arma::mat k;
+    KernelMatrix(a, b, cd, k);
+
+    for (size_t j = 0; j < b.n_cols; ++j)
+      for (size_t i = 0; i < a.n_cols; ++i)
+        REQUIRE(k(i, j) ==
+            Approx(cd.Evaluate(a.col(i), b.col(j))).epsilon(1e-10));
+  }
+
+  // Subview arguments must work too, so callers can tile large problems.
+  {
+    LaplacianKernel lk(2.0);
+    arma::mat k;
+    KernelMatrix(a.cols(0, 9), b.cols(5, 14), lk, k);
+
+    REQUIRE(k.n_rows == 10);
+    REQUIRE(k.n_cols == 10);
+    for (size_t j = 0; j < 10; ++j)
+      for (size_t i = 0; i < 10; ++i)
+        REQUIRE(k(i, j) ==
+            Approx(lk.Evaluate(a.col(i), b.col(j + 5))).epsilon(1e-10));
+  }
+}
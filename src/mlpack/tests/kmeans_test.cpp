@@ -536,6 +536,61 @@ TEST_CASE("KMeansPlusPlusTest", "[KMeansTest]")
   REQUIRE(distortion < 14500.0);
 }
 
+/**
+ * Test that the k-means|| initialization strategy returns initial cluster
+ * estimates comparable to k-means++.
+ */
+TEST_CASE("KMeansParallelInitializationTest", "[KMeansTest]")
+{
+  // Use the same five-Gaussian dataset as the k-means++ test.
+  arma::mat data(3, 3000);
+  data.randn();
+
+  arma::mat centroids(" 0  5 -2 -6  1;"
+                      " 0  0 -2  8  6;"
+                      " 0 -2 -2  8  1");
+
+  for (size_t i = 1000; i < 1200; ++i)
+    data.col(i) += centroids.col(1);
+  for (size_t i = 1200; i < 1700; ++i)
+    data.col(i) += centroids.col(2);
+  for (size_t i = 1700; i < 1800; ++i)
+    data.col(i) += centroids.col(3);
+  for (size_t i = 1800; i < 3000; ++i)
+    data.col(i) += centroids.col(4);
+
+  KMeansParallelInitialization k;
+  arma::mat resultingCentroids;
+  k.Cluster(data, 5, resultingCentroids);
+
+  // Calculate resulting assignments.
+  arma::Row<size_t> assignments(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    double bestDist = DBL_MAX;
+    for (size_t j = 0; j < 5; ++j)
+    {
+      const double dist = EuclideanDistance::Evaluate(data.col(i),
+          resultingCentroids.col(j));
+      if (dist < bestDist)
+      {
+        bestDist = dist;
+        assignments[i] = j;
+      }
+    }
+  }
+
+  // Calculate sum of distances from centroid means.
+  double distortion = 0;
+  for (size_t i = 0; i < 3000; ++i)
+    distortion += EuclideanDistance::Evaluate(data.col(i),
+        resultingCentroids.col(assignments[i]));
+
+  // k-means|| approximates k-means++, so use the same distortion bound as the
+  // k-means++ test above.
+  REQUIRE(distortion < 14500.0);
+}
+
 #ifdef ARMA_HAS_SPMAT
 /**
  * Make sure sparse k-means works okay.
@@ -652,6 +707,124 @@ TEST_CASE("HamerlyTest", "[KMeansTest]")
   }
 }
 
+/**
+ * Make sure Recluster() reaches a Lloyd fixed point when warm-started from a
+ * previous clustering after some of the data has changed.
+ */
+TEST_CASE("KMeansReclusterTest", "[KMeansTest]")
+{
+  // Three well-separated Gaussian blobs.
+  arma::mat dataset(2, 300, arma::fill::randn);
+  dataset *= 0.5;
+  dataset.cols(100, 199).each_col() += arma::vec("  10.0  10.0");
+  dataset.cols(200, 299).each_col() += arma::vec(" -10.0   5.0");
+
+  KMeans<> km;
+  arma::Row<size_t> assignments;
+  arma::mat centroids;
+  km.Cluster(dataset, 3, assignments, centroids);
+
+  // Now move a few points into other blobs; their assignments are stale.
+  dataset.col(0) = arma::vec(" 10.1   9.9");
+  dataset.col(1) = arma::vec(" -9.9   5.1");
+  dataset.col(150) = arma::vec("  0.1  -0.2");
+
+  km.Recluster(dataset, 3, assignments, centroids);
+
+  // At a Lloyd fixed point, every point is assigned to its closest centroid...
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    arma::vec distances(3);
+    for (size_t c = 0; c < 3; ++c)
+      distances(c) = EuclideanDistance::Evaluate(dataset.col(i),
+          centroids.col(c));
+    REQUIRE(assignments[i] == (size_t) distances.index_min());
+  }
+
+  // ...and every centroid is the mean of its assigned points.
+  arma::mat means(2, 3, arma::fill::zeros);
+  arma::Col<size_t> counts(3, arma::fill::zeros);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    means.col(assignments[i]) += dataset.col(i);
+    counts[assignments[i]]++;
+  }
+  for (size_t c = 0; c < 3; ++c)
+  {
+    REQUIRE(counts[c] > 0);
+    means.col(c) /= counts[c];
+    for (size_t d = 0; d < 2; ++d)
+      REQUIRE(means(d, c) == Approx(centroids(d, c)).epsilon(1e-7));
+  }
+}
+
+/**
+ * Make sure the mini-batch step recovers well-separated clusters.  The
+ * results are stochastic, so the data and the initial centroids are kept
+ * simple.
+ */
+TEST_CASE("MiniBatchKMeansTest", "[KMeansTest]")
+{
+  arma::mat dataset = trans(kMeansData);
+
+  // Start the centroids near the true cluster centers.
+  arma::mat centroids(2, 3);
+  centroids.col(0) = arma::vec("   1.0  1.0");
+  centroids.col(1) = arma::vec("   9.0  9.0");
+  centroids.col(2) = arma::vec(" -11.0  6.0");
+
+  KMeans<EuclideanDistance, SampleInitialization, MaxVarianceNewCluster,
+      MiniBatchKMeans> miniBatch;
+  arma::Row<size_t> assignments;
+  miniBatch.Cluster(dataset, 3, assignments, centroids, false, true);
+
+  // Each class must map to a single distinct cluster.
+  for (size_t i = 1; i < 13; ++i)
+    REQUIRE(assignments(i) == assignments(0));
+  REQUIRE(assignments(13) != assignments(0));
+  for (size_t i = 14; i < 20; ++i)
+    REQUIRE(assignments(i) == assignments(13));
+  REQUIRE(assignments(20) != assignments(0));
+  REQUIRE(assignments(20) != assignments(13));
+  for (size_t i = 21; i < 30; ++i)
+    REQUIRE(assignments(i) == assignments(20));
+}
+
+TEST_CASE("BlockedKMeansTest", "[KMeansTest]")
+{
+  const size_t trials = 5;
+
+  for (size_t t = 0; t < trials; ++t)
+  {
+    arma::mat dataset(10, 1000);
+    dataset.randu();
+
+    const size_t k = 5 * (t + 1);
+    arma::mat centroids(10, k);
+    centroids.randu();
+
+    // Make sure the blocked Lloyd step and the naive method return the same
+    // clusters.
+    arma::mat naiveCentroids(centroids);
+    KMeans<> km;
+    arma::Row<size_t> assignments;
+    km.Cluster(dataset, k, assignments, naiveCentroids, false, true);
+
+    KMeans<EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+        BlockedKMeans> blocked;
+    arma::Row<size_t> blockedAssignments;
+    arma::mat blockedCentroids(centroids);
+    blocked.Cluster(dataset, k, blockedAssignments, blockedCentroids, false,
+        true);
+
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+      REQUIRE(assignments[i] == blockedAssignments[i]);
+
+    for (size_t i = 0; i < centroids.n_elem; ++i)
+      REQUIRE(naiveCentroids[i] == Approx(blockedCentroids[i]).epsilon(1e-7));
+  }
+}
+
 TEST_CASE("PellegMooreTest", "[KMeansTest]")
 {
   const size_t trials = 5;
@@ -1825,3 +1825,785 @@ TEST_CASE("KNNSpillTreeSearchEnoughResults", "[KNNTest]")
   REQUIRE(arma::accu(distancesGreedy < 0.0 || distancesGreedy > std::sqrt(3.0))
       == 0);
 }
+
+/**
+ * Test that the parallel dual-tree traverser returns the same results as the
+ * standard depth-first dual-tree traverser.
+ */
+TEST_CASE("KNNParallelDualTreeTraverserTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(8, 1000);
+
+  using ParallelKNN = NeighborSearch<NearestNeighborSort, EuclideanDistance,
+      arma::mat, KDTree,
+      KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+          arma::mat>::ParallelDualTreeTraverser>;
+
+  KNN knn(dataset);
+  ParallelKNN parallelKnn(dataset);
+
+  arma::Mat<size_t> neighbors, parallelNeighbors;
+  arma::mat distances, parallelDistances;
+  knn.Search(10, neighbors, distances);
+  parallelKnn.Search(10, parallelNeighbors, parallelDistances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors(i) == parallelNeighbors(i));
+    REQUIRE(distances(i) == Approx(parallelDistances(i)).epsilon(1e-7));
+  }
+}
+
+/**
+ * Test that the streaming block-wise Search() overload gives the same results
+ * as a single monolithic Search() call.
+ */
+TEST_CASE("KNNStreamingSearchTest", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(5, 500);
+  arma::mat querySet = arma::randu<arma::mat>(5, 203); // Partial last block.
+
+  KNN knn(referenceSet);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(querySet, 3, neighbors, distances);
+
+  arma::Mat<size_t> streamedNeighbors(3, querySet.n_cols);
+  arma::mat streamedDistances(3, querySet.n_cols);
+  knn.Search(querySet, 3, 50,
+      [&](const size_t blockBegin,
+          const arma::Mat<size_t>& blockNeighbors,
+          const arma::mat& blockDistances)
+      {
+        streamedNeighbors.cols(blockBegin,
+            blockBegin + blockNeighbors.n_cols - 1) = blockNeighbors;
+        streamedDistances.cols(blockBegin,
+            blockBegin + blockDistances.n_cols - 1) = blockDistances;
+      });
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors(i) == streamedNeighbors(i));
+    REQUIRE(distances(i) == Approx(streamedDistances(i)).epsilon(1e-7));
+  }
+}
+
+/**
+ * Test that a single-precision KNN search gives the same neighbors as a
+ * double-precision search, with distances that agree to float tolerance.
+ */
+TEST_CASE("KNNSinglePrecisionTest", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(8, 400);
+  arma::mat querySet = arma::randu<arma::mat>(8, 100);
+
+  KNN knn(referenceSet);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(querySet, 5, neighbors, distances);
+
+  using FloatKNN = NeighborSearch<NearestNeighborSort, EuclideanDistance,
+      arma::fmat, KDTree>;
+  FloatKNN floatKnn(arma::conv_to<arma::fmat>::from(referenceSet));
+  arma::Mat<size_t> floatNeighbors;
+  arma::fmat floatDistances;
+  floatKnn.Search(arma::conv_to<arma::fmat>::from(querySet), 5, floatNeighbors,
+      floatDistances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors(i) == floatNeighbors(i));
+    REQUIRE(distances(i) == Approx((double) floatDistances(i)).epsilon(1e-4));
+  }
+}
+
+/**
+ * Test that mixed-precision search returns exact double-precision distances.
+ */
+TEST_CASE("KNNMixedPrecisionSearchTest", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(8, 400);
+  arma::mat querySet = arma::randu<arma::mat>(8, 100);
+
+  KNN knn(referenceSet);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(querySet, 5, neighbors, distances);
+
+  arma::Mat<size_t> mixedNeighbors;
+  arma::mat mixedDistances;
+  MixedPrecisionSearch<>(referenceSet, querySet, 5, mixedNeighbors,
+      mixedDistances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors(i) == mixedNeighbors(i));
+    // The refined distances are computed in double precision, so they should
+    // agree with the all-double search to machine precision.
+    REQUIRE(distances(i) == Approx(mixedDistances(i)).epsilon(1e-12));
+  }
+}
+
+/**
+ * Test that the product quantization index gives exact results when the
+ * re-ranking candidate set covers the whole reference set, with and without
+ * an optimized rotation.
+ */
+TEST_CASE("KNNPQIndexTest", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(10, 300);
+  arma::mat querySet = arma::randu<arma::mat>(10, 100);
+
+  KNN naive(referenceSet, NAIVE_MODE);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  naive.Search(querySet, 5, neighbors, distances);
+
+  // Re-ranking every reference point makes the search exact, regardless of
+  // how lossy the quantization is.
+  PQIndex<> pq(referenceSet, 2 /* numSubspaces */, 16 /* numCodewords */);
+  arma::Mat<size_t> pqNeighbors;
+  arma::mat pqDistances;
+  pq.Search(querySet, 5, pqNeighbors, pqDistances, referenceSet.n_cols);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors(i) == pqNeighbors(i));
+    REQUIRE(distances(i) == Approx(pqDistances(i)).epsilon(1e-10));
+  }
+
+  // The same should hold when an optimized rotation is trained.
+  PQIndex<> opq(referenceSet, 2, 16, 3 /* opqIterations */);
+  opq.Search(querySet, 5, pqNeighbors, pqDistances, referenceSet.n_cols);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors(i) == pqNeighbors(i));
+    REQUIRE(distances(i) == Approx(pqDistances(i)).epsilon(1e-10));
+  }
+}
+
+/**
+ * Test that monochromatic PQ search never returns a point as its own
+ * neighbor.
+ */
+TEST_CASE("KNNPQIndexMonochromaticTest", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(8, 200);
+
+  PQIndex<> pq(referenceSet, 4, 16);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  pq.Search(3, neighbors, distances);
+
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+    for (size_t j = 0; j < neighbors.n_rows; ++j)
+      REQUIRE(neighbors(j, i) != i);
+}
+
+/**
+ * Test that an attached TraversalStatistics collector agrees with the
+ * traverser's own counters and produces a machine-readable report.
+ */
+TEST_CASE("DualTreeTraverserStatisticsTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 300);
+
+  typedef KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+  std::vector<size_t> oldFromNew;
+  TreeType tree(dataset, oldFromNew);
+
+  typedef NeighborSearchRules<NearestNeighborSort, EuclideanDistance, TreeType>
+      RuleType;
+  EuclideanDistance metric;
+  RuleType rules(tree.Dataset(), tree.Dataset(), 3, metric, 0, true);
+
+  TreeType::DualTreeTraverser<RuleType> traverser(rules);
+  TraversalStatistics stats;
+  traverser.EnableStatistics(stats);
+  traverser.Traverse(tree, tree);
+
+  // The per-depth totals must agree with the traverser's own counters.
+  REQUIRE(stats.TotalVisits() == traverser.NumVisited());
+  REQUIRE(stats.TotalScores() == traverser.NumScores());
+  REQUIRE(stats.TotalPrunes() == traverser.NumPrunes());
+  REQUIRE(stats.TotalBaseCases() == traverser.NumBaseCases());
+  REQUIRE(stats.TotalBaseCases() > 0);
+
+  // The root was visited exactly once.
+  REQUIRE(stats.Visits().size() > 1);
+  REQUIRE(stats.Visits()[0] == 1);
+
+  // Every leaf combination that evaluated base cases is in the histogram.
+  size_t histogramTotal = 0;
+  for (size_t b = 0; b < stats.BaseCaseHistogram().size(); ++b)
+    histogramTotal += stats.BaseCaseHistogram()[b];
+  REQUIRE(histogramTotal > 0);
+
+  // The report must at least be structurally sane.
+  std::ostringstream report;
+  stats.Report(report);
+  REQUIRE(report.str().find("\"depths\"") != std::string::npos);
+  REQUIRE(report.str().find("\"baseCaseHistogram\"") != std::string::npos);
+
+  // A second traversal without the collector should leave it untouched.
+  const size_t oldVisits = stats.TotalVisits();
+  traverser.DisableStatistics();
+  traverser.Traverse(tree, tree);
+  REQUIRE(stats.TotalVisits() == oldVisits);
+}
+
+/**
+ * Test that the best-first dual-tree traverser gives the same results as the
+ * default depth-first dual-tree traverser.
+ */
+TEST_CASE("KNNBestFirstDualTreeTraverserTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(8, 1000);
+
+  using BestFirstKNN = NeighborSearch<NearestNeighborSort, EuclideanDistance,
+      arma::mat, KDTree,
+      KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+          arma::mat>::BestFirstDualTreeTraverser>;
+
+  KNN knn(dataset);
+  BestFirstKNN bfKnn(dataset);
+
+  arma::Mat<size_t> neighbors, bfNeighbors;
+  arma::mat distances, bfDistances;
+  knn.Search(10, neighbors, distances);
+  bfKnn.Search(10, bfNeighbors, bfDistances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors(i) == bfNeighbors(i));
+    REQUIRE(distances(i) == Approx(bfDistances(i)).epsilon(1e-7));
+  }
+}
+
+/**
+ * Test that a compile-time-dimensionality metric threaded through the kd-tree
+ * gives the same results as the runtime Euclidean metric.
+ */
+TEST_CASE("KNNFixedDimMetricTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(8, 500);
+
+  NeighborSearch<NearestNeighborSort, FixedDimLMetric<8>, arma::mat, KDTree>
+      fixedKnn(dataset);
+  KNN knn(dataset);
+
+  arma::Mat<size_t> fixedNeighbors, neighbors;
+  arma::mat fixedDistances, distances;
+  fixedKnn.Search(5, fixedNeighbors, fixedDistances);
+  knn.Search(5, neighbors, distances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(fixedNeighbors(i) == neighbors(i));
+    REQUIRE(fixedDistances(i) == Approx(distances(i)).epsilon(1e-7));
+  }
+}
+
+/**
+ * Test that adaptive backtracking in the defeatist spill tree traverser never
+ * gives worse candidates than the plain defeatist descent.
+ */
+TEST_CASE("KNNSpillTreeAdaptiveBacktrackingTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 800);
+  arma::mat querySet = arma::randu<arma::mat>(5, 100);
+  const size_t k = 3;
+
+  typedef SPTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+
+  // Plain defeatist search.
+  TreeType tree(dataset, 0.05 /* tau parameter */);
+  SpillKNN defeatist(std::move(tree), SINGLE_TREE_MODE);
+  arma::Mat<size_t> defeatistNeighbors;
+  arma::mat defeatistDistances;
+  defeatist.Search(querySet, k, defeatistNeighbors, defeatistDistances);
+
+  // Adaptive defeatist search, driven directly through the traverser.
+  TreeType adaptiveTree(dataset, 0.05 /* tau parameter */);
+  typedef NeighborSearchRules<NearestNeighborSort, EuclideanDistance, TreeType>
+      RuleType;
+  EuclideanDistance metric;
+  RuleType rules(adaptiveTree.Dataset(), querySet, k, metric, 0, false);
+
+  TreeType::DefeatistSingleTreeTraverser<RuleType> traverser(rules);
+  traverser.AdaptiveBacktracking() = true;
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+    traverser.Traverse(i, adaptiveTree);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  rules.GetResults(neighbors, distances);
+
+  // The adaptive traversal visits a superset of the nodes the defeatist
+  // descent visits, so every candidate slot can only improve.
+  for (size_t i = 0; i < distances.n_elem; ++i)
+    REQUIRE(distances(i) <= defeatistDistances(i) + 1e-10);
+}
+
+/**
+ * Perform several monochromatic dual-tree searches in a row with the same
+ * object.  After the first search the bounds cached in the tree statistics
+ * are stale and must be invalidated (this is now done lazily with a
+ * generation stamp instead of a full-tree reset walk), so every repetition
+ * must still agree with brute-force search.
+ */
+TEST_CASE("KNNRepeatedMonochromaticSearchTest", "[KNNTest]")
+{
+  arma::mat dataset(8, 1000, arma::fill::randu);
+
+  KNN knn(dataset, DUAL_TREE_MODE);
+  KNN naive(dataset, NAIVE_MODE);
+
+  arma::Mat<size_t> naiveNeighbors;
+  arma::mat naiveDistances;
+  naive.Search(5, naiveNeighbors, naiveDistances);
+
+  for (size_t trial = 0; trial < 3; ++trial)
+  {
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    knn.Search(5, neighbors, distances);
+
+    for (size_t i = 0; i < neighbors.n_elem; ++i)
+    {
+      REQUIRE(neighbors[i] == naiveNeighbors[i]);
+      REQUIRE(distances[i] == Approx(naiveDistances[i]).epsilon(1e-10));
+    }
+  }
+}
+
+/**
+ * Test that the inverted-file index gives exact results when every list is
+ * probed, regardless of how the coarse quantizer came out.
+ */
+TEST_CASE("KNNIFIndexTest", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(10, 300);
+  arma::mat querySet = arma::randu<arma::mat>(10, 100);
+
+  KNN naive(referenceSet, NAIVE_MODE);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  naive.Search(querySet, 5, neighbors, distances);
+
+  IFIndex<> ivf(referenceSet, 10 /* numLists */);
+  arma::Mat<size_t> ivfNeighbors;
+  arma::mat ivfDistances;
+  ivf.Search(querySet, 5, ivfNeighbors, ivfDistances, 10 /* numProbes */);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors(i) == ivfNeighbors(i));
+    REQUIRE(distances(i) == Approx(ivfDistances(i)).epsilon(1e-10));
+  }
+}
+
+/**
+ * Test the inverted-file index on sparse data, where it is meant to be used.
+ * Probing every list again makes the search exact, so the results must match
+ * a brute-force search on a densified copy of the data.
+ */
+TEST_CASE("KNNIFIndexSparseTest", "[KNNTest]")
+{
+  // The dimensionality of these datasets must be high so that the probability
+  // of a completely empty point is very low (see SparseKNNKDTreeTest).
+  arma::sp_mat queryDataset;
+  queryDataset.sprandu(70, 200, 0.2);
+  arma::sp_mat referenceDataset;
+  referenceDataset.sprandu(70, 500, 0.1);
+  arma::mat denseQuery(queryDataset);
+  arma::mat denseReference(referenceDataset);
+
+  KNN naive(denseReference, NAIVE_MODE);
+  arma::Mat<size_t> naiveNeighbors;
+  arma::mat naiveDistances;
+  naive.Search(denseQuery, 10, naiveNeighbors, naiveDistances);
+
+  IFIndex<NearestNeighborSort, arma::sp_mat> ivf(referenceDataset, 15);
+  arma::Mat<size_t> ivfNeighbors;
+  arma::mat ivfDistances;
+  ivf.Search(queryDataset, 10, ivfNeighbors, ivfDistances, 15);
+
+  for (size_t i = 0; i < naiveNeighbors.n_elem; ++i)
+  {
+    REQUIRE(naiveNeighbors(i) == ivfNeighbors(i));
+    REQUIRE(naiveDistances(i) == Approx(ivfDistances(i)).epsilon(1e-7));
+  }
+}
+
+/**
+ * Test that monochromatic inverted-file search never returns a point as its
+ * own neighbor.
+ */
+TEST_CASE("KNNIFIndexMonochromaticTest", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(8, 200);
+
+  IFIndex<> ivf(referenceSet, 10);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  ivf.Search(3, neighbors, distances, 10);
+
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+    for (size_t j = 0; j < neighbors.n_rows; ++j)
+      REQUIRE(neighbors(j, i) != i);
+}
+
+/**
+ * Test that CheckpointedSearch() gives the same results as a plain Search(),
+ * that it resumes from a partial checkpoint without recomputing the
+ * completed blocks, and that it removes its checkpoint file when done.
+ */
+TEST_CASE("KNNCheckpointedSearchTest", "[KNNTest]")
+{
+  arma::mat referenceSet(5, 300, arma::fill::randu);
+  arma::mat querySet(5, 107, arma::fill::randu);
+  const size_t k = 3;
+
+  KNN knn(referenceSet);
+  arma::Mat<size_t> expectedNeighbors;
+  arma::mat expectedDistances;
+  knn.Search(querySet, k, expectedNeighbors, expectedDistances);
+
+  const std::string file = "knn_checkpoint_test.bin";
+  remove(file.c_str());
+
+  // A fresh run must match the plain search and clean up its file.
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  CheckpointedSearch(knn, querySet, k, neighbors, distances, file, 25);
+
+  REQUIRE(arma::all(arma::vectorise(neighbors == expectedNeighbors)));
+  CheckMatrices(distances, expectedDistances);
+  REQUIRE(!std::ifstream(file).is_open());
+
+  // Simulate a preempted run: write a checkpoint with the first 50 query
+  // points complete and garbage afterwards.  Resuming must fill in only the
+  // rest and still produce the full correct results.
+  {
+    arma::Mat<size_t> partialNeighbors(k, querySet.n_cols, arma::fill::zeros);
+    arma::mat partialDistances(k, querySet.n_cols, arma::fill::zeros);
+    partialNeighbors.cols(0, 49) = expectedNeighbors.cols(0, 49);
+    partialDistances.cols(0, 49) = expectedDistances.cols(0, 49);
+
+    std::ofstream ofs(file, std::ios::binary | std::ios::trunc);
+    cereal::BinaryOutputArchive ar(ofs);
+    ar((size_t) k, (size_t) querySet.n_cols, (size_t) 50, partialNeighbors,
+        partialDistances);
+  }
+
+  CheckpointedSearch(knn, querySet, k, neighbors, distances, file, 25);
+  REQUIRE(arma::all(arma::vectorise(neighbors == expectedNeighbors)));
+  CheckMatrices(distances, expectedDistances);
+
+  // A checkpoint with the wrong k must be ignored, not resumed from.
+  {
+    arma::Mat<size_t> partialNeighbors(k + 1, querySet.n_cols,
+        arma::fill::zeros);
+    arma::mat partialDistances(k + 1, querySet.n_cols, arma::fill::zeros);
+    std::ofstream ofs(file, std::ios::binary | std::ios::trunc);
+    cereal::BinaryOutputArchive ar(ofs);
+    ar((size_t) (k + 1), (size_t) querySet.n_cols, (size_t) 50,
+        partialNeighbors, partialDistances);
+  }
+
+  CheckpointedSearch(knn, querySet, k, neighbors, distances, file, 25);
+  REQUIRE(arma::all(arma::vectorise(neighbors == expectedNeighbors)));
+  CheckMatrices(distances, expectedDistances);
+}
+
+/**
+ * Test anytime search with a work budget.  A generous budget must reproduce
+ * the exact results with full confidence; a tiny budget must still return
+ * validly-shaped results with sane confidences.
+ */
+TEST_CASE("KNNSearchBudgetTest", "[KNNTest]")
+{
+  arma::mat referenceSet(5, 500, arma::fill::randu);
+  arma::mat querySet(5, 120, arma::fill::randu);
+  const size_t k = 3;
+
+  KNN exact(referenceSet);
+  arma::Mat<size_t> expectedNeighbors;
+  arma::mat expectedDistances;
+  exact.Search(querySet, k, expectedNeighbors, expectedDistances);
+
+  // A budget far larger than the work an unbudgeted search needs must not
+  // change the results, and every query must have full confidence.
+  KNN generous(referenceSet);
+  generous.Budget() = 100 * referenceSet.n_cols * querySet.n_cols;
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  generous.Search(querySet, k, neighbors, distances);
+
+  REQUIRE(arma::all(arma::vectorise(neighbors == expectedNeighbors)));
+  CheckMatrices(distances, expectedDistances);
+  REQUIRE(generous.Confidences().n_elem == querySet.n_cols);
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+    REQUIRE(generous.Confidences()[i] == Approx(1.0));
+
+  // A tiny budget must produce results of the right shape, with finite
+  // distances for at least some queries (the best-first traversal finds
+  // candidates early) and confidences in [0, 1], not all equal to 1.
+  KNN stingy(referenceSet);
+  stingy.Budget() = 200;
+  stingy.Search(querySet, k, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == k);
+  REQUIRE(neighbors.n_cols == querySet.n_cols);
+  REQUIRE(distances.n_rows == k);
+  REQUIRE(distances.n_cols == querySet.n_cols);
+  REQUIRE(stingy.Confidences().n_elem == querySet.n_cols);
+  bool anyPartial = false;
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    REQUIRE(stingy.Confidences()[i] >= 0.0);
+    REQUIRE(stingy.Confidences()[i] <= 1.0);
+    if (stingy.Confidences()[i] < 1.0)
+      anyPartial = true;
+  }
+  REQUIRE(anyPartial);
+  // The budget must actually have limited the work.
+  REQUIRE(stingy.BaseCases() + stingy.Scores() <
+      exact.BaseCases() + exact.Scores());
+
+  // Single-tree mode must respect the budget too.
+  KNN single(referenceSet, SINGLE_TREE_MODE);
+  single.Budget() = 200;
+  single.Search(querySet, k, neighbors, distances);
+  REQUIRE(single.Confidences().n_elem == querySet.n_cols);
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    REQUIRE(single.Confidences()[i] >= 0.0);
+    REQUIRE(single.Confidences()[i] <= 1.0);
+  }
+
+  // Naive mode ignores the budget and always gives exact results.
+  KNN naive(referenceSet, NAIVE_MODE);
+  naive.Budget() = 200;
+  naive.Search(querySet, k, neighbors, distances);
+  REQUIRE(arma::all(arma::vectorise(neighbors == expectedNeighbors)));
+  CheckMatrices(distances, expectedDistances);
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+    REQUIRE(naive.Confidences()[i] == Approx(1.0));
+}
+
+/**
+ * Make sure that repeated searches through a SearchWorkspace give exactly the
+ * same results as plain Search() calls, in every search mode and when the
+ * query set size and k change between calls.
+ */
+TEST_CASE("KNNSearchWorkspaceTest", "[KNNTest]")
+{
+  arma::mat referenceData;
+  referenceData.randu(6, 400);
+
+  const NeighborSearchMode modes[3] =
+      { DUAL_TREE_MODE, SINGLE_TREE_MODE, NAIVE_MODE };
+  for (size_t m = 0; m < 3; ++m)
+  {
+    KNN knn(referenceData, modes[m]);
+    KNN::SearchWorkspace workspace;
+
+    const size_t querySizes[3] = { 100, 35, 100 };
+    const size_t ks[3] = { 5, 8, 5 };
+    for (size_t trial = 0; trial < 3; ++trial)
+    {
+      arma::mat queryData;
+      queryData.randu(6, querySizes[trial]);
+
+      arma::Mat<size_t> neighbors, wsNeighbors;
+      arma::mat distances, wsDistances;
+      knn.Search(queryData, ks[trial], neighbors, distances);
+      knn.Search(queryData, ks[trial], wsNeighbors, wsDistances, workspace);
+
+      REQUIRE(wsNeighbors.n_rows == neighbors.n_rows);
+      REQUIRE(wsNeighbors.n_cols == neighbors.n_cols);
+      for (size_t i = 0; i < neighbors.n_elem; ++i)
+      {
+        REQUIRE(wsNeighbors[i] == neighbors[i]);
+        REQUIRE(wsDistances[i] == Approx(distances[i]).epsilon(1e-10));
+      }
+    }
+
+    // Clearing the workspace must not affect later searches.
+    workspace.Clear();
+    arma::mat queryData;
+    queryData.randu(6, 50);
+    arma::Mat<size_t> neighbors, wsNeighbors;
+    arma::mat distances, wsDistances;
+    knn.Search(queryData, 3, neighbors, distances);
+    knn.Search(queryData, 3, wsNeighbors, wsDistances, workspace);
+    for (size_t i = 0; i < neighbors.n_elem; ++i)
+      REQUIRE(wsNeighbors[i] == neighbors[i]);
+  }
+}
+
+/**
+ * Test that greedy traversal with a backtrack budget never returns worse
+ * results than pure defeatist search, and converges to the exact results as
+ * the budget grows.
+ */
+TEST_CASE("KNNGreedyBacktrackTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(8, 1000);
+  arma::mat queries = arma::randu<arma::mat>(8, 100);
+
+  // Exact results for reference.
+  KNN exact(dataset);
+  arma::Mat<size_t> exactNeighbors;
+  arma::mat exactDistances;
+  exact.Search(queries, 5, exactNeighbors, exactDistances);
+
+  typedef KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+  std::vector<size_t> oldFromNew;
+  TreeType tree(dataset, oldFromNew);
+
+  typedef NeighborSearchRules<NearestNeighborSort, EuclideanDistance, TreeType>
+      RuleType;
+  EuclideanDistance metric;
+
+  const size_t budgets[3] = { 0, 10, 2000 };
+  arma::mat allDistances[3];
+  for (size_t b = 0; b < 3; ++b)
+  {
+    RuleType rules(tree.Dataset(), queries, 5, metric);
+    GreedySingleTreeTraverser<TreeType, RuleType> traverser(rules);
+    traverser.Backtracks() = budgets[b];
+
+    for (size_t i = 0; i < queries.n_cols; ++i)
+      traverser.Traverse(i, tree);
+
+    arma::Mat<size_t> neighbors;
+    rules.GetResults(neighbors, allDistances[b]);
+
+    // Defeatist results can never beat the exact results.
+    for (size_t i = 0; i < allDistances[b].n_elem; ++i)
+      REQUIRE(allDistances[b][i] >= exactDistances[i] - 1e-10);
+  }
+
+  // A larger budget only adds base cases on top of the same greedy descent,
+  // so the distances can only improve.
+  for (size_t i = 0; i < allDistances[0].n_elem; ++i)
+  {
+    REQUIRE(allDistances[1][i] <= allDistances[0][i] + 1e-10);
+    REQUIRE(allDistances[2][i] <= allDistances[1][i] + 1e-10);
+  }
+
+  // With a budget this large the search is effectively exhaustive.
+  for (size_t i = 0; i < allDistances[2].n_elem; ++i)
+    REQUIRE(allDistances[2][i] == Approx(exactDistances[i]).margin(1e-10));
+}
+
+/**
+ * Test that the leaf size autotuner returns sane values and that the build
+ * cost term pushes the recommendation towards larger leaves.
+ */
+TEST_CASE("TuneLeafSizeTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(6, 800);
+
+  const size_t tuned = TuneLeafSize(dataset, 5, 500, 100);
+
+  // The result must come from inside the probed range.
+  REQUIRE(tuned >= 1);
+  REQUIRE(tuned <= 128);
+
+  // A heavy build cost term penalizes deep trees, so the recommendation can
+  // only move towards larger leaves.
+  const size_t tunedWithBuild = TuneLeafSize(dataset, 5, 500, 100, 2.0,
+      1000.0);
+  REQUIRE(tunedWithBuild >= tuned);
+
+  // Invalid arguments must be rejected.
+  arma::mat empty(6, 0);
+  REQUIRE_THROWS_AS(TuneLeafSize(empty, 5), std::invalid_argument);
+  REQUIRE_THROWS_AS(TuneLeafSize(dataset, 0), std::invalid_argument);
+}
+
+/**
+ * Test that early-abandoning base cases still give exact results on
+ * high-dimensional data (where the partial-distance checks actually trigger).
+ */
+TEST_CASE("KNNEarlyAbandonExactnessTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(200, 400);
+
+  KNN knn(dataset);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(3, neighbors, distances);
+
+  KNN naive(dataset, NAIVE_MODE);
+  arma::Mat<size_t> naiveNeighbors;
+  arma::mat naiveDistances;
+  naive.Search(3, naiveNeighbors, naiveDistances);
+
+  // Verify against brute force computed directly with Armadillo.
+  for (size_t i = 0; i < 20; ++i)
+  {
+    arma::vec dists(dataset.n_cols);
+    for (size_t j = 0; j < dataset.n_cols; ++j)
+      dists[j] = arma::norm(dataset.col(i) - dataset.col(j));
+    dists[i] = DBL_MAX; // Exclude the point itself.
+    arma::uvec order = arma::sort_index(dists);
+
+    for (size_t j = 0; j < 3; ++j)
+    {
+      REQUIRE(distances(j, i) == Approx(dists[order[j]]).epsilon(1e-10));
+      REQUIRE(naiveDistances(j, i) == Approx(dists[order[j]]).epsilon(1e-10));
+    }
+  }
+
+  CheckMatrices(distances, naiveDistances);
+}
+
+/**
+ * Test that sharded search gives exact results and prunes distant shards on
+ * clustered data.
+ */
+TEST_CASE("ShardedNeighborSearchTest", "[KNNTest]")
+{
+  // Three well-separated clusters.
+  arma::mat dataset(5, 900);
+  dataset.cols(0, 299) = arma::randu<arma::mat>(5, 300);
+  dataset.cols(300, 599) = arma::randu<arma::mat>(5, 300) + 10.0;
+  dataset.cols(600, 899) = arma::randu<arma::mat>(5, 300) - 10.0;
+  arma::mat queries = dataset.cols(0, 99) + 0.01;
+
+  KNN exact(dataset);
+  arma::Mat<size_t> exactNeighbors;
+  arma::mat exactDistances;
+  exact.Search(queries, 5, exactNeighbors, exactDistances);
+
+  ShardedNeighborSearch<> sharded(dataset, 8);
+  REQUIRE(sharded.NumShards() >= 2);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  sharded.Search(queries, 5, neighbors, distances);
+
+  CheckMatrices(distances, exactDistances);
+
+  // All queries sit inside the first cluster, so the shards covering the
+  // other clusters must have been pruned for at least some queries.
+  REQUIRE(sharded.ShardPrunes() > 0);
+
+  // Invalid arguments must be rejected.
+  REQUIRE_THROWS_AS(sharded.Search(queries, 0, neighbors, distances),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(sharded.Search(queries, 901, neighbors, distances),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(ShardedNeighborSearch<>(dataset, 0),
+      std::invalid_argument);
+}
@@ -667,6 +667,100 @@ TEST_CASE("PredictFitInterceptNormalizeDataTest", "[LARSTest]")
   }
 }
 
+/**
+ * Test that coordinate descent training on a one-element lambda grid gives
+ * the same solution as the homotopy algorithm, for every combination of
+ * elastic net, intercept fitting, and data normalization.
+ */
+TEST_CASE("LARSTestCDSingleLambda", "[LARSTest]")
+{
+  arma::mat X;
+  arma::rowvec y;
+
+  for (size_t trial = 0; trial < 8; ++trial)
+  {
+    const bool elasticNet = trial & 1;
+    const bool fitIntercept = trial & 2;
+    const bool normalizeData = trial & 4;
+
+    GenerateProblem(X, y, 100, 10);
+
+    // Armadillo's median is broken, so...
+    arma::vec sortedAbsCorr = sort(abs(X * y.t()));
+    const double lambda1 = sortedAbsCorr(5);
+    const double lambda2 = elasticNet ? lambda1 / 2 : 0.0;
+
+    LARS lars(false, lambda1, lambda2);
+    lars.FitIntercept(fitIntercept);
+    lars.NormalizeData(normalizeData);
+    arma::vec betaOpt;
+    lars.Train(X, y, betaOpt);
+
+    LARS larsCD(false, 0.0 /* ignored */, lambda2);
+    larsCD.FitIntercept(fitIntercept);
+    larsCD.NormalizeData(normalizeData);
+    arma::vec betaCD;
+    larsCD.TrainCD(X, y, arma::vec { lambda1 }, betaCD);
+
+    REQUIRE(betaCD.n_elem == betaOpt.n_elem);
+    for (size_t j = 0; j < betaOpt.n_elem; ++j)
+      REQUIRE(betaCD[j] == Approx(betaOpt[j]).margin(1e-5));
+    REQUIRE(larsCD.Intercept() == Approx(lars.Intercept()).margin(1e-5));
+  }
+}
+
+/**
+ * Test warm-started coordinate descent on a grid of lambda values: each
+ * solution on the path must match a separately-trained homotopy model, and
+ * the path bookkeeping must be consistent.
+ */
+TEST_CASE("LARSTestCDWarmStartPath", "[LARSTest]")
+{
+  arma::mat X;
+  arma::rowvec y;
+  GenerateProblem(X, y, 250, 25);
+
+  const double maxCorr = arma::abs(X * y.t()).max();
+  arma::vec lambdaGrid = maxCorr * arma::vec { 0.5, 0.2, 0.05 };
+
+  LARS larsCD;
+  larsCD.TrainCD(X, y, lambdaGrid);
+
+  REQUIRE(larsCD.BetaPath().size() == lambdaGrid.n_elem);
+  REQUIRE(larsCD.LambdaPath().size() == lambdaGrid.n_elem);
+  REQUIRE(larsCD.InterceptPath().size() == lambdaGrid.n_elem);
+
+  for (size_t l = 0; l < lambdaGrid.n_elem; ++l)
+  {
+    REQUIRE(larsCD.LambdaPath()[l] == Approx(lambdaGrid[l]));
+
+    // Train a homotopy model for this lambda value only.
+    LARS lars(false, lambdaGrid[l]);
+    arma::vec betaOpt;
+    lars.Train(X, y, betaOpt);
+
+    const arma::vec& betaCD = larsCD.BetaPath()[l];
+    REQUIRE(betaCD.n_elem == betaOpt.n_elem);
+    for (size_t j = 0; j < betaOpt.n_elem; ++j)
+      REQUIRE(betaCD[j] == Approx(betaOpt[j]).margin(1e-5));
+    REQUIRE(larsCD.InterceptPath()[l] ==
+        Approx(lars.Intercept()).margin(1e-5));
+  }
+
+  // The active set must hold exactly the nonzero dimensions of the last
+  // solution.
+  for (size_t j = 0; j < larsCD.Beta().n_elem; ++j)
+  {
+    const bool isInActiveSet = std::find(larsCD.ActiveSet().begin(),
+        larsCD.ActiveSet().end(), j) != larsCD.ActiveSet().end();
+    REQUIRE(isInActiveSet == (larsCD.Beta()[j] != 0.0));
+  }
+
+  // An empty grid is not allowed.
+  REQUIRE_THROWS_AS(larsCD.TrainCD(X, y, arma::vec()),
+      std::invalid_argument);
+}
+
 /**
  * Verify that KKT conditions are satisfied for a solution of the standard Lasso
  * problem (with X, y and lambda) (own version)
@@ -198,6 +198,77 @@ TEST_CASE("LinearRegressionTrainTest", "[LinearRegressionTest]")
         Approx(lrTrain.Parameters()[i]).epsilon(1e-7));
 }
 
+/**
+ * Test that a model built with TrainIncremental() matches a model trained
+ * from scratch on the same points.
+ */
+TEST_CASE("LinearRegressionIncrementalTest", "[LinearRegressionTest]")
+{
+  // Random dataset.
+  arma::mat dataset = arma::randu<arma::mat>(5, 1000);
+  arma::rowvec responses = arma::randu<arma::rowvec>(1000);
+
+  // Train a model on all points at once.
+  LinearRegression lrBatch(dataset, responses, 0.3);
+
+  // Train a model on the first half, then add the rest in small chunks.
+  LinearRegression lr(dataset.cols(0, 499), responses.subvec(0, 499), 0.3);
+  for (size_t i = 500; i < 1000; i += 100)
+  {
+    lr.TrainIncremental(dataset.cols(i, i + 99),
+        responses.subvec(i, i + 99));
+  }
+
+  REQUIRE(lr.Parameters().n_elem == lrBatch.Parameters().n_elem);
+  for (size_t i = 0; i < lr.Parameters().n_elem; ++i)
+    REQUIRE(lr.Parameters()[i] ==
+        Approx(lrBatch.Parameters()[i]).epsilon(1e-7));
+
+  // An untrained model must also be trainable incrementally, if lambda is
+  // large enough for the Gram matrix to be positive definite.
+  LinearRegression lrEmpty;
+  lrEmpty.Lambda() = 0.3;
+  for (size_t i = 0; i < 1000; i += 100)
+  {
+    lrEmpty.TrainIncremental(dataset.cols(i, i + 99),
+        responses.subvec(i, i + 99));
+  }
+
+  for (size_t i = 0; i < lrEmpty.Parameters().n_elem; ++i)
+    REQUIRE(lrEmpty.Parameters()[i] ==
+        Approx(lrBatch.Parameters()[i]).epsilon(1e-7));
+}
+
+/**
+ * Test that Forget() removes points from the model: a sliding window
+ * maintained with TrainIncremental()/Forget() must match a model trained
+ * from scratch on the window.
+ */
+TEST_CASE("LinearRegressionForgetTest", "[LinearRegressionTest]")
+{
+  // Random dataset.
+  arma::mat dataset = arma::randu<arma::mat>(5, 1000);
+  arma::rowvec responses = arma::randu<arma::rowvec>(1000);
+
+  // Slide a 500-point window forward in chunks of 100 points.
+  LinearRegression lr(dataset.cols(0, 499), responses.subvec(0, 499), 0.3);
+  for (size_t i = 0; i < 500; i += 100)
+  {
+    lr.TrainIncremental(dataset.cols(i + 500, i + 599),
+        responses.subvec(i + 500, i + 599));
+    lr.Forget(dataset.cols(i, i + 99), responses.subvec(i, i + 99));
+  }
+
+  // Train a model on the final window from scratch.
+  LinearRegression lrBatch(dataset.cols(500, 999), responses.subvec(500, 999),
+      0.3);
+
+  REQUIRE(lr.Parameters().n_elem == lrBatch.Parameters().n_elem);
+  for (size_t i = 0; i < lr.Parameters().n_elem; ++i)
+    REQUIRE(lr.Parameters()[i] ==
+        Approx(lrBatch.Parameters()[i]).epsilon(1e-5));
+}
+
 /*
  * Linear regression serialization test.
  */
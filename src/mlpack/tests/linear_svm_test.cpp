@@ -462,6 +462,71 @@ TEST_CASE("LinearSVMFunctionSeparableGradient", "[LinearSVMTest]")
   }
 }
 
+/**
+ * Test the sparse gradient kernel of the LinearSVMFunction against the dense
+ * one.  The data term and the regularization of the touched features must
+ * match; untouched features carry no entries in the sparse gradient.
+ */
+TEST_CASE("LinearSVMFunctionSparseGradient", "[LinearSVMTest]")
+{
+  const size_t points = 50;
+  const size_t inputSize = 20;
+  const size_t numClasses = 3;
+  const size_t batchSize = 10;
+  const double lambda = 0.5;
+
+  // Initialize a random sparse dataset.
+  arma::sp_mat data;
+  data.sprandu(inputSize, points, 0.3);
+
+  // Create random class labels.
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; ++i)
+    labels(i) = RandInt(0, numClasses);
+
+  LinearSVMFunction<arma::sp_mat> svmf(data, labels, numClasses, lambda);
+
+  arma::mat parameters;
+  parameters.randu(inputSize, numClasses);
+
+  for (size_t k = 0; k + batchSize <= points; k += batchSize)
+  {
+    arma::mat denseGradient;
+    arma::sp_mat sparseGradient;
+    svmf.Gradient(parameters, k, denseGradient, batchSize);
+    svmf.Gradient(parameters, k, sparseGradient, batchSize);
+
+    REQUIRE(sparseGradient.n_rows == parameters.n_rows);
+    REQUIRE(sparseGradient.n_cols == parameters.n_cols);
+
+    // Determine which features appear in this batch.
+    std::vector<bool> touched(inputSize, false);
+    for (size_t j = k; j < k + batchSize; ++j)
+      for (auto it = data.begin_col(j); it != data.end_col(j); ++it)
+        touched[it.row()] = true;
+
+    for (size_t r = 0; r < inputSize; ++r)
+    {
+      for (size_t c = 0; c < numClasses; ++c)
+      {
+        if (touched[r])
+        {
+          REQUIRE((double) sparseGradient(r, c) ==
+              Approx(denseGradient(r, c)).epsilon(1e-7));
+        }
+        else
+        {
+          // In the sparse formulation, untouched features get no
+          // regularization contribution (and no entry at all).
+          REQUIRE((double) sparseGradient(r, c) == Approx(0.0).margin(1e-12));
+          REQUIRE(denseGradient(r, c) ==
+              Approx(lambda * parameters(r, c)).epsilon(1e-7));
+        }
+      }
+    }
+  }
+}
+
 /**
  * Test training of linear svm on a simple dataset using
  * L-BFGS optimizer
@@ -1193,3 +1258,97 @@ TEST_CASE("LinearSVMCallbackTest", "[LinearSVMTest]")
 
   REQUIRE(cb.calledEndOptimization == true);
 }
+
+/**
+ * Test that ClassifyTopK() agrees with Classify() on the top class, and that
+ * for k = numClasses it returns all scores in decreasing order.
+ */
+TEST_CASE("LinearSVMClassifyTopKTest", "[LinearSVMTest]")
+{
+  const size_t numClasses = 12;
+  const size_t dimensionality = 20;
+  const size_t points = 500;
+
+  // Build a model with random weights directly; training is not needed to
+  // test inference.
+  arma::mat data = arma::randn(dimensionality, points);
+  LinearSVM<arma::mat> lsvm(numClasses, 0.0001, 1.0, false);
+  lsvm.Parameters() = arma::randn(dimensionality, numClasses);
+
+  arma::Row<size_t> predictions;
+  arma::mat fullScores;
+  lsvm.Classify(data, predictions, fullScores);
+
+  // The top-1 result must match Classify().
+  arma::Mat<size_t> topLabels;
+  arma::mat topScores;
+  lsvm.ClassifyTopK(data, 1, topLabels, topScores);
+
+  REQUIRE(topLabels.n_rows == 1);
+  REQUIRE(topLabels.n_cols == points);
+  for (size_t j = 0; j < points; ++j)
+  {
+    REQUIRE(topLabels(0, j) == predictions[j]);
+    REQUIRE(topScores(0, j) ==
+        Approx(fullScores(predictions[j], j)).epsilon(1e-10));
+  }
+
+  // With k = numClasses, we must get all scores, sorted by decreasing value.
+  lsvm.ClassifyTopK(data, numClasses, topLabels, topScores);
+  for (size_t j = 0; j < points; ++j)
+  {
+    for (size_t c = 0; c < numClasses; ++c)
+      REQUIRE(topScores(c, j) ==
+          Approx(fullScores(topLabels(c, j), j)).epsilon(1e-10));
+    for (size_t c = 1; c < numClasses; ++c)
+      REQUIRE(topScores(c, j) <= topScores(c - 1, j));
+  }
+
+  // Invalid values of k must be rejected.
+  REQUIRE_THROWS_AS(lsvm.ClassifyTopK(data, 0, topLabels, topScores),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(
+      lsvm.ClassifyTopK(data, numClasses + 1, topLabels, topScores),
+      std::invalid_argument);
+}
+
+/**
+ * Test 8-bit quantized inference: with weights that are exactly
+ * representable in 8 bits, ClassifyTopK() must give the same results as with
+ * the full-precision weights.
+ */
+TEST_CASE("LinearSVMQuantizeTest", "[LinearSVMTest]")
+{
+  const size_t numClasses = 8;
+  const size_t dimensionality = 15;
+  const size_t points = 300;
+
+  arma::mat data = arma::randn(dimensionality, points);
+
+  // Weights are integer multiples of 0.01 in [-1.27, 1.27], so symmetric
+  // 8-bit quantization represents them exactly.
+  LinearSVM<arma::mat> lsvm(numClasses, 0.0001, 1.0, false);
+  lsvm.Parameters() = 0.01 * arma::conv_to<arma::mat>::from(
+      arma::randi(dimensionality, numClasses, arma::distr_param(-127, 127)));
+  // Make sure every class uses the full quantization range.
+  lsvm.Parameters().row(0).fill(1.27);
+
+  arma::Mat<size_t> exactLabels, quantizedLabels;
+  arma::mat exactScores, quantizedScores;
+  lsvm.ClassifyTopK(data, 3, exactLabels, exactScores);
+
+  lsvm.Quantize();
+  REQUIRE(lsvm.QuantizedParameters().n_rows == dimensionality);
+  REQUIRE(lsvm.QuantizedParameters().n_cols == numClasses);
+  lsvm.ClassifyTopK(data, 3, quantizedLabels, quantizedScores);
+
+  for (size_t j = 0; j < points; ++j)
+  {
+    for (size_t c = 0; c < 3; ++c)
+    {
+      REQUIRE(quantizedLabels(c, j) == exactLabels(c, j));
+      REQUIRE(quantizedScores(c, j) ==
+          Approx(exactScores(c, j)).epsilon(1e-10));
+    }
+  }
+}
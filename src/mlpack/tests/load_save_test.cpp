@@ -1720,6 +1720,52 @@ TEST_CASE("CategoricalCSVLoadTest04", "[LoadSaveTest]")
   remove("test.csv");
 }
 
+/**
+ * Load a categorical CSV that is large enough to be split into several
+ * parallel chunks, and make sure the mappings still come out in
+ * first-occurrence order.
+ */
+TEST_CASE("BigCategoricalCSVLoadTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.csv", fstream::out);
+  // The categorical dimension sees a new category every 100 points, so the
+  // mapped values are known in advance.
+  for (size_t i = 0; i < 1000; ++i)
+    f << i << ", " << (i % 3) << ".5, cat" << (i / 100) << endl;
+  f.close();
+
+  arma::mat matrix;
+  DatasetInfo info;
+  if (!data::Load("test.csv", matrix, info))
+    FAIL("Cannot load dataset");
+
+  REQUIRE(matrix.n_rows == 3);
+  REQUIRE(matrix.n_cols == 1000);
+
+  REQUIRE(info.Type(0) == Datatype::numeric);
+  REQUIRE(info.Type(1) == Datatype::numeric);
+  REQUIRE(info.Type(2) == Datatype::categorical);
+  REQUIRE(info.NumMappings(2) == 10);
+
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    REQUIRE(matrix(0, i) == Approx((double) i).epsilon(1e-7));
+    REQUIRE(matrix(1, i) == Approx((i % 3) + 0.5).epsilon(1e-7));
+    // Categories are mapped in order of first occurrence.
+    REQUIRE(matrix(2, i) == Approx((double) (i / 100)).epsilon(1e-7));
+  }
+
+  for (size_t c = 0; c < 10; ++c)
+  {
+    std::ostringstream oss;
+    oss << "cat" << c;
+    REQUIRE(info.UnmapString(c, 2) == oss.str());
+  }
+
+  remove("test.csv");
+}
+
 TEST_CASE("CategoricalNontransposedCSVLoadTest00", "[LoadSaveTest]")
 {
   fstream f;
@@ -2206,6 +2252,43 @@ TEST_CASE("HarderARFFTest", "[LoadSaveTest]")
   remove("test.arff");
 }
 
+/**
+ * Load an ARFF file with enough data lines for several parallel chunks, and
+ * make sure the string mappings still come out in first-occurrence order.
+ */
+TEST_CASE("BigARFFTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.arff", fstream::out);
+  f << "@relation big" << endl;
+  f << "@attribute x numeric" << endl;
+  f << "@attribute s string" << endl;
+  f << "@data" << endl;
+  // The string dimension sees a new category every 50 points.
+  for (size_t i = 0; i < 500; ++i)
+    f << i << ", str" << (i / 50) << endl;
+  f.close();
+
+  arma::mat dataset;
+  DatasetInfo info;
+  if (!data::Load("test.arff", dataset, info))
+    FAIL("Cannot load dataset");
+
+  REQUIRE(dataset.n_rows == 2);
+  REQUIRE(dataset.n_cols == 500);
+  REQUIRE(info.Type(0) == Datatype::numeric);
+  REQUIRE(info.Type(1) == Datatype::categorical);
+  REQUIRE(info.NumMappings(1) == 10);
+
+  for (size_t i = 0; i < 500; ++i)
+  {
+    REQUIRE(dataset(0, i) == Approx((double) i).epsilon(1e-7));
+    REQUIRE(dataset(1, i) == Approx((double) (i / 50)).epsilon(1e-7));
+  }
+
+  remove("test.arff");
+}
+
 /**
  * If we pass a bad DatasetInfo, it should throw.
  */
@@ -2496,3 +2579,132 @@ TEST_CASE("LoadCSVHeaderTest", "[LoadSaveTest]")
   REQUIRE(dataset.n_rows == 4);
   REQUIRE(dataset.n_cols == 2);
 }
+
+/**
+ * Test that a matrix can be round-tripped through the mlpack columnar binary
+ * format, and that individual dimensions can be loaded lazily.
+ */
+TEST_CASE("ColumnarFormatTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(10, 50, arma::fill::randu);
+
+  REQUIRE(data::SaveColumnar("test_file.mlcol", dataset) == true);
+
+  // Load the full dataset.
+  arma::mat fullDataset;
+  REQUIRE(data::LoadColumnar("test_file.mlcol", fullDataset) == true);
+  REQUIRE(fullDataset.n_rows == dataset.n_rows);
+  REQUIRE(fullDataset.n_cols == dataset.n_cols);
+  CheckMatrices(dataset, fullDataset);
+
+  // Load only a few dimensions, out of order; only those blocks are read.
+  std::vector<size_t> dims = { 7, 2, 9 };
+  arma::mat partialDataset;
+  REQUIRE(data::LoadColumnar("test_file.mlcol", partialDataset, dims) ==
+      true);
+  REQUIRE(partialDataset.n_rows == 3);
+  REQUIRE(partialDataset.n_cols == dataset.n_cols);
+  for (size_t i = 0; i < dims.size(); ++i)
+  {
+    CheckMatrices(arma::mat(dataset.row(dims[i])),
+        arma::mat(partialDataset.row(i)));
+  }
+
+  // Requesting an out-of-range dimension must fail.
+  std::vector<size_t> badDims = { 10 };
+  arma::mat badDataset;
+  REQUIRE(data::LoadColumnar("test_file.mlcol", badDataset, badDims) ==
+      false);
+
+  remove("test_file.mlcol");
+}
+
+/**
+ * Test that a DatasetMapper is stored in and loaded from a columnar binary
+ * file.
+ */
+TEST_CASE("ColumnarFormatDatasetMapperTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(3, 20, arma::fill::randu);
+
+  data::DatasetInfo info(3);
+  info.Type(1) = data::Datatype::categorical;
+
+  REQUIRE(data::SaveColumnar("test_file.mlcol", dataset, &info) == true);
+
+  arma::mat loadedDataset;
+  data::DatasetInfo loadedInfo;
+  std::vector<size_t> allDims;
+  REQUIRE(data::LoadColumnar("test_file.mlcol", loadedDataset, allDims,
+      &loadedInfo) == true);
+
+  CheckMatrices(dataset, loadedDataset);
+  REQUIRE(loadedInfo.Dimensionality() == 3);
+  REQUIRE(loadedInfo.Type(0) == data::Datatype::numeric);
+  REQUIRE(loadedInfo.Type(1) == data::Datatype::categorical);
+
+  remove("test_file.mlcol");
+}
+
+/**
+ * Test that streaming a CSV in chunks yields exactly the same data as a
+ * batch load.
+ */
+TEST_CASE("LoadStreamChunkTest", "[LoadSaveTest]")
+{
+  // Write a small CSV; 20 points with 4 dimensions.
+  arma::mat dataset(4, 20, arma::fill::randu);
+  REQUIRE(data::Save("test_file.csv", dataset) == true);
+
+  data::LoadStream<> stream("test_file.csv", 7);
+  REQUIRE(stream.Dimensionality() == 4);
+
+  arma::mat streamed(4, 0);
+  arma::mat chunk;
+  std::vector<size_t> chunkSizes;
+  while (stream.Next(chunk))
+  {
+    REQUIRE(chunk.n_rows == 4);
+    chunkSizes.push_back(chunk.n_cols);
+    streamed = arma::join_rows(streamed, chunk);
+  }
+
+  // 20 points in chunks of 7: 7, 7, 6.
+  REQUIRE(chunkSizes.size() == 3);
+  REQUIRE(chunkSizes[0] == 7);
+  REQUIRE(chunkSizes[1] == 7);
+  REQUIRE(chunkSizes[2] == 6);
+
+  arma::mat batchLoaded;
+  REQUIRE(data::Load("test_file.csv", batchLoaded) == true);
+  CheckMatrices(batchLoaded, streamed);
+
+  remove("test_file.csv");
+}
+
+/**
+ * Test that a transform given to LoadStream is applied to each chunk during
+ * ingest.
+ */
+TEST_CASE("LoadStreamTransformTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(4, 20, arma::fill::randu);
+  REQUIRE(data::Save("test_file.csv", dataset) == true);
+
+  data::StandardScaler scaler;
+  scaler.Fit(dataset);
+
+  data::LoadStream<> stream("test_file.csv", 7, false,
+      [&scaler](arma::mat& chunk) { scaler.Transform(chunk); });
+
+  arma::mat streamed(4, 0);
+  arma::mat chunk;
+  while (stream.Next(chunk))
+    streamed = arma::join_rows(streamed, chunk);
+
+  arma::mat expected;
+  scaler.Transform(dataset, expected);
+  CheckMatrices(expected, streamed);
+
+  remove("test_file.csv");
+}
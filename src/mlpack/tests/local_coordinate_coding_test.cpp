@@ -188,3 +188,47 @@ TEST_CASE("LocalCoordinateCodingTrainReturnObjective",
 
   REQUIRE(std::isfinite(objVal) == true);
 }
+
+/**
+ * Test that encoding restricted to nearest anchor atoms produces codes close
+ * to the dense codes, and leaves non-anchor rows exactly zero.
+ */
+TEST_CASE("LocalCoordinateCodingNeighborAtomsTest",
+          "[LocalCoordinateCodingTest]")
+{
+  double lambda1 = 0.1;
+  uword nAtoms = 10;
+
+  mat X;
+  X.load("mnist_first250_training_4s_and_9s.arm");
+  uword nPoints = X.n_cols;
+
+  // Normalize each point since these are images.
+  for (uword i = 0; i < nPoints; ++i)
+  {
+    X.col(i) /= norm(X.col(i), 2);
+  }
+
+  LocalCoordinateCoding lcc(X, nAtoms, lambda1, 10);
+
+  mat denseCodes;
+  lcc.Encode(X, denseCodes);
+
+  // Restrict to the nearest anchors; the locality penalty already drives the
+  // weights of far-away atoms towards zero, so the codes should stay close.
+  lcc.NeighborAtoms() = 5;
+  mat anchorCodes;
+  lcc.Encode(X, anchorCodes);
+
+  REQUIRE(anchorCodes.n_rows == denseCodes.n_rows);
+  REQUIRE(anchorCodes.n_cols == denseCodes.n_cols);
+
+  // Each column may have at most NeighborAtoms() nonzero entries.
+  for (uword i = 0; i < nPoints; ++i)
+    REQUIRE(accu(anchorCodes.col(i) != 0) <= 5);
+
+  // The reconstructions should be of comparable quality.
+  const double denseErr = norm(X - lcc.Dictionary() * denseCodes, "fro");
+  const double anchorErr = norm(X - lcc.Dictionary() * anchorCodes, "fro");
+  REQUIRE(anchorErr <= denseErr + 0.05 * std::abs(denseErr));
+}
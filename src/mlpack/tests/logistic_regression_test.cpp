@@ -181,6 +181,110 @@ TEST_CASE("LogisticRegressionFunctionGradient", "[LogisticRegressionTest]")
   REQUIRE(gradient[0] >= 0.0);
 }
 
+/**
+ * Test that the full-dataset objective and gradient, which are accumulated
+ * over blocks of points, match the sum of the separable versions on a dataset
+ * spanning several blocks.
+ */
+TEST_CASE("LogisticRegressionFunctionBlockedGradient",
+          "[LogisticRegressionTest]")
+{
+  const size_t points = 10000;
+  arma::mat data(5, points, arma::fill::randn);
+  arma::Row<size_t> responses =
+      arma::randi<arma::Row<size_t>>(points, arma::distr_param(0, 1));
+
+  LogisticRegressionFunction<> lrf(data, responses, 0.5);
+  const arma::mat parameters(1, 6, arma::fill::randn);
+
+  // Accumulate the objective and gradient one batch at a time.
+  const size_t batchSize = 1000;
+  double batchObjective = 0.0;
+  arma::mat batchGradient(1, 6, arma::fill::zeros);
+  for (size_t begin = 0; begin < points; begin += batchSize)
+  {
+    arma::mat gradient;
+    batchObjective += lrf.Evaluate(parameters, begin, batchSize);
+    lrf.Gradient(parameters, begin, gradient, batchSize);
+    batchGradient += gradient;
+  }
+
+  arma::mat gradient;
+  const double objective = lrf.EvaluateWithGradient(parameters, gradient);
+
+  REQUIRE(objective == Approx(batchObjective).epsilon(1e-7));
+  REQUIRE(objective == Approx(lrf.Evaluate(parameters)).epsilon(1e-7));
+  for (size_t i = 0; i < gradient.n_elem; ++i)
+    REQUIRE(gradient[i] == Approx(batchGradient[i]).epsilon(1e-7));
+
+  arma::mat gradientOnly;
+  lrf.Gradient(parameters, gradientOnly);
+  for (size_t i = 0; i < gradient.n_elem; ++i)
+    REQUIRE(gradientOnly[i] == Approx(gradient[i]).epsilon(1e-10));
+}
+
+/**
+ * Test the sparse gradient kernel of LogisticRegressionFunction against the
+ * dense one.  The intercept and the touched features must match; untouched
+ * features carry no entries in the sparse gradient.
+ */
+TEST_CASE("LogisticRegressionFunctionSparseGradient",
+          "[LogisticRegressionTest]")
+{
+  const size_t points = 50;
+  const size_t inputSize = 20;
+  const size_t batchSize = 10;
+  const double lambda = 0.5;
+
+  arma::sp_mat data;
+  data.sprandu(inputSize, points, 0.3);
+  arma::Row<size_t> responses =
+      arma::randi<arma::Row<size_t>>(points, arma::distr_param(0, 1));
+
+  LogisticRegressionFunction<arma::sp_mat> lrf(data, responses, lambda);
+
+  arma::mat parameters(1, inputSize + 1, arma::fill::randn);
+
+  for (size_t k = 0; k + batchSize <= points; k += batchSize)
+  {
+    arma::mat denseGradient;
+    arma::sp_mat sparseGradient;
+    lrf.Gradient(parameters, k, denseGradient, batchSize);
+    lrf.Gradient(parameters, k, sparseGradient, batchSize);
+
+    REQUIRE(sparseGradient.n_rows == parameters.n_rows);
+    REQUIRE(sparseGradient.n_cols == parameters.n_cols);
+
+    // Determine which features appear in this batch.
+    std::vector<bool> touched(inputSize, false);
+    for (size_t j = k; j < k + batchSize; ++j)
+      for (auto it = data.begin_col(j); it != data.end_col(j); ++it)
+        touched[it.row()] = true;
+
+    // The intercept term is always present.
+    REQUIRE((double) sparseGradient(0, 0) ==
+        Approx(denseGradient[0]).epsilon(1e-7));
+
+    for (size_t r = 0; r < inputSize; ++r)
+    {
+      if (touched[r])
+      {
+        REQUIRE((double) sparseGradient(0, r + 1) ==
+            Approx(denseGradient[r + 1]).epsilon(1e-7));
+      }
+      else
+      {
+        // In the sparse formulation, untouched features get no
+        // regularization contribution (and no entry at all).
+        REQUIRE((double) sparseGradient(0, r + 1) ==
+            Approx(0.0).margin(1e-12));
+        REQUIRE(denseGradient[r + 1] == Approx(lambda * parameters[r + 1] /
+            points * batchSize).epsilon(1e-7));
+      }
+    }
+  }
+}
+
 /**
  * Test individual Evaluate() functions for SGD.
  */
@@ -652,6 +652,29 @@ TEST_CASE("LSHTrainTest", "[LSHTest]")
   REQUIRE(distances.n_rows == 3);
 }
 
+TEST_CASE("LSHTuneTest", "[LSHTest]")
+{
+  // Check that Tune() produces a usable model and reports a sensible recall.
+  arma::mat referenceData = arma::randu<arma::mat>(5, 500);
+  arma::mat queryData = arma::randu<arma::mat>(5, 100);
+
+  LSHSearch<> lsh;
+  const double recall = lsh.Tune(referenceData, 3, 0.4, 0, 16, 50);
+
+  REQUIRE(recall >= 0.0);
+  REQUIRE(recall <= 1.0);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  lsh.Search(queryData, 3, neighbors, distances);
+
+  REQUIRE(neighbors.n_cols == 100);
+  REQUIRE(neighbors.n_rows == 3);
+
+  // An invalid recall target should be rejected.
+  REQUIRE_THROWS_AS(lsh.Tune(referenceData, 3, 1.5), std::invalid_argument);
+}
+
 /**
  * Test: this verifies ComputeRecall works correctly by providing two identical
  * vectors and requiring that Recall is equal to 1.
@@ -614,6 +614,75 @@ TEST_CASE("ShuffleTest", "[MathTest]")
     REQUIRE(counts[i] == 1);
 }
 
+/**
+ * Make sure in-place shuffling works, using only one column of temporary
+ * storage.
+ */
+TEST_CASE("InPlaceShuffleTest", "[MathTest]")
+{
+  arma::mat data(3, 10, arma::fill::zeros);
+  arma::Row<size_t> labels(10);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    data(0, i) = i;
+    labels[i] = i;
+  }
+
+  ShuffleData(data, labels);
+
+  REQUIRE(data.n_rows == 3);
+  REQUIRE(data.n_cols == 10);
+  REQUIRE(labels.n_elem == 10);
+
+  // Make sure we only have each point once.
+  arma::Row<size_t> counts(10, arma::fill::zeros);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    REQUIRE((size_t) data(0, i) == labels[i]);
+    REQUIRE(data(1, i) == Approx(0.0).margin(1e-5));
+    REQUIRE(data(2, i) == Approx(0.0).margin(1e-5));
+    counts[labels[i]]++;
+  }
+
+  for (size_t i = 0; i < 10; ++i)
+    REQUIRE(counts[i] == 1);
+}
+
+/**
+ * Make sure in-place shuffling with weights works.
+ */
+TEST_CASE("InPlaceShuffleWeightsTest", "[MathTest]")
+{
+  arma::mat data(3, 10, arma::fill::zeros);
+  arma::Row<size_t> labels(10);
+  arma::rowvec weights(10);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    data(0, i) = i;
+    labels[i] = i;
+    weights[i] = i;
+  }
+
+  ShuffleData(data, labels, weights);
+
+  REQUIRE(data.n_rows == 3);
+  REQUIRE(data.n_cols == 10);
+  REQUIRE(labels.n_elem == 10);
+  REQUIRE(weights.n_elem == 10);
+
+  // Make sure we only have each point once.
+  arma::Row<size_t> counts(10, arma::fill::zeros);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    REQUIRE((size_t) data(0, i) == labels[i]);
+    REQUIRE(weights[i] == Approx((double) labels[i]).margin(1e-5));
+    counts[labels[i]]++;
+  }
+
+  for (size_t i = 0; i < 10; ++i)
+    REQUIRE(counts[i] == 1);
+}
+
 /**
  * Make sure shuffling sparse data works.
  */
@@ -1003,3 +1072,209 @@ TEST_CASE("InplaceSparseShuffleWeightsTest", "[MathTest]")
     REQUIRE(weightCounts[i] == 1);
   }
 }
+
+/**
+ * Test that the raw log-add kernels agree with a straightforward reference
+ * computation, including the -inf edge cases.
+ */
+TEST_CASE("LogAddKernelTest", "[MathTest]")
+{
+  arma::vec x(64, arma::fill::randn);
+  x *= 10.0;
+
+  // Reference computation with scalar LogAdd().
+  double ref = -std::numeric_limits<double>::infinity();
+  for (size_t i = 0; i < x.n_elem; ++i)
+    ref = LogAdd(ref, x[i]);
+
+  REQUIRE(AccuLog(x) == Approx(ref).epsilon(1e-10));
+
+  // An all--inf vector must sum to -inf, not NaN.
+  arma::vec allInf(8);
+  allInf.fill(-std::numeric_limits<double>::infinity());
+  REQUIRE(AccuLog(allInf) == -std::numeric_limits<double>::infinity());
+
+  // LogSumExpT() reduces each column; compare against per-column AccuLog().
+  arma::mat m(16, 5, arma::fill::randn);
+  m *= 10.0;
+  arma::vec y;
+  LogSumExpT<arma::mat, false>(m, y);
+  REQUIRE(y.n_elem == m.n_cols);
+  for (size_t j = 0; j < m.n_cols; ++j)
+    REQUIRE(y[j] == Approx(AccuLog(arma::vec(m.col(j)))).epsilon(1e-10));
+
+  // The in-place variant adds the previous y values to the sums.
+  arma::vec yInPlace(m.n_cols, arma::fill::randn);
+  arma::vec yBefore = yInPlace;
+  LogSumExpT<arma::mat, true>(m, yInPlace);
+  for (size_t j = 0; j < m.n_cols; ++j)
+    REQUIRE(yInPlace[j] == Approx(LogAdd(y[j], yBefore[j])).epsilon(1e-10));
+
+  // A column of all -inf must give -inf even in-place with a -inf start.
+  arma::mat mInf(4, 1);
+  mInf.fill(-std::numeric_limits<double>::infinity());
+  arma::vec yInf(1);
+  yInf.fill(-std::numeric_limits<double>::infinity());
+  LogSumExpT<arma::mat, true>(mInf, yInf);
+  REQUIRE(yInf[0] == -std::numeric_limits<double>::infinity());
+}
+
+/**
+ * Test the accuracy bound of the FastExp() approximation used by the fast
+ * log-add mode.
+ */
+TEST_CASE("FastExpAccuracyTest", "[MathTest]")
+{
+  // Sweep the domain produced by max-subtraction (arguments are <= 0).
+  for (double x = 0.0; x >= -700.0; x -= 0.37)
+  {
+    const double expected = std::exp(x);
+    REQUIRE(internal::FastExp(x) == Approx(expected).epsilon(1e-8));
+  }
+
+  // Below the underflow threshold the result must be exactly zero.
+  REQUIRE(internal::FastExp(-750.0) == 0.0);
+  REQUIRE(internal::FastExp(
+      -std::numeric_limits<double>::infinity()) == 0.0);
+}
+
+/**
+ * Test the slice-multiplication routines against explicit per-slice products
+ * for all transpose combinations, covering the flattened-GEMM fast path of
+ * MultiplyMat2Cube().
+ */
+TEST_CASE("MultiplySlicesTest", "[MathTest]")
+{
+  arma::cube a(4, 6, 7, arma::fill::randn);
+  arma::cube b(6, 5, 7, arma::fill::randn);
+  arma::mat m(4, 6, arma::fill::randn);
+
+  arma::cube c2c = MultiplyCube2Cube(a, b, false, false);
+  arma::cube m2c = MultiplyMat2Cube(m, b, false, false);
+  arma::cube m2cT = MultiplyMat2Cube(arma::mat(m.t()), b, true, false);
+  arma::cube c2m = MultiplyCube2Mat(a, arma::mat(b.slice(0)), false, false);
+
+  REQUIRE(c2c.n_rows == 4);
+  REQUIRE(c2c.n_cols == 5);
+  REQUIRE(c2c.n_slices == 7);
+
+  for (size_t i = 0; i < a.n_slices; ++i)
+  {
+    arma::mat expected = a.slice(i) * b.slice(i);
+    CheckMatrices(arma::mat(c2c.slice(i)), expected);
+    CheckMatrices(arma::mat(m2c.slice(i)), arma::mat(m * b.slice(i)));
+    CheckMatrices(arma::mat(m2cT.slice(i)), arma::mat(m * b.slice(i)));
+    CheckMatrices(arma::mat(c2m.slice(i)),
+        arma::mat(a.slice(i) * b.slice(0)));
+  }
+
+  // Transposed variants of the cube-cube product.
+  arma::cube aT(6, 4, 7, arma::fill::randn);
+  arma::cube bT(5, 6, 7, arma::fill::randn);
+  arma::cube cAT = MultiplyCube2Cube(aT, b, true, false);
+  arma::cube cBT = MultiplyCube2Cube(a, bT, false, true);
+  arma::cube cABT = MultiplyCube2Cube(aT, bT, true, true);
+  for (size_t i = 0; i < a.n_slices; ++i)
+  {
+    CheckMatrices(arma::mat(cAT.slice(i)),
+        arma::mat(aT.slice(i).t() * b.slice(i)));
+    CheckMatrices(arma::mat(cBT.slice(i)),
+        arma::mat(a.slice(i) * bT.slice(i).t()));
+    CheckMatrices(arma::mat(cABT.slice(i)),
+        arma::mat(aT.slice(i).t() * bT.slice(i).t()));
+  }
+}
+
+/**
+ * Test the subsampled randomized Hadamard projection: when no coordinates
+ * are dropped, the transform is orthonormal and must preserve norms exactly;
+ * with subsampling and padding it must at least be linear and correctly
+ * shaped.
+ */
+TEST_CASE("SRHTProjectionTest", "[MathTest]")
+{
+  // Full sample: outDim == padDim, so P is orthonormal.
+  SRHTProjection full(8, 8);
+  arma::mat x(8, 25, arma::fill::randn);
+  arma::mat y;
+  full.Project(x, y);
+
+  REQUIRE(y.n_rows == 8);
+  REQUIRE(y.n_cols == 25);
+  for (size_t c = 0; c < x.n_cols; ++c)
+    REQUIRE(arma::norm(y.col(c)) == Approx(arma::norm(x.col(c))).
+        epsilon(1e-10));
+
+  // Subsampled, with a non-power-of-two input dimensionality.
+  SRHTProjection srht(13, 6);
+  arma::mat a(13, 10, arma::fill::randn);
+  arma::mat b(13, 10, arma::fill::randn);
+  arma::mat pa, pb, pab;
+  srht.Project(a, pa);
+  srht.Project(b, pb);
+  srht.Project(arma::mat(2.0 * a + b), pab);
+
+  REQUIRE(pa.n_rows == 6);
+  REQUIRE(pa.n_cols == 10);
+  // The projection is linear and deterministic once constructed.
+  CheckMatrices(pab, arma::mat(2.0 * pa + pb));
+}
+
+/**
+ * Test the count-sketch projection: a standard basis vector must map to a
+ * single signed entry in its hash bucket, and the projection must be linear.
+ */
+TEST_CASE("CountSketchProjectionTest", "[MathTest]")
+{
+  CountSketchProjection sketch(20, 7);
+
+  // Project the identity: column j must be signs[j] * e_{buckets[j]}.
+  arma::mat basis = arma::eye(20, 20);
+  arma::mat projected;
+  sketch.Project(basis, projected);
+
+  REQUIRE(projected.n_rows == 7);
+  REQUIRE(projected.n_cols == 20);
+  for (size_t j = 0; j < 20; ++j)
+  {
+    REQUIRE(arma::accu(arma::abs(projected.col(j))) == Approx(1.0));
+    REQUIRE(projected(sketch.Buckets()[j], j) ==
+        Approx(sketch.Signs()[j]));
+  }
+
+  // Linearity.
+  arma::mat a(20, 5, arma::fill::randn);
+  arma::mat b(20, 5, arma::fill::randn);
+  arma::mat pa, pb, pab;
+  sketch.Project(a, pa);
+  sketch.Project(b, pb);
+  sketch.Project(arma::mat(a + b), pab);
+  CheckMatrices(pab, arma::mat(pa + pb));
+}
+
+/**
+ * Test that MakeColsAlias() produces views over the original memory, for both
+ * matrices and rows.
+ */
+TEST_CASE("MakeColsAliasTest", "[MathTest]")
+{
+  arma::mat m = arma::randu<arma::mat>(4, 10);
+  arma::mat view = MakeColsAlias(m, 3, 5);
+
+  REQUIRE(view.n_rows == 4);
+  REQUIRE(view.n_cols == 5);
+  REQUIRE(view.memptr() == m.colptr(3));
+  CheckMatrices(view, arma::mat(m.cols(3, 7)));
+
+  // Writes through the view must be visible in the original matrix.
+  view(1, 2) = 37.0;
+  REQUIRE(m(1, 5) == Approx(37.0));
+
+  arma::rowvec r = arma::randu<arma::rowvec>(10);
+  arma::rowvec rowView = MakeColsAlias(r, 2, 4);
+
+  REQUIRE(rowView.n_elem == 4);
+  REQUIRE(rowView.memptr() == r.memptr() + 2);
+  rowView[0] = -1.0;
+  REQUIRE(r[2] == Approx(-1.0));
+}
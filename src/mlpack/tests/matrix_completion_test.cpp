@@ -59,3 +59,43 @@ TEST_CASE("UniformMatrixCompletionSDP", "[MatrixCompletionTest]")
        Approx(Xorig(indices(0, i), indices(1, i))).epsilon(1e-7));
   }
 }
+
+/**
+ * A second call to Recover() should warm-start from the previous solution's
+ * factor and return the same completed matrix.
+ */
+TEST_CASE("WarmStartMatrixCompletionSDP", "[MatrixCompletionTest]")
+{
+  arma::mat Xorig, values;
+  arma::umat indices;
+
+  if (!data::Load("completion_X.csv", Xorig, false, false))
+    FAIL("Cannot load dataset completion_X.csv");
+  if (!data::Load("completion_indices.csv", indices, false, false))
+    FAIL("Cannot load dataset completion_indices.csv");
+
+  values.set_size(indices.n_cols);
+  for (size_t i = 0; i < indices.n_cols; ++i)
+  {
+    values(i) = Xorig(indices(0, i), indices(1, i));
+  }
+
+  arma::mat recovered;
+  MatrixCompletion mc(Xorig.n_rows, Xorig.n_cols, indices, values);
+  mc.Recover(recovered);
+
+  const double err =
+    arma::norm(Xorig - recovered, "fro") /
+    arma::norm(Xorig, "fro");
+  REQUIRE(err == Approx(0.0).margin(1e-5));
+
+  // Solving again starts at the previous optimum, so the solution should not
+  // move.
+  arma::mat rewarmed;
+  mc.Recover(rewarmed);
+
+  const double drift =
+    arma::norm(recovered - rewarmed, "fro") /
+    arma::norm(recovered, "fro");
+  REQUIRE(drift == Approx(0.0).margin(1e-5));
+}
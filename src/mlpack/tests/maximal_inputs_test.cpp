@@ -74,3 +74,31 @@ TEST_CASE("ColumnToBlocksChangeBlockSize", "[MaximalInputsTest]")
 
   TestResults(output, matlabResults);
 }
+
+TEST_CASE("ColumnToBlocksInverseTransform", "[MaximalInputsTest]")
+{
+  const arma::mat maximalInput = CreateMaximalInput();
+
+  arma::mat blocks;
+  ColumnsToBlocks ctb(1, 2);
+  ctb.Transform(maximalInput, blocks);
+
+  // Gathering the blocks back must reproduce the original columns.
+  arma::mat recovered;
+  ctb.InverseTransform(blocks, recovered);
+  TestResults(recovered, maximalInput);
+
+  // The round trip must also work for non-square blocks and a wider margin.
+  ColumnsToBlocks rect(2, 1, 1, 4);
+  rect.BufSize(2);
+  rect.BufValue(-3);
+  arma::mat rectBlocks, rectRecovered;
+  rect.Transform(maximalInput, rectBlocks);
+  rect.InverseTransform(rectBlocks, rectRecovered);
+  TestResults(rectRecovered, maximalInput);
+
+  // A matrix with the wrong dimensions must be rejected.
+  arma::mat bad(3, 3, arma::fill::zeros);
+  REQUIRE_THROWS_AS(ctb.InverseTransform(bad, recovered),
+      std::runtime_error);
+}
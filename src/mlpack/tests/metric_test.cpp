@@ -67,6 +67,63 @@ TEST_CASE("L2MetricTest", "[MetricTest]")
       Approx(lMetric.Evaluate(a2, b2)).epsilon(1e-7));
 }
 
+/**
+ * Test that FixedDimLMetric agrees with LMetric for several powers.
+ */
+TEST_CASE("FixedDimLMetricTest", "[MetricTest]")
+{
+  arma::vec a(16);
+  a.randn();
+
+  arma::vec b(16);
+  b.randn();
+
+  FixedDimLMetric<16, 1, false> l1;
+  FixedDimLMetric<16, 2, true> l2;
+  FixedDimLMetric<16, 2, false> squaredL2;
+  FixedDimLMetric<16, 3, true> l3;
+
+  REQUIRE(l1.Evaluate(a, b) ==
+      Approx((LMetric<1, false>::Evaluate(a, b))).epsilon(1e-7));
+  REQUIRE(l2.Evaluate(a, b) ==
+      Approx((LMetric<2, true>::Evaluate(a, b))).epsilon(1e-7));
+  REQUIRE(squaredL2.Evaluate(a, b) ==
+      Approx((LMetric<2, false>::Evaluate(a, b))).epsilon(1e-7));
+  REQUIRE(l3.Evaluate(a, b) ==
+      Approx((LMetric<3, true>::Evaluate(a, b))).epsilon(1e-7));
+}
+
+/**
+ * Test that the dispatched SIMD kernels agree with the Armadillo expression
+ * fallback: dense vectors take the raw-kernel path, while subviews and float
+ * vectors must give the same results as the double-precision dense path.
+ */
+TEST_CASE("SIMDKernelDispatchTest", "[MetricTest]")
+{
+  arma::mat data(37, 2, arma::fill::randn);
+  arma::vec a = data.col(0);
+  arma::vec b = data.col(1);
+  arma::fvec fa = arma::conv_to<arma::fvec>::from(a);
+  arma::fvec fb = arma::conv_to<arma::fvec>::from(b);
+
+  // The subview arguments exercise the expression fallback; the vec and fvec
+  // arguments exercise the raw kernels.
+  REQUIRE(ManhattanDistance::Evaluate(a, b) ==
+      Approx(ManhattanDistance::Evaluate(data.col(0), data.col(1))).
+      epsilon(1e-10));
+  REQUIRE(EuclideanDistance::Evaluate(a, b) ==
+      Approx(EuclideanDistance::Evaluate(data.col(0), data.col(1))).
+      epsilon(1e-10));
+  REQUIRE(SquaredEuclideanDistance::Evaluate(a, b) ==
+      Approx(SquaredEuclideanDistance::Evaluate(data.col(0), data.col(1))).
+      epsilon(1e-10));
+
+  REQUIRE((double) EuclideanDistance::Evaluate(fa, fb) ==
+      Approx(EuclideanDistance::Evaluate(a, b)).epsilon(1e-5));
+  REQUIRE((double) ManhattanDistance::Evaluate(fa, fb) ==
+      Approx(ManhattanDistance::Evaluate(a, b)).epsilon(1e-5));
+}
+
 /**
  * Simple test for L-Infinity metric.
  */
@@ -354,3 +411,57 @@ TEST_CASE("BLEUScoreTest", "[MetricTest]")
         Approx(expectedPrecision[i]).epsilon(1e-4));
   }
 }
+
+/**
+ * Simple test of the batched pairwise distance computation, for both the
+ * BLAS-backed L2 overloads and the generic blocked kernel.
+ */
+TEST_CASE("PairwiseDistancesTest", "[MetricTest]")
+{
+  arma::mat a = arma::randu(4, 75);
+  arma::mat b = arma::randu(4, 130);
+
+  EuclideanDistance euclidean;
+  SquaredEuclideanDistance squared;
+  ManhattanDistance manhattan;
+
+  arma::mat euclideanDistances, squaredDistances, manhattanDistances;
+  PairwiseDistances(a, b, euclidean, euclideanDistances);
+  PairwiseDistances(a, b, squared, squaredDistances);
+  PairwiseDistances(a, b, manhattan, manhattanDistances);
+
+  REQUIRE(euclideanDistances.n_rows == a.n_cols);
+  REQUIRE(euclideanDistances.n_cols == b.n_cols);
+
+  for (size_t j = 0; j < b.n_cols; ++j)
+  {
+    for (size_t i = 0; i < a.n_cols; ++i)
+    {
+      REQUIRE(euclideanDistances(i, j) ==
+          Approx(EuclideanDistance::Evaluate(a.col(i), b.col(j))).
+          epsilon(1e-7).margin(1e-12));
+      REQUIRE(squaredDistances(i, j) ==
+          Approx(SquaredEuclideanDistance::Evaluate(a.col(i), b.col(j))).
+          epsilon(1e-7).margin(1e-12));
+      REQUIRE(manhattanDistances(i, j) ==
+          Approx(ManhattanDistance::Evaluate(a.col(i), b.col(j))).
+          epsilon(1e-10));
+    }
+  }
+
+  // The arguments may also be subviews, so callers can tile large problems.
+  arma::mat tileDistances;
+  PairwiseDistances(a.cols(10, 19), b, euclidean, tileDistances);
+  REQUIRE(tileDistances.n_rows == 10);
+  for (size_t j = 0; j < b.n_cols; ++j)
+    for (size_t i = 0; i < 10; ++i)
+      REQUIRE(tileDistances(i, j) ==
+          Approx(euclideanDistances(i + 10, j)).epsilon(1e-7).margin(1e-12));
+
+  // A point must be at zero distance from itself, even with the floating
+  // point cancellation in the BLAS-backed path.
+  arma::mat selfDistances;
+  PairwiseDistances(a, a, euclidean, selfDistances);
+  for (size_t i = 0; i < a.n_cols; ++i)
+    REQUIRE(selfDistances(i, i) == Approx(0.0).margin(1e-6));
+}
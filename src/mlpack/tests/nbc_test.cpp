@@ -397,3 +397,94 @@ TEST_CASE("NaiveBayesClassifierHighDimensionsTest", "[NBCTest]")
   for (size_t i = 0; i < calcVec.n_cols; ++i)
     REQUIRE(calcVec(i) == testLabels(i));
 }
+
+/**
+ * Test that a model built from merged per-shard sufficient statistics is the
+ * same as a model trained non-incrementally on the full dataset.
+ */
+TEST_CASE("SufficientStatisticsTest", "[NBCTest]")
+{
+  const char* trainFilename = "trainSet.csv";
+  size_t classes = 2;
+
+  arma::mat trainData;
+  if (!data::Load(trainFilename, trainData))
+    FAIL("Cannot load dataset");
+
+  // Get the labels out.
+  arma::Row<size_t> labels(trainData.n_cols);
+  for (size_t i = 0; i < trainData.n_cols; ++i)
+    labels[i] = trainData(trainData.n_rows - 1, i);
+  trainData.shed_row(trainData.n_rows - 1);
+
+  // Train a model on the full dataset with the non-incremental algorithm.
+  NaiveBayesClassifier<> nbc(trainData, labels, classes, false);
+
+  // Compute sufficient statistics of two shards of the dataset separately.
+  const size_t half = trainData.n_cols / 2;
+  arma::mat counts1, sums1, sumSquares1, counts2, sums2, sumSquares2;
+  NaiveBayesClassifier<>::SufficientStatistics(trainData.cols(0, half - 1),
+      labels.subvec(0, half - 1), classes, counts1, sums1, sumSquares1);
+  NaiveBayesClassifier<>::SufficientStatistics(
+      trainData.cols(half, trainData.n_cols - 1),
+      labels.subvec(half, trainData.n_cols - 1), classes, counts2, sums2,
+      sumSquares2);
+
+  // Merge the statistics and build a model from them.
+  NaiveBayesClassifier<> nbcStats;
+  nbcStats.TrainFromSufficientStatistics(counts1 + counts2, sums1 + sums2,
+      sumSquares1 + sumSquares2);
+
+  // Both models must agree.
+  REQUIRE(nbcStats.Means().n_elem == nbc.Means().n_elem);
+  for (size_t i = 0; i < nbc.Means().n_elem; ++i)
+    REQUIRE(nbcStats.Means()[i] == Approx(nbc.Means()[i]).epsilon(1e-7));
+  for (size_t i = 0; i < nbc.Variances().n_elem; ++i)
+    REQUIRE(nbcStats.Variances()[i] ==
+        Approx(nbc.Variances()[i]).epsilon(1e-7));
+  for (size_t i = 0; i < nbc.Probabilities().n_elem; ++i)
+    REQUIRE(nbcStats.Probabilities()[i] ==
+        Approx(nbc.Probabilities()[i]).epsilon(1e-7));
+
+  // Statistics with mismatched sizes must be rejected.
+  REQUIRE_THROWS_AS(
+      nbcStats.TrainFromSufficientStatistics(counts1, sums1.rows(0, 0),
+          sumSquares1),
+      std::invalid_argument);
+}
+
+/**
+ * Ensure that the blocked batch log-likelihood kernel agrees with per-point
+ * classification, on enough points to span several blocks.
+ */
+TEST_CASE("BatchLogLikelihoodConsistencyTest", "[NBCTest]")
+{
+  const size_t points = 700;
+  const size_t dimension = 5;
+  const size_t classes = 3;
+
+  arma::mat data(dimension, points, arma::fill::randn);
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; ++i)
+  {
+    labels[i] = i % classes;
+    data.col(i) += 2.0 * labels[i];
+  }
+
+  NaiveBayesClassifier<> nbc(data, labels, classes);
+
+  arma::Row<size_t> batchPredictions;
+  arma::mat batchProbs;
+  nbc.Classify(data, batchPredictions, batchProbs);
+
+  for (size_t i = 0; i < points; ++i)
+  {
+    size_t prediction;
+    arma::vec probs;
+    nbc.Classify(arma::vec(data.col(i)), prediction, probs);
+
+    REQUIRE(batchPredictions[i] == prediction);
+    for (size_t j = 0; j < classes; ++j)
+      REQUIRE(batchProbs(j, i) == Approx(probs[j]).margin(1e-10));
+  }
+}
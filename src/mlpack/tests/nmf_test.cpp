@@ -301,3 +301,69 @@ TEST_CASE("NonNegNMFALSTest", "[NMFTest]")
   REQUIRE((arma::all(arma::vectorise(w) >= 0)
       && arma::all(arma::vectorise(h) >= 0)));
 }
+
+/**
+ * Check that warm-starting from a previous factorization of a matrix that
+ * gained a few new columns reaches a good solution with a very small
+ * iteration budget.
+ */
+TEST_CASE("NMFWarmStartTest", "[NMFTest]")
+{
+  mat trueW = randu<mat>(20, 8);
+  mat trueH = randu<mat>(8, 102);
+  mat fullV = trueW * trueH;
+  const size_t r = 8;
+
+  // Factorize all but the last two columns to convergence.
+  mat oldV = fullV.cols(0, 99);
+  mat w, h;
+  SimpleResidueTermination srt(1e-10, 10000);
+  AMF<> nmf(srt);
+  nmf.Apply(oldV, r, w, h);
+
+  // Refit the grown matrix with a warm start and a tiny iteration budget.
+  WarmStartInitialization warmStart(w, h);
+  SimpleResidueTermination warmSrt(1e-10, 25);
+  AMF<SimpleResidueTermination, WarmStartInitialization> warmNmf(warmSrt,
+      warmStart);
+  mat newW, newH;
+  warmNmf.Apply(fullV, r, newW, newH);
+
+  // The warm-started refit should already be close to the input, and the
+  // factors must remain nonnegative.
+  REQUIRE(arma::norm(fullV - newW * newH, "fro") /
+      arma::norm(fullV, "fro") == Approx(0.0).margin(0.05));
+  REQUIRE((arma::all(arma::vectorise(newW) >= 0)
+      && arma::all(arma::vectorise(newH) >= 0)));
+}
+
+/**
+ * Check that warm-starting can also grow the rank of the factorization
+ * without discarding the previous solution.
+ */
+TEST_CASE("NMFWarmStartRankGrowthTest", "[NMFTest]")
+{
+  mat trueW = randu<mat>(20, 10);
+  mat trueH = randu<mat>(10, 100);
+  mat v = trueW * trueH;
+
+  // Fit with a rank that is too small, then warm-start a higher-rank refit.
+  mat w, h;
+  SimpleResidueTermination srt(1e-10, 10000);
+  AMF<> nmf(srt);
+  nmf.Apply(v, (size_t) 6, w, h);
+  const double lowRankError = arma::norm(v - w * h, "fro") /
+      arma::norm(v, "fro");
+
+  WarmStartInitialization warmStart(w, h);
+  AMF<SimpleResidueTermination, WarmStartInitialization> warmNmf(srt,
+      warmStart);
+  mat newW, newH;
+  warmNmf.Apply(v, (size_t) 10, newW, newH);
+
+  // The extra components should improve on the low-rank fit.
+  const double grownError = arma::norm(v - newW * newH, "fro") /
+      arma::norm(v, "fro");
+  REQUIRE(grownError < lowRankError);
+  REQUIRE(grownError == Approx(0.0).margin(0.05));
+}
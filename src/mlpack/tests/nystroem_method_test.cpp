@@ -193,3 +193,75 @@ TEST_CASE("GermanTest", "[NystroemMethodTest]")
     REQUIRE(avgError == Approx(0.0).margin(results[trial]));
   }
 }
+
+/**
+ * Make sure that a second Apply() call reuses the cached landmarks and
+ * factorization and produces the exact same output.
+ */
+TEST_CASE("CachedApplyTest", "[NystroemMethodTest]")
+{
+  arma::mat data;
+  data.randu(5, 400);
+
+  GaussianKernel gk;
+  NystroemMethod<GaussianKernel, OrderedSelection> nm(data, gk, 50);
+
+  REQUIRE(nm.Cached() == false);
+
+  arma::mat g1, g2;
+  nm.Apply(g1);
+
+  REQUIRE(nm.Cached() == true);
+  REQUIRE(nm.Landmarks().n_cols == 50);
+
+  // The second call skips selection and factorization, so the result must be
+  // bit-identical.
+  nm.Apply(g2);
+  REQUIRE(arma::approx_equal(g1, g2, "absdiff", 1e-12));
+
+  // After a reset the approximation is rebuilt from scratch; with ordered
+  // selection the same landmarks are chosen, so the result should still
+  // match.
+  nm.Reset();
+  REQUIRE(nm.Cached() == false);
+  nm.Apply(g2);
+  REQUIRE(arma::approx_equal(g1, g2, "absdiff", 1e-12));
+}
+
+/**
+ * Make sure that the adaptive pivoted Cholesky factorization meets the
+ * requested trace-norm error target, and that a later Apply() call reproduces
+ * the same approximation from the cache.
+ */
+TEST_CASE("AdaptiveRankTest", "[NystroemMethodTest]")
+{
+  arma::mat data;
+  data.randu(5, 300);
+
+  GaussianKernel gk(1.5);
+  NystroemMethod<GaussianKernel, OrderedSelection> nm(data, gk, 300);
+
+  const double tolerance = 1e-3;
+  arma::mat g;
+  nm.Apply(g, tolerance);
+
+  // Construct exact kernel matrix.
+  arma::mat kernel(data.n_cols, data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    for (size_t j = 0; j < data.n_cols; ++j)
+      kernel(i, j) = gk.Evaluate(data.col(i), data.col(j));
+
+  // The residual is positive semidefinite, so its trace bounds the error; the
+  // factorization stops once it drops below tolerance * trace(K).
+  const double residualTrace = arma::trace(kernel - g * g.t());
+  REQUIRE(residualTrace <= tolerance * arma::trace(kernel) + 1e-8);
+
+  // The error target should be reachable well below full rank here.
+  REQUIRE(g.n_cols < data.n_cols);
+
+  // A later Apply() reuses the cached pivots and factorization.
+  REQUIRE(nm.Cached() == true);
+  arma::mat g2;
+  nm.Apply(g2);
+  REQUIRE(arma::approx_equal(g * g.t(), g2 * g2.t(), "absdiff", 1e-6));
+}
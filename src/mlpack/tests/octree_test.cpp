@@ -10,6 +10,7 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/core.hpp>
+#include <mlpack/methods/neighbor_search.hpp>
 
 #include "catch.hpp"
 #include "test_catch_tools.hpp"
@@ -341,3 +342,116 @@ TEST_CASE("OctreeSerializationTest", "[OctreeTest]")
   delete binaryTree;
   delete jsonTree;
 }
+
+/**
+ * Ensure that the Morton-code bulk constructor produces a valid tree: every
+ * node's range is contiguous, children partition their parent's points, the
+ * bound contains all descendant points, and the point mapping is a
+ * permutation that matches the reordered dataset.
+ */
+TEST_CASE("OctreeMortonBuildTest", "[OctreeTest]")
+{
+  arma::mat dataset(3, 700, arma::fill::randu);
+  std::vector<size_t> oldFromNew;
+
+  Octree<>* t = Octree<>::BuildMorton(dataset, oldFromNew, 10);
+
+  // The mapping must be a permutation of the input points, and the tree's
+  // dataset must be the input reordered by that permutation.
+  REQUIRE(oldFromNew.size() == dataset.n_cols);
+  std::vector<bool> seen(dataset.n_cols, false);
+  for (size_t i = 0; i < oldFromNew.size(); ++i)
+  {
+    REQUIRE(oldFromNew[i] < dataset.n_cols);
+    REQUIRE(!seen[oldFromNew[i]]);
+    seen[oldFromNew[i]] = true;
+
+    for (size_t d = 0; d < dataset.n_rows; ++d)
+      REQUIRE(t->Dataset()(d, i) ==
+          Approx(dataset(d, oldFromNew[i])).epsilon(1e-10));
+  }
+
+  // Walk the tree checking structural invariants.
+  std::queue<Octree<>*> nodes;
+  nodes.push(t);
+  while (!nodes.empty())
+  {
+    Octree<>* node = nodes.front();
+    nodes.pop();
+
+    // The bound must contain all of the node's descendant points.
+    for (size_t i = 0; i < node->NumDescendants(); ++i)
+      REQUIRE(node->Bound().Contains(node->Dataset().col(
+          node->Descendant(i))));
+
+    if (node->NumChildren() > 0)
+    {
+      // Children must partition the parent's contiguous range, in order.
+      size_t point = node->Descendant(0);
+      size_t count = 0;
+      for (size_t i = 0; i < node->NumChildren(); ++i)
+      {
+        REQUIRE(node->Child(i).NumDescendants() > 0);
+        REQUIRE(node->Child(i).Descendant(0) == point);
+        point += node->Child(i).NumDescendants();
+        count += node->Child(i).NumDescendants();
+        nodes.push(&node->Child(i));
+      }
+      REQUIRE(count == node->NumDescendants());
+    }
+  }
+
+  delete t;
+}
+
+/**
+ * Nearest neighbor search on a Morton-built octree must give identical
+ * results to brute-force search.
+ */
+TEST_CASE("OctreeMortonBuildKNNTest", "[OctreeTest]")
+{
+  arma::mat dataset(5, 500, arma::fill::randu);
+
+  using TreeType = Octree<EuclideanDistance,
+      NeighborSearchStat<NearestNeighborSort>, arma::mat>;
+
+  TreeType* tree = TreeType::BuildMorton(dataset);
+  NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat, Octree>
+      knn(std::move(*tree), SINGLE_TREE_MODE);
+  delete tree;
+
+  KNN naive(dataset, NAIVE_MODE);
+
+  arma::Mat<size_t> neighbors, naiveNeighbors;
+  arma::mat distances, naiveDistances;
+  knn.Search(dataset, 5, neighbors, distances);
+  naive.Search(dataset, 5, naiveNeighbors, naiveDistances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    // The tree's points are reordered, so compare distances only.
+    REQUIRE(distances[i] == Approx(naiveDistances[i]).epsilon(1e-10));
+  }
+}
+
+/**
+ * Build an octree as a zero-copy view over externally owned memory; the tree
+ * must reference the buffer directly and record the column rearrangement in
+ * oldFromNew.
+ */
+TEST_CASE("OctreeViewConstructionTest", "[OctreeTest]")
+{
+  // Pretend this buffer is externally owned (e.g. shared memory).
+  std::vector<double> buffer(3 * 400);
+  arma::mat original(3, 400, arma::fill::randu);
+  std::copy(original.begin(), original.end(), buffer.data());
+
+  std::vector<size_t> oldFromNew;
+  Octree<> tree(MakeAlias(buffer.data(), 3, 400), oldFromNew, 10);
+
+  REQUIRE(tree.Dataset().memptr() == buffer.data());
+  for (size_t i = 0; i < 400; ++i)
+    for (size_t d = 0; d < 3; ++d)
+      REQUIRE(tree.Dataset()(d, i) ==
+          Approx(original(d, oldFromNew[i])).epsilon(1e-10));
+}
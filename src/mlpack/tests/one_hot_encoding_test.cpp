@@ -229,3 +229,44 @@ TEST_CASE("OneHotEncodingDatasetinfoTest", "[OneHotEncodingTest]")
 
   remove("test.csv");
 }
+
+/**
+ * Test that the sparse one-hot encoding overload matches the dense one and
+ * that OneHotDecoding() recovers the original dataset.
+ */
+TEST_CASE("SparseOneHotEncodingDatasetInfoTest", "[OneHotEncodingTest]")
+{
+  fstream f;
+  f.open("test.csv", fstream::out);
+  f << "1, 2, hello" << endl;
+  f << "3, 4, goodbye" << endl;
+  f << "5, 6, coffee" << endl;
+  f << "7, 8, confusion" << endl;
+  f << "9, 10, hello" << endl;
+  f << "11, 12, confusion" << endl;
+  f << "13, 14, confusion" << endl;
+  f.close();
+
+  // Load the test CSV.
+  arma::mat matrix;
+  DatasetInfo info;
+  if (!data::Load("test.csv", matrix, info))
+    FAIL("Cannot load dataset test.csv");
+
+  arma::mat output;
+  data::OneHotEncoding(matrix, output, info);
+
+  arma::sp_mat sparseOutput;
+  data::OneHotEncoding(matrix, sparseOutput, info);
+
+  REQUIRE(sparseOutput.n_rows == output.n_rows);
+  REQUIRE(sparseOutput.n_cols == output.n_cols);
+  CheckMatrices(output, arma::mat(sparseOutput));
+
+  // Decoding must reproduce the original (mapped) dataset.
+  arma::mat decoded;
+  data::OneHotDecoding(sparseOutput, decoded, info);
+  CheckMatrices(matrix, decoded);
+
+  remove("test.csv");
+}
@@ -330,3 +330,95 @@ TEST_CASE("PCAScalingTest", "[PCATest]")
   // The eigenvalues should sum to three.
   REQUIRE(accu(eigval) == Approx(3.0).epsilon(0.001));
 }
+
+/**
+ * Test that sharded updates and merged worker sketches give the same
+ * principal components as exact PCA over the whole dataset.
+ */
+TEST_CASE("IncrementalPCAShardedMergeTest", "[PCATest]")
+{
+  arma::mat data = arma::randu<arma::mat>(5, 1000);
+
+  // Reference components from exact PCA over the full dataset.
+  arma::mat score;
+  arma::vec eigValRef;
+  arma::mat eigvecRef;
+  PCA<> pca;
+  pca.Apply(data, score, eigValRef, eigvecRef);
+
+  // Feed the data in uneven shards to two workers, then merge.
+  IncrementalPCA workerA, workerB;
+  workerA.Update(data.cols(0, 99));
+  workerA.Update(data.cols(100, 549));
+  workerB.Update(data.cols(550, 799));
+  workerB.Update(data.cols(800, 998));
+  workerB.Update(data.cols(999, 999)); // A single-point shard.
+  workerA.Merge(workerB);
+
+  REQUIRE(workerA.Count() == Approx(1000.0));
+
+  arma::vec eigVal;
+  arma::mat eigvec;
+  workerA.Apply(eigVal, eigvec);
+
+  REQUIRE(eigVal.n_elem == eigValRef.n_elem);
+  for (size_t i = 0; i < eigValRef.n_elem; ++i)
+    REQUIRE(eigVal[i] == Approx(eigValRef[i]).epsilon(1e-8));
+
+  // The loadings are defined up to sign.
+  for (size_t j = 0; j < eigvecRef.n_cols; ++j)
+  {
+    const double sign =
+        (arma::dot(eigvec.col(j), eigvecRef.col(j)) < 0.0) ? -1.0 : 1.0;
+    for (size_t i = 0; i < eigvecRef.n_rows; ++i)
+      REQUIRE(sign * eigvec(i, j) == Approx(eigvecRef(i, j)).margin(1e-8));
+  }
+
+  // Merging an empty sketch changes nothing.
+  IncrementalPCA empty;
+  workerA.Merge(empty);
+  REQUIRE(workerA.Count() == Approx(1000.0));
+
+  // Mismatched dimensionalities must be rejected.
+  arma::mat badShard = arma::randu<arma::mat>(3, 10);
+  REQUIRE_THROWS_AS(workerA.Update(badShard), std::invalid_argument);
+}
+
+/**
+ * Test that projecting through the sketch retains the same amount of
+ * variance as PCA-based dimensionality reduction.
+ */
+TEST_CASE("IncrementalPCATransformTest", "[PCATest]")
+{
+  arma::mat data = arma::randu<arma::mat>(5, 600);
+
+  arma::mat reduced = data;
+  PCA<> pca;
+  const double varRetainedRef = pca.Apply(reduced, (size_t) 2);
+
+  IncrementalPCA sketch;
+  sketch.Update(data.cols(0, 299));
+  sketch.Update(data.cols(300, 599));
+
+  arma::mat transformed;
+  const double varRetained = sketch.Transform(data, transformed, 2);
+
+  REQUIRE(transformed.n_rows == 2);
+  REQUIRE(transformed.n_cols == data.n_cols);
+  REQUIRE(varRetained == Approx(varRetainedRef).epsilon(1e-8));
+
+  // The projections agree with exact PCA up to the sign of each component.
+  for (size_t j = 0; j < 2; ++j)
+  {
+    const double sign =
+        (arma::dot(transformed.row(j), reduced.row(j)) < 0.0) ? -1.0 : 1.0;
+    for (size_t i = 0; i < data.n_cols; ++i)
+      REQUIRE(sign * transformed(j, i) == Approx(reduced(j, i)).margin(1e-8));
+  }
+
+  // Components cannot be extracted from a near-empty sketch.
+  IncrementalPCA empty;
+  arma::vec eigVal;
+  arma::mat eigvec;
+  REQUIRE_THROWS_AS(empty.Apply(eigVal, eigvec), std::invalid_argument);
+}
@@ -266,3 +266,94 @@ TEST_CASE("InstanceWeightsConstructor", "[PerceptronTest]")
 
   REQUIRE(p.Weights().n_elem > 0);
 }
+
+/**
+ * Test that the averaged perceptron with blocked passes converges for the AND
+ * gate classifier.
+ */
+TEST_CASE("AveragedAnd", "[PerceptronTest]")
+{
+  mat trainData;
+  trainData = { { 0, 1, 1, 0 },
+                { 1, 0, 1, 0 } };
+  Mat<size_t> labels;
+  labels = { 0, 0, 1, 0 };
+
+  Perceptron<> p(2, trainData.n_rows, 1000);
+  p.TrainAveraged(trainData, labels.row(0), 2);
+
+  mat testData;
+  testData = { { 0, 1, 1, 0 },
+               { 1, 0, 1, 0 } };
+  Row<size_t> predictedLabels;
+  p.Classify(testData, predictedLabels);
+
+  CHECK(predictedLabels(0, 0) == 0);
+  CHECK(predictedLabels(0, 1) == 0);
+  CHECK(predictedLabels(0, 2) == 1);
+  CHECK(predictedLabels(0, 3) == 0);
+}
+
+/**
+ * Test the averaged perceptron on a non-separable dataset: the averaged
+ * weights must still give a sensible decision boundary.
+ */
+TEST_CASE("AveragedNonLinearlySeparableDataset", "[PerceptronTest]")
+{
+  mat trainData;
+  trainData = { { 1, 2, 3, 4, 5, 6, 7, 8, 1, 2, 3, 4, 5, 6, 7, 8 },
+                { 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2 } };
+
+  Mat<size_t> labels;
+  labels = { 0, 0, 0, 1, 0, 1, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1 };
+
+  Perceptron<> p(2, trainData.n_rows, 1000);
+  p.TrainAveraged(trainData, labels.row(0), 2);
+
+  mat testData;
+  testData = { { 3,   4,   5,   6 },
+               { 3, 2.3, 1.7, 1.5 } };
+  Row<size_t> predictedLabels;
+  p.Classify(testData, predictedLabels);
+
+  CHECK(predictedLabels(0, 0) == 0);
+  CHECK(predictedLabels(0, 1) == 0);
+  CHECK(predictedLabels(0, 2) == 1);
+  CHECK(predictedLabels(0, 3) == 1);
+}
+
+/**
+ * Test that the averaged perceptron separates a dataset of many points with a
+ * clear margin, where blocked passes cover several blocks.
+ */
+TEST_CASE("AveragedTwoGaussians", "[PerceptronTest]")
+{
+  const size_t points = 2000;
+  mat trainData(2, points);
+  Row<size_t> labels(points);
+  for (size_t i = 0; i < points / 2; ++i)
+  {
+    trainData.col(i) = arma::vec("2.0 2.0") + 0.5 * arma::randn<arma::vec>(2);
+    labels(i) = 0;
+  }
+  for (size_t i = points / 2; i < points; ++i)
+  {
+    trainData.col(i) = arma::vec("-2.0 -2.0") +
+        0.5 * arma::randn<arma::vec>(2);
+    labels(i) = 1;
+  }
+
+  Perceptron<> p(2, trainData.n_rows, 10);
+  p.TrainAveraged(trainData, labels, 2);
+
+  Row<size_t> predictedLabels;
+  p.Classify(trainData, predictedLabels);
+
+  size_t correct = 0;
+  for (size_t i = 0; i < points; ++i)
+    if (predictedLabels(i) == labels(i))
+      ++correct;
+
+  // The classes are well-separated, so accuracy must be nearly perfect.
+  REQUIRE((double) correct / points > 0.98);
+}
@@ -431,3 +431,111 @@ TEST_CASE("CartPoleWithCategoricalDQN", "[QLearningTest]")
   }
   REQUIRE(converged);
 }
+
+//! Test that concurrent stores into LockFreeReplay produce consistent
+//! transitions when sampled.
+TEST_CASE("LockFreeReplayConcurrentStoreTest", "[QLearningTest]")
+{
+  using TestEnv = DiscreteActionEnv<4, 2>;
+
+  LockFreeReplay<TestEnv> replayMethod(64, 500);
+
+  // Store transitions from several threads at once; encode the transition
+  // number into both the state and the reward so that sampled transitions can
+  // be checked for consistency afterwards.
+  #pragma omp parallel for
+  for (size_t i = 0; i < (size_t) 2000; ++i)
+  {
+    arma::colvec stateData(4), nextStateData(4);
+    stateData.fill((double) i);
+    nextStateData.fill((double) i + 1);
+
+    TestEnv::State state(stateData);
+    TestEnv::Action action;
+    action.action = i % 2;
+    TestEnv::State nextState(nextStateData);
+
+    replayMethod.Store(state, action, (double) i, nextState, false, 0.99);
+  }
+
+  REQUIRE(replayMethod.Size() == 500);
+
+  arma::mat sampledStates, sampledNextStates;
+  std::vector<TestEnv::Action> sampledActions;
+  arma::rowvec sampledRewards;
+  arma::irowvec sampledTerminal;
+  replayMethod.Sample(sampledStates, sampledActions, sampledRewards,
+      sampledNextStates, sampledTerminal);
+
+  REQUIRE(sampledStates.n_cols == 64);
+  REQUIRE(sampledActions.size() == 64);
+  for (size_t t = 0; t < 64; ++t)
+  {
+    // Each sampled transition must be internally consistent: the state, next
+    // state, action, and reward must all come from the same Store() call.
+    const double i = sampledRewards(t);
+    REQUIRE(sampledStates(0, t) == i);
+    REQUIRE(arma::all(sampledStates.col(t) == i));
+    REQUIRE(arma::all(sampledNextStates.col(t) == i + 1));
+    REQUIRE(sampledActions[t].action == (size_t) i % 2);
+    REQUIRE(sampledTerminal(t) == 0);
+  }
+}
+
+//! Test DQN on Cart Pole with the lock-free replay buffer used sequentially;
+//! it should behave just like RandomReplay.
+TEST_CASE("CartPoleWithDQNLockFreeReplay", "[QLearningTest]")
+{
+  // Set up the network.
+  SimpleDQN<> network(128, 128, 2);
+
+  // Set up the policy and replay method.
+  GreedyPolicy<CartPole> policy(1.0, 1000, 0.1, 0.99);
+  LockFreeReplay<CartPole> replayMethod(10, 10000);
+
+  TrainingConfig config;
+  config.StepSize() = 0.01;
+  config.Discount() = 0.9;
+  config.TargetNetworkSyncInterval() = 100;
+  config.ExplorationSteps() = 100;
+  config.DoubleQLearning() = false;
+  config.StepLimit() = 200;
+
+  // Set up DQN agent.
+  QLearning<CartPole, decltype(network), AdamUpdate, decltype(policy)>
+      agent(config, network, policy, replayMethod);
+
+  bool converged = testAgent<decltype(agent)>(agent, 45, 1000);
+  REQUIRE(converged);
+}
+
+//! Test the vectorized environment adapter and batched rollouts.
+TEST_CASE("VectorizedEnvRolloutTest", "[QLearningTest]")
+{
+  // Check the adapter mechanics on a batch of CartPole instances.
+  VectorizedEnv<CartPole> envs(8);
+  arma::mat encodedStates;
+  envs.InitialSample(encodedStates);
+  REQUIRE(encodedStates.n_rows == CartPole::State::dimension);
+  REQUIRE(encodedStates.n_cols == 8);
+
+  // Run a short vectorized rollout with a DQN agent; the replay buffer
+  // receives one transition per instance per step.
+  SimpleDQN<> network(64, 64, 2);
+  GreedyPolicy<CartPole> policy(1.0, 1000, 0.1, 0.99);
+  RandomReplay<CartPole> replayMethod(10, 10000);
+
+  TrainingConfig config;
+  config.StepSize() = 0.01;
+  config.Discount() = 0.9;
+  config.TargetNetworkSyncInterval() = 100;
+  config.ExplorationSteps() = 100;
+  config.StepLimit() = 200;
+
+  QLearning<CartPole, decltype(network), AdamUpdate, decltype(policy)>
+      agent(config, network, policy, replayMethod);
+
+  const double totalReturn = agent.VectorizedEpisode(envs, 50);
+  REQUIRE(std::isfinite(totalReturn));
+  REQUIRE(agent.TotalSteps() == 50 * envs.NumEnvs());
+}
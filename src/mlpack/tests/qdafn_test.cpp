@@ -240,3 +240,31 @@ TEST_CASE("QDAFNSparseTest", "[QDAFNTest]")
   REQUIRE(distances.n_rows == 3);
   REQUIRE(distances.n_cols == 1000);
 }
+
+// A batch search over many queries must give the same results as searching
+// for each query on its own; the batch path projects the whole query set in
+// one matrix product and handles the queries in parallel.
+TEST_CASE("QDAFNBatchQueryTest", "[QDAFNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(6, 500);
+  arma::mat querySet = arma::randu<arma::mat>(6, 200);
+
+  QDAFN<> qdafn(dataset, 10, 30);
+
+  arma::mat batchDistances;
+  arma::Mat<size_t> batchNeighbors;
+  qdafn.Search(querySet, 3, batchNeighbors, batchDistances);
+
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    arma::mat distances;
+    arma::Mat<size_t> neighbors;
+    qdafn.Search(querySet.col(q), 3, neighbors, distances);
+
+    for (size_t j = 0; j < 3; ++j)
+    {
+      REQUIRE(batchNeighbors(j, q) == neighbors(j, 0));
+      REQUIRE(batchDistances(j, q) == Approx(distances(j, 0)).epsilon(1e-7));
+    }
+  }
+}
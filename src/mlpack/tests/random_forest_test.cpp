@@ -92,6 +92,119 @@ TEST_CASE("BootstrapWeightsTest", "[RandomForestTest]")
   }
 }
 
+/**
+ * Make sure bootstrap sample counts sum to the number of points.
+ */
+TEST_CASE("BootstrapSampleCountsTest", "[RandomForestTest]")
+{
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    arma::rowvec sampleCounts;
+    BootstrapSampleCounts(1000, sampleCounts);
+
+    REQUIRE(sampleCounts.n_elem == 1000);
+    REQUIRE(sampleCounts.min() >= 0.0);
+    REQUIRE(arma::accu(sampleCounts) == Approx(1000.0));
+  }
+}
+
+/**
+ * Make sure the out-of-bag error is computed during training and is a
+ * reasonable estimate of the generalization error.
+ */
+TEST_CASE("OOBErrorTest", "[RandomForestTest]")
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+
+  RandomForest<> rf(dataset, labels, 3, 20 /* 20 trees */, 1, 1e-7);
+
+  // The OOB error should be a valid error fraction, and the forest gets at
+  // least 70% accuracy on held-out data, so the OOB estimate should not be
+  // wildly worse than that.
+  REQUIRE(rf.OOBError() >= 0.0);
+  REQUIRE(rf.OOBError() <= 0.4);
+}
+
+/**
+ * Make sure a random forest can be trained directly on a sparse matrix and
+ * still gets reasonable accuracy.
+ */
+TEST_CASE("SparseTrainTest", "[RandomForestTest]")
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+
+  arma::sp_mat sparseDataset(dataset);
+
+  RandomForest<> rf(sparseDataset, labels, 3, 10 /* 10 trees */, 1, 1e-7);
+
+  arma::Row<size_t> predictions;
+  rf.Classify(sparseDataset, predictions);
+
+  size_t correct = 0;
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    if (predictions[i] == labels[i])
+      ++correct;
+
+  REQUIRE(double(correct) / double(labels.n_elem) > 0.7);
+}
+
+/**
+ * Make sure ClassifyTopK() agrees with the full Classify() output.
+ */
+TEST_CASE("ClassifyTopKTest", "[RandomForestTest]")
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+
+  RandomForest<> rf(dataset, labels, 3, 10 /* 10 trees */, 1, 1e-7);
+
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  rf.Classify(dataset, predictions, probabilities);
+
+  arma::Mat<size_t> classes;
+  arma::mat classProbabilities;
+  rf.ClassifyTopK(dataset, 2, classes, classProbabilities);
+
+  REQUIRE(classes.n_rows == 2);
+  REQUIRE(classes.n_cols == dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    // The most likely class must match the regular prediction, and its
+    // probability must match the full probability matrix.
+    REQUIRE(classes(0, i) == predictions[i]);
+    REQUIRE(classProbabilities(0, i) ==
+        Approx(probabilities(predictions[i], i)).epsilon(1e-10));
+
+    // The second class must not be more likely than the first.
+    REQUIRE(classProbabilities(0, i) >= classProbabilities(1, i));
+    REQUIRE(classes(1, i) != classes(0, i));
+  }
+
+  // Asking for more classes than the forest was trained on is an error.
+  REQUIRE_THROWS_AS(rf.ClassifyTopK(dataset, 4, classes, classProbabilities),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(rf.ClassifyTopK(dataset, 0, classes, classProbabilities),
+      std::invalid_argument);
+}
+
 /**
  * Make sure an empty forest cannot predict.
  */
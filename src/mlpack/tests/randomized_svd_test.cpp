@@ -60,3 +60,108 @@ TEST_CASE("RandomizedSVDReconstructionError", "[RandomizedSVDTest]")
       arma::norm(centeredData, "frob");
   REQUIRE(error == Approx(0.0).margin(1e-5));
 }
+
+/**
+ * The streaming (blocked) variant should give the same quality of
+ * decomposition as Apply(), including with a block size that does not evenly
+ * divide the number of columns.
+ */
+TEST_CASE("RandomizedSVDStreamingReconstructionError", "[RandomizedSVDTest]")
+{
+  arma::mat U = arma::randn<arma::mat>(3, 20);
+  arma::mat V = arma::randn<arma::mat>(10, 3);
+
+  arma::mat R;
+  arma::qr_econ(U, R, U);
+  arma::qr_econ(V, R, V);
+
+  arma::mat s = arma::diagmat(arma::vec("1 0.1 0.01"));
+
+  arma::mat data = arma::trans(U * arma::diagmat(s) * V.t());
+
+  // Center the data into a temporary matrix.
+  arma::mat centeredData;
+  Center(data, centeredData);
+
+  arma::mat U1, U2, V1, V2;
+  arma::vec s1, s2, s3;
+
+  arma::svd_econ(U1, s1, V1, centeredData);
+
+  // Use a block size that does not divide the number of columns evenly.
+  RandomizedSVD rSVD(0, 10);
+  rSVD.ApplyStreaming(data, U2, s2, V2, 3, 7);
+
+  // Use the same amount of data for the comparison (matrix rank).
+  s3 = s1.subvec(0, s2.n_elem - 1);
+
+  // The singular value error should be small.
+  double error = arma::norm(s2 - s3, "frob") / arma::norm(s2, "frob");
+  REQUIRE(error == Approx(0.0).margin(1e-5));
+
+  arma::mat reconstruct = U2 * arma::diagmat(s2) * V2.t();
+
+  // The relative reconstruction error should be small.
+  error = arma::norm(centeredData - reconstruct, "frob") /
+      arma::norm(centeredData, "frob");
+  REQUIRE(error == Approx(0.0).margin(1e-5));
+
+  // The same must hold for the transposed (wide) orientation.
+  arma::mat dataT = data.t();
+  arma::mat centeredDataT;
+  Center(dataT, centeredDataT);
+
+  arma::svd_econ(U1, s1, V1, centeredDataT);
+  rSVD.ApplyStreaming(dataT, U2, s2, V2, 3, 7);
+  s3 = s1.subvec(0, s2.n_elem - 1);
+
+  error = arma::norm(s2 - s3, "frob") / arma::norm(s2, "frob");
+  REQUIRE(error == Approx(0.0).margin(1e-5));
+
+  reconstruct = U2 * arma::diagmat(s2) * V2.t();
+  error = arma::norm(centeredDataT - reconstruct, "frob") /
+      arma::norm(centeredDataT, "frob");
+  REQUIRE(error == Approx(0.0).margin(1e-5));
+
+  // A zero block size is not allowed.
+  REQUIRE_THROWS_AS(rSVD.ApplyStreaming(data, U2, s2, V2, 3, 0),
+      std::invalid_argument);
+}
+
+/**
+ * Seeding the range finder with the singular vectors of a previous
+ * decomposition should give an accurate result with a single power
+ * iteration, and a basis of the wrong shape should simply be ignored.
+ */
+TEST_CASE("RandomizedSVDWarmStartTest", "[RandomizedSVDTest]")
+{
+  arma::mat data = arma::randn<arma::mat>(300, 1000);
+
+  // A reference decomposition, run to good accuracy.
+  arma::mat u1, v1;
+  arma::vec s1;
+  RandomizedSVD rSVD(0, 10);
+  rSVD.Apply(data, u1, s1, v1, 10);
+
+  // Warm-start from the previous left singular vectors (the matrix is wide,
+  // so the sampling matrix lives in the column space) and use a single power
+  // iteration.
+  arma::mat u2, v2;
+  arma::vec s2;
+  RandomizedSVD warmSVD(0, 1);
+  warmSVD.InitialBasis() = u1;
+  warmSVD.Apply(data, u2, s2, v2, 10);
+
+  double error = arma::norm(s2 - s1, "frob") / arma::norm(s1, "frob");
+  REQUIRE(error == Approx(0.0).margin(1e-5));
+
+  // A basis of the wrong shape must be ignored, not applied.
+  arma::mat u3, v3;
+  arma::vec s3;
+  RandomizedSVD mismatchedSVD(0, 10);
+  mismatchedSVD.InitialBasis() = arma::randn<arma::mat>(17, 4);
+  mismatchedSVD.Apply(data, u3, s3, v3, 10);
+
+  error = arma::norm(s3 - s1, "frob") / arma::norm(s1, "frob");
+  REQUIRE(error == Approx(0.0).margin(1e-5));
+}
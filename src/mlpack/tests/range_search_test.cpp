@@ -1459,6 +1459,71 @@ TEST_CASE("NeighborPtrDeleteTest", "[RangeSearchTest]")
   REQUIRE(distances.size() == 50);
 }
 
+/**
+ * Make sure the flat CSR result format and the callback mode both produce the
+ * same result set as the classic vector-of-vectors format.
+ */
+TEST_CASE("RangeSearchCSRAndCallbackTest", "[RangeSearchTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 300);
+  arma::mat queryset = arma::randu<arma::mat>(5, 100);
+  const Range range(0.25, 0.8);
+
+  RangeSearch<> rs(dataset);
+
+  // Classic format, used as reference.
+  vector<vector<size_t>> neighbors;
+  vector<vector<double>> distances;
+  rs.Search(queryset, range, neighbors, distances);
+
+  // Flat CSR format.
+  vector<size_t> csrNeighbors;
+  vector<double> csrDistances;
+  vector<size_t> csrOffsets;
+  rs.Search(queryset, range, csrNeighbors, csrDistances, csrOffsets);
+
+  REQUIRE(csrOffsets.size() == queryset.n_cols + 1);
+  REQUIRE(csrOffsets[0] == 0);
+  REQUIRE(csrNeighbors.size() == csrDistances.size());
+  REQUIRE(csrOffsets[queryset.n_cols] == csrNeighbors.size());
+
+  // Callback mode; collect the results ourselves.
+  vector<vector<size_t>> cbNeighbors(queryset.n_cols);
+  vector<vector<double>> cbDistances(queryset.n_cols);
+  rs.Search(queryset, range,
+      [&](const size_t queryIndex, const size_t neighborIndex,
+          const double distance)
+      {
+        cbNeighbors[queryIndex].push_back(neighborIndex);
+        cbDistances[queryIndex].push_back(distance);
+      });
+
+  for (size_t i = 0; i < queryset.n_cols; ++i)
+  {
+    // The CSR and callback results are not sorted by neighbor index, so sort
+    // everything before comparing.
+    vector<size_t> expected(neighbors[i]);
+    std::sort(expected.begin(), expected.end());
+
+    vector<size_t> csr(csrNeighbors.begin() + csrOffsets[i],
+                       csrNeighbors.begin() + csrOffsets[i + 1]);
+    std::sort(csr.begin(), csr.end());
+    REQUIRE(csr == expected);
+
+    vector<size_t> cb(cbNeighbors[i]);
+    std::sort(cb.begin(), cb.end());
+    REQUIRE(cb == expected);
+
+    // Check the distances of the CSR results against the true distances.
+    for (size_t j = csrOffsets[i]; j < csrOffsets[i + 1]; ++j)
+    {
+      const double trueDist = EuclideanDistance::Evaluate(queryset.col(i),
+          dataset.col(csrNeighbors[j]));
+      REQUIRE(csrDistances[j] == Approx(trueDist).epsilon(1e-10));
+    }
+  }
+}
+
 /**
  * Test copy constructor and copy operator.
  */
@@ -1712,3 +1777,102 @@ TEST_CASE("MoveOperatorNaiveTest", "[RangeSearchTest]")
     }
   }
 }
+
+/**
+ * Make sure that repeated searches through a SearchWorkspace give exactly the
+ * same results as plain Search() calls, including when the query set size
+ * changes between calls.
+ */
+TEST_CASE("RangeSearchWorkspaceTest", "[RangeSearchTest]")
+{
+  arma::mat referenceData;
+  referenceData.randu(5, 500);
+
+  RangeSearch<> rs(referenceData);
+  RangeSearch<>::SearchWorkspace workspace;
+
+  const Range range(0.25, 0.8);
+  const size_t querySizes[3] = { 120, 40, 120 };
+  for (size_t trial = 0; trial < 3; ++trial)
+  {
+    arma::mat queryData;
+    queryData.randu(5, querySizes[trial]);
+
+    vector<vector<size_t>> neighbors, wsNeighbors;
+    vector<vector<double>> distances, wsDistances;
+    rs.Search(queryData, range, neighbors, distances);
+    rs.Search(queryData, range, wsNeighbors, wsDistances, workspace);
+
+    REQUIRE(wsNeighbors.size() == neighbors.size());
+    for (size_t i = 0; i < neighbors.size(); ++i)
+    {
+      REQUIRE(wsNeighbors[i].size() == neighbors[i].size());
+      for (size_t j = 0; j < neighbors[i].size(); ++j)
+      {
+        REQUIRE(wsNeighbors[i][j] == neighbors[i][j]);
+        REQUIRE(wsDistances[i][j] == Approx(distances[i][j]).epsilon(1e-10));
+      }
+    }
+  }
+
+  // Clearing the workspace must not affect later searches.
+  workspace.Clear();
+  arma::mat queryData;
+  queryData.randu(5, 60);
+  vector<vector<size_t>> neighbors, wsNeighbors;
+  vector<vector<double>> distances, wsDistances;
+  rs.Search(queryData, range, neighbors, distances);
+  rs.Search(queryData, range, wsNeighbors, wsDistances, workspace);
+  REQUIRE(wsNeighbors.size() == neighbors.size());
+  for (size_t i = 0; i < neighbors.size(); ++i)
+    REQUIRE(wsNeighbors[i].size() == neighbors[i].size());
+}
+
+/**
+ * MixedPrecisionRangeSearch() must return exactly the same results as an
+ * all-double range search: the traversal runs on floats inside a widened
+ * range, but refinement against the original data restores exactness.
+ */
+TEST_CASE("MixedPrecisionRangeSearchTest", "[RangeSearchTest]")
+{
+  arma::mat referenceSet = arma::randu(10, 500);
+  arma::mat querySet = arma::randu(10, 100);
+  const Range range(0.4, 1.1);
+
+  RangeSearch<> exact(referenceSet);
+  vector<vector<size_t>> exactNeighbors;
+  vector<vector<double>> exactDistances;
+  exact.Search(querySet, range, exactNeighbors, exactDistances);
+
+  vector<vector<size_t>> neighbors;
+  vector<vector<double>> distances;
+  MixedPrecisionRangeSearch(referenceSet, querySet, range, neighbors,
+      distances);
+
+  vector<vector<pair<double, size_t>>> exactSorted, mixedSorted;
+  SortResults(exactNeighbors, exactDistances, exactSorted);
+  SortResults(neighbors, distances, mixedSorted);
+
+  REQUIRE(mixedSorted.size() == exactSorted.size());
+  for (size_t i = 0; i < exactSorted.size(); ++i)
+  {
+    REQUIRE(mixedSorted[i].size() == exactSorted[i].size());
+    for (size_t j = 0; j < exactSorted[i].size(); ++j)
+    {
+      REQUIRE(mixedSorted[i][j].second == exactSorted[i][j].second);
+      REQUIRE(mixedSorted[i][j].first ==
+          Approx(exactSorted[i][j].first).epsilon(1e-12));
+    }
+  }
+
+  // The single-tree variant must also be exact.
+  MixedPrecisionRangeSearch(referenceSet, querySet, range, neighbors,
+      distances, true);
+  SortResults(neighbors, distances, mixedSorted);
+  for (size_t i = 0; i < exactSorted.size(); ++i)
+  {
+    REQUIRE(mixedSorted[i].size() == exactSorted[i].size());
+    for (size_t j = 0; j < exactSorted[i].size(); ++j)
+      REQUIRE(mixedSorted[i][j].second == exactSorted[i][j].second);
+  }
+}
@@ -1353,3 +1353,73 @@ TEST_CASE("RectangleTreeMoveDatasetTest", "[RectangleTreeTraitsTest]")
   REQUIRE(tree.Dataset().n_rows == 3);
   REQUIRE(tree.Dataset().n_cols == 1000);
 }
+
+/**
+ * A function to count how many times each point of the dataset appears in a
+ * leaf of the tree.  It recurses so that it covers each node under (and
+ * including) this one.
+ */
+template<typename TreeType>
+void CollectLeafPoints(const TreeType& tree, std::vector<size_t>& counts)
+{
+  if (tree.NumChildren() == 0)
+  {
+    for (size_t i = 0; i < tree.Count(); ++i)
+      ++counts[tree.Point(i)];
+  }
+  else
+  {
+    for (size_t i = 0; i < tree.NumChildren(); ++i)
+      CollectLeafPoints(tree.Child(i), counts);
+  }
+}
+
+// A test to ensure that an STR bulk-loaded tree satisfies the R tree
+// invariants, holds every point exactly once, and gives the same neighbors as
+// a naive search.
+TEST_CASE("RectangleTreeSTRBulkLoadTest", "[RectangleTreeTraitsTest]")
+{
+  arma::mat dataset;
+  dataset.randu(8, 1000); // 1000 points in 8 dimensions.
+
+  typedef RTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+
+  TreeType* tree = TreeType::BuildSTR(dataset, 20, 6, 5, 2);
+
+  REQUIRE(tree->NumDescendants() == 1000);
+
+  CheckContainment(*tree);
+  CheckExactContainment(*tree);
+  CheckHierarchy(*tree);
+  CheckNumDescendants(*tree);
+  CheckFills(*tree);
+
+  // Every point of the dataset should appear in exactly one leaf.
+  std::vector<size_t> counts(dataset.n_cols, 0);
+  CollectLeafPoints(*tree, counts);
+  for (size_t i = 0; i < counts.size(); ++i)
+    REQUIRE(counts[i] == 1);
+
+  // Nearest neighbor search with the bulk-loaded tree.
+  arma::Mat<size_t> neighbors1;
+  arma::mat distances1;
+  NeighborSearch<NearestNeighborSort, LMetric<2, true>, arma::mat, RTree>
+      knn1(std::move(*tree), SINGLE_TREE_MODE);
+  delete tree;
+
+  knn1.Search(5, neighbors1, distances1);
+
+  // Nearest neighbor search the naive way.
+  arma::Mat<size_t> neighbors2;
+  arma::mat distances2;
+  KNN knn2(dataset, NAIVE_MODE);
+
+  knn2.Search(5, neighbors2, distances2);
+
+  for (size_t i = 0; i < neighbors1.size(); ++i)
+  {
+    REQUIRE(neighbors1[i] == neighbors2[i]);
+    REQUIRE(distances1[i] == distances2[i]);
+  }
+}
@@ -67,6 +67,30 @@ TEST_CASE("StandardScalerTest", "[ScalingTest]")
   CheckMatrices(dataset, temp);
 }
 
+/**
+ * Test that the in-place Transform() overloads match the copying ones.
+ */
+TEST_CASE("InPlaceTransformTest", "[ScalingTest]")
+{
+  data::MinMaxScaler minmax;
+  minmax.Fit(dataset);
+  minmax.Transform(dataset, scaleddataset);
+  temp = dataset;
+  minmax.Transform(temp);
+  CheckMatrices(scaleddataset, temp);
+  minmax.InverseTransform(temp);
+  CheckMatrices(dataset, temp);
+
+  data::StandardScaler standard;
+  standard.Fit(dataset);
+  standard.Transform(dataset, scaleddataset);
+  temp = dataset;
+  standard.Transform(temp);
+  CheckMatrices(scaleddataset, temp);
+  standard.InverseTransform(temp);
+  CheckMatrices(dataset, temp);
+}
+
 /**
  * Test For MeanNormalization Scaler Class.
  */
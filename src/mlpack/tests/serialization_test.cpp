@@ -153,12 +153,12 @@ TEST_CASE("BallBoundTest", "[SerializationTest]")
 
 TEST_CASE("MahalanobisBallBoundTest", "[SerializationTest]")
 {
-  BallBound<MahalanobisDistance<>, arma::vec> b(100);
+  BallBound<MahalanobisDistance<>, double, arma::vec> b(100);
   b.Center().randu();
   b.Radius() = 14.0;
   b.Metric().Covariance().randu(100, 100);
 
-  BallBound<MahalanobisDistance<>, arma::vec> xmlB, jsonB, binaryB;
+  BallBound<MahalanobisDistance<>, double, arma::vec> xmlB, jsonB, binaryB;
 
   SerializeObjectAll(b, xmlB, jsonB, binaryB);
 
@@ -334,6 +334,45 @@ TEST_CASE("BinarySpaceTreeOverwriteTest", "[SerializationTest]")
   CheckTrees(tree, xmlTree, jsonTree, binaryTree);
 }
 
+/**
+ * The incremental Insert()/Delete() bookkeeping must survive serialization:
+ * a loaded tree has to reclaim tombstoned points on Rebuild() instead of
+ * resurrecting them, and it must keep the rebuild threshold it was saved
+ * with.
+ */
+TEST_CASE("BinarySpaceTreeIncrementalStateTest", "[SerializationTest]")
+{
+  arma::mat data;
+  data.randu(3, 100);
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+  TreeType tree(data);
+  tree.RebuildThreshold() = 0.75;
+
+  tree.Insert(arma::vec("0.5 0.5 0.5"));
+  REQUIRE(tree.Delete(10));
+
+  TreeType* xmlTree;
+  TreeType* jsonTree;
+  TreeType* binaryTree;
+
+  SerializePointerObjectAll(&tree, xmlTree, jsonTree, binaryTree);
+
+  REQUIRE(xmlTree->RebuildThreshold() == Approx(0.75));
+  REQUIRE(jsonTree->RebuildThreshold() == Approx(0.75));
+  REQUIRE(binaryTree->RebuildThreshold() == Approx(0.75));
+
+  // Rebuilding the loaded tree must drop the tombstoned point, leaving the
+  // 100 points that are still live (and no sentinel values in the dataset).
+  binaryTree->Rebuild();
+  REQUIRE(binaryTree->Dataset().n_cols == 100);
+  REQUIRE(binaryTree->NumDescendants() == 100);
+  REQUIRE(binaryTree->Dataset().max() < std::numeric_limits<double>::max());
+
+  delete xmlTree;
+  delete jsonTree;
+  delete binaryTree;
+}
+
 TEST_CASE("CoverTreeTest", "[SerializationTest]")
 {
   arma::mat data;
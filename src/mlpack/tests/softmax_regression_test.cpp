@@ -672,3 +672,53 @@ TEST_CASE("SoftmaxRegressionComputeProbabilitiesAndLabelsTest",
     REQUIRE(testLabels(i) == labels(i));
   }
 }
+
+TEST_CASE("SoftmaxRegressionTrainOneVsAllTest", "[SoftmaxRegressionTest]")
+{
+  const size_t points = 3000;
+  const size_t inputSize = 3;
+  const size_t numClasses = 3;
+
+  // Generate three-Gaussian dataset.
+  arma::mat identity = arma::eye<arma::mat>(3, 3);
+  GaussianDistribution g1(arma::vec("1.0 9.0 1.0"), identity);
+  GaussianDistribution g2(arma::vec("4.0 3.0 4.0"), identity);
+  GaussianDistribution g3(arma::vec("3.0 2.0 7.0"), identity);
+
+  arma::mat data(inputSize, points);
+  arma::Row<size_t> labels(points);
+
+  for (size_t i = 0; i < points / 3; ++i)
+  {
+    data.col(i) = g1.Random();
+    labels(i) = 0;
+  }
+  for (size_t i = points / 3; i < (2 * points) / 3; ++i)
+  {
+    data.col(i) = g2.Random();
+    labels(i) = 1;
+  }
+  for (size_t i = (2 * points) / 3; i < points; ++i)
+  {
+    data.col(i) = g3.Random();
+    labels(i) = 2;
+  }
+
+  // Train one binary model per class and assemble them.
+  SoftmaxRegression sr(inputSize, numClasses, true);
+  const double objective = sr.TrainOneVsAll(data, labels, numClasses);
+
+  REQUIRE(std::isfinite(objective) == true);
+  REQUIRE(sr.Parameters().n_rows == numClasses);
+  REQUIRE(sr.Parameters().n_cols == inputSize + 1);
+
+  // The classes are well-separated, so training accuracy must be nearly
+  // perfect.
+  const double acc = sr.ComputeAccuracy(data, labels);
+  REQUIRE(acc == Approx(100.0).epsilon(0.02));
+
+  // One-vs-all training requires an intercept.
+  SoftmaxRegression srNoIntercept(inputSize, numClasses, false);
+  REQUIRE_THROWS_AS(srNoIntercept.TrainOneVsAll(data, labels, numClasses),
+      std::invalid_argument);
+}
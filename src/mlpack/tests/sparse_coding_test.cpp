@@ -212,3 +212,38 @@ TEST_CASE("SparseCodingTrainReturnObjective", "[SparseCodingTest]")
 
   REQUIRE(std::isfinite(objVal) == true);
 }
+
+/**
+ * Test that mini-batch training runs and produces a usable dictionary.
+ */
+TEST_CASE("SparseCodingMiniBatchTrainTest", "[SparseCodingTest]")
+{
+  const double tol = 1e-6;
+
+  double lambda1 = 0.1;
+  uword nAtoms = 25;
+
+  mat X;
+  X.load("mnist_first250_training_4s_and_9s.arm");
+  uword nPoints = X.n_cols;
+
+  // Normalize each point since these are images.
+  for (uword i = 0; i < nPoints; ++i)
+    X.col(i) /= norm(X.col(i), 2);
+
+  // The mini-batch objective is noisy, so cap the number of iterations
+  // instead of relying on the tolerance check.
+  SparseCoding sc(nAtoms, lambda1, 0.0, 5, 0.01, tol);
+  sc.BatchSize() = 50;
+  double objVal = sc.Train(X);
+
+  REQUIRE(std::isfinite(objVal) == true);
+  REQUIRE(sc.Dictionary().n_rows == X.n_rows);
+  REQUIRE(sc.Dictionary().n_cols == nAtoms);
+
+  // The learned dictionary must be able to encode the full dataset.
+  mat codes;
+  sc.Encode(X, codes);
+  REQUIRE(codes.n_rows == nAtoms);
+  REQUIRE(codes.n_cols == nPoints);
+}
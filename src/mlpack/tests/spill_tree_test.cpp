@@ -301,3 +301,27 @@ TEST_CASE("SpillTreeMoveDatasetTest", "[SpillTreeTest]")
   REQUIRE(tree.Dataset().n_rows == 3);
   REQUIRE(tree.Dataset().n_cols == 1000);
 }
+
+/**
+ * The spill tree never copies or rearranges its dataset when built from a
+ * const reference, so it can act as a read-only view over externally owned
+ * memory.
+ */
+TEST_CASE("SpillTreeViewConstructionTest", "[SpillTreeTest]")
+{
+  // Pretend this buffer is externally owned (e.g. shared memory).
+  std::vector<double> buffer(3 * 500);
+  arma::mat original(3, 500, arma::fill::randu);
+  std::copy(original.begin(), original.end(), buffer.data());
+
+  const arma::mat view = MakeAlias(buffer.data(), 3, 500);
+  SPTree<EuclideanDistance, EmptyStatistic, arma::mat> tree(view, 0.1);
+
+  // The tree must reference the view directly...
+  REQUIRE(&tree.Dataset() == &view);
+  REQUIRE(tree.Dataset().memptr() == buffer.data());
+
+  // ...and the external memory must be untouched.
+  for (size_t i = 0; i < view.n_elem; ++i)
+    REQUIRE(view[i] == original[i]);
+}
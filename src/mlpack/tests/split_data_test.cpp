@@ -105,6 +105,45 @@ TEST_CASE("SplitShuffleDataResultMat", "[SplitDataTest]")
   CheckMatEqual(input, concat);
 }
 
+TEST_CASE("SplitIndicesTest", "[SplitDataTest]")
+{
+  arma::uvec trainIdx, testIdx;
+  std::tie(trainIdx, testIdx) = SplitIndices(10, 0.2);
+  REQUIRE(trainIdx.n_elem == 8);
+  REQUIRE(testIdx.n_elem == 2);
+
+  // Make sure every column is used exactly once.
+  CheckDuplication(
+      arma::conv_to<Row<size_t>>::from(trainIdx),
+      arma::conv_to<Row<size_t>>::from(testIdx));
+}
+
+TEST_CASE("SplitViewsTest", "[SplitDataTest]")
+{
+  mat input(2, 10);
+  size_t count = 0; // Counter for unique sequential values.
+  input.imbue([&count] () { return ++count; });
+
+  const auto views = SplitViews(input, 0.2);
+  const SplitView<mat>& trainView = std::get<0>(views);
+  const SplitView<mat>& testView = std::get<1>(views);
+
+  REQUIRE(trainView.NumRows() == 2);
+  REQUIRE(trainView.NumCols() == 8);
+  REQUIRE(testView.NumRows() == 2);
+  REQUIRE(testView.NumCols() == 2);
+
+  // Element access must match the viewed columns of the input.
+  for (size_t i = 0; i < trainView.NumCols(); ++i)
+    for (size_t j = 0; j < trainView.NumRows(); ++j)
+      REQUIRE(trainView(j, i) == input(j, trainView.Indices()[i]));
+
+  // Materializing the views must reproduce the whole dataset.
+  mat concat = arma::join_rows(trainView.Materialize(),
+      testView.Materialize());
+  CheckMatEqual(input, concat);
+}
+
 TEST_CASE("SplitDataResultMat", "[SplitDataTest]")
 {
   mat input(2, 10);
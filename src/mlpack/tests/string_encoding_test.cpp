@@ -1427,3 +1427,63 @@ TEST_CASE("SplitByAnyOfTfIdfEncodingSerialization", "[StringEncodingTest]")
 
   CheckMatrices(output, xmlOutput, jsonOutput, binaryOutput);
 }
+
+/**
+ * Test the bag of words encoding algorithm with the hashed (stateless)
+ * dictionary.
+ */
+TEST_CASE("HashedBagOfWordsEncodingTest", "[StringEncodingTest]")
+{
+  arma::mat output;
+  HashedBagOfWordsEncoding<SplitByAnyOf::TokenType> encoder;
+  encoder.Dictionary().NumBuckets() = 64;
+  SplitByAnyOf tokenizer(" .,\"");
+
+  encoder.Encode(stringEncodingInput, output, tokenizer);
+
+  REQUIRE(output.n_rows == 64);
+  REQUIRE(output.n_cols == stringEncodingInput.size());
+
+  // Compute the expected counts by hashing each token by hand.
+  arma::mat expected(64, stringEncodingInput.size(), arma::fill::zeros);
+  for (size_t i = 0; i < stringEncodingInput.size(); ++i)
+  {
+    MLPACK_STRING_VIEW strView(stringEncodingInput[i]);
+    auto token = tokenizer(strView);
+    while (!tokenizer.IsTokenEmpty(token))
+    {
+      expected(std::hash<MLPACK_STRING_VIEW>()(token) % 64, i) += 1;
+      token = tokenizer(strView);
+    }
+  }
+
+  CheckMatrices(output, expected);
+
+  // The sparse output must match the dense one.
+  arma::sp_mat sparseOutput;
+  encoder.Encode(stringEncodingInput, sparseOutput, tokenizer);
+  CheckMatrices(output, arma::mat(sparseOutput));
+}
+
+/**
+ * Test that the sparse bag of words output matches the dense one on a corpus
+ * large enough to be split across several encoding chunks.
+ */
+TEST_CASE("SparseBagOfWordsEncodingTest", "[StringEncodingTest]")
+{
+  vector<string> input;
+  for (size_t i = 0; i < 100; ++i)
+    input.push_back(stringEncodingInput[i % stringEncodingInput.size()]);
+
+  BagOfWordsEncoding<SplitByAnyOf::TokenType> encoder;
+  SplitByAnyOf tokenizer(" .,\"");
+
+  arma::mat output;
+  encoder.Encode(input, output, tokenizer);
+
+  BagOfWordsEncoding<SplitByAnyOf::TokenType> sparseEncoder;
+  arma::sp_mat sparseOutput;
+  sparseEncoder.Encode(input, sparseOutput, tokenizer);
+
+  CheckMatrices(output, arma::mat(sparseOutput));
+}
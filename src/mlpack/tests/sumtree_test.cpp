@@ -87,3 +87,58 @@ TEST_CASE("BatchUpdate", "[SumTreeTest]")
   CHECK(sumtree.FindPrefixSum(2.8) <= 3);
   CHECK(sumtree.FindPrefixSum(3.0) <= 3);
 }
+
+/**
+ * Test that a batched prefix-sum query gives the same results as resolving
+ * each mass individually.
+ */
+TEST_CASE("FindPrefixSumBatch", "[SumTreeTest]")
+{
+  SumTree<double> sumtree(8);
+  for (size_t i = 0; i < 8; ++i)
+    sumtree.Set(i, 0.1 * (i + 1));
+
+  // Sorted ascending, as produced by stratified sampling.
+  arma::colvec masses = { 0.0, 0.3, 0.7, 1.2, 2.0, 3.0, 3.5 };
+
+  arma::ucolvec expected(masses.n_elem);
+  for (size_t i = 0; i < masses.n_elem; ++i)
+    expected[i] = sumtree.FindPrefixSum(masses[i]);
+
+  arma::ucolvec indices;
+  sumtree.FindPrefixSumBatch(masses, indices);
+
+  REQUIRE(indices.n_elem == expected.n_elem);
+  for (size_t i = 0; i < masses.n_elem; ++i)
+    REQUIRE(indices[i] == expected[i]);
+}
+
+/**
+ * Test that a partial BatchUpdate leaves the tree in the same state as
+ * setting each element individually.
+ */
+TEST_CASE("PartialBatchUpdate", "[SumTreeTest]")
+{
+  SumTree<double> sumtree(8);
+  SumTree<double> reference(8);
+  for (size_t i = 0; i < 8; ++i)
+  {
+    sumtree.Set(i, 1.0);
+    reference.Set(i, 1.0);
+  }
+
+  // Update only a few leaves; the batched sweep must recompute every
+  // affected internal node.
+  arma::ucolvec indices = { 1, 4, 7 };
+  arma::colvec data = { 0.5, 2.0, 0.25 };
+  sumtree.BatchUpdate(indices, data);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+    reference.Set(indices[i], data[i]);
+
+  CHECK(sumtree.Sum() == Approx(reference.Sum()).epsilon(1e-10));
+  for (size_t start = 0; start < 8; ++start)
+  {
+    CHECK(sumtree.Sum(start, 8) ==
+        Approx(reference.Sum(start, 8)).epsilon(1e-10));
+  }
+}
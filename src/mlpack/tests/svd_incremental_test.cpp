@@ -136,3 +136,65 @@ TEST_CASE("SVDIncompleteIncrementalRegularizationTest", "[SVDIncrementalTest]")
 
   REQUIRE(regularizedRMSE < regularRMSE + 0.105);
 }
+
+/**
+ * Test for convergence of parallel shuffled SGD learning on a sparse matrix.
+ */
+TEST_CASE("SVDParallelSGDConvergenceTest", "[SVDIncrementalTest]")
+{
+  sp_mat data;
+  data.sprandn(100, 100, 0.2);
+
+  SVDParallelSGDLearning<sp_mat> svd(0.01);
+  SimpleResidueTermination srt(1e-8, 200);
+
+  AMF<SimpleResidueTermination,
+      RandomAMFInitialization,
+      SVDParallelSGDLearning<sp_mat>> amf(srt, RandomAMFInitialization(),
+                                          svd);
+
+  mat m1, m2;
+  amf.Apply(data, 2, m1, m2);
+
+  REQUIRE(amf.TerminationPolicy().Iteration() !=
+          amf.TerminationPolicy().MaxIterations());
+}
+
+/**
+ * The parallel shuffled SGD epochs should reduce the RMSE over the observed
+ * (nonzero) entries of a low-rank matrix.
+ */
+TEST_CASE("SVDParallelSGDObservedRMSETest", "[SVDIncrementalTest]")
+{
+  // Build a rank-2 matrix and keep a random 30% of its entries.
+  mat wTrue = arma::randu<mat>(60, 2);
+  mat hTrue = arma::randu<mat>(2, 80);
+  sp_mat data(60, 80);
+  for (size_t i = 0; i < data.n_rows; ++i)
+    for (size_t j = 0; j < data.n_cols; ++j)
+      if (Random() < 0.3)
+        data(i, j) = arma::dot(wTrue.row(i), hTrue.col(j));
+
+  SVDParallelSGDLearning<sp_mat> svd(0.02);
+  SimpleResidueTermination srt(1e-10, 300);
+
+  AMF<SimpleResidueTermination,
+      RandomAMFInitialization,
+      SVDParallelSGDLearning<sp_mat>> amf(srt, RandomAMFInitialization(),
+                                          svd);
+
+  mat w, h;
+  amf.Apply(data, 2, w, h);
+
+  // Compute the RMSE over the observed entries only.
+  double squaredError = 0.0;
+  size_t observed = 0;
+  for (sp_mat::const_iterator it = data.begin(); it != data.end(); ++it)
+  {
+    const double err = (*it) - arma::dot(w.row(it.row()), h.col(it.col()));
+    squaredError += err * err;
+    ++observed;
+  }
+
+  REQUIRE(sqrt(squaredError / observed) < 0.1);
+}
@@ -143,3 +143,75 @@ TEST_CASE("DisabledTimingTest", "[TimerTest]")
 
   REQUIRE(Timer::Get("test_timer") == std::chrono::microseconds(0));
 }
+
+/**
+ * The memory meter should record a nonzero peak RSS for a metered region, and
+ * should accumulate reported allocations.
+ */
+TEST_CASE("MemoryMeterTest", "[TimerTest]")
+{
+  MemoryMeter::EnableMetering();
+  MemoryMeter::Start("test_meter");
+
+  // Allocate and touch a buffer large enough to be visible in the RSS.
+  std::vector<char> buffer(16 * 1024 * 1024, 1);
+
+  // Report a few allocations, as an application allocator hook would.
+  MemoryMeter::RecordAllocation(100);
+  MemoryMeter::RecordAllocation(100);
+  MemoryMeter::RecordAllocation(100);
+
+  MemoryMeter::Stop("test_meter");
+
+  const util::MemoryUsage usage = MemoryMeter::Get("test_meter");
+
+  // RSS sampling may be unavailable on exotic platforms; in that case the
+  // samples are all zero and there is nothing to check.
+  if (util::MemoryMeters::CurrentRSS() > 0)
+    REQUIRE(usage.peakRss > 0);
+
+  REQUIRE(usage.allocCount == 3);
+  REQUIRE(usage.allocBytes == 300);
+
+  // Make sure the buffer is not optimized away before the meter stops.
+  REQUIRE(buffer[12345] == 1);
+
+  MemoryMeter::DisableMetering();
+}
+
+TEST_CASE("TwiceStopMemoryMeterTest", "[TimerTest]")
+{
+  MemoryMeter::EnableMetering();
+  MemoryMeter::Start("test_meter");
+  MemoryMeter::Stop("test_meter");
+
+  REQUIRE_THROWS_AS(MemoryMeter::Stop("test_meter"), std::runtime_error);
+
+  MemoryMeter::DisableMetering();
+}
+
+TEST_CASE("TwiceStartMemoryMeterTest", "[TimerTest]")
+{
+  MemoryMeter::EnableMetering();
+  MemoryMeter::Start("test_meter");
+
+  REQUIRE_THROWS_AS(MemoryMeter::Start("test_meter"), std::runtime_error);
+  MemoryMeter::Stop("test_meter");
+  MemoryMeter::DisableMetering();
+}
+
+TEST_CASE("DisabledMeteringTest", "[TimerTest]")
+{
+  // It should be disabled by default but let's be paranoid.
+  MemoryMeter::DisableMetering();
+
+  MemoryMeter::Start("test_meter");
+  std::vector<char> buffer(1024 * 1024, 1);
+  MemoryMeter::Stop("test_meter");
+
+  const util::MemoryUsage usage = MemoryMeter::Get("test_meter");
+  REQUIRE(usage.rssDelta == 0);
+  REQUIRE(usage.peakRss == 0);
+  REQUIRE(usage.allocCount == 0);
+  REQUIRE(buffer[1234] == 1);
+}
@@ -9,6 +9,8 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/core.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+#include <mlpack/methods/range_search/range_search.hpp>
 
 #include <queue>
 #include <stack>
@@ -1944,6 +1946,83 @@ TEST_CASE("CoverTreeConstructionTest", "[TreeTest]")
   // implementation.
 }
 
+/**
+ * Create a cover tree on a dataset large enough that the distance scans during
+ * construction run in parallel, and make sure it's accurate.
+ */
+TEST_CASE("CoverTreeParallelConstructionTest", "[TreeTest]")
+{
+  arma::mat dataset;
+  // 3-dimensional, 12000 points; large enough to exceed the parallel distance
+  // computation threshold at the upper levels of the tree.
+  dataset.randu(3, 12000);
+
+  typedef StandardCoverTree<EuclideanDistance, EmptyStatistic, arma::mat>
+      TreeType;
+  TreeType tree(dataset);
+
+  // Ensure each leaf is only created once.
+  arma::vec counts;
+  counts.zeros(12000);
+  RecurseTreeCountLeaves(tree, counts);
+
+  for (size_t i = 0; i < 12000; ++i)
+    REQUIRE(counts[i] == 1);
+
+  // Each non-leaf should have a self-child.
+  CheckSelfChild<TreeType>(tree);
+
+  // Each node must satisfy the covering principle (its children must be less
+  // than or equal to a certain distance apart).
+  CheckCovering<TreeType, LMetric<2, true> >(tree);
+}
+
+/**
+ * Make sure a packed (arena) copy of a cover tree is identical in structure
+ * to the original and lays siblings out contiguously.
+ */
+TEST_CASE("CoverTreeArenaTest", "[TreeTest]")
+{
+  arma::mat dataset;
+  dataset.randu(10, 500);
+
+  typedef StandardCoverTree<EuclideanDistance, EmptyStatistic, arma::mat>
+      TreeType;
+  TreeType tree(dataset);
+
+  CoverTreeArena<EuclideanDistance, EmptyStatistic, arma::mat> arena(tree);
+
+  // Compare the packed tree to the original, level by level.
+  std::queue<std::pair<const TreeType*, const TreeType*>> queue;
+  queue.push(std::make_pair(&tree, &arena.Root()));
+  size_t nodes = 0;
+  while (!queue.empty())
+  {
+    const TreeType* src = queue.front().first;
+    const TreeType* copy = queue.front().second;
+    queue.pop();
+    ++nodes;
+
+    REQUIRE(copy->Point() == src->Point());
+    REQUIRE(copy->Scale() == src->Scale());
+    REQUIRE(copy->NumDescendants() == src->NumDescendants());
+    REQUIRE(copy->NumChildren() == src->NumChildren());
+    REQUIRE(&copy->Dataset() == &src->Dataset());
+
+    // The test tree fits in one slab, so siblings must be adjacent in memory.
+    for (size_t i = 1; i < copy->NumChildren(); ++i)
+      REQUIRE(&copy->Child(i) == &copy->Child(i - 1) + 1);
+
+    for (size_t i = 0; i < src->NumChildren(); ++i)
+    {
+      REQUIRE(copy->Child(i).Parent() == copy);
+      queue.push(std::make_pair(&src->Child(i), &copy->Child(i)));
+    }
+  }
+
+  REQUIRE(nodes == arena.NumNodes());
+}
+
 /**
  * Create a cover tree on sparse data and make sure it's accurate.
  */
@@ -2277,3 +2356,444 @@ TEST_CASE("CoverTreeDescendantTest", "[TreeTest]")
   // using the recursive function above.
   CheckDescendants(&tree);
 }
+
+/**
+ * Make sure that packing a tree into a contiguous arena with Pack() preserves
+ * the tree's structure.
+ */
+TEST_CASE("BinarySpaceTreePackTest", "[TreeTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 500);
+
+  using TreeType = KDTree<EuclideanDistance, EmptyStatistic, arma::mat>;
+  TreeType tree(dataset);
+  TreeType unpackedTree(tree); // Deep copy, left unpacked for comparison.
+
+  REQUIRE(!tree.IsPacked());
+  tree.Pack();
+  REQUIRE(tree.IsPacked());
+
+  // Packing again should be a no-op.
+  tree.Pack();
+
+  // Recursively compare the packed tree against the unpacked copy.
+  std::stack<std::pair<TreeType*, TreeType*>> nodes;
+  nodes.push(std::make_pair(&tree, &unpackedTree));
+  while (!nodes.empty())
+  {
+    TreeType* packed = nodes.top().first;
+    TreeType* unpacked = nodes.top().second;
+    nodes.pop();
+
+    REQUIRE(packed->Begin() == unpacked->Begin());
+    REQUIRE(packed->Count() == unpacked->Count());
+    REQUIRE(packed->IsLeaf() == unpacked->IsLeaf());
+    for (size_t d = 0; d < packed->Bound().Dim(); ++d)
+    {
+      REQUIRE(packed->Bound()[d].Lo() ==
+          Approx(unpacked->Bound()[d].Lo()).epsilon(1e-10));
+      REQUIRE(packed->Bound()[d].Hi() ==
+          Approx(unpacked->Bound()[d].Hi()).epsilon(1e-10));
+    }
+
+    if (!packed->IsLeaf())
+    {
+      REQUIRE(packed->Left()->Parent() == packed);
+      REQUIRE(packed->Right()->Parent() == packed);
+      nodes.push(std::make_pair(packed->Left(), unpacked->Left()));
+      nodes.push(std::make_pair(packed->Right(), unpacked->Right()));
+    }
+  }
+}
+
+/**
+ * Ensure that the batched MinDistances()/MaxDistances() kernels agree with
+ * the per-point MinDistance()/MaxDistance() calls.
+ */
+TEST_CASE("HRectBoundBatchDistanceTest", "[TreeTest]")
+{
+  HRectBound<EuclideanDistance> b(4);
+  b |= arma::randu<arma::mat>(4, 50);
+
+  arma::mat points = 3.0 * arma::randu<arma::mat>(4, 100) - 1.0;
+
+  arma::vec minDistances, maxDistances;
+  b.MinDistances(points, minDistances);
+  b.MaxDistances(points, maxDistances);
+
+  REQUIRE(minDistances.n_elem == points.n_cols);
+  REQUIRE(maxDistances.n_elem == points.n_cols);
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    REQUIRE(minDistances[i] ==
+        Approx(b.MinDistance(points.col(i))).epsilon(1e-10));
+    REQUIRE(maxDistances[i] ==
+        Approx(b.MaxDistance(points.col(i))).epsilon(1e-10));
+  }
+}
+
+/**
+ * Test that a tree saved with SaveFlat() and reloaded with LoadFlat() has the
+ * same structure, bounds, and dataset as the original.
+ */
+TEST_CASE("BinarySpaceTreeFlatFormatTest", "[TreeTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(4, 300);
+
+  using TreeType = KDTree<EuclideanDistance, EmptyStatistic, arma::mat>;
+  TreeType tree(dataset);
+  tree.SaveFlat("flat_tree_test.bin");
+
+  TreeType loadedTree(arma::randu<arma::mat>(2, 10)); // Will be replaced.
+  loadedTree.LoadFlat("flat_tree_test.bin");
+  remove("flat_tree_test.bin");
+
+  REQUIRE(loadedTree.IsPacked());
+  REQUIRE(loadedTree.Dataset().n_rows == tree.Dataset().n_rows);
+  REQUIRE(loadedTree.Dataset().n_cols == tree.Dataset().n_cols);
+  for (size_t i = 0; i < tree.Dataset().n_elem; ++i)
+    REQUIRE(loadedTree.Dataset()[i] == Approx(tree.Dataset()[i]).epsilon(1e-10));
+
+  std::stack<std::pair<TreeType*, TreeType*>> nodes;
+  nodes.push(std::make_pair(&loadedTree, &tree));
+  while (!nodes.empty())
+  {
+    TreeType* loaded = nodes.top().first;
+    TreeType* original = nodes.top().second;
+    nodes.pop();
+
+    REQUIRE(loaded->Begin() == original->Begin());
+    REQUIRE(loaded->Count() == original->Count());
+    REQUIRE(loaded->IsLeaf() == original->IsLeaf());
+    REQUIRE(loaded->ParentDistance() ==
+        Approx(original->ParentDistance()).margin(1e-10));
+    for (size_t d = 0; d < loaded->Bound().Dim(); ++d)
+    {
+      REQUIRE(loaded->Bound()[d].Lo() ==
+          Approx(original->Bound()[d].Lo()).epsilon(1e-10));
+      REQUIRE(loaded->Bound()[d].Hi() ==
+          Approx(original->Bound()[d].Hi()).epsilon(1e-10));
+    }
+
+    if (!loaded->IsLeaf())
+    {
+      nodes.push(std::make_pair(loaded->Left(), original->Left()));
+      nodes.push(std::make_pair(loaded->Right(), original->Right()));
+    }
+  }
+}
+
+/**
+ * Test incremental Insert()/Delete() on a BinarySpaceTree: inserted points
+ * must be covered by all bounds on their path and findable by brute-force
+ * checking of leaf ranges; deleted points must be unreachable.
+ */
+TEST_CASE("BinarySpaceTreeInsertDeleteTest", "[TreeTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(3, 200);
+
+  using TreeType = KDTree<EuclideanDistance, EmptyStatistic, arma::mat>;
+  TreeType tree(dataset);
+  tree.RebuildThreshold() = 1.0; // Keep rebuilds out of the structure checks.
+
+  // Insert a handful of points and check invariants after each.
+  for (size_t i = 0; i < 10; ++i)
+  {
+    arma::vec point = 2.0 * arma::randu<arma::vec>(3) - 0.5;
+    const size_t index = tree.Insert(point);
+    REQUIRE(index == 200 + i);
+    REQUIRE(tree.Dataset().n_cols == 201 + i);
+    REQUIRE(tree.NumDescendants() == 201 + i);
+
+    // The point must be covered by bounds all the way down to some leaf
+    // whose range contains its index.
+    TreeType* node = &tree;
+    while (true)
+    {
+      REQUIRE(node->Bound().Contains(point));
+      REQUIRE(index >= node->Begin());
+      REQUIRE(index < node->Begin() + node->Count());
+      if (node->IsLeaf())
+        break;
+      node = (index < node->Right()->Begin()) ? node->Left() : node->Right();
+    }
+  }
+
+  // Delete a point: it should be tombstoned, and deleting twice fails.
+  REQUIRE(tree.Delete(5));
+  REQUIRE(!tree.Delete(5));
+  REQUIRE(tree.Dataset().col(5).min() == std::numeric_limits<double>::max());
+
+  // An explicit rebuild reclaims the tombstone.
+  tree.Rebuild();
+  REQUIRE(tree.Dataset().n_cols == 209);
+  REQUIRE(tree.NumDescendants() == 209);
+  REQUIRE(tree.Dataset().max() < std::numeric_limits<double>::max());
+}
+
+/**
+ * Build a kd-tree as a zero-copy view over externally owned memory.  The tree
+ * must reference the external buffer directly instead of copying it, and the
+ * rearrangement of the buffer's columns must be recorded in oldFromNew.
+ */
+TEST_CASE("BinarySpaceTreeViewConstructionTest", "[TreeTest]")
+{
+  using TreeType = KDTree<EuclideanDistance, EmptyStatistic, arma::mat>;
+
+  // Pretend this buffer is externally owned (e.g. shared memory).
+  std::vector<double> buffer(3 * 400);
+  arma::mat original(3, 400, arma::fill::randu);
+  std::copy(original.begin(), original.end(), buffer.data());
+
+  std::vector<size_t> oldFromNew;
+  TreeType tree(MakeAlias(buffer.data(), 3, 400), oldFromNew, 10);
+
+  // The tree's dataset must be a view of the external buffer: same memory.
+  REQUIRE(tree.Dataset().memptr() == buffer.data());
+
+  // The buffer's columns were permuted in place; oldFromNew records how.
+  for (size_t i = 0; i < 400; ++i)
+    for (size_t d = 0; d < 3; ++d)
+      REQUIRE(tree.Dataset()(d, i) ==
+          Approx(original(d, oldFromNew[i])).epsilon(1e-10));
+}
+
+/**
+ * Make sure that running two rule sets fused into one dual-tree traversal
+ * with CompositeRules gives the same results as running each rule set in its
+ * own traversal.  k-nearest-neighbor search and range search are fused here;
+ * both can share a tree built with NeighborSearchStat.
+ */
+TEST_CASE("CompositeRulesTest", "[TreeTest]")
+{
+  using TreeType = KDTree<EuclideanDistance,
+      NeighborSearchStat<NearestNeighborSort>, arma::mat>;
+  using KNNRuleType = NeighborSearchRules<NearestNeighborSort,
+      EuclideanDistance, TreeType>;
+  using RangeRuleType = RangeSearchRules<EuclideanDistance, TreeType>;
+  using CompositeType = CompositeRules<KNNRuleType, RangeRuleType, TreeType>;
+
+  arma::mat referenceData = arma::randu<arma::mat>(5, 800);
+  arma::mat queryData = arma::randu<arma::mat>(5, 150);
+  const size_t k = 5;
+  const Range range(0.3, 0.6);
+  EuclideanDistance metric;
+
+  std::vector<size_t> oldFromNewRefs, oldFromNewQueries;
+  TreeType referenceTree(referenceData, oldFromNewRefs);
+
+  // First, run each rule set in its own traversal.
+  arma::Mat<size_t> separateNeighbors;
+  arma::mat separateDistances;
+  std::vector<std::vector<size_t>> separateRangeNeighbors(queryData.n_cols);
+  std::vector<std::vector<double>> separateRangeDistances(queryData.n_cols);
+  {
+    TreeType queryTree(queryData, oldFromNewQueries);
+
+    KNNRuleType knnRules(referenceTree.Dataset(), queryTree.Dataset(), k,
+        metric);
+    TreeType::DualTreeTraverser<KNNRuleType> knnTraverser(knnRules);
+    knnTraverser.Traverse(queryTree, referenceTree);
+    knnRules.GetResults(separateNeighbors, separateDistances);
+
+    RangeSearchVectorSink sink(separateRangeNeighbors, separateRangeDistances);
+    RangeRuleType rangeRules(referenceTree.Dataset(), queryTree.Dataset(),
+        range, sink, metric);
+    TreeType::DualTreeTraverser<RangeRuleType> rangeTraverser(rangeRules);
+    rangeTraverser.Traverse(queryTree, referenceTree);
+  }
+
+  // Now run both rule sets fused into a single traversal.
+  arma::Mat<size_t> fusedNeighbors;
+  arma::mat fusedDistances;
+  std::vector<std::vector<size_t>> fusedRangeNeighbors(queryData.n_cols);
+  std::vector<std::vector<double>> fusedRangeDistances(queryData.n_cols);
+  {
+    TreeType queryTree(queryData, oldFromNewQueries);
+
+    KNNRuleType knnRules(referenceTree.Dataset(), queryTree.Dataset(), k,
+        metric);
+    RangeSearchVectorSink sink(fusedRangeNeighbors, fusedRangeDistances);
+    RangeRuleType rangeRules(referenceTree.Dataset(), queryTree.Dataset(),
+        range, sink, metric);
+
+    CompositeType composite(knnRules, rangeRules);
+    TreeType::DualTreeTraverser<CompositeType> traverser(composite);
+    traverser.Traverse(queryTree, referenceTree);
+    knnRules.GetResults(fusedNeighbors, fusedDistances);
+  }
+
+  // Both query trees were built from the same matrix, so the results use the
+  // same tree-internal ordering and can be compared directly.
+  for (size_t i = 0; i < queryData.n_cols; ++i)
+  {
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(fusedNeighbors(j, i) == separateNeighbors(j, i));
+      REQUIRE(fusedDistances(j, i) ==
+          Approx(separateDistances(j, i)).epsilon(1e-10));
+    }
+
+    // Range search results have no guaranteed order.
+    std::sort(separateRangeNeighbors[i].begin(),
+        separateRangeNeighbors[i].end());
+    std::sort(fusedRangeNeighbors[i].begin(), fusedRangeNeighbors[i].end());
+    REQUIRE(fusedRangeNeighbors[i] == separateRangeNeighbors[i]);
+  }
+}
+
+/**
+ * Test that the TreeRegistry shares one tree among many lookups, keeps trees
+ * of different types under the same name apart, and copies on write only when
+ * a tree is actually shared.
+ */
+TEST_CASE("TreeRegistryTest", "[TreeTest]")
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  TreeRegistry::Get().Clear();
+
+  arma::mat dataset(5, 200, arma::fill::randu);
+
+  // The first call builds the tree; the second must return the same object
+  // and the same mappings.
+  std::vector<size_t> oldFromNew, oldFromNew2;
+  std::shared_ptr<TreeType> tree = TreeRegistry::Get().GetOrBuild<TreeType>(
+      "refs", dataset, oldFromNew);
+  std::shared_ptr<TreeType> tree2 = TreeRegistry::Get().GetOrBuild<TreeType>(
+      "refs", dataset, oldFromNew2);
+
+  REQUIRE(tree.get() == tree2.get());
+  REQUIRE(oldFromNew == oldFromNew2);
+  REQUIRE(oldFromNew.size() == dataset.n_cols);
+  REQUIRE(TreeRegistry::Get().Size() == 1);
+
+  // Find() must return the same tree, and an empty pointer for an unknown
+  // name or a different tree type under the same name.
+  REQUIRE(TreeRegistry::Get().Find<TreeType>("refs").get() == tree.get());
+  REQUIRE(TreeRegistry::Get().Find<TreeType>("other") ==
+      std::shared_ptr<TreeType>());
+
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::fmat> FloatTreeType;
+  REQUIRE(TreeRegistry::Get().Find<FloatTreeType>("refs") ==
+      std::shared_ptr<FloatTreeType>());
+
+  // A float tree may be registered under the same name without clobbering
+  // the double tree.
+  arma::fmat floatDataset = arma::conv_to<arma::fmat>::from(dataset);
+  std::vector<size_t> floatOldFromNew;
+  std::shared_ptr<FloatTreeType> floatTree =
+      TreeRegistry::Get().GetOrBuild<FloatTreeType>("refs", floatDataset,
+      floatOldFromNew);
+  REQUIRE(TreeRegistry::Get().Size() == 2);
+  REQUIRE(TreeRegistry::Get().Find<TreeType>("refs").get() == tree.get());
+
+  // EnsureUnique() must copy a shared tree but leave a private one alone.
+  std::shared_ptr<TreeType> mutableTree = tree;
+  EnsureUnique(mutableTree);
+  REQUIRE(mutableTree.get() != tree.get());
+  REQUIRE(mutableTree->NumDescendants() == tree->NumDescendants());
+
+  TreeType* beforePtr = mutableTree.get();
+  EnsureUnique(mutableTree); // Not shared anymore; must be a no-op.
+  REQUIRE(mutableTree.get() == beforePtr);
+
+  // Removing the registry's reference must not invalidate handed-out ones.
+  REQUIRE(TreeRegistry::Get().Remove<TreeType>("refs"));
+  REQUIRE(!TreeRegistry::Get().Remove<TreeType>("refs"));
+  REQUIRE(TreeRegistry::Get().Size() == 1);
+  REQUIRE(tree->Dataset().n_cols == dataset.n_cols);
+
+  TreeRegistry::Get().Clear();
+  REQUIRE(TreeRegistry::Get().Size() == 0);
+}
+
+/**
+ * The sparse overloads of HRectBound::operator|=() must produce exactly the
+ * same bound as the generic element-wise version, including the implicit
+ * zeros of any dimension that is not dense in the data.
+ */
+TEST_CASE("HRectBoundSparseUnionTest", "[TreeTest]")
+{
+  // Four points in five dimensions; dimension 2 is entirely zero, and
+  // dimension 3 is nonzero in every point, so no implicit zero may be added
+  // there.
+  arma::umat locations = { { 0, 0, 1, 1, 3, 3, 3, 3, 4 },
+                           { 0, 2, 1, 3, 0, 1, 2, 3, 1 } };
+  arma::vec values = { 1.0, -2.0, 3.0, -1.5, -1.0, -2.0, -3.0, -0.5, 2.5 };
+  arma::sp_mat dataset(locations, values, 5, 4);
+
+  HRectBound<EuclideanDistance> sparseBound(5);
+  sparseBound |= dataset;
+
+  arma::mat denseDataset(dataset);
+  HRectBound<EuclideanDistance> denseBound(5);
+  denseBound |= denseDataset;
+
+  for (size_t d = 0; d < 5; ++d)
+  {
+    REQUIRE(sparseBound[d].Lo() == Approx(denseBound[d].Lo()).margin(1e-15));
+    REQUIRE(sparseBound[d].Hi() == Approx(denseBound[d].Hi()).margin(1e-15));
+  }
+
+  // Dimension 3 is dense and entirely negative: the upper bound must be the
+  // largest nonzero value, not zero.
+  REQUIRE(sparseBound[3].Hi() == Approx(-0.5).epsilon(1e-7));
+  // Dimension 4 is nonnegative with implicit zeros, so zero is its lower
+  // bound.
+  REQUIRE(sparseBound[4].Lo() == Approx(0.0).margin(1e-15));
+  // Dimension 2 has no nonzero entries at all.
+  REQUIRE(sparseBound[2].Lo() == Approx(0.0).margin(1e-15));
+  REQUIRE(sparseBound[2].Hi() == Approx(0.0).margin(1e-15));
+
+  // The subview overload (the form used during tree construction) must agree
+  // with the dense equivalent too.
+  HRectBound<EuclideanDistance> sparseColsBound(5);
+  sparseColsBound |= dataset.cols(1, 3);
+
+  HRectBound<EuclideanDistance> denseColsBound(5);
+  denseColsBound |= denseDataset.cols(1, 3);
+
+  for (size_t d = 0; d < 5; ++d)
+  {
+    REQUIRE(sparseColsBound[d].Lo() ==
+        Approx(denseColsBound[d].Lo()).margin(1e-15));
+    REQUIRE(sparseColsBound[d].Hi() ==
+        Approx(denseColsBound[d].Hi()).margin(1e-15));
+  }
+}
+
+/**
+ * Build a mean-split tree on sparse data and make sure the mappings and
+ * bounds are correct; both the mean computation of the split and the
+ * partition itself use the sparse-specific code paths.
+ */
+TEST_CASE("SparseMeanSplitTreeTest", "[TreeTest]")
+{
+  typedef BinarySpaceTree<EuclideanDistance, EmptyStatistic, arma::sp_mat,
+      HRectBound, MeanSplit> TreeType;
+
+  arma::sp_mat dataset;
+  dataset.sprandu(8, 300, 0.1);
+  const arma::sp_mat datacopy(dataset);
+
+  std::vector<size_t> newToOld;
+  std::vector<size_t> oldToNew;
+  TreeType root(dataset, newToOld, oldToNew);
+
+  REQUIRE(root.Count() == 300);
+
+  // Check the forward and backward mappings for correctness.
+  const arma::sp_mat& treeset = root.Dataset();
+  for (size_t i = 0; i < treeset.n_cols; ++i)
+  {
+    for (size_t j = 0; j < treeset.n_rows; ++j)
+    {
+      REQUIRE(treeset(j, i) == datacopy(j, newToOld[i]));
+      REQUIRE(treeset(j, oldToNew[i]) == datacopy(j, i));
+    }
+  }
+
+  // Now check that each point is contained inside of all bounds above it.
+  CheckPointBounds(root);
+}
@@ -10,7 +10,7 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/core.hpp>
-#include <mlpack/methods/xgboost/loss_functions/sse_loss.hpp>
+#include <mlpack/methods/xgboost.hpp>
 
 #include "catch.hpp"
 #include "serialization.hpp"
@@ -63,3 +63,107 @@ TEST_CASE("SSEGainTest", "[XGBTest]")
   SSELoss Loss;
   REQUIRE(Loss.Evaluate<false>(input, weights) == gain);
 }
+
+/**
+ * Make sure an untrained ensemble cannot predict.
+ */
+TEST_CASE("XGBEmptyPredictTest", "[XGBTest]")
+{
+  XGBoost<> xgb; // No training.
+
+  arma::mat points(10, 100, arma::fill::randu);
+  arma::rowvec predictions;
+  REQUIRE_THROWS_AS(xgb.Predict(points, predictions), std::invalid_argument);
+  REQUIRE_THROWS_AS(xgb.Predict(points.col(0)), std::invalid_argument);
+}
+
+/**
+ * Test that boosted trees fit a numeric regression dataset at least as well
+ * as a single decision tree.
+ */
+TEST_CASE("XGBNumericTrainTest", "[XGBTest]")
+{
+  arma::mat X;
+  arma::rowvec Y;
+
+  if (!data::Load("lars_dependent_x.csv", X))
+    FAIL("Cannot load dataset lars_dependent_x.csv");
+  if (!data::Load("lars_dependent_y.csv", Y))
+    FAIL("Cannot load dataset lars_dependent_y.csv");
+
+  arma::mat XTrain, XTest;
+  arma::rowvec YTrain, YTest;
+  data::Split(X, Y, XTrain, XTest, YTrain, YTest, 0.3);
+
+  XGBoost<> xgb(XTrain, YTrain, 50, 0.3, 5);
+  DecisionTreeRegressor<> tree(XTrain, YTrain, 5);
+
+  arma::rowvec xgbPredictions, treePredictions;
+  xgb.Predict(XTest, xgbPredictions);
+  tree.Predict(XTest, treePredictions);
+
+  const double xgbRMSE = std::sqrt(arma::accu(arma::square(
+      xgbPredictions - YTest)) / (double) YTest.n_elem);
+  const double treeRMSE = std::sqrt(arma::accu(arma::square(
+      treePredictions - YTest)) / (double) YTest.n_elem);
+
+  REQUIRE(xgbRMSE <= treeRMSE * 1.1);
+  REQUIRE(xgbRMSE < 1.0);
+}
+
+/**
+ * Test that more boosting iterations reduce the training error.
+ */
+TEST_CASE("XGBTrainingErrorTest", "[XGBTest]")
+{
+  arma::mat X;
+  arma::rowvec Y;
+
+  if (!data::Load("lars_dependent_x.csv", X))
+    FAIL("Cannot load dataset lars_dependent_x.csv");
+  if (!data::Load("lars_dependent_y.csv", Y))
+    FAIL("Cannot load dataset lars_dependent_y.csv");
+
+  XGBoost<> xgb;
+  const double mseFew = xgb.Train(X, Y, 5, 0.1, 5);
+  const double mseMany = xgb.Train(X, Y, 50, 0.1, 5);
+
+  REQUIRE(mseMany <= mseFew);
+}
+
+/**
+ * Test that an ensemble can be serialized and gives the same predictions
+ * afterwards.
+ */
+TEST_CASE("XGBSerializationTest", "[XGBTest]")
+{
+  arma::mat X;
+  arma::rowvec Y;
+
+  if (!data::Load("lars_dependent_x.csv", X))
+    FAIL("Cannot load dataset lars_dependent_x.csv");
+  if (!data::Load("lars_dependent_y.csv", Y))
+    FAIL("Cannot load dataset lars_dependent_y.csv");
+
+  XGBoost<> xgb(X, Y, 20, 0.3, 5);
+
+  arma::rowvec beforePredictions;
+  xgb.Predict(X, beforePredictions);
+
+  XGBoost<> xmlXgb, jsonXgb, binaryXgb;
+  binaryXgb.Train(X, Y, 3, 0.1, 5);
+  SerializeObjectAll(xgb, xmlXgb, jsonXgb, binaryXgb);
+
+  // Now check that we get the same results from the serialized models.
+  arma::rowvec xmlPredictions, jsonPredictions, binaryPredictions;
+  xmlXgb.Predict(X, xmlPredictions);
+  jsonXgb.Predict(X, jsonPredictions);
+  binaryXgb.Predict(X, binaryPredictions);
+
+  REQUIRE(arma::approx_equal(xmlPredictions, beforePredictions, "absdiff",
+      1e-10));
+  REQUIRE(arma::approx_equal(jsonPredictions, beforePredictions, "absdiff",
+      1e-10));
+  REQUIRE(arma::approx_equal(binaryPredictions, beforePredictions, "absdiff",
+      1e-10));
+}